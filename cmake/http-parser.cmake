@@ -45,3 +45,12 @@ set_property(DIRECTORY APPEND PROPERTY
   ADDITIONAL_MAKE_CLEAN_FILES ${CMAKE_BINARY_DIR}/lib/libhttpparser.a)
 
 set(HTTPPARSER_INCLUDE_DIR ${DEPS_HTTPPARSER_SRC})
+
+# Builds the benchmark of the parser, deps/http-parser/httpparser-bench in
+# the build directory.
+if(NOT "${TARGET_OS}" MATCHES "NUTTX|TIZENRT")
+  add_custom_target(http-parser-bench
+    COMMAND ${CMAKE_COMMAND} --build ${CMAKE_BINARY_DIR}/${DEPS_HTTPPARSER}
+            --target httpparser-bench
+    DEPENDS http-parser)
+endif()
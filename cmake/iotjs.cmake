@@ -52,6 +52,10 @@ if(ENABLE_MINIMAL)
     set(MODULE_ANALYZER_ARGS --iotjs-minimal-profile)
 endif()
 
+if(IOTJS_APP)
+    list(APPEND MODULE_ANALYZER_ARGS --iotjs-app "${IOTJS_APP}")
+endif()
+
 execute_process(
   COMMAND python ${ROOT_DIR}/tools/module_analyzer.py
           --mode cmake-dump
@@ -99,12 +103,34 @@ if(ENABLE_SNAPSHOT)
   set(IOTJS_CFLAGS ${IOTJS_CFLAGS} -DENABLE_SNAPSHOT)
 endif()
 
+if(ENABLE_CODE_CACHE)
+  if(NOT ENABLE_SNAPSHOT)
+    message(FATAL_ERROR "Code cache requires snapshot mode")
+  endif()
+  set(IOTJS_CFLAGS ${IOTJS_CFLAGS} -DENABLE_CODE_CACHE)
+endif()
+
+if(ENABLE_JS_COMPRESSION)
+  set(JS2C_COMPRESS_ARG --compress)
+  set(IOTJS_CFLAGS ${IOTJS_CFLAGS} -DENABLE_JS_COMPRESSION)
+endif()
+
+# The GPIO character device, which kernel headers have since Linux 4.8
+if("${TARGET_OS}" STREQUAL "LINUX")
+  include(CheckIncludeFile)
+  check_include_file(linux/gpio.h HAVE_LINUX_GPIO_H)
+  if(HAVE_LINUX_GPIO_H)
+    set(IOTJS_CFLAGS ${IOTJS_CFLAGS} -DHAVE_LINUX_GPIO_H)
+  endif()
+endif()
+
 add_custom_command(
   OUTPUT ${IOTJS_SOURCE_DIR}/iotjs_js.c ${IOTJS_SOURCE_DIR}/iotjs_js.h
   COMMAND python ${ROOT_DIR}/tools/js2c.py
   ARGS --buildtype=${JS2C_RUN_MODE}
        --modules '${IOTJS_JS_MODULES}'
        ${JS2C_SNAPSHOT_ARG}
+       ${JS2C_COMPRESS_ARG}
   DEPENDS ${ROOT_DIR}/tools/js2c.py
           jerry
           ${IOTJS_SOURCE_DIR}/js/*.js
@@ -209,9 +235,12 @@ message(STATUS "TARGET_BOARD             ${TARGET_BOARD}")
 message(STATUS "BUILD_LIB_ONLY           ${BUILD_LIB_ONLY}")
 message(STATUS "ENABLE_LTO               ${ENABLE_LTO}")
 message(STATUS "ENABLE_SNAPSHOT          ${ENABLE_SNAPSHOT}")
+message(STATUS "ENABLE_CODE_CACHE        ${ENABLE_CODE_CACHE}")
+message(STATUS "ENABLE_JS_COMPRESSION    ${ENABLE_JS_COMPRESSION}")
 message(STATUS "ENABLE_MINIMAL           ${ENABLE_MINIMAL}")
 message(STATUS "IOTJS_INCLUDE_MODULE     ${IOTJS_INCLUDE_MODULE}")
 message(STATUS "IOTJS_EXCLUDE_MODULE     ${IOTJS_EXCLUDE_MODULE}")
+message(STATUS "IOTJS_APP                ${IOTJS_APP}")
 message(STATUS "IOTJS_C_FLAGS            ${IOTJS_C_FLAGS}")
 message(STATUS "IOTJS_LINK_FLAGS         ${IOTJS_LINK_FLAGS}")
 
@@ -228,6 +257,25 @@ separate_arguments(EXTERNAL_INCLUDE_DIR)
 separate_arguments(EXTERNAL_STATIC_LIB)
 separate_arguments(EXTERNAL_SHARED_LIB)
 
+# The tls module, and https on it, run on mbedTLS
+find_value(ENABLE_MODULE_TLS "TLS" 1 0 ${IOTJS_MODULES_ENABLED})
+if(ENABLE_MODULE_TLS)
+  set(MBEDTLS_LIBS mbedtls mbedx509 mbedcrypto)
+  if(EXTERNAL_SHARED_LIB)
+    list(REMOVE_ITEM EXTERNAL_SHARED_LIB ${MBEDTLS_LIBS})
+  endif()
+  list(APPEND EXTERNAL_SHARED_LIB ${MBEDTLS_LIBS})
+endif()
+
+# Where tls is not built, the https client runs on libcurl
+find_value(ENABLE_MODULE_HTTPS "HTTPS" 1 0 ${IOTJS_MODULES_ENABLED})
+if(ENABLE_MODULE_HTTPS)
+  if(EXTERNAL_SHARED_LIB)
+    list(REMOVE_ITEM EXTERNAL_SHARED_LIB curl)
+  endif()
+  list(APPEND EXTERNAL_SHARED_LIB curl)
+endif()
+
 set(IOTJS_INCLUDE_DIRS
   ${EXTERNAL_INCLUDE_DIR}
   ${ROOT_DIR}/include
@@ -95,6 +95,7 @@ add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_MEM_STATS)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_ERROR_MESSAGES)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_DEBUGGER)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_DEBUGGER_PORT)
+add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_CPOINTER_32_BIT)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS MEM_HEAP_SIZE_KB)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS JERRY_HEAP_SECTION_ATTR)
 
@@ -117,7 +118,7 @@ ExternalProject_Add(libjerry
     -DJERRY_CMDLINE=OFF
     -DJERRY_CMDLINE_MINIMAL=OFF
     -DFEATURE_SNAPSHOT_EXEC=${ENABLE_SNAPSHOT}
-    -DFEATURE_SNAPSHOT_SAVE=OFF
+    -DFEATURE_SNAPSHOT_SAVE=${ENABLE_CODE_CACHE}
     -DFEATURE_PROFILE=${FEATURE_PROFILE}
     -DFEATURE_VM_EXEC_STOP=ON
     -DENABLE_LTO=${ENABLE_LTO}
@@ -20,9 +20,8 @@ BuildRequires: pkgconfig(capi-appfw-package-manager)
 BuildRequires: pkgconfig(capi-appfw-application)
 BuildRequires: pkgconfig(capi-system-peripheral-io)
 BuildRequires: pkgconfig(dlog)
-#for https
-BuildRequires:  openssl-devel
-BuildRequires:  libcurl-devel
+#for tls and https
+BuildRequires:  mbedtls-devel
 
 Requires(postun): /sbin/ldconfig
 Requires(post): /sbin/ldconfig
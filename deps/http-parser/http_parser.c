@@ -29,6 +29,19 @@
 #include <string.h>
 #include <limits.h>
 
+/* Runs of ordinary URL, header name and header value characters are skipped
+ * 16 bytes at a time with SSE4.2 or NEON when the compiler targets them.
+ * Define HTTP_PARSER_NO_SIMD to parse byte by byte.
+ */
+#if !defined(HTTP_PARSER_NO_SIMD) && defined(__SSE4_2__)
+# include <nmmintrin.h>
+# define HTTP_PARSER_SSE42 1
+#elif !defined(HTTP_PARSER_NO_SIMD) && \
+      (defined(__ARM_NEON) || defined(__ARM_NEON__))
+# include <arm_neon.h>
+# define HTTP_PARSER_NEON 1
+#endif
+
 #ifndef ULLONG_MAX
 # define ULLONG_MAX ((uint64_t) -1) /* 2^64-1 */
 #endif
@@ -468,6 +481,170 @@ static struct {
 
 int http_message_needs_eof(const http_parser *parser);
 
+
+#if HTTP_PARSER_SSE42
+/* Byte ranges for _mm_cmpestri(), in pairs of the first and the last byte. */
+
+/* Ordinary characters of a path, a query string or a fragment: printable
+ * ASCII but '#' and '?', and in the lenient mode the bytes above 0x7f.
+ */
+static const char url_char_ranges[16] =
+  "\x21\x22\x24\x3e\x40\x7e"
+#if !HTTP_PARSER_STRICT
+  "\x80\xff"
+#endif
+  ;
+#define URL_CHAR_RANGES_LEN (HTTP_PARSER_STRICT ? 6 : 8)
+
+/* Token characters of a header name but '|' and '~', for which there is no
+ * room, and which the byte-by-byte loop takes.
+ */
+static const char token_char_ranges[16] =
+  "!!#'*+-.09AZ^z||";
+#define TOKEN_CHAR_RANGES_LEN 16
+
+#define CMPESTRI_SKIP \
+  (_SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_NEGATIVE_POLARITY | \
+   _SIDD_LEAST_SIGNIFICANT)
+#define CMPESTRI_FIND \
+  (_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT)
+#endif
+
+#if HTTP_PARSER_NEON
+/* Whether all the bytes of a comparison result are set. */
+static int
+neon_all_set(uint8x16_t v)
+{
+  uint64x2_t v64 = vreinterpretq_u64_u8(v);
+  return (vgetq_lane_u64(v64, 0) & vgetq_lane_u64(v64, 1)) == UINT64_MAX;
+}
+#endif
+
+
+/* Returns the first byte from `p` that is not an ordinary character of a
+ * path, a query string or a fragment, or `end`. The bytes left, such as '?'
+ * or a space, go through parse_url_char().
+ */
+static const char*
+skip_url_chars(const char* p, const char* end)
+{
+#if HTTP_PARSER_SSE42
+  const __m128i ranges = _mm_loadu_si128((const __m128i*) url_char_ranges);
+
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*) p);
+    int i = _mm_cmpestri(ranges, URL_CHAR_RANGES_LEN, v, 16, CMPESTRI_SKIP);
+    if (i != 16) {
+      return p + i;
+    }
+  }
+#elif HTTP_PARSER_NEON
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t*) p);
+    uint8x16_t ok = vandq_u8(vcgeq_u8(v, vdupq_n_u8(0x21)),
+                             vcleq_u8(v, vdupq_n_u8(0x7e)));
+    ok = vbicq_u8(ok, vceqq_u8(v, vdupq_n_u8('#')));
+    ok = vbicq_u8(ok, vceqq_u8(v, vdupq_n_u8('?')));
+#if !HTTP_PARSER_STRICT
+    ok = vorrq_u8(ok, vcgeq_u8(v, vdupq_n_u8(0x80)));
+#endif
+    if (!neon_all_set(ok)) {
+      break;
+    }
+  }
+#endif
+
+  while (p != end && IS_URL_CHAR(*p)) {
+    p++;
+  }
+  return p;
+}
+
+
+/* Returns the first byte from `p` that is not a character of a header name,
+ * or `end`. Header names are mostly letters and '-'.
+ */
+static const char*
+skip_token_chars(const char* p, const char* end)
+{
+#if HTTP_PARSER_SSE42
+  const __m128i ranges = _mm_loadu_si128((const __m128i*) token_char_ranges);
+
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*) p);
+    int i = _mm_cmpestri(ranges, TOKEN_CHAR_RANGES_LEN, v, 16, CMPESTRI_SKIP);
+    if (i != 16) {
+      p += i;
+      break;
+    }
+  }
+#elif HTTP_PARSER_NEON
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t*) p);
+    uint8x16_t lower = vorrq_u8(v, vdupq_n_u8(0x20));
+    uint8x16_t ok = vandq_u8(vcgeq_u8(lower, vdupq_n_u8('a')),
+                             vcleq_u8(lower, vdupq_n_u8('z')));
+    ok = vorrq_u8(ok, vandq_u8(vcgeq_u8(v, vdupq_n_u8('0')),
+                               vcleq_u8(v, vdupq_n_u8('9'))));
+    ok = vorrq_u8(ok, vceqq_u8(v, vdupq_n_u8('-')));
+    if (!neon_all_set(ok)) {
+      break;
+    }
+  }
+#endif
+
+  while (p != end && TOKEN(*p)) {
+    p++;
+  }
+  return p;
+}
+
+
+/* Returns the first CR or LF from `p`, or `end`. */
+static const char*
+find_crlf(const char* p, const char* end)
+{
+#if HTTP_PARSER_SSE42
+  const __m128i crlf = _mm_setr_epi8(CR, LF, 0, 0, 0, 0, 0, 0,
+                                     0, 0, 0, 0, 0, 0, 0, 0);
+
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*) p);
+    int i = _mm_cmpestri(crlf, 2, v, 16, CMPESTRI_FIND);
+    if (i != 16) {
+      return p + i;
+    }
+  }
+#elif HTTP_PARSER_NEON
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t*) p);
+    uint8x16_t found = vorrq_u8(vceqq_u8(v, vdupq_n_u8(CR)),
+                                vceqq_u8(v, vdupq_n_u8(LF)));
+    uint64x2_t found64 = vreinterpretq_u64_u8(found);
+    if (vgetq_lane_u64(found64, 0) | vgetq_lane_u64(found64, 1)) {
+      break;
+    }
+  }
+#else
+  {
+    const char* p_cr = (const char*) memchr(p, CR, end - p);
+    const char* p_lf = (const char*) memchr(p, LF,
+                                            (p_cr != NULL ? p_cr : end) - p);
+    if (p_lf != NULL) {
+      return p_lf;
+    }
+    return p_cr != NULL ? p_cr : end;
+  }
+#endif
+
+  for (; p != end; p++) {
+    if (*p == CR || *p == LF) {
+      return p;
+    }
+  }
+  return end;
+}
+
 /* Our URL parser.
  *
  * This is designed to be shared by http_parser_execute() for URL validation,
@@ -1141,6 +1318,15 @@ reexecute:
               SET_ERRNO(HPE_INVALID_URL);
               goto error;
             }
+
+            /* The ordinary characters that follow keep the state. */
+            if (CURRENT_STATE() == s_req_path ||
+                CURRENT_STATE() == s_req_query_string ||
+                CURRENT_STATE() == s_req_fragment) {
+              const char* q = skip_url_chars(p + 1, data + len);
+              COUNT_HEADER_SIZE(q - (p + 1));
+              p = q - 1;
+            }
         }
         break;
       }
@@ -1329,6 +1515,7 @@ reexecute:
 
           switch (parser->header_state) {
             case h_general:
+              p = skip_token_chars(p + 1, data + len) - 1;
               break;
 
             case h_C:
@@ -1545,22 +1732,14 @@ reexecute:
           switch (h_state) {
             case h_general:
             {
-              const char* p_cr;
-              const char* p_lf;
               size_t limit = data + len - p;
+              const char* p_end;
 
               limit = MIN(limit, HTTP_MAX_HEADER_SIZE);
+              p_end = p + limit;
 
-              p_cr = (const char*) memchr(p, CR, limit);
-              p_lf = (const char*) memchr(p, LF, limit);
-              if (p_cr != NULL) {
-                if (p_lf != NULL && p_cr >= p_lf)
-                  p = p_lf;
-                else
-                  p = p_cr;
-              } else if (UNLIKELY(p_lf != NULL)) {
-                p = p_lf;
-              } else {
+              p = find_crlf(p, p_end);
+              if (p == p_end) {
                 p = data + len;
               }
               --p;
@@ -2168,6 +2347,11 @@ http_errno_description(enum http_errno err) {
       (sizeof(http_strerror_tab) / sizeof(http_strerror_tab[0])));
   return http_strerror_tab[err].description;
 }
+#endif
+
+/* The URL parser is kept in the memory constrained build, for the url module
+ * of IoT.js.
+ */
 
 static enum http_host_state
 http_parse_host_char(enum http_host_state s, const char ch) {
@@ -2411,7 +2595,6 @@ http_parser_parse_url(const char *buf, size_t buflen, int is_connect,
 
   return 0;
 }
-#endif
 
 void
 http_parser_pause(http_parser *parser, int paused) {
@@ -327,12 +327,12 @@ const char *http_errno_name(enum http_errno err);
 #ifndef HTTPPARSER_ENABLE_MEMORY_CONSTRAINTS
 /* Return a string description of the given error */
 const char *http_errno_description(enum http_errno err);
+#endif
 
 /* Parse a URL; return nonzero on failure */
 int http_parser_parse_url(const char *buf, size_t buflen,
                           int is_connect,
                           struct http_parser_url *u);
-#endif
 
 /* Pause or un-pause the parser; a nonzero value pauses */
 void http_parser_pause(http_parser *parser, int paused);
@@ -195,6 +195,59 @@ jerry_debugger_wait_and_run_client_source (jerry_value_t *return_value) /**< [ou
 #endif /* JERRY_DEBUGGER */
 } /* jerry_debugger_wait_and_run_client_source */
 
+/**
+ * Check the messages of the client and send the queued profile samples, while
+ * no JS code is running. The embedder should call it periodically, at the
+ * sampling interval or more often, e.g. from its event loop.
+ *
+ * @return true - if profiling is enabled and the embedder should take its samples
+ *         false - otherwise
+ */
+bool
+jerry_debugger_profile_tick (void)
+{
+#ifdef JERRY_DEBUGGER
+  if (!(JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_CONNECTED)
+      || (JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_BREAKPOINT_MODE))
+  {
+    return false;
+  }
+
+  jerry_debugger_receive (NULL);
+
+  if (!(JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_CONNECTED))
+  {
+    return false;
+  }
+
+  return jerry_debugger_profile_tick_internal ();
+#else /* !JERRY_DEBUGGER */
+  return false;
+#endif /* JERRY_DEBUGGER */
+} /* jerry_debugger_profile_tick */
+
+/**
+ * Queue a profile sample of the embedder, which is sent to the client at the
+ * next tick, if the client samples its kind.
+ */
+void
+jerry_debugger_profile_sample (jerry_debugger_profile_kind_t kind, /**< kind of the sample */
+                               const uint32_t values[], /**< values of the sample */
+                               uint32_t count) /**< number of values, at most
+                                                *   JERRY_DEBUGGER_PROFILE_MAX_VALUES */
+{
+#ifdef JERRY_DEBUGGER
+  if ((JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_CONNECTED) && kind < JERRY_DEBUGGER_PROFILE__COUNT)
+  {
+    jerry_debugger_profile_push (kind, values, count);
+  }
+#else /* !JERRY_DEBUGGER */
+  JERRY_UNUSED (kind);
+  JERRY_UNUSED (values);
+  JERRY_UNUSED (count);
+#endif /* JERRY_DEBUGGER */
+} /* jerry_debugger_profile_sample */
+
 /**
  * Send the output of the program to the debugger client.
  * Currently only sends print output.
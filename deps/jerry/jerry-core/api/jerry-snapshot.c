@@ -318,7 +318,7 @@ jerry_snapshot_set_offsets (uint32_t *buffer_p, /**< buffer */
 static ecma_compiled_code_t *
 snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data */
                              size_t offset, /**< byte code offset */
-                             lit_mem_to_snapshot_id_map_entry_t *lit_map_p, /**< literal map */
+                             const ecma_snapshot_literal_table_t *lit_table_p, /**< literal table */
                              bool copy_bytecode) /**< byte code should be copied to memory */
 {
   ecma_compiled_code_t *bytecode_p = (ecma_compiled_code_t *) (snapshot_data_p + offset);
@@ -430,16 +430,9 @@ snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data
 
   for (uint32_t i = 0; i < const_literal_end; i++)
   {
-    lit_mem_to_snapshot_id_map_entry_t *current_p = lit_map_p;
-
     if (literal_start_p[i] != 0)
     {
-      while (current_p->literal_offset != literal_start_p[i])
-      {
-        current_p++;
-      }
-
-      literal_start_p[i] = current_p->literal_id;
+      literal_start_p[i] = ecma_snapshot_get_literal (lit_table_p, literal_start_p[i]);
     }
   }
 
@@ -458,7 +451,7 @@ snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data
       ecma_compiled_code_t *literal_bytecode_p;
       literal_bytecode_p = snapshot_load_compiled_code (snapshot_data_p,
                                                         literal_offset,
-                                                        lit_map_p,
+                                                        lit_table_p,
                                                         copy_bytecode);
 
       ECMA_SET_NON_NULL_POINTER (literal_start_p[i],
@@ -471,102 +464,166 @@ snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data
 
 #endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
 
+#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+
 /**
- * Generate snapshot from specified source
+ * Generate snapshot from the specified sources, whose code shares one literal table
  *
  * @return size of snapshot, if it was generated succesfully
- *          (i.e. there are no syntax errors in source code, buffer size is sufficient,
- *           and snapshot support is enabled in current configuration through JERRY_ENABLE_SNAPSHOT_SAVE),
  *         0 - otherwise.
  */
-size_t
-jerry_parse_and_save_snapshot (const jerry_char_t *source_p, /**< script source */
-                               size_t source_size, /**< script source size */
-                               bool is_for_global, /**< snapshot would be executed as global (true)
-                                                    *   or eval (false) */
-                               bool is_strict, /**< strict mode */
-                               uint32_t *buffer_p, /**< buffer to save snapshot to */
-                               size_t buffer_size) /**< the buffer's size */
+static size_t
+snapshot_parse_and_save (const jerry_char_t * const *sources_p, /**< script sources */
+                         const size_t *source_sizes_p, /**< script source sizes */
+                         uint32_t source_count, /**< number of sources */
+                         bool is_for_global, /**< snapshot would be executed as global (true)
+                                              *   or eval (false) */
+                         bool is_strict, /**< strict mode */
+                         bool save_module_table, /**< save the offsets of the sources after the literals */
+                         uint32_t *buffer_p, /**< buffer to save snapshot to */
+                         size_t buffer_size) /**< the buffer's size */
 {
-#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
   snapshot_globals_t globals;
   ecma_value_t parse_status;
   ecma_compiled_code_t *bytecode_data_p;
 
-  globals.snapshot_buffer_write_offset = JERRY_ALIGNUP (sizeof (jerry_snapshot_header_t),
-                                                        JMEM_ALIGNMENT);
-  globals.snapshot_error_occured = false;
+  size_t module_table_size = (1 + source_count) * sizeof (uint32_t);
+  uint32_t *module_table_p = NULL;
 
-  parse_status = parser_parse_script (source_p,
-                                      source_size,
-                                      is_strict,
-                                      &bytecode_data_p);
-
-  if (ECMA_IS_VALUE_ERROR (parse_status))
+  if (save_module_table)
   {
-    ecma_free_value (parse_status);
-    return 0;
+    module_table_p = (uint32_t *) jmem_heap_alloc_block_null_on_error (module_table_size);
+
+    if (module_table_p == NULL)
+    {
+      return 0;
+    }
+
+    module_table_p[0] = source_count;
   }
 
-  snapshot_add_compiled_code (bytecode_data_p, (uint8_t *) buffer_p, buffer_size, &globals);
+  globals.snapshot_buffer_write_offset = JERRY_ALIGNUP (sizeof (jerry_snapshot_header_t),
+                                                        JMEM_ALIGNMENT);
+  globals.snapshot_error_occured = false;
 
-  if (globals.snapshot_error_occured)
+  /* The literals of all sources are in the literal storage when it is saved. */
+  for (uint32_t i = 0; i < source_count && !globals.snapshot_error_occured; i++)
   {
-    return 0;
-  }
+    parse_status = parser_parse_script (sources_p[i],
+                                        source_sizes_p[i],
+                                        is_strict,
+                                        &bytecode_data_p);
 
-  jerry_snapshot_header_t header;
-  header.version = JERRY_SNAPSHOT_VERSION;
-  header.lit_table_offset = (uint32_t) globals.snapshot_buffer_write_offset;
-  header.is_run_global = is_for_global;
+    if (ECMA_IS_VALUE_ERROR (parse_status))
+    {
+      ecma_free_value (parse_status);
+      globals.snapshot_error_occured = true;
+      break;
+    }
 
-  lit_mem_to_snapshot_id_map_entry_t *lit_map_p = NULL;
-  uint32_t literals_num;
+    if (module_table_p != NULL)
+    {
+      module_table_p[1 + i] = (uint32_t) globals.snapshot_buffer_write_offset;
+    }
 
-  if (!ecma_save_literals_for_snapshot (buffer_p,
-                                        buffer_size,
-                                        &globals.snapshot_buffer_write_offset,
-                                        &lit_map_p,
-                                        &literals_num,
-                                        &header.lit_table_size))
-  {
-    JERRY_ASSERT (lit_map_p == NULL);
-    return 0;
+    snapshot_add_compiled_code (bytecode_data_p, (uint8_t *) buffer_p, buffer_size, &globals);
+    ecma_bytecode_deref (bytecode_data_p);
   }
 
-  jerry_snapshot_set_offsets (buffer_p + (JERRY_ALIGNUP (sizeof (jerry_snapshot_header_t),
-                                                         JMEM_ALIGNMENT) / sizeof (uint32_t)),
-                              (uint32_t) (header.lit_table_offset - sizeof (jerry_snapshot_header_t)),
-                              lit_map_p);
+  size_t result = 0;
 
-  size_t header_offset = 0;
+  if (!globals.snapshot_error_occured)
+  {
+    jerry_snapshot_header_t header;
+    header.version = JERRY_SNAPSHOT_VERSION;
+    header.lit_table_offset = (uint32_t) globals.snapshot_buffer_write_offset;
+    header.is_run_global = is_for_global;
 
-  snapshot_write_to_buffer_by_offset ((uint8_t *) buffer_p,
-                                      buffer_size,
-                                      &header_offset,
-                                      &header,
-                                      sizeof (header));
+    lit_mem_to_snapshot_id_map_entry_t *lit_map_p = NULL;
+    uint32_t literals_num;
 
-  if (lit_map_p != NULL)
-  {
-    size_t size_to_free = literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t);
-    // Over-provision for full-bitwidth address overhead
-    #ifdef SEG_FULLBIT_ADDRESS_ALLOC
-    size_to_free += literals_num * 4;
-    #endif
-    // profiling of full-bitwidth overhead
-    sub_full_bitwidth_size(literals_num * 4);
+    if (ecma_save_literals_for_snapshot (buffer_p,
+                                         buffer_size,
+                                         &globals.snapshot_buffer_write_offset,
+                                         &lit_map_p,
+                                         &literals_num,
+                                         &header.lit_table_size))
+    {
+      jerry_snapshot_set_offsets (buffer_p + (JERRY_ALIGNUP (sizeof (jerry_snapshot_header_t),
+                                                             JMEM_ALIGNMENT) / sizeof (uint32_t)),
+                                  (uint32_t) (header.lit_table_offset - sizeof (jerry_snapshot_header_t)),
+                                  lit_map_p);
+
+      size_t header_offset = 0;
+
+      snapshot_write_to_buffer_by_offset ((uint8_t *) buffer_p,
+                                          buffer_size,
+                                          &header_offset,
+                                          &header,
+                                          sizeof (header));
+
+      if (module_table_p == NULL
+          || snapshot_write_to_buffer_by_offset ((uint8_t *) buffer_p,
+                                                 buffer_size,
+                                                 &globals.snapshot_buffer_write_offset,
+                                                 module_table_p,
+                                                 module_table_size))
+      {
+        result = globals.snapshot_buffer_write_offset;
+      }
+    }
+    else
+    {
+      JERRY_ASSERT (lit_map_p == NULL);
+    }
 
-    #ifdef PROF_COUNT__SIZE_DETAILED
-    profile_add_count_size_detailed(13, -size_to_free); /* size detailed */
-    #endif
+    if (lit_map_p != NULL)
+    {
+      size_t size_to_free = literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t);
+      // Over-provision for full-bitwidth address overhead
+      #ifdef SEG_FULLBIT_ADDRESS_ALLOC
+      size_to_free += literals_num * 4;
+      #endif
+      // profiling of full-bitwidth overhead
+      sub_full_bitwidth_size(literals_num * 4);
+
+      #ifdef PROF_COUNT__SIZE_DETAILED
+      profile_add_count_size_detailed(13, -size_to_free); /* size detailed */
+      #endif
+
+      jmem_heap_free_block (lit_map_p, size_to_free);
+    }
+  }
 
-    jmem_heap_free_block (lit_map_p, size_to_free);
+  if (module_table_p != NULL)
+  {
+    jmem_heap_free_block (module_table_p, module_table_size);
   }
 
-  ecma_bytecode_deref (bytecode_data_p);
+  return result;
+} /* snapshot_parse_and_save */
+
+#endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
 
-  return globals.snapshot_buffer_write_offset;
+/**
+ * Generate snapshot from specified source
+ *
+ * @return size of snapshot, if it was generated succesfully
+ *          (i.e. there are no syntax errors in source code, buffer size is sufficient,
+ *           and snapshot support is enabled in current configuration through JERRY_ENABLE_SNAPSHOT_SAVE),
+ *         0 - otherwise.
+ */
+size_t
+jerry_parse_and_save_snapshot (const jerry_char_t *source_p, /**< script source */
+                               size_t source_size, /**< script source size */
+                               bool is_for_global, /**< snapshot would be executed as global (true)
+                                                    *   or eval (false) */
+                               bool is_strict, /**< strict mode */
+                               uint32_t *buffer_p, /**< buffer to save snapshot to */
+                               size_t buffer_size) /**< the buffer's size */
+{
+#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+  return snapshot_parse_and_save (&source_p, &source_size, 1, is_for_global, is_strict, false, buffer_p, buffer_size);
 #else /* !JERRY_ENABLE_SNAPSHOT_SAVE */
   JERRY_UNUSED (source_p);
   JERRY_UNUSED (source_size);
@@ -580,26 +637,66 @@ jerry_parse_and_save_snapshot (const jerry_char_t *source_p, /**< script source
 } /* jerry_parse_and_save_snapshot */
 
 /**
- * Execute snapshot from specified buffer
+ * Generate one snapshot from several sources, e.g. the modules of an application, which
+ * is run by jerry_exec_multi_snapshot. The code of the sources shares one literal table,
+ * so a literal used by several of them is stored once.
  *
- * Note:
- *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ * @return size of snapshot, if it was generated succesfully
+ *          (i.e. there are no syntax errors in the sources, buffer size is sufficient,
+ *           and snapshot support is enabled in current configuration through JERRY_ENABLE_SNAPSHOT_SAVE),
+ *         0 - otherwise.
+ */
+size_t
+jerry_parse_and_save_multi_snapshot (const jerry_char_t * const *sources_p, /**< script sources */
+                                     const size_t *source_sizes_p, /**< script source sizes */
+                                     uint32_t source_count, /**< number of sources */
+                                     bool is_for_global, /**< snapshot would be executed as global (true)
+                                                          *   or eval (false) */
+                                     bool is_strict, /**< strict mode */
+                                     uint32_t *buffer_p, /**< buffer to save snapshot to */
+                                     size_t buffer_size) /**< the buffer's size */
+{
+#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+  if (source_count == 0)
+  {
+    return 0;
+  }
+
+  return snapshot_parse_and_save (sources_p,
+                                  source_sizes_p,
+                                  source_count,
+                                  is_for_global,
+                                  is_strict,
+                                  true,
+                                  buffer_p,
+                                  buffer_size);
+#else /* !JERRY_ENABLE_SNAPSHOT_SAVE */
+  JERRY_UNUSED (sources_p);
+  JERRY_UNUSED (source_sizes_p);
+  JERRY_UNUSED (source_count);
+  JERRY_UNUSED (is_for_global);
+  JERRY_UNUSED (is_strict);
+  JERRY_UNUSED (buffer_p);
+  JERRY_UNUSED (buffer_size);
+
+  return 0;
+#endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
+} /* jerry_parse_and_save_multi_snapshot */
+
+#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+
+/**
+ * Execute the code of a source of a snapshot
  *
  * @return result of bytecode - if run was successful
  *         thrown error - otherwise
  */
-jerry_value_t
-jerry_exec_snapshot (const uint32_t *snapshot_p, /**< snapshot */
-                     size_t snapshot_size, /**< size of snapshot */
-                     bool copy_bytecode) /**< flag, indicating whether the passed snapshot
-                                          *   buffer should be copied to the engine's memory.
-                                          *   If set the engine should not reference the buffer
-                                          *   after the function returns (in this case, the passed
-                                          *   buffer could be freed after the call).
-                                          *   Otherwise (if the flag is not set) - the buffer could only be
-                                          *   freed after the engine stops (i.e. after call to jerry_cleanup). */
+static jerry_value_t
+snapshot_exec (const uint32_t *snapshot_p, /**< snapshot */
+               size_t snapshot_size, /**< size of snapshot */
+               uint32_t source_index, /**< index of the source in the snapshot */
+               bool copy_bytecode) /**< byte code should be copied to memory */
 {
-#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
   JERRY_ASSERT (snapshot_p != NULL);
 
   static const char * const invalid_version_error_p = "Invalid snapshot version";
@@ -618,47 +715,57 @@ jerry_exec_snapshot (const uint32_t *snapshot_p, /**< snapshot */
     return ecma_raise_type_error (invalid_version_error_p);
   }
 
-  lit_mem_to_snapshot_id_map_entry_t *lit_map_p = NULL;
-  uint32_t literals_num;
-
-  if (header_p->lit_table_offset >= snapshot_size)
+  if (header_p->lit_table_offset >= snapshot_size
+      || header_p->lit_table_size > snapshot_size - header_p->lit_table_offset)
   {
     return ecma_raise_type_error (invalid_version_error_p);
   }
 
+  size_t code_offset = sizeof (jerry_snapshot_header_t);
+
+  if (source_index > 0)
+  {
+    /* The offsets of the sources follow the literal table. */
+    size_t module_table_offset = header_p->lit_table_offset + header_p->lit_table_size;
+    const uint32_t *module_table_p = (const uint32_t *) (snapshot_data_p + module_table_offset);
+
+    if (module_table_offset + sizeof (uint32_t) > snapshot_size
+        || source_index >= module_table_p[0]
+        || module_table_offset + (2 + source_index) * sizeof (uint32_t) > snapshot_size)
+    {
+      return ecma_raise_type_error (invalid_format_error_p);
+    }
+
+    code_offset = module_table_p[1 + source_index];
+
+    if (code_offset < sizeof (jerry_snapshot_header_t)
+        || code_offset >= header_p->lit_table_offset
+        || (code_offset & (JMEM_ALIGNMENT - 1)) != 0)
+    {
+      return ecma_raise_type_error (invalid_format_error_p);
+    }
+  }
+
   JERRY_ASSERT ((header_p->lit_table_offset % sizeof (uint32_t)) == 0);
-  if (!ecma_load_literals_from_snapshot ((uint32_t *) (snapshot_data_p + header_p->lit_table_offset),
+
+  /* Unless the byte code is copied, the snapshot is referenced until the engine stops,
+   * and so are the characters of the long literal strings. */
+  ecma_snapshot_literal_table_t lit_table;
+
+  if (!ecma_snapshot_literal_table_init (&lit_table,
+                                         (uint32_t *) (snapshot_data_p + header_p->lit_table_offset),
                                          header_p->lit_table_size,
-                                         &lit_map_p,
-                                         &literals_num))
+                                         !copy_bytecode))
   {
-    JERRY_ASSERT (lit_map_p == NULL);
     return ecma_raise_type_error (invalid_format_error_p);
   }
 
   ecma_compiled_code_t *bytecode_p;
   bytecode_p = snapshot_load_compiled_code (snapshot_data_p,
-                                            sizeof (jerry_snapshot_header_t),
-                                            lit_map_p,
+                                            code_offset,
+                                            &lit_table,
                                             copy_bytecode);
 
-  if (lit_map_p != NULL)
-  {
-    size_t size_to_free = literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t);
-    // Over-provision for full-bitwidth address overhead
-    #ifdef SEG_FULLBIT_ADDRESS_ALLOC
-    size_to_free += literals_num * 4;
-    #endif
-    // profiling of full-bitwidth overhead
-    sub_full_bitwidth_size(literals_num * 4);
-
-    #ifdef PROF_COUNT__SIZE_DETAILED
-    profile_add_count_size_detailed(13, -size_to_free); /* size detailed */
-    #endif
-
-    jmem_heap_free_block (lit_map_p, size_to_free);
-  }
-
   if (bytecode_p == NULL)
   {
     return ecma_raise_type_error (invalid_format_error_p);
@@ -677,6 +784,32 @@ jerry_exec_snapshot (const uint32_t *snapshot_p, /**< snapshot */
   }
 
   return ret_val;
+} /* snapshot_exec */
+
+#endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
+
+/**
+ * Execute snapshot from specified buffer
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return result of bytecode - if run was successful
+ *         thrown error - otherwise
+ */
+jerry_value_t
+jerry_exec_snapshot (const uint32_t *snapshot_p, /**< snapshot */
+                     size_t snapshot_size, /**< size of snapshot */
+                     bool copy_bytecode) /**< flag, indicating whether the passed snapshot
+                                          *   buffer should be copied to the engine's memory.
+                                          *   If set the engine should not reference the buffer
+                                          *   after the function returns (in this case, the passed
+                                          *   buffer could be freed after the call).
+                                          *   Otherwise (if the flag is not set) - the buffer could only be
+                                          *   freed after the engine stops (i.e. after call to jerry_cleanup). */
+{
+#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+  return snapshot_exec (snapshot_p, snapshot_size, 0, copy_bytecode);
 #else /* !JERRY_ENABLE_SNAPSHOT_EXEC */
   JERRY_UNUSED (snapshot_p);
   JERRY_UNUSED (snapshot_size);
@@ -686,6 +819,37 @@ jerry_exec_snapshot (const uint32_t *snapshot_p, /**< snapshot */
 #endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
 } /* jerry_exec_snapshot */
 
+/**
+ * Execute the code of one source of a snapshot saved by jerry_parse_and_save_multi_snapshot.
+ * The literals of the snapshot are created when the code refers to them, so only those of
+ * the sources which are run are in the memory. A snapshot of one source has the index 0.
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return result of bytecode - if run was successful
+ *         thrown error - otherwise
+ */
+jerry_value_t
+jerry_exec_multi_snapshot (const uint32_t *snapshot_p, /**< snapshot */
+                           size_t snapshot_size, /**< size of snapshot */
+                           uint32_t source_index, /**< index of the source in the snapshot */
+                           bool copy_bytecode) /**< flag, indicating whether the passed snapshot
+                                                *   buffer should be copied to the engine's memory,
+                                                *   as in jerry_exec_snapshot */
+{
+#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+  return snapshot_exec (snapshot_p, snapshot_size, source_index, copy_bytecode);
+#else /* !JERRY_ENABLE_SNAPSHOT_EXEC */
+  JERRY_UNUSED (snapshot_p);
+  JERRY_UNUSED (snapshot_size);
+  JERRY_UNUSED (source_index);
+  JERRY_UNUSED (copy_bytecode);
+
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_FALSE);
+#endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
+} /* jerry_exec_multi_snapshot */
+
 /**
  * @}
  */
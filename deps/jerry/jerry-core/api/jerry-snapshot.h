@@ -33,9 +33,17 @@ typedef struct
                             *   or as eval-mode code (false) */
 } jerry_snapshot_header_t;
 
+/*
+ * A snapshot of several sources, saved by jerry_parse_and_save_multi_snapshot, holds their
+ * code one after the other from the header on, and one literal table. It is followed by
+ * the module table: the number of sources and the offset of the code of each, as uint32_t
+ * values. The first source starts right after the header, like the only source of a
+ * snapshot saved by jerry_parse_and_save_snapshot.
+ */
+
 /**
  * Jerry snapshot format version
  */
-#define JERRY_SNAPSHOT_VERSION (7u)
+#define JERRY_SNAPSHOT_VERSION (9u)
 
 #endif /* !JERRY_SNAPSHOT_H */
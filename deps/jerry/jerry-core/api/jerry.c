@@ -15,9 +15,11 @@
 
 #include <stdio.h>
 
+#include "cptl-rmap-cache.h"
 #include "debugger.h"
 #include "ecma-alloc.h"
 #include "ecma-array-object.h"
+#include "ecma-arraybuffer-object.h"
 #include "ecma-builtin-helpers.h"
 #include "ecma-builtins.h"
 #include "ecma-exceptions.h"
@@ -31,11 +33,14 @@
 #include "ecma-objects.h"
 #include "ecma-objects-general.h"
 #include "ecma-promise-object.h"
+#include "ecma-typedarray-object.h"
 #include "jcontext.h"
 #include "jerryscript.h"
 #include "jmem.h"
+#include "jmem-heap-segmented.h"
 #include "js-parser.h"
 #include "re-compiler.h"
+#include "vm.h"
 
 // jmem-profiler
 #include "jmem-profiler.h"
@@ -56,7 +61,8 @@ JERRY_STATIC_ASSERT ((int) ECMA_INIT_EMPTY == (int) JERRY_INIT_EMPTY
                      && (int) ECMA_INIT_SHOW_OPCODES == (int) JERRY_INIT_SHOW_OPCODES
                      && (int) ECMA_INIT_SHOW_REGEXP_OPCODES == (int) JERRY_INIT_SHOW_REGEXP_OPCODES
                      && (int) ECMA_INIT_MEM_STATS == (int) JERRY_INIT_MEM_STATS
-                     && (int) ECMA_INIT_JMEM_LOGS_ENABLED == (int) JERRY_INIT_JMEM_LOGS_ENABLED,
+                     && (int) ECMA_INIT_JMEM_LOGS_ENABLED == (int) JERRY_INIT_JMEM_LOGS_ENABLED
+                     && (int) ECMA_INIT_PARSER_OPTIMIZE == (int) JERRY_INIT_PARSER_OPTIMIZE,
                      ecma_init_flag_t_must_be_equal_to_jerry_init_flag_t);
 
 #ifndef JERRY_JS_PARSER
@@ -195,6 +201,7 @@ jerry_cleanup (void)
     jmem_heap_free_block (this_p, sizeof (jerry_context_data_header_t) + this_p->manager_p->bytes_needed);
   }
 
+  vm_finalize_inline_caches ();
   ecma_finalize ();
   jmem_finalize ();
   jerry_make_api_unavailable ();
@@ -210,6 +217,199 @@ void jerry_set_heap_size_ptr(size_t* heap_size_ptr) {
   set_extern_heap_size_ptr(heap_size_ptr);
 }
 
+// jmem-profiler: structured output of all profilers (NULL path = stdout)
+bool jerry_set_jmem_profile_output(const char *path_p,
+                                   jerry_jmem_profile_format_t format) {
+#if defined(JMEM_PROFILE)
+  JERRY_STATIC_ASSERT (JERRY_JMEM_PROFILE_FORMAT_JSON == PROF_RECORD_FORMAT_JSON
+                       && JERRY_JMEM_PROFILE_FORMAT_CSV == PROF_RECORD_FORMAT_CSV,
+                       jmem_profile_formats_must_be_equal);
+  return set_profile_record_output(path_p, (int)format);
+#else
+  // jmem profilers are not built
+  JERRY_UNUSED(path_p);
+  JERRY_UNUSED(format);
+  return false;
+#endif
+}
+
+// jmem-profiler: runtime selection (a combination of
+// jerry_jmem_profile_category_t)
+uint32_t jerry_get_jmem_profile_categories(void) {
+  return get_profile_categories();
+}
+
+// False if a category is not built in; the others are selected anyway
+bool jerry_set_jmem_profile_categories(uint32_t categories) {
+  JERRY_STATIC_ASSERT (JERRY_JMEM_PROFILE_SIZE == PROF_CATEGORY_SIZE
+                       && JERRY_JMEM_PROFILE_TIME == PROF_CATEGORY_TIME
+                       && JERRY_JMEM_PROFILE_PMU == PROF_CATEGORY_PMU
+                       && JERRY_JMEM_PROFILE_CPTL == PROF_CATEGORY_CPTL
+                       && JERRY_JMEM_PROFILE_SEGMENT == PROF_CATEGORY_SEGMENT
+                       && JERRY_JMEM_PROFILE_JSOBJECT == PROF_CATEGORY_JSOBJECT
+                       && JERRY_JMEM_PROFILE_COUNT == PROF_CATEGORY_COUNT
+                       && JERRY_JMEM_PROFILE_SAMPLING == PROF_CATEGORY_SAMPLING
+                       && JERRY_JMEM_PROFILE_OPCODE == PROF_CATEGORY_OPCODE
+                       && JERRY_JMEM_PROFILE_CPU == PROF_CATEGORY_CPU
+                       && JERRY_JMEM_PROFILE_TRACE == PROF_CATEGORY_TRACE
+                       && JERRY_JMEM_PROFILE_ALL == PROF_CATEGORY_ALL,
+                       jmem_profile_categories_must_be_equal);
+  set_profile_categories(categories);
+  return (categories & ~get_built_in_profile_categories()) == 0;
+}
+
+// jmem-profiler: write sampled heap allocation sites in the folded stack
+// format of flame graph tools
+bool jerry_write_jmem_sampling_profile(const char *path_p) {
+  jerry_assert_api_available ();
+  return write_sampling_profile(path_p);
+}
+
+// jmem-profiler: a tick of the CPU profiler, from a timer signal handler. The
+// running JS call stack is sampled at the next execution stop check.
+void jerry_jmem_cpu_profile_tick(void) {
+  profile_cpu_tick();
+}
+
+// jmem-profiler: write the sampled JS call stacks in the folded stack format
+// of flame graph tools
+bool jerry_write_jmem_cpu_profile(const char *path_p) {
+  jerry_assert_api_available ();
+  return write_cpu_profile(path_p);
+}
+
+// idle-time garbage collection
+void jerry_free_unused_memory(void) {
+  jerry_assert_api_available ();
+  // Runs GC if worthwhile, and frees empty segment groups
+  jmem_run_free_unused_memory_callbacks(JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW);
+}
+
+// memory governor: heap usage as the GC trigger counts it
+size_t jerry_get_heap_usage(size_t *heap_size_p) {
+  jerry_assert_api_available ();
+  if (heap_size_p != NULL) {
+    *heap_size_p = JMEM_HEAP_SIZE;
+  }
+  size_t usage, peak_usage;
+  jmem_heap_get_usage_stats(&usage, &peak_usage);
+  return usage;
+}
+
+// memory governor: also gives up the caches and retained segments
+void jerry_free_unused_memory_critical(void) {
+  jerry_assert_api_available ();
+  jmem_run_free_unused_memory_callbacks(JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH);
+}
+
+// memory usage: the heap usage with its peak, the pools and the segments
+void jerry_get_heap_usage_stats(jerry_heap_usage_t *out_stats_p) {
+  jerry_assert_api_available ();
+  memset(out_stats_p, 0, sizeof(jerry_heap_usage_t));
+  out_stats_p->size = JMEM_HEAP_SIZE;
+  jmem_heap_get_usage_stats(&out_stats_p->allocated_size,
+                            &out_stats_p->peak_allocated_size);
+  out_stats_p->pool_free_size = jmem_pools_get_free_size();
+#ifdef JMEM_SEGMENTED_HEAP
+  out_stats_p->segment_count = JERRY_HEAP_CONTEXT(segments_count);
+  out_stats_p->segment_size = SEG_SEGMENT_SIZE;
+  for (uint32_t sidx = 0; sidx < SEG_NUM_SEGMENTS; sidx++) {
+    if (JERRY_HEAP_CONTEXT(area[sidx]) != NULL) {
+      out_stats_p->segment_occupied_size +=
+          JERRY_HEAP_CONTEXT(segments[sidx]).occupied_size;
+    }
+  }
+#endif /* JMEM_SEGMENTED_HEAP */
+}
+
+// memory usage: the occupied size of each allocated segment, in the order of
+// the segments, up to max_count of them. Returns the count of the segments.
+uint32_t jerry_get_segment_occupancy(size_t *occupied_sizes_p,
+                                     uint32_t max_count) {
+  jerry_assert_api_available ();
+  uint32_t count = 0;
+#ifdef JMEM_SEGMENTED_HEAP
+  for (uint32_t sidx = 0; sidx < SEG_NUM_SEGMENTS; sidx++) {
+    if (JERRY_HEAP_CONTEXT(area[sidx]) == NULL) {
+      continue;
+    }
+    if (count < max_count) {
+      occupied_sizes_p[count] = JERRY_HEAP_CONTEXT(segments[sidx]).occupied_size;
+    }
+    count++;
+  }
+#else /* !JMEM_SEGMENTED_HEAP */
+  JERRY_UNUSED(occupied_sizes_p);
+  JERRY_UNUSED(max_count);
+#endif /* JMEM_SEGMENTED_HEAP */
+  return count;
+}
+
+// GC-free regions: reserve the headroom, and suppress GC until the end
+bool jerry_begin_no_gc_region(size_t reserved_size) {
+  jerry_assert_api_available ();
+  return jmem_heap_begin_no_gc_region(reserved_size);
+}
+
+// GC-free regions: true if the region has allocated more than its headroom
+bool jerry_end_no_gc_region(void) {
+  jerry_assert_api_available ();
+  return jmem_heap_end_no_gc_region();
+}
+
+// segmented heap: segment size (before jerry_init)
+bool jerry_set_segment_size(uint32_t segment_size) {
+  if (unlikely (JERRY_CONTEXT (jerry_api_available)))
+  {
+    /* Segment size cannot be changed while the heap is alive. */
+    return false;
+  }
+#if defined(JMEM_SEGMENTED_HEAP) && defined(SEG_RUNTIME_SEGMENT_SIZE)
+  return set_segment_size(segment_size);
+#else
+  // Segment size is fixed at build time
+  JERRY_UNUSED(segment_size);
+  return false;
+#endif
+}
+
+// segmented heap: empty segments kept after GC (watermarks), and GCs they are
+// kept for above the low watermark
+bool jerry_set_segment_retention(uint32_t low, uint32_t high, uint32_t age) {
+  jerry_assert_api_available ();
+#if defined(JMEM_SEGMENTED_HEAP) && defined(SEG_SEGMENT_RETENTION)
+  return set_segment_retention(low, high, age);
+#else
+  // Empty segments are freed at once
+  JERRY_UNUSED(low);
+  JERRY_UNUSED(high);
+  JERRY_UNUSED(age);
+  return false;
+#endif
+}
+
+// segmented heap: reverse map cache
+bool jerry_set_rmap_cache_config(uint32_t size, uint32_t set_size,
+                                 jerry_rmap_cache_policy_t policy,
+                                 bool is_adaptive) {
+  jerry_assert_api_available ();
+#if defined(JMEM_SEGMENTED_HEAP) && defined(SEG_RMAP_CACHE) \
+    && defined(SEG_RMAP_CACHE_ADAPTIVE)
+  JERRY_STATIC_ASSERT (JERRY_RMAP_CACHE_POLICY_FIFO == SEG_RMAP_CACHE_POLICY_FIFO
+                       && JERRY_RMAP_CACHE_POLICY_LRU == SEG_RMAP_CACHE_POLICY_LRU
+                       && JERRY_RMAP_CACHE_POLICY_CLOCK == SEG_RMAP_CACHE_POLICY_CLOCK,
+                       rmap_cache_policies_must_be_equal);
+  return configure_rmap_cache(size, set_size, (uint32_t)policy, is_adaptive);
+#else
+  // Reverse map cache is not runtime-configurable
+  JERRY_UNUSED(size);
+  JERRY_UNUSED(set_size);
+  JERRY_UNUSED(policy);
+  JERRY_UNUSED(is_adaptive);
+  return false;
+#endif
+}
+
 /**
  * Retrieve a context data item, or create a new one.
  *
@@ -265,6 +465,23 @@ jerry_register_magic_strings (const jerry_char_ptr_t *ex_str_items_p, /**< chara
   lit_magic_strings_ex_set ((const lit_utf8_byte_t **) ex_str_items_p, count, (const lit_utf8_size_t *) str_lengths_p);
 } /* jerry_register_magic_strings */
 
+/**
+ * Register the perfect hash of the external magic string array
+ *
+ * Note:
+ *      the external magic strings must be registered before
+ */
+void
+jerry_register_magic_strings_hash (const uint16_t *displacements_p, /**< bucket displacements */
+                                   uint32_t displacement_count, /**< number of buckets */
+                                   const uint16_t *slots_p, /**< string indices of the hash slots */
+                                   uint32_t slot_count) /**< number of slots */
+{
+  jerry_assert_api_available ();
+
+  lit_magic_strings_ex_hash_set (displacements_p, displacement_count, slots_p, slot_count);
+} /* jerry_register_magic_strings_hash */
+
 /**
  * Get Jerry configured memory limits
  */
@@ -279,15 +496,124 @@ jerry_get_memory_limits (size_t *out_data_bss_brk_limit_p, /**< [out] Jerry's ma
 
 /**
  * Run garbage collection
+ *
+ * Note:
+ *      nothing is done in a GC-free region
  */
 void
 jerry_gc (void)
 {
   jerry_assert_api_available ();
 
+  if (jmem_is_gc_suppressed ())
+  {
+    return;
+  }
+
   ecma_gc_run (JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW);
 } /* jerry_gc */
 
+/**
+ * Perform a bounded slice of incremental garbage collection.
+ *
+ * Note:
+ *      nothing is done in a GC-free region,
+ *      with JMEM_LAZY_SWEEP, the dead objects left by the last collection are freed first,
+ *      without incremental garbage collector nor lazy sweeping, this function does nothing
+ *
+ * @return true - if no garbage collection cycle is in progress after the call,
+ *         false - if the caller should call this function again later
+ */
+bool
+jerry_gc_step (uint32_t budget) /**< maximum number of objects to examine */
+{
+  jerry_assert_api_available ();
+
+  if (jmem_is_gc_suppressed ())
+  {
+    JERRY_UNUSED (budget);
+    return false;
+  }
+
+#ifdef JMEM_INCREMENTAL_GC
+  return ecma_gc_incremental_step (budget > 0 ? budget : 1);
+#elif defined (JMEM_LAZY_SWEEP)
+  return ecma_gc_sweep_step (budget > 0 ? budget : 1);
+#else /* !JMEM_INCREMENTAL_GC && !JMEM_LAZY_SWEEP */
+  JERRY_UNUSED (budget);
+  return true;
+#endif /* JMEM_INCREMENTAL_GC */
+} /* jerry_gc_step */
+
+/**
+ * Set the adaptive trigger of garbage collection.
+ *
+ * The heap may grow by the growth percent of its usage after a collection before the next
+ * collection. The growth is raised while the collections are too close or free little,
+ * and bounded by the pause budget and by the reserve of the heap.
+ *
+ * Note:
+ *      a growth of 0 percent restores the fixed trigger
+ */
+void
+jerry_set_gc_trigger (const jerry_gc_trigger_t *trigger_p) /**< knobs of the trigger */
+{
+  jerry_assert_api_available ();
+
+  JERRY_CONTEXT (ecma_gc_trigger) = *trigger_p;
+  ecma_gc_apply_trigger ();
+} /* jerry_set_gc_trigger */
+
+/**
+ * Get the knobs of the adaptive trigger of garbage collection.
+ */
+void
+jerry_get_gc_trigger (jerry_gc_trigger_t *out_trigger_p) /**< [out] knobs of the trigger */
+{
+  jerry_assert_api_available ();
+
+  *out_trigger_p = JERRY_CONTEXT (ecma_gc_trigger);
+} /* jerry_get_gc_trigger */
+
+/**
+ * Get the state of the garbage collections: the last pause, the allocation and survival rates,
+ * and the heap usage which triggers the next collection.
+ */
+void
+jerry_get_gc_stats (jerry_gc_stats_t *out_stats_p) /**< [out] state of the collections */
+{
+  jerry_assert_api_available ();
+
+  *out_stats_p = JERRY_CONTEXT (ecma_gc_stats);
+} /* jerry_get_gc_stats */
+
+/**
+ * Write the live objects of the heap and their references to a snapshot file.
+ *
+ * Note:
+ *      garbage is collected before the snapshot is taken
+ *
+ * @return true - if the snapshot is written,
+ *         false - otherwise. Usually it is because the JMEM_HEAP_SNAPSHOT feature is not enabled.
+ */
+bool
+jerry_write_heap_snapshot (const char *path_p) /**< path of the snapshot file */
+{
+  jerry_assert_api_available ();
+
+#ifdef JMEM_HEAP_SNAPSHOT
+  if (path_p == NULL)
+  {
+    return false;
+  }
+
+  return ecma_gc_write_heap_snapshot (path_p);
+#else /* !JMEM_HEAP_SNAPSHOT */
+  JERRY_UNUSED (path_p);
+  return false;
+#endif /* JMEM_HEAP_SNAPSHOT */
+} /* jerry_write_heap_snapshot */
+
 /**
  * Get heap memory stats.
  *
@@ -425,12 +751,13 @@ jerry_parse_named_resource (const jerry_char_t *name_p, /**< name (usually a fil
                                 name_p,
                                 name_length);
   }
-#else /* JERRY_DEBUGGER */
-  JERRY_UNUSED (name_p);
-  JERRY_UNUSED (name_length);
 #endif /* JERRY_DEBUGGER */
 
-  return jerry_parse (source_p, source_size, is_strict);
+  /* Functions of the source are attributed to the name by the jmem profilers. */
+  profile_code_set_resource (name_p, name_length);
+  jerry_value_t ret_value = jerry_parse (source_p, source_size, is_strict);
+  profile_code_set_resource (NULL, 0);
+  return ret_value;
 } /* jerry_parse_named_resource */
 
 /**
@@ -512,12 +839,54 @@ jerry_run_all_enqueued_jobs (void)
   jerry_assert_api_available ();
 
 #ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
-  return ecma_process_all_enqueued_jobs ();
+  return ecma_process_enqueued_jobs (0);
 #else /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
   return ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
 #endif /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
 } /* jerry_run_all_enqueued_jobs */
 
+/**
+ * Run enqueued Promise jobs until the first thrown error, until all get executed,
+ * or until the time budget is used up. Jobs enqueued by the executed jobs are also
+ * executed, so a budget keeps a long chain of jobs from starving the caller.
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return result of last executed job, may be error value.
+ */
+jerry_value_t
+jerry_run_enqueued_jobs (uint32_t time_budget_ms) /**< time budget in milliseconds,
+                                                   *   0 - run all jobs */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
+  return ecma_process_enqueued_jobs (time_budget_ms);
+#else /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+  JERRY_UNUSED (time_budget_ms);
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+#endif /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+} /* jerry_run_enqueued_jobs */
+
+/**
+ * Check whether there are enqueued Promise jobs.
+ *
+ * @return true - if there are jobs to run,
+ *         false - otherwise
+ */
+bool
+jerry_has_enqueued_jobs (void)
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
+  return ecma_has_enqueued_jobs ();
+#else /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+  return false;
+#endif /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+} /* jerry_has_enqueued_jobs */
+
 /**
  * Get global object
  *
@@ -549,6 +918,25 @@ jerry_value_is_array (const jerry_value_t value) /**< jerry api value */
           && ecma_get_object_type (ecma_get_object_from_value (value)) == ECMA_OBJECT_TYPE_ARRAY);
 } /* jerry_value_is_array */
 
+/**
+ * Check if the specified value is an ArrayBuffer object.
+ *
+ * @return true  - if the specified value is an ArrayBuffer object,
+ *         false - otherwise (also if the ArrayBuffer built-in is disabled)
+ */
+bool
+jerry_value_is_arraybuffer (const jerry_value_t value) /**< jerry api value */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+  return ecma_is_arraybuffer (value);
+#else /* CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  JERRY_UNUSED (value);
+  return false;
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+} /* jerry_value_is_arraybuffer */
+
 /**
  * Check if the specified value is boolean.
  *
@@ -633,8 +1021,6 @@ jerry_value_is_object (const jerry_value_t value) /**< api value */
   return ecma_is_value_object (value);
 } /* jerry_value_is_object */
 
-#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
-
 /**
  * Check if the specified value is promise.
  *
@@ -646,11 +1032,14 @@ jerry_value_is_promise (const jerry_value_t value) /**< api value */
 {
   jerry_assert_api_available ();
 
+#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
   return (ecma_is_value_object (value)
           && ecma_is_promise (ecma_get_object_from_value (value)));
-} /* jerry_value_is_promise */
-
+#else /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+  JERRY_UNUSED (value);
+  return false;
 #endif /* !CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+} /* jerry_value_is_promise */
 
 /**
  * Check if the specified value is string.
@@ -666,6 +1055,25 @@ jerry_value_is_string (const jerry_value_t value) /**< api value */
   return ecma_is_value_string (value);
 } /* jerry_value_is_string */
 
+/**
+ * Check if the specified value is a TypedArray object.
+ *
+ * @return true  - if the specified value is a TypedArray object,
+ *         false - otherwise (also if the TypedArray built-ins are disabled)
+ */
+bool
+jerry_value_is_typedarray (const jerry_value_t value) /**< jerry api value */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+  return ecma_is_typedarray (value);
+#else /* CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  JERRY_UNUSED (value);
+  return false;
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+} /* jerry_value_is_typedarray */
+
 /**
  * Check if the specified value is undefined.
  *
@@ -721,6 +1129,12 @@ bool jerry_is_feature_enabled (const jerry_feature_t feature)
 #ifdef JERRY_VM_EXEC_STOP
           || feature == JERRY_FEATURE_VM_EXEC_STOP
 #endif /* JERRY_VM_EXEC_STOP */
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+          || feature == JERRY_FEATURE_TYPEDARRAY
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
+          || feature == JERRY_FEATURE_PROMISE
+#endif /* !CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
           );
 } /* jerry_is_feature_enabled */
 
@@ -1118,8 +1532,6 @@ jerry_create_object (void)
   return ecma_make_object_value (ecma_op_create_object_object_noarg ());
 } /* jerry_create_object */
 
-#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
-
 /**
  * Create an empty Promise object which can be resolve/reject later
  * by calling jerry_resolve_or_reject_promise.
@@ -1128,17 +1540,20 @@ jerry_create_object (void)
  *      returned value must be freed with jerry_release_value, when it is no longer needed.
  *
  * @return value of the created object
+ *         error - if the Promise built-in is disabled
  */
 jerry_value_t
 jerry_create_promise (void)
 {
   jerry_assert_api_available ();
 
+#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
   return ecma_op_create_promise_object (ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY), ECMA_PROMISE_EXECUTOR_EMPTY);
+#else /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+  return ecma_raise_type_error (ECMA_ERR_MSG ("Promise is not supported."));
+#endif /* !CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
 } /* jerry_create_promise */
 
-#endif /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
-
 /**
  * Create string from a valid UTF-8 string
  *
@@ -1206,6 +1621,30 @@ jerry_create_string_sz (const jerry_char_t *str_p, /**< pointer to string */
   return ecma_make_string_value (ecma_str_p);
 } /* jerry_create_string_sz */
 
+/**
+ * Create string from a valid CESU-8 string, which is kept outside of the engine heap
+ *
+ * Note:
+ *      the string takes the characters over, and calls free_cb with str_p when they
+ *      are no longer needed; the characters must not change until then. Short strings
+ *      are copied onto the heap, and free_cb is called before returning.
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return value of the created string
+ */
+jerry_value_t
+jerry_create_external_string_sz (const jerry_char_t *str_p, /**< pointer to string */
+                                 jerry_size_t str_size, /**< string size */
+                                 jerry_object_native_free_callback_t free_cb) /**< frees the string, or NULL */
+{
+  jerry_assert_api_available ();
+
+  ecma_string_t *ecma_str_p = ecma_new_ecma_external_string ((const lit_utf8_byte_t *) str_p,
+                                                             (lit_utf8_size_t) str_size,
+                                                             free_cb);
+  return ecma_make_string_value (ecma_str_p);
+} /* jerry_create_external_string_sz */
+
 /**
  * Creates a jerry_value_t representing an undefined value.
  *
@@ -1250,6 +1689,163 @@ jerry_get_array_length (const jerry_value_t value)
   return length;
 } /* jerry_get_array_length */
 
+/**
+ * Create an ArrayBuffer object with a zero filled data buffer on the engine heap
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return value of the created ArrayBuffer object
+ *         error - if the ArrayBuffer built-in is disabled
+ */
+jerry_value_t
+jerry_create_arraybuffer (const jerry_length_t size) /**< size of the data buffer */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+  return ecma_make_object_value (ecma_arraybuffer_new_object (size));
+#else /* CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  JERRY_UNUSED (size);
+  return ecma_raise_type_error (ECMA_ERR_MSG ("ArrayBuffer and TypedArray are not supported."));
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+} /* jerry_create_arraybuffer */
+
+/**
+ * Create an ArrayBuffer object over a data buffer allocated by the application
+ *
+ * The data buffer is used in place, without copying: typed arrays created over the
+ * ArrayBuffer read and write the memory of the application. It must stay valid
+ * until the free callback is called, which happens when the ArrayBuffer is garbage
+ * collected. A NULL callback leaves the buffer to the application.
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return value of the created ArrayBuffer object
+ *         error - if the ArrayBuffer built-in is disabled
+ */
+jerry_value_t
+jerry_create_arraybuffer_external (const jerry_length_t size, /**< size of the data buffer */
+                                   uint8_t *buffer_p, /**< data buffer */
+                                   jerry_object_native_free_callback_t free_cb) /**< callback which frees the
+                                                                                 *   data buffer, or NULL */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+  if (buffer_p == NULL && size > 0)
+  {
+    return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
+  }
+
+  return ecma_make_object_value (ecma_arraybuffer_new_object_external (size, buffer_p, free_cb));
+#else /* CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  JERRY_UNUSED (size);
+  JERRY_UNUSED (buffer_p);
+  JERRY_UNUSED (free_cb);
+  return ecma_raise_type_error (ECMA_ERR_MSG ("ArrayBuffer and TypedArray are not supported."));
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+} /* jerry_create_arraybuffer_external */
+
+/**
+ * Get the size of the data buffer of an ArrayBuffer object
+ *
+ * Note:
+ *      Returns 0, if the value parameter is not an ArrayBuffer object.
+ *
+ * @return size of the data buffer in bytes
+ */
+jerry_length_t
+jerry_get_arraybuffer_byte_length (const jerry_value_t value) /**< ArrayBuffer object */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+  if (ecma_is_arraybuffer (value))
+  {
+    return ecma_arraybuffer_get_length (ecma_get_object_from_value (value));
+  }
+#else /* CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  JERRY_UNUSED (value);
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  return 0;
+} /* jerry_get_arraybuffer_byte_length */
+
+/**
+ * Get the data buffer of an ArrayBuffer object
+ *
+ * Note:
+ *      The pointer of a data buffer on the engine heap is only valid while the
+ *      ArrayBuffer is alive and no JavaScript code runs, as the garbage collector
+ *      may free the object.
+ *
+ * @return pointer to the data buffer
+ *         NULL - if the value parameter is not an ArrayBuffer object
+ */
+uint8_t *
+jerry_get_arraybuffer_pointer (const jerry_value_t value) /**< ArrayBuffer object */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+  if (ecma_is_arraybuffer (value))
+  {
+    return (uint8_t *) ecma_arraybuffer_get_buffer (ecma_get_object_from_value (value));
+  }
+#else /* CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  JERRY_UNUSED (value);
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  return NULL;
+} /* jerry_get_arraybuffer_pointer */
+
+/**
+ * Get the ArrayBuffer viewed by a TypedArray object, and the byte range of the view
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return value of the ArrayBuffer object
+ *         error - if the value parameter is not a TypedArray object
+ */
+jerry_value_t
+jerry_get_typedarray_buffer (const jerry_value_t value, /**< TypedArray object */
+                             jerry_length_t *byte_offset_p, /**< [out] start of the view in the ArrayBuffer,
+                                                             *   if not NULL */
+                             jerry_length_t *byte_length_p) /**< [out] size of the view in bytes, if not NULL */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+  if (!ecma_is_typedarray (value))
+  {
+    return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
+  }
+
+  ecma_object_t *typedarray_p = ecma_get_object_from_value (value);
+
+  if (byte_offset_p != NULL)
+  {
+    *byte_offset_p = ecma_typedarray_get_offset (typedarray_p);
+  }
+
+  if (byte_length_p != NULL)
+  {
+    uint8_t shift = ecma_typedarray_get_element_size_shift (typedarray_p);
+    *byte_length_p = ecma_typedarray_get_length (typedarray_p) << shift;
+  }
+
+  ecma_object_t *arraybuffer_p = ecma_typedarray_get_arraybuffer (typedarray_p);
+  ecma_ref_object (arraybuffer_p);
+  return ecma_make_object_value (arraybuffer_p);
+#else /* CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+  JERRY_UNUSED (value);
+  JERRY_UNUSED (byte_offset_p);
+  JERRY_UNUSED (byte_length_p);
+  return ecma_raise_type_error (ECMA_ERR_MSG ("ArrayBuffer and TypedArray are not supported."));
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+} /* jerry_get_typedarray_buffer */
+
 /**
  * Get size of Jerry string
  *
@@ -1368,6 +1964,45 @@ jerry_string_to_char_buffer (const jerry_value_t value, /**< input string value
                                            buffer_size);
 } /* jerry_string_to_char_buffer */
 
+/**
+ * Get the characters of a string without copying them.
+ *
+ * Note:
+ *      The characters are cesu-8 encoded, and are not zero terminated. They
+ *      are valid as long as the string value is alive.
+ *
+ * @return pointer to the characters - if the string keeps them in one piece
+ *         NULL - otherwise (the characters have to be copied out by
+ *                jerry_string_to_char_buffer)
+ */
+const jerry_char_t *
+jerry_get_string_chars (const jerry_value_t value, /**< input string value */
+                        jerry_size_t *size_p) /**< [out] size of the characters */
+{
+  jerry_assert_api_available ();
+
+  *size_p = 0;
+
+  if (!ecma_is_value_string (value))
+  {
+    return NULL;
+  }
+
+  lit_utf8_size_t size;
+  bool is_ascii;
+  const lit_utf8_byte_t *chars_p = ecma_string_raw_chars (ecma_get_string_from_value (value),
+                                                          &size,
+                                                          &is_ascii);
+
+  if (chars_p == NULL)
+  {
+    return NULL;
+  }
+
+  *size_p = (jerry_size_t) size;
+  return (const jerry_char_t *) chars_p;
+} /* jerry_get_string_chars */
+
 /**
  * Copy the characters of an utf-8 encoded string into a specified buffer.
  *
@@ -2069,6 +2704,8 @@ jerry_set_prototype (const jerry_value_t obj_val, /**< object value */
     return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
   }
 
+  ECMA_GC_WRITE_BARRIER (ecma_get_object_from_value (obj_val));
+
   if (ecma_is_value_null (proto_obj_val))
   {
     ECMA_SET_POINTER (ecma_get_object_from_value (obj_val)->prototype_or_outer_reference_cp, NULL);
@@ -2236,7 +2873,8 @@ jerry_foreach_object_property (const jerry_value_t obj_val, /**< object value */
 
   ecma_collection_iterator_t names_iter;
   ecma_object_t *object_p = ecma_get_object_from_value (obj_val);
-  ecma_collection_header_t *names_p = ecma_op_object_get_property_names (object_p, false, true, true);
+  bool is_shared;
+  ecma_collection_header_t *names_p = ecma_op_object_get_enumerable_property_names (object_p, true, &is_shared);
   ecma_collection_iterator_init (&names_iter, names_p);
 
   ecma_value_t property_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
@@ -2258,7 +2896,7 @@ jerry_foreach_object_property (const jerry_value_t obj_val, /**< object value */
     ecma_free_value (property_value);
   }
 
-  ecma_free_values_collection (names_p, true);
+  ecma_op_object_free_enumerable_property_names (names_p, is_shared);
 
   if (!ECMA_IS_VALUE_ERROR (property_value))
   {
@@ -2269,8 +2907,6 @@ jerry_foreach_object_property (const jerry_value_t obj_val, /**< object value */
   return false;
 } /* jerry_foreach_object_property */
 
-#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
-
 /**
  * Resolve or reject the promise with an argument.
  *
@@ -2284,6 +2920,7 @@ jerry_resolve_or_reject_promise (jerry_value_t promise, /**< the promise value *
 {
   jerry_assert_api_available ();
 
+#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
   if (!ecma_is_value_object (promise) || !ecma_is_promise (ecma_get_object_from_value (promise)))
   {
     return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
@@ -2310,9 +2947,13 @@ jerry_resolve_or_reject_promise (jerry_value_t promise, /**< the promise value *
   ecma_free_value (function);
 
   return ret;
-} /* jerry_resolve_or_reject_promise */
-
+#else /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+  JERRY_UNUSED (promise);
+  JERRY_UNUSED (argument);
+  JERRY_UNUSED (is_resolve);
+  return ecma_raise_type_error (ECMA_ERR_MSG ("Promise is not supported."));
 #endif /* !CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+} /* jerry_resolve_or_reject_promise */
 
 /**
  * Validate UTF-8 string
@@ -2419,7 +3060,8 @@ jerry_create_instance (uint32_t heap_size, /**< the size of heap */
 /**
  * If JERRY_VM_EXEC_STOP is defined the callback passed to this function is
  * periodically called with the user_p argument. If frequency is greater
- * than 1, the callback is only called at every frequency ticks.
+ * than 1, the callback is only called at every frequency ticks. If frequency
+ * is 0, the callback is only called after jerry_request_vm_exec_stop.
  */
 void
 jerry_set_vm_exec_stop_callback (jerry_vm_exec_stop_callback_t stop_cb, /**< periodically called user function */
@@ -2427,15 +3069,15 @@ jerry_set_vm_exec_stop_callback (jerry_vm_exec_stop_callback_t stop_cb, /**< per
                                  uint32_t frequency) /**< frequency of the function call */
 {
 #ifdef JERRY_VM_EXEC_STOP
-  if (frequency == 0)
-  {
-    frequency = 1;
-  }
-
   JERRY_CONTEXT (vm_exec_stop_frequency) = frequency;
   JERRY_CONTEXT (vm_exec_stop_counter) = frequency;
   JERRY_CONTEXT (vm_exec_stop_user_p) = user_p;
   JERRY_CONTEXT (vm_exec_stop_cb) = stop_cb;
+
+  /* A periodic callback is checked at every tick, the others only once a stop is requested.
+   * The requests made for an earlier callback are dropped. */
+  JERRY_CONTEXT (vm_exec_stop_requested) = 0;
+  JERRY_CONTEXT (vm_exec_stop_pending) = (stop_cb != NULL && frequency != 0) ? 1 : 0;
 #else /* !JERRY_VM_EXEC_STOP */
   JERRY_UNUSED (stop_cb);
   JERRY_UNUSED (user_p);
@@ -2443,6 +3085,22 @@ jerry_set_vm_exec_stop_callback (jerry_vm_exec_stop_callback_t stop_cb, /**< per
 #endif /* JERRY_VM_EXEC_STOP */
 } /* jerry_set_vm_exec_stop_callback */
 
+/**
+ * Requests the VM to call the execution stop callback at the next backward jump
+ * or caught exception, regardless of its frequency.
+ *
+ * Only a flag is set here, so the function can be called from a signal handler.
+ * The request is kept until the callback is called.
+ */
+void
+jerry_request_vm_exec_stop (void)
+{
+#ifdef JERRY_VM_EXEC_STOP
+  JERRY_CONTEXT (vm_exec_stop_requested) = 1;
+  JERRY_CONTEXT (vm_exec_stop_pending) = 1;
+#endif /* JERRY_VM_EXEC_STOP */
+} /* jerry_request_vm_exec_stop */
+
 /**
  * @}
  */
@@ -68,11 +68,139 @@
  */
 // #define CONFIG_ECMA_LCACHE_DISABLE
 
+/**
+ * Enable inline caches of property accesses in the VM
+ *
+ * Each get / put property site of the byte code caches the properties
+ * found by the lookup cache for the last few objects it accessed.
+ */
+// #define CONFIG_VM_INLINE_CACHE
+
+#ifdef CONFIG_VM_INLINE_CACHE
+# define CONFIG_VM_INLINE_CACHE_SIZE (128) /* number of entries, a power of 2 */
+# define CONFIG_VM_INLINE_CACHE_WAYS (2) /* objects cached by an entry */
+#endif /* CONFIG_VM_INLINE_CACHE */
+
+/**
+ * Enable the cache of enumerated property names
+ *
+ * The names listed by for-in, Object.keys and JSON.stringify are kept for the last
+ * few general objects enumerated, and reused until a property is added to or
+ * deleted from the objects or their prototypes. A for-in loop iterates the cached
+ * list itself, so it allocates nothing when the list is reused.
+ */
+// #define CONFIG_ECMA_ENUM_CACHE
+
+#ifdef CONFIG_ECMA_ENUM_CACHE
+# define CONFIG_ECMA_ENUM_CACHE_SIZE (16) /* number of cached name lists, a power of 2 */
+# define CONFIG_ECMA_ENUM_CACHE_WATCH_SIZE (64) /* number of watched objects, a power of 2 */
+# define CONFIG_ECMA_ENUM_CACHE_CHAIN_LENGTH (4) /* objects of a cached prototype chain */
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
+/**
+ * Enable threaded dispatch of opcodes in the VM
+ *
+ * The opcode handlers of vm_loop are reached by computed goto instead of the
+ * switch, if the compiler supports labels as values (GCC and Clang).
+ */
+// #define CONFIG_VM_THREADED_DISPATCH
+
+/**
+ * Enable lazy compilation of nested functions
+ *
+ * The parser only scans the body of a function nested in another function, and
+ * keeps a copy of its source instead of the byte code. The function is compiled
+ * when it is called first. Syntax errors which are not found by the scan are
+ * reported by the first call. Builds saving snapshots or supporting the debugger
+ * always compile functions when parsing them.
+ */
+// #define CONFIG_PARSER_LAZY_FUNCTIONS
+
 /**
  * Disable ECMA property hashmap
  */
 // #define CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE
 
+/**
+ * Minimum number of named properties of an object to create a property hashmap for it
+ *
+ * Every object has its own hashmap, so objects created in large numbers by the
+ * same constructor duplicate it. Raising the limit trades lookup speed of these
+ * objects for memory; the lookup and inline caches still serve repeated lookups.
+ */
+#ifndef CONFIG_ECMA_PROPERTY_HASHMAP_MIN_PROPERTIES
+# define CONFIG_ECMA_PROPERTY_HASHMAP_MIN_PROPERTIES (16)
+#endif /* !CONFIG_ECMA_PROPERTY_HASHMAP_MIN_PROPERTIES */
+
+/**
+ * Disable interning of property names
+ *
+ * Otherwise the properties named by equal strings created at run-time, e.g. by JSON.parse,
+ * share a single string of at most CONFIG_ECMA_PROPERTY_NAME_INTERN_MAX_SIZE bytes.
+ */
+// #define CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_MAX_SIZE
+# define CONFIG_ECMA_PROPERTY_NAME_INTERN_MAX_SIZE (32)
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_MAX_SIZE */
+
+/**
+ * Enable rope strings
+ *
+ * Concatenating strings into a string of at least CONFIG_ECMA_ROPE_STRING_MIN_SIZE
+ * bytes creates a rope referring to the operands instead of copying them. The rope
+ * is flattened into a single buffer when its characters are accessed first, so
+ * building a string by repeated concatenation copies it only once.
+ */
+// #define CONFIG_ECMA_ROPE_STRING
+
+#ifdef CONFIG_ECMA_ROPE_STRING
+# define CONFIG_ECMA_ROPE_STRING_MIN_SIZE (64) /* must be above LIT_MAGIC_STRING_LENGTH_LIMIT */
+#endif /* CONFIG_ECMA_ROPE_STRING */
+
+/**
+ * Minimum size of external strings
+ *
+ * Shorter strings given to jerry_create_external_string_sz are copied onto the heap,
+ * where they take less memory than the descriptor of an external string.
+ */
+#ifndef CONFIG_ECMA_EXTERNAL_STRING_MIN_SIZE
+# define CONFIG_ECMA_EXTERNAL_STRING_MIN_SIZE (64) /* must be above LIT_MAGIC_STRING_LENGTH_LIMIT */
+#endif /* !CONFIG_ECMA_EXTERNAL_STRING_MIN_SIZE */
+
+/**
+ * Enable fast arrays
+ *
+ * The elements of an array are stored in a contiguous buffer of values instead
+ * of index named properties, as long as all of them are writable, enumerable and
+ * configurable data properties and the array has few holes. Otherwise the array
+ * falls back to the property form once and for all.
+ */
+// #define CONFIG_ECMA_FAST_ARRAY
+
+#if (defined (CONFIG_ECMA_FAST_ARRAY) && defined (JERRY_CPOINTER_32_BIT))
+#  error "Fast arrays need 16 bit compressed pointers to fit into the extended object"
+#endif
+
+/**
+ * Enable inline property pairs
+ *
+ * General objects and lexical environments are allocated together with their first
+ * property pair, which holds their first two properties. This saves one allocation,
+ * and its overhead, for each object with properties, at the cost of the size of a
+ * property pair for each object without properties.
+ */
+// #define CONFIG_ECMA_INLINE_PROPERTY_PAIR
+
+/**
+ * Disable SIMD instructions in the string routines
+ *
+ * The utf-8 and cesu-8 routines skip ASCII characters sixteen bytes at a time,
+ * with SSE2 or NEON instructions if the compiler targets them, and with word
+ * operations otherwise.
+ */
+// #define CONFIG_DISABLE_LIT_SIMD
+
 /**
  * Share of newly allocated since last GC objects among all currently allocated objects,
  * after achieving which, GC is started upon low severity try-give-memory-back requests.
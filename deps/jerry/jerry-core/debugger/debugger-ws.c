@@ -70,6 +70,8 @@ jerry_debugger_close_connection_tcp (bool log_error) /**< log error */
   JERRY_ASSERT (JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_CONNECTED);
 
   JERRY_CONTEXT (debugger_flags) = (uint8_t) JERRY_DEBUGGER_VM_IGNORE;
+  JERRY_CONTEXT (debugger_profile_kinds) = 0;
+  JERRY_CONTEXT (debugger_profile_count) = 0;
 
   if (log_error)
   {
@@ -242,6 +242,24 @@ jerry_debugger_sleep (void)
     return false; \
   }
 
+/**
+ * Start profiling, or stop it if no kinds are given.
+ */
+static void
+jerry_debugger_profile_start (uint8_t kinds, /**< bit set of the sampled kinds */
+                              uint32_t interval) /**< sampling interval in milliseconds */
+{
+  double now = jerry_port_get_current_time ();
+
+  JERRY_CONTEXT (debugger_profile_kinds) = (uint8_t) (kinds & ((1u << JERRY_DEBUGGER_PROFILE__COUNT) - 1));
+  JERRY_CONTEXT (debugger_profile_interval) = interval;
+  JERRY_CONTEXT (debugger_profile_start_time) = now;
+  JERRY_CONTEXT (debugger_profile_next_time) = now;
+  JERRY_CONTEXT (debugger_profile_dropped) = 0;
+  JERRY_CONTEXT (debugger_profile_head) = 0;
+  JERRY_CONTEXT (debugger_profile_count) = 0;
+} /* jerry_debugger_profile_start */
+
 /**
  * Receive message from the client.
  *
@@ -258,6 +276,7 @@ jerry_debugger_process_message (uint8_t *recv_buffer_p, /**< pointer the the rec
   /* Process the received message. */
 
   if (recv_buffer_p[0] >= JERRY_DEBUGGER_CONTINUE
+      && recv_buffer_p[0] <= JERRY_DEBUGGER_EVAL_PART
       && !(JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_BREAKPOINT_MODE))
   {
     jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Message requires breakpoint mode\n");
@@ -415,6 +434,18 @@ jerry_debugger_process_message (uint8_t *recv_buffer_p, /**< pointer the the rec
       return true;
     }
 
+    case JERRY_DEBUGGER_PROFILE:
+    {
+      JERRY_DEBUGGER_CHECK_PACKET_SIZE (jerry_debugger_receive_profile_t);
+      JERRY_DEBUGGER_RECEIVE_BUFFER_AS (jerry_debugger_receive_profile_t, profile_p);
+
+      uint32_t interval;
+      memcpy (&interval, profile_p->interval, sizeof (uint32_t));
+
+      jerry_debugger_profile_start (interval > 0 ? profile_p->kinds : 0, interval);
+      return true;
+    }
+
     case JERRY_DEBUGGER_STOP:
     {
       JERRY_DEBUGGER_CHECK_PACKET_SIZE (jerry_debugger_receive_type_t);
@@ -883,6 +914,210 @@ jerry_debugger_send_memstats (void)
   jerry_debugger_send (sizeof (jerry_debugger_send_memstats_t));
 } /* jerry_debugger_send_memstats */
 
+/**
+ * Queue a profile sample of a kind which is sampled.
+ *
+ * Note:
+ *      The sample is dropped if the queue is full, as the samples are only sent
+ *      a few at a time when incoming messages are checked.
+ */
+void
+jerry_debugger_profile_push (jerry_debugger_profile_kind_t kind, /**< kind of the sample */
+                             const uint32_t *values_p, /**< values of the sample */
+                             uint32_t count) /**< number of values */
+{
+  if (!(JERRY_CONTEXT (debugger_profile_kinds) & (1u << kind)))
+  {
+    return;
+  }
+
+  if (JERRY_CONTEXT (debugger_profile_count) >= JERRY_DEBUGGER_PROFILE_QUEUE_LENGTH)
+  {
+    JERRY_CONTEXT (debugger_profile_dropped)++;
+    return;
+  }
+
+  uint32_t index = ((uint32_t) JERRY_CONTEXT (debugger_profile_head) + JERRY_CONTEXT (debugger_profile_count));
+  jerry_debugger_profile_sample_t *sample_p = JERRY_CONTEXT (debugger_profile_queue)
+                                              + (index % JERRY_DEBUGGER_PROFILE_QUEUE_LENGTH);
+  double time = jerry_port_get_current_time () - JERRY_CONTEXT (debugger_profile_start_time);
+
+  count = JERRY_MIN (count, JERRY_DEBUGGER_PROFILE_MAX_VALUES);
+  sample_p->kind = (uint8_t) kind;
+  sample_p->count = (uint8_t) count;
+  sample_p->time = (uint32_t) JERRY_MIN (JERRY_MAX (time, 0), (double) UINT32_MAX);
+  memcpy (sample_p->values, values_p, count * sizeof (uint32_t));
+
+  JERRY_CONTEXT (debugger_profile_count)++;
+} /* jerry_debugger_profile_push */
+
+/**
+ * Check whether the sampling interval has elapsed, and start the next one.
+ *
+ * @return true - if the engine and the embedder should take their samples
+ *         false - otherwise
+ */
+static bool
+jerry_debugger_profile_is_due (void)
+{
+  if (JERRY_CONTEXT (debugger_profile_kinds) == 0)
+  {
+    return false;
+  }
+
+  double now = jerry_port_get_current_time ();
+
+  if (now < JERRY_CONTEXT (debugger_profile_next_time))
+  {
+    return false;
+  }
+
+  JERRY_CONTEXT (debugger_profile_next_time) = now + JERRY_CONTEXT (debugger_profile_interval);
+  return true;
+} /* jerry_debugger_profile_is_due */
+
+/**
+ * Queue a heap usage sample.
+ */
+static void
+jerry_debugger_profile_heap (void)
+{
+  size_t usage;
+  size_t peak_usage;
+  jmem_heap_get_usage_stats (&usage, &peak_usage);
+
+  uint32_t values[7];
+  values[0] = (uint32_t) usage;
+  values[1] = (uint32_t) peak_usage;
+  values[2] = (uint32_t) JERRY_CONTEXT (jmem_allocated_heap_size);
+  values[3] = JERRY_CONTEXT (jmem_heap_allocated_blocks_count);
+#ifdef JMEM_SEGMENTED_HEAP
+  values[4] = (uint32_t) (SEG_NUM_SEGMENTS - JERRY_HEAP_CONTEXT (segments_count));
+#else /* !JMEM_SEGMENTED_HEAP */
+  values[4] = 0;
+#endif /* JMEM_SEGMENTED_HEAP */
+  values[5] = JERRY_CONTEXT (ecma_gc_stats).count;
+  values[6] = JERRY_CONTEXT (debugger_profile_dropped);
+
+  jerry_debugger_profile_push (JERRY_DEBUGGER_PROFILE_HEAP, values, 7);
+} /* jerry_debugger_profile_heap */
+
+/**
+ * Queue a sample of a garbage collection which has ended.
+ */
+void
+jerry_debugger_profile_gc (void)
+{
+  const jerry_gc_stats_t *stats_p = &JERRY_CONTEXT (ecma_gc_stats);
+
+  uint32_t values[6];
+  values[0] = stats_p->count;
+  values[1] = stats_p->last_pause_us;
+  values[2] = (uint32_t) JERRY_CONTEXT (ecma_gc_size_before);
+  values[3] = (uint32_t) JERRY_CONTEXT (jmem_heap_blocks_size);
+  values[4] = stats_p->survival_percent;
+  values[5] = (uint32_t) stats_p->trigger_size;
+
+  jerry_debugger_profile_push (JERRY_DEBUGGER_PROFILE_GC, values, 6);
+} /* jerry_debugger_profile_gc */
+
+/**
+ * Queue a sample of the innermost frames of the running JS code.
+ */
+static void
+jerry_debugger_profile_cpu (void)
+{
+  uint32_t values[JERRY_DEBUGGER_PROFILE_MAX_VALUES];
+  uint32_t count = 0;
+  vm_frame_ctx_t *frame_ctx_p = JERRY_CONTEXT (vm_top_context_p);
+
+  while (frame_ctx_p != NULL && count < JERRY_DEBUGGER_PROFILE_CPU_DEPTH * 2)
+  {
+    if (!(frame_ctx_p->bytecode_header_p->status_flags & CBC_CODE_FLAGS_DEBUGGER_IGNORE))
+    {
+      jmem_cpointer_t byte_code_cp;
+      JMEM_CP_SET_NON_NULL_POINTER (byte_code_cp, frame_ctx_p->bytecode_header_p);
+
+      values[count++] = byte_code_cp;
+      values[count++] = (uint32_t) (frame_ctx_p->byte_code_p - (uint8_t *) frame_ctx_p->bytecode_header_p);
+    }
+
+    frame_ctx_p = frame_ctx_p->prev_context_p;
+  }
+
+  jerry_debugger_profile_push (JERRY_DEBUGGER_PROFILE_CPU, values, count);
+} /* jerry_debugger_profile_cpu */
+
+/**
+ * Send a few of the queued profile samples to the client.
+ */
+static void
+jerry_debugger_profile_send (void)
+{
+  JERRY_DEBUGGER_SEND_BUFFER_AS (jerry_debugger_send_profile_sample_t, message_p);
+
+  for (uint32_t i = 0; i < JERRY_DEBUGGER_PROFILE_SEND_COUNT && JERRY_CONTEXT (debugger_profile_count) > 0; i++)
+  {
+    const jerry_debugger_profile_sample_t *sample_p;
+    sample_p = JERRY_CONTEXT (debugger_profile_queue) + JERRY_CONTEXT (debugger_profile_head);
+
+    size_t size = 1 + 1 + sizeof (uint32_t) + sample_p->count * sizeof (uint32_t);
+
+    JERRY_DEBUGGER_INIT_SEND_MESSAGE (message_p);
+    JERRY_DEBUGGER_SET_SEND_MESSAGE_SIZE (message_p, size);
+    message_p->type = JERRY_DEBUGGER_PROFILE_SAMPLE;
+    message_p->kind = sample_p->kind;
+    memcpy (message_p->time, &sample_p->time, sizeof (uint32_t));
+    memcpy (message_p->values, sample_p->values, sample_p->count * sizeof (uint32_t));
+
+    JERRY_CONTEXT (debugger_profile_head) = (uint8_t) ((JERRY_CONTEXT (debugger_profile_head) + 1)
+                                                       % JERRY_DEBUGGER_PROFILE_QUEUE_LENGTH);
+    JERRY_CONTEXT (debugger_profile_count)--;
+
+    if (!jerry_debugger_send (sizeof (jerry_debugger_send_header_t) + size))
+    {
+      return;
+    }
+  }
+} /* jerry_debugger_profile_send */
+
+/**
+ * Take the samples of the engine if they are due, while JS code is running, and
+ * send the queued ones.
+ */
+void
+jerry_debugger_profile_vm (void)
+{
+  if (jerry_debugger_profile_is_due ())
+  {
+    jerry_debugger_profile_heap ();
+    jerry_debugger_profile_cpu ();
+  }
+
+  jerry_debugger_profile_send ();
+} /* jerry_debugger_profile_vm */
+
+/**
+ * Take the heap sample if it is due, while no JS code is running, and send the
+ * queued samples.
+ *
+ * @return true - if the samples of the embedder are due as well
+ *         false - otherwise
+ */
+bool
+jerry_debugger_profile_tick_internal (void)
+{
+  bool is_due = jerry_debugger_profile_is_due ();
+
+  if (is_due)
+  {
+    jerry_debugger_profile_heap ();
+  }
+
+  jerry_debugger_profile_send ();
+  return is_due;
+} /* jerry_debugger_profile_tick_internal */
+
 /*
  * Converts an standard error into a string.
  *
@@ -18,6 +18,7 @@
 
 #include "debugger-ws.h"
 #include "ecma-globals.h"
+#include "jerryscript.h"
 
 #ifdef JERRY_DEBUGGER
 
@@ -33,6 +34,22 @@
  */
 #define JERRY_DEBUGGER_TIMEOUT 100
 
+/**
+ * Number of profile samples waiting to be sent, samples over it are dropped.
+ */
+#define JERRY_DEBUGGER_PROFILE_QUEUE_LENGTH 8
+
+/**
+ * Number of profile samples sent at each check of incoming messages, so that
+ * profiling takes little of the time and bandwidth of the program.
+ */
+#define JERRY_DEBUGGER_PROFILE_SEND_COUNT 2
+
+/**
+ * Number of innermost frames in a CPU profile sample.
+ */
+#define JERRY_DEBUGGER_PROFILE_CPU_DEPTH (JERRY_DEBUGGER_PROFILE_MAX_VALUES / 2)
+
 /**
   * This constant represents that the string to be sent has no subtype.
   */
@@ -123,6 +140,7 @@ typedef enum
   JERRY_DEBUGGER_WAIT_FOR_SOURCE = 23, /**< engine waiting for a source code */
   JERRY_DEBUGGER_OUTPUT_RESULT = 24, /**< output sent by the program to the debugger */
   JERRY_DEBUGGER_OUTPUT_RESULT_END = 25, /**< last output result data */
+  JERRY_DEBUGGER_PROFILE_SAMPLE = 26, /**< profile sample */
 
   /* Messages sent by the client to server. */
 
@@ -145,6 +163,8 @@ typedef enum
   JERRY_DEBUGGER_GET_BACKTRACE = 12, /**< get backtrace */
   JERRY_DEBUGGER_EVAL = 13, /**< first message of evaluating a string */
   JERRY_DEBUGGER_EVAL_PART = 14, /**< next message of evaluating a string */
+  /* The following messages are accepted in both run and breakpoint modes. */
+  JERRY_DEBUGGER_PROFILE = 15, /**< start or stop profiling */
 } jerry_debugger_header_type_t;
 
 /**
@@ -271,6 +291,39 @@ typedef struct
   uint8_t property_bytes[sizeof (uint32_t)]; /**< property bytes */
 } jerry_debugger_send_memstats_t;
 
+/**
+ * Profile sample waiting to be sent.
+ */
+typedef struct
+{
+  uint8_t kind; /**< jerry_debugger_profile_kind_t of the sample */
+  uint8_t count; /**< number of values */
+  uint32_t time; /**< milliseconds since the start of profiling */
+  uint32_t values[JERRY_DEBUGGER_PROFILE_MAX_VALUES]; /**< values of the sample */
+} jerry_debugger_profile_sample_t;
+
+/**
+ * Outgoing message: profile sample
+ */
+typedef struct
+{
+  jerry_debugger_send_header_t header; /**< message header */
+  uint8_t type; /**< type of the message */
+  uint8_t kind; /**< kind of the sample */
+  uint8_t time[sizeof (uint32_t)]; /**< milliseconds since the start of profiling */
+  uint8_t values[JERRY_DEBUGGER_PROFILE_MAX_VALUES][sizeof (uint32_t)]; /**< values of the sample */
+} jerry_debugger_send_profile_sample_t;
+
+/**
+ * Incoming message: start or stop profiling.
+ */
+typedef struct
+{
+  uint8_t type; /**< type of the message */
+  uint8_t kinds; /**< bit set of the jerry_debugger_profile_kind_t to sample */
+  uint8_t interval[sizeof (uint32_t)]; /**< sampling interval in milliseconds, 0 stops profiling */
+} jerry_debugger_receive_profile_t;
+
 /**
  * Outgoing message: notify breakpoint hit.
  */
@@ -352,6 +405,11 @@ bool jerry_debugger_send_parse_function (uint32_t line, uint32_t column);
 void jerry_debugger_send_memstats (void);
 bool jerry_debugger_send_exception_string (ecma_value_t exception_value);
 
+void jerry_debugger_profile_push (jerry_debugger_profile_kind_t kind, const uint32_t *values_p, uint32_t count);
+void jerry_debugger_profile_gc (void);
+void jerry_debugger_profile_vm (void);
+bool jerry_debugger_profile_tick_internal (void);
+
 #endif /* JERRY_DEBUGGER */
 
 #endif /* DEBUGGER_H */
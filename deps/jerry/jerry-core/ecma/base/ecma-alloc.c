@@ -51,6 +51,20 @@ JERRY_STATIC_ASSERT (sizeof (ecma_extended_object_t) - sizeof (ecma_object_t) <=
  *     else - shutdown engine.
  */
 
+/**
+ * Allocate or free a block of objects and property pairs:
+ * from the pools if its size is pooled, otherwise from the heap.
+ */
+#ifdef JMEM_POOLS_SIZE_CLASSES
+#define ALLOC_BLOCK(size) \
+  ((size) <= JMEM_POOLS_MAX_CHUNK_SIZE ? jmem_pools_alloc (size) : jmem_heap_alloc_block (size))
+#define FREE_BLOCK(ptr, size) \
+  ((size) <= JMEM_POOLS_MAX_CHUNK_SIZE ? jmem_pools_free ((ptr), (size)) : jmem_heap_free_block ((ptr), (size)))
+#else /* !JMEM_POOLS_SIZE_CLASSES */
+#define ALLOC_BLOCK(size) jmem_heap_alloc_block (size)
+#define FREE_BLOCK(ptr, size) jmem_heap_free_block ((ptr), (size))
+#endif /* JMEM_POOLS_SIZE_CLASSES */
+
 /**
  * Template of an allocation routine.
  */
@@ -102,7 +116,6 @@ JERRY_STATIC_ASSERT (sizeof (ecma_extended_object_t) - sizeof (ecma_object_t) <=
 
 DECLARE_ROUTINES_FOR (number, 0, 1)
 DECLARE_ROUTINES_FOR (collection_header, 8, 2)
-DECLARE_ROUTINES_FOR (collection_chunk, 0, 3)
 
 /**
  * Allocate memory for ecma-object
@@ -113,10 +126,10 @@ inline ecma_object_t * __attr_always_inline___
 ecma_alloc_object (void)
 {
 #ifdef JMEM_STATS
-  jmem_stats_allocate_object_bytes (sizeof (ecma_object_t));
+  jmem_stats_allocate_object_bytes (ECMA_OBJECT_SIZE);
 #endif /* JMEM_STATS */
 
-  size_t size_to_allocate = sizeof(ecma_object_t);
+  size_t size_to_allocate = ECMA_OBJECT_SIZE;
   // Over-provision for full-bitwidth address overhead
   #ifdef SEG_FULLBIT_ADDRESS_ALLOC
   size_to_allocate += 8;
@@ -128,7 +141,12 @@ ecma_alloc_object (void)
   profile_add_count_size_detailed(0, size_to_allocate); /* size detailed */
   #endif
 
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+  /* Objects with an inline property pair are larger than the pooled chunks. */
+  ecma_object_t * res = (ecma_object_t *) ALLOC_BLOCK (size_to_allocate);
+#else /* !CONFIG_ECMA_INLINE_PROPERTY_PAIR */
   ecma_object_t * res = (ecma_object_t *) jmem_pools_alloc (size_to_allocate);
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
   return res;
 } /* ecma_alloc_object */
 
@@ -139,10 +157,10 @@ inline void __attr_always_inline___
 ecma_dealloc_object (ecma_object_t *object_p) /**< object to be freed */
 {
 #ifdef JMEM_STATS
-  jmem_stats_free_object_bytes (sizeof (ecma_object_t));
+  jmem_stats_free_object_bytes (ECMA_OBJECT_SIZE);
 #endif /* JMEM_STATS */
 
-  size_t size_to_free = sizeof(ecma_object_t);
+  size_t size_to_free = ECMA_OBJECT_SIZE;
   // Over-provision for full-bitwidth address overhead
   #ifdef SEG_FULLBIT_ADDRESS_ALLOC
   size_to_free += 8;
@@ -154,7 +172,11 @@ ecma_dealloc_object (ecma_object_t *object_p) /**< object to be freed */
   profile_add_count_size_detailed(0, -size_to_free); /* size detailed */
   #endif
 
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+  FREE_BLOCK (object_p, size_to_free);
+#else /* !CONFIG_ECMA_INLINE_PROPERTY_PAIR */
   jmem_pools_free (object_p, size_to_free);
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
 
 } /* ecma_dealloc_object */
 
@@ -182,7 +204,7 @@ ecma_alloc_extended_object (size_t size) /**< size of object */
   profile_add_count_size_detailed(11, size_to_allocate); /* size detailed */
   #endif
 
-  ecma_extended_object_t * res = jmem_heap_alloc_block (size_to_allocate);
+  ecma_extended_object_t * res = ALLOC_BLOCK (size_to_allocate);
   return res;
 } /* ecma_alloc_extended_object */
 
@@ -209,7 +231,7 @@ ecma_dealloc_extended_object (ecma_extended_object_t *ext_object_p, /**< propert
   profile_add_count_size_detailed(11, -size_to_free); /* size detailed */
   #endif
 
-  jmem_heap_free_block (ext_object_p, size_to_free);
+  FREE_BLOCK (ext_object_p, size_to_free);
 
 } /* ecma_dealloc_extended_object */
 
@@ -366,7 +388,7 @@ ecma_alloc_property_pair (void)
   profile_add_count_size_detailed(12, size_to_allocate); /* size detailed */
   #endif
 
-  ecma_property_pair_t * res = jmem_heap_alloc_block (size_to_allocate);
+  ecma_property_pair_t * res = ALLOC_BLOCK (size_to_allocate);
   return res;
 } /* ecma_alloc_property_pair */
 
@@ -392,7 +414,7 @@ ecma_dealloc_property_pair (ecma_property_pair_t *property_pair_p) /**< property
   profile_add_count_size_detailed(12, -size_to_free); /* size detailed */
   #endif
 
-  jmem_heap_free_block (property_pair_p, size_to_free);
+  FREE_BLOCK (property_pair_p, size_to_free);
 
 } /* ecma_dealloc_property_pair */
 
@@ -73,18 +73,6 @@ ecma_collection_header_t *ecma_alloc_collection_header (void);
  */
 void ecma_dealloc_collection_header (ecma_collection_header_t *collection_header_p);
 
-/**
- * Allocate memory for non-first chunk of a collection
- *
- * @return pointer to allocated memory
- */
-ecma_collection_chunk_t *ecma_alloc_collection_chunk (void);
-
-/**
- * Dealloc memory from non-first chunk of a collection
- */
-void ecma_dealloc_collection_chunk (ecma_collection_chunk_t *collection_chunk_p);
-
 /**
  * Allocate memory for ecma-string descriptor
  *
@@ -0,0 +1,343 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-enum-cache.h"
+#include "ecma-helpers.h"
+#include "jcontext.h"
+
+/** \addtogroup ecma ECMA
+ * @{
+ *
+ * \addtogroup ecmaenumcache Enumeration cache
+ * @{
+ *
+ * The enumeration cache keeps the names of the enumerable properties of the last
+ * few objects enumerated. JerryScript objects have no shapes, so a list is valid
+ * only until a property of the object, or of one of its prototypes, is added or
+ * deleted. The objects of the valid lists are watched: modifying or freeing a
+ * watched object removes it from the watches, which invalidates the lists that
+ * were filled while it was watched, and checking a list only compares the watch
+ * stamps of the objects of its prototype chain.
+ *
+ * The cached lists are shared by their users, e.g. the for-in loops iterating
+ * them, so no list is freed while any of them is in use.
+ */
+
+#ifdef CONFIG_ECMA_ENUM_CACHE
+
+JERRY_STATIC_ASSERT ((CONFIG_ECMA_ENUM_CACHE_SIZE & (CONFIG_ECMA_ENUM_CACHE_SIZE - 1)) == 0,
+                     ecma_enum_cache_size_must_be_a_power_of_2);
+JERRY_STATIC_ASSERT ((CONFIG_ECMA_ENUM_CACHE_WATCH_SIZE & (CONFIG_ECMA_ENUM_CACHE_WATCH_SIZE - 1)) == 0,
+                     ecma_enum_cache_watch_size_must_be_a_power_of_2);
+
+/**
+ * Hash of an object pointer
+ *
+ * @return hash
+ */
+static inline uint32_t __attr_always_inline___
+ecma_enum_cache_hash (const ecma_object_t *object_p) /**< object */
+{
+  return (uint32_t) (((uintptr_t) object_p) >> JMEM_ALIGNMENT_LOG);
+} /* ecma_enum_cache_hash */
+
+/**
+ * Get the watch slot of an object
+ *
+ * @return watch slot
+ */
+static inline ecma_enum_cache_watch_t * __attr_always_inline___
+ecma_enum_cache_get_watch (const ecma_object_t *object_p) /**< object */
+{
+  uint32_t index = ecma_enum_cache_hash (object_p) & (CONFIG_ECMA_ENUM_CACHE_WATCH_SIZE - 1);
+
+  return JERRY_CONTEXT (ecma_enum_cache_watches) + index;
+} /* ecma_enum_cache_get_watch */
+
+/**
+ * Get the cache entry of an enumeration
+ *
+ * @return cache entry
+ */
+static inline ecma_enum_cache_entry_t * __attr_always_inline___
+ecma_enum_cache_get_entry (const ecma_object_t *object_p, /**< enumerated object */
+                           bool is_with_prototype_chain) /**< the prototypes are enumerated */
+{
+  uint32_t index = (ecma_enum_cache_hash (object_p) << 1) | (is_with_prototype_chain ? 1u : 0u);
+
+  return JERRY_CONTEXT (ecma_enum_cache_entries) + (index & (CONFIG_ECMA_ENUM_CACHE_SIZE - 1));
+} /* ecma_enum_cache_get_entry */
+
+/**
+ * Collect the objects whose properties an enumeration lists.
+ *
+ * Only general objects are cached: the lazy properties of the other object types,
+ * e.g. the elements of fast arrays, are not added by creating properties.
+ *
+ * @return number of the objects,
+ *         0 - if the enumeration cannot be cached
+ */
+static uint32_t
+ecma_enum_cache_get_chain (ecma_object_t *object_p, /**< enumerated object */
+                           bool is_with_prototype_chain, /**< the prototypes are enumerated */
+                           ecma_object_t **chain_p) /**< [out] the objects */
+{
+  uint32_t length = 0;
+
+  do
+  {
+    if (length == CONFIG_ECMA_ENUM_CACHE_CHAIN_LENGTH
+        || ecma_get_object_type (object_p) != ECMA_OBJECT_TYPE_GENERAL)
+    {
+      return 0;
+    }
+
+    chain_p[length++] = object_p;
+    object_p = is_with_prototype_chain ? ecma_get_object_prototype (object_p) : NULL;
+  }
+  while (object_p != NULL);
+
+  return length;
+} /* ecma_enum_cache_get_chain */
+
+/**
+ * Check whether the objects of a cache entry are watched since the entry is filled.
+ *
+ * @return true - if the entry is valid,
+ *         false - otherwise
+ */
+static bool
+ecma_enum_cache_is_valid (const ecma_enum_cache_entry_t *entry_p, /**< cache entry */
+                          ecma_object_t **chain_p, /**< objects of the enumeration */
+                          uint32_t chain_length) /**< number of the objects */
+{
+  if (chain_length != entry_p->chain_length)
+  {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < chain_length; i++)
+  {
+    ecma_enum_cache_watch_t *watch_p = ecma_enum_cache_get_watch (chain_p[i]);
+
+    if (watch_p->object_p != chain_p[i] || watch_p->stamp != entry_p->stamps[i])
+    {
+      return false;
+    }
+  }
+
+  return true;
+} /* ecma_enum_cache_is_valid */
+
+/**
+ * Free the name lists of the cache.
+ */
+static void
+ecma_enum_cache_free_entries (void)
+{
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_enum_cache_users) == 0);
+
+  for (uint32_t i = 0; i < CONFIG_ECMA_ENUM_CACHE_SIZE; i++)
+  {
+    ecma_enum_cache_entry_t *entry_p = JERRY_CONTEXT (ecma_enum_cache_entries) + i;
+
+    if (entry_p->object_p != NULL)
+    {
+      ecma_free_values_collection (entry_p->names_p, true);
+      entry_p->object_p = NULL;
+    }
+  }
+} /* ecma_enum_cache_free_entries */
+
+/**
+ * Initialize the enumeration cache
+ */
+void
+ecma_enum_cache_init (void)
+{
+  memset (JERRY_CONTEXT (ecma_enum_cache_watches), 0, sizeof (JERRY_CONTEXT (ecma_enum_cache_watches)));
+  memset (JERRY_CONTEXT (ecma_enum_cache_entries), 0, sizeof (JERRY_CONTEXT (ecma_enum_cache_entries)));
+  JERRY_CONTEXT (ecma_enum_cache_stamp) = 0;
+  JERRY_CONTEXT (ecma_enum_cache_users) = 0;
+} /* ecma_enum_cache_init */
+
+/**
+ * Finalize the enumeration cache
+ */
+void
+ecma_enum_cache_finalize (void)
+{
+  ecma_enum_cache_free_entries ();
+  ecma_enum_cache_invalidate_all ();
+} /* ecma_enum_cache_finalize */
+
+/**
+ * Free the cached name lists, unless they are in use.
+ */
+void
+ecma_enum_cache_flush (void)
+{
+  if (JERRY_CONTEXT (ecma_enum_cache_users) == 0)
+  {
+    ecma_enum_cache_free_entries ();
+  }
+} /* ecma_enum_cache_flush */
+
+/**
+ * Invalidate the cached name lists of an object and of the objects it is a prototype of.
+ *
+ * Called when a property of the object is added or deleted, or the object is freed.
+ */
+void
+ecma_enum_cache_invalidate (ecma_object_t *object_p) /**< object */
+{
+  ecma_enum_cache_watch_t *watch_p = ecma_enum_cache_get_watch (object_p);
+
+  if (watch_p->object_p == object_p)
+  {
+    watch_p->object_p = NULL;
+  }
+} /* ecma_enum_cache_invalidate */
+
+/**
+ * Invalidate all cached name lists.
+ *
+ * Called when the object of a modified property is not known.
+ */
+void
+ecma_enum_cache_invalidate_all (void)
+{
+  for (uint32_t i = 0; i < CONFIG_ECMA_ENUM_CACHE_WATCH_SIZE; i++)
+  {
+    JERRY_CONTEXT (ecma_enum_cache_watches)[i].object_p = NULL;
+  }
+} /* ecma_enum_cache_invalidate_all */
+
+/**
+ * Find the cached names of the enumerable properties of an object.
+ *
+ * Note:
+ *      the list must be released by ecma_enum_cache_release
+ *
+ * @return the list - if it is cached and valid,
+ *         NULL - otherwise
+ */
+ecma_collection_header_t *
+ecma_enum_cache_lookup (ecma_object_t *object_p, /**< object */
+                        bool is_with_prototype_chain) /**< the prototypes are enumerated */
+{
+  ecma_enum_cache_entry_t *entry_p = ecma_enum_cache_get_entry (object_p, is_with_prototype_chain);
+
+  if (entry_p->object_p != object_p || entry_p->is_with_prototype_chain != is_with_prototype_chain)
+  {
+    return NULL;
+  }
+
+  ecma_object_t *chain_p[CONFIG_ECMA_ENUM_CACHE_CHAIN_LENGTH];
+  uint32_t chain_length = ecma_enum_cache_get_chain (object_p, is_with_prototype_chain, chain_p);
+
+  if (!ecma_enum_cache_is_valid (entry_p, chain_p, chain_length))
+  {
+    return NULL;
+  }
+
+  JERRY_CONTEXT (ecma_enum_cache_users)++;
+  return entry_p->names_p;
+} /* ecma_enum_cache_lookup */
+
+/**
+ * Cache the names of the enumerable properties of an object.
+ *
+ * Note:
+ *      if the list is cached, it is owned by the cache from now on,
+ *      and it must be released by ecma_enum_cache_release
+ *
+ * @return true - if the list is cached,
+ *         false - otherwise, the list is still owned by the caller
+ */
+bool
+ecma_enum_cache_insert (ecma_object_t *object_p, /**< object */
+                        bool is_with_prototype_chain, /**< the prototypes are enumerated */
+                        ecma_collection_header_t *names_p) /**< names of the enumerable properties */
+{
+  ecma_object_t *chain_p[CONFIG_ECMA_ENUM_CACHE_CHAIN_LENGTH];
+  uint32_t chain_length = ecma_enum_cache_get_chain (object_p, is_with_prototype_chain, chain_p);
+
+  if (chain_length == 0)
+  {
+    return false;
+  }
+
+  ecma_enum_cache_entry_t *entry_p = ecma_enum_cache_get_entry (object_p, is_with_prototype_chain);
+
+  if (entry_p->object_p != NULL)
+  {
+    if (JERRY_CONTEXT (ecma_enum_cache_users) > 0)
+    {
+      /* The list of the entry may be in use. */
+      return false;
+    }
+
+    ecma_free_values_collection (entry_p->names_p, true);
+    entry_p->object_p = NULL;
+  }
+
+  for (uint32_t i = 0; i < chain_length; i++)
+  {
+    ecma_enum_cache_watch_t *watch_p = ecma_enum_cache_get_watch (chain_p[i]);
+
+    if (watch_p->object_p != chain_p[i])
+    {
+      /* Watching the object replaces the watch of another one, which invalidates its lists. */
+      watch_p->object_p = chain_p[i];
+      watch_p->stamp = ++JERRY_CONTEXT (ecma_enum_cache_stamp);
+    }
+
+    entry_p->stamps[i] = watch_p->stamp;
+  }
+
+  entry_p->chain_length = (uint8_t) chain_length;
+
+  if (!ecma_enum_cache_is_valid (entry_p, chain_p, chain_length))
+  {
+    /* Two objects of the prototype chain have the same watch slot. */
+    return false;
+  }
+
+  entry_p->object_p = object_p;
+  entry_p->names_p = names_p;
+  entry_p->is_with_prototype_chain = is_with_prototype_chain;
+
+  JERRY_CONTEXT (ecma_enum_cache_users)++;
+  return true;
+} /* ecma_enum_cache_insert */
+
+/**
+ * Release a cached name list returned by ecma_enum_cache_lookup or kept by ecma_enum_cache_insert.
+ */
+void
+ecma_enum_cache_release (void)
+{
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_enum_cache_users) > 0);
+
+  JERRY_CONTEXT (ecma_enum_cache_users)--;
+} /* ecma_enum_cache_release */
+
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
+/**
+ * @}
+ * @}
+ */
@@ -18,20 +18,25 @@
  */
 
 #include "ecma-alloc.h"
+#include "ecma-array-object.h"
+#include "ecma-enum-cache.h"
 #include "ecma-globals.h"
 #include "ecma-gc.h"
 #include "ecma-helpers.h"
 #include "ecma-lcache.h"
+#include "ecma-literal-storage.h"
 #include "ecma-property-hashmap.h"
 #include "jcontext.h"
 #include "jrt.h"
 #include "jrt-libc-includes.h"
 #include "jrt-bit-fields.h"
+#include "jrt-probes.h"
 #include "re-compiler.h"
 #include "vm-defines.h"
 #include "vm-stack.h"
 
 #ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+#include "ecma-arraybuffer-object.h"
 #include "ecma-typedarray-object.h"
 #endif
 #ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
@@ -51,6 +56,25 @@
  * @{
  */
 
+/**
+ * Types of references between objects
+ */
+typedef enum
+{
+  ECMA_GC_REFERENCE_PROPERTY, /**< value, getter or setter of a property */
+  ECMA_GC_REFERENCE_PROTOTYPE, /**< prototype of an object */
+  ECMA_GC_REFERENCE_ENVIRONMENT, /**< outer environment, function scope or arguments environment */
+  ECMA_GC_REFERENCE_BINDING, /**< binding object of an object-bound environment */
+  ECMA_GC_REFERENCE_INTERNAL /**< other internal references (promise reactions, bound arguments, etc.) */
+} ecma_gc_reference_type_t;
+
+/**
+ * Visitor of a reference from an object to another object
+ */
+typedef void (*ecma_gc_reference_visitor_t) (ecma_object_t *object_p,
+                                             ecma_gc_reference_type_t type,
+                                             void *data_p);
+
 /**
  * Current state of an object's visited flag that
  * indicates whether the object is in visited state:
@@ -64,6 +88,7 @@
 
 static void ecma_gc_mark (ecma_object_t *object_p);
 static void ecma_gc_sweep (ecma_object_t *object_p);
+static void ecma_gc_run_internal (jmem_free_unused_memory_severity_t severity, bool is_sweep_deferred);
 
 /**
  * Get next object in list of objects with same generation.
@@ -120,6 +145,206 @@ ecma_gc_set_object_visited (ecma_object_t *object_p, /**< object */
   }
 } /* ecma_gc_set_object_visited */
 
+/**
+ * Set visited flag of an unvisited object, and push it onto the mark stack to mark from it.
+ *
+ * If the stack is full, the object stays unmarked in the white-gray list, and the rest of
+ * the collection marks from the visited objects met by the traversals of the list.
+ */
+static inline void __attr_always_inline___
+ecma_gc_visit_object (ecma_object_t *object_p) /**< object */
+{
+  JERRY_ASSERT (!ecma_gc_is_object_visited (object_p));
+
+  ecma_gc_set_object_visited (object_p, true);
+
+  uint32_t count = JERRY_CONTEXT (ecma_gc_mark_stack_count);
+
+  if (likely (count < JMEM_GC__MARK_STACK_SIZE))
+  {
+    JERRY_CONTEXT (ecma_gc_mark_stack) [count] = object_p;
+    JERRY_CONTEXT (ecma_gc_mark_stack_count) = count + 1;
+  }
+  else
+  {
+    JERRY_CONTEXT (ecma_gc_is_mark_stack_overflowed) = true;
+  }
+} /* ecma_gc_visit_object */
+
+/**
+ * Empty the mark stack and the overflow state before marking
+ */
+static inline void
+ecma_gc_reset_mark_stack (void)
+{
+  JERRY_CONTEXT (ecma_gc_mark_stack_count) = 0;
+  JERRY_CONTEXT (ecma_gc_is_mark_stack_overflowed) = false;
+} /* ecma_gc_reset_mark_stack */
+
+/**
+ * Compute the heap usage which triggers the next collection
+ *
+ * @return live size grown by the growth percent, at least by CONFIG_MEM_HEAP_DESIRED_LIMIT,
+ *         but within the pause budget and the reserve if possible
+ */
+static size_t
+ecma_gc_compute_trigger_size (size_t live_size, /**< heap usage after the last collection */
+                              uint32_t growth_percent) /**< adapted growth */
+{
+  const jerry_gc_trigger_t *trigger_p = &JERRY_CONTEXT (ecma_gc_trigger);
+  const jerry_gc_stats_t *stats_p = &JERRY_CONTEXT (ecma_gc_stats);
+
+  size_t min_trigger_size = live_size + CONFIG_MEM_HEAP_DESIRED_LIMIT;
+  size_t trigger_size = live_size + live_size / 100 * growth_percent;
+
+  /* The pause is proportional to the heap usage at the start of the collection */
+  if (trigger_p->pause_budget_us > 0 && stats_p->last_pause_us > 0)
+  {
+    double budget_size = ((double) JERRY_CONTEXT (ecma_gc_size_before) * trigger_p->pause_budget_us
+                          / stats_p->last_pause_us);
+
+    if ((double) trigger_size > budget_size)
+    {
+      trigger_size = (size_t) budget_size;
+    }
+  }
+
+  size_t reserve_size = JMEM_HEAP_SIZE / 100 * JERRY_MIN (trigger_p->reserve_percent, 100);
+
+  if (trigger_size > JMEM_HEAP_SIZE - reserve_size)
+  {
+    trigger_size = JMEM_HEAP_SIZE - reserve_size;
+  }
+
+  return JERRY_MAX (trigger_size, min_trigger_size);
+} /* ecma_gc_compute_trigger_size */
+
+/**
+ * Record the start of a collection
+ */
+static void
+ecma_gc_start_stats (void)
+{
+  jerry_gc_stats_t *stats_p = &JERRY_CONTEXT (ecma_gc_stats);
+  double now = jerry_port_get_current_time ();
+  size_t size_before = JERRY_CONTEXT (jmem_heap_blocks_size);
+
+  if (stats_p->count > 0 && now > JERRY_CONTEXT (ecma_gc_start_time))
+  {
+    double interval_ms = now - JERRY_CONTEXT (ecma_gc_start_time);
+    size_t allocated_size = size_before > stats_p->live_size ? size_before - stats_p->live_size : 0;
+
+    stats_p->interval_ms = (uint32_t) JERRY_MIN (interval_ms, (double) UINT32_MAX);
+    stats_p->allocation_rate = (uint32_t) JERRY_MIN ((double) allocated_size / interval_ms, (double) UINT32_MAX);
+  }
+
+  stats_p->count++;
+  JERRY_CONTEXT (ecma_gc_start_time) = now;
+  JERRY_CONTEXT (ecma_gc_size_before) = size_before;
+
+  JERRY_PROBE1 (gc__start, size_before);
+} /* ecma_gc_start_stats */
+
+/**
+ * Adapt the trigger of the next collection to the last one, once its dead objects are freed.
+ *
+ * The growth is doubled, up to 8 times the configured one, while the collections are closer
+ * than min_interval_ms or free less than a tenth of the heap usage, and it is halved back
+ * when they are farther than four times the interval.
+ */
+static void
+ecma_gc_update_trigger (void)
+{
+  const jerry_gc_trigger_t *trigger_p = &JERRY_CONTEXT (ecma_gc_trigger);
+  jerry_gc_stats_t *stats_p = &JERRY_CONTEXT (ecma_gc_stats);
+  size_t live_size = JERRY_CONTEXT (jmem_heap_blocks_size);
+  size_t size_before = JERRY_CONTEXT (ecma_gc_size_before);
+
+  stats_p->live_size = live_size;
+  stats_p->survival_percent = (size_before > live_size
+                               ? (uint32_t) (live_size * 100 / size_before)
+                               : 100);
+#ifdef JMEM_SEGMENTED_HEAP
+  stats_p->free_segments = (uint32_t) (SEG_NUM_SEGMENTS - JERRY_HEAP_CONTEXT (segments_count));
+#endif /* JMEM_SEGMENTED_HEAP */
+
+  if (trigger_p->growth_percent == 0)
+  {
+    stats_p->trigger_size = 0;
+    return;
+  }
+
+  uint32_t growth_percent = JERRY_MAX (stats_p->growth_percent, trigger_p->growth_percent);
+  bool is_too_close = (trigger_p->min_interval_ms > 0
+                       && stats_p->interval_ms < trigger_p->min_interval_ms);
+
+  if (is_too_close || stats_p->survival_percent > 90)
+  {
+    growth_percent = JERRY_MIN (growth_percent * 2, trigger_p->growth_percent * 8);
+  }
+  else if (trigger_p->min_interval_ms == 0
+           || stats_p->interval_ms > trigger_p->min_interval_ms * 4)
+  {
+    growth_percent = JERRY_MAX (growth_percent / 2, trigger_p->growth_percent);
+  }
+
+  stats_p->growth_percent = growth_percent;
+  stats_p->trigger_size = ecma_gc_compute_trigger_size (live_size, growth_percent);
+} /* ecma_gc_update_trigger */
+
+/**
+ * Record the end of a collection
+ */
+static void
+ecma_gc_end_stats (bool is_sweep_deferred) /**< the dead objects are not freed yet */
+{
+  double pause_ms = jerry_port_get_current_time () - JERRY_CONTEXT (ecma_gc_start_time);
+
+  JERRY_CONTEXT (ecma_gc_stats).last_pause_us = (uint32_t) JERRY_MAX (JERRY_MIN (pause_ms * 1000, 1e9), 1);
+  JERRY_CONTEXT (ecma_gc_stats).total_pause_us += JERRY_CONTEXT (ecma_gc_stats).last_pause_us;
+
+  JERRY_PROBE2 (gc__done, JERRY_CONTEXT (jmem_heap_blocks_size), JERRY_CONTEXT (ecma_gc_stats).last_pause_us);
+
+  if (!is_sweep_deferred)
+  {
+    ecma_gc_update_trigger ();
+  }
+
+#ifdef JERRY_DEBUGGER
+  if (JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_CONNECTED)
+  {
+    jerry_debugger_profile_gc ();
+  }
+#endif /* JERRY_DEBUGGER */
+} /* ecma_gc_end_stats */
+
+/**
+ * Apply new knobs of the adaptive trigger to the next collection
+ */
+void
+ecma_gc_apply_trigger (void)
+{
+  const jerry_gc_trigger_t *trigger_p = &JERRY_CONTEXT (ecma_gc_trigger);
+
+  JERRY_CONTEXT (ecma_gc_stats).growth_percent = trigger_p->growth_percent;
+
+  if (trigger_p->growth_percent == 0)
+  {
+    JERRY_CONTEXT (ecma_gc_stats).trigger_size = 0;
+    return;
+  }
+
+  size_t live_size = JERRY_CONTEXT (ecma_gc_stats).live_size;
+
+  if (JERRY_CONTEXT (ecma_gc_stats).count == 0)
+  {
+    live_size = JERRY_CONTEXT (jmem_heap_blocks_size);
+  }
+
+  JERRY_CONTEXT (ecma_gc_stats).trigger_size = ecma_gc_compute_trigger_size (live_size,
+                                                                            trigger_p->growth_percent);
+} /* ecma_gc_apply_trigger */
+
 /**
  * Initialize GC information for the object
  */
@@ -139,8 +364,19 @@ ecma_init_gc_info (ecma_object_t *object_p) /**< object */
   ecma_gc_set_object_next (object_p, JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY]);
   JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = object_p;
 
+#ifdef JMEM_INCREMENTAL_GC
+  /* Objects created during incremental marking are not collected by the current cycle,
+   * and they are marked from once they are initialized */
+  ecma_gc_set_object_visited (object_p, false);
+
+  if (JERRY_CONTEXT (ecma_gc_is_marking))
+  {
+    ecma_gc_visit_object (object_p);
+  }
+#else /* !JMEM_INCREMENTAL_GC */
   /* Should be set to false at the beginning of garbage collection */
   ecma_gc_set_object_visited (object_p, false);
+#endif /* JMEM_INCREMENTAL_GC */
 } /* ecma_init_gc_info */
 
 /**
@@ -177,11 +413,13 @@ ecma_deref_object (ecma_object_t *object_p) /**< object */
 } /* ecma_deref_object */
 
 /**
- * Mark referenced object from property
+ * Visit referenced object from property
  */
-static void
-ecma_gc_mark_property (ecma_property_pair_t *property_pair_p, /**< property pair */
-                       uint32_t index) /**< property index */
+static inline void __attr_always_inline___
+ecma_gc_visit_property (ecma_property_pair_t *property_pair_p, /**< property pair */
+                        uint32_t index, /**< property index */
+                        ecma_gc_reference_visitor_t visitor_p, /**< visitor of references */
+                        void *data_p) /**< data passed to the visitor */
 {
   uint8_t property = property_pair_p->header.types[index];
 
@@ -201,7 +439,7 @@ ecma_gc_mark_property (ecma_property_pair_t *property_pair_p, /**< property pair
       {
         ecma_object_t *value_obj_p = ecma_get_object_from_value (value);
 
-        ecma_gc_set_object_visited (value_obj_p, true);
+        visitor_p (value_obj_p, ECMA_GC_REFERENCE_PROPERTY, data_p);
       }
       break;
     }
@@ -213,12 +451,12 @@ ecma_gc_mark_property (ecma_property_pair_t *property_pair_p, /**< property pair
 
       if (getter_obj_p != NULL)
       {
-        ecma_gc_set_object_visited (getter_obj_p, true);
+        visitor_p (getter_obj_p, ECMA_GC_REFERENCE_PROPERTY, data_p);
       }
 
       if (setter_obj_p != NULL)
       {
-        ecma_gc_set_object_visited (setter_obj_p, true);
+        visitor_p (setter_obj_p, ECMA_GC_REFERENCE_PROPERTY, data_p);
       }
       break;
     }
@@ -234,16 +472,17 @@ ecma_gc_mark_property (ecma_property_pair_t *property_pair_p, /**< property pair
       break;
     }
   }
-} /* ecma_gc_mark_property */
+} /* ecma_gc_visit_property */
 
 /**
- * Mark objects as visited starting from specified object as root
+ * Visit the objects referenced from specified object
  */
-void
-ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
+static inline void __attr_always_inline___
+ecma_gc_visit_references (ecma_object_t *object_p, /**< object to visit from */
+                          ecma_gc_reference_visitor_t visitor_p, /**< visitor of references */
+                          void *data_p) /**< data passed to the visitor */
 {
   JERRY_ASSERT (object_p != NULL);
-  JERRY_ASSERT (ecma_gc_is_object_visited (object_p));
 
   bool traverse_properties = true;
 
@@ -252,13 +491,13 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
     ecma_object_t *lex_env_p = ecma_get_lex_env_outer_reference (object_p);
     if (lex_env_p != NULL)
     {
-      ecma_gc_set_object_visited (lex_env_p, true);
+      visitor_p (lex_env_p, ECMA_GC_REFERENCE_ENVIRONMENT, data_p);
     }
 
     if (ecma_get_lex_env_type (object_p) != ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
     {
       ecma_object_t *binding_object_p = ecma_get_lex_env_binding_object (object_p);
-      ecma_gc_set_object_visited (binding_object_p, true);
+      visitor_p (binding_object_p, ECMA_GC_REFERENCE_BINDING, data_p);
 
       traverse_properties = false;
     }
@@ -268,7 +507,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
     ecma_object_t *proto_p = ecma_get_object_prototype (object_p);
     if (proto_p != NULL)
     {
-      ecma_gc_set_object_visited (proto_p, true);
+      visitor_p (proto_p, ECMA_GC_REFERENCE_PROTOTYPE, data_p);
     }
 
     switch (ecma_get_object_type (object_p))
@@ -285,7 +524,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
 
           if (ecma_is_value_object (result))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (result), true);
+            visitor_p (ecma_get_object_from_value (result), ECMA_GC_REFERENCE_INTERNAL, data_p);
           }
 
           /* Mark all reactions. */
@@ -294,14 +533,14 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
 
           while (ecma_collection_iterator_next (&iter))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (*iter.current_value_p), true);
+            visitor_p (ecma_get_object_from_value (*iter.current_value_p), ECMA_GC_REFERENCE_INTERNAL, data_p);
           }
 
           ecma_collection_iterator_init (&iter, ((ecma_promise_object_t *) ext_object_p)->reject_reactions);
 
           while (ecma_collection_iterator_next (&iter))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (*iter.current_value_p), true);
+            visitor_p (ecma_get_object_from_value (*iter.current_value_p), ECMA_GC_REFERENCE_INTERNAL, data_p);
           }
         }
 
@@ -319,14 +558,14 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
             ecma_object_t *lex_env_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_object_t,
                                                                         ext_object_p->u.pseudo_array.u2.lex_env_cp);
 
-            ecma_gc_set_object_visited (lex_env_p, true);
+            visitor_p (lex_env_p, ECMA_GC_REFERENCE_ENVIRONMENT, data_p);
             break;
           }
 #ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
           case ECMA_PSEUDO_ARRAY_TYPEDARRAY:
           case ECMA_PSEUDO_ARRAY_TYPEDARRAY_WITH_INFO:
           {
-            ecma_gc_set_object_visited (ecma_typedarray_get_arraybuffer (object_p), true);
+            visitor_p (ecma_typedarray_get_arraybuffer (object_p), ECMA_GC_REFERENCE_INTERNAL, data_p);
             break;
           }
 #endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
@@ -347,7 +586,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
         target_func_obj_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_object_t,
                                                              ext_function_p->u.bound_function.target_function);
 
-        ecma_gc_set_object_visited (target_func_obj_p, true);
+        visitor_p (target_func_obj_p, ECMA_GC_REFERENCE_INTERNAL, data_p);
 
         ecma_value_t args_len_or_this = ext_function_p->u.bound_function.args_len_or_this;
 
@@ -355,7 +594,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
         {
           if (ecma_is_value_object (args_len_or_this))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (args_len_or_this), true);
+            visitor_p (ecma_get_object_from_value (args_len_or_this), ECMA_GC_REFERENCE_INTERNAL, data_p);
           }
           break;
         }
@@ -369,7 +608,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
         {
           if (ecma_is_value_object (args_p[i]))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (args_p[i]), true);
+            visitor_p (ecma_get_object_from_value (args_p[i]), ECMA_GC_REFERENCE_INTERNAL, data_p);
           }
         }
         break;
@@ -383,10 +622,38 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
           ecma_object_t *scope_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_object_t,
                                                                     ext_func_p->u.function.scope_cp);
 
-          ecma_gc_set_object_visited (scope_p, true);
+          visitor_p (scope_p, ECMA_GC_REFERENCE_ENVIRONMENT, data_p);
+        }
+        break;
+      }
+#ifdef CONFIG_ECMA_FAST_ARRAY
+      case ECMA_OBJECT_TYPE_ARRAY:
+      {
+        ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+
+        if (!ext_object_p->u.array.is_fast)
+        {
+          break;
+        }
+
+        ecma_fast_array_header_t *header_p = ECMA_GET_POINTER (ecma_fast_array_header_t,
+                                                               ext_object_p->u.array.elements_cp);
+
+        if (header_p != NULL)
+        {
+          ecma_value_t *elements_p = ECMA_FAST_ARRAY_GET_ELEMENTS (header_p);
+
+          for (uint32_t i = 0; i < header_p->capacity; i++)
+          {
+            if (ecma_is_value_object (elements_p[i]))
+            {
+              visitor_p (ecma_get_object_from_value (elements_p[i]), ECMA_GC_REFERENCE_PROPERTY, data_p);
+            }
+          }
         }
         break;
       }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
       default:
       {
         break;
@@ -403,13 +670,43 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
       JERRY_ASSERT (prop_iter_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP
                     || ECMA_PROPERTY_IS_PROPERTY_PAIR (prop_iter_p));
 
-      ecma_gc_mark_property ((ecma_property_pair_t *) prop_iter_p, 0);
-      ecma_gc_mark_property ((ecma_property_pair_t *) prop_iter_p, 1);
+      ecma_gc_visit_property ((ecma_property_pair_t *) prop_iter_p, 0, visitor_p, data_p);
+      ecma_gc_visit_property ((ecma_property_pair_t *) prop_iter_p, 1, visitor_p, data_p);
 
       prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
                                       prop_iter_p->next_property_cp);
     }
   }
+} /* ecma_gc_visit_references */
+
+/**
+ * Mark a referenced object as visited, and push it onto the mark stack if it is not yet
+ */
+static inline void __attr_always_inline___
+ecma_gc_mark_reference (ecma_object_t *object_p, /**< referenced object */
+                        ecma_gc_reference_type_t type, /**< type of the reference */
+                        void *data_p) /**< unused */
+{
+  JERRY_UNUSED (type);
+  JERRY_UNUSED (data_p);
+
+  if (!ecma_gc_is_object_visited (object_p))
+  {
+    ecma_gc_visit_object (object_p);
+  }
+} /* ecma_gc_mark_reference */
+
+/**
+ * Mark the objects referenced from specified object as visited
+ */
+void
+ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
+{
+  JERRY_ASSERT (object_p != NULL);
+  JERRY_ASSERT (ecma_gc_is_object_visited (object_p));
+
+  /* The visitor is inlined, so marking does not pay for indirect calls */
+  ecma_gc_visit_references (object_p, ecma_gc_mark_reference, NULL);
 } /* ecma_gc_mark */
 
 /**
@@ -457,14 +754,17 @@ ecma_gc_free_native_pointer (ecma_property_t *property_p, /**< property */
 void
 ecma_gc_sweep (ecma_object_t *object_p) /**< object to free */
 {
-  JERRY_ASSERT (object_p != NULL
-  #ifndef GC_ON_ZERO_REFCOUNT
-                && !ecma_gc_is_object_visited (object_p)
-  #endif
-                && object_p->type_flags_refs < ECMA_OBJECT_REF_ONE);
+  /* The visited flag is checked by the callers: the flag of the objects left unswept
+   * by a lazy sweep is flipped with the flag of all other objects */
+  JERRY_ASSERT (object_p != NULL && object_p->type_flags_refs < ECMA_OBJECT_REF_ONE);
 
   bool obj_is_not_lex_env = !ecma_is_lexical_environment (object_p);
 
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  /* A new object allocated at the same address must not be watched. */
+  ecma_enum_cache_invalidate (object_p);
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
   if (obj_is_not_lex_env
       || ecma_get_lex_env_type (object_p) == ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
   {
@@ -512,7 +812,7 @@ ecma_gc_sweep (ecma_object_t *object_p) /**< object to free */
       prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
                                       prop_iter_p->next_property_cp);
 
-      ecma_dealloc_property_pair (prop_pair_p);
+      ecma_free_property_pair (object_p, prop_pair_p);
     }
   }
 
@@ -588,6 +888,20 @@ ecma_gc_sweep (ecma_object_t *object_p) /**< object to free */
 #ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
         case LIT_MAGIC_STRING_ARRAY_BUFFER_UL:
         {
+          if (ecma_arraybuffer_has_external_memory (object_p))
+          {
+            ecma_arraybuffer_external_info *array_object_p = (ecma_arraybuffer_external_info *) object_p;
+
+            if (array_object_p->free_cb != NULL)
+            {
+              array_object_p->free_cb (array_object_p->buffer_p);
+            }
+
+            ecma_dealloc_extended_object ((ecma_extended_object_t *) object_p,
+                                          sizeof (ecma_arraybuffer_external_info));
+            return;
+          }
+
           ecma_length_t arraybuffer_length = ext_object_p->u.class_prop.u.length;
           size_t size = sizeof (ecma_extended_object_t) + arraybuffer_length;
           ecma_dealloc_extended_object ((ecma_extended_object_t *) object_p, size);
@@ -616,6 +930,13 @@ ecma_gc_sweep (ecma_object_t *object_p) /**< object to free */
       return;
     }
 
+#ifdef CONFIG_ECMA_FAST_ARRAY
+    if (ecma_op_array_is_fast_array (object_p))
+    {
+      ecma_fast_array_free_elements (object_p);
+    }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
     if (ecma_get_object_is_builtin (object_p)
         || object_type == ECMA_OBJECT_TYPE_ARRAY
         || object_type == ECMA_OBJECT_TYPE_EXTERNAL_FUNCTION)
@@ -715,46 +1036,112 @@ ecma_gc_sweep (ecma_object_t *object_p) /**< object to free */
 } /* ecma_gc_sweep */
 
 /**
- * Run garbage collection
+ * Mark the objects referenced from stack or globals (i.e. roots) as visited
  */
-void
-ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
+static void
+ecma_gc_mark_roots (void)
 {
-  profile_gc_start(); /* Time profiling */
-#if defined(PROF_SIZE)
-  JERRY_CONTEXT(jmem_size_profiler_gc_count)++; /* Size profiling */
-#endif
-
-#ifndef GC_ON_ZERO_REFCOUNT
-  JERRY_CONTEXT (ecma_gc_new_objects) = 0;
-#endif
-
-  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] == NULL);
-
-  /* if some object is referenced from stack or globals (i.e. it is root), mark it */
   for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
        obj_iter_p != NULL;
        obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
   {
-    JERRY_ASSERT (!ecma_gc_is_object_visited (obj_iter_p));
+    if (obj_iter_p->type_flags_refs >= ECMA_OBJECT_REF_ONE
+        && !ecma_gc_is_object_visited (obj_iter_p))
+    {
+      ecma_gc_visit_object (obj_iter_p);
+    }
+  }
+} /* ecma_gc_mark_roots */
 
-    if (obj_iter_p->type_flags_refs >= ECMA_OBJECT_REF_ONE)
+/**
+ * Mark from the objects of the mark stack, until the stack is empty.
+ *
+ * Each object is marked from once when it is visited, so the marking is linear
+ * in the number of reachable objects whatever the shape of the object graph.
+ *
+ * @return true - if the mark stack is empty,
+ *         false - if the budget is exhausted
+ */
+static bool
+ecma_gc_mark_stacked_objects (uint32_t *budget_p) /**< [in, out] maximum number of objects to examine */
+{
+  uint32_t budget = *budget_p;
+  bool is_empty = true;
+
+  while (JERRY_CONTEXT (ecma_gc_mark_stack_count) > 0)
+  {
+    if (budget == 0)
     {
-      ecma_gc_set_object_visited (obj_iter_p, true);
+      is_empty = false;
+      break;
     }
+
+    budget--;
+
+    uint32_t count = JERRY_CONTEXT (ecma_gc_mark_stack_count) - 1;
+    JERRY_CONTEXT (ecma_gc_mark_stack_count) = count;
+
+    ecma_gc_mark (JERRY_CONTEXT (ecma_gc_mark_stack) [count]);
   }
 
-  bool marked_anything_during_current_iteration = false;
+  *budget_p = budget;
+  return is_empty;
+} /* ecma_gc_mark_stacked_objects */
 
-  do
+/**
+ * Move visited objects of the white-gray list to the black list.
+ *
+ * The objects are marked from through the mark stack. Only if the stack overflowed
+ * during the collection, the visited objects are marked from again when they are moved.
+ *
+ * The list is traversed from the object after *obj_prev_pp (or from the head if it is NULL),
+ * and traversing is repeated until nothing is moved during a whole traversal.
+ * At most 'budget' objects are examined; the position and the marking state
+ * of the current traversal are stored back to allow continuing later.
+ *
+ * @return true - if all reachable objects are marked,
+ *         false - if the budget is exhausted
+ */
+static bool
+ecma_gc_mark_visited_objects (ecma_object_t **obj_prev_pp, /**< [in, out] last unvisited object
+                                                            *   before the current position */
+                              bool *is_marked_in_pass_p, /**< [in, out] anything is marked
+                                                          *   during current traversal */
+                              uint32_t budget) /**< maximum number of objects to examine */
+{
+  ecma_object_t *obj_prev_p = *obj_prev_pp;
+  bool marked_anything_during_current_iteration = *is_marked_in_pass_p;
+
+  while (true)
   {
-    marked_anything_during_current_iteration = false;
+    ecma_object_t *obj_iter_p;
 
-    ecma_object_t *obj_prev_p = NULL;
-    ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+    if (obj_prev_p != NULL)
+    {
+      obj_iter_p = ecma_gc_get_object_next (obj_prev_p);
+    }
+    else
+    {
+      obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+    }
 
-    while (obj_iter_p != NULL)
+    while (true)
     {
+      if (!ecma_gc_mark_stacked_objects (&budget)
+          || (obj_iter_p != NULL && budget == 0))
+      {
+        *obj_prev_pp = obj_prev_p;
+        *is_marked_in_pass_p = marked_anything_during_current_iteration;
+        return false;
+      }
+
+      if (obj_iter_p == NULL)
+      {
+        break;
+      }
+
+      budget--;
+
       ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
 
       if (ecma_gc_is_object_visited (obj_iter_p))
@@ -774,7 +1161,11 @@ ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
           JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = obj_next_p;
         }
 
-        ecma_gc_mark (obj_iter_p);
+        if (unlikely (JERRY_CONTEXT (ecma_gc_is_mark_stack_overflowed)))
+        {
+          ecma_gc_mark (obj_iter_p);
+        }
+
         marked_anything_during_current_iteration = true;
       }
       else
@@ -784,44 +1175,524 @@ ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
 
       obj_iter_p = obj_next_p;
     }
+
+    if (!marked_anything_during_current_iteration)
+    {
+      break;
+    }
+
+    marked_anything_during_current_iteration = false;
+    obj_prev_p = NULL;
   }
-  while (marked_anything_during_current_iteration);
 
-  /* Sweeping objects that are currently unmarked */
-  ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+  *obj_prev_pp = NULL;
+  *is_marked_in_pass_p = false;
+  return true;
+} /* ecma_gc_mark_visited_objects */
 
-  while (obj_iter_p != NULL)
+#ifdef JMEM_LAZY_SWEEP
+/**
+ * Free a part of the dead objects left unswept by the last garbage collection.
+ *
+ * @return true - if no dead object is left unswept after the call,
+ *         false - if the budget is exhausted
+ */
+bool
+ecma_gc_sweep_step (uint32_t budget) /**< maximum number of objects to free */
+{
+  ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_unswept_objects_p);
+
+  if (obj_iter_p == NULL)
   {
-    ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
+    return true;
+  }
 
-    JERRY_ASSERT (!ecma_gc_is_object_visited (obj_iter_p));
+  while (obj_iter_p != NULL && budget > 0)
+  {
+    ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
 
     ecma_gc_sweep (obj_iter_p);
     obj_iter_p = obj_next_p;
+    budget--;
   }
 
-  if (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH)
+  JERRY_CONTEXT (ecma_gc_unswept_objects_p) = obj_iter_p;
+
+  if (obj_iter_p != NULL)
   {
-    /* Remove the property hashmap of BLACK objects */
-    obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK];
+    return false;
+  }
 
-    while (obj_iter_p != NULL)
-    {
-      JERRY_ASSERT (ecma_gc_is_object_visited (obj_iter_p));
+  ecma_gc_update_trigger ();
+  return true;
+} /* ecma_gc_sweep_step */
+#endif /* JMEM_LAZY_SWEEP */
 
-      if (!ecma_is_lexical_environment (obj_iter_p)
-          || ecma_get_lex_env_type (obj_iter_p) == ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
-      {
-        ecma_property_header_t *prop_iter_p = ecma_get_property_list (obj_iter_p);
+/**
+ * Start marking: mark the roots of the object graph
+ */
+static void
+ecma_gc_start_marking (void)
+{
+#ifndef GC_ON_ZERO_REFCOUNT
+  JERRY_CONTEXT (ecma_gc_new_objects) = 0;
+#endif
 
-        if (prop_iter_p != NULL && prop_iter_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP)
-        {
-          ecma_property_hashmap_free (obj_iter_p);
-        }
-      }
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] == NULL);
 
-      obj_iter_p = ecma_gc_get_object_next (obj_iter_p);
-    }
+#ifndef JERRY_NDEBUG
+  for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+       obj_iter_p != NULL;
+       obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
+  {
+    JERRY_ASSERT (!ecma_gc_is_object_visited (obj_iter_p));
+  }
+#endif /* !JERRY_NDEBUG */
+
+  ecma_gc_reset_mark_stack ();
+
+  /* if some object is referenced from stack or globals (i.e. it is root), mark it */
+  ecma_gc_mark_roots ();
+} /* ecma_gc_start_marking */
+
+#ifdef JMEM_INCREMENTAL_GC
+/**
+ * Record an object modified during incremental marking.
+ *
+ * A visited object may already be moved to the black list, so the references
+ * stored into it after that are marked again when the marking is finished.
+ */
+void
+ecma_gc_write_barrier (ecma_object_t *object_p) /**< modified object */
+{
+  if (likely (!JERRY_CONTEXT (ecma_gc_is_marking))
+      || !ecma_gc_is_object_visited (object_p))
+  {
+    return;
+  }
+
+  uint32_t rescan_count = JERRY_CONTEXT (ecma_gc_rescan_count);
+
+  if (rescan_count > 0
+      && JERRY_CONTEXT (ecma_gc_rescan_objects) [rescan_count - 1] == object_p)
+  {
+    return;
+  }
+
+  if (rescan_count < JMEM_INCREMENTAL_GC__RESCAN_SIZE)
+  {
+    JERRY_CONTEXT (ecma_gc_rescan_objects) [rescan_count] = object_p;
+    JERRY_CONTEXT (ecma_gc_rescan_count) = rescan_count + 1;
+  }
+  else
+  {
+    JERRY_CONTEXT (ecma_gc_is_rescan_overflowed) = true;
+  }
+} /* ecma_gc_write_barrier */
+
+/**
+ * Finish incremental marking: catch up with the changes made by the mutator
+ * between the marking slices, and mark the rest of reachable objects.
+ */
+static void
+ecma_gc_finish_marking (void)
+{
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_is_marking));
+
+  JERRY_CONTEXT (ecma_gc_is_marking) = false;
+
+  /* Objects referenced from stack or globals after the start of marking */
+  ecma_gc_mark_roots ();
+
+  /* Objects modified after being marked */
+  if (JERRY_CONTEXT (ecma_gc_is_rescan_overflowed))
+  {
+    for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK];
+         obj_iter_p != NULL;
+         obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
+    {
+      ecma_gc_mark (obj_iter_p);
+    }
+  }
+  else
+  {
+    for (uint32_t i = 0; i < JERRY_CONTEXT (ecma_gc_rescan_count); i++)
+    {
+      ecma_gc_mark (JERRY_CONTEXT (ecma_gc_rescan_objects) [i]);
+    }
+  }
+
+  JERRY_CONTEXT (ecma_gc_rescan_count) = 0;
+  JERRY_CONTEXT (ecma_gc_is_rescan_overflowed) = false;
+
+  ecma_object_t *obj_prev_p = NULL;
+  bool is_marked_in_pass = false;
+
+  while (!ecma_gc_mark_visited_objects (&obj_prev_p, &is_marked_in_pass, UINT32_MAX))
+  {
+  }
+} /* ecma_gc_finish_marking */
+
+/**
+ * Perform a slice of incremental garbage collection.
+ *
+ * A new cycle is started if enough objects are allocated since the last one.
+ * Marking of the cycle is performed over several calls; when it is complete,
+ * the unreachable objects are swept at once.
+ *
+ * @return true - if no garbage collection cycle is in progress after the call,
+ *         false - otherwise
+ */
+bool
+ecma_gc_incremental_step (uint32_t budget) /**< maximum number of objects to examine */
+{
+  JERRY_ASSERT (budget > 0);
+
+#ifdef JMEM_LAZY_SWEEP
+  /* The dead objects of the last cycle are freed before a new cycle is started */
+  if (!ecma_gc_sweep_step (budget))
+  {
+    return false;
+  }
+#endif /* JMEM_LAZY_SWEEP */
+
+  if (!JERRY_CONTEXT (ecma_gc_is_marking))
+  {
+    size_t new_objects_share = CONFIG_ECMA_GC_NEW_OBJECTS_SHARE_TO_START_GC;
+
+    if (JERRY_CONTEXT (ecma_gc_new_objects) * new_objects_share <= JERRY_CONTEXT (ecma_gc_objects_number))
+    {
+      return true;
+    }
+
+    ecma_gc_start_marking ();
+
+    JERRY_CONTEXT (ecma_gc_is_marking) = true;
+    JERRY_CONTEXT (ecma_gc_is_marked_in_pass) = false;
+    JERRY_CONTEXT (ecma_gc_mark_cursor_p) = NULL;
+    JERRY_CONTEXT (ecma_gc_rescan_count) = 0;
+    JERRY_CONTEXT (ecma_gc_is_rescan_overflowed) = false;
+  }
+
+  if (!ecma_gc_mark_visited_objects (&JERRY_CONTEXT (ecma_gc_mark_cursor_p),
+                                     &JERRY_CONTEXT (ecma_gc_is_marked_in_pass),
+                                     budget))
+  {
+    return false;
+  }
+
+  ecma_gc_run_internal (JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW, true);
+  return true;
+} /* ecma_gc_incremental_step */
+#endif /* JMEM_INCREMENTAL_GC */
+
+#ifdef JMEM_GENERATIONAL_GC
+/*
+ * Generational collection
+ *
+ * Objects are not moved, so the young generation is the prefix of the white-gray list
+ * which is allocated after the last collection. Between collections, objects which
+ * survived a collection (old objects) keep the visited state, and young objects
+ * are in unvisited state.
+ */
+
+/**
+ * Record an old object modified since the last garbage collection.
+ *
+ * The references stored into old objects are roots of the next minor collection.
+ */
+void
+ecma_gc_write_barrier (ecma_object_t *object_p) /**< modified object */
+{
+  if (!ecma_gc_is_object_visited (object_p))
+  {
+    return;
+  }
+
+  uint32_t remembered_count = JERRY_CONTEXT (ecma_gc_remembered_count);
+
+  if (remembered_count > 0
+      && JERRY_CONTEXT (ecma_gc_remembered_objects) [remembered_count - 1] == object_p)
+  {
+    return;
+  }
+
+  if (remembered_count < JMEM_GENERATIONAL_GC__REMEMBERED_SET_SIZE)
+  {
+    JERRY_CONTEXT (ecma_gc_remembered_objects) [remembered_count] = object_p;
+    JERRY_CONTEXT (ecma_gc_remembered_count) = remembered_count + 1;
+  }
+  else
+  {
+    JERRY_CONTEXT (ecma_gc_is_remembered_set_overflowed) = true;
+  }
+} /* ecma_gc_write_barrier */
+
+/**
+ * Reset the generations after a collection: all objects become old
+ */
+static void
+ecma_gc_reset_generations (void)
+{
+  JERRY_CONTEXT (ecma_gc_old_objects_p) = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+  JERRY_CONTEXT (ecma_gc_remembered_count) = 0;
+  JERRY_CONTEXT (ecma_gc_is_remembered_set_overflowed) = false;
+} /* ecma_gc_reset_generations */
+
+/**
+ * Check whether a minor collection is sufficient for the next collection
+ *
+ * @return true - if the remembered set holds all modified old objects and
+ *                the limit of successive minor collections is not reached,
+ *         false - otherwise
+ */
+static bool
+ecma_gc_is_minor_gc_possible (void)
+{
+  return (!JERRY_CONTEXT (ecma_gc_is_remembered_set_overflowed)
+          && JERRY_CONTEXT (ecma_gc_minor_gc_count) < JMEM_GENERATIONAL_GC__MAX_MINOR_GCS);
+} /* ecma_gc_is_minor_gc_possible */
+
+/**
+ * Run minor garbage collection
+ *
+ * Only young objects are collected and all old objects are considered alive.
+ * The roots are referenced young objects and the remembered old objects,
+ * so the cost is proportional to the young objects instead of the whole heap.
+ */
+static void
+ecma_gc_run_minor (void)
+{
+  JERRY_ASSERT (ecma_gc_is_minor_gc_possible ());
+
+  profile_gc_start(); /* Time profiling */
+  profile_gc_cycles_start(); /* PMU profiling */
+
+#ifndef GC_ON_ZERO_REFCOUNT
+  JERRY_CONTEXT (ecma_gc_new_objects) = 0;
+#endif
+
+  JERRY_CONTEXT (ecma_gc_minor_gc_count)++;
+  ecma_gc_start_stats ();
+
+  ecma_object_t *old_objects_p = JERRY_CONTEXT (ecma_gc_old_objects_p);
+
+  ecma_gc_reset_mark_stack ();
+
+  /* if some young object is referenced from stack or globals (i.e. it is root), mark it */
+  for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+       obj_iter_p != old_objects_p;
+       obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
+  {
+    if (obj_iter_p->type_flags_refs >= ECMA_OBJECT_REF_ONE)
+    {
+      ecma_gc_visit_object (obj_iter_p);
+    }
+  }
+
+  /* young objects referenced from old objects */
+  for (uint32_t i = 0; i < JERRY_CONTEXT (ecma_gc_remembered_count); i++)
+  {
+    ecma_gc_mark (JERRY_CONTEXT (ecma_gc_remembered_objects) [i]);
+  }
+
+  uint32_t budget = UINT32_MAX;
+  ecma_object_t *promoted_objects_p = NULL;
+  ecma_object_t *promoted_objects_tail_p = NULL;
+  bool marked_anything_during_current_iteration = false;
+
+  do
+  {
+    marked_anything_during_current_iteration = false;
+
+    ecma_object_t *obj_prev_p = NULL;
+    ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+
+    while (true)
+    {
+      ecma_gc_mark_stacked_objects (&budget);
+
+      if (obj_iter_p == old_objects_p)
+      {
+        break;
+      }
+
+      ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
+
+      if (ecma_gc_is_object_visited (obj_iter_p))
+      {
+        /* Moving the object to list of promoted objects */
+        ecma_gc_set_object_next (obj_iter_p, promoted_objects_p);
+        promoted_objects_p = obj_iter_p;
+
+        if (promoted_objects_tail_p == NULL)
+        {
+          promoted_objects_tail_p = obj_iter_p;
+        }
+
+        if (likely (obj_prev_p != NULL))
+        {
+          ecma_gc_set_object_next (obj_prev_p, obj_next_p);
+        }
+        else
+        {
+          JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = obj_next_p;
+        }
+
+        if (unlikely (JERRY_CONTEXT (ecma_gc_is_mark_stack_overflowed)))
+        {
+          ecma_gc_mark (obj_iter_p);
+        }
+
+        marked_anything_during_current_iteration = true;
+      }
+      else
+      {
+        obj_prev_p = obj_iter_p;
+      }
+
+      obj_iter_p = obj_next_p;
+    }
+  }
+  while (marked_anything_during_current_iteration);
+
+  /* Sweeping young objects that are currently unmarked */
+  ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+
+  while (obj_iter_p != old_objects_p)
+  {
+    ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
+
+    JERRY_ASSERT (!ecma_gc_is_object_visited (obj_iter_p));
+
+    ecma_gc_sweep (obj_iter_p);
+    obj_iter_p = obj_next_p;
+  }
+
+  /* Promoting the surviving young objects, which are kept in visited state */
+  if (promoted_objects_tail_p != NULL)
+  {
+    ecma_gc_set_object_next (promoted_objects_tail_p, old_objects_p);
+    JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = promoted_objects_p;
+  }
+  else
+  {
+    JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = old_objects_p;
+  }
+
+  ecma_gc_reset_generations ();
+
+#ifndef CONFIG_DISABLE_REGEXP_BUILTIN
+  /* Free RegExp bytecodes stored in cache */
+  re_cache_gc_run ();
+#endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
+
+  ecma_gc_end_stats (false);
+
+  profile_gc_cycles_end(); /* PMU profiling */
+  profile_gc_end(); /* Time profiling */
+} /* ecma_gc_run_minor */
+#endif /* JMEM_GENERATIONAL_GC */
+
+/**
+ * Run garbage collection
+ *
+ * If the sweep is deferred, the dead objects are left to ecma_gc_sweep_step or to the next
+ * collection, so the pause is only as long as the marking.
+ */
+static void
+ecma_gc_run_internal (jmem_free_unused_memory_severity_t severity, /**< gc severity */
+                      bool is_sweep_deferred) /**< leave the dead objects unswept (with JMEM_LAZY_SWEEP) */
+{
+#ifdef JMEM_LAZY_SWEEP
+  ecma_gc_sweep_step (UINT32_MAX);
+#else /* !JMEM_LAZY_SWEEP */
+  is_sweep_deferred = false;
+#endif /* JMEM_LAZY_SWEEP */
+
+  ecma_gc_start_stats ();
+
+  profile_gc_start(); /* Time profiling */
+  profile_gc_cycles_start(); /* PMU profiling */
+#if defined(PROF_SIZE)
+  JERRY_CONTEXT(jmem_size_profiler_gc_count)++; /* Size profiling */
+#endif
+
+#ifdef JMEM_GENERATIONAL_GC
+  /* Make young objects visited like old ones, and then unvisit all objects */
+  for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+       obj_iter_p != JERRY_CONTEXT (ecma_gc_old_objects_p);
+       obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
+  {
+    ecma_gc_set_object_visited (obj_iter_p, true);
+  }
+
+  JERRY_CONTEXT (ecma_gc_visited_flip_flag) = !JERRY_CONTEXT (ecma_gc_visited_flip_flag);
+  JERRY_CONTEXT (ecma_gc_minor_gc_count) = 0;
+#endif /* JMEM_GENERATIONAL_GC */
+
+#ifdef JMEM_INCREMENTAL_GC
+  if (JERRY_CONTEXT (ecma_gc_is_marking))
+  {
+    ecma_gc_finish_marking ();
+  }
+  else
+#endif /* JMEM_INCREMENTAL_GC */
+  {
+    ecma_object_t *obj_prev_p = NULL;
+    bool is_marked_in_pass = false;
+
+    ecma_gc_start_marking ();
+
+    while (!ecma_gc_mark_visited_objects (&obj_prev_p, &is_marked_in_pass, UINT32_MAX))
+    {
+    }
+  }
+
+  /* Sweeping objects that are currently unmarked */
+  ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+
+#ifdef JMEM_LAZY_SWEEP
+  if (is_sweep_deferred)
+  {
+    /* The list of unmarked objects is not referenced by anything else */
+    JERRY_CONTEXT (ecma_gc_unswept_objects_p) = obj_iter_p;
+    obj_iter_p = NULL;
+  }
+#endif /* JMEM_LAZY_SWEEP */
+
+  while (obj_iter_p != NULL)
+  {
+    ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
+
+    JERRY_ASSERT (!ecma_gc_is_object_visited (obj_iter_p));
+
+    ecma_gc_sweep (obj_iter_p);
+    obj_iter_p = obj_next_p;
+  }
+
+  if (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH)
+  {
+    /* Remove the property hashmap of BLACK objects */
+    obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK];
+
+    while (obj_iter_p != NULL)
+    {
+      JERRY_ASSERT (ecma_gc_is_object_visited (obj_iter_p));
+
+      if (!ecma_is_lexical_environment (obj_iter_p)
+          || ecma_get_lex_env_type (obj_iter_p) == ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
+      {
+        ecma_property_header_t *prop_iter_p = ecma_get_property_list (obj_iter_p);
+
+        if (prop_iter_p != NULL && prop_iter_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP)
+        {
+          ecma_property_hashmap_free (obj_iter_p);
+        }
+      }
+
+      obj_iter_p = ecma_gc_get_object_next (obj_iter_p);
+    }
   }
 
   /* Unmarking all objects */
@@ -829,14 +1700,36 @@ ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
   JERRY_CONTEXT (ecma_gc_objects_lists)[ECMA_GC_COLOR_WHITE_GRAY] = black_objects;
   JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] = NULL;
 
+#ifdef JMEM_GENERATIONAL_GC
+  /* Surviving objects become old, which are kept in visited state */
+  ecma_gc_reset_generations ();
+#else /* !JMEM_GENERATIONAL_GC */
   JERRY_CONTEXT (ecma_gc_visited_flip_flag) = !JERRY_CONTEXT (ecma_gc_visited_flip_flag);
+#endif /* JMEM_GENERATIONAL_GC */
 
 #ifndef CONFIG_DISABLE_REGEXP_BUILTIN
   /* Free RegExp bytecodes stored in cache */
   re_cache_gc_run ();
 #endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
 
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+  /* Release the property names which are not used by any property */
+  ecma_intern_gc_run ();
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
+
+  ecma_gc_end_stats (is_sweep_deferred);
+
+  profile_gc_cycles_end(); /* PMU profiling */
   profile_gc_end(); /* Time profiling */
+} /* ecma_gc_run_internal */
+
+/**
+ * Run garbage collection, and free the dead objects at once
+ */
+void
+ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
+{
+  ecma_gc_run_internal (severity, false);
 } /* ecma_gc_run */
 
 /**
@@ -856,6 +1749,15 @@ ecma_free_unused_memory (jmem_free_unused_memory_severity_t severity) /**< sever
 
   if (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW)
   {
+#ifdef JMEM_LAZY_SWEEP
+    /* Freeing the dead objects of the last collection is cheaper than a new collection */
+    if (JERRY_CONTEXT (ecma_gc_unswept_objects_p) != NULL)
+    {
+      ecma_gc_sweep_step (UINT32_MAX);
+      return;
+    }
+#endif /* JMEM_LAZY_SWEEP */
+
 #ifndef CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE
     if (JERRY_CONTEXT (ecma_prop_hashmap_alloc_state) > ECMA_PROP_HASHMAP_ALLOC_ON)
     {
@@ -870,10 +1772,28 @@ ecma_free_unused_memory (jmem_free_unused_memory_severity_t severity) /**< sever
      * Otherwise, probability to free sufficient space is considered to be low.
      */
     size_t new_objects_share = CONFIG_ECMA_GC_NEW_OBJECTS_SHARE_TO_START_GC;
+    bool is_worthwhile = (JERRY_CONTEXT (ecma_gc_new_objects) * new_objects_share
+                          > JERRY_CONTEXT (ecma_gc_objects_number));
+    size_t trigger_size = JERRY_CONTEXT (ecma_gc_stats).trigger_size;
 
-    if (JERRY_CONTEXT (ecma_gc_new_objects) * new_objects_share > JERRY_CONTEXT (ecma_gc_objects_number))
+    if (trigger_size != 0)
     {
-      ecma_gc_run (severity);
+      /* With the adaptive trigger, it is worthwhile once half of the planned growth is used,
+       * so an idle-time collection may come before the trigger is reached */
+      size_t live_size = JERRY_MIN (JERRY_CONTEXT (ecma_gc_stats).live_size, trigger_size);
+      is_worthwhile = JERRY_CONTEXT (jmem_heap_blocks_size) >= live_size + (trigger_size - live_size) / 2;
+    }
+
+    if (is_worthwhile)
+    {
+#ifdef JMEM_GENERATIONAL_GC
+      if (ecma_gc_is_minor_gc_possible ())
+      {
+        ecma_gc_run_minor ();
+        return;
+      }
+#endif /* JMEM_GENERATIONAL_GC */
+      ecma_gc_run_internal (severity, true);
     }
 #endif
   }
@@ -893,11 +1813,385 @@ ecma_free_unused_memory (jmem_free_unused_memory_severity_t severity) /**< sever
     }
 #endif /* !CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE */
 
+#ifdef CONFIG_ECMA_ENUM_CACHE
+    ecma_enum_cache_flush ();
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
     /* Freeing as much memory as we currently can */
     ecma_gc_run (severity);
   }
 } /* ecma_free_unused_memory */
 
+#ifdef JMEM_HEAP_SNAPSHOT
+/*
+ * Heap snapshot
+ *
+ * The snapshot is taken right after a full collection, so all objects in the
+ * object list are alive. It is a text file of a record per line:
+ *
+ *   heap-snapshot <version> <segment size>
+ *   N <id> <type> <size> <references from native code or stack> <segment index>
+ *   P <id of owner> <size> <segment index>     (property pair of an object)
+ *   E <id of retainer> <id> <reference type>
+ *   S <segment index> <index of leading segment in group> <occupied size>
+ *
+ * Ids are heap offsets. Objects referenced from native code or stack are the
+ * roots of the graph. Strings, numbers and byte code are not recorded.
+ */
+
+/**
+ * Version of the heap snapshot format
+ */
+#define ECMA_GC_HEAP_SNAPSHOT_VERSION 1
+
+/**
+ * Names of object types in the heap snapshot
+ */
+static const char * const ecma_gc_snapshot_object_type_names[] =
+{
+  "object", "class", "function", "external_function", "array", "bound_function", "pseudo_array"
+};
+
+/**
+ * Names of lexical environment types in the heap snapshot
+ */
+static const char * const ecma_gc_snapshot_lex_env_type_names[] =
+{
+  "declarative_env", "object_bound_env", "this_object_bound_env"
+};
+
+/**
+ * Names of reference types in the heap snapshot
+ */
+static const char * const ecma_gc_snapshot_reference_type_names[] =
+{
+  "property", "prototype", "environment", "binding", "internal"
+};
+
+/**
+ * State of heap snapshot writing passed to the reference visitor
+ */
+typedef struct
+{
+  FILE *fp; /**< snapshot file */
+  uint32_t retainer_id; /**< id of the object visited from */
+} ecma_gc_snapshot_writer_t;
+
+/**
+ * Get the id of a heap block in the snapshot
+ *
+ * @return offset of the block in the heap
+ */
+static uint32_t
+ecma_gc_snapshot_get_id (void *block_p) /**< heap block */
+{
+  return JMEM_COMPRESS_POINTER_INTERNAL ((jmem_heap_free_t *) block_p);
+} /* ecma_gc_snapshot_get_id */
+
+/**
+ * Get the segment index of a heap block in the snapshot
+ *
+ * @return segment index - if the heap is segmented,
+ *         0 - otherwise
+ */
+static uint32_t
+ecma_gc_snapshot_get_segment (void *block_p) /**< heap block */
+{
+#ifdef JMEM_SEGMENTED_HEAP
+  return ecma_gc_snapshot_get_id (block_p) >> SEG_SEGMENT_SHIFT;
+#else /* !JMEM_SEGMENTED_HEAP */
+  JERRY_UNUSED (block_p);
+  return 0;
+#endif /* JMEM_SEGMENTED_HEAP */
+} /* ecma_gc_snapshot_get_segment */
+
+/**
+ * Get the allocated size of an object, without its property pairs
+ *
+ * Note:
+ *      the size is calculated in the same way as ecma_gc_sweep frees the object
+ *
+ * @return size of the object
+ */
+static size_t
+ecma_gc_snapshot_get_object_size (ecma_object_t *object_p) /**< object */
+{
+  if (ecma_is_lexical_environment (object_p))
+  {
+    return ECMA_OBJECT_SIZE;
+  }
+
+  ecma_object_type_t object_type = ecma_get_object_type (object_p);
+  size_t ext_object_size = sizeof (ecma_extended_object_t);
+
+  if (ecma_get_object_is_builtin (object_p))
+  {
+    uint8_t length_and_bitset_size;
+
+    if (object_type == ECMA_OBJECT_TYPE_CLASS
+        || object_type == ECMA_OBJECT_TYPE_ARRAY)
+    {
+      ext_object_size = sizeof (ecma_extended_built_in_object_t);
+      length_and_bitset_size = ((ecma_extended_built_in_object_t *) object_p)->built_in.length_and_bitset_size;
+    }
+    else
+    {
+      length_and_bitset_size = ((ecma_extended_object_t *) object_p)->u.built_in.length_and_bitset_size;
+    }
+
+    ext_object_size += (2 * sizeof (uint32_t)) * (length_and_bitset_size >> ECMA_BUILT_IN_BITSET_SHIFT);
+  }
+
+  if (object_type == ECMA_OBJECT_TYPE_CLASS)
+  {
+    ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+
+    switch (ext_object_p->u.class_prop.class_id)
+    {
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+      case LIT_MAGIC_STRING_ARRAY_BUFFER_UL:
+      {
+        if (ecma_arraybuffer_has_external_memory (object_p))
+        {
+          return sizeof (ecma_arraybuffer_external_info);
+        }
+
+        return sizeof (ecma_extended_object_t) + ext_object_p->u.class_prop.u.length;
+      }
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
+      case LIT_MAGIC_STRING_PROMISE_UL:
+      {
+        return sizeof (ecma_promise_object_t);
+      }
+#endif /* !CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
+      default:
+      {
+        return ext_object_size;
+      }
+    }
+  }
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  if (ecma_op_array_is_fast_array (object_p))
+  {
+    ecma_fast_array_header_t *header_p;
+    header_p = ECMA_GET_POINTER (ecma_fast_array_header_t,
+                                 ((ecma_extended_object_t *) object_p)->u.array.elements_cp);
+
+    if (header_p != NULL)
+    {
+      return ext_object_size + ECMA_FAST_ARRAY_BUFFER_SIZE (header_p->capacity);
+    }
+  }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
+  if (ecma_get_object_is_builtin (object_p)
+      || object_type == ECMA_OBJECT_TYPE_ARRAY
+      || object_type == ECMA_OBJECT_TYPE_EXTERNAL_FUNCTION
+      || object_type == ECMA_OBJECT_TYPE_FUNCTION)
+  {
+    return ext_object_size;
+  }
+
+  if (object_type == ECMA_OBJECT_TYPE_PSEUDO_ARRAY)
+  {
+    ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+    if (ext_object_p->u.pseudo_array.type == ECMA_PSEUDO_ARRAY_TYPEDARRAY)
+    {
+      return sizeof (ecma_extended_object_t);
+    }
+
+    if (ext_object_p->u.pseudo_array.type == ECMA_PSEUDO_ARRAY_TYPEDARRAY_WITH_INFO)
+    {
+      return sizeof (ecma_extended_typedarray_object_t);
+    }
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+
+    JERRY_ASSERT (ext_object_p->u.pseudo_array.type == ECMA_PSEUDO_ARRAY_ARGUMENTS);
+
+    ecma_length_t formal_params_number = ext_object_p->u.pseudo_array.u1.length;
+    return sizeof (ecma_extended_object_t) + formal_params_number * sizeof (jmem_cpointer_t);
+  }
+
+  if (object_type == ECMA_OBJECT_TYPE_BOUND_FUNCTION)
+  {
+    ecma_extended_object_t *ext_function_p = (ecma_extended_object_t *) object_p;
+    ecma_value_t args_len_or_this = ext_function_p->u.bound_function.args_len_or_this;
+
+    if (!ecma_is_value_integer_number (args_len_or_this))
+    {
+      return sizeof (ecma_extended_object_t);
+    }
+
+    ecma_integer_value_t args_length = ecma_get_integer_from_value (args_len_or_this);
+    return sizeof (ecma_extended_object_t) + ((size_t) args_length) * sizeof (ecma_value_t);
+  }
+
+  return ECMA_OBJECT_SIZE;
+} /* ecma_gc_snapshot_get_object_size */
+
+/**
+ * Write a reference of the visited object to the heap snapshot
+ */
+static void
+ecma_gc_snapshot_write_reference (ecma_object_t *object_p, /**< referenced object */
+                                  ecma_gc_reference_type_t type, /**< type of the reference */
+                                  void *data_p) /**< snapshot writer */
+{
+  ecma_gc_snapshot_writer_t *writer_p = (ecma_gc_snapshot_writer_t *) data_p;
+
+  fprintf (writer_p->fp, "E %u %u %s\n",
+           (unsigned int) writer_p->retainer_id,
+           (unsigned int) ecma_gc_snapshot_get_id (object_p),
+           ecma_gc_snapshot_reference_type_names[type]);
+} /* ecma_gc_snapshot_write_reference */
+
+/**
+ * Write an object, its property pairs and its references to the heap snapshot
+ */
+static void
+ecma_gc_snapshot_write_object (ecma_gc_snapshot_writer_t *writer_p, /**< snapshot writer */
+                               ecma_object_t *object_p) /**< object */
+{
+  uint32_t id = ecma_gc_snapshot_get_id (object_p);
+  const char *type_name_p;
+
+  if (ecma_is_lexical_environment (object_p))
+  {
+    type_name_p = ecma_gc_snapshot_lex_env_type_names[ecma_get_lex_env_type (object_p)
+                                                      - ECMA_LEXICAL_ENVIRONMENT_TYPE_START];
+  }
+  else
+  {
+    type_name_p = ecma_gc_snapshot_object_type_names[ecma_get_object_type (object_p)];
+  }
+
+  fprintf (writer_p->fp, "N %u %s %u %u %u\n",
+           (unsigned int) id,
+           type_name_p,
+           (unsigned int) ecma_gc_snapshot_get_object_size (object_p),
+           (unsigned int) (object_p->type_flags_refs / ECMA_OBJECT_REF_ONE),
+           (unsigned int) ecma_gc_snapshot_get_segment (object_p));
+
+  if (!ecma_is_lexical_environment (object_p)
+      || ecma_get_lex_env_type (object_p) == ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
+  {
+    ecma_property_header_t *prop_iter_p = ecma_get_property_list (object_p);
+
+    if (prop_iter_p != NULL && prop_iter_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP)
+    {
+      /* The hashmap is a cache which can be freed at any collection. */
+      prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
+                                      prop_iter_p->next_property_cp);
+    }
+
+    while (prop_iter_p != NULL)
+    {
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+      /* The inline property pair is a part of the object. */
+      if ((ecma_property_pair_t *) prop_iter_p == ECMA_OBJECT_INLINE_PROPERTY_PAIR (object_p))
+      {
+        prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
+                                        prop_iter_p->next_property_cp);
+        continue;
+      }
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
+
+      fprintf (writer_p->fp, "P %u %u %u\n",
+               (unsigned int) id,
+               (unsigned int) sizeof (ecma_property_pair_t),
+               (unsigned int) ecma_gc_snapshot_get_segment (prop_iter_p));
+
+      prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
+                                      prop_iter_p->next_property_cp);
+    }
+  }
+
+  writer_p->retainer_id = id;
+  ecma_gc_visit_references (object_p, ecma_gc_snapshot_write_reference, writer_p);
+} /* ecma_gc_snapshot_write_object */
+
+/**
+ * Write the segments of the heap to the heap snapshot
+ */
+static void
+ecma_gc_snapshot_write_segments (ecma_gc_snapshot_writer_t *writer_p) /**< snapshot writer */
+{
+#ifdef JMEM_SEGMENTED_HEAP
+  uint32_t group_start_sidx = 0;
+
+  for (uint32_t sidx = 0; sidx < SEG_NUM_SEGMENTS; sidx++)
+  {
+    if (JERRY_HEAP_CONTEXT (area[sidx]) == NULL)
+    {
+      continue;
+    }
+
+    jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT (segments[sidx]);
+
+    if (segment_header->group_num_segments > 0)
+    {
+      group_start_sidx = sidx;
+    }
+
+    fprintf (writer_p->fp, "S %u %u %u\n",
+             (unsigned int) sidx,
+             (unsigned int) group_start_sidx,
+             (unsigned int) segment_header->occupied_size);
+  }
+#else /* !JMEM_SEGMENTED_HEAP */
+  JERRY_UNUSED (writer_p);
+#endif /* JMEM_SEGMENTED_HEAP */
+} /* ecma_gc_snapshot_write_segments */
+
+/**
+ * Collect garbage and write the live objects of the heap to a snapshot file
+ *
+ * @return true - if the snapshot is written,
+ *         false - if the file cannot be opened
+ */
+bool
+ecma_gc_write_heap_snapshot (const char *path_p) /**< path of the snapshot file */
+{
+  JERRY_ASSERT (path_p != NULL);
+
+  FILE *fp = fopen (path_p, "w");
+
+  if (fp == NULL)
+  {
+    return false;
+  }
+
+  /* Only reachable objects are left in the object list */
+  ecma_gc_run (JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW);
+
+  ecma_gc_snapshot_writer_t writer;
+  writer.fp = fp;
+  writer.retainer_id = 0;
+
+#ifdef JMEM_SEGMENTED_HEAP
+  fprintf (fp, "heap-snapshot %u %u\n", ECMA_GC_HEAP_SNAPSHOT_VERSION, (unsigned int) SEG_SEGMENT_SIZE);
+#else /* !JMEM_SEGMENTED_HEAP */
+  fprintf (fp, "heap-snapshot %u %u\n", ECMA_GC_HEAP_SNAPSHOT_VERSION, (unsigned int) JMEM_HEAP_SIZE);
+#endif /* JMEM_SEGMENTED_HEAP */
+
+  for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+       obj_iter_p != NULL;
+       obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
+  {
+    ecma_gc_snapshot_write_object (&writer, obj_iter_p);
+  }
+
+  ecma_gc_snapshot_write_segments (&writer);
+
+  fclose (fp);
+  return true;
+} /* ecma_gc_write_heap_snapshot */
+#endif /* JMEM_HEAP_SNAPSHOT */
+
 /**
  * @}
  * @}
@@ -31,6 +31,30 @@ void ecma_ref_object (ecma_object_t *object_p);
 void ecma_deref_object (ecma_object_t *object_p);
 void ecma_gc_run (jmem_free_unused_memory_severity_t severity);
 void ecma_free_unused_memory (jmem_free_unused_memory_severity_t severity);
+void ecma_gc_apply_trigger (void);
+
+#ifdef JMEM_INCREMENTAL_GC
+bool ecma_gc_incremental_step (uint32_t budget);
+#endif /* JMEM_INCREMENTAL_GC */
+
+#ifdef JMEM_LAZY_SWEEP
+bool ecma_gc_sweep_step (uint32_t budget);
+#endif /* JMEM_LAZY_SWEEP */
+
+#ifdef JMEM_HEAP_SNAPSHOT
+bool ecma_gc_write_heap_snapshot (const char *path_p);
+#endif /* JMEM_HEAP_SNAPSHOT */
+
+#if defined (JMEM_INCREMENTAL_GC) || defined (JMEM_GENERATIONAL_GC)
+void ecma_gc_write_barrier (ecma_object_t *object_p);
+
+/**
+ * Record modification of an object for incremental marking or minor collection
+ */
+#define ECMA_GC_WRITE_BARRIER(object_p) ecma_gc_write_barrier (object_p)
+#else /* !JMEM_INCREMENTAL_GC && !JMEM_GENERATIONAL_GC */
+#define ECMA_GC_WRITE_BARRIER(object_p)
+#endif /* JMEM_INCREMENTAL_GC || JMEM_GENERATIONAL_GC */
 
 /**
  * @}
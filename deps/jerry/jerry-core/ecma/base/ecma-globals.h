@@ -63,6 +63,7 @@ typedef enum
   ECMA_INIT_SHOW_REGEXP_OPCODES = (1u << 1), /**< dump regexp byte-code to log after compilation */
   ECMA_INIT_MEM_STATS           = (1u << 2), /**< dump memory statistics */
   ECMA_INIT_JMEM_LOGS_ENABLED   = (1u << 5), /**< jmem logs enabled */
+  ECMA_INIT_PARSER_OPTIMIZE     = (1u << 6), /**< slower parser optimizations, e.g. for saving snapshots */
 } ecma_init_flag_t;
 
 /**
@@ -675,6 +676,30 @@ typedef struct
   jmem_cpointer_t prototype_or_outer_reference_cp;
 } ecma_object_t;
 
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+
+/**
+ * Size of an object which is not an extended object: the object header
+ * followed by its inline property pair.
+ */
+#define ECMA_OBJECT_SIZE (sizeof (ecma_object_t) + sizeof (ecma_property_pair_t))
+
+/**
+ * Get the inline property pair of an object which is not an extended object.
+ *
+ * The pair is not in the property list while both of its properties are deleted.
+ */
+#define ECMA_OBJECT_INLINE_PROPERTY_PAIR(object_p) ((ecma_property_pair_t *) ((object_p) + 1))
+
+#else /* !CONFIG_ECMA_INLINE_PROPERTY_PAIR */
+
+/**
+ * Size of an object which is not an extended object.
+ */
+#define ECMA_OBJECT_SIZE (sizeof (ecma_object_t))
+
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
+
 /**
  * Description of built-in properties of an object.
  */
@@ -714,6 +739,7 @@ typedef struct
     struct
     {
       uint16_t class_id; /**< class id of the object */
+      uint16_t extra_info; /**< additional information about the object (e.g. flags of ArrayBuffer) */
 
       /*
        * Description of extra fields. These extra fields depends on the class_id.
@@ -741,6 +767,10 @@ typedef struct
     {
       uint32_t length; /**< length property value */
       ecma_property_t length_prop; /**< length property */
+#ifdef CONFIG_ECMA_FAST_ARRAY
+      uint8_t is_fast; /**< the elements are stored in the elements buffer */
+      jmem_cpointer_t elements_cp; /**< elements buffer (ecma_fast_array_header_t) of a fast array */
+#endif /* CONFIG_ECMA_FAST_ARRAY */
     } array;
 
     /*
@@ -785,6 +815,30 @@ typedef struct
   ecma_built_in_props_t built_in; /**< built-in object part */
 } ecma_extended_built_in_object_t;
 
+#ifdef CONFIG_ECMA_FAST_ARRAY
+/**
+ * Header of the elements buffer of a fast array.
+ *
+ * The header is followed by capacity element slots. An element slot holds the value
+ * of the element or ECMA_SIMPLE_VALUE_ARRAY_HOLE if the element does not exist.
+ */
+typedef struct
+{
+  uint32_t capacity; /**< number of element slots */
+} ecma_fast_array_header_t;
+
+/**
+ * Get the element slots of a fast array elements buffer
+ */
+#define ECMA_FAST_ARRAY_GET_ELEMENTS(header_p) ((ecma_value_t *) ((header_p) + 1))
+
+/**
+ * Size of a fast array elements buffer with the specified number of element slots
+ */
+#define ECMA_FAST_ARRAY_BUFFER_SIZE(capacity) \
+  (sizeof (ecma_fast_array_header_t) + ((size_t) (capacity)) * sizeof (ecma_value_t))
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
 /**
  * Description of ECMA property descriptor
  *
@@ -1006,33 +1060,26 @@ typedef double ecma_number_t;
  */
 #define ECMA_STRING_NOT_ARRAY_INDEX UINT32_MAX
 
+/**
+ * Capacity of the smallest buffer of a collection
+ */
+#define ECMA_COLLECTION_INITIAL_CAPACITY 2
+
 /**
  * Description of a collection's header.
+ *
+ * The elements are stored contiguously in a single heap block, whose capacity is the
+ * number of the elements rounded up to a power of 2 (at least ECMA_COLLECTION_INITIAL_CAPACITY).
  */
 typedef struct
 {
   /** Number of elements in the collection */
   ecma_length_t unit_number;
 
-  /** Compressed pointer to first chunk with collection's data */
-  jmem_cpointer_t first_chunk_cp;
-
-  /** Compressed pointer to last chunk with collection's data */
-  jmem_cpointer_t last_chunk_cp;
+  /** Compressed pointer to the buffer of the elements, NULL if the collection is empty */
+  jmem_cpointer_t buffer_cp;
 } ecma_collection_header_t;
 
-/**
- * Description of non-first chunk in a collection's chain of chunks
- */
-typedef struct
-{
-  /** Characters */
-  lit_utf8_byte_t data[ sizeof (uint64_t) - sizeof (jmem_cpointer_t) ];
-
-  /** Compressed pointer to next chunk */
-  jmem_cpointer_t next_chunk_cp;
-} ecma_collection_chunk_t;
-
 /**
  * Identifier for ecma-string's actual data container
  */
@@ -1051,7 +1098,12 @@ typedef enum
                                *   so no string processing function supports this type except
                                *   the ecma_deref_ecma_string function. */
 
-  ECMA_STRING_CONTAINER__MAX = ECMA_STRING_LITERAL_NUMBER /**< maximum value */
+  ECMA_STRING_CONTAINER_ROPE, /**< concatenation of two strings, which is flattened
+                               *   when its characters are accessed first */
+  ECMA_STRING_CONTAINER_EXTERNAL_STRING, /**< actual data is an utf-8 (cesu8) string outside of the heap,
+                                          *   which is owned by the string */
+
+  ECMA_STRING_CONTAINER__MAX = ECMA_STRING_CONTAINER_EXTERNAL_STRING /**< maximum value */
 } ecma_string_container_t;
 
 /**
@@ -1130,6 +1182,33 @@ typedef struct
   lit_utf8_size_t long_utf8_string_length; /**< length of this long utf-8 string in bytes */
 } ecma_long_string_t;
 
+/**
+ * External ECMA string-value descriptor
+ *
+ * The size and the length are stored as in a long string, the characters are
+ * freed by the callback when the string is freed.
+ */
+typedef struct
+{
+  ecma_long_string_t header; /**< long string header */
+  const lit_utf8_byte_t *chars_p; /**< characters of the string */
+  ecma_object_native_free_callback_t free_cb; /**< frees the characters, or NULL */
+} ecma_external_string_t;
+
+/**
+ * Rope ECMA string-value descriptor
+ *
+ * The size of the rope is stored in the long_utf8_string_size field of the header.
+ */
+typedef struct
+{
+  ecma_string_t header; /**< string header */
+  ecma_length_t length; /**< length of the rope in characters */
+  jmem_cpointer_t left_cp; /**< first string, or the flattened string */
+  jmem_cpointer_t right_cp; /**< second string which is never a rope,
+                             *   or JMEM_CP_NULL if the rope is flattened */
+} ecma_rope_string_t;
+
 /**
  * Compiled byte code data.
  */
@@ -1189,6 +1268,24 @@ typedef struct
   jmem_cpointer_t values[ECMA_LIT_STORAGE_VALUE_COUNT]; /**< list of values */
 } ecma_lit_storage_item_t;
 
+/**
+ * Minimum number of entries of a literal storage index
+ */
+#define ECMA_LIT_STORAGE_INDEX_MIN_SIZE 32
+
+/**
+ * Hash index of the literals of a literal storage list
+ *
+ * The index is an open addressed table of the literals, which is twice as
+ * large as the previous one when more than three quarters of it are in use.
+ */
+typedef struct
+{
+  jmem_cpointer_t *table_p; /**< table of the literals, NULL if there is no index */
+  uint32_t mask; /**< number of entries of the table minus one */
+  uint32_t count; /**< number of literals in the list */
+} ecma_lit_storage_index_t;
+
 #ifndef CONFIG_ECMA_LCACHE_DISABLE
 
 /**
@@ -1218,6 +1315,34 @@ typedef struct
 
 #endif /* !CONFIG_ECMA_LCACHE_DISABLE */
 
+#ifdef CONFIG_ECMA_ENUM_CACHE
+
+/**
+ * Object watched by the enumeration cache
+ *
+ * The object is removed when one of its properties is added or deleted,
+ * so the name lists filled with its stamp are not used any more.
+ */
+typedef struct
+{
+  ecma_object_t *object_p; /**< watched object, NULL if the slot is empty */
+  uint32_t stamp; /**< unique number of the watch */
+} ecma_enum_cache_watch_t;
+
+/**
+ * Entry of the enumeration cache
+ */
+typedef struct
+{
+  ecma_object_t *object_p; /**< enumerated object, NULL if the entry is empty */
+  ecma_collection_header_t *names_p; /**< names of the enumerable properties (the strings are referenced) */
+  uint32_t stamps[CONFIG_ECMA_ENUM_CACHE_CHAIN_LENGTH]; /**< watch stamps of the object and its prototypes */
+  uint8_t chain_length; /**< number of the enumerated objects, 1 without the prototype chain */
+  bool is_with_prototype_chain; /**< the names of the prototypes are listed */
+} ecma_enum_cache_entry_t;
+
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
 #ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
 
 /**
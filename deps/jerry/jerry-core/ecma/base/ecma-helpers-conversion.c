@@ -328,6 +328,29 @@
  * @}
  */
 
+#if CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64
+
+/**
+ * Integers up to this value are exactly representable
+ */
+#define ECMA_NUMBER_CONVERSION_MAX_EXACT_INTEGER ((ecma_number_t) (1ull << 53))
+
+/**
+ * Maximum number of digits of the exactly representable integers
+ */
+#define ECMA_NUMBER_CONVERSION_MAX_EXACT_INTEGER_DIGITS 16
+
+/**
+ * Exactly representable powers of ten
+ */
+static const ecma_number_t ecma_number_conversion_powers_of_10[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#endif /* CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64 */
+
 /**
  * ECMA-defined conversion of string to Number.
  *
@@ -621,6 +644,25 @@ ecma_utf8_string_to_number (const lit_utf8_byte_t *str_p, /**< utf-8 string */
   }
 
 #if CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64
+  /* Both the digits and the power of ten are exact, so a single operation rounds correctly. */
+  if (digits < ECMA_NUMBER_MAX_DIGITS
+      && fraction_uint64 <= (uint64_t) ECMA_NUMBER_CONVERSION_MAX_EXACT_INTEGER
+      && e < (int32_t) (sizeof (ecma_number_conversion_powers_of_10) / sizeof (ecma_number_t)))
+  {
+    ecma_number_t num = (ecma_number_t) fraction_uint64;
+
+    if (e_sign)
+    {
+      num /= ecma_number_conversion_powers_of_10[e];
+    }
+    else
+    {
+      num *= ecma_number_conversion_powers_of_10[e];
+    }
+
+    return sign ? -num : num;
+  }
+
   int32_t binary_exponent = 33;
 
   /*
@@ -929,6 +971,16 @@ ecma_number_to_decimal (ecma_number_t num, /**< ecma-number */
   JERRY_ASSERT (!ecma_number_is_infinity (num));
   JERRY_ASSERT (!ecma_number_is_negative (num));
 
+#if CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64
+  /* Grisu3 rejects about half a percent of the numbers, which are converted by the slower errol. */
+  lit_utf8_size_t digit_count = ecma_grisu3_dtoa ((double) num, out_digits_p, out_decimal_exp_p);
+
+  if (likely (digit_count != 0))
+  {
+    return digit_count;
+  }
+#endif /* CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64 */
+
   return ecma_errol0_dtoa ((double) num, out_digits_p, out_decimal_exp_p);
 } /* ecma_number_to_decimal */
 
@@ -1124,6 +1176,33 @@ ecma_number_to_utf8_string (ecma_number_t num, /**< ecma-number */
     return (lit_utf8_size_t) (dst_p - buffer_p);
   }
 
+#if CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64
+  /* Every integer below 2^53 is representable, so all of its digits are needed. */
+  if (num < ECMA_NUMBER_CONVERSION_MAX_EXACT_INTEGER)
+  {
+    uint64_t num_uint64 = (uint64_t) num;
+
+    if (((ecma_number_t) num_uint64) == num)
+    {
+      lit_utf8_byte_t *buf_p = dst_p + ECMA_NUMBER_CONVERSION_MAX_EXACT_INTEGER_DIGITS;
+      JERRY_ASSERT (buf_p <= buffer_p + buffer_size);
+
+      do
+      {
+        *(--buf_p) = (lit_utf8_byte_t) ((num_uint64 % 10) + LIT_CHAR_0);
+        num_uint64 /= 10;
+      }
+      while (num_uint64 != 0);
+
+      lit_utf8_size_t digit_count = (lit_utf8_size_t) (dst_p + ECMA_NUMBER_CONVERSION_MAX_EXACT_INTEGER_DIGITS - buf_p);
+      memmove (dst_p, buf_p, digit_count);
+      dst_p += digit_count;
+
+      return (lit_utf8_size_t) (dst_p - buffer_p);
+    }
+  }
+#endif /* CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64 */
+
   /* decimal exponent */
   int32_t n;
   /* number of digits in mantissa */
@@ -0,0 +1,478 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+
+#include "ecma-helpers.h"
+#include "lit-char-helpers.h"
+
+/** \addtogroup ecma ECMA
+ * @{
+ *
+ * \addtogroup ecmahelpers Helpers for operations with ECMA data types
+ * @{
+ */
+
+#if CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64
+
+/**
+ * Printing Floating-Point Numbers Quickly and Accurately with Integers
+ *
+ * available at http://florian.loitsch.com/publications/dtoa-pldi2010.pdf
+ *
+ * The Grisu3 algorithm generates the shortest digits of most numbers using 64-bit
+ * integer arithmetic only, and reports the rare numbers, where it cannot decide
+ * whether the digits are the shortest ones.
+ */
+
+/**
+ * Floating-point number with a 64-bit significand and a binary exponent
+ */
+typedef struct
+{
+  uint64_t f; /**< significand */
+  int32_t e; /**< binary exponent */
+} ecma_diy_fp_t;
+
+/**
+ * Significand size of ecma_diy_fp_t
+ */
+#define ECMA_GRISU_SIGNIFICAND_SIZE 64
+
+/**
+ * Minimal binary exponent of the scaled numbers
+ */
+#define ECMA_GRISU_MIN_TARGET_EXPONENT (-60)
+
+/**
+ * Maximal binary exponent of the scaled numbers
+ */
+#define ECMA_GRISU_MAX_TARGET_EXPONENT (-32)
+
+/**
+ * Cached power of ten
+ */
+typedef struct
+{
+  uint64_t significand; /**< normalized, rounded significand */
+  int16_t binary_exponent; /**< binary exponent */
+  int16_t decimal_exponent; /**< decimal exponent */
+} ecma_grisu_cached_power_t;
+
+/**
+ * Decimal exponent of the first cached power of ten
+ */
+#define ECMA_GRISU_CACHED_POWERS_MIN_DECIMAL_EXPONENT (-348)
+
+/**
+ * Distance of the decimal exponents of the cached powers of ten
+ */
+#define ECMA_GRISU_CACHED_POWERS_DECIMAL_EXPONENT_DISTANCE 8
+
+/**
+ * Powers of ten from 10^-348 to 10^340
+ */
+static const ecma_grisu_cached_power_t ecma_grisu_cached_powers[] =
+{
+  { 0xfa8fd5a0081c0288ull, -1220, -348 },
+  { 0xbaaee17fa23ebf76ull, -1193, -340 },
+  { 0x8b16fb203055ac76ull, -1166, -332 },
+  { 0xcf42894a5dce35eaull, -1140, -324 },
+  { 0x9a6bb0aa55653b2dull, -1113, -316 },
+  { 0xe61acf033d1a45dfull, -1087, -308 },
+  { 0xab70fe17c79ac6caull, -1060, -300 },
+  { 0xff77b1fcbebcdc4full, -1034, -292 },
+  { 0xbe5691ef416bd60cull, -1007, -284 },
+  { 0x8dd01fad907ffc3cull, -980, -276 },
+  { 0xd3515c2831559a83ull, -954, -268 },
+  { 0x9d71ac8fada6c9b5ull, -927, -260 },
+  { 0xea9c227723ee8bcbull, -901, -252 },
+  { 0xaecc49914078536dull, -874, -244 },
+  { 0x823c12795db6ce57ull, -847, -236 },
+  { 0xc21094364dfb5637ull, -821, -228 },
+  { 0x9096ea6f3848984full, -794, -220 },
+  { 0xd77485cb25823ac7ull, -768, -212 },
+  { 0xa086cfcd97bf97f4ull, -741, -204 },
+  { 0xef340a98172aace5ull, -715, -196 },
+  { 0xb23867fb2a35b28eull, -688, -188 },
+  { 0x84c8d4dfd2c63f3bull, -661, -180 },
+  { 0xc5dd44271ad3cdbaull, -635, -172 },
+  { 0x936b9fcebb25c996ull, -608, -164 },
+  { 0xdbac6c247d62a584ull, -582, -156 },
+  { 0xa3ab66580d5fdaf6ull, -555, -148 },
+  { 0xf3e2f893dec3f126ull, -529, -140 },
+  { 0xb5b5ada8aaff80b8ull, -502, -132 },
+  { 0x87625f056c7c4a8bull, -475, -124 },
+  { 0xc9bcff6034c13053ull, -449, -116 },
+  { 0x964e858c91ba2655ull, -422, -108 },
+  { 0xdff9772470297ebdull, -396, -100 },
+  { 0xa6dfbd9fb8e5b88full, -369, -92 },
+  { 0xf8a95fcf88747d94ull, -343, -84 },
+  { 0xb94470938fa89bcfull, -316, -76 },
+  { 0x8a08f0f8bf0f156bull, -289, -68 },
+  { 0xcdb02555653131b6ull, -263, -60 },
+  { 0x993fe2c6d07b7facull, -236, -52 },
+  { 0xe45c10c42a2b3b06ull, -210, -44 },
+  { 0xaa242499697392d3ull, -183, -36 },
+  { 0xfd87b5f28300ca0eull, -157, -28 },
+  { 0xbce5086492111aebull, -130, -20 },
+  { 0x8cbccc096f5088ccull, -103, -12 },
+  { 0xd1b71758e219652cull, -77, -4 },
+  { 0x9c40000000000000ull, -50, 4 },
+  { 0xe8d4a51000000000ull, -24, 12 },
+  { 0xad78ebc5ac620000ull, 3, 20 },
+  { 0x813f3978f8940984ull, 30, 28 },
+  { 0xc097ce7bc90715b3ull, 56, 36 },
+  { 0x8f7e32ce7bea5c70ull, 83, 44 },
+  { 0xd5d238a4abe98068ull, 109, 52 },
+  { 0x9f4f2726179a2245ull, 136, 60 },
+  { 0xed63a231d4c4fb27ull, 162, 68 },
+  { 0xb0de65388cc8ada8ull, 189, 76 },
+  { 0x83c7088e1aab65dbull, 216, 84 },
+  { 0xc45d1df942711d9aull, 242, 92 },
+  { 0x924d692ca61be758ull, 269, 100 },
+  { 0xda01ee641a708deaull, 295, 108 },
+  { 0xa26da3999aef774aull, 322, 116 },
+  { 0xf209787bb47d6b85ull, 348, 124 },
+  { 0xb454e4a179dd1877ull, 375, 132 },
+  { 0x865b86925b9bc5c2ull, 402, 140 },
+  { 0xc83553c5c8965d3dull, 428, 148 },
+  { 0x952ab45cfa97a0b3ull, 455, 156 },
+  { 0xde469fbd99a05fe3ull, 481, 164 },
+  { 0xa59bc234db398c25ull, 508, 172 },
+  { 0xf6c69a72a3989f5cull, 534, 180 },
+  { 0xb7dcbf5354e9beceull, 561, 188 },
+  { 0x88fcf317f22241e2ull, 588, 196 },
+  { 0xcc20ce9bd35c78a5ull, 614, 204 },
+  { 0x98165af37b2153dfull, 641, 212 },
+  { 0xe2a0b5dc971f303aull, 667, 220 },
+  { 0xa8d9d1535ce3b396ull, 694, 228 },
+  { 0xfb9b7cd9a4a7443cull, 720, 236 },
+  { 0xbb764c4ca7a44410ull, 747, 244 },
+  { 0x8bab8eefb6409c1aull, 774, 252 },
+  { 0xd01fef10a657842cull, 800, 260 },
+  { 0x9b10a4e5e9913129ull, 827, 268 },
+  { 0xe7109bfba19c0c9dull, 853, 276 },
+  { 0xac2820d9623bf429ull, 880, 284 },
+  { 0x80444b5e7aa7cf85ull, 907, 292 },
+  { 0xbf21e44003acdd2dull, 933, 300 },
+  { 0x8e679c2f5e44ff8full, 960, 308 },
+  { 0xd433179d9c8cb841ull, 986, 316 },
+  { 0x9e19db92b4e31ba9ull, 1013, 324 },
+  { 0xeb96bf6ebadf77d9ull, 1039, 332 },
+  { 0xaf87023b9bf0ee6bull, 1066, 340 }
+};
+
+/**
+ * Multiply two numbers and round the result to 64 bits
+ *
+ * @return product
+ */
+static ecma_diy_fp_t
+ecma_diy_fp_multiply (ecma_diy_fp_t x, /**< first operand */
+                      ecma_diy_fp_t y) /**< second operand */
+{
+  uint64_t a = x.f >> 32;
+  uint64_t b = x.f & UINT32_MAX;
+  uint64_t c = y.f >> 32;
+  uint64_t d = y.f & UINT32_MAX;
+
+  uint64_t ac = a * c;
+  uint64_t bc = b * c;
+  uint64_t ad = a * d;
+  uint64_t bd = b * d;
+
+  /* Round the lower 64 bits of the product. */
+  uint64_t tmp = (bd >> 32) + (ad & UINT32_MAX) + (bc & UINT32_MAX) + (1ull << 31);
+
+  ecma_diy_fp_t result;
+  result.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+  result.e = x.e + y.e + ECMA_GRISU_SIGNIFICAND_SIZE;
+  return result;
+} /* ecma_diy_fp_multiply */
+
+/**
+ * Shift the significand left until its highest bit is set
+ *
+ * @return normalized number
+ */
+static ecma_diy_fp_t
+ecma_diy_fp_normalize (ecma_diy_fp_t x) /**< non-zero number */
+{
+  JERRY_ASSERT (x.f != 0);
+
+  while ((x.f & (1ull << (ECMA_GRISU_SIGNIFICAND_SIZE - 1))) == 0)
+  {
+    x.f <<= 1;
+    x.e--;
+  }
+
+  return x;
+} /* ecma_diy_fp_normalize */
+
+/**
+ * Get the cached power of ten, which scales numbers with the given binary
+ * exponent into the [ECMA_GRISU_MIN_TARGET_EXPONENT, ECMA_GRISU_MAX_TARGET_EXPONENT] range
+ *
+ * @return the cached power of ten
+ */
+static const ecma_grisu_cached_power_t *
+ecma_grisu_get_cached_power (int32_t binary_exponent) /**< binary exponent of the scaled number */
+{
+  int32_t min_exponent = ECMA_GRISU_MIN_TARGET_EXPONENT - (binary_exponent + ECMA_GRISU_SIGNIFICAND_SIZE);
+
+  /* 0.30102999566398114 is the decimal logarithm of 2. */
+  int32_t k = (int32_t) ceil ((min_exponent + ECMA_GRISU_SIGNIFICAND_SIZE - 1) * 0.30102999566398114);
+  int32_t index = ((-ECMA_GRISU_CACHED_POWERS_MIN_DECIMAL_EXPONENT + k - 1)
+                   / ECMA_GRISU_CACHED_POWERS_DECIMAL_EXPONENT_DISTANCE) + 1;
+
+  JERRY_ASSERT (index >= 0
+                && (size_t) index < sizeof (ecma_grisu_cached_powers) / sizeof (ecma_grisu_cached_power_t));
+
+  const ecma_grisu_cached_power_t *power_p = ecma_grisu_cached_powers + index;
+
+  JERRY_ASSERT (binary_exponent + power_p->binary_exponent + ECMA_GRISU_SIGNIFICAND_SIZE
+                >= ECMA_GRISU_MIN_TARGET_EXPONENT);
+  JERRY_ASSERT (binary_exponent + power_p->binary_exponent + ECMA_GRISU_SIGNIFICAND_SIZE
+                <= ECMA_GRISU_MAX_TARGET_EXPONENT);
+
+  return power_p;
+} /* ecma_grisu_get_cached_power */
+
+/**
+ * Move the last generated digit closer to the scaled number, and check whether
+ * the digits are guaranteed to be the shortest, correctly rounded representation
+ *
+ * @return true - if the digits are correct,
+ *         false - otherwise
+ */
+static bool
+ecma_grisu_round_weed (lit_utf8_byte_t *buffer_p, /**< generated digits */
+                       lit_utf8_size_t length, /**< number of generated digits */
+                       uint64_t distance_too_high_w, /**< distance of the upper bound and the number */
+                       uint64_t unsafe_interval, /**< size of the unsafe interval */
+                       uint64_t rest, /**< distance of the upper bound and the digits */
+                       uint64_t ten_kappa, /**< weight of the last digit */
+                       uint64_t unit) /**< maximal error of the computations */
+{
+  uint64_t small_distance = distance_too_high_w - unit;
+  uint64_t big_distance = distance_too_high_w + unit;
+
+  while (rest < small_distance
+         && unsafe_interval - rest >= ten_kappa
+         && (rest + ten_kappa < small_distance
+             || small_distance - rest >= rest + ten_kappa - small_distance))
+  {
+    buffer_p[length - 1]--;
+    rest += ten_kappa;
+  }
+
+  if (rest < big_distance
+      && unsafe_interval - rest >= ten_kappa
+      && (rest + ten_kappa < big_distance
+          || big_distance - rest > rest + ten_kappa - big_distance))
+  {
+    return false;
+  }
+
+  return (2 * unit <= rest) && (rest <= unsafe_interval - 4 * unit);
+} /* ecma_grisu_round_weed */
+
+/**
+ * Generate the shortest digits between the scaled boundaries of a number
+ *
+ * @return true - if the digits are correct,
+ *         false - otherwise
+ */
+static bool
+ecma_grisu_digit_gen (ecma_diy_fp_t low, /**< scaled lower boundary */
+                      ecma_diy_fp_t w, /**< scaled number */
+                      ecma_diy_fp_t high, /**< scaled upper boundary */
+                      lit_utf8_byte_t *buffer_p, /**< [out] buffer for the digits */
+                      lit_utf8_size_t *length_p, /**< [out] number of digits */
+                      int32_t *kappa_p) /**< [out] decimal exponent of the last digit */
+{
+  JERRY_ASSERT (low.e == w.e && w.e == high.e);
+  JERRY_ASSERT (w.e >= ECMA_GRISU_MIN_TARGET_EXPONENT && w.e <= ECMA_GRISU_MAX_TARGET_EXPONENT);
+
+  uint64_t unit = 1;
+  uint64_t too_low = low.f - unit;
+  uint64_t too_high = high.f + unit;
+  uint64_t unsafe_interval = too_high - too_low;
+
+  uint32_t one_shift = (uint32_t) -w.e;
+  uint64_t one = 1ull << one_shift;
+
+  uint32_t integrals = (uint32_t) (too_high >> one_shift);
+  uint64_t fractionals = too_high & (one - 1);
+
+  uint32_t divisor = 1;
+  int32_t kappa = 0;
+
+  if (integrals != 0)
+  {
+    kappa = 1;
+
+    while (integrals / divisor >= 10)
+    {
+      divisor *= 10;
+      kappa++;
+    }
+  }
+
+  lit_utf8_size_t length = 0;
+
+  while (kappa > 0)
+  {
+    buffer_p[length++] = (lit_utf8_byte_t) (LIT_CHAR_0 + integrals / divisor);
+    integrals %= divisor;
+    kappa--;
+
+    uint64_t rest = (((uint64_t) integrals) << one_shift) + fractionals;
+
+    if (rest < unsafe_interval)
+    {
+      *length_p = length;
+      *kappa_p = kappa;
+      return ecma_grisu_round_weed (buffer_p,
+                                    length,
+                                    too_high - w.f,
+                                    unsafe_interval,
+                                    rest,
+                                    ((uint64_t) divisor) << one_shift,
+                                    unit);
+    }
+
+    divisor /= 10;
+  }
+
+  while (true)
+  {
+    fractionals *= 10;
+    unit *= 10;
+    unsafe_interval *= 10;
+
+    buffer_p[length++] = (lit_utf8_byte_t) (LIT_CHAR_0 + (fractionals >> one_shift));
+    fractionals &= one - 1;
+    kappa--;
+
+    if (fractionals < unsafe_interval)
+    {
+      *length_p = length;
+      *kappa_p = kappa;
+      return ecma_grisu_round_weed (buffer_p,
+                                    length,
+                                    (too_high - w.f) * unit,
+                                    unsafe_interval,
+                                    fractionals,
+                                    one,
+                                    unit);
+    }
+  }
+} /* ecma_grisu_digit_gen */
+
+/**
+ * Generate the shortest digits of a positive, finite number, which are read back as the same number
+ *
+ * @return number of generated digits - if the digits are guaranteed to be the shortest ones,
+ *         0 - otherwise (the caller should use a slower algorithm)
+ */
+lit_utf8_size_t
+ecma_grisu3_dtoa (double val, /**< positive, finite number */
+                  lit_utf8_byte_t *buffer_p, /**< [out] buffer for the digits */
+                  int32_t *exp_p) /**< [out] decimal exponent */
+{
+  JERRY_ASSERT (val > 0 && !isinf (val));
+
+  union
+  {
+    uint64_t u64_value;
+    double float_value;
+  } u;
+
+  u.float_value = val;
+
+  uint64_t fraction = u.u64_value & ((1ull << 52) - 1);
+  int32_t biased_exp = (int32_t) ((u.u64_value >> 52) & 0x7ff);
+
+  ecma_diy_fp_t v;
+
+  if (biased_exp != 0)
+  {
+    v.f = fraction | (1ull << 52);
+    v.e = biased_exp - 1075;
+  }
+  else
+  {
+    v.f = fraction;
+    v.e = -1074;
+  }
+
+  /* The boundaries are halfway between the number and its neighbours. */
+  ecma_diy_fp_t plus;
+  plus.f = (v.f << 1) + 1;
+  plus.e = v.e - 1;
+  plus = ecma_diy_fp_normalize (plus);
+
+  ecma_diy_fp_t minus;
+
+  if (fraction == 0 && biased_exp > 1)
+  {
+    /* The lower neighbour is closer for powers of two. */
+    minus.f = (v.f << 2) - 1;
+    minus.e = v.e - 2;
+  }
+  else
+  {
+    minus.f = (v.f << 1) - 1;
+    minus.e = v.e - 1;
+  }
+
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+
+  ecma_diy_fp_t w = ecma_diy_fp_normalize (v);
+  JERRY_ASSERT (w.e == plus.e);
+
+  const ecma_grisu_cached_power_t *power_p = ecma_grisu_get_cached_power (w.e);
+
+  ecma_diy_fp_t ten_mk;
+  ten_mk.f = power_p->significand;
+  ten_mk.e = power_p->binary_exponent;
+
+  lit_utf8_size_t length;
+  int32_t kappa;
+
+  if (!ecma_grisu_digit_gen (ecma_diy_fp_multiply (minus, ten_mk),
+                             ecma_diy_fp_multiply (w, ten_mk),
+                             ecma_diy_fp_multiply (plus, ten_mk),
+                             buffer_p,
+                             &length,
+                             &kappa))
+  {
+    return 0;
+  }
+
+  /* The number is 0.d1d2...dk * 10^exp. */
+  *exp_p = (int32_t) length + kappa - power_p->decimal_exponent;
+  return length;
+} /* ecma_grisu3_dtoa */
+
+#endif /* CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64 */
+
+/**
+ * @}
+ * @}
+ */
@@ -18,6 +18,7 @@
 #include "ecma-globals.h"
 #include "ecma-helpers.h"
 #include "ecma-lcache.h"
+#include "ecma-literal-storage.h"
 #include "jrt.h"
 #include "jrt-libc-includes.h"
 #include "lit-char-helpers.h"
@@ -42,6 +43,56 @@ JERRY_STATIC_ASSERT ((ECMA_STRING_MAX_REF | ECMA_STRING_CONTAINER_MASK) == UINT1
 JERRY_STATIC_ASSERT (ECMA_STRING_NOT_ARRAY_INDEX == UINT32_MAX,
                      ecma_string_not_array_index_must_be_equal_to_uint32_max);
 
+/* External strings are never equal to magic strings or array indices, so they need not be normalized. */
+JERRY_STATIC_ASSERT (CONFIG_ECMA_EXTERNAL_STRING_MIN_SIZE > LIT_MAGIC_STRING_LENGTH_LIMIT
+                     && CONFIG_ECMA_EXTERNAL_STRING_MIN_SIZE > ECMA_MAX_CHARS_IN_STRINGIFIED_UINT32,
+                     ecma_external_strings_must_be_longer_than_magic_strings_and_array_indices);
+
+#ifdef CONFIG_ECMA_ROPE_STRING
+
+/* Ropes are never equal to magic strings or array indices, so they need not be normalized. */
+JERRY_STATIC_ASSERT (CONFIG_ECMA_ROPE_STRING_MIN_SIZE > LIT_MAGIC_STRING_LENGTH_LIMIT
+                     && CONFIG_ECMA_ROPE_STRING_MIN_SIZE > ECMA_MAX_CHARS_IN_STRINGIFIED_UINT32,
+                     ecma_rope_strings_must_be_longer_than_magic_strings_and_array_indices);
+
+/**
+ * Replace a rope by its flattened string
+ */
+#define ECMA_STRING_FLATTEN_ROPE(string_p) \
+  do \
+  { \
+    if (ECMA_STRING_GET_CONTAINER (string_p) == ECMA_STRING_CONTAINER_ROPE) \
+    { \
+      string_p = (ecma_string_t *) ecma_rope_string_flatten (string_p); \
+    } \
+  } while (0)
+
+#else /* !CONFIG_ECMA_ROPE_STRING */
+
+/**
+ * Replace a rope by its flattened string
+ */
+#define ECMA_STRING_FLATTEN_ROPE(string_p)
+
+#endif /* CONFIG_ECMA_ROPE_STRING */
+
+/**
+ * Get the characters of a long or an external string
+ *
+ * @return pointer to the characters
+ */
+static inline const lit_utf8_byte_t * __attr_always_inline___
+ecma_long_string_chars (const ecma_string_t *string_p) /**< long or external string */
+{
+  if (ECMA_STRING_GET_CONTAINER (string_p) == ECMA_STRING_CONTAINER_EXTERNAL_STRING)
+  {
+    return ((const ecma_external_string_t *) string_p)->chars_p;
+  }
+
+  JERRY_ASSERT (ECMA_STRING_GET_CONTAINER (string_p) == ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING);
+  return (const lit_utf8_byte_t *) (((const ecma_long_string_t *) string_p) + 1);
+} /* ecma_long_string_chars */
+
 static void
 ecma_init_ecma_string_from_magic_string_id (ecma_string_t *string_p,
                                             lit_magic_string_id_t magic_string_id);
@@ -238,7 +289,10 @@ ecma_new_ecma_string_from_utf8_converted_to_cesu8 (const lit_utf8_byte_t *string
   {
     if ((string_p[pos] & LIT_UTF8_1_BYTE_MASK) == LIT_UTF8_1_BYTE_MARKER)
     {
-      pos++;
+      lit_utf8_size_t ascii_size = lit_utf8_ascii_prefix_size (string_p + pos, string_size - pos);
+      pos += ascii_size;
+      converted_string_length += ascii_size;
+      continue;
     }
     else if ((string_p[pos] & LIT_UTF8_2_BYTE_MASK) == LIT_UTF8_2_BYTE_MARKER)
     {
@@ -331,6 +385,60 @@ ecma_new_ecma_string_from_utf8_converted_to_cesu8 (const lit_utf8_byte_t *string
   return string_desc_p;
 } /* ecma_new_ecma_string_from_utf8_converted_to_cesu8 */
 
+/**
+ * Allocate new ecma-string which refers to a cesu-8 string outside of the heap
+ *
+ * Note:
+ *      the string owns the characters, and frees them by the free callback when
+ *      it is freed. Short strings are copied onto the heap instead, and the
+ *      characters are freed before returning.
+ *
+ * @return pointer to ecma-string descriptor
+ */
+ecma_string_t *
+ecma_new_ecma_external_string (const lit_utf8_byte_t *string_p, /**< cesu-8 string */
+                               lit_utf8_size_t string_size, /**< string size */
+                               ecma_object_native_free_callback_t free_cb) /**< frees the characters,
+                                                                            *   or NULL */
+{
+  JERRY_ASSERT (string_p != NULL || string_size == 0);
+  JERRY_ASSERT (lit_is_valid_cesu8_string (string_p, string_size));
+
+  bool copy = (string_size < CONFIG_ECMA_EXTERNAL_STRING_MIN_SIZE);
+
+  if (!copy && lit_get_magic_string_ex_count () > 0)
+  {
+    copy = (lit_is_ex_utf8_string_magic (string_p, string_size) < lit_get_magic_string_ex_count ());
+  }
+
+  if (copy)
+  {
+    ecma_string_t *string_desc_p = ecma_new_ecma_string_from_utf8 (string_p, string_size);
+
+    if (free_cb != NULL)
+    {
+      free_cb ((void *) string_p);
+    }
+
+    return string_desc_p;
+  }
+
+  ecma_external_string_t *external_string_p;
+  external_string_p = (ecma_external_string_t *) ecma_alloc_string_buffer (sizeof (ecma_external_string_t));
+
+  ecma_string_t *string_desc_p = &external_string_p->header.header;
+
+  string_desc_p->refs_and_container = ECMA_STRING_CONTAINER_EXTERNAL_STRING | ECMA_STRING_REF_ONE;
+  string_desc_p->hash = lit_utf8_string_calc_hash (string_p, string_size);
+  string_desc_p->u.long_utf8_string_size = string_size;
+
+  external_string_p->header.long_utf8_string_length = lit_utf8_string_length (string_p, string_size);
+  external_string_p->chars_p = string_p;
+  external_string_p->free_cb = free_cb;
+
+  return string_desc_p;
+} /* ecma_new_ecma_external_string */
+
 /**
  * Allocate new ecma-string and fill it with cesu-8 character which represents specified code unit
  *
@@ -488,6 +596,211 @@ ecma_new_ecma_length_string (void)
   return string_desc_p;
 } /* ecma_new_ecma_length_string */
 
+#ifdef CONFIG_ECMA_ROPE_STRING
+
+/**
+ * Concatenate ecma-strings into a rope
+ *
+ * @return rope string
+ */
+static ecma_string_t *
+ecma_concat_ecma_strings_to_rope (ecma_string_t *string1_p, /**< first ecma-string */
+                                  ecma_string_t *string2_p, /**< second ecma-string */
+                                  lit_utf8_size_t new_size) /**< size of the concatenation */
+{
+  /* Ropes are extended on the left, so the second string is kept flat. */
+  if (ECMA_STRING_GET_CONTAINER (string2_p) == ECMA_STRING_CONTAINER_ROPE)
+  {
+    string2_p = (ecma_string_t *) ecma_rope_string_flatten (string2_p);
+  }
+
+  ecma_string_t *left_p = string1_p;
+  ecma_string_t *right_p = string2_p;
+  lit_string_hash_t hash_start = string1_p->hash;
+
+  /* Small second strings are appended to the last chunk of the rope, not to create a rope per append. */
+  if (ECMA_STRING_GET_CONTAINER (string1_p) == ECMA_STRING_CONTAINER_ROPE
+      && ((ecma_rope_string_t *) string1_p)->right_cp != JMEM_CP_NULL)
+  {
+    ecma_rope_string_t *rope1_p = (ecma_rope_string_t *) string1_p;
+    ecma_string_t *chunk_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, rope1_p->right_cp);
+
+    if (ecma_string_get_size (chunk_p) + ecma_string_get_size (string2_p) < CONFIG_ECMA_ROPE_STRING_MIN_SIZE)
+    {
+      left_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, rope1_p->left_cp);
+      right_p = ecma_concat_ecma_strings (chunk_p, string2_p);
+    }
+  }
+
+  switch (ECMA_STRING_GET_CONTAINER (string1_p))
+  {
+    case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
+    case ECMA_STRING_CONTAINER_MAGIC_STRING:
+    case ECMA_STRING_CONTAINER_MAGIC_STRING_EX:
+    {
+      ECMA_STRING_TO_UTF8_STRING (string1_p, utf8_string1_p, utf8_string1_size);
+      hash_start = lit_utf8_string_calc_hash (utf8_string1_p, utf8_string1_size);
+      ECMA_FINALIZE_UTF8_STRING (utf8_string1_p, utf8_string1_size);
+      break;
+    }
+    default:
+    {
+      break;
+    }
+  }
+
+  ecma_rope_string_t *rope_p = (ecma_rope_string_t *) ecma_alloc_string_buffer (sizeof (ecma_rope_string_t));
+  ecma_string_t *string_desc_p = &rope_p->header;
+
+  string_desc_p->refs_and_container = ECMA_STRING_CONTAINER_ROPE | ECMA_STRING_REF_ONE;
+  string_desc_p->u.long_utf8_string_size = new_size;
+
+  ECMA_STRING_TO_UTF8_STRING (string2_p, utf8_string2_p, utf8_string2_size);
+  string_desc_p->hash = lit_utf8_string_hash_combine (hash_start, utf8_string2_p, utf8_string2_size);
+  ECMA_FINALIZE_UTF8_STRING (utf8_string2_p, utf8_string2_size);
+
+  rope_p->length = ecma_string_get_length (string1_p) + ecma_string_get_length (string2_p);
+
+  ecma_ref_ecma_string (left_p);
+
+  if (right_p == string2_p)
+  {
+    ecma_ref_ecma_string (right_p);
+  }
+
+  ECMA_SET_NON_NULL_POINTER (rope_p->left_cp, left_p);
+  ECMA_SET_NON_NULL_POINTER (rope_p->right_cp, right_p);
+
+  return string_desc_p;
+} /* ecma_concat_ecma_strings_to_rope */
+
+/**
+ * Flatten a rope into a single string, if it is not flattened yet
+ *
+ * Note:
+ *      the rope keeps a reference to the flattened string
+ *
+ * @return flattened string
+ */
+const ecma_string_t *
+ecma_rope_string_flatten (const ecma_string_t *string_p) /**< rope string */
+{
+  JERRY_ASSERT (ECMA_STRING_GET_CONTAINER (string_p) == ECMA_STRING_CONTAINER_ROPE);
+
+  ecma_rope_string_t *rope_p = (ecma_rope_string_t *) string_p;
+
+  if (rope_p->right_cp == JMEM_CP_NULL)
+  {
+    return ECMA_GET_NON_NULL_POINTER (ecma_string_t, rope_p->left_cp);
+  }
+
+  const lit_utf8_size_t size = string_p->u.long_utf8_string_size;
+  ecma_string_t *flat_string_p;
+  lit_utf8_byte_t *data_p;
+
+  if (likely (size <= UINT16_MAX))
+  {
+    flat_string_p = ecma_alloc_string_buffer (sizeof (ecma_string_t) + size);
+
+    flat_string_p->refs_and_container = ECMA_STRING_CONTAINER_HEAP_UTF8_STRING | ECMA_STRING_REF_ONE;
+    flat_string_p->u.common_uint32_field = 0;
+    flat_string_p->u.utf8_string.size = (uint16_t) size;
+    flat_string_p->u.utf8_string.length = (uint16_t) rope_p->length;
+
+    data_p = (lit_utf8_byte_t *) (flat_string_p + 1);
+  }
+  else
+  {
+    flat_string_p = ecma_alloc_string_buffer (sizeof (ecma_long_string_t) + size);
+
+    flat_string_p->refs_and_container = ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING | ECMA_STRING_REF_ONE;
+    flat_string_p->u.common_uint32_field = 0;
+    flat_string_p->u.long_utf8_string_size = size;
+
+    ecma_long_string_t *long_string_desc_p = (ecma_long_string_t *) flat_string_p;
+    long_string_desc_p->long_utf8_string_length = rope_p->length;
+
+    data_p = (lit_utf8_byte_t *) (long_string_desc_p + 1);
+  }
+
+  flat_string_p->hash = string_p->hash;
+
+  /* The second strings are flat, so the rope is walked from its end without recursion. */
+  const ecma_string_t *node_p = string_p;
+  lit_utf8_size_t end = size;
+
+  while (ECMA_STRING_GET_CONTAINER (node_p) == ECMA_STRING_CONTAINER_ROPE)
+  {
+    const ecma_rope_string_t *node_rope_p = (const ecma_rope_string_t *) node_p;
+
+    if (node_rope_p->right_cp == JMEM_CP_NULL)
+    {
+      node_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, node_rope_p->left_cp);
+      break;
+    }
+
+    const ecma_string_t *right_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, node_rope_p->right_cp);
+    lit_utf8_size_t right_size = ecma_string_get_size (right_p);
+
+    JERRY_ASSERT (right_size <= end);
+    end -= right_size;
+    ecma_string_to_utf8_bytes (right_p, data_p + end, right_size);
+
+    node_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, node_rope_p->left_cp);
+  }
+
+  ecma_string_to_utf8_bytes (node_p, data_p, end);
+
+  ecma_deref_ecma_string (ECMA_GET_NON_NULL_POINTER (ecma_string_t, rope_p->left_cp));
+  ecma_deref_ecma_string (ECMA_GET_NON_NULL_POINTER (ecma_string_t, rope_p->right_cp));
+
+  ECMA_SET_NON_NULL_POINTER (rope_p->left_cp, flat_string_p);
+  rope_p->right_cp = JMEM_CP_NULL;
+
+  return flat_string_p;
+} /* ecma_rope_string_flatten */
+
+/**
+ * Deallocate a rope and the ropes it refers to which are not referenced anymore
+ */
+static void
+ecma_dealloc_rope_string (ecma_string_t *string_p) /**< rope string */
+{
+  /* Ropes usually grow on the left, so the chain is freed without recursion. */
+  while (true)
+  {
+    JERRY_ASSERT (ECMA_STRING_GET_CONTAINER (string_p) == ECMA_STRING_CONTAINER_ROPE);
+    JERRY_ASSERT (string_p->refs_and_container < ECMA_STRING_REF_ONE);
+
+    ecma_rope_string_t *rope_p = (ecma_rope_string_t *) string_p;
+    ecma_string_t *left_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, rope_p->left_cp);
+
+    if (rope_p->right_cp != JMEM_CP_NULL)
+    {
+      ecma_deref_ecma_string (ECMA_GET_NON_NULL_POINTER (ecma_string_t, rope_p->right_cp));
+    }
+
+    ecma_dealloc_string_buffer (string_p, sizeof (ecma_rope_string_t));
+
+    if (ECMA_STRING_GET_CONTAINER (left_p) != ECMA_STRING_CONTAINER_ROPE)
+    {
+      ecma_deref_ecma_string (left_p);
+      return;
+    }
+
+    left_p->refs_and_container = (uint16_t) (left_p->refs_and_container - ECMA_STRING_REF_ONE);
+
+    if (left_p->refs_and_container >= ECMA_STRING_REF_ONE)
+    {
+      return;
+    }
+
+    string_p = left_p;
+  }
+} /* ecma_dealloc_rope_string */
+
+#endif /* CONFIG_ECMA_ROPE_STRING */
+
 /**
  * Concatenate ecma-strings
  *
@@ -511,6 +824,21 @@ ecma_concat_ecma_strings (ecma_string_t *string1_p, /**< first ecma-string */
     return string1_p;
   }
 
+#ifdef CONFIG_ECMA_ROPE_STRING
+  lit_utf8_size_t rope_size = ecma_string_get_size (string1_p) + ecma_string_get_size (string2_p);
+
+  /* It is impossible to allocate this large string. */
+  if (rope_size < ecma_string_get_size (string1_p))
+  {
+    jerry_fatal (ERR_OUT_OF_MEMORY);
+  }
+
+  if (rope_size >= CONFIG_ECMA_ROPE_STRING_MIN_SIZE)
+  {
+    return ecma_concat_ecma_strings_to_rope (string1_p, string2_p, rope_size);
+  }
+#endif /* CONFIG_ECMA_ROPE_STRING */
+
   const lit_utf8_byte_t *utf8_string1_p, *utf8_string2_p;
   lit_utf8_size_t utf8_string1_size, utf8_string2_size;
   lit_utf8_size_t utf8_string1_length, utf8_string2_length;
@@ -531,10 +859,11 @@ ecma_concat_ecma_strings (ecma_string_t *string1_p, /**< first ecma-string */
       break;
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
       ecma_long_string_t *long_string_desc_p = (ecma_long_string_t *) string1_p;
 
-      utf8_string1_p = (lit_utf8_byte_t *) (long_string_desc_p + 1);
+      utf8_string1_p = ecma_long_string_chars (string1_p);
       utf8_string1_size = string1_p->u.long_utf8_string_size;
       utf8_string1_length = long_string_desc_p->long_utf8_string_length;
       break;
@@ -580,10 +909,11 @@ ecma_concat_ecma_strings (ecma_string_t *string1_p, /**< first ecma-string */
       break;
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
       ecma_long_string_t *long_string_desc_p = (ecma_long_string_t *) string2_p;
 
-      utf8_string2_p = (lit_utf8_byte_t *) (long_string_desc_p + 1);
+      utf8_string2_p = ecma_long_string_chars (string2_p);
       utf8_string2_size = string2_p->u.long_utf8_string_size;
       utf8_string2_length = long_string_desc_p->long_utf8_string_length;
       break;
@@ -774,6 +1104,18 @@ ecma_deref_ecma_string (ecma_string_t *string_p) /**< ecma-string */
       ecma_dealloc_string_buffer (string_p, string_p->u.long_utf8_string_size + sizeof (ecma_long_string_t));
       return;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      ecma_external_string_t *external_string_p = (ecma_external_string_t *) string_p;
+
+      if (external_string_p->free_cb != NULL)
+      {
+        external_string_p->free_cb ((void *) external_string_p->chars_p);
+      }
+
+      ecma_dealloc_string_buffer (string_p, sizeof (ecma_external_string_t));
+      return;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     case ECMA_STRING_CONTAINER_MAGIC_STRING:
     case ECMA_STRING_CONTAINER_MAGIC_STRING_EX:
@@ -786,6 +1128,13 @@ ecma_deref_ecma_string (ecma_string_t *string_p) /**< ecma-string */
       ecma_fast_free_value (string_p->u.lit_number);
       break;
     }
+#ifdef CONFIG_ECMA_ROPE_STRING
+    case ECMA_STRING_CONTAINER_ROPE:
+    {
+      ecma_dealloc_rope_string (string_p);
+      return;
+    }
+#endif /* CONFIG_ECMA_ROPE_STRING */
     default:
     {
       JERRY_UNREACHABLE ();
@@ -813,8 +1162,12 @@ ecma_string_to_number (const ecma_string_t *str_p) /**< ecma-string */
 
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     case ECMA_STRING_CONTAINER_MAGIC_STRING:
     case ECMA_STRING_CONTAINER_MAGIC_STRING_EX:
+#ifdef CONFIG_ECMA_ROPE_STRING
+    case ECMA_STRING_CONTAINER_ROPE:
+#endif /* CONFIG_ECMA_ROPE_STRING */
     {
       ecma_number_t num;
 
@@ -879,6 +1232,8 @@ ecma_string_copy_to_cesu8_buffer (const ecma_string_t *string_desc_p, /**< ecma-
   JERRY_ASSERT (buffer_p != NULL || buffer_size == 0);
   JERRY_ASSERT (ecma_string_get_size (string_desc_p) <= buffer_size);
 
+  ECMA_STRING_FLATTEN_ROPE (string_desc_p);
+
   lit_utf8_size_t size;
 
   switch (ECMA_STRING_GET_CONTAINER (string_desc_p))
@@ -890,9 +1245,10 @@ ecma_string_copy_to_cesu8_buffer (const ecma_string_t *string_desc_p, /**< ecma-
       break;
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
       size = string_desc_p->u.long_utf8_string_size;
-      memcpy (buffer_p, ((ecma_long_string_t *) string_desc_p) + 1, size);
+      memcpy (buffer_p, ecma_long_string_chars (string_desc_p), size);
       break;
     }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
@@ -940,6 +1296,8 @@ ecma_string_copy_to_utf8_buffer (const ecma_string_t *string_desc_p, /**< ecma-s
   JERRY_ASSERT (buffer_p != NULL || buffer_size == 0);
   JERRY_ASSERT (ecma_string_get_utf8_size (string_desc_p) <= buffer_size);
 
+  ECMA_STRING_FLATTEN_ROPE (string_desc_p);
+
   lit_utf8_size_t size;
 
   switch (ECMA_STRING_GET_CONTAINER (string_desc_p))
@@ -953,8 +1311,9 @@ ecma_string_copy_to_utf8_buffer (const ecma_string_t *string_desc_p, /**< ecma-s
       break;
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
-      size = lit_convert_cesu8_string_to_utf8_string ((lit_utf8_byte_t *) (((ecma_long_string_t *) string_desc_p) + 1),
+      size = lit_convert_cesu8_string_to_utf8_string (ecma_long_string_chars (string_desc_p),
                                                       string_desc_p->u.long_utf8_string_size,
                                                       buffer_p,
                                                       buffer_size);
@@ -1279,6 +1638,8 @@ ecma_string_raw_chars (const ecma_string_t *string_p, /**< ecma-string */
   lit_utf8_size_t size;
   const lit_utf8_byte_t *result_p;
 
+  ECMA_STRING_FLATTEN_ROPE (string_p);
+
   switch (ECMA_STRING_GET_CONTAINER (string_p))
   {
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
@@ -1289,11 +1650,12 @@ ecma_string_raw_chars (const ecma_string_t *string_p, /**< ecma-string */
       break;
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
       size = string_p->u.long_utf8_string_size;
       ecma_long_string_t *long_string_p = (ecma_long_string_t *) string_p;
       length = long_string_p->long_utf8_string_length;
-      result_p = (const lit_utf8_byte_t *) (long_string_p + 1);
+      result_p = ecma_long_string_chars (string_p);
       break;
     }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
@@ -1377,12 +1739,19 @@ ecma_string_is_length (const ecma_string_t *string_p) /**< property name */
 /**
  * Converts a string into a property name
  *
+ * Note:
+ *      the referenced string may be a shared string equal to prop_name_p,
+ *      and interning the string may allocate memory
+ *
  * @return the compressed pointer part of the name
  */
 inline jmem_cpointer_t __attr_always_inline___
 ecma_string_to_property_name (ecma_string_t *prop_name_p, /**< property name */
                               ecma_property_t *name_type_p) /**< [out] property name type */
 {
+  /* Properties are named by the flattened strings. */
+  ECMA_STRING_FLATTEN_ROPE (prop_name_p);
+
   ecma_string_container_t container = ECMA_STRING_GET_CONTAINER (prop_name_p);
 
   switch (container)
@@ -1416,7 +1785,11 @@ ecma_string_to_property_name (ecma_string_t *prop_name_p, /**< property name */
 
   *name_type_p = ECMA_PROPERTY_NAME_TYPE_STRING << ECMA_PROPERTY_NAME_TYPE_SHIFT;
 
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+  prop_name_p = ecma_intern_property_name (prop_name_p);
+#else /* CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
   ecma_ref_ecma_string (prop_name_p);
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
 
   jmem_cpointer_t prop_name_cp;
 
@@ -1567,8 +1940,6 @@ static bool __attr_noinline___
 ecma_compare_ecma_strings_longpath (const ecma_string_t *string1_p, /* ecma-string */
                                     const ecma_string_t *string2_p) /* ecma-string */
 {
-  JERRY_ASSERT (ECMA_STRING_GET_CONTAINER (string1_p) == ECMA_STRING_GET_CONTAINER (string2_p));
-
   const lit_utf8_byte_t *utf8_string1_p, *utf8_string2_p;
   lit_utf8_size_t utf8_string1_size, utf8_string2_size;
 
@@ -1576,16 +1947,21 @@ ecma_compare_ecma_strings_longpath (const ecma_string_t *string1_p, /* ecma-stri
   {
     utf8_string1_p = (lit_utf8_byte_t *) (string1_p + 1);
     utf8_string1_size = string1_p->u.utf8_string.size;
+  }
+  else
+  {
+    utf8_string1_p = ecma_long_string_chars (string1_p);
+    utf8_string1_size = string1_p->u.long_utf8_string_size;
+  }
+
+  if (ECMA_STRING_GET_CONTAINER (string2_p) == ECMA_STRING_CONTAINER_HEAP_UTF8_STRING)
+  {
     utf8_string2_p = (lit_utf8_byte_t *) (string2_p + 1);
     utf8_string2_size = string2_p->u.utf8_string.size;
   }
   else
   {
-    JERRY_ASSERT (ECMA_STRING_GET_CONTAINER (string1_p) == ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING);
-
-    utf8_string1_p = (lit_utf8_byte_t *) (((ecma_long_string_t *) string1_p) + 1);
-    utf8_string1_size = string1_p->u.long_utf8_string_size;
-    utf8_string2_p = (lit_utf8_byte_t *) (((ecma_long_string_t *) string2_p) + 1);
+    utf8_string2_p = ecma_long_string_chars (string2_p);
     utf8_string2_size = string2_p->u.long_utf8_string_size;
   }
 
@@ -1620,10 +1996,23 @@ ecma_compare_ecma_strings (const ecma_string_t *string1_p, /* ecma-string */
     return false;
   }
 
+  ECMA_STRING_FLATTEN_ROPE (string1_p);
+  ECMA_STRING_FLATTEN_ROPE (string2_p);
+
   ecma_string_container_t string1_container = ECMA_STRING_GET_CONTAINER (string1_p);
+  ecma_string_container_t string2_container = ECMA_STRING_GET_CONTAINER (string2_p);
 
-  if (string1_container != ECMA_STRING_GET_CONTAINER (string2_p))
+  if (string1_container != string2_container)
   {
+    /* External strings are equal to the heap strings with the same characters. */
+    if ((string1_container == ECMA_STRING_CONTAINER_EXTERNAL_STRING
+         && string2_container >= ECMA_STRING_CONTAINER_HEAP_UTF8_STRING)
+        || (string2_container == ECMA_STRING_CONTAINER_EXTERNAL_STRING
+            && string1_container >= ECMA_STRING_CONTAINER_HEAP_UTF8_STRING))
+    {
+      return ecma_compare_ecma_strings_longpath (string1_p, string2_p);
+    }
+
     return false;
   }
 
@@ -1661,6 +2050,9 @@ ecma_compare_ecma_strings_relational (const ecma_string_t *string1_p, /**< ecma-
   lit_utf8_byte_t uint32_to_string_buffer1[ECMA_MAX_CHARS_IN_STRINGIFIED_UINT32];
   lit_utf8_byte_t uint32_to_string_buffer2[ECMA_MAX_CHARS_IN_STRINGIFIED_UINT32];
 
+  ECMA_STRING_FLATTEN_ROPE (string1_p);
+  ECMA_STRING_FLATTEN_ROPE (string2_p);
+
   switch (ECMA_STRING_GET_CONTAINER (string1_p))
   {
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
@@ -1670,8 +2062,9 @@ ecma_compare_ecma_strings_relational (const ecma_string_t *string1_p, /**< ecma-
       break;
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
-      utf8_string1_p = (lit_utf8_byte_t *) (((ecma_long_string_t *) string1_p) + 1);
+      utf8_string1_p = ecma_long_string_chars (string1_p);
       utf8_string1_size = string1_p->u.long_utf8_string_size;
       break;
     }
@@ -1708,8 +2101,9 @@ ecma_compare_ecma_strings_relational (const ecma_string_t *string1_p, /**< ecma-
       break;
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
-      utf8_string2_p = (lit_utf8_byte_t *) (((ecma_long_string_t *) string2_p) + 1);
+      utf8_string2_p = ecma_long_string_chars (string2_p);
       utf8_string2_size = string2_p->u.long_utf8_string_size;
       break;
     }
@@ -1753,11 +2147,18 @@ ecma_string_get_length (const ecma_string_t *string_p) /**< ecma-string */
 {
   switch (ECMA_STRING_GET_CONTAINER (string_p))
   {
+#ifdef CONFIG_ECMA_ROPE_STRING
+    case ECMA_STRING_CONTAINER_ROPE:
+    {
+      return ((ecma_rope_string_t *) string_p)->length;
+    }
+#endif /* CONFIG_ECMA_ROPE_STRING */
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
     {
       return (ecma_length_t) (string_p->u.utf8_string.length);
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
       return (ecma_length_t) (((ecma_long_string_t *) string_p)->long_utf8_string_length);
     }
@@ -1789,6 +2190,8 @@ ecma_string_get_length (const ecma_string_t *string_p) /**< ecma-string */
 ecma_length_t
 ecma_string_get_utf8_length (const ecma_string_t *string_p) /**< ecma-string */
 {
+  ECMA_STRING_FLATTEN_ROPE (string_p);
+
   switch (ECMA_STRING_GET_CONTAINER (string_p))
   {
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
@@ -1802,6 +2205,7 @@ ecma_string_get_utf8_length (const ecma_string_t *string_p) /**< ecma-string */
                                                   (lit_utf8_size_t) string_p->u.utf8_string.size);
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
       ecma_long_string_t *long_string_p = (ecma_long_string_t *) string_p;
       if (string_p->u.long_utf8_string_size == (lit_utf8_size_t) long_string_p->long_utf8_string_length)
@@ -1809,7 +2213,7 @@ ecma_string_get_utf8_length (const ecma_string_t *string_p) /**< ecma-string */
         return (ecma_length_t) (long_string_p->long_utf8_string_length);
       }
 
-      return lit_get_utf8_length_of_cesu8_string ((const lit_utf8_byte_t *) (string_p + 1),
+      return lit_get_utf8_length_of_cesu8_string (ecma_long_string_chars (string_p),
                                                   (lit_utf8_size_t) string_p->u.long_utf8_string_size);
     }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
@@ -1842,11 +2246,18 @@ ecma_string_get_size (const ecma_string_t *string_p) /**< ecma-string */
 {
   switch (ECMA_STRING_GET_CONTAINER (string_p))
   {
+#ifdef CONFIG_ECMA_ROPE_STRING
+    case ECMA_STRING_CONTAINER_ROPE:
+    {
+      return string_p->u.long_utf8_string_size;
+    }
+#endif /* CONFIG_ECMA_ROPE_STRING */
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
     {
       return (lit_utf8_size_t) string_p->u.utf8_string.size;
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
       return (lit_utf8_size_t) string_p->u.long_utf8_string_size;
     }
@@ -1874,6 +2285,8 @@ ecma_string_get_size (const ecma_string_t *string_p) /**< ecma-string */
 lit_utf8_size_t
 ecma_string_get_utf8_size (const ecma_string_t *string_p) /**< ecma-string */
 {
+  ECMA_STRING_FLATTEN_ROPE (string_p);
+
   switch (ECMA_STRING_GET_CONTAINER (string_p))
   {
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
@@ -1887,6 +2300,7 @@ ecma_string_get_utf8_size (const ecma_string_t *string_p) /**< ecma-string */
                                                 (lit_utf8_size_t) string_p->u.utf8_string.size);
     }
     case ECMA_STRING_CONTAINER_HEAP_LONG_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     {
       ecma_long_string_t *long_string_p = (ecma_long_string_t *) string_p;
       if (string_p->u.long_utf8_string_size == (lit_utf8_size_t) long_string_p->long_utf8_string_length)
@@ -1894,7 +2308,7 @@ ecma_string_get_utf8_size (const ecma_string_t *string_p) /**< ecma-string */
         return (lit_utf8_size_t) string_p->u.long_utf8_string_size;
       }
 
-      return lit_get_utf8_size_of_cesu8_string ((const lit_utf8_byte_t *) (string_p + 1),
+      return lit_get_utf8_size_of_cesu8_string (ecma_long_string_chars (string_p),
                                                 (lit_utf8_size_t) string_p->u.long_utf8_string_size);
     }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
@@ -25,6 +25,106 @@
  * @{
  */
 
+/**
+ * Get the capacity of the buffer of a collection.
+ *
+ * Note:
+ *      the capacity is not stored, it only depends on the number of the elements,
+ *      so that the header fits in a pool chunk: a buffer grows by doubling
+ *
+ * @return number of the elements the buffer can hold
+ */
+static ecma_length_t
+ecma_get_values_collection_capacity (ecma_length_t values_number) /**< number of ecma values */
+{
+  if (values_number == 0)
+  {
+    return 0;
+  }
+
+  if (unlikely (values_number > JMEM_HEAP_SIZE / sizeof (ecma_value_t)))
+  {
+    jerry_fatal (ERR_OUT_OF_MEMORY);
+  }
+
+  ecma_length_t capacity = ECMA_COLLECTION_INITIAL_CAPACITY;
+
+  while (capacity < values_number)
+  {
+    capacity <<= 1;
+  }
+
+  return capacity;
+} /* ecma_get_values_collection_capacity */
+
+/**
+ * Allocate the buffer of a collection.
+ *
+ * @return pointer to the buffer
+ */
+static ecma_value_t *
+ecma_alloc_values_collection_buffer (ecma_length_t capacity) /**< number of the elements */
+{
+  JERRY_ASSERT (capacity > 0);
+
+  size_t size = capacity * sizeof (ecma_value_t);
+
+  #ifdef PROF_COUNT__SIZE_DETAILED
+  profile_add_count_size_detailed(3, size); /* size detailed */
+  #endif
+
+  return (ecma_value_t *) jmem_heap_alloc_block (size);
+} /* ecma_alloc_values_collection_buffer */
+
+/**
+ * Free the buffer of a collection.
+ */
+static void
+ecma_dealloc_values_collection_buffer (ecma_value_t *buffer_p, /**< buffer */
+                                       ecma_length_t capacity) /**< number of the elements */
+{
+  JERRY_ASSERT (buffer_p != NULL && capacity > 0);
+
+  size_t size = capacity * sizeof (ecma_value_t);
+
+  #ifdef PROF_COUNT__SIZE_DETAILED
+  profile_add_count_size_detailed(3, -size); /* size detailed */
+  #endif
+
+  jmem_heap_free_block (buffer_p, size);
+} /* ecma_dealloc_values_collection_buffer */
+
+/**
+ * Move the elements of a collection to a buffer of another capacity.
+ */
+static void
+ecma_resize_values_collection_buffer (ecma_collection_header_t *header_p, /**< collection's header */
+                                      ecma_length_t old_capacity, /**< capacity of the current buffer */
+                                      ecma_length_t new_capacity) /**< capacity of the new buffer */
+{
+  JERRY_ASSERT (header_p->unit_number <= old_capacity && header_p->unit_number <= new_capacity);
+
+  ecma_value_t *old_buffer_p = ECMA_GET_POINTER (ecma_value_t, header_p->buffer_cp);
+  ecma_value_t *new_buffer_p = NULL;
+
+  if (new_capacity > 0)
+  {
+    new_buffer_p = ecma_alloc_values_collection_buffer (new_capacity);
+
+    if (header_p->unit_number > 0)
+    {
+      memcpy (new_buffer_p, old_buffer_p, header_p->unit_number * sizeof (ecma_value_t));
+    }
+  }
+
+  if (old_buffer_p != NULL)
+  {
+    ecma_dealloc_values_collection_buffer (old_buffer_p, old_capacity);
+  }
+
+  ECMA_SET_POINTER (header_p->buffer_cp, new_buffer_p);
+} /* ecma_resize_values_collection_buffer */
+
 /**
  * Allocate a collection of ecma values.
  *
@@ -38,47 +138,33 @@ ecma_new_values_collection (const ecma_value_t values_buffer[], /**< ecma values
 {
   JERRY_ASSERT (values_buffer != NULL || values_number == 0);
 
-  const size_t values_in_chunk = JERRY_SIZE_OF_STRUCT_MEMBER (ecma_collection_chunk_t, data) / sizeof (ecma_value_t);
-
   ecma_collection_header_t *header_p = ecma_alloc_collection_header ();
 
   header_p->unit_number = values_number;
+  header_p->buffer_cp = ECMA_NULL_POINTER;
+
+  if (values_number == 0)
+  {
+    return header_p;
+  }
 
-  jmem_cpointer_t *next_chunk_cp_p = &header_p->first_chunk_cp;
-  ecma_collection_chunk_t *last_chunk_p = NULL;
-  ecma_value_t *cur_value_buf_iter_p = NULL;
-  ecma_value_t *cur_value_buf_end_p = NULL;
+  ecma_value_t *buffer_p = ecma_alloc_values_collection_buffer (ecma_get_values_collection_capacity (values_number));
 
   for (ecma_length_t value_index = 0;
        value_index < values_number;
        value_index++)
   {
-    if (cur_value_buf_iter_p == cur_value_buf_end_p)
-    {
-      ecma_collection_chunk_t *chunk_p = ecma_alloc_collection_chunk ();
-      ECMA_SET_POINTER (*next_chunk_cp_p, chunk_p);
-      next_chunk_cp_p = &chunk_p->next_chunk_cp;
-
-      cur_value_buf_iter_p = (ecma_value_t *) chunk_p->data;
-      cur_value_buf_end_p = cur_value_buf_iter_p + values_in_chunk;
-
-      last_chunk_p = chunk_p;
-    }
-
-    JERRY_ASSERT (cur_value_buf_iter_p + 1 <= cur_value_buf_end_p);
-
     if (do_ref_if_object)
     {
-      *cur_value_buf_iter_p++ = ecma_copy_value (values_buffer[value_index]);
+      buffer_p[value_index] = ecma_copy_value (values_buffer[value_index]);
     }
     else
     {
-      *cur_value_buf_iter_p++ = ecma_copy_value_if_not_object (values_buffer[value_index]);
+      buffer_p[value_index] = ecma_copy_value_if_not_object (values_buffer[value_index]);
     }
   }
 
-  *next_chunk_cp_p = ECMA_NULL_POINTER;
-  ECMA_SET_POINTER (header_p->last_chunk_cp, last_chunk_p);
+  ECMA_SET_NON_NULL_POINTER (header_p->buffer_cp, buffer_p);
 
   return header_p;
 } /* ecma_new_values_collection */
@@ -93,41 +179,25 @@ ecma_free_values_collection (ecma_collection_header_t *header_p, /**< collection
 {
   JERRY_ASSERT (header_p != NULL);
 
-  const size_t values_in_chunk = JERRY_SIZE_OF_STRUCT_MEMBER (ecma_collection_chunk_t, data) / sizeof (ecma_value_t);
+  ecma_value_t *buffer_p = ECMA_GET_POINTER (ecma_value_t, header_p->buffer_cp);
 
-  ecma_collection_chunk_t *chunk_p = ECMA_GET_POINTER (ecma_collection_chunk_t,
-                                                       header_p->first_chunk_cp);
-  ecma_length_t value_index = 0;
-
-  while (chunk_p != NULL)
+  if (buffer_p != NULL)
   {
-    JERRY_ASSERT (value_index < header_p->unit_number);
-
-    ecma_value_t *cur_value_buf_iter_p = (ecma_value_t *) chunk_p->data;
-    ecma_value_t *cur_value_buf_end_p = cur_value_buf_iter_p + values_in_chunk;
+    ecma_value_t *buffer_end_p = buffer_p + header_p->unit_number;
 
-    while (cur_value_buf_iter_p != cur_value_buf_end_p
-           && value_index < header_p->unit_number)
+    for (ecma_value_t *value_p = buffer_p; value_p < buffer_end_p; value_p++)
     {
-      JERRY_ASSERT (cur_value_buf_iter_p < cur_value_buf_end_p);
-
       if (do_deref_if_object)
       {
-        ecma_free_value (*cur_value_buf_iter_p);
+        ecma_free_value (*value_p);
       }
       else
       {
-        ecma_free_value_if_not_object (*cur_value_buf_iter_p);
+        ecma_free_value_if_not_object (*value_p);
       }
-
-      cur_value_buf_iter_p++;
-      value_index++;
     }
 
-    ecma_collection_chunk_t *next_chunk_p = ECMA_GET_POINTER (ecma_collection_chunk_t,
-                                                              chunk_p->next_chunk_cp);
-    ecma_dealloc_collection_chunk (chunk_p);
-    chunk_p = next_chunk_p;
+    ecma_dealloc_values_collection_buffer (buffer_p, ecma_get_values_collection_capacity (header_p->unit_number));
   }
 
   ecma_dealloc_collection_header (header_p);
@@ -135,6 +205,9 @@ ecma_free_values_collection (ecma_collection_header_t *header_p, /**< collection
 
 /**
  * Append new value to ecma values collection
+ *
+ * Warning:
+ *         the function invalidates all iterators and buffer pointers of the passed collection
  */
 void
 ecma_append_to_values_collection (ecma_collection_header_t *header_p, /**< collection's header */
@@ -142,140 +215,61 @@ ecma_append_to_values_collection (ecma_collection_header_t *header_p, /**< colle
                                   bool do_ref_if_object) /**< if the value is object value,
                                                               increase reference counter of the object */
 {
-  const size_t values_in_chunk = JERRY_SIZE_OF_STRUCT_MEMBER (ecma_collection_chunk_t, data) / sizeof (ecma_value_t);
-
-  size_t values_number = header_p->unit_number;
-  size_t pos_of_new_value_in_chunk = values_number % values_in_chunk;
+  ecma_length_t values_number = header_p->unit_number;
 
-  values_number++;
-
-  if ((ecma_length_t) values_number == values_number)
-  {
-    header_p->unit_number = (ecma_length_t) values_number;
-  }
-  else
+  if (unlikely (values_number == UINT32_MAX))
   {
     jerry_fatal (ERR_OUT_OF_MEMORY);
   }
 
-  ecma_collection_chunk_t *chunk_p = ECMA_GET_POINTER (ecma_collection_chunk_t,
-                                                       header_p->last_chunk_cp);
+  ecma_length_t capacity = ecma_get_values_collection_capacity (values_number);
 
-  if (pos_of_new_value_in_chunk == 0)
+  if (values_number == capacity)
   {
-    /* all chunks are currently filled with values */
-
-    chunk_p = ecma_alloc_collection_chunk ();
-    chunk_p->next_chunk_cp = ECMA_NULL_POINTER;
-
-    if (header_p->last_chunk_cp == ECMA_NULL_POINTER)
-    {
-      JERRY_ASSERT (header_p->first_chunk_cp == ECMA_NULL_POINTER);
-
-      #ifdef PROF_COUNT__COMPRESSION_CALLERS
-      profile_inc_count_compression_callers(9); /* compression callers */
-      #endif
-      ECMA_SET_NON_NULL_POINTER (header_p->first_chunk_cp, chunk_p);
-    }
-    else
-    {
-      ecma_collection_chunk_t *last_chunk_p = ECMA_GET_NON_NULL_POINTER (ecma_collection_chunk_t,
-                                                                         header_p->last_chunk_cp);
-
-      JERRY_ASSERT (last_chunk_p->next_chunk_cp == ECMA_NULL_POINTER);
-
-      #ifdef PROF_COUNT__COMPRESSION_CALLERS
-      profile_inc_count_compression_callers(9); /* compression callers */
-      #endif
-      ECMA_SET_NON_NULL_POINTER (last_chunk_p->next_chunk_cp, chunk_p);
-    }
-
-    #ifdef PROF_COUNT__COMPRESSION_CALLERS
-    profile_inc_count_compression_callers(9); /* compression callers */
-    #endif
-    ECMA_SET_NON_NULL_POINTER (header_p->last_chunk_cp, chunk_p);
-  }
-  else
-  {
-    /* last chunk can be appended with the new value */
-    JERRY_ASSERT (chunk_p != NULL);
+    /* the buffer is full */
+    ecma_resize_values_collection_buffer (header_p,
+                                          capacity,
+                                          ecma_get_values_collection_capacity (values_number + 1));
   }
 
-  ecma_value_t *values_p = (ecma_value_t *) chunk_p->data;
-
-  JERRY_ASSERT ((uint8_t *) (values_p + pos_of_new_value_in_chunk + 1) <= (uint8_t *) (chunk_p + 1));
+  ecma_value_t *buffer_p = ECMA_GET_NON_NULL_POINTER (ecma_value_t, header_p->buffer_cp);
 
   if (do_ref_if_object)
   {
-    values_p[pos_of_new_value_in_chunk] = ecma_copy_value (v);
+    buffer_p[values_number] = ecma_copy_value (v);
   }
   else
   {
-    values_p[pos_of_new_value_in_chunk] = ecma_copy_value_if_not_object (v);
+    buffer_p[values_number] = ecma_copy_value_if_not_object (v);
   }
+
+  header_p->unit_number = values_number + 1;
 } /* ecma_append_to_values_collection */
 
 /**
  * Remove last element of the collection
  *
  * Warning:
- *         the function invalidates all iterators that are configured to access the passed collection
+ *         the function invalidates all iterators and buffer pointers of the passed collection
  */
 void
 ecma_remove_last_value_from_values_collection (ecma_collection_header_t *header_p) /**< collection's header */
 {
   JERRY_ASSERT (header_p != NULL && header_p->unit_number > 0);
 
-  const size_t values_in_chunk = JERRY_SIZE_OF_STRUCT_MEMBER (ecma_collection_chunk_t, data) / sizeof (ecma_value_t);
-  size_t values_number = header_p->unit_number;
-  size_t pos_of_value_to_remove_in_chunk = (values_number - 1u) % values_in_chunk;
-
-  ecma_collection_chunk_t *last_chunk_p = ECMA_GET_NON_NULL_POINTER (ecma_collection_chunk_t,
-                                                                     header_p->last_chunk_cp);
-
-  ecma_value_t *values_p = (ecma_value_t *) last_chunk_p->data;
-  JERRY_ASSERT ((uint8_t *) (values_p + pos_of_value_to_remove_in_chunk + 1) <= (uint8_t *) (last_chunk_p + 1));
-
-  ecma_value_t value_to_remove = values_p[pos_of_value_to_remove_in_chunk];
-
-  ecma_free_value (value_to_remove);
+  ecma_value_t *buffer_p = ECMA_GET_NON_NULL_POINTER (ecma_value_t, header_p->buffer_cp);
+  ecma_length_t capacity = ecma_get_values_collection_capacity (header_p->unit_number);
 
   header_p->unit_number--;
 
-  if (pos_of_value_to_remove_in_chunk == 0)
-  {
-    ecma_collection_chunk_t *chunk_to_remove_p = last_chunk_p;
+  ecma_free_value (buffer_p[header_p->unit_number]);
 
-    /* free last chunk */
-    if (header_p->first_chunk_cp == header_p->last_chunk_cp)
-    {
-      header_p->first_chunk_cp = ECMA_NULL_POINTER;
-      header_p->last_chunk_cp = ECMA_NULL_POINTER;
-    }
-    else
-    {
-      ecma_collection_chunk_t *chunk_iter_p = ECMA_GET_NON_NULL_POINTER (ecma_collection_chunk_t,
-                                                                         header_p->first_chunk_cp);
+  ecma_length_t new_capacity = ecma_get_values_collection_capacity (header_p->unit_number);
 
-      while (chunk_iter_p->next_chunk_cp != header_p->last_chunk_cp)
-      {
-        chunk_iter_p = ECMA_GET_NON_NULL_POINTER (ecma_collection_chunk_t,
-                                                  chunk_iter_p->next_chunk_cp);
-      }
-
-      ecma_collection_chunk_t *new_last_chunk_p = chunk_iter_p;
-
-      JERRY_ASSERT (ECMA_GET_NON_NULL_POINTER (ecma_collection_chunk_t,
-                                               new_last_chunk_p->next_chunk_cp) == chunk_to_remove_p);
-
-      #ifdef PROF_COUNT__COMPRESSION_CALLERS
-      profile_inc_count_compression_callers(10); /* compression callers */
-      #endif
-      ECMA_SET_NON_NULL_POINTER (header_p->last_chunk_cp, new_last_chunk_p);
-      new_last_chunk_p->next_chunk_cp = ECMA_NULL_POINTER;
-    }
-
-    ecma_dealloc_collection_chunk (chunk_to_remove_p);
+  if (new_capacity != capacity)
+  {
+    /* the buffer is halved, so that its capacity stays derivable from the number of the elements */
+    ecma_resize_values_collection_buffer (header_p, capacity, new_capacity);
   }
 } /* ecma_remove_last_value_from_values_collection */
 
@@ -306,6 +300,23 @@ ecma_new_strings_collection (ecma_string_t *string_ptrs_buffer[], /**< pointers
   return new_collection_p;
 } /* ecma_new_strings_collection */
 
+/**
+ * Get the elements of a collection as an array.
+ *
+ * Note:
+ *      the pointer is valid until the collection is modified
+ *
+ * @return pointer to the first element,
+ *         NULL - if the collection is empty
+ */
+ecma_value_t *
+ecma_get_values_collection_buffer (ecma_collection_header_t *header_p) /**< collection's header */
+{
+  JERRY_ASSERT (header_p != NULL);
+
+  return ECMA_GET_POINTER (ecma_value_t, header_p->buffer_cp);
+} /* ecma_get_values_collection_buffer */
+
 /**
  * Initialize new collection iterator for the collection
  */
@@ -314,10 +325,8 @@ ecma_collection_iterator_init (ecma_collection_iterator_t *iterator_p, /**< cont
                                ecma_collection_header_t *collection_p) /**< header of collection */
 {
   iterator_p->header_p = collection_p;
-  iterator_p->next_chunk_cp = (collection_p != NULL ? collection_p->first_chunk_cp : JMEM_CP_NULL);
   iterator_p->current_index = 0;
   iterator_p->current_value_p = NULL;
-  iterator_p->current_chunk_end_p = NULL;
 } /* ecma_collection_iterator_init */
 
 /**
@@ -330,52 +339,28 @@ bool
 ecma_collection_iterator_next (ecma_collection_iterator_t *iterator_p) /**< context of iterator */
 {
   if (iterator_p->header_p == NULL
-      || unlikely (iterator_p->header_p->unit_number == 0)
-      || unlikely (iterator_p->header_p->first_chunk_cp == JMEM_CP_NULL))
+      || unlikely (iterator_p->header_p->unit_number == 0))
   {
     return false;
   }
 
-  const size_t values_in_chunk = JERRY_SIZE_OF_STRUCT_MEMBER (ecma_collection_chunk_t, data) / sizeof (ecma_value_t);
-
   if (iterator_p->current_value_p == NULL)
   {
     JERRY_ASSERT (iterator_p->current_index == 0);
 
-    ecma_collection_chunk_t *first_chunk_p = ECMA_GET_NON_NULL_POINTER (ecma_collection_chunk_t,
-                                                                        iterator_p->header_p->first_chunk_cp);
-
-    iterator_p->next_chunk_cp = first_chunk_p->next_chunk_cp;
-    iterator_p->current_value_p = (ecma_value_t *) &first_chunk_p->data;
-    iterator_p->current_chunk_end_p = (iterator_p->current_value_p + values_in_chunk);
+    iterator_p->current_value_p = ECMA_GET_NON_NULL_POINTER (ecma_value_t, iterator_p->header_p->buffer_cp);
+    return true;
   }
-  else
-  {
-    if (iterator_p->current_index + 1 == iterator_p->header_p->unit_number)
-    {
-      return false;
-    }
-
-    JERRY_ASSERT (iterator_p->current_index + 1 < iterator_p->header_p->unit_number);
 
-    iterator_p->current_index++;
-    iterator_p->current_value_p++;
+  if (iterator_p->current_index + 1 == iterator_p->header_p->unit_number)
+  {
+    return false;
   }
 
-  if (iterator_p->current_value_p == iterator_p->current_chunk_end_p)
-  {
-    ecma_collection_chunk_t *next_chunk_p = ECMA_GET_POINTER (ecma_collection_chunk_t,
-                                                              iterator_p->next_chunk_cp);
-    JERRY_ASSERT (next_chunk_p != NULL);
+  JERRY_ASSERT (iterator_p->current_index + 1 < iterator_p->header_p->unit_number);
 
-    iterator_p->next_chunk_cp = next_chunk_p->next_chunk_cp;
-    iterator_p->current_value_p = (ecma_value_t *) &next_chunk_p->data;
-    iterator_p->current_chunk_end_p = iterator_p->current_value_p + values_in_chunk;
-  }
-  else
-  {
-    JERRY_ASSERT (iterator_p->current_value_p < iterator_p->current_chunk_end_p);
-  }
+  iterator_p->current_index++;
+  iterator_p->current_value_p++;
 
   return true;
 } /* ecma_collection_iterator_next */
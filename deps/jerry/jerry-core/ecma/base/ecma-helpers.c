@@ -14,6 +14,7 @@
  */
 
 #include "ecma-alloc.h"
+#include "ecma-enum-cache.h"
 #include "ecma-gc.h"
 #include "ecma-globals.h"
 #include "ecma-helpers.h"
@@ -24,9 +25,10 @@
 #include "re-compiler.h"
 #include "ecma-builtins.h"
 
+#include "jcontext.h"
+
 #ifdef JERRY_DEBUGGER
 #include "debugger.h"
-#include "jcontext.h"
 #endif /* JERRY_DEBUGGER */
 
 /** \addtogroup ecma ECMA
@@ -84,6 +86,62 @@ JERRY_STATIC_ASSERT (ECMA_OBJECT_REF_ONE == (ECMA_OBJECT_FLAG_EXTENSIBLE << 1),
 JERRY_STATIC_ASSERT ((ECMA_OBJECT_MAX_REF | (ECMA_OBJECT_REF_ONE - 1)) == UINT16_MAX,
                      ecma_object_max_ref_does_not_fill_the_remaining_bits);
 
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+
+/**
+ * The inline property pair must be aligned, so that it can be compressed.
+ */
+JERRY_STATIC_ASSERT (sizeof (ecma_object_t) % JMEM_ALIGNMENT == 0,
+                     inline_property_pair_must_be_aligned);
+
+/**
+ * Mark the inline property pair of a new object free.
+ */
+static inline void __attr_always_inline___
+ecma_init_inline_property_pair (ecma_object_t *object_p) /**< object which is not an extended object */
+{
+  ecma_property_pair_t *property_pair_p = ECMA_OBJECT_INLINE_PROPERTY_PAIR (object_p);
+
+  property_pair_p->header.types[0] = ECMA_PROPERTY_TYPE_DELETED;
+  property_pair_p->header.types[1] = ECMA_PROPERTY_TYPE_DELETED;
+} /* ecma_init_inline_property_pair */
+
+/**
+ * Get the inline property pair of an object, if the object has one and the pair
+ * is not in its property list.
+ *
+ * @return pointer to the free inline property pair - if there is one,
+ *         NULL - otherwise
+ */
+static ecma_property_pair_t *
+ecma_get_free_inline_property_pair (ecma_object_t *object_p) /**< object */
+{
+  /* Only general objects and lexical environments are not extended objects,
+   * and object-bound lexical environments have no property list. */
+  if (!ecma_is_lexical_environment (object_p)
+      && (ecma_get_object_type (object_p) != ECMA_OBJECT_TYPE_GENERAL
+          || ecma_get_object_is_builtin (object_p)))
+  {
+    return NULL;
+  }
+
+  JERRY_ASSERT (!ecma_is_lexical_environment (object_p)
+                || ecma_get_lex_env_type (object_p) == ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE);
+
+  ecma_property_pair_t *property_pair_p = ECMA_OBJECT_INLINE_PROPERTY_PAIR (object_p);
+
+  /* A pair of the property list always has a property. */
+  if (property_pair_p->header.types[0] != ECMA_PROPERTY_TYPE_DELETED
+      || property_pair_p->header.types[1] != ECMA_PROPERTY_TYPE_DELETED)
+  {
+    return NULL;
+  }
+
+  return property_pair_p;
+} /* ecma_get_free_inline_property_pair */
+
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
+
 /**
  * Create an object with specified prototype object
  * (or NULL prototype if there is not prototype for the object)
@@ -107,6 +165,9 @@ ecma_create_object (ecma_object_t *prototype_object_p, /**< pointer to prototybe
   else
   {
     new_object_p = ecma_alloc_object ();
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+    ecma_init_inline_property_pair (new_object_p);
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
   }
 
   new_object_p->type_flags_refs = (uint16_t) (type | ECMA_OBJECT_FLAG_EXTENSIBLE);
@@ -135,6 +196,9 @@ ecma_object_t *
 ecma_create_decl_lex_env (ecma_object_t *outer_lexical_environment_p) /**< outer lexical environment */
 {
   ecma_object_t *new_lexical_environment_p = ecma_alloc_object ();
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+  ecma_init_inline_property_pair (new_lexical_environment_p);
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
 
   uint16_t type = ECMA_OBJECT_FLAG_BUILT_IN_OR_LEXICAL_ENV | ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE;
   new_lexical_environment_p->type_flags_refs = type;
@@ -407,6 +471,23 @@ ecma_create_property (ecma_object_t *object_p, /**< the object */
 {
   JERRY_ASSERT (ECMA_PROPERTY_PAIR_ITEM_COUNT == 2);
 
+  ECMA_GC_WRITE_BARRIER (object_p);
+
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  ecma_enum_cache_invalidate (object_p);
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
+  /* The name is converted first, because interning the name may allocate
+   * memory, which may free the property hashmap of the object. */
+  jmem_cpointer_t name_cp = ECMA_NULL_POINTER;
+
+  if (name_p != NULL)
+  {
+    ecma_property_t name_type;
+    name_cp = ecma_string_to_property_name (name_p, &name_type);
+    type_and_flags = (ecma_property_t) (type_and_flags | name_type);
+  }
+
   jmem_cpointer_t *property_list_head_p = &object_p->property_list_or_bound_object_cp;
 
   if (*property_list_head_p != ECMA_NULL_POINTER)
@@ -430,18 +511,7 @@ ecma_create_property (ecma_object_t *object_p, /**< the object */
     {
       ecma_property_pair_t *first_property_pair_p = (ecma_property_pair_t *) first_property_p;
 
-      if (name_p == NULL)
-      {
-        first_property_pair_p->names_cp[0] = ECMA_NULL_POINTER;
-      }
-      else
-      {
-        ecma_property_t name_type;
-        first_property_pair_p->names_cp[0] = ecma_string_to_property_name (name_p,
-                                                                           &name_type);
-        type_and_flags = (ecma_property_t) (type_and_flags | name_type);
-      }
-
+      first_property_pair_p->names_cp[0] = name_cp;
       first_property_p->types[0] = type_and_flags;
 
       ecma_property_t *property_p = first_property_p->types + 0;
@@ -473,7 +543,16 @@ ecma_create_property (ecma_object_t *object_p, /**< the object */
   }
 
   /* Otherwise we create a new property pair and use its second value. */
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+  ecma_property_pair_t *first_property_pair_p = ecma_get_free_inline_property_pair (object_p);
+
+  if (first_property_pair_p == NULL)
+  {
+    first_property_pair_p = ecma_alloc_property_pair ();
+  }
+#else /* !CONFIG_ECMA_INLINE_PROPERTY_PAIR */
   ecma_property_pair_t *first_property_pair_p = ecma_alloc_property_pair ();
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
 
   /* Need to query property_list_head_p again and recheck the existennce
    * of property hasmap, because ecma_alloc_property_pair may delete them. */
@@ -496,19 +575,7 @@ ecma_create_property (ecma_object_t *object_p, /**< the object */
   first_property_pair_p->header.next_property_cp = *property_list_head_p;
   first_property_pair_p->header.types[0] = ECMA_PROPERTY_TYPE_DELETED;
   first_property_pair_p->names_cp[0] = ECMA_NULL_POINTER;
-
-  if (name_p == NULL)
-  {
-    first_property_pair_p->names_cp[1] = ECMA_NULL_POINTER;
-  }
-  else
-  {
-    ecma_property_t name_type;
-    first_property_pair_p->names_cp[1] = ecma_string_to_property_name (name_p,
-                                                                       &name_type);
-    type_and_flags = (ecma_property_t) (type_and_flags | name_type);
-  }
-
+  first_property_pair_p->names_cp[1] = name_cp;
   first_property_pair_p->header.types[1] = type_and_flags;
 
   #ifdef PROF_COUNT__COMPRESSION_CALLERS
@@ -683,7 +750,7 @@ ecma_find_named_property (ecma_object_t *obj_p, /**< object to find property in
                                     prop_iter_p->next_property_cp);
   }
 
-  if (steps >= (ECMA_PROPERTY_HASMAP_MINIMUM_SIZE / 2))
+  if (steps >= ECMA_PROPERTY_HASHMAP_MIN_PROPERTY_COUNT)
   {
     ecma_property_hashmap_create (obj_p);
   }
@@ -770,6 +837,11 @@ ecma_free_property (ecma_object_t *object_p, /**< object the property belongs to
     ecma_lcache_invalidate (object_p, name_cp, property_p);
   }
 
+#ifdef CONFIG_VM_INLINE_CACHE
+  /* Invalidate all inline caches, which may refer to the property. */
+  JERRY_CONTEXT (vm_inline_cache_epoch)++;
+#endif /* CONFIG_VM_INLINE_CACHE */
+
   if (ECMA_PROPERTY_GET_NAME_TYPE (*property_p) == ECMA_PROPERTY_NAME_TYPE_STRING)
   {
     ecma_string_t *prop_name_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, name_cp);
@@ -779,6 +851,31 @@ ecma_free_property (ecma_object_t *object_p, /**< object the property belongs to
   *property_p = ECMA_PROPERTY_TYPE_DELETED;
 } /* ecma_free_property */
 
+/**
+ * Free a property pair, which is removed from the property list of the object,
+ * and whose properties are deleted.
+ */
+inline void __attr_always_inline___
+ecma_free_property_pair (ecma_object_t *object_p, /**< object */
+                         ecma_property_pair_t *property_pair_p) /**< property pair */
+{
+  JERRY_ASSERT (property_pair_p->header.types[0] == ECMA_PROPERTY_TYPE_DELETED
+                && property_pair_p->header.types[1] == ECMA_PROPERTY_TYPE_DELETED);
+
+#ifdef CONFIG_ECMA_INLINE_PROPERTY_PAIR
+  /* The inline property pair is freed with the object, and until then
+   * it can be reused by ecma_create_property. */
+  if (property_pair_p == ECMA_OBJECT_INLINE_PROPERTY_PAIR (object_p))
+  {
+    return;
+  }
+#else /* !CONFIG_ECMA_INLINE_PROPERTY_PAIR */
+  JERRY_UNUSED (object_p);
+#endif /* CONFIG_ECMA_INLINE_PROPERTY_PAIR */
+
+  ecma_dealloc_property_pair (property_pair_p);
+} /* ecma_free_property_pair */
+
 /**
  * Delete the object's property referenced by its value pointer.
  *
@@ -792,6 +889,10 @@ ecma_delete_property (ecma_object_t *object_p, /**< object */
   ecma_property_header_t *prev_prop_p = NULL;
   ecma_property_hashmap_delete_status hashmap_status = ECMA_PROPERTY_HASHMAP_DELETE_NO_HASHMAP;
 
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  ecma_enum_cache_invalidate (object_p);
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
   if (cur_prop_p != NULL && cur_prop_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP)
   {
     prev_prop_p = cur_prop_p;
@@ -846,7 +947,7 @@ ecma_delete_property (ecma_object_t *object_p, /**< object */
           prev_prop_p->next_property_cp = cur_prop_p->next_property_cp;
         }
 
-        ecma_dealloc_property_pair ((ecma_property_pair_t *) cur_prop_p);
+        ecma_free_property_pair (object_p, (ecma_property_pair_t *) cur_prop_p);
 
         if (hashmap_status == ECMA_PROPERTY_HASHMAP_DELETE_RECREATE_HASHMAP)
         {
@@ -981,7 +1082,7 @@ ecma_delete_array_properties (ecma_object_t *object_p, /**< object */
 
       ecma_property_header_t *next_prop_p = ECMA_GET_POINTER (ecma_property_header_t,
                                                               current_prop_p->next_property_cp);
-      ecma_dealloc_property_pair ((ecma_property_pair_t *) current_prop_p);
+      ecma_free_property_pair (object_p, (ecma_property_pair_t *) current_prop_p);
       current_prop_p = next_prop_p;
     }
     else
@@ -1061,6 +1162,8 @@ ecma_named_data_property_assign_value (ecma_object_t *obj_p, /**< object */
 {
   ecma_assert_object_contains_the_property (obj_p, prop_value_p, ECMA_PROPERTY_TYPE_NAMEDDATA);
 
+  ECMA_GC_WRITE_BARRIER (obj_p);
+
   ecma_value_assign_value (&prop_value_p->value, value);
 } /* ecma_named_data_property_assign_value */
 
@@ -1110,6 +1213,8 @@ ecma_set_named_accessor_property_getter (ecma_object_t *object_p, /**< the prope
 {
   ecma_assert_object_contains_the_property (object_p, prop_value_p, ECMA_PROPERTY_TYPE_NAMEDACCESSOR);
 
+  ECMA_GC_WRITE_BARRIER (object_p);
+
 #ifdef JERRY_CPOINTER_32_BIT
   ecma_getter_setter_pointers_t *getter_setter_pair_p;
   getter_setter_pair_p = ECMA_GET_POINTER (ecma_getter_setter_pointers_t,
@@ -1130,6 +1235,8 @@ ecma_set_named_accessor_property_setter (ecma_object_t *object_p, /**< the prope
 {
   ecma_assert_object_contains_the_property (object_p, prop_value_p, ECMA_PROPERTY_TYPE_NAMEDACCESSOR);
 
+  ECMA_GC_WRITE_BARRIER (object_p);
+
 #ifdef JERRY_CPOINTER_32_BIT
   ecma_getter_setter_pointers_t *getter_setter_pair_p;
   getter_setter_pair_p = ECMA_GET_POINTER (ecma_getter_setter_pointers_t,
@@ -1200,6 +1307,14 @@ ecma_set_property_enumerable_attr (ecma_property_t *property_p, /**< [in,out] pr
   JERRY_ASSERT (ECMA_PROPERTY_GET_TYPE (*property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA
                 || ECMA_PROPERTY_GET_TYPE (*property_p) == ECMA_PROPERTY_TYPE_NAMEDACCESSOR);
 
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  if (ecma_is_property_enumerable (*property_p) != is_enumerable)
+  {
+    /* The object of the property is not known. */
+    ecma_enum_cache_invalidate_all ();
+  }
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
   if (is_enumerable)
   {
     *property_p = (uint8_t) (*property_p | ECMA_PROPERTY_FLAG_ENUMERABLE);
@@ -1365,6 +1480,31 @@ ecma_bytecode_deref (ecma_compiled_code_t *bytecode_p) /**< byte code pointer */
     return;
   }
 
+#ifdef PARSER_LAZY_FUNCTIONS
+  if (bytecode_p->status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION)
+  {
+    cbc_lazy_function_t *lazy_function_p = (cbc_lazy_function_t *) bytecode_p;
+
+    if (lazy_function_p->bytecode_cp != ECMA_NULL_POINTER)
+    {
+      ecma_bytecode_deref (ECMA_GET_NON_NULL_POINTER (ecma_compiled_code_t, lazy_function_p->bytecode_cp));
+    }
+
+    if (lazy_function_p->source_cp != ECMA_NULL_POINTER)
+    {
+      #ifdef PROF_COUNT__SIZE_DETAILED
+      profile_add_count_size_detailed(31, -lazy_function_p->source_size); /* size detailed */
+      #endif
+      jmem_heap_free_block (ECMA_GET_NON_NULL_POINTER (uint8_t, lazy_function_p->source_cp),
+                            lazy_function_p->source_size);
+    }
+
+#ifdef JMEM_STATS
+    jmem_stats_free_byte_code_bytes (((size_t) bytecode_p->size) << JMEM_ALIGNMENT_LOG);
+#endif /* JMEM_STATS */
+  }
+  else
+#endif /* PARSER_LAZY_FUNCTIONS */
   if (bytecode_p->status_flags & CBC_CODE_FLAGS_FUNCTION)
   {
     jmem_cpointer_t *literal_start_p = NULL;
@@ -1447,12 +1587,18 @@ ecma_bytecode_deref (ecma_compiled_code_t *bytecode_p) /**< byte code pointer */
     re_compiled_code_t *re_bytecode_p = (re_compiled_code_t *) bytecode_p;
 
     ecma_deref_ecma_string (ECMA_GET_NON_NULL_POINTER (ecma_string_t, re_bytecode_p->pattern_cp));
+
+    if (re_bytecode_p->last_input_cp != ECMA_NULL_POINTER)
+    {
+      ecma_deref_ecma_string (ECMA_GET_NON_NULL_POINTER (ecma_string_t, re_bytecode_p->last_input_cp));
+    }
 #endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
   }
 
   #ifdef PROF_COUNT__SIZE_DETAILED
   profile_add_count_size_detailed(31, -(((size_t) bytecode_p->size) << JMEM_ALIGNMENT_LOG)); /* size detailed */
   #endif
+  profile_code_unregister (bytecode_p); /* Code sites of profilers */
 
   jmem_heap_free_block (bytecode_p,
                         ((size_t) bytecode_p->size) << JMEM_ALIGNMENT_LOG);
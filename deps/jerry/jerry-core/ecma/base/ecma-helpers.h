@@ -193,6 +193,8 @@ void ecma_free_value_if_not_object (ecma_value_t value);
 ecma_string_t *ecma_new_ecma_string_from_utf8 (const lit_utf8_byte_t *string_p, lit_utf8_size_t string_size);
 ecma_string_t *ecma_new_ecma_string_from_utf8_converted_to_cesu8 (const lit_utf8_byte_t *string_p,
                                                                   lit_utf8_size_t string_size);
+ecma_string_t *ecma_new_ecma_external_string (const lit_utf8_byte_t *string_p, lit_utf8_size_t string_size,
+                                              ecma_object_native_free_callback_t free_cb);
 ecma_string_t *ecma_new_ecma_string_from_code_unit (ecma_char_t code_unit);
 ecma_string_t *ecma_new_ecma_string_from_uint32 (uint32_t uint32_number);
 ecma_string_t *ecma_new_ecma_string_from_number (ecma_number_t num);
@@ -200,6 +202,9 @@ ecma_string_t *ecma_new_ecma_string_from_magic_string_id (lit_magic_string_id_t
 ecma_string_t *ecma_new_ecma_string_from_magic_string_ex_id (lit_magic_string_ex_id_t id);
 ecma_string_t *ecma_new_ecma_length_string (void);
 ecma_string_t *ecma_concat_ecma_strings (ecma_string_t *string1_p, ecma_string_t *string2_p);
+#ifdef CONFIG_ECMA_ROPE_STRING
+const ecma_string_t *ecma_rope_string_flatten (const ecma_string_t *string_p);
+#endif /* CONFIG_ECMA_ROPE_STRING */
 void ecma_ref_ecma_string (ecma_string_t *string_p);
 void ecma_deref_ecma_string (ecma_string_t *string_p);
 ecma_number_t ecma_string_to_number (const ecma_string_t *str_p);
@@ -293,6 +298,7 @@ void ecma_append_to_values_collection (ecma_collection_header_t *header_p, ecma_
 void ecma_remove_last_value_from_values_collection (ecma_collection_header_t *header_p);
 ecma_collection_header_t *ecma_new_strings_collection (ecma_string_t *string_ptrs_buffer[],
                                                        ecma_length_t strings_number);
+ecma_value_t *ecma_get_values_collection_buffer (ecma_collection_header_t *header_p);
 
 /**
  * Context of ecma values' collection iterator
@@ -300,11 +306,8 @@ ecma_collection_header_t *ecma_new_strings_collection (ecma_string_t *string_ptr
 typedef struct
 {
   ecma_collection_header_t *header_p; /**< collection header */
-  jmem_cpointer_t next_chunk_cp; /**< compressed pointer to next chunk */
   ecma_length_t current_index; /**< index of current element */
   const ecma_value_t *current_value_p; /**< pointer to current element */
-  const ecma_value_t *current_chunk_beg_p; /**< pointer to beginning of current chunk's data */
-  const ecma_value_t *current_chunk_end_p; /**< pointer to place right after the end of current chunk's data */
 } ecma_collection_iterator_t;
 
 void
@@ -343,6 +346,7 @@ ecma_property_value_t *
 ecma_get_named_data_property (ecma_object_t *obj_p, ecma_string_t *name_p);
 
 void ecma_free_property (ecma_object_t *object_p, jmem_cpointer_t name_cp, ecma_property_t *property_p);
+void ecma_free_property_pair (ecma_object_t *object_p, ecma_property_pair_t *property_pair_p);
 
 void ecma_delete_property (ecma_object_t *object_p, ecma_property_value_t *prop_value_p);
 uint32_t ecma_delete_array_properties (ecma_object_t *object_p, uint32_t new_length, uint32_t old_length);
@@ -390,6 +394,11 @@ lit_utf8_size_t ecma_number_to_utf8_string (ecma_number_t num, lit_utf8_byte_t *
 /* ecma-helpers-errol.c */
 lit_utf8_size_t ecma_errol0_dtoa (double val, lit_utf8_byte_t *buffer_p, int32_t *exp_p);
 
+/* ecma-helpers-grisu.c */
+#if CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64
+lit_utf8_size_t ecma_grisu3_dtoa (double val, lit_utf8_byte_t *buffer_p, int32_t *exp_p);
+#endif /* CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64 */
+
 /**
  * @}
  * @}
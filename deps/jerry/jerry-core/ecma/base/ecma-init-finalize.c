@@ -14,6 +14,7 @@
  */
 
 #include "ecma-builtins.h"
+#include "ecma-enum-cache.h"
 #include "ecma-gc.h"
 #include "ecma-helpers.h"
 #include "ecma-init-finalize.h"
@@ -37,6 +38,9 @@ void
 ecma_init (void)
 {
   ecma_lcache_init ();
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  ecma_enum_cache_init ();
+#endif /* CONFIG_ECMA_ENUM_CACHE */
   ecma_init_global_lex_env ();
 
   jmem_register_free_unused_memory_callback (ecma_free_unused_memory);
@@ -59,6 +63,13 @@ ecma_finalize (void)
 {
   jmem_unregister_free_unused_memory_callback (ecma_free_unused_memory);
 
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  ecma_enum_cache_finalize ();
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
+#ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
+  ecma_job_queue_finalize ();
+#endif /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
   ecma_finalize_global_lex_env ();
   ecma_finalize_builtins ();
   ecma_gc_run (JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW);
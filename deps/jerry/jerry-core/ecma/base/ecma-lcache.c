@@ -149,6 +149,14 @@ static inline jmem_cpointer_t __attr_always_inline___
 ecma_string_to_lcache_property_name (const ecma_string_t *prop_name_p, /**< property name */
                                      ecma_property_t *name_type_p) /**< [out] property name type */
 {
+#ifdef CONFIG_ECMA_ROPE_STRING
+  /* Properties are named by the flattened strings. */
+  if (ECMA_STRING_GET_CONTAINER (prop_name_p) == ECMA_STRING_CONTAINER_ROPE)
+  {
+    prop_name_p = ecma_rope_string_flatten (prop_name_p);
+  }
+#endif /* CONFIG_ECMA_ROPE_STRING */
+
   ecma_string_container_t container = ECMA_STRING_GET_CONTAINER (prop_name_p);
 
   switch (container)
@@ -25,6 +25,20 @@
  * @{
  */
 
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+
+/**
+ * Shared property names with this many references are not referenced by more properties.
+ */
+#define ECMA_PROPERTY_NAME_INTERN_MAX_REF (ECMA_STRING_MAX_REF / 2)
+
+/**
+ * Initial number of entries of the property name intern index, which is usually small.
+ */
+#define ECMA_PROPERTY_NAME_INTERN_MIN_SIZE 8
+
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
+
 /**
  * Free string list
  */
@@ -63,94 +77,552 @@ ecma_free_string_list (ecma_lit_storage_item_t *string_list_p) /**< string list
   }
 } /* ecma_free_string_list */
 
+/**
+ * Size of the table of a literal storage index.
+ */
+#define ECMA_LIT_STORAGE_INDEX_TABLE_SIZE(entry_count) \
+  ((entry_count) * sizeof (jmem_cpointer_t))
+
+/**
+ * Free the table of a literal storage index.
+ */
+static void
+ecma_lit_storage_index_free (ecma_lit_storage_index_t *index_p) /**< literal storage index */
+{
+  if (index_p->table_p != NULL)
+  {
+    size_t size_to_free = ECMA_LIT_STORAGE_INDEX_TABLE_SIZE (index_p->mask + 1);
+
+    #ifdef PROF_COUNT__SIZE_DETAILED
+    profile_add_count_size_detailed(6, -size_to_free); /* size detailed */
+    #endif
+
+    jmem_heap_free_block (index_p->table_p, size_to_free);
+    index_p->table_p = NULL;
+    index_p->mask = 0;
+  }
+} /* ecma_lit_storage_index_free */
+
 /**
  * Finalize literal storage
  */
 void
 ecma_finalize_lit_storage (void)
 {
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+  ecma_lit_storage_index_t *intern_index_p = &JERRY_CONTEXT (property_name_index);
+
+  for (uint32_t i = 0; intern_index_p->table_p != NULL && i <= intern_index_p->mask; i++)
+  {
+    if (intern_index_p->table_p[i] != JMEM_CP_NULL)
+    {
+      ecma_deref_ecma_string (JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, intern_index_p->table_p[i]));
+    }
+  }
+
+  ecma_lit_storage_index_free (intern_index_p);
+  intern_index_p->count = 0;
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
+
+  ecma_lit_storage_index_free (&JERRY_CONTEXT (string_index));
+  ecma_lit_storage_index_free (&JERRY_CONTEXT (number_index));
+  JERRY_CONTEXT (string_index).count = 0;
+  JERRY_CONTEXT (number_index).count = 0;
+
   ecma_free_string_list (JERRY_CONTEXT (string_list_first_p));
   ecma_free_string_list (JERRY_CONTEXT (number_list_first_p));
 } /* ecma_finalize_lit_storage */
 
 /**
- * Find or create a literal string.
+ * Calculate the index hash of a literal number value.
  *
- * @return ecma_string_t compressed pointer
+ * @return hash of the number
  */
-jmem_cpointer_t
-ecma_find_or_create_literal_string (const lit_utf8_byte_t *chars_p, /**< string to be searched */
-                                    lit_utf8_size_t size) /**< size of the string */
+static uint32_t
+ecma_lit_storage_hash_number (ecma_value_t num) /**< number value */
 {
-  ecma_string_t *string_p = ecma_new_ecma_string_from_utf8 (chars_p, size);
+  if (ecma_is_value_integer_number (num))
+  {
+    return (uint32_t) ecma_get_integer_from_value (num);
+  }
 
-  ecma_lit_storage_item_t *string_list_p = JERRY_CONTEXT (string_list_first_p);
-  jmem_cpointer_t *empty_cpointer_p = NULL;
+  ecma_number_t float_num = ecma_get_float_from_value (num);
+  return lit_utf8_string_calc_hash ((const lit_utf8_byte_t *) &float_num, sizeof (ecma_number_t));
+} /* ecma_lit_storage_hash_number */
 
-  while (string_list_p != NULL)
+/**
+ * Calculate the index hash of a stored literal.
+ *
+ * @return hash of the literal
+ */
+static uint32_t
+ecma_lit_storage_hash (const ecma_string_t *literal_p) /**< literal string or number */
+{
+  if (ECMA_STRING_GET_CONTAINER (literal_p) == ECMA_STRING_LITERAL_NUMBER)
+  {
+    return ecma_lit_storage_hash_number (literal_p->u.lit_number);
+  }
+
+  return ecma_string_hash (literal_p);
+} /* ecma_lit_storage_hash */
+
+/**
+ * Insert a literal into the table of a literal storage index, which has a free entry.
+ */
+static void
+ecma_lit_storage_index_insert (ecma_lit_storage_index_t *index_p, /**< literal storage index */
+                               jmem_cpointer_t literal_cp) /**< literal */
+{
+  ecma_string_t *literal_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, literal_cp);
+  uint32_t entry_index = ecma_lit_storage_hash (literal_p) & index_p->mask;
+
+  while (index_p->table_p[entry_index] != JMEM_CP_NULL)
+  {
+    entry_index = (entry_index + 1) & index_p->mask;
+  }
+
+  index_p->table_p[entry_index] = literal_cp;
+} /* ecma_lit_storage_index_insert */
+
+/**
+ * Rebuild the table of a literal storage index with a size fitting the literals of the list.
+ *
+ * Note:
+ *      the table is freed if there is not enough memory, and the literals are searched
+ *      in the list until the table can be allocated again
+ */
+static void
+ecma_lit_storage_index_rebuild (ecma_lit_storage_index_t *index_p, /**< literal storage index */
+                                ecma_lit_storage_item_t *list_p) /**< literal storage list */
+{
+  uint32_t entry_count = ECMA_LIT_STORAGE_INDEX_MIN_SIZE;
+
+  while (index_p->count > entry_count - (entry_count >> 2))
+  {
+    entry_count <<= 1;
+  }
+
+  ecma_lit_storage_index_free (index_p);
+
+  size_t size_to_allocate = ECMA_LIT_STORAGE_INDEX_TABLE_SIZE (entry_count);
+  jmem_cpointer_t *table_p = (jmem_cpointer_t *) jmem_heap_alloc_block_null_on_error (size_to_allocate);
+
+  if (table_p == NULL)
+  {
+    return;
+  }
+
+  #ifdef PROF_COUNT__SIZE_DETAILED
+  profile_add_count_size_detailed(6, size_to_allocate); /* size detailed */
+  #endif
+
+  memset (table_p, 0, size_to_allocate);
+  JERRY_STATIC_ASSERT (JMEM_CP_NULL == 0, jmem_cp_null_must_be_zero);
+
+  index_p->table_p = table_p;
+  index_p->mask = entry_count - 1;
+
+  while (list_p != NULL)
   {
     for (int i = 0; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
     {
-      if (string_list_p->values[i] == JMEM_CP_NULL)
+      if (list_p->values[i] != JMEM_CP_NULL)
       {
-        if (empty_cpointer_p == NULL)
-        {
-          empty_cpointer_p = string_list_p->values + i;
-        }
+        ecma_lit_storage_index_insert (index_p, list_p->values[i]);
       }
-      else
-      {
-        ecma_string_t *value_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t,
-                                                               string_list_p->values[i]);
+    }
 
-        if (ecma_compare_ecma_strings (string_p, value_p))
-        {
-          /* Return with string if found in the list. */
-          ecma_deref_ecma_string (string_p);
-          return string_list_p->values[i];
-        }
+    list_p = JMEM_CP_GET_POINTER (ecma_lit_storage_item_t, list_p->next_cp);
+  }
+} /* ecma_lit_storage_index_rebuild */
+
+/**
+ * Append a new literal to a literal storage list, and insert it into the index of the list.
+ *
+ * Note:
+ *      literals are never removed from the list, so only its first item may have free values
+ */
+static void
+ecma_lit_storage_append (ecma_lit_storage_item_t **list_first_p, /**< [in,out] first item of the list */
+                         ecma_lit_storage_index_t *index_p, /**< index of the list */
+                         jmem_cpointer_t literal_cp) /**< new literal */
+{
+  ecma_lit_storage_item_t *item_p = *list_first_p;
+  int free_index = ECMA_LIT_STORAGE_VALUE_COUNT;
+
+  if (item_p != NULL)
+  {
+    for (int i = ECMA_LIT_STORAGE_VALUE_COUNT - 1; i >= 0 && item_p->values[i] == JMEM_CP_NULL; i--)
+    {
+      free_index = i;
+    }
+  }
+
+  if (free_index < ECMA_LIT_STORAGE_VALUE_COUNT)
+  {
+    item_p->values[free_index] = literal_cp;
+  }
+  else
+  {
+    size_t size_to_allocate = sizeof(ecma_lit_storage_item_t);
+    // Over-provision for full-bitwidth address overhead
+    #ifdef SEG_FULLBIT_ADDRESS_ALLOC
+    size_to_allocate += 8;
+    #endif
+    // profiling of full-bitwidth overhead
+    add_full_bitwidth_size(8);
+
+    #ifdef PROF_COUNT__SIZE_DETAILED
+    profile_add_count_size_detailed(6, size_to_allocate); /* size detailed */
+    #endif
+
+    ecma_lit_storage_item_t *new_item_p;
+    new_item_p = (ecma_lit_storage_item_t *) jmem_pools_alloc (size_to_allocate);
+
+    new_item_p->values[0] = literal_cp;
+    for (int i = 1; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
+    {
+      new_item_p->values[i] = JMEM_CP_NULL;
+    }
+
+    JMEM_CP_SET_POINTER (new_item_p->next_cp, *list_first_p);
+    *list_first_p = new_item_p;
+  }
+
+  index_p->count++;
+
+  if (index_p->table_p == NULL
+      || index_p->count > index_p->mask + 1 - ((index_p->mask + 1) >> 2))
+  {
+    ecma_lit_storage_index_rebuild (index_p, *list_first_p);
+    return;
+  }
+
+  ecma_lit_storage_index_insert (index_p, literal_cp);
+} /* ecma_lit_storage_append */
+
+/**
+ * Find a string in the table of a literal storage index.
+ *
+ * @return index of the equal string in the table - if found,
+ *         index of the free entry where the search stopped - otherwise
+ */
+static uint32_t
+ecma_lit_storage_index_find_string (const ecma_lit_storage_index_t *index_p, /**< literal storage index */
+                                    const ecma_string_t *string_p) /**< string to be searched */
+{
+  JERRY_ASSERT (index_p->table_p != NULL);
+
+  uint32_t entry_index = ecma_string_hash (string_p) & index_p->mask;
+
+  while (index_p->table_p[entry_index] != JMEM_CP_NULL)
+  {
+    ecma_string_t *value_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t,
+                                                           index_p->table_p[entry_index]);
+
+    if (ecma_compare_ecma_strings (string_p, value_p))
+    {
+      break;
+    }
+
+    entry_index = (entry_index + 1) & index_p->mask;
+  }
+
+  return entry_index;
+} /* ecma_lit_storage_index_find_string */
+
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+
+/**
+ * Remove an entry from the table of the property name intern index.
+ *
+ * The following entries of the probe sequence are moved back, so the
+ * table has no deleted entries.
+ */
+static void
+ecma_intern_index_remove (uint32_t entry_index) /**< index of the removed entry */
+{
+  ecma_lit_storage_index_t *index_p = &JERRY_CONTEXT (property_name_index);
+  uint32_t next_index = entry_index;
+
+  while (true)
+  {
+    next_index = (next_index + 1) & index_p->mask;
+
+    if (index_p->table_p[next_index] == JMEM_CP_NULL)
+    {
+      break;
+    }
+
+    ecma_string_t *value_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, index_p->table_p[next_index]);
+    uint32_t home_index = ecma_string_hash (value_p) & index_p->mask;
+
+    /* The entry stays if its home index is cyclically in (entry_index, next_index]. */
+    if (((next_index - home_index) & index_p->mask) < ((next_index - entry_index) & index_p->mask))
+    {
+      continue;
+    }
+
+    index_p->table_p[entry_index] = index_p->table_p[next_index];
+    entry_index = next_index;
+  }
+
+  index_p->table_p[entry_index] = JMEM_CP_NULL;
+  index_p->count--;
+} /* ecma_intern_index_remove */
+
+/**
+ * Insert a property name into the property name intern index.
+ *
+ * Note:
+ *      the name is not interned if there is not enough memory for the table
+ */
+static void
+ecma_intern_index_insert (ecma_string_t *name_p) /**< property name */
+{
+  ecma_lit_storage_index_t *index_p = &JERRY_CONTEXT (property_name_index);
+
+  if (index_p->table_p == NULL
+      || index_p->count >= index_p->mask + 1 - ((index_p->mask + 1) >> 2))
+  {
+    uint32_t entry_count = ((index_p->table_p == NULL) ? ECMA_PROPERTY_NAME_INTERN_MIN_SIZE
+                                                        : (index_p->mask + 1) << 1);
+    size_t size_to_allocate = ECMA_LIT_STORAGE_INDEX_TABLE_SIZE (entry_count);
+
+    /* The allocation may run a garbage collection, which removes entries from the old table. */
+    jmem_cpointer_t *table_p = (jmem_cpointer_t *) jmem_heap_alloc_block_null_on_error (size_to_allocate);
+
+    if (table_p == NULL)
+    {
+      return;
+    }
+
+    #ifdef PROF_COUNT__SIZE_DETAILED
+    profile_add_count_size_detailed(6, size_to_allocate); /* size detailed */
+    #endif
+
+    memset (table_p, 0, size_to_allocate);
+
+    ecma_lit_storage_index_t old_index = *index_p;
+
+    index_p->table_p = table_p;
+    index_p->mask = entry_count - 1;
+
+    for (uint32_t i = 0; old_index.table_p != NULL && i <= old_index.mask; i++)
+    {
+      if (old_index.table_p[i] != JMEM_CP_NULL)
+      {
+        ecma_lit_storage_index_insert (index_p, old_index.table_p[i]);
       }
     }
 
-    string_list_p = JMEM_CP_GET_POINTER (ecma_lit_storage_item_t, string_list_p->next_cp);
+    ecma_lit_storage_index_free (&old_index);
   }
 
-  jmem_cpointer_t result;
-  JMEM_CP_SET_NON_NULL_POINTER (result, string_p);
+  jmem_cpointer_t name_cp;
+  JMEM_CP_SET_NON_NULL_POINTER (name_cp, name_p);
+
+  ecma_ref_ecma_string (name_p);
+  ecma_lit_storage_index_insert (index_p, name_cp);
+  index_p->count++;
+} /* ecma_intern_index_insert */
 
-  if (empty_cpointer_p != NULL)
+/**
+ * Get the shared instance of a property name.
+ *
+ * Short names created at run-time, e.g. the keys of JSON.parse or the names passed
+ * by native code, are shared by the properties with the same name. The literals are
+ * shared first, and the other names are kept in a weak intern index, whose names
+ * are released by the garbage collector when no property refers to them.
+ *
+ * @return referenced string, which is equal to the property name
+ */
+ecma_string_t *
+ecma_intern_property_name (ecma_string_t *name_p) /**< property name */
+{
+  if (ECMA_STRING_GET_CONTAINER (name_p) != ECMA_STRING_CONTAINER_HEAP_UTF8_STRING
+      || ecma_string_get_size (name_p) > CONFIG_ECMA_PROPERTY_NAME_INTERN_MAX_SIZE)
   {
-    *empty_cpointer_p = result;
-    return result;
+    ecma_ref_ecma_string (name_p);
+    return name_p;
   }
 
-  size_t size_to_allocate = sizeof(ecma_lit_storage_item_t);
-  // Over-provision for full-bitwidth address overhead
-  #ifdef SEG_FULLBIT_ADDRESS_ALLOC
-  size_to_allocate += 8;
-  #endif
-  // profiling of full-bitwidth overhead
-  add_full_bitwidth_size(8);
-  
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(6, size_to_allocate); /* size detailed */
-  #endif
+  ecma_lit_storage_index_t *index_p = &JERRY_CONTEXT (string_index);
+  ecma_string_t *shared_p = NULL;
 
-  ecma_lit_storage_item_t *new_item_p;
-  new_item_p = (ecma_lit_storage_item_t *) jmem_pools_alloc (size_to_allocate);
+  if (index_p->table_p != NULL)
+  {
+    uint32_t entry_index = ecma_lit_storage_index_find_string (index_p, name_p);
 
-  new_item_p->values[0] = result;
-  for (int i = 1; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
+    if (index_p->table_p[entry_index] != JMEM_CP_NULL)
+    {
+      shared_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, index_p->table_p[entry_index]);
+    }
+  }
+
+  index_p = &JERRY_CONTEXT (property_name_index);
+
+  if (shared_p == NULL && index_p->table_p != NULL)
+  {
+    uint32_t entry_index = ecma_lit_storage_index_find_string (index_p, name_p);
+
+    if (index_p->table_p[entry_index] != JMEM_CP_NULL)
+    {
+      shared_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, index_p->table_p[entry_index]);
+    }
+  }
+
+  if (shared_p == NULL)
+  {
+    ecma_intern_index_insert (name_p);
+    shared_p = name_p;
+  }
+  else if (shared_p->refs_and_container >= ECMA_PROPERTY_NAME_INTERN_MAX_REF)
+  {
+    /* Leave enough references for the other users of the shared name. */
+    shared_p = name_p;
+  }
+
+  ecma_ref_ecma_string (shared_p);
+  return shared_p;
+} /* ecma_intern_property_name */
+
+/**
+ * Release the interned property names, which are referenced only by the intern index.
+ */
+void
+ecma_intern_gc_run (void)
+{
+  ecma_lit_storage_index_t *index_p = &JERRY_CONTEXT (property_name_index);
+
+  for (uint32_t i = 0; index_p->table_p != NULL && i <= index_p->mask; i++)
+  {
+    /* Removing an entry may move another one into its place. */
+    while (index_p->table_p[i] != JMEM_CP_NULL)
+    {
+      ecma_string_t *name_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, index_p->table_p[i]);
+
+      if (!ECMA_STRING_IS_REF_EQUALS_TO_ONE (name_p))
+      {
+        break;
+      }
+
+      ecma_intern_index_remove (i);
+      ecma_deref_ecma_string (name_p);
+    }
+  }
+} /* ecma_intern_gc_run */
+
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
+
+/**
+ * Find the literal string equal to a string, or make the string a literal.
+ *
+ * Note:
+ *      the reference of the string is taken over
+ *
+ * @return ecma_string_t compressed pointer
+ */
+static jmem_cpointer_t
+ecma_find_or_insert_literal_string (ecma_string_t *string_p) /**< string to be searched */
+{
+  ecma_lit_storage_index_t *index_p = &JERRY_CONTEXT (string_index);
+
+  if (index_p->table_p != NULL)
+  {
+    uint32_t entry_index = ecma_lit_storage_index_find_string (index_p, string_p);
+
+    if (index_p->table_p[entry_index] != JMEM_CP_NULL)
+    {
+      /* Return with string if found in the index. */
+      ecma_deref_ecma_string (string_p);
+      return index_p->table_p[entry_index];
+    }
+  }
+  else
+  {
+    ecma_lit_storage_item_t *string_list_p = JERRY_CONTEXT (string_list_first_p);
+
+    while (string_list_p != NULL)
+    {
+      for (int i = 0; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
+      {
+        if (string_list_p->values[i] != JMEM_CP_NULL)
+        {
+          ecma_string_t *value_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t,
+                                                                 string_list_p->values[i]);
+
+          if (ecma_compare_ecma_strings (string_p, value_p))
+          {
+            /* Return with string if found in the list. */
+            ecma_deref_ecma_string (string_p);
+            return string_list_p->values[i];
+          }
+        }
+      }
+
+      string_list_p = JMEM_CP_GET_POINTER (ecma_lit_storage_item_t, string_list_p->next_cp);
+    }
+  }
+
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+  ecma_lit_storage_index_t *intern_index_p = &JERRY_CONTEXT (property_name_index);
+
+  if (intern_index_p->table_p != NULL)
   {
-    new_item_p->values[i] = JMEM_CP_NULL;
+    uint32_t entry_index = ecma_lit_storage_index_find_string (intern_index_p, string_p);
+
+    if (intern_index_p->table_p[entry_index] != JMEM_CP_NULL)
+    {
+      /* The interned property name becomes the literal, and the reference
+       * of the intern index is passed to the literal storage. */
+      ecma_deref_ecma_string (string_p);
+      string_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, intern_index_p->table_p[entry_index]);
+      ecma_intern_index_remove (entry_index);
+    }
   }
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
 
-  JMEM_CP_SET_POINTER (new_item_p->next_cp, JERRY_CONTEXT (string_list_first_p));
-  JERRY_CONTEXT (string_list_first_p) = new_item_p;
+  jmem_cpointer_t result;
+  JMEM_CP_SET_NON_NULL_POINTER (result, string_p);
 
+  ecma_lit_storage_append (&JERRY_CONTEXT (string_list_first_p), index_p, result);
   return result;
+} /* ecma_find_or_insert_literal_string */
+
+/**
+ * Find or create a literal string.
+ *
+ * @return ecma_string_t compressed pointer
+ */
+jmem_cpointer_t
+ecma_find_or_create_literal_string (const lit_utf8_byte_t *chars_p, /**< string to be searched */
+                                    lit_utf8_size_t size) /**< size of the string */
+{
+  return ecma_find_or_insert_literal_string (ecma_new_ecma_string_from_utf8 (chars_p, size));
 } /* ecma_find_or_create_literal_string */
 
+/**
+ * Check whether a literal number is equal to a number value.
+ *
+ * @return true - if the numbers are equal,
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+ecma_lit_storage_number_equals (const ecma_string_t *value_p, /**< literal number */
+                                ecma_value_t num) /**< number value */
+{
+  JERRY_ASSERT (ECMA_STRING_GET_CONTAINER (value_p) == ECMA_STRING_LITERAL_NUMBER);
+
+  if (ecma_is_value_integer_number (num))
+  {
+    return value_p->u.lit_number == num;
+  }
+
+  return (ecma_is_value_float_number (value_p->u.lit_number)
+          && ecma_get_float_from_value (value_p->u.lit_number) == ecma_get_float_from_value (num));
+} /* ecma_lit_storage_number_equals */
+
 /**
  * Find or create a literal number.
  *
@@ -160,48 +632,49 @@ jmem_cpointer_t
 ecma_find_or_create_literal_number (ecma_number_t number_arg) /**< number to be searched */
 {
   ecma_value_t num = ecma_make_number_value (number_arg);
+  ecma_lit_storage_index_t *index_p = &JERRY_CONTEXT (number_index);
 
-  ecma_lit_storage_item_t *number_list_p = JERRY_CONTEXT (number_list_first_p);
-  jmem_cpointer_t *empty_cpointer_p = NULL;
-
-  while (number_list_p != NULL)
+  if (index_p->table_p != NULL)
   {
-    for (int i = 0; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
+    uint32_t entry_index = ecma_lit_storage_hash_number (num) & index_p->mask;
+
+    while (index_p->table_p[entry_index] != JMEM_CP_NULL)
     {
-      if (number_list_p->values[i] == JMEM_CP_NULL)
+      ecma_string_t *value_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t,
+                                                             index_p->table_p[entry_index]);
+
+      if (ecma_lit_storage_number_equals (value_p, num))
       {
-        if (empty_cpointer_p == NULL)
-        {
-          empty_cpointer_p = number_list_p->values + i;
-        }
+        ecma_free_value (num);
+        return index_p->table_p[entry_index];
       }
-      else
-      {
-        ecma_string_t *value_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t,
-                                                               number_list_p->values[i]);
 
-        JERRY_ASSERT (ECMA_STRING_GET_CONTAINER (value_p) == ECMA_STRING_LITERAL_NUMBER);
+      entry_index = (entry_index + 1) & index_p->mask;
+    }
+  }
+  else
+  {
+    ecma_lit_storage_item_t *number_list_p = JERRY_CONTEXT (number_list_first_p);
 
-        if (ecma_is_value_integer_number (num))
-        {
-          if (value_p->u.lit_number == num)
-          {
-            return number_list_p->values[i];
-          }
-        }
-        else
+    while (number_list_p != NULL)
+    {
+      for (int i = 0; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
+      {
+        if (number_list_p->values[i] != JMEM_CP_NULL)
         {
-          if (ecma_is_value_float_number (value_p->u.lit_number)
-              && ecma_get_float_from_value (value_p->u.lit_number) == ecma_get_float_from_value (num))
+          ecma_string_t *value_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t,
+                                                                 number_list_p->values[i]);
+
+          if (ecma_lit_storage_number_equals (value_p, num))
           {
             ecma_free_value (num);
             return number_list_p->values[i];
           }
         }
       }
-    }
 
-    number_list_p = JMEM_CP_GET_POINTER (ecma_lit_storage_item_t, number_list_p->next_cp);
+      number_list_p = JMEM_CP_GET_POINTER (ecma_lit_storage_item_t, number_list_p->next_cp);
+    }
   }
 
   ecma_string_t *string_p = ecma_alloc_string ();
@@ -211,36 +684,7 @@ ecma_find_or_create_literal_number (ecma_number_t number_arg) /**< number to be
   jmem_cpointer_t result;
   JMEM_CP_SET_NON_NULL_POINTER (result, string_p);
 
-  if (empty_cpointer_p != NULL)
-  {
-    *empty_cpointer_p = result;
-    return result;
-  }
-
-  size_t size_to_allocate = sizeof(ecma_lit_storage_item_t);
-  // Over-provision for full-bitwidth address overhead
-  #ifdef SEG_FULLBIT_ADDRESS_ALLOC
-  size_to_allocate += 8;
-  #endif
-  // profiling of full-bitwidth overhead
-  add_full_bitwidth_size(8);
-
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(6, size_to_allocate); /* size detailed */
-  #endif
-
-  ecma_lit_storage_item_t *new_item_p;
-  new_item_p = (ecma_lit_storage_item_t *) jmem_pools_alloc (size_to_allocate);
-
-  new_item_p->values[0] = result;
-  for (int i = 1; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
-  {
-    new_item_p->values[i] = JMEM_CP_NULL;
-  }
-
-  JMEM_CP_SET_POINTER (new_item_p->next_cp, JERRY_CONTEXT (number_list_first_p));
-  JERRY_CONTEXT (number_list_first_p) = new_item_p;
-
+  ecma_lit_storage_append (&JERRY_CONTEXT (number_list_first_p), index_p, result);
   return result;
 } /* ecma_find_or_create_literal_number */
 
@@ -434,156 +878,95 @@ ecma_save_literals_for_snapshot (uint32_t *buffer_p, /**< [out] output snapshot
 #ifdef JERRY_ENABLE_SNAPSHOT_EXEC
 
 /**
- * Helper function for ecma_load_literals_from_snapshot.
+ * Check the literal table of a snapshot, and prepare it for ecma_snapshot_get_literal.
  *
- * Note: always inline because it is used only once.
+ * Note:
+ *      the literals are not created here, only when the loaded byte code refers to them,
+ *      so the literals of a snapshot which holds several modules are created only for
+ *      the modules which are run.
  *
- * @return true - if load was performed successfully
- *         false - otherwise (i.e. buffer length is incorrect)
+ * @return true - if the literal table is consistent,
+ *         false - otherwise (i.e. snapshot is incorrect)
  */
-static inline bool __attr_always_inline___
-ecma_load_literals_from_buffer (const uint16_t *buffer_p, /**< buffer with literal table in snapshot */
-                                uint32_t lit_table_size, /**< size of literal table in snapshot */
-                                lit_mem_to_snapshot_id_map_entry_t *map_p, /**< literal map */
-                                uint32_t string_count, /**< number of strings */
-                                uint32_t number_count) /**< number of numbers */
+bool
+ecma_snapshot_literal_table_init (ecma_snapshot_literal_table_t *table_p, /**< [out] literal table */
+                                  const uint32_t *buffer_p, /**< buffer with literal table in snapshot */
+                                  uint32_t lit_table_size, /**< size of literal table in snapshot */
+                                  bool is_in_place) /**< the snapshot outlives the literals, so long strings
+                                                     *   may refer to its characters */
 {
+  if (lit_table_size < 2 * sizeof (uint32_t))
+  {
+    return false;
+  }
+
+  uint32_t string_count = buffer_p[0];
+  uint32_t number_count = buffer_p[1];
+
   /* The zero value is reserved for NULL (no literal)
    * constant so the first literal must have offset one. */
+  const uint8_t *literal_base_p = ((const uint8_t *) (buffer_p + 2)) - JERRY_SNAPSHOT_LITERAL_ALIGNMENT;
+  uint32_t literal_end = (uint32_t) (lit_table_size + JERRY_SNAPSHOT_LITERAL_ALIGNMENT - 2 * sizeof (uint32_t));
   uint32_t literal_offset = JERRY_SNAPSHOT_LITERAL_ALIGNMENT;
 
-  /* Load strings first. */
   while (string_count > 0)
   {
-    if (lit_table_size < literal_offset + sizeof (uint32_t))
+    if (literal_end < literal_offset + sizeof (uint32_t))
     {
-      /* Buffer is not sufficent. */
       return false;
     }
 
-    lit_utf8_size_t length = *buffer_p;
-    lit_utf8_size_t aligned_length = JERRY_ALIGNUP (sizeof (uint16_t) + length,
-                                                    JERRY_SNAPSHOT_LITERAL_ALIGNMENT);
+    const uint16_t *length_p = (const uint16_t *) (literal_base_p + literal_offset);
+    literal_offset += (uint32_t) JERRY_ALIGNUP (sizeof (uint16_t) + *length_p, JERRY_SNAPSHOT_LITERAL_ALIGNMENT);
 
-    if (lit_table_size < literal_offset + aligned_length)
+    if (literal_end < literal_offset)
     {
-      /* Buffer is not sufficent. */
       return false;
     }
 
-    map_p->literal_id = ecma_find_or_create_literal_string (((lit_utf8_byte_t *) buffer_p) + sizeof (uint16_t), length);
-    map_p->literal_offset = (jmem_cpointer_t) (literal_offset >> JERRY_SNAPSHOT_LITERAL_ALIGNMENT_LOG);
-    map_p++;
-
-    JERRY_ASSERT ((aligned_length % sizeof (uint16_t)) == 0);
-    buffer_p += aligned_length / sizeof (uint16_t);
-    literal_offset += aligned_length;
-
     string_count--;
   }
 
-  /* Load numbers. */
-  while (number_count > 0)
-  {
-    if (lit_table_size < literal_offset + sizeof (ecma_number_t))
-    {
-      /* Buffer is not sufficent. */
-      return false;
-    }
+  table_p->literal_base_p = literal_base_p;
+  table_p->number_offset = literal_offset;
+  table_p->is_in_place = is_in_place;
 
-    ecma_number_t num;
-    memcpy (&num, buffer_p, sizeof (ecma_number_t));
-
-    map_p->literal_id = ecma_find_or_create_literal_number (num);
-    map_p->literal_offset = (jmem_cpointer_t) (literal_offset >> JERRY_SNAPSHOT_LITERAL_ALIGNMENT_LOG);
-    map_p++;
-
-    ecma_length_t length = JERRY_ALIGNUP (sizeof (ecma_number_t),
-                                          JERRY_SNAPSHOT_LITERAL_ALIGNMENT);
-
-    JERRY_ASSERT ((length % sizeof (uint16_t)) == 0);
-    buffer_p += length / sizeof (uint16_t);
-    literal_offset += length;
-
-    number_count--;
-  }
+  uint32_t number_size = (uint32_t) JERRY_ALIGNUP (sizeof (ecma_number_t), JERRY_SNAPSHOT_LITERAL_ALIGNMENT);
 
-  return (lit_table_size == (literal_offset + 2 * sizeof (uint32_t) - JERRY_SNAPSHOT_LITERAL_ALIGNMENT));
-} /* ecma_load_literals_from_buffer */
+  return (literal_end - literal_offset == number_count * number_size);
+} /* ecma_snapshot_literal_table_init */
 
 /**
- * Load literals from snapshot.
+ * Find or create the literal at an offset of the literal table of a snapshot.
  *
- * @return true - if load was performed successfully (i.e. literals saved in the snapshot are consistent),
- *         false - otherwise (i.e. snapshot is incorrect)
+ * @return ecma_string_t compressed pointer
  */
-bool
-ecma_load_literals_from_snapshot (const uint32_t *buffer_p, /**< buffer with literal table in snapshot */
-                                  uint32_t lit_table_size, /**< size of literal table in snapshot */
-                                  lit_mem_to_snapshot_id_map_entry_t **out_map_p, /**< [out] map from literal offsets
-                                                                                   *   in snapshot to identifiers
-                                                                                   *   of loaded literals in literal
-                                                                                   *   storage */
-                                  uint32_t *out_map_len_p) /**< [out] literals number */
+jmem_cpointer_t
+ecma_snapshot_get_literal (const ecma_snapshot_literal_table_t *table_p, /**< literal table */
+                           jmem_cpointer_t literal_offset) /**< offset of the literal in the table */
 {
-  *out_map_p = NULL;
+  uint32_t offset = ((uint32_t) literal_offset) << JERRY_SNAPSHOT_LITERAL_ALIGNMENT_LOG;
+  const uint8_t *literal_p = table_p->literal_base_p + offset;
 
-  if (lit_table_size < 2 * sizeof (uint32_t))
+  if (offset >= table_p->number_offset)
   {
-    /* Buffer is not sufficent. */
-    return false;
-  }
-
-  uint32_t string_count = buffer_p[0];
-  uint32_t number_count = buffer_p[1];
-  buffer_p += 2;
-
-  uint32_t total_count = string_count + number_count;
-  lit_mem_to_snapshot_id_map_entry_t *map_p;
-
-  *out_map_len_p = total_count;
+    ecma_number_t num;
+    memcpy (&num, literal_p, sizeof (ecma_number_t));
 
-  if (total_count == 0)
-  {
-    return true;
+    return ecma_find_or_create_literal_number (num);
   }
 
-  size_t size_to_allocate = total_count * sizeof (lit_mem_to_snapshot_id_map_entry_t);
-  // Over-provision for full-bitwidth address overhead
-  #ifdef SEG_FULLBIT_ADDRESS_ALLOC
-  size_to_allocate += total_count * 4;
-  #endif
-  // profiling of full-bitwidth overhead
-  add_full_bitwidth_size(total_count * 4);
-
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(13, size_to_allocate); /* size detailed */
-  #endif
+  lit_utf8_size_t length = *(const uint16_t *) literal_p;
+  const lit_utf8_byte_t *chars_p = literal_p + sizeof (uint16_t);
 
-  map_p = jmem_heap_alloc_block (size_to_allocate);
-  *out_map_p = map_p;
-
-  if (ecma_load_literals_from_buffer ((uint16_t *) buffer_p, lit_table_size, map_p, string_count, number_count))
+  if (table_p->is_in_place)
   {
-    return true;
+    /* Long strings refer to the characters in the snapshot, e.g. in ROM. */
+    return ecma_find_or_insert_literal_string (ecma_new_ecma_external_string (chars_p, length, NULL));
   }
 
-  size_t size_to_free = size_to_allocate;
-  // Over-provision for full-bitwidth address overhead
-  #ifdef SEG_FULLBIT_ADDRESS_ALLOC
-  size_to_free += total_count * 4;
-  #endif
-  // profiling of full-bitwidth overhead
-  sub_full_bitwidth_size(total_count * 4);
-
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(13, -size_to_free); /* size detailed */
-  #endif
-
-  jmem_heap_free_block (map_p, size_to_free);
-  *out_map_p = NULL;
-  return false;
-} /* ecma_load_literals_from_snapshot */
+  return ecma_find_or_create_literal_string (chars_p, length);
+} /* ecma_snapshot_get_literal */
 
 #endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
 
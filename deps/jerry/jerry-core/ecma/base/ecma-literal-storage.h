@@ -36,11 +36,26 @@ typedef struct
   jmem_cpointer_t literal_offset; /**< literal offset */
 } lit_mem_to_snapshot_id_map_entry_t;
 
+/**
+ * Literal table of a snapshot, whose literals are created when the byte code refers to them
+ */
+typedef struct
+{
+  const uint8_t *literal_base_p; /**< start of the literals, minus the offset of the first one */
+  uint32_t number_offset; /**< offset of the first number, after the strings */
+  bool is_in_place; /**< long strings may refer to the characters in the snapshot */
+} ecma_snapshot_literal_table_t;
+
 void ecma_finalize_lit_storage (void);
 
 jmem_cpointer_t ecma_find_or_create_literal_string (const lit_utf8_byte_t *chars_p, lit_utf8_size_t size);
 jmem_cpointer_t ecma_find_or_create_literal_number (ecma_number_t number_arg);
 
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+ecma_string_t *ecma_intern_property_name (ecma_string_t *name_p);
+void ecma_intern_gc_run (void);
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
+
 #ifdef JERRY_ENABLE_SNAPSHOT_SAVE
 bool
 ecma_save_literals_for_snapshot (uint32_t *, size_t, size_t *,
@@ -48,9 +63,10 @@ ecma_save_literals_for_snapshot (uint32_t *, size_t, size_t *,
 #endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
 
 #ifdef JERRY_ENABLE_SNAPSHOT_EXEC
-bool
-ecma_load_literals_from_snapshot (const uint32_t *, uint32_t,
-                                  lit_mem_to_snapshot_id_map_entry_t **, uint32_t *);
+bool ecma_snapshot_literal_table_init (ecma_snapshot_literal_table_t *table_p, const uint32_t *buffer_p,
+                                       uint32_t lit_table_size, bool is_in_place);
+jmem_cpointer_t ecma_snapshot_get_literal (const ecma_snapshot_literal_table_t *table_p,
+                                           jmem_cpointer_t literal_offset);
 #endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
 
 /**
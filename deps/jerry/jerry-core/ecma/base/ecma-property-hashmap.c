@@ -41,7 +41,17 @@
  * Compute the total size of the property hashmap.
  */
 #define ECMA_PROPERTY_HASHMAP_GET_TOTAL_SIZE(max_property_count) \
-  (sizeof (ecma_property_hashmap_t) + (max_property_count * sizeof (jmem_cpointer_t)) + (max_property_count >> 3))
+  (sizeof (ecma_property_hashmap_t) + (max_property_count * sizeof (jmem_cpointer_t)) + (max_property_count >> 3) \
+   + max_property_count)
+
+/**
+ * Get the tag of a property name hash.
+ *
+ * The tag is taken from the upper bits of a multiplicative hash, so it differs for most
+ * names which are mapped to the same entry index.
+ */
+#define ECMA_PROPERTY_HASHMAP_GET_TAG(hash) \
+  ((uint8_t) (((uint32_t) (hash) * 2654435769u) >> 24))
 
 /**
  * Number of items in the stepping table.
@@ -117,7 +127,7 @@ ecma_property_hashmap_create (ecma_object_t *object_p) /**< object */
                                     prop_iter_p->next_property_cp);
   }
 
-  if (named_property_count < (ECMA_PROPERTY_HASMAP_MINIMUM_SIZE / 2))
+  if (named_property_count < ECMA_PROPERTY_HASHMAP_MIN_PROPERTY_COUNT)
   {
     return;
   }
@@ -162,6 +172,7 @@ ecma_property_hashmap_create (ecma_object_t *object_p) /**< object */
 
   jmem_cpointer_t *pair_list_p = (jmem_cpointer_t *) (hashmap_p + 1);
   uint8_t *bits_p = (uint8_t *) (pair_list_p + max_property_count);
+  uint8_t *tags_p = bits_p + (max_property_count >> 3);
   uint32_t mask = max_property_count - 1;
 
   uint8_t shift_counter = 0;
@@ -199,6 +210,7 @@ ecma_property_hashmap_create (ecma_object_t *object_p) /**< object */
 
       uint32_t entry_index = ecma_string_get_property_name_hash (prop_iter_p->types[i],
                                                                  property_pair_p->names_cp[i]);
+      uint8_t tag = ECMA_PROPERTY_HASHMAP_GET_TAG (entry_index);
       uint32_t step = ecma_property_hashmap_steps[entry_index & (ECMA_PROPERTY_HASHMAP_NUMBER_OF_STEPS - 1)];
 
       if (mask < LIT_STRING_HASH_LIMIT)
@@ -231,6 +243,7 @@ ecma_property_hashmap_create (ecma_object_t *object_p) /**< object */
       }
 
       ECMA_SET_POINTER (pair_list_p[entry_index], property_pair_p);
+      tags_p[entry_index] = tag;
 
       if (i != 0)
       {
@@ -307,6 +320,7 @@ ecma_property_hashmap_insert (ecma_object_t *object_p, /**< object */
   JERRY_ASSERT (property_index < ECMA_PROPERTY_PAIR_ITEM_COUNT);
 
   uint32_t entry_index = name_p->hash;
+  uint8_t tag = ECMA_PROPERTY_HASHMAP_GET_TAG (entry_index);
   uint32_t step = ecma_property_hashmap_steps[entry_index & (ECMA_PROPERTY_HASHMAP_NUMBER_OF_STEPS - 1)];
   uint32_t mask = hashmap_p->max_property_count - 1;
 
@@ -338,6 +352,9 @@ ecma_property_hashmap_insert (ecma_object_t *object_p, /**< object */
   ECMA_SET_POINTER (pair_list_p[entry_index], property_pair_p);
 
   uint8_t *bits_p = (uint8_t *) (pair_list_p + hashmap_p->max_property_count);
+  uint8_t *tags_p = bits_p + (hashmap_p->max_property_count >> 3);
+  tags_p[entry_index] = tag;
+
   bits_p += (entry_index >> 3);
   mask = (uint32_t) (1 << (entry_index & 0x7));
 
@@ -394,10 +411,12 @@ ecma_property_hashmap_delete (ecma_object_t *object_p, /**< object */
   }
 
   uint32_t entry_index = ecma_string_get_property_name_hash (*property_p, name_cp);
+  uint8_t tag = ECMA_PROPERTY_HASHMAP_GET_TAG (entry_index);
   uint32_t step = ecma_property_hashmap_steps[entry_index & (ECMA_PROPERTY_HASHMAP_NUMBER_OF_STEPS - 1)];
   uint32_t mask = hashmap_p->max_property_count - 1;
   jmem_cpointer_t *pair_list_p = (jmem_cpointer_t *) (hashmap_p + 1);
   uint8_t *bits_p = (uint8_t *) (pair_list_p + hashmap_p->max_property_count);
+  uint8_t *tags_p = bits_p + (hashmap_p->max_property_count >> 3);
 
   if (mask < LIT_STRING_HASH_LIMIT)
   {
@@ -416,7 +435,12 @@ ecma_property_hashmap_delete (ecma_object_t *object_p, /**< object */
 
   while (true)
   {
-    if (pair_list_p[entry_index] != ECMA_NULL_POINTER)
+    if (pair_list_p[entry_index] == ECMA_NULL_POINTER)
+    {
+      /* Must be a deleted entry. */
+      JERRY_ASSERT (ECMA_PROPERTY_HASHMAP_GET_BIT (bits_p, entry_index));
+    }
+    else if (tags_p[entry_index] == tag)
     {
       size_t offset = 0;
 
@@ -437,11 +461,6 @@ ecma_property_hashmap_delete (ecma_object_t *object_p, /**< object */
         return ECMA_PROPERTY_HASHMAP_DELETE_HAS_HASHMAP;
       }
     }
-    else
-    {
-      /* Must be a deleted entry. */
-      JERRY_ASSERT (ECMA_PROPERTY_HASHMAP_GET_BIT (bits_p, entry_index));
-    }
 
     entry_index = (entry_index + step) & mask;
 
@@ -503,10 +522,12 @@ ecma_property_hashmap_find (ecma_property_hashmap_t *hashmap_p, /**< hashmap */
 #endif /* !JERRY_NDEBUG */
 
   uint32_t entry_index = name_p->hash;
+  uint8_t tag = ECMA_PROPERTY_HASHMAP_GET_TAG (entry_index);
   uint32_t step = ecma_property_hashmap_steps[entry_index & (ECMA_PROPERTY_HASHMAP_NUMBER_OF_STEPS - 1)];
   uint32_t mask = hashmap_p->max_property_count - 1;
   jmem_cpointer_t *pair_list_p = (jmem_cpointer_t *) (hashmap_p + 1);
   uint8_t *bits_p = (uint8_t *) (pair_list_p + hashmap_p->max_property_count);
+  uint8_t *tags_p = bits_p + (hashmap_p->max_property_count >> 3);
 
   if (mask < LIT_STRING_HASH_LIMIT)
   {
@@ -525,8 +546,20 @@ ecma_property_hashmap_find (ecma_property_hashmap_t *hashmap_p, /**< hashmap */
 
   while (true)
   {
-    if (pair_list_p[entry_index] != ECMA_NULL_POINTER)
+    if (pair_list_p[entry_index] == ECMA_NULL_POINTER)
     {
+      if (!ECMA_PROPERTY_HASHMAP_GET_BIT (bits_p, entry_index))
+      {
+#ifndef JERRY_NDEBUG
+        JERRY_ASSERT (!property_found);
+#endif /* !JERRY_NDEBUG */
+        return NULL;
+      }
+      /* Otherwise it is a deleted entry. */
+    }
+    else if (tags_p[entry_index] == tag)
+    {
+      /* The property pair is decompressed only if the tag matches. */
       size_t offset = 0;
       if (ECMA_PROPERTY_HASHMAP_GET_BIT (bits_p, entry_index))
       {
@@ -551,17 +584,6 @@ ecma_property_hashmap_find (ecma_property_hashmap_t *hashmap_p, /**< hashmap */
         return property_p;
       }
     }
-    else
-    {
-      if (!ECMA_PROPERTY_HASHMAP_GET_BIT (bits_p, entry_index))
-      {
-#ifndef JERRY_NDEBUG
-        JERRY_ASSERT (!property_found);
-#endif /* !JERRY_NDEBUG */
-        return NULL;
-      }
-      /* Otherwise it is a deleted entry. */
-    }
 
     entry_index = (entry_index + step) & mask;
 
@@ -28,6 +28,11 @@
  */
 #define ECMA_PROPERTY_HASMAP_MINIMUM_SIZE 32
 
+/**
+ * Minimum number of named properties of an object having a property hashmap.
+ */
+#define ECMA_PROPERTY_HASHMAP_MIN_PROPERTY_COUNT CONFIG_ECMA_PROPERTY_HASHMAP_MIN_PROPERTIES
+
 /**
  * Property hash.
  */
@@ -40,8 +45,10 @@ typedef struct
 
   /*
    * The hash is followed by max_property_count ecma_cpointer_t
-   * compressed pointers and (max_property_count + 7) / 8 bytes
-   * which stores a flag for each compressed pointer.
+   * compressed pointers, (max_property_count + 7) / 8 bytes
+   * which stores a flag for each compressed pointer and
+   * max_property_count bytes which store a tag of the name
+   * hash for each compressed pointer.
    *
    * If the compressed pointer is equal to ECMA_NULL_POINTER
    *   - flag is cleared if the entry is NULL
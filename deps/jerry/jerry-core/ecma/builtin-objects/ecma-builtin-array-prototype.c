@@ -73,6 +73,110 @@ ecma_builtin_array_prototype_helper_set_length (ecma_object_t *object, /**< obje
   return ret_value;
 } /* ecma_builtin_array_prototype_helper_set_length */
 
+/**
+ * Helper function to search an element of an object
+ *
+ * Note:
+ *      the existing elements of fast arrays are read without creating their names
+ *
+ * @return ecma value (return value of ecma_op_object_find)
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_array_prototype_helper_find_element (ecma_object_t *object_p, /**< object */
+                                                  uint32_t index) /**< element index */
+{
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  if (ecma_op_array_is_fast_array (object_p))
+  {
+    ecma_value_t element = ecma_fast_array_get_element (object_p, index);
+
+    if (!ecma_is_value_array_hole (element))
+    {
+      return ecma_fast_copy_value (element);
+    }
+  }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
+  ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
+  ecma_value_t ret_value = ecma_op_object_find (object_p, index_str_p);
+  ecma_deref_ecma_string (index_str_p);
+
+  return ret_value;
+} /* ecma_builtin_array_prototype_helper_find_element */
+
+/**
+ * Helper function to append an element to an array created by a routine
+ *
+ * Note:
+ *      the index must not be less than the length of the array
+ */
+static void
+ecma_builtin_array_prototype_helper_append_element (ecma_object_t *array_p, /**< array */
+                                                    uint32_t index, /**< element index */
+                                                    ecma_value_t value) /**< element value */
+{
+  JERRY_ASSERT (ecma_get_object_type (array_p) == ECMA_OBJECT_TYPE_ARRAY);
+  JERRY_ASSERT (index >= ((ecma_extended_object_t *) array_p)->u.array.length);
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  ecma_extended_object_t *ext_array_p = (ecma_extended_object_t *) array_p;
+
+  if (ext_array_p->u.array.is_fast
+      && ecma_fast_array_add_element (array_p, index, value))
+  {
+    ext_array_p->u.array.length = index + 1;
+    return;
+  }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
+  ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
+
+  /* This will always be a simple value since 'is_throw' is false, so no need to free. */
+  ecma_value_t put_comp = ecma_builtin_helper_def_prop (array_p,
+                                                        index_str_p,
+                                                        value,
+                                                        true, /* Writable */
+                                                        true, /* Enumerable */
+                                                        true, /* Configurable */
+                                                        false);
+  JERRY_ASSERT (ecma_is_value_true (put_comp));
+
+  ecma_deref_ecma_string (index_str_p);
+} /* ecma_builtin_array_prototype_helper_append_element */
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+
+/**
+ * Helper function to check whether the prototype chain of an object has an element
+ *
+ * Note:
+ *      new elements must not be stored in the elements buffer of a fast array
+ *      while an inherited element (e.g. a setter) could intercept them
+ *
+ * @return true - if the element is inherited,
+ *         false - otherwise
+ */
+static bool
+ecma_builtin_array_prototype_helper_has_inherited_element (ecma_object_t *object_p, /**< object */
+                                                           uint32_t index) /**< element index */
+{
+  ecma_object_t *proto_p = ecma_get_object_prototype (object_p);
+
+  if (proto_p == NULL)
+  {
+    return false;
+  }
+
+  ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
+  bool has_element = ecma_op_object_has_property (proto_p, index_str_p);
+  ecma_deref_ecma_string (index_str_p);
+
+  return has_element;
+} /* ecma_builtin_array_prototype_helper_has_inherited_element */
+
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
 /**
  * The Array.prototype object's 'toString' routine
  *
@@ -562,9 +666,29 @@ ecma_builtin_array_prototype_object_push (ecma_value_t this_arg, /**< this argum
   ECMA_OP_TO_NUMBER_TRY_CATCH (length_var, length_value, ret_value);
 
   ecma_number_t n = ((ecma_number_t) ecma_number_to_uint32 (length_var));
+  uint32_t index = 0;
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  /* The new elements of fast arrays are stored in the elements buffer while no setter can intercept them. */
+  ecma_extended_object_t *ext_obj_p = (ecma_extended_object_t *) obj_p;
+
+  while (index < arguments_number
+         && ecma_op_array_is_fast_array (obj_p)
+         && (ecma_number_t) ext_obj_p->u.array.length == n
+         && ext_obj_p->u.array.length < UINT32_MAX
+         && ecma_is_property_writable (ext_obj_p->u.array.length_prop)
+         && ecma_get_object_extensible (obj_p)
+         && !ecma_builtin_array_prototype_helper_has_inherited_element (obj_p, ext_obj_p->u.array.length)
+         && ecma_fast_array_add_element (obj_p, ext_obj_p->u.array.length, argument_list_p[index]))
+  {
+    ext_obj_p->u.array.length++;
+    index++;
+    n++;
+  }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
 
   /* 5. */
-  for (uint32_t index = 0;
+  for (;
        index < arguments_number && ecma_is_value_empty (ret_value);
        index++, n++)
   {
@@ -881,34 +1005,16 @@ ecma_builtin_array_prototype_object_slice (ecma_value_t this_arg, /**< 'this' ar
   /* 10. */
   for (uint32_t k = start; k < end && ecma_is_value_empty (ret_value); k++, n++)
   {
-    /* 10.a */
-    ecma_string_t *curr_idx_str_p = ecma_new_ecma_string_from_uint32 (k);
-
-    /* 10.c */
-    ECMA_TRY_CATCH (get_value, ecma_op_object_find (obj_p, curr_idx_str_p), ret_value);
+    /* 10.a - 10.c */
+    ECMA_TRY_CATCH (get_value, ecma_builtin_array_prototype_helper_find_element (obj_p, k), ret_value);
 
     if (ecma_is_value_found (get_value))
     {
-      /* 10.c.i */
-      ecma_string_t *to_idx_str_p = ecma_new_ecma_string_from_uint32 (n);
-
-      /* 10.c.ii */
-      /* This will always be a simple value since 'is_throw' is false, so no need to free. */
-      ecma_value_t put_comp = ecma_builtin_helper_def_prop (new_array_p,
-                                                            to_idx_str_p,
-                                                            get_value,
-                                                            true, /* Writable */
-                                                            true, /* Enumerable */
-                                                            true, /* Configurable */
-                                                            false);
-      JERRY_ASSERT (ecma_is_value_true (put_comp));
-
-      ecma_deref_ecma_string (to_idx_str_p);
+      /* 10.c.i - 10.c.ii */
+      ecma_builtin_array_prototype_helper_append_element (new_array_p, n, get_value);
     }
 
     ECMA_FINALIZE (get_value);
-
-    ecma_deref_ecma_string (curr_idx_str_p);
   }
 
   if (ecma_is_value_empty (ret_value))
@@ -973,7 +1079,42 @@ ecma_builtin_array_prototype_object_sort_compare_helper (ecma_value_t j, /**< le
     }
     else
     {
-      if (ecma_is_value_undefined (comparefn))
+      if (ecma_is_value_undefined (comparefn)
+          && ecma_is_value_integer_number (j)
+          && ecma_is_value_integer_number (k))
+      {
+        /* Default comparison of integers, which compares their decimal forms without creating strings. */
+        lit_utf8_byte_t j_buffer[ECMA_MAX_CHARS_IN_STRINGIFIED_NUMBER];
+        lit_utf8_byte_t k_buffer[ECMA_MAX_CHARS_IN_STRINGIFIED_NUMBER];
+
+        lit_utf8_size_t j_size = ecma_number_to_utf8_string ((ecma_number_t) ecma_get_integer_from_value (j),
+                                                             j_buffer,
+                                                             sizeof (j_buffer));
+        lit_utf8_size_t k_size = ecma_number_to_utf8_string ((ecma_number_t) ecma_get_integer_from_value (k),
+                                                             k_buffer,
+                                                             sizeof (k_buffer));
+
+        int compare = memcmp (j_buffer, k_buffer, JERRY_MIN (j_size, k_size));
+
+        if (compare == 0)
+        {
+          compare = (int) j_size - (int) k_size;
+        }
+
+        if (compare < 0)
+        {
+          result = ECMA_NUMBER_MINUS_ONE;
+        }
+        else if (compare > 0)
+        {
+          result = ECMA_NUMBER_ONE;
+        }
+        else
+        {
+          result = ECMA_NUMBER_ZERO;
+        }
+      }
+      else if (ecma_is_value_undefined (comparefn))
       {
         /* Default comparison when no comparefn is passed. */
         ECMA_TRY_CATCH (j_value, ecma_op_to_string (j), ret_value);
@@ -1178,6 +1319,227 @@ ecma_builtin_array_prototype_object_array_heap_sort_helper (ecma_value_t array[]
   return ret_value;
 } /* ecma_builtin_array_prototype_object_array_heap_sort_helper */
 
+/**
+ * Maximum number of elements sorted by insertion sort
+ */
+#define ECMA_BUILTIN_ARRAY_INSERTION_SORT_MAX_LENGTH 16
+
+/**
+ * Helper function to check whether a value must be sorted before another value
+ *
+ * @return ecma value (true - if the left value is less than the right value, false - otherwise)
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_array_prototype_object_sort_less_helper (ecma_value_t left, /**< left value */
+                                                      ecma_value_t right, /**< right value */
+                                                      ecma_value_t comparefn) /**< compare function */
+{
+  ecma_value_t compare_value = ecma_builtin_array_prototype_object_sort_compare_helper (left, right, comparefn);
+
+  if (ECMA_IS_VALUE_ERROR (compare_value))
+  {
+    return compare_value;
+  }
+
+  JERRY_ASSERT (ecma_is_value_number (compare_value));
+
+  bool is_less = ecma_get_number_from_value (compare_value) < ECMA_NUMBER_ZERO;
+  ecma_free_value (compare_value);
+
+  return ecma_make_boolean_value (is_less);
+} /* ecma_builtin_array_prototype_object_sort_less_helper */
+
+/**
+ * Insertion sort function
+ *
+ * @return ecma value
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_array_prototype_object_array_insertion_sort_helper (ecma_value_t array[], /**< array to sort */
+                                                                 uint32_t left, /**< left index */
+                                                                 uint32_t right, /**< right index */
+                                                                 ecma_value_t comparefn) /**< compare function */
+{
+  for (uint32_t i = left + 1; i <= right; i++)
+  {
+    ecma_value_t current = array[i];
+    uint32_t j = i;
+
+    while (j > left)
+    {
+      ecma_value_t less_value = ecma_builtin_array_prototype_object_sort_less_helper (current,
+                                                                                      array[j - 1],
+                                                                                      comparefn);
+
+      if (!ecma_is_value_true (less_value))
+      {
+        if (ECMA_IS_VALUE_ERROR (less_value))
+        {
+          array[j] = current;
+          return less_value;
+        }
+
+        break;
+      }
+
+      array[j] = array[j - 1];
+      j--;
+    }
+
+    array[j] = current;
+  }
+
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+} /* ecma_builtin_array_prototype_object_array_insertion_sort_helper */
+
+/**
+ * Swap two elements of the array if the right one must be sorted before the left one
+ *
+ * @return ecma value
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_array_prototype_object_array_order_helper (ecma_value_t array[], /**< array to sort */
+                                                        uint32_t left, /**< left index */
+                                                        uint32_t right, /**< right index */
+                                                        ecma_value_t comparefn) /**< compare function */
+{
+  ecma_value_t less_value = ecma_builtin_array_prototype_object_sort_less_helper (array[right],
+                                                                                  array[left],
+                                                                                  comparefn);
+
+  if (ecma_is_value_true (less_value))
+  {
+    ecma_value_t swap = array[left];
+    array[left] = array[right];
+    array[right] = swap;
+  }
+
+  return ECMA_IS_VALUE_ERROR (less_value) ? less_value : ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+} /* ecma_builtin_array_prototype_object_array_order_helper */
+
+/**
+ * Introsort function
+ *
+ * Note:
+ *      the ranges are partitioned around the median of their first, middle and last
+ *      elements, the smaller partition is sorted recursively, small ranges are
+ *      sorted by insertion sort, and ranges which exceeded the depth limit are
+ *      sorted by heapsort. The array always contains the same values, even if
+ *      the compare function throws an error.
+ *
+ * @return ecma value
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_array_prototype_object_array_intro_sort_helper (ecma_value_t array[], /**< array to sort */
+                                                             uint32_t left, /**< left index */
+                                                             uint32_t right, /**< right index */
+                                                             uint32_t depth_limit, /**< remaining partitions */
+                                                             ecma_value_t comparefn) /**< compare function */
+{
+  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+
+  while (right - left >= ECMA_BUILTIN_ARRAY_INSERTION_SORT_MAX_LENGTH)
+  {
+    if (depth_limit == 0)
+    {
+      return ecma_builtin_array_prototype_object_array_heap_sort_helper (array + left,
+                                                                         (int) (right - left),
+                                                                         comparefn);
+    }
+
+    depth_limit--;
+
+    /* Order the first, middle and last elements, then move the median to the end. */
+    uint32_t middle = left + (right - left) / 2;
+
+    ret_value = ecma_builtin_array_prototype_object_array_order_helper (array, left, middle, comparefn);
+
+    if (ecma_is_value_empty (ret_value))
+    {
+      ret_value = ecma_builtin_array_prototype_object_array_order_helper (array, left, right, comparefn);
+    }
+
+    if (ecma_is_value_empty (ret_value))
+    {
+      ret_value = ecma_builtin_array_prototype_object_array_order_helper (array, middle, right, comparefn);
+    }
+
+    if (!ecma_is_value_empty (ret_value))
+    {
+      return ret_value;
+    }
+
+    ecma_value_t pivot = array[middle];
+    array[middle] = array[right];
+    array[right] = pivot;
+
+    /* Move the elements which are less than the pivot before the others. */
+    uint32_t store = left;
+
+    for (uint32_t i = left; i < right; i++)
+    {
+      ecma_value_t less_value = ecma_builtin_array_prototype_object_sort_less_helper (array[i],
+                                                                                      pivot,
+                                                                                      comparefn);
+
+      if (ECMA_IS_VALUE_ERROR (less_value))
+      {
+        return less_value;
+      }
+
+      if (ecma_is_value_true (less_value))
+      {
+        ecma_value_t swap = array[i];
+        array[i] = array[store];
+        array[store] = swap;
+        store++;
+      }
+    }
+
+    array[right] = array[store];
+    array[store] = pivot;
+
+    /* Sort the smaller partition recursively, and continue with the larger one, which is never empty. */
+    if (store - left < right - store)
+    {
+      if (store > left + 1)
+      {
+        ret_value = ecma_builtin_array_prototype_object_array_intro_sort_helper (array,
+                                                                                 left,
+                                                                                 store - 1,
+                                                                                 depth_limit,
+                                                                                 comparefn);
+      }
+
+      left = store + 1;
+    }
+    else
+    {
+      if (store + 1 < right)
+      {
+        ret_value = ecma_builtin_array_prototype_object_array_intro_sort_helper (array,
+                                                                                 store + 1,
+                                                                                 right,
+                                                                                 depth_limit,
+                                                                                 comparefn);
+      }
+
+      right = store - 1;
+    }
+
+    if (!ecma_is_value_empty (ret_value))
+    {
+      return ret_value;
+    }
+  }
+
+  return ecma_builtin_array_prototype_object_array_insertion_sort_helper (array, left, right, comparefn);
+} /* ecma_builtin_array_prototype_object_array_intro_sort_helper */
+
 /**
  * The Array.prototype object's 'sort' routine
  *
@@ -1214,52 +1576,80 @@ ecma_builtin_array_prototype_object_sort (ecma_value_t this_arg, /**< this argum
 
   uint32_t len = ecma_number_to_uint32 (len_number);
 
-  ecma_collection_header_t *array_index_props_p = ecma_op_object_get_property_names (obj_p, true, false, false);
+  ecma_collection_header_t *array_index_props_p = NULL;
 
   uint32_t defined_prop_count = 0;
   uint32_t copied_num = 0;
 
   ecma_collection_iterator_t iter;
-  ecma_collection_iterator_init (&iter, array_index_props_p);
 
-  /* Count properties with name that is array index less than len */
-  while (ecma_collection_iterator_next (&iter)
-         && ecma_is_value_empty (ret_value))
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  /* The elements of dense fast arrays are data properties, so they are copied without collecting their names. */
+  if (ecma_op_array_is_fast_array (obj_p)
+      && ((ecma_extended_object_t *) obj_p)->u.array.length == len
+      && ecma_fast_array_is_dense (obj_p))
   {
-    ecma_string_t *property_name_p = ecma_get_string_from_value (*iter.current_value_p);
+    defined_prop_count = len;
+  }
+  else
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+  {
+    array_index_props_p = ecma_op_object_get_property_names (obj_p, true, false, false);
 
-    uint32_t index = ecma_string_get_array_index (property_name_p);
-    JERRY_ASSERT (index != ECMA_STRING_NOT_ARRAY_INDEX);
+    ecma_collection_iterator_init (&iter, array_index_props_p);
 
-    if (index < len)
+    /* Count properties with name that is array index less than len */
+    while (ecma_collection_iterator_next (&iter)
+           && ecma_is_value_empty (ret_value))
     {
-      defined_prop_count++;
+      ecma_string_t *property_name_p = ecma_get_string_from_value (*iter.current_value_p);
+
+      uint32_t index = ecma_string_get_array_index (property_name_p);
+      JERRY_ASSERT (index != ECMA_STRING_NOT_ARRAY_INDEX);
+
+      if (index < len)
+      {
+        defined_prop_count++;
+      }
     }
   }
 
   JMEM_DEFINE_LOCAL_ARRAY (values_buffer, defined_prop_count, ecma_value_t);
 
-  ecma_collection_iterator_init (&iter, array_index_props_p);
-
-  /* Copy unsorted array into a native c array. */
-  while (ecma_collection_iterator_next (&iter)
-         && ecma_is_value_empty (ret_value))
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  if (array_index_props_p == NULL)
   {
-    ecma_string_t *property_name_p = ecma_get_string_from_value (*iter.current_value_p);
-
-    uint32_t index = ecma_string_get_array_index (property_name_p);
-    JERRY_ASSERT (index != ECMA_STRING_NOT_ARRAY_INDEX);
-
-    if (index >= len)
+    /* Copy the elements buffer into a native c array. */
+    for (; copied_num < defined_prop_count; copied_num++)
     {
-      break;
+      values_buffer[copied_num] = ecma_copy_value (ecma_fast_array_get_element (obj_p, copied_num));
     }
+  }
+  else
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+  {
+    ecma_collection_iterator_init (&iter, array_index_props_p);
+
+    /* Copy unsorted array into a native c array. */
+    while (ecma_collection_iterator_next (&iter)
+           && ecma_is_value_empty (ret_value))
+    {
+      ecma_string_t *property_name_p = ecma_get_string_from_value (*iter.current_value_p);
+
+      uint32_t index = ecma_string_get_array_index (property_name_p);
+      JERRY_ASSERT (index != ECMA_STRING_NOT_ARRAY_INDEX);
 
-    ECMA_TRY_CATCH (index_value, ecma_op_object_get (obj_p, property_name_p), ret_value);
+      if (index >= len)
+      {
+        break;
+      }
 
-    values_buffer[copied_num++] = ecma_copy_value (index_value);
+      ECMA_TRY_CATCH (index_value, ecma_op_object_get (obj_p, property_name_p), ret_value);
 
-    ECMA_FINALIZE (index_value);
+      values_buffer[copied_num++] = ecma_copy_value (index_value);
+
+      ECMA_FINALIZE (index_value);
+    }
   }
 
   JERRY_ASSERT (copied_num == defined_prop_count
@@ -1268,10 +1658,19 @@ ecma_builtin_array_prototype_object_sort (ecma_value_t this_arg, /**< this argum
   /* Sorting. */
   if (copied_num > 1 && ecma_is_value_empty (ret_value))
   {
+    uint32_t depth_limit = 0;
+
+    for (uint32_t size = copied_num; size > 1; size >>= 1)
+    {
+      depth_limit += 2;
+    }
+
     ECMA_TRY_CATCH (sort_value,
-                    ecma_builtin_array_prototype_object_array_heap_sort_helper (values_buffer,
-                                                                                (int)(copied_num - 1),
-                                                                                arg1),
+                    ecma_builtin_array_prototype_object_array_intro_sort_helper (values_buffer,
+                                                                                 0,
+                                                                                 copied_num - 1,
+                                                                                 depth_limit,
+                                                                                 arg1),
                     ret_value);
     ECMA_FINALIZE (sort_value);
   }
@@ -1281,6 +1680,15 @@ ecma_builtin_array_prototype_object_sort (ecma_value_t this_arg, /**< this argum
        index < copied_num && ecma_is_value_empty (ret_value);
        index++)
   {
+#ifdef CONFIG_ECMA_FAST_ARRAY
+    /* The compare function might have changed the array, so the elements are checked one by one. */
+    if (ecma_op_array_is_fast_array (obj_p)
+        && ecma_fast_array_assign_element (obj_p, index, values_buffer[index]))
+    {
+      continue;
+    }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
     ecma_string_t *index_string_p = ecma_new_ecma_string_from_uint32 (index);
     ECMA_TRY_CATCH (put_value,
                     ecma_op_object_put (obj_p, index_string_p, values_buffer[index], true),
@@ -1298,25 +1706,27 @@ ecma_builtin_array_prototype_object_sort (ecma_value_t this_arg, /**< this argum
   JMEM_FINALIZE_LOCAL_ARRAY (values_buffer);
 
   /* Undefined properties should be in the back of the array. */
-
-  ecma_collection_iterator_init (&iter, array_index_props_p);
-
-  while (ecma_collection_iterator_next (&iter)
-         && ecma_is_value_empty (ret_value))
+  if (array_index_props_p != NULL)
   {
-    ecma_string_t *property_name_p = ecma_get_string_from_value (*iter.current_value_p);
-
-    uint32_t index = ecma_string_get_array_index (property_name_p);
-    JERRY_ASSERT (index != ECMA_STRING_NOT_ARRAY_INDEX);
+    ecma_collection_iterator_init (&iter, array_index_props_p);
 
-    if (index >= copied_num && index < len)
+    while (ecma_collection_iterator_next (&iter)
+           && ecma_is_value_empty (ret_value))
     {
-      ECMA_TRY_CATCH (del_value, ecma_op_object_delete (obj_p, property_name_p, true), ret_value);
-      ECMA_FINALIZE (del_value);
+      ecma_string_t *property_name_p = ecma_get_string_from_value (*iter.current_value_p);
+
+      uint32_t index = ecma_string_get_array_index (property_name_p);
+      JERRY_ASSERT (index != ECMA_STRING_NOT_ARRAY_INDEX);
+
+      if (index >= copied_num && index < len)
+      {
+        ECMA_TRY_CATCH (del_value, ecma_op_object_delete (obj_p, property_name_p, true), ret_value);
+        ECMA_FINALIZE (del_value);
+      }
     }
-  }
 
-  ecma_free_values_collection (array_index_props_p, true);
+    ecma_free_values_collection (array_index_props_p, true);
+  }
 
   if (ecma_is_value_empty (ret_value))
   {
@@ -1332,99 +1742,25 @@ ecma_builtin_array_prototype_object_sort (ecma_value_t this_arg, /**< this argum
 } /* ecma_builtin_array_prototype_object_sort */
 
 /**
- * The Array.prototype object's 'splice' routine
+ * Helper function to move the elements of the 'splice' routine
  *
  * See also:
- *          ECMA-262 v5, 15.4.4.12
+ *          ECMA-262 v5, 15.4.4.12 steps 8-16
  *
- * @return ecma value
+ * @return ecma value (empty - if the elements are moved, error - otherwise)
  *         Returned value must be freed with ecma_free_value.
  */
 static ecma_value_t
-ecma_builtin_array_prototype_object_splice (ecma_value_t this_arg, /**< this argument */
-                                            const ecma_value_t args[], /**< arguments list */
-                                            ecma_length_t args_number) /**< number of arguments */
+ecma_builtin_array_prototype_object_splice_elements (ecma_object_t *obj_p, /**< object */
+                                                     ecma_object_t *new_array_p, /**< array of deleted elements */
+                                                     uint32_t len, /**< length of the object */
+                                                     uint32_t start, /**< start index */
+                                                     uint32_t delete_count, /**< number of deleted elements */
+                                                     const ecma_value_t args[], /**< arguments list */
+                                                     ecma_length_t args_number) /**< number of arguments */
 {
   ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
 
-  /* 1. */
-  ECMA_TRY_CATCH (obj_this,
-                  ecma_op_to_object (this_arg),
-                  ret_value);
-
-  ecma_object_t *obj_p = ecma_get_object_from_value (obj_this);
-
-  /* 3. */
-  ecma_string_t *length_magic_string_p = ecma_new_ecma_length_string ();
-
-  ECMA_TRY_CATCH (len_value,
-                  ecma_op_object_get (obj_p, length_magic_string_p),
-                  ret_value);
-
-  /* 4. */
-  ECMA_OP_TO_NUMBER_TRY_CATCH (len_number,
-                               len_value,
-                               ret_value);
-
-  const uint32_t len = ecma_number_to_uint32 (len_number);
-
-  ecma_value_t new_array = ecma_op_create_array_object (0, 0, false);
-  ecma_object_t *new_array_p = ecma_get_object_from_value (new_array);
-
-  uint32_t start = 0;
-  uint32_t delete_count = 0;
-
-  if (args_number > 0)
-  {
-    /* 5. */
-    ECMA_OP_TO_NUMBER_TRY_CATCH (start_num,
-                                 args[0],
-                                 ret_value);
-
-    start = ecma_builtin_helper_array_index_normalize (start_num, len);
-
-    /*
-     * If there is only one argument, that will be the start argument,
-     * and we must delete the additional elements.
-     */
-    if (args_number == 1)
-    {
-      delete_count = len - start;
-    }
-    else
-    {
-      /* 7. */
-      ECMA_OP_TO_NUMBER_TRY_CATCH (delete_num,
-                                   args[1],
-                                   ret_value);
-
-      if (!ecma_number_is_nan (delete_num))
-      {
-        if (ecma_number_is_negative (delete_num))
-        {
-          delete_count = 0;
-        }
-        else
-        {
-          delete_count = ecma_number_is_infinity (delete_num) ? len : ecma_number_to_uint32 (delete_num);
-
-          if (delete_count > len - start)
-          {
-            delete_count = len - start;
-          }
-        }
-      }
-      else
-      {
-        delete_count = 0;
-      }
-
-      ECMA_OP_TO_NUMBER_FINALIZE (delete_num);
-    }
-
-    ECMA_OP_TO_NUMBER_FINALIZE (start_num);
-  }
-
   /* 8-9. */
   uint32_t k = 0;
 
@@ -1599,6 +1935,193 @@ ecma_builtin_array_prototype_object_splice (ecma_value_t this_arg, /**< this arg
     ECMA_FINALIZE (set_length_value);
   }
 
+  return ret_value;
+} /* ecma_builtin_array_prototype_object_splice_elements */
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+
+/**
+ * Helper function to move the elements of the 'splice' routine in the elements buffer of a dense fast array
+ *
+ * Note:
+ *      the result is the same as the result of the generic steps, since the
+ *      elements of the array are data properties, and no setter can intercept
+ *      the new elements
+ *
+ * @return true - if the elements are moved,
+ *         false - if the generic steps must be used
+ */
+static bool
+ecma_builtin_array_prototype_object_splice_fast (ecma_object_t *obj_p, /**< object */
+                                                 ecma_object_t *new_array_p, /**< array of deleted elements */
+                                                 uint32_t len, /**< length of the object */
+                                                 uint32_t start, /**< start index */
+                                                 uint32_t delete_count, /**< number of deleted elements */
+                                                 const ecma_value_t args[], /**< arguments list */
+                                                 ecma_length_t args_number) /**< number of arguments */
+{
+  if (!ecma_op_array_is_fast_array (obj_p))
+  {
+    return false;
+  }
+
+  ecma_extended_object_t *ext_obj_p = (ecma_extended_object_t *) obj_p;
+  uint32_t item_count = (args_number > 2) ? (uint32_t) (args_number - 2) : 0;
+
+  if (ext_obj_p->u.array.length != len
+      || !ecma_is_property_writable (ext_obj_p->u.array.length_prop)
+      || !ecma_fast_array_is_dense (obj_p))
+  {
+    return false;
+  }
+
+  if (item_count > delete_count)
+  {
+    if (item_count - delete_count >= UINT32_MAX - len
+        || !ecma_get_object_extensible (obj_p))
+    {
+      return false;
+    }
+
+    for (uint32_t index = len; index < len - delete_count + item_count; index++)
+    {
+      if (ecma_builtin_array_prototype_helper_has_inherited_element (obj_p, index))
+      {
+        return false;
+      }
+    }
+  }
+
+  /* 8-9. */
+  for (uint32_t k = 0; k < delete_count; k++)
+  {
+    ecma_builtin_array_prototype_helper_append_element (new_array_p,
+                                                        k,
+                                                        ecma_fast_array_get_element (obj_p, start + k));
+  }
+
+  /* 10-16. The generic steps define the same elements of the new array again if there is not enough memory. */
+  return ecma_fast_array_splice (obj_p, start, delete_count, (item_count > 0) ? args + 2 : NULL, item_count);
+} /* ecma_builtin_array_prototype_object_splice_fast */
+
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
+/**
+ * The Array.prototype object's 'splice' routine
+ *
+ * See also:
+ *          ECMA-262 v5, 15.4.4.12
+ *
+ * @return ecma value
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_array_prototype_object_splice (ecma_value_t this_arg, /**< this argument */
+                                            const ecma_value_t args[], /**< arguments list */
+                                            ecma_length_t args_number) /**< number of arguments */
+{
+  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+
+  /* 1. */
+  ECMA_TRY_CATCH (obj_this,
+                  ecma_op_to_object (this_arg),
+                  ret_value);
+
+  ecma_object_t *obj_p = ecma_get_object_from_value (obj_this);
+
+  /* 3. */
+  ecma_string_t *length_magic_string_p = ecma_new_ecma_length_string ();
+
+  ECMA_TRY_CATCH (len_value,
+                  ecma_op_object_get (obj_p, length_magic_string_p),
+                  ret_value);
+
+  /* 4. */
+  ECMA_OP_TO_NUMBER_TRY_CATCH (len_number,
+                               len_value,
+                               ret_value);
+
+  const uint32_t len = ecma_number_to_uint32 (len_number);
+
+  ecma_value_t new_array = ecma_op_create_array_object (0, 0, false);
+  ecma_object_t *new_array_p = ecma_get_object_from_value (new_array);
+
+  uint32_t start = 0;
+  uint32_t delete_count = 0;
+
+  if (args_number > 0)
+  {
+    /* 5. */
+    ECMA_OP_TO_NUMBER_TRY_CATCH (start_num,
+                                 args[0],
+                                 ret_value);
+
+    start = ecma_builtin_helper_array_index_normalize (start_num, len);
+
+    /*
+     * If there is only one argument, that will be the start argument,
+     * and we must delete the additional elements.
+     */
+    if (args_number == 1)
+    {
+      delete_count = len - start;
+    }
+    else
+    {
+      /* 7. */
+      ECMA_OP_TO_NUMBER_TRY_CATCH (delete_num,
+                                   args[1],
+                                   ret_value);
+
+      if (!ecma_number_is_nan (delete_num))
+      {
+        if (ecma_number_is_negative (delete_num))
+        {
+          delete_count = 0;
+        }
+        else
+        {
+          delete_count = ecma_number_is_infinity (delete_num) ? len : ecma_number_to_uint32 (delete_num);
+
+          if (delete_count > len - start)
+          {
+            delete_count = len - start;
+          }
+        }
+      }
+      else
+      {
+        delete_count = 0;
+      }
+
+      ECMA_OP_TO_NUMBER_FINALIZE (delete_num);
+    }
+
+    ECMA_OP_TO_NUMBER_FINALIZE (start_num);
+  }
+
+  if (ecma_is_value_empty (ret_value))
+  {
+#ifdef CONFIG_ECMA_FAST_ARRAY
+    if (!ecma_builtin_array_prototype_object_splice_fast (obj_p,
+                                                          new_array_p,
+                                                          len,
+                                                          start,
+                                                          delete_count,
+                                                          args,
+                                                          args_number))
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+    {
+      ret_value = ecma_builtin_array_prototype_object_splice_elements (obj_p,
+                                                                       new_array_p,
+                                                                       len,
+                                                                       start,
+                                                                       delete_count,
+                                                                       args,
+                                                                       args_number);
+    }
+  }
+
   if (ecma_is_value_empty (ret_value))
   {
     ret_value = new_array;
@@ -1768,10 +2291,8 @@ ecma_builtin_array_prototype_object_index_of (ecma_value_t this_arg, /**< this a
 
       for (; from_idx < len && found_index < 0 && ecma_is_value_empty (ret_value); from_idx++)
       {
-        ecma_string_t *idx_str_p = ecma_new_ecma_string_from_uint32 (from_idx);
-
         /* 9.a */
-        ECMA_TRY_CATCH (get_value, ecma_op_object_find (obj_p, idx_str_p), ret_value);
+        ECMA_TRY_CATCH (get_value, ecma_builtin_array_prototype_helper_find_element (obj_p, from_idx), ret_value);
 
         if (ecma_is_value_found (get_value))
         {
@@ -1783,8 +2304,6 @@ ecma_builtin_array_prototype_object_index_of (ecma_value_t this_arg, /**< this a
         }
 
         ECMA_FINALIZE (get_value);
-
-        ecma_deref_ecma_string (idx_str_p);
       }
     }
 
@@ -2203,11 +2722,8 @@ ecma_builtin_array_prototype_object_for_each (ecma_value_t this_arg, /**< this a
     /* Iterate over array and call callbackfn on every element */
     for (uint32_t index = 0; index < len && ecma_is_value_empty (ret_value); index++)
     {
-      /* 7.a */
-      ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
-
-      /* 7.b */
-      ECMA_TRY_CATCH (current_value, ecma_op_object_find (obj_p, index_str_p), ret_value);
+      /* 7.a - 7.b */
+      ECMA_TRY_CATCH (current_value, ecma_builtin_array_prototype_helper_find_element (obj_p, index), ret_value);
 
       if (ecma_is_value_found (current_value))
       {
@@ -2222,8 +2738,6 @@ ecma_builtin_array_prototype_object_for_each (ecma_value_t this_arg, /**< this a
       }
 
       ECMA_FINALIZE (current_value);
-
-      ecma_deref_ecma_string (index_str_p);
     }
 
     if (ecma_is_value_empty (ret_value))
@@ -2300,11 +2814,8 @@ ecma_builtin_array_prototype_object_map (ecma_value_t this_arg, /**< this argume
 
     for (uint32_t index = 0; index < len && ecma_is_value_empty (ret_value); index++)
     {
-      /* 8.a */
-      ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
-
-      /* 8.b */
-      ECMA_TRY_CATCH (current_value, ecma_op_object_find (obj_p, index_str_p), ret_value);
+      /* 8.a - 8.b */
+      ECMA_TRY_CATCH (current_value, ecma_builtin_array_prototype_helper_find_element (obj_p, index), ret_value);
 
       if (ecma_is_value_found (current_value))
       {
@@ -2315,22 +2826,12 @@ ecma_builtin_array_prototype_object_map (ecma_value_t this_arg, /**< this argume
         ECMA_TRY_CATCH (mapped_value, ecma_op_function_call (func_object_p, arg2, call_args, 3), ret_value);
 
         /* 8.c.iii */
-        /* This will always be a simple value since 'is_throw' is false, so no need to free. */
-        ecma_value_t put_comp = ecma_builtin_helper_def_prop (new_array_p,
-                                                              index_str_p,
-                                                              mapped_value,
-                                                              true, /* Writable */
-                                                              true, /* Enumerable */
-                                                              true, /* Configurable */
-                                                              false);
-        JERRY_ASSERT (ecma_is_value_true (put_comp));
+        ecma_builtin_array_prototype_helper_append_element (new_array_p, index, mapped_value);
 
         ECMA_FINALIZE (mapped_value);
       }
 
       ECMA_FINALIZE (current_value);
-
-      ecma_deref_ecma_string (index_str_p);
     }
 
     if (ecma_is_value_empty (ret_value))
@@ -16,7 +16,9 @@
 #include "ecma-alloc.h"
 #include "ecma-helpers.h"
 #include "ecma-builtin-helpers.h"
+#include "jrt-libc-includes.h"
 #include "lit-char-helpers.h"
+#include "lit-magic-strings.h"
 
 /** \addtogroup ecma ECMA
  * @{
@@ -93,215 +95,145 @@ ecma_has_string_value_in_collection (ecma_collection_header_t *collection_p, /**
 } /* ecma_has_string_value_in_collection*/
 
 /**
- * Common function to concatenate key-value pairs into an ecma-string.
- *
- * See also:
- *          ECMA-262 v5, 15.12.3
- *
- * Used by:
- *         - ecma_builtin_helper_json_create_formatted_json step 10.b.ii
- *         - ecma_builtin_helper_json_create_non_formatted_json step 10.a.i
- *
- * @return pointer to ecma-string
- *         Returned value must be freed with ecma_deref_ecma_string.
+ * Initial capacity of the JSON text buffer
  */
-ecma_string_t *
-ecma_builtin_helper_json_create_separated_properties (ecma_collection_header_t *partial_p, /**< key-value pairs*/
-                                                      ecma_string_t *separator_p) /**< separator*/
-{
-  ecma_string_t *properties_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
-  ecma_string_t *tmp_str_p;
+#define ECMA_JSON_BUFFER_INITIAL_CAPACITY 64
 
-  ecma_collection_iterator_t iterator;
-  ecma_collection_iterator_init (&iterator, partial_p);
-
-  uint32_t index = 0;
+/**
+ * Initialize an empty JSON text buffer.
+ */
+void
+ecma_builtin_helper_json_buffer_init (ecma_json_buffer_t *buffer_p) /**< buffer */
+{
+  buffer_p->data_p = NULL;
+  buffer_p->size = 0;
+  buffer_p->capacity = 0;
+} /* ecma_builtin_helper_json_buffer_init */
 
-  while (ecma_collection_iterator_next (&iterator))
+/**
+ * Free the memory of a JSON text buffer.
+ */
+void
+ecma_builtin_helper_json_buffer_free (ecma_json_buffer_t *buffer_p) /**< buffer */
+{
+  if (buffer_p->data_p != NULL)
   {
-    ecma_value_t name_value = *iterator.current_value_p;
-    ecma_string_t *current_p = ecma_get_string_from_value (name_value);
-
-    if (index == 0)
-    {
-      index++;
-
-      tmp_str_p = ecma_concat_ecma_strings (properties_str_p, current_p);
-      ecma_deref_ecma_string (properties_str_p);
-      properties_str_p = tmp_str_p;
-      continue;
-    }
-
-    tmp_str_p = ecma_concat_ecma_strings (properties_str_p, separator_p);
-    ecma_deref_ecma_string (properties_str_p);
-    properties_str_p = tmp_str_p;
-
-    tmp_str_p = ecma_concat_ecma_strings (properties_str_p, current_p);
-    ecma_deref_ecma_string (properties_str_p);
-    properties_str_p = tmp_str_p;
+    jmem_heap_free_block (buffer_p->data_p, buffer_p->capacity);
   }
 
-  return properties_str_p;
-} /* ecma_builtin_helper_json_create_separated_properties */
+  ecma_builtin_helper_json_buffer_init (buffer_p);
+} /* ecma_builtin_helper_json_buffer_free */
 
 /**
- * Common function to create a formatted JSON string.
- *
- * See also:
- *          ECMA-262 v5, 15.12.3
+ * Extend a JSON text buffer by the specified number of bytes.
  *
- * Used by:
- *         - ecma_builtin_json_object step 10.b
- *         - ecma_builtin_json_array step 10.b
+ * The capacity is doubled when it is exceeded, so the text is copied
+ * a constant number of times on average.
  *
- * @return ecma value
- *         Returned value must be freed with ecma_free_value.
+ * @return pointer to the first extended byte
  */
-ecma_value_t
-ecma_builtin_helper_json_create_formatted_json (ecma_string_t *left_bracket_p, /**< left bracket*/
-                                                ecma_string_t *right_bracket_p, /**< right bracket*/
-                                                ecma_string_t *stepback_p, /**< stepback*/
-                                                ecma_collection_header_t *partial_p, /**< key-value pairs*/
-                                                ecma_json_stringify_context_t *context_p) /**< context*/
+static lit_utf8_byte_t *
+ecma_builtin_helper_json_buffer_extend (ecma_json_buffer_t *buffer_p, /**< buffer */
+                                        lit_utf8_size_t size) /**< number of bytes */
 {
-  /* 10.b */
-  ecma_string_t *comma_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_COMMA_CHAR);
-  ecma_string_t *line_feed_p = ecma_get_magic_string (LIT_MAGIC_STRING_NEW_LINE_CHAR);
-  ecma_string_t *properties_str_p;
-  ecma_string_t *separator_p;
-
-  /* 10.b.i */
-  ecma_string_t *tmp_str_p = ecma_concat_ecma_strings (comma_str_p, line_feed_p);
-  ecma_deref_ecma_string (comma_str_p);
-  separator_p = tmp_str_p;
-
-  tmp_str_p = ecma_concat_ecma_strings (separator_p, context_p->indent_str_p);
-  ecma_deref_ecma_string (separator_p);
-  separator_p = tmp_str_p;
-
-  /* 10.b.ii */
-  properties_str_p = ecma_builtin_helper_json_create_separated_properties (partial_p, separator_p);
-  ecma_deref_ecma_string (separator_p);
-
-  /* 10.b.iii */
-  ecma_string_t *final_str_p;
+  if (buffer_p->capacity - buffer_p->size < size)
+  {
+    lit_utf8_size_t new_capacity = JERRY_MAX (buffer_p->capacity, ECMA_JSON_BUFFER_INITIAL_CAPACITY);
 
-  tmp_str_p = ecma_concat_ecma_strings (left_bracket_p, line_feed_p);
-  final_str_p = tmp_str_p;
+    while (new_capacity - buffer_p->size < size)
+    {
+      /* It is impossible to allocate this large buffer. */
+      if (new_capacity > UINT32_MAX / 2)
+      {
+        jerry_fatal (ERR_OUT_OF_MEMORY);
+      }
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, context_p->indent_str_p);
-  ecma_deref_ecma_string (final_str_p);
-  final_str_p = tmp_str_p;
+      new_capacity *= 2;
+    }
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, properties_str_p);
-  ecma_deref_ecma_string (final_str_p);
-  ecma_deref_ecma_string (properties_str_p);
-  final_str_p = tmp_str_p;
+    lit_utf8_byte_t *new_data_p = (lit_utf8_byte_t *) jmem_heap_alloc_block (new_capacity);
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, line_feed_p);
-  ecma_deref_ecma_string (line_feed_p);
-  ecma_deref_ecma_string (final_str_p);
-  final_str_p = tmp_str_p;
+    if (buffer_p->data_p != NULL)
+    {
+      memcpy (new_data_p, buffer_p->data_p, buffer_p->size);
+      jmem_heap_free_block (buffer_p->data_p, buffer_p->capacity);
+    }
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, stepback_p);
-  ecma_deref_ecma_string (final_str_p);
-  final_str_p = tmp_str_p;
+    buffer_p->data_p = new_data_p;
+    buffer_p->capacity = new_capacity;
+  }
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, right_bracket_p);
-  ecma_deref_ecma_string (final_str_p);
-  final_str_p = tmp_str_p;
+  lit_utf8_byte_t *extension_p = buffer_p->data_p + buffer_p->size;
+  buffer_p->size += size;
+  return extension_p;
+} /* ecma_builtin_helper_json_buffer_extend */
 
-  return ecma_make_string_value (final_str_p);
-} /* ecma_builtin_helper_json_create_formatted_json */
+/**
+ * Append bytes to a JSON text buffer.
+ */
+void
+ecma_builtin_helper_json_buffer_append (ecma_json_buffer_t *buffer_p, /**< buffer */
+                                        const lit_utf8_byte_t *data_p, /**< cesu-8 characters */
+                                        lit_utf8_size_t size) /**< number of bytes */
+{
+  if (size > 0)
+  {
+    memcpy (ecma_builtin_helper_json_buffer_extend (buffer_p, size), data_p, size);
+  }
+} /* ecma_builtin_helper_json_buffer_append */
 
 /**
- * Common function to create a non-formatted JSON string.
- *
- * See also:
- *          ECMA-262 v5, 15.12.3
- *
- * Used by:
- *         - ecma_builtin_json_object step 10.a
- *         - ecma_builtin_json_array step 10.a
- *
- * @return ecma value
- *         Returned value must be freed with ecma_free_value.
+ * Append an ASCII character to a JSON text buffer.
  */
-ecma_value_t
-ecma_builtin_helper_json_create_non_formatted_json (ecma_string_t *left_bracket_p, /**< left bracket*/
-                                                    ecma_string_t *right_bracket_p, /**< right bracket*/
-                                                    ecma_collection_header_t *partial_p) /**< key-value pairs*/
+void
+ecma_builtin_helper_json_buffer_append_char (ecma_json_buffer_t *buffer_p, /**< buffer */
+                                             lit_utf8_byte_t ch) /**< ASCII character */
 {
-  /* 10.a */
-  ecma_string_t *comma_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_COMMA_CHAR);
-  ecma_string_t *properties_str_p;
-  ecma_string_t *tmp_str_p;
+  JERRY_ASSERT (ch <= LIT_UTF8_1_BYTE_CODE_POINT_MAX);
 
-  /* 10.a.i */
-  properties_str_p = ecma_builtin_helper_json_create_separated_properties (partial_p, comma_str_p);
-  ecma_deref_ecma_string (comma_str_p);
+  *ecma_builtin_helper_json_buffer_extend (buffer_p, 1) = ch;
+} /* ecma_builtin_helper_json_buffer_append_char */
 
-  /* 10.a.ii */
-  tmp_str_p = ecma_concat_ecma_strings (left_bracket_p, properties_str_p);
-  ecma_deref_ecma_string (properties_str_p);
-  properties_str_p = tmp_str_p;
+/**
+ * Append a magic string to a JSON text buffer.
+ */
+void
+ecma_builtin_helper_json_buffer_append_magic (ecma_json_buffer_t *buffer_p, /**< buffer */
+                                              lit_magic_string_id_t id) /**< magic string id */
+{
+  ecma_builtin_helper_json_buffer_append (buffer_p, lit_get_magic_string_utf8 (id), lit_get_magic_string_size (id));
+} /* ecma_builtin_helper_json_buffer_append_magic */
 
-  tmp_str_p = ecma_concat_ecma_strings (properties_str_p, right_bracket_p);
-  ecma_deref_ecma_string (properties_str_p);
-  properties_str_p = tmp_str_p;
+/**
+ * Append an ecma-string to a JSON text buffer.
+ */
+void
+ecma_builtin_helper_json_buffer_append_string (ecma_json_buffer_t *buffer_p, /**< buffer */
+                                               ecma_string_t *string_p) /**< ecma-string */
+{
+  lit_utf8_size_t size = ecma_string_get_size (string_p);
 
-  return ecma_make_string_value (properties_str_p);
-} /* ecma_builtin_helper_json_create_non_formatted_json */
+  if (size > 0)
+  {
+    ecma_string_to_utf8_bytes (string_p, ecma_builtin_helper_json_buffer_extend (buffer_p, size), size);
+  }
+} /* ecma_builtin_helper_json_buffer_append_string */
 
 /**
- * Convert decimal value to 4 digit hexadecimal string value.
- *
- * See also:
- *          ECMA-262 v5, 15.12.3
- *
- * Used by:
- *         - ecma_builtin_json_quote step 2.c.iii
+ * Create an ecma-string from the text of a JSON text buffer, and free the buffer.
  *
  * @return pointer to ecma-string
  *         Returned value must be freed with ecma_deref_ecma_string.
  */
 ecma_string_t *
-ecma_builtin_helper_json_create_hex_digit_ecma_string (uint8_t value) /**< value in decimal*/
+ecma_builtin_helper_json_buffer_finalize (ecma_json_buffer_t *buffer_p) /**< buffer */
 {
-  /* 2.c.iii */
-  ecma_string_t *hex_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
-
-  JMEM_DEFINE_LOCAL_ARRAY (hex_buff, 4, lit_utf8_byte_t);
-
-  for (uint32_t i = 0; i < 4; i++)
-  {
-    uint8_t remainder = value % 16;
-    lit_utf8_byte_t ch = ' ';
-
-    if (remainder < 10)
-    {
-      ch = (lit_utf8_byte_t) (LIT_CHAR_0 + remainder);
-    }
-    else
-    {
-      uint8_t a = (uint8_t) (remainder - 10);
-      ch = (lit_utf8_byte_t) (LIT_CHAR_LOWERCASE_A + a);
-    }
-
-    hex_buff[3 - i] = ch;
-
-    value = value / 16;
-  }
-
-  ecma_deref_ecma_string (hex_str_p);
-  hex_str_p = ecma_new_ecma_string_from_utf8 ((lit_utf8_byte_t *) hex_buff, 4);
-
-  JMEM_FINALIZE_LOCAL_ARRAY (hex_buff);
+  ecma_string_t *string_p = ecma_new_ecma_string_from_utf8 (buffer_p->data_p, buffer_p->size);
 
-  JERRY_ASSERT (ecma_string_get_length (hex_str_p));
+  ecma_builtin_helper_json_buffer_free (buffer_p);
 
-  return hex_str_p;
-} /* ecma_builtin_helper_json_create_hex_digit_ecma_string */
+  return string_p;
+} /* ecma_builtin_helper_json_buffer_finalize */
 
 /**
  * @}
@@ -201,11 +201,18 @@ ecma_builtin_helper_object_get_properties (ecma_object_t *obj_p, /**< object */
   ecma_object_t *new_array_p = ecma_get_object_from_value (new_array);
 
   uint32_t index = 0;
+  bool is_shared = false;
 
-  ecma_collection_header_t *props_p = ecma_op_object_get_property_names (obj_p,
-                                                                         false,
-                                                                         only_enumerable_properties,
-                                                                         false);
+  ecma_collection_header_t *props_p;
+
+  if (only_enumerable_properties)
+  {
+    props_p = ecma_op_object_get_enumerable_property_names (obj_p, false, &is_shared);
+  }
+  else
+  {
+    props_p = ecma_op_object_get_property_names (obj_p, false, false, false);
+  }
 
   ecma_collection_iterator_t iter;
   ecma_collection_iterator_init (&iter, props_p);
@@ -229,7 +236,7 @@ ecma_builtin_helper_object_get_properties (ecma_object_t *obj_p, /**< object */
     index++;
   }
 
-  ecma_free_values_collection (props_p, true);
+  ecma_op_object_free_enumerable_property_names (props_p, is_shared);
 
   return new_array;
 } /* ecma_builtin_helper_object_get_properties */
@@ -535,13 +542,150 @@ ecma_builtin_helper_string_prototype_object_index_of (ecma_value_t this_arg, /**
   return ret_value;
 } /* ecma_builtin_helper_string_prototype_object_index_of */
 
+/**
+ * Minimum size of a search string searched with the Boyer-Moore-Horspool algorithm
+ */
+#define ECMA_BUILTIN_HELPER_HORSPOOL_MIN_SEARCH_SIZE 4
+
+/**
+ * Minimum number of bytes searched with the Boyer-Moore-Horspool algorithm
+ */
+#define ECMA_BUILTIN_HELPER_HORSPOOL_MIN_STRING_SIZE 128
+
+/**
+ * Helper function for finding the first occurrence of a byte sequence
+ *
+ * Note:
+ *      short byte sequences are found by skipping to the occurrences of their
+ *      first byte with memchr, longer ones with the Boyer-Moore-Horspool algorithm
+ *
+ * @return offset of the occurrence - if the byte sequence is found,
+ *         string size - otherwise
+ */
+static lit_utf8_size_t
+ecma_builtin_helper_string_find_bytes (const lit_utf8_byte_t *str_p, /**< string */
+                                       lit_utf8_size_t str_size, /**< string size */
+                                       const lit_utf8_byte_t *search_p, /**< search string */
+                                       lit_utf8_size_t search_size) /**< search string size (non-zero) */
+{
+  JERRY_ASSERT (search_size > 0);
+
+  if (search_size > str_size)
+  {
+    return str_size;
+  }
+
+  const lit_utf8_size_t last_offset = str_size - search_size;
+  lit_utf8_size_t offset = 0;
+
+  if (search_size < ECMA_BUILTIN_HELPER_HORSPOOL_MIN_SEARCH_SIZE
+      || str_size < ECMA_BUILTIN_HELPER_HORSPOOL_MIN_STRING_SIZE)
+  {
+    while (offset <= last_offset)
+    {
+      const lit_utf8_byte_t *first_p = (const lit_utf8_byte_t *) memchr (str_p + offset,
+                                                                         search_p[0],
+                                                                         last_offset - offset + 1);
+
+      if (first_p == NULL)
+      {
+        break;
+      }
+
+      offset = (lit_utf8_size_t) (first_p - str_p);
+
+      if (memcmp (first_p + 1, search_p + 1, search_size - 1) == 0)
+      {
+        return offset;
+      }
+
+      offset++;
+    }
+
+    return str_size;
+  }
+
+  /* Shift of the search window for each value of its last byte, limited to the range of uint8_t. */
+  uint8_t shift_table[256];
+  const lit_utf8_size_t max_shift = JERRY_MIN (search_size, UINT8_MAX);
+
+  memset (shift_table, (int) max_shift, sizeof (shift_table));
+
+  for (lit_utf8_size_t i = 0; i < search_size - 1; i++)
+  {
+    const lit_utf8_size_t distance = search_size - 1 - i;
+
+    if (distance < max_shift)
+    {
+      shift_table[search_p[i]] = (uint8_t) distance;
+    }
+  }
+
+  const lit_utf8_byte_t last_byte = search_p[search_size - 1];
+
+  while (offset <= last_offset)
+  {
+    const lit_utf8_byte_t byte = str_p[offset + search_size - 1];
+
+    if (byte == last_byte
+        && memcmp (str_p + offset, search_p, search_size - 1) == 0)
+    {
+      return offset;
+    }
+
+    offset += shift_table[byte];
+  }
+
+  return str_size;
+} /* ecma_builtin_helper_string_find_bytes */
+
+/**
+ * Helper function for finding the last occurrence of a byte sequence
+ *
+ * @return offset of the occurrence - if the byte sequence is found,
+ *         string size - otherwise
+ */
+static lit_utf8_size_t
+ecma_builtin_helper_string_find_last_bytes (const lit_utf8_byte_t *str_p, /**< string */
+                                            lit_utf8_size_t str_size, /**< string size */
+                                            lit_utf8_size_t max_offset, /**< maximum offset of the occurrence */
+                                            const lit_utf8_byte_t *search_p, /**< search string */
+                                            lit_utf8_size_t search_size) /**< search string size (non-zero) */
+{
+  JERRY_ASSERT (search_size > 0);
+
+  if (search_size > str_size)
+  {
+    return str_size;
+  }
+
+  lit_utf8_size_t offset = JERRY_MIN (max_offset, str_size - search_size);
+  const lit_utf8_byte_t first_byte = search_p[0];
+
+  while (true)
+  {
+    if (str_p[offset] == first_byte
+        && memcmp (str_p + offset + 1, search_p + 1, search_size - 1) == 0)
+    {
+      return offset;
+    }
+
+    if (offset == 0)
+    {
+      return str_size;
+    }
+
+    offset--;
+  }
+} /* ecma_builtin_helper_string_find_last_bytes */
+
 /**
  * Helper function for finding index of a search string
  *
- * This function clamps the given index to the [0, length] range.
- * If the index is negative, 0 value is used.
- * If the index is greater than the length of the string, the normalized index will be the length of the string.
- * NaN is mapped to zero or length depending on the nan_to_zero parameter.
+ * The strings are compared in their CESU-8 form: each character is encoded separately,
+ * and the first byte of a character is never a continuation byte, so a byte sequence
+ * match is always a character sequence match. Character positions are only converted
+ * to byte positions for non-ascii strings.
  *
  * See also:
  *          ECMA-262 v5, 15.5.4.7,8,11
@@ -549,12 +693,14 @@ ecma_builtin_helper_string_prototype_object_index_of (ecma_value_t this_arg, /**
  * Used by:
  *         - The ecma_builtin_helper_string_prototype_object_index_of helper routine.
  *         - The ecma_builtin_string_prototype_object_replace_match helper routine.
+ *         - The String.prototype.split routine.
  *
- * @return uint32_t - the normalized value of the index
+ * @return true - if the search string is found,
+ *         false - otherwise
  */
 bool
-ecma_builtin_helper_string_find_index (ecma_string_t *original_str_p, /**< index */
-                                       ecma_string_t *search_str_p, /**< string's length */
+ecma_builtin_helper_string_find_index (const ecma_string_t *original_str_p, /**< original string */
+                                       const ecma_string_t *search_str_p, /**< search string */
                                        bool first_index, /**< whether search for first (t) or last (f) index */
                                        ecma_length_t start_pos, /**< start position */
                                        ecma_length_t *ret_index_p) /**< position found in original string */
@@ -572,77 +718,64 @@ ecma_builtin_helper_string_find_index (ecma_string_t *original_str_p, /**< index
     }
     else
     {
-      /* create utf8 string from original string and advance to position */
       ECMA_STRING_TO_UTF8_STRING (original_str_p, original_str_utf8_p, original_str_size);
-
-      ecma_length_t index = start_pos;
-
-      const lit_utf8_byte_t *original_str_curr_p = original_str_utf8_p;
-      for (ecma_length_t idx = 0; idx < index; idx++)
-      {
-        lit_utf8_incr (&original_str_curr_p);
-      }
-
-      /* create utf8 string from search string */
       ECMA_STRING_TO_UTF8_STRING (search_str_p, search_str_utf8_p, search_str_size);
 
-      const lit_utf8_byte_t *search_str_curr_p = search_str_utf8_p;
+      const bool is_ascii = (original_str_size == original_len);
+
+      /* Convert the start position to a byte offset. */
+      lit_utf8_size_t start_offset = start_pos;
 
-      /* iterate original string and try to match at each position */
-      bool searching = true;
-      ecma_char_t first_char = lit_utf8_read_next (&search_str_curr_p);
-      while (searching)
+      if (!is_ascii)
       {
-        /* match as long as possible */
-        ecma_length_t match_len = 0;
-        const lit_utf8_byte_t *stored_original_str_curr_p = original_str_curr_p;
+        const lit_utf8_byte_t *original_str_curr_p = original_str_utf8_p;
 
-        if (match_len < search_len &&
-            index + match_len < original_len &&
-            lit_utf8_read_next (&original_str_curr_p) == first_char)
+        for (ecma_length_t idx = 0; idx < start_pos; idx++)
         {
-          const lit_utf8_byte_t *nested_search_str_curr_p = search_str_curr_p;
-          match_len++;
-
-          while (match_len < search_len &&
-                 index + match_len < original_len &&
-                 lit_utf8_read_next (&original_str_curr_p) == lit_utf8_read_next (&nested_search_str_curr_p))
-          {
-            match_len++;
-          }
+          lit_utf8_incr (&original_str_curr_p);
         }
 
-        /* check for match */
-        if (match_len == search_len)
-        {
-          match_found = true;
-          *ret_index_p = index;
+        start_offset = (lit_utf8_size_t) (original_str_curr_p - original_str_utf8_p);
+      }
 
-          break;
-        }
-        else
+      lit_utf8_size_t match_offset;
+
+      if (first_index)
+      {
+        match_offset = ecma_builtin_helper_string_find_bytes (original_str_utf8_p + start_offset,
+                                                              original_str_size - start_offset,
+                                                              search_str_utf8_p,
+                                                              search_str_size);
+
+        if (match_offset < original_str_size - start_offset)
         {
-          /* inc/dec index and update iterators and search condition */
-          original_str_curr_p = stored_original_str_curr_p;
+          match_found = true;
+          *ret_index_p = start_pos;
 
-          if (first_index)
+          if (is_ascii)
           {
-            if ((searching = (index <= original_len - search_len)))
-            {
-              lit_utf8_incr (&original_str_curr_p);
-              index++;
-            }
+            *ret_index_p += match_offset;
           }
           else
           {
-            if ((searching = (index > 0)))
-            {
-              lit_utf8_decr (&original_str_curr_p);
-              index--;
-            }
+            *ret_index_p += lit_utf8_string_length (original_str_utf8_p + start_offset, match_offset);
           }
         }
       }
+      else
+      {
+        match_offset = ecma_builtin_helper_string_find_last_bytes (original_str_utf8_p,
+                                                                   original_str_size,
+                                                                   start_offset,
+                                                                   search_str_utf8_p,
+                                                                   search_str_size);
+
+        if (match_offset < original_str_size)
+        {
+          match_found = true;
+          *ret_index_p = is_ascii ? match_offset : lit_utf8_string_length (original_str_utf8_p, match_offset);
+        }
+      }
 
       ECMA_FINALIZE_UTF8_STRING (search_str_utf8_p, search_str_size);
       ECMA_FINALIZE_UTF8_STRING (original_str_utf8_p, original_str_size);
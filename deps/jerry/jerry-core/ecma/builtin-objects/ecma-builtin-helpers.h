@@ -42,8 +42,8 @@ ecma_value_t
 ecma_builtin_helper_string_prototype_object_index_of (ecma_value_t this_arg, ecma_value_t arg1,
                                                       ecma_value_t arg2, bool first_index);
 bool
-ecma_builtin_helper_string_find_index (ecma_string_t *original_str_p, ecma_string_t *search_str_p, bool first_index,
-                                       ecma_length_t start_pos, ecma_length_t *ret_index_p);
+ecma_builtin_helper_string_find_index (const ecma_string_t *original_str_p, const ecma_string_t *search_str_p,
+                                       bool first_index, ecma_length_t start_pos, ecma_length_t *ret_index_p);
 ecma_value_t
 ecma_builtin_helper_def_prop (ecma_object_t *obj_p, ecma_string_t *index_p, ecma_value_t value,
                               bool writable, bool enumerable, bool configurable, bool is_throw);
@@ -122,11 +122,24 @@ ecma_value_t ecma_date_value_to_time_string (ecma_number_t datetime_number);
 
 /* ecma-builtin-helper-json.c */
 
+/**
+ * Growable buffer of the text created by JSON.stringify()
+ */
+typedef struct
+{
+  lit_utf8_byte_t *data_p; /**< cesu-8 characters */
+  lit_utf8_size_t size; /**< number of bytes written */
+  lit_utf8_size_t capacity; /**< number of bytes allocated */
+} ecma_json_buffer_t;
+
 /**
  * Context for JSON.stringify()
  */
 typedef struct
 {
+  /** The JSON text. */
+  ecma_json_buffer_t buffer;
+
   /** Collection for property keys. */
   ecma_collection_header_t *property_list_p;
 
@@ -146,17 +159,14 @@ typedef struct
 bool ecma_has_object_value_in_collection (ecma_collection_header_t *collection_p, ecma_value_t object_value);
 bool ecma_has_string_value_in_collection (ecma_collection_header_t *collection_p, ecma_value_t string_value);
 
-ecma_string_t *
-ecma_builtin_helper_json_create_hex_digit_ecma_string (uint8_t value);
-ecma_string_t *
-ecma_builtin_helper_json_create_separated_properties (ecma_collection_header_t *partial_p, ecma_string_t *separator_p);
-ecma_value_t
-ecma_builtin_helper_json_create_formatted_json (ecma_string_t *left_bracket_p, ecma_string_t *right_bracket_p,
-                                                ecma_string_t *stepback_p, ecma_collection_header_t *partial_p,
-                                                ecma_json_stringify_context_t *context_p);
-ecma_value_t
-ecma_builtin_helper_json_create_non_formatted_json (ecma_string_t *left_bracket_p, ecma_string_t *right_bracket_p,
-                                                    ecma_collection_header_t *partial_p);
+void ecma_builtin_helper_json_buffer_init (ecma_json_buffer_t *buffer_p);
+void ecma_builtin_helper_json_buffer_free (ecma_json_buffer_t *buffer_p);
+void ecma_builtin_helper_json_buffer_append (ecma_json_buffer_t *buffer_p, const lit_utf8_byte_t *data_p,
+                                             lit_utf8_size_t size);
+void ecma_builtin_helper_json_buffer_append_char (ecma_json_buffer_t *buffer_p, lit_utf8_byte_t ch);
+void ecma_builtin_helper_json_buffer_append_magic (ecma_json_buffer_t *buffer_p, lit_magic_string_id_t id);
+void ecma_builtin_helper_json_buffer_append_string (ecma_json_buffer_t *buffer_p, ecma_string_t *string_p);
+ecma_string_t *ecma_builtin_helper_json_buffer_finalize (ecma_json_buffer_t *buffer_p);
 
 /* ecma-builtin-helper-error.c */
 
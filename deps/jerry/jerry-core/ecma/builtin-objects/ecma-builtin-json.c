@@ -536,6 +536,69 @@ ecma_builtin_json_define_value_property (ecma_object_t *obj_p, /**< this object
   JERRY_ASSERT (ecma_is_value_boolean (completion_value));
 } /* ecma_builtin_json_define_value_property */
 
+/**
+ * Add a member to an object created by the parser.
+ *
+ * All properties of the object are writable, enumerable and configurable
+ * data properties created by this function, so the steps of
+ * [[DefineOwnProperty]] are skipped. Later duplicates of a name overwrite
+ * the value, as the define would do.
+ */
+static void
+ecma_builtin_json_add_member (ecma_object_t *object_p, /**< object created by the parser */
+                              ecma_string_t *name_p, /**< member name */
+                              ecma_value_t value) /**< member value */
+{
+  ecma_property_t *property_p = ecma_find_named_property (object_p, name_p);
+
+  if (property_p != NULL)
+  {
+    ecma_named_data_property_assign_value (object_p, ECMA_PROPERTY_VALUE_PTR (property_p), value);
+    return;
+  }
+
+  ecma_property_value_t *prop_value_p = ecma_create_named_data_property (object_p,
+                                                                         name_p,
+                                                                         ECMA_PROPERTY_CONFIGURABLE_ENUMERABLE_WRITABLE,
+                                                                         NULL);
+  prop_value_p->value = ecma_copy_value_if_not_object (value);
+} /* ecma_builtin_json_add_member */
+
+/**
+ * Append an element to an array created by the parser.
+ *
+ * The elements are added in order, so the index is always a new property
+ * right after the end of the array.
+ */
+static void
+ecma_builtin_json_append_element (ecma_object_t *array_p, /**< array created by the parser */
+                                  ecma_value_t value) /**< element value */
+{
+  ecma_extended_object_t *ext_array_p = (ecma_extended_object_t *) array_p;
+  uint32_t index = ext_array_p->u.array.length;
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  if (ext_array_p->u.array.is_fast
+      && ecma_fast_array_add_element (array_p, index, value))
+  {
+    ext_array_p->u.array.length = index + 1;
+    return;
+  }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
+  ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
+
+  ecma_property_value_t *prop_value_p = ecma_create_named_data_property (array_p,
+                                                                         index_str_p,
+                                                                         ECMA_PROPERTY_CONFIGURABLE_ENUMERABLE_WRITABLE,
+                                                                         NULL);
+  prop_value_p->value = ecma_copy_value_if_not_object (value);
+
+  ecma_deref_ecma_string (index_str_p);
+
+  ext_array_p->u.array.length = index + 1;
+} /* ecma_builtin_json_append_element */
+
 /**
  * Parse next value.
  *
@@ -618,7 +681,7 @@ ecma_builtin_json_parse_value (ecma_json_token_t *token_p) /**< token argument *
           break;
         }
 
-        ecma_builtin_json_define_value_property (object_p, name_p, value);
+        ecma_builtin_json_add_member (object_p, name_p, value);
         ecma_deref_ecma_string (name_p);
         ecma_free_value (value);
 
@@ -634,7 +697,6 @@ ecma_builtin_json_parse_value (ecma_json_token_t *token_p) /**< token argument *
     case left_square_token:
     {
       bool parse_comma = false;
-      uint32_t length = 0;
 
       ecma_value_t array_construction = ecma_op_create_array_object (NULL, 0, false);
       JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (array_construction));
@@ -665,23 +727,9 @@ ecma_builtin_json_parse_value (ecma_json_token_t *token_p) /**< token argument *
           break;
         }
 
-        ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (length);
-
-        ecma_value_t completion = ecma_builtin_helper_def_prop (array_p,
-                                                                index_str_p,
-                                                                value,
-                                                                true, /* Writable */
-                                                                true, /* Enumerable */
-                                                                true, /* Configurable */
-                                                                false); /* Failure handling */
-
-        JERRY_ASSERT (ecma_is_value_true (completion));
-
-        ecma_deref_ecma_string (index_str_p);
-
+        ecma_builtin_json_append_element (array_p, value);
         ecma_free_value (value);
 
-        length++;
         parse_comma = true;
       }
 
@@ -900,6 +948,8 @@ ecma_builtin_json_stringify (ecma_value_t this_arg, /**< 'this' argument */
 
   ecma_json_stringify_context_t context;
 
+  ecma_builtin_helper_json_buffer_init (&context.buffer);
+
   /* 1. */
   context.occurence_stack_p = ecma_new_values_collection (NULL, 0, false);
 
@@ -1128,7 +1178,14 @@ ecma_builtin_json_stringify (ecma_value_t this_arg, /**< 'this' argument */
                       ecma_builtin_json_str (empty_str_p, obj_wrapper_p, &context),
                       ret_value);
 
-      ret_value = ecma_copy_value (str_val);
+      if (ecma_is_value_true (str_val))
+      {
+        ret_value = ecma_make_string_value (ecma_builtin_helper_json_buffer_finalize (&context.buffer));
+      }
+      else
+      {
+        ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+      }
 
       ECMA_FINALIZE (str_val);
 
@@ -1144,170 +1201,132 @@ ecma_builtin_json_stringify (ecma_value_t this_arg, /**< 'this' argument */
   ecma_free_values_collection (context.property_list_p, true);
   ecma_free_values_collection (context.occurence_stack_p, true);
 
+  ecma_builtin_helper_json_buffer_free (&context.buffer);
+
   return ret_value;
 } /* ecma_builtin_json_stringify */
 
 /**
  * Abstract operation 'Quote' defined in 15.12.3
  *
+ * The quoted string is appended to the buffer.
+ *
  * See also:
  *          ECMA-262 v5, 15.12.3
- *
- * @return ecma value
- *         Returned value must be freed with ecma_free_value.
  */
-static ecma_value_t
-ecma_builtin_json_quote (ecma_string_t *string_p) /**< string that should be quoted*/
+static void
+ecma_builtin_json_quote (ecma_json_buffer_t *buffer_p, /**< buffer */
+                         ecma_string_t *string_p) /**< string that should be quoted*/
 {
-  /* 1. */
-  ecma_string_t *quote_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_DOUBLE_QUOTE_CHAR);
-  ecma_ref_ecma_string (quote_str_p);
-  ecma_string_t *product_str_p = quote_str_p;
-  ecma_string_t *tmp_str_p;
-
   ECMA_STRING_TO_UTF8_STRING (string_p, string_buff, string_buff_size);
 
   const lit_utf8_byte_t *str_p = string_buff;
   const lit_utf8_byte_t *str_end_p = string_buff + string_buff_size;
+  const lit_utf8_byte_t *unescaped_start_p = str_p;
+
+  /* 1. */
+  ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_DOUBLE_QUOTE);
 
   while (str_p < str_end_p)
   {
-    ecma_char_t current_char = lit_utf8_read_next (&str_p);
+    /* All the escaped characters are ASCII, so the bytes of other characters are not decoded. */
+    lit_utf8_byte_t current_char = *str_p;
 
-    /* 2.a */
-    if (current_char == LIT_CHAR_BACKSLASH || current_char == LIT_CHAR_DOUBLE_QUOTE)
+    /* 2.d */
+    if (current_char != LIT_CHAR_BACKSLASH
+        && current_char != LIT_CHAR_DOUBLE_QUOTE
+        && current_char >= LIT_CHAR_SP)
     {
-      ecma_string_t *backslash_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_BACKSLASH_CHAR);
-
-      /* 2.a.i */
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, backslash_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (backslash_str_p);
-      product_str_p = tmp_str_p;
-
-      /* 2.a.ii */
-      ecma_string_t *current_char_str_p = ecma_new_ecma_string_from_code_unit (current_char);
-
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, current_char_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (current_char_str_p);
-      product_str_p = tmp_str_p;
+      str_p++;
+      continue;
     }
-    /* 2.b */
-    else if (current_char == LIT_CHAR_BS
-             || current_char == LIT_CHAR_FF
-             || current_char == LIT_CHAR_LF
-             || current_char == LIT_CHAR_CR
-             || current_char == LIT_CHAR_TAB)
-    {
-      ecma_string_t *backslash_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_BACKSLASH_CHAR);
 
-      /* 2.b.i */
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, backslash_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (backslash_str_p);
-      product_str_p = tmp_str_p;
+    ecma_builtin_helper_json_buffer_append (buffer_p,
+                                            unescaped_start_p,
+                                            (lit_utf8_size_t) (str_p - unescaped_start_p));
+    str_p++;
+    unescaped_start_p = str_p;
 
-      /* 2.b.ii */
-      lit_utf8_byte_t abbrev = LIT_CHAR_SP;
+    lit_utf8_byte_t escape_buff[6];
+    lit_utf8_size_t escape_size = 2;
 
-      switch (current_char)
-      {
-        case LIT_CHAR_BS:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_B;
-          break;
-        }
-        case LIT_CHAR_FF:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_F;
-          break;
-        }
-        case LIT_CHAR_LF:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_N;
-          break;
-        }
-        case LIT_CHAR_CR:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_R;
-          break;
-        }
-        case LIT_CHAR_TAB:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_T;
-          break;
-        }
-      }
+    escape_buff[0] = LIT_CHAR_BACKSLASH;
 
-      /* 2.b.iii */
-      ecma_string_t *abbrev_str_p = ecma_new_ecma_string_from_utf8 (&abbrev, 1);
-
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, abbrev_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (abbrev_str_p);
-      product_str_p = tmp_str_p;
-    }
-    /* 2.c */
-    else if (current_char < LIT_CHAR_SP)
+    switch (current_char)
     {
-      ecma_string_t *backslash_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_BACKSLASH_CHAR);
-
-      /* 2.c.i */
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, backslash_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (backslash_str_p);
-      product_str_p = tmp_str_p;
-
-      /* 2.c.ii */
-      lit_utf8_byte_t u_ch = LIT_CHAR_LOWERCASE_U;
-      ecma_string_t *u_ch_str_p = ecma_new_ecma_string_from_utf8 (&u_ch, 1);
-
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, u_ch_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (u_ch_str_p);
-      product_str_p = tmp_str_p;
-
-      /* 2.c.iii */
-      ecma_string_t *hex_str_p = ecma_builtin_helper_json_create_hex_digit_ecma_string ((uint8_t) current_char);
-
-      /* 2.c.iv */
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, hex_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (hex_str_p);
-      product_str_p = tmp_str_p;
+      /* 2.a */
+      case LIT_CHAR_BACKSLASH:
+      case LIT_CHAR_DOUBLE_QUOTE:
+      {
+        escape_buff[1] = current_char;
+        break;
+      }
+      /* 2.b */
+      case LIT_CHAR_BS:
+      {
+        escape_buff[1] = LIT_CHAR_LOWERCASE_B;
+        break;
+      }
+      case LIT_CHAR_FF:
+      {
+        escape_buff[1] = LIT_CHAR_LOWERCASE_F;
+        break;
+      }
+      case LIT_CHAR_LF:
+      {
+        escape_buff[1] = LIT_CHAR_LOWERCASE_N;
+        break;
+      }
+      case LIT_CHAR_CR:
+      {
+        escape_buff[1] = LIT_CHAR_LOWERCASE_R;
+        break;
+      }
+      case LIT_CHAR_TAB:
+      {
+        escape_buff[1] = LIT_CHAR_LOWERCASE_T;
+        break;
+      }
+      /* 2.c */
+      default:
+      {
+        escape_buff[1] = LIT_CHAR_LOWERCASE_U;
+        escape_buff[2] = LIT_CHAR_0;
+        escape_buff[3] = LIT_CHAR_0;
+        escape_buff[4] = (lit_utf8_byte_t) (LIT_CHAR_0 + (current_char >> 4));
+
+        uint8_t low_digit = (uint8_t) (current_char & 0xf);
+        escape_buff[5] = (lit_utf8_byte_t) ((low_digit < 10) ? (LIT_CHAR_0 + low_digit)
+                                                                : (LIT_CHAR_LOWERCASE_A + low_digit - 10));
+        escape_size = 6;
+        break;
+      }
     }
-    /* 2.d */
-    else
-    {
-      ecma_string_t *current_char_str_p = ecma_new_ecma_string_from_code_unit (current_char);
 
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, current_char_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (current_char_str_p);
-      product_str_p = tmp_str_p;
-    }
+    ecma_builtin_helper_json_buffer_append (buffer_p, escape_buff, escape_size);
   }
 
+  ecma_builtin_helper_json_buffer_append (buffer_p,
+                                          unescaped_start_p,
+                                          (lit_utf8_size_t) (str_end_p - unescaped_start_p));
+
   ECMA_FINALIZE_UTF8_STRING (string_buff, string_buff_size);
 
   /* 3. */
-  tmp_str_p = ecma_concat_ecma_strings (product_str_p, quote_str_p);
-  ecma_deref_ecma_string (product_str_p);
-  ecma_deref_ecma_string (quote_str_p);
-  product_str_p = tmp_str_p;
-
-  /* 4. */
-  return ecma_make_string_value (product_str_p);
+  ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_DOUBLE_QUOTE);
 } /* ecma_builtin_json_quote */
 
 /**
  * Abstract operation 'Str' defined in 15.12.3
  *
+ * The result string is appended to the buffer of the context.
+ *
  * See also:
  *          ECMA-262 v5, 15.12.3
  *
- * @return ecma value
+ * @return ecma value - true, if the value is appended to the buffer
+ *                    - undefined, if the value has no JSON representation
+ *                    - error, otherwise
  *         Returned value must be freed with ecma_free_value.
  */
 static ecma_value_t
@@ -1420,17 +1439,27 @@ ecma_builtin_json_str (ecma_string_t *key_p, /**< property key*/
 
   if (ecma_is_value_empty (ret_value))
   {
-    /* 5. - 7. */
-    if (ecma_is_value_null (my_val) || ecma_is_value_boolean (my_val))
+    ecma_json_buffer_t *buffer_p = &context_p->buffer;
+
+    ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+
+    /* 5. */
+    if (ecma_is_value_null (my_val))
+    {
+      ecma_builtin_helper_json_buffer_append_magic (buffer_p, LIT_MAGIC_STRING_NULL);
+    }
+    /* 6. - 7. */
+    else if (ecma_is_value_boolean (my_val))
     {
-      ret_value = ecma_op_to_string (my_val);
-      JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (ret_value));
+      ecma_builtin_helper_json_buffer_append_magic (buffer_p,
+                                                    (ecma_is_value_true (my_val) ? LIT_MAGIC_STRING_TRUE
+                                                                                 : LIT_MAGIC_STRING_FALSE));
     }
     /* 8. */
     else if (ecma_is_value_string (my_val))
     {
       ecma_string_t *value_str_p = ecma_get_string_from_value (my_val);
-      ret_value = ecma_builtin_json_quote (value_str_p);
+      ecma_builtin_json_quote (buffer_p, value_str_p);
     }
     /* 9. */
     else if (ecma_is_value_number (my_val))
@@ -1440,14 +1469,15 @@ ecma_builtin_json_str (ecma_string_t *key_p, /**< property key*/
       /* 9.a */
       if (!ecma_number_is_nan (num_value_p) && !ecma_number_is_infinity (num_value_p))
       {
-        ret_value = ecma_op_to_string (my_val);
-        JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (ret_value));
+        lit_utf8_byte_t num_buff[ECMA_MAX_CHARS_IN_STRINGIFIED_NUMBER];
+        lit_utf8_size_t num_size = ecma_number_to_utf8_string (num_value_p, num_buff, sizeof (num_buff));
+
+        ecma_builtin_helper_json_buffer_append (buffer_p, num_buff, num_size);
       }
       else
       {
         /* 9.b */
-        ecma_string_t *null_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_NULL);
-        ret_value = ecma_make_string_value (null_str_p);
+        ecma_builtin_helper_json_buffer_append_magic (buffer_p, LIT_MAGIC_STRING_NULL);
       }
     }
     /* 10. */
@@ -1459,24 +1489,12 @@ ecma_builtin_json_str (ecma_string_t *key_p, /**< property key*/
       /* 10.a */
       if (class_name == LIT_MAGIC_STRING_ARRAY_UL)
       {
-        ECMA_TRY_CATCH (val,
-                        ecma_builtin_json_array (obj_p, context_p),
-                        ret_value);
-
-        ret_value = ecma_copy_value (val);
-
-        ECMA_FINALIZE (val);
+        ret_value = ecma_builtin_json_array (obj_p, context_p);
       }
       /* 10.b */
       else
       {
-        ECMA_TRY_CATCH (val,
-                        ecma_builtin_json_object (obj_p, context_p),
-                        ret_value);
-
-        ret_value = ecma_copy_value (val);
-
-        ECMA_FINALIZE (val);
+        ret_value = ecma_builtin_json_object (obj_p, context_p);
       }
     }
     else
@@ -1495,10 +1513,13 @@ ecma_builtin_json_str (ecma_string_t *key_p, /**< property key*/
 /**
  * Abstract operation 'JO' defined in 15.12.3
  *
+ * The members are appended to the buffer of the context as they are created.
+ *
  * See also:
  *          ECMA-262 v5, 15.12.3
  *
- * @return ecma value
+ * @return ecma value - true, if the object is appended to the buffer
+ *                    - error, otherwise
  *         Returned value must be freed with ecma_free_value.
  */
 static ecma_value_t
@@ -1536,7 +1557,8 @@ ecma_builtin_json_object (ecma_object_t *obj_p, /**< the object*/
   {
     property_keys_p = ecma_new_values_collection (NULL, 0, true);
 
-    ecma_collection_header_t *props_p = ecma_op_object_get_property_names (obj_p, false, true, false);
+    bool is_shared;
+    ecma_collection_header_t *props_p = ecma_op_object_get_enumerable_property_names (obj_p, false, &is_shared);
 
     ecma_collection_iterator_t iter;
     ecma_collection_iterator_init (&iter, props_p);
@@ -1558,11 +1580,15 @@ ecma_builtin_json_object (ecma_object_t *obj_p, /**< the object*/
       }
     }
 
-    ecma_free_values_collection (props_p, true);
+    ecma_op_object_free_enumerable_property_names (props_p, is_shared);
   }
 
   /* 7. */
-  ecma_collection_header_t *partial_p = ecma_new_values_collection (NULL, 0, true);
+  ecma_json_buffer_t *buffer_p = &context_p->buffer;
+  bool is_gap_empty = ecma_string_is_empty (context_p->gap_str_p);
+  bool has_members = false;
+
+  ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_LEFT_BRACE);
 
   /* 8. */
   ecma_collection_iterator_t iterator;
@@ -1573,50 +1599,46 @@ ecma_builtin_json_object (ecma_object_t *obj_p, /**< the object*/
     ecma_value_t value = *iterator.current_value_p;
     ecma_string_t *key_p = ecma_get_string_from_value (value);
 
-    /* 8.a */
-    ECMA_TRY_CATCH (str_val,
-                    ecma_builtin_json_str (key_p, obj_p, context_p),
-                    ret_value);
+    /* The member is written before its value, and removed if the value is undefined. */
+    lit_utf8_size_t member_start = buffer_p->size;
 
-    /* 8.b */
-    if (!ecma_is_value_undefined (str_val))
+    /* 10.a.i, 10.b.i - 10.b.iii */
+    if (has_members)
     {
-      ecma_string_t *colon_p = ecma_get_magic_string (LIT_MAGIC_STRING_COLON_CHAR);
-      ecma_string_t *value_str_p = ecma_get_string_from_value (str_val);
-      ecma_string_t *tmp_str_p;
-
-      /* 8.b.i */
-      ecma_value_t str_comp_val = ecma_builtin_json_quote (key_p);
-      JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (str_comp_val));
+      ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_COMMA);
+    }
 
-      ecma_string_t *member_str_p = ecma_get_string_from_value (str_comp_val);
+    if (!is_gap_empty)
+    {
+      ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_LF);
+      ecma_builtin_helper_json_buffer_append_string (buffer_p, context_p->indent_str_p);
+    }
 
-      /* 8.b.ii */
-      tmp_str_p = ecma_concat_ecma_strings (member_str_p, colon_p);
-      ecma_free_value (str_comp_val);
-      ecma_deref_ecma_string (colon_p);
-      member_str_p = tmp_str_p;
+    /* 8.b.i */
+    ecma_builtin_json_quote (buffer_p, key_p);
 
-      /* 8.b.iii */
-      if (!ecma_string_is_empty (context_p->gap_str_p))
-      {
-        ecma_string_t *space_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_SPACE_CHAR);
+    /* 8.b.ii */
+    ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_COLON);
 
-        tmp_str_p = ecma_concat_ecma_strings (member_str_p, space_str_p);
-        ecma_deref_ecma_string (member_str_p);
-        ecma_deref_ecma_string (space_str_p);
-        member_str_p = tmp_str_p;
-      }
+    /* 8.b.iii */
+    if (!is_gap_empty)
+    {
+      ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_SP);
+    }
 
-      /* 8.b.iv */
-      tmp_str_p = ecma_concat_ecma_strings (member_str_p, value_str_p);
-      ecma_deref_ecma_string (member_str_p);
-      member_str_p = tmp_str_p;
+    /* 8.a, 8.b.iv */
+    ECMA_TRY_CATCH (str_val,
+                    ecma_builtin_json_str (key_p, obj_p, context_p),
+                    ret_value);
 
-      /* 8.b.v */
-      ecma_value_t member_value = ecma_make_string_value (member_str_p);
-      ecma_append_to_values_collection (partial_p, member_value, true);
-      ecma_deref_ecma_string (member_str_p);
+    /* 8.b */
+    if (ecma_is_value_undefined (str_val))
+    {
+      buffer_p->size = member_start;
+    }
+    else
+    {
+      has_members = true;
     }
 
     ECMA_FINALIZE (str_val);
@@ -1629,57 +1651,20 @@ ecma_builtin_json_object (ecma_object_t *obj_p, /**< the object*/
 
   if (!ecma_is_value_empty (ret_value))
   {
-    ecma_free_values_collection (partial_p, true);
     ecma_deref_ecma_string (stepback_p);
     return ret_value;
   }
 
-  /* 9. */
-  if (partial_p->unit_number == 0)
-  {
-    ecma_string_t *left_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_BRACE_CHAR);
-    ecma_string_t *right_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_BRACE_CHAR);
-
-    ecma_string_t *final_str_p = ecma_concat_ecma_strings (left_brace_str_p, right_brace_str_p);
-    ret_value = ecma_make_string_value (final_str_p);
-
-    ecma_deref_ecma_string (left_brace_str_p);
-    ecma_deref_ecma_string (right_brace_str_p);
-  }
-  /* 10. */
-  else
+  /* 9. - 10. */
+  if (has_members && !is_gap_empty)
   {
-    /* 10.a */
-    if (ecma_string_is_empty (context_p->gap_str_p))
-    {
-      ecma_string_t *left_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_BRACE_CHAR);
-      ecma_string_t *right_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_BRACE_CHAR);
-
-      ret_value = ecma_builtin_helper_json_create_non_formatted_json (left_brace_str_p,
-                                                                      right_brace_str_p,
-                                                                      partial_p);
-
-      ecma_deref_ecma_string (left_brace_str_p);
-      ecma_deref_ecma_string (right_brace_str_p);
-    }
-    /* 10.b */
-    else
-    {
-      ecma_string_t *left_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_BRACE_CHAR);
-      ecma_string_t *right_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_BRACE_CHAR);
-
-      ret_value = ecma_builtin_helper_json_create_formatted_json (left_brace_str_p,
-                                                                  right_brace_str_p,
-                                                                  stepback_p,
-                                                                  partial_p,
-                                                                  context_p);
-
-      ecma_deref_ecma_string (left_brace_str_p);
-      ecma_deref_ecma_string (right_brace_str_p);
-    }
+    /* 10.b.iii */
+    ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_LF);
+    ecma_builtin_helper_json_buffer_append_string (buffer_p, stepback_p);
   }
 
-  ecma_free_values_collection (partial_p, true);
+  ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_RIGHT_BRACE);
+  ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
 
   /* 11. */
   ecma_remove_last_value_from_values_collection (context_p->occurence_stack_p);
@@ -1695,10 +1680,13 @@ ecma_builtin_json_object (ecma_object_t *obj_p, /**< the object*/
 /**
  * Abstract operation 'JA' defined in 15.12.3
  *
+ * The elements are appended to the buffer of the context as they are created.
+ *
  * See also:
  *          ECMA-262 v5, 15.12.3
  *
- * @return ecma value
+ * @return ecma value - true, if the array is appended to the buffer
+ *                    - error, otherwise
  *         Returned value must be freed with ecma_free_value.
  */
 static ecma_value_t
@@ -1725,7 +1713,10 @@ ecma_builtin_json_array (ecma_object_t *obj_p, /**< the array object*/
   context_p->indent_str_p = ecma_concat_ecma_strings (context_p->indent_str_p, context_p->gap_str_p);
 
   /* 5. */
-  ecma_collection_header_t *partial_p = ecma_new_values_collection (NULL, 0, true);
+  ecma_json_buffer_t *buffer_p = &context_p->buffer;
+  bool is_gap_empty = ecma_string_is_empty (context_p->gap_str_p);
+
+  ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_LEFT_SQUARE);
 
   ecma_string_t *length_str_p = ecma_new_ecma_length_string ();
 
@@ -1738,11 +1729,24 @@ ecma_builtin_json_array (ecma_object_t *obj_p, /**< the array object*/
                                array_length,
                                ret_value);
 
+  uint32_t length = ecma_number_to_uint32 (array_length_num);
+
   /* 7. - 8. */
   for (uint32_t index = 0;
-       index < ecma_number_to_uint32 (array_length_num) && ecma_is_value_empty (ret_value);
+       index < length && ecma_is_value_empty (ret_value);
        index++)
   {
+    /* 10.a.i, 10.b.i - 10.b.iii */
+    if (index > 0)
+    {
+      ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_COMMA);
+    }
+
+    if (!is_gap_empty)
+    {
+      ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_LF);
+      ecma_builtin_helper_json_buffer_append_string (buffer_p, context_p->indent_str_p);
+    }
 
     /* 8.a */
     ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
@@ -1754,73 +1758,33 @@ ecma_builtin_json_array (ecma_object_t *obj_p, /**< the array object*/
     /* 8.b */
     if (ecma_is_value_undefined (str_val))
     {
-      ecma_string_t *null_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_NULL);
-      ecma_append_to_values_collection (partial_p, ecma_make_string_value (null_str_p), true);
-      ecma_deref_ecma_string (null_str_p);
-    }
-    /* 8.c */
-    else
-    {
-      ecma_append_to_values_collection (partial_p, str_val, true);
+      ecma_builtin_helper_json_buffer_append_magic (buffer_p, LIT_MAGIC_STRING_NULL);
     }
 
+    /* 8.c: the value is already appended. */
+
     ECMA_FINALIZE (str_val);
     ecma_deref_ecma_string (index_str_p);
   }
 
   if (ecma_is_value_empty (ret_value))
   {
-    /* 9. */
-    if (partial_p->unit_number == 0)
+    /* 9. - 10. */
+    if (length > 0 && !is_gap_empty)
     {
-      ecma_string_t *left_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_SQUARE_CHAR);
-      ecma_string_t *right_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_SQUARE_CHAR);
-
-      ecma_string_t *final_str_p = ecma_concat_ecma_strings (left_square_str_p, right_square_str_p);
-      ret_value = ecma_make_string_value (final_str_p);
-
-      ecma_deref_ecma_string (left_square_str_p);
-      ecma_deref_ecma_string (right_square_str_p);
+      /* 10.b.iii */
+      ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_LF);
+      ecma_builtin_helper_json_buffer_append_string (buffer_p, stepback_p);
     }
-    /* 10. */
-    else
-    {
-      /* 10.a */
-      if (ecma_string_is_empty (context_p->gap_str_p))
-      {
-        ecma_string_t *left_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_SQUARE_CHAR);
-        ecma_string_t *right_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_SQUARE_CHAR);
-
-        ret_value = ecma_builtin_helper_json_create_non_formatted_json (left_square_str_p,
-                                                                        right_square_str_p,
-                                                                        partial_p);
 
-        ecma_deref_ecma_string (left_square_str_p);
-        ecma_deref_ecma_string (right_square_str_p);
-      }
-      /* 10.b */
-      else
-      {
-        ecma_string_t *left_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_SQUARE_CHAR);
-        ecma_string_t *right_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_SQUARE_CHAR);
-
-        ret_value = ecma_builtin_helper_json_create_formatted_json (left_square_str_p,
-                                                                    right_square_str_p,
-                                                                    stepback_p,
-                                                                    partial_p,
-                                                                    context_p);
-
-        ecma_deref_ecma_string (left_square_str_p);
-        ecma_deref_ecma_string (right_square_str_p);
-      }
-    }
+    ecma_builtin_helper_json_buffer_append_char (buffer_p, LIT_CHAR_RIGHT_SQUARE);
+    ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
   }
 
   ECMA_OP_TO_NUMBER_FINALIZE (array_length_num);
   ECMA_FINALIZE (array_length);
 
   ecma_deref_ecma_string (length_str_p);
-  ecma_free_values_collection (partial_p, true);
 
   /* 11. */
   ecma_remove_last_value_from_values_collection (context_p->occurence_stack_p);
@@ -189,6 +189,7 @@ ecma_set_prototype_of (ecma_value_t o_value, /**< O */
   }
 
   /* 9. */
+  ECMA_GC_WRITE_BARRIER (o_p);
   ECMA_SET_POINTER (o_p->prototype_or_outer_reference_cp, v_p);
 
   /* 10. */
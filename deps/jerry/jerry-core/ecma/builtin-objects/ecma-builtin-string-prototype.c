@@ -1661,23 +1661,29 @@ ecma_builtin_string_prototype_object_split (ecma_value_t this_arg, /**< this arg
           else
           {
             ecma_string_t *separator_str_p = ecma_get_string_from_value (separator);
-            ecma_length_t separator_length = ecma_string_get_length (separator_str_p);
+            ecma_length_t match_pos = curr_pos;
 
-            if (curr_pos + separator_length <= string_length)
+            if (ecma_string_is_empty (separator_str_p))
             {
-              bool is_different = false;
-              for (ecma_length_t i = 0; i < separator_length && !is_different; i++)
-              {
-                ecma_char_t char_from_string = ecma_string_get_char_at_pos (this_to_string_p, curr_pos + i);
-                ecma_char_t char_from_separator = ecma_string_get_char_at_pos (separator_str_p, i);
-                is_different = (char_from_string != char_from_separator);
-              }
+              /* 6-7. */
+              match_result = ecma_op_create_array_object (0, 0, false);
+            }
+            else if (ecma_builtin_helper_string_find_index (this_to_string_p,
+                                                            separator_str_p,
+                                                            true,
+                                                            curr_pos,
+                                                            &match_pos))
+            {
+              /* The positions before the next occurrence of the separator cannot match. */
+              curr_pos = match_pos;
 
-              if (!is_different)
-              {
-                /* 6-7. */
-                match_result = ecma_op_create_array_object (0, 0, false);
-              }
+              /* 6-7. */
+              match_result = ecma_op_create_array_object (0, 0, false);
+            }
+            else
+            {
+              /* No more matches, the loop terminates. */
+              curr_pos = string_length;
             }
           }
 
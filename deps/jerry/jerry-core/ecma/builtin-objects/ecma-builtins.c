@@ -213,6 +213,11 @@ ecma_builtin_init_object (ecma_builtin_id_t obj_builtin_id, /**< built-in ID */
 
       ext_object_p->u.array.length = 0;
       ext_object_p->u.array.length_prop = ECMA_PROPERTY_FLAG_WRITABLE | ECMA_PROPERTY_TYPE_VIRTUAL;
+#ifdef CONFIG_ECMA_FAST_ARRAY
+      /* Built-in arrays are never fast, as their properties are instantiated lazily. */
+      ext_object_p->u.array.is_fast = false;
+      ext_object_p->u.array.elements_cp = JMEM_CP_NULL;
+#endif /* CONFIG_ECMA_FAST_ARRAY */
       break;
     }
 #endif /* !CONFIG_DISABLE_ARRAY_BUILTIN */
@@ -32,6 +32,465 @@
  * @{
  */
 
+#ifdef CONFIG_ECMA_FAST_ARRAY
+
+/**
+ * Maximum number of holes a new element of a fast array may leave after the element slots
+ */
+#define ECMA_FAST_ARRAY_MAX_NEW_HOLES 32
+
+/**
+ * Check whether the object is an array which stores its elements in an elements buffer
+ *
+ * @return true - if the object is a fast array,
+ *         false - otherwise
+ */
+inline bool __attr_always_inline___
+ecma_op_array_is_fast_array (ecma_object_t *object_p) /**< object */
+{
+  return (ecma_get_object_type (object_p) == ECMA_OBJECT_TYPE_ARRAY
+          && ((ecma_extended_object_t *) object_p)->u.array.is_fast);
+} /* ecma_op_array_is_fast_array */
+
+/**
+ * Get the elements buffer of a fast array
+ *
+ * @return pointer to the buffer header - if the array has element slots,
+ *         NULL - otherwise
+ */
+static inline ecma_fast_array_header_t * __attr_always_inline___
+ecma_fast_array_get_header (ecma_object_t *object_p) /**< fast array */
+{
+  JERRY_ASSERT (ecma_op_array_is_fast_array (object_p));
+
+  return ECMA_GET_POINTER (ecma_fast_array_header_t, ((ecma_extended_object_t *) object_p)->u.array.elements_cp);
+} /* ecma_fast_array_get_header */
+
+/**
+ * Reallocate the elements buffer of a fast array with a new number of element slots
+ *
+ * Note:
+ *      the elements beyond the new capacity must be freed before,
+ *      and the new element slots are holes
+ *
+ * @return true - if the buffer is reallocated,
+ *         false - if there is not enough memory, and the buffer is unchanged
+ */
+static bool
+ecma_fast_array_set_capacity (ecma_object_t *object_p, /**< fast array */
+                              uint32_t new_capacity) /**< new number of element slots */
+{
+  ecma_fast_array_header_t *new_header_p = NULL;
+
+  if (new_capacity > 0)
+  {
+    new_header_p = (ecma_fast_array_header_t *) jmem_heap_alloc_block_null_on_error (
+                                                  ECMA_FAST_ARRAY_BUFFER_SIZE (new_capacity));
+
+    if (new_header_p == NULL)
+    {
+      return false;
+    }
+  }
+
+  /* The allocation might have run the garbage collector, which does not move the old buffer though. */
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+  uint32_t old_capacity = (header_p != NULL) ? header_p->capacity : 0;
+
+  if (new_header_p != NULL)
+  {
+    ecma_value_t *new_elements_p = ECMA_FAST_ARRAY_GET_ELEMENTS (new_header_p);
+    uint32_t copied_count = JERRY_MIN (old_capacity, new_capacity);
+
+    new_header_p->capacity = new_capacity;
+
+    if (copied_count > 0)
+    {
+      memcpy (new_elements_p, ECMA_FAST_ARRAY_GET_ELEMENTS (header_p), copied_count * sizeof (ecma_value_t));
+    }
+
+    for (uint32_t index = copied_count; index < new_capacity; index++)
+    {
+      new_elements_p[index] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_ARRAY_HOLE);
+    }
+  }
+
+  if (header_p != NULL)
+  {
+    jmem_heap_free_block (header_p, ECMA_FAST_ARRAY_BUFFER_SIZE (old_capacity));
+  }
+
+  ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+  ECMA_SET_POINTER (ext_object_p->u.array.elements_cp, new_header_p);
+  return true;
+} /* ecma_fast_array_set_capacity */
+
+/**
+ * Get an element of a fast array
+ *
+ * @return value of the element - if the element exists,
+ *         ECMA_SIMPLE_VALUE_ARRAY_HOLE - otherwise
+ *         Returned value is not copied
+ */
+ecma_value_t
+ecma_fast_array_get_element (ecma_object_t *object_p, /**< fast array */
+                             uint32_t index) /**< element index */
+{
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+
+  if (header_p == NULL || index >= header_p->capacity)
+  {
+    return ecma_make_simple_value (ECMA_SIMPLE_VALUE_ARRAY_HOLE);
+  }
+
+  return ECMA_FAST_ARRAY_GET_ELEMENTS (header_p)[index];
+} /* ecma_fast_array_get_element */
+
+/**
+ * Assign a new value to an existing element of a fast array
+ *
+ * @return true - if the element exists and it is assigned,
+ *         false - otherwise
+ */
+bool
+ecma_fast_array_assign_element (ecma_object_t *object_p, /**< fast array */
+                                uint32_t index, /**< element index */
+                                ecma_value_t value) /**< value to assign */
+{
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+
+  if (header_p == NULL || index >= header_p->capacity)
+  {
+    return false;
+  }
+
+  ecma_value_t *element_p = ECMA_FAST_ARRAY_GET_ELEMENTS (header_p) + index;
+
+  if (ecma_is_value_array_hole (*element_p))
+  {
+    return false;
+  }
+
+  ECMA_GC_WRITE_BARRIER (object_p);
+
+  ecma_value_assign_value (element_p, value);
+  return true;
+} /* ecma_fast_array_assign_element */
+
+/**
+ * Add a new element to a fast array
+ *
+ * Note:
+ *      the length of the array is not updated, and the array is converted to the
+ *      property form if the element would leave too many holes or there is not
+ *      enough memory to grow the elements buffer
+ *
+ * @return true - if the element is stored in the elements buffer,
+ *         false - if the array is converted, so the element must be created as a property
+ */
+bool
+ecma_fast_array_add_element (ecma_object_t *object_p, /**< fast array */
+                             uint32_t index, /**< element index */
+                             ecma_value_t value) /**< element value */
+{
+  JERRY_ASSERT (ecma_is_value_array_hole (ecma_fast_array_get_element (object_p, index)));
+
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+  uint32_t capacity = (header_p != NULL) ? header_p->capacity : 0;
+
+  if (index >= capacity)
+  {
+    uint32_t required_capacity = index + 1;
+    uint32_t new_capacity = required_capacity + (required_capacity >> 1);
+
+    if (index - capacity >= ECMA_FAST_ARRAY_MAX_NEW_HOLES
+        || (!ecma_fast_array_set_capacity (object_p, new_capacity)
+            && !ecma_fast_array_set_capacity (object_p, required_capacity)))
+    {
+      ecma_fast_array_convert_to_normal (object_p);
+      return false;
+    }
+
+    header_p = ecma_fast_array_get_header (object_p);
+  }
+
+  ECMA_GC_WRITE_BARRIER (object_p);
+
+  ECMA_FAST_ARRAY_GET_ELEMENTS (header_p)[index] = ecma_copy_value_if_not_object (value);
+  return true;
+} /* ecma_fast_array_add_element */
+
+/**
+ * Delete an element of a fast array
+ *
+ * Note:
+ *      holes are left in place, so indices of the other elements are kept
+ */
+void
+ecma_fast_array_delete_element (ecma_object_t *object_p, /**< fast array */
+                                uint32_t index) /**< element index */
+{
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+
+  if (header_p != NULL && index < header_p->capacity)
+  {
+    ecma_value_t *element_p = ECMA_FAST_ARRAY_GET_ELEMENTS (header_p) + index;
+
+    ecma_free_value_if_not_object (*element_p);
+    *element_p = ecma_make_simple_value (ECMA_SIMPLE_VALUE_ARRAY_HOLE);
+  }
+} /* ecma_fast_array_delete_element */
+
+/**
+ * Delete the elements of a fast array from the specified new length
+ *
+ * Note:
+ *      the length of the array is not updated, and the elements buffer
+ *      shrinks if at most half of its slots remain
+ */
+void
+ecma_fast_array_set_length (ecma_object_t *object_p, /**< fast array */
+                            uint32_t new_length) /**< new length */
+{
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+
+  if (header_p == NULL || new_length >= header_p->capacity)
+  {
+    return;
+  }
+
+  ecma_value_t *elements_p = ECMA_FAST_ARRAY_GET_ELEMENTS (header_p);
+
+  for (uint32_t index = new_length; index < header_p->capacity; index++)
+  {
+    ecma_free_value_if_not_object (elements_p[index]);
+    elements_p[index] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_ARRAY_HOLE);
+  }
+
+  if (new_length <= header_p->capacity / 2)
+  {
+    /* The holes are kept if the smaller buffer cannot be allocated. */
+    ecma_fast_array_set_capacity (object_p, new_length);
+  }
+} /* ecma_fast_array_set_length */
+
+/**
+ * Check whether all elements of a fast array below its length exist
+ *
+ * Note:
+ *      the elements of a dense fast array are read and written without looking
+ *      up the prototype chain, since the array has no holes
+ *
+ * @return true - if the array has no holes below its length,
+ *         false - otherwise
+ */
+bool
+ecma_fast_array_is_dense (ecma_object_t *object_p) /**< fast array */
+{
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+  uint32_t length = ((ecma_extended_object_t *) object_p)->u.array.length;
+
+  if (length == 0)
+  {
+    return true;
+  }
+
+  if (header_p == NULL || length > header_p->capacity)
+  {
+    return false;
+  }
+
+  ecma_value_t *elements_p = ECMA_FAST_ARRAY_GET_ELEMENTS (header_p);
+
+  for (uint32_t index = 0; index < length; index++)
+  {
+    if (ecma_is_value_array_hole (elements_p[index]))
+    {
+      return false;
+    }
+  }
+
+  return true;
+} /* ecma_fast_array_is_dense */
+
+/**
+ * Replace a range of the elements of a dense fast array with new elements
+ *
+ * Note:
+ *      the removed elements are freed, the following elements are moved to their
+ *      new place, and the length of the array is updated
+ *
+ * @return true - if the elements are replaced,
+ *         false - if there is not enough memory, and the array is unchanged
+ */
+bool
+ecma_fast_array_splice (ecma_object_t *object_p, /**< dense fast array */
+                        uint32_t start, /**< index of the first removed element */
+                        uint32_t delete_count, /**< number of removed elements */
+                        const ecma_value_t *items_p, /**< new elements */
+                        uint32_t item_count) /**< number of new elements */
+{
+  JERRY_ASSERT (ecma_fast_array_is_dense (object_p));
+
+  ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+  uint32_t old_length = ext_object_p->u.array.length;
+
+  JERRY_ASSERT (start <= old_length && delete_count <= old_length - start);
+  JERRY_ASSERT (item_count <= UINT32_MAX - (old_length - delete_count));
+
+  uint32_t new_length = old_length - delete_count + item_count;
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+  uint32_t capacity = (header_p != NULL) ? header_p->capacity : 0;
+
+  if (new_length > capacity)
+  {
+    if (!ecma_fast_array_set_capacity (object_p, new_length + (new_length >> 1))
+        && !ecma_fast_array_set_capacity (object_p, new_length))
+    {
+      return false;
+    }
+
+    header_p = ecma_fast_array_get_header (object_p);
+  }
+
+  if (new_length == 0 && old_length == 0)
+  {
+    return true;
+  }
+
+  JERRY_ASSERT (header_p != NULL);
+
+  ECMA_GC_WRITE_BARRIER (object_p);
+
+  ecma_value_t *elements_p = ECMA_FAST_ARRAY_GET_ELEMENTS (header_p);
+
+  for (uint32_t index = start; index < start + delete_count; index++)
+  {
+    ecma_free_value_if_not_object (elements_p[index]);
+  }
+
+  memmove (elements_p + start + item_count,
+           elements_p + start + delete_count,
+           (old_length - start - delete_count) * sizeof (ecma_value_t));
+
+  for (uint32_t index = 0; index < item_count; index++)
+  {
+    elements_p[start + index] = ecma_copy_value_if_not_object (items_p[index]);
+  }
+
+  for (uint32_t index = new_length; index < old_length; index++)
+  {
+    elements_p[index] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_ARRAY_HOLE);
+  }
+
+  ext_object_p->u.array.length = new_length;
+
+  /* The buffer shrinks if the array lost most of its elements. */
+  ecma_fast_array_set_length (object_p, new_length);
+  return true;
+} /* ecma_fast_array_splice */
+
+/**
+ * Convert a fast array to the property form
+ *
+ * The elements become writable, enumerable and configurable data properties.
+ */
+void
+ecma_fast_array_convert_to_normal (ecma_object_t *object_p) /**< fast array */
+{
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+
+  if (header_p != NULL)
+  {
+    ecma_value_t *elements_p = ECMA_FAST_ARRAY_GET_ELEMENTS (header_p);
+
+    for (uint32_t index = 0; index < header_p->capacity; index++)
+    {
+      if (ecma_is_value_array_hole (elements_p[index]))
+      {
+        continue;
+      }
+
+      ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
+
+      ecma_property_value_t *prop_value_p;
+      prop_value_p = ecma_create_named_data_property (object_p,
+                                                      index_str_p,
+                                                      ECMA_PROPERTY_CONFIGURABLE_ENUMERABLE_WRITABLE,
+                                                      NULL);
+
+      ecma_deref_ecma_string (index_str_p);
+
+      /* The reference is moved to the property, the slot is cleared for the garbage collector. */
+      prop_value_p->value = elements_p[index];
+      elements_p[index] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_ARRAY_HOLE);
+    }
+
+    jmem_heap_free_block (header_p, ECMA_FAST_ARRAY_BUFFER_SIZE (header_p->capacity));
+  }
+
+  ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+  ext_object_p->u.array.is_fast = false;
+  ext_object_p->u.array.elements_cp = JMEM_CP_NULL;
+} /* ecma_fast_array_convert_to_normal */
+
+/**
+ * Free the elements buffer of a fast array
+ */
+void
+ecma_fast_array_free_elements (ecma_object_t *object_p) /**< fast array */
+{
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+
+  if (header_p == NULL)
+  {
+    return;
+  }
+
+  ecma_value_t *elements_p = ECMA_FAST_ARRAY_GET_ELEMENTS (header_p);
+
+  for (uint32_t index = 0; index < header_p->capacity; index++)
+  {
+    ecma_free_value_if_not_object (elements_p[index]);
+  }
+
+  jmem_heap_free_block (header_p, ECMA_FAST_ARRAY_BUFFER_SIZE (header_p->capacity));
+  ((ecma_extended_object_t *) object_p)->u.array.elements_cp = JMEM_CP_NULL;
+} /* ecma_fast_array_free_elements */
+
+/**
+ * List names of the elements of a fast array
+ *
+ * Note:
+ *      the names are listed in descending order like the index named properties
+ *      of an array filled in ascending order, which is the cheapest to sort
+ */
+void
+ecma_fast_array_list_element_names (ecma_object_t *object_p, /**< fast array */
+                                    ecma_collection_header_t *main_collection_p) /**< 'main' collection */
+{
+  ecma_fast_array_header_t *header_p = ecma_fast_array_get_header (object_p);
+
+  if (header_p == NULL)
+  {
+    return;
+  }
+
+  for (uint32_t index = header_p->capacity; index > 0; index--)
+  {
+    if (ecma_is_value_array_hole (ECMA_FAST_ARRAY_GET_ELEMENTS (header_p)[index - 1]))
+    {
+      continue;
+    }
+
+    ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index - 1);
+    ecma_append_to_values_collection (main_collection_p, ecma_make_string_value (index_str_p), true);
+    ecma_deref_ecma_string (index_str_p);
+  }
+} /* ecma_fast_array_list_element_names */
+
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
 /**
  * Array object creation operation.
  *
@@ -106,6 +565,29 @@ ecma_op_create_array_object (const ecma_value_t *arguments_list_p, /**< list of
   ext_obj_p->u.array.length = length;
   ext_obj_p->u.array.length_prop = ECMA_PROPERTY_FLAG_WRITABLE | ECMA_PROPERTY_TYPE_VIRTUAL;
 
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  ext_obj_p->u.array.is_fast = true;
+  ext_obj_p->u.array.elements_cp = JMEM_CP_NULL;
+
+  if (array_items_count == 0
+      || ecma_fast_array_set_capacity (object_p, array_items_count))
+  {
+    for (uint32_t index = 0;
+         index < array_items_count;
+         index++)
+    {
+      if (!ecma_is_value_array_hole (array_items_p[index]))
+      {
+        ecma_fast_array_add_element (object_p, index, array_items_p[index]);
+      }
+    }
+
+    return ecma_make_object_value (object_p);
+  }
+
+  ext_obj_p->u.array.is_fast = false;
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
   for (uint32_t index = 0;
        index < array_items_count;
        index++)
@@ -214,6 +696,13 @@ ecma_op_array_object_set_length (ecma_object_t *object_p, /**< the array object
   if (new_len_uint32 < old_len_uint32)
   {
     current_len_uint32 = ecma_delete_array_properties (object_p, new_len_uint32, old_len_uint32);
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+    if (ext_object_p->u.array.is_fast)
+    {
+      ecma_fast_array_set_length (object_p, current_len_uint32);
+    }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
   }
 
   ext_object_p->u.array.length = current_len_uint32;
@@ -310,6 +799,53 @@ ecma_op_array_object_define_own_property (ecma_object_t *object_p, /**< the arra
     return ecma_reject (is_throw);
   }
 
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  if (ext_object_p->u.array.is_fast)
+  {
+    if (!property_desc_p->is_get_defined
+        && !property_desc_p->is_set_defined)
+    {
+      ecma_value_t value = (property_desc_p->is_value_defined ? property_desc_p->value
+                                                              : ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED));
+
+      if (!ecma_is_value_array_hole (ecma_fast_array_get_element (object_p, index)))
+      {
+        /* Existing elements keep their attributes if the descriptor does not change them. */
+        if ((!property_desc_p->is_configurable_defined || property_desc_p->is_configurable)
+            && (!property_desc_p->is_enumerable_defined || property_desc_p->is_enumerable)
+            && (!property_desc_p->is_writable_defined || property_desc_p->is_writable))
+        {
+          if (property_desc_p->is_value_defined)
+          {
+            ecma_fast_array_assign_element (object_p, index, value);
+          }
+
+          return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+        }
+      }
+      else if (property_desc_p->is_configurable
+               && property_desc_p->is_enumerable
+               && property_desc_p->is_writable
+               && ecma_get_object_extensible (object_p)
+               && ecma_fast_array_add_element (object_p, index, value))
+      {
+        if (update_length)
+        {
+          ext_object_p->u.array.length = index + 1;
+        }
+
+        return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+      }
+    }
+
+    /* The general definition below creates or changes an index named property. */
+    if (ext_object_p->u.array.is_fast)
+    {
+      ecma_fast_array_convert_to_normal (object_p);
+    }
+  }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
   ecma_value_t completition = ecma_op_general_object_define_own_property (object_p,
                                                                           property_name_p,
                                                                           property_desc_p,
@@ -55,6 +55,21 @@ ecma_op_array_list_lazy_property_names (ecma_object_t *obj_p, bool separate_enum
                                         ecma_collection_header_t *main_collection_p,
                                         ecma_collection_header_t *non_enum_collection_p);
 
+#ifdef CONFIG_ECMA_FAST_ARRAY
+bool ecma_op_array_is_fast_array (ecma_object_t *object_p);
+ecma_value_t ecma_fast_array_get_element (ecma_object_t *object_p, uint32_t index);
+bool ecma_fast_array_assign_element (ecma_object_t *object_p, uint32_t index, ecma_value_t value);
+bool ecma_fast_array_add_element (ecma_object_t *object_p, uint32_t index, ecma_value_t value);
+void ecma_fast_array_delete_element (ecma_object_t *object_p, uint32_t index);
+void ecma_fast_array_set_length (ecma_object_t *object_p, uint32_t new_length);
+bool ecma_fast_array_is_dense (ecma_object_t *object_p);
+bool ecma_fast_array_splice (ecma_object_t *object_p, uint32_t start, uint32_t delete_count,
+                             const ecma_value_t *items_p, uint32_t item_count);
+void ecma_fast_array_convert_to_normal (ecma_object_t *object_p);
+void ecma_fast_array_free_elements (ecma_object_t *object_p);
+void ecma_fast_array_list_element_names (ecma_object_t *object_p, ecma_collection_header_t *main_collection_p);
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
 /**
  * @}
  * @}
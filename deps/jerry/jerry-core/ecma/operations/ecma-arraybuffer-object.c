@@ -52,6 +52,7 @@ ecma_arraybuffer_new_object (ecma_length_t length) /**< length of the arraybuffe
   ecma_deref_object (prototype_obj_p);
   ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
   ext_object_p->u.class_prop.class_id = LIT_MAGIC_STRING_ARRAY_BUFFER_UL;
+  ext_object_p->u.class_prop.extra_info = ECMA_ARRAYBUFFER_INTERNAL_MEMORY;
   ext_object_p->u.class_prop.u.length = length;
 
   lit_utf8_byte_t *buf = (lit_utf8_byte_t *) (ext_object_p + 1);
@@ -60,6 +61,38 @@ ecma_arraybuffer_new_object (ecma_length_t length) /**< length of the arraybuffe
   return object_p;
 } /* ecma_arraybuffer_new_object */
 
+/**
+ * Helper function: create arraybuffer object over a data buffer allocated by the embedder
+ *
+ * The data is neither copied nor cleared. The free callback, if any, is called with
+ * the buffer when the object is garbage collected. Typed arrays and iotjs Buffers
+ * created over the object share the data buffer with its owner.
+ *
+ * @return ecma_object_t *
+ */
+ecma_object_t *
+ecma_arraybuffer_new_object_external (ecma_length_t length, /**< length of the data buffer */
+                                      void *buffer_p, /**< data buffer */
+                                      ecma_object_native_free_callback_t free_cb) /**< callback which frees
+                                                                                   *   the buffer, or NULL */
+{
+  JERRY_ASSERT (buffer_p != NULL || length == 0);
+
+  ecma_object_t *prototype_obj_p = ecma_builtin_get (ECMA_BUILTIN_ID_ARRAYBUFFER_PROTOTYPE);
+  ecma_object_t *object_p = ecma_create_object (prototype_obj_p,
+                                                sizeof (ecma_arraybuffer_external_info),
+                                                ECMA_OBJECT_TYPE_CLASS);
+  ecma_deref_object (prototype_obj_p);
+  ecma_arraybuffer_external_info *array_object_p = (ecma_arraybuffer_external_info *) object_p;
+  array_object_p->extended_object.u.class_prop.class_id = LIT_MAGIC_STRING_ARRAY_BUFFER_UL;
+  array_object_p->extended_object.u.class_prop.extra_info = ECMA_ARRAYBUFFER_EXTERNAL_MEMORY;
+  array_object_p->extended_object.u.class_prop.u.length = length;
+  array_object_p->buffer_p = buffer_p;
+  array_object_p->free_cb = free_cb;
+
+  return object_p;
+} /* ecma_arraybuffer_new_object_external */
+
 /**
  * ArrayBuffer object creation operation.
  *
@@ -158,9 +191,30 @@ ecma_arraybuffer_get_buffer (ecma_object_t *object_p) /**< pointer to the ArrayB
   JERRY_ASSERT (ecma_object_class_is (object_p, LIT_MAGIC_STRING_ARRAY_BUFFER_UL));
 
   ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+
+  if (unlikely (ext_object_p->u.class_prop.extra_info & ECMA_ARRAYBUFFER_EXTERNAL_MEMORY))
+  {
+    return (lit_utf8_byte_t *) ((ecma_arraybuffer_external_info *) object_p)->buffer_p;
+  }
+
   return (lit_utf8_byte_t *) (ext_object_p + 1);
 } /* ecma_arraybuffer_get_buffer */
 
+/**
+ * Helper function: check whether the data buffer of the arraybuffer object is allocated by the embedder
+ *
+ * @return true - if the data buffer is external
+ *         false - otherwise
+ */
+inline bool __attr_pure___ __attr_always_inline___
+ecma_arraybuffer_has_external_memory (ecma_object_t *object_p) /**< pointer to the ArrayBuffer object */
+{
+  JERRY_ASSERT (ecma_object_class_is (object_p, LIT_MAGIC_STRING_ARRAY_BUFFER_UL));
+
+  ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+  return (ext_object_p->u.class_prop.extra_info & ECMA_ARRAYBUFFER_EXTERNAL_MEMORY) != 0;
+} /* ecma_arraybuffer_has_external_memory */
+
 /**
  * @}
  * @}
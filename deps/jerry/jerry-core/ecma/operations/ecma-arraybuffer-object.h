@@ -26,6 +26,25 @@
  * @{
  */
 
+/**
+ * Flags of ArrayBuffer objects, stored in the extra_info field of the class part
+ */
+typedef enum
+{
+  ECMA_ARRAYBUFFER_INTERNAL_MEMORY = 0u, /**< the data buffer follows the object */
+  ECMA_ARRAYBUFFER_EXTERNAL_MEMORY = (1u << 0), /**< the data buffer is allocated by the embedder */
+} ecma_arraybuffer_extra_flag_t;
+
+/**
+ * Description of ArrayBuffer objects with external data buffer
+ */
+typedef struct
+{
+  ecma_extended_object_t extended_object; /**< extended object part */
+  void *buffer_p; /**< pointer to the external data buffer */
+  ecma_object_native_free_callback_t free_cb; /**< callback which frees the external data buffer, or NULL */
+} ecma_arraybuffer_external_info;
+
 ecma_value_t
 ecma_op_create_arraybuffer_object (const ecma_value_t *, ecma_length_t);
 
@@ -34,6 +53,10 @@ ecma_op_create_arraybuffer_object (const ecma_value_t *, ecma_length_t);
  */
 ecma_object_t *
 ecma_arraybuffer_new_object (ecma_length_t lengh);
+ecma_object_t *
+ecma_arraybuffer_new_object_external (ecma_length_t length, void *buffer_p, ecma_object_native_free_callback_t free_cb);
+bool
+ecma_arraybuffer_has_external_memory (ecma_object_t *obj_p) __attr_pure___;
 lit_utf8_byte_t *
 ecma_arraybuffer_get_buffer (ecma_object_t *obj_p) __attr_pure___;
 ecma_length_t
@@ -26,6 +26,7 @@
 #include "ecma-objects-arguments.h"
 #include "ecma-try-catch-macro.h"
 #include "jcontext.h"
+#include "js-parser.h"
 
 /** \addtogroup ecma ECMA
  * @{
@@ -308,6 +309,18 @@ ecma_op_function_call (ecma_object_t *func_obj_p, /**< Function object */
       bytecode_data_p = ECMA_GET_INTERNAL_VALUE_POINTER (const ecma_compiled_code_t,
                                                          ext_func_p->u.function.bytecode_cp);
 
+#ifdef PARSER_LAZY_FUNCTIONS
+      if (unlikely (bytecode_data_p->status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION))
+      {
+        ecma_value_t compile_status = parser_compile_lazy_function (bytecode_data_p, &bytecode_data_p);
+
+        if (ECMA_IS_VALUE_ERROR (compile_status))
+        {
+          return compile_status;
+        }
+      }
+#endif /* PARSER_LAZY_FUNCTIONS */
+
       is_strict = (bytecode_data_p->status_flags & CBC_CODE_FLAGS_STRICT_MODE) ? true : false;
       is_no_lex_env = (bytecode_data_p->status_flags & CBC_CODE_FLAGS_LEXICAL_ENV_NOT_NEEDED) ? true : false;
 
@@ -354,7 +367,8 @@ ecma_op_function_call (ecma_object_t *func_obj_p, /**< Function object */
                           local_env_p,
                           false,
                           arguments_list_p,
-                          arguments_list_len);
+                          arguments_list_len,
+                          func_obj_p);
 
       if (!is_no_lex_env)
       {
@@ -30,60 +30,41 @@
  * @{
  */
 
-/**
- * Description of the PromiseReactionJob
- */
-typedef struct
-{
-  ecma_value_t reaction; /**< the PromiseReaction */
-  ecma_value_t argument; /**< argument for the reaction */
-} ecma_job_promise_reaction_t;
-
-/**
- * Description of the PromiseResolveThenableJob
- */
-typedef struct
-{
-  ecma_value_t promise; /**< promise to be resolved */
-  ecma_value_t thenable; /**< thenbale object */
-  ecma_value_t then; /** 'then' function */
-} ecma_job_promise_resolve_thenable_t;
-
 /**
  * Initialize the jobqueue.
  */
 void ecma_job_queue_init (void)
 {
-  JERRY_CONTEXT (job_queue_head_p) = NULL;
-  JERRY_CONTEXT (job_queue_tail_p) = NULL;
+  JERRY_CONTEXT (job_queue_buffer_p) = NULL;
+  JERRY_CONTEXT (job_queue_capacity) = 0;
+  JERRY_CONTEXT (job_queue_head) = 0;
+  JERRY_CONTEXT (job_queue_count) = 0;
 } /* ecma_job_queue_init */
 
 /**
- * Create a PromiseReactionJob.
- *
- * @return pointer to the PromiseReactionJob
+ * Free the ring buffer of the jobqueue.
  */
-static ecma_job_promise_reaction_t *
-ecma_create_promise_reaction_job (ecma_value_t reaction, /**< PromiseReaction */
-                                  ecma_value_t argument) /**< argument for the reaction */
+static void
+ecma_job_queue_free_buffer (void)
 {
-  JERRY_ASSERT (ecma_is_value_object (reaction));
+  JERRY_ASSERT (JERRY_CONTEXT (job_queue_count) == 0);
 
-  ecma_job_promise_reaction_t *job_p;
+  if (JERRY_CONTEXT (job_queue_buffer_p) != NULL)
+  {
+    size_t size = JERRY_CONTEXT (job_queue_capacity) * sizeof (ecma_job_queueitem_t);
 
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(27, sizeof(ecma_job_promise_reaction_t)); /* size detailed */
-  #endif
+    #ifdef PROF_COUNT__SIZE_DETAILED
+    profile_add_count_size_detailed(29, -size); /* size detailed */
+    #endif
 
-  job_p = (ecma_job_promise_reaction_t *) jmem_heap_alloc_block (sizeof (ecma_job_promise_reaction_t));
-  job_p->reaction = ecma_copy_value (reaction);
-  job_p->argument = ecma_copy_value (argument);
+    jmem_heap_free_block (JERRY_CONTEXT (job_queue_buffer_p), size);
+  }
 
-  return job_p;
-} /* ecma_create_promise_reaction_job */
+  ecma_job_queue_init ();
+} /* ecma_job_queue_free_buffer */
 
 /**
- * Free the heap and the member of the PromiseReactionJob.
+ * Free the values of a PromiseReactionJob.
  */
 static void
 ecma_free_promise_reaction_job (ecma_job_promise_reaction_t *job_p) /**< points to the PromiseReactionJob */
@@ -92,45 +73,10 @@ ecma_free_promise_reaction_job (ecma_job_promise_reaction_t *job_p) /**< points
 
   ecma_free_value (job_p->reaction);
   ecma_free_value (job_p->argument);
-
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(27, -sizeof(ecma_job_promise_reaction_t)); /* size detailed */
-  #endif
-
-  jmem_heap_free_block (job_p, sizeof (ecma_job_promise_reaction_t));
 } /* ecma_free_promise_reaction_job */
 
 /**
- * Create a PromiseResolveThenableJob
- *
- * @return pointer to the PromiseResolveThenableJob
- */
-static ecma_job_promise_resolve_thenable_t *
-ecma_create_promise_resolve_thenable_job (ecma_value_t promise, /**< promise to be resolved */
-                                          ecma_value_t thenable, /**< thenable object */
-                                          ecma_value_t then) /**< 'then' function */
-{
-  JERRY_ASSERT (ecma_is_promise (ecma_get_object_from_value (promise)));
-  JERRY_ASSERT (ecma_is_value_object (thenable));
-  JERRY_ASSERT (ecma_op_is_callable (then));
-
-  ecma_job_promise_resolve_thenable_t *job_p;
-
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(28, sizeof(ecma_job_promise_resolve_thenable_t)); /* size detailed */
-  #endif
-
-  job_p = (ecma_job_promise_resolve_thenable_t *) jmem_heap_alloc_block (sizeof (ecma_job_promise_resolve_thenable_t));
-
-  job_p->promise = ecma_copy_value (promise);
-  job_p->thenable = ecma_copy_value (thenable);
-  job_p->then = ecma_copy_value (then);
-
-  return job_p;
-} /* ecma_create_promise_resolve_thenable_job */
-
-/**
- * Free the heap and the member of the PromiseResolveThenableJob.
+ * Free the values of a PromiseResolveThenableJob.
  */
 static void
 ecma_free_promise_resolve_thenable_job (ecma_job_promise_resolve_thenable_t *job_p) /**< points to the
@@ -141,12 +87,6 @@ ecma_free_promise_resolve_thenable_job (ecma_job_promise_resolve_thenable_t *job
   ecma_free_value (job_p->promise);
   ecma_free_value (job_p->thenable);
   ecma_free_value (job_p->then);
-
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(28, -sizeof(ecma_job_promise_resolve_thenable_t)); /* size detailed */
-  #endif
-
-  jmem_heap_free_block (job_p, sizeof (ecma_job_promise_resolve_thenable_t));
 } /* ecma_free_promise_resolve_thenable_job */
 
 /**
@@ -284,31 +224,56 @@ ecma_process_promise_resolve_thenable_job (void *obj_p) /**< the job to be opera
 } /* ecma_process_promise_resolve_thenable_job */
 
 /**
- * Enqueue a Promise job into the jobqueue.
+ * Append an item to the jobqueue, and grow its ring buffer if it is full.
+ *
+ * @return pointer to the new item, which must be filled by the caller
  */
-static void
-ecma_enqueue_job (ecma_job_handler_t handler, /**< the handler for the job */
-                  void *job_p) /**< the job */
+static ecma_job_queueitem_t *
+ecma_enqueue_job (ecma_job_handler_t handler) /**< the handler for the job */
 {
-  #ifdef PROF_COUNT__SIZE_DETAILED
-  profile_add_count_size_detailed(29, sizeof(ecma_job_queueitem_t)); /* size detailed */
-  #endif
+  uint32_t capacity = JERRY_CONTEXT (job_queue_capacity);
+  uint32_t count = JERRY_CONTEXT (job_queue_count);
 
-  ecma_job_queueitem_t *item_p = jmem_heap_alloc_block (sizeof (ecma_job_queueitem_t));
-  item_p->job_p = job_p;
-  item_p->handler = handler;
-  item_p->next_p = NULL;
-
-  if (JERRY_CONTEXT (job_queue_head_p) == NULL)
-  {
-    JERRY_CONTEXT (job_queue_head_p) = item_p;
-    JERRY_CONTEXT (job_queue_tail_p) = item_p;
-  }
-  else
+  if (count == capacity)
   {
-    JERRY_CONTEXT (job_queue_tail_p)->next_p = item_p;
-    JERRY_CONTEXT (job_queue_tail_p) = item_p;
+    uint32_t new_capacity = (capacity == 0) ? ECMA_JOB_QUEUE_INITIAL_CAPACITY : capacity * 2;
+    size_t new_size = new_capacity * sizeof (ecma_job_queueitem_t);
+
+    #ifdef PROF_COUNT__SIZE_DETAILED
+    profile_add_count_size_detailed(29, new_size); /* size detailed */
+    #endif
+
+    ecma_job_queueitem_t *new_buffer_p = (ecma_job_queueitem_t *) jmem_heap_alloc_block (new_size);
+    ecma_job_queueitem_t *buffer_p = JERRY_CONTEXT (job_queue_buffer_p);
+    uint32_t head = JERRY_CONTEXT (job_queue_head);
+
+    /* The items are moved to the start of the new buffer in queue order. */
+    for (uint32_t i = 0; i < count; i++)
+    {
+      new_buffer_p[i] = buffer_p[(head + i) % capacity];
+    }
+
+    if (buffer_p != NULL)
+    {
+      #ifdef PROF_COUNT__SIZE_DETAILED
+      profile_add_count_size_detailed(29, -(capacity * sizeof (ecma_job_queueitem_t))); /* size detailed */
+      #endif
+
+      jmem_heap_free_block (buffer_p, capacity * sizeof (ecma_job_queueitem_t));
+    }
+
+    JERRY_CONTEXT (job_queue_buffer_p) = new_buffer_p;
+    JERRY_CONTEXT (job_queue_capacity) = new_capacity;
+    JERRY_CONTEXT (job_queue_head) = 0;
+    capacity = new_capacity;
   }
+
+  uint32_t index = (JERRY_CONTEXT (job_queue_head) + count) % capacity;
+  ecma_job_queueitem_t *item_p = JERRY_CONTEXT (job_queue_buffer_p) + index;
+  item_p->handler = handler;
+
+  JERRY_CONTEXT (job_queue_count) = count + 1;
+  return item_p;
 } /* ecma_enqueue_job */
 
 /**
@@ -318,8 +283,11 @@ void
 ecma_enqueue_promise_reaction_job (ecma_value_t reaction, /**< PromiseReaction */
                                    ecma_value_t argument) /**< argument for the reaction */
 {
-  ecma_job_promise_reaction_t *job_p = ecma_create_promise_reaction_job (reaction, argument);
-  ecma_enqueue_job (ecma_process_promise_reaction_job, job_p);
+  JERRY_ASSERT (ecma_is_value_object (reaction));
+
+  ecma_job_queueitem_t *item_p = ecma_enqueue_job (ecma_process_promise_reaction_job);
+  item_p->u.reaction.reaction = ecma_copy_value (reaction);
+  item_p->u.reaction.argument = ecma_copy_value (argument);
 } /* ecma_enqueue_promise_reaction_job */
 
 /**
@@ -330,44 +298,112 @@ ecma_enqueue_promise_resolve_thenable_job (ecma_value_t promise, /**< promise to
                                            ecma_value_t thenable, /**< thenable object */
                                            ecma_value_t then) /**< 'then' function */
 {
-  ecma_job_promise_resolve_thenable_t *job_p = ecma_create_promise_resolve_thenable_job (promise,
-                                                                                         thenable,
-                                                                                         then);
-  ecma_enqueue_job (ecma_process_promise_resolve_thenable_job, job_p);
+  JERRY_ASSERT (ecma_is_promise (ecma_get_object_from_value (promise)));
+  JERRY_ASSERT (ecma_is_value_object (thenable));
+  JERRY_ASSERT (ecma_op_is_callable (then));
+
+  ecma_job_queueitem_t *item_p = ecma_enqueue_job (ecma_process_promise_resolve_thenable_job);
+  item_p->u.resolve_thenable.promise = ecma_copy_value (promise);
+  item_p->u.resolve_thenable.thenable = ecma_copy_value (thenable);
+  item_p->u.resolve_thenable.then = ecma_copy_value (then);
 } /* ecma_enqueue_promise_resolve_thenable_job */
 
 /**
- * Process enqueued Promise jobs until the first thrown error or until the
- * jobqueue becomes empty.
+ * Check whether the jobqueue is non-empty.
+ *
+ * @return true - if there are enqueued jobs,
+ *         false - otherwise
+ */
+bool
+ecma_has_enqueued_jobs (void)
+{
+  return JERRY_CONTEXT (job_queue_count) != 0;
+} /* ecma_has_enqueued_jobs */
+
+/**
+ * Process enqueued Promise jobs until the first thrown error, until the
+ * jobqueue becomes empty, or until the time budget is used up. The jobs
+ * enqueued by the processed jobs are also processed in the same call.
+ *
+ * Note:
+ *      the time budget is checked after every ECMA_JOB_QUEUE_TIME_CHECK_INTERVAL
+ *      jobs, so a call may exceed the budget by the run time of these jobs.
  *
  * @return result of the last processed job - if the jobqueue was non-empty,
  *         undefined - otherwise.
  */
 ecma_value_t
-ecma_process_all_enqueued_jobs (void)
+ecma_process_enqueued_jobs (uint32_t time_budget_ms) /**< time budget in milliseconds,
+                                                      *   0 - process all jobs */
 {
   ecma_value_t ret = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+  double deadline = 0;
+  uint32_t processed_count = 0;
 
-  while (JERRY_CONTEXT (job_queue_head_p) != NULL && !ECMA_IS_VALUE_ERROR (ret))
+  if (time_budget_ms != 0)
   {
-    ecma_job_queueitem_t *item_p = JERRY_CONTEXT (job_queue_head_p);
-    JERRY_CONTEXT (job_queue_head_p) = JERRY_CONTEXT (job_queue_head_p)->next_p;
+    deadline = jerry_port_get_current_time () + time_budget_ms;
+  }
 
-    void *job_p = item_p->job_p;
-    ecma_job_handler_t handler = item_p->handler;
+  while (JERRY_CONTEXT (job_queue_count) != 0 && !ECMA_IS_VALUE_ERROR (ret))
+  {
+    if (time_budget_ms != 0
+        && processed_count != 0
+        && (processed_count % ECMA_JOB_QUEUE_TIME_CHECK_INTERVAL) == 0
+        && jerry_port_get_current_time () >= deadline)
+    {
+      break;
+    }
 
-    #ifdef PROF_COUNT__SIZE_DETAILED
-    profile_add_count_size_detailed(29, -sizeof(ecma_job_queueitem_t)); /* size detailed */
-    #endif
+    /* The item is copied, as the handler may enqueue jobs which move the ring buffer. */
+    uint32_t head = JERRY_CONTEXT (job_queue_head);
+    ecma_job_queueitem_t item = JERRY_CONTEXT (job_queue_buffer_p)[head];
 
-    jmem_heap_free_block (item_p, sizeof (ecma_job_queueitem_t));
+    JERRY_CONTEXT (job_queue_head) = (head + 1) % JERRY_CONTEXT (job_queue_capacity);
+    JERRY_CONTEXT (job_queue_count)--;
 
     ecma_free_value (ret);
-    ret = handler (job_p);
+    ret = item.handler (&item.u);
+    processed_count++;
+  }
+
+  /* A ring buffer grown by a burst of jobs is not kept. */
+  if (JERRY_CONTEXT (job_queue_count) == 0
+      && JERRY_CONTEXT (job_queue_capacity) > ECMA_JOB_QUEUE_INITIAL_CAPACITY)
+  {
+    ecma_job_queue_free_buffer ();
   }
 
   return ret;
-} /* ecma_process_all_enqueued_jobs */
+} /* ecma_process_enqueued_jobs */
+
+/**
+ * Free the jobs which were never processed and the ring buffer of the jobqueue.
+ */
+void
+ecma_job_queue_finalize (void)
+{
+  while (JERRY_CONTEXT (job_queue_count) != 0)
+  {
+    uint32_t head = JERRY_CONTEXT (job_queue_head);
+    ecma_job_queueitem_t item = JERRY_CONTEXT (job_queue_buffer_p)[head];
+
+    JERRY_CONTEXT (job_queue_head) = (head + 1) % JERRY_CONTEXT (job_queue_capacity);
+    JERRY_CONTEXT (job_queue_count)--;
+
+    if (item.handler == ecma_process_promise_reaction_job)
+    {
+      ecma_free_promise_reaction_job (&item.u.reaction);
+    }
+    else
+    {
+      JERRY_ASSERT (item.handler == ecma_process_promise_resolve_thenable_job);
+      ecma_free_promise_resolve_thenable_job (&item.u.resolve_thenable);
+    }
+  }
+
+  ecma_job_queue_free_buffer ();
+} /* ecma_job_queue_finalize */
 
 /**
  * @}
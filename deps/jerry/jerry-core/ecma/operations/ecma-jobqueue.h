@@ -30,22 +30,59 @@
  */
 typedef ecma_value_t (*ecma_job_handler_t) (void *job_p);
 
+/**
+ * Description of the PromiseReactionJob
+ */
+typedef struct
+{
+  ecma_value_t reaction; /**< the PromiseReaction */
+  ecma_value_t argument; /**< argument for the reaction */
+} ecma_job_promise_reaction_t;
+
+/**
+ * Description of the PromiseResolveThenableJob
+ */
+typedef struct
+{
+  ecma_value_t promise; /**< promise to be resolved */
+  ecma_value_t thenable; /**< thenbale object */
+  ecma_value_t then; /** 'then' function */
+} ecma_job_promise_resolve_thenable_t;
+
 /**
  * Description of the job queue item.
+ *
+ * The items are stored by value in a ring buffer, so enqueuing a job
+ * does not allocate memory unless the ring buffer is full.
  */
-typedef struct ecma_job_queueitem_t
+typedef struct
 {
-  struct ecma_job_queueitem_t *next_p; /**< points to next item */
   ecma_job_handler_t handler; /**< the handler for the job*/
-  void *job_p; /**< points to the job */
+  union
+  {
+    ecma_job_promise_reaction_t reaction; /**< PromiseReactionJob */
+    ecma_job_promise_resolve_thenable_t resolve_thenable; /**< PromiseResolveThenableJob */
+  } u;
 } ecma_job_queueitem_t;
 
+/**
+ * Number of items of the ring buffer of the job queue when it is allocated first
+ */
+#define ECMA_JOB_QUEUE_INITIAL_CAPACITY 8
+
+/**
+ * Number of jobs processed between two checks of the time budget
+ */
+#define ECMA_JOB_QUEUE_TIME_CHECK_INTERVAL 8
+
 void ecma_job_queue_init (void);
+void ecma_job_queue_finalize (void);
 
 void ecma_enqueue_promise_reaction_job (ecma_value_t reaction, ecma_value_t argument);
 void ecma_enqueue_promise_resolve_thenable_job (ecma_value_t promise, ecma_value_t thenable, ecma_value_t then);
 
-ecma_value_t ecma_process_all_enqueued_jobs (void);
+ecma_value_t ecma_process_enqueued_jobs (uint32_t time_budget_ms);
+bool ecma_has_enqueued_jobs (void);
 
 /**
  * @}
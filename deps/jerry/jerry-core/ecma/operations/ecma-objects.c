@@ -16,6 +16,7 @@
 #include "ecma-array-object.h"
 #include "ecma-builtins.h"
 #include "ecma-builtin-helpers.h"
+#include "ecma-enum-cache.h"
 #include "ecma-exceptions.h"
 #include "ecma-gc.h"
 #include "ecma-globals.h"
@@ -140,6 +141,30 @@ ecma_op_object_get_own_property (ecma_object_t *object_p, /**< the object */
 
         return ext_object_p->u.array.length_prop;
       }
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+      if (ecma_op_array_is_fast_array (object_p))
+      {
+        uint32_t index = ecma_string_get_array_index (property_name_p);
+
+        if (index != ECMA_STRING_NOT_ARRAY_INDEX)
+        {
+          ecma_value_t element = ecma_fast_array_get_element (object_p, index);
+
+          if (ecma_is_value_array_hole (element))
+          {
+            return ECMA_PROPERTY_TYPE_NOT_FOUND;
+          }
+
+          if (options & ECMA_PROPERTY_GET_VALUE)
+          {
+            property_ref_p->virtual_value = ecma_copy_value (element);
+          }
+
+          return ECMA_PROPERTY_CONFIGURABLE_ENUMERABLE_WRITABLE | ECMA_PROPERTY_TYPE_VIRTUAL;
+        }
+      }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
       break;
     }
 #ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
@@ -439,6 +464,25 @@ ecma_op_object_find_own (ecma_value_t base_value, /**< base value */
 
         return ecma_make_uint32_value (ext_object_p->u.array.length);
       }
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+      if (ecma_op_array_is_fast_array (object_p))
+      {
+        uint32_t index = ecma_string_get_array_index (property_name_p);
+
+        if (index != ECMA_STRING_NOT_ARRAY_INDEX)
+        {
+          ecma_value_t element = ecma_fast_array_get_element (object_p, index);
+
+          if (ecma_is_value_array_hole (element))
+          {
+            return ecma_make_simple_value (ECMA_SIMPLE_VALUE_NOT_FOUND);
+          }
+
+          return ecma_fast_copy_value (element);
+        }
+      }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
       break;
     }
     case ECMA_OBJECT_TYPE_PSEUDO_ARRAY:
@@ -725,6 +769,20 @@ ecma_op_object_put (ecma_object_t *object_p, /**< the object */
 
         return ecma_reject (is_throw);
       }
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+      if (ecma_op_array_is_fast_array (object_p))
+      {
+        uint32_t index = ecma_string_get_array_index (property_name_p);
+
+        /* Missing elements are created below, after the prototype chain is checked. */
+        if (index != ECMA_STRING_NOT_ARRAY_INDEX
+            && ecma_fast_array_assign_element (object_p, index, value))
+        {
+          return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+        }
+      }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
       break;
     }
     case ECMA_OBJECT_TYPE_PSEUDO_ARRAY:
@@ -931,6 +989,14 @@ ecma_op_object_put (ecma_object_t *object_p, /**< the object */
 
           ext_object_p->u.array.length = index + 1;
         }
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+        if (ext_object_p->u.array.is_fast
+            && ecma_fast_array_add_element (object_p, index, value))
+        {
+          return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+        }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
       }
 
       ecma_property_value_t *new_prop_value_p;
@@ -993,13 +1059,32 @@ ecma_op_object_delete (ecma_object_t *obj_p, /**< the object */
     case ECMA_OBJECT_TYPE_CLASS:
     case ECMA_OBJECT_TYPE_FUNCTION:
     case ECMA_OBJECT_TYPE_EXTERNAL_FUNCTION:
-    case ECMA_OBJECT_TYPE_ARRAY:
     case ECMA_OBJECT_TYPE_BOUND_FUNCTION:
     {
       return ecma_op_general_object_delete (obj_p,
                                             property_name_p,
                                             is_throw);
     }
+    case ECMA_OBJECT_TYPE_ARRAY:
+    {
+#ifdef CONFIG_ECMA_FAST_ARRAY
+      if (ecma_op_array_is_fast_array (obj_p))
+      {
+        uint32_t index = ecma_string_get_array_index (property_name_p);
+
+        /* The elements of a fast array are configurable. */
+        if (index != ECMA_STRING_NOT_ARRAY_INDEX)
+        {
+          ecma_fast_array_delete_element (obj_p, index);
+          return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+        }
+      }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
+      return ecma_op_general_object_delete (obj_p,
+                                            property_name_p,
+                                            is_throw);
+    }
 
     case ECMA_OBJECT_TYPE_PSEUDO_ARRAY:
     {
@@ -1428,6 +1513,14 @@ ecma_op_object_get_property_names (ecma_object_t *obj_p, /**< object */
                                                   is_enumerable_only,
                                                   prop_names_p,
                                                   skipped_non_enumerable_p);
+
+#ifdef CONFIG_ECMA_FAST_ARRAY
+          if (prototype_chain_iter_p == obj_p
+              && ecma_op_array_is_fast_array (obj_p))
+          {
+            ecma_fast_array_list_element_names (obj_p, prop_names_p);
+          }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
           break;
         }
         default:
@@ -1701,6 +1794,60 @@ ecma_op_object_get_property_names (ecma_object_t *obj_p, /**< object */
   return ret_p;
 } /* ecma_op_object_get_property_names */
 
+/**
+ * Get the names of the enumerable properties of an object, see ecma_op_object_get_property_names.
+ *
+ * With CONFIG_ECMA_ENUM_CACHE the list may be shared with the enumeration cache,
+ * and it must not be modified.
+ *
+ * @return collection of strings - property names,
+ *         which must be freed with ecma_op_object_free_enumerable_property_names
+ */
+ecma_collection_header_t *
+ecma_op_object_get_enumerable_property_names (ecma_object_t *obj_p, /**< object */
+                                              bool is_with_prototype_chain, /**< list the prototypes too */
+                                              bool *is_shared_p) /**< [out] the list is shared
+                                                                  *   with the enumeration cache */
+{
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  ecma_collection_header_t *names_p = ecma_enum_cache_lookup (obj_p, is_with_prototype_chain);
+
+  if (names_p != NULL)
+  {
+    *is_shared_p = true;
+    return names_p;
+  }
+
+  names_p = ecma_op_object_get_property_names (obj_p, false, true, is_with_prototype_chain);
+  *is_shared_p = ecma_enum_cache_insert (obj_p, is_with_prototype_chain, names_p);
+  return names_p;
+#else /* !CONFIG_ECMA_ENUM_CACHE */
+  *is_shared_p = false;
+  return ecma_op_object_get_property_names (obj_p, false, true, is_with_prototype_chain);
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+} /* ecma_op_object_get_enumerable_property_names */
+
+/**
+ * Free the names returned by ecma_op_object_get_enumerable_property_names
+ */
+void
+ecma_op_object_free_enumerable_property_names (ecma_collection_header_t *names_p, /**< property names */
+                                               bool is_shared) /**< the list is shared
+                                                                *   with the enumeration cache */
+{
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  if (is_shared)
+  {
+    ecma_enum_cache_release ();
+    return;
+  }
+#else /* !CONFIG_ECMA_ENUM_CACHE */
+  JERRY_ASSERT (!is_shared);
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
+  ecma_free_values_collection (names_p, true);
+} /* ecma_op_object_free_enumerable_property_names */
+
 /**
  * The function is used in the assert of ecma_object_get_class_name
  */
@@ -48,6 +48,10 @@ ecma_value_t ecma_op_object_has_instance (ecma_object_t *obj_p, ecma_value_t val
 bool ecma_op_object_is_prototype_of (ecma_object_t *base_p, ecma_object_t *target_p);
 ecma_collection_header_t * ecma_op_object_get_property_names (ecma_object_t *obj_p, bool is_array_indices_only,
                                                               bool is_enumerable_only, bool is_with_prototype_chain);
+ecma_collection_header_t *ecma_op_object_get_enumerable_property_names (ecma_object_t *obj_p,
+                                                                        bool is_with_prototype_chain,
+                                                                        bool *is_shared_p);
+void ecma_op_object_free_enumerable_property_names (ecma_collection_header_t *names_p, bool is_shared);
 
 lit_magic_string_id_t ecma_object_get_class_name (ecma_object_t *obj_p);
 bool ecma_object_class_is (ecma_object_t *object_p, uint32_t class_id);
@@ -1213,6 +1213,95 @@ re_set_result_array_properties (ecma_object_t *array_obj_p, /**< result array */
   ecma_deref_ecma_string (result_prop_str_p);
 } /* re_set_result_array_properties */
 
+/**
+ * Find the first input position from the given one where a match of the RegExp can start,
+ * see also re_compute_scan_info
+ *
+ * @return pointer to the position - if found
+ *         NULL - otherwise (the RegExp cannot match from the given position)
+ */
+static const lit_utf8_byte_t *
+re_scan_match_start (const re_compiled_code_t *bc_p, /**< RegExp bytecode */
+                     const lit_utf8_byte_t *str_curr_p, /**< current position in the input */
+                     const lit_utf8_byte_t *str_end_p) /**< end of the input */
+{
+  JERRY_ASSERT (bc_p->scan_type == RE_SCAN_PREFIX || bc_p->scan_type == RE_SCAN_FIRST_BYTES);
+  JERRY_ASSERT (bc_p->scan_size > 0);
+
+  if (bc_p->scan_type == RE_SCAN_FIRST_BYTES)
+  {
+    while (str_curr_p < str_end_p)
+    {
+      for (uint32_t i = 0; i < bc_p->scan_size; i++)
+      {
+        if (*str_curr_p == bc_p->scan_bytes[i])
+        {
+          return str_curr_p;
+        }
+      }
+
+      str_curr_p++;
+    }
+
+    return NULL;
+  }
+
+  /* The first byte of a cesu8 character is never a continuation byte, so the found
+   * bytes are always at a character boundary. */
+  while ((lit_utf8_size_t) (str_end_p - str_curr_p) >= bc_p->scan_size)
+  {
+    str_curr_p = (const lit_utf8_byte_t *) memchr (str_curr_p,
+                                                   bc_p->scan_bytes[0],
+                                                   (size_t) (str_end_p - str_curr_p));
+
+    if (str_curr_p == NULL
+        || (lit_utf8_size_t) (str_end_p - str_curr_p) < bc_p->scan_size)
+    {
+      return NULL;
+    }
+
+    if (memcmp (str_curr_p + 1, bc_p->scan_bytes + 1, (size_t) bc_p->scan_size - 1) == 0)
+    {
+      return str_curr_p;
+    }
+
+    str_curr_p++;
+  }
+
+  return NULL;
+} /* re_scan_match_start */
+
+/**
+ * Remember the input and the byte offset of lastIndex after a global match, so that
+ * the next exec on the same input can continue without counting the characters again
+ */
+static void
+re_set_last_match (re_compiled_code_t *bc_p, /**< RegExp bytecode */
+                   ecma_string_t *input_str_p, /**< input string, or NULL to forget the last match */
+                   uint32_t last_index, /**< lastIndex after the match */
+                   lit_utf8_size_t last_offset) /**< byte offset of lastIndex in the input */
+{
+  ecma_string_t *last_input_p = ECMA_GET_POINTER (ecma_string_t, bc_p->last_input_cp);
+
+  if (last_input_p != input_str_p)
+  {
+    if (input_str_p != NULL)
+    {
+      ecma_ref_ecma_string (input_str_p);
+    }
+
+    if (last_input_p != NULL)
+    {
+      ecma_deref_ecma_string (last_input_p);
+    }
+
+    ECMA_SET_POINTER (bc_p->last_input_cp, input_str_p);
+  }
+
+  bc_p->last_index = last_index;
+  bc_p->last_offset = last_offset;
+} /* re_set_last_match */
+
 /**
  * RegExp helper function to start the recursive matching algorithm
  * and create the result Array object
@@ -1297,7 +1386,7 @@ ecma_regexp_exec_helper (ecma_value_t regexp_value, /**< RegExp object */
   int32_t index = 0;
   ecma_length_t input_str_len;
 
-  input_str_len = lit_utf8_string_length (input_buffer_p, input_buffer_size);
+  input_str_len = ecma_string_get_length (input_string_p);
 
   if (input_buffer_p && (re_ctx.flags & RE_FLAG_GLOBAL))
   {
@@ -1312,9 +1401,18 @@ ecma_regexp_exec_helper (ecma_value_t regexp_value, /**< RegExp object */
         && index <= (int32_t) input_str_len
         && index > 0)
     {
-      for (int i = 0; i < index; i++)
+      if (ECMA_GET_POINTER (ecma_string_t, bc_p->last_input_cp) == input_string_p
+          && bc_p->last_index == (uint32_t) index)
       {
-        lit_utf8_incr (&input_curr_p);
+        /* Continue the iteration of the previous exec on the same input. */
+        input_curr_p += bc_p->last_offset;
+      }
+      else
+      {
+        for (int i = 0; i < index; i++)
+        {
+          lit_utf8_incr (&input_curr_p);
+        }
       }
     }
 
@@ -1345,6 +1443,20 @@ ecma_regexp_exec_helper (ecma_value_t regexp_value, /**< RegExp object */
     }
     else
     {
+      if (bc_p->scan_type == RE_SCAN_PREFIX || bc_p->scan_type == RE_SCAN_FIRST_BYTES)
+      {
+        const lit_utf8_byte_t *match_start_p = re_scan_match_start (bc_p, input_curr_p, input_end_p);
+
+        if (match_start_p == NULL)
+        {
+          index = (int32_t) input_str_len + 1;
+          continue;
+        }
+
+        index += (int32_t) lit_utf8_string_length (input_curr_p, (lit_utf8_size_t) (match_start_p - input_curr_p));
+        input_curr_p = match_start_p;
+      }
+
       ECMA_TRY_CATCH (match_value, re_match_regexp (&re_ctx,
                                                     bc_start_p,
                                                     input_curr_p,
@@ -1357,11 +1469,19 @@ ecma_regexp_exec_helper (ecma_value_t regexp_value, /**< RegExp object */
         break;
       }
 
-      if (input_curr_p < input_end_p)
+      if (bc_p->scan_type == RE_SCAN_ANCHORED)
       {
-        lit_utf8_incr (&input_curr_p);
+        /* No match can start after the first position. */
+        index = (int32_t) input_str_len + 1;
+      }
+      else
+      {
+        if (input_curr_p < input_end_p)
+        {
+          lit_utf8_incr (&input_curr_p);
+        }
+        index++;
       }
-      index++;
 
       ECMA_FINALIZE (match_value);
     }
@@ -1375,12 +1495,16 @@ ecma_regexp_exec_helper (ecma_value_t regexp_value, /**< RegExp object */
     if (sub_str_p != NULL
         && input_buffer_p != NULL)
     {
-      lastindex_num = (ecma_number_t) lit_utf8_string_length (input_buffer_p,
-                                                              (lit_utf8_size_t) (sub_str_p - input_buffer_p));
+      /* The match starts at index, so only the characters of the match have to be counted. */
+      uint32_t lastindex = (uint32_t) index + lit_utf8_string_length (input_curr_p,
+                                                                       (lit_utf8_size_t) (sub_str_p - input_curr_p));
+      lastindex_num = (ecma_number_t) lastindex;
+      re_set_last_match (bc_p, input_string_p, lastindex, (lit_utf8_size_t) (sub_str_p - input_buffer_p));
     }
     else
     {
       lastindex_num = ECMA_NUMBER_ZERO;
+      re_set_last_match (bc_p, NULL, 0, 0);
     }
 
     ecma_op_object_put (regexp_object_p, magic_str_p, ecma_make_number_value (lastindex_num), true);
@@ -1423,6 +1547,16 @@ ecma_regexp_exec_helper (ecma_value_t regexp_value, /**< RegExp object */
           capture_value = ecma_make_string_value (capture_str_p);
         }
 
+#ifdef CONFIG_ECMA_FAST_ARRAY
+        if (ecma_op_array_is_fast_array (result_array_obj_p)
+            && ecma_fast_array_add_element (result_array_obj_p, i / 2, capture_value))
+        {
+          ecma_free_value (capture_value);
+          ecma_deref_ecma_string (index_str_p);
+          continue;
+        }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
         ecma_property_value_t *prop_value_p;
         prop_value_p = ecma_create_named_data_property (result_array_obj_p,
                                                         index_str_p,
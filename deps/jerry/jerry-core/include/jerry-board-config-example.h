@@ -18,4 +18,9 @@
 
 #define PROF_MODE_ARTIK053
 
+// Segments of the segmented heap in the CCM of STM32F4, above the 16KB used
+// by the linker (see SEG_MEMORY_REGIONS in jmem-config.h)
+// #define SEG_MEMORY_REGIONS
+// #define SEG_MEMORY_REGION_TABLE { { (uint8_t *)0x10004000, 48 * 1024 } }
+
 #endif /* !JERRY_BOARD_CONFIG_H */
\ No newline at end of file
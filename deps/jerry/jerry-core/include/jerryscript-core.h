@@ -58,8 +58,47 @@ typedef enum
   JERRY_INIT_MEM_STATS_SEPARATE  = (1u << 3), /**< deprecated, an unused placeholder now */
   JERRY_INIT_DEBUGGER            = (1u << 4), /**< deprecated, an unused placeholder now */
   JERRY_INIT_JMEM_LOGS_ENABLED   = (1u << 5), /**< jmem logs enabled */
+  JERRY_INIT_PARSER_OPTIMIZE     = (1u << 6), /**< slower parser optimizations, e.g. for saving snapshots */
 } jerry_init_flag_t;
 
+/**
+ * Replacement policies of the reverse map cache of the segmented heap.
+ */
+typedef enum
+{
+  JERRY_RMAP_CACHE_POLICY_FIFO,  /**< first-in first-out */
+  JERRY_RMAP_CACHE_POLICY_LRU,   /**< least recently used */
+  JERRY_RMAP_CACHE_POLICY_CLOCK  /**< second chance */
+} jerry_rmap_cache_policy_t;
+
+/**
+ * Output formats of the jmem profilers.
+ */
+typedef enum
+{
+  JERRY_JMEM_PROFILE_FORMAT_JSON, /**< one JSON object per line */
+  JERRY_JMEM_PROFILE_FORMAT_CSV   /**< timestamp, profiler, key, value rows */
+} jerry_jmem_profile_format_t;
+
+/**
+ * Categories of the jmem profilers that can be selected at runtime.
+ */
+typedef enum
+{
+  JERRY_JMEM_PROFILE_SIZE     = (1u << 0), /**< total heap size */
+  JERRY_JMEM_PROFILE_TIME     = (1u << 1), /**< time of alloc/free/GC/(de)compression */
+  JERRY_JMEM_PROFILE_PMU      = (1u << 2), /**< PMU cycles of (de)compression */
+  JERRY_JMEM_PROFILE_CPTL     = (1u << 3), /**< compressed pointer translation */
+  JERRY_JMEM_PROFILE_SEGMENT  = (1u << 4), /**< segment utilization */
+  JERRY_JMEM_PROFILE_JSOBJECT = (1u << 5), /**< JS object allocation sizes */
+  JERRY_JMEM_PROFILE_COUNT    = (1u << 6), /**< temporary counters */
+  JERRY_JMEM_PROFILE_SAMPLING = (1u << 7), /**< sampled heap allocation sites */
+  JERRY_JMEM_PROFILE_OPCODE   = (1u << 8), /**< executed opcodes per function */
+  JERRY_JMEM_PROFILE_CPU      = (1u << 9), /**< sampled JS call stacks by CPU time */
+  JERRY_JMEM_PROFILE_TRACE    = (1u << 10), /**< trace of heap allocations for jerry-replay */
+  JERRY_JMEM_PROFILE_ALL      = ((1u << 11) - 1), /**< all the categories */
+} jerry_jmem_profile_category_t;
+
 /**
  * JerryScript API Error object types.
  */
@@ -89,6 +128,8 @@ typedef enum
   JERRY_FEATURE_SNAPSHOT_EXEC, /**< executing snapshot files */
   JERRY_FEATURE_DEBUGGER, /**< debugging */
   JERRY_FEATURE_VM_EXEC_STOP, /**< stopping ECMAScript execution */
+  JERRY_FEATURE_TYPEDARRAY, /**< ArrayBuffer and TypedArray built-ins */
+  JERRY_FEATURE_PROMISE, /**< Promise built-in */
   JERRY_FEATURE__COUNT /**< number of features. NOTE: must be at the end of the list */
 } jerry_feature_t;
 
@@ -172,6 +213,49 @@ typedef struct
   size_t reserved[4]; /**< padding for future extensions */
 } jerry_heap_stats_t;
 
+/**
+ * Knobs of the adaptive trigger of garbage collection.
+ */
+typedef struct
+{
+  uint32_t growth_percent; /**< growth of the heap over the live size before the next collection,
+                            *   0 for the fixed trigger */
+  uint32_t min_interval_ms; /**< collections closer than this raise the growth, 0 to ignore */
+  uint32_t pause_budget_us; /**< target pause of a collection, which bounds the growth, 0 to ignore */
+  uint32_t reserve_percent; /**< share of the heap which the growth leaves free */
+} jerry_gc_trigger_t;
+
+/**
+ * State of the garbage collections.
+ */
+typedef struct
+{
+  uint32_t count; /**< number of collections */
+  uint32_t last_pause_us; /**< pause of the last collection */
+  uint32_t interval_ms; /**< time between the starts of the last two collections */
+  uint32_t allocation_rate; /**< bytes allocated per millisecond between the last two collections */
+  uint32_t survival_percent; /**< share of the heap usage which survived the last collection */
+  uint32_t growth_percent; /**< growth adapted to the intervals and the survival of the collections */
+  uint32_t free_segments; /**< segments of the segmented heap not allocated yet */
+  size_t live_size; /**< heap usage after the last collection */
+  size_t trigger_size; /**< heap usage which triggers the next collection, 0 for the fixed trigger */
+  uint64_t total_pause_us; /**< pause of all collections so far */
+} jerry_gc_stats_t;
+
+/**
+ * Usage of the heap, in more detail than jerry_get_heap_usage.
+ */
+typedef struct
+{
+  size_t size; /**< size of the heap */
+  size_t allocated_size; /**< heap usage, as the GC trigger counts it */
+  size_t peak_allocated_size; /**< most heap usage so far */
+  size_t pool_free_size; /**< free chunks kept by the pools, which are part of the heap usage */
+  uint32_t segment_count; /**< allocated segments of the segmented heap, 0 for the other heaps */
+  size_t segment_size; /**< size of a segment, 0 for the other heaps */
+  size_t segment_occupied_size; /**< bytes in use in the allocated segments */
+} jerry_heap_usage_t;
+
 /**
  * Type of an external function handler.
  */
@@ -245,8 +329,15 @@ void jerry_init (jerry_init_flag_t flags);
 void jerry_cleanup (void);
 void jerry_register_magic_strings (const jerry_char_ptr_t *ex_str_items_p, uint32_t count,
                                    const jerry_length_t *str_lengths_p);
+void jerry_register_magic_strings_hash (const uint16_t *displacements_p, uint32_t displacement_count,
+                                        const uint16_t *slots_p, uint32_t slot_count);
 void jerry_get_memory_limits (size_t *out_data_bss_brk_limit_p, size_t *out_stack_limit_p);
 void jerry_gc (void);
+bool jerry_gc_step (uint32_t budget);
+void jerry_set_gc_trigger (const jerry_gc_trigger_t *trigger_p);
+void jerry_get_gc_trigger (jerry_gc_trigger_t *out_trigger_p);
+void jerry_get_gc_stats (jerry_gc_stats_t *out_stats_p);
+bool jerry_write_heap_snapshot (const char *path_p);
 void *jerry_get_context_data (const jerry_context_data_manager_t *manager_p);
 
 bool jerry_get_memory_stats (jerry_heap_stats_t *out_stats_p);
@@ -262,6 +353,8 @@ jerry_value_t jerry_run (const jerry_value_t func_val);
 jerry_value_t jerry_eval (const jerry_char_t *source_p, size_t source_size, bool is_strict);
 
 jerry_value_t jerry_run_all_enqueued_jobs (void);
+jerry_value_t jerry_run_enqueued_jobs (uint32_t time_budget_ms);
+bool jerry_has_enqueued_jobs (void);
 
 /**
  * Get the global context.
@@ -272,6 +365,7 @@ jerry_value_t jerry_get_global_object (void);
  * Checker functions of 'jerry_value_t'.
  */
 bool jerry_value_is_array (const jerry_value_t value);
+bool jerry_value_is_arraybuffer (const jerry_value_t value);
 bool jerry_value_is_boolean (const jerry_value_t value);
 bool jerry_value_is_constructor (const jerry_value_t value);
 bool jerry_value_is_function (const jerry_value_t value);
@@ -280,6 +374,7 @@ bool jerry_value_is_null (const jerry_value_t value);
 bool jerry_value_is_object (const jerry_value_t value);
 bool jerry_value_is_promise (const jerry_value_t value);
 bool jerry_value_is_string (const jerry_value_t value);
+bool jerry_value_is_typedarray (const jerry_value_t value);
 bool jerry_value_is_undefined (const jerry_value_t value);
 
 /**
@@ -308,6 +403,7 @@ jerry_size_t jerry_get_utf8_string_size (const jerry_value_t value);
 jerry_length_t jerry_get_string_length (const jerry_value_t value);
 jerry_length_t jerry_get_utf8_string_length (const jerry_value_t value);
 jerry_size_t jerry_string_to_char_buffer (const jerry_value_t value, jerry_char_t *buffer_p, jerry_size_t buffer_size);
+const jerry_char_t *jerry_get_string_chars (const jerry_value_t value, jerry_size_t *size_p);
 jerry_size_t jerry_string_to_utf8_char_buffer (const jerry_value_t value,
                                                jerry_char_t *buffer_p,
                                                jerry_size_t buffer_size);
@@ -327,6 +423,17 @@ jerry_size_t jerry_substring_to_utf8_char_buffer (const jerry_value_t value,
  */
 uint32_t jerry_get_array_length (const jerry_value_t value);
 
+/**
+ * Functions for ArrayBuffer and TypedArray object values.
+ */
+jerry_value_t jerry_create_arraybuffer (const jerry_length_t size);
+jerry_value_t jerry_create_arraybuffer_external (const jerry_length_t size, uint8_t *buffer_p,
+                                                 jerry_object_native_free_callback_t free_cb);
+jerry_length_t jerry_get_arraybuffer_byte_length (const jerry_value_t value);
+uint8_t *jerry_get_arraybuffer_pointer (const jerry_value_t value);
+jerry_value_t jerry_get_typedarray_buffer (const jerry_value_t value, jerry_length_t *byte_offset_p,
+                                           jerry_length_t *byte_length_p);
+
 /**
  * Converters of 'jerry_value_t'.
  */
@@ -365,6 +472,8 @@ jerry_value_t jerry_create_string_from_utf8 (const jerry_char_t *str_p);
 jerry_value_t jerry_create_string_sz_from_utf8 (const jerry_char_t *str_p, jerry_size_t str_size);
 jerry_value_t jerry_create_string (const jerry_char_t *str_p);
 jerry_value_t jerry_create_string_sz (const jerry_char_t *str_p, jerry_size_t str_size);
+jerry_value_t jerry_create_external_string_sz (const jerry_char_t *str_p, jerry_size_t str_size,
+                                               jerry_object_native_free_callback_t free_cb);
 jerry_value_t jerry_create_undefined (void);
 
 /**
@@ -437,10 +546,44 @@ jerry_instance_t *jerry_create_instance (uint32_t heap_size, jerry_instance_allo
  * Miscellaneous functions.
  */
 void jerry_set_vm_exec_stop_callback (jerry_vm_exec_stop_callback_t stop_cb, void *user_p, uint32_t frequency);
+void jerry_request_vm_exec_stop (void);
 
 // jmem-profiler
 void jerry_will_cleanup(void);
 void jerry_set_heap_size_ptr(size_t*);
+bool jerry_set_jmem_profile_output(const char *path_p,
+                                   jerry_jmem_profile_format_t format);
+uint32_t jerry_get_jmem_profile_categories(void);
+bool jerry_set_jmem_profile_categories(uint32_t categories);
+bool jerry_write_jmem_sampling_profile(const char *path_p);
+void jerry_jmem_cpu_profile_tick(void);
+bool jerry_write_jmem_cpu_profile(const char *path_p);
+
+// idle-time garbage collection
+void jerry_free_unused_memory(void);
+
+// memory governor: heap usage and size, and collection under memory pressure
+size_t jerry_get_heap_usage(size_t *heap_size_p);
+void jerry_free_unused_memory_critical(void);
+void jerry_get_heap_usage_stats(jerry_heap_usage_t *out_stats_p);
+uint32_t jerry_get_segment_occupancy(size_t *occupied_sizes_p,
+                                     uint32_t max_count);
+
+// GC-free regions: no GC runs in a region, within the headroom of the heap
+// reserved at its start. Ending a region tells whether it has overrun.
+bool jerry_begin_no_gc_region(size_t reserved_size);
+bool jerry_end_no_gc_region(void);
+
+// segmented heap: segment size (before jerry_init)
+bool jerry_set_segment_size(uint32_t segment_size);
+
+// segmented heap: empty segments kept after GC, and GCs they are kept for
+bool jerry_set_segment_retention(uint32_t low, uint32_t high, uint32_t age);
+
+// segmented heap: reverse map cache
+bool jerry_set_rmap_cache_config(uint32_t size, uint32_t set_size,
+                                 jerry_rmap_cache_policy_t policy,
+                                 bool is_adaptive);
 
 /**
  * @}
@@ -17,6 +17,7 @@
 #define JERRYSCRIPT_DEBUGGER_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -37,6 +38,23 @@ typedef enum
   JERRY_DEBUGGER_SOURCE_END = 2, /**< the end of the sources signal received */
 } jerry_debugger_wait_and_run_type_t;
 
+/**
+ * Kinds of the samples streamed to the debugger client while it profiles.
+ */
+typedef enum
+{
+  JERRY_DEBUGGER_PROFILE_HEAP = 0, /**< heap usage, sampled by the engine */
+  JERRY_DEBUGGER_PROFILE_GC = 1, /**< a garbage collection, at its end */
+  JERRY_DEBUGGER_PROFILE_CPU = 2, /**< the running JS frames, sampled by the engine */
+  JERRY_DEBUGGER_PROFILE_LOOP = 3, /**< event loop statistics, sampled by the embedder */
+  JERRY_DEBUGGER_PROFILE__COUNT /**< number of sample kinds */
+} jerry_debugger_profile_kind_t;
+
+/**
+ * Maximum number of values of a profile sample.
+ */
+#define JERRY_DEBUGGER_PROFILE_MAX_VALUES 8
+
 /**
  * Engine debugger functions.
  */
@@ -47,6 +65,8 @@ void jerry_debugger_continue (void);
 void jerry_debugger_stop_at_breakpoint (bool enable_stop_at_breakpoint);
 jerry_debugger_wait_and_run_type_t jerry_debugger_wait_and_run_client_source (jerry_value_t *return_value);
 void jerry_debugger_send_output (jerry_char_t buffer[], jerry_size_t str_size, uint8_t type);
+bool jerry_debugger_profile_tick (void);
+void jerry_debugger_profile_sample (jerry_debugger_profile_kind_t kind, const uint32_t values[], uint32_t count);
 
 /**
  * @}
@@ -33,6 +33,11 @@ extern "C"
 size_t jerry_parse_and_save_snapshot (const jerry_char_t *source_p, size_t source_size, bool is_for_global,
                                       bool is_strict, uint32_t *buffer_p, size_t buffer_size);
 jerry_value_t jerry_exec_snapshot (const uint32_t *snapshot_p, size_t snapshot_size, bool copy_bytecode);
+size_t jerry_parse_and_save_multi_snapshot (const jerry_char_t * const *sources_p, const size_t *source_sizes_p,
+                                            uint32_t source_count, bool is_for_global, bool is_strict,
+                                            uint32_t *buffer_p, size_t buffer_size);
+jerry_value_t jerry_exec_multi_snapshot (const uint32_t *snapshot_p, size_t snapshot_size, uint32_t source_index,
+                                         bool copy_bytecode);
 size_t jerry_parse_and_save_literals (const jerry_char_t *source_p, size_t source_size, bool is_strict,
                                       uint32_t *buffer_p, size_t buffer_size, bool is_c_format);
 
@@ -53,6 +53,19 @@ typedef struct jerry_context_data_header
 #define JERRY_CONTEXT_DATA_HEADER_USER_DATA(item_p) \
   ((uint8_t *) (item_p + 1))
 
+#if defined(JMEM_PROFILE) && defined(PROF_PMU)
+/**
+ * PMU event counters of the jmem PMU profiler
+ */
+typedef struct
+{
+  unsigned long long cycles; /**< CPU cycles */
+  unsigned long long instructions; /**< retired instructions */
+  unsigned long long cache_misses; /**< last-level cache misses */
+  unsigned long long branch_misses; /**< mispredicted branches */
+} jmem_pmu_counters_t;
+#endif /* defined(JMEM_PROFILE) && defined(PROF_PMU) */
+
 /**
  * JerryScript context
  *
@@ -69,20 +82,41 @@ typedef struct
   ecma_object_t *ecma_gc_objects_lists[ECMA_GC_COLOR__COUNT]; /**< List of marked (visited during
                                                                *   current GC session) and umarked objects */
   jmem_heap_free_t *jmem_heap_list_skip_p; /**< This is used to speed up deallocation. */
+#ifdef JMEM_HEAP_FREE_INDEX
+  uint32_t jmem_free_index[JMEM_HEAP_FREE_INDEX_WORDS]; /**< bitmap of the starts of free regions */
+  uint32_t jmem_free_index_summary[JMEM_HEAP_FREE_INDEX_SUMMARY_WORDS]; /**< bitmap of the non-zero
+                                                                        *   words of jmem_free_index */
+#endif /* JMEM_HEAP_FREE_INDEX */
   jmem_pools_chunk_t *jmem_free_8_byte_chunk_p; /**< list of free eight byte pool chunks */
 #if defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC)
   jmem_pools_chunk_t *jmem_free_16_byte_chunk_p; /**< list of free sixteen byte pool chunks */
 #endif /* defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC) */
+#ifdef JMEM_POOLS_SIZE_CLASSES
+  jmem_pools_chunk_t *jmem_free_sized_chunk_p[JMEM_POOLS_NUM_SIZE_CLASSES]; /**< lists of free pool chunks
+                                                                            *   larger than the fixed pools */
+#endif /* JMEM_POOLS_SIZE_CLASSES */
   jmem_free_unused_memory_callback_t jmem_free_unused_memory_callback; /**< Callback for freeing up memory. */
   const lit_utf8_byte_t **lit_magic_string_ex_array; /**< array of external magic strings */
   const lit_utf8_size_t *lit_magic_string_ex_sizes; /**< external magic string lengths */
+  const uint16_t *lit_magic_string_ex_hash_displacements; /**< bucket displacements of the external
+                                                          *   magic string hash */
+  const uint16_t *lit_magic_string_ex_hash_slots; /**< external magic string ids of the hash slots */
   ecma_lit_storage_item_t *string_list_first_p; /**< first item of the literal string list */
   ecma_lit_storage_item_t *number_list_first_p; /**< first item of the literal number list */
+  ecma_lit_storage_index_t string_index; /**< hash index of the literal string list */
+  ecma_lit_storage_index_t number_index; /**< hash index of the literal number list */
+#ifndef CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE
+  ecma_lit_storage_index_t property_name_index; /**< weak intern index of the run-time property names */
+#endif /* !CONFIG_ECMA_PROPERTY_NAME_INTERN_DISABLE */
   ecma_object_t *ecma_global_lex_env_p; /**< global lexical environment */
   vm_frame_ctx_t *vm_top_context_p; /**< top (current) interpreter context */
   jerry_context_data_header_t *context_data_p; /**< linked list of user-provided context-specific pointers */
   size_t ecma_gc_objects_number; /**< number of currently allocated objects */
   size_t ecma_gc_new_objects; /**< number of newly allocated objects since last GC session */
+  jerry_gc_trigger_t ecma_gc_trigger; /**< knobs of the adaptive trigger of garbage collection */
+  jerry_gc_stats_t ecma_gc_stats; /**< state of the garbage collections */
+  size_t ecma_gc_size_before; /**< heap usage at the start of the last collection */
+  double ecma_gc_start_time; /**< start time of the last collection (ms) */
 
   size_t jmem_heap_blocks_size; /**< block size */
   size_t jmem_full_bitwidth_pointer_overhead; /**< additional block size for full-bitwidth address */
@@ -96,9 +130,55 @@ typedef struct
 
   size_t jmem_heap_limit; /**< current limit of heap usage, that is upon being reached,
                            *   causes call of "try give memory back" callbacks */
+  size_t jmem_heap_peak_usage; /**< most heap usage so far */
+  bool jmem_is_no_gc_region; /**< garbage collection is suppressed by jerry_begin_no_gc_region */
+  bool jmem_is_no_gc_region_exhausted; /**< the heap ran out in the region, and is collected again */
+  size_t jmem_no_gc_region_start_size; /**< heap usage at the start of the region */
+  size_t jmem_no_gc_region_reserved_size; /**< headroom reserved for the region */
+  size_t jmem_no_gc_region_peak_size; /**< most heap usage in the region */
   uint32_t lit_magic_string_ex_count; /**< external magic strings count */
+  uint32_t lit_magic_string_ex_hash_displacement_count; /**< number of external magic string hash buckets */
+  uint32_t lit_magic_string_ex_hash_slot_count; /**< number of external magic string hash slots */
   uint32_t jerry_init_flags; /**< run-time configuration flags */
   uint8_t ecma_gc_visited_flip_flag; /**< current state of an object's visited flag */
+  bool ecma_gc_is_mark_stack_overflowed; /**< some visited objects are not pushed to the mark stack */
+  uint32_t ecma_gc_mark_stack_count; /**< number of objects in the mark stack */
+  ecma_object_t *ecma_gc_mark_stack[JMEM_GC__MARK_STACK_SIZE]; /**< visited objects to mark from */
+#ifdef JMEM_INCREMENTAL_GC
+  bool ecma_gc_is_marking; /**< an incremental marking is in progress */
+  bool ecma_gc_is_marked_in_pass; /**< anything is marked in the current marking pass */
+  bool ecma_gc_is_rescan_overflowed; /**< too many objects are modified during marking */
+  uint32_t ecma_gc_rescan_count; /**< number of objects in the rescan buffer */
+  ecma_object_t *ecma_gc_mark_cursor_p; /**< last unvisited object before the marking position,
+                                         *   NULL if the position is the head of the list */
+  ecma_object_t *ecma_gc_rescan_objects[JMEM_INCREMENTAL_GC__RESCAN_SIZE]; /**< visited objects modified
+                                                                            *   during marking */
+#endif /* JMEM_INCREMENTAL_GC */
+#ifdef JMEM_LAZY_SWEEP
+  ecma_object_t *ecma_gc_unswept_objects_p; /**< list of dead objects left by the last garbage collection */
+#endif /* JMEM_LAZY_SWEEP */
+#ifdef JMEM_GENERATIONAL_GC
+  ecma_object_t *ecma_gc_old_objects_p; /**< first object of the white-gray list
+                                         *   which survived a garbage collection */
+  uint32_t ecma_gc_minor_gc_count; /**< number of minor collections since last full collection */
+  bool ecma_gc_is_remembered_set_overflowed; /**< too many old objects are modified */
+  uint32_t ecma_gc_remembered_count; /**< number of objects in the remembered set */
+  ecma_object_t *ecma_gc_remembered_objects[JMEM_GENERATIONAL_GC__REMEMBERED_SET_SIZE]; /**< old objects
+                                                                                        *   modified since
+                                                                                        *   last collection */
+#endif /* JMEM_GENERATIONAL_GC */
+#ifdef CONFIG_VM_INLINE_CACHE
+  uint32_t vm_inline_cache_epoch; /**< incremented whenever a property is freed */
+  vm_inline_cache_entry_t vm_inline_caches[CONFIG_VM_INLINE_CACHE_SIZE]; /**< inline caches
+                                                                        *   of property access sites */
+#endif /* CONFIG_VM_INLINE_CACHE */
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  uint32_t ecma_enum_cache_stamp; /**< stamp of the last watched object */
+  uint32_t ecma_enum_cache_users; /**< number of cached name lists in use */
+  ecma_enum_cache_watch_t ecma_enum_cache_watches[CONFIG_ECMA_ENUM_CACHE_WATCH_SIZE]; /**< objects enumerated
+                                                                                     *   by the cached lists */
+  ecma_enum_cache_entry_t ecma_enum_cache_entries[CONFIG_ECMA_ENUM_CACHE_SIZE]; /**< cached name lists */
+#endif /* CONFIG_ECMA_ENUM_CACHE */
   uint8_t is_direct_eval_form_call; /**< direct call from eval */
   uint8_t jerry_api_available; /**< API availability flag */
 
@@ -113,12 +193,17 @@ typedef struct
 #endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
 
 #ifndef CONFIG_DISABLE_ES2015_PROMISE_BUILTIN
-  ecma_job_queueitem_t *job_queue_head_p; /**< points to the head item of the jobqueue */
-  ecma_job_queueitem_t *job_queue_tail_p; /**< points to the tail item of the jobqueue*/
+  ecma_job_queueitem_t *job_queue_buffer_p; /**< ring buffer of the enqueued jobs */
+  uint32_t job_queue_capacity; /**< number of items of the ring buffer */
+  uint32_t job_queue_head; /**< index of the first enqueued job in the ring buffer */
+  uint32_t job_queue_count; /**< number of enqueued jobs */
 #endif /* CONFIG_DISABLE_ES2015_PROMISE_BUILTIN */
 
 #ifdef JERRY_VM_EXEC_STOP
-  uint32_t vm_exec_stop_frequency; /**< reset value for vm_exec_stop_counter */
+  volatile uint8_t vm_exec_stop_pending; /**< non-zero if the VM has to call vm_exec_stop_check */
+  volatile uint8_t vm_exec_stop_requested; /**< non-zero if jerry_request_vm_exec_stop is called */
+  volatile uint8_t vm_exec_sample_requested; /**< non-zero if the CPU profiler waits for a sample */
+  uint32_t vm_exec_stop_frequency; /**< reset value for vm_exec_stop_counter, 0 if only called when requested */
   uint32_t vm_exec_stop_counter; /**< down counter for reducing the calls of vm_exec_stop_cb */
   void *vm_exec_stop_user_p; /**< user pointer for vm_exec_stop_cb */
   ecma_vm_exec_stop_callback_t vm_exec_stop_cb; /**< user function which returns whether the
@@ -136,6 +221,15 @@ typedef struct
   uint16_t debugger_receive_buffer_offset; /**< receive buffer offset */
   int debugger_connection; /**< holds the file descriptor of the socket communication */
   uint16_t debugger_port; /**< debugger socket communication port */
+  jerry_debugger_profile_sample_t debugger_profile_queue[JERRY_DEBUGGER_PROFILE_QUEUE_LENGTH]; /**< samples
+                                                                                               *   to be sent */
+  double debugger_profile_start_time; /**< start time of profiling */
+  double debugger_profile_next_time; /**< time of the next sample */
+  uint32_t debugger_profile_interval; /**< sampling interval in milliseconds */
+  uint32_t debugger_profile_dropped; /**< samples dropped as the queue was full */
+  uint8_t debugger_profile_kinds; /**< bit set of the sampled kinds, 0 if not profiling */
+  uint8_t debugger_profile_head; /**< index of the first sample in the queue */
+  uint8_t debugger_profile_count; /**< number of samples in the queue */
 #endif /* JERRY_DEBUGGER */
 
 #ifdef JMEM_STATS
@@ -151,10 +245,15 @@ typedef struct
   int num_allocated_slabs;
   bool is_slab_allocated[DE_MAX_NUM_SLABS]; // 64B
   int num_allocated_slots[DE_MAX_NUM_SLABS]; // 64B
+  unsigned char slab_size_class[DE_MAX_NUM_SLABS]; // 64B
+  // The slab each size class allocated from last
+  unsigned char current_slab[DE_SLAB_NUM_SIZE_CLASSES];
   unsigned char cp2si_rmap[JMEM_HEAP_SIZE / JMEM_ALIGNMENT]; // 32KB
 #endif /* defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB) */
 
 #ifdef JMEM_PROFILE
+  uint32_t jmem_profile_categories; /**< profilers selected at runtime */
+
   /* Total size profiling */
   struct timeval timeval_js_start;
 #ifdef PROF_SIZE__PERIOD_USEC
@@ -187,16 +286,18 @@ typedef struct
 
 #ifdef PROF_PMU
 #define PROFILER_PMU_ENTRY(x) \
-        unsigned long long x##_cycles; \
+        jmem_pmu_counters_t x##_pmu; \
         unsigned int x##_pmu_count
 
-  unsigned long long decompression_cycles_val;
-  unsigned long long compression_cycles_val;
+  jmem_pmu_counters_t decompression_pmu_watch;
+  jmem_pmu_counters_t compression_pmu_watch;
+  jmem_pmu_counters_t gc_pmu_watch;
 
   PROFILER_PMU_ENTRY(decompression);
   PROFILER_PMU_ENTRY(compression_rmc_hit);
   PROFILER_PMU_ENTRY(compression_fifo_hit);
   PROFILER_PMU_ENTRY(compression_final_miss);
+  PROFILER_PMU_ENTRY(gc);
 #endif
 
 #ifdef PROF_JSOBJECT_ALLOCATION
@@ -355,16 +456,34 @@ typedef struct
   jmem_heap_free_t first; /**< first node in free region list */
 #ifdef JMEM_SEGMENTED_HEAP
   // Segmented heap
-  uint8_t *area[SEG_NUM_SEGMENTS + 1]; // segment base table
-  jmem_segment_t segments[SEG_NUM_SEGMENTS]; // segment headers
+  uint8_t *area[SEG_MAX_NUM_SEGMENTS + 1]; // segment base table
+  jmem_segment_t segments[SEG_MAX_NUM_SEGMENTS]; // segment headers
   uint32_t segments_count; // the number of segments
+#ifdef SEG_RUNTIME_SEGMENT_SIZE
+  uint32_t segment_shift; // log2 of segment size
+#endif /* defined(SEG_RUNTIME_SEGMENT_SIZE) */
 
   // Internal variables in compression path
   uint32_t comp_i_offset;
   uint8_t *comp_i_saddr;
 
   // reverse map cache
-#if defined(SEG_RMAP_CACHE)
+#if defined(SEG_RMAP_CACHE) && defined(SEG_RMAP_CACHE_ADAPTIVE)
+  // runtime-configured cache; the active part is rmc_size entries
+  uint8_t *rmc_table_base_addr[SEG_RMAP_CACHE_SIZE];
+  uint32_t rmc_table_sidx[SEG_RMAP_CACHE_SIZE];
+  uint32_t rmc_table_stamps[SEG_RMAP_CACHE_SIZE]; // LRU ages, CLOCK ref bits
+  uint32_t rmc_table_eviction_headers[SEG_RMAP_CACHE_SIZE]; // FIFO, CLOCK
+  uint32_t rmc_index;
+  uint32_t rmc_size;
+  uint32_t rmc_set_size;
+  uint32_t rmc_set_mask;
+  uint32_t rmc_policy;
+  uint32_t rmc_stamp;
+  bool rmc_is_adaptive;
+  uint32_t rmc_window_access_count;
+  uint32_t rmc_window_miss_count;
+#elif defined(SEG_RMAP_CACHE)
 #if SEG_RMAP_CACHE_SIZE == 1 // single-entry cache
   uint8_t *rmc_single_base_addr;
   uint32_t rmc_single_sidx;
@@ -389,11 +508,41 @@ typedef struct
 #endif /* SEG_RMAP_CACHE_SIZE != 1 */
 #endif /* defined(SEG_RMAP_CACHE) */
 
+#if defined(SEG_SIZE_CLASS_BINS)
+  // size-class bins: segments which have a non-empty bin of each size class
+  uint32_t bin_bitmaps[SEG_NUM_SIZE_CLASSES][SEG_BIN_BITMAP_WORDS];
+#endif /* defined(SEG_SIZE_CLASS_BINS) */
+
+#if defined(SEG_SEGMENT_EVACUATION)
+  // segment evacuation: the number of segments being evacuated
+  uint32_t evacuating_segments_count;
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
+
+#if defined(SEG_MEMORY_REGIONS)
+  // memory regions: bitmaps of the segment slots used in each region
+  uint32_t region_used_slots[SEG_MEMORY_REGION_MAX_COUNT];
+#endif /* defined(SEG_MEMORY_REGIONS) */
+
+#if defined(SEG_SEGMENT_RETENTION)
+  // segment retention: empty segment groups are kept mapped for reuse
+  uint32_t retention_epoch; // the number of heap trims after GC
+  uint32_t retention_low; // empty segments kept however long unused
+  uint32_t retention_high; // most empty segments kept
+  uint32_t retention_age; // epochs an empty group is kept above the low mark
+  uint32_t retained_segments_count; // empty segments kept now
+#endif /* defined(SEG_SEGMENT_RETENTION) */
+
 #if defined(SEG_RMAP_BINSEARCH)
   // reverse map tree
   rb_root segment_rmap_rb_root; // Segment reverse map tree
 #endif /* defined(SEG_RMAP_BINSEARCH) */
 
+#if defined(SEG_RMAP_RADIX_TABLE)
+  // radix table: 2nd-level tables of segment indexes, indexed by upper bits
+  uint16_t *radix_l1[SEG_RMAP_RADIX_L1_SIZE];
+  uint32_t radix_l2_counts[SEG_RMAP_RADIX_L1_SIZE]; // # of valid entries
+#endif /* defined(SEG_RMAP_RADIX_TABLE) */
+
 #if defined(SEG_RMAP_2LEVEL_SEARCH)
   // 2-level search
   uint8_t *fc_table_base_addr[SEG_RMAP_2LEVEL_SEARCH_FIFO_CACHE_SIZE];
@@ -19,28 +19,58 @@
 
 #if defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB)
 
-void *alloc_a_block_from_slab(size_t size) {
-  // Search a slab
-  unsigned char slab_index;
-  bool is_slab_found = false;
-  for (slab_index = 0; slab_index < DE_MAX_NUM_SLABS; slab_index++) {
-    bool is_allocated = JERRY_CONTEXT(is_slab_allocated[slab_index]);
-    int num_allocated_slots = JERRY_CONTEXT(num_allocated_slots[slab_index]);
-    if (!is_allocated) {
-      continue;
-    }
-    if (num_allocated_slots + 1 < DE_NUM_SLOTS_PER_SLAB) {
+// Slot sizes of the size classes: the 8B and 16B pool chunks, strings and
+// property pairs of 24B and 32B, and extended objects of 48B and 64B
+static const uint32_t slab_slot_sizes[DE_SLAB_NUM_SIZE_CLASSES] = {
+    8, 16, 24, 32, 48, 64};
+
+static inline uint32_t get_slab_size_class(size_t size) {
+  JERRY_ASSERT(size > 0 && size <= DE_SLAB_MAX_SLOT_SIZE);
+  uint32_t size_class = 0;
+  while (slab_slot_sizes[size_class] < size) {
+    size_class++;
+  }
+  return size_class;
+}
+
+static inline bool is_slab_available(unsigned char slab_index,
+                                     uint32_t size_class) {
+  int num_slots = (int)(DE_SLAB_SEGMENT_SIZE / slab_slot_sizes[size_class]);
+  return JERRY_CONTEXT(is_slab_allocated[slab_index]) &&
+         JERRY_CONTEXT(slab_size_class[slab_index]) == size_class &&
+         JERRY_CONTEXT(num_allocated_slots[slab_index]) < num_slots;
+}
+
+void *alloc_a_block_from_slab(size_t size, bool ret_null_on_error) {
+  uint32_t size_class = get_slab_size_class(size);
+
+  // Search a slab of the size class, from the one used last
+  unsigned char slab_index = JERRY_CONTEXT(current_slab[size_class]);
+  bool is_slab_found = is_slab_available(slab_index, size_class);
+  for (slab_index = 0; !is_slab_found && slab_index < DE_MAX_NUM_SLABS;
+       slab_index++) {
+    if (is_slab_available(slab_index, size_class)) {
       is_slab_found = true;
       break;
     }
   }
   // Allocate a slab if proper slab is not found
   if (!is_slab_found) {
-    slab_index = alloc_a_slab_segment();
+    slab_index = alloc_a_slab_segment(size_class);
   }
+  JERRY_CONTEXT(current_slab[size_class]) = slab_index;
 
   // Allocate a real block from static heap (because it is just an emulation)
-  void *block_address = jmem_heap_alloc_block_small_object(size);
+  void *block_address =
+      ret_null_on_error ? jmem_heap_alloc_block_small_object_null_on_error(size)
+                        : jmem_heap_alloc_block_small_object(size);
+  if (block_address == NULL) {
+    // Give back the slab allocated for this block
+    if (JERRY_CONTEXT(num_allocated_slots[slab_index]) == 0) {
+      free_a_slab_segment(slab_index);
+    }
+    return NULL;
+  }
 
   // Allocate slots to the slab segment: update slab metadata
   jmem_cpointer_t block_cp = jmem_compress_pointer(block_address);
@@ -69,7 +99,7 @@ void free_a_block_from_slab(void *block_address, size_t size) {
   // JERRY_CONTEXT(num_allocated_slots[slab_index]));
 }
 
-unsigned char alloc_a_slab_segment(void) {
+unsigned char alloc_a_slab_segment(uint32_t size_class) {
   // Get a slab index for the new slab
   unsigned char slab_index;
   bool is_slab_index_found = false;
@@ -96,6 +126,7 @@ unsigned char alloc_a_slab_segment(void) {
 
   // Update slab metadata
   JERRY_CONTEXT(is_slab_allocated[slab_index]) = true;
+  JERRY_CONTEXT(slab_size_class[slab_index]) = (unsigned char)size_class;
   JERRY_CONTEXT(num_allocated_slabs)++;
 
   // Update allocated heap size, system allocator metadata size
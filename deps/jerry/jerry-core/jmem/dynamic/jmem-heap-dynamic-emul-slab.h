@@ -20,9 +20,9 @@
 #include "jcontext.h"
 
 #if defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB)
-extern void *alloc_a_block_from_slab(size_t size);
+extern void *alloc_a_block_from_slab(size_t size, bool ret_null_on_error);
 extern void free_a_block_from_slab(void *block_address, size_t size);
-extern unsigned char alloc_a_slab_segment(void);
+extern unsigned char alloc_a_slab_segment(uint32_t size_class);
 extern void free_a_slab_segment(unsigned char slab_index);
 
 #endif /* defined(JMEM_DYNAMIC_HEAP_EMUL) && \
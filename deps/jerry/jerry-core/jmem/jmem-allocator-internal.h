@@ -32,6 +32,9 @@ void jmem_heap_stats_print (void);
 void jmem_heap_init (void);
 void jmem_heap_finalize (void);
 bool jmem_is_heap_pointer (const void *pointer);
+#ifdef SEG_SIZE_CLASS_BINS
+void jmem_heap_flush_size_class_bins (void);
+#endif /* SEG_SIZE_CLASS_BINS */
 
 void jmem_run_free_unused_memory_callbacks (jmem_free_unused_memory_severity_t severity);
 
@@ -158,10 +158,18 @@ jmem_unregister_free_unused_memory_callback (jmem_free_unused_memory_callback_t
 
 /**
  * Run 'try to give memory back' callbacks with specified severity
+ *
+ * Note:
+ *      nothing is run while garbage collection is suppressed
  */
 void
 jmem_run_free_unused_memory_callbacks (jmem_free_unused_memory_severity_t severity) /**< severity of the request */
 {
+  if (jmem_is_gc_suppressed ())
+  {
+    return;
+  }
+
   if (JERRY_CONTEXT (jmem_free_unused_memory_callback) != NULL)
   {
     JERRY_CONTEXT (jmem_free_unused_memory_callback) (severity);
@@ -169,11 +177,40 @@ jmem_run_free_unused_memory_callbacks (jmem_free_unused_memory_severity_t severi
 
   jmem_pools_collect_empty ();
 
+#ifdef SEG_SIZE_CLASS_BINS
+  jmem_heap_flush_size_class_bins ();
+#endif /* SEG_SIZE_CLASS_BINS */
+
 #ifdef JMEM_SEGMENTED_HEAP
-  free_empty_segment_groups ();
+  /* Retained segments are given up only when memory is short */
+  if (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH)
+  {
+    free_all_empty_segment_groups ();
+  }
+  else
+  {
+    free_empty_segment_groups ();
+  }
 #endif /* JMEM_SEGMENTED_HEAP */
+
+#ifdef SEG_SEGMENT_EVACUATION
+  mark_sparse_segment_groups ();
+#endif /* SEG_SEGMENT_EVACUATION */
 } /* jmem_run_free_unused_memory_callbacks */
 
+/**
+ * Check whether garbage collection is suppressed: it is in a GC-free region,
+ * until the heap is exhausted in the region.
+ *
+ * @return true - if garbage collection should not be run now,
+ *         false - otherwise
+ */
+bool
+jmem_is_gc_suppressed (void)
+{
+  return (JERRY_CONTEXT (jmem_is_no_gc_region) && !JERRY_CONTEXT (jmem_is_no_gc_region_exhausted));
+} /* jmem_is_gc_suppressed */
+
 #ifdef JMEM_STATS
 /**
  * Print memory usage statistics
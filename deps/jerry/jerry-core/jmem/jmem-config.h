@@ -21,16 +21,76 @@
 #include "config.h"
 
 /* Garbage collection type configs */
+#define JMEM_GC__MARK_STACK_SIZE 128 // objects to mark from, list passes if full
+
 // #define JMEM_LAZY_GC
+// #define JMEM_INCREMENTAL_GC // time-sliced marking driven by jerry_gc_step()
+
+#ifdef JMEM_INCREMENTAL_GC
+#define JMEM_INCREMENTAL_GC__RESCAN_SIZE 64 // objects modified during marking
+#endif /* defined(JMEM_INCREMENTAL_GC) */
+
+// #define JMEM_LAZY_SWEEP // dead objects of automatic GCs freed by jerry_gc_step()
+
+// #define JMEM_GENERATIONAL_GC // minor GCs of objects allocated since last GC
+
+#ifdef JMEM_GENERATIONAL_GC
+#define JMEM_GENERATIONAL_GC__REMEMBERED_SET_SIZE 128 // modified old objects
+#define JMEM_GENERATIONAL_GC__MAX_MINOR_GCS 8 // minor GCs between full GCs
+#endif /* defined(JMEM_GENERATIONAL_GC) */
+
+#if defined(JMEM_INCREMENTAL_GC) && defined(JMEM_GENERATIONAL_GC)
+#error "JMEM_INCREMENTAL_GC and JMEM_GENERATIONAL_GC cannot be enabled together"
+#endif
+
+// #define JMEM_HEAP_SNAPSHOT // live objects and their retainers to a file
+
+// #define JMEM_HEAP_FREE_INDEX // bitmap of free regions, for frees in O(1)
+
+/* Pool manager configs */
+// #define JMEM_POOLS_SIZE_CLASSES // pool objects/property pairs up to max size
+
+#ifdef JMEM_POOLS_SIZE_CLASSES
+#define JMEM_POOLS_MAX_CHUNK_SIZE 64 // largest pooled chunk (unit: bytes)
+#endif /* defined(JMEM_POOLS_SIZE_CLASSES) */
 
 /* Segmented heap allocation configs */
+// #define SEG_RUNTIME_SEGMENT_SIZE // segment size chosen at jerry_init() time
+
+// Heaps over 1MB, which need 32-bit compressed pointers, are divided into
+// larger segments to keep the segment tables and their searches small
+#if defined(JERRY_CPOINTER_32_BIT) && CONFIG_MEM_HEAP_AREA_SIZE > (1024 * 1024)
+#define SEG_LARGE_HEAP
+#endif /* defined(JERRY_CPOINTER_32_BIT) && CONFIG_MEM_HEAP_AREA_SIZE > 1MB */
+
+#ifdef SEG_RUNTIME_SEGMENT_SIZE
+#define SEG_MIN_SEGMENT_SHIFT 9      // 512B
+#define SEG_MAX_SEGMENT_SHIFT 15     // 32KB (16-bit segment-local offsets)
+#ifdef SEG_LARGE_HEAP
+#define SEG_DEFAULT_SEGMENT_SHIFT 15 // 32KB
+#else /* defined(SEG_LARGE_HEAP) */
+#define SEG_DEFAULT_SEGMENT_SHIFT 11 // 2KB
+#endif /* !defined(SEG_LARGE_HEAP) */
+#define SEG_SEGMENT_SHIFT (JERRY_HEAP_CONTEXT(segment_shift))
+#define SEG_SEGMENT_SIZE (1u << SEG_SEGMENT_SHIFT)
+#elif defined(SEG_LARGE_HEAP) /* defined(SEG_RUNTIME_SEGMENT_SIZE) */
+#define SEG_SEGMENT_SIZE 32768
+#define SEG_SEGMENT_SHIFT 15
+#define SEG_MIN_SEGMENT_SHIFT SEG_SEGMENT_SHIFT
+#else /* defined(SEG_RUNTIME_SEGMENT_SIZE) */
 #define SEG_SEGMENT_SIZE 2048
 #define SEG_SEGMENT_SHIFT 11
+#define SEG_MIN_SEGMENT_SHIFT SEG_SEGMENT_SHIFT
+#endif /* !defined(SEG_RUNTIME_SEGMENT_SIZE) */
 
 /* Heap allocation type */
 // 1) Real dynamic heap - if JMEM_SYSTEM_ALLOCATOR in CMakeLists.txt is enabled
+// The other types can also be chosen with a compile flag, such as
+// -DJMEM_STATIC_HEAP, to build the jerry-replay of each allocator
+#if !defined(JMEM_DYNAMIC_HEAP_EMUL) && !defined(JMEM_STATIC_HEAP)
 #define JMEM_SEGMENTED_HEAP // 2) Segmented heap
 // #define JMEM_DYNAMIC_HEAP_EMUL // 3) Dynamic heap emulation
+#endif /* !defined(JMEM_DYNAMIC_HEAP_EMUL) && !defined(JMEM_STATIC_HEAP) */
 // 4) Static heap - else
 
 
@@ -43,33 +103,102 @@
 
 // #define SEG_FULLBIT_ADDRESS_ALLOC // fullbit-address allocation
 
+// Allocation fast path
+// #define SEG_SIZE_CLASS_BINS        // segregated free lists per size class
+
+// Segment placement
+// #define SEG_MEMORY_REGIONS         // segments in fast memory of the board
+
+// Segment reclamation
+// #define SEG_SEGMENT_EVACUATION     // drain sparse segment groups after GC
+// #define SEG_SEGMENT_RETENTION      // keep empty segment groups for a while
+
 // Fast path
 #define SEG_RMAP_CACHE             // caching in reverse map
 // Slow path
 #define SEG_RMAP_BINSEARCH         // binary search for reverse map
 // #define SEG_RMAP_2LEVEL_SEARCH     // 2-level search for reverse map
+// #define SEG_RMAP_RADIX_TABLE       // radix table for reverse map
 
 #elif defined(JMEM_DYNAMIC_HEAP_EMUL) // 3) Dynamic heap emulation
 #define DE_SLAB // dynamic heap emulation with slab segment
 
 #else
+#ifndef JMEM_STATIC_HEAP
 #define JMEM_STATIC_HEAP // 4) Static heap
+#endif /* !defined(JMEM_STATIC_HEAP) */
 // no options
 
 #endif
 
 /* Reverse map caching config */
 #ifdef SEG_RMAP_CACHE
+// #define SEG_RMAP_CACHE_ADAPTIVE // runtime geometry, replacement and sizing
+
+#ifdef SEG_RMAP_CACHE_ADAPTIVE
+// Replacement policies
+#define SEG_RMAP_CACHE_POLICY_FIFO 0
+#define SEG_RMAP_CACHE_POLICY_LRU 1
+#define SEG_RMAP_CACHE_POLICY_CLOCK 2
+
+#define SEG_RMAP_CACHE_SIZE 64     // cache capacity (unit: # of entries)
+#define SEG_RMAP_CACHE_MIN_SIZE 4  // minimum active size (unit: # of entries)
+#define SEG_RMAP_CACHE_INIT_SIZE 16    // initial active size
+#define SEG_RMAP_CACHE_INIT_SET_SIZE 2 // initial set size
+#define SEG_RMAP_CACHE_INIT_POLICY SEG_RMAP_CACHE_POLICY_LRU
+#define SEG_RMAP_CACHE_ADAPT_PERIOD 4096  // window (unit: # of accesses)
+#define SEG_RMAP_CACHE_ADAPT_GROW_RATIO 90   // grow below it (unit: %)
+#define SEG_RMAP_CACHE_ADAPT_SHRINK_RATIO 99 // shrink above it (unit: %)
+#else /* defined(SEG_RMAP_CACHE_ADAPTIVE) */
 #define SEG_RMAP_CACHE_SIZE 16     // cache size (unit: # of entries)
 #define SEG_RMAP_CACHE_SET_SIZE 1 // set size (unit: # of entries)
 #define SEG_RMAP_CACHE_WAYS (SEG_RMAP_CACHE_SIZE / SEG_RMAP_CACHE_SET_SIZE)
+#endif /* !defined(SEG_RMAP_CACHE_ADAPTIVE) */
 #endif /* defined(SEG_RMAP_CACHE) */
 
+/* Size-class bins config */
+#ifdef SEG_SIZE_CLASS_BINS
+#define SEG_SIZE_CLASS_MAX_SIZE 64 // largest binned block (unit: bytes)
+#endif /* defined(SEG_SIZE_CLASS_BINS) */
+
+/* Memory regions config */
+#ifdef SEG_MEMORY_REGIONS
+// jerry-board-config.h gives the regions in the order they are filled, e.g.
+//   #define SEG_MEMORY_REGION_TABLE { { (uint8_t *)0x10004000, 48 * 1024 } }
+// and may restrict them to the initial segment and the hottest ones, e.g.
+//   #define SEG_MEMORY_REGION_HOT_SEGMENTS { 1, 2, 5 }
+#ifndef SEG_MEMORY_REGION_TABLE
+#error "SEG_MEMORY_REGIONS needs SEG_MEMORY_REGION_TABLE in jerry-board-config.h"
+#endif /* !defined(SEG_MEMORY_REGION_TABLE) */
+#define SEG_MEMORY_REGION_MAX_COUNT 4  // regions (unit: # of regions)
+#define SEG_MEMORY_REGION_MAX_SLOTS 32 // segments used of each region
+#endif /* defined(SEG_MEMORY_REGIONS) */
+
+/* Segment evacuation config */
+#ifdef SEG_SEGMENT_EVACUATION
+#define SEG_SEGMENT_EVACUATION_THRESHOLD 25 // occupancy below it (unit: %)
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
+
+/* Segment retention config */
+#ifdef SEG_SEGMENT_RETENTION
+#define SEG_SEGMENT_RETENTION_LOW 1  // kept however long unused (unit: segments)
+#define SEG_SEGMENT_RETENTION_HIGH 4 // most kept (unit: segments)
+#define SEG_SEGMENT_RETENTION_AGE 4  // kept above the low mark (unit: GCs)
+#endif /* defined(SEG_SEGMENT_RETENTION) */
+
 /* 2-level search config */
 #ifdef SEG_RMAP_2LEVEL_SEARCH
 #define SEG_RMAP_2LEVEL_SEARCH_FIFO_CACHE_SIZE 4 // FIFO cache size
 #endif /* defined(SEG_RMAP_2LEVEL_SEARCH) */
 
+/* Radix table config */
+#ifdef SEG_RMAP_RADIX_TABLE
+// Radix table requires segment-aligned segment groups, and replaces the others
+#undef SEG_RMAP_BINSEARCH
+#undef SEG_RMAP_2LEVEL_SEARCH
+#define SEG_RMAP_RADIX_L1_BITS 10 // 1st-level index bits (upper address bits)
+#endif /* defined(SEG_RMAP_RADIX_TABLE) */
+
 /* Profiler configs */
 // #define JMEM_PROFILE
 
@@ -81,6 +210,36 @@
 // #define PROF_SEGMENT // It may degrade performance
 // #define PROF_JSOBJECT // It may degrade performance
 // #define PROF_COUNT // It may degrade performance
+// #define PROF_SAMPLING // It may degrade performance
+// #define PROF_OPCODE // It may degrade performance harshly
+// #define PROF_CPU
+// #define PROF_TRACE // It may degrade performance
+
+// Build in all the profilers, but leave them off until they are selected at
+// runtime (jerry_set_jmem_profile_categories)
+// #define PROF_ALL
+
+#ifdef PROF_ALL
+#define PROF_SIZE
+#define PROF_TIME
+#define PROF_TIME__ALLOC
+#define PROF_TIME__FREE
+#define PROF_TIME__GC
+#define PROF_TIME__DECOMPRESSION
+#define PROF_TIME__COMPRESSION
+#define PROF_PMU
+#define PROF_PMU__GC_CYCLES
+#define PROF_CPTL
+#define PROF_CPTL_RMC_HIT_RATIO
+#define PROF_SEGMENT
+#define PROF_JSOBJECT
+#define PROF_COUNT
+#define PROF_SAMPLING
+#define PROF_OPCODE
+#define PROF_CPU
+#define PROF_TRACE
+#define PROF_DEFAULT_CATEGORIES 0
+#endif /* defined(PROF_ALL) */
 
 /* jmem-profiler-size.c */
 #ifdef PROF_SIZE
@@ -107,6 +266,10 @@
 #ifdef PROF_PMU
 #define PROF_PMU__DECOMPRESSION_CYCLES // It may degrade performance
 #define PROF_PMU__COMPRESSION_CYCLES   // It may degrade performance
+// #define PROF_PMU__GC_CYCLES
+// Linux perf_event_open backend: cycles, instructions, cache misses and
+// branch misses. Raw ARM cycle counter is used if it is not available.
+// #define PROF_PMU__PERF_EVENT
 #endif
 
 #ifdef PROF_PMU__COMPRESSION_CYCLES
@@ -141,6 +304,26 @@
 #define PROF_JSOBJECT_ALLOCATION__MAX_SIZE 1024
 #endif /* defined(PROF_JSOBJECT) */
 
+/* jmem-profiler-sampling.c */
+#ifdef PROF_SAMPLING
+#define PROF_SAMPLING__INTERVAL_BYTES (64 * 1024) // bytes allocated per sample
+#define PROF_SAMPLING__MAX_DEPTH 32 // frames kept in a sampled stack
+#endif /* defined(PROF_SAMPLING) */
+
+/* jmem-profiler-cpu.c */
+#ifdef PROF_CPU
+#define PROF_CPU__MAX_DEPTH 32 // frames kept in a sampled stack
+// Samples are taken at the execution stop checks of the VM
+#ifndef JERRY_VM_EXEC_STOP
+#undef PROF_CPU
+#endif
+#endif /* defined(PROF_CPU) */
+
+/* jmem-profiler-trace.c */
+#ifdef PROF_TRACE
+#define PROF_TRACE__BUFFER_SIZE 4096 // events buffered before a write
+#endif /* defined(PROF_TRACE) */
+
 /* jmem-profiler-count.c */
 #ifdef PROF_COUNT
 #define PROF_COUNT__MAX_TYPES 10 // default type count
@@ -0,0 +1,114 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jmem-heap-free-index.h"
+
+#include "jcontext.h"
+#include "jmem-config.h"
+#include "jmem.h"
+#include "jrt-libc-includes.h"
+
+#ifdef JMEM_HEAP_FREE_INDEX
+/* Free region index
+ * A bitmap has a bit for each JMEM_ALIGNMENT unit of the heap, set at the
+ * start of each free region, and a summary bitmap has a bit for each word of
+ * it which is not zero. The free region before a freed block is found in a
+ * few words of the bitmaps instead of walking the free region list, so that
+ * the cost of a free does not grow with the number of free regions.
+ */
+
+#if defined(ECMA_VALUE_CAN_STORE_UINTPTR_VALUE_DIRECTLY) && \
+    defined(JMEM_SEGMENTED_HEAP)
+#error "JMEM_HEAP_FREE_INDEX needs the compressed offsets of segmented heap"
+#endif
+
+static inline uint32_t __attr_always_inline___
+offset_to_unit(uint32_t offset) {
+#ifdef ECMA_VALUE_CAN_STORE_UINTPTR_VALUE_DIRECTLY
+  // Free region offsets are the addresses themselves
+  offset -= (uint32_t)(uintptr_t)JERRY_HEAP_CONTEXT(area);
+#endif /* defined(ECMA_VALUE_CAN_STORE_UINTPTR_VALUE_DIRECTLY) */
+  return offset / JMEM_ALIGNMENT;
+}
+
+static inline jmem_heap_free_t *__attr_always_inline___
+unit_to_region(uint32_t unit) {
+  uint32_t offset = unit * JMEM_ALIGNMENT;
+#ifdef ECMA_VALUE_CAN_STORE_UINTPTR_VALUE_DIRECTLY
+  offset += (uint32_t)(uintptr_t)JERRY_HEAP_CONTEXT(area);
+#endif /* defined(ECMA_VALUE_CAN_STORE_UINTPTR_VALUE_DIRECTLY) */
+  return JMEM_DECOMPRESS_POINTER_INTERNAL(offset);
+}
+
+static inline uint32_t __attr_always_inline___ last_bit(uint32_t bitmap) {
+  return 31 - (uint32_t)__builtin_clz(bitmap);
+}
+
+void jmem_heap_free_index_init(void) {
+  memset(JERRY_CONTEXT(jmem_free_index), 0,
+         sizeof(JERRY_CONTEXT(jmem_free_index)));
+  memset(JERRY_CONTEXT(jmem_free_index_summary), 0,
+         sizeof(JERRY_CONTEXT(jmem_free_index_summary)));
+}
+
+void jmem_heap_free_index_insert(uint32_t offset) {
+  uint32_t unit = offset_to_unit(offset);
+  uint32_t word = unit / 32;
+  JERRY_ASSERT(word < JMEM_HEAP_FREE_INDEX_WORDS);
+
+  JERRY_CONTEXT(jmem_free_index[word]) |= (uint32_t)1 << (unit % 32);
+  JERRY_CONTEXT(jmem_free_index_summary[word / 32]) |=
+      (uint32_t)1 << (word % 32);
+}
+
+void jmem_heap_free_index_remove(uint32_t offset) {
+  uint32_t unit = offset_to_unit(offset);
+  uint32_t word = unit / 32;
+  JERRY_ASSERT(word < JMEM_HEAP_FREE_INDEX_WORDS);
+
+  JERRY_CONTEXT(jmem_free_index[word]) &= ~((uint32_t)1 << (unit % 32));
+  if (JERRY_CONTEXT(jmem_free_index[word]) == 0) {
+    JERRY_CONTEXT(jmem_free_index_summary[word / 32]) &=
+        ~((uint32_t)1 << (word % 32));
+  }
+}
+
+jmem_heap_free_t *jmem_heap_free_index_find_prev(uint32_t offset) {
+  uint32_t unit = offset_to_unit(offset);
+  uint32_t word = unit / 32;
+
+  // Free regions before the offset in its word
+  uint32_t bitmap = JERRY_CONTEXT(jmem_free_index[word]) &
+                    (((uint32_t)1 << (unit % 32)) - 1);
+  if (bitmap != 0) {
+    return unit_to_region(word * 32 + last_bit(bitmap));
+  }
+
+  // The last word before it with a free region
+  uint32_t summary_word = word / 32;
+  uint32_t summary = JERRY_CONTEXT(jmem_free_index_summary[summary_word]) &
+                     (((uint32_t)1 << (word % 32)) - 1);
+  while (summary == 0) {
+    if (summary_word == 0) {
+      return &JERRY_HEAP_CONTEXT(first);
+    }
+    summary = JERRY_CONTEXT(jmem_free_index_summary[--summary_word]);
+  }
+
+  word = summary_word * 32 + last_bit(summary);
+  bitmap = JERRY_CONTEXT(jmem_free_index[word]);
+  return unit_to_region(word * 32 + last_bit(bitmap));
+}
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
@@ -0,0 +1,36 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JMEM_HEAP_FREE_INDEX_H
+#define JMEM_HEAP_FREE_INDEX_H
+
+#include "jmem-config.h"
+#include "jmem.h"
+#include "jrt.h"
+
+#ifdef JMEM_HEAP_FREE_INDEX
+// Clear the index, before the first free region is added
+extern void jmem_heap_free_index_init(void);
+
+// Add or remove a free region starting at the offset
+extern void jmem_heap_free_index_insert(uint32_t offset);
+extern void jmem_heap_free_index_remove(uint32_t offset);
+
+// Get the free region preceding the offset in address order, or the leading
+// free region of the heap if there is none
+extern jmem_heap_free_t *jmem_heap_free_index_find_prev(uint32_t offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
+
+#endif /* !defined(JMEM_HEAP_FREE_INDEX_H) */
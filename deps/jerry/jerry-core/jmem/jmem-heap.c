@@ -23,8 +23,11 @@
 #include "jrt-libc-includes.h"
 
 #include "jmem-heap-segmented.h"
+#include "jmem-heap-segmented-bins.h"
+#include "cptl-rmap-cache.h"
 #define JMEM_ALLOCATOR_INTERNAL
 #include "jmem-allocator-internal.h"
+#include "jmem-heap-free-index.h"
 #include "jmem-heap-dynamic-emul-slab.h"
 #include "jmem-profiler.h"
 
@@ -96,7 +99,11 @@ static inline void jmem_heap_print_allocator_type(void) {
     (JMEM_HEAP_AREA_SIZE / 1024), JMEM_HEAP_AREA_SIZE);
 
 // Addressing
-#if defined(JERRY_CPOINTER_32_BIT) \
+#if defined(JMEM_SEGMENTED_HEAP) && defined(JERRY_CPOINTER_32_BIT) \
+    && !defined(SEG_FULLBIT_ADDRESS_ALLOC) \
+    && !defined(ECMA_VALUE_CAN_STORE_UINTPTR_VALUE_DIRECTLY)
+  printf(">> Addressing: Multiple base compressed (MBCA), 32-bit\n");
+#elif defined(JERRY_CPOINTER_32_BIT) \
     || defined(SEG_FULLBIT_ADDRESS_ALLOC) \
     || defined(JMEM_DYNAMIC_HEAP_EMUL)
   printf(">> Addressing: Full-bitwidth\n");
@@ -128,7 +135,10 @@ static inline void jmem_heap_print_allocator_type(void) {
   // MBCAT Fast path
 #if defined(SEG_RMAP_CACHE)
   printf(">>>> MBCAT Fast path: reverse map cache (RMC)\n");
-#if SEG_RMAP_CACHE_SET_SIZE == 1
+#if defined(SEG_RMAP_CACHE_ADAPTIVE)
+  printf(">>>>>> Runtime-configured, cache capacity: %d\n", SEG_RMAP_CACHE_SIZE);
+  print_rmap_cache_config();
+#elif SEG_RMAP_CACHE_SET_SIZE == 1
   printf(">>>>>> Direct-mapped, cache size: %d\n", SEG_RMAP_CACHE_SIZE);
 #elif SEG_RMAP_CACHE_SIZE == SEG_RMAP_CACHE_SET_SIZE
   printf(">>>>>> Fully-associative, cache size: %d\n", SEG_RMAP_CACHE_SIZE);
@@ -143,8 +153,23 @@ static inline void jmem_heap_print_allocator_type(void) {
   printf(">>>> MBCAT Fast path: none\n");
 #endif /* !defined(SEG_RMAP_CACHE) */
 
+  // Segment reclamation
+#if defined(SEG_SEGMENT_EVACUATION)
+  printf(">>>> Segment reclamation: evacuation (threshold: %d%%)\n",
+         SEG_SEGMENT_EVACUATION_THRESHOLD);
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
+
+  // Allocation fast path
+#if defined(SEG_SIZE_CLASS_BINS)
+  printf(">>>> Allocation fast path: size-class bins (max size: %dB)\n",
+         SEG_SIZE_CLASS_MAX_SIZE);
+#endif /* defined(SEG_SIZE_CLASS_BINS) */
+
   // MBCAT Slow path
-#if defined(SEG_RMAP_BINSEARCH)
+#if defined(SEG_RMAP_RADIX_TABLE)
+  printf(">>>> MBCAT Slow path: radix table lookup (L1 bits: %d, L2 bits: %d)\n",
+         SEG_RMAP_RADIX_L1_BITS, SEG_RMAP_RADIX_L2_BITS);
+#elif defined(SEG_RMAP_BINSEARCH)
   printf(">>>> MBCAT Slow path: binary search based on reverse map tree (RMT)\n");
 #elif defined(SEG_RMAP_2LEVEL_SEARCH)
   printf(">>>> MBCAT Slow path: 2-level search (FIFO cache size: %d)\n",
@@ -184,6 +209,11 @@ static inline void jmem_heap_init_first_free_region(void) {
   profile_inc_count_compression_callers(1); // compression callers
 #endif
   JERRY_CONTEXT(jmem_heap_list_skip_p) = &JERRY_HEAP_CONTEXT(first);
+
+#ifdef JMEM_HEAP_FREE_INDEX
+  jmem_heap_free_index_init();
+  jmem_heap_free_index_insert(JERRY_HEAP_CONTEXT(first).next_offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
 }
 
 static inline void jmem_heap_init_size_metrics(void) {
@@ -209,6 +239,9 @@ void jmem_heap_init(void) {
 #ifndef JERRY_SYSTEM_ALLOCATOR
   JERRY_ASSERT((uintptr_t)JERRY_HEAP_CONTEXT(area) % JMEM_ALIGNMENT == 0);
 #endif /* !defined(JERRY_SYSTEM_ALLOCATOR) */
+#if defined(JMEM_SEGMENTED_HEAP) && defined(SEG_RUNTIME_SEGMENT_SIZE)
+  init_segment_size();
+#endif /* defined(JMEM_SEGMENTED_HEAP) && defined(SEG_RUNTIME_SEGMENT_SIZE) */
   jmem_heap_print_allocator_type();
 
 #if !defined(JERRY_SYSTEM_ALLOCATOR)
@@ -230,14 +263,48 @@ void jmem_heap_init(void) {
 void jmem_heap_finalize(void) {
   finalize_profilers(); /* Finalize profilers */
 
+#ifdef SEG_SIZE_CLASS_BINS
+  jmem_heap_flush_size_class_bins();
+#endif /* SEG_SIZE_CLASS_BINS */
 #ifdef JMEM_SEGMENTED_HEAP
-  free_empty_segment_groups();
+  free_all_empty_segment_groups();
   free_initial_segment_group();
   JERRY_ASSERT(JERRY_HEAP_CONTEXT(segments_count) == 0);
 #endif
   JERRY_ASSERT(JERRY_CONTEXT(jmem_heap_blocks_size) == 0);
 } /* jmem_heap_finalize */
 
+/**
+ * Get the heap usage the GC trigger compares with its limit.
+ */
+static inline size_t __attr_always_inline___ jmem_heap_get_usage(void) {
+#if defined(JMEM_STATIC_HEAP) || defined(JMEM_SEGMENTED_HEAP)
+  return JERRY_CONTEXT(jmem_heap_blocks_size);
+#else  /* defined(JMEM_STATIC_HEAP) || defined(JMEM_SEGMENTED_HEAP) */
+  return JERRY_CONTEXT(jmem_allocated_heap_size);
+#endif /* !defined(JMEM_STATIC_HEAP) && !defined(JMEM_SEGMENTED_HEAP) */
+} /* jmem_heap_get_usage */
+
+/**
+ * Record the heap usage after an allocation, if it is the most so far.
+ */
+static inline void __attr_always_inline___ jmem_heap_update_peak_usage(void) {
+  size_t usage = jmem_heap_get_usage();
+  if (usage > JERRY_CONTEXT(jmem_heap_peak_usage)) {
+    JERRY_CONTEXT(jmem_heap_peak_usage) = usage;
+  }
+} /* jmem_heap_update_peak_usage */
+
+/**
+ * Get the heap usage, and the most of it so far.
+ */
+void jmem_heap_get_usage_stats(size_t *usage_p,      /**< [out] heap usage */
+                               size_t *peak_usage_p) /**< [out] peak usage */
+{
+  *usage_p = jmem_heap_get_usage();
+  *peak_usage_p = JERRY_MAX(JERRY_CONTEXT(jmem_heap_peak_usage), *usage_p);
+} /* jmem_heap_get_usage_stats */
+
 static inline void *jmem_heap_alloc_block_internal_fast(bool is_small_block) {
   /* Fast path for 8B blocks, first region is guaranteed to be sufficient. */
   jmem_heap_free_t *data_space_p = NULL;
@@ -273,7 +340,7 @@ static inline void *jmem_heap_alloc_block_internal_fast(bool is_small_block) {
   uint32_t block_offset = JERRY_HEAP_CONTEXT(first).next_offset;
 #ifdef JMEM_SEGMENTED_HEAP
   // Update segment occupied size (segment heap)
-  uint32_t sidx = block_offset / SEG_SEGMENT_SIZE;
+  uint32_t sidx = block_offset >> SEG_SEGMENT_SHIFT;
   jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[sidx]);
   segment_header->occupied_size += JMEM_ALIGNMENT;
   // JERRY_ASSERT(segment_header->occupied_size <= SEG_SEGMENT_SIZE);
@@ -281,6 +348,9 @@ static inline void *jmem_heap_alloc_block_internal_fast(bool is_small_block) {
   JMEM_HEAP_STAT_ALLOC_ITER();
 
   // Update free region metadata
+#ifdef JMEM_HEAP_FREE_INDEX
+  jmem_heap_free_index_remove(block_offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
   if (data_space_p->size == JMEM_ALIGNMENT) {
     JERRY_HEAP_CONTEXT(first).next_offset = data_space_p->next_offset;
   } else {
@@ -291,6 +361,9 @@ static inline void *jmem_heap_alloc_block_internal_fast(bool is_small_block) {
     remaining_p->size = data_space_p->size - JMEM_ALIGNMENT;
     remaining_p->next_offset = data_space_p->next_offset;
     JERRY_HEAP_CONTEXT(first).next_offset = remaining_offset;
+#ifdef JMEM_HEAP_FREE_INDEX
+    jmem_heap_free_index_insert(remaining_offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
   }
 
   // Update fast path skipping pointer
@@ -307,6 +380,9 @@ static inline void *jmem_heap_alloc_block_internal_slow(
   jmem_heap_free_t *data_space_p = NULL;
   uint32_t current_offset = JERRY_HEAP_CONTEXT(first).next_offset;
   jmem_heap_free_t *prev_p = &JERRY_HEAP_CONTEXT(first);
+#ifdef SEG_SEGMENT_EVACUATION
+  bool is_evacuating = JERRY_HEAP_CONTEXT(evacuating_segments_count) > 0;
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
   while (current_offset != JMEM_HEAP_END_OF_LIST) {
     jmem_heap_free_t *current_p =
         JMEM_DECOMPRESS_POINTER_INTERNAL(current_offset);
@@ -314,6 +390,17 @@ static inline void *jmem_heap_alloc_block_internal_slow(
     JMEM_HEAP_STAT_ALLOC_ITER();
 
     const uint32_t next_offset = current_p->next_offset;
+
+#ifdef SEG_SEGMENT_EVACUATION
+    // Skip free regions in segments being evacuated
+    if (is_evacuating &&
+        JERRY_HEAP_CONTEXT(segments[current_offset >> SEG_SEGMENT_SHIFT])
+            .is_evacuating) {
+      prev_p = current_p;
+      current_offset = next_offset;
+      continue;
+    }
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
 // #ifdef JMEM_SEGMENTED_HEAP
 //     jmem_heap_free_t *next_p = JMEM_DECOMPRESS_POINTER_INTERNAL(next_offset);
 //     JERRY_ASSERT(next_offset == JMEM_HEAP_END_OF_LIST_UINT32 ||
@@ -359,7 +446,7 @@ static inline void *jmem_heap_alloc_block_internal_slow(
           block_start_offset + (uint32_t)size_to_alloc - JMEM_ALIGNMENT;
       uint32_t fragment_start_offset = block_start_offset;
       while (size_to_alloc > 0) {
-        uint32_t sidx = fragment_start_offset / SEG_SEGMENT_SIZE;
+        uint32_t sidx = fragment_start_offset >> SEG_SEGMENT_SHIFT;
         uint32_t segment_end_offset =
             (sidx + 1) * SEG_SEGMENT_SIZE - JMEM_ALIGNMENT;
         uint32_t fragment_end_offset;
@@ -380,6 +467,10 @@ static inline void *jmem_heap_alloc_block_internal_slow(
       }
 #endif
 
+#ifdef JMEM_HEAP_FREE_INDEX
+      jmem_heap_free_index_remove(current_offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
+
       /* Region was larger than necessary. */
       if (current_p->size > required_size) {
         /* Get address of remaining space. */
@@ -396,6 +487,9 @@ static inline void *jmem_heap_alloc_block_internal_slow(
 #else
         prev_p->next_offset = JMEM_COMPRESS_POINTER_INTERNAL(remaining_p);
 #endif
+#ifdef JMEM_HEAP_FREE_INDEX
+        jmem_heap_free_index_insert(prev_p->next_offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
       }
       /* Block is an exact fit. */
       else {
@@ -453,13 +547,29 @@ static __attr_hot___ void *jmem_heap_alloc_block_internal(const size_t size,
       ((size + JMEM_ALIGNMENT - 1) / JMEM_ALIGNMENT) * JMEM_ALIGNMENT;
   // Try to allocate block
   jmem_heap_free_t *data_space_p = NULL;
-  if (required_size == JMEM_ALIGNMENT &&
+#ifdef SEG_SEGMENT_EVACUATION
+  // Fast path takes the first free region regardless of its segment
+  bool is_fast_path_allowed =
+      JERRY_HEAP_CONTEXT(evacuating_segments_count) == 0;
+#else  /* defined(SEG_SEGMENT_EVACUATION) */
+  bool is_fast_path_allowed = true;
+#endif /* !defined(SEG_SEGMENT_EVACUATION) */
+  if (required_size == JMEM_ALIGNMENT && is_fast_path_allowed &&
       likely(JERRY_HEAP_CONTEXT(first).next_offset != JMEM_HEAP_END_OF_LIST)) {
     data_space_p = jmem_heap_alloc_block_internal_fast(is_small_block);
   } else {
     data_space_p =
         jmem_heap_alloc_block_internal_slow(required_size, is_small_block);
   }
+#ifdef SEG_SEGMENT_EVACUATION
+  if (unlikely(data_space_p == NULL) &&
+      JERRY_HEAP_CONTEXT(evacuating_segments_count) > 0) {
+    // Evacuation should not make the heap grow: reuse evacuated segments
+    cancel_segment_evacuation();
+    data_space_p =
+        jmem_heap_alloc_block_internal_slow(required_size, is_small_block);
+  }
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
 
   // legacy code: jmem_heap_init (it does not contribute to jmem-heap behaviors)
   while (JERRY_CONTEXT(jmem_heap_blocks_size) >=
@@ -473,11 +583,13 @@ static __attr_hot___ void *jmem_heap_alloc_block_internal(const size_t size,
   }
   // JERRY_ASSERT((uintptr_t)data_space_p % JMEM_ALIGNMENT == 0);
   JMEM_HEAP_STAT_ALLOC(size);
+  jmem_heap_update_peak_usage();
   profile_alloc_end(); /* Time profiling */
   return (void *)data_space_p;
 #else  /* JERRY_SYSTEM_ALLOCATOR */
   void *data_space_p =
       jmem_heap_alloc_block_internal_dynamic_real(size, is_small_block);
+  jmem_heap_update_peak_usage();
   profile_alloc_end(); /* Time profiling */
   return data_space_p;
 #endif /* !JERRY_SYSTEM_ALLOCATOR */
@@ -508,6 +620,7 @@ static void *jmem_heap_gc_and_alloc_block(
   }
   size_t size =
       (required_size + JMEM_ALIGNMENT - 1) / JMEM_ALIGNMENT * JMEM_ALIGNMENT;
+  profile_sampling_on_alloc(size); /* Sampling heap profiling */
 
 #ifdef JMEM_GC_BEFORE_EACH_ALLOC
   // GC before each alloc: not enabled in most cases
@@ -517,6 +630,19 @@ static void *jmem_heap_gc_and_alloc_block(
   jmem_run_free_unused_memory_callbacks(JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH);
 #endif /* JMEM_GC_BEFORE_EACH_ALLOC */
 
+#ifdef SEG_SIZE_CLASS_BINS
+  // Fast path: size-class bins (binned blocks are already accounted)
+  if (size <= SEG_SIZE_CLASS_MAX_SIZE) {
+    profile_alloc_start(); /* Time profiling */
+    void *binned_block_p = alloc_a_block_from_bins(size);
+    profile_alloc_end(); /* Time profiling */
+    if (binned_block_p != NULL) {
+      profile_jsobject_inc_allocation(size); /* JS object allocation profiling */
+      return binned_block_p;
+    }
+  }
+#endif /* SEG_SIZE_CLASS_BINS */
+
   // Call GC if free memory is expected to lack
 #if defined(JMEM_STATIC_HEAP) || defined(JMEM_SEGMENTED_HEAP)
   size_t allocated_size = JERRY_CONTEXT(jmem_heap_blocks_size) + size;
@@ -528,10 +654,21 @@ static void *jmem_heap_gc_and_alloc_block(
 #endif /* defined(DE_SLAB) */
 #endif /* !defined(JMEM_STATIC_HEAP) && !defined(JMEM_SEGMENTED_HEAP) */
 
+  // GC-free region: the headroom used is tracked, and no GC is triggered
+  if (unlikely(JERRY_CONTEXT(jmem_is_no_gc_region)) &&
+      allocated_size > JERRY_CONTEXT(jmem_no_gc_region_peak_size)) {
+    JERRY_CONTEXT(jmem_no_gc_region_peak_size) = allocated_size;
+  }
+
 #ifdef JMEM_LAZY_GC
   if (allocated_size > JMEM_HEAP_SIZE) {
 #else
-  if (allocated_size > JERRY_CONTEXT(jmem_heap_limit)) {
+  // The adaptive trigger replaces the fixed steps of the heap limit
+  size_t gc_trigger_size = JERRY_CONTEXT(ecma_gc_stats).trigger_size;
+  if (gc_trigger_size == 0) {
+    gc_trigger_size = JERRY_CONTEXT(jmem_heap_limit);
+  }
+  if (allocated_size > gc_trigger_size) {
 #endif
 #ifdef PRINT_GC_BEHAVIOR
     printf("GC 1: expected over-size\n");
@@ -558,6 +695,10 @@ static void *jmem_heap_gc_and_alloc_block(
     return data_space_p;
   }
 #endif /* JMEM_SEGMENTED_HEAP */
+  // A GC-free region is broken rather than running out of memory
+  if (unlikely(JERRY_CONTEXT(jmem_is_no_gc_region))) {
+    JERRY_CONTEXT(jmem_is_no_gc_region_exhausted) = true;
+  }
   for (jmem_free_unused_memory_severity_t severity =
            JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW;
        severity <= JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH;
@@ -614,7 +755,14 @@ static void *jmem_heap_gc_and_alloc_block(
 inline void *__attr_hot___ __attr_always_inline___
 jmem_heap_alloc_block(const size_t size) /**< required memory size */
 {
+#if defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB)
+  // Small blocks are taken from the slab of their size class
+  if (size > 0 && size <= DE_SLAB_MAX_SLOT_SIZE) {
+    return alloc_a_block_from_slab(size, false);
+  }
+#endif /* defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB) */
   void *ret = jmem_heap_gc_and_alloc_block(size, false, false);
+  profile_trace_on_alloc(ret, size, false); /* Allocation trace */
   return ret;
 } /* jmem_heap_alloc_block */
 
@@ -634,10 +782,97 @@ inline void *__attr_hot___ __attr_always_inline___
 jmem_heap_alloc_block_null_on_error(
     const size_t size) /**< required memory size */
 {
+#if defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB)
+  if (size > 0 && size <= DE_SLAB_MAX_SLOT_SIZE) {
+    return alloc_a_block_from_slab(size, true);
+  }
+#endif /* defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB) */
   void *ret = jmem_heap_gc_and_alloc_block(size, true, false);
+  profile_trace_on_alloc(ret, size, false); /* Allocation trace */
   return ret;
 } /* jmem_heap_alloc_block_null_on_error */
 
+/**
+ * Get the free size of the heap that can be allocated without GC.
+ */
+static size_t jmem_heap_get_headroom(void) {
+#if defined(JMEM_STATIC_HEAP) || defined(JMEM_SEGMENTED_HEAP)
+  // The static heap, or the segments allocated so far
+  size_t capacity = JERRY_CONTEXT(jmem_allocated_heap_size);
+#else  /* defined(JMEM_STATIC_HEAP) || defined(JMEM_SEGMENTED_HEAP) */
+  size_t capacity = JMEM_HEAP_SIZE;
+#endif /* !defined(JMEM_STATIC_HEAP) && !defined(JMEM_SEGMENTED_HEAP) */
+  size_t usage = jmem_heap_get_usage();
+  return (capacity > usage) ? capacity - usage : 0;
+} /* jmem_heap_get_headroom */
+
+/**
+ * Begin a GC-free region, in which garbage collection is suppressed.
+ *
+ * The headroom of the region is made free at the start: by a GC if the heap
+ * lacks it, and on the segmented heap by allocating segments for the rest.
+ * Allocating more than the headroom overruns the region, but does not trigger
+ * a GC, unless the heap is exhausted.
+ *
+ * @return true - if the headroom is reserved and the region is begun,
+ *         false - if a region is already in progress, or the heap cannot
+ *                 provide the headroom
+ */
+bool jmem_heap_begin_no_gc_region(
+    size_t reserved_size) /**< headroom of the region */
+{
+  if (JERRY_CONTEXT(jmem_is_no_gc_region)) {
+    return false;
+  }
+  if (reserved_size > JMEM_HEAP_SIZE) {
+    return false;
+  }
+  size_t size = JERRY_ALIGNUP(reserved_size, JMEM_ALIGNMENT);
+
+  if (jmem_heap_get_headroom() < size) {
+    jmem_run_free_unused_memory_callbacks(JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH);
+  }
+#ifdef JMEM_SEGMENTED_HEAP
+  size_t headroom = jmem_heap_get_headroom();
+  if (headroom < size) {
+    print_segment_utilization_profile_before_segalloc(size - headroom);
+    alloc_a_segment_group(size - headroom);
+  }
+#endif /* JMEM_SEGMENTED_HEAP */
+  if (jmem_heap_get_headroom() < size) {
+    return false;
+  }
+
+  JERRY_CONTEXT(jmem_is_no_gc_region) = true;
+  JERRY_CONTEXT(jmem_is_no_gc_region_exhausted) = false;
+  JERRY_CONTEXT(jmem_no_gc_region_start_size) = jmem_heap_get_usage();
+  JERRY_CONTEXT(jmem_no_gc_region_peak_size) = jmem_heap_get_usage();
+  JERRY_CONTEXT(jmem_no_gc_region_reserved_size) = size;
+  return true;
+} /* jmem_heap_begin_no_gc_region */
+
+/**
+ * End the GC-free region, and report its headroom used to the size profiler.
+ *
+ * @return true - if the region has allocated more than its headroom,
+ *         false - otherwise, or if no region is in progress
+ */
+bool jmem_heap_end_no_gc_region(void) {
+  if (!JERRY_CONTEXT(jmem_is_no_gc_region)) {
+    return false;
+  }
+  size_t used_size = JERRY_CONTEXT(jmem_no_gc_region_peak_size) -
+                     JERRY_CONTEXT(jmem_no_gc_region_start_size);
+  size_t reserved_size = JERRY_CONTEXT(jmem_no_gc_region_reserved_size);
+  bool is_overrun = (JERRY_CONTEXT(jmem_is_no_gc_region_exhausted) ||
+                     used_size > reserved_size);
+
+  JERRY_CONTEXT(jmem_is_no_gc_region) = false;
+  JERRY_CONTEXT(jmem_is_no_gc_region_exhausted) = false;
+  print_no_gc_region_profile(reserved_size, used_size, is_overrun);
+  return is_overrun;
+} /* jmem_heap_end_no_gc_region */
+
 /**
  * Free the memory block.
  */
@@ -662,6 +897,12 @@ static void __attr_hot___ jmem_heap_free_block_internal(
   jmem_heap_free_t *next_p;
   uint32_t next_cp;
 
+#ifdef JMEM_HEAP_FREE_INDEX
+  // The free region before the block is looked up in the index
+  const uint32_t block_offset = JMEM_COMPRESS_POINTER_INTERNAL(block_p);
+  prev_p = jmem_heap_free_index_find_prev(block_offset);
+  JMEM_HEAP_STAT_SKIP();
+#else /* defined(JMEM_HEAP_FREE_INDEX) */
 #ifdef JMEM_SEGMENTED_HEAP
   uint32_t boffset = JMEM_COMPRESS_POINTER_INTERNAL(block_p);
 #ifdef PROF_COUNT__COMPRESSION_CALLERS
@@ -701,6 +942,7 @@ static void __attr_hot___ jmem_heap_free_block_internal(
 
     JMEM_HEAP_STAT_FREE_ITER();
   }
+#endif /* !defined(JMEM_HEAP_FREE_INDEX) */
 
   next_cp = prev_p->next_offset;
   next_p = JMEM_DECOMPRESS_POINTER_INTERNAL(next_cp);
@@ -717,6 +959,9 @@ static void __attr_hot___ jmem_heap_free_block_internal(
   } else {
     block_p->size = (uint32_t)aligned_size;
     prev_p->next_offset = block_offset;
+#ifdef JMEM_HEAP_FREE_INDEX
+    jmem_heap_free_index_insert(block_offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
   }
 
   /* Update next. */
@@ -724,6 +969,9 @@ static void __attr_hot___ jmem_heap_free_block_internal(
     /* Can be merged. */
     block_p->size += next_p->size;
     block_p->next_offset = next_p->next_offset;
+#ifdef JMEM_HEAP_FREE_INDEX
+    jmem_heap_free_index_remove(next_cp);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
   } else {
     block_p->next_offset = next_cp;
   }
@@ -737,7 +985,7 @@ static void __attr_hot___ jmem_heap_free_block_internal(
       block_start_offset + (uint32_t)size_to_free - JMEM_ALIGNMENT;
   uint32_t fragment_start_offset = block_start_offset;
   while (size_to_free > 0) {
-    uint32_t sidx = fragment_start_offset / SEG_SEGMENT_SIZE;
+    uint32_t sidx = fragment_start_offset >> SEG_SEGMENT_SHIFT;
     uint32_t segment_end_offset =
         (sidx + 1) * SEG_SEGMENT_SIZE - JMEM_ALIGNMENT;
     uint32_t fragment_end_offset;
@@ -820,6 +1068,37 @@ static void __attr_hot___ jmem_heap_free_block_internal(
 #endif /* !JERRY_SYSTEM_ALLOCATOR */
 } /* jmem_heap_free_block_internal */
 
+#ifdef SEG_SIZE_CLASS_BINS
+/**
+ * Free the memory block to size-class bins, if it is binnable.
+ *
+ * @return true - if the block is kept in a bin,
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___ jmem_heap_free_block_to_bins(
+    void *ptr,         /**< pointer to beginning of data space of the block */
+    const size_t size) /**< size of allocated region */
+{
+  profile_free_start(); /* Time profiling */
+  bool is_binned = free_a_block_to_bins(ptr, size);
+  profile_free_end(); /* Time profiling */
+  return is_binned;
+} /* jmem_heap_free_block_to_bins */
+
+/**
+ * Return all the blocks kept in size-class bins to the free region list
+ */
+void jmem_heap_flush_size_class_bins(void) {
+  for (size_t size = JMEM_ALIGNMENT; size <= SEG_SIZE_CLASS_MAX_SIZE;
+       size += JMEM_ALIGNMENT) {
+    void *block_p;
+    while ((block_p = alloc_a_block_from_bins(size)) != NULL) {
+      jmem_heap_free_block_internal(block_p, size, false);
+    }
+  }
+} /* jmem_heap_flush_size_class_bins */
+#endif /* SEG_SIZE_CLASS_BINS */
+
 /**
  * Free the memory block.
  */
@@ -827,16 +1106,41 @@ void __attr_hot___ jmem_heap_free_block(
     void *ptr,         /**< pointer to beginning of data space of the block */
     const size_t size) /**< size of allocated region */
 {
+#if defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB)
+  if (size <= DE_SLAB_MAX_SLOT_SIZE) {
+    free_a_block_from_slab(ptr, size);
+    return;
+  }
+#endif /* defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB) */
+  profile_trace_on_free(ptr, false); /* Allocation trace */
+#ifdef SEG_SIZE_CLASS_BINS
+  if (jmem_heap_free_block_to_bins(ptr, size)) {
+    return;
+  }
+#endif /* SEG_SIZE_CLASS_BINS */
   jmem_heap_free_block_internal(ptr, size, false);
 } /* jmem_heap_free_block */
 
 inline void *__attr_hot___ __attr_always_inline___
 jmem_heap_alloc_block_small_object(const size_t size) {
   void *ret = jmem_heap_gc_and_alloc_block(size, false, true);
+  profile_trace_on_alloc(ret, size, true); /* Allocation trace */
+  return ret;
+}
+inline void *__attr_hot___ __attr_always_inline___
+jmem_heap_alloc_block_small_object_null_on_error(const size_t size) {
+  void *ret = jmem_heap_gc_and_alloc_block(size, true, true);
+  profile_trace_on_alloc(ret, size, true); /* Allocation trace */
   return ret;
 }
 inline void __attr_hot___ __attr_always_inline___
 jmem_heap_free_block_small_object(void *ptr, const size_t size) {
+  profile_trace_on_free(ptr, true); /* Allocation trace */
+#ifdef SEG_SIZE_CLASS_BINS
+  if (jmem_heap_free_block_to_bins(ptr, size)) {
+    return;
+  }
+#endif /* SEG_SIZE_CLASS_BINS */
   jmem_heap_free_block_internal(ptr, size, true);
 }
 
@@ -70,14 +70,18 @@ void jmem_pools_finalize(void) {
 #if defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC)
   JERRY_ASSERT(JERRY_CONTEXT(jmem_free_16_byte_chunk_p) == NULL);
 #endif /* defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC) */
+#ifdef JMEM_POOLS_SIZE_CLASSES
+  for (uint32_t i = 0; i < JMEM_POOLS_NUM_SIZE_CLASSES; i++) {
+    JERRY_ASSERT(JERRY_CONTEXT(jmem_free_sized_chunk_p[i]) == NULL);
+  }
+#endif /* JMEM_POOLS_SIZE_CLASSES */
 } /* jmem_pools_finalize */
 
 static inline void *__attr_hot___ __attr_always_inline___
 jmem_heap_alloc_block_for_pool(size_t size) {
   #if defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB)
     // Dynamic heap with slab
-    JERRY_UNUSED(size);
-    return alloc_a_block_from_slab(size);
+    return alloc_a_block_from_slab(size, false);
   #else /* defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB) */
     // Others 
     return jmem_heap_alloc_block_small_object(size);
@@ -95,6 +99,34 @@ jmem_heap_free_block_for_pool(void* ptr, size_t size) {
   #endif /* !(defined(JMEM_DYNAMIC_HEAP_EMUL) && defined(DE_SLAB)) */
 }
 
+#ifdef JMEM_POOLS_SIZE_CLASSES
+/**
+ * Get index of the size class for chunks larger than the fixed pools
+ *
+ * @return index in jmem_free_sized_chunk_p
+ */
+static inline uint32_t __attr_always_inline___
+jmem_pools_get_size_class(size_t size) /**< size of the chunk */
+{
+  JERRY_ASSERT(size > JMEM_POOLS_FIXED_MAX_CHUNK_SIZE &&
+               size <= JMEM_POOLS_MAX_CHUNK_SIZE);
+
+  return (uint32_t)((size - JMEM_POOLS_FIXED_MAX_CHUNK_SIZE - 1) /
+                    JMEM_ALIGNMENT);
+} /* jmem_pools_get_size_class */
+
+/**
+ * Get chunk size of a size class
+ *
+ * @return size of the chunks in the size class
+ */
+static inline size_t __attr_always_inline___
+jmem_pools_get_size_class_chunk_size(uint32_t size_class) /**< size class */
+{
+  return JMEM_POOLS_FIXED_MAX_CHUNK_SIZE + (size_class + 1) * JMEM_ALIGNMENT;
+} /* jmem_pools_get_size_class_chunk_size */
+#endif /* JMEM_POOLS_SIZE_CLASSES */
+
 /**
  * Allocate a chunk of specified size
  *
@@ -125,6 +157,29 @@ jmem_pools_alloc(size_t size) /**< size of the chunk */
     }
   }
 
+#ifdef JMEM_POOLS_SIZE_CLASSES
+  if (size > JMEM_POOLS_FIXED_MAX_CHUNK_SIZE) {
+    uint32_t size_class = jmem_pools_get_size_class(size);
+
+    if (JERRY_CONTEXT(jmem_free_sized_chunk_p[size_class]) != NULL) {
+      const jmem_pools_chunk_t *const chunk_p =
+          JERRY_CONTEXT(jmem_free_sized_chunk_p[size_class]);
+
+      VALGRIND_DEFINED_SPACE(chunk_p, sizeof(jmem_pools_chunk_t));
+
+      JERRY_CONTEXT(jmem_free_sized_chunk_p[size_class]) = chunk_p->next_p;
+
+      VALGRIND_UNDEFINED_SPACE(chunk_p, sizeof(jmem_pools_chunk_t));
+
+      return (void *)chunk_p;
+    } else {
+      // Larger chunks are taken from the general heap as before pooling
+      return jmem_heap_alloc_block(
+          jmem_pools_get_size_class_chunk_size(size_class));
+    }
+  }
+#endif /* JMEM_POOLS_SIZE_CLASSES */
+
 #if defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC)
   JERRY_ASSERT(size <= 16);
 
@@ -164,6 +219,13 @@ jmem_pools_free(void *chunk_p, /**< pointer to the chunk */
   if (size <= 8) {
     chunk_to_free_p->next_p = JERRY_CONTEXT(jmem_free_8_byte_chunk_p);
     JERRY_CONTEXT(jmem_free_8_byte_chunk_p) = chunk_to_free_p;
+#ifdef JMEM_POOLS_SIZE_CLASSES
+  } else if (size > JMEM_POOLS_FIXED_MAX_CHUNK_SIZE) {
+    uint32_t size_class = jmem_pools_get_size_class(size);
+
+    chunk_to_free_p->next_p = JERRY_CONTEXT(jmem_free_sized_chunk_p[size_class]);
+    JERRY_CONTEXT(jmem_free_sized_chunk_p[size_class]) = chunk_to_free_p;
+#endif /* JMEM_POOLS_SIZE_CLASSES */
   } else {
 #if defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC)
     JERRY_ASSERT(size <= 16);
@@ -207,8 +269,76 @@ void jmem_pools_collect_empty(void) {
     chunk_p = next_p;
   }
 #endif /* defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC) */
+
+#ifdef JMEM_POOLS_SIZE_CLASSES
+  for (uint32_t size_class = 0; size_class < JMEM_POOLS_NUM_SIZE_CLASSES;
+       size_class++) {
+    size_t chunk_size = jmem_pools_get_size_class_chunk_size(size_class);
+    chunk_p = JERRY_CONTEXT(jmem_free_sized_chunk_p[size_class]);
+    JERRY_CONTEXT(jmem_free_sized_chunk_p[size_class]) = NULL;
+
+    while (chunk_p) {
+      VALGRIND_DEFINED_SPACE(chunk_p, sizeof(jmem_pools_chunk_t));
+      jmem_pools_chunk_t *const next_p = chunk_p->next_p;
+      VALGRIND_NOACCESS_SPACE(chunk_p, sizeof(jmem_pools_chunk_t));
+
+      jmem_heap_free_block(chunk_p, chunk_size);
+      chunk_p = next_p;
+    }
+  }
+#endif /* JMEM_POOLS_SIZE_CLASSES */
 } /* jmem_pools_collect_empty */
 
+/**
+ * Count the chunks of a free chunk list
+ *
+ * @return number of chunks in the list
+ */
+static size_t
+jmem_pools_count_chunks(jmem_pools_chunk_t *chunk_p) /**< first chunk of the list */
+{
+  size_t count = 0;
+
+  while (chunk_p) {
+    VALGRIND_DEFINED_SPACE(chunk_p, sizeof(jmem_pools_chunk_t));
+    jmem_pools_chunk_t *const next_p = chunk_p->next_p;
+    VALGRIND_NOACCESS_SPACE(chunk_p, sizeof(jmem_pools_chunk_t));
+
+    count++;
+    chunk_p = next_p;
+  }
+
+  return count;
+} /* jmem_pools_count_chunks */
+
+/**
+ * Get the size of the free chunks kept by the pools
+ *
+ * @return bytes of the free chunks, which are in use for the heap
+ */
+size_t
+jmem_pools_get_free_size(void)
+{
+  size_t free_size =
+      jmem_pools_count_chunks(JERRY_CONTEXT(jmem_free_8_byte_chunk_p)) * 8;
+
+#if defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC)
+  free_size +=
+      jmem_pools_count_chunks(JERRY_CONTEXT(jmem_free_16_byte_chunk_p)) * 16;
+#endif /* defined(JERRY_CPOINTER_32_BIT) || defined(SEG_FULLBIT_ADDRESS_ALLOC) */
+
+#ifdef JMEM_POOLS_SIZE_CLASSES
+  for (uint32_t size_class = 0; size_class < JMEM_POOLS_NUM_SIZE_CLASSES;
+       size_class++) {
+    free_size += jmem_pools_count_chunks(
+                     JERRY_CONTEXT(jmem_free_sized_chunk_p[size_class])) *
+                 jmem_pools_get_size_class_chunk_size(size_class);
+  }
+#endif /* JMEM_POOLS_SIZE_CLASSES */
+
+  return free_size;
+} /* jmem_pools_get_free_size */
+
 inline void __attr_always_inline___ add_full_bitwidth_size(size_t full_bw_size) {
   // Apply the number of cpointers to the actually allocated heap size
 #if defined(JMEM_DYNAMIC_HEAP_EMUL) || defined(SEG_FULLBIT_ADDRESS_ALLOC)
@@ -34,20 +34,60 @@
 #define JMEM_HEAP_SIZE ((size_t) (CONFIG_MEM_HEAP_AREA_SIZE))
 #endif /* !JERRY_ENABLE_EXTERNAL_CONTEXT */
 
+/**
+ * Logarithm of required alignment for allocated units/blocks
+ */
+#define JMEM_ALIGNMENT_LOG   3
+
+/**
+ * Representation of NULL value for compressed pointers
+ */
+#define JMEM_CP_NULL ((jmem_cpointer_t) 0)
+
+/**
+ * Required alignment for allocated units/blocks
+ */
+#define JMEM_ALIGNMENT (1u << JMEM_ALIGNMENT_LOG)
+
 /* Segmented heap allocator */
-#define SEG_NUM_SEGMENTS (JMEM_HEAP_SIZE / SEG_SEGMENT_SIZE)
+#define SEG_NUM_SEGMENTS (JMEM_HEAP_SIZE >> SEG_SEGMENT_SHIFT)
+#define SEG_MAX_NUM_SEGMENTS (JMEM_HEAP_SIZE >> SEG_MIN_SEGMENT_SHIFT)
 #define SEG_METADATA_SIZE_PER_SEGMENT (32)
 
 /* Dynamic heap with slab */
-#define DE_SLAB_SLOT_SIZE (16)
-#define DE_NUM_SLOTS_PER_SLAB (512)
-#define DE_SLAB_SEGMENT_SIZE (DE_SLAB_SLOT_SIZE * DE_NUM_SLOTS_PER_SLAB)
+#define DE_SLAB_SEGMENT_SIZE (8192)
 #define DE_MAX_NUM_SLABS (JMEM_HEAP_SIZE / DE_SLAB_SEGMENT_SIZE)
+// Slot sizes of the slabs: 8, 16, 24, 32, 48 and 64 bytes
+#define DE_SLAB_NUM_SIZE_CLASSES (6)
+#define DE_SLAB_MAX_SLOT_SIZE (64)
 
 /* Calculating system allocator's effect */
 #define SYSTEM_ALLOCATOR_METADATA_SIZE 8
 #define SYSTEM_ALLOCATOR_ALIGN_BYTES 8
 
+/* Free region index */
+#ifdef JMEM_HEAP_FREE_INDEX
+#define JMEM_HEAP_FREE_INDEX_WORDS ((JMEM_HEAP_SIZE / JMEM_ALIGNMENT + 31) / 32)
+#define JMEM_HEAP_FREE_INDEX_SUMMARY_WORDS \
+  ((JMEM_HEAP_FREE_INDEX_WORDS + 31) / 32)
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
+
+/* Size-class bins of segmented heap */
+#ifdef SEG_SIZE_CLASS_BINS
+#define SEG_NUM_SIZE_CLASSES (SEG_SIZE_CLASS_MAX_SIZE / JMEM_ALIGNMENT)
+#define SEG_BIN_BITMAP_WORDS ((SEG_MAX_NUM_SEGMENTS + 31) / 32)
+#define SEG_BIN_EMPTY ((uint16_t) UINT16_MAX)
+#endif /* defined(SEG_SIZE_CLASS_BINS) */
+
+/* Radix table of segmented heap */
+#ifdef SEG_RMAP_RADIX_TABLE
+#define SEG_RMAP_RADIX_L2_BITS \
+  (32 - SEG_SEGMENT_SHIFT - SEG_RMAP_RADIX_L1_BITS)
+#define SEG_RMAP_RADIX_L1_SIZE (1u << SEG_RMAP_RADIX_L1_BITS)
+#define SEG_RMAP_RADIX_L2_SIZE (1u << SEG_RMAP_RADIX_L2_BITS)
+#define SEG_RMAP_RADIX_EMPTY ((uint16_t) UINT16_MAX)
+#endif /* defined(SEG_RMAP_RADIX_TABLE) */
+
 #ifdef JMEM_SEGMENTED_HEAP
 /**
  * Segment information
@@ -59,24 +99,27 @@ typedef struct {
   // Occupied size of segment
   size_t occupied_size;
 
-} jmem_segment_t;
-#endif /* defined(JMEM_SEGMENTED_HEAP) */
-/*******************************************************/
+#ifdef SEG_SIZE_CLASS_BINS
+  // Size of free blocks kept in the bins of this segment
+  uint32_t binned_size;
 
-/**
- * Logarithm of required alignment for allocated units/blocks
- */
-#define JMEM_ALIGNMENT_LOG   3
+  // Heads of per-size-class bins (segment-local offsets)
+  uint16_t bin_heads[SEG_NUM_SIZE_CLASSES];
+#endif /* defined(SEG_SIZE_CLASS_BINS) */
 
-/**
- * Representation of NULL value for compressed pointers
- */
-#define JMEM_CP_NULL ((jmem_cpointer_t) 0)
+#ifdef SEG_SEGMENT_EVACUATION
+  // Allocator avoids free regions of the segment to let it be empty
+  bool is_evacuating;
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
 
-/**
- * Required alignment for allocated units/blocks
- */
-#define JMEM_ALIGNMENT (1u << JMEM_ALIGNMENT_LOG)
+#ifdef SEG_SEGMENT_RETENTION
+  // Retention epoch the group became empty at, 0 while it is occupied (valid
+  // only in leading segment of the group)
+  uint32_t empty_epoch;
+#endif /* defined(SEG_SEGMENT_RETENTION) */
+} jmem_segment_t;
+#endif /* defined(JMEM_SEGMENTED_HEAP) */
+/*******************************************************/
 
 /**
  * Compressed pointer representations
@@ -130,6 +173,27 @@ typedef struct jmem_pools_chunk_t
   struct jmem_pools_chunk_t *next_p; /**< pointer to next pool chunk */
 } jmem_pools_chunk_t;
 
+/**
+ * Size of the largest chunks pooled by the fixed 8/16 byte pools
+ */
+#if defined (JERRY_CPOINTER_32_BIT) || defined (SEG_FULLBIT_ADDRESS_ALLOC)
+#define JMEM_POOLS_FIXED_MAX_CHUNK_SIZE 16
+#else /* !JERRY_CPOINTER_32_BIT && !SEG_FULLBIT_ADDRESS_ALLOC */
+#define JMEM_POOLS_FIXED_MAX_CHUNK_SIZE 8
+#endif /* JERRY_CPOINTER_32_BIT || SEG_FULLBIT_ADDRESS_ALLOC */
+
+#ifdef JMEM_POOLS_SIZE_CLASSES
+/**
+ * Number of additional size classes above the fixed pools (one per JMEM_ALIGNMENT)
+ */
+#define JMEM_POOLS_NUM_SIZE_CLASSES \
+  ((JMEM_POOLS_MAX_CHUNK_SIZE - JMEM_POOLS_FIXED_MAX_CHUNK_SIZE) / JMEM_ALIGNMENT)
+
+#if (JMEM_POOLS_MAX_CHUNK_SIZE % JMEM_ALIGNMENT != 0) || (JMEM_POOLS_MAX_CHUNK_SIZE <= JMEM_POOLS_FIXED_MAX_CHUNK_SIZE)
+#error "JMEM_POOLS_MAX_CHUNK_SIZE must be aligned and larger than the fixed pools"
+#endif
+#endif /* JMEM_POOLS_SIZE_CLASSES */
+
 /**
  *  Free region node
  */
@@ -147,8 +211,14 @@ void *jmem_heap_alloc_block_null_on_error (const size_t size);
 void jmem_heap_free_block (void *ptr, const size_t size);
 
 void *jmem_heap_alloc_block_small_object (const size_t size);
+void *jmem_heap_alloc_block_small_object_null_on_error (const size_t size);
 void jmem_heap_free_block_small_object (void *ptr, const size_t size);
 
+bool jmem_heap_begin_no_gc_region (size_t reserved_size);
+bool jmem_heap_end_no_gc_region (void);
+
+void jmem_heap_get_usage_stats (size_t *usage_p, size_t *peak_usage_p);
+
 /* Modification for unifying segmented heap allocator */
 /**
  * End of list marker.
@@ -243,6 +313,7 @@ void jmem_register_free_unused_memory_callback (jmem_free_unused_memory_callback
 void jmem_unregister_free_unused_memory_callback (jmem_free_unused_memory_callback_t callback);
 
 void jmem_run_free_unused_memory_callbacks (jmem_free_unused_memory_severity_t severity);
+bool jmem_is_gc_suppressed (void);
 
 /**
  * Define a local array variable and allocate memory for the array on the heap.
@@ -343,6 +414,7 @@ void jmem_run_free_unused_memory_callbacks (jmem_free_unused_memory_severity_t s
 
 void *jmem_pools_alloc (size_t size);
 void jmem_pools_free (void *chunk_p, size_t size);
+size_t jmem_pools_get_free_size (void);
 
 void add_full_bitwidth_size(size_t full_bw_size);
 void sub_full_bitwidth_size(size_t full_bw_size);
@@ -0,0 +1,200 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hashtable.h"
+#include "jmem-profiler-common-internal.h"
+#include "jmem-profiler.h"
+
+#if defined(JMEM_PROFILE) && defined(PROF_CODE_SITES)
+/* Code sites of the sampling and opcode profilers
+ * A code site is the resource (file) name and the start line of a function,
+ * since byte code has no line info outside the debugger. Byte code is
+ * registered when it is parsed, and mapped to its code site until it is freed.
+ */
+typedef struct {
+  uint32_t resource_idx;
+  uint32_t line;
+} code_site_t;
+
+// Sites and resources are kept until exit, as profiles refer to them even
+// after their byte code is freed.
+static code_site_t *sites = NULL;
+static uint32_t num_sites = 0;
+static uint32_t sites_capacity = 0;
+static char **resources = NULL;
+static uint32_t num_resources = 0;
+static uint32_t current_resource_idx = CODE_RESOURCE_NONE;
+
+static HashTable sites_ht; // key=<code_site_t> value=<uint32_t site idx>
+static HashTable code_ht;  // key=<void* byte code> value=<uint32_t site idx>
+
+static void __init_code_tables(void) {
+  if (ht_is_initialized(&sites_ht)) {
+    return;
+  }
+  ht_setup(&sites_ht, sizeof(code_site_t), sizeof(uint32_t), 64);
+  ht_setup(&code_ht, sizeof(void *), sizeof(uint32_t), 64);
+}
+
+static uint32_t __get_site_idx(uint32_t resource_idx, uint32_t line) {
+  code_site_t site;
+  memset(&site, 0, sizeof(site));
+  site.resource_idx = resource_idx;
+  site.line = line;
+  if (ht_contains(&sites_ht, &site)) {
+    return HT_LOOKUP_AS(uint32_t, &sites_ht, &site);
+  }
+
+  if (num_sites == sites_capacity) {
+    uint32_t new_capacity = (sites_capacity == 0) ? 64 : sites_capacity * 2;
+    code_site_t *new_sites =
+        (code_site_t *)realloc(sites, sizeof(code_site_t) * new_capacity);
+    if (new_sites == NULL) {
+      return CODE_SITE_UNKNOWN;
+    }
+    sites = new_sites;
+    sites_capacity = new_capacity;
+  }
+  uint32_t site_idx = num_sites++;
+  sites[site_idx] = site;
+  ht_insert(&sites_ht, &site, &site_idx);
+  return site_idx;
+}
+
+uint32_t get_code_site_idx(const void *bytecode_p) {
+  if (!ht_is_initialized(&code_ht) || !ht_contains(&code_ht, &bytecode_p)) {
+    return CODE_SITE_UNKNOWN;
+  }
+  return HT_LOOKUP_AS(uint32_t, &code_ht, &bytecode_p);
+}
+
+size_t append_profile_str(char *buf, size_t pos, size_t size,
+                          const char *str) {
+  while (*str != '\0' && pos + 1 < size) {
+    buf[pos++] = *str++;
+  }
+  buf[pos] = '\0';
+  return pos;
+}
+
+static size_t __append_uint(char *buf, size_t pos, size_t size,
+                            uint32_t value) {
+  char digits[11];
+  int num_digits = 0;
+  do {
+    digits[num_digits++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  while (num_digits > 0 && pos + 1 < size) {
+    buf[pos++] = digits[--num_digits];
+  }
+  buf[pos] = '\0';
+  return pos;
+}
+
+size_t append_code_site(char *buf, size_t pos, size_t size,
+                        uint32_t site_idx) {
+  if (site_idx == CODE_SITE_UNKNOWN) {
+    return append_profile_str(buf, pos, size, "(unknown)");
+  }
+  code_site_t *site = &sites[site_idx];
+  pos = append_profile_str(buf, pos, size,
+                           (site->resource_idx != CODE_RESOURCE_NONE)
+                               ? resources[site->resource_idx]
+                               : "(anonymous)");
+  pos = append_profile_str(buf, pos, size, ":");
+  return __append_uint(buf, pos, size, site->line);
+}
+
+const char *format_code_site(uint32_t site_idx) {
+  static char site_str[256];
+  append_code_site(site_str, 0, sizeof(site_str), site_idx);
+  return site_str;
+}
+#endif /* defined(JMEM_PROFILE) && defined(PROF_CODE_SITES) */
+
+inline void __attr_always_inline___ init_code_sites(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_CODE_SITES)
+  CHECK_LOGGING_ENABLED();
+  __init_code_tables();
+  ht_clear(&code_ht);
+#endif
+}
+
+void profile_code_set_resource(const uint8_t *name_p, size_t name_length) {
+#if defined(JMEM_PROFILE) && defined(PROF_CODE_SITES)
+  CHECK_LOGGING_ENABLED();
+  current_resource_idx = CODE_RESOURCE_NONE;
+  if (name_p == NULL) {
+    return;
+  }
+
+  for (uint32_t idx = 0; idx < num_resources; idx++) {
+    if (strlen(resources[idx]) == name_length &&
+        !memcmp(resources[idx], name_p, name_length)) {
+      current_resource_idx = idx;
+      return;
+    }
+  }
+
+  char **new_resources =
+      (char **)realloc(resources, sizeof(char *) * (num_resources + 1));
+  char *name = (char *)malloc(name_length + 1);
+  if (new_resources == NULL || name == NULL) {
+    if (new_resources != NULL) {
+      resources = new_resources;
+    }
+    free(name);
+    return;
+  }
+  memcpy(name, name_p, name_length);
+  name[name_length] = '\0';
+  resources = new_resources;
+  resources[num_resources] = name;
+  current_resource_idx = num_resources++;
+#else
+  JERRY_UNUSED(name_p);
+  JERRY_UNUSED(name_length);
+#endif
+}
+
+// Registered regardless of the runtime selection, so that code parsed before
+// a profiler is turned on can still be attributed.
+void profile_code_register(const void *bytecode_p, uint32_t line) {
+#if defined(JMEM_PROFILE) && defined(PROF_CODE_SITES)
+  CHECK_LOGGING_ENABLED();
+  __init_code_tables();
+  uint32_t site_idx = __get_site_idx(current_resource_idx, line);
+  ht_insert(&code_ht, &bytecode_p, &site_idx);
+#else
+  JERRY_UNUSED(bytecode_p);
+  JERRY_UNUSED(line);
+#endif
+}
+
+void profile_code_unregister(const void *bytecode_p) {
+#if defined(JMEM_PROFILE) && defined(PROF_CODE_SITES)
+  CHECK_LOGGING_ENABLED();
+  if (ht_is_initialized(&code_ht)) {
+    ht_erase(&code_ht, &bytecode_p);
+  }
+  profile_opcode_on_code_free(bytecode_p);
+#else
+  JERRY_UNUSED(bytecode_p);
+#endif
+}
@@ -26,6 +26,16 @@
   if (!(JERRY_CONTEXT(jerry_init_flags) & ECMA_INIT_JMEM_LOGS_ENABLED)) \
   return
 
+// A profiler works only if its category is selected at runtime. It costs a
+// context load and a test on each profiling hook when it is not selected.
+#if defined(JMEM_PROFILE)
+#define CHECK_PROFILE_ENABLED(category)                              \
+  CHECK_LOGGING_ENABLED();                                           \
+  if (!(JERRY_CONTEXT(jmem_profile_categories) & (category))) return
+#else
+#define CHECK_PROFILE_ENABLED(category) CHECK_LOGGING_ENABLED()
+#endif
+
 /* jmem-profiler-common.c */
 extern void get_js_uptime(struct timeval *js_uptime);
 extern long get_timeval_diff_usec(struct timeval *prior, struct timeval *post);
@@ -48,12 +58,59 @@ extern void init_cptl_profiler(void);
 /* jmem-profiler-count.c */
 extern void init_count_profile(void);
 
+/* jmem-profiler-code.c: code sites shared by the sampling and opcode profilers
+ */
+#if defined(PROF_SAMPLING) || defined(PROF_OPCODE) || defined(PROF_CPU)
+#define PROF_CODE_SITES
+#endif
+#define CODE_SITE_UNKNOWN UINT32_MAX  // code not parsed from source
+#define CODE_RESOURCE_NONE UINT32_MAX // code parsed without a name
+extern void init_code_sites(void);
+extern uint32_t get_code_site_idx(const void *bytecode_p);
+// Append to a buffer, truncating at the end of the buffer
+extern size_t append_profile_str(char *buf, size_t pos, size_t size,
+                                 const char *str);
+extern size_t append_code_site(char *buf, size_t pos, size_t size,
+                               uint32_t site_idx);
+// "<resource>:<line>" in a static buffer
+extern const char *format_code_site(uint32_t site_idx);
+
+/* jmem-profiler-sampling.c */
+extern void init_sampling_profiler(void);
+
+/* jmem-profiler-opcode.c */
+extern void init_opcode_profiler(void);
+extern void profile_opcode_on_code_free(const void *bytecode_p);
+
+/* jmem-profiler-cpu.c */
+extern void init_cpu_profiler(void);
+
+/* jmem-profiler-trace.c */
+extern void init_trace_profiler(void);
+extern void finalize_trace_profiler(void);
+
+/* jmem-profiler-record.c */
+extern bool is_profile_record_enabled(void);
+extern void profile_record_begin(const char *profiler_id);
+extern void profile_record_int(const char *key, long long value);
+extern void profile_record_uint(const char *key, unsigned long long value);
+extern void profile_record_indexed_int(const char *key_prefix, uint32_t index,
+                                       long long value);
+extern void profile_record_indexed_uint(const char *key_prefix, uint32_t index,
+                                        unsigned long long value);
+extern void profile_record_float(const char *key, double value);
+extern void profile_record_indexed_float(const char *key_prefix,
+                                         uint32_t index, double value);
+extern void profile_record_str(const char *key, const char *value);
+extern void profile_record_end(void);
+
 /* Profiler output configs */
 /* If config is defined, output is stored to the specified file.
  * Otherwise, output is printed to stdout.
  */
 #ifdef PROF_MODE_ARTIK053
 #define PROF_TOTAL_SIZE_FILENAME "/mnt/total_size.log"
+#define PROF_NO_GC_REGION_FILENAME "/mnt/no_gc_region.log"
 #define PROF_SEGMENT_UTILIZATION_FILENAME "/mnt/segment_utilization.log"
 #define PROF_TIME_FILENAME "/mnt/time.log"
 #define PROF_PMU_FILENAME "/mnt/pmu.log"
@@ -61,8 +118,13 @@ extern void init_count_profile(void);
 #define PROF_CPTL_FILENAME "/mnt/cptl.log"
 #define PROF_CPTL_ACCESS_FILENAME "/mnt/cptl_access.log"
 #define PROF_COUNT_FILENAME "/mnt/count.log"
+#define PROF_SAMPLING_FILENAME "/mnt/sampling.folded"
+#define PROF_OPCODE_FILENAME "/mnt/opcode.log"
+#define PROF_CPU_FILENAME "/mnt/cpu.folded"
+#define PROF_TRACE_FILENAME "/mnt/alloc_trace.bin"
 #else
 #define PROF_TOTAL_SIZE_FILENAME "total_size.log"
+#define PROF_NO_GC_REGION_FILENAME "no_gc_region.log"
 #define PROF_SEGMENT_UTILIZATION_FILENAME "segment_utilization.log"
 #define PROF_TIME_FILENAME "time.log"
 #define PROF_PMU_FILENAME "pmu.log"
@@ -70,6 +132,10 @@ extern void init_count_profile(void);
 #define PROF_CPTL_FILENAME "cptl.log"
 #define PROF_CPTL_ACCESS_FILENAME "cptl_access.log"
 #define PROF_COUNT_FILENAME "count.log"
+#define PROF_SAMPLING_FILENAME "sampling.folded"
+#define PROF_OPCODE_FILENAME "opcode.log"
+#define PROF_CPU_FILENAME "cpu.folded"
+#define PROF_TRACE_FILENAME "alloc_trace.bin"
 #endif
 
 #endif /* !defined(JMEM_PROFILER_COMMON_H) */
\ No newline at end of file
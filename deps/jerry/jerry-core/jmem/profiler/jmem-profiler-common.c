@@ -19,8 +19,18 @@
 #include "jmem-profiler-common-internal.h"
 #include "jmem-profiler.h"
 
+#ifndef PROF_DEFAULT_CATEGORIES
+#define PROF_DEFAULT_CATEGORIES PROF_CATEGORY_ALL
+#endif
+
+// Categories selected at runtime
+// * It can be set before jerry_init, and it is kept across contexts.
+static uint32_t selected_profile_categories = PROF_DEFAULT_CATEGORIES;
+
 inline void __attr_always_inline___ init_profilers(void) {
 #if defined(JMEM_PROFILE)
+  JERRY_CONTEXT(jmem_profile_categories) =
+      selected_profile_categories & get_built_in_profile_categories();
   CHECK_LOGGING_ENABLED();
   gettimeofday(&JERRY_CONTEXT(timeval_js_start), NULL);
   init_size_profiler();
@@ -28,6 +38,11 @@ inline void __attr_always_inline___ init_profilers(void) {
   init_time_profiler();
   init_cptl_profiler();
   init_pmu_profiler();
+  init_code_sites();
+  init_sampling_profiler();
+  init_opcode_profiler();
+  init_cpu_profiler();
+  init_trace_profiler();
 #endif
 }
 
@@ -41,6 +56,62 @@ inline void __attr_always_inline___ finalize_profilers(void) {
   print_cptl_profile_rmc_hit_ratio();  /* CPTL profiling */
   print_count_profile();               /* Count profiling */
   print_pmu_profile();                 /* PMU profiling */
+  print_sampling_profile();            /* Sampling heap profiling */
+  print_opcode_profile();              /* Opcode profiling */
+  print_cpu_profile();                 /* Sampling CPU profiling */
+  finalize_trace_profiler();           /* Allocation trace */
+#endif
+}
+
+uint32_t get_built_in_profile_categories(void) {
+  uint32_t categories = 0;
+#if defined(JMEM_PROFILE)
+#if defined(PROF_SIZE)
+  categories |= PROF_CATEGORY_SIZE;
+#endif
+#if defined(PROF_TIME)
+  categories |= PROF_CATEGORY_TIME;
+#endif
+#if defined(PROF_PMU)
+  categories |= PROF_CATEGORY_PMU;
+#endif
+#if defined(PROF_CPTL)
+  categories |= PROF_CATEGORY_CPTL;
+#endif
+#if defined(PROF_SEGMENT)
+  categories |= PROF_CATEGORY_SEGMENT;
+#endif
+#if defined(PROF_JSOBJECT)
+  categories |= PROF_CATEGORY_JSOBJECT;
+#endif
+#if defined(PROF_COUNT)
+  categories |= PROF_CATEGORY_COUNT;
+#endif
+#if defined(PROF_SAMPLING)
+  categories |= PROF_CATEGORY_SAMPLING;
+#endif
+#if defined(PROF_OPCODE)
+  categories |= PROF_CATEGORY_OPCODE;
+#endif
+#if defined(PROF_CPU)
+  categories |= PROF_CATEGORY_CPU;
+#endif
+#if defined(PROF_TRACE)
+  categories |= PROF_CATEGORY_TRACE;
+#endif
+#endif /* defined(JMEM_PROFILE) */
+  return categories;
+}
+
+uint32_t get_profile_categories(void) {
+  return selected_profile_categories & get_built_in_profile_categories();
+}
+
+void set_profile_categories(uint32_t categories) {
+  selected_profile_categories = categories & PROF_CATEGORY_ALL;
+#if defined(JMEM_PROFILE)
+  // Harmless before jerry_init: the context is reinitialized there
+  JERRY_CONTEXT(jmem_profile_categories) = get_profile_categories();
 #endif
 }
 
@@ -31,7 +31,17 @@ inline void __attr_always_inline___ init_count_profile(void) {
 
 inline void __attr_always_inline___ print_count_profile(void) {
 #if defined(PROF_COUNT)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_COUNT);
+  if (is_profile_record_enabled()) {
+    profile_record_begin("count");
+    for (int type = 0; type < PROF_COUNT__MAX_TYPES; type++) {
+      profile_record_indexed_int("type_", (uint32_t)type,
+                                 JERRY_CONTEXT(prof_count[type]));
+    }
+    profile_record_end();
+    return;
+  }
+
   FILE *fp = fopen(PROF_COUNT_FILENAME, "a");
   for (int type = 0; type < PROF_COUNT__MAX_TYPES; type++) {
     if (type > 0) {
@@ -47,7 +57,7 @@ inline void __attr_always_inline___ print_count_profile(void) {
 }
 inline void __attr_always_inline___ profile_inc_count_compression_callers(int type) {
 #if defined(PROF_COUNT)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_COUNT);
   JERRY_CONTEXT(prof_count[type])++;
 #else  /* defined(PROF_COUNT) */
   JERRY_UNUSED(type);
@@ -56,7 +66,7 @@ inline void __attr_always_inline___ profile_inc_count_compression_callers(int ty
 
 inline void __attr_always_inline___ profile_add_count_size_detailed(int type, size_t size) {
 #if defined(PROF_COUNT)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_COUNT);
   JERRY_CONTEXT(prof_count[type]) += (int)size;
 #else  /* defined(PROF_COUNT) */
   JERRY_UNUSED(type);
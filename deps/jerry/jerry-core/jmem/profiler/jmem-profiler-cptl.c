@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <stdio.h>
+
 #include "jmem-profiler-common-internal.h"
 #include "jmem-profiler.h"
 #include "jrt.h"
@@ -28,11 +30,14 @@ void init_cptl_profiler(void) {
 #endif
 
 #if defined(PROF_CPTL_ACCESS)
-  FILE* fp = fopen(PROF_CPTL_ACCESS_FILENAME, "w");
-  // Same segment: old(legacy) name of lru cache success count
-  fprintf(fp, "CPTL Access Number, Segment Index, Type/Depth, Same Segment\n");
-  fflush(fp);
-  fclose(fp);
+  if (!is_profile_record_enabled()) {
+    FILE* fp = fopen(PROF_CPTL_ACCESS_FILENAME, "w");
+    // Same segment: old(legacy) name of lru cache success count
+    fprintf(fp,
+            "CPTL Access Number, Segment Index, Type/Depth, Same Segment\n");
+    fflush(fp);
+    fclose(fp);
+  }
 
   JERRY_CONTEXT(cptl_access_count) = 0;
 #endif
@@ -55,13 +60,23 @@ void init_cptl_profiler(void) {
 
 inline void __attr_always_inline___ print_cptl_profile_rmc_hit_ratio(void) {
 #if defined(SEG_RMAP_CACHE) && defined(PROF_CPTL_RMC_HIT_RATIO)
-  CHECK_LOGGING_ENABLED();
-  FILE* fp = fopen(PROF_CPTL_FILENAME, "a");
-
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_CPTL);
   float rmc_access_count_fp = (float)JERRY_CONTEXT(cptl_rmc_access_count);
   float rmc_miss_count_fp = (float)JERRY_CONTEXT(cptl_rmc_miss_count);
   float rmc_hit_ratio = 1.0f - (rmc_miss_count_fp / rmc_access_count_fp);
 
+  if (is_profile_record_enabled()) {
+    profile_record_begin("cptl");
+    profile_record_float("rmc_hit_ratio", (double)rmc_hit_ratio);
+    profile_record_uint("rmc_miss_count", JERRY_CONTEXT(cptl_rmc_miss_count));
+    profile_record_uint("rmc_access_count",
+                        JERRY_CONTEXT(cptl_rmc_access_count));
+    profile_record_end();
+    return;
+  }
+
+  FILE* fp = fopen(PROF_CPTL_FILENAME, "a");
+
   fprintf(fp, "RMC Hit Ratio, RMC Miss Count, RMC Access\n");
   fprintf(fp, "%2.3f, %u, %u\n", rmc_hit_ratio,
           JERRY_CONTEXT(cptl_rmc_miss_count),
@@ -91,8 +106,7 @@ inline void __attr_always_inline___ print_cptl_access(uint32_t sidx,
   // * 0 = compression hit
   // * 1~ = compression miss penalty
 #if defined(PROF_CPTL_ACCESS)
-  CHECK_LOGGING_ENABLED();
-  FILE* fp = fopen(PROF_CPTL_ACCESS_FILENAME, "a");
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_CPTL);
 
 #if defined(PROF_CPTL_ACCESS_SIMUL)
   uint32_t consec_hit_count = simulate_cache(sidx, type_miss_penalty);
@@ -104,6 +118,17 @@ inline void __attr_always_inline___ print_cptl_access(uint32_t sidx,
     type_miss_penalty = (int)GET_LOOKUP_DEPTH();
   }
 
+  if (is_profile_record_enabled()) {
+    profile_record_begin("cptl_access");
+    profile_record_uint("access_number", JERRY_CONTEXT(cptl_access_count)++);
+    profile_record_uint("sidx", sidx);
+    profile_record_int("type_depth", type_miss_penalty);
+    profile_record_uint("consec_hit_count", consec_hit_count);
+    profile_record_end();
+    return;
+  }
+
+  FILE* fp = fopen(PROF_CPTL_ACCESS_FILENAME, "a");
   fprintf(fp, "%u, %u, %d, %u\n", JERRY_CONTEXT(cptl_access_count)++, sidx,
           type_miss_penalty, consec_hit_count);
   fflush(fp);
@@ -0,0 +1,205 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hashtable.h"
+#include "jcontext.h"
+#include "jmem-profiler-common-internal.h"
+#include "jmem-profiler.h"
+#include "vm-defines.h"
+
+#if defined(JMEM_PROFILE) && defined(PROF_CPU)
+/* Sampling CPU profiling
+ * A timer of the embedder calls profile_cpu_tick from its signal handler. If
+ * JS is running, the tick only asks the VM for a sample, and the stack of
+ * code sites is sampled at the next execution stop check (a backward jump, a
+ * caught exception or a call), where the frames are consistent. A tick out of
+ * JS is credited to "(native)". The report is in the folded stack format of
+ * flame graph tools, a count of ticks per stack:
+ *   app.js:1;app.js:12 153
+ */
+
+// Innermost frame first; unused entries are zero to compare whole keys
+typedef struct {
+  uint32_t depth;
+  uint32_t site_idxs[PROF_CPU__MAX_DEPTH];
+} cpu_stack_t;
+
+static HashTable cpu_stacks_ht; // key=<cpu_stack_t> value=<ull ticks>
+
+// Ticks are only counted up by the signal handler, and taken ticks only by the
+// VM, so neither update races with the other.
+static volatile uint32_t js_ticks = 0;
+static uint32_t taken_js_ticks = 0;
+static volatile uint32_t native_ticks = 0;
+static uint32_t taken_native_ticks = 0;
+
+static void __init_cpu_tables(void) {
+  if (ht_is_initialized(&cpu_stacks_ht)) {
+    return;
+  }
+  ht_setup(&cpu_stacks_ht, sizeof(cpu_stack_t), sizeof(unsigned long long),
+           64);
+}
+
+// Outermost frame first, as flame graph tools expect
+static const char *__format_cpu_stack(const cpu_stack_t *stack) {
+  static char stack_str[PROF_CPU__MAX_DEPTH * 64];
+  size_t pos = 0;
+
+  stack_str[0] = '\0';
+  if (stack->depth == 0) {
+    append_profile_str(stack_str, pos, sizeof(stack_str), "(native)");
+    return stack_str;
+  }
+  for (uint32_t i = stack->depth; i > 0; i--) {
+    pos = append_code_site(stack_str, pos, sizeof(stack_str),
+                           stack->site_idxs[i - 1]);
+    if (i > 1) {
+      pos = append_profile_str(stack_str, pos, sizeof(stack_str), ";");
+    }
+  }
+  return stack_str;
+}
+
+// The ticks out of JS are added to the stack without frames
+static void __add_native_ticks(void) {
+  unsigned long long ticks = (uint32_t)(native_ticks - taken_native_ticks);
+  taken_native_ticks += (uint32_t)ticks;
+  if (ticks == 0) {
+    return;
+  }
+
+  cpu_stack_t stack;
+  memset(&stack, 0, sizeof(stack));
+  if (ht_contains(&cpu_stacks_ht, &stack)) {
+    HT_LOOKUP_AS(unsigned long long, &cpu_stacks_ht, &stack) += ticks;
+  } else {
+    ht_insert(&cpu_stacks_ht, &stack, &ticks);
+  }
+}
+
+static void __write_cpu_profile(FILE *fp) {
+  __add_native_ticks();
+  for (size_t chain = 0; chain < cpu_stacks_ht.capacity; chain++) {
+    for (HTNode *node = cpu_stacks_ht.nodes[chain]; node != NULL;
+         node = node->next) {
+      fprintf(fp, "%s %llu\n",
+              __format_cpu_stack((const cpu_stack_t *)node->key),
+              *(unsigned long long *)node->value);
+    }
+  }
+}
+
+static void __record_cpu_profile(void) {
+  // A record per stack, in the same folded format
+  __add_native_ticks();
+  for (size_t chain = 0; chain < cpu_stacks_ht.capacity; chain++) {
+    for (HTNode *node = cpu_stacks_ht.nodes[chain]; node != NULL;
+         node = node->next) {
+      profile_record_begin("cpu");
+      profile_record_str("stack",
+                         __format_cpu_stack((const cpu_stack_t *)node->key));
+      profile_record_uint("ticks", *(unsigned long long *)node->value);
+      profile_record_end();
+    }
+  }
+}
+#endif /* defined(JMEM_PROFILE) && defined(PROF_CPU) */
+
+inline void __attr_always_inline___ init_cpu_profiler(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_CPU)
+  CHECK_LOGGING_ENABLED();
+  __init_cpu_tables();
+  ht_clear(&cpu_stacks_ht);
+  taken_js_ticks = js_ticks;
+  taken_native_ticks = native_ticks;
+#endif
+}
+
+// Called from a signal handler: it only reads the context and sets flags.
+void profile_cpu_tick(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_CPU)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_CPU);
+  if (JERRY_CONTEXT(vm_top_context_p) == NULL) {
+    native_ticks++;
+    return;
+  }
+  js_ticks++;
+  JERRY_CONTEXT(vm_exec_sample_requested) = 1;
+  JERRY_CONTEXT(vm_exec_stop_pending) = 1;
+#endif
+}
+
+void profile_cpu_take_sample(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_CPU)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_CPU);
+  // A sample stands for all the ticks since the last one
+  unsigned long long ticks = (uint32_t)(js_ticks - taken_js_ticks);
+  taken_js_ticks += (uint32_t)ticks;
+  if (ticks == 0) {
+    return;
+  }
+
+  cpu_stack_t stack;
+  memset(&stack, 0, sizeof(stack));
+
+  // Deeper frames than the limit are truncated at the root side
+  for (vm_frame_ctx_t *frame_p = JERRY_CONTEXT(vm_top_context_p);
+       frame_p != NULL && stack.depth < PROF_CPU__MAX_DEPTH;
+       frame_p = frame_p->prev_context_p) {
+    stack.site_idxs[stack.depth++] =
+        get_code_site_idx((const void *)frame_p->bytecode_header_p);
+  }
+
+  if (ht_contains(&cpu_stacks_ht, &stack)) {
+    HT_LOOKUP_AS(unsigned long long, &cpu_stacks_ht, &stack) += ticks;
+  } else {
+    ht_insert(&cpu_stacks_ht, &stack, &ticks);
+  }
+#endif
+}
+
+inline void __attr_always_inline___ print_cpu_profile(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_CPU)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_CPU);
+  if (is_profile_record_enabled()) {
+    __record_cpu_profile();
+    return;
+  }
+  write_cpu_profile(PROF_CPU_FILENAME);
+#endif
+}
+
+bool write_cpu_profile(const char *path) {
+#if defined(JMEM_PROFILE) && defined(PROF_CPU)
+  if (!ht_is_initialized(&cpu_stacks_ht)) {
+    return false;
+  }
+  FILE *fp = fopen(path, "w");
+  if (fp == NULL) {
+    return false;
+  }
+  __write_cpu_profile(fp);
+  fflush(fp);
+  fclose(fp);
+  return true;
+#else
+  JERRY_UNUSED(path);
+  return false;
+#endif
+}
@@ -27,7 +27,7 @@
 inline void __attr_always_inline___
 profile_jsobject_inc_allocation(size_t jsobject_size) {
 #if defined(JMEM_PROFILE) && defined(PROF_JSOBJECT_ALLOCATION)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_JSOBJECT);
   size_t aligned_size =
       (jsobject_size + JMEM_ALIGNMENT - 1) / JMEM_ALIGNMENT * JMEM_ALIGNMENT;
 
@@ -44,7 +44,18 @@ profile_jsobject_inc_allocation(size_t jsobject_size) {
 
 inline void __attr_always_inline___ print_jsobject_allocation_profile(void) {
 #if defined(JMEM_PROFILE) && defined(PROF_JSOBJECT_ALLOCATION)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_JSOBJECT);
+  if (is_profile_record_enabled()) {
+    profile_record_begin("jsobject");
+    for (uint32_t index = 0;
+         index < PROF_JSOBJECT_ALLOCATION__MAX_SIZE / JMEM_ALIGNMENT; index++) {
+      profile_record_indexed_uint("size_", (index + 1) * JMEM_ALIGNMENT,
+                                  JERRY_CONTEXT(jsobject_count[index]));
+    }
+    profile_record_end();
+    return;
+  }
+
   FILE *fp = fopen(PROF_JSOBJECT_ALLOCATION_FILENAME, "a");
 
   for (uint32_t index = 0;
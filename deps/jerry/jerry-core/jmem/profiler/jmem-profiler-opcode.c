@@ -0,0 +1,173 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "byte-code.h"
+#include "hashtable.h"
+#include "jmem-profiler-common-internal.h"
+#include "jmem-profiler.h"
+
+#if defined(JMEM_PROFILE) && defined(PROF_OPCODE)
+/* Opcode profiling
+ * vm_loop counts the opcodes it executes, and the pairs of opcodes executed
+ * one after another in the same function, per code site of the function.
+ * Opcodes are numbered as in vm_decode_table: extended opcodes follow the
+ * CBC_END opcode.
+ */
+#define OPCODE_NONE UINT16_MAX // first opcode of a single opcode count
+
+typedef struct {
+  uint32_t site_idx;
+  uint16_t first;  // OPCODE_NONE for a single opcode
+  uint16_t second;
+} opcode_key_t;
+
+#define CBC_OPCODE(arg1, arg2, arg3, arg4) #arg1,
+static const char *const opcode_names[] = {CBC_OPCODE_LIST
+                                               CBC_EXT_OPCODE_LIST};
+#undef CBC_OPCODE
+
+#define NUM_OPCODES (sizeof(opcode_names) / sizeof(opcode_names[0]))
+
+static HashTable opcode_ht; // key=<opcode_key_t> value=<ull count>
+
+// The function of the last executed opcode
+static const void *last_bytecode_p = NULL;
+static uint32_t last_site_idx = CODE_SITE_UNKNOWN;
+static uint16_t last_opcode = OPCODE_NONE;
+
+static void __count_opcode(uint32_t site_idx, uint16_t first,
+                           uint16_t second) {
+  opcode_key_t key;
+  memset(&key, 0, sizeof(key));
+  key.site_idx = site_idx;
+  key.first = first;
+  key.second = second;
+  if (ht_contains(&opcode_ht, &key)) {
+    HT_LOOKUP_AS(unsigned long long, &opcode_ht, &key)++;
+  } else {
+    unsigned long long count = 1;
+    ht_insert(&opcode_ht, &key, &count);
+  }
+}
+
+static void __record_opcode_profile(void) {
+  for (size_t chain = 0; chain < opcode_ht.capacity; chain++) {
+    for (HTNode *node = opcode_ht.nodes[chain]; node != NULL;
+         node = node->next) {
+      opcode_key_t *key = (opcode_key_t *)node->key;
+      unsigned long long count = *(unsigned long long *)node->value;
+      if (key->first == OPCODE_NONE) {
+        profile_record_begin("opcode");
+        profile_record_str("function", format_code_site(key->site_idx));
+        profile_record_str("opcode", opcode_names[key->second]);
+      } else {
+        profile_record_begin("opcode_pair");
+        profile_record_str("function", format_code_site(key->site_idx));
+        profile_record_str("first", opcode_names[key->first]);
+        profile_record_str("second", opcode_names[key->second]);
+      }
+      profile_record_uint("count", count);
+      profile_record_end();
+    }
+  }
+}
+
+static void __write_opcode_profile(FILE *fp) {
+  for (size_t chain = 0; chain < opcode_ht.capacity; chain++) {
+    for (HTNode *node = opcode_ht.nodes[chain]; node != NULL;
+         node = node->next) {
+      opcode_key_t *key = (opcode_key_t *)node->key;
+      unsigned long long count = *(unsigned long long *)node->value;
+      if (key->first == OPCODE_NONE) {
+        fprintf(fp, "OP, %s, %s, %llu\n", format_code_site(key->site_idx),
+                opcode_names[key->second], count);
+      } else {
+        fprintf(fp, "OPPAIR, %s, %s, %s, %llu\n",
+                format_code_site(key->site_idx), opcode_names[key->first],
+                opcode_names[key->second], count);
+      }
+    }
+  }
+}
+#endif /* defined(JMEM_PROFILE) && defined(PROF_OPCODE) */
+
+inline void __attr_always_inline___ init_opcode_profiler(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_OPCODE)
+  CHECK_LOGGING_ENABLED();
+  if (!ht_is_initialized(&opcode_ht)) {
+    ht_setup(&opcode_ht, sizeof(opcode_key_t), sizeof(unsigned long long),
+             256);
+  }
+  ht_clear(&opcode_ht);
+  last_bytecode_p = NULL;
+  last_opcode = OPCODE_NONE;
+#endif
+}
+
+void profile_opcode_on_execute(const void *bytecode_p, uint32_t opcode) {
+#if defined(JMEM_PROFILE) && defined(PROF_OPCODE)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_OPCODE);
+  JERRY_ASSERT(opcode < NUM_OPCODES);
+
+  // Pairs are not counted across calls and returns
+  if (bytecode_p != last_bytecode_p) {
+    last_bytecode_p = bytecode_p;
+    last_site_idx = get_code_site_idx(bytecode_p);
+    last_opcode = OPCODE_NONE;
+  }
+
+  __count_opcode(last_site_idx, OPCODE_NONE, (uint16_t)opcode);
+  if (last_opcode != OPCODE_NONE) {
+    __count_opcode(last_site_idx, last_opcode, (uint16_t)opcode);
+  }
+  last_opcode = (uint16_t)opcode;
+#else
+  JERRY_UNUSED(bytecode_p);
+  JERRY_UNUSED(opcode);
+#endif
+}
+
+// The address of freed byte code may be reused by another function
+void profile_opcode_on_code_free(const void *bytecode_p) {
+#if defined(JMEM_PROFILE) && defined(PROF_OPCODE)
+  if (bytecode_p == last_bytecode_p) {
+    last_bytecode_p = NULL;
+    last_opcode = OPCODE_NONE;
+  }
+#else
+  JERRY_UNUSED(bytecode_p);
+#endif
+}
+
+inline void __attr_always_inline___ print_opcode_profile(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_OPCODE)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_OPCODE);
+  if (is_profile_record_enabled()) {
+    __record_opcode_profile();
+    return;
+  }
+
+  FILE *fp = fopen(PROF_OPCODE_FILENAME, "a");
+  if (fp == NULL) {
+    return;
+  }
+  __write_opcode_profile(fp);
+  fflush(fp);
+  fclose(fp);
+#endif
+}
@@ -18,33 +18,62 @@
 #include "jmem-profiler-common-internal.h"
 #include "jmem-profiler.h"
 
+#if defined(JMEM_PROFILE) && defined(PROF_PMU) && \
+    defined(PROF_PMU__PERF_EVENT) && defined(__linux__)
+#define PMU_PERF_EVENT_BACKEND
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #if defined(JMEM_PROFILE) && defined(PROF_PMU)
-void __start_pmu_cycles_watch(unsigned long long *cycles_watch);
-void __stop_pmu_cycles_watch(unsigned long long *cycles_watch,
-                             unsigned long long *cycles,
-                             unsigned int *count);
+// Samples longer than this are dropped as they are likely to be preempted
+#define PMU_MAX_CPTL_SAMPLE_CYCLES 10000ull
+#define PMU_MAX_GC_SAMPLE_CYCLES (~0ull)
+
+static void __open_pmu_events(void);
+static void __start_pmu_watch(jmem_pmu_counters_t *watch);
+static void __stop_pmu_watch(jmem_pmu_counters_t *watch,
+                             jmem_pmu_counters_t *total, unsigned int *count,
+                             unsigned long long max_cycles);
 #endif
 
 /* PMU profiling */
 inline void __attr_always_inline___ init_pmu_profiler(void) {
 #if defined(JMEM_PROFILE) && defined(PROF_PMU)
-#define INIT_PROFILER_PMU_ENTRY(x)   \
-  JERRY_CONTEXT(x##_cycles) = 0;     \
+#define INIT_PROFILER_PMU_COUNTERS(x) \
+  JERRY_CONTEXT(x).cycles = 0;        \
+  JERRY_CONTEXT(x).instructions = 0;  \
+  JERRY_CONTEXT(x).cache_misses = 0;  \
+  JERRY_CONTEXT(x).branch_misses = 0
+#define INIT_PROFILER_PMU_ENTRY(x)       \
+  INIT_PROFILER_PMU_COUNTERS(x##_pmu);   \
   JERRY_CONTEXT(x##_pmu_count) = 0
 
   CHECK_LOGGING_ENABLED();
-  JERRY_CONTEXT(compression_cycles_val) = 0;
-  JERRY_CONTEXT(decompression_cycles_val) = 0;
+  __open_pmu_events();
+  INIT_PROFILER_PMU_COUNTERS(compression_pmu_watch);
+  INIT_PROFILER_PMU_COUNTERS(decompression_pmu_watch);
+  INIT_PROFILER_PMU_COUNTERS(gc_pmu_watch);
   INIT_PROFILER_PMU_ENTRY(decompression);
   INIT_PROFILER_PMU_ENTRY(compression_rmc_hit);
   INIT_PROFILER_PMU_ENTRY(compression_fifo_hit);
   INIT_PROFILER_PMU_ENTRY(compression_final_miss);
+  INIT_PROFILER_PMU_ENTRY(gc);
 #endif
 }
 
+#if defined(JMEM_PROFILE) && defined(PROF_PMU)
+static const char *__get_pmu_backend_name(void);
+#endif
+
 void print_pmu_profile(void) {
 #if defined(JMEM_PROFILE) && defined(PROF_PMU)
-#define TOTAL_CYCLES(x) (unsigned long long)JERRY_CONTEXT(x##_cycles)
+#define TOTAL(x, event) (unsigned long long)JERRY_CONTEXT(x##_pmu).event
+#define TOTAL3(x, y, z, event) (TOTAL(x, event) + TOTAL(y, event) + TOTAL(z, event))
+#define TOTAL_CYCLES(x) TOTAL(x, cycles)
 #define AVG_CYCLES(x)                                                      \
   (JERRY_CONTEXT(x##_pmu_count) > 0)                                       \
       ? TOTAL_CYCLES(x) / (unsigned long long)JERRY_CONTEXT(x##_pmu_count) \
@@ -59,8 +88,7 @@ void print_pmu_profile(void) {
              (unsigned long long)JERRY_CONTEXT(y##_pmu_count) + \
              (unsigned long long)JERRY_CONTEXT(z##_pmu_count))  \
       : 0
-#define TOTAL_CYCLES3(x, y, z) \
-  (TOTAL_CYCLES(x) + TOTAL_CYCLES(y) + TOTAL_CYCLES(z))
+#define TOTAL_CYCLES3(x, y, z) TOTAL3(x, y, z, cycles)
 #define PRINT_PMU_HEADER(fp) fprintf(fp, "PMU")
 #define PRINT_CYCLES(fp, x) fprintf(fp, ", %llu", x)
 #define PRINT_AVG_CYCLES(fp, x) fprintf(fp, ", %llu", AVG_CYCLES(x))
@@ -69,9 +97,58 @@ void print_pmu_profile(void) {
 #define PRINT_TOTAL_CYCLES(fp, x) fprintf(fp, ", %llu", TOTAL_CYCLES(x))
 #define PRINT_TOTAL_CYCLES3(fp, x, y, z) \
   fprintf(fp, ", %llu", TOTAL_CYCLES3(x, y, z))
+#define PRINT_EVENTS(fp, x)                                              \
+  fprintf(fp, ", %llu, %llu, %llu", TOTAL(x, instructions),            \
+          TOTAL(x, cache_misses), TOTAL(x, branch_misses))
+#define PRINT_EVENTS3(fp, x, y, z)                                       \
+  fprintf(fp, ", %llu, %llu, %llu", TOTAL3(x, y, z, instructions),     \
+          TOTAL3(x, y, z, cache_misses), TOTAL3(x, y, z, branch_misses))
 #define PRINT_PMU_TAIL(fp) fprintf(fp, "\n")
+#define RECORD_AVG_CYCLES(x) profile_record_uint(#x "_avg_cycles", AVG_CYCLES(x))
+#define RECORD_TOTAL_CYCLES(x) \
+  profile_record_uint(#x "_total_cycles", TOTAL_CYCLES(x))
+#define RECORD_EVENTS(x)                                                  \
+  profile_record_uint(#x "_instructions", TOTAL(x, instructions));       \
+  profile_record_uint(#x "_cache_misses", TOTAL(x, cache_misses));       \
+  profile_record_uint(#x "_branch_misses", TOTAL(x, branch_misses))
+#define COMPRESSION_ENTRIES \
+  compression_rmc_hit, compression_fifo_hit, compression_final_miss
+
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_PMU);
+  if (is_profile_record_enabled()) {
+    profile_record_begin("pmu");
+    profile_record_str("backend", __get_pmu_backend_name());
+    RECORD_AVG_CYCLES(decompression);
+    profile_record_uint("compression_avg_cycles",
+                        AVG_CYCLES3(compression_rmc_hit, compression_fifo_hit,
+                                    compression_final_miss));
+    RECORD_AVG_CYCLES(compression_rmc_hit);
+    RECORD_AVG_CYCLES(compression_fifo_hit);
+    RECORD_AVG_CYCLES(compression_final_miss);
+    RECORD_AVG_CYCLES(gc);
+    RECORD_TOTAL_CYCLES(decompression);
+    profile_record_uint("compression_total_cycles",
+                        TOTAL_CYCLES3(compression_rmc_hit, compression_fifo_hit,
+                                      compression_final_miss));
+    RECORD_TOTAL_CYCLES(compression_rmc_hit);
+    RECORD_TOTAL_CYCLES(compression_fifo_hit);
+    RECORD_TOTAL_CYCLES(compression_final_miss);
+    RECORD_TOTAL_CYCLES(gc);
+    RECORD_EVENTS(decompression);
+    profile_record_uint("compression_instructions",
+                        TOTAL3(compression_rmc_hit, compression_fifo_hit,
+                               compression_final_miss, instructions));
+    profile_record_uint("compression_cache_misses",
+                        TOTAL3(compression_rmc_hit, compression_fifo_hit,
+                               compression_final_miss, cache_misses));
+    profile_record_uint("compression_branch_misses",
+                        TOTAL3(compression_rmc_hit, compression_fifo_hit,
+                               compression_final_miss, branch_misses));
+    RECORD_EVENTS(gc);
+    profile_record_end();
+    return;
+  }
 
-  CHECK_LOGGING_ENABLED();
   FILE *fp = fopen(PROF_PMU_FILENAME, "a");
 
   PRINT_PMU_HEADER(fp);
@@ -87,6 +164,14 @@ void print_pmu_profile(void) {
   PRINT_TOTAL_CYCLES(fp, compression_rmc_hit);
   PRINT_TOTAL_CYCLES(fp, compression_fifo_hit);
   PRINT_TOTAL_CYCLES(fp, compression_final_miss);
+  // Appended to keep the former columns: GC cycles, and instructions, cache
+  // misses and branch misses of decompression, compression and GC
+  PRINT_AVG_CYCLES(fp, gc);
+  PRINT_TOTAL_CYCLES(fp, gc);
+  PRINT_EVENTS(fp, decompression);
+  PRINT_EVENTS3(fp, compression_rmc_hit, compression_fifo_hit,
+                compression_final_miss);
+  PRINT_EVENTS(fp, gc);
   PRINT_PMU_TAIL(fp);
   fflush(fp);
   fclose(fp);
@@ -95,25 +180,28 @@ void print_pmu_profile(void) {
 
 void __attr_always_inline___ profile_compression_cycles_start(void) {
 #if defined(PROF_PMU__COMPRESSION_CYCLES)
-  CHECK_LOGGING_ENABLED();
-  __start_pmu_cycles_watch(&JERRY_CONTEXT(compression_cycles_val));
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_PMU);
+  __start_pmu_watch(&JERRY_CONTEXT(compression_pmu_watch));
 #endif
 }
 inline void __attr_always_inline___ profile_compression_cycles_end(int type) {
 #if defined(PROF_PMU__COMPRESSION_CYCLES)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_PMU);
   if (type == 0) { // COMPRESSION_RMC_HIT
-    __stop_pmu_cycles_watch(&JERRY_CONTEXT(compression_cycles_val),
-                            &JERRY_CONTEXT(compression_rmc_hit_cycles),
-                            &JERRY_CONTEXT(compression_rmc_hit_pmu_count));
+    __stop_pmu_watch(&JERRY_CONTEXT(compression_pmu_watch),
+                     &JERRY_CONTEXT(compression_rmc_hit_pmu),
+                     &JERRY_CONTEXT(compression_rmc_hit_pmu_count),
+                     PMU_MAX_CPTL_SAMPLE_CYCLES);
   } else if (type == 1) { // COMPRESSION_FIFO_HIT
-    __stop_pmu_cycles_watch(&JERRY_CONTEXT(compression_cycles_val),
-                            &JERRY_CONTEXT(compression_fifo_hit_cycles),
-                            &JERRY_CONTEXT(compression_fifo_hit_pmu_count));
+    __stop_pmu_watch(&JERRY_CONTEXT(compression_pmu_watch),
+                     &JERRY_CONTEXT(compression_fifo_hit_pmu),
+                     &JERRY_CONTEXT(compression_fifo_hit_pmu_count),
+                     PMU_MAX_CPTL_SAMPLE_CYCLES);
   } else if (type == 2) { // COMPRESSION_FINAL_MISS
-    __stop_pmu_cycles_watch(&JERRY_CONTEXT(compression_cycles_val),
-                            &JERRY_CONTEXT(compression_final_miss_cycles),
-                            &JERRY_CONTEXT(compression_final_miss_pmu_count));
+    __stop_pmu_watch(&JERRY_CONTEXT(compression_pmu_watch),
+                     &JERRY_CONTEXT(compression_final_miss_pmu),
+                     &JERRY_CONTEXT(compression_final_miss_pmu_count),
+                     PMU_MAX_CPTL_SAMPLE_CYCLES);
   } else {
     printf("Invalid argument to profile_compression_end: %d\n", type);
   }
@@ -124,16 +212,31 @@ inline void __attr_always_inline___ profile_compression_cycles_end(int type) {
 
 inline void __attr_always_inline___ profile_decompression_cycles_start(void) {
 #if defined(PROF_PMU__DECOMPRESSION_CYCLES)
-  CHECK_LOGGING_ENABLED();
-  __start_pmu_cycles_watch(&JERRY_CONTEXT(decompression_cycles_val));
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_PMU);
+  __start_pmu_watch(&JERRY_CONTEXT(decompression_pmu_watch));
 #endif
 }
 inline void __attr_always_inline___ profile_decompression_cycles_end(void) {
 #if defined(PROF_PMU__DECOMPRESSION_CYCLES)
-  CHECK_LOGGING_ENABLED();
-  __stop_pmu_cycles_watch(&JERRY_CONTEXT(decompression_cycles_val),
-                          &JERRY_CONTEXT(decompression_cycles),
-                          &JERRY_CONTEXT(decompression_pmu_count));
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_PMU);
+  __stop_pmu_watch(&JERRY_CONTEXT(decompression_pmu_watch),
+                   &JERRY_CONTEXT(decompression_pmu),
+                   &JERRY_CONTEXT(decompression_pmu_count),
+                   PMU_MAX_CPTL_SAMPLE_CYCLES);
+#endif
+}
+
+inline void __attr_always_inline___ profile_gc_cycles_start(void) {
+#if defined(PROF_PMU__GC_CYCLES)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_PMU);
+  __start_pmu_watch(&JERRY_CONTEXT(gc_pmu_watch));
+#endif
+}
+inline void __attr_always_inline___ profile_gc_cycles_end(void) {
+#if defined(PROF_PMU__GC_CYCLES)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_PMU);
+  __stop_pmu_watch(&JERRY_CONTEXT(gc_pmu_watch), &JERRY_CONTEXT(gc_pmu),
+                   &JERRY_CONTEXT(gc_pmu_count), PMU_MAX_GC_SAMPLE_CYCLES);
 #endif
 }
 
@@ -149,22 +252,117 @@ static inline unsigned long arm_pmu_read_cycles(void) {
 #endif
 }
 
-void __start_pmu_cycles_watch(unsigned long long *cycles_watch) {
-  *cycles_watch = (unsigned long long)arm_pmu_read_cycles();
+#if defined(PMU_PERF_EVENT_BACKEND)
+// perf_event_open backend
+// The events are read at once as a group led by the cycle counter. An event
+// that the CPU does not support is left out of the group and reads as 0.
+#define PMU_EVENT_CYCLES 0
+#define PMU_EVENT_INSTRUCTIONS 1
+#define PMU_EVENT_CACHE_MISSES 2
+#define PMU_EVENT_BRANCH_MISSES 3
+#define PMU_NUM_EVENTS 4
+
+static int pmu_group_fd = -1;
+static bool is_pmu_events_opened = false;
+static int pmu_event_slots[PMU_NUM_EVENTS]; // index in a group read, or -1
+static uint32_t pmu_num_slots = 0;
+
+static void __open_pmu_events(void) {
+  static const uint64_t configs[PMU_NUM_EVENTS] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+  // Events are opened once, and kept across contexts
+  if (is_pmu_events_opened) {
+    return;
+  }
+  is_pmu_events_opened = true;
+
+  for (int event = 0; event < PMU_NUM_EVENTS; event++) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = configs[event];
+    attr.disabled = (pmu_group_fd == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, pmu_group_fd, 0);
+    if (fd < 0) {
+      pmu_event_slots[event] = -1;
+      if (event == PMU_EVENT_CYCLES) {
+        // The group cannot be made without its leader: fall back to raw PMU
+        return;
+      }
+      continue;
+    }
+    if (pmu_group_fd == -1) {
+      pmu_group_fd = fd;
+    }
+    pmu_event_slots[event] = (int)pmu_num_slots++;
+  }
+
+  ioctl(pmu_group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(pmu_group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static inline unsigned long long __attr_always_inline___
+__get_pmu_event_value(const uint64_t *values, int event) {
+  int slot = pmu_event_slots[event];
+  return (slot >= 0) ? (unsigned long long)values[1 + slot] : 0;
 }
-void __stop_pmu_cycles_watch(unsigned long long *cycles_watch,
-                             unsigned long long *cycles,
-                             unsigned int *count) {
-  unsigned long long curr_cycles;
-  curr_cycles = (unsigned long long)arm_pmu_read_cycles();
-  unsigned long long my_cycles = (curr_cycles - *cycles_watch);
-  my_cycles = (curr_cycles - *cycles_watch);
-  if(my_cycles < 10000) {
-    *cycles += my_cycles;
+#else
+static void __open_pmu_events(void) {}
+#endif /* defined(PMU_PERF_EVENT_BACKEND) */
+
+static const char *__get_pmu_backend_name(void) {
+#if defined(PMU_PERF_EVENT_BACKEND)
+  if (pmu_group_fd >= 0) {
+    return "perf_event";
+  }
+#endif
+  return "arm";
+}
+
+static inline void __attr_always_inline___
+__read_pmu_counters(jmem_pmu_counters_t *counters) {
+#if defined(PMU_PERF_EVENT_BACKEND)
+  if (pmu_group_fd >= 0) {
+    uint64_t values[1 + PMU_NUM_EVENTS]; // nr, then values of the group
+    if (read(pmu_group_fd, values, sizeof(values)) > 0) {
+      counters->cycles = __get_pmu_event_value(values, PMU_EVENT_CYCLES);
+      counters->instructions =
+          __get_pmu_event_value(values, PMU_EVENT_INSTRUCTIONS);
+      counters->cache_misses =
+          __get_pmu_event_value(values, PMU_EVENT_CACHE_MISSES);
+      counters->branch_misses =
+          __get_pmu_event_value(values, PMU_EVENT_BRANCH_MISSES);
+      return;
+    }
+  }
+#endif /* defined(PMU_PERF_EVENT_BACKEND) */
+  counters->cycles = (unsigned long long)arm_pmu_read_cycles();
+  counters->instructions = 0;
+  counters->cache_misses = 0;
+  counters->branch_misses = 0;
+}
+
+void __start_pmu_watch(jmem_pmu_counters_t *watch) {
+  __read_pmu_counters(watch);
+}
+void __stop_pmu_watch(jmem_pmu_counters_t *watch, jmem_pmu_counters_t *total,
+                      unsigned int *count, unsigned long long max_cycles) {
+  jmem_pmu_counters_t curr;
+  __read_pmu_counters(&curr);
+  unsigned long long my_cycles = (curr.cycles - watch->cycles);
+  if (my_cycles < max_cycles) {
+    total->cycles += my_cycles;
+    total->instructions += curr.instructions - watch->instructions;
+    total->cache_misses += curr.cache_misses - watch->cache_misses;
+    total->branch_misses += curr.branch_misses - watch->branch_misses;
     *count += 1;
-  } else {
-    JERRY_UNUSED(cycles);
-    JERRY_UNUSED(count);
   }
 }
 #endif /* defined(JMEM_PROFILE) && defined(PROF_PMU) */
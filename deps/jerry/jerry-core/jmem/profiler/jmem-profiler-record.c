@@ -0,0 +1,157 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include "jmem-profiler-common-internal.h"
+#include "jmem-profiler.h"
+
+/* Structured profiler output
+ * If an output is set, all the profilers write records to it instead of their
+ * own log files. A record consists of a timestamp, a profiler id and key/value
+ * fields. Keys are identifiers, so they are written without escaping.
+ * * JSON lines: {"ts":1.000000,"profiler":"size","blocks_size":128, ...}
+ * * CSV: a "timestamp,profiler,key,value" row for each field
+ */
+static FILE *record_fp = NULL;
+static int record_format = PROF_RECORD_FORMAT_JSON;
+static const char *record_profiler_id = NULL;
+static struct timeval record_timestamp;
+
+bool set_profile_record_output(const char *path, int format) {
+  if (format != PROF_RECORD_FORMAT_JSON && format != PROF_RECORD_FORMAT_CSV) {
+    return false;
+  }
+
+  FILE *fp = (path != NULL) ? fopen(path, "a") : stdout;
+  if (fp == NULL) {
+    return false;
+  }
+
+  if (record_fp != NULL && record_fp != stdout) {
+    fclose(record_fp);
+  }
+  record_fp = fp;
+  record_format = format;
+
+  if (record_format == PROF_RECORD_FORMAT_CSV) {
+    fprintf(record_fp, "Timestamp (s), Profiler, Key, Value\n");
+    fflush(record_fp);
+  }
+  return true;
+}
+
+inline bool __attr_always_inline___ is_profile_record_enabled(void) {
+  return record_fp != NULL;
+}
+
+void profile_record_begin(const char *profiler_id) {
+  JERRY_ASSERT(record_fp != NULL && record_profiler_id == NULL);
+  record_profiler_id = profiler_id;
+  get_js_uptime(&record_timestamp);
+
+  if (record_format == PROF_RECORD_FORMAT_JSON) {
+    fprintf(record_fp, "{\"ts\":%lu.%06lu,\"profiler\":\"%s\"",
+            (unsigned long)record_timestamp.tv_sec,
+            (unsigned long)record_timestamp.tv_usec, profiler_id);
+  }
+}
+
+// Write the common part of a field: CSV row header or JSON key
+static void profile_record_key(const char *key, bool has_index,
+                               uint32_t index) {
+  JERRY_ASSERT(record_profiler_id != NULL);
+
+  if (record_format == PROF_RECORD_FORMAT_JSON) {
+    fprintf(record_fp, ",\"%s", key);
+    if (has_index) {
+      fprintf(record_fp, "%lu", (unsigned long)index);
+    }
+    fprintf(record_fp, "\":");
+  } else {
+    fprintf(record_fp, "%lu.%06lu, %s, %s",
+            (unsigned long)record_timestamp.tv_sec,
+            (unsigned long)record_timestamp.tv_usec, record_profiler_id, key);
+    if (has_index) {
+      fprintf(record_fp, "%lu", (unsigned long)index);
+    }
+    fprintf(record_fp, ", ");
+  }
+}
+
+static inline void __attr_always_inline___ profile_record_value_end(void) {
+  if (record_format == PROF_RECORD_FORMAT_CSV) {
+    fprintf(record_fp, "\n");
+  }
+}
+
+void profile_record_int(const char *key, long long value) {
+  profile_record_key(key, false, 0);
+  fprintf(record_fp, "%lld", value);
+  profile_record_value_end();
+}
+
+void profile_record_uint(const char *key, unsigned long long value) {
+  profile_record_key(key, false, 0);
+  fprintf(record_fp, "%llu", value);
+  profile_record_value_end();
+}
+
+void profile_record_indexed_int(const char *key_prefix, uint32_t index,
+                                long long value) {
+  profile_record_key(key_prefix, true, index);
+  fprintf(record_fp, "%lld", value);
+  profile_record_value_end();
+}
+
+void profile_record_indexed_uint(const char *key_prefix, uint32_t index,
+                                 unsigned long long value) {
+  profile_record_key(key_prefix, true, index);
+  fprintf(record_fp, "%llu", value);
+  profile_record_value_end();
+}
+
+void profile_record_float(const char *key, double value) {
+  profile_record_key(key, false, 0);
+  fprintf(record_fp, "%.6f", value);
+  profile_record_value_end();
+}
+
+void profile_record_indexed_float(const char *key_prefix, uint32_t index,
+                                  double value) {
+  profile_record_key(key_prefix, true, index);
+  fprintf(record_fp, "%.6f", value);
+  profile_record_value_end();
+}
+
+void profile_record_str(const char *key, const char *value) {
+  profile_record_key(key, false, 0);
+  if (record_format == PROF_RECORD_FORMAT_JSON) {
+    fprintf(record_fp, "\"%s\"", value);
+  } else {
+    fprintf(record_fp, "%s", value);
+  }
+  profile_record_value_end();
+}
+
+void profile_record_end(void) {
+  JERRY_ASSERT(record_profiler_id != NULL);
+  if (record_format == PROF_RECORD_FORMAT_JSON) {
+    fprintf(record_fp, "}\n");
+  }
+  fflush(record_fp);
+  record_profiler_id = NULL;
+}
@@ -0,0 +1,171 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hashtable.h"
+#include "jcontext.h"
+#include "jmem-profiler-common-internal.h"
+#include "jmem-profiler.h"
+#include "vm-defines.h"
+
+#if defined(JMEM_PROFILE) && defined(PROF_SAMPLING)
+/* Sampling heap profiling
+ * Every PROF_SAMPLING__INTERVAL_BYTES bytes allocated by jmem_heap_alloc_block,
+ * the running JS frames are sampled, and the stack of their code sites is
+ * credited with the interval. The report is in the folded stack format of
+ * flame graph tools:
+ *   app.js:1;http_incoming.js:42 65536
+ */
+
+// Innermost frame first; unused entries are zero to compare whole keys
+typedef struct {
+  uint32_t depth;
+  uint32_t site_idxs[PROF_SAMPLING__MAX_DEPTH];
+} sampling_stack_t;
+
+static HashTable stacks_ht; // key=<sampling_stack_t> value=<ull bytes>
+static size_t allocated_bytes_since_sample = 0;
+
+static void __init_sampling_tables(void) {
+  if (ht_is_initialized(&stacks_ht)) {
+    return;
+  }
+  ht_setup(&stacks_ht, sizeof(sampling_stack_t), sizeof(unsigned long long),
+           64);
+}
+
+// Outermost frame first, as flame graph tools expect
+static const char *__format_stack(const sampling_stack_t *stack) {
+  static char stack_str[PROF_SAMPLING__MAX_DEPTH * 64];
+  size_t pos = 0;
+
+  stack_str[0] = '\0';
+  if (stack->depth == 0) {
+    append_profile_str(stack_str, pos, sizeof(stack_str), "(native)");
+    return stack_str;
+  }
+  for (uint32_t i = stack->depth; i > 0; i--) {
+    pos = append_code_site(stack_str, pos, sizeof(stack_str),
+                           stack->site_idxs[i - 1]);
+    if (i > 1) {
+      pos = append_profile_str(stack_str, pos, sizeof(stack_str), ";");
+    }
+  }
+  return stack_str;
+}
+
+static void __take_sample(unsigned long long bytes) {
+  sampling_stack_t stack;
+  memset(&stack, 0, sizeof(stack));
+
+  // Deeper frames than the limit are truncated at the root side
+  for (vm_frame_ctx_t *frame_p = JERRY_CONTEXT(vm_top_context_p);
+       frame_p != NULL && stack.depth < PROF_SAMPLING__MAX_DEPTH;
+       frame_p = frame_p->prev_context_p) {
+    stack.site_idxs[stack.depth++] =
+        get_code_site_idx((const void *)frame_p->bytecode_header_p);
+  }
+
+  if (ht_contains(&stacks_ht, &stack)) {
+    HT_LOOKUP_AS(unsigned long long, &stacks_ht, &stack) += bytes;
+  } else {
+    ht_insert(&stacks_ht, &stack, &bytes);
+  }
+}
+
+static void __write_sampling_profile(FILE *fp) {
+  for (size_t chain = 0; chain < stacks_ht.capacity; chain++) {
+    for (HTNode *node = stacks_ht.nodes[chain]; node != NULL;
+         node = node->next) {
+      fprintf(fp, "%s %llu\n",
+              __format_stack((const sampling_stack_t *)node->key),
+              *(unsigned long long *)node->value);
+    }
+  }
+}
+
+static void __record_sampling_profile(void) {
+  // A record per stack, in the same folded format
+  for (size_t chain = 0; chain < stacks_ht.capacity; chain++) {
+    for (HTNode *node = stacks_ht.nodes[chain]; node != NULL;
+         node = node->next) {
+      profile_record_begin("sampling");
+      profile_record_str("stack",
+                         __format_stack((const sampling_stack_t *)node->key));
+      profile_record_uint("bytes", *(unsigned long long *)node->value);
+      profile_record_end();
+    }
+  }
+}
+#endif /* defined(JMEM_PROFILE) && defined(PROF_SAMPLING) */
+
+inline void __attr_always_inline___ init_sampling_profiler(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_SAMPLING)
+  CHECK_LOGGING_ENABLED();
+  __init_sampling_tables();
+  ht_clear(&stacks_ht);
+  allocated_bytes_since_sample = 0;
+#endif
+}
+
+inline void __attr_always_inline___ profile_sampling_on_alloc(size_t size) {
+#if defined(JMEM_PROFILE) && defined(PROF_SAMPLING)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SAMPLING);
+  allocated_bytes_since_sample += size;
+  if (likely(allocated_bytes_since_sample < PROF_SAMPLING__INTERVAL_BYTES)) {
+    return;
+  }
+  // A sample stands for all the intervals passed by this allocation
+  size_t num_intervals =
+      allocated_bytes_since_sample / PROF_SAMPLING__INTERVAL_BYTES;
+  allocated_bytes_since_sample %= PROF_SAMPLING__INTERVAL_BYTES;
+  __take_sample((unsigned long long)num_intervals *
+                PROF_SAMPLING__INTERVAL_BYTES);
+#else
+  JERRY_UNUSED(size);
+#endif
+}
+
+inline void __attr_always_inline___ print_sampling_profile(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_SAMPLING)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SAMPLING);
+  if (is_profile_record_enabled()) {
+    __record_sampling_profile();
+    return;
+  }
+  write_sampling_profile(PROF_SAMPLING_FILENAME);
+#endif
+}
+
+bool write_sampling_profile(const char *path) {
+#if defined(JMEM_PROFILE) && defined(PROF_SAMPLING)
+  if (!ht_is_initialized(&stacks_ht)) {
+    return false;
+  }
+  FILE *fp = fopen(path, "w");
+  if (fp == NULL) {
+    return false;
+  }
+  __write_sampling_profile(fp);
+  fflush(fp);
+  fclose(fp);
+  return true;
+#else
+  JERRY_UNUSED(path);
+  return false;
+#endif
+}
@@ -26,15 +26,17 @@ inline void __attr_always_inline___ init_segment_profiler(void) {
 #if defined(JMEM_PROFILE)
   CHECK_LOGGING_ENABLED();
 #if defined(PROF_SEGMENT_UTILIZATION__PERIOD_USEC)
-  FILE *fp2 = fopen(PROF_SEGMENT_UTILIZATION_FILENAME, "w");
-  fprintf(fp2, "Timestamp (s), JSObject Size (s)");
-  for (uint32_t segment_idx = 0; segment_idx < SEG_NUM_SEGMENTS;
-       segment_idx++) {
-    fprintf(fp2, ", S%lu", (unsigned long)segment_idx);
+  if (!is_profile_record_enabled()) {
+    FILE *fp2 = fopen(PROF_SEGMENT_UTILIZATION_FILENAME, "w");
+    fprintf(fp2, "Timestamp (s), JSObject Size (s)");
+    for (uint32_t segment_idx = 0; segment_idx < SEG_NUM_SEGMENTS;
+         segment_idx++) {
+      fprintf(fp2, ", S%lu", (unsigned long)segment_idx);
+    }
+    fprintf(fp2, "\n");
+    fflush(fp2);
+    fclose(fp2);
   }
-  fprintf(fp2, "\n");
-  fflush(fp2);
-  fclose(fp2);
   JERRY_CONTEXT(jsuptime_recent_segutil_print).tv_sec = 0;
   JERRY_CONTEXT(jsuptime_recent_segutil_print).tv_usec = 0;
 #endif
@@ -45,7 +47,7 @@ inline void __attr_always_inline___
 print_segment_utilization_profile_after_free(size_t jsobject_size) {
 #if defined(PROF_SEGMENT_UTILIZATION__AFTER_FREE_BLOCK)
 #if defined(PROF_SEGMENT_UTILIZATION__PERIOD_USEC)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SEGMENT);
   struct timeval js_uptime;
   get_js_uptime(&js_uptime);
   long timeval_diff_in_usec =
@@ -66,7 +68,7 @@ print_segment_utilization_profile_after_free(size_t jsobject_size) {
 inline void __attr_always_inline___
 print_segment_utilization_profile_before_segalloc(size_t jsobject_size) {
 #if defined(PROF_SEGMENT_UTILIZATION__BEFORE_ADD_SEGMENT)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SEGMENT);
   __print_segment_utilization_profile("BAS", jsobject_size);
 #else
   JERRY_UNUSED(jsobject_size);
@@ -76,7 +78,7 @@ print_segment_utilization_profile_before_segalloc(size_t jsobject_size) {
 inline void __attr_always_inline___
 print_segment_utiliaztion_profile_before_gc(size_t jsobject_size) {
 #if defined(PROF_SEGMENT_UTILIZATION__BEFORE_GC)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SEGMENT);
   __print_segment_utilization_profile("BGC", jsobject_size);
 #else
   JERRY_UNUSED(jsobject_size);
@@ -86,7 +88,7 @@ print_segment_utiliaztion_profile_before_gc(size_t jsobject_size) {
 inline void __attr_always_inline___
 print_segment_utiliaztion_profile_after_gc(size_t jsobject_size) {
 #if defined(PROF_SEGMENT_UTILIZATION__AFTER_GC)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SEGMENT);
   __print_segment_utilization_profile("AGC", jsobject_size);
 #else
   JERRY_UNUSED(jsobject_size);
@@ -95,7 +97,7 @@ print_segment_utiliaztion_profile_after_gc(size_t jsobject_size) {
 
 inline void __attr_always_inline___
 print_segment_utilization_profile_finally(void) {
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SEGMENT);
   __print_segment_utilization_profile("F", 0);
 }
 
@@ -103,7 +105,30 @@ inline void __attr_always_inline___
 __print_segment_utilization_profile(const char *header, size_t jsobject_size) {
 #if defined(JMEM_SEGMENTED_HEAP) && defined(JMEM_PROFILE) && \
     defined(PROF_SEGMENT)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SEGMENT);
+  if (is_profile_record_enabled()) {
+    // Only allocated segments are recorded
+    profile_record_begin("segment");
+    profile_record_str("event", header);
+    profile_record_uint("jsobject_size", jsobject_size);
+    for (uint32_t segment_idx = 0; segment_idx < SEG_NUM_SEGMENTS;
+         segment_idx++) {
+      if (JERRY_HEAP_CONTEXT(area[segment_idx]) == NULL) {
+        continue;
+      }
+      jmem_segment_t *segment = &(JERRY_HEAP_CONTEXT(segments[segment_idx]));
+#ifdef PROF_SEGMENT_UTILIZATION__ABSOLUTE
+      profile_record_indexed_uint("s", segment_idx, segment->occupied_size);
+#else
+      profile_record_indexed_float(
+          "s", segment_idx,
+          (double)segment->occupied_size / (double)SEG_SEGMENT_SIZE * 100.0);
+#endif /* defined(PROF_SEGMENT_UTILIZATION__ABSOLUTE) */
+    }
+    profile_record_end();
+    return;
+  }
+
   struct timeval js_uptime;
   get_js_uptime(&js_uptime);
 
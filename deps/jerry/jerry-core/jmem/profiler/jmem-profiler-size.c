@@ -176,14 +176,21 @@ inline void __attr_always_inline___ init_size_profiler(void) {
   CHECK_LOGGING_ENABLED();
 #if defined(PROF_SIZE)
 
-  FILE *fp1 = fopen(PROF_TOTAL_SIZE_FILENAME, "w");
-  fprintf(fp1,
-          "Timestamp (s), Blocks Size (B), Full-bitwidth Pointer Overhead (B), "
-          "Allocated Heap Size (B), System Allocator Metadata Size (B), "
-          "Segment Metadata Size (B), Snapshot Size (B), Total Heap Size (B), "
-          "GC Threshold (B), GC Count\n");
-  fflush(fp1);
-  fclose(fp1);
+  if (!is_profile_record_enabled()) {
+    FILE *fp1 = fopen(PROF_TOTAL_SIZE_FILENAME, "w");
+    fprintf(fp1,
+            "Timestamp (s), Blocks Size (B), Full-bitwidth Pointer Overhead "
+            "(B), Allocated Heap Size (B), System Allocator Metadata Size (B), "
+            "Segment Metadata Size (B), Snapshot Size (B), Total Heap Size "
+            "(B), GC Threshold (B), GC Count\n");
+    fflush(fp1);
+    fclose(fp1);
+
+    FILE *fp2 = fopen(PROF_NO_GC_REGION_FILENAME, "w");
+    fprintf(fp2, "Timestamp (s), Reserved Size (B), Used Size (B), Overrun\n");
+    fflush(fp2);
+    fclose(fp2);
+  }
 #if defined(PROF_SIZE__PERIOD_USEC)
   JERRY_CONTEXT(jsuptime_recent_total_size_print).tv_sec = 0;
   JERRY_CONTEXT(jsuptime_recent_total_size_print).tv_usec = 0;
@@ -195,7 +202,7 @@ inline void __attr_always_inline___ init_size_profiler(void) {
 inline void __attr_always_inline___ print_total_size_profile_on_alloc(void) {
 #if defined(PROF_SIZE)
 #if defined(PROF_SIZE__PERIOD_USEC)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SIZE);
   struct timeval js_uptime;
   get_js_uptime(&js_uptime);
   long timeval_diff_in_usec =
@@ -216,18 +223,45 @@ inline void __attr_always_inline___ print_total_size_profile_on_alloc(void) {
 
 inline void __attr_always_inline___ print_total_size_profile_finally(void) {
 #if defined(PROF_SIZE)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SIZE);
   __print_total_size_profile();
 #endif /* defined(PROF_SIZE) */
 }
 
-inline void __attr_always_inline___ __print_total_size_profile(void) {
+// The headroom a GC-free region has used, at the end of the region
+void print_no_gc_region_profile(size_t reserved_size, size_t used_size,
+                                bool is_overrun) {
 #if defined(PROF_SIZE)
-  CHECK_LOGGING_ENABLED();
-  FILE *fp = fopen(PROF_TOTAL_SIZE_FILENAME, "a");
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SIZE);
+
+  if (is_profile_record_enabled()) {
+    profile_record_begin("no_gc_region");
+    profile_record_uint("reserved_size", reserved_size);
+    profile_record_uint("used_size", used_size);
+    profile_record_uint("overrun", is_overrun ? 1 : 0);
+    profile_record_end();
+    return;
+  }
 
+  FILE *fp = fopen(PROF_NO_GC_REGION_FILENAME, "a");
   struct timeval js_uptime;
   get_js_uptime(&js_uptime);
+  fprintf(fp, "%lu.%06lu, %lu, %lu, %d\n", js_uptime.tv_sec,
+          js_uptime.tv_usec, (unsigned long)reserved_size,
+          (unsigned long)used_size, is_overrun ? 1 : 0);
+  fflush(fp);
+  fclose(fp);
+#else
+  JERRY_UNUSED(reserved_size);
+  JERRY_UNUSED(used_size);
+  JERRY_UNUSED(is_overrun);
+#endif /* defined(PROF_SIZE) */
+}
+
+inline void __attr_always_inline___ __print_total_size_profile(void) {
+#if defined(PROF_SIZE)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_SIZE);
+
   uint32_t blocks_size = (uint32_t)JERRY_CONTEXT(jmem_heap_blocks_size);
   uint32_t full_bw_oh =
       (uint32_t)JERRY_CONTEXT(jmem_full_bitwidth_pointer_overhead);
@@ -245,6 +279,24 @@ inline void __attr_always_inline___ __print_total_size_profile(void) {
     total_heap_size = alloc_heap_size + (uint32_t)*extern_heap_size_ptr;
   }
 
+  if (is_profile_record_enabled()) {
+    profile_record_begin("size");
+    profile_record_uint("blocks_size", blocks_size);
+    profile_record_uint("full_bitwidth_pointer_overhead", full_bw_oh);
+    profile_record_uint("allocated_heap_size", alloc_heap_size);
+    profile_record_uint("system_allocator_metadata_size", sysalloc_meta_size);
+    profile_record_uint("segment_metadata_size", segment_meta_size);
+    profile_record_uint("snapshot_size", snapshot_size);
+    profile_record_uint("total_heap_size", total_heap_size);
+    profile_record_uint("gc_threshold", gc_threshold);
+    profile_record_uint("gc_count", gc_count);
+    profile_record_end();
+    return;
+  }
+
+  FILE *fp = fopen(PROF_TOTAL_SIZE_FILENAME, "a");
+  struct timeval js_uptime;
+  get_js_uptime(&js_uptime);
   fprintf(fp, "%lu.%06lu, %lu, %lu, %lu, %lu, %lu, %lu, %lu, %lu, %lu\n",
           js_uptime.tv_sec, js_uptime.tv_usec, blocks_size, full_bw_oh,
           alloc_heap_size, sysalloc_meta_size, segment_meta_size, snapshot_size,
@@ -83,7 +83,48 @@ void print_time_profile(void) {
 #define PRT_TIME3(fp, x, y, z) PRT(fp, GET_TIME3(x, y, z))
 #define PRT_COUNT(fp, x) PRT(fp, GET_COUNT(x))
 
-  CHECK_LOGGING_ENABLED();
+#define REC_AVG_TIME(x) profile_record_uint(#x "_avg_time_ns", GET_AVG_TIME1(x))
+#define REC_TIME(x) profile_record_uint(#x "_time_ns", GET_TIME(x))
+#define REC_COUNT(x) profile_record_uint(#x "_count", GET_COUNT(x))
+
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
+  if (is_profile_record_enabled()) {
+    profile_record_begin("time");
+    profile_record_uint("uptime_ns", get_uptime_ns());
+
+    REC_AVG_TIME(alloc);
+    REC_AVG_TIME(free);
+    REC_AVG_TIME(gc);
+    REC_AVG_TIME(decompression);
+    profile_record_uint("compression_avg_time_ns",
+                        GET_AVG_TIME3(compression_rmc_hit, compression_fifo_hit,
+                                      compression_final_miss));
+    REC_AVG_TIME(compression_rmc_hit);
+    REC_AVG_TIME(compression_fifo_hit);
+    REC_AVG_TIME(compression_final_miss);
+
+    REC_TIME(alloc);
+    REC_TIME(free);
+    REC_TIME(gc);
+    REC_TIME(decompression);
+    profile_record_uint("compression_time_ns",
+                        GET_TIME3(compression_rmc_hit, compression_fifo_hit,
+                                  compression_final_miss));
+    REC_TIME(compression_rmc_hit);
+    REC_TIME(compression_fifo_hit);
+    REC_TIME(compression_final_miss);
+
+    REC_COUNT(alloc);
+    REC_COUNT(free);
+    REC_COUNT(gc);
+    REC_COUNT(decompression);
+    REC_COUNT(compression_rmc_hit);
+    REC_COUNT(compression_fifo_hit);
+    REC_COUNT(compression_final_miss);
+    profile_record_end();
+    return;
+  }
+
   FILE *fp = fopen(PROF_TIME_FILENAME, "a");
 
   PRT_HEADER(fp);
@@ -124,41 +165,41 @@ void print_time_profile(void) {
 
 void __attr_always_inline___ profile_alloc_start(void) {
 #if defined(PROF_TIME__ALLOC)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   JERRY_CONTEXT(alloc_count)++;
   __check_watch(&JERRY_CONTEXT(timeval_alloc));
 #endif
 }
 void __attr_always_inline___ profile_alloc_end(void) {
 #if defined(PROF_TIME__ALLOC)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   __stop_watch(&JERRY_CONTEXT(timeval_alloc), &JERRY_CONTEXT(alloc_time));
 #endif
 }
 
 void __attr_always_inline___ profile_free_start(void) {
 #if defined(PROF_TIME__FREE)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   JERRY_CONTEXT(free_count)++;
   __check_watch(&JERRY_CONTEXT(timeval_free));
 #endif
 }
 void __attr_always_inline___ profile_free_end(void) {
 #if defined(PROF_TIME__FREE)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   __stop_watch(&JERRY_CONTEXT(timeval_free), &JERRY_CONTEXT(free_time));
 #endif
 }
 
 void __attr_always_inline___ profile_compression_start(void) {
 #if defined(PROF_TIME__COMPRESSION)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   __check_watch(&JERRY_CONTEXT(timeval_compression));
 #endif
 }
 inline void __attr_always_inline___ profile_compression_end(int type) {
 #if defined(PROF_TIME__COMPRESSION)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   if (type == 0) { // COMPRESSION_RMC_HIT
     JERRY_CONTEXT(compression_rmc_hit_count)++;
     __stop_watch(&JERRY_CONTEXT(timeval_compression),
@@ -181,14 +222,14 @@ inline void __attr_always_inline___ profile_compression_end(int type) {
 
 inline void __attr_always_inline___ profile_decompression_start(void) {
 #if defined(PROF_TIME__DECOMPRESSION)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   JERRY_CONTEXT(decompression_count)++;
   __check_watch(&JERRY_CONTEXT(timeval_decompression));
 #endif
 }
 inline void __attr_always_inline___ profile_decompression_end(void) {
 #if defined(PROF_TIME__DECOMPRESSION)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   __stop_watch(&JERRY_CONTEXT(timeval_decompression),
                &JERRY_CONTEXT(decompression_time));
 #endif
@@ -196,14 +237,14 @@ inline void __attr_always_inline___ profile_decompression_end(void) {
 
 inline void __attr_always_inline___ profile_gc_start(void) {
 #if defined(PROF_TIME__GC)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   JERRY_CONTEXT(gc_count)++;
   __check_watch(&JERRY_CONTEXT(timeval_gc));
 #endif
 }
 inline void __attr_always_inline___ profile_gc_end(void) {
 #if defined(PROF_TIME__GC)
-  CHECK_LOGGING_ENABLED();
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TIME);
   __stop_watch(&JERRY_CONTEXT(timeval_gc), &JERRY_CONTEXT(gc_time));
 #endif
 }
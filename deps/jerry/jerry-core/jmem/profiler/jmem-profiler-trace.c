@@ -0,0 +1,167 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "hashtable.h"
+#include "jcontext.h"
+#include "jmem-profiler-common-internal.h"
+#include "jmem-profiler.h"
+#include "jmem.h"
+
+#if defined(JMEM_PROFILE) && defined(PROF_TRACE)
+/* Allocation trace recording
+ * Every block allocated and freed through jmem_heap_alloc_block* and
+ * jmem_heap_free_block* is written to a compact binary trace, which
+ * jerry-replay runs against the heap allocator it is built with.
+ *
+ * The trace starts with a header of PROF_TRACE_HEADER_SIZE bytes:
+ *   "JMTR", version (1 byte), JMEM_ALIGNMENT (1 byte), 2 reserved bytes,
+ *   heap size (4 bytes, little endian), 4 reserved bytes
+ * Then each event is two unsigned LEB128 numbers: a tag, and the microseconds
+ * since the previous event. The low 2 bits of the tag are the type of the
+ * event, and the others its argument:
+ *   alloc(_small): the size in JMEM_ALIGNMENT units. A block is identified by
+ *                  the count of the allocations before it.
+ *   free(_small):  how many allocations ago the block was allocated, which is
+ *                  small for the short-lived blocks most frees are of.
+ * Failed allocations are not recorded.
+ */
+
+static FILE *trace_fp = NULL;
+static uint8_t trace_buffer[PROF_TRACE__BUFFER_SIZE];
+static size_t trace_buffer_pos = 0;
+static HashTable trace_blocks_ht; // key=<void *block> value=<uint32_t id>
+static uint32_t trace_next_id = 0;
+static struct timeval trace_last_time;
+
+static void __flush_trace(void) {
+  if (trace_buffer_pos > 0) {
+    fwrite(trace_buffer, 1, trace_buffer_pos, trace_fp);
+    trace_buffer_pos = 0;
+  }
+}
+
+static void __write_trace_uint(uint32_t value) {
+  // An unsigned LEB128 number is at most 5 bytes
+  if (trace_buffer_pos + 5 > PROF_TRACE__BUFFER_SIZE) {
+    __flush_trace();
+  }
+  do {
+    uint8_t byte = (uint8_t)(value & 0x7f);
+    value >>= 7;
+    trace_buffer[trace_buffer_pos++] = (uint8_t)(byte | (value ? 0x80 : 0));
+  } while (value != 0);
+}
+
+static void __write_trace_event(uint32_t type, uint32_t arg) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  long delta_usec = get_timeval_diff_usec(&trace_last_time, &now);
+  trace_last_time = now;
+
+  __write_trace_uint((arg << 2) | type);
+  __write_trace_uint(delta_usec > 0 ? (uint32_t)delta_usec : 0);
+}
+
+static void __write_trace_header(void) {
+  uint8_t header[PROF_TRACE_HEADER_SIZE];
+  uint32_t heap_size = (uint32_t)JMEM_HEAP_SIZE;
+
+  memset(header, 0, sizeof(header));
+  memcpy(header, PROF_TRACE_MAGIC, 4);
+  header[4] = PROF_TRACE_VERSION;
+  header[5] = JMEM_ALIGNMENT;
+  for (int i = 0; i < 4; i++) {
+    header[8 + i] = (uint8_t)(heap_size >> (8 * i));
+  }
+  fwrite(header, 1, sizeof(header), trace_fp);
+}
+#endif /* defined(JMEM_PROFILE) && defined(PROF_TRACE) */
+
+inline void __attr_always_inline___ init_trace_profiler(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_TRACE)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TRACE);
+  if (trace_fp != NULL) {
+    return;
+  }
+  trace_fp = fopen(PROF_TRACE_FILENAME, "wb");
+  if (trace_fp == NULL) {
+    return;
+  }
+  if (!ht_is_initialized(&trace_blocks_ht)) {
+    ht_setup(&trace_blocks_ht, sizeof(void *), sizeof(uint32_t), 1024);
+  }
+  ht_clear(&trace_blocks_ht);
+  trace_next_id = 0;
+  trace_buffer_pos = 0;
+  gettimeofday(&trace_last_time, NULL);
+  __write_trace_header();
+#endif
+}
+
+inline void __attr_always_inline___ profile_trace_on_alloc(void *block_p,
+                                                           size_t size,
+                                                           bool is_small) {
+#if defined(JMEM_PROFILE) && defined(PROF_TRACE)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TRACE);
+  if (trace_fp == NULL || block_p == NULL) {
+    return;
+  }
+  uint32_t id = trace_next_id++;
+  ht_insert(&trace_blocks_ht, &block_p, &id);
+
+  uint32_t units = (uint32_t)((size + JMEM_ALIGNMENT - 1) / JMEM_ALIGNMENT);
+  __write_trace_event(is_small ? PROF_TRACE_ALLOC_SMALL : PROF_TRACE_ALLOC,
+                      units);
+#else
+  JERRY_UNUSED(block_p);
+  JERRY_UNUSED(size);
+  JERRY_UNUSED(is_small);
+#endif
+}
+
+inline void __attr_always_inline___ profile_trace_on_free(void *block_p,
+                                                          bool is_small) {
+#if defined(JMEM_PROFILE) && defined(PROF_TRACE)
+  CHECK_PROFILE_ENABLED(PROF_CATEGORY_TRACE);
+  if (trace_fp == NULL || !ht_contains(&trace_blocks_ht, &block_p)) {
+    // Blocks allocated before the trace started are left out
+    return;
+  }
+  uint32_t id = HT_LOOKUP_AS(uint32_t, &trace_blocks_ht, &block_p);
+  ht_erase(&trace_blocks_ht, &block_p);
+
+  __write_trace_event(is_small ? PROF_TRACE_FREE_SMALL : PROF_TRACE_FREE,
+                      trace_next_id - id);
+#else
+  JERRY_UNUSED(block_p);
+  JERRY_UNUSED(is_small);
+#endif
+}
+
+inline void __attr_always_inline___ finalize_trace_profiler(void) {
+#if defined(JMEM_PROFILE) && defined(PROF_TRACE)
+  if (trace_fp == NULL) {
+    return;
+  }
+  __flush_trace();
+  fclose(trace_fp);
+  trace_fp = NULL;
+  ht_clear(&trace_blocks_ht);
+#endif
+}
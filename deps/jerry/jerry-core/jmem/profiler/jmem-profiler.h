@@ -25,9 +25,33 @@ extern void finalize_profilers(void);
 
 extern void set_extern_heap_size_ptr(size_t*);
 
+/* jmem-profiler-common.c: runtime selection of built-in profilers */
+#define PROF_CATEGORY_SIZE (1u << 0)
+#define PROF_CATEGORY_TIME (1u << 1)
+#define PROF_CATEGORY_PMU (1u << 2)
+#define PROF_CATEGORY_CPTL (1u << 3)
+#define PROF_CATEGORY_SEGMENT (1u << 4)
+#define PROF_CATEGORY_JSOBJECT (1u << 5)
+#define PROF_CATEGORY_COUNT (1u << 6)
+#define PROF_CATEGORY_SAMPLING (1u << 7)
+#define PROF_CATEGORY_OPCODE (1u << 8)
+#define PROF_CATEGORY_CPU (1u << 9)
+#define PROF_CATEGORY_TRACE (1u << 10)
+#define PROF_CATEGORY_ALL ((1u << 11) - 1)
+extern uint32_t get_built_in_profile_categories(void);
+extern uint32_t get_profile_categories(void);
+extern void set_profile_categories(uint32_t categories);
+
+/* jmem-profiler-record.c: structured output of all profilers */
+#define PROF_RECORD_FORMAT_JSON 0 // JSON lines
+#define PROF_RECORD_FORMAT_CSV 1  // timestamp, profiler, key, value rows
+extern bool set_profile_record_output(const char *path, int format);
+
 /* jmem-profiler-size.c: size profiling */
 extern void print_total_size_profile_on_alloc(void);
 extern void print_total_size_profile_finally(void);
+extern void print_no_gc_region_profile(size_t reserved_size, size_t used_size,
+                                       bool is_overrun);
 
 /* jmem-profiler-time.c: time profiling */
 extern void print_time_profile(void);
@@ -48,6 +72,8 @@ extern void profile_compression_cycles_start(void);
 extern void profile_compression_cycles_end(int type);
 extern void profile_decompression_cycles_start(void);
 extern void profile_decompression_cycles_end(void);
+extern void profile_gc_cycles_start(void);
+extern void profile_gc_cycles_end(void);
 
 /* jmem-profiler-segment.c: segment utilization profiling */
 extern void print_segment_utilization_profile_after_free(size_t jsobject_size);
@@ -68,6 +94,38 @@ extern void profile_inc_rmc_access_count(void);
 extern void profile_inc_rmc_miss_count(void);
 extern void print_cptl_access(uint32_t sidx, int type_depth);
 
+/* jmem-profiler-code.c: code sites (resource name and line) of byte code */
+extern void profile_code_set_resource(const uint8_t *name_p,
+                                      size_t name_length);
+extern void profile_code_register(const void *bytecode_p, uint32_t line);
+extern void profile_code_unregister(const void *bytecode_p);
+
+/* jmem-profiler-sampling.c: sampling heap profiling of JS call sites */
+extern void profile_sampling_on_alloc(size_t size);
+extern void print_sampling_profile(void);
+extern bool write_sampling_profile(const char *path);
+
+/* jmem-profiler-opcode.c: executed opcodes and opcode pairs per function */
+extern void profile_opcode_on_execute(const void *bytecode_p, uint32_t opcode);
+extern void print_opcode_profile(void);
+
+/* jmem-profiler-cpu.c: sampling CPU profiling of JS call stacks */
+extern void profile_cpu_tick(void);
+extern void profile_cpu_take_sample(void);
+extern void print_cpu_profile(void);
+extern bool write_cpu_profile(const char *path);
+
+/* jmem-profiler-trace.c: allocation trace for jerry-replay */
+#define PROF_TRACE_MAGIC "JMTR"
+#define PROF_TRACE_VERSION 1
+#define PROF_TRACE_HEADER_SIZE 16
+#define PROF_TRACE_ALLOC 0       // arg: size in JMEM_ALIGNMENT units
+#define PROF_TRACE_FREE 1        // arg: allocations since the block
+#define PROF_TRACE_ALLOC_SMALL 2 // jmem_heap_alloc_block_small_object
+#define PROF_TRACE_FREE_SMALL 3  // jmem_heap_free_block_small_object
+extern void profile_trace_on_alloc(void *block_p, size_t size, bool is_small);
+extern void profile_trace_on_free(void *block_p, bool is_small);
+
 /* jmem-profiler-count.c : Temporary count profiling for investigation */
 extern void print_count_profile(void);
 /** PROF_COUNT__COMPRESSION_CALLERS **/
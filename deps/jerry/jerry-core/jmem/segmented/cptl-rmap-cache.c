@@ -21,8 +21,137 @@
 #include "jmem-profiler.h"
 #include "jmem.h"
 
+#if defined(SEG_RMAP_CACHE) && defined(SEG_RMAP_CACHE_ADAPTIVE)
+/* Adaptive reverse map cache
+ * Geometry (size, set size) and replacement policy are configured at runtime
+ * within the capacity of SEG_RMAP_CACHE_SIZE entries.
+ * If adaptive sizing is enabled, the hit ratio is checked at every miss after
+ * an adaptation window, and the active size is doubled or halved.
+ */
+
+static inline bool __attr_always_inline___ is_power_of_2(uint32_t value) {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+static void reset_rmap_cache(uint32_t size, uint32_t set_size) {
+  JERRY_HEAP_CONTEXT(rmc_size) = size;
+  JERRY_HEAP_CONTEXT(rmc_set_size) = set_size;
+  JERRY_HEAP_CONTEXT(rmc_set_mask) = size / set_size - 1;
+  JERRY_HEAP_CONTEXT(rmc_index) = 0;
+  JERRY_HEAP_CONTEXT(rmc_stamp) = 0;
+  for (uint32_t i = 0; i < SEG_RMAP_CACHE_SIZE; i++) {
+    JERRY_HEAP_CONTEXT(rmc_table_base_addr[i]) = NULL;
+    JERRY_HEAP_CONTEXT(rmc_table_sidx[i]) = SEG_NUM_SEGMENTS;
+    JERRY_HEAP_CONTEXT(rmc_table_stamps[i]) = 0;
+    JERRY_HEAP_CONTEXT(rmc_table_eviction_headers[i]) = 0;
+  }
+  JERRY_HEAP_CONTEXT(rmc_window_access_count) = 0;
+  JERRY_HEAP_CONTEXT(rmc_window_miss_count) = 0;
+}
+
+bool configure_rmap_cache(uint32_t size, uint32_t set_size, uint32_t policy,
+                          bool is_adaptive) {
+  if (!is_power_of_2(size) || !is_power_of_2(set_size) || set_size > size ||
+      size > SEG_RMAP_CACHE_SIZE)
+    return false;
+  if (policy != SEG_RMAP_CACHE_POLICY_FIFO &&
+      policy != SEG_RMAP_CACHE_POLICY_LRU &&
+      policy != SEG_RMAP_CACHE_POLICY_CLOCK)
+    return false;
+
+  JERRY_HEAP_CONTEXT(rmc_policy) = policy;
+  JERRY_HEAP_CONTEXT(rmc_is_adaptive) = is_adaptive;
+  reset_rmap_cache(size, set_size);
+  return true;
+}
+
+void print_rmap_cache_config(void) {
+  static const char *policy_names[] = {"FIFO", "LRU", "CLOCK"};
+  printf(">>>>>> Size: %u, set size: %u, policy: %s, adaptive: %s\n",
+         (unsigned int)JERRY_HEAP_CONTEXT(rmc_size),
+         (unsigned int)JERRY_HEAP_CONTEXT(rmc_set_size),
+         policy_names[JERRY_HEAP_CONTEXT(rmc_policy)],
+         JERRY_HEAP_CONTEXT(rmc_is_adaptive) ? "yes" : "no");
+}
+
+static void adapt_rmap_cache(void) {
+  uint64_t accesses = JERRY_HEAP_CONTEXT(rmc_window_access_count);
+  uint64_t misses = JERRY_HEAP_CONTEXT(rmc_window_miss_count);
+  uint32_t hit_ratio = (uint32_t)(100 - misses * 100 / accesses);
+  uint32_t size = JERRY_HEAP_CONTEXT(rmc_size);
+  uint32_t set_size = JERRY_HEAP_CONTEXT(rmc_set_size);
+
+  JERRY_HEAP_CONTEXT(rmc_window_access_count) = 0;
+  JERRY_HEAP_CONTEXT(rmc_window_miss_count) = 0;
+
+  if (hit_ratio < SEG_RMAP_CACHE_ADAPT_GROW_RATIO &&
+      size * 2 <= SEG_RMAP_CACHE_SIZE) {
+    reset_rmap_cache(size * 2, set_size);
+  } else if (hit_ratio > SEG_RMAP_CACHE_ADAPT_SHRINK_RATIO &&
+             size / 2 >= SEG_RMAP_CACHE_MIN_SIZE && size / 2 >= set_size) {
+    reset_rmap_cache(size / 2, set_size);
+  }
+}
+
+static inline uint32_t __attr_always_inline___
+select_rmap_cache_victim(uint32_t index) {
+  uint32_t set_size = JERRY_HEAP_CONTEXT(rmc_set_size);
+  uint32_t i_from = index * set_size;
+  switch (JERRY_HEAP_CONTEXT(rmc_policy)) {
+  case SEG_RMAP_CACHE_POLICY_LRU: {
+    // Least recently used entry; invalid entries have the oldest age (0)
+    uint32_t victim = i_from;
+    for (uint32_t i = i_from + 1; i < i_from + set_size; i++) {
+      if (JERRY_HEAP_CONTEXT(rmc_table_stamps[i]) <
+          JERRY_HEAP_CONTEXT(rmc_table_stamps[victim]))
+        victim = i;
+    }
+    return victim;
+  }
+  case SEG_RMAP_CACHE_POLICY_CLOCK: {
+    // Second chance: skip and clear referenced entries
+    uint32_t hand = JERRY_HEAP_CONTEXT(rmc_table_eviction_headers[index]);
+    while (JERRY_HEAP_CONTEXT(rmc_table_stamps[i_from + hand]) != 0) {
+      JERRY_HEAP_CONTEXT(rmc_table_stamps[i_from + hand]) = 0;
+      hand = (hand + 1) & (set_size - 1);
+    }
+    JERRY_HEAP_CONTEXT(rmc_table_eviction_headers[index]) =
+        (hand + 1) & (set_size - 1);
+    return i_from + hand;
+  }
+  default: {
+    // FIFO
+    uint32_t hand = JERRY_HEAP_CONTEXT(rmc_table_eviction_headers[index]);
+    JERRY_HEAP_CONTEXT(rmc_table_eviction_headers[index]) =
+        (hand + 1) & (set_size - 1);
+    return i_from + hand;
+  }
+  }
+}
+
+static inline void __attr_always_inline___ touch_rmap_cache_entry(uint32_t i) {
+  if (JERRY_HEAP_CONTEXT(rmc_policy) == SEG_RMAP_CACHE_POLICY_LRU) {
+    JERRY_HEAP_CONTEXT(rmc_stamp)++;
+    if (unlikely(JERRY_HEAP_CONTEXT(rmc_stamp) == 0)) {
+      // Age counter wrapped around: forget the ages
+      for (uint32_t j = 0; j < SEG_RMAP_CACHE_SIZE; j++)
+        JERRY_HEAP_CONTEXT(rmc_table_stamps[j]) = 0;
+      JERRY_HEAP_CONTEXT(rmc_stamp) = 1;
+    }
+    JERRY_HEAP_CONTEXT(rmc_table_stamps[i]) = JERRY_HEAP_CONTEXT(rmc_stamp);
+  } else if (JERRY_HEAP_CONTEXT(rmc_policy) == SEG_RMAP_CACHE_POLICY_CLOCK) {
+    JERRY_HEAP_CONTEXT(rmc_table_stamps[i]) = 1;
+  }
+}
+#endif /* defined(SEG_RMAP_CACHE) && defined(SEG_RMAP_CACHE_ADAPTIVE) */
+
 void init_rmap_cache(void) {
-#ifdef SEG_RMAP_CACHE
+#if defined(SEG_RMAP_CACHE) && defined(SEG_RMAP_CACHE_ADAPTIVE)
+  // Initialize reverse map cache with the default configuration
+  JERRY_HEAP_CONTEXT(rmc_policy) = SEG_RMAP_CACHE_INIT_POLICY;
+  JERRY_HEAP_CONTEXT(rmc_is_adaptive) = true;
+  reset_rmap_cache(SEG_RMAP_CACHE_INIT_SIZE, SEG_RMAP_CACHE_INIT_SET_SIZE);
+#elif defined(SEG_RMAP_CACHE)
   // Initialize reverse map cache
 #if SEG_RMAP_CACHE_SIZE == 1
   // Case 1. Singleton cache
@@ -43,7 +172,26 @@ access_and_check_rmap_cache(uint8_t *addr) {
 // access_and_check_rmap_cache(uint8_t *addr, uint8_t **saddr_out) {
 // Access and check reverse map cache
 #ifdef SEG_RMAP_CACHE
-#if SEG_RMAP_CACHE_SIZE == 1
+#if defined(SEG_RMAP_CACHE_ADAPTIVE)
+  // Case 0. Runtime-configured cache
+  JERRY_HEAP_CONTEXT(rmc_window_access_count)++;
+  JERRY_HEAP_CONTEXT(rmc_index) = ((uint32_t)addr >> SEG_SEGMENT_SHIFT) &
+                                  JERRY_HEAP_CONTEXT(rmc_set_mask);
+  uint32_t index = JERRY_HEAP_CONTEXT(rmc_index);
+  uint32_t i_from = index * JERRY_HEAP_CONTEXT(rmc_set_size);
+  uint32_t i_to = i_from + JERRY_HEAP_CONTEXT(rmc_set_size);
+  for (uint32_t i = i_from; i < i_to; i++) {
+    uint8_t *cached_base_addr = JERRY_HEAP_CONTEXT(rmc_table_base_addr[i]);
+    uint32_t result = (uint32_t)addr - (uint32_t)cached_base_addr;
+    if (likely(result < (uint32_t)SEG_SEGMENT_SIZE)) {
+      JERRY_HEAP_CONTEXT(comp_i_offset) = result;
+      JERRY_HEAP_CONTEXT(comp_i_saddr) = cached_base_addr;
+      touch_rmap_cache_entry(i);
+      return JERRY_HEAP_CONTEXT(rmc_table_sidx[i]); // Cache hit
+    }
+  }
+  return SEG_NUM_SEGMENTS; // Cache miss
+#elif SEG_RMAP_CACHE_SIZE == 1
   // Case 1. Singleton cache
   uint8_t *cached_base_addr = JERRY_HEAP_CONTEXT(rmc_single_base_addr);
 
@@ -133,7 +281,25 @@ inline void __attr_always_inline___ update_rmap_cache(uint32_t sidx) {
 //                                                       uint32_t sidx) {
 // Update reverse map cache on slow path (miss)
 #ifdef SEG_RMAP_CACHE
-#if SEG_RMAP_CACHE_SIZE == 1
+#if defined(SEG_RMAP_CACHE_ADAPTIVE)
+  // Case 0. Runtime-configured cache
+  JERRY_HEAP_CONTEXT(rmc_window_miss_count)++;
+  if (JERRY_HEAP_CONTEXT(rmc_is_adaptive) &&
+      JERRY_HEAP_CONTEXT(rmc_window_access_count) >=
+          SEG_RMAP_CACHE_ADAPT_PERIOD) {
+    adapt_rmap_cache();
+    // The set index is changed if the cache is resized
+    JERRY_HEAP_CONTEXT(rmc_index) =
+        ((uint32_t)JERRY_HEAP_CONTEXT(comp_i_saddr) >> SEG_SEGMENT_SHIFT) &
+        JERRY_HEAP_CONTEXT(rmc_set_mask);
+  }
+
+  uint32_t victim = select_rmap_cache_victim(JERRY_HEAP_CONTEXT(rmc_index));
+  JERRY_HEAP_CONTEXT(rmc_table_base_addr[victim]) =
+      JERRY_HEAP_CONTEXT(comp_i_saddr);
+  JERRY_HEAP_CONTEXT(rmc_table_sidx[victim]) = sidx;
+  touch_rmap_cache_entry(victim);
+#elif SEG_RMAP_CACHE_SIZE == 1
   // Case 1. Singleton cache
   JERRY_HEAP_CONTEXT(rmc_single_base_addr) = JERRY_HEAP_CONTEXT(comp_i_saddr);
   // JERRY_HEAP_CONTEXT(rmc_single_base_addr) = saddr;
@@ -181,7 +347,16 @@ inline void __attr_always_inline___ update_rmap_cache(uint32_t sidx) {
 inline void __attr_always_inline___ invalidate_rmap_cache_entry(uint32_t sidx) {
 // Access, check and invalidate reverse map cache
 #ifdef SEG_RMAP_CACHE
-#if SEG_RMAP_CACHE_SIZE == 1
+#if defined(SEG_RMAP_CACHE_ADAPTIVE)
+  // Case 0. Runtime-configured cache
+  for (uint32_t i = 0; i < JERRY_HEAP_CONTEXT(rmc_size); i++) {
+    if (JERRY_HEAP_CONTEXT(rmc_table_sidx[i]) == sidx) {
+      JERRY_HEAP_CONTEXT(rmc_table_base_addr[i]) = NULL;
+      JERRY_HEAP_CONTEXT(rmc_table_sidx[i]) = SEG_NUM_SEGMENTS;
+      JERRY_HEAP_CONTEXT(rmc_table_stamps[i]) = 0;
+    }
+  }
+#elif SEG_RMAP_CACHE_SIZE == 1
   // Case 1. Singleton cache
   if (JERRY_HEAP_CONTEXT(rmc_single_sidx) == sidx) {
     JERRY_HEAP_CONTEXT(rmc_single_base_addr) = 0;
@@ -198,6 +373,5 @@ inline void __attr_always_inline___ invalidate_rmap_cache_entry(uint32_t sidx) {
 #endif /* SEG_RMAP_CACHE_SIZE != 1 */
 #else  /* defined(SEG_RMAP_CACHE) */
   JERRY_UNUSED(sidx);
-  return NULL;
 #endif /* !defined(SEG_RMAP_CACHE) */
 }
\ No newline at end of file
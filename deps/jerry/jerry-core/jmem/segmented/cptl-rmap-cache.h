@@ -16,6 +16,7 @@
 #ifndef CPTL_RMAP_CACHE_H
 #define CPTL_RMAP_CACHE_H
 
+#include "jmem-config.h"
 #include "jrt.h"
 
 extern void init_rmap_cache(void);
@@ -25,4 +26,13 @@ extern void update_rmap_cache(uint32_t sidx);
 // extern void update_rmap_cache(uint8_t *saddr, uint32_t sidx);
 extern void invalidate_rmap_cache_entry(uint32_t sidx);
 
+#if defined(SEG_RMAP_CACHE) && defined(SEG_RMAP_CACHE_ADAPTIVE)
+// Change geometry and replacement policy of reverse map cache at runtime
+// * size and set_size should be powers of 2 (set_size <= size <= capacity)
+// * false if the configuration is invalid
+extern bool configure_rmap_cache(uint32_t size, uint32_t set_size,
+                                 uint32_t policy, bool is_adaptive);
+extern void print_rmap_cache_config(void);
+#endif /* defined(SEG_RMAP_CACHE) && defined(SEG_RMAP_CACHE_ADAPTIVE) */
+
 #endif /* !defined(CPTL_RMAP_CACHE_H) */
\ No newline at end of file
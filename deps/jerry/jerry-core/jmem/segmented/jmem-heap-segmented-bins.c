@@ -0,0 +1,131 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jmem-heap-segmented-bins.h"
+
+#include "jcontext.h"
+#include "jmem-config.h"
+#include "jmem-heap-segmented-cptl.h"
+#include "jmem.h"
+
+#if defined(JMEM_SEGMENTED_HEAP) && defined(SEG_SIZE_CLASS_BINS)
+/* Size-class bins
+ * A freed small block is pushed to the LIFO bin of its segment and size class
+ * instead of being merged into the address-ordered free region list.
+ * Like the chunks of the pool manager, binned blocks remain accounted as
+ * allocated in the heap; they are returned to the free region list by
+ * jmem_heap_flush_size_class_bins() before empty segment groups are freed.
+ */
+
+static inline uint32_t __attr_always_inline___
+get_size_class(size_t size) {
+  return (uint32_t)(size / JMEM_ALIGNMENT) - 1;
+}
+
+static inline void __attr_always_inline___
+set_bin_bitmap(uint32_t size_class, uint32_t sidx) {
+  JERRY_HEAP_CONTEXT(bin_bitmaps[size_class][sidx / 32]) |=
+      (uint32_t)1 << (sidx % 32);
+}
+
+static inline void __attr_always_inline___
+clear_bin_bitmap(uint32_t size_class, uint32_t sidx) {
+  JERRY_HEAP_CONTEXT(bin_bitmaps[size_class][sidx / 32]) &=
+      ~((uint32_t)1 << (sidx % 32));
+}
+
+void init_size_class_bins(void) {
+  for (uint32_t size_class = 0; size_class < SEG_NUM_SIZE_CLASSES;
+       size_class++) {
+    for (uint32_t word = 0; word < SEG_BIN_BITMAP_WORDS; word++) {
+      JERRY_HEAP_CONTEXT(bin_bitmaps[size_class][word]) = 0;
+    }
+  }
+  for (uint32_t sidx = 0; sidx < SEG_NUM_SEGMENTS; sidx++) {
+    init_segment_bins(&JERRY_HEAP_CONTEXT(segments[sidx]));
+  }
+}
+
+inline void __attr_always_inline___
+init_segment_bins(jmem_segment_t *segment_header) {
+  segment_header->binned_size = 0;
+  for (uint32_t size_class = 0; size_class < SEG_NUM_SIZE_CLASSES;
+       size_class++) {
+    segment_header->bin_heads[size_class] = SEG_BIN_EMPTY;
+  }
+}
+
+inline void *__attribute__((hot)) alloc_a_block_from_bins(size_t size) {
+  JERRY_ASSERT(size > 0 && size <= SEG_SIZE_CLASS_MAX_SIZE);
+  JERRY_ASSERT(size % JMEM_ALIGNMENT == 0);
+  uint32_t size_class = get_size_class(size);
+
+  // Find a segment having a non-empty bin of the size class
+  for (uint32_t word = 0; word < SEG_BIN_BITMAP_WORDS; word++) {
+    uint32_t bitmap = JERRY_HEAP_CONTEXT(bin_bitmaps[size_class][word]);
+    if (likely(bitmap == 0))
+      continue;
+
+    uint32_t sidx = word * 32 + (uint32_t)__builtin_ctz(bitmap);
+    jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[sidx]);
+    uint16_t block_offset = segment_header->bin_heads[size_class];
+    JERRY_ASSERT(block_offset != SEG_BIN_EMPTY);
+
+    // Pop the head block of the bin
+    jmem_heap_free_t *block_p =
+        (jmem_heap_free_t *)(sidx_to_addr(sidx) + block_offset);
+    segment_header->bin_heads[size_class] = (uint16_t)block_p->next_offset;
+    segment_header->binned_size -= (uint32_t)size;
+    if (segment_header->bin_heads[size_class] == SEG_BIN_EMPTY) {
+      clear_bin_bitmap(size_class, sidx);
+    }
+    return (void *)block_p;
+  }
+  return NULL;
+}
+
+inline bool __attribute__((hot))
+free_a_block_to_bins(void *block_address, size_t size) {
+  size_t aligned_size =
+      (size + JMEM_ALIGNMENT - 1) / JMEM_ALIGNMENT * JMEM_ALIGNMENT;
+  if (aligned_size > SEG_SIZE_CLASS_MAX_SIZE)
+    return false;
+
+  jmem_heap_free_t *block_p = (jmem_heap_free_t *)block_address;
+  uint32_t block_cp = JMEM_COMPRESS_POINTER_INTERNAL(block_p);
+  uint32_t sidx = block_cp >> SEG_SEGMENT_SHIFT;
+  uint32_t block_offset = block_cp & (SEG_SEGMENT_SIZE - 1);
+
+  // A block crossing the boundary of segments is not binnable
+  if (block_offset + aligned_size > SEG_SEGMENT_SIZE)
+    return false;
+
+#ifdef SEG_SEGMENT_EVACUATION
+  // A block in segments being evacuated should return to free region list
+  if (JERRY_HEAP_CONTEXT(segments[sidx]).is_evacuating)
+    return false;
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
+
+  // Push the block to the bin
+  uint32_t size_class = get_size_class(aligned_size);
+  jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[sidx]);
+  block_p->size = (uint32_t)aligned_size;
+  block_p->next_offset = segment_header->bin_heads[size_class];
+  segment_header->bin_heads[size_class] = (uint16_t)block_offset;
+  segment_header->binned_size += (uint32_t)aligned_size;
+  set_bin_bitmap(size_class, sidx);
+  return true;
+}
+#endif /* defined(JMEM_SEGMENTED_HEAP) && defined(SEG_SIZE_CLASS_BINS) */
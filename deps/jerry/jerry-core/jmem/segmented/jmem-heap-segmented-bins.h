@@ -0,0 +1,39 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JMEM_HEAP_SEGMENTED_BINS_H
+#define JMEM_HEAP_SEGMENTED_BINS_H
+
+#include "jmem-config.h"
+#include "jmem.h"
+#include "jrt.h"
+
+#if defined(JMEM_SEGMENTED_HEAP) && defined(SEG_SIZE_CLASS_BINS)
+// Initialize size-class bins of all segments
+extern void init_size_class_bins(void);
+
+// Initialize size-class bins of a newly allocated segment
+extern void init_segment_bins(jmem_segment_t *segment_header);
+
+// Pop a free block from the bins of its size class
+// * NULL if all the bins of the size class are empty
+extern void *alloc_a_block_from_bins(size_t size);
+
+// Push a free block to the bin of its segment and size class
+// * false if the block is not binnable (too large or crossing segments)
+extern bool free_a_block_to_bins(void *block_address, size_t size);
+#endif /* defined(JMEM_SEGMENTED_HEAP) && defined(SEG_SIZE_CLASS_BINS) */
+
+#endif /* !defined(JMEM_HEAP_SEGMENTED_BINS_H) */
@@ -17,6 +17,7 @@
 
 #include "jcontext.h"
 #include "jmem-config.h"
+#include "jmem-heap-segmented-rmap-radix.h"
 #include "jmem-heap-segmented-rmap-rb.h"
 #include "jmem-profiler.h"
 #include "jmem.h"
@@ -36,6 +37,9 @@ void init_cptl(void) {
 #ifdef SEG_RMAP_BINSEARCH
   JERRY_HEAP_CONTEXT(segment_rmap_rb_root).rb_node = NULL;
 #endif /* SEG_RMAP_BINSEARCH */
+#ifdef SEG_RMAP_RADIX_TABLE
+  init_segment_rmap_radix();
+#endif /* SEG_RMAP_RADIX_TABLE */
 
   // Initialize FIFO cache
 #ifdef SEG_RMAP_2LEVEL_SEARCH
@@ -247,7 +251,10 @@ inline uint32_t __attribute__((hot)) addr_to_saddr_and_sidx(uint8_t *addr) {
     defined(PROF_PMU__COMPRESSION_CYCLES_DETAILED)
   JERRY_CONTEXT(recent_compression_type) = 2; // COMPRESSION_FINAL_MISS
 #endif
-#if defined(SEG_RMAP_BINSEARCH)
+#if defined(SEG_RMAP_RADIX_TABLE)
+  // Radix table lookup
+  sidx = segment_rmap_radix_lookup(addr);
+#elif defined(SEG_RMAP_BINSEARCH)
   // Binary search
   sidx = binary_search(addr);
 #elif defined(SEG_RMAP_2LEVEL_SEARCH) /* defined(SEG_RMAP_BINSEARCH) */
@@ -0,0 +1,140 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jmem-heap-segmented-regions.h"
+
+#include "jcontext.h"
+#include "jmem.h"
+
+#ifdef JMEM_SEGMENTED_HEAP
+#ifdef SEG_MEMORY_REGIONS
+/* Memory regions
+ * Boards with fast memory next to the main RAM, such as the CCM of STM32F4,
+ * give its free parts in SEG_MEMORY_REGION_TABLE of jerry-board-config.h.
+ * Segment groups are placed in the first region with room for them, and in
+ * the system heap otherwise. With SEG_MEMORY_REGION_HOT_SEGMENTS, only the
+ * initial segment and the listed ones, the most accessed in a CPTL access
+ * profile of the application, are placed in the regions. The segment base
+ * table maps each segment index to its area wherever it is, so sidx_to_addr()
+ * is not changed.
+ */
+
+typedef struct {
+  uint8_t *base;
+  size_t size;
+} seg_memory_region_t;
+
+static const seg_memory_region_t memory_regions[] = SEG_MEMORY_REGION_TABLE;
+
+#define MEMORY_REGIONS_COUNT \
+  (sizeof(memory_regions) / sizeof(memory_regions[0]))
+
+JERRY_STATIC_ASSERT(MEMORY_REGIONS_COUNT <= SEG_MEMORY_REGION_MAX_COUNT,
+                    memory_regions_must_fit_in_heap_context);
+
+#ifdef SEG_MEMORY_REGION_HOT_SEGMENTS
+static const uint32_t hot_segments[] = SEG_MEMORY_REGION_HOT_SEGMENTS;
+
+#define HOT_SEGMENTS_COUNT (sizeof(hot_segments) / sizeof(hot_segments[0]))
+#endif /* defined(SEG_MEMORY_REGION_HOT_SEGMENTS) */
+
+// Slots are aligned to the segment size, as the radix table requires
+static uint8_t *get_first_slot(const seg_memory_region_t *region) {
+  uintptr_t base = (uintptr_t)region->base;
+  uintptr_t mask = (uintptr_t)SEG_SEGMENT_SIZE - 1;
+  return (uint8_t *)((base + mask) & ~mask);
+}
+
+static uint32_t get_slots_count(const seg_memory_region_t *region) {
+  uint8_t *first_slot = get_first_slot(region);
+  uint8_t *end = region->base + region->size;
+  if (end <= first_slot)
+    return 0;
+  size_t slots_count = (size_t)(end - first_slot) / SEG_SEGMENT_SIZE;
+  if (slots_count > SEG_MEMORY_REGION_MAX_SLOTS)
+    return SEG_MEMORY_REGION_MAX_SLOTS;
+  return (uint32_t)slots_count;
+}
+
+static uint32_t get_slots_mask(uint32_t first_slot, uint32_t num_segments) {
+  uint32_t mask = num_segments >= 32 ? 0xffffffffu : (1u << num_segments) - 1;
+  return mask << first_slot;
+}
+
+static bool is_placed_in_regions(uint32_t start_sidx, uint32_t num_segments) {
+#ifdef SEG_MEMORY_REGION_HOT_SEGMENTS
+  // Initial segment holds the builtins and the global object
+  if (start_sidx == 0)
+    return true;
+  for (uint32_t i = 0; i < HOT_SEGMENTS_COUNT; i++) {
+    if (hot_segments[i] >= start_sidx &&
+        hot_segments[i] < start_sidx + num_segments)
+      return true;
+  }
+  return false;
+#else  /* defined(SEG_MEMORY_REGION_HOT_SEGMENTS) */
+  JERRY_UNUSED(start_sidx);
+  JERRY_UNUSED(num_segments);
+  return true;
+#endif /* !defined(SEG_MEMORY_REGION_HOT_SEGMENTS) */
+}
+
+void init_memory_regions(void) {
+  for (uint32_t i = 0; i < SEG_MEMORY_REGION_MAX_COUNT; i++) {
+    JERRY_HEAP_CONTEXT(region_used_slots[i]) = 0;
+  }
+}
+
+uint8_t *alloc_region_segment_group_area(uint32_t start_sidx,
+                                         uint32_t num_segments) {
+  if (!is_placed_in_regions(start_sidx, num_segments))
+    return NULL;
+
+  for (uint32_t i = 0; i < MEMORY_REGIONS_COUNT; i++) {
+    const seg_memory_region_t *region = &memory_regions[i];
+    uint32_t slots_count = get_slots_count(region);
+    uint32_t used_slots = JERRY_HEAP_CONTEXT(region_used_slots[i]);
+
+    // First fit of the consecutive slots of the group
+    for (uint32_t slot = 0; slot + num_segments <= slots_count; slot++) {
+      uint32_t mask = get_slots_mask(slot, num_segments);
+      if ((used_slots & mask) == 0) {
+        JERRY_HEAP_CONTEXT(region_used_slots[i]) = used_slots | mask;
+        return get_first_slot(region) + SEG_SEGMENT_SIZE * slot;
+      }
+    }
+  }
+  return NULL;
+}
+
+bool free_region_segment_group_area(uint8_t *area, uint32_t num_segments) {
+  for (uint32_t i = 0; i < MEMORY_REGIONS_COUNT; i++) {
+    const seg_memory_region_t *region = &memory_regions[i];
+    uint8_t *first_slot = get_first_slot(region);
+    if (area < first_slot ||
+        area >= first_slot + SEG_SEGMENT_SIZE * get_slots_count(region))
+      continue;
+
+    uint32_t slot = (uint32_t)((size_t)(area - first_slot) / SEG_SEGMENT_SIZE);
+    uint32_t mask = get_slots_mask(slot, num_segments);
+    JERRY_ASSERT((JERRY_HEAP_CONTEXT(region_used_slots[i]) & mask) == mask);
+    JERRY_HEAP_CONTEXT(region_used_slots[i]) &= ~mask;
+    return true;
+  }
+  return false;
+}
+
+#endif /* SEG_MEMORY_REGIONS */
+#endif /* JMEM_SEGMENTED_HEAP */
@@ -0,0 +1,38 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JMEM_HEAP_SEGMENTED_REGIONS_H
+#define JMEM_HEAP_SEGMENTED_REGIONS_H
+
+#include "jmem-config.h"
+#include "jrt.h"
+
+#ifdef JMEM_SEGMENTED_HEAP
+#ifdef SEG_MEMORY_REGIONS
+
+extern void init_memory_regions(void);
+
+// Area of a segment group in a memory region, or NULL if the group is not
+// placed in one
+extern uint8_t *alloc_region_segment_group_area(uint32_t start_sidx,
+                                                uint32_t num_segments);
+// Returns false if the area is not in a memory region
+extern bool free_region_segment_group_area(uint8_t *area,
+                                           uint32_t num_segments);
+
+#endif /* SEG_MEMORY_REGIONS */
+#endif /* JMEM_SEGMENTED_HEAP */
+
+#endif /* !defined(JMEM_HEAP_SEGMENTED_REGIONS_H) */
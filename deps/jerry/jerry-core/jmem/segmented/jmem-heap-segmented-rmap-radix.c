@@ -0,0 +1,129 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// posix_memalign() is not declared in strict C99
+#define _POSIX_C_SOURCE 200112L
+
+#include "jmem-heap-segmented-rmap-radix.h"
+
+#include "jcontext.h"
+#include "jmem.h"
+
+#include <stdlib.h>
+#define MALLOC(size) ((void *)malloc(size))
+#define FREE(ptr) (free((void *)ptr))
+
+#ifdef JMEM_SEGMENTED_HEAP
+#ifdef SEG_RMAP_RADIX_TABLE
+/* Radix table (page-table style reverse map)
+ * Segment groups are aligned to the segment size, so the upper bits of an
+ * address (addr >> SEG_SEGMENT_SHIFT) identify its segment. They are split
+ * into 1st-level and 2nd-level indexes; 2nd-level tables are allocated on
+ * demand and freed when their last segment is removed.
+ */
+
+JERRY_STATIC_ASSERT(SEG_MAX_NUM_SEGMENTS < SEG_RMAP_RADIX_EMPTY,
+                    segment_index_must_fit_in_radix_entry);
+
+#define L1_INDEX(page) ((page) >> SEG_RMAP_RADIX_L2_BITS)
+#define L2_INDEX(page) ((page) & (SEG_RMAP_RADIX_L2_SIZE - 1))
+#define L2_TABLE_SIZE (SEG_RMAP_RADIX_L2_SIZE * sizeof(uint16_t))
+
+static inline uint32_t __attr_always_inline___ addr_to_page(uint8_t *addr) {
+  return (uint32_t)(uintptr_t)addr >> SEG_SEGMENT_SHIFT;
+}
+
+void *alloc_aligned_segment_group_area(size_t size) {
+  void *area;
+  if (posix_memalign(&area, SEG_SEGMENT_SIZE, size) != 0)
+    return NULL;
+  return area;
+}
+
+void init_segment_rmap_radix(void) {
+  for (uint32_t i = 0; i < SEG_RMAP_RADIX_L1_SIZE; i++) {
+    JERRY_HEAP_CONTEXT(radix_l1[i]) = NULL;
+    JERRY_HEAP_CONTEXT(radix_l2_counts[i]) = 0;
+  }
+}
+
+inline uint32_t __attribute__((hot)) segment_rmap_radix_lookup(uint8_t *addr) {
+  uint32_t page = addr_to_page(addr);
+  uint16_t *l2_table = JERRY_HEAP_CONTEXT(radix_l1[L1_INDEX(page)]);
+  INCREASE_LOOKUP_DEPTH();
+  if (unlikely(l2_table == NULL))
+    return SEG_NUM_SEGMENTS;
+
+  uint32_t sidx = l2_table[L2_INDEX(page)];
+  if (unlikely(sidx == SEG_RMAP_RADIX_EMPTY))
+    return SEG_NUM_SEGMENTS;
+
+  uint8_t *saddr = JERRY_HEAP_CONTEXT(area[sidx]);
+  JERRY_ASSERT(saddr == (uint8_t *)((uintptr_t)addr &
+                                    ~(uintptr_t)(SEG_SEGMENT_SIZE - 1)));
+  JERRY_HEAP_CONTEXT(comp_i_offset) = (uint32_t)(addr - saddr);
+  JERRY_HEAP_CONTEXT(comp_i_saddr) = saddr;
+  return sidx;
+}
+
+bool segment_rmap_radix_insert(uint8_t *segment_area, uint32_t sidx) {
+  JERRY_ASSERT(((uintptr_t)segment_area & (SEG_SEGMENT_SIZE - 1)) == 0);
+  uint32_t page = addr_to_page(segment_area);
+  uint32_t l1_index = L1_INDEX(page);
+  uint16_t *l2_table = JERRY_HEAP_CONTEXT(radix_l1[l1_index]);
+
+  if (l2_table == NULL) {
+    // Allocate a new 2nd-level table
+    l2_table = (uint16_t *)MALLOC(L2_TABLE_SIZE);
+    if (l2_table == NULL)
+      return false;
+    for (uint32_t i = 0; i < SEG_RMAP_RADIX_L2_SIZE; i++) {
+      l2_table[i] = SEG_RMAP_RADIX_EMPTY;
+    }
+    JERRY_HEAP_CONTEXT(radix_l1[l1_index]) = l2_table;
+
+    // Update segment allocator metadata size, system allocator
+    JERRY_CONTEXT(jmem_segment_allocator_metadata_size) += L2_TABLE_SIZE;
+    JERRY_CONTEXT(jmem_system_allocator_metadata_size) +=
+        SYSTEM_ALLOCATOR_METADATA_SIZE;
+  }
+
+  JERRY_ASSERT(l2_table[L2_INDEX(page)] == SEG_RMAP_RADIX_EMPTY);
+  l2_table[L2_INDEX(page)] = (uint16_t)sidx;
+  JERRY_HEAP_CONTEXT(radix_l2_counts[l1_index])++;
+  return true;
+}
+
+void segment_rmap_radix_remove(uint8_t *segment_area) {
+  uint32_t page = addr_to_page(segment_area);
+  uint32_t l1_index = L1_INDEX(page);
+  uint16_t *l2_table = JERRY_HEAP_CONTEXT(radix_l1[l1_index]);
+  JERRY_ASSERT(l2_table != NULL);
+  JERRY_ASSERT(l2_table[L2_INDEX(page)] != SEG_RMAP_RADIX_EMPTY);
+
+  l2_table[L2_INDEX(page)] = SEG_RMAP_RADIX_EMPTY;
+  if (--JERRY_HEAP_CONTEXT(radix_l2_counts[l1_index]) == 0) {
+    // Free the empty 2nd-level table
+    FREE(l2_table);
+    JERRY_HEAP_CONTEXT(radix_l1[l1_index]) = NULL;
+
+    // Update segment allocator metadata size, system allocator
+    JERRY_CONTEXT(jmem_segment_allocator_metadata_size) -= L2_TABLE_SIZE;
+    JERRY_CONTEXT(jmem_system_allocator_metadata_size) -=
+        SYSTEM_ALLOCATOR_METADATA_SIZE;
+  }
+}
+#endif /* SEG_RMAP_RADIX_TABLE */
+#endif /* JMEM_SEGMENTED_HEAP */
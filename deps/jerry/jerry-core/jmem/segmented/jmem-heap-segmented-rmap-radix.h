@@ -0,0 +1,36 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JMEM_HEAP_SEGMENTED_RADIX_H
+#define JMEM_HEAP_SEGMENTED_RADIX_H
+
+#include "jmem-config.h"
+#include "jrt.h"
+
+#ifdef JMEM_SEGMENTED_HEAP
+#ifdef SEG_RMAP_RADIX_TABLE
+
+// Allocate a segment group area aligned to the segment size
+extern void *alloc_aligned_segment_group_area(size_t size);
+
+extern void init_segment_rmap_radix(void);
+extern uint32_t segment_rmap_radix_lookup(uint8_t *addr);
+extern bool segment_rmap_radix_insert(uint8_t *segment_area, uint32_t sidx);
+extern void segment_rmap_radix_remove(uint8_t *segment_area);
+
+#endif /* SEG_RMAP_RADIX_TABLE */
+#endif /* JMEM_SEGMENTED_HEAP */
+
+#endif /* !defined(JMEM_HEAP_SEGMENTED_RADIX_H) */
@@ -16,6 +16,7 @@
 #include "jcontext.h"
 #include "jmem.h"
 #include "jrt.h"
+#include "jrt-probes.h"
 
 #include <stdlib.h>
 #define MALLOC(size) ((void *)malloc(size))
@@ -24,7 +25,11 @@
 #include "jmem-heap-segmented.h"
 
 #include "cptl-rmap-cache.h"
+#include "jmem-heap-free-index.h"
+#include "jmem-heap-segmented-bins.h"
 #include "jmem-heap-segmented-cptl.h"
+#include "jmem-heap-segmented-regions.h"
+#include "jmem-heap-segmented-rmap-radix.h"
 #include "jmem-heap-segmented-rmap-rb.h"
 
 #ifdef JMEM_SEGMENTED_HEAP
@@ -33,17 +38,68 @@
 static void *alloc_a_segment_group_internal(size_t required_size,
                                             uint32_t *start_sidx_out);
 
+#ifdef SEG_RUNTIME_SEGMENT_SIZE
+// Segment size requested before jerry_init()
+static uint32_t requested_segment_shift = SEG_DEFAULT_SEGMENT_SHIFT;
+#endif /* defined(SEG_RUNTIME_SEGMENT_SIZE) */
+
 /* External functions */
+#ifdef SEG_RUNTIME_SEGMENT_SIZE
+bool set_segment_size(uint32_t segment_size) {
+  if (segment_size == 0 || (segment_size & (segment_size - 1)) != 0 ||
+      segment_size > JMEM_HEAP_SIZE)
+    return false;
+
+  uint32_t segment_shift = (uint32_t)__builtin_ctz(segment_size);
+  if (segment_shift < SEG_MIN_SEGMENT_SHIFT ||
+      segment_shift > SEG_MAX_SEGMENT_SHIFT)
+    return false;
+
+  requested_segment_shift = segment_shift;
+  return true;
+}
+
+void init_segment_size(void) {
+  JERRY_HEAP_CONTEXT(segment_shift) = requested_segment_shift;
+}
+#endif /* defined(SEG_RUNTIME_SEGMENT_SIZE) */
+
 void init_segmented_heap(void) {
   // Initialize segment headers
   for (uint32_t sidx = 0; sidx < SEG_NUM_SEGMENTS; sidx++) {
     JERRY_HEAP_CONTEXT(segments[sidx]).occupied_size = 0;
     JERRY_HEAP_CONTEXT(segments[sidx]).group_num_segments = 0;
+#ifdef SEG_SEGMENT_EVACUATION
+    JERRY_HEAP_CONTEXT(segments[sidx]).is_evacuating = false;
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
+#ifdef SEG_SEGMENT_RETENTION
+    JERRY_HEAP_CONTEXT(segments[sidx]).empty_epoch = 0;
+#endif /* defined(SEG_SEGMENT_RETENTION) */
   }
+#ifdef SEG_SEGMENT_EVACUATION
+  JERRY_HEAP_CONTEXT(evacuating_segments_count) = 0;
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
+#ifdef SEG_SEGMENT_RETENTION
+  JERRY_HEAP_CONTEXT(retention_epoch) = 0;
+  JERRY_HEAP_CONTEXT(retention_low) = SEG_SEGMENT_RETENTION_LOW;
+  JERRY_HEAP_CONTEXT(retention_high) = SEG_SEGMENT_RETENTION_HIGH;
+  JERRY_HEAP_CONTEXT(retention_age) = SEG_SEGMENT_RETENTION_AGE;
+  JERRY_HEAP_CONTEXT(retained_segments_count) = 0;
+#endif /* defined(SEG_SEGMENT_RETENTION) */
 
   // Initialize compressed pointer translation layer (CPTL)
   init_cptl();
 
+#ifdef SEG_MEMORY_REGIONS
+  // Initialize fast memory regions
+  init_memory_regions();
+#endif /* defined(SEG_MEMORY_REGIONS) */
+
+#ifdef SEG_SIZE_CLASS_BINS
+  // Initialize size-class bins
+  init_size_class_bins();
+#endif /* defined(SEG_SIZE_CLASS_BINS) */
+
   // Initialize first segment
   uint32_t start_sidx;
   alloc_a_segment_group_internal(JMEM_ALIGNMENT, &start_sidx);
@@ -74,11 +130,39 @@ static uint32_t get_required_num_segments(size_t required_size) {
          SEG_SEGMENT_SIZE;
 }
 
+static uint8_t *alloc_segment_group_area(uint32_t start_sidx,
+                                         uint32_t num_segments) {
+#ifdef SEG_MEMORY_REGIONS
+  uint8_t *region_area =
+      alloc_region_segment_group_area(start_sidx, num_segments);
+  if (region_area != NULL)
+    return region_area;
+#else  /* defined(SEG_MEMORY_REGIONS) */
+  JERRY_UNUSED(start_sidx);
+#endif /* !defined(SEG_MEMORY_REGIONS) */
+
+  size_t segment_group_size = SEG_SEGMENT_SIZE * num_segments;
+#ifdef SEG_RMAP_RADIX_TABLE
+  return alloc_aligned_segment_group_area(segment_group_size);
+#else  /* defined(SEG_RMAP_RADIX_TABLE) */
+  return MALLOC(segment_group_size);
+#endif /* !defined(SEG_RMAP_RADIX_TABLE) */
+}
+
+static void free_segment_group_area(void *area, uint32_t num_segments) {
+#ifdef SEG_MEMORY_REGIONS
+  if (free_region_segment_group_area((uint8_t *)area, num_segments))
+    return;
+#else  /* defined(SEG_MEMORY_REGIONS) */
+  JERRY_UNUSED(num_segments);
+#endif /* !defined(SEG_MEMORY_REGIONS) */
+  FREE(area);
+}
+
 static void *alloc_a_segment_group_internal(size_t required_size,
                                             uint32_t *start_sidx_out) {
   // Calculate required number of segments
   uint32_t required_num_segments = get_required_num_segments(required_size);
-  uint32_t segment_group_size = SEG_SEGMENT_SIZE * required_num_segments;
 
   // Check number of segments
   if (JERRY_HEAP_CONTEXT(segments_count) + required_num_segments >
@@ -91,10 +175,27 @@ static void *alloc_a_segment_group_internal(size_t required_size,
     return NULL;
 
   // Allocate segment group
-  uint8_t *segment_group_area = MALLOC(segment_group_size);
+  uint8_t *segment_group_area =
+      alloc_segment_group_area(start_sidx, required_num_segments);
   if (segment_group_area == NULL)
     return NULL;
 
+#ifdef SEG_RMAP_RADIX_TABLE
+  // Update segment reverse map radix table
+  for (uint32_t seg_no = 0; seg_no < required_num_segments; seg_no++) {
+    uint8_t *segment_area = segment_group_area + (SEG_SEGMENT_SIZE * seg_no);
+    if (!segment_rmap_radix_insert(segment_area, start_sidx + seg_no)) {
+      // Roll back on failure of 2nd-level table allocation
+      while (seg_no-- > 0) {
+        segment_rmap_radix_remove(segment_group_area +
+                                  (SEG_SEGMENT_SIZE * seg_no));
+      }
+      free_segment_group_area(segment_group_area, required_num_segments);
+      return NULL;
+    }
+  }
+#endif /* defined(SEG_RMAP_RADIX_TABLE) */
+
   // Update segment metadata
   for (uint32_t seg_no = 0; seg_no < required_num_segments; seg_no++) {
     uint32_t sidx = start_sidx + seg_no;
@@ -118,6 +219,15 @@ static void *alloc_a_segment_group_internal(size_t required_size,
       segment_header->group_num_segments = 0;
     }
     segment_header->occupied_size = 0;
+#ifdef SEG_SIZE_CLASS_BINS
+    init_segment_bins(segment_header);
+#endif /* defined(SEG_SIZE_CLASS_BINS) */
+#ifdef SEG_SEGMENT_EVACUATION
+    segment_header->is_evacuating = false;
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
+#ifdef SEG_SEGMENT_RETENTION
+    segment_header->empty_epoch = 0;
+#endif /* defined(SEG_SEGMENT_RETENTION) */
   }
 
   // Update allocated heap area size, system memory allocator
@@ -139,6 +249,8 @@ void *alloc_a_segment_group(size_t required_size) {
       (uint8_t *)alloc_a_segment_group_internal(required_size, &start_sidx);
   if (segment_group_area == NULL)
     return NULL;
+  JERRY_PROBE2(segment__alloc, required_size,
+               JERRY_HEAP_CONTEXT(segments_count));
   jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[start_sidx]);
   uint32_t required_num_segments = segment_header->group_num_segments;
 
@@ -160,108 +272,247 @@ void *alloc_a_segment_group(size_t required_size) {
   segment_group_region->size = SEG_SEGMENT_SIZE * required_num_segments;
   segment_group_region->next_offset = prev_p->next_offset;
   prev_p->next_offset = segment_group_offset;
+#ifdef JMEM_HEAP_FREE_INDEX
+  jmem_heap_free_index_insert(segment_group_offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
 
   return (void *)segment_group_region;
 }
 
-void free_empty_segment_groups(void) {
-  // Free empty segment groups except initial segment
-  for (uint32_t start_sidx = 1; start_sidx < SEG_NUM_SEGMENTS; start_sidx++) {
-    // Filter leading segment of the segment group
-    jmem_heap_free_t *segment_group_region =
-        (jmem_heap_free_t *)JERRY_HEAP_CONTEXT(area[start_sidx]);
-    jmem_segment_t *segment_group_header =
-        &JERRY_HEAP_CONTEXT(segments[start_sidx]);
-    if (segment_group_region == NULL ||
-        segment_group_header->group_num_segments == 0)
-      continue;
+static bool is_empty_segment_group(uint32_t start_sidx) {
+  jmem_segment_t *segment_group_header =
+      &JERRY_HEAP_CONTEXT(segments[start_sidx]);
+  uint32_t end_sidx = start_sidx + segment_group_header->group_num_segments - 1;
+  bool is_free_segment_group = true;
+  for (uint32_t sidx = start_sidx; sidx <= end_sidx; sidx++) {
+    jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[sidx]);
+    if (segment_header->occupied_size > 0)
+      is_free_segment_group = false;
+#ifdef SEG_SIZE_CLASS_BINS
+    // Bins should be flushed before freeing segment groups
+    JERRY_ASSERT(segment_header->binned_size == 0);
+#endif /* defined(SEG_SIZE_CLASS_BINS) */
+  }
+  return is_free_segment_group;
+}
 
-    // Check if the segment group is empty
-    bool is_free_segment_group = true;
-    uint32_t end_sidx =
-        start_sidx + segment_group_header->group_num_segments - 1;
-    for (uint32_t sidx = start_sidx; sidx <= end_sidx; sidx++) {
-      jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[sidx]);
-      if (segment_header->occupied_size > 0)
-        is_free_segment_group = false;
-    }
+static void free_segment_group(uint32_t start_sidx) {
+  jmem_heap_free_t *segment_group_region =
+      (jmem_heap_free_t *)JERRY_HEAP_CONTEXT(area[start_sidx]);
+  jmem_segment_t *segment_group_header =
+      &JERRY_HEAP_CONTEXT(segments[start_sidx]);
+  uint32_t group_num_segments = segment_group_header->group_num_segments;
+  uint32_t end_sidx = start_sidx + group_num_segments - 1;
 
-    if (!is_free_segment_group)
-      continue;
+  // Check free region size of the segment group
+  JERRY_ASSERT(segment_group_region->size ==
+               SEG_SEGMENT_SIZE * group_num_segments);
 
+  // Update segment count
+  JERRY_HEAP_CONTEXT(segments_count) -= group_num_segments;
 
-    // Update segment metadata
-    {
-      uint32_t group_num_segments = segment_group_header->group_num_segments;
-      // Check free region size of the segment group
-      JERRY_ASSERT(segment_group_region->size ==
-                   SEG_SEGMENT_SIZE * group_num_segments);
-
-      // Update segment count
-      JERRY_HEAP_CONTEXT(segments_count) -= group_num_segments;
-
-      // Update free region list
-      uint32_t curr_offset = JERRY_HEAP_CONTEXT(first).next_offset;
-      jmem_heap_free_t *current_p =
-          JMEM_DECOMPRESS_POINTER_INTERNAL(curr_offset);
-      jmem_heap_free_t *prev_p = &JERRY_HEAP_CONTEXT(first);
-      uint32_t segment_group_offset =
-          (uint32_t)start_sidx * (uint32_t)SEG_SEGMENT_SIZE;
-      while (current_p != JMEM_HEAP_END_OF_LIST &&
-             curr_offset < segment_group_offset) {
-        prev_p = current_p;
-        curr_offset = current_p->next_offset;
-        current_p = JMEM_DECOMPRESS_POINTER_INTERNAL(curr_offset);
-      }
-      JERRY_ASSERT(curr_offset == segment_group_offset);
-      prev_p->next_offset = current_p->next_offset;
+  // Update free region list
+  uint32_t curr_offset = JERRY_HEAP_CONTEXT(first).next_offset;
+  jmem_heap_free_t *current_p = JMEM_DECOMPRESS_POINTER_INTERNAL(curr_offset);
+  jmem_heap_free_t *prev_p = &JERRY_HEAP_CONTEXT(first);
+  uint32_t segment_group_offset =
+      (uint32_t)start_sidx * (uint32_t)SEG_SEGMENT_SIZE;
+  while (current_p != JMEM_HEAP_END_OF_LIST &&
+         curr_offset < segment_group_offset) {
+    prev_p = current_p;
+    curr_offset = current_p->next_offset;
+    current_p = JMEM_DECOMPRESS_POINTER_INTERNAL(curr_offset);
+  }
+  JERRY_ASSERT(curr_offset == segment_group_offset);
+  prev_p->next_offset = current_p->next_offset;
+#ifdef JMEM_HEAP_FREE_INDEX
+  jmem_heap_free_index_remove(segment_group_offset);
+#endif /* defined(JMEM_HEAP_FREE_INDEX) */
 
-      // Update allocated heap area size, system memory allocator
-      JERRY_CONTEXT(jmem_allocated_heap_size) -=
-          SEG_SEGMENT_SIZE * group_num_segments;
-      JERRY_CONTEXT(jmem_system_allocator_metadata_size) -=
-          SYSTEM_ALLOCATOR_METADATA_SIZE;
+  // Update allocated heap area size, system memory allocator
+  JERRY_CONTEXT(jmem_allocated_heap_size) -=
+      SEG_SEGMENT_SIZE * group_num_segments;
+  JERRY_CONTEXT(jmem_system_allocator_metadata_size) -=
+      SYSTEM_ALLOCATOR_METADATA_SIZE;
 
-      // Update segment metadata
-      for (uint32_t sidx = start_sidx; sidx <= end_sidx; sidx++) {
-        jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[sidx]);
-        uint8_t *segment_area = sidx_to_addr(sidx);
+  // Update segment metadata
+  for (uint32_t sidx = start_sidx; sidx <= end_sidx; sidx++) {
+    jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[sidx]);
+    uint8_t *segment_area = sidx_to_addr(sidx);
 
-        // Update segment header
-        segment_header->group_num_segments = 0;
-        segment_header->occupied_size = 0;
+    // Update segment header
+    segment_header->group_num_segments = 0;
+    segment_header->occupied_size = 0;
+#ifdef SEG_SEGMENT_EVACUATION
+    if (segment_header->is_evacuating) {
+      segment_header->is_evacuating = false;
+      JERRY_HEAP_CONTEXT(evacuating_segments_count)--;
+    }
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
 
-#ifdef SEG_RMAP_BINSEARCH
-        // Update segment reverse map tree
-        segment_rmap_remove(&JERRY_HEAP_CONTEXT(segment_rmap_rb_root),
-                            segment_area);
+#if defined(SEG_RMAP_BINSEARCH)
+    // Update segment reverse map tree
+    segment_rmap_remove(&JERRY_HEAP_CONTEXT(segment_rmap_rb_root),
+                        segment_area);
+#elif defined(SEG_RMAP_RADIX_TABLE)
+    // Update segment reverse map radix table
+    segment_rmap_radix_remove(segment_area);
 #else
-        JERRY_UNUSED(segment_area);
+    JERRY_UNUSED(segment_area);
 #endif /* defined(SEG_RMAP_BINSEARCH) */
 
 #ifdef SEG_RMAP_CACHE
-        // Invalidate reverse map cache entry
-        invalidate_rmap_cache_entry(sidx);
+    // Invalidate reverse map cache entry
+    invalidate_rmap_cache_entry(sidx);
 #ifdef SEG_RMAP_2LEVEL_SEARCH
-        invalidate_fifo_cache_entry(sidx);
+    invalidate_fifo_cache_entry(sidx);
 #endif
 #endif /* defined(SEG_RMAP_BINSEARCH) */
 
-        // Update segment base table
-        JERRY_HEAP_CONTEXT(area[sidx]) = NULL;
-      }
+    // Update segment base table
+    JERRY_HEAP_CONTEXT(area[sidx]) = NULL;
+  }
+
+  // Free the segment group
+  free_segment_group_area(segment_group_region, group_num_segments);
+}
+
+static bool is_leading_segment(uint32_t sidx) {
+  return JERRY_HEAP_CONTEXT(area[sidx]) != NULL &&
+         JERRY_HEAP_CONTEXT(segments[sidx]).group_num_segments != 0;
+}
+
+void free_all_empty_segment_groups(void) {
+  // Free empty segment groups except initial segment
+  for (uint32_t start_sidx = 1; start_sidx < SEG_NUM_SEGMENTS; start_sidx++) {
+    if (is_leading_segment(start_sidx) && is_empty_segment_group(start_sidx))
+      free_segment_group(start_sidx);
+  }
+#ifdef SEG_SEGMENT_RETENTION
+  JERRY_HEAP_CONTEXT(retained_segments_count) = 0;
+#endif /* defined(SEG_SEGMENT_RETENTION) */
+}
+
+#ifdef SEG_SEGMENT_RETENTION
+/* Segment retention
+ * Freeing every empty segment group after GC makes an oscillating load
+ * allocate and free the same segments over and over, each time invalidating
+ * the reverse map. Instead, empty groups stay mapped, and are released when
+ * they have been empty for retention_age heap trims while more than
+ * retention_low empty segments are kept, or at once above retention_high.
+ * Higher groups are released first, as lower ones are reused first.
+ */
+void free_empty_segment_groups(void) {
+  uint32_t epoch = ++JERRY_HEAP_CONTEXT(retention_epoch);
+
+  // Age the empty segment groups
+  uint32_t empty_segments_count = 0;
+  for (uint32_t start_sidx = 1; start_sidx < SEG_NUM_SEGMENTS; start_sidx++) {
+    if (!is_leading_segment(start_sidx))
+      continue;
+    jmem_segment_t *segment_group_header =
+        &JERRY_HEAP_CONTEXT(segments[start_sidx]);
+    if (!is_empty_segment_group(start_sidx)) {
+      segment_group_header->empty_epoch = 0;
+      continue;
+    }
+    if (segment_group_header->empty_epoch == 0)
+      segment_group_header->empty_epoch = epoch;
+    empty_segments_count += segment_group_header->group_num_segments;
+  }
+
+  // Release the empty segment groups out of the watermarks
+  uint32_t retention_low = JERRY_HEAP_CONTEXT(retention_low);
+  for (uint32_t start_sidx = SEG_NUM_SEGMENTS - 1;
+       start_sidx > 0 && empty_segments_count > retention_low; start_sidx--) {
+    if (!is_leading_segment(start_sidx))
+      continue;
+    jmem_segment_t *segment_group_header =
+        &JERRY_HEAP_CONTEXT(segments[start_sidx]);
+    if (segment_group_header->empty_epoch == 0)
+      continue;
+    uint32_t age = epoch - segment_group_header->empty_epoch;
+    if (empty_segments_count <= JERRY_HEAP_CONTEXT(retention_high) &&
+        age < JERRY_HEAP_CONTEXT(retention_age))
+      continue;
+    empty_segments_count -= segment_group_header->group_num_segments;
+    segment_group_header->empty_epoch = 0;
+    free_segment_group(start_sidx);
+  }
+  JERRY_HEAP_CONTEXT(retained_segments_count) = empty_segments_count;
+}
 
-      // Free the segment group
-      FREE(segment_group_region);
-    } /* update segment metadata END */
-  }   /* for (start_sidx = 1 to (SEG_NUM_SEGMENTS - 1) by 1 */
+bool set_segment_retention(uint32_t low, uint32_t high, uint32_t age) {
+  if (low > high)
+    return false;
+  JERRY_HEAP_CONTEXT(retention_low) = low;
+  JERRY_HEAP_CONTEXT(retention_high) = high;
+  JERRY_HEAP_CONTEXT(retention_age) = age;
+  return true;
 }
+#else  /* defined(SEG_SEGMENT_RETENTION) */
+void free_empty_segment_groups(void) {
+  free_all_empty_segment_groups();
+}
+#endif /* !defined(SEG_SEGMENT_RETENTION) */
+
+#ifdef SEG_SEGMENT_EVACUATION
+/* Segment evacuation
+ * Live objects cannot be moved because compressed pointers to them are not
+ * tracked. Instead, the allocator stops placing new blocks in sparsely
+ * occupied segment groups, so that their survivors die out and the groups
+ * are freed by free_empty_segment_groups() at a later GC.
+ */
+void mark_sparse_segment_groups(void) {
+  cancel_segment_evacuation();
+
+  // Initial segment group is never freed
+  for (uint32_t start_sidx = 1; start_sidx < SEG_NUM_SEGMENTS; start_sidx++) {
+    jmem_segment_t *segment_group_header =
+        &JERRY_HEAP_CONTEXT(segments[start_sidx]);
+    uint32_t group_num_segments = segment_group_header->group_num_segments;
+    if (JERRY_HEAP_CONTEXT(area[start_sidx]) == NULL ||
+        group_num_segments == 0)
+      continue;
+
+    // Calculate occupancy of the segment group
+    uint32_t end_sidx = start_sidx + group_num_segments - 1;
+    size_t occupied_size = 0;
+    for (uint32_t sidx = start_sidx; sidx <= end_sidx; sidx++) {
+      occupied_size += JERRY_HEAP_CONTEXT(segments[sidx]).occupied_size;
+    }
+    if (occupied_size * 100 >= (size_t)SEG_SEGMENT_EVACUATION_THRESHOLD *
+                                   SEG_SEGMENT_SIZE * group_num_segments)
+      continue;
+#ifdef SEG_SEGMENT_RETENTION
+    // Retained empty groups are there to be reused
+    if (occupied_size == 0)
+      continue;
+#endif /* defined(SEG_SEGMENT_RETENTION) */
+
+    // Mark the segment group
+    for (uint32_t sidx = start_sidx; sidx <= end_sidx; sidx++) {
+      JERRY_HEAP_CONTEXT(segments[sidx]).is_evacuating = true;
+    }
+    JERRY_HEAP_CONTEXT(evacuating_segments_count) += group_num_segments;
+  }
+}
+
+void cancel_segment_evacuation(void) {
+  if (JERRY_HEAP_CONTEXT(evacuating_segments_count) == 0)
+    return;
+  for (uint32_t sidx = 0; sidx < SEG_NUM_SEGMENTS; sidx++) {
+    JERRY_HEAP_CONTEXT(segments[sidx]).is_evacuating = false;
+  }
+  JERRY_HEAP_CONTEXT(evacuating_segments_count) = 0;
+}
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
 
 void free_initial_segment_group(void) {
   jmem_heap_free_t *segment_group_region = JERRY_HEAP_CONTEXT(area[0]);
   jmem_segment_t *segment_header = &JERRY_HEAP_CONTEXT(segments[0]);
   // Free the segment group
-  FREE(segment_group_region);
+  free_segment_group_area(segment_group_region, 1);
 
   // Update segment count
   JERRY_HEAP_CONTEXT(segments_count)--;
@@ -270,10 +521,13 @@ void free_initial_segment_group(void) {
   segment_header->group_num_segments = 0;
   segment_header->occupied_size = 0;
 
-#ifdef SEG_RMAP_BINSEARCH
+#if defined(SEG_RMAP_BINSEARCH)
   // Update segment reverse map tree
   segment_rmap_remove(&JERRY_HEAP_CONTEXT(segment_rmap_rb_root),
                       segment_group_region);
+#elif defined(SEG_RMAP_RADIX_TABLE)
+  // Update segment reverse map radix table
+  segment_rmap_radix_remove((uint8_t *)segment_group_region);
 #endif /* defined(SEG_RMAP_BINSEARCH) */
 
   // Update allocated heap area size, system memory allocator
@@ -22,9 +22,32 @@
 
 #ifdef JMEM_SEGMENTED_HEAP
 extern void init_segmented_heap(void);
+#ifdef SEG_RUNTIME_SEGMENT_SIZE
+// Request segment size of the next jerry_init() (a power of 2)
+// * false if the segment size is not supported
+extern bool set_segment_size(uint32_t segment_size);
+// Apply the requested segment size to the heap
+extern void init_segment_size(void);
+#endif /* defined(SEG_RUNTIME_SEGMENT_SIZE) */
 extern void *alloc_a_segment_group(size_t required_size);
+// Free empty segment groups after GC, but those segment retention keeps
 extern void free_empty_segment_groups(void);
+// Free all empty segment groups
+extern void free_all_empty_segment_groups(void);
 extern void free_initial_segment_group(void);
+
+#ifdef SEG_SEGMENT_RETENTION
+// Set the watermarks (unit: segments) and the age (unit: GCs) of retention
+// * false if low is above high
+extern bool set_segment_retention(uint32_t low, uint32_t high, uint32_t age);
+#endif /* defined(SEG_SEGMENT_RETENTION) */
+
+#ifdef SEG_SEGMENT_EVACUATION
+// Mark sparsely occupied segment groups to be evacuated
+extern void mark_sparse_segment_groups(void);
+// Stop evacuating all segments
+extern void cancel_segment_evacuation(void);
+#endif /* defined(SEG_SEGMENT_EVACUATION) */
 #endif /* JMEM_SEGMENTED_HEAP */
 
 #endif /* !defined(JMEM_HEAP_SEGMENTED_H) */
\ No newline at end of file
@@ -39,12 +39,14 @@ lit_get_magic_string_utf8 (lit_magic_string_id_t id) /**< magic string id */
 {
   static const lit_utf8_byte_t * const lit_magic_strings[] JERRY_CONST_DATA =
   {
-#define LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE(size, id)
+#define LIT_MAGIC_STRING_HASH_DISPLACEMENT(displacement)
+#define LIT_MAGIC_STRING_HASH_SLOT(id)
 #define LIT_MAGIC_STRING_DEF(id, utf8_string) \
     (const lit_utf8_byte_t *) utf8_string,
 #include "lit-magic-strings.inc.h"
 #undef LIT_MAGIC_STRING_DEF
-#undef LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE
+#undef LIT_MAGIC_STRING_HASH_SLOT
+#undef LIT_MAGIC_STRING_HASH_DISPLACEMENT
   };
 
   JERRY_ASSERT (id < LIT_NON_INTERNAL_MAGIC_STRING__COUNT);
@@ -62,12 +64,14 @@ lit_get_magic_string_size (lit_magic_string_id_t id) /**< magic string id */
 {
   static const lit_magic_size_t lit_magic_string_sizes[] JERRY_CONST_DATA =
   {
-#define LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE(size, id)
+#define LIT_MAGIC_STRING_HASH_DISPLACEMENT(displacement)
+#define LIT_MAGIC_STRING_HASH_SLOT(id)
 #define LIT_MAGIC_STRING_DEF(id, utf8_string) \
     sizeof(utf8_string) - 1,
 #include "lit-magic-strings.inc.h"
 #undef LIT_MAGIC_STRING_DEF
-#undef LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE
+#undef LIT_MAGIC_STRING_HASH_SLOT
+#undef LIT_MAGIC_STRING_HASH_DISPLACEMENT
   };
 
   JERRY_ASSERT (id < LIT_NON_INTERNAL_MAGIC_STRING__COUNT);
@@ -76,29 +80,122 @@ lit_get_magic_string_size (lit_magic_string_id_t id) /**< magic string id */
 } /* lit_get_magic_string_size */
 
 /**
- * Get the block start element with the given size from
- * the list of ECMA and implementation-defined magic string constants
- *
- * @return magic string id
+ * Initial value of the magic string hashes
  */
-lit_magic_string_id_t
-lit_get_magic_string_size_block_start (lit_utf8_size_t size) /**< magic string size */
+#define LIT_MAGIC_STRING_HASH_INIT 2166136261u
+
+/**
+ * Bucket displacements of the perfect hash of the ECMA and implementation-defined magic string constants
+ */
+static const uint16_t lit_magic_string_hash_displacements[] JERRY_CONST_DATA =
 {
-  static const lit_magic_string_id_t lit_magic_string_size_block_starts[] JERRY_CONST_DATA =
-  {
 #define LIT_MAGIC_STRING_DEF(id, utf8_string)
-#define LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE(size, id) \
-    id,
+#define LIT_MAGIC_STRING_HASH_SLOT(id)
+#define LIT_MAGIC_STRING_HASH_DISPLACEMENT(displacement) \
+    displacement,
 #include "lit-magic-strings.inc.h"
-    LIT_NON_INTERNAL_MAGIC_STRING__COUNT
+#undef LIT_MAGIC_STRING_HASH_DISPLACEMENT
+#undef LIT_MAGIC_STRING_HASH_SLOT
 #undef LIT_MAGIC_STRING_DEF
-#undef LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE
-  };
+};
+
+/**
+ * Magic string ids of the perfect hash slots, empty slots contain LIT_NON_INTERNAL_MAGIC_STRING__COUNT
+ */
+static const uint16_t lit_magic_string_hash_slots[] JERRY_CONST_DATA =
+{
+#define LIT_MAGIC_STRING_DEF(id, utf8_string)
+#define LIT_MAGIC_STRING_HASH_DISPLACEMENT(displacement)
+#define LIT_MAGIC_STRING_HASH_SLOT(id) \
+    (uint16_t) id,
+#include "lit-magic-strings.inc.h"
+#undef LIT_MAGIC_STRING_HASH_SLOT
+#undef LIT_MAGIC_STRING_HASH_DISPLACEMENT
+#undef LIT_MAGIC_STRING_DEF
+};
+
+/**
+ * Continue the magic string hash computation with the bytes of a string
+ *
+ * Note:
+ *      this is the 32 bit FNV-1a hash, which is also computed by tools/gen-magic-strings.py
+ *      and by the generators of external magic string hash tables
+ *
+ * @return updated hash value
+ */
+static inline uint32_t __attr_always_inline___
+lit_magic_string_hash (uint32_t hash, /**< hash of the preceding bytes */
+                       const lit_utf8_byte_t *string_p, /**< utf-8 string */
+                       lit_utf8_size_t string_size) /**< string size in bytes */
+{
+  const lit_utf8_byte_t *string_end_p = string_p + string_size;
+
+  while (string_p < string_end_p)
+  {
+    hash = (hash ^ *string_p++) * 16777619u;
+  }
+
+  return hash;
+} /* lit_magic_string_hash */
+
+/**
+ * Get the slot of a magic string hash in a perfect hash table
+ *
+ * @return slot index
+ */
+static inline uint32_t __attr_always_inline___
+lit_magic_string_hash_slot (uint32_t hash, /**< magic string hash */
+                            const uint16_t *displacements_p, /**< bucket displacements */
+                            uint32_t displacement_count, /**< number of buckets */
+                            uint32_t slot_count) /**< number of slots */
+{
+  /* The displaced hash is mixed by the finalizer of MurmurHash3. */
+  hash += displacements_p[hash % displacement_count];
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
 
-  JERRY_ASSERT (size <= (sizeof (lit_magic_string_size_block_starts) / sizeof (lit_magic_string_id_t)));
+  return hash % slot_count;
+} /* lit_magic_string_hash_slot */
 
-  return lit_magic_string_size_block_starts[size];
-} /* lit_get_magic_string_size_block_start */
+/**
+ * Get the magic string id which may be equal to a string with the given hash
+ *
+ * @return id - if the hash slot is not empty,
+ *         LIT_NON_INTERNAL_MAGIC_STRING__COUNT - otherwise.
+ */
+static lit_magic_string_id_t
+lit_get_magic_string_hash_candidate (uint32_t hash) /**< magic string hash */
+{
+  const uint32_t displacement_count = sizeof (lit_magic_string_hash_displacements) / sizeof (uint16_t);
+  const uint32_t slot_count = sizeof (lit_magic_string_hash_slots) / sizeof (uint16_t);
+
+  uint32_t slot = lit_magic_string_hash_slot (hash,
+                                              lit_magic_string_hash_displacements,
+                                              displacement_count,
+                                              slot_count);
+
+  return (lit_magic_string_id_t) lit_magic_string_hash_slots[slot];
+} /* lit_get_magic_string_hash_candidate */
+
+/**
+ * Get the external magic string id which may be equal to a string with the given hash
+ *
+ * @return id - if the hash slot is not empty,
+ *         lit_get_magic_string_ex_count () - otherwise.
+ */
+static lit_magic_string_ex_id_t
+lit_get_magic_string_ex_hash_candidate (uint32_t hash) /**< magic string hash */
+{
+  uint32_t slot = lit_magic_string_hash_slot (hash,
+                                              JERRY_CONTEXT (lit_magic_string_ex_hash_displacements),
+                                              JERRY_CONTEXT (lit_magic_string_ex_hash_displacement_count),
+                                              JERRY_CONTEXT (lit_magic_string_ex_hash_slot_count));
+
+  return (lit_magic_string_ex_id_t) JERRY_CONTEXT (lit_magic_string_ex_hash_slots)[slot];
+} /* lit_get_magic_string_ex_hash_candidate */
 
 /**
  * Get specified magic string as zero-terminated string from external table
@@ -179,6 +276,45 @@ lit_magic_strings_ex_set (const lit_utf8_byte_t **ex_str_items, /**< character a
 #endif /* !JERRY_NDEBUG */
 } /* lit_magic_strings_ex_set */
 
+/**
+ * Register the perfect hash of the external magic strings
+ *
+ * Note:
+ *      the lookup falls back to binary search if no hash is registered
+ */
+void
+lit_magic_strings_ex_hash_set (const uint16_t *displacements_p, /**< bucket displacements */
+                               uint32_t displacement_count, /**< number of buckets */
+                               const uint16_t *slots_p, /**< external magic string ids of the slots, empty slots
+                                                         *   contain the number of external magic strings */
+                               uint32_t slot_count) /**< number of slots */
+{
+  JERRY_ASSERT (displacements_p != NULL && displacement_count > 0);
+  JERRY_ASSERT (slots_p != NULL && slot_count > 0);
+
+  JERRY_ASSERT (JERRY_CONTEXT (lit_magic_string_ex_count) > 0);
+  JERRY_ASSERT (JERRY_CONTEXT (lit_magic_string_ex_count) <= UINT16_MAX);
+  JERRY_ASSERT (JERRY_CONTEXT (lit_magic_string_ex_hash_slots) == NULL);
+
+  JERRY_CONTEXT (lit_magic_string_ex_hash_displacements) = displacements_p;
+  JERRY_CONTEXT (lit_magic_string_ex_hash_displacement_count) = displacement_count;
+  JERRY_CONTEXT (lit_magic_string_ex_hash_slots) = slots_p;
+  JERRY_CONTEXT (lit_magic_string_ex_hash_slot_count) = slot_count;
+
+#ifndef JERRY_NDEBUG
+  /* Check whether every string is found in its own slot. */
+  for (lit_magic_string_ex_id_t id = (lit_magic_string_ex_id_t) 0;
+       id < JERRY_CONTEXT (lit_magic_string_ex_count);
+       id = (lit_magic_string_ex_id_t) (id + 1))
+  {
+    uint32_t hash = lit_magic_string_hash (LIT_MAGIC_STRING_HASH_INIT,
+                                           lit_get_magic_string_ex_utf8 (id),
+                                           lit_get_magic_string_ex_size (id));
+    JERRY_ASSERT (lit_get_magic_string_ex_hash_candidate (hash) == id);
+  }
+#endif /* !JERRY_NDEBUG */
+} /* lit_magic_strings_ex_hash_set */
+
 /**
  * Returns the magic string id of the argument string if it is available.
  *
@@ -194,27 +330,14 @@ lit_is_utf8_string_magic (const lit_utf8_byte_t *string_p, /**< utf-8 string */
     return LIT_MAGIC_STRING__COUNT;
   }
 
-  /**< The string must be in this id range. */
-  lit_utf8_size_t first = lit_get_magic_string_size_block_start (string_size);
-  lit_utf8_size_t last = lit_get_magic_string_size_block_start (string_size + 1);
+  uint32_t hash = lit_magic_string_hash (LIT_MAGIC_STRING_HASH_INIT, string_p, string_size);
+  lit_magic_string_id_t id = lit_get_magic_string_hash_candidate (hash);
 
-  while (first < last)
+  if (id < LIT_NON_INTERNAL_MAGIC_STRING__COUNT
+      && lit_get_magic_string_size (id) == string_size
+      && memcmp (lit_get_magic_string_utf8 (id), string_p, string_size) == 0)
   {
-    lit_utf8_size_t middle = ((first + last) / 2); /**< mid point of search */
-    int compare = memcmp (lit_get_magic_string_utf8 (middle), string_p, string_size);
-
-    if (compare == 0)
-    {
-      return (lit_magic_string_id_t) middle;
-    }
-    else if (compare > 0)
-    {
-      last = middle;
-    }
-    else
-    {
-      first = middle + 1;
-    }
+    return id;
   }
 
   return LIT_MAGIC_STRING__COUNT;
@@ -239,33 +362,19 @@ lit_is_utf8_string_pair_magic (const lit_utf8_byte_t *string1_p, /**< first utf-
     return LIT_MAGIC_STRING__COUNT;
   }
 
-  /**< The string must be in this id range. */
-  lit_utf8_size_t first = lit_get_magic_string_size_block_start (total_string_size);
-  lit_utf8_size_t last = lit_get_magic_string_size_block_start (total_string_size + 1);
+  uint32_t hash = lit_magic_string_hash (LIT_MAGIC_STRING_HASH_INIT, string1_p, string1_size);
+  hash = lit_magic_string_hash (hash, string2_p, string2_size);
+  lit_magic_string_id_t id = lit_get_magic_string_hash_candidate (hash);
 
-  while (first < last)
+  if (id < LIT_NON_INTERNAL_MAGIC_STRING__COUNT
+      && lit_get_magic_string_size (id) == total_string_size)
   {
-    lit_utf8_size_t middle = ((first + last) / 2); /**< mid point of search */
-    const lit_utf8_byte_t *middle_string_p = lit_get_magic_string_utf8 (middle);
-
-    int compare = memcmp (middle_string_p, string1_p, string1_size);
-
-    if (compare == 0)
-    {
-      compare = memcmp (middle_string_p + string1_size, string2_p, string2_size);
-    }
+    const lit_utf8_byte_t *magic_string_p = lit_get_magic_string_utf8 (id);
 
-    if (compare == 0)
-    {
-      return (lit_magic_string_id_t) middle;
-    }
-    else if (compare > 0)
+    if (memcmp (magic_string_p, string1_p, string1_size) == 0
+        && memcmp (magic_string_p + string1_size, string2_p, string2_size) == 0)
     {
-      last = middle;
-    }
-    else
-    {
-      first = middle + 1;
+      return id;
     }
   }
 
@@ -290,6 +399,21 @@ lit_is_ex_utf8_string_magic (const lit_utf8_byte_t *string_p, /**< utf-8 string
     return (lit_magic_string_ex_id_t) magic_string_ex_count;
   }
 
+  if (JERRY_CONTEXT (lit_magic_string_ex_hash_slots) != NULL)
+  {
+    uint32_t hash = lit_magic_string_hash (LIT_MAGIC_STRING_HASH_INIT, string_p, string_size);
+    lit_magic_string_ex_id_t id = lit_get_magic_string_ex_hash_candidate (hash);
+
+    if (id < magic_string_ex_count
+        && lit_get_magic_string_ex_size (id) == string_size
+        && memcmp (lit_get_magic_string_ex_utf8 (id), string_p, string_size) == 0)
+    {
+      return id;
+    }
+
+    return (lit_magic_string_ex_id_t) magic_string_ex_count;
+  }
+
   lit_magic_string_ex_id_t first = 0;
   lit_magic_string_ex_id_t last = (lit_magic_string_ex_id_t) magic_string_ex_count;
 
@@ -350,6 +474,27 @@ lit_is_ex_utf8_string_pair_magic (const lit_utf8_byte_t *string1_p, /**< first u
     return (lit_magic_string_ex_id_t) magic_string_ex_count;
   }
 
+  if (JERRY_CONTEXT (lit_magic_string_ex_hash_slots) != NULL)
+  {
+    uint32_t hash = lit_magic_string_hash (LIT_MAGIC_STRING_HASH_INIT, string1_p, string1_size);
+    hash = lit_magic_string_hash (hash, string2_p, string2_size);
+    lit_magic_string_ex_id_t id = lit_get_magic_string_ex_hash_candidate (hash);
+
+    if (id < magic_string_ex_count
+        && lit_get_magic_string_ex_size (id) == total_string_size)
+    {
+      const lit_utf8_byte_t *ext_string_p = lit_get_magic_string_ex_utf8 (id);
+
+      if (memcmp (ext_string_p, string1_p, string1_size) == 0
+          && memcmp (ext_string_p + string1_size, string2_p, string2_size) == 0)
+      {
+        return id;
+      }
+    }
+
+    return (lit_magic_string_ex_id_t) magic_string_ex_count;
+  }
+
   lit_magic_string_ex_id_t first = 0;
   lit_magic_string_ex_id_t last = (lit_magic_string_ex_id_t) magic_string_ex_count;
 
@@ -28,12 +28,14 @@
  */
 typedef enum
 {
-#define LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE(size, id)
+#define LIT_MAGIC_STRING_HASH_DISPLACEMENT(displacement)
+#define LIT_MAGIC_STRING_HASH_SLOT(id)
 #define LIT_MAGIC_STRING_DEF(id, ascii_zt_string) \
      id,
 #include "lit-magic-strings.inc.h"
 #undef LIT_MAGIC_STRING_DEF
-#undef LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE
+#undef LIT_MAGIC_STRING_HASH_SLOT
+#undef LIT_MAGIC_STRING_HASH_DISPLACEMENT
   LIT_NON_INTERNAL_MAGIC_STRING__COUNT, /**< number of non-internal magic strings */
   LIT_INTERNAL_MAGIC_STRING_PROMISE = LIT_NON_INTERNAL_MAGIC_STRING__COUNT, /**<  [[Promise]] of promise
                                                                              *    reject or resolve functions */
@@ -57,13 +59,14 @@ uint32_t lit_get_magic_string_ex_count (void);
 
 const lit_utf8_byte_t *lit_get_magic_string_utf8 (lit_magic_string_id_t id);
 lit_utf8_size_t lit_get_magic_string_size (lit_magic_string_id_t id);
-lit_magic_string_id_t lit_get_magic_string_size_block_start (lit_utf8_size_t size);
 
 const lit_utf8_byte_t *lit_get_magic_string_ex_utf8 (lit_magic_string_ex_id_t id);
 lit_utf8_size_t lit_get_magic_string_ex_size (lit_magic_string_ex_id_t id);
 
 void lit_magic_strings_ex_set (const lit_utf8_byte_t **ex_str_items, uint32_t count,
                                const lit_utf8_size_t *ex_str_sizes);
+void lit_magic_strings_ex_hash_set (const uint16_t *displacements_p, uint32_t displacement_count,
+                                    const uint16_t *slots_p, uint32_t slot_count);
 
 lit_magic_string_id_t lit_is_utf8_string_magic (const lit_utf8_byte_t *string_p, lit_utf8_size_t string_size);
 lit_magic_string_id_t lit_is_utf8_string_pair_magic (const lit_utf8_byte_t *string1_p, lit_utf8_size_t string1_size,
@@ -18,11 +18,7 @@
 
 
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING__EMPTY, "")
-LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_NEW_LINE_CHAR, "\n")
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_SPACE_CHAR, " ")
-#if !defined (CONFIG_DISABLE_JSON_BUILTIN)
-LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_DOUBLE_QUOTE_CHAR, "\"")
-#endif
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_LEFT_PARENTHESIS_CHAR, "(")
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_RIGHT_PARENTHESIS_CHAR, ")")
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_COMMA_CHAR, ",")
@@ -37,9 +33,6 @@ LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_COLON_CHAR, ":")
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_E_U, "E")
 #endif
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_LEFT_SQUARE_CHAR, "[")
-#if !defined (CONFIG_DISABLE_JSON_BUILTIN)
-LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_BACKSLASH_CHAR, "\\")
-#endif
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_RIGHT_SQUARE_CHAR, "]")
 #if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_G_CHAR, "g")
@@ -549,100 +542,1064 @@ LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_PROPERTY_IS_ENUMERABLE_UL, "propertyIsEnu
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_GET_OWN_PROPERTY_DESCRIPTOR_UL, "getOwnPropertyDescriptor")
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING__FUNCTION_TO_STRING, "function(){/* ecmascript */}")
 
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (0, LIT_MAGIC_STRING__EMPTY)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (1, LIT_MAGIC_STRING_NEW_LINE_CHAR)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (1)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (5)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (3)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (17)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (3)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (31)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (1)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (12)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (14)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (10)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (22)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (2)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (22)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (9)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (4)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (3)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (1)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (1)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (7)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (8)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (8)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (15)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (1)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (31)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (10)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (3)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (8)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (2)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (14)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (14)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (41)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (36)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (8)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (42)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (8)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (85)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (2)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (89)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (2)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (35)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (12)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (20)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (54)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (11)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (39)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (12)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (3)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (10)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (1)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (0)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (7)
+LIT_MAGIC_STRING_HASH_DISPLACEMENT (73)
+
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_MONTH_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_UTC_MINUTES_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NEGATIVE_INFINITY_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UTC_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MATH_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_OWN_PROPERTY_NAMES_UL)
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_REDUCE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NUMBER)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_STRING_UL)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_COS)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_PROMISE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_THEN)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NUMBER_UL)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FLOOR)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_UTC_MINUTES_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_FIXED_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
 #if !defined (CONFIG_DISABLE_MATH_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (2, LIT_MAGIC_STRING_PI_U)
-#elif !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (2, LIT_MAGIC_STRING_OF)
-#elif !defined (CONFIG_DISABLE_MATH_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (2, LIT_MAGIC_STRING_LN2_U)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MAX)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UNDEFINED)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_DEFINE_PROPERTIES_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ERROR_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_COMMA_CHAR)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CALLEE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FUNCTION)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_UTC_SECONDS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_OWN_PROPERTY_DESCRIPTOR_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CALL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PROTOTYPE)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_TIME_STRING_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_INT8_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FOR_EACH_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SQRT)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_WRITABLE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_BOOLEAN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ARRAY_UL)
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SOURCE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ES2015_PROMISE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PROMISE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ANNEXB_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UNESCAPE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FROM_CHAR_CODE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TEST)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MULTILINE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ATAN2)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_UTC_STRING_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LOG10E_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IGNORECASE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_VALUE)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LOG)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_LOWER_CASE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SORT)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TRIM)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CHAR_AT_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_OBJECT_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_LOCALE_DATE_STRING_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_LOCALE_TIME_STRING_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_REDUCE_RIGHT_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LENGTH)
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_BUFFER)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ANNEXB_BUILTIN) && !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SUBSTR)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MAX_VALUE_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LEFT_BRACE_CHAR)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NOW)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ERROR_BUILTINS)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_RANGE_ERROR_UL)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (2, LIT_MAGIC_STRING_NAN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING__EMPTY)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PREVENT_EXTENSIONS_UL)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_UTC_HOURS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ANNEXB_BUILTIN) && !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_COMPILE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_VALUE_OF_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FUNCTION_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_EVAL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_DEFINE_PROPERTY_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_HAS_OWN_PROPERTY_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_UTC_MONTH_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_RIGHT_PARENTHESIS_CHAR)
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SLASH_CHAR)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_EXPONENTIAL_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_INPUT)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ERROR_BUILTINS)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SYNTAX_ERROR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
 #if !defined (CONFIG_DISABLE_MATH_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (3, LIT_MAGIC_STRING_LN2_U)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LN10_U)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (3, LIT_MAGIC_STRING_NAN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IS_FINITE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ARRAY_BUFFER_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LEFT_PARENTHESIS_CHAR)
+#if !defined (CONFIG_DISABLE_ES2015_PROMISE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CATCH)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (4, LIT_MAGIC_STRING_EMPTY_NON_CAPTURE_GROUP)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_EXEC)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_BOOLEAN_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_STRING_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_RIGHT_SQUARE_CHAR)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_DECODE_URI_COMPONENT)
+#if !defined (CONFIG_DISABLE_ANNEXB_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ESCAPE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FILTER)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ENCODE_URI)
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FROM)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_DAY_UL)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (4, LIT_MAGIC_STRING_DATE_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PARSE_FLOAT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LEFT_SQUARE_CHAR)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_SECONDS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_INVALID_DATE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NAME)
+#if !defined (CONFIG_DISABLE_ES2015_PROMISE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_RESOLVE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_TIMEZONE_OFFSET_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_PROMISE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_RACE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_BYTES_PER_ELEMENT_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MAP)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_UTC_FULL_YEAR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_BIND)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CREATE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_RIGHT_BRACE_CHAR)
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TYPED_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_UTC_DATE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IS_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (5, LIT_MAGIC_STRING_ARRAY_UL)
 #if !defined (CONFIG_DISABLE_MATH_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (6, LIT_MAGIC_STRING_LOG10E_U)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ATAN)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (6, LIT_MAGIC_STRING_NUMBER_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (7, LIT_MAGIC_STRING_BOOLEAN_UL)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (8, LIT_MAGIC_STRING_FUNCTION_UL)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (9, LIT_MAGIC_STRING_NEGATIVE_INFINITY_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IS_SEALED_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (10, LIT_MAGIC_STRING_INT16_ARRAY_UL)
-#elif !defined (CONFIG_DISABLE_ERROR_BUILTINS)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (10, LIT_MAGIC_STRING_RANGE_ERROR_UL)
-#elif !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (10, LIT_MAGIC_STRING_TYPED_ARRAY_UL)
-#elif !defined (CONFIG_DISABLE_STRING_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (10, LIT_MAGIC_STRING_CHAR_CODE_AT_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UINT32_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_APPLY)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ROUND)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (10, LIT_MAGIC_STRING_ENUMERABLE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_MILLISECONDS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CALLER)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TAN)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
 #if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (11, LIT_MAGIC_STRING_ARRAY_BUFFER_UL)
-#elif !defined (CONFIG_DISABLE_ERROR_BUILTINS)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (11, LIT_MAGIC_STRING_SYNTAX_ERROR_UL)
-#elif !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (11, LIT_MAGIC_STRING_UINT16_ARRAY_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_BYTE_LENGTH_UL)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (11, LIT_MAGIC_STRING_CONSTRUCTOR)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_JSON_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_STRINGIFY)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PUSH)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ARGUMENTS_UL)
+#if !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MIN_VALUE_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_I_CHAR)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
 #if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (12, LIT_MAGIC_STRING_FLOAT32_ARRAY_UL)
-#elif  CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64 && !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (12, LIT_MAGIC_STRING_FLOAT64_ARRAY_UL)
-#elif !defined (CONFIG_DISABLE_DATE_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (12, LIT_MAGIC_STRING_INVALID_DATE_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_INT16_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LASTINDEX_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_FULL_YEAR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IS_PROTOTYPE_OF_UL)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LN2_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_UTC_MONTH_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_PROMISE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ALL)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (12, LIT_MAGIC_STRING_CONFIGURABLE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IS_FROZEN_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #if !defined (CONFIG_DISABLE_DATE_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (13, LIT_MAGIC_STRING_GET_UTC_MINUTES_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_DATE_UL)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (13, LIT_MAGIC_STRING_IS_PROTOTYPE_OF_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
 #if !defined (CONFIG_DISABLE_ERROR_BUILTINS)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (14, LIT_MAGIC_STRING_REFERENCE_ERROR_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TYPE_ERROR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_KEYS)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PI_U)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (14, LIT_MAGIC_STRING_DEFINE_PROPERTY_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ACOS)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ERROR_BUILTINS)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_REFERENCE_ERROR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IS_VIEW_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CEIL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_POW)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NAN)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_DATE_STRING_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_EVERY)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UINT16_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SUBSTRING)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_UTC_DATE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CONSTRUCTOR)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ENCODE_URI_COMPONENT)
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_LOCALE_UPPER_CASE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_OF)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ABS)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ASIN)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SQRT2_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ANNEXB_BUILTIN) && !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_YEAR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LOG2E_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LOCALE_COMPARE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SEAL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #if !defined (CONFIG_DISABLE_DATE_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (15, LIT_MAGIC_STRING_GET_MILLISECONDS_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_UTC_SECONDS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SPLICE)
 #else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (15, LIT_MAGIC_STRING_DEFINE_PROPERTIES_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IS_EXTENSIBLE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_MINUTES_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
 #endif
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (16, LIT_MAGIC_STRING_DEFINE_PROPERTIES_UL)
 #if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (17, LIT_MAGIC_STRING_BYTES_PER_ELEMENT_U)
-#elif !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (17, LIT_MAGIC_STRING_NEGATIVE_INFINITY_U)
-#elif !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (17, LIT_MAGIC_STRING_UINT8_CLAMPED_ARRAY_UL)
-#elif !defined (CONFIG_DISABLE_DATE_BUILTIN)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (17, LIT_MAGIC_STRING_GET_TIMEZONE_OFFSET_UL)
-#else
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (17, LIT_MAGIC_STRING_PREVENT_EXTENSIONS_UL)
-#endif
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (18, LIT_MAGIC_STRING_DECODE_URI_COMPONENT)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (19, LIT_MAGIC_STRING_GET_OWN_PROPERTY_NAMES_UL)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (20, LIT_MAGIC_STRING_PROPERTY_IS_ENUMERABLE_UL)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (21, LIT_MAGIC_STRING_GET_OWN_PROPERTY_DESCRIPTOR_UL)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (22, LIT_MAGIC_STRING_GET_OWN_PROPERTY_DESCRIPTOR_UL)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (23, LIT_MAGIC_STRING_GET_OWN_PROPERTY_DESCRIPTOR_UL)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (24, LIT_MAGIC_STRING_GET_OWN_PROPERTY_DESCRIPTOR_UL)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (25, LIT_MAGIC_STRING__FUNCTION_TO_STRING)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (26, LIT_MAGIC_STRING__FUNCTION_TO_STRING)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (27, LIT_MAGIC_STRING__FUNCTION_TO_STRING)
-LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE (28, LIT_MAGIC_STRING__FUNCTION_TO_STRING)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_INT32_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_STRING)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_UTC_HOURS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UINT8_CLAMPED_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SPACE_CHAR)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PARSE_INT)
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_UPPER_CASE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_IS_NAN)
+#if !defined (CONFIG_DISABLE_ANNEXB_BUILTIN) && !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_YEAR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_M_CHAR)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NULL_UL)
+#if !defined (CONFIG_DISABLE_ES2015_PROMISE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_REJECT)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_JOIN)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_FULL_YEAR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_REVERSE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_INFINITY_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CHAR_CODE_AT_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_UTC_MILLISECONDS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_PRECISION_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_LOCALE_STRING_UL)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_EXP)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PROPERTY_IS_ENUMERABLE_UL)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_HOURS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CONFIGURABLE)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MIN)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN) && !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MATCH)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SQRT1_2_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_COLON_CHAR)
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SPLIT)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UNDEFINED_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MESSAGE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TRUE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_PROTOTYPE_OF_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NULL)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_TIME_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FREEZE)
+#if !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_LOCALE_LOWER_CASE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_MINUS_CHAR)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FLOAT32_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SIN)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_E_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_SECONDS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_JSON_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_JSON_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ERROR_BUILTINS)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_EVAL_ERROR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ENUMERABLE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_NEGATIVE_INFINITY_UL)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_ISO_STRING_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_EMPTY_NON_CAPTURE_GROUP)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_INDEX_OF_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ERROR_BUILTINS)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_URI_ERROR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_MILLISECONDS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_CONCAT)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GLOBAL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_MATH_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_RANDOM)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN) \
+|| !defined (CONFIG_DISABLE_JSON_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_JSON_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_G_CHAR)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_UTC_FULL_YEAR_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_UTC_DAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_REGEXP_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_ARGUMENTS)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_OBJECT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_DATE_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_DATE_UL)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FALSE)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_DECODE_URI)
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN) && !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_REPLACE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SOME)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_POP)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UNSHIFT)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_BYTE_OFFSET_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_HOURS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_MINUTES_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING__FUNCTION_TO_STRING)
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SHIFT)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SLICE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_TIME_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_MONTH_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN) && !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SEARCH)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_GET_UTC_MILLISECONDS_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_UINT8_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_REGEXP_BUILTIN) \
+|| !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_INDEX)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ANNEXB_BUILTIN) && !defined (CONFIG_DISABLE_DATE_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_TO_GMT_STRING_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_NUMBER_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_POSITIVE_INFINITY_U)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_ES2015_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_SET_PROTOTYPE_OF_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#if !defined (CONFIG_DISABLE_ARRAY_BUILTIN) \
+|| !defined (CONFIG_DISABLE_STRING_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_LAST_INDEX_OF_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if  CONFIG_ECMA_NUMBER_TYPE == CONFIG_ECMA_NUMBER_FLOAT64 && !defined (CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_FLOAT64_ARRAY_UL)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
+#if !defined (CONFIG_DISABLE_DATE_BUILTIN) \
+|| !defined (CONFIG_DISABLE_JSON_BUILTIN)
+LIT_MAGIC_STRING_HASH_SLOT (LIT_MAGIC_STRING_PARSE)
+#else
+LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)
+#endif
@@ -17,6 +17,70 @@
 
 #include "jrt-libc-includes.h"
 
+#ifndef CONFIG_DISABLE_LIT_SIMD
+#if defined (__SSE2__)
+#define LIT_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+#define LIT_SIMD_NEON
+#include <arm_neon.h>
+#endif /* __SSE2__ */
+#endif /* !CONFIG_DISABLE_LIT_SIMD */
+
+/**
+ * Number of bytes checked at once by lit_utf8_ascii_prefix_size
+ */
+#define LIT_ASCII_BLOCK_SIZE 16
+
+/**
+ * Calculate the size of the leading ASCII characters of an utf-8 or cesu-8 string
+ *
+ * @return number of bytes before the first byte of a multi-byte sequence
+ */
+lit_utf8_size_t
+lit_utf8_ascii_prefix_size (const lit_utf8_byte_t *buf_p, /**< utf-8 or cesu-8 string */
+                            lit_utf8_size_t buf_size) /**< string size */
+{
+  lit_utf8_size_t size = 0;
+
+  while (buf_size - size >= LIT_ASCII_BLOCK_SIZE)
+  {
+#if defined (LIT_SIMD_SSE2)
+    __m128i block = _mm_loadu_si128 ((const __m128i *) (buf_p + size));
+
+    if (_mm_movemask_epi8 (block) != 0)
+    {
+      break;
+    }
+#elif defined (LIT_SIMD_NEON)
+    uint8x16_t block = vld1q_u8 (buf_p + size);
+    uint8x8_t half = vorr_u8 (vget_low_u8 (block), vget_high_u8 (block));
+
+    if ((vget_lane_u64 (vreinterpret_u64_u8 (half), 0) & 0x8080808080808080ull) != 0)
+    {
+      break;
+    }
+#else /* !LIT_SIMD_SSE2 && !LIT_SIMD_NEON */
+    uint32_t words[LIT_ASCII_BLOCK_SIZE / sizeof (uint32_t)];
+    memcpy (words, buf_p + size, LIT_ASCII_BLOCK_SIZE);
+
+    if (((words[0] | words[1] | words[2] | words[3]) & 0x80808080u) != 0)
+    {
+      break;
+    }
+#endif /* LIT_SIMD_SSE2 */
+
+    size += LIT_ASCII_BLOCK_SIZE;
+  }
+
+  while (size < buf_size && (buf_p[size] & LIT_UTF8_1_BYTE_MASK) == LIT_UTF8_1_BYTE_MARKER)
+  {
+    size++;
+  }
+
+  return size;
+} /* lit_utf8_ascii_prefix_size */
+
 /**
  * Validate utf-8 string
  *
@@ -31,7 +95,7 @@ bool
 lit_is_valid_utf8_string (const lit_utf8_byte_t *utf8_buf_p, /**< utf-8 string */
                           lit_utf8_size_t buf_size) /**< string size */
 {
-  lit_utf8_size_t idx = 0;
+  lit_utf8_size_t idx = lit_utf8_ascii_prefix_size (utf8_buf_p, buf_size);
 
   bool is_prev_code_point_high_surrogate = false;
   while (idx < buf_size)
@@ -40,6 +104,7 @@ lit_is_valid_utf8_string (const lit_utf8_byte_t *utf8_buf_p, /**< utf-8 string *
     if ((c & LIT_UTF8_1_BYTE_MASK) == LIT_UTF8_1_BYTE_MARKER)
     {
       is_prev_code_point_high_surrogate = false;
+      idx += lit_utf8_ascii_prefix_size (utf8_buf_p + idx, buf_size - idx);
       continue;
     }
 
@@ -128,13 +193,14 @@ bool
 lit_is_valid_cesu8_string (const lit_utf8_byte_t *cesu8_buf_p, /**< cesu-8 string */
                            lit_utf8_size_t buf_size) /**< string size */
 {
-  lit_utf8_size_t idx = 0;
+  lit_utf8_size_t idx = lit_utf8_ascii_prefix_size (cesu8_buf_p, buf_size);
 
   while (idx < buf_size)
   {
     lit_utf8_byte_t c = cesu8_buf_p[idx++];
     if ((c & LIT_UTF8_1_BYTE_MASK) == LIT_UTF8_1_BYTE_MARKER)
     {
+      idx += lit_utf8_ascii_prefix_size (cesu8_buf_p + idx, buf_size - idx);
       continue;
     }
 
@@ -266,13 +332,17 @@ ecma_length_t
 lit_utf8_string_length (const lit_utf8_byte_t *utf8_buf_p, /**< utf-8 string */
                         lit_utf8_size_t utf8_buf_size) /**< string size */
 {
-  ecma_length_t length = 0;
-  lit_utf8_size_t size = 0;
+  lit_utf8_size_t size = lit_utf8_ascii_prefix_size (utf8_buf_p, utf8_buf_size);
+  ecma_length_t length = size;
 
   while (size < utf8_buf_size)
   {
     size += lit_get_unicode_char_size_by_utf8_first_byte (*(utf8_buf_p + size));
     length++;
+
+    lit_utf8_size_t ascii_size = lit_utf8_ascii_prefix_size (utf8_buf_p + size, utf8_buf_size - size);
+    size += ascii_size;
+    length += ascii_size;
   }
 
   JERRY_ASSERT (size == utf8_buf_size);
@@ -295,6 +365,16 @@ lit_get_utf8_size_of_cesu8_string (const lit_utf8_byte_t *cesu8_buf_p, /**< cesu
 
   while (offset < cesu8_buf_size)
   {
+    lit_utf8_size_t ascii_size = lit_utf8_ascii_prefix_size (cesu8_buf_p + offset, cesu8_buf_size - offset);
+
+    if (ascii_size > 0)
+    {
+      /* Surrogates are not ASCII, so the sizes do not change. */
+      offset += ascii_size;
+      prev_ch = 0;
+      continue;
+    }
+
     ecma_char_t ch;
     offset += lit_read_code_unit_from_utf8 (cesu8_buf_p + offset, &ch);
 
@@ -326,6 +406,16 @@ lit_get_utf8_length_of_cesu8_string (const lit_utf8_byte_t *cesu8_buf_p, /**< ce
 
   while (offset < cesu8_buf_size)
   {
+    lit_utf8_size_t ascii_size = lit_utf8_ascii_prefix_size (cesu8_buf_p + offset, cesu8_buf_size - offset);
+
+    if (ascii_size > 0)
+    {
+      offset += ascii_size;
+      utf8_length += ascii_size;
+      prev_ch = 0;
+      continue;
+    }
+
     ecma_char_t ch;
     offset += lit_read_code_unit_from_utf8 (cesu8_buf_p + offset, &ch);
 
@@ -804,6 +894,19 @@ lit_convert_cesu8_string_to_utf8_string (const lit_utf8_byte_t *cesu8_string, /*
 
   while (cesu8_pos < cesu8_end_pos)
   {
+    lit_utf8_size_t ascii_size = lit_utf8_ascii_prefix_size (cesu8_pos, (lit_utf8_size_t) (cesu8_end_pos - cesu8_pos));
+
+    if (ascii_size > 0)
+    {
+      memcpy (utf8_pos, cesu8_pos, ascii_size);
+      size += ascii_size;
+      utf8_pos = utf8_string + size;
+      cesu8_pos += ascii_size;
+      prev_ch = 0;
+      prev_ch_size = 0;
+      continue;
+    }
+
     ecma_char_t ch;
     lit_utf8_size_t code_unit_size = lit_read_code_unit_from_utf8 (cesu8_pos, &ch);
 
@@ -93,6 +93,7 @@ bool lit_is_code_point_utf16_low_surrogate (lit_code_point_t code_point);
 bool lit_is_code_point_utf16_high_surrogate (lit_code_point_t code_point);
 
 /* size */
+lit_utf8_size_t lit_utf8_ascii_prefix_size (const lit_utf8_byte_t *buf_p, lit_utf8_size_t buf_size);
 lit_utf8_size_t lit_zt_utf8_string_size (const lit_utf8_byte_t *utf8_str_p);
 lit_utf8_size_t lit_get_utf8_size_of_cesu8_string (const lit_utf8_byte_t *cesu8_buf_p, lit_utf8_size_t cesu8_buf_size);
 
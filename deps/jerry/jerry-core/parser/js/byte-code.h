@@ -200,7 +200,7 @@
 /* Stack consumption of opcodes with context. */
 
 /* PARSER_FOR_IN_CONTEXT_STACK_ALLOCATION must be <= 4 */
-#define PARSER_FOR_IN_CONTEXT_STACK_ALLOCATION 3
+#define PARSER_FOR_IN_CONTEXT_STACK_ALLOCATION 4
 /* PARSER_WITH_CONTEXT_STACK_ALLOCATION must be <= 4 */
 #define PARSER_WITH_CONTEXT_STACK_ALLOCATION 2
 /* PARSER_TRY_CONTEXT_STACK_ALLOCATION must be <= 3 */
@@ -539,6 +539,12 @@
   /* Basic opcodes. */ \
   CBC_OPCODE (CBC_EXT_DEBUGGER, CBC_NO_FLAG, 0, \
               VM_OC_NONE) \
+  CBC_OPCODE (CBC_EXT_PUSH_ARGUMENTS_LENGTH, CBC_NO_FLAG, 1, \
+              VM_OC_ARGUMENTS_LENGTH | VM_OC_PUT_STACK) \
+  CBC_OPCODE (CBC_EXT_PUSH_ARGUMENT, CBC_NO_FLAG, 0, \
+              VM_OC_ARGUMENT_GET | VM_OC_GET_STACK | VM_OC_PUT_STACK) \
+  CBC_OPCODE (CBC_EXT_PUSH_LITERAL_BASE, CBC_HAS_LITERAL_ARG, 1, \
+              VM_OC_PUSH_LITERAL_BASE | VM_OC_GET_LITERAL) \
   \
   /* Binary compound assignment opcodes with pushing the result. */ \
   CBC_EXT_BINARY_LVALUE_OPERATION (CBC_EXT_ASSIGN_ADD, \
@@ -654,8 +660,33 @@ typedef enum
   CBC_CODE_FLAGS_ARGUMENTS_NEEDED = (1u << 4), /**< arguments object must be constructed */
   CBC_CODE_FLAGS_LEXICAL_ENV_NOT_NEEDED = (1u << 5), /**< no need to create a lexical environment */
   CBC_CODE_FLAGS_DEBUGGER_IGNORE = (1u << 6), /**< this function should be ignored by debugger */
+  CBC_CODE_FLAGS_LAZY_FUNCTION = (1u << 7), /**< compiled code data is cbc_lazy_function_t */
 } cbc_code_flags;
 
+#if defined (CONFIG_PARSER_LAZY_FUNCTIONS) && JERRY_JS_PARSER \
+    && !defined (JERRY_ENABLE_SNAPSHOT_SAVE) && !defined (JERRY_DEBUGGER)
+/**
+ * Functions are compiled when they are called first.
+ */
+#define PARSER_LAZY_FUNCTIONS
+#endif /* CONFIG_PARSER_LAZY_FUNCTIONS && JERRY_JS_PARSER && !JERRY_ENABLE_SNAPSHOT_SAVE && !JERRY_DEBUGGER */
+
+/**
+ * Function which is not compiled yet.
+ *
+ * Only argument_end is set in the header, other groups are empty.
+ */
+typedef struct
+{
+  cbc_uint8_arguments_t header;     /**< compiled code header */
+  jmem_cpointer_t bytecode_cp;      /**< byte code of the function after the first call */
+  jmem_cpointer_t source_cp;        /**< source of the function before the first call */
+  uint32_t source_size;             /**< size of the source */
+  uint32_t status_flags;            /**< parser status flags of the function */
+  uint32_t line;                    /**< line of the source start */
+  uint32_t column;                  /**< column of the source start */
+} cbc_lazy_function_t;
+
 #define CBC_OPCODE(arg1, arg2, arg3, arg4) arg1,
 
 /**
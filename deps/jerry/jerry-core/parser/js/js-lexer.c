@@ -1531,62 +1531,94 @@ lexer_construct_literal_object (parser_context_t *context_p, /**< context */
   JERRY_ASSERT (context_p->allocated_buffer_p == NULL);
 } /* lexer_construct_literal_object */
 
-#undef LEXER_MAX_LITERAL_LOCAL_BUFFER_SIZE
-
 /**
- * Construct a number object.
+ * Construct a string literal object from the concatenation of two string literals.
  *
- * @return true if number is small number
+ * @return true - if the literal is constructed,
+ *         false - if the concatenated string is too long
  */
 bool
-lexer_construct_number_object (parser_context_t *context_p, /**< context */
-                               bool push_number_allowed, /**< push number support is allowed */
-                               bool is_negative_number) /**< sign is negative */
+lexer_construct_string_concatenation (parser_context_t *context_p, /**< context */
+                                      uint16_t left_index, /**< index of the left string literal */
+                                      uint16_t right_index) /**< index of the right string literal */
 {
-  parser_list_iterator_t literal_iterator;
-  lexer_literal_t *literal_p;
-  ecma_number_t num;
-  uint32_t literal_index = 0;
-  uint16_t length = context_p->token.lit_location.length;
+  lexer_literal_t *left_p = PARSER_GET_LITERAL (left_index);
+  lexer_literal_t *right_p = PARSER_GET_LITERAL (right_index);
+  size_t length = (size_t) left_p->prop.length + right_p->prop.length;
 
-  if (context_p->token.extra_value != LEXER_NUMBER_OCTAL)
+  JERRY_ASSERT (left_p->type == LEXER_STRING_LITERAL
+                && right_p->type == LEXER_STRING_LITERAL);
+  JERRY_ASSERT (context_p->allocated_buffer_p == NULL);
+
+  if (length > PARSER_MAXIMUM_STRING_LENGTH)
   {
-    num = ecma_utf8_string_to_number (context_p->token.lit_location.char_p,
-                                      length);
+    return false;
   }
-  else
-  {
-    const uint8_t *src_p = context_p->token.lit_location.char_p;
-    const uint8_t *src_end_p = src_p + length - 1;
 
-    num = 0;
-    do
-    {
-      src_p++;
-      num = num * 8 + (ecma_number_t) (*src_p - LIT_CHAR_0);
-    }
-    while (src_p < src_end_p);
+  if (length == 0)
+  {
+    lexer_process_char_literal (context_p, left_p->u.char_p, 0, LEXER_STRING_LITERAL, false);
+    context_p->lit_object.type = LEXER_LITERAL_OBJECT_ANY;
+    return true;
   }
 
-  if (push_number_allowed)
-  {
-    int32_t int_num = (int32_t) num;
+  uint8_t *destination_p = (uint8_t *) parser_malloc_local (context_p, length);
+  context_p->allocated_buffer_p = destination_p;
+  context_p->allocated_buffer_size = (uint32_t) length;
 
-    if (int_num == num)
-    {
-      if (int_num <= CBC_PUSH_NUMBER_BYTE_RANGE_END
-          && (int_num != 0 || !is_negative_number))
-      {
-        context_p->lit_object.index = (uint16_t) int_num;
-        return true;
-      }
-    }
+  memcpy (destination_p, left_p->u.char_p, left_p->prop.length);
+  memcpy (destination_p + left_p->prop.length, right_p->u.char_p, right_p->prop.length);
+
+  /* The characters are copied, since the buffer is freed below. */
+  lexer_process_char_literal (context_p, destination_p, length, LEXER_STRING_LITERAL, true);
+  context_p->lit_object.type = LEXER_LITERAL_OBJECT_ANY;
+
+  context_p->allocated_buffer_p = NULL;
+  parser_free_local (destination_p, length);
+  return true;
+} /* lexer_construct_string_concatenation */
+
+#undef LEXER_MAX_LITERAL_LOCAL_BUFFER_SIZE
+
+/**
+ * Get the value of the current number token.
+ *
+ * @return value of the number
+ */
+ecma_number_t
+lexer_get_number_value (parser_context_t *context_p) /**< context */
+{
+  uint16_t length = context_p->token.lit_location.length;
+
+  if (context_p->token.extra_value != LEXER_NUMBER_OCTAL)
+  {
+    return ecma_utf8_string_to_number (context_p->token.lit_location.char_p, length);
   }
 
-  if (is_negative_number)
+  const uint8_t *src_p = context_p->token.lit_location.char_p;
+  const uint8_t *src_end_p = src_p + length - 1;
+  ecma_number_t num = 0;
+
+  do
   {
-    num = -num;
+    src_p++;
+    num = num * 8 + (ecma_number_t) (*src_p - LIT_CHAR_0);
   }
+  while (src_p < src_end_p);
+
+  return num;
+} /* lexer_get_number_value */
+
+/**
+ * Search or append a number to the literal pool.
+ */
+void
+lexer_construct_number_literal (parser_context_t *context_p, /**< context */
+                                ecma_number_t num) /**< number */
+{
+  parser_list_iterator_t literal_iterator;
+  lexer_literal_t *literal_p;
+  uint32_t literal_index = 0;
 
   jmem_cpointer_t lit_cp = ecma_find_or_create_literal_number (num);
   parser_list_iterator_init (&context_p->literal_pool, &literal_iterator);
@@ -1599,7 +1631,7 @@ lexer_construct_number_object (parser_context_t *context_p, /**< context */
       context_p->lit_object.literal_p = literal_p;
       context_p->lit_object.index = (uint16_t) literal_index;
       context_p->lit_object.type = LEXER_LITERAL_OBJECT_ANY;
-      return false;
+      return;
     }
 
     literal_index++;
@@ -1613,7 +1645,7 @@ lexer_construct_number_object (parser_context_t *context_p, /**< context */
   }
 
   literal_p = (lexer_literal_t *) parser_list_append (context_p, &context_p->literal_pool);
-  literal_p->prop.length = context_p->token.lit_location.length;
+  literal_p->prop.length = 0;
   literal_p->type = LEXER_UNUSED_LITERAL;
   literal_p->status_flags = 0;
 
@@ -1625,7 +1657,41 @@ lexer_construct_number_object (parser_context_t *context_p, /**< context */
   context_p->lit_object.literal_p = literal_p;
   context_p->lit_object.index = (uint16_t) literal_index;
   context_p->lit_object.type = LEXER_LITERAL_OBJECT_ANY;
+} /* lexer_construct_number_literal */
+
+/**
+ * Construct a number object.
+ *
+ * @return true if number is small number
+ */
+bool
+lexer_construct_number_object (parser_context_t *context_p, /**< context */
+                               bool push_number_allowed, /**< push number support is allowed */
+                               bool is_negative_number) /**< sign is negative */
+{
+  ecma_number_t num = lexer_get_number_value (context_p);
+
+  if (push_number_allowed)
+  {
+    int32_t int_num = (int32_t) num;
+
+    if (int_num == num)
+    {
+      if (int_num <= CBC_PUSH_NUMBER_BYTE_RANGE_END
+          && (int_num != 0 || !is_negative_number))
+      {
+        context_p->lit_object.index = (uint16_t) int_num;
+        return true;
+      }
+    }
+  }
+
+  if (is_negative_number)
+  {
+    num = -num;
+  }
 
+  lexer_construct_number_literal (context_p, num);
   return false;
 } /* lexer_construct_number_object */
 
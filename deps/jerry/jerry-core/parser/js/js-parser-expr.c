@@ -13,6 +13,9 @@
  * limitations under the License.
  */
 
+#include "ecma-helpers.h"
+#include "ecma-number-arithmetic.h"
+#include "jcontext.h"
 #include "js-parser-internal.h"
 
 #if JERRY_JS_PARSER
@@ -454,6 +457,277 @@ parser_parse_object_literal (parser_context_t *context_p) /**< context */
   parser_stack_pop_uint8 (context_p);
 } /* parser_parse_object_literal */
 
+/**
+ * Checks whether the last byte code pushes a number constant and gets its value.
+ *
+ * @return true - if the last byte code pushes a number constant
+ *         false - otherwise
+ */
+static bool
+parser_get_pushed_number (parser_context_t *context_p, /**< context */
+                          ecma_number_t *num_p) /**< [out] number value */
+{
+  switch (context_p->last_cbc_opcode)
+  {
+    case CBC_PUSH_NUMBER_0:
+    {
+      *num_p = ECMA_NUMBER_ZERO;
+      return true;
+    }
+    case CBC_PUSH_NUMBER_POS_BYTE:
+    {
+      *num_p = (ecma_number_t) (context_p->last_cbc.value + 1);
+      return true;
+    }
+    case CBC_PUSH_NUMBER_NEG_BYTE:
+    {
+      *num_p = -((ecma_number_t) (context_p->last_cbc.value + 1));
+      return true;
+    }
+    case CBC_PUSH_LITERAL:
+    {
+      if (context_p->last_cbc.literal_type != LEXER_NUMBER_LITERAL)
+      {
+        return false;
+      }
+
+      lexer_literal_t *literal_p = PARSER_GET_LITERAL (context_p->last_cbc.literal_index);
+      ecma_string_t *string_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, literal_p->u.value);
+
+      *num_p = ecma_get_number_from_value (string_p->u.lit_number);
+      return true;
+    }
+    default:
+    {
+      return false;
+    }
+  }
+} /* parser_get_pushed_number */
+
+/**
+ * Checks whether the number literal of the current token is the whole right
+ * operand of the binary operator on the top of the stack.
+ *
+ * Note:
+ *   the next token is scanned and the lexer is restored afterwards, which
+ *   is safe since only the construct functions create literals
+ *
+ * @return true - if the operation can be computed by the parser
+ *         false - otherwise
+ */
+static bool
+parser_is_right_operand_complete (parser_context_t *context_p, /**< context */
+                                  uint8_t operator_type) /**< binary operator */
+{
+  lexer_token_t token = context_p->token;
+  const uint8_t *source_p = context_p->source_p;
+  parser_line_counter_t line = context_p->line;
+  parser_line_counter_t column = context_p->column;
+  bool is_complete = true;
+
+  lexer_next_token (context_p);
+
+  switch (context_p->token.type)
+  {
+    case LEXER_DOT:
+    case LEXER_LEFT_SQUARE:
+    case LEXER_LEFT_PAREN:
+    {
+      is_complete = false;
+      break;
+    }
+    case LEXER_INCREASE:
+    case LEXER_DECREASE:
+    {
+      is_complete = context_p->token.was_newline;
+      break;
+    }
+    default:
+    {
+      if (LEXER_IS_BINARY_OP_TOKEN (context_p->token.type)
+          && !LEXER_IS_BINARY_LVALUE_TOKEN (context_p->token.type))
+      {
+        uint8_t next_precedence = parser_binary_precedence_table[context_p->token.type - LEXER_FIRST_BINARY_OP];
+
+        is_complete = (next_precedence <= parser_binary_precedence_table[operator_type - LEXER_FIRST_BINARY_OP]);
+      }
+      break;
+    }
+  }
+
+  context_p->token = token;
+  context_p->source_p = source_p;
+  context_p->line = line;
+  context_p->column = column;
+  return is_complete;
+} /* parser_is_right_operand_complete */
+
+/**
+ * Computes a binary operation on number constants the same way as the VM.
+ *
+ * @return result of the operation
+ */
+static ecma_number_t
+parser_compute_number_operation (uint8_t operator_type, /**< binary operator */
+                                 ecma_number_t left_num, /**< left operand */
+                                 ecma_number_t right_num) /**< right operand */
+{
+  switch (operator_type)
+  {
+    case LEXER_ADD:
+    {
+      return ecma_number_add (left_num, right_num);
+    }
+    case LEXER_SUBTRACT:
+    {
+      return ecma_number_substract (left_num, right_num);
+    }
+    case LEXER_MULTIPLY:
+    {
+      return ecma_number_multiply (left_num, right_num);
+    }
+    case LEXER_DIVIDE:
+    {
+      return ecma_number_divide (left_num, right_num);
+    }
+    case LEXER_MODULO:
+    {
+      return ecma_op_number_remainder (left_num, right_num);
+    }
+    default:
+    {
+      break;
+    }
+  }
+
+  uint32_t left_uint32 = ecma_number_to_uint32 (left_num);
+  uint32_t right_uint32 = ecma_number_to_uint32 (right_num);
+
+  switch (operator_type)
+  {
+    case LEXER_BIT_OR:
+    {
+      return (ecma_number_t) ((int32_t) (left_uint32 | right_uint32));
+    }
+    case LEXER_BIT_XOR:
+    {
+      return (ecma_number_t) ((int32_t) (left_uint32 ^ right_uint32));
+    }
+    case LEXER_BIT_AND:
+    {
+      return (ecma_number_t) ((int32_t) (left_uint32 & right_uint32));
+    }
+    case LEXER_LEFT_SHIFT:
+    {
+      return (ecma_number_t) ((int32_t) (left_uint32 << (right_uint32 & 0x1f)));
+    }
+    case LEXER_RIGHT_SHIFT:
+    {
+      return (ecma_number_t) (ecma_number_to_int32 (left_num) >> (right_uint32 & 0x1f));
+    }
+    default:
+    {
+      JERRY_ASSERT (operator_type == LEXER_UNS_RIGHT_SHIFT);
+      return (ecma_number_t) (left_uint32 >> (right_uint32 & 0x1f));
+    }
+  }
+} /* parser_compute_number_operation */
+
+/**
+ * Emit a byte code which pushes a number constant.
+ */
+static void
+parser_emit_number (parser_context_t *context_p, /**< context */
+                    ecma_number_t num) /**< number value */
+{
+  if (num >= -CBC_PUSH_NUMBER_BYTE_RANGE_END
+      && num <= CBC_PUSH_NUMBER_BYTE_RANGE_END)
+  {
+    int32_t int_num = (int32_t) num;
+
+    if ((ecma_number_t) int_num == num)
+    {
+      if (int_num == 0)
+      {
+        if (!ecma_number_is_negative (num))
+        {
+          parser_emit_cbc (context_p, CBC_PUSH_NUMBER_0);
+          return;
+        }
+      }
+      else
+      {
+        bool is_negative_number = (int_num < 0);
+
+        context_p->lit_object.index = (uint16_t) (is_negative_number ? -int_num : int_num);
+        parser_emit_cbc_push_number (context_p, is_negative_number);
+        return;
+      }
+    }
+  }
+
+  lexer_construct_number_literal (context_p, num);
+  parser_emit_cbc_literal (context_p, CBC_PUSH_LITERAL, context_p->lit_object.index);
+  context_p->last_cbc.literal_type = LEXER_NUMBER_LITERAL;
+  context_p->last_cbc.literal_object_type = LEXER_LITERAL_OBJECT_ANY;
+} /* parser_emit_number */
+
+/**
+ * Computes the binary operation on the top of the stack when both
+ * operands are number constants, e.g. 60 * 60 * 1000 is parsed as
+ * a single constant.
+ *
+ * @return true - if the operation is computed
+ *         false - otherwise
+ */
+static bool
+parser_fold_number_operation (parser_context_t *context_p, /**< context */
+                              bool is_negative_number) /**< sign of the right operand */
+{
+  uint8_t operator_type = context_p->stack_top_uint8;
+  ecma_number_t left_num;
+
+  switch (operator_type)
+  {
+    case LEXER_BIT_OR:
+    case LEXER_BIT_XOR:
+    case LEXER_BIT_AND:
+    case LEXER_LEFT_SHIFT:
+    case LEXER_RIGHT_SHIFT:
+    case LEXER_UNS_RIGHT_SHIFT:
+    case LEXER_ADD:
+    case LEXER_SUBTRACT:
+    case LEXER_MULTIPLY:
+    case LEXER_DIVIDE:
+    case LEXER_MODULO:
+    {
+      break;
+    }
+    default:
+    {
+      return false;
+    }
+  }
+
+  if (!parser_get_pushed_number (context_p, &left_num)
+      || !parser_is_right_operand_complete (context_p, operator_type))
+  {
+    return false;
+  }
+
+  ecma_number_t right_num = lexer_get_number_value (context_p);
+
+  if (is_negative_number)
+  {
+    right_num = -right_num;
+  }
+
+  parser_stack_pop_uint8 (context_p);
+  context_p->last_cbc_opcode = PARSER_CBC_UNAVAILABLE;
+  parser_emit_number (context_p, parser_compute_number_operation (operator_type, left_num, right_num));
+  return true;
+} /* parser_fold_number_operation */
+
 /**
  * Parse and record unary operators, and parse the primary literal.
  */
@@ -508,9 +782,26 @@ parser_parse_unary_expression (parser_context_t *context_p, /**< context */
       if (context_p->token.lit_location.type == LEXER_IDENT_LITERAL
           || context_p->token.lit_location.type == LEXER_STRING_LITERAL)
       {
+        uint32_t status_flags = context_p->status_flags;
+
         lexer_construct_literal_object (context_p,
                                         &context_p->token.lit_location,
                                         context_p->token.lit_location.type);
+
+        if (context_p->lit_object.type == LEXER_LITERAL_OBJECT_ARGUMENTS
+            && !(status_flags & (PARSER_ARGUMENTS_NEEDED | PARSER_ARGUMENTS_NOT_NEEDED | PARSER_INSIDE_WITH))
+            && !LEXER_IS_UNARY_LVALUE_OP_TOKEN (context_p->stack_top_uint8)
+            && context_p->stack_top_uint8 != LEXER_LEFT_PAREN)
+        {
+          /* The arguments object is not created until the postfix
+           * part shows that the object itself is needed. This push
+           * is not merged, so parser_parse_arguments_access can drop it. */
+          context_p->status_flags &= ~(PARSER_ARGUMENTS_NEEDED | PARSER_LEXICAL_ENV_NEEDED);
+          context_p->status_flags |= status_flags & PARSER_LEXICAL_ENV_NEEDED;
+
+          parser_emit_cbc_literal_from_token (context_p, CBC_PUSH_LITERAL);
+          break;
+        }
       }
       else if (context_p->token.lit_location.type == LEXER_NUMBER_LITERAL)
       {
@@ -526,6 +817,11 @@ parser_parse_unary_expression (parser_context_t *context_p, /**< context */
           parser_stack_pop_uint8 (context_p);
         }
 
+        if (parser_fold_number_operation (context_p, is_negative_number))
+        {
+          break;
+        }
+
         if (lexer_construct_number_object (context_p, true, is_negative_number))
         {
           JERRY_ASSERT (context_p->lit_object.index <= CBC_PUSH_NUMBER_BYTE_RANGE_END);
@@ -696,6 +992,104 @@ parser_parse_unary_expression (parser_context_t *context_p, /**< context */
   lexer_next_token (context_p);
 } /* parser_parse_unary_expression */
 
+/**
+ * Checks whether the token after a property access of the arguments object
+ * uses the access as a reference (an assignment, a call or a for-in target),
+ * which needs the object itself. The target of for-in is parsed from a source
+ * range, which ends before the in keyword.
+ *
+ * @return true - if the access is used as a reference, false - otherwise
+ */
+static inline bool
+parser_is_arguments_reference (uint8_t token_type) /**< token after the access */
+{
+  return (LEXER_IS_BINARY_LVALUE_TOKEN (token_type)
+          || token_type == LEXER_INCREASE
+          || token_type == LEXER_DECREASE
+          || token_type == LEXER_LEFT_PAREN
+          || token_type == LEXER_EOS);
+} /* parser_is_arguments_reference */
+
+/**
+ * Parse the arguments.length and arguments[index] accesses, which read the
+ * arguments of the call without creating an arguments object. Any other use
+ * of the arguments identifier needs the object.
+ *
+ * @return true - if the postfix part of the expression is processed,
+ *         false - otherwise
+ */
+static bool
+parser_parse_arguments_access (parser_context_t *context_p) /**< context */
+{
+  if (context_p->last_cbc_opcode != CBC_PUSH_LITERAL
+      || context_p->last_cbc.literal_object_type != LEXER_LITERAL_OBJECT_ARGUMENTS
+      || (context_p->status_flags & (PARSER_ARGUMENTS_NEEDED | PARSER_ARGUMENTS_NOT_NEEDED)))
+  {
+    return false;
+  }
+
+  if (context_p->token.type == LEXER_DOT)
+  {
+    lexer_expect_identifier (context_p, LEXER_STRING_LITERAL);
+    JERRY_ASSERT (context_p->token.type == LEXER_LITERAL
+                  && context_p->token.lit_location.type == LEXER_STRING_LITERAL);
+
+    lexer_literal_t *literal_p = context_p->lit_object.literal_p;
+    uint16_t literal_index = context_p->lit_object.index;
+    bool is_length = (literal_p->prop.length == 6 && memcmp (literal_p->u.char_p, "length", 6) == 0);
+
+    lexer_next_token (context_p);
+
+    if (is_length && !parser_is_arguments_reference (context_p->token.type))
+    {
+      context_p->last_cbc_opcode = PARSER_CBC_UNAVAILABLE;
+      parser_emit_cbc_ext (context_p, CBC_EXT_PUSH_ARGUMENTS_LENGTH);
+      context_p->status_flags |= PARSER_ARGUMENTS_FAST_ACCESS;
+      return true;
+    }
+
+    context_p->status_flags |= PARSER_ARGUMENTS_NEEDED | PARSER_LEXICAL_ENV_NEEDED;
+
+    JERRY_ASSERT (CBC_ARGS_EQ (CBC_PUSH_PROP_LITERAL_LITERAL,
+                               CBC_HAS_LITERAL_ARG | CBC_HAS_LITERAL_ARG2));
+    context_p->last_cbc_opcode = CBC_PUSH_PROP_LITERAL_LITERAL;
+    context_p->last_cbc.value = literal_index;
+    return true;
+  }
+
+  if (context_p->token.type == LEXER_LEFT_SQUARE)
+  {
+    uint16_t literal_index = context_p->last_cbc.literal_index;
+
+    /* The index is evaluated first, the object is pushed under it if needed. */
+    context_p->last_cbc_opcode = PARSER_CBC_UNAVAILABLE;
+
+    lexer_next_token (context_p);
+    parser_parse_expression (context_p, PARSE_EXPR);
+    if (context_p->token.type != LEXER_RIGHT_SQUARE)
+    {
+      parser_raise_error (context_p, PARSER_ERR_RIGHT_SQUARE_EXPECTED);
+    }
+    lexer_next_token (context_p);
+
+    if (!parser_is_arguments_reference (context_p->token.type))
+    {
+      parser_emit_cbc_ext (context_p, CBC_EXT_PUSH_ARGUMENT);
+      context_p->status_flags |= PARSER_ARGUMENTS_FAST_ACCESS;
+      return true;
+    }
+
+    context_p->status_flags |= PARSER_ARGUMENTS_NEEDED | PARSER_LEXICAL_ENV_NEEDED;
+
+    parser_emit_cbc_ext_literal (context_p, CBC_EXT_PUSH_LITERAL_BASE, literal_index);
+    parser_emit_cbc (context_p, CBC_PUSH_PROP);
+    return true;
+  }
+
+  context_p->status_flags |= PARSER_ARGUMENTS_NEEDED | PARSER_LEXICAL_ENV_NEEDED;
+  return false;
+} /* parser_parse_arguments_access */
+
 /**
  * Parse the postfix part of unary operators, and
  * generate byte code for the whole expression.
@@ -706,6 +1100,11 @@ parser_process_unary_expression (parser_context_t *context_p) /**< context */
   /* Parse postfix part of a primary expression. */
   while (true)
   {
+    if (parser_parse_arguments_access (context_p))
+    {
+      continue;
+    }
+
     /* Since break would only break the switch, we use
      * continue to continue this loop. Without continue,
      * the code abandons the loop. */
@@ -1233,6 +1632,36 @@ parser_append_binary_token (parser_context_t *context_p) /**< context */
   parser_stack_push_uint8 (context_p, context_p->token.type);
 } /* parser_append_binary_token */
 
+/**
+ * Replaces the two string literals pushed by the last byte code with their
+ * concatenation. The original literals are dropped later if they are not
+ * used anywhere else.
+ *
+ * @return true - if the concatenation is constructed
+ *         false - otherwise
+ */
+static bool
+parser_fold_string_concatenation (parser_context_t *context_p) /**< context */
+{
+  JERRY_ASSERT (context_p->last_cbc_opcode == CBC_PUSH_TWO_LITERALS);
+
+  uint16_t left_index = context_p->last_cbc.literal_index;
+  uint16_t right_index = context_p->last_cbc.value;
+
+  if (PARSER_GET_LITERAL (left_index)->type != LEXER_STRING_LITERAL
+      || PARSER_GET_LITERAL (right_index)->type != LEXER_STRING_LITERAL
+      || !lexer_construct_string_concatenation (context_p, left_index, right_index))
+  {
+    return false;
+  }
+
+  context_p->last_cbc_opcode = CBC_PUSH_LITERAL;
+  context_p->last_cbc.literal_index = context_p->lit_object.index;
+  context_p->last_cbc.literal_type = LEXER_STRING_LITERAL;
+  context_p->last_cbc.literal_object_type = LEXER_LITERAL_OBJECT_ANY;
+  return true;
+} /* parser_fold_string_concatenation */
+
 /**
  * Emit opcode for binary computations.
  */
@@ -1321,6 +1750,14 @@ parser_process_binary_opcodes (parser_context_t *context_p, /**< context */
     {
       opcode = LEXER_BINARY_OP_TOKEN_TO_OPCODE (token);
 
+      if (token == LEXER_ADD
+          && context_p->last_cbc_opcode == CBC_PUSH_TWO_LITERALS
+          && (JERRY_CONTEXT (jerry_init_flags) & ECMA_INIT_PARSER_OPTIMIZE)
+          && parser_fold_string_concatenation (context_p))
+      {
+        continue;
+      }
+
       if (context_p->last_cbc_opcode == CBC_PUSH_LITERAL)
       {
         JERRY_ASSERT (CBC_SAME_ARGS (context_p->last_cbc_opcode, opcode + CBC_BINARY_WITH_LITERAL));
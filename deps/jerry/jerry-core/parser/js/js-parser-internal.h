@@ -53,6 +53,8 @@
 #define PARSER_LEXICAL_ENV_NEEDED             0x08000u
 #define PARSER_HAS_LATE_LIT_INIT              0x10000u
 #define PARSER_DEBUGGER_BREAKPOINT_APPENDED   0x20000u
+#define PARSER_LAZY_FUNCTION_SCAN             0x40000u
+#define PARSER_ARGUMENTS_FAST_ACCESS          0x80000u
 
 /* Expression parsing flags. */
 #define PARSE_EXPR                            0x00
@@ -192,6 +194,17 @@ typedef struct parser_branch_node_t
   parser_branch_t branch;                     /**< branch */
 } parser_branch_node_t;
 
+/**
+ * Saved end of the byte code stream.
+ */
+typedef struct
+{
+  parser_mem_page_t *page_p;                  /**< last page */
+  uint32_t last_position;                     /**< position of the last allocated byte */
+  uint32_t byte_code_size;                    /**< byte code size */
+  uint32_t status_flags;                      /**< PARSER_NO_END_LABEL flag */
+} parser_code_position_t;
+
 #ifdef JERRY_DEBUGGER
 /**
  * Extra information for each breakpoint.
@@ -369,6 +382,8 @@ void parser_emit_cbc_backward_branch (parser_context_t *context_p, uint16_t opco
 void parser_set_branch_to_current_position (parser_context_t *context_p, parser_branch_t *branch_p);
 void parser_set_breaks_to_current_position (parser_context_t *context_p, parser_branch_node_t *current_p);
 void parser_set_continues_to_current_position (parser_context_t *context_p, parser_branch_node_t *current_p);
+void parser_save_code_position (parser_context_t *context_p, parser_code_position_t *position_p);
+void parser_remove_code (parser_context_t *context_p, parser_code_position_t *position_p);
 
 /* Convenience macros. */
 #define parser_emit_cbc_ext(context_p, opcode) \
@@ -398,7 +413,10 @@ ecma_char_t lexer_hex_to_character (parser_context_t *context_p, const uint8_t *
 void lexer_expect_object_literal_id (parser_context_t *context_p, bool must_be_identifier);
 void lexer_construct_literal_object (parser_context_t *context_p, lexer_lit_location_t *literal_p,
                                      uint8_t literal_type);
+ecma_number_t lexer_get_number_value (parser_context_t *context_p);
+void lexer_construct_number_literal (parser_context_t *context_p, ecma_number_t num);
 bool lexer_construct_number_object (parser_context_t *context_p, bool push_number_allowed, bool is_negative_number);
+bool lexer_construct_string_concatenation (parser_context_t *context_p, uint16_t left_index, uint16_t right_index);
 uint16_t lexer_construct_function_object (parser_context_t *context_p, uint32_t extra_status_flags);
 void lexer_construct_regexp_object (parser_context_t *context_p, bool parse_only);
 bool lexer_compare_identifier_to_current (parser_context_t *context_p, const lexer_lit_location_t *right);
@@ -296,6 +296,7 @@ parser_scan_primary_expression_end (parser_context_t *context_p, /**< context */
   /* Check whether we can enter to statement mode. */
   if (stack_top != SCAN_STACK_BLOCK_STATEMENT
       && stack_top != SCAN_STACK_BLOCK_EXPRESSION
+      && stack_top != SCAN_STACK_BLOCK_PROPERTY
       && !(stack_top == SCAN_STACK_HEAD && end_type == LEXER_SCAN_SWITCH))
   {
     parser_raise_error (context_p, PARSER_ERR_INVALID_EXPRESSION);
@@ -381,7 +382,8 @@ parser_scan_statement (parser_context_t *context_p, /**< context */
     {
       lexer_next_token (context_p);
       if (!context_p->token.was_newline
-          && context_p->token.type != LEXER_SEMICOLON)
+          && context_p->token.type != LEXER_SEMICOLON
+          && context_p->token.type != LEXER_RIGHT_BRACE)
       {
         *mode = SCAN_MODE_PRIMARY_EXPRESSION;
       }
@@ -532,6 +534,24 @@ parser_scan_until (parser_context_t *context_p, /**< context */
       return;
     }
 
+#ifdef PARSER_LAZY_FUNCTIONS
+    if ((context_p->status_flags & PARSER_LAZY_FUNCTION_SCAN)
+        && type == LEXER_LITERAL
+        && context_p->token.lit_location.type == LEXER_IDENT_LITERAL)
+    {
+      /* The identifiers of a lazy function are copied to the parent function
+       * to keep them out of the registers of the parent function. */
+      lexer_construct_literal_object (context_p,
+                                      &context_p->token.lit_location,
+                                      LEXER_IDENT_LITERAL);
+
+      if (context_p->lit_object.type == LEXER_LITERAL_OBJECT_EVAL)
+      {
+        context_p->status_flags |= PARSER_NO_REG_STORE;
+      }
+    }
+#endif /* PARSER_LAZY_FUNCTIONS */
+
     switch (mode)
     {
       case SCAN_MODE_PRIMARY_EXPRESSION:
@@ -653,8 +673,12 @@ parser_scan_until (parser_context_t *context_p, /**< context */
             || context_p->token.type == LEXER_PROPERTY_SETTER)
         {
           parser_stack_push_uint8 (context_p, SCAN_STACK_BLOCK_PROPERTY);
+
+          /* The name of the accessor can be any property name. */
+          lexer_scan_identifier (context_p, true);
+          lexer_next_token (context_p);
           mode = SCAN_MODE_FUNCTION_ARGUMENTS;
-          break;
+          continue;
         }
 
         lexer_next_token (context_p);
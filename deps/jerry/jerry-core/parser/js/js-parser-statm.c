@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include "ecma-helpers.h"
 #include "js-parser-internal.h"
 
 #if JERRY_JS_PARSER
@@ -93,9 +94,21 @@ typedef struct
  */
 typedef struct
 {
-  parser_branch_t branch;                 /**< branch to the end */
+  parser_branch_t branch;                 /**< branch to the end, page_p is NULL if there is no branch */
+  parser_code_position_t dead_code_start; /**< start of the code which is never executed */
+  bool is_dead_code;                      /**< the statement body is never executed */
 } parser_if_else_statement_t;
 
+/**
+ * Value of a condition known by the parser.
+ */
+typedef enum
+{
+  PARSER_CONDITION_UNKNOWN,               /**< the value is known at run time only */
+  PARSER_CONDITION_FALSE,                 /**< the value is always false */
+  PARSER_CONDITION_TRUE,                  /**< the value is always true */
+} parser_condition_value_t;
+
 /**
  * Switch statement.
  */
@@ -468,6 +481,156 @@ parser_parse_function_statement (parser_context_t *context_p) /**< context */
   lexer_next_token (context_p);
 } /* parser_parse_function_statement */
 
+/**
+ * Checks whether the last byte code pushes a constant as the value
+ * of a condition. The push is dropped if the value is known.
+ *
+ * @return value of the condition
+ */
+static parser_condition_value_t
+parser_get_constant_condition (parser_context_t *context_p) /**< context */
+{
+  parser_condition_value_t value;
+
+#ifdef JERRY_DEBUGGER
+  if (JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_CONNECTED)
+  {
+    /* Breakpoints refer to the byte code offsets. */
+    return PARSER_CONDITION_UNKNOWN;
+  }
+#endif /* JERRY_DEBUGGER */
+
+  switch (context_p->last_cbc_opcode)
+  {
+    case CBC_PUSH_FALSE:
+    case CBC_PUSH_NULL:
+    case CBC_PUSH_NUMBER_0:
+    {
+      value = PARSER_CONDITION_FALSE;
+      break;
+    }
+    case CBC_PUSH_TRUE:
+    case CBC_PUSH_NUMBER_POS_BYTE:
+    case CBC_PUSH_NUMBER_NEG_BYTE:
+    {
+      value = PARSER_CONDITION_TRUE;
+      break;
+    }
+    case CBC_PUSH_LITERAL:
+    {
+      lexer_literal_t *literal_p = PARSER_GET_LITERAL (context_p->last_cbc.literal_index);
+      bool is_true;
+
+      if (context_p->last_cbc.literal_type == LEXER_STRING_LITERAL)
+      {
+        is_true = (literal_p->prop.length > 0);
+      }
+      else if (context_p->last_cbc.literal_type == LEXER_NUMBER_LITERAL)
+      {
+        ecma_string_t *string_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, literal_p->u.value);
+        ecma_number_t num = ecma_get_number_from_value (string_p->u.lit_number);
+
+        is_true = !ecma_number_is_nan (num) && !ecma_number_is_zero (num);
+      }
+      else
+      {
+        return PARSER_CONDITION_UNKNOWN;
+      }
+
+      value = is_true ? PARSER_CONDITION_TRUE : PARSER_CONDITION_FALSE;
+      break;
+    }
+    default:
+    {
+      return PARSER_CONDITION_UNKNOWN;
+    }
+  }
+
+  context_p->last_cbc_opcode = PARSER_CBC_UNAVAILABLE;
+  return value;
+} /* parser_get_constant_condition */
+
+/**
+ * Checks whether a break or continue statement emitted after
+ * the code position jumps out of the current statements.
+ *
+ * @return true - if the code after the position has pending jumps
+ *         false - otherwise
+ */
+static bool
+parser_has_pending_jumps (parser_context_t *context_p, /**< context */
+                          parser_code_position_t *position_p) /**< code position */
+{
+  parser_stack_iterator_t iterator;
+
+  parser_stack_iterator_init (context_p, &iterator);
+
+  while (true)
+  {
+    uint8_t type = parser_stack_iterator_read_uint8 (&iterator);
+    parser_branch_node_t *branch_list_p;
+
+    if (type == PARSER_STATEMENT_START)
+    {
+      return false;
+    }
+
+    if (type == PARSER_STATEMENT_LABEL)
+    {
+      parser_label_statement_t label_statement;
+
+      parser_stack_iterator_skip (&iterator, 1);
+      parser_stack_iterator_read (&iterator, &label_statement, sizeof (parser_label_statement_t));
+      parser_stack_iterator_skip (&iterator, sizeof (parser_label_statement_t));
+      branch_list_p = label_statement.break_list_p;
+    }
+    else if (type >= PARSER_STATEMENT_SWITCH && type <= PARSER_STATEMENT_FOR_IN)
+    {
+      parser_loop_statement_t loop;
+
+      parser_stack_iterator_skip (&iterator, 1);
+      parser_stack_iterator_read (&iterator, &loop, sizeof (parser_loop_statement_t));
+      parser_stack_iterator_skip (&iterator, (size_t) (parser_statement_length (type) - 1));
+      branch_list_p = loop.branch_list_p;
+    }
+    else
+    {
+      parser_stack_iterator_skip (&iterator, parser_statement_length (type));
+      continue;
+    }
+
+    while (branch_list_p != NULL)
+    {
+      if ((branch_list_p->branch.offset >> 8) >= position_p->byte_code_size)
+      {
+        return true;
+      }
+      branch_list_p = branch_list_p->next_p;
+    }
+  }
+} /* parser_has_pending_jumps */
+
+/**
+ * Set the branch of an if or else statement to the current position. The
+ * code of a branch which is never executed is removed if it is possible.
+ */
+static void
+parser_set_if_else_branch (parser_context_t *context_p, /**< context */
+                           parser_if_else_statement_t *statement_p) /**< if or else statement */
+{
+  if (statement_p->is_dead_code
+      && !parser_has_pending_jumps (context_p, &statement_p->dead_code_start))
+  {
+    parser_remove_code (context_p, &statement_p->dead_code_start);
+    return;
+  }
+
+  if (statement_p->branch.page_p != NULL)
+  {
+    parser_set_branch_to_current_position (context_p, &statement_p->branch);
+  }
+} /* parser_set_if_else_branch */
+
 /**
  * Parse if statement (starting part).
  */
@@ -478,9 +641,31 @@ parser_parse_if_statement_start (parser_context_t *context_p) /**< context */
 
   parser_parse_enclosed_expr (context_p);
 
-  parser_emit_cbc_forward_branch (context_p,
-                                  CBC_BRANCH_IF_FALSE_FORWARD,
-                                  &if_statement.branch);
+  if_statement.is_dead_code = false;
+
+  switch (parser_get_constant_condition (context_p))
+  {
+    case PARSER_CONDITION_FALSE:
+    {
+      /* The jump is removed with the body, unless the body has pending jumps. */
+      parser_save_code_position (context_p, &if_statement.dead_code_start);
+      parser_emit_cbc_forward_branch (context_p, CBC_JUMP_FORWARD, &if_statement.branch);
+      if_statement.is_dead_code = true;
+      break;
+    }
+    case PARSER_CONDITION_TRUE:
+    {
+      if_statement.branch.page_p = NULL;
+      break;
+    }
+    default:
+    {
+      parser_emit_cbc_forward_branch (context_p,
+                                      CBC_BRANCH_IF_FALSE_FORWARD,
+                                      &if_statement.branch);
+      break;
+    }
+  }
 
   parser_stack_push (context_p, &if_statement, sizeof (parser_if_else_statement_t));
   parser_stack_push_uint8 (context_p, PARSER_STATEMENT_IF);
@@ -505,7 +690,7 @@ parser_parse_if_statement_end (parser_context_t *context_p) /**< context */
     parser_stack_pop (context_p, &if_statement, sizeof (parser_if_else_statement_t));
     parser_stack_iterator_init (context_p, &context_p->last_statement);
 
-    parser_set_branch_to_current_position (context_p, &if_statement.branch);
+    parser_set_if_else_branch (context_p, &if_statement);
 
     return false;
   }
@@ -515,11 +700,33 @@ parser_parse_if_statement_end (parser_context_t *context_p) /**< context */
   parser_stack_iterator_skip (&iterator, 1);
   parser_stack_iterator_read (&iterator, &if_statement, sizeof (parser_if_else_statement_t));
 
-  parser_emit_cbc_forward_branch (context_p,
-                                  CBC_JUMP_FORWARD,
-                                  &else_statement.branch);
+  else_statement.is_dead_code = false;
+
+  if (if_statement.is_dead_code
+      && !parser_has_pending_jumps (context_p, &if_statement.dead_code_start))
+  {
+    /* The else part is always executed. */
+    parser_remove_code (context_p, &if_statement.dead_code_start);
+    else_statement.branch.page_p = NULL;
+  }
+  else
+  {
+    if (!if_statement.is_dead_code && if_statement.branch.page_p == NULL)
+    {
+      /* The else part is never executed. */
+      parser_save_code_position (context_p, &else_statement.dead_code_start);
+      else_statement.is_dead_code = true;
+    }
+
+    parser_emit_cbc_forward_branch (context_p,
+                                    CBC_JUMP_FORWARD,
+                                    &else_statement.branch);
 
-  parser_set_branch_to_current_position (context_p, &if_statement.branch);
+    if (if_statement.branch.page_p != NULL)
+    {
+      parser_set_branch_to_current_position (context_p, &if_statement.branch);
+    }
+  }
 
   parser_stack_iterator_write (&iterator, &else_statement, sizeof (parser_if_else_statement_t));
 
@@ -1246,8 +1453,9 @@ parser_parse_try_statement_end (parser_context_t *context_p) /**< context */
     JERRY_ASSERT (context_p->token.type == LEXER_LITERAL
                   && context_p->token.lit_location.type == LEXER_IDENT_LITERAL);
 
+    /* The catch block creates its own lexical environment for the binding,
+     * so the function needs one only if the binding is also one of its vars. */
     context_p->lit_object.literal_p->status_flags |= LEXER_FLAG_NO_REG_STORE;
-    context_p->status_flags |= PARSER_LEXICAL_ENV_NEEDED;
 
     literal_index = context_p->lit_object.index;
 
@@ -2086,7 +2294,7 @@ parser_parse_statements (parser_context_t *context_p) /**< context */
           parser_stack_pop (context_p, &else_statement, sizeof (parser_if_else_statement_t));
           parser_stack_iterator_init (context_p, &context_p->last_statement);
 
-          parser_set_branch_to_current_position (context_p, &else_statement.branch);
+          parser_set_if_else_branch (context_p, &else_statement);
           continue;
         }
 
@@ -201,7 +201,15 @@ parser_flush_cbc (parser_context_t *context_p) /**< context */
       }
     }
 
-    if (flags & CBC_HAS_BYTE_ARG)
+    if (context_p->last_cbc_opcode == CBC_PUSH_NUMBER_POS_BYTE)
+    {
+      JERRY_DEBUG_MSG (" number:%d", (int) context_p->last_cbc.value + 1);
+    }
+    else if (context_p->last_cbc_opcode == CBC_PUSH_NUMBER_NEG_BYTE)
+    {
+      JERRY_DEBUG_MSG (" number:%d", -((int) context_p->last_cbc.value + 1));
+    }
+    else if (flags & CBC_HAS_BYTE_ARG)
     {
       JERRY_DEBUG_MSG (" byte_arg:%d", (int) context_p->last_cbc.value);
     }
@@ -319,37 +327,10 @@ parser_emit_cbc_push_number (parser_context_t *context_p, /**< context */
   JERRY_ASSERT (value > 0 && value <= CBC_PUSH_NUMBER_BYTE_RANGE_END);
   JERRY_ASSERT (CBC_STACK_ADJUST_VALUE (cbc_flags[opcode]) == 1);
 
-  context_p->stack_depth++;
-
-#ifdef PARSER_DUMP_BYTE_CODE
-  if (context_p->is_show_opcodes)
-  {
-    int real_value = value;
-
-    if (is_negative_number)
-    {
-      real_value = -real_value;
-    }
-
-    JERRY_DEBUG_MSG ("  [%3d] %s number:%d\n",
-                     (int) context_p->stack_depth,
-                     cbc_names[opcode],
-                     real_value);
-  }
-#endif /* PARSER_DUMP_BYTE_CODE */
-
-  parser_emit_two_bytes (context_p, opcode, (uint8_t) (value - 1));
-
-  context_p->byte_code_size += 2;
-
-  if (context_p->stack_depth > context_p->stack_limit)
-  {
-    context_p->stack_limit = context_p->stack_depth;
-    if (context_p->stack_limit > PARSER_MAXIMUM_STACK_LIMIT)
-    {
-      parser_raise_error (context_p, PARSER_ERR_STACK_LIMIT_REACHED);
-    }
-  }
+  /* The byte code is kept as the last byte code, so the
+   * expression parser can fold it with other constants. */
+  context_p->last_cbc_opcode = opcode;
+  context_p->last_cbc.value = (uint16_t) (value - 1);
 } /* parser_emit_cbc_push_number */
 
 /**
@@ -647,6 +628,80 @@ parser_set_continues_to_current_position (parser_context_t *context_p, /**< cont
   }
 } /* parser_set_continues_to_current_position */
 
+/**
+ * Save the current end of the byte code stream, so the code emitted
+ * after this position can be removed later.
+ */
+void
+parser_save_code_position (parser_context_t *context_p, /**< context */
+                           parser_code_position_t *position_p) /**< [out] code position */
+{
+  if (context_p->last_cbc_opcode != PARSER_CBC_UNAVAILABLE)
+  {
+    parser_flush_cbc (context_p);
+  }
+
+  position_p->page_p = context_p->byte_code.last_p;
+  position_p->last_position = context_p->byte_code.last_position;
+  position_p->byte_code_size = context_p->byte_code_size;
+  position_p->status_flags = context_p->status_flags & PARSER_NO_END_LABEL;
+} /* parser_save_code_position */
+
+/**
+ * Remove the byte code emitted after a saved position.
+ *
+ * Note:
+ *   the caller must ensure that no branch refers to the removed code
+ */
+void
+parser_remove_code (parser_context_t *context_p, /**< context */
+                    parser_code_position_t *position_p) /**< code position */
+{
+  parser_mem_page_t *page_p;
+
+  /* The last byte code is flushed to keep the stack depth consistent. */
+  if (context_p->last_cbc_opcode != PARSER_CBC_UNAVAILABLE)
+  {
+    parser_flush_cbc (context_p);
+  }
+
+  JERRY_ASSERT (context_p->byte_code_size >= position_p->byte_code_size);
+
+#ifdef PARSER_DUMP_BYTE_CODE
+  if (context_p->is_show_opcodes)
+  {
+    JERRY_DEBUG_MSG ("  [%3d] dead code removed: %d bytes\n",
+                     (int) context_p->stack_depth,
+                     (int) (context_p->byte_code_size - position_p->byte_code_size));
+  }
+#endif /* PARSER_DUMP_BYTE_CODE */
+
+  if (position_p->page_p == NULL)
+  {
+    page_p = context_p->byte_code.first_p;
+    context_p->byte_code.first_p = NULL;
+  }
+  else
+  {
+    page_p = position_p->page_p->next_p;
+    position_p->page_p->next_p = NULL;
+  }
+
+  while (page_p != NULL)
+  {
+    parser_mem_page_t *next_p = page_p->next_p;
+
+    parser_free (page_p, sizeof (parser_mem_page_t *) + PARSER_CBC_STREAM_PAGE_SIZE);
+    page_p = next_p;
+  }
+
+  context_p->byte_code.last_p = position_p->page_p;
+  context_p->byte_code.last_position = position_p->last_position;
+  context_p->byte_code_size = position_p->byte_code_size;
+  context_p->status_flags &= ~PARSER_NO_END_LABEL;
+  context_p->status_flags |= position_p->status_flags;
+} /* parser_remove_code */
+
 #ifdef JERRY_ENABLE_ERROR_MESSAGES
 /**
  * Returns with the string representation of the error
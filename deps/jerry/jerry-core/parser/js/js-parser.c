@@ -87,6 +87,12 @@ parser_copy_identifiers (parser_context_t *context_p) /**< context */
       {
         /* This literal is known by the parent. */
         parent_literal_p->status_flags |= LEXER_FLAG_NO_REG_STORE;
+
+        if (parent_literal_p->status_flags & LEXER_FLAG_FUNCTION_NAME)
+        {
+          /* The name of a function expression is used by this function. */
+          parent_literal_p->status_flags = (uint8_t) (parent_literal_p->status_flags & ~LEXER_FLAG_UNUSED_IDENT);
+        }
         break;
       }
     }
@@ -158,14 +164,63 @@ parser_compute_indicies (parser_context_t *context_p, /**< context */
     context_p->status_flags = status_flags;
   }
 
+  if ((status_flags & PARSER_ARGUMENTS_FAST_ACCESS)
+      && !(status_flags & PARSER_ARGUMENTS_NEEDED))
+  {
+    /* Code which may be evaluated by the debugger needs the object. The formal
+     * arguments of non-strict code are read from the argument registers, so
+     * each of them must be in its register. */
+    bool is_object_needed = (status_flags & PARSER_NO_REG_STORE) != 0;
+
+    if (!(status_flags & PARSER_IS_STRICT))
+    {
+      is_object_needed |= (status_flags & PARSER_HAS_NON_STRICT_ARG) != 0;
+
+      parser_list_iterator_init (&context_p->literal_pool, &literal_iterator);
+      while (!is_object_needed
+             && (literal_p = (lexer_literal_t *) parser_list_iterator_next (&literal_iterator)))
+      {
+        if ((literal_p->status_flags & LEXER_FLAG_FUNCTION_ARGUMENT)
+            && (literal_p->status_flags & LEXER_FLAG_NO_REG_STORE))
+        {
+          is_object_needed = true;
+        }
+      }
+    }
+
+    if (is_object_needed)
+    {
+      status_flags |= PARSER_ARGUMENTS_NEEDED | PARSER_LEXICAL_ENV_NEEDED;
+      context_p->status_flags = status_flags;
+    }
+  }
+
   /* First phase: count the number of items in each group. */
   parser_list_iterator_init (&context_p->literal_pool, &literal_iterator);
   while ((literal_p = (lexer_literal_t *) parser_list_iterator_next (&literal_iterator)))
   {
+    if ((literal_p->status_flags & LEXER_FLAG_FUNCTION_NAME)
+        && (literal_p->status_flags & LEXER_FLAG_UNUSED_IDENT))
+    {
+      if (status_flags & PARSER_NO_REG_STORE)
+      {
+        /* The name can still be resolved by eval. */
+        literal_p->status_flags = (uint8_t) (literal_p->status_flags & ~LEXER_FLAG_UNUSED_IDENT);
+      }
+      else
+      {
+        /* The name of a function expression which is never referenced
+         * needs no binding, and no lexical environment to hold it. */
+        uint8_t binding_flags = LEXER_FLAG_VAR | LEXER_FLAG_INITIALIZED | LEXER_FLAG_FUNCTION_NAME;
+        literal_p->status_flags = (uint8_t) (literal_p->status_flags & ~binding_flags);
+      }
+    }
+
     if (literal_p->status_flags & LEXER_FLAG_UNUSED_IDENT)
     {
 #ifndef PARSER_DUMP_BYTE_CODE
-      if (!(literal_p->status_flags & LEXER_FLAG_SOURCE_PTR))
+      if (literal_p->type != LEXER_NUMBER_LITERAL
+          && !(literal_p->status_flags & LEXER_FLAG_SOURCE_PTR))
       {
         #ifdef PROF_COUNT__SIZE_DETAILED
         profile_add_count_size_detailed(31, -(size_t)literal_p->prop.length); /* size detailed */
@@ -669,7 +724,11 @@ parser_generate_initializers (parser_context_t *context_p, /**< context */
       else
       {
         JERRY_ASSERT (literal_p->type == LEXER_NUMBER_LITERAL);
-        literal_pool_p[literal_p->prop.index] = literal_p->u.value;
+
+        if (!(literal_p->status_flags & LEXER_FLAG_UNUSED_IDENT))
+        {
+          literal_pool_p[literal_p->prop.index] = literal_p->u.value;
+        }
       }
     }
 
@@ -1365,6 +1424,102 @@ parse_print_final_cbc (ecma_compiled_code_t *compiled_code_p, /**< compiled code
     } \
   } while (0)
 
+/**
+ * Mark the string and number literals which are not referenced by the byte code
+ * as unused, so they are not stored in the literal pool of the compiled code.
+ * These are left behind when constant expressions are computed by the parser.
+ */
+static void
+parser_mark_unreferenced_literals (parser_context_t *context_p) /**< context */
+{
+  parser_list_iterator_t literal_iterator;
+  lexer_literal_t *literal_p;
+  parser_mem_page_t *page_p = context_p->byte_code.first_p;
+  parser_mem_page_t *last_page_p = context_p->byte_code.last_p;
+  size_t last_position = context_p->byte_code.last_position;
+  size_t offset = 0;
+
+  parser_list_iterator_init (&context_p->literal_pool, &literal_iterator);
+  while ((literal_p = (lexer_literal_t *) parser_list_iterator_next (&literal_iterator)))
+  {
+    if (literal_p->type == LEXER_STRING_LITERAL
+        || literal_p->type == LEXER_NUMBER_LITERAL)
+    {
+      literal_p->status_flags |= LEXER_FLAG_UNUSED_IDENT;
+    }
+  }
+
+  if (last_position >= PARSER_CBC_STREAM_PAGE_SIZE)
+  {
+    last_page_p = NULL;
+    last_position = 0;
+  }
+
+  while (page_p != last_page_p || offset < last_position)
+  {
+    cbc_opcode_t opcode = (cbc_opcode_t) page_p->bytes[offset];
+    size_t branch_offset_length = CBC_BRANCH_OFFSET_LENGTH (opcode);
+    uint8_t flags = cbc_flags[opcode];
+
+    PARSER_NEXT_BYTE (page_p, offset);
+
+    if (opcode == CBC_EXT_OPCODE)
+    {
+      cbc_ext_opcode_t ext_opcode = (cbc_ext_opcode_t) page_p->bytes[offset];
+
+      branch_offset_length = CBC_BRANCH_OFFSET_LENGTH (ext_opcode);
+      flags = cbc_ext_flags[ext_opcode];
+      PARSER_NEXT_BYTE (page_p, offset);
+    }
+
+    while (flags & (CBC_HAS_LITERAL_ARG | CBC_HAS_LITERAL_ARG2))
+    {
+      size_t literal_index = page_p->bytes[offset];
+
+      PARSER_NEXT_BYTE (page_p, offset);
+      literal_index |= ((size_t) page_p->bytes[offset]) << 8;
+      PARSER_NEXT_BYTE (page_p, offset);
+
+      literal_p = PARSER_GET_LITERAL (literal_index);
+
+      if (literal_p->type == LEXER_STRING_LITERAL
+          || literal_p->type == LEXER_NUMBER_LITERAL)
+      {
+        literal_p->status_flags = (uint8_t) (literal_p->status_flags & ~LEXER_FLAG_UNUSED_IDENT);
+      }
+
+      if (flags & CBC_HAS_LITERAL_ARG2)
+      {
+        if (flags & CBC_HAS_LITERAL_ARG)
+        {
+          flags = CBC_HAS_LITERAL_ARG;
+        }
+        else
+        {
+          flags = CBC_HAS_LITERAL_ARG | CBC_HAS_LITERAL_ARG2;
+        }
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    if (flags & CBC_HAS_BYTE_ARG)
+    {
+      PARSER_NEXT_BYTE (page_p, offset);
+    }
+
+    if (flags & CBC_HAS_BRANCH_ARG)
+    {
+      while (branch_offset_length-- > 0)
+      {
+        PARSER_NEXT_BYTE (page_p, offset);
+      }
+    }
+  }
+} /* parser_mark_unreferenced_literals */
+
 /**
  * Post processing main function.
  *
@@ -1423,6 +1578,11 @@ parser_post_processing (parser_context_t *context_p) /**< context */
 
   parser_copy_identifiers (context_p);
 
+  if (JERRY_CONTEXT (jerry_init_flags) & ECMA_INIT_PARSER_OPTIMIZE)
+  {
+    parser_mark_unreferenced_literals (context_p);
+  }
+
   initializers_length = parser_compute_indicies (context_p,
                                                  &ident_end,
                                                  &uninitialized_var_end,
@@ -1992,6 +2152,8 @@ static ecma_compiled_code_t *
 parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
                      size_t size, /**< size of the source code */
                      int strict_mode, /**< strict mode */
+                     const cbc_lazy_function_t *lazy_function_p, /**< function compiled from
+                                                                  *   the source, or NULL */
                      parser_error_location_t *error_location_p) /**< error location */
 {
   parser_context_t context;
@@ -2021,6 +2183,19 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
   context.line = 1;
   context.column = 1;
 
+#ifdef PARSER_LAZY_FUNCTIONS
+  if (lazy_function_p != NULL)
+  {
+    context.status_flags = lazy_function_p->status_flags;
+    context.line = lazy_function_p->line;
+    context.column = lazy_function_p->column;
+    context.token.line = context.line;
+    context.token.column = context.column;
+  }
+#else /* !PARSER_LAZY_FUNCTIONS */
+  JERRY_UNUSED (lazy_function_p);
+#endif /* PARSER_LAZY_FUNCTIONS */
+
   context.last_cbc_opcode = PARSER_CBC_UNAVAILABLE;
 
   context.argument_count = 0;
@@ -2057,12 +2232,24 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
     /* Pushing a dummy value ensures the stack is never empty.
      * This simplifies the stack management routines. */
     parser_stack_push_uint8 (&context, CBC_MAXIMUM_BYTE_VALUE);
-    /* The next token must always be present to make decisions
-     * in the parser. Therefore when a token is consumed, the
-     * lexer_next_token() must be immediately called. */
-    lexer_next_token (&context);
 
-    parser_parse_statements (&context);
+#ifdef PARSER_LAZY_FUNCTIONS
+    if (lazy_function_p != NULL)
+    {
+      /* The source starts after the token preceding the function,
+       * which is the current token of parser_parse_function. */
+      compiled_code = parser_parse_function (&context, lazy_function_p->status_flags);
+    }
+    else
+#endif /* PARSER_LAZY_FUNCTIONS */
+    {
+      /* The next token must always be present to make decisions
+       * in the parser. Therefore when a token is consumed, the
+       * lexer_next_token() must be immediately called. */
+      lexer_next_token (&context);
+
+      parser_parse_statements (&context);
+    }
 
     /* When the parsing is successful, only the
      * dummy value can be remained on the stack. */
@@ -2076,7 +2263,13 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
     JERRY_ASSERT (context.last_cbc_opcode == PARSER_CBC_UNAVAILABLE);
     JERRY_ASSERT (context.allocated_buffer_p == NULL);
 
-    compiled_code = parser_post_processing (&context);
+#ifdef PARSER_LAZY_FUNCTIONS
+    if (lazy_function_p == NULL)
+#endif /* PARSER_LAZY_FUNCTIONS */
+    {
+      compiled_code = parser_post_processing (&context);
+      profile_code_register (compiled_code, 1); /* Code sites of profilers */
+    }
     parser_list_free (&context.literal_pool);
 
 #ifdef PARSER_DUMP_BYTE_CODE
@@ -2125,6 +2318,89 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
   return compiled_code;
 } /* parser_parse_source */
 
+#ifdef PARSER_LAZY_FUNCTIONS
+
+/**
+ * Scan the body of a function, which is compiled from
+ * a copy of its source when it is called first.
+ *
+ * @return compiled code of the lazy function
+ */
+static ecma_compiled_code_t *
+parser_scan_lazy_function (parser_context_t *context_p, /**< context */
+                           const uint8_t *source_start_p, /**< start of the function source */
+                           parser_line_counter_t line, /**< line of the source start */
+                           parser_line_counter_t column, /**< column of the source start */
+                           uint32_t status_flags) /**< status flags of the function */
+{
+  lexer_range_t range;
+
+  context_p->status_flags |= PARSER_LAZY_FUNCTION_SCAN;
+
+  /* The switch pre-scan stops at the closing brace of the function
+   * body, since case and default cannot appear out of a switch. */
+  parser_scan_until (context_p, &range, LEXER_KEYW_CASE);
+
+  if (context_p->token.type != LEXER_RIGHT_BRACE)
+  {
+    parser_raise_error (context_p, ((context_p->token.type == LEXER_KEYW_CASE) ? PARSER_ERR_CASE_NOT_IN_SWITCH
+                                                                                : PARSER_ERR_DEFAULT_NOT_IN_SWITCH));
+  }
+
+  parser_copy_identifiers (context_p);
+
+  size_t source_size = (size_t) (context_p->source_p - source_start_p);
+  uint8_t *source_p = (uint8_t *) parser_malloc (context_p, source_size);
+  memcpy (source_p, source_start_p, source_size);
+
+  /* The source is freed on error. */
+  context_p->allocated_buffer_p = source_p;
+  context_p->allocated_buffer_size = (uint32_t) source_size;
+
+  size_t total_size = JERRY_ALIGNUP (sizeof (cbc_lazy_function_t), JMEM_ALIGNMENT);
+  cbc_lazy_function_t *lazy_function_p = (cbc_lazy_function_t *) parser_malloc (context_p, total_size);
+
+  context_p->allocated_buffer_p = NULL;
+
+#ifdef JMEM_STATS
+  jmem_stats_allocate_byte_code_bytes (total_size);
+#endif /* JMEM_STATS */
+
+  memset (&lazy_function_p->header, 0, sizeof (cbc_uint8_arguments_t));
+  lazy_function_p->header.header.size = (uint16_t) (total_size >> JMEM_ALIGNMENT_LOG);
+  lazy_function_p->header.header.refs = 1;
+  lazy_function_p->header.header.status_flags = CBC_CODE_FLAGS_FUNCTION | CBC_CODE_FLAGS_LAZY_FUNCTION;
+  lazy_function_p->header.argument_end = (uint8_t) context_p->argument_count;
+
+  if (status_flags & PARSER_IS_STRICT)
+  {
+    lazy_function_p->header.header.status_flags |= CBC_CODE_FLAGS_STRICT_MODE;
+  }
+
+  lazy_function_p->bytecode_cp = ECMA_NULL_POINTER;
+  ECMA_SET_NON_NULL_POINTER (lazy_function_p->source_cp, source_p);
+  lazy_function_p->source_size = (uint32_t) source_size;
+  lazy_function_p->status_flags = status_flags;
+  lazy_function_p->line = line;
+  lazy_function_p->column = column;
+
+  /* The identifiers needed by the parent are passed to it by parser_copy_identifiers. */
+  parser_list_iterator_t literal_iterator;
+  lexer_literal_t *literal_p;
+
+  parser_list_iterator_init (&context_p->literal_pool, &literal_iterator);
+  while ((literal_p = (lexer_literal_t *) parser_list_iterator_next (&literal_iterator)) != NULL)
+  {
+    util_free_literal (literal_p);
+  }
+
+  parser_cbc_stream_free (&context_p->byte_code);
+
+  return (ecma_compiled_code_t *) lazy_function_p;
+} /* parser_scan_lazy_function */
+
+#endif /* PARSER_LAZY_FUNCTIONS */
+
 /**
  * Parse function code
  *
@@ -2136,6 +2412,7 @@ parser_parse_function (parser_context_t *context_p, /**< context */
 {
   parser_saved_context_t saved_context;
   ecma_compiled_code_t *compiled_code_p;
+  parser_line_counter_t start_line = context_p->token.line;
 
   JERRY_ASSERT (context_p->last_cbc_opcode == PARSER_CBC_UNAVAILABLE);
 
@@ -2174,6 +2451,15 @@ parser_parse_function (parser_context_t *context_p, /**< context */
 
   context_p->status_flags &= PARSER_IS_STRICT;
   context_p->status_flags |= status_flags;
+
+#ifdef PARSER_LAZY_FUNCTIONS
+  /* The function can be compiled later from this position. */
+  uint32_t lazy_status_flags = context_p->status_flags;
+  const uint8_t *lazy_source_p = context_p->source_p;
+  parser_line_counter_t lazy_line = context_p->line;
+  parser_line_counter_t lazy_column = context_p->column;
+#endif /* PARSER_LAZY_FUNCTIONS */
+
   context_p->stack_depth = 0;
   context_p->stack_limit = 0;
   context_p->last_context_p = &saved_context;
@@ -2227,7 +2513,9 @@ parser_parse_function (parser_context_t *context_p, /**< context */
      * function expression name, so there is no need to assign special flags. */
     if (context_p->lit_object.type != LEXER_LITERAL_OBJECT_ARGUMENTS)
     {
-      uint8_t lexer_flags = LEXER_FLAG_VAR | LEXER_FLAG_INITIALIZED | LEXER_FLAG_FUNCTION_NAME;
+      /* The name is marked unused until the function body refers to it. */
+      uint8_t lexer_flags = (LEXER_FLAG_VAR | LEXER_FLAG_INITIALIZED
+                             | LEXER_FLAG_FUNCTION_NAME | LEXER_FLAG_UNUSED_IDENT);
       context_p->lit_object.literal_p->status_flags |= lexer_flags;
     }
 
@@ -2376,8 +2664,29 @@ parser_parse_function (parser_context_t *context_p, /**< context */
   }
 
   lexer_next_token (context_p);
-  parser_parse_statements (context_p);
-  compiled_code_p = parser_post_processing (context_p);
+
+#ifdef PARSER_LAZY_FUNCTIONS
+  /* Nested functions are compiled when they are called first. The directive
+   * prologue of the body may change the strict mode, so those are compiled. */
+  if (saved_context.prev_context_p != NULL
+      && !(context_p->status_flags & PARSER_HAS_NON_STRICT_ARG)
+      && context_p->argument_count <= CBC_MAXIMUM_BYTE_VALUE
+      && !(context_p->token.type == LEXER_LITERAL
+           && context_p->token.lit_location.type == LEXER_STRING_LITERAL))
+  {
+    compiled_code_p = parser_scan_lazy_function (context_p,
+                                                 lazy_source_p,
+                                                 lazy_line,
+                                                 lazy_column,
+                                                 lazy_status_flags);
+  }
+  else
+#endif /* PARSER_LAZY_FUNCTIONS */
+  {
+    parser_parse_statements (context_p);
+    compiled_code_p = parser_post_processing (context_p);
+    profile_code_register (compiled_code_p, start_line); /* Code sites of profilers */
+  }
 
 #ifdef PARSER_DUMP_BYTE_CODE
   if (context_p->is_show_opcodes)
@@ -2490,6 +2799,92 @@ parser_send_breakpoints (parser_context_t *context_p, /**< context */
 
 #endif /* JERRY_DEBUGGER */
 
+/**
+ * Raise the syntax error of a parse error
+ *
+ * @return error value
+ */
+static ecma_value_t
+parser_raise_syntax_error (const parser_error_location_t *parser_error_p) /**< parse error */
+{
+  if (parser_error_p->error == PARSER_ERR_OUT_OF_MEMORY)
+  {
+    /* It is unlikely that memory can be allocated in an out-of-memory
+     * situation. However, a simple value can still be thrown. */
+    return ecma_make_error_value (ecma_make_simple_value (ECMA_SIMPLE_VALUE_NULL));
+  }
+#ifdef JERRY_ENABLE_ERROR_MESSAGES
+  const lit_utf8_byte_t *err_bytes_p = (const lit_utf8_byte_t *) parser_error_to_string (parser_error_p->error);
+  lit_utf8_size_t err_bytes_size = lit_zt_utf8_string_size (err_bytes_p);
+
+  ecma_string_t *err_str_p = ecma_new_ecma_string_from_utf8 (err_bytes_p, err_bytes_size);
+  ecma_value_t err_str_val = ecma_make_string_value (err_str_p);
+  ecma_value_t line_str_val = ecma_make_uint32_value (parser_error_p->line);
+  ecma_value_t col_str_val = ecma_make_uint32_value (parser_error_p->column);
+
+  ecma_value_t error_value = ecma_raise_standard_error_with_format (ECMA_ERROR_SYNTAX,
+                                                                    "% [line: %, column: %]",
+                                                                    err_str_val,
+                                                                    line_str_val,
+                                                                    col_str_val);
+
+  ecma_free_value (col_str_val);
+  ecma_free_value (line_str_val);
+  ecma_free_value (err_str_val);
+
+  return error_value;
+#else /* !JERRY_ENABLE_ERROR_MESSAGES */
+  return ecma_raise_syntax_error ("");
+#endif /* JERRY_ENABLE_ERROR_MESSAGES */
+} /* parser_raise_syntax_error */
+
+#ifdef PARSER_LAZY_FUNCTIONS
+
+/**
+ * Compile a lazy function when it is called first
+ *
+ * @return true - if success
+ *         syntax error - otherwise
+ */
+ecma_value_t
+parser_compile_lazy_function (const ecma_compiled_code_t *bytecode_p, /**< lazy function */
+                              const ecma_compiled_code_t **bytecode_data_p) /**< [out] compiled code */
+{
+  cbc_lazy_function_t *lazy_function_p = (cbc_lazy_function_t *) bytecode_p;
+
+  JERRY_ASSERT (bytecode_p->status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION);
+
+  if (lazy_function_p->bytecode_cp == ECMA_NULL_POINTER)
+  {
+    uint8_t *source_p = ECMA_GET_NON_NULL_POINTER (uint8_t, lazy_function_p->source_cp);
+    parser_error_location_t parser_error;
+    ecma_compiled_code_t *compiled_code_p;
+
+    compiled_code_p = parser_parse_source (source_p,
+                                           lazy_function_p->source_size,
+                                           false,
+                                           lazy_function_p,
+                                           &parser_error);
+
+    if (compiled_code_p == NULL)
+    {
+      /* The function stays lazy, so the next call raises the error again. */
+      return parser_raise_syntax_error (&parser_error);
+    }
+
+    ECMA_SET_NON_NULL_POINTER (lazy_function_p->bytecode_cp, compiled_code_p);
+
+    /* The source is not needed anymore. */
+    lazy_function_p->source_cp = ECMA_NULL_POINTER;
+    parser_free (source_p, lazy_function_p->source_size);
+  }
+
+  *bytecode_data_p = ECMA_GET_NON_NULL_POINTER (const ecma_compiled_code_t, lazy_function_p->bytecode_cp);
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+} /* parser_compile_lazy_function */
+
+#endif /* PARSER_LAZY_FUNCTIONS */
+
 #endif /* JERRY_JS_PARSER */
 
 /**
@@ -2520,7 +2915,7 @@ parser_parse_script (const uint8_t *source_p, /**< source code */
   }
 #endif /* JERRY_DEBUGGER */
 
-  *bytecode_data_p = parser_parse_source (source_p, size, is_strict, &parser_error);
+  *bytecode_data_p = parser_parse_source (source_p, size, is_strict, NULL, &parser_error);
 
   if (!*bytecode_data_p)
   {
@@ -2531,35 +2926,7 @@ parser_parse_script (const uint8_t *source_p, /**< source code */
     }
 #endif /* JERRY_DEBUGGER */
 
-    if (parser_error.error == PARSER_ERR_OUT_OF_MEMORY)
-    {
-      /* It is unlikely that memory can be allocated in an out-of-memory
-       * situation. However, a simple value can still be thrown. */
-      return ecma_make_error_value (ecma_make_simple_value (ECMA_SIMPLE_VALUE_NULL));
-    }
-#ifdef JERRY_ENABLE_ERROR_MESSAGES
-    const lit_utf8_byte_t *err_bytes_p = (const lit_utf8_byte_t *) parser_error_to_string (parser_error.error);
-    lit_utf8_size_t err_bytes_size = lit_zt_utf8_string_size (err_bytes_p);
-
-    ecma_string_t *err_str_p = ecma_new_ecma_string_from_utf8 (err_bytes_p, err_bytes_size);
-    ecma_value_t err_str_val = ecma_make_string_value (err_str_p);
-    ecma_value_t line_str_val = ecma_make_uint32_value (parser_error.line);
-    ecma_value_t col_str_val = ecma_make_uint32_value (parser_error.column);
-
-    ecma_value_t error_value = ecma_raise_standard_error_with_format (ECMA_ERROR_SYNTAX,
-                                                                      "% [line: %, column: %]",
-                                                                      err_str_val,
-                                                                      line_str_val,
-                                                                      col_str_val);
-
-    ecma_free_value (col_str_val);
-    ecma_free_value (line_str_val);
-    ecma_free_value (err_str_val);
-
-    return error_value;
-#else /* !JERRY_ENABLE_ERROR_MESSAGES */
-    return ecma_raise_syntax_error ("");
-#endif /* JERRY_ENABLE_ERROR_MESSAGES */
+    return parser_raise_syntax_error (&parser_error);
   }
   return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
 #else /* !JERRY_JS_PARSER */
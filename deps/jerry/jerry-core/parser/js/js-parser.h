@@ -16,6 +16,7 @@
 #ifndef JS_PARSER_H
 #define JS_PARSER_H
 
+#include "byte-code.h"
 #include "ecma-globals.h"
 
 /** \addtogroup parser Parser
@@ -133,6 +134,11 @@ ecma_value_t parser_parse_script (const uint8_t *source_p, size_t size, bool is_
 
 const char *parser_error_to_string (parser_error_t);
 
+#ifdef PARSER_LAZY_FUNCTIONS
+ecma_value_t parser_compile_lazy_function (const ecma_compiled_code_t *bytecode_p,
+                                           const ecma_compiled_code_t **bytecode_data_p);
+#endif /* PARSER_LAZY_FUNCTIONS */
+
 /**
  * @}
  * @}
@@ -79,6 +79,22 @@ typedef enum
   RE_OP_INV_CHAR_CLASS                            /**< "[^ ]" */
 } re_opcode_t;
 
+/**
+ * Maximum number of bytes used to find where a match can start
+ */
+#define RE_SCAN_BYTES_MAX 8
+
+/**
+ * Ways to find the input offsets where a match can start
+ */
+typedef enum
+{
+  RE_SCAN_NONE,                                   /**< try every offset */
+  RE_SCAN_ANCHORED,                               /**< only the start of the input (leading "^") */
+  RE_SCAN_PREFIX,                                 /**< offsets of the literal prefix in scan_bytes */
+  RE_SCAN_FIRST_BYTES                             /**< offsets of any of the bytes in scan_bytes */
+} re_scan_type_t;
+
 /**
  * Compiled byte code data.
  */
@@ -88,6 +104,12 @@ typedef struct
   jmem_cpointer_t pattern_cp;        /**< original RegExp pattern */
   uint32_t num_of_captures;          /**< number of capturing brackets */
   uint32_t num_of_non_captures;      /**< number of non capturing brackets */
+  jmem_cpointer_t last_input_cp;     /**< input string of the last global match (referenced), or NULL */
+  uint8_t scan_type;                 /**< re_scan_type_t of the pattern */
+  uint8_t scan_size;                 /**< number of bytes in scan_bytes */
+  uint32_t last_index;               /**< lastIndex after the last global match */
+  uint32_t last_offset;              /**< byte offset of last_index in the last global match input */
+  lit_utf8_byte_t scan_bytes[RE_SCAN_BYTES_MAX]; /**< literal prefix or possible first bytes (cesu8) */
 } re_compiled_code_t;
 
 /**
@@ -20,6 +20,7 @@
 #include "jcontext.h"
 #include "jrt-libc-includes.h"
 #include "jmem.h"
+#include "lit-char-helpers.h"
 #include "re-bytecode.h"
 #include "re-compiler.h"
 #include "re-parser.h"
@@ -504,6 +505,137 @@ re_cache_gc_run (void)
   }
 } /* re_cache_gc_run */
 
+/**
+ * Add a byte to the possible first bytes of a match
+ *
+ * @return true - if the byte is added or already present
+ *         false - if there are too many different first bytes
+ */
+static bool
+re_add_scan_byte (re_compiled_code_t *re_compiled_code_p, /**< compiled code */
+                  lit_utf8_byte_t byte) /**< first byte */
+{
+  for (uint32_t i = 0; i < re_compiled_code_p->scan_size; i++)
+  {
+    if (re_compiled_code_p->scan_bytes[i] == byte)
+    {
+      return true;
+    }
+  }
+
+  if (re_compiled_code_p->scan_size == RE_SCAN_BYTES_MAX)
+  {
+    return false;
+  }
+
+  re_compiled_code_p->scan_bytes[re_compiled_code_p->scan_size++] = byte;
+  return true;
+} /* re_add_scan_byte */
+
+/**
+ * Find out from the compiled bytecode where a match can start, so the matcher
+ * can skip the input offsets where it would surely fail:
+ *  - a leading "^" (without the multiline flag) can only match at the start of the input,
+ *  - a single alternative starting with characters needs their cesu8 bytes as a prefix,
+ *  - alternatives all starting with a character need one of the first bytes of those characters
+ *    (both letter cases of ASCII characters with the ignore case flag).
+ */
+static void
+re_compute_scan_info (re_compiled_code_t *re_compiled_code_p) /**< compiled code */
+{
+  bool is_ignorecase = (re_compiled_code_p->header.status_flags & RE_FLAG_IGNORE_CASE) != 0;
+  bool is_anchored = (re_compiled_code_p->header.status_flags & RE_FLAG_MULTILINE) == 0;
+  bool has_first_bytes = true;
+  uint32_t num_of_alternatives = 0;
+  uint8_t *bc_p = (uint8_t *) (re_compiled_code_p + 1);
+
+  re_compiled_code_p->scan_type = RE_SCAN_NONE;
+  re_compiled_code_p->scan_size = 0;
+
+  JERRY_ASSERT (*bc_p == RE_OP_SAVE_AT_START);
+  bc_p++;
+
+  do
+  {
+    uint32_t offset = re_get_value (&bc_p);
+    uint8_t *alternative_p = bc_p;
+    re_opcode_t op = re_get_opcode (&alternative_p);
+
+    is_anchored = is_anchored && (op == RE_OP_ASSERT_START);
+    has_first_bytes = has_first_bytes && (op == RE_OP_CHAR);
+
+    if (has_first_bytes)
+    {
+      ecma_char_t ch = re_get_char (&alternative_p); /* Already canonicalized. */
+
+      if (!is_ignorecase)
+      {
+        lit_utf8_byte_t ch_bytes[LIT_CESU8_MAX_BYTES_IN_CODE_UNIT];
+        lit_code_unit_to_utf8 (ch, ch_bytes);
+        has_first_bytes = re_add_scan_byte (re_compiled_code_p, ch_bytes[0]);
+      }
+      else if (ch <= LIT_UTF8_1_BYTE_CODE_POINT_MAX)
+      {
+        /* Only ASCII characters are canonicalized to ASCII characters. */
+        has_first_bytes = re_add_scan_byte (re_compiled_code_p, (lit_utf8_byte_t) ch);
+
+        if (has_first_bytes && ch >= LIT_CHAR_UPPERCASE_A && ch <= LIT_CHAR_UPPERCASE_Z)
+        {
+          ch = (ecma_char_t) (ch + (LIT_CHAR_LOWERCASE_A - LIT_CHAR_UPPERCASE_A));
+          has_first_bytes = re_add_scan_byte (re_compiled_code_p, (lit_utf8_byte_t) ch);
+        }
+      }
+      else
+      {
+        has_first_bytes = false;
+      }
+    }
+
+    num_of_alternatives++;
+    bc_p += offset;
+  }
+  while (re_get_opcode (&bc_p) == RE_OP_ALTERNATIVE);
+
+  if (is_anchored)
+  {
+    re_compiled_code_p->scan_type = RE_SCAN_ANCHORED;
+    re_compiled_code_p->scan_size = 0;
+    return;
+  }
+
+  if (!has_first_bytes)
+  {
+    re_compiled_code_p->scan_size = 0;
+    return;
+  }
+
+  if (num_of_alternatives > 1 || is_ignorecase)
+  {
+    re_compiled_code_p->scan_type = (re_compiled_code_p->scan_size == 1) ? RE_SCAN_PREFIX : RE_SCAN_FIRST_BYTES;
+    return;
+  }
+
+  /* Collect the characters at the start of the only alternative as a literal prefix. */
+  bc_p = (uint8_t *) (re_compiled_code_p + 1) + 1 + sizeof (uint32_t);
+  re_compiled_code_p->scan_size = 0;
+
+  while (re_get_opcode (&bc_p) == RE_OP_CHAR)
+  {
+    lit_utf8_byte_t ch_bytes[LIT_CESU8_MAX_BYTES_IN_CODE_UNIT];
+    lit_utf8_size_t ch_size = lit_code_unit_to_utf8 (re_get_char (&bc_p), ch_bytes);
+
+    if (re_compiled_code_p->scan_size + ch_size > RE_SCAN_BYTES_MAX)
+    {
+      break;
+    }
+
+    memcpy (re_compiled_code_p->scan_bytes + re_compiled_code_p->scan_size, ch_bytes, ch_size);
+    re_compiled_code_p->scan_size = (uint8_t) (re_compiled_code_p->scan_size + ch_size);
+  }
+
+  re_compiled_code_p->scan_type = RE_SCAN_PREFIX;
+} /* re_compute_scan_info */
+
 /**
  * Compilation of RegExp bytecode
  *
@@ -581,11 +713,16 @@ re_compile_bytecode (const re_compiled_code_t **out_bytecode_p, /**< [out] point
     ECMA_SET_NON_NULL_POINTER (re_compiled_code.pattern_cp, pattern_str_p);
     re_compiled_code.num_of_captures = re_ctx.num_of_captures * 2;
     re_compiled_code.num_of_non_captures = re_ctx.num_of_non_captures;
+    re_compiled_code.last_input_cp = ECMA_NULL_POINTER;
+    re_compiled_code.last_index = 0;
+    re_compiled_code.last_offset = 0;
 
     re_bytecode_list_insert (&bc_ctx,
                              0,
                              (uint8_t *) &re_compiled_code,
                              sizeof (re_compiled_code_t));
+
+    re_compute_scan_info ((re_compiled_code_t *) bc_ctx.block_start_p);
   }
 
   ECMA_FINALIZE (empty);
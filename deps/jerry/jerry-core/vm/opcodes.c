@@ -285,12 +285,13 @@ vm_op_delete_var (jmem_cpointer_t name_literal, /**< name literal */
  * See also:
  *          ECMA-262 v5, 12.6.4
  *
- * @return completion value
- *         Returned value must be freed with ecma_free_value
+ * @return names of the enumerable properties, NULL if there are none (or the value is undefined or null)
+ *         Returned collection must be freed with ecma_op_object_free_enumerable_property_names
  */
 ecma_collection_header_t *
 opfunc_for_in (ecma_value_t left_value, /**< left value */
-               ecma_value_t *result_obj_p) /**< expression object */
+               ecma_value_t *result_obj_p, /**< expression object */
+               bool *is_shared_p) /**< [out] the names are shared with the enumeration cache */
 {
   ecma_value_t compl_val = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
   ecma_collection_header_t *prop_names_p = NULL;
@@ -305,7 +306,7 @@ opfunc_for_in (ecma_value_t left_value, /**< left value */
                     compl_val);
 
     ecma_object_t *obj_p = ecma_get_object_from_value (obj_expr_value);
-    prop_names_p = ecma_op_object_get_property_names (obj_p, false, true, true);
+    prop_names_p = ecma_op_object_get_enumerable_property_names (obj_p, true, is_shared_p);
 
     if (prop_names_p->unit_number != 0)
     {
@@ -314,7 +315,7 @@ opfunc_for_in (ecma_value_t left_value, /**< left value */
     }
     else
     {
-      ecma_dealloc_collection_header (prop_names_p);
+      ecma_op_object_free_enumerable_property_names (prop_names_p, *is_shared_p);
       prop_names_p = NULL;
     }
 
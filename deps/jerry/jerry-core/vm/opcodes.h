@@ -109,7 +109,7 @@ ecma_value_t
 vm_op_delete_var (jmem_cpointer_t name_literal, ecma_object_t *lex_env_p);
 
 ecma_collection_header_t *
-opfunc_for_in (ecma_value_t left_value, ecma_value_t *result_obj_p);
+opfunc_for_in (ecma_value_t left_value, ecma_value_t *result_obj_p, bool *is_shared_p);
 
 /**
  * @}
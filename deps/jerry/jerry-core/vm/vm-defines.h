@@ -48,14 +48,33 @@ typedef struct vm_frame_ctx_t
   ecma_value_t *stack_top_p;                          /**< stack top pointer */
   jmem_cpointer_t *literal_start_p;                   /**< literal list start pointer */
   ecma_object_t *lex_env_p;                           /**< current lexical environment */
+  const ecma_value_t *arg_list_p;                     /**< arguments list of the call */
+  ecma_object_t *func_obj_p;                          /**< called function, NULL for global and eval code */
   struct vm_frame_ctx_t *prev_context_p;              /**< previous context */
   ecma_value_t this_binding;                          /**< this binding */
   ecma_value_t call_block_result;                     /**< preserve block result during a call */
+  ecma_length_t arg_list_len;                         /**< length of arguments list */
   uint16_t context_depth;                             /**< current context depth */
   uint8_t is_eval_code;                               /**< eval mode flag */
   uint8_t call_operation;                             /**< perform a call or construct operation */
 } vm_frame_ctx_t;
 
+#ifdef CONFIG_VM_INLINE_CACHE
+/**
+ * Inline cache entry of property access sites
+ *
+ * The entry is valid while no property is freed since it is filled,
+ * so the cached property pointers always belong to the cached objects.
+ */
+typedef struct
+{
+  uint32_t epoch; /**< vm_inline_cache_epoch when the entry is filled */
+  ecma_object_t *object_p[CONFIG_VM_INLINE_CACHE_WAYS]; /**< cached objects, most recently used first */
+  ecma_value_t name[CONFIG_VM_INLINE_CACHE_WAYS]; /**< property names (string names are referenced) */
+  ecma_property_t *property_p[CONFIG_VM_INLINE_CACHE_WAYS]; /**< own properties of the objects */
+} vm_inline_cache_entry_t;
+#endif /* CONFIG_VM_INLINE_CACHE */
+
 /**
  * @}
  * @}
@@ -63,6 +63,9 @@ typedef enum
   VM_CONTEXT_CATCH,                           /**< catch context */
   VM_CONTEXT_WITH,                            /**< with context */
   VM_CONTEXT_FOR_IN,                          /**< for-in context */
+#ifdef CONFIG_ECMA_ENUM_CACHE
+  VM_CONTEXT_FOR_IN_SHARED,                   /**< for-in context iterating a list of the enumeration cache */
+#endif /* CONFIG_ECMA_ENUM_CACHE */
 } vm_stack_context_type_t;
 
 ecma_value_t *vm_stack_context_abort (vm_frame_ctx_t *frame_ctx_p, ecma_value_t *vm_stack_top_p);
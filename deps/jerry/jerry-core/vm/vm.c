@@ -20,6 +20,7 @@
 #include "ecma-builtins.h"
 #include "ecma-comparison.h"
 #include "ecma-conversion.h"
+#include "ecma-enum-cache.h"
 #include "ecma-exceptions.h"
 #include "ecma-function-object.h"
 #include "ecma-gc.h"
@@ -30,11 +31,15 @@
 #include "ecma-objects-general.h"
 #include "ecma-regexp-object.h"
 #include "ecma-try-catch-macro.h"
+#include "ecma-typedarray-object.h"
 #include "jcontext.h"
 #include "opcodes.h"
 #include "vm.h"
 #include "vm-stack.h"
 
+// jmem-profiler
+#include "jmem-profiler.h"
+
 /** \addtogroup vm Virtual machine
  * @{
  *
@@ -42,6 +47,154 @@
  * @{
  */
 
+#if defined (CONFIG_VM_THREADED_DISPATCH) && defined (__GNUC__)
+/**
+ * The compiler supports labels as values, so opcode groups are dispatched by computed goto.
+ */
+#define VM_THREADED_DISPATCH
+#endif /* CONFIG_VM_THREADED_DISPATCH && __GNUC__ */
+
+#ifdef VM_THREADED_DISPATCH
+/**
+ * Case label of an opcode group in vm_loop, which is also the target of the threaded dispatch.
+ */
+#define VM_CASE(group) case group: vm_label_ ## group
+#else /* !VM_THREADED_DISPATCH */
+/**
+ * Case label of an opcode group in vm_loop.
+ */
+#define VM_CASE(group) case group
+#endif /* VM_THREADED_DISPATCH */
+
+#ifdef CONFIG_VM_INLINE_CACHE
+/**
+ * Release the property names of an inline cache entry, and make it empty and valid.
+ */
+static void
+vm_inline_cache_reset (vm_inline_cache_entry_t *entry_p) /**< inline cache entry */
+{
+  for (uint32_t i = 0; i < CONFIG_VM_INLINE_CACHE_WAYS; i++)
+  {
+    if (ecma_is_value_string (entry_p->name[i]))
+    {
+      ecma_deref_ecma_string (ecma_get_string_from_value (entry_p->name[i]));
+    }
+
+    entry_p->object_p[i] = NULL;
+    entry_p->name[i] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+    entry_p->property_p[i] = NULL;
+  }
+
+  entry_p->epoch = JERRY_CONTEXT (vm_inline_cache_epoch);
+} /* vm_inline_cache_reset */
+
+/**
+ * Get the inline cache entry of a property access site.
+ *
+ * @return valid inline cache entry
+ */
+static inline vm_inline_cache_entry_t * __attr_always_inline___
+vm_inline_cache_get_entry (const uint8_t *site_p) /**< byte code of the property access */
+{
+  uintptr_t site = (uintptr_t) site_p;
+  vm_inline_cache_entry_t *entry_p;
+  entry_p = JERRY_CONTEXT (vm_inline_caches) + ((site ^ (site >> 7)) & (CONFIG_VM_INLINE_CACHE_SIZE - 1));
+
+  if (unlikely (entry_p->epoch != JERRY_CONTEXT (vm_inline_cache_epoch)))
+  {
+    vm_inline_cache_reset (entry_p);
+  }
+
+  return entry_p;
+} /* vm_inline_cache_get_entry */
+
+/**
+ * Find the cached property of an object in an inline cache entry.
+ *
+ * Note:
+ *      names are compared by value, so a string name matches only the same string
+ *
+ * @return pointer to the property - if it is cached,
+ *         NULL - otherwise
+ */
+static inline ecma_property_t * __attr_always_inline___
+vm_inline_cache_lookup (vm_inline_cache_entry_t *entry_p, /**< inline cache entry */
+                        ecma_object_t *object_p, /**< object */
+                        ecma_value_t name) /**< property name */
+{
+  for (uint32_t i = 0; i < CONFIG_VM_INLINE_CACHE_WAYS; i++)
+  {
+    if (entry_p->object_p[i] == object_p && entry_p->name[i] == name)
+    {
+      return entry_p->property_p[i];
+    }
+  }
+
+  return NULL;
+} /* vm_inline_cache_lookup */
+
+/**
+ * Insert an own property of an object into an inline cache entry, evicting the least recently inserted one.
+ */
+static void
+vm_inline_cache_insert (vm_inline_cache_entry_t *entry_p, /**< inline cache entry */
+                        ecma_object_t *object_p, /**< object */
+                        ecma_value_t name, /**< property name (integer or string) */
+                        ecma_property_t *property_p) /**< own property of the object */
+{
+  const uint32_t last = CONFIG_VM_INLINE_CACHE_WAYS - 1;
+
+  if (ecma_is_value_string (entry_p->name[last]))
+  {
+    ecma_deref_ecma_string (ecma_get_string_from_value (entry_p->name[last]));
+  }
+
+  for (uint32_t i = last; i > 0; i--)
+  {
+    entry_p->object_p[i] = entry_p->object_p[i - 1];
+    entry_p->name[i] = entry_p->name[i - 1];
+    entry_p->property_p[i] = entry_p->property_p[i - 1];
+  }
+
+  /* The name is referenced to keep its address from being reused by another string. */
+  if (ecma_is_value_string (name))
+  {
+    ecma_ref_ecma_string (ecma_get_string_from_value (name));
+  }
+
+  entry_p->object_p[0] = object_p;
+  entry_p->name[0] = name;
+  entry_p->property_p[0] = property_p;
+} /* vm_inline_cache_insert */
+
+/**
+ * Check whether the own data properties of an object can be assigned without [[Put]].
+ *
+ * @return true - if assigning a writable own data property is the whole [[Put]] operation,
+ *         false - otherwise (e.g. arguments objects mapping their properties to bindings)
+ */
+static inline bool __attr_always_inline___
+vm_inline_cache_is_put_cacheable (ecma_object_t *object_p) /**< object */
+{
+  return (!ecma_is_lexical_environment (object_p)
+          && ecma_get_object_type (object_p) != ECMA_OBJECT_TYPE_PSEUDO_ARRAY);
+} /* vm_inline_cache_is_put_cacheable */
+#endif /* CONFIG_VM_INLINE_CACHE */
+
+/**
+ * Release the property names kept by the inline caches.
+ */
+void
+vm_finalize_inline_caches (void)
+{
+#ifdef CONFIG_VM_INLINE_CACHE
+  for (uint32_t i = 0; i < CONFIG_VM_INLINE_CACHE_SIZE; i++)
+  {
+    vm_inline_cache_reset (JERRY_CONTEXT (vm_inline_caches) + i);
+  }
+#endif /* CONFIG_VM_INLINE_CACHE */
+} /* vm_finalize_inline_caches */
+
 /**
  * Get the value of object[property].
  *
@@ -49,7 +202,8 @@
  */
 static ecma_value_t
 vm_op_get_value (ecma_value_t object, /**< base object */
-                 ecma_value_t property) /**< property name */
+                 ecma_value_t property, /**< property name */
+                 const uint8_t *site_p) /**< byte code of the property access */
 {
   if (ecma_is_value_object (object))
   {
@@ -61,6 +215,27 @@ vm_op_get_value (ecma_value_t object, /**< base object */
     {
       ecma_integer_value_t int_value = ecma_get_integer_from_value (property);
 
+#ifdef CONFIG_ECMA_FAST_ARRAY
+      if (int_value >= 0 && ecma_op_array_is_fast_array (object_p))
+      {
+        ecma_value_t element = ecma_fast_array_get_element (object_p, (uint32_t) int_value);
+
+        /* Holes are looked up in the prototype chain. */
+        if (!ecma_is_value_array_hole (element))
+        {
+          return ecma_fast_copy_value (element);
+        }
+      }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+      /* ES2015 9.4.5.4: the elements of typed arrays are not looked up in the prototype chain. */
+      if (int_value >= 0 && ecma_is_typedarray (object))
+      {
+        return ecma_op_typedarray_get_index_prop (object_p, (uint32_t) int_value);
+      }
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+
 #ifdef JERRY_CPOINTER_32_BIT
       bool limit_check = (int_value >= 0);
 #else /* !JERRY_CPOINTER_32_BIT */
@@ -81,11 +256,30 @@ vm_op_get_value (ecma_value_t object, /**< base object */
 
     if (property_name_p != NULL)
     {
+#ifdef CONFIG_VM_INLINE_CACHE
+      vm_inline_cache_entry_t *cache_entry_p = vm_inline_cache_get_entry (site_p);
+      ecma_property_t *cached_property_p = vm_inline_cache_lookup (cache_entry_p, object_p, property);
+
+      if (cached_property_p != NULL
+          && ECMA_PROPERTY_GET_TYPE (*cached_property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA)
+      {
+        return ecma_fast_copy_value (ECMA_PROPERTY_VALUE_PTR (cached_property_p)->value);
+      }
+#else /* !CONFIG_VM_INLINE_CACHE */
+      JERRY_UNUSED (site_p);
+#endif /* CONFIG_VM_INLINE_CACHE */
+
       ecma_property_t *property_p = ecma_lcache_lookup (object_p, property_name_p);
 
       if (property_p != NULL &&
           ECMA_PROPERTY_GET_TYPE (*property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA)
       {
+#ifdef CONFIG_VM_INLINE_CACHE
+        if (cached_property_p == NULL)
+        {
+          vm_inline_cache_insert (cache_entry_p, object_p, property, property_p);
+        }
+#endif /* CONFIG_VM_INLINE_CACHE */
         return ecma_fast_copy_value (ECMA_PROPERTY_VALUE_PTR (property_p)->value);
       }
 
@@ -122,6 +316,128 @@ vm_op_get_value (ecma_value_t object, /**< base object */
   return get_value_result;
 } /* vm_op_get_value */
 
+/**
+ * Get the value of arguments[property].
+ *
+ * The code only reads the arguments with CBC_EXT_PUSH_ARGUMENT and
+ * CBC_EXT_PUSH_ARGUMENTS_LENGTH unless it needs the arguments object,
+ * so the properties of the object are computed from the call.
+ *
+ * @return ecma value
+ */
+static ecma_value_t
+vm_op_get_argument (vm_frame_ctx_t *frame_ctx_p, /**< frame context */
+                    ecma_value_t property, /**< property name */
+                    const uint8_t *site_p) /**< byte code of the property access */
+{
+  const ecma_compiled_code_t *bytecode_header_p = frame_ctx_p->bytecode_header_p;
+
+  if (bytecode_header_p->status_flags & CBC_CODE_FLAGS_ARGUMENTS_NEEDED)
+  {
+    ecma_string_t *name_p = ecma_get_magic_string (LIT_MAGIC_STRING_ARGUMENTS);
+    ecma_value_t arguments = ecma_op_resolve_reference_value (frame_ctx_p->lex_env_p, name_p);
+    ecma_deref_ecma_string (name_p);
+
+    if (ECMA_IS_VALUE_ERROR (arguments))
+    {
+      return arguments;
+    }
+
+    ecma_value_t result = vm_op_get_value (arguments, property, site_p);
+    ecma_free_value (arguments);
+    return result;
+  }
+
+  JERRY_ASSERT (frame_ctx_p->func_obj_p != NULL);
+
+  uint32_t index = ECMA_STRING_NOT_ARRAY_INDEX;
+
+  if (ecma_is_value_integer_number (property))
+  {
+    ecma_integer_value_t int_value = ecma_get_integer_from_value (property);
+
+    if (int_value >= 0)
+    {
+      index = (uint32_t) int_value;
+    }
+  }
+  else if (ecma_is_value_string (property))
+  {
+    ecma_string_t *name_p = ecma_get_string_from_value (property);
+    index = ecma_string_get_array_index (name_p);
+
+    if (index == ECMA_STRING_NOT_ARRAY_INDEX)
+    {
+      bool is_strict = (bytecode_header_p->status_flags & CBC_CODE_FLAGS_STRICT_MODE) != 0;
+
+      if (ecma_compare_ecma_string_to_magic_id (name_p, LIT_MAGIC_STRING_LENGTH))
+      {
+        return ecma_make_uint32_value (frame_ctx_p->arg_list_len);
+      }
+
+      if (ecma_compare_ecma_string_to_magic_id (name_p, LIT_MAGIC_STRING_CALLEE))
+      {
+        if (is_strict)
+        {
+          return ecma_raise_type_error (ECMA_ERR_MSG ("'callee' is not accessible in strict mode."));
+        }
+
+        ecma_ref_object (frame_ctx_p->func_obj_p);
+        return ecma_make_object_value (frame_ctx_p->func_obj_p);
+      }
+
+      if (is_strict && ecma_compare_ecma_string_to_magic_id (name_p, LIT_MAGIC_STRING_CALLER))
+      {
+        return ecma_raise_type_error (ECMA_ERR_MSG ("'caller' is not accessible in strict mode."));
+      }
+    }
+  }
+  else
+  {
+    ecma_value_t name = ecma_op_to_string (property);
+
+    if (ECMA_IS_VALUE_ERROR (name))
+    {
+      return name;
+    }
+
+    ecma_value_t result = vm_op_get_argument (frame_ctx_p, name, site_p);
+    ecma_free_value (name);
+    return result;
+  }
+
+  if (index < frame_ctx_p->arg_list_len)
+  {
+    uint16_t argument_end;
+
+    if (bytecode_header_p->status_flags & CBC_CODE_FLAGS_UINT16_ARGUMENTS)
+    {
+      argument_end = ((cbc_uint16_arguments_t *) bytecode_header_p)->argument_end;
+    }
+    else
+    {
+      argument_end = ((cbc_uint8_arguments_t *) bytecode_header_p)->argument_end;
+    }
+
+    /* The formal arguments of non-strict code are mapped to the argument
+     * registers: the parser keeps the arguments object of any function
+     * which has its arguments out of the registers. */
+    if (index < argument_end
+        && !(bytecode_header_p->status_flags & CBC_CODE_FLAGS_STRICT_MODE))
+    {
+      return ecma_fast_copy_value (frame_ctx_p->registers_p[index]);
+    }
+
+    return ecma_fast_copy_value (frame_ctx_p->arg_list_p[index]);
+  }
+
+  /* Everything else is inherited from Object.prototype. */
+  ecma_object_t *prototype_p = ecma_builtin_get (ECMA_BUILTIN_ID_OBJECT_PROTOTYPE);
+  ecma_value_t result = vm_op_get_value (ecma_make_object_value (prototype_p), property, site_p);
+  ecma_deref_object (prototype_p);
+  return result;
+} /* vm_op_get_argument */
+
 /**
  * Set the value of object[property].
  *
@@ -135,8 +451,82 @@ static ecma_value_t
 vm_op_set_value (ecma_value_t object, /**< base object */
                  ecma_value_t property, /**< property name */
                  ecma_value_t value, /**< ecma value */
-                 bool is_strict) /**< strict mode */
+                 bool is_strict, /**< strict mode */
+                 const uint8_t *site_p) /**< byte code of the property access */
 {
+#ifdef CONFIG_ECMA_FAST_ARRAY
+  if (ecma_is_value_object (object)
+      && ecma_is_value_integer_number (property)
+      && ecma_get_integer_from_value (property) >= 0
+      && ecma_op_array_is_fast_array (ecma_get_object_from_value (object)))
+  {
+    /* Same as ecma_op_object_put for existing elements. */
+    if (ecma_fast_array_assign_element (ecma_get_object_from_value (object),
+                                        (uint32_t) ecma_get_integer_from_value (property),
+                                        value))
+    {
+      ecma_free_value (object);
+      return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+    }
+  }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
+#ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
+  if (ecma_is_value_integer_number (property)
+      && ecma_get_integer_from_value (property) >= 0
+      && ecma_is_typedarray (object))
+  {
+    /* Same as ecma_op_object_put for integer indices, see ES2015 9.4.5.5. */
+    ecma_value_t completion_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+
+    if (!ecma_op_typedarray_set_index_prop (ecma_get_object_from_value (object),
+                                            (uint32_t) ecma_get_integer_from_value (property),
+                                            value))
+    {
+      completion_value = ecma_reject (is_strict);
+    }
+
+    ecma_free_value (object);
+    return completion_value;
+  }
+#endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
+
+#ifdef CONFIG_VM_INLINE_CACHE
+  if (ecma_is_value_object (object)
+      && ecma_is_value_string (property)
+      && vm_inline_cache_is_put_cacheable (ecma_get_object_from_value (object)))
+  {
+    ecma_object_t *object_p = ecma_get_object_from_value (object);
+    vm_inline_cache_entry_t *cache_entry_p = vm_inline_cache_get_entry (site_p);
+    ecma_property_t *property_p = vm_inline_cache_lookup (cache_entry_p, object_p, property);
+
+    if (property_p == NULL)
+    {
+      property_p = ecma_lcache_lookup (object_p, ecma_get_string_from_value (property));
+
+      if (property_p != NULL
+          && ECMA_PROPERTY_GET_TYPE (*property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA)
+      {
+        vm_inline_cache_insert (cache_entry_p, object_p, property, property_p);
+      }
+    }
+
+    /* Same as ecma_op_object_put for writable own data properties. */
+    if (property_p != NULL
+        && ECMA_PROPERTY_GET_TYPE (*property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA
+        && ecma_is_property_writable (*property_p))
+    {
+      ecma_named_data_property_assign_value (object_p, ECMA_PROPERTY_VALUE_PTR (property_p), value);
+
+      ecma_free_value (object);
+      ecma_free_value (property);
+      return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+    }
+  }
+#else /* !CONFIG_VM_INLINE_CACHE */
+  JERRY_UNUSED (site_p);
+#endif /* CONFIG_VM_INLINE_CACHE */
+
   if (unlikely (!ecma_is_value_object (object)))
   {
     ecma_value_t to_object = ecma_op_to_object (object);
@@ -233,7 +623,8 @@ vm_run_global (const ecma_compiled_code_t *bytecode_p) /**< pointer to bytecode
                                    ecma_get_global_environment (),
                                    false,
                                    NULL,
-                                   0);
+                                   0,
+                                   NULL);
 
   ecma_deref_object (glob_obj_p);
   return ret_value;
@@ -278,7 +669,8 @@ vm_run_eval (ecma_compiled_code_t *bytecode_data_p, /**< byte-code data */
                                           lex_env_p,
                                           true,
                                           NULL,
-                                          0);
+                                          0,
+                                          NULL);
 
   ecma_deref_object (lex_env_p);
   ecma_free_value (this_binding);
@@ -698,6 +1090,72 @@ vm_init_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
   }
 } /* vm_init_loop */
 
+#ifdef JERRY_VM_EXEC_STOP
+
+/**
+ * Calls the execution stop callback, when it is requested or its period is over.
+ *
+ * The loop only looks at vm_exec_stop_pending, which is set all the time when the
+ * callback is called periodically, and only while a stop is requested otherwise.
+ *
+ * @return undefined - if the execution continues
+ *         error value - otherwise
+ */
+static ecma_value_t __attr_noinline___
+vm_exec_stop_check (void)
+{
+  uint32_t frequency = JERRY_CONTEXT (vm_exec_stop_frequency);
+
+  /* The pending flag is cleared before the requests are taken, so a request made
+   * in between is not lost: it is either taken now, or checked again. */
+  if (frequency == 0)
+  {
+    JERRY_CONTEXT (vm_exec_stop_pending) = 0;
+  }
+
+  if (JERRY_CONTEXT (vm_exec_sample_requested))
+  {
+    JERRY_CONTEXT (vm_exec_sample_requested) = 0;
+    profile_cpu_take_sample (); /* Sampling CPU profiling */
+  }
+
+  bool requested = JERRY_CONTEXT (vm_exec_stop_requested) != 0;
+  JERRY_CONTEXT (vm_exec_stop_requested) = 0;
+
+  if (!requested)
+  {
+    if (frequency == 0 || --JERRY_CONTEXT (vm_exec_stop_counter) != 0)
+    {
+      return ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+    }
+    JERRY_CONTEXT (vm_exec_stop_counter) = frequency;
+  }
+
+  if (JERRY_CONTEXT (vm_exec_stop_cb) == NULL)
+  {
+    return ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+  }
+
+  ecma_value_t result = JERRY_CONTEXT (vm_exec_stop_cb) (JERRY_CONTEXT (vm_exec_stop_user_p));
+
+  if (ecma_is_value_undefined (result))
+  {
+    return result;
+  }
+
+  /* The callback is asked again at the next check, which must throw the same error. */
+  JERRY_CONTEXT (vm_exec_stop_requested) = 1;
+  JERRY_CONTEXT (vm_exec_stop_pending) = 1;
+
+  if (!ECMA_IS_VALUE_ERROR (result))
+  {
+    result = ecma_make_error_value (result);
+  }
+  return result;
+} /* vm_exec_stop_check */
+
+#endif /* JERRY_VM_EXEC_STOP */
+
 /**
  * Run generic byte code.
  *
@@ -723,6 +1181,105 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
   ecma_value_t block_result = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
   bool is_strict = ((frame_ctx_p->bytecode_header_p->status_flags & CBC_CODE_FLAGS_STRICT_MODE) != 0);
 
+#ifdef VM_THREADED_DISPATCH
+  /* Handlers of the opcode groups. */
+  __extension__ static const void * const vm_dispatch_table[] =
+  {
+    [VM_OC_NONE] = &&vm_label_VM_OC_NONE,
+    [VM_OC_POP] = &&vm_label_VM_OC_POP,
+    [VM_OC_POP_BLOCK] = &&vm_label_VM_OC_POP_BLOCK,
+    [VM_OC_PUSH] = &&vm_label_VM_OC_PUSH,
+    [VM_OC_PUSH_TWO] = &&vm_label_VM_OC_PUSH_TWO,
+    [VM_OC_PUSH_THREE] = &&vm_label_VM_OC_PUSH_THREE,
+    [VM_OC_PUSH_UNDEFINED] = &&vm_label_VM_OC_PUSH_UNDEFINED,
+    [VM_OC_PUSH_TRUE] = &&vm_label_VM_OC_PUSH_TRUE,
+    [VM_OC_PUSH_FALSE] = &&vm_label_VM_OC_PUSH_FALSE,
+    [VM_OC_PUSH_NULL] = &&vm_label_VM_OC_PUSH_NULL,
+    [VM_OC_PUSH_THIS] = &&vm_label_VM_OC_PUSH_THIS,
+    [VM_OC_PUSH_NUMBER_0] = &&vm_label_VM_OC_PUSH_NUMBER_0,
+    [VM_OC_PUSH_NUMBER_POS_BYTE] = &&vm_label_VM_OC_PUSH_NUMBER_POS_BYTE,
+    [VM_OC_PUSH_NUMBER_NEG_BYTE] = &&vm_label_VM_OC_PUSH_NUMBER_NEG_BYTE,
+    [VM_OC_PUSH_OBJECT] = &&vm_label_VM_OC_PUSH_OBJECT,
+    [VM_OC_SET_PROPERTY] = &&vm_label_VM_OC_SET_PROPERTY,
+    [VM_OC_SET_GETTER] = &&vm_label_VM_OC_SET_GETTER,
+    [VM_OC_SET_SETTER] = &&vm_label_VM_OC_SET_SETTER,
+    [VM_OC_PUSH_UNDEFINED_BASE] = &&vm_label_VM_OC_PUSH_UNDEFINED_BASE,
+    [VM_OC_PUSH_LITERAL_BASE] = &&vm_label_VM_OC_PUSH_LITERAL_BASE,
+    [VM_OC_PUSH_ARRAY] = &&vm_label_VM_OC_PUSH_ARRAY,
+    [VM_OC_PUSH_ELISON] = &&vm_label_VM_OC_PUSH_ELISON,
+    [VM_OC_APPEND_ARRAY] = &&vm_label_VM_OC_APPEND_ARRAY,
+    [VM_OC_IDENT_REFERENCE] = &&vm_label_VM_OC_IDENT_REFERENCE,
+    [VM_OC_ARGUMENTS_LENGTH] = &&vm_label_VM_OC_ARGUMENTS_LENGTH,
+    [VM_OC_ARGUMENT_GET] = &&vm_label_VM_OC_ARGUMENT_GET,
+    [VM_OC_PROP_REFERENCE] = &&vm_label_VM_OC_PROP_REFERENCE,
+    [VM_OC_PROP_GET] = &&vm_label_VM_OC_PROP_GET,
+    [VM_OC_PROP_PRE_INCR] = &&vm_label_VM_OC_PROP_PRE_INCR,
+    [VM_OC_PROP_PRE_DECR] = &&vm_label_VM_OC_PROP_PRE_DECR,
+    [VM_OC_PROP_POST_INCR] = &&vm_label_VM_OC_PROP_POST_INCR,
+    [VM_OC_PROP_POST_DECR] = &&vm_label_VM_OC_PROP_POST_DECR,
+    [VM_OC_PRE_INCR] = &&vm_label_VM_OC_PRE_INCR,
+    [VM_OC_PRE_DECR] = &&vm_label_VM_OC_PRE_DECR,
+    [VM_OC_POST_INCR] = &&vm_label_VM_OC_POST_INCR,
+    [VM_OC_POST_DECR] = &&vm_label_VM_OC_POST_DECR,
+    [VM_OC_PROP_DELETE] = &&vm_label_VM_OC_PROP_DELETE,
+    [VM_OC_DELETE] = &&vm_label_VM_OC_DELETE,
+    [VM_OC_ASSIGN] = &&vm_label_VM_OC_ASSIGN,
+    [VM_OC_ASSIGN_PROP] = &&vm_label_VM_OC_ASSIGN_PROP,
+    [VM_OC_ASSIGN_PROP_THIS] = &&vm_label_VM_OC_ASSIGN_PROP_THIS,
+    [VM_OC_RET] = &&vm_label_VM_OC_RET,
+    [VM_OC_THROW] = &&vm_label_VM_OC_THROW,
+    [VM_OC_THROW_REFERENCE_ERROR] = &&vm_label_VM_OC_THROW_REFERENCE_ERROR,
+    [VM_OC_EVAL] = &&vm_label_VM_OC_EVAL,
+    [VM_OC_CALL] = &&vm_label_VM_OC_CALL,
+    [VM_OC_NEW] = &&vm_label_VM_OC_NEW,
+    [VM_OC_JUMP] = &&vm_label_VM_OC_JUMP,
+    [VM_OC_BRANCH_IF_STRICT_EQUAL] = &&vm_label_VM_OC_BRANCH_IF_STRICT_EQUAL,
+    [VM_OC_BRANCH_IF_TRUE] = &&vm_label_VM_OC_BRANCH_IF_TRUE,
+    [VM_OC_BRANCH_IF_FALSE] = &&vm_label_VM_OC_BRANCH_IF_FALSE,
+    [VM_OC_BRANCH_IF_LOGICAL_TRUE] = &&vm_label_VM_OC_BRANCH_IF_LOGICAL_TRUE,
+    [VM_OC_BRANCH_IF_LOGICAL_FALSE] = &&vm_label_VM_OC_BRANCH_IF_LOGICAL_FALSE,
+    [VM_OC_PLUS] = &&vm_label_VM_OC_PLUS,
+    [VM_OC_MINUS] = &&vm_label_VM_OC_MINUS,
+    [VM_OC_NOT] = &&vm_label_VM_OC_NOT,
+    [VM_OC_BIT_NOT] = &&vm_label_VM_OC_BIT_NOT,
+    [VM_OC_VOID] = &&vm_label_VM_OC_VOID,
+    [VM_OC_TYPEOF_IDENT] = &&vm_label_VM_OC_TYPEOF_IDENT,
+    [VM_OC_TYPEOF] = &&vm_label_VM_OC_TYPEOF,
+    [VM_OC_ADD] = &&vm_label_VM_OC_ADD,
+    [VM_OC_SUB] = &&vm_label_VM_OC_SUB,
+    [VM_OC_MUL] = &&vm_label_VM_OC_MUL,
+    [VM_OC_DIV] = &&vm_label_VM_OC_DIV,
+    [VM_OC_MOD] = &&vm_label_VM_OC_MOD,
+    [VM_OC_EQUAL] = &&vm_label_VM_OC_EQUAL,
+    [VM_OC_NOT_EQUAL] = &&vm_label_VM_OC_NOT_EQUAL,
+    [VM_OC_STRICT_EQUAL] = &&vm_label_VM_OC_STRICT_EQUAL,
+    [VM_OC_STRICT_NOT_EQUAL] = &&vm_label_VM_OC_STRICT_NOT_EQUAL,
+    [VM_OC_LESS] = &&vm_label_VM_OC_LESS,
+    [VM_OC_GREATER] = &&vm_label_VM_OC_GREATER,
+    [VM_OC_LESS_EQUAL] = &&vm_label_VM_OC_LESS_EQUAL,
+    [VM_OC_GREATER_EQUAL] = &&vm_label_VM_OC_GREATER_EQUAL,
+    [VM_OC_IN] = &&vm_label_VM_OC_IN,
+    [VM_OC_INSTANCEOF] = &&vm_label_VM_OC_INSTANCEOF,
+    [VM_OC_BIT_OR] = &&vm_label_VM_OC_BIT_OR,
+    [VM_OC_BIT_XOR] = &&vm_label_VM_OC_BIT_XOR,
+    [VM_OC_BIT_AND] = &&vm_label_VM_OC_BIT_AND,
+    [VM_OC_LEFT_SHIFT] = &&vm_label_VM_OC_LEFT_SHIFT,
+    [VM_OC_RIGHT_SHIFT] = &&vm_label_VM_OC_RIGHT_SHIFT,
+    [VM_OC_UNS_RIGHT_SHIFT] = &&vm_label_VM_OC_UNS_RIGHT_SHIFT,
+    [VM_OC_WITH] = &&vm_label_VM_OC_WITH,
+    [VM_OC_FOR_IN_CREATE_CONTEXT] = &&vm_label_VM_OC_FOR_IN_CREATE_CONTEXT,
+    [VM_OC_FOR_IN_GET_NEXT] = &&vm_label_VM_OC_FOR_IN_GET_NEXT,
+    [VM_OC_FOR_IN_HAS_NEXT] = &&vm_label_VM_OC_FOR_IN_HAS_NEXT,
+    [VM_OC_TRY] = &&vm_label_VM_OC_TRY,
+    [VM_OC_CATCH] = &&vm_label_VM_OC_CATCH,
+    [VM_OC_FINALLY] = &&vm_label_VM_OC_FINALLY,
+    [VM_OC_CONTEXT_END] = &&vm_label_VM_OC_CONTEXT_END,
+    [VM_OC_JUMP_AND_EXIT_CONTEXT] = &&vm_label_VM_OC_JUMP_AND_EXIT_CONTEXT,
+    [VM_OC_BREAKPOINT_ENABLED] = &&vm_label_VM_OC_BREAKPOINT_ENABLED,
+    [VM_OC_BREAKPOINT_DISABLED] = &&vm_label_VM_OC_BREAKPOINT_DISABLED
+  };
+#endif /* VM_THREADED_DISPATCH */
+
   /* Prepare for byte code execution. */
   if (!(bytecode_header_p->status_flags & CBC_CODE_FLAGS_FULL_LITERAL_ENCODING))
   {
@@ -768,6 +1325,10 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
         opcode_data = (uint32_t) ((CBC_END + 1) + opcode);
       }
 
+#if defined (JMEM_PROFILE) && defined (PROF_OPCODE)
+      profile_opcode_on_execute (bytecode_header_p, opcode_data); /* Opcode profiling */
+#endif /* JMEM_PROFILE && PROF_OPCODE */
+
       opcode_data = vm_decode_table[opcode_data];
 
       left_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
@@ -856,23 +1417,12 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
         if (opcode_data & VM_OC_BACKWARD_BRANCH)
         {
 #ifdef JERRY_VM_EXEC_STOP
-          if (JERRY_CONTEXT (vm_exec_stop_cb) != NULL
-              && --JERRY_CONTEXT (vm_exec_stop_counter) == 0)
+          if (JERRY_CONTEXT (vm_exec_stop_pending))
           {
-            result = JERRY_CONTEXT (vm_exec_stop_cb) (JERRY_CONTEXT (vm_exec_stop_user_p));
+            result = vm_exec_stop_check ();
 
-            if (ecma_is_value_undefined (result))
+            if (!ecma_is_value_undefined (result))
             {
-              JERRY_CONTEXT (vm_exec_stop_counter) = JERRY_CONTEXT (vm_exec_stop_frequency);
-            }
-            else
-            {
-              JERRY_CONTEXT (vm_exec_stop_counter) = 1;
-
-              if (!ECMA_IS_VALUE_ERROR (result))
-              {
-                result = ecma_make_error_value (result);
-              }
               goto error;
             }
           }
@@ -882,37 +1432,42 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
         }
       }
 
+#ifdef VM_THREADED_DISPATCH
+      JERRY_ASSERT (VM_OC_GROUP_GET_INDEX (opcode_data) < sizeof (vm_dispatch_table) / sizeof (vm_dispatch_table[0]));
+      __extension__ ({ goto *vm_dispatch_table[VM_OC_GROUP_GET_INDEX (opcode_data)]; });
+#endif /* VM_THREADED_DISPATCH */
+
       switch (VM_OC_GROUP_GET_INDEX (opcode_data))
       {
-        case VM_OC_NONE:
+        VM_CASE (VM_OC_NONE):
         {
           JERRY_ASSERT (opcode == CBC_EXT_DEBUGGER);
           continue;
         }
-        case VM_OC_POP:
+        VM_CASE (VM_OC_POP):
         {
           JERRY_ASSERT (stack_top_p > frame_ctx_p->registers_p + register_end);
           ecma_free_value (*(--stack_top_p));
           continue;
         }
-        case VM_OC_POP_BLOCK:
+        VM_CASE (VM_OC_POP_BLOCK):
         {
           ecma_fast_free_value (block_result);
           block_result = *(--stack_top_p);
           continue;
         }
-        case VM_OC_PUSH:
+        VM_CASE (VM_OC_PUSH):
         {
           *stack_top_p++ = left_value;
           continue;
         }
-        case VM_OC_PUSH_TWO:
+        VM_CASE (VM_OC_PUSH_TWO):
         {
           *stack_top_p++ = left_value;
           *stack_top_p++ = right_value;
           continue;
         }
-        case VM_OC_PUSH_THREE:
+        VM_CASE (VM_OC_PUSH_THREE):
         {
           uint16_t literal_index;
 
@@ -926,49 +1481,49 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = left_value;
           continue;
         }
-        case VM_OC_PUSH_UNDEFINED:
+        VM_CASE (VM_OC_PUSH_UNDEFINED):
         {
           *stack_top_p++ = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           continue;
         }
-        case VM_OC_PUSH_TRUE:
+        VM_CASE (VM_OC_PUSH_TRUE):
         {
           *stack_top_p++ = ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
           continue;
         }
-        case VM_OC_PUSH_FALSE:
+        VM_CASE (VM_OC_PUSH_FALSE):
         {
           *stack_top_p++ = ecma_make_simple_value (ECMA_SIMPLE_VALUE_FALSE);
           continue;
         }
-        case VM_OC_PUSH_NULL:
+        VM_CASE (VM_OC_PUSH_NULL):
         {
           *stack_top_p++ = ecma_make_simple_value (ECMA_SIMPLE_VALUE_NULL);
           continue;
         }
-        case VM_OC_PUSH_THIS:
+        VM_CASE (VM_OC_PUSH_THIS):
         {
           *stack_top_p++ = ecma_copy_value (frame_ctx_p->this_binding);
           continue;
         }
-        case VM_OC_PUSH_NUMBER_0:
+        VM_CASE (VM_OC_PUSH_NUMBER_0):
         {
           *stack_top_p++ = ecma_make_integer_value (0);
           continue;
         }
-        case VM_OC_PUSH_NUMBER_POS_BYTE:
+        VM_CASE (VM_OC_PUSH_NUMBER_POS_BYTE):
         {
           ecma_integer_value_t number = *byte_code_p++;
           *stack_top_p++ = ecma_make_integer_value (number + 1);
           continue;
         }
-        case VM_OC_PUSH_NUMBER_NEG_BYTE:
+        VM_CASE (VM_OC_PUSH_NUMBER_NEG_BYTE):
         {
           ecma_integer_value_t number = *byte_code_p++;
           *stack_top_p++ = ecma_make_integer_value (-(number + 1));
           continue;
         }
-        case VM_OC_PUSH_OBJECT:
+        VM_CASE (VM_OC_PUSH_OBJECT):
         {
           ecma_object_t *prototype_p = ecma_builtin_get (ECMA_BUILTIN_ID_OBJECT_PROTOTYPE);
           ecma_object_t *obj_p = ecma_create_object (prototype_p,
@@ -979,7 +1534,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = ecma_make_object_value (obj_p);
           continue;
         }
-        case VM_OC_SET_PROPERTY:
+        VM_CASE (VM_OC_SET_PROPERTY):
         {
           ecma_object_t *object_p = ecma_get_object_from_value (stack_top_p[-1]);
           ecma_string_t *prop_name_p;
@@ -1033,8 +1588,8 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
 
           goto free_both_values;
         }
-        case VM_OC_SET_GETTER:
-        case VM_OC_SET_SETTER:
+        VM_CASE (VM_OC_SET_GETTER):
+        VM_CASE (VM_OC_SET_SETTER):
         {
           opfunc_set_accessor (VM_OC_GROUP_GET_INDEX (opcode_data) == VM_OC_SET_GETTER ? true : false,
                                stack_top_p[-1],
@@ -1043,7 +1598,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
 
           goto free_both_values;
         }
-        case VM_OC_PUSH_ARRAY:
+        VM_CASE (VM_OC_PUSH_ARRAY):
         {
           result = ecma_op_create_array_object (NULL, 0, false);
 
@@ -1055,12 +1610,12 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           continue;
         }
-        case VM_OC_PUSH_ELISON:
+        VM_CASE (VM_OC_PUSH_ELISON):
         {
           *stack_top_p++ = ecma_make_simple_value (ECMA_SIMPLE_VALUE_ARRAY_HOLE);
           continue;
         }
-        case VM_OC_APPEND_ARRAY:
+        VM_CASE (VM_OC_APPEND_ARRAY):
         {
           ecma_object_t *array_obj_p;
           uint32_t length_num;
@@ -1077,6 +1632,16 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           {
             if (!ecma_is_value_array_hole (stack_top_p[i]))
             {
+#ifdef CONFIG_ECMA_FAST_ARRAY
+              if (ext_array_obj_p->u.array.is_fast
+                  && ecma_fast_array_add_element (array_obj_p, length_num, stack_top_p[i]))
+              {
+                ecma_free_value (stack_top_p[i]);
+                length_num++;
+                continue;
+              }
+#endif /* CONFIG_ECMA_FAST_ARRAY */
+
               ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (length_num);
 
               ecma_property_value_t *prop_value_p;
@@ -1103,14 +1668,21 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           ext_array_obj_p->u.array.length = length_num;
           continue;
         }
-        case VM_OC_PUSH_UNDEFINED_BASE:
+        VM_CASE (VM_OC_PUSH_UNDEFINED_BASE):
         {
           stack_top_p[0] = stack_top_p[-1];
           stack_top_p[-1] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           stack_top_p++;
           continue;
         }
-        case VM_OC_IDENT_REFERENCE:
+        VM_CASE (VM_OC_PUSH_LITERAL_BASE):
+        {
+          stack_top_p[0] = stack_top_p[-1];
+          stack_top_p[-1] = left_value;
+          stack_top_p++;
+          continue;
+        }
+        VM_CASE (VM_OC_IDENT_REFERENCE):
         {
           uint16_t literal_index;
 
@@ -1150,7 +1722,37 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           continue;
         }
-        case VM_OC_PROP_REFERENCE:
+        VM_CASE (VM_OC_ARGUMENTS_LENGTH):
+        {
+          if (bytecode_header_p->status_flags & CBC_CODE_FLAGS_ARGUMENTS_NEEDED)
+          {
+            ecma_string_t *length_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LENGTH);
+            result = vm_op_get_argument (frame_ctx_p,
+                                         ecma_make_string_value (length_str_p),
+                                         byte_code_start_p);
+            ecma_deref_ecma_string (length_str_p);
+
+            if (ECMA_IS_VALUE_ERROR (result))
+            {
+              goto error;
+            }
+            break;
+          }
+
+          result = ecma_make_uint32_value (frame_ctx_p->arg_list_len);
+          break;
+        }
+        VM_CASE (VM_OC_ARGUMENT_GET):
+        {
+          result = vm_op_get_argument (frame_ctx_p, left_value, byte_code_start_p);
+
+          if (ECMA_IS_VALUE_ERROR (result))
+          {
+            goto error;
+          }
+          break;
+        }
+        VM_CASE (VM_OC_PROP_REFERENCE):
         {
           /* Forms with reference requires preserving the base and offset. */
 
@@ -1174,14 +1776,15 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           /* FALLTHRU */
         }
-        case VM_OC_PROP_GET:
-        case VM_OC_PROP_PRE_INCR:
-        case VM_OC_PROP_PRE_DECR:
-        case VM_OC_PROP_POST_INCR:
-        case VM_OC_PROP_POST_DECR:
+        VM_CASE (VM_OC_PROP_GET):
+        VM_CASE (VM_OC_PROP_PRE_INCR):
+        VM_CASE (VM_OC_PROP_PRE_DECR):
+        VM_CASE (VM_OC_PROP_POST_INCR):
+        VM_CASE (VM_OC_PROP_POST_DECR):
         {
           result = vm_op_get_value (left_value,
-                                    right_value);
+                                    right_value,
+                                    byte_code_start_p);
 
           if (ECMA_IS_VALUE_ERROR (result))
           {
@@ -1208,10 +1811,10 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           right_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           /* FALLTHRU */
         }
-        case VM_OC_PRE_INCR:
-        case VM_OC_PRE_DECR:
-        case VM_OC_POST_INCR:
-        case VM_OC_POST_DECR:
+        VM_CASE (VM_OC_PRE_INCR):
+        VM_CASE (VM_OC_PRE_DECR):
+        VM_CASE (VM_OC_POST_INCR):
+        VM_CASE (VM_OC_POST_DECR):
         {
           uint32_t opcode_flags = VM_OC_GROUP_GET_INDEX (opcode_data) - VM_OC_PROP_PRE_INCR;
 
@@ -1347,20 +1950,20 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_ASSIGN:
+        VM_CASE (VM_OC_ASSIGN):
         {
           result = left_value;
           left_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           break;
         }
-        case VM_OC_ASSIGN_PROP:
+        VM_CASE (VM_OC_ASSIGN_PROP):
         {
           result = stack_top_p[-1];
           stack_top_p[-1] = left_value;
           left_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           break;
         }
-        case VM_OC_ASSIGN_PROP_THIS:
+        VM_CASE (VM_OC_ASSIGN_PROP_THIS):
         {
           result = stack_top_p[-1];
           stack_top_p[-1] = ecma_copy_value (frame_ctx_p->this_binding);
@@ -1368,7 +1971,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           left_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           break;
         }
-        case VM_OC_RET:
+        VM_CASE (VM_OC_RET):
         {
           JERRY_ASSERT (opcode == CBC_RETURN
                         || opcode == CBC_RETURN_WITH_BLOCK
@@ -1384,24 +1987,24 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           left_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           goto error;
         }
-        case VM_OC_THROW:
+        VM_CASE (VM_OC_THROW):
         {
           result = ecma_make_error_value (left_value);
           left_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           goto error;
         }
-        case VM_OC_THROW_REFERENCE_ERROR:
+        VM_CASE (VM_OC_THROW_REFERENCE_ERROR):
         {
           result = ecma_raise_reference_error (ECMA_ERR_MSG ("Undefined reference."));
           goto error;
         }
-        case VM_OC_EVAL:
+        VM_CASE (VM_OC_EVAL):
         {
           JERRY_CONTEXT (is_direct_eval_form_call) = true;
           JERRY_ASSERT (*byte_code_p >= CBC_CALL && *byte_code_p <= CBC_CALL2_PROP_BLOCK);
           continue;
         }
-        case VM_OC_CALL:
+        VM_CASE (VM_OC_CALL):
         {
           if (frame_ctx_p->call_operation == VM_NO_EXEC_OP)
           {
@@ -1442,7 +2045,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           continue;
         }
-        case VM_OC_NEW:
+        VM_CASE (VM_OC_NEW):
         {
           if (frame_ctx_p->call_operation == VM_NO_EXEC_OP)
           {
@@ -1471,7 +2074,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           continue;
         }
-        case VM_OC_PROP_DELETE:
+        VM_CASE (VM_OC_PROP_DELETE):
         {
           result = vm_op_delete_prop (left_value, right_value, is_strict);
 
@@ -1485,7 +2088,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_DELETE:
+        VM_CASE (VM_OC_DELETE):
         {
           uint16_t literal_index;
 
@@ -1510,12 +2113,12 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           continue;
         }
-        case VM_OC_JUMP:
+        VM_CASE (VM_OC_JUMP):
         {
           byte_code_p = byte_code_start_p + branch_offset;
           continue;
         }
-        case VM_OC_BRANCH_IF_STRICT_EQUAL:
+        VM_CASE (VM_OC_BRANCH_IF_STRICT_EQUAL):
         {
           ecma_value_t value = *(--stack_top_p);
 
@@ -1529,10 +2132,10 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           ecma_free_value (value);
           continue;
         }
-        case VM_OC_BRANCH_IF_TRUE:
-        case VM_OC_BRANCH_IF_FALSE:
-        case VM_OC_BRANCH_IF_LOGICAL_TRUE:
-        case VM_OC_BRANCH_IF_LOGICAL_FALSE:
+        VM_CASE (VM_OC_BRANCH_IF_TRUE):
+        VM_CASE (VM_OC_BRANCH_IF_FALSE):
+        VM_CASE (VM_OC_BRANCH_IF_LOGICAL_TRUE):
+        VM_CASE (VM_OC_BRANCH_IF_LOGICAL_FALSE):
         {
           uint32_t opcode_flags = VM_OC_GROUP_GET_INDEX (opcode_data) - VM_OC_BRANCH_IF_TRUE;
           ecma_value_t value = *(--stack_top_p);
@@ -1558,7 +2161,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           ecma_fast_free_value (value);
           continue;
         }
-        case VM_OC_PLUS:
+        VM_CASE (VM_OC_PLUS):
         {
           result = opfunc_unary_plus (left_value);
 
@@ -1570,7 +2173,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_left_value;
         }
-        case VM_OC_MINUS:
+        VM_CASE (VM_OC_MINUS):
         {
           result = opfunc_unary_minus (left_value);
 
@@ -1582,7 +2185,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_left_value;
         }
-        case VM_OC_NOT:
+        VM_CASE (VM_OC_NOT):
         {
           result = opfunc_logical_not (left_value);
 
@@ -1594,7 +2197,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_left_value;
         }
-        case VM_OC_BIT_NOT:
+        VM_CASE (VM_OC_BIT_NOT):
         {
           result = do_number_bitwise_logic (NUMBER_BITWISE_NOT,
                                             left_value,
@@ -1608,12 +2211,12 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_left_value;
         }
-        case VM_OC_VOID:
+        VM_CASE (VM_OC_VOID):
         {
           *stack_top_p++ = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
           goto free_left_value;
         }
-        case VM_OC_TYPEOF_IDENT:
+        VM_CASE (VM_OC_TYPEOF_IDENT):
         {
           uint16_t literal_index;
 
@@ -1654,7 +2257,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           /* FALLTHRU */
         }
-        case VM_OC_TYPEOF:
+        VM_CASE (VM_OC_TYPEOF):
         {
           result = opfunc_typeof (left_value);
 
@@ -1666,7 +2269,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_left_value;
         }
-        case VM_OC_ADD:
+        VM_CASE (VM_OC_ADD):
         {
           if (ecma_are_values_integer_numbers (left_value, right_value))
           {
@@ -1706,7 +2309,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_SUB:
+        VM_CASE (VM_OC_SUB):
         {
           JERRY_STATIC_ASSERT (ECMA_INTEGER_NUMBER_MAX * 2 <= INT32_MAX
                                && ECMA_INTEGER_NUMBER_MIN * 2 >= INT32_MIN,
@@ -1755,7 +2358,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_MUL:
+        VM_CASE (VM_OC_MUL):
         {
           JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (left_value)
                         && !ECMA_IS_VALUE_ERROR (right_value));
@@ -1818,7 +2421,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_DIV:
+        VM_CASE (VM_OC_DIV):
         {
           JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (left_value)
                         && !ECMA_IS_VALUE_ERROR (right_value));
@@ -1833,7 +2436,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_MOD:
+        VM_CASE (VM_OC_MOD):
         {
           JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (left_value)
                         && !ECMA_IS_VALUE_ERROR (right_value));
@@ -1865,7 +2468,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_EQUAL:
+        VM_CASE (VM_OC_EQUAL):
         {
           result = opfunc_equal_value (left_value, right_value);
 
@@ -1877,7 +2480,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_NOT_EQUAL:
+        VM_CASE (VM_OC_NOT_EQUAL):
         {
           result = opfunc_not_equal_value (left_value, right_value);
 
@@ -1889,7 +2492,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_STRICT_EQUAL:
+        VM_CASE (VM_OC_STRICT_EQUAL):
         {
           bool is_equal = ecma_op_strict_equality_compare (left_value, right_value);
 
@@ -1898,7 +2501,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_STRICT_NOT_EQUAL:
+        VM_CASE (VM_OC_STRICT_NOT_EQUAL):
         {
           bool is_equal = ecma_op_strict_equality_compare (left_value, right_value);
 
@@ -1907,8 +2510,16 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_BIT_OR:
+        VM_CASE (VM_OC_BIT_OR):
         {
+          if (ecma_are_values_integer_numbers (left_value, right_value))
+          {
+            ecma_integer_value_t left_integer = ecma_get_integer_from_value (left_value);
+            ecma_integer_value_t right_integer = ecma_get_integer_from_value (right_value);
+            result = ecma_make_int32_value (left_integer | right_integer);
+            break;
+          }
+
           result = do_number_bitwise_logic (NUMBER_BITWISE_LOGIC_OR,
                                             left_value,
                                             right_value);
@@ -1919,8 +2530,16 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_BIT_XOR:
+        VM_CASE (VM_OC_BIT_XOR):
         {
+          if (ecma_are_values_integer_numbers (left_value, right_value))
+          {
+            ecma_integer_value_t left_integer = ecma_get_integer_from_value (left_value);
+            ecma_integer_value_t right_integer = ecma_get_integer_from_value (right_value);
+            result = ecma_make_int32_value (left_integer ^ right_integer);
+            break;
+          }
+
           result = do_number_bitwise_logic (NUMBER_BITWISE_LOGIC_XOR,
                                             left_value,
                                             right_value);
@@ -1931,8 +2550,16 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_BIT_AND:
+        VM_CASE (VM_OC_BIT_AND):
         {
+          if (ecma_are_values_integer_numbers (left_value, right_value))
+          {
+            ecma_integer_value_t left_integer = ecma_get_integer_from_value (left_value);
+            ecma_integer_value_t right_integer = ecma_get_integer_from_value (right_value);
+            result = ecma_make_int32_value (left_integer & right_integer);
+            break;
+          }
+
           result = do_number_bitwise_logic (NUMBER_BITWISE_LOGIC_AND,
                                             left_value,
                                             right_value);
@@ -1943,8 +2570,16 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_LEFT_SHIFT:
+        VM_CASE (VM_OC_LEFT_SHIFT):
         {
+          if (ecma_are_values_integer_numbers (left_value, right_value))
+          {
+            ecma_integer_value_t left_integer = ecma_get_integer_from_value (left_value);
+            ecma_integer_value_t right_integer = ecma_get_integer_from_value (right_value);
+            result = ecma_make_int32_value ((int32_t) ((uint32_t) left_integer << ((uint32_t) right_integer & 0x1f)));
+            break;
+          }
+
           result = do_number_bitwise_logic (NUMBER_BITWISE_SHIFT_LEFT,
                                             left_value,
                                             right_value);
@@ -1955,8 +2590,16 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_RIGHT_SHIFT:
+        VM_CASE (VM_OC_RIGHT_SHIFT):
         {
+          if (ecma_are_values_integer_numbers (left_value, right_value))
+          {
+            ecma_integer_value_t left_integer = ecma_get_integer_from_value (left_value);
+            ecma_integer_value_t right_integer = ecma_get_integer_from_value (right_value);
+            result = ecma_make_int32_value (left_integer >> ((uint32_t) right_integer & 0x1f));
+            break;
+          }
+
           result = do_number_bitwise_logic (NUMBER_BITWISE_SHIFT_RIGHT,
                                             left_value,
                                             right_value);
@@ -1967,8 +2610,16 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_UNS_RIGHT_SHIFT:
+        VM_CASE (VM_OC_UNS_RIGHT_SHIFT):
         {
+          if (ecma_are_values_integer_numbers (left_value, right_value))
+          {
+            ecma_integer_value_t left_integer = ecma_get_integer_from_value (left_value);
+            ecma_integer_value_t right_integer = ecma_get_integer_from_value (right_value);
+            result = ecma_make_uint32_value ((uint32_t) left_integer >> ((uint32_t) right_integer & 0x1f));
+            break;
+          }
+
           result = do_number_bitwise_logic (NUMBER_BITWISE_SHIFT_URIGHT,
                                             left_value,
                                             right_value);
@@ -1979,7 +2630,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           }
           break;
         }
-        case VM_OC_LESS:
+        VM_CASE (VM_OC_LESS):
         {
           if (ecma_are_values_integer_numbers (left_value, right_value))
           {
@@ -2009,7 +2660,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_GREATER:
+        VM_CASE (VM_OC_GREATER):
         {
           if (ecma_are_values_integer_numbers (left_value, right_value))
           {
@@ -2039,7 +2690,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_LESS_EQUAL:
+        VM_CASE (VM_OC_LESS_EQUAL):
         {
           if (ecma_are_values_integer_numbers (left_value, right_value))
           {
@@ -2069,7 +2720,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_GREATER_EQUAL:
+        VM_CASE (VM_OC_GREATER_EQUAL):
         {
           if (ecma_are_values_integer_numbers (left_value, right_value))
           {
@@ -2099,7 +2750,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_IN:
+        VM_CASE (VM_OC_IN):
         {
           result = opfunc_in (left_value, right_value);
 
@@ -2111,7 +2762,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_INSTANCEOF:
+        VM_CASE (VM_OC_INSTANCEOF):
         {
           result = opfunc_instanceof (left_value, right_value);
 
@@ -2123,7 +2774,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           *stack_top_p++ = result;
           goto free_both_values;
         }
-        case VM_OC_WITH:
+        VM_CASE (VM_OC_WITH):
         {
           ecma_value_t value = *(--stack_top_p);
           ecma_object_t *object_p;
@@ -2158,14 +2809,15 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           frame_ctx_p->lex_env_p = with_env_p;
           continue;
         }
-        case VM_OC_FOR_IN_CREATE_CONTEXT:
+        VM_CASE (VM_OC_FOR_IN_CREATE_CONTEXT):
         {
           ecma_value_t value = *(--stack_top_p);
 
           JERRY_ASSERT (frame_ctx_p->registers_p + register_end + frame_ctx_p->context_depth == stack_top_p);
 
           ecma_value_t expr_obj_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
-          ecma_collection_header_t *header_p = opfunc_for_in (value, &expr_obj_value);
+          bool is_shared;
+          ecma_collection_header_t *header_p = opfunc_for_in (value, &expr_obj_value, &is_shared);
           ecma_free_value (value);
 
           if (header_p == NULL)
@@ -2179,54 +2831,97 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           VM_PLUS_EQUAL_U16 (frame_ctx_p->context_depth, PARSER_FOR_IN_CONTEXT_STACK_ALLOCATION);
           stack_top_p += PARSER_FOR_IN_CONTEXT_STACK_ALLOCATION;
           stack_top_p[-1] = (ecma_value_t) VM_CREATE_CONTEXT (VM_CONTEXT_FOR_IN, branch_offset);
-          stack_top_p[-2] = header_p->first_chunk_cp;
-          stack_top_p[-3] = expr_obj_value;
+          ECMA_SET_NON_NULL_POINTER (stack_top_p[-2], header_p);
+          stack_top_p[-3] = 0;
+          stack_top_p[-4] = expr_obj_value;
 
-          ecma_dealloc_collection_header (header_p);
+#ifdef CONFIG_ECMA_ENUM_CACHE
+          if (is_shared)
+          {
+            /* The names of the cached list are not consumed by the loop. */
+            stack_top_p[-1] = (ecma_value_t) VM_CREATE_CONTEXT (VM_CONTEXT_FOR_IN_SHARED, branch_offset);
+          }
+#else /* !CONFIG_ECMA_ENUM_CACHE */
+          JERRY_ASSERT (!is_shared);
+#endif /* CONFIG_ECMA_ENUM_CACHE */
           continue;
         }
-        case VM_OC_FOR_IN_GET_NEXT:
+        VM_CASE (VM_OC_FOR_IN_GET_NEXT):
         {
           ecma_value_t *context_top_p = frame_ctx_p->registers_p + register_end + frame_ctx_p->context_depth;
-          ecma_collection_chunk_t *chunk_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_collection_chunk_t, context_top_p[-2]);
+          ecma_collection_header_t *header_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_collection_header_t,
+                                                                             context_top_p[-2]);
+          ecma_value_t *buffer_p = ecma_get_values_collection_buffer (header_p);
+          ecma_length_t index = context_top_p[-3];
 
-          JERRY_ASSERT (VM_GET_CONTEXT_TYPE (context_top_p[-1]) == VM_CONTEXT_FOR_IN);
+          JERRY_ASSERT (index < header_p->unit_number);
 
-          lit_utf8_byte_t *data_ptr = chunk_p->data;
-          result = *(ecma_value_t *) data_ptr;
-          context_top_p[-2] = chunk_p->next_chunk_cp;
+          result = buffer_p[index];
+          context_top_p[-3] = index + 1;
 
-          ecma_dealloc_collection_chunk (chunk_p);
+#ifdef CONFIG_ECMA_ENUM_CACHE
+          if (VM_GET_CONTEXT_TYPE (context_top_p[-1]) == VM_CONTEXT_FOR_IN_SHARED)
+          {
+            *stack_top_p++ = ecma_copy_value (result);
+            continue;
+          }
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
+          JERRY_ASSERT (VM_GET_CONTEXT_TYPE (context_top_p[-1]) == VM_CONTEXT_FOR_IN);
+
+          /* The name is moved to the stack. */
+          buffer_p[index] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
 
           *stack_top_p++ = result;
           continue;
         }
-        case VM_OC_FOR_IN_HAS_NEXT:
+        VM_CASE (VM_OC_FOR_IN_HAS_NEXT):
         {
           JERRY_ASSERT (frame_ctx_p->registers_p + register_end + frame_ctx_p->context_depth == stack_top_p);
 
+          ecma_collection_header_t *header_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_collection_header_t,
+                                                                             stack_top_p[-2]);
+          ecma_value_t *buffer_p = ecma_get_values_collection_buffer (header_p);
+          ecma_length_t index = stack_top_p[-3];
+
           while (true)
           {
-            if (stack_top_p[-2] == JMEM_CP_NULL)
+            if (index == header_p->unit_number)
             {
-              ecma_free_value (stack_top_p[-3]);
+#ifdef CONFIG_ECMA_ENUM_CACHE
+              if (VM_GET_CONTEXT_TYPE (stack_top_p[-1]) == VM_CONTEXT_FOR_IN_SHARED)
+              {
+                ecma_enum_cache_release ();
+              }
+              else
+              {
+                ecma_free_values_collection (header_p, true);
+              }
+#else /* !CONFIG_ECMA_ENUM_CACHE */
+              ecma_free_values_collection (header_p, true);
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+
+              ecma_free_value (stack_top_p[-4]);
 
               VM_MINUS_EQUAL_U16 (frame_ctx_p->context_depth, PARSER_FOR_IN_CONTEXT_STACK_ALLOCATION);
               stack_top_p -= PARSER_FOR_IN_CONTEXT_STACK_ALLOCATION;
               break;
             }
 
-            ecma_collection_chunk_t *chunk_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_collection_chunk_t, stack_top_p[-2]);
+            ecma_string_t *prop_name_p = ecma_get_string_from_value (buffer_p[index]);
 
-            lit_utf8_byte_t *data_ptr = chunk_p->data;
-            ecma_string_t *prop_name_p = ecma_get_string_from_value (*(ecma_value_t *) data_ptr);
-
-            if (!ecma_op_object_has_property (ecma_get_object_from_value (stack_top_p[-3]),
+            if (!ecma_op_object_has_property (ecma_get_object_from_value (stack_top_p[-4]),
                                               prop_name_p))
             {
-              stack_top_p[-2] = chunk_p->next_chunk_cp;
-              ecma_deref_ecma_string (prop_name_p);
-              ecma_dealloc_collection_chunk (chunk_p);
+#ifdef CONFIG_ECMA_ENUM_CACHE
+              if (VM_GET_CONTEXT_TYPE (stack_top_p[-1]) != VM_CONTEXT_FOR_IN_SHARED)
+#endif /* CONFIG_ECMA_ENUM_CACHE */
+              {
+                ecma_deref_ecma_string (prop_name_p);
+                buffer_p[index] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+              }
+
+              stack_top_p[-3] = ++index;
             }
             else
             {
@@ -2237,7 +2932,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
 
           continue;
         }
-        case VM_OC_TRY:
+        VM_CASE (VM_OC_TRY):
         {
           /* Try opcode simply creates the try context. */
           branch_offset += (int32_t) (byte_code_start_p - frame_ctx_p->byte_code_start_p);
@@ -2250,7 +2945,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           stack_top_p[-1] = (ecma_value_t) VM_CREATE_CONTEXT (VM_CONTEXT_TRY, branch_offset);
           continue;
         }
-        case VM_OC_CATCH:
+        VM_CASE (VM_OC_CATCH):
         {
           /* Catches are ignored and turned to jumps. */
           JERRY_ASSERT (frame_ctx_p->registers_p + register_end + frame_ctx_p->context_depth == stack_top_p);
@@ -2259,7 +2954,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           byte_code_p = byte_code_start_p + branch_offset;
           continue;
         }
-        case VM_OC_FINALLY:
+        VM_CASE (VM_OC_FINALLY):
         {
           branch_offset += (int32_t) (byte_code_start_p - frame_ctx_p->byte_code_start_p);
 
@@ -2278,7 +2973,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           stack_top_p[-2] = (ecma_value_t) branch_offset;
           continue;
         }
-        case VM_OC_CONTEXT_END:
+        VM_CASE (VM_OC_CONTEXT_END):
         {
           JERRY_ASSERT (frame_ctx_p->registers_p + register_end + frame_ctx_p->context_depth == stack_top_p);
 
@@ -2334,7 +3029,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           JERRY_ASSERT (frame_ctx_p->registers_p + register_end + frame_ctx_p->context_depth == stack_top_p);
           continue;
         }
-        case VM_OC_JUMP_AND_EXIT_CONTEXT:
+        VM_CASE (VM_OC_JUMP_AND_EXIT_CONTEXT):
         {
           JERRY_ASSERT (frame_ctx_p->registers_p + register_end + frame_ctx_p->context_depth == stack_top_p);
 
@@ -2357,7 +3052,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           JERRY_ASSERT (frame_ctx_p->registers_p + register_end + frame_ctx_p->context_depth == stack_top_p);
           continue;
         }
-        case VM_OC_BREAKPOINT_ENABLED:
+        VM_CASE (VM_OC_BREAKPOINT_ENABLED):
         {
 #ifdef JERRY_DEBUGGER
           if (JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_VM_IGNORE)
@@ -2375,7 +3070,7 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
 #endif /* JERRY_DEBUGGER */
           continue;
         }
-        case VM_OC_BREAKPOINT_DISABLED:
+        VM_CASE (VM_OC_BREAKPOINT_DISABLED):
         {
 #ifdef JERRY_DEBUGGER
           if (JERRY_CONTEXT (debugger_flags) & JERRY_DEBUGGER_VM_IGNORE)
@@ -2405,6 +3100,8 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
 
           JERRY_CONTEXT (debugger_message_delay) = JERRY_DEBUGGER_MESSAGE_FREQUENCY;
 
+          jerry_debugger_profile_vm ();
+
           if (jerry_debugger_receive (NULL))
           {
             continue;
@@ -2492,7 +3189,8 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
           ecma_value_t set_value_result = vm_op_set_value (object,
                                                            property,
                                                            result,
-                                                           is_strict);
+                                                           is_strict,
+                                                           byte_code_start_p);
 
           if (ECMA_IS_VALUE_ERROR (set_value_result))
           {
@@ -2635,26 +3333,14 @@ error:
         }
 
 #ifdef JERRY_VM_EXEC_STOP
-        if (JERRY_CONTEXT (vm_exec_stop_cb) != NULL
-            && --JERRY_CONTEXT (vm_exec_stop_counter) == 0)
+        if (JERRY_CONTEXT (vm_exec_stop_pending))
         {
-          result = JERRY_CONTEXT (vm_exec_stop_cb) (JERRY_CONTEXT (vm_exec_stop_user_p));
+          result = vm_exec_stop_check ();
 
-          if (ecma_is_value_undefined (result))
-          {
-            JERRY_CONTEXT (vm_exec_stop_counter) = JERRY_CONTEXT (vm_exec_stop_frequency);
-          }
-          else
+          if (!ecma_is_value_undefined (result))
           {
-            JERRY_CONTEXT (vm_exec_stop_counter) = 1;
-
             left_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
             right_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
-
-            if (!ECMA_IS_VALUE_ERROR (result))
-            {
-              result = ecma_make_error_value (result);
-            }
             goto error;
           }
         }
@@ -2728,6 +3414,15 @@ vm_execute (vm_frame_ctx_t *frame_ctx_p, /**< frame context */
 
   JERRY_CONTEXT (is_direct_eval_form_call) = false;
 
+#ifdef JERRY_VM_EXEC_STOP
+  /* Code without loops is sampled when it calls a function. */
+  if (JERRY_CONTEXT (vm_exec_stop_pending) && JERRY_CONTEXT (vm_exec_sample_requested))
+  {
+    JERRY_CONTEXT (vm_exec_sample_requested) = 0;
+    profile_cpu_take_sample (); /* Sampling CPU profiling */
+  }
+#endif /* JERRY_VM_EXEC_STOP */
+
   JERRY_CONTEXT (vm_top_context_p) = frame_ctx_p;
 
   vm_init_loop (frame_ctx_p);
@@ -2782,7 +3477,8 @@ vm_run (const ecma_compiled_code_t *bytecode_header_p, /**< byte-code data heade
         ecma_object_t *lex_env_p, /**< lexical environment to use */
         bool is_eval_code, /**< is the code is eval code (ECMA-262 v5, 10.1) */
         const ecma_value_t *arg_list_p, /**< arguments list */
-        ecma_length_t arg_list_len) /**< length of arguments list */
+        ecma_length_t arg_list_len, /**< length of arguments list */
+        ecma_object_t *func_obj_p) /**< called function, NULL for global and eval code */
 {
   jmem_cpointer_t *literal_p;
   vm_frame_ctx_t frame_ctx;
@@ -2813,8 +3509,11 @@ vm_run (const ecma_compiled_code_t *bytecode_header_p, /**< byte-code data heade
   frame_ctx.byte_code_p = (uint8_t *) literal_p;
   frame_ctx.byte_code_start_p = (uint8_t *) literal_p;
   frame_ctx.lex_env_p = lex_env_p;
+  frame_ctx.arg_list_p = arg_list_p;
+  frame_ctx.func_obj_p = func_obj_p;
   frame_ctx.prev_context_p = JERRY_CONTEXT (vm_top_context_p);
   frame_ctx.this_binding = this_binding_value;
+  frame_ctx.arg_list_len = arg_list_len;
   frame_ctx.context_depth = 0;
   frame_ctx.is_eval_code = is_eval_code;
   frame_ctx.call_operation = VM_NO_EXEC_OP;
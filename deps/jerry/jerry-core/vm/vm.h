@@ -121,10 +121,13 @@ typedef enum
   VM_OC_SET_GETTER,              /**< set getter */
   VM_OC_SET_SETTER,              /**< set setter */
   VM_OC_PUSH_UNDEFINED_BASE,     /**< push undefined base */
+  VM_OC_PUSH_LITERAL_BASE,       /**< push literal base */
   VM_OC_PUSH_ARRAY,              /**< push array */
   VM_OC_PUSH_ELISON,             /**< push elison */
   VM_OC_APPEND_ARRAY,            /**< append array */
   VM_OC_IDENT_REFERENCE,         /**< ident reference */
+  VM_OC_ARGUMENTS_LENGTH,        /**< length of the arguments */
+  VM_OC_ARGUMENT_GET,            /**< argument get */
   VM_OC_PROP_REFERENCE,          /**< prop reference */
   VM_OC_PROP_GET,                /**< prop get */
 
@@ -281,7 +284,9 @@ ecma_value_t vm_run_eval (ecma_compiled_code_t *bytecode_data_p, bool is_direct)
 
 ecma_value_t vm_run (const ecma_compiled_code_t *bytecode_header_p, ecma_value_t this_binding_value,
                      ecma_object_t *lex_env_p, bool is_eval_code, const ecma_value_t *arg_list_p,
-                     ecma_length_t arg_list_len);
+                     ecma_length_t arg_list_len, ecma_object_t *func_obj_p);
+
+void vm_finalize_inline_caches (void);
 
 bool vm_is_strict_mode (void);
 bool vm_is_direct_eval_form_call (void);
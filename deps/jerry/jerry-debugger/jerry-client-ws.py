@@ -18,6 +18,7 @@ from __future__ import print_function
 from cmd import Cmd
 from pprint import pprint  # For the readable stack printing.
 import argparse
+import json
 import logging
 import re
 import select
@@ -51,6 +52,7 @@ JERRY_DEBUGGER_EVAL_RESULT_END = 22
 JERRY_DEBUGGER_WAIT_FOR_SOURCE = 23
 JERRY_DEBUGGER_OUTPUT_RESULT = 24
 JERRY_DEBUGGER_OUTPUT_RESULT_END = 25
+JERRY_DEBUGGER_PROFILE_SAMPLE = 26
 
 # Subtypes of eval
 JERRY_DEBUGGER_EVAL_OK = 1
@@ -79,6 +81,15 @@ JERRY_DEBUGGER_NEXT = 11
 JERRY_DEBUGGER_GET_BACKTRACE = 12
 JERRY_DEBUGGER_EVAL = 13
 JERRY_DEBUGGER_EVAL_PART = 14
+JERRY_DEBUGGER_PROFILE = 15
+
+# Kinds of profile samples, and the names of their values
+JERRY_DEBUGGER_PROFILE_KINDS = [
+    ("heap", ["usage", "peak", "allocated", "blocks", "free_segments", "gc_count", "dropped"]),
+    ("gc", ["count", "pause_us", "size_before", "size_after", "survival_percent", "trigger_size"]),
+    ("cpu", None),
+    ("loop", ["iterations", "idle_us", "callback_us", "job_us", "gc_us", "max_lag_us"]),
+]
 
 MAX_BUFFER_SIZE = 128
 WEBSOCKET_BINARY_FRAME = 2
@@ -102,6 +113,10 @@ def arguments_parse():
                         help="set exception config, usage 1: [Enable] or 0: [Disable]")
     parser.add_argument("--client-source", action="store", default=[], type=str, nargs="+",
                         help="specify a javascript source file to execute")
+    parser.add_argument("--profile", action="store", default=0, type=int, metavar="INTERVAL",
+                        help="stream profile samples every INTERVAL milliseconds, printed as JSON lines")
+    parser.add_argument("--profile-output", action="store", default=None, metavar="FILE",
+                        help="write the profile samples to FILE instead of the standard output")
 
     args = parser.parse_args()
 
@@ -661,6 +676,16 @@ class JerryDebugger(object):
                               enable)
         self.send_message(message)
 
+    def send_profile(self, interval):
+        message = struct.pack(self.byte_order + "BBIBBI",
+                              WEBSOCKET_BINARY_FRAME | WEBSOCKET_FIN_BIT,
+                              WEBSOCKET_FIN_BIT + 1 + 1 + 4,
+                              0,
+                              JERRY_DEBUGGER_PROFILE,
+                              (1 << len(JERRY_DEBUGGER_PROFILE_KINDS)) - 1 if interval > 0 else 0,
+                              interval)
+        self.send_message(message)
+
     def set_colors(self):
         self.green = '\033[92m'
         self.nocolor = '\033[0m'
@@ -965,6 +990,30 @@ def get_breakpoint(debugger, breakpoint_data):
     return (function.offsets[nearest_offset], False)
 
 
+def print_profile_sample(debugger, data, output):
+    kind = ord(data[3])
+    count = (ord(data[1]) - 1 - 1 - 4) // 4
+    values = struct.unpack(debugger.byte_order + "I" * (count + 1), data[4: 4 + 4 * (count + 1)])
+
+    if kind >= len(JERRY_DEBUGGER_PROFILE_KINDS):
+        return
+
+    name, value_names = JERRY_DEBUGGER_PROFILE_KINDS[kind]
+    sample = {"kind": name, "time": values[0]}
+
+    if value_names is None:
+        frames = []
+        for i in range(1, count, 2):
+            if values[i] in debugger.function_list:
+                frames.append(str(get_breakpoint(debugger, (values[i], values[i + 1]))[0]))
+        sample["frames"] = frames
+    else:
+        sample.update(zip(value_names, values[1:]))
+
+    output.write(json.dumps(sample, sort_keys=True) + "\n")
+    output.flush()
+
+
 def main():
     args = arguments_parse()
 
@@ -991,6 +1040,12 @@ def main():
     if args.client_source is not None:
         prompt.store_client_sources(args.client_source)
 
+    profile_output = sys.stdout
+    if args.profile > 0:
+        if args.profile_output:
+            profile_output = open(args.profile_output, "w")
+        debugger.send_profile(args.profile)
+
     while True:
         if not non_interactive and prompt.cont:
             if sys.stdin in select.select([sys.stdin], [], [], 0)[0]:
@@ -1152,6 +1207,9 @@ def main():
         elif buffer_type == JERRY_DEBUGGER_WAIT_FOR_SOURCE:
             prompt.send_client_source()
 
+        elif buffer_type == JERRY_DEBUGGER_PROFILE_SAMPLE:
+            print_profile_sample(debugger, data, profile_output)
+
 
         else:
             raise Exception("Unknown message")
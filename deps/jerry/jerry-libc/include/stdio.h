@@ -42,6 +42,7 @@ extern FILE *stderr;
 int vfprintf (FILE *stream, const char *format, va_list ap);
 FILE *fopen (const char *path, const char *mode);
 int fclose (FILE *fp);
+int fflush (FILE *stream);
 size_t fread (void *ptr, size_t size, size_t nmemb, FILE *stream);
 size_t fwrite (const void *ptr, size_t size, size_t nmemb, FILE *stream);
 int printf (const char *format, ...);
@@ -95,6 +95,29 @@ memcmp (const void *s1, /**< first area */
   return 0;
 } /* memcmp */
 
+/**
+ * memchr
+ *
+ * @return pointer to the first occurrence of the byte in the area, or NULL if not found
+ */
+void *
+memchr (const void *s, /**< area */
+        int c, /**< byte to search for */
+        size_t n) /**< area size */
+{
+  const uint8_t *area_p = (const uint8_t *) s;
+  while (n--)
+  {
+    if (*area_p == (uint8_t) c)
+    {
+      return (void *) area_p;
+    }
+    area_p++;
+  }
+
+  return NULL;
+} /* memchr */
+
 /**
  * memcpy
  */
@@ -198,6 +198,22 @@ fclose (FILE *fp) /**< stream pointer */
   return 0;
 } /* fclose */
 
+/**
+ * fflush
+ *
+ * Note:
+ *      the streams are not buffered, as each write is a system call
+ *
+ * @return 0
+ */
+int
+fflush (FILE *stream) /**< stream pointer */
+{
+  (void) stream; /* Unused. */
+
+  return 0;
+} /* fflush */
+
 /**
  * fread
  *
@@ -0,0 +1,541 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Replays an allocation trace, recorded with the 'trace' category of the
+ * memory profiler, against the heap allocator this tool is built with.
+ *
+ * The allocator is chosen when the engine is configured, so one jerry-replay
+ * is built for each allocator to compare, and all of them replay one trace.
+ * The events are replayed back to back, without the gaps between them. The
+ * first replay samples the heap after each event, and the others are timed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "jerryscript.h"
+#include "jerryscript-port.h"
+#include "jcontext.h"
+#include "jmem.h"
+
+/**
+ * Size of the trace header, and the values of its fields
+ */
+#define REPLAY_HEADER_SIZE (16)
+#define REPLAY_MAGIC "JMTR"
+#define REPLAY_VERSION (1)
+
+/**
+ * Types of the trace events, in the low 2 bits of their tags
+ */
+#define REPLAY_ALLOC       (0)
+#define REPLAY_FREE        (1)
+#define REPLAY_ALLOC_SMALL (2)
+#define REPLAY_FREE_SMALL  (3)
+
+/**
+ * Standalone Jerry exit codes
+ */
+#define JERRY_STANDALONE_EXIT_CODE_OK   (0)
+#define JERRY_STANDALONE_EXIT_CODE_FAIL (1)
+
+/**
+ * A decoded trace event
+ */
+typedef struct
+{
+  uint8_t type; /**< REPLAY_ALLOC, REPLAY_FREE, REPLAY_ALLOC_SMALL or REPLAY_FREE_SMALL */
+  uint32_t arg; /**< size of an allocation, or id of the freed block */
+  uint32_t delta_us; /**< microseconds since the previous event */
+} replay_event_t;
+
+/**
+ * A block allocated by the replay
+ */
+typedef struct
+{
+  void *block_p; /**< the block, NULL if it is not allocated */
+  uint32_t size; /**< size of the block */
+  bool is_small; /**< allocated as a small object */
+} replay_block_t;
+
+/**
+ * Results of a replay
+ */
+typedef struct
+{
+  uint32_t allocs; /**< allocations in the trace */
+  uint32_t frees; /**< frees in the trace */
+  uint32_t failed; /**< allocations which failed, whose frees are skipped */
+  uint64_t trace_us; /**< length of the traced run */
+  uint64_t time_us; /**< time of the fastest replay */
+  size_t peak_live; /**< most bytes of the trace allocated at once */
+  size_t peak_usage; /**< most heap usage, with the rounding and headers of the blocks */
+  size_t peak_footprint; /**< most memory taken by the heap */
+  double frag_at_peak; /**< fragmentation at the peak footprint */
+  double frag_mean; /**< fragmentation over all the events */
+} replay_result_t;
+
+static replay_event_t *events_p = NULL;
+static uint32_t event_count = 0;
+static replay_block_t *blocks_p = NULL;
+
+static const char *
+allocator_name (void)
+{
+#if defined (JERRY_SYSTEM_ALLOCATOR)
+  return "system";
+#elif defined (JMEM_SEGMENTED_HEAP)
+  return "segmented";
+#elif defined (JMEM_DYNAMIC_HEAP_EMUL)
+  return "dynamic-emul";
+#else
+  return "static";
+#endif
+} /* allocator_name */
+
+static bool
+read_uleb128 (const uint8_t **pos_p,
+              const uint8_t *end_p,
+              uint32_t *out_value_p)
+{
+  uint32_t value = 0;
+  uint32_t shift = 0;
+
+  while (*pos_p < end_p && shift < 35)
+  {
+    uint8_t byte = *(*pos_p)++;
+    value |= (uint32_t) (byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+    {
+      *out_value_p = value;
+      return true;
+    }
+    shift += 7;
+  }
+  return false;
+} /* read_uleb128 */
+
+/**
+ * Decode the events of a trace file, and check that they fit this build.
+ *
+ * @return true - if the trace is valid,
+ *         false - otherwise.
+ */
+static bool
+load_trace (const char *file_name,
+            uint64_t *out_trace_us_p)
+{
+  FILE *file = fopen (file_name, "rb");
+  if (file == NULL)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to open file: %s\n", file_name);
+    return false;
+  }
+
+  fseek (file, 0, SEEK_END);
+  long file_size = ftell (file);
+  fseek (file, 0, SEEK_SET);
+
+  uint8_t *data_p = (file_size > 0) ? (uint8_t *) malloc ((size_t) file_size) : NULL;
+  if (data_p == NULL || fread (data_p, 1u, (size_t) file_size, file) != (size_t) file_size)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to read file: %s\n", file_name);
+    free (data_p);
+    fclose (file);
+    return false;
+  }
+  fclose (file);
+
+  if (file_size < REPLAY_HEADER_SIZE
+      || memcmp (data_p, REPLAY_MAGIC, 4) != 0
+      || data_p[4] != REPLAY_VERSION)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: not an allocation trace: %s\n", file_name);
+    free (data_p);
+    return false;
+  }
+
+  if (data_p[5] != JMEM_ALIGNMENT)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR,
+                    "Error: the trace was recorded with an alignment of %u, not %u\n",
+                    (unsigned) data_p[5],
+                    (unsigned) JMEM_ALIGNMENT);
+    free (data_p);
+    return false;
+  }
+
+  /* Each event takes at least two bytes. */
+  events_p = (replay_event_t *) malloc (sizeof (replay_event_t) * ((size_t) file_size / 2 + 1));
+  if (events_p == NULL)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: out of memory\n");
+    free (data_p);
+    return false;
+  }
+
+  const uint8_t *pos_p = data_p + REPLAY_HEADER_SIZE;
+  const uint8_t *end_p = data_p + file_size;
+  uint32_t alloc_count = 0;
+  uint64_t trace_us = 0;
+
+  while (pos_p < end_p)
+  {
+    uint32_t tag;
+    uint32_t delta_us;
+    if (!read_uleb128 (&pos_p, end_p, &tag) || !read_uleb128 (&pos_p, end_p, &delta_us))
+    {
+      /* The recording was cut short. */
+      jerry_port_log (JERRY_LOG_LEVEL_WARNING, "Warning: the trace ends in an event\n");
+      break;
+    }
+
+    replay_event_t *event_p = events_p + event_count;
+    event_p->type = (uint8_t) (tag & 0x3);
+    event_p->delta_us = delta_us;
+    trace_us += delta_us;
+
+    if (event_p->type == REPLAY_ALLOC || event_p->type == REPLAY_ALLOC_SMALL)
+    {
+      event_p->arg = (tag >> 2) * JMEM_ALIGNMENT;
+      alloc_count++;
+    }
+    else
+    {
+      uint32_t age = tag >> 2;
+      if (age == 0 || age > alloc_count)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: invalid free in event %u\n", (unsigned) event_count);
+        free (data_p);
+        return false;
+      }
+      event_p->arg = alloc_count - age;
+    }
+    event_count++;
+  }
+  free (data_p);
+
+  blocks_p = (replay_block_t *) calloc (alloc_count + 1, sizeof (replay_block_t));
+  if (blocks_p == NULL)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: out of memory\n");
+    return false;
+  }
+
+  *out_trace_us_p = trace_us;
+  return true;
+} /* load_trace */
+
+static uint64_t
+get_time_us (void)
+{
+  struct timeval now;
+  gettimeofday (&now, NULL);
+  return (uint64_t) now.tv_sec * 1000000u + (uint64_t) now.tv_usec;
+} /* get_time_us */
+
+/**
+ * Memory taken by the heap: the allocated segments of a segmented heap, the
+ * emulated system allocations with their metadata and slabs, and the static
+ * heap up to its last allocated block.
+ */
+static size_t
+get_footprint (void)
+{
+#if defined (JMEM_SEGMENTED_HEAP)
+  return JERRY_HEAP_CONTEXT (segments_count) * SEG_SEGMENT_SIZE;
+#elif defined (JMEM_DYNAMIC_HEAP_EMUL)
+  size_t footprint = (JERRY_CONTEXT (jmem_allocated_heap_size)
+                      + JERRY_CONTEXT (jmem_system_allocator_metadata_size));
+#ifdef DE_SLAB
+  footprint += (size_t) JERRY_CONTEXT (num_allocated_slabs) * DE_SLAB_SEGMENT_SIZE;
+#endif /* DE_SLAB */
+  return footprint;
+#else /* !JMEM_SEGMENTED_HEAP && !JMEM_DYNAMIC_HEAP_EMUL */
+  /* The free regions are sorted by their addresses. */
+  const jmem_heap_free_t *region_p = &JERRY_HEAP_CONTEXT (first);
+  uint32_t region_offset = 0;
+
+  while (region_p->next_offset != JMEM_HEAP_END_OF_LIST)
+  {
+    region_offset = region_p->next_offset;
+    region_p = JMEM_DECOMPRESS_POINTER_INTERNAL (region_offset);
+  }
+
+  if (region_p != &JERRY_HEAP_CONTEXT (first) && region_offset + region_p->size == JMEM_HEAP_AREA_SIZE)
+  {
+    return region_offset;
+  }
+  return JMEM_HEAP_AREA_SIZE;
+#endif /* JMEM_SEGMENTED_HEAP */
+} /* get_footprint */
+
+/**
+ * Replay the events once, and optionally sample the heap after each of them.
+ */
+static void
+replay_events (replay_result_t *result_p,
+               bool is_sampling)
+{
+  uint32_t next_id = 0;
+  size_t live_size = 0;
+  double frag_sum = 0;
+
+  replay_block_t *block_p;
+
+  for (uint32_t i = 0; i < event_count; i++)
+  {
+    const replay_event_t *event_p = events_p + i;
+    bool is_small = (event_p->type == REPLAY_ALLOC_SMALL || event_p->type == REPLAY_FREE_SMALL);
+
+    if (event_p->type == REPLAY_ALLOC || event_p->type == REPLAY_ALLOC_SMALL)
+    {
+      block_p = blocks_p + next_id++;
+      block_p->size = event_p->arg;
+      block_p->is_small = is_small;
+
+      /* Small objects cannot fail, heap exhaustion terminates the replay. */
+      block_p->block_p = (is_small ? jmem_heap_alloc_block_small_object (block_p->size)
+                                   : jmem_heap_alloc_block_null_on_error (block_p->size));
+      if (block_p->block_p == NULL)
+      {
+        result_p->failed++;
+      }
+      else
+      {
+        live_size += block_p->size;
+      }
+    }
+    else
+    {
+      block_p = blocks_p + event_p->arg;
+      if (block_p->block_p != NULL)
+      {
+        if (block_p->is_small)
+        {
+          jmem_heap_free_block_small_object (block_p->block_p, block_p->size);
+        }
+        else
+        {
+          jmem_heap_free_block (block_p->block_p, block_p->size);
+        }
+        block_p->block_p = NULL;
+        live_size -= block_p->size;
+      }
+    }
+
+    if (!is_sampling)
+    {
+      continue;
+    }
+
+    size_t usage;
+    size_t peak_usage;
+    jmem_heap_get_usage_stats (&usage, &peak_usage);
+    size_t footprint = get_footprint ();
+    double frag = (live_size < footprint) ? 1.0 - (double) live_size / (double) footprint : 0;
+    frag_sum += frag;
+
+    if (live_size > result_p->peak_live)
+    {
+      result_p->peak_live = live_size;
+    }
+    if (usage > result_p->peak_usage)
+    {
+      result_p->peak_usage = usage;
+    }
+    if (footprint > result_p->peak_footprint)
+    {
+      result_p->peak_footprint = footprint;
+      result_p->frag_at_peak = frag;
+    }
+  }
+
+  /* Blocks which were alive at the end of the trace. */
+  for (uint32_t id = 0; id < next_id; id++)
+  {
+    block_p = blocks_p + id;
+    if (block_p->block_p == NULL)
+    {
+      continue;
+    }
+
+    if (block_p->is_small)
+    {
+      jmem_heap_free_block_small_object (block_p->block_p, block_p->size);
+    }
+    else
+    {
+      jmem_heap_free_block (block_p->block_p, block_p->size);
+    }
+    block_p->block_p = NULL;
+  }
+
+  if (is_sampling && event_count > 0)
+  {
+    result_p->frag_mean = frag_sum / event_count;
+  }
+} /* replay_events */
+
+static void
+print_help (char *name)
+{
+  printf ("Usage: %s [OPTION]... TRACE\n"
+          "\n"
+          "Replays an allocation trace against the heap allocator of this build.\n"
+          "\n"
+          "Options:\n"
+          "  -h, --help\n"
+          "  --repeat N    replay N times, and report the fastest (default: 5)\n"
+          "  --json        print the results as JSON\n"
+          "\n",
+          name);
+} /* print_help */
+
+int
+main (int argc,
+      char **argv)
+{
+  const char *trace_file_p = NULL;
+  bool is_json = false;
+  int repeat = 5;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp ("-h", argv[i]) || !strcmp ("--help", argv[i]))
+    {
+      print_help (argv[0]);
+      return JERRY_STANDALONE_EXIT_CODE_OK;
+    }
+    else if (!strcmp ("--json", argv[i]))
+    {
+      is_json = true;
+    }
+    else if (!strcmp ("--repeat", argv[i]) && i + 1 < argc)
+    {
+      repeat = atoi (argv[++i]);
+      if (repeat < 1)
+      {
+        repeat = 1;
+      }
+    }
+    else
+    {
+      trace_file_p = argv[i];
+    }
+  }
+
+  if (trace_file_p == NULL)
+  {
+    print_help (argv[0]);
+    return JERRY_STANDALONE_EXIT_CODE_FAIL;
+  }
+
+  replay_result_t result;
+  memset (&result, 0, sizeof (result));
+
+  if (!load_trace (trace_file_p, &result.trace_us))
+  {
+    free (events_p);
+    free (blocks_p);
+    return JERRY_STANDALONE_EXIT_CODE_FAIL;
+  }
+
+  for (uint32_t i = 0; i < event_count; i++)
+  {
+    if (events_p[i].type == REPLAY_ALLOC || events_p[i].type == REPLAY_ALLOC_SMALL)
+    {
+      result.allocs++;
+    }
+    else
+    {
+      result.frees++;
+    }
+  }
+
+  /* The trace holds the allocations of the engine as well, so only the heap
+   * is initialized. */
+  jmem_init ();
+
+  /* The first pass also warms the heap up, as the engine has been running
+   * when the trace was recorded. */
+  replay_events (&result, true);
+  uint32_t failed = result.failed;
+
+  for (int i = 0; i < repeat; i++)
+  {
+    uint64_t start_us = get_time_us ();
+    replay_events (&result, false);
+    uint64_t time_us = get_time_us () - start_us;
+
+    if (i == 0 || time_us < result.time_us)
+    {
+      result.time_us = time_us;
+    }
+  }
+  result.failed = failed;
+
+  jmem_finalize ();
+
+  double ns_per_event = event_count ? (double) result.time_us * 1000.0 / event_count : 0;
+
+  if (is_json)
+  {
+    printf ("{\"allocator\": \"%s\", \"heapSize\": %u, \"events\": %u, \"allocs\": %u, \"frees\": %u, "
+            "\"failed\": %u, \"traceUs\": %llu, \"timeUs\": %llu, \"nsPerEvent\": %.1f, "
+            "\"peakLive\": %u, \"peakUsage\": %u, \"peakFootprint\": %u, "
+            "\"fragAtPeak\": %.4f, \"fragMean\": %.4f}\n",
+            allocator_name (),
+            (unsigned) JMEM_HEAP_SIZE,
+            (unsigned) event_count,
+            (unsigned) result.allocs,
+            (unsigned) result.frees,
+            (unsigned) result.failed,
+            (unsigned long long) result.trace_us,
+            (unsigned long long) result.time_us,
+            ns_per_event,
+            (unsigned) result.peak_live,
+            (unsigned) result.peak_usage,
+            (unsigned) result.peak_footprint,
+            result.frag_at_peak,
+            result.frag_mean);
+  }
+  else
+  {
+    printf ("Allocator:           %s (heap of %u bytes)\n", allocator_name (), (unsigned) JMEM_HEAP_SIZE);
+    printf ("Events:              %u (%u allocs, %u frees, %u failed)\n",
+            (unsigned) event_count,
+            (unsigned) result.allocs,
+            (unsigned) result.frees,
+            (unsigned) result.failed);
+    printf ("Replay time:         %llu us (%.1f ns/event)\n",
+            (unsigned long long) result.time_us,
+            ns_per_event);
+    printf ("Peak live bytes:     %u\n", (unsigned) result.peak_live);
+    printf ("Peak heap usage:     %u\n", (unsigned) result.peak_usage);
+    printf ("Peak footprint:      %u\n", (unsigned) result.peak_footprint);
+    printf ("Fragmentation:       %.2f%% at the peak, %.2f%% on average\n",
+            result.frag_at_peak * 100.0,
+            result.frag_mean * 100.0);
+  }
+
+  free (events_p);
+  free (blocks_p);
+  return (result.failed == 0) ? JERRY_STANDALONE_EXIT_CODE_OK : JERRY_STANDALONE_EXIT_CODE_FAIL;
+} /* main */
@@ -81,6 +81,68 @@ read_file (const char *file_name,
   return (const uint32_t *) buffer;
 } /* read_file */
 
+/**
+ * Save the snapshot of several scripts, which share its literal table
+ *
+ * @return true - if the snapshot is saved,
+ *         false - otherwise
+ */
+static bool
+save_multi_snapshot (const char **file_names, /**< script file names */
+                     int files_counter, /**< number of scripts */
+                     bool is_for_global, /**< snapshot would be executed as global */
+                     const char *save_snapshot_file_name_p, /**< snapshot file name */
+                     uint32_t *snapshot_buffer_p, /**< buffer of the snapshot */
+                     size_t snapshot_buffer_size) /**< size of the buffer */
+{
+  const jerry_char_t *sources_p[files_counter];
+  size_t source_sizes[files_counter];
+  size_t buffer_offset = 0;
+
+  /* The scripts are read one after the other into the buffer of read_file. */
+  for (int i = 0; i < files_counter; i++)
+  {
+    FILE *file = fopen (file_names[i], "r");
+
+    if (file == NULL)
+    {
+      jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to open file: %s\n", file_names[i]);
+      return false;
+    }
+
+    source_sizes[i] = fread (buffer + buffer_offset, 1u, sizeof (buffer) - buffer_offset, file);
+    fclose (file);
+
+    if (!jerry_is_valid_utf8_string (buffer + buffer_offset, (jerry_size_t) source_sizes[i]))
+    {
+      jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: input must be a valid UTF-8 string: %s\n", file_names[i]);
+      return false;
+    }
+
+    sources_p[i] = buffer + buffer_offset;
+    buffer_offset += source_sizes[i];
+  }
+
+  size_t snapshot_size = jerry_parse_and_save_multi_snapshot (sources_p,
+                                                              source_sizes,
+                                                              (uint32_t) files_counter,
+                                                              is_for_global,
+                                                              false,
+                                                              snapshot_buffer_p,
+                                                              snapshot_buffer_size);
+  printf("(Save) Snapshot size: %dB\n", snapshot_size);
+
+  if (snapshot_size == 0)
+  {
+    return false;
+  }
+
+  FILE *snapshot_file_p = fopen (save_snapshot_file_name_p, "w");
+  fwrite (snapshot_buffer_p, sizeof (uint8_t), snapshot_size, snapshot_file_p);
+  fclose (snapshot_file_p);
+  return true;
+} /* save_multi_snapshot */
+
 /**
  * Check whether an error is a SyntaxError or not
  *
@@ -284,6 +346,7 @@ typedef enum
   OPT_DEBUGGER_WAIT_SOURCE,
   OPT_SAVE_SNAP_GLOBAL,
   OPT_SAVE_SNAP_EVAL,
+  OPT_OPTIMIZE_SNAP,
   OPT_SAVE_LIT_LIST,
   OPT_SAVE_LIT_C,
   OPT_EXEC_SNAP,
@@ -319,6 +382,8 @@ static const cli_opt_t main_opts[] =
                .help = "save binary snapshot of parsed JS input (for execution in global context)"),
   CLI_OPT_DEF (.id = OPT_SAVE_SNAP_EVAL, .longopt = "save-snapshot-for-eval", .meta = "FILE",
                .help = "save binary snapshot of parsed JS input (for execution in local context by eval)"),
+  CLI_OPT_DEF (.id = OPT_OPTIMIZE_SNAP, .longopt = "optimize-snapshot",
+               .help = "apply slower byte-code optimizations (for saving snapshots)"),
   CLI_OPT_DEF (.id = OPT_SAVE_LIT_LIST, .longopt = "save-literals-list-format", .meta = "FILE",
                .help = "export literals found in parsed JS input (in list format)"),
   CLI_OPT_DEF (.id = OPT_SAVE_LIT_C, .longopt = "save-literals-c-format", .meta = "FILE",
@@ -496,6 +561,11 @@ main (int argc,
         save_snapshot_file_name_p = cli_consume_string (&cli_state);
         break;
       }
+      case OPT_OPTIMIZE_SNAP:
+      {
+        flags |= JERRY_INIT_PARSER_OPTIMIZE;
+        break;
+      }
       case OPT_SAVE_LIT_LIST:
       case OPT_SAVE_LIT_C:
       {
@@ -568,8 +638,10 @@ main (int argc,
 
   if (is_save_snapshot_mode)
   {
-    check_usage (files_counter == 1,
-                 argv[0], "Error: --save-snapshot-* options work with exactly one script", NULL);
+    check_usage (files_counter >= 1,
+                 argv[0], "Error: --save-snapshot-* options work with at least one script", NULL);
+    check_usage (files_counter == 1 || !is_save_literals_mode,
+                 argv[0], "Error: --save-snapshot-* options work with one script with --save-literals-*", NULL);
     check_usage (exec_snapshots_count == 0,
                  argv[0], "Error: --save-snapshot-* and --exec-snapshot options can't be passed simultaneously", NULL);
   }
@@ -631,7 +703,22 @@ main (int argc,
     }
   }
 
-  if (!jerry_value_has_error_flag (ret_value))
+  if (is_save_snapshot_mode && files_counter > 1)
+  {
+    /* The code of the scripts is saved with one literal table, see jerry_exec_multi_snapshot. */
+    static uint32_t multi_snapshot_buffer[ JERRY_SNAPSHOT_BUFFER_SIZE ];
+
+    if (!save_multi_snapshot (file_names,
+                              files_counter,
+                              is_save_snapshot_mode_for_global_or_eval,
+                              save_snapshot_file_name_p,
+                              multi_snapshot_buffer,
+                              sizeof (multi_snapshot_buffer)))
+    {
+      ret_value = jerry_create_error (JERRY_ERROR_COMMON, (jerry_char_t *) "Snapshot saving failed!");
+    }
+  }
+  else if (!jerry_value_has_error_flag (ret_value))
   {
     for (int i = 0; i < files_counter; i++)
     {
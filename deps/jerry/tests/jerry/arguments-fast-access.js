@@ -0,0 +1,148 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Reads of arguments.length and arguments[index] without an arguments object. */
+function read(a, b) {
+  return arguments.length + ":" + arguments[0] + ":" + arguments[2] + ":" + arguments[5];
+}
+assert(read(1, 2, 3) === "3:1:3:undefined");
+assert(read() === "0:undefined:undefined:undefined");
+
+function readLast() {
+  return arguments[arguments.length - 1];
+}
+assert(readLast(1, 2, 3) === 3);
+
+function copy(first) {
+  var args = [];
+  for (var i = 1; i < arguments.length; i++) {
+    args.push(arguments[i]);
+  }
+  return args;
+}
+assert(copy(1, 2, 3).join() === "2,3");
+
+function readKeys() {
+  return arguments["1"] + "," + arguments[1.5] + "," + arguments["length"];
+}
+assert(readKeys(1, 2) === "2,undefined,2");
+
+function readInherited() {
+  return arguments["hasOwnProperty"];
+}
+assert(readInherited() === Object.prototype.hasOwnProperty);
+
+function readCallee() {
+  return arguments["callee"];
+}
+assert(readCallee() === readCallee);
+
+/* The formal arguments are mapped in non-strict code only. */
+function mapped(a) {
+  a = 5;
+  return arguments[0];
+}
+assert(mapped(1) === 5);
+assert(mapped() === undefined);
+
+function unmapped(a) {
+  "use strict";
+  a = 5;
+  return arguments[0];
+}
+assert(unmapped(1) === 1);
+
+function strictCallee() {
+  "use strict";
+  try {
+    arguments["callee"];
+    return false;
+  } catch (e) {
+    return e instanceof TypeError;
+  }
+}
+assert(strictCallee());
+
+/* These uses need the arguments object. */
+function closure(a) {
+  var set = function() { a = 9; };
+  set();
+  return arguments[0];
+}
+assert(closure(1) === 9);
+
+function evalArgument(a) {
+  eval("a = 3");
+  return arguments[0];
+}
+assert(evalArgument(1) === 3);
+
+function assign() {
+  arguments[0] = 7;
+  return arguments[0] + arguments.length;
+}
+assert(assign(1) === 8);
+
+function increment(a) {
+  arguments[0]++;
+  return a;
+}
+assert(increment(1) === 2);
+
+function remove(a) {
+  var res = delete arguments[0];
+  return res + ":" + arguments[0] + ":" + a;
+}
+assert(remove(1) === "true:undefined:1");
+
+function forIn() {
+  for (arguments[0] in { z: 1 }) {
+  }
+  return arguments[0];
+}
+assert(forIn(1) === "z");
+
+function call() {
+  return arguments[0]();
+}
+assert(call(function() { return this.length; }, 2) === 2);
+
+function escape() {
+  return arguments;
+}
+assert(escape(1, 2).length === 2);
+
+function setLength() {
+  arguments.length = 1;
+  return arguments.length;
+}
+assert(setLength(1, 2) === 1);
+
+function withArguments() {
+  with ({ arguments: [4] }) {
+    return arguments[0];
+  }
+}
+assert(withArguments(1) === 4);
+
+function shadowed() {
+  var arguments = [6];
+  return arguments[0];
+}
+assert(shadowed(1) === 6);
+
+function parameter(arguments) {
+  return arguments[0];
+}
+assert(parameter([8]) === 8);
@@ -0,0 +1,169 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+var a, i, sum;
+
+// Filling and reading large arrays
+a = [];
+for (i = 0; i < 2000; i++)
+{
+  a[i] = i * 2;
+}
+assert (a.length === 2000);
+sum = 0;
+for (i = 0; i < a.length; i++)
+{
+  sum += a[i];
+}
+assert (sum === 3998000);
+
+a = new Array (100);
+for (i = 0; i < 100; i++)
+{
+  a[i] = "x" + i;
+}
+assert (a[99] === "x99");
+assert (a.join ("").length === 290);
+
+a = [];
+for (i = 0; i < 500; i++)
+{
+  a.push ({ v: i });
+}
+assert (a[499].v === 499);
+assert (a.pop ().v === 499);
+assert (a.length === 499);
+
+// Holes and deleted elements
+a = [1, , 3];
+assert (a.length === 3);
+assert (!(1 in a));
+assert (a.hasOwnProperty ("2"));
+assert (delete a[0]);
+assert (a[0] === undefined);
+assert (!a.hasOwnProperty ("0"));
+a[0] = 5;
+assert (a.join () === "5,,3");
+
+Array.prototype[1] = "proto";
+assert ([0, , 2][1] === "proto");
+assert ([0, 1, 2][1] === 1);
+delete Array.prototype[1];
+
+// Setters of the prototype chain are called for new elements
+var setter_value;
+Object.defineProperty (Array.prototype, "3", {
+  set: function (v) { setter_value = v; },
+  configurable: true
+});
+a = [0, 1, 2];
+a[3] = "set";
+assert (setter_value === "set");
+assert (a.length === 3);
+delete Array.prototype[3];
+
+// Sparse writes
+a = [1, 2];
+a[100000] = 3;
+assert (a.length === 100001);
+assert (a[1] === 2);
+assert (a[100000] === 3);
+assert (Object.keys (a).join () === "0,1,100000");
+a.length = 1;
+assert (a.length === 1);
+assert (a[1] === undefined);
+
+a = [];
+a[40] = 1;
+a[5] = 2;
+assert (Object.keys (a).join () === "5,40");
+
+// Shrinking and growing the length
+a = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9];
+a.length = 3;
+assert (a.join () === "0,1,2");
+assert (a[5] === undefined);
+a.length = 6;
+assert (a.join () === "0,1,2,,,");
+a[4] = 4;
+assert (a.join () === "0,1,2,,4,");
+
+// Names are listed in ascending order
+a = ["a", "b", "c"];
+a.x = "y";
+var names = [];
+for (var name in a)
+{
+  names.push (name);
+}
+assert (names.join () === "0,1,2,x");
+assert (Object.keys (a).join () === "0,1,2,x");
+assert (Object.getOwnPropertyNames (a).length === 5);
+
+// Property descriptors
+var desc = Object.getOwnPropertyDescriptor ([7], "0");
+assert (desc.value === 7);
+assert (desc.writable && desc.enumerable && desc.configurable);
+
+a = [1, 2, 3];
+Object.defineProperty (a, "1", { value: 20 });
+assert (a[1] === 20);
+Object.defineProperty (a, "3", { value: 4, writable: true, enumerable: true, configurable: true });
+assert (a.length === 4);
+Object.defineProperty (a, "0", { value: 10, writable: false });
+a[0] = 11;
+assert (a[0] === 10);
+assert (a[2] === 3);
+Object.defineProperty (a, "5", { get: function () { return "got"; } });
+assert (a[5] === "got");
+assert (a.length === 6);
+
+a = [1, 2, 3];
+Object.freeze (a);
+assert (Object.isFrozen (a));
+a[0] = 5;
+a[3] = 5;
+assert (a.join () === "1,2,3");
+
+a = [1, 2];
+Object.preventExtensions (a);
+a[0] = 3;
+a[2] = 4;
+assert (a.join () === "3,2");
+assert (!a.hasOwnProperty ("2"));
+
+// Built-in routines
+a = [5, 3, 9, 1];
+a.sort ();
+assert (a.join () === "1,3,5,9");
+a.reverse ();
+assert (a.join () === "9,5,3,1");
+assert (a.concat ([0]).join () === "9,5,3,1,0");
+assert (a.slice (1, 3).join () === "5,3");
+assert (a.splice (1, 2, "x").join () === "5,3");
+assert (a.join () === "9,x,1");
+a.unshift (10);
+assert (a.shift () === 10);
+assert (a.indexOf (1) === 2);
+assert (a.map (function (v) { return v + v; }).join () === "18,xx,2");
+assert (JSON.stringify (JSON.parse ("[1,[2,\"3\"],{\"a\":[]}]")) === "[1,[2,\"3\"],{\"a\":[]}]");
+assert ("a,b,,c".split (",").length === 4);
+assert (/(a)(b)?/.exec ("a").length === 3);
+
+// Arrays as prototypes
+var o = Object.create ([1, 2, 3]);
+assert (o[1] === 2);
+o[1] = 5;
+assert (o[1] === 5);
+assert (Object.getPrototypeOf (o)[1] === 2);
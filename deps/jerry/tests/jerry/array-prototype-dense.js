@@ -0,0 +1,169 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+function check (array, expected) {
+  assert (array.length === expected.length);
+  for (var i = 0; i < expected.length; i++) {
+    assert (array[i] === expected[i]);
+  }
+}
+
+// push
+var array = [];
+for (var i = 0; i < 100; i++) {
+  assert (array.push (i, i + 1) === 2 * (i + 1));
+}
+assert (array[199] === 100);
+
+array = [1, 2];
+Object.preventExtensions (array);
+try {
+  array.push (3);
+  assert (false);
+} catch (e) {
+  assert (e instanceof TypeError);
+}
+check (array, [1, 2]);
+
+var setter_value;
+Object.defineProperty (Array.prototype, "2", { set: function (v) { setter_value = v; }, configurable: true });
+array = [1, 2];
+array.push (3, 4);
+assert (setter_value === 3);
+assert (array.length === 4);
+assert (!array.hasOwnProperty ("2"));
+assert (array[3] === 4);
+delete Array.prototype[2];
+
+// indexOf, forEach and map
+array = [5, "a", 7, {}, 7];
+assert (array.indexOf (7) === 2);
+assert (array.indexOf (7, 3) === 4);
+assert (array.indexOf ("b") === -1);
+
+var holes = [1, , 3];
+Array.prototype[1] = 2;
+assert (holes.indexOf (2) === 1);
+check (holes.map (function (v) { return v * 2; }), [2, 4, 6]);
+delete Array.prototype[1];
+
+var visited = [];
+array = [1, 2, 3, 4];
+array.forEach (function (v, i, a) {
+  visited.push (v);
+  if (i === 0) {
+    a.pop ();
+    a[1] = 20;
+  }
+});
+check (visited, [1, 20, 3]);
+
+check ([1, 2, 3].map (function (v, i) { return v + i; }), [1, 3, 5]);
+assert ([, , 3].map (function (v) { return v; }).hasOwnProperty ("0") === false);
+
+// slice
+array = [1, 2, 3, 4, 5];
+check (array.slice (1, 4), [2, 3, 4]);
+check (array.slice (-2), [4, 5]);
+check (array.slice (3, 1), []);
+check ([1, , 3].slice (0), [1, undefined, 3]);
+assert ([1, , 3].slice (0).hasOwnProperty ("1") === false);
+
+// splice
+array = [1, 2, 3, 4, 5];
+check (array.splice (1, 2), [2, 3]);
+check (array, [1, 4, 5]);
+check (array.splice (1, 0, "a", "b", "c"), []);
+check (array, [1, "a", "b", "c", 4, 5]);
+check (array.splice (2, 2, "x", "y"), ["b", "c"]);
+check (array, [1, "a", "x", "y", 4, 5]);
+check (array.splice (-1), [5]);
+check (array, [1, "a", "x", "y", 4]);
+check (array.splice (0, 4, {}), [1, "a", "x", "y"]);
+assert (array.length === 2 && array[1] === 4);
+
+array = [];
+for (i = 0; i < 64; i++) {
+  array.push (i);
+}
+array.splice (8, 48);
+assert (array.length === 16 && array[8] === 56 && array[15] === 63);
+
+Object.defineProperty (Array.prototype, "3", { set: function (v) { setter_value = v; }, configurable: true });
+array = [1, 2, 3];
+array.splice (1, 0, "a");
+assert (setter_value === 3);
+assert (array.length === 4 && array[1] === "a" && array[2] === 2);
+delete Array.prototype[3];
+
+// sort
+array = [];
+for (i = 0; i < 200; i++) {
+  array.push ((i * 37) % 101);
+}
+array.sort (function (a, b) { return a - b; });
+for (i = 1; i < array.length; i++) {
+  assert (array[i - 1] <= array[i]);
+}
+
+check ([10, 9, 1, 100, -5, -40, 0].sort (), [-40, -5, 0, 1, 10, 100, 9]);
+check ([3, "2", 1, undefined, , 0.5].sort (), [0.5, 1, "2", 3, undefined, undefined]);
+
+array = [];
+for (i = 0; i < 100; i++) {
+  array.push (i % 3);
+}
+array.sort ();
+assert (array[0] === 0 && array[33] === 0 && array[34] === 1 && array[99] === 2);
+
+array = [];
+for (i = 50; i > 0; i--) {
+  array.push ("s" + i);
+}
+array.sort ();
+assert (array[0] === "s1" && array[1] === "s10" && array[49] === "s9");
+
+// The compare function may change the sorted array.
+array = [5, 4, 3, 2, 1, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18];
+array.sort (function (a, b) {
+  array.length = 2;
+  return a - b;
+});
+assert (array.length === 18);
+
+// Inconsistent compare functions keep the elements.
+array = [];
+for (i = 0; i < 100; i++) {
+  array.push (i);
+}
+array.sort (function (a, b) { return ((a * 7 + b) % 3) - 1; });
+var sum = 0;
+for (i = 0; i < array.length; i++) {
+  sum += array[i];
+}
+assert (sum === 4950);
+
+array = [3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19];
+try {
+  array.sort (function (a, b) {
+    if (a === 10 || b === 10) {
+      throw "error";
+    }
+    return a - b;
+  });
+  assert (false);
+} catch (e) {
+  assert (e === "error");
+}
+assert (array.length === 20);
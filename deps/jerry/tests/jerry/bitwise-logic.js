@@ -19,3 +19,9 @@ assert((5 | 5) === 5);
 assert((5 ^ 2) === 7);
 assert((5 ^ 5) === 0);
 assert((~5) == -6);
+
+assert((-0x8000000 | 0) === -134217728);
+assert((-0x8000000 & 0x7ffffff) === 0);
+assert((-1 ^ 0x7ffffff) === -134217728);
+assert((-6 & 0xff) === 250);
+assert((0x5555 | -0x10000) === -43691);
@@ -0,0 +1,127 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+function forInKeys(object) {
+  var keys = [];
+  for (var key in object) {
+    keys.push(key);
+  }
+  return keys.join();
+}
+
+/* Repeated enumerations of an unchanged object. */
+var headers = { "content-type": "text/plain", "content-length": 5, connection: "close" };
+for (var i = 0; i < 10; i++) {
+  assert(forInKeys(headers) === "content-type,content-length,connection");
+  assert(Object.keys(headers).join() === "content-type,content-length,connection");
+  assert(JSON.stringify(headers) === '{"content-type":"text/plain","content-length":5,"connection":"close"}');
+}
+
+/* Adding and deleting properties. */
+headers.date = "today";
+assert(forInKeys(headers) === "content-type,content-length,connection,date");
+assert(Object.keys(headers).join() === "content-type,content-length,connection,date");
+delete headers["content-length"];
+assert(forInKeys(headers) === "content-type,connection,date");
+assert(Object.keys(headers).join() === "content-type,connection,date");
+headers["content-length"] = 6;
+assert(forInKeys(headers) === "content-type,connection,date,content-length");
+
+/* Changing the enumerable attribute. */
+Object.defineProperty(headers, "date", { enumerable: false });
+assert(forInKeys(headers) === "content-type,connection,content-length");
+assert(Object.keys(headers).join() === "content-type,connection,content-length");
+Object.defineProperty(headers, "date", { enumerable: true });
+assert(forInKeys(headers) === "content-type,connection,date,content-length");
+
+/* Properties of the prototypes. */
+function Base() {
+  this.own = 1;
+}
+var instance = new Base();
+assert(forInKeys(instance) === "own");
+Base.prototype.inherited = 2;
+assert(forInKeys(instance) === "own,inherited");
+assert(Object.keys(instance).join() === "own");
+Object.prototype.everywhere = 3;
+assert(forInKeys(instance) === "own,inherited,everywhere");
+assert(forInKeys({}) === "everywhere");
+delete Object.prototype.everywhere;
+assert(forInKeys(instance) === "own,inherited");
+Base.prototype.own = 4;
+assert(forInKeys(instance) === "own,inherited");
+delete instance.own;
+assert(forInKeys(instance) === "inherited,own");
+
+/* Nested loops over the same object, and loops left early. */
+var object = { a: 1, b: 2, c: 3 };
+var pairs = [];
+for (var outer in object) {
+  for (var inner in object) {
+    pairs.push(outer + inner);
+  }
+}
+assert(pairs.join() === "aa,ab,ac,ba,bb,bc,ca,cb,cc");
+
+for (var key in object) {
+  break;
+}
+
+try {
+  for (var key in object) {
+    throw key;
+  }
+} catch (e) {
+  assert(e === "a");
+}
+
+(function () {
+  for (var key in object) {
+    return;
+  }
+})();
+
+assert(forInKeys(object) === "a,b,c");
+
+/* Properties deleted or added during the loop. */
+var visited = [];
+for (var key in object) {
+  visited.push(key);
+  if (key === "a") {
+    delete object.b;
+    object.d = 4;
+  }
+}
+assert(visited.join() === "a,c");
+assert(forInKeys(object) === "a,c,d");
+
+/* Many objects, some of them at the addresses of freed ones. */
+for (var i = 0; i < 1000; i++) {
+  var item = {};
+  item["key" + (i % 7)] = i;
+  if (i % 3 === 0) {
+    item.extra = i;
+  }
+  var expected = "key" + (i % 7) + (i % 3 === 0 ? ",extra" : "");
+  assert(forInKeys(item) === expected);
+  assert(forInKeys(item) === expected);
+  assert(Object.keys(item).join() === expected);
+}
+
+/* Arrays and other objects are enumerated as before. */
+var array = [1, 2, 3];
+assert(forInKeys(array) === "0,1,2");
+array.push(4);
+assert(forInKeys(array) === "0,1,2,3");
+assert(forInKeys("str") === "0,1,2");
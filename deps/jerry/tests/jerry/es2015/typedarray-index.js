@@ -0,0 +1,70 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+var a, i, sum;
+
+// Reading and writing elements by integer index
+a = new Int16Array (1000);
+for (i = 0; i < a.length; i++)
+{
+  a[i] = i * 3;
+}
+sum = 0;
+for (i = 0; i < a.length; i++)
+{
+  sum += a[i];
+}
+assert (sum === 1498500);
+
+// Conversion of the stored values
+a = new Uint8Array (4);
+a[0] = 257;
+a[1] = -1;
+a[2] = 3.7;
+a[3] = "12";
+assert (a[0] === 1 && a[1] === 255 && a[2] === 3 && a[3] === 12);
+
+a = new Float32Array (2);
+a[0] = 0.5;
+a[1] = { valueOf: function () { return 1.5; } };
+assert (a[0] === 0.5 && a[1] === 1.5);
+
+// Out of range indices are not looked up in the prototype chain
+Uint8Array.prototype[10] = "proto";
+a = new Uint8Array (2);
+assert (a[10] === undefined);
+a[10] = 5;
+assert (a[10] === undefined);
+assert (a.length === 2);
+delete Uint8Array.prototype[10];
+
+a[-1] = 7;
+assert (a[-1] === undefined);
+assert (a.length === 2);
+
+// Large indices
+a = new Uint8Array (70000);
+a[69999] = 9;
+assert (a[69999] === 9);
+assert (a[70000] === undefined);
+
+// Views share the memory of the buffer
+var buffer = new ArrayBuffer (8);
+var bytes = new Uint8Array (buffer);
+var words = new Uint32Array (buffer, 4, 1);
+words[0] = 0x01020304;
+assert (bytes[4] + bytes[5] + bytes[6] + bytes[7] === 10);
+bytes[0] = 42;
+assert (new Int8Array (buffer)[0] === 42);
+assert (words[1] === undefined);
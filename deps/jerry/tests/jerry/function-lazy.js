@@ -0,0 +1,115 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Nested functions, which may be compiled when they are called first. */
+
+function outer (a, b)
+{
+  var local = a + b;
+
+  function inner (c)
+  {
+    local += c;
+    return local;
+  }
+
+  return inner;
+}
+
+var inner = outer (1, 2);
+assert (inner.length === 1);
+assert (inner (3) === 6);
+assert (inner (4) === 10);
+
+function counter ()
+{
+  var count = 0;
+  return {
+    get value () { return count; },
+    set value (v) { count = v; },
+    next: function () { return ++count; }
+  };
+}
+
+var c = counter ();
+assert (c.next () === 1);
+c.value = 10;
+assert (c.next () === 11);
+assert (c.value === 11);
+
+function with_eval ()
+{
+  var hidden = 5;
+  function reader (name) { return eval (name); }
+  return reader ("hidden");
+}
+
+assert (with_eval () === 5);
+
+function strict_outer ()
+{
+  'use strict';
+  function strict_inner () { return this; }
+  return strict_inner ();
+}
+
+assert (strict_outer () === undefined);
+
+function directive_inner ()
+{
+  function f () { 'use strict'; return this; }
+  function g () { return this; }
+  return f () === undefined && g () !== undefined;
+}
+
+assert (directive_inner ());
+
+function named_expression ()
+{
+  var fact = function f (n) { return n <= 1 ? 1 : n * f (n - 1); };
+  return fact (5);
+}
+
+assert (named_expression () === 120);
+
+function args_outer ()
+{
+  function args_inner () { return arguments.length; }
+  return args_inner (1, 2, 3);
+}
+
+assert (args_outer () === 3);
+
+function deep ()
+{
+  return function (x) { return function (y) { return function (z) { return x + y + z; }; }; };
+}
+
+assert (deep () (1) (2) (3) === 6);
+
+function late_error ()
+{
+  function broken () { return new Function ("a", "return a +"); }
+  try
+  {
+    broken () ();
+    assert (false);
+  }
+  catch (e)
+  {
+    assert (e instanceof SyntaxError);
+  }
+}
+
+late_error ();
@@ -0,0 +1,107 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Catch bindings of functions without a lexical environment. */
+function catchLocal(a) {
+  var x = a;
+  try {
+    throw x + 1;
+  } catch (e) {
+    x += e;
+  }
+  return x;
+}
+assert(catchLocal(1) === 3);
+
+function catchClosure() {
+  try {
+    throw 5;
+  } catch (e) {
+    return function() { return e; };
+  }
+}
+assert(catchClosure()() === 5);
+
+function catchShadow(e) {
+  try {
+    throw 2;
+  } catch (e) {
+    e++;
+  }
+  return e;
+}
+assert(catchShadow(7) === 7);
+
+function catchVar() {
+  var e = 1;
+  try {
+    throw 2;
+  } catch (e) {
+    var e = 3;
+  }
+  return e;
+}
+assert(catchVar() === 1);
+
+function catchNested() {
+  var r = 0;
+  try {
+    throw 1;
+  } catch (e) {
+    try {
+      throw 2;
+    } catch (f) {
+      r = e + f;
+    }
+    r += e;
+  }
+  return r;
+}
+assert(catchNested() === 4);
+
+var outer = 10;
+function catchOuter() {
+  try {
+    throw 1;
+  } catch (e) {
+    return outer + e;
+  }
+}
+assert(catchOuter() === 11);
+
+/* Names of function expressions. */
+var unused = function unusedName(a) { return a + 1; };
+assert(unused(1) === 2);
+
+var recursive = function fact(n) { return n <= 1 ? 1 : n * fact(n - 1); };
+assert(recursive(5) === 120);
+
+var inner = function innerName() { return function() { return typeof innerName; }; };
+assert(inner()() === 'function');
+
+var evaluated = function evalName() { return eval('typeof evalName'); };
+assert(evaluated() === 'function');
+
+var shadowed = function shadowName(shadowName) { return shadowName; };
+assert(shadowed(4) === 4);
+
+var typed = function typeName() { return typeof typeName; };
+assert(typed() === 'function');
+
+var hidden = function hiddenName() { return typeof hiddenName2; };
+assert(hidden() === 'undefined');
+
+var g = 'global';
+var notBound = function g2() { return g; };
+assert(notBound() === 'global');
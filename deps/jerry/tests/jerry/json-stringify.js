@@ -212,3 +212,25 @@ assert (JSON.stringify (object, null, undefined) == '{"a":2}');
 assert (JSON.stringify (object, null, new Boolean (true)) == '{"a":2}');
 assert (JSON.stringify (object, null, [1, 2, 3] ) == '{"a":2}');
 assert (JSON.stringify (object, null, { "a": 3 }) == '{"a":2}');
+
+// Checking members without JSON representation between other members
+object = { "a": undefined, "b": 1, "c": function () {}, "d": "x", "e": undefined };
+assert (JSON.stringify (object) == '{"b":1,"d":"x"}');
+assert (JSON.stringify (object, null, 1) == '{\n "b": 1,\n "d": "x"\n}');
+assert (JSON.stringify ({ "a": undefined }, null, 1) == '{}');
+assert (JSON.stringify ([undefined, function () {}], null, 1) == '[\n null,\n null\n]');
+assert (JSON.stringify ({ "a": [], "b": {} }, null, 1) == '{\n "a": [],\n "b": {}\n}');
+
+// Checking escapes around characters copied as they are
+assert (JSON.stringify ("\u0001ab\"cd\\\u001fé€") == '"\\u0001ab\\"cd\\\\\\u001fé€"');
+assert (JSON.stringify ({ "k\n": "v\t" }) == '{"k\\n":"v\\t"}');
+
+// Checking a long text
+var long_array = [];
+for (var i = 0; i < 200; i++)
+{
+  long_array.push ({ "id": i, "name": "sensor" + i, "ok": i % 2 == 0 });
+}
+var long_text = JSON.stringify (long_array);
+assert (long_text.length == 7881);
+assert (JSON.stringify (JSON.parse (long_text)) == long_text);
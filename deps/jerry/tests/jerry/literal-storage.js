@@ -0,0 +1,42 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+var i, src;
+
+// Many string and number literals, also repeated in later sources
+src = "var o = {};";
+for (i = 0; i < 200; i++)
+{
+  src += "o.prop_" + i + " = 'value_" + i + "' + " + (i + 0.5) + " + " + (i * 3) + ";";
+}
+eval (src);
+eval (src);
+
+for (i = 0; i < 200; i++)
+{
+  assert (o["prop_" + i] === "value_" + i + (i + 0.5) + (i * 3));
+}
+assert (Object.keys (o).length === 200);
+
+// Literals which are equal or similar to each other
+assert (eval ("'abc' + 'abc'") === "abcabc");
+assert (eval ("'ab' + 'c'") === "abc");
+assert (eval ("1.25 + 1.25 + 125") === 127.5);
+assert (eval ("0.1 + 0.2") === 0.1 + 0.2);
+assert (eval ("1e300 * 10") === 1e301);
+assert (eval ("'0' + 0 + '0'") === "000");
+assert (function () { return "length"; } ().length === 6);
+
+var f = new Function ("a", "return a.value_1 + 'value_1' + 7.5");
+assert (f ({ value_1: "x" }) === "xvalue_17.5");
@@ -0,0 +1,49 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Numbers are converted to their shortest representation, which is read back as the same number. */
+assert (String (0.1) === "0.1");
+assert (String (0.1 + 0.2) === "0.30000000000000004");
+assert (String (123.456) === "123.456");
+assert (String (-20.5) === "-20.5");
+assert (String (1 / 3) === "0.3333333333333333");
+assert (String (5e-324) === "5e-324");
+assert (String (1.7976931348623157e308) === "1.7976931348623157e+308");
+assert (String (2.2250738585072014e-308) === "2.2250738585072014e-308");
+assert (String (1e21) === "1e+21");
+assert (String (1.5e-7) === "1.5e-7");
+assert (String (0.000001) === "0.000001");
+assert (String (2.5e300) === "2.5e+300");
+
+/* Integers. */
+assert (String (4294967296) === "4294967296");
+assert (String (-4294967297) === "-4294967297");
+assert (String (9007199254740991) === "9007199254740991");
+assert (String (9007199254740992) === "9007199254740992");
+assert (String (123456789012345680000) === "123456789012345680000");
+
+/* Decimal strings are converted to the nearest number. */
+assert (Number ("0.1") === 0.1);
+assert (Number ("  -12.5e1 ") === -125);
+assert (Number ("1e22") === 1e22);
+assert (Number ("-75.125") === -75.125);
+assert (Number ("1e-22") * 1e22 === 1);
+assert (1 / Number ("-0.0") === -Infinity);
+assert (isNaN (Number ("1.2.3")));
+
+var values = [0.5, 1.37, 20.25, -3.14159, 1e-10, 6.02214076e23, 299792.458, 1234.5678];
+for (var i = 0; i < values.length; i++) {
+  assert (Number (String (values[i])) === values[i]);
+  assert (JSON.parse (JSON.stringify (values[i])) === values[i]);
+}
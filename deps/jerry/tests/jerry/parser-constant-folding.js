@@ -0,0 +1,136 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Constant expressions computed by the parser. */
+assert(60 * 60 * 1000 === 3600000);
+assert(1 + 2 * 3 === 7);
+assert((1 + 2) * 3 === 9);
+assert(2 * -3 === -6);
+assert(-2 - -3 === 1);
+assert(10 - 2 - 3 === 5);
+assert(100 / 8 === 12.5);
+assert(10 % 3 + 0.5 === 1.5);
+assert(-7 % 2 === -1);
+assert(1 / (-0 * 1) === -Infinity);
+assert(1 / (0 * -1) === -Infinity);
+assert(1 / (1 - 1) === Infinity);
+assert(isNaN(0 / 0));
+assert(1 / 0 === Infinity);
+assert(1 << 31 === -2147483648);
+assert(1 << 31 >>> 0 === 2147483648);
+assert(-1 >>> 28 === 15);
+assert(-16 >> 2 === -4);
+assert(1 << 33 === 2);
+assert((5 | 2) === 7);
+assert((6 & 3) === 2);
+assert((6 ^ 3) === 5);
+assert((0.5 | 0) === 0);
+assert((4294967296 | 1) === 1);
+assert(255 + 1 === 256);
+assert(-256 - 1 === -257);
+assert(1 + 2 + "a" === "3a");
+assert("a" + 1 + 2 === "a12");
+assert("a" + "b" + "c" === "abc");
+assert("" + "" === "");
+assert(1 + 2 .toString() === "12");
+assert(1 + 2["toString"]() === "12");
+assert(2 * 3 < 7);
+assert((true ? 1 : 2) + 3 === 4);
+assert(typeof 1 + 2 === "number2");
+
+var x = 4;
+x = x * 2 + 1;
+assert(x === 9);
+x = 2 + 1 + x;
+assert(x === 12);
+
+/* Branches which are never executed. */
+var log = "";
+
+if (false) { log += "a"; }
+if (0) { log += "b"; } else { log += "c"; }
+if (true) { log += "d"; } else { log += "e"; }
+if (1) log += "f"; else log += "g";
+if ("") { log += "h"; }
+if ("x") { log += "i"; }
+if (null) { log += "j"; }
+if (0 / 0) { log += "k"; }
+if (0.5) { log += "l"; }
+if (1 - 1) { log += "m"; } else if (2 - 1) { log += "n"; } else { log += "o"; }
+assert(log === "cdfiln");
+
+/* Declarations are hoisted from the removed code. */
+if (false) {
+  var hoisted = 5;
+  function hoistedFunction() { return 6; }
+}
+assert(hoisted === undefined);
+assert(hoistedFunction() === 6);
+
+/* Jumps out of the removed code. */
+var count = 0;
+while (true) {
+  count++;
+  if (count < 3) {
+    continue;
+  }
+  if (false) {
+    break;
+  }
+  break;
+}
+assert(count === 3);
+
+outer: for (var i = 0; i < 3; i++) {
+  if (true) {
+  } else {
+    continue outer;
+  }
+  count++;
+}
+assert(count === 6);
+
+function deadReturn() {
+  if (false) {
+    return 1;
+  }
+}
+assert(deadReturn() === undefined);
+
+function liveReturn() {
+  if (true) {
+    return 1;
+  }
+}
+assert(liveReturn() === 1);
+
+function evalInDeadCode(a) {
+  if (false) {
+    eval("");
+  }
+  return a;
+}
+assert(evalInDeadCode(7) === 7);
+
+switch (2) {
+  case 1:
+    log = "1";
+    break;
+  case 2:
+    if (false) {
+      break;
+    }
+    log = "2";
+}
+assert(log === "2");
@@ -0,0 +1,69 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Objects with many properties are searched through their property hashmap. */
+var names = [];
+for (var i = 0; i < 300; i++) {
+  names.push("p" + i);
+  names.push(String(i * 7));
+}
+names.push("length", "prototype", "caller", "callee", "message");
+
+var obj = {};
+for (var i = 0; i < names.length; i++) {
+  obj[names[i]] = i;
+}
+
+for (var i = 0; i < names.length; i++) {
+  assert(obj[names[i]] === i);
+}
+assert(obj.p300 === undefined);
+assert(obj["q1"] === undefined);
+assert(!("302" in obj));
+
+/* Delete every third property, then add new ones. */
+for (var i = 0; i < names.length; i += 3) {
+  assert(delete obj[names[i]]);
+}
+
+for (var i = 0; i < names.length; i++) {
+  assert(obj[names[i]] === (i % 3 === 0 ? undefined : i));
+}
+
+for (var i = 0; i < 200; i++) {
+  obj["n" + i] = -i;
+}
+
+for (var i = 0; i < 200; i++) {
+  assert(obj["n" + i] === -i);
+}
+
+for (var i = 0; i < names.length; i += 3) {
+  obj[names[i]] = i + 1;
+}
+
+for (var i = 0; i < names.length; i++) {
+  assert(obj[names[i]] === (i % 3 === 0 ? i + 1 : i));
+}
+
+/* Remove most properties, so the hashmap is recreated. */
+for (var i = 0; i < names.length; i++) {
+  if (i !== 5) {
+    delete obj[names[i]];
+  }
+}
+
+assert(obj[names[5]] === 5);
+assert(obj[names[6]] === undefined);
+assert(obj.n199 === -199);
@@ -0,0 +1,65 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+var json = "[";
+for (var i = 0; i < 100; i++) {
+  json += (i ? "," : "") + '{"identifier":' + i + ',"description":"item","nested":{"identifier":' + i + '}}';
+}
+json += "]";
+
+var items = JSON.parse(json);
+assert(items.length === 100);
+
+for (var i = 0; i < items.length; i++) {
+  assert(items[i].identifier === i);
+  assert(items[i].nested.identifier === i);
+  assert(items[i].hasOwnProperty("description"));
+  assert(Object.keys(items[i]).join() === "identifier,description,nested");
+}
+
+/* Property names built at run-time match the parsed names. */
+var name = "ident" + "ifier".toString();
+for (var i = 0; i < items.length; i++) {
+  delete items[i][name];
+  assert(!items[i].hasOwnProperty("identifier"));
+  items[i]["identi" + "fier"] = -i;
+}
+
+items = JSON.parse(json);
+for (var i = 0; i < items.length; i++) {
+  assert(items[i][name] === i);
+}
+
+/* Names longer than the intern limit are still correct. */
+var long_name = "";
+for (var i = 0; i < 64; i++) {
+  long_name += "x";
+}
+var a = {};
+var b = {};
+a[long_name] = 1;
+b[long_name + ""] = 2;
+assert(a[long_name] === 1 && b[long_name] === 2);
+assert(Object.keys(a)[0] === Object.keys(b)[0]);
+
+/* Many objects share the same name. */
+var all = [];
+for (var i = 0; i < 1000; i++) {
+  var o = {};
+  o["shared" + "_name"] = i;
+  all.push(o);
+}
+for (var i = 0; i < all.length; i++) {
+  assert(all[i].shared_name === i);
+}
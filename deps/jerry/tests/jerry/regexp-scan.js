@@ -0,0 +1,97 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+var r;
+
+// Literal prefix
+r = /abc\d/.exec ("xxabxabcxabc7yy");
+assert (r[0] === "abc7");
+assert (r.index === 9);
+assert (/abc/.exec ("ab") === null);
+assert (/abc/.exec ("") === null);
+assert (/abcdefghijkl/.exec ("abcdefghijk abcdefghijkl") .index === 12);
+assert (/abcdefghijkl/.exec ("abcdefghijk abcdefghijkL") === null);
+
+// Multi-byte characters in the prefix and in the input
+r = /été/.exec ("étè été");
+assert (r.index === 4);
+r = /世界/.exec ("世世界!");
+assert (r.index === 1);
+r = /b/.exec ("😀éb");
+assert (r.index === 3);
+
+// Possible first characters of alternatives
+r = /GET|POST|PUT/.exec ("xx PUTS POST");
+assert (r[0] === "PUT");
+assert (r.index === 3);
+assert (/GET|POST/.exec ("get post") === null);
+r = /ab|é/.exec ("è éab");
+assert (r[0] === "é");
+assert (r.index === 2);
+assert (/a|b|c|d|e|f|g|h|i/.exec ("xyz i")[0] === "i");
+
+// Ignore case
+r = /get/i.exec ("xx GeT");
+assert (r[0] === "GeT");
+assert (r.index === 3);
+assert (/1a|b/i.exec ("xx 1A")[0] === "1A");
+assert (/é/i.exec ("x É").index === 2);
+
+// Anchored patterns
+assert (/^ab/.exec ("ab ab").index === 0);
+assert (/^ab/.exec ("xab") === null);
+assert (/^a|^b/.exec ("b").index === 0);
+assert (/^b/m.exec ("a\nb").index === 2);
+r = /^a/g;
+r.lastIndex = 1;
+assert (r.exec ("aa") === null);
+assert (r.lastIndex === 0);
+
+// Patterns without a known start
+assert (/a*b/.exec ("xxb")[0] === "b");
+assert (/(ab)?c/.exec ("xxc")[0] === "c");
+assert (/|a/.exec ("a")[0] === "");
+
+// Repeated global exec on the same input
+var input = "path=/a/b/c;path=/d;path=/eéf;";
+r = /path=([^;]*)/g;
+var paths = [];
+var m;
+while ((m = r.exec (input)) !== null)
+{
+  paths.push (m[1] + "@" + m.index + ":" + r.lastIndex);
+}
+assert (paths.join (" ") === "/a/b/c@0:11 /d@12:19 /eéf@20:29");
+assert (r.lastIndex === 0);
+
+r = /é./g;
+input = "éaébéc";
+assert (r.exec (input)[0] === "éa");
+r.lastIndex = 1;
+assert (r.exec (input)[0] === "éb");
+assert (r.lastIndex === 4);
+assert (r.exec ("xédéeéf")[0] === "éf");
+assert (r.exec (input) === null);
+
+// RegExps of the same pattern on different inputs
+var r1 = /o./g;
+var r2 = /o./g;
+assert (r1.exec ("foo boo")[0] === "oo");
+assert (r2.exec ("be or")[0] === "or");
+assert (r1.exec ("foo boo")[0] === "oo");
+assert (r1.lastIndex === 7);
+assert (r2.lastIndex === 5);
+
+assert ("a1b22c333".match (/\d+/g).join () === "1,22,333");
+assert ("one two two".replace (/two/g, "2") === "one 2 2");
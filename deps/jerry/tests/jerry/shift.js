@@ -19,3 +19,14 @@ assert((9 >> 2) === 2);
 assert((-14 >> 2) === -4);
 
 assert((9 >>> 2) === (9 >> 2));
+
+assert((1 << 31) === -2147483648);
+assert((0x7ffffff << 4) === 0x7ffffff0);
+assert((-1 << 28) === -268435456);
+assert((5 << -31) === 10);
+assert((5 << 33) === 10);
+assert((-0x8000000 >> 27) === -1);
+assert((-14 >> 34) === -4);
+assert((-1 >>> 0) === 4294967295);
+assert((-14 >>> 2) === 1073741820);
+assert((0x7ffffff >>> 27) === 0);
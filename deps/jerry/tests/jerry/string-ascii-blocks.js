@@ -0,0 +1,62 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Non-ASCII characters before, inside and after blocks of ASCII characters. */
+
+var ascii = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+for (var i = 0; i <= 34; i++)
+{
+  var head = ascii.substring (0, i);
+  var tail = ascii.substring (i);
+
+  var two = head + "é" + tail;
+  assert (two.length === ascii.length + 1);
+  assert (two.charCodeAt (i) === 0xe9);
+  assert (decodeURIComponent (encodeURIComponent (two)) === two);
+
+  var three = head + "€" + tail;
+  assert (three.length === ascii.length + 1);
+  assert (three.indexOf ("€") === i);
+  assert (decodeURI (encodeURI (three)) === three);
+
+  var pair = head + "😀" + tail;
+  assert (pair.length === ascii.length + 2);
+  assert (pair.charCodeAt (i + 1) === 0xde00);
+  assert (decodeURIComponent (encodeURIComponent (pair)) === pair);
+  assert (JSON.parse (JSON.stringify (pair)) === pair);
+}
+
+assert (decodeURIComponent ("0123456789abcdef0123456789%C3%A9") === "0123456789abcdef0123456789é");
+assert (decodeURIComponent ("0123456789abcdef0123456789%F0%9F%98%80") === "0123456789abcdef0123456789😀");
+
+try
+{
+  decodeURIComponent ("0123456789abcdef0123456789%C3");
+  assert (false);
+}
+catch (e)
+{
+  assert (e instanceof URIError);
+}
+
+try
+{
+  decodeURIComponent ("0123456789abcdef0123456789%ED%A0%BD%ED%B8%80");
+  assert (false);
+}
+catch (e)
+{
+  assert (e instanceof URIError);
+}
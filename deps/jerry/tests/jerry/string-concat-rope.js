@@ -0,0 +1,64 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+var str = "";
+for (var i = 0; i < 1000; i++)
+{
+  str += "ab" + i;
+}
+
+assert (str.length === 4890);
+assert (str.charAt (0) === "a");
+assert (str.charAt (4889) === "9");
+assert (str.indexOf ("ab999") === 4885);
+assert (str.substring (2, 6) === "0ab1");
+
+var prepended = "";
+for (var i = 0; i < 100; i++)
+{
+  prepended = i % 10 + prepended;
+}
+
+assert (prepended.length === 100);
+assert (prepended.charAt (0) === "9");
+assert (prepended.slice (-3) === "210");
+
+var left = "0123456789012345678901234567890123456789";
+var right = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz";
+var joined = left + right;
+var literal = "0123456789012345678901234567890123456789abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz";
+
+assert (joined === literal);
+assert (joined + "" === literal);
+assert (literal < joined + "!");
+assert (!(joined < literal));
+
+var obj = {};
+obj[literal] = 1;
+assert (obj[left + right] === 1);
+obj[right + left] = 2;
+assert (obj[right + "0123456789012345678901234567890123456789"] === 2);
+
+var nested = ("x" + left) + (right + "y");
+assert (nested.length === 1 + left.length + right.length + 1);
+assert (nested === "x" + literal + "y");
+assert (nested.charAt (nested.length - 1) === "y");
+
+var number = "000000000000000000000000000000000000000000000000000000000000" + "42";
+assert (+number === 42);
+
+var unicode = "áéíóúőű" + left + "😀" + right;
+assert (unicode.length === 7 + left.length + 2 + right.length);
+assert (unicode.charCodeAt (7 + left.length) === 0xd83d);
+assert (JSON.parse (JSON.stringify (unicode)) === unicode);
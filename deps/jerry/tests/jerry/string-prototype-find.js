@@ -0,0 +1,80 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+var long_string = "";
+for (var i = 0; i < 20; i++) {
+  long_string += "abcdefghij";
+}
+long_string += "needle in the haystack";
+
+// Short and long search strings in ascii strings.
+assert (long_string.indexOf ("needle") === 200);
+assert (long_string.indexOf ("needle in the haystack") === 200);
+assert (long_string.indexOf ("needle in the haystacks") === -1);
+assert (long_string.indexOf ("j") === 9);
+assert (long_string.indexOf ("ja") === 9);
+assert (long_string.indexOf ("hijab") === 7);
+assert (long_string.indexOf ("hijab", 8) === 17);
+assert (long_string.indexOf ("abcdefghijabcdefghijx") === -1);
+assert (long_string.indexOf ("haystack", 300) === -1);
+assert (long_string.indexOf ("", 5) === 0);
+assert (long_string.lastIndexOf ("a") === 219);
+assert (long_string.lastIndexOf ("abc") === 190);
+assert (long_string.lastIndexOf ("abc", 189) === 180);
+assert (long_string.lastIndexOf ("abc", 0) === 0);
+assert (long_string.lastIndexOf ("haystack", 0) === -1);
+
+// Non-ascii strings.
+var unicode_string = "été 中文 café 😀 café";
+assert (unicode_string.indexOf ("café") === 7);
+assert (unicode_string.indexOf ("café", 8) === 15);
+assert (unicode_string.indexOf ("é", 1) === 2);
+assert (unicode_string.indexOf ("\ude00") === 13);
+assert (unicode_string.indexOf ("😀") === 12);
+assert (unicode_string.indexOf ("té 中") === 1);
+assert (unicode_string.indexOf ("x") === -1);
+assert (unicode_string.lastIndexOf ("café") === 15);
+assert (unicode_string.lastIndexOf ("café", 14) === 7);
+assert (unicode_string.lastIndexOf ("é", 6) === 2);
+
+var long_unicode_string = "";
+for (i = 0; i < 20; i++) {
+  long_unicode_string += "ábcdefgh中j";
+}
+assert (long_unicode_string.indexOf ("中jábc") === 8);
+assert (long_unicode_string.indexOf ("中jábc", 9) === 18);
+assert (long_unicode_string.indexOf ("中jábd") === -1);
+assert (long_unicode_string.lastIndexOf ("h中j") === 197);
+
+// split and replace with string patterns.
+var parts = "GET /index.html HTTP/1.1\r\nHost: localhost\r\n\r\n".split ("\r\n");
+assert (parts.length === 4);
+assert (parts[0] === "GET /index.html HTTP/1.1");
+assert (parts[1] === "Host: localhost");
+assert (parts[2] === "" && parts[3] === "");
+
+parts = "a,,b,".split (",");
+assert (parts.length === 4 && parts[1] === "" && parts[2] === "b" && parts[3] === "");
+
+parts = "é-é--é".split ("--");
+assert (parts.length === 2 && parts[0] === "é-é" && parts[1] === "é");
+
+parts = "a1b1c".split ("1", 2);
+assert (parts.length === 2 && parts[1] === "b");
+
+parts = "abc".split ("");
+assert (parts.length === 3 && parts[2] === "c");
+
+assert (long_string.replace ("needle", "pin").indexOf ("pin in") === 200);
+assert ("café café".replace ("é c", "e-c") === "cafe-café");
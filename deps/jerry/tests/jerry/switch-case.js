@@ -103,3 +103,28 @@ switch ("var") {
 }
 
 assert (flow === '123a4');
+
+function return_in_case (value) {
+  switch (value) {
+    case 1: return
+    case 2: return 2;
+  }
+  return 3;
+}
+
+assert (return_in_case (1) === undefined);
+assert (return_in_case (2) === 2);
+assert (return_in_case (5) === 3);
+
+function getter_in_case (value) {
+  switch (value) {
+    case 1:
+      var obj = { get prop () { return 'get'; }, set prop (v) { } };
+      return obj.prop;
+    default:
+      return 'default';
+  }
+}
+
+assert (getter_in_case (1) === 'get');
+assert (getter_in_case (2) === 'default');
@@ -0,0 +1,94 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Name lists growing past several capacities. */
+var object = {};
+for (var i = 0; i < 1000; i++) {
+  object["p" + i] = i;
+
+  if ((i & (i + 1)) === 0 || i === 999) {
+    var keys = Object.keys(object);
+    assert(keys.length === i + 1);
+    assert(keys[0] === "p0" && keys[i] === "p" + i);
+  }
+}
+
+var count = 0;
+for (var key in object) {
+  assert(key === "p" + count);
+  count++;
+}
+assert(count === 1000);
+
+/* Loops left early, with the rest of the names unconsumed. */
+for (var key in object) {
+  if (key === "p500") {
+    break;
+  }
+}
+
+try {
+  for (var key in object) {
+    if (key === "p3") {
+      throw key;
+    }
+  }
+} catch (e) {
+  assert(e === "p3");
+}
+
+/* Names deleted during the loop are skipped. */
+var visited = 0;
+for (var key in object) {
+  visited++;
+  if (key === "p0") {
+    for (var j = 1; j < 1000; j += 2) {
+      delete object["p" + j];
+    }
+  }
+}
+assert(visited === 500);
+
+/* The occurrence stack of JSON.stringify grows and shrinks with the nesting. */
+var nested = {};
+var inner = nested;
+for (var i = 0; i < 40; i++) {
+  inner.child = { index: i };
+  inner = inner.child;
+}
+var text = JSON.stringify(nested);
+assert(JSON.parse(text).child.child.child.index === 2);
+
+inner.child = nested;
+try {
+  JSON.stringify(nested);
+  assert(false);
+} catch (e) {
+  assert(e instanceof TypeError);
+}
+
+var array = [];
+for (var i = 0; i < 20; i++) {
+  array.push([i, { value: [i] }]);
+}
+assert(JSON.stringify(array).length > 0);
+
+/* Property names of the other object types. */
+assert(Object.getOwnPropertyNames(function (a, b) {}).length >= 2);
+assert(Object.getOwnPropertyNames(new String("abcdefghij")).length === 11);
+var sparse = [];
+sparse[5] = 1;
+sparse[100] = 2;
+sparse.x = 3;
+assert(Object.keys(sparse).join() === "5,100,x");
@@ -1102,6 +1102,28 @@ main (void)
     jerry_release_value (res);
     jerry_release_value (parsed_code_val);
 
+    /* With a zero frequency the callback is only called when it is requested. */
+    countdown = 6;
+    jerry_set_vm_exec_stop_callback (vm_exec_stop_callback, &countdown, 0);
+
+    inf_loop_code_src_p = "for (var i = 0; i < 1000; i++) {}";
+    res = jerry_eval ((jerry_char_t *) inf_loop_code_src_p, strlen (inf_loop_code_src_p), false);
+    TEST_ASSERT (!jerry_value_has_error_flag (res));
+    TEST_ASSERT (countdown == 6);
+    jerry_release_value (res);
+
+    countdown = 0;
+    jerry_request_vm_exec_stop ();
+
+    /* The callback keeps stopping the scripts once it has thrown. */
+    inf_loop_code_src_p = "while(true) {}";
+    for (int i = 0; i < 2; i++)
+    {
+      res = jerry_eval ((jerry_char_t *) inf_loop_code_src_p, strlen (inf_loop_code_src_p), false);
+      TEST_ASSERT (jerry_value_has_error_flag (res));
+      jerry_release_value (res);
+    }
+
     jerry_cleanup ();
   }
 
@@ -1212,6 +1234,59 @@ main (void)
     jerry_cleanup ();
   }
 
+  /* Dump / execute snapshot of several sources */
+  if (jerry_is_feature_enabled (JERRY_FEATURE_SNAPSHOT_SAVE)
+      && jerry_is_feature_enabled (JERRY_FEATURE_SNAPSHOT_EXEC))
+  {
+    static uint32_t multi_snapshot_buffer[SNAPSHOT_BUFFER_SIZE];
+
+    const jerry_char_t *sources_p[] =
+    {
+      (const jerry_char_t *) "'first ' + 'string shared by the sources of the snapshot, long enough to stay in it';",
+      (const jerry_char_t *) "'second ' + 'string shared by the sources of the snapshot, long enough to stay in it';"
+    };
+    const size_t source_sizes[] = { strlen ((const char *) sources_p[0]), strlen ((const char *) sources_p[1]) };
+
+    jerry_init (JERRY_INIT_EMPTY);
+    size_t multi_snapshot_size = jerry_parse_and_save_multi_snapshot (sources_p,
+                                                                      source_sizes,
+                                                                      2,
+                                                                      false,
+                                                                      false,
+                                                                      multi_snapshot_buffer,
+                                                                      sizeof (multi_snapshot_buffer));
+    TEST_ASSERT (multi_snapshot_size != 0);
+    jerry_cleanup ();
+
+    for (int copy_bytecode = 0; copy_bytecode < 2; copy_bytecode++)
+    {
+      jerry_init (JERRY_INIT_EMPTY);
+
+      res = jerry_exec_multi_snapshot (multi_snapshot_buffer, multi_snapshot_size, 1, copy_bytecode);
+      TEST_ASSERT (!jerry_value_has_error_flag (res));
+      TEST_ASSERT (jerry_value_is_string (res));
+      TEST_ASSERT (jerry_get_string_size (res) == 78);
+      sz = jerry_substring_to_char_buffer (res, 0, 20, (jerry_char_t *) buffer, sizeof (buffer));
+      jerry_release_value (res);
+      TEST_ASSERT (sz == 20);
+      TEST_ASSERT (!strncmp (buffer, "second string shared", 20));
+
+      res = jerry_exec_multi_snapshot (multi_snapshot_buffer, multi_snapshot_size, 0, copy_bytecode);
+      TEST_ASSERT (!jerry_value_has_error_flag (res));
+      TEST_ASSERT (jerry_get_string_size (res) == 77);
+      sz = jerry_substring_to_char_buffer (res, 0, 19, (jerry_char_t *) buffer, sizeof (buffer));
+      jerry_release_value (res);
+      TEST_ASSERT (sz == 19);
+      TEST_ASSERT (!strncmp (buffer, "first string shared", 19));
+
+      res = jerry_exec_multi_snapshot (multi_snapshot_buffer, multi_snapshot_size, 2, copy_bytecode);
+      TEST_ASSERT (jerry_value_has_error_flag (res));
+      jerry_release_value (res);
+
+      jerry_cleanup ();
+    }
+  }
+
   /* Save literals */
   if (jerry_is_feature_enabled (JERRY_FEATURE_SNAPSHOT_SAVE))
   {
@@ -0,0 +1,178 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jerryscript.h"
+
+#include "test-common.h"
+
+/**
+ * Number of calls of the free callback of the external buffer
+ */
+static int free_count = 0;
+
+/**
+ * Data of the external buffer
+ */
+static uint8_t external_data[16];
+
+/**
+ * Free callback of the external buffer
+ */
+static void
+external_free_cb (void *native_p) /**< data buffer */
+{
+  TEST_ASSERT (native_p == external_data);
+  free_count++;
+} /* external_free_cb */
+
+/**
+ * Evaluate a piece of code
+ *
+ * @return result of the evaluation
+ */
+static jerry_value_t
+eval_code (const char *source_p) /**< source code */
+{
+  jerry_value_t result = jerry_eval ((const jerry_char_t *) source_p, strlen (source_p), false);
+  TEST_ASSERT (!jerry_value_has_error_flag (result));
+  return result;
+} /* eval_code */
+
+/**
+ * Set a property of the global object
+ */
+static void
+set_global_property (const char *name_p, /**< property name */
+                     jerry_value_t value) /**< property value */
+{
+  jerry_value_t global_obj_val = jerry_get_global_object ();
+  jerry_value_t name_val = jerry_create_string ((const jerry_char_t *) name_p);
+  jerry_value_t result_val = jerry_set_property (global_obj_val, name_val, value);
+  TEST_ASSERT (!jerry_value_has_error_flag (result_val));
+
+  jerry_release_value (result_val);
+  jerry_release_value (name_val);
+  jerry_release_value (global_obj_val);
+} /* set_global_property */
+
+/**
+ * Check that the API fails gracefully if the ArrayBuffer built-in is disabled
+ */
+static void
+test_disabled (void)
+{
+  jerry_value_t result = jerry_create_arraybuffer (4);
+  TEST_ASSERT (jerry_value_has_error_flag (result));
+  jerry_release_value (result);
+
+  result = jerry_create_arraybuffer_external (sizeof (external_data), external_data, external_free_cb);
+  TEST_ASSERT (jerry_value_has_error_flag (result));
+  jerry_release_value (result);
+
+  jerry_value_t object = jerry_create_object ();
+  TEST_ASSERT (!jerry_value_is_arraybuffer (object));
+  TEST_ASSERT (!jerry_value_is_typedarray (object));
+  TEST_ASSERT (jerry_get_arraybuffer_byte_length (object) == 0);
+  TEST_ASSERT (jerry_get_arraybuffer_pointer (object) == NULL);
+  jerry_release_value (object);
+} /* test_disabled */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  if (!jerry_is_feature_enabled (JERRY_FEATURE_TYPEDARRAY))
+  {
+    test_disabled ();
+    jerry_cleanup ();
+    TEST_ASSERT (free_count == 0);
+    return 0;
+  }
+
+  /* ArrayBuffer on the engine heap. */
+  jerry_value_t arraybuffer = jerry_create_arraybuffer (4);
+  TEST_ASSERT (jerry_value_is_arraybuffer (arraybuffer));
+  TEST_ASSERT (!jerry_value_is_typedarray (arraybuffer));
+  TEST_ASSERT (jerry_get_arraybuffer_byte_length (arraybuffer) == 4);
+
+  uint8_t *data_p = jerry_get_arraybuffer_pointer (arraybuffer);
+  TEST_ASSERT (data_p != NULL);
+  TEST_ASSERT (data_p[0] == 0 && data_p[3] == 0);
+  data_p[3] = 42;
+
+  set_global_property ("internal", arraybuffer);
+  jerry_release_value (arraybuffer);
+
+  jerry_value_t result = eval_code ("new Uint8Array (internal)[3] === 42");
+  TEST_ASSERT (jerry_get_boolean_value (result));
+  jerry_release_value (result);
+
+  /* ArrayBuffer over an external data buffer. */
+  memset (external_data, 0, sizeof (external_data));
+  external_data[1] = 5;
+
+  arraybuffer = jerry_create_arraybuffer_external (sizeof (external_data), external_data, external_free_cb);
+  TEST_ASSERT (jerry_value_is_arraybuffer (arraybuffer));
+  TEST_ASSERT (jerry_get_arraybuffer_byte_length (arraybuffer) == sizeof (external_data));
+  TEST_ASSERT (jerry_get_arraybuffer_pointer (arraybuffer) == external_data);
+
+  set_global_property ("external", arraybuffer);
+  jerry_release_value (arraybuffer);
+
+  result = eval_code ("var bytes = new Uint8Array (external);"
+                      "bytes[0] = bytes[1] + 2;"
+                      "bytes[15] = 255;"
+                      "external.byteLength === 16 && external.slice (1, 2).byteLength === 1");
+  TEST_ASSERT (jerry_get_boolean_value (result));
+  jerry_release_value (result);
+
+  TEST_ASSERT (external_data[0] == 7);
+  TEST_ASSERT (external_data[15] == 255);
+
+  /* Views of the external data buffer. */
+  jerry_value_t typedarray = eval_code ("new Uint16Array (external, 4, 3)");
+  TEST_ASSERT (jerry_value_is_typedarray (typedarray));
+  TEST_ASSERT (!jerry_value_is_arraybuffer (typedarray));
+
+  jerry_length_t byte_offset = 0;
+  jerry_length_t byte_length = 0;
+  arraybuffer = jerry_get_typedarray_buffer (typedarray, &byte_offset, &byte_length);
+  TEST_ASSERT (jerry_value_is_arraybuffer (arraybuffer));
+  TEST_ASSERT (jerry_get_arraybuffer_pointer (arraybuffer) == external_data);
+  TEST_ASSERT (byte_offset == 4);
+  TEST_ASSERT (byte_length == 6);
+  jerry_release_value (arraybuffer);
+  jerry_release_value (typedarray);
+
+  jerry_value_t number = jerry_create_number (1);
+  result = jerry_get_typedarray_buffer (number, NULL, NULL);
+  TEST_ASSERT (jerry_value_has_error_flag (result));
+  jerry_release_value (result);
+  jerry_release_value (number);
+
+  /* The data buffer is freed with the last reference to the ArrayBuffer. */
+  result = eval_code ("bytes = undefined; external = undefined;");
+  jerry_release_value (result);
+
+  jerry_gc ();
+  TEST_ASSERT (free_count == 1);
+
+  jerry_cleanup ();
+  TEST_ASSERT (free_count == 1);
+  return 0;
+} /* main */
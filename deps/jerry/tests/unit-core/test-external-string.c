@@ -0,0 +1,124 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+#include "jerryscript.h"
+#include "test-common.h"
+
+#define TEST_LONG_STRING_SIZE (70000)
+#define TEST_COPIED_STRING_SIZE (1000)
+
+static int free_count = 0;
+static const void *freed_p = NULL;
+
+static void
+external_string_free (void *native_p)
+{
+  free_count++;
+  freed_p = native_p;
+} /* external_string_free */
+
+static void
+set_global (const char *name_p, /**< name of the global */
+            jerry_value_t value) /**< value of the global */
+{
+  jerry_value_t global = jerry_get_global_object ();
+  jerry_value_t name = jerry_create_string ((const jerry_char_t *) name_p);
+  jerry_value_t res = jerry_set_property (global, name, value);
+
+  TEST_ASSERT (!jerry_value_has_error_flag (res));
+
+  jerry_release_value (res);
+  jerry_release_value (name);
+  jerry_release_value (global);
+} /* set_global */
+
+static bool
+eval_bool (const char *source_p) /**< source code which returns a boolean */
+{
+  jerry_value_t res = jerry_eval ((const jerry_char_t *) source_p, strlen (source_p), false);
+
+  TEST_ASSERT (jerry_value_is_boolean (res));
+  bool result = jerry_get_boolean_value (res);
+
+  jerry_release_value (res);
+  return result;
+} /* eval_bool */
+
+static char long_string[TEST_LONG_STRING_SIZE];
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  /* Short strings are copied, and freed at once. */
+  static const char short_string[] = "short";
+  jerry_value_t value = jerry_create_external_string_sz ((const jerry_char_t *) short_string,
+                                                         sizeof (short_string) - 1,
+                                                         external_string_free);
+  TEST_ASSERT (free_count == 1 && freed_p == short_string);
+  TEST_ASSERT (jerry_get_string_size (value) == 5);
+  jerry_release_value (value);
+
+  /* A long string refers to the characters until it is freed. */
+  for (size_t i = 0; i < TEST_LONG_STRING_SIZE; i++)
+  {
+    long_string[i] = (char) ('a' + (i % 26));
+  }
+
+  value = jerry_create_external_string_sz ((const jerry_char_t *) long_string,
+                                           TEST_LONG_STRING_SIZE,
+                                           external_string_free);
+
+  jerry_size_t size;
+  TEST_ASSERT (jerry_get_string_chars (value, &size) == (const jerry_char_t *) long_string);
+  TEST_ASSERT (size == TEST_LONG_STRING_SIZE);
+  TEST_ASSERT (jerry_get_string_length (value) == TEST_LONG_STRING_SIZE);
+
+  set_global ("ext", value);
+  jerry_release_value (value);
+
+  /* An external string is equal to the heap string with the same characters. */
+  value = jerry_create_external_string_sz ((const jerry_char_t *) long_string,
+                                           TEST_COPIED_STRING_SIZE,
+                                           NULL);
+  jerry_value_t heap_value = jerry_create_string_sz ((const jerry_char_t *) long_string,
+                                                     TEST_COPIED_STRING_SIZE);
+  set_global ("ext2", value);
+  set_global ("heap", heap_value);
+  jerry_release_value (heap_value);
+  jerry_release_value (value);
+
+  TEST_ASSERT (free_count == 1);
+
+  TEST_ASSERT (eval_bool ("ext2 === heap && heap === ext2 && ext2 !== ext"));
+  TEST_ASSERT (eval_bool ("ext.length === 70000 && ext.charAt(27) === 'b'"));
+  TEST_ASSERT (eval_bool ("ext.slice(0, 3) === 'abc' && ext.indexOf('zab') === 25"));
+  TEST_ASSERT (eval_bool ("ext.slice(0, 1000) === heap && ext2 < ext"));
+  TEST_ASSERT (eval_bool ("var o = {}; o[ext2] = 1; o[heap] === 1"));
+
+  jerry_value_t res = jerry_eval ((const jerry_char_t *) "ext = ext2 = heap = o = undefined", 33, false);
+  jerry_release_value (res);
+  jerry_gc ();
+
+  TEST_ASSERT (free_count == 2 && freed_p == long_string);
+
+  jerry_cleanup ();
+
+  return 0;
+} /* main */
@@ -0,0 +1,82 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "config.h"
+#include "jerryscript.h"
+#include "test-common.h"
+
+#define OBJECT_COUNT 256
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  size_t heap_size = 0;
+  size_t initial_usage = jerry_get_heap_usage (&heap_size);
+  TEST_ASSERT (heap_size > 0);
+  TEST_ASSERT (initial_usage <= heap_size);
+  TEST_ASSERT (jerry_get_heap_usage (NULL) == initial_usage);
+
+  /* The usage follows the live objects. */
+  jerry_value_t objects[OBJECT_COUNT];
+  for (uint32_t i = 0; i < OBJECT_COUNT; i++)
+  {
+    objects[i] = jerry_create_object ();
+  }
+
+  size_t peak_usage = jerry_get_heap_usage (NULL);
+  TEST_ASSERT (peak_usage > initial_usage);
+  TEST_ASSERT (peak_usage <= heap_size);
+
+  for (uint32_t i = 0; i < OBJECT_COUNT; i++)
+  {
+    jerry_release_value (objects[i]);
+  }
+
+  /* Collecting under critical pressure gives the garbage back. */
+  jerry_free_unused_memory_critical ();
+  TEST_ASSERT (jerry_get_heap_usage (NULL) < peak_usage);
+
+  /* The detailed usage keeps the peak after the garbage is gone. */
+  jerry_heap_usage_t usage;
+  jerry_get_heap_usage_stats (&usage);
+  TEST_ASSERT (usage.size == heap_size);
+  TEST_ASSERT (usage.allocated_size == jerry_get_heap_usage (NULL));
+  TEST_ASSERT (usage.peak_allocated_size >= peak_usage);
+  TEST_ASSERT (usage.pool_free_size <= usage.allocated_size);
+
+  size_t occupied_sizes[8];
+  uint32_t segment_count = jerry_get_segment_occupancy (occupied_sizes, 8);
+  TEST_ASSERT (segment_count == usage.segment_count);
+
+  size_t occupied_size = 0;
+  for (uint32_t i = 0; i < segment_count && i < 8; i++)
+  {
+    TEST_ASSERT (occupied_sizes[i] <= usage.segment_size);
+    occupied_size += occupied_sizes[i];
+  }
+  TEST_ASSERT (segment_count > 8 || occupied_size == usage.segment_occupied_size);
+
+  /* The collections are counted with their pause. */
+  jerry_gc_stats_t gc_stats;
+  jerry_get_gc_stats (&gc_stats);
+  TEST_ASSERT (gc_stats.total_pause_us >= gc_stats.last_pause_us);
+
+  jerry_cleanup ();
+
+  return 0;
+} /* main */
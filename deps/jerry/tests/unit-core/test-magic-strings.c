@@ -0,0 +1,137 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+#include "jerryscript.h"
+#include "lit-magic-strings.h"
+#include "test-common.h"
+
+/**
+ * External magic strings, sorted by size at first, then lexicographically
+ */
+static const jerry_char_ptr_t magic_string_items[] =
+{
+  (const jerry_char_ptr_t) "fs",
+  (const jerry_char_ptr_t) "net",
+  (const jerry_char_ptr_t) "http",
+  (const jerry_char_ptr_t) "buffer",
+  (const jerry_char_ptr_t) "console",
+  (const jerry_char_ptr_t) "process",
+  (const jerry_char_ptr_t) "Readable",
+  (const jerry_char_ptr_t) "EventEmitter"
+};
+
+static const jerry_length_t magic_string_lengths[] =
+{
+  2, 3, 4, 6, 7, 7, 8, 12
+};
+
+#define MAGIC_STRING_COUNT ((uint32_t) (sizeof (magic_string_items) / sizeof (jerry_char_ptr_t)))
+
+/**
+ * Perfect hash of the external magic strings, computed by
+ * calculate_perfect_hash of tools/gen-magic-strings.py
+ */
+static const uint16_t magic_string_hash_displacements[] =
+{
+  0, 0
+};
+
+static const uint16_t magic_string_hash_slots[] =
+{
+  3, 7, MAGIC_STRING_COUNT, 5, 4, 0, MAGIC_STRING_COUNT, 6, 2, 1
+};
+
+static const char *non_magic_strings[] =
+{
+  "f", "fss", "htt", "buffer2", "Console", "Readablf", "EventEmitte"
+};
+
+static void
+test_magic_strings (void)
+{
+  for (lit_magic_string_id_t id = (lit_magic_string_id_t) 0;
+       id < LIT_NON_INTERNAL_MAGIC_STRING__COUNT;
+       id = (lit_magic_string_id_t) (id + 1))
+  {
+    const lit_utf8_byte_t *string_p = lit_get_magic_string_utf8 (id);
+    lit_utf8_size_t string_size = lit_get_magic_string_size (id);
+
+    TEST_ASSERT (lit_is_utf8_string_magic (string_p, string_size) == id);
+
+    for (lit_utf8_size_t split = 0; split <= string_size; split++)
+    {
+      TEST_ASSERT (lit_is_utf8_string_pair_magic (string_p, split, string_p + split, string_size - split) == id);
+    }
+  }
+
+  TEST_ASSERT (lit_is_utf8_string_magic ((const lit_utf8_byte_t *) "lengthx", 7) == LIT_MAGIC_STRING__COUNT);
+  TEST_ASSERT (lit_is_utf8_string_pair_magic ((const lit_utf8_byte_t *) "len", 3,
+                                              (const lit_utf8_byte_t *) "gtx", 3) == LIT_MAGIC_STRING__COUNT);
+} /* test_magic_strings */
+
+static void
+test_magic_strings_ex (void)
+{
+  for (lit_magic_string_ex_id_t id = 0; id < MAGIC_STRING_COUNT; id++)
+  {
+    const lit_utf8_byte_t *string_p = magic_string_items[id];
+    lit_utf8_size_t string_size = magic_string_lengths[id];
+
+    TEST_ASSERT (lit_is_ex_utf8_string_magic (string_p, string_size) == id);
+
+    for (lit_utf8_size_t split = 0; split <= string_size; split++)
+    {
+      TEST_ASSERT (lit_is_ex_utf8_string_pair_magic (string_p, split, string_p + split, string_size - split) == id);
+    }
+  }
+
+  for (uint32_t i = 0; i < sizeof (non_magic_strings) / sizeof (const char *); i++)
+  {
+    const lit_utf8_byte_t *string_p = (const lit_utf8_byte_t *) non_magic_strings[i];
+    lit_utf8_size_t string_size = (lit_utf8_size_t) strlen (non_magic_strings[i]);
+
+    TEST_ASSERT (lit_is_ex_utf8_string_magic (string_p, string_size) == MAGIC_STRING_COUNT);
+    TEST_ASSERT (lit_is_ex_utf8_string_pair_magic (string_p, 1, string_p + 1, string_size - 1) == MAGIC_STRING_COUNT);
+  }
+} /* test_magic_strings_ex */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+  test_magic_strings ();
+  jerry_cleanup ();
+
+  /* Binary search lookup. */
+  jerry_init (JERRY_INIT_EMPTY);
+  jerry_register_magic_strings (magic_string_items, MAGIC_STRING_COUNT, magic_string_lengths);
+  test_magic_strings_ex ();
+  jerry_cleanup ();
+
+  /* Perfect hash lookup. */
+  jerry_init (JERRY_INIT_EMPTY);
+  jerry_register_magic_strings (magic_string_items, MAGIC_STRING_COUNT, magic_string_lengths);
+  jerry_register_magic_strings_hash (magic_string_hash_displacements,
+                                     sizeof (magic_string_hash_displacements) / sizeof (uint16_t),
+                                     magic_string_hash_slots,
+                                     sizeof (magic_string_hash_slots) / sizeof (uint16_t));
+  test_magic_strings_ex ();
+  jerry_cleanup ();
+
+  return 0;
+} /* main */
@@ -0,0 +1,72 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+#include "jerryscript.h"
+#include "test-common.h"
+
+static uint32_t
+get_gc_count (void)
+{
+  jerry_gc_stats_t stats;
+  jerry_get_gc_stats (&stats);
+  return stats.count;
+} /* get_gc_count */
+
+static void
+create_garbage (uint32_t count) /**< number of objects */
+{
+  for (uint32_t i = 0; i < count; i++)
+  {
+    jerry_release_value (jerry_create_object ());
+  }
+} /* create_garbage */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  /* Regions are not nested, and need a headroom the heap can provide. */
+  TEST_ASSERT (!jerry_end_no_gc_region ());
+  TEST_ASSERT (!jerry_begin_no_gc_region ((size_t) -1));
+  TEST_ASSERT (jerry_begin_no_gc_region (4096));
+  TEST_ASSERT (!jerry_begin_no_gc_region (4096));
+
+  /* No collection is run in a region, even when requested. */
+  uint32_t gc_count = get_gc_count ();
+  jerry_value_t object = jerry_create_object ();
+  jerry_gc ();
+  TEST_ASSERT (get_gc_count () == gc_count);
+  TEST_ASSERT (!jerry_end_no_gc_region ());
+  jerry_release_value (object);
+
+  /* Allocating past the headroom overruns the region, without a collection. */
+  TEST_ASSERT (jerry_begin_no_gc_region (64));
+  gc_count = get_gc_count ();
+  create_garbage (64);
+  TEST_ASSERT (get_gc_count () == gc_count);
+  TEST_ASSERT (jerry_end_no_gc_region ());
+
+  /* Collections are run again after the region. */
+  jerry_gc ();
+  TEST_ASSERT (get_gc_count () == gc_count + 1);
+
+  jerry_cleanup ();
+
+  return 0;
+} /* main */
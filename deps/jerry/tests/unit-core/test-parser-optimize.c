@@ -0,0 +1,84 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+#include "jerryscript.h"
+#include "test-common.h"
+
+#define SNAPSHOT_BUFFER_SIZE 1024
+
+static const char *test_source_p = ("var s = 'con' + 'cat' + 'enated';\n"
+                                    "var n = 60 * 60 * 1000 + 'ms';\n"
+                                    "if (false) { s = 'never'; }\n"
+                                    "s + ',' + n + ',' + ('a' + 1 + 2);\n");
+
+static bool
+run_source (void)
+{
+  jerry_value_t result = jerry_eval ((const jerry_char_t *) test_source_p, strlen (test_source_p), false);
+  const char *expected_p = "concatenated,3600000ms,a12";
+  jerry_char_t buffer[32];
+  bool is_equal = false;
+
+  if (jerry_value_is_string (result))
+  {
+    jerry_size_t size = jerry_string_to_char_buffer (result, buffer, sizeof (buffer));
+    is_equal = (size == strlen (expected_p) && memcmp (buffer, expected_p, size) == 0);
+  }
+
+  jerry_release_value (result);
+  return is_equal;
+} /* run_source */
+
+static size_t
+save_snapshot (jerry_init_flag_t flags) /**< init flags */
+{
+  static uint32_t snapshot_buffer[SNAPSHOT_BUFFER_SIZE];
+
+  jerry_init (flags);
+  size_t snapshot_size = jerry_parse_and_save_snapshot ((const jerry_char_t *) test_source_p,
+                                                        strlen (test_source_p),
+                                                        true,
+                                                        false,
+                                                        snapshot_buffer,
+                                                        SNAPSHOT_BUFFER_SIZE);
+  jerry_cleanup ();
+
+  TEST_ASSERT (snapshot_size != 0);
+  return snapshot_size;
+} /* save_snapshot */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  /* The optimizations do not change the results. */
+  jerry_init (JERRY_INIT_EMPTY);
+  TEST_ASSERT (run_source ());
+  jerry_cleanup ();
+
+  jerry_init (JERRY_INIT_PARSER_OPTIMIZE);
+  TEST_ASSERT (run_source ());
+  jerry_cleanup ();
+
+  /* Concatenated strings are stored without their parts. */
+  if (jerry_is_feature_enabled (JERRY_FEATURE_SNAPSHOT_SAVE))
+  {
+    TEST_ASSERT (save_snapshot (JERRY_INIT_PARSER_OPTIMIZE) < save_snapshot (JERRY_INIT_EMPTY));
+  }
+
+  return 0;
+} /* main */
@@ -31,6 +31,17 @@ const char *test_source = (
                            "}); "
                            );
 
+const char *chain_source = (
+                            "var sum = 0; "
+                            "var last; "
+                            "for (var i = 0; i < 32; i++) { "
+                            "  last = Promise.resolve(i).then(function(x) { sum += x; }).then(function() { }); "
+                            "} "
+                            "last.then(function() { "
+                            "  assert(sum === 496); "
+                            "}); "
+                            );
+
 static int count_in_assert = 0;
 static jerry_value_t my_promise1;
 static jerry_value_t my_promise2;
@@ -160,6 +171,31 @@ main (void)
   jerry_release_value (str_resolve);
   jerry_release_value (str_reject);
 
+  /* Test jerry_run_enqueued_jobs and jerry_has_enqueued_jobs with a chain growing the jobqueue. */
+  TEST_ASSERT (!jerry_has_enqueued_jobs ());
+
+  res = jerry_eval ((jerry_char_t *) chain_source, strlen (chain_source), false);
+  TEST_ASSERT (!jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+
+  TEST_ASSERT (jerry_has_enqueued_jobs ());
+
+  while (jerry_has_enqueued_jobs ())
+  {
+    res = jerry_run_enqueued_jobs (1);
+    TEST_ASSERT (!jerry_value_has_error_flag (res));
+    jerry_release_value (res);
+  }
+
+  TEST_ASSERT (count_in_assert == 3);
+
+  /* The jobs which are not run are freed by jerry_cleanup. */
+  res = jerry_eval ((jerry_char_t *) chain_source, strlen (chain_source), false);
+  TEST_ASSERT (!jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+
+  TEST_ASSERT (jerry_has_enqueued_jobs ());
+
   jerry_cleanup ();
 } /* main */
 
@@ -74,6 +74,8 @@ def get_arguments():
                         help='build jerry command line tool (%(choices)s; default: %(default)s)')
     parser.add_argument('--jerry-cmdline-minimal', metavar='X', choices=['ON', 'OFF'], default='OFF', type=str.upper,
                         help='build minimal version of the jerry command line tool (%(choices)s; default: %(default)s)')
+    parser.add_argument('--jerry-cmdline-replay', metavar='X', choices=['ON', 'OFF'], default='OFF', type=str.upper,
+                        help='build the allocation trace replay tool (%(choices)s; default: %(default)s)')
     parser.add_argument('--jerry-debugger', metavar='X', choices=['ON', 'OFF'], default='OFF', type=str.upper,
                         help='enable the jerry debugger (%(choices)s; default: %(default)s)')
     parser.add_argument('--jerry-ext', metavar='X', choices=['ON', 'OFF'], default='ON', type=str.upper,
@@ -150,6 +152,7 @@ def generate_build_options(arguments):
     build_options.append('-DFEATURE_ERROR_MESSAGES=%s' % arguments.error_messages)
     build_options.append('-DJERRY_CMDLINE=%s' % arguments.jerry_cmdline)
     build_options.append('-DJERRY_CMDLINE_MINIMAL=%s' % arguments.jerry_cmdline_minimal)
+    build_options.append('-DJERRY_CMDLINE_REPLAY=%s' % arguments.jerry_cmdline_replay)
     build_options.append('-DJERRY_PORT_DEFAULT=%s' % arguments.jerry_port_default)
     build_options.append('-DJERRY_EXT=%s' % arguments.jerry_ext)
     build_options.append('-DJERRY_LIBC=%s' % arguments.jerry_libc)
@@ -81,7 +81,9 @@ def extract_magic_string_refs(debug=False):
         # the listed (file, line number) locations.
         for str_ref in re.findall('LIT_MAGIC_STRING_[a-zA-Z0-9_]+', line):
             if str_ref in ['LIT_MAGIC_STRING_DEF',
-                           'LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE',
+                           'LIT_MAGIC_STRING_HASH_DISPLACEMENT',
+                           'LIT_MAGIC_STRING_HASH_INIT',
+                           'LIT_MAGIC_STRING_HASH_SLOT',
                            'LIT_MAGIC_STRING_LENGTH_LIMIT',
                            'LIT_MAGIC_STRING__COUNT']:
                 continue
@@ -240,33 +242,100 @@ def generate_magic_string_defs(gen_file, defs):
         print('#endif', file=gen_file)
 
 
-def generate_first_magic_strings(gen_file, defs):
-    print(file=gen_file) # empty line separator
+# Must be kept in sync with lit_magic_string_hash and lit_magic_string_hash_slot
+# in jerry-core/lit/lit-magic-strings.c.
+HASH_INIT = 2166136261
+HASH_MASK = 0xffffffff
+HASH_BUCKET_SIZE = 4
+HASH_MAX_DISPLACEMENT = 0xffff
+
+
+def calculate_hash(string, hash_value=HASH_INIT):
+    # 32 bit FNV-1a hash of the utf-8 representation of the string.
+    for byte in bytearray(string.encode('utf-8')):
+        hash_value = ((hash_value ^ byte) * 16777619) & HASH_MASK
+    return hash_value
+
+
+def calculate_hash_slot(hash_value, displacement, slot_count):
+    # The displaced hash is mixed by the finalizer of MurmurHash3.
+    hash_value = (hash_value + displacement) & HASH_MASK
+    hash_value ^= hash_value >> 16
+    hash_value = (hash_value * 0x85ebca6b) & HASH_MASK
+    hash_value ^= hash_value >> 13
+    hash_value = (hash_value * 0xc2b2ae35) & HASH_MASK
+    hash_value ^= hash_value >> 16
+    return hash_value % slot_count
+
+
+def calculate_perfect_hash(strings):
+    # Builds a hash-and-displace perfect hash for the list of strings as
+    #   ([displacement, ...], [string index or None, ...])
+    # where string i is found in the slot computed from the displacement of
+    # the bucket selected by `calculate_hash(strings[i]) % len(displacements)`.
+    hashes = [calculate_hash(string) for string in strings]
+    bucket_count = max(1, (len(strings) + HASH_BUCKET_SIZE - 1) // HASH_BUCKET_SIZE)
+    slot_count = max(1, len(strings) + len(strings) // 4)
+
+    while True:
+        buckets = [[] for _ in range(bucket_count)]
+        for idx, hash_value in enumerate(hashes):
+            buckets[hash_value % bucket_count].append(idx)
+
+        displacements = [0] * bucket_count
+        slots = [None] * slot_count
+
+        # Place the largest buckets first, while most of the slots are free.
+        for bucket_idx in sorted(range(bucket_count), key=lambda idx: (-len(buckets[idx]), idx)):
+            bucket = buckets[bucket_idx]
+            if not bucket:
+                continue
 
-    max_size = len(defs[-1][1])
-    for size in range(max_size + 1):
-        last_guards = set([()])
-        for str_ref, str_value, guards in defs:
-            if len(str_value) >= size:
-                if () not in guards and () in last_guards:
-                    print('#if {guards}'.format(guards=guards_to_str(guards)), file=gen_file)
-                elif () not in guards and () not in last_guards:
-                    if guards == last_guards:
-                        continue
-                    print('#elif {guards}'.format(guards=guards_to_str(guards)), file=gen_file)
-                elif () in guards and () not in last_guards:
-                    print('#else', file=gen_file)
-
-                print('LIT_MAGIC_STRING_FIRST_STRING_WITH_SIZE ({size}, {str_ref})'
-                      .format(size=size, str_ref=str_ref), file=gen_file)
-
-                if () in guards:
+            for displacement in range(HASH_MAX_DISPLACEMENT + 1):
+                bucket_slots = [calculate_hash_slot(hashes[idx], displacement, slot_count)
+                                for idx in bucket]
+                if len(set(bucket_slots)) == len(bucket_slots) \
+                   and all(slots[slot] is None for slot in bucket_slots):
                     break
+            else:
+                break
+
+            displacements[bucket_idx] = displacement
+            for idx, slot in zip(bucket, bucket_slots):
+                slots[slot] = idx
+        else:
+            return displacements, slots
+
+        slot_count += max(1, slot_count // 8)
+
+
+def generate_magic_string_hash(gen_file, defs):
+    displacements, slots = calculate_perfect_hash([str_value for _, str_value, _ in defs])
+
+    print(file=gen_file) # empty line separator
 
-                last_guards = guards
+    for displacement in displacements:
+        print('LIT_MAGIC_STRING_HASH_DISPLACEMENT ({displacement})'
+              .format(displacement=displacement), file=gen_file)
 
-        if () not in last_guards:
-            print('#endif', file=gen_file)
+    print(file=gen_file) # empty line separator
+
+    # The slots of the strings which are disabled by their guards are empty.
+    for slot in slots:
+        if slot is None:
+            print('LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)', file=gen_file)
+            continue
+
+        str_ref, _, guards = defs[slot]
+        if () in guards:
+            print('LIT_MAGIC_STRING_HASH_SLOT ({str_ref})'.format(str_ref=str_ref), file=gen_file)
+            continue
+
+        print('#if {guards}'.format(guards=guards_to_str(guards)), file=gen_file)
+        print('LIT_MAGIC_STRING_HASH_SLOT ({str_ref})'.format(str_ref=str_ref), file=gen_file)
+        print('#else', file=gen_file)
+        print('LIT_MAGIC_STRING_HASH_SLOT (LIT_NON_INTERNAL_MAGIC_STRING__COUNT)', file=gen_file)
+        print('#endif', file=gen_file)
 
 
 def main():
@@ -282,7 +351,7 @@ def main():
     with open(MAGIC_STRINGS_INC_H, 'w') as gen_file:
         generate_header(gen_file)
         generate_magic_string_defs(gen_file, extended_defs)
-        generate_first_magic_strings(gen_file, extended_defs)
+        generate_magic_string_hash(gen_file, extended_defs)
 
 
 if __name__ == '__main__':
@@ -27,13 +27,12 @@ set(COMMON_SRCFILES
     ${INCLUDE_ROOT}/uv-errno.h
     ${INCLUDE_ROOT}/uv-threadpool.h
     ${INCLUDE_ROOT}/uv-version.h
-#   ${SOURCE_ROOT}/fs-poll.c
+    ${SOURCE_ROOT}/fs-poll.c
     ${SOURCE_ROOT}/heap-inl.h
     ${SOURCE_ROOT}/inet.c
     ${SOURCE_ROOT}/queue.h
     ${SOURCE_ROOT}/threadpool.c
     ${SOURCE_ROOT}/uv-common.c
-    ${SOURCE_ROOT}/hashtable.c
     ${SOURCE_ROOT}/uv-common.h
 #   ${SOURCE_ROOT}/version.c
     ${SOURCE_ROOT}/tuv_debuglog.c
@@ -25,7 +25,8 @@ set(PLATFORM_SRCFILES
       ${PLATFORM_SRCFILES}
 #     ${UNIX_PATH}/proctitle.c
       ${UNIX_PATH}/linux-core.c
-#     ${UNIX_PATH}/linux-inotify.c
+      ${UNIX_PATH}/linux-inotify.c
+      ${UNIX_PATH}/linux-iouring.c
       ${UNIX_PATH}/linux-syscalls.c
       ${UNIX_PATH}/linux-syscalls.h
       )
@@ -97,6 +97,9 @@ int getpeername(int sockfd, struct sockaddr* addr, socklen_t* addrlen);
 #define UV_PLATFORM_LOOP_FIELDS                                               \
   struct pollfd pollfds[TUV_POLL_EVENTS_SIZE];                                \
   int npollfds;                                                               \
+  int16_t* pollfd_slots;      /* The pollfds entry of each fd, or -1. */     \
+  unsigned int npollfd_slots;                                                 \
+  int pollfds_stale;          /* Some pollfds entries are to be removed. */   \
 
 
 
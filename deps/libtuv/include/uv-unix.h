@@ -259,6 +259,7 @@ typedef struct {
   uv__io_t signal_io_watcher;                                                 \
   uv_signal_t child_watcher;                                                  \
   int emfile_fd;                                                              \
+  uint64_t idle_time;                                                         \
   UV_PLATFORM_LOOP_FIELDS
 #else /* original libuv code */
 # define UV_LOOP_PRIVATE_FIELDS                                               \
@@ -290,6 +291,7 @@ typedef struct {
   uv__io_t signal_io_watcher;                                                 \
   uv_signal_t child_watcher;                                                  \
   int emfile_fd;                                                              \
+  uint64_t idle_time;                                                         \
   UV_PLATFORM_LOOP_FIELDS
 #endif
 
@@ -374,13 +376,15 @@ typedef struct {
   uv_timer_cb timer_cb;                                                       \
   void* heap_node[1];                                                         \
   uint64_t timeout;                                                           \
-  uint64_t repeat;
+  uint64_t repeat;                                                            \
+  uint64_t slack;
 #else /* original libuv code */
 # define UV_TIMER_PRIVATE_FIELDS                                              \
   uv_timer_cb timer_cb;                                                       \
   void* heap_node[3];                                                         \
   uint64_t timeout;                                                           \
   uint64_t repeat;                                                            \
+  uint64_t slack;                                                             \
   uint64_t start_id;
 #endif
 
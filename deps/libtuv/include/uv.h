@@ -262,6 +262,8 @@ UV_EXTERN int uv_has_ref(const uv_handle_t*);
 
 UV_EXTERN void uv_update_time(uv_loop_t*);
 UV_EXTERN uint64_t uv_now(const uv_loop_t*);
+/* Nanoseconds the loop has spent blocked in polling for I/O. */
+UV_EXTERN uint64_t uv_metrics_idle_time(const uv_loop_t*);
 
 UV_EXTERN int uv_backend_fd(const uv_loop_t*);
 UV_EXTERN int uv_backend_timeout(const uv_loop_t*);
@@ -530,7 +532,12 @@ UV_EXTERN int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable);
 
 enum uv_tcp_flags {
   /* Used with uv_tcp_bind, when an IPv6 address is used. */
-  UV_TCP_IPV6ONLY = 1
+  UV_TCP_IPV6ONLY = 1,
+  /* Used with uv_tcp_bind, lets several sockets listen on the same address
+   * and port, with the kernel spreading the connections over them (sets
+   * SO_REUSEPORT). Returns UV_ENOTSUP where that is not available.
+   */
+  UV_TCP_REUSEPORT = 2
 };
 
 UV_EXTERN int uv_tcp_bind(uv_tcp_t* handle,
@@ -576,7 +583,24 @@ enum uv_udp_flags {
    * (provided they all set the flag) but only the last one to bind will receive
    * any traffic, in effect "stealing" the port from the previous listener.
    */
-  UV_UDP_REUSEADDR = 4
+  UV_UDP_REUSEADDR = 4,
+  /*
+   * Indicates that the message was received by recvmmsg, so the buffer provided
+   * must not be freed by the recv_cb callback.
+   */
+  UV_UDP_MMSG_CHUNK = 8,
+  /*
+   * Indicates that the buffer provided has been fully utilized by recvmmsg and
+   * that it should now be freed by the recv_cb callback. When this flag is set
+   * in uv_udp_recv_cb, nread will always be 0 and addr will always be NULL.
+   */
+  UV_UDP_MMSG_FREE = 16,
+  /*
+   * Indicates that recvmmsg should be used, if available. Set in
+   * uv_udp_init_ex. The buffer of uv_alloc_cb is then split into 64 KiB
+   * chunks, one per received message.
+   */
+  UV_UDP_RECVMMSG = 256
 };
 
 typedef void (*uv_udp_send_cb)(uv_udp_send_t* req, int status);
@@ -613,6 +637,7 @@ struct uv_udp_send_s {
 UV_EXTERN int uv_udp_init(uv_loop_t*, uv_udp_t* handle);
 UV_EXTERN int uv_udp_init_ex(uv_loop_t*, uv_udp_t* handle, unsigned int flags);
 UV_EXTERN int uv_udp_open(uv_udp_t* handle, uv_os_sock_t sock);
+UV_EXTERN int uv_udp_using_recvmmsg(const uv_udp_t* handle);
 UV_EXTERN int uv_udp_bind(uv_udp_t* handle,
                           const struct sockaddr* addr,
                           unsigned int flags);
@@ -723,7 +748,8 @@ struct uv_poll_s {
 enum uv_poll_event {
   UV_READABLE = 1,
   UV_WRITABLE = 2,
-  UV_DISCONNECT = 4
+  UV_DISCONNECT = 4,
+  UV_PRIORITIZED = 8
 };
 
 UV_EXTERN int uv_poll_init(uv_loop_t* loop, uv_poll_t* handle, int fd);
@@ -797,6 +823,8 @@ UV_EXTERN int uv_timer_stop(uv_timer_t* handle);
 UV_EXTERN int uv_timer_again(uv_timer_t* handle);
 UV_EXTERN void uv_timer_set_repeat(uv_timer_t* handle, uint64_t repeat);
 UV_EXTERN uint64_t uv_timer_get_repeat(const uv_timer_t* handle);
+UV_EXTERN void uv_timer_set_slack(uv_timer_t* handle, uint64_t slack);
+UV_EXTERN uint64_t uv_timer_get_slack(const uv_timer_t* handle);
 
 
 /*
@@ -983,11 +1011,29 @@ UV_EXTERN int uv_queue_work(uv_loop_t* loop,
                             uv_work_cb work_cb,
                             uv_after_work_cb after_work_cb);
 
+/* Sets the threadpool to keep `size` threads, growing up to `max_size`
+ * threads while all are busy. Threads beyond `size` leave after idling for a
+ * while. Must be called before any work is queued; otherwise the sizes come
+ * from UV_THREADPOOL_SIZE and UV_THREADPOOL_MAX_SIZE.
+ */
+UV_EXTERN int uv_threadpool_configure(unsigned int size,
+                                      unsigned int max_size);
+
 UV_EXTERN int uv_cancel(uv_req_t* req);
 #if defined(__NUTTX__) || defined(__TUV_RAW__) || defined(__TIZENRT__)
 // For embed systems that need cleanup before exit
 UV_EXTERN void tuv_cleanup(void);
 #endif
+#if defined(__NUTTX__)
+// Called right before the loop blocks in poll() for up to `timeout`
+// milliseconds, -1 for no limit, and with the milliseconds it was blocked
+// right after, so that the board can enter and leave a low-power state
+// around the wait. NULL for no callback.
+typedef void (*tuv_idle_cb)(uv_loop_t* loop, int timeout);
+UV_EXTERN void tuv_loop_set_idle_cb(uv_loop_t* loop,
+                                    tuv_idle_cb enter_cb,
+                                    tuv_idle_cb leave_cb);
+#endif
 
 struct uv_cpu_info_s {
   char* model;
@@ -56,15 +56,45 @@ static void uv__req_init(uv_loop_t* loop,
 
 #define MAX_THREADPOOL_SIZE 128
 
+/* Threads beyond the minimum leave after idling this long (nanoseconds). */
+#define THREADPOOL_IDLE_TIMEOUT ((uint64_t) 5 * 1000 * 1000 * 1000)
+
+enum {
+  SLOT_UNUSED = 0,
+  SLOT_RUNNING,
+  SLOT_EXITED  /* The thread has returned and waits to be joined. */
+};
+
+/* Work waiting to run. Every thread has a queue it takes work from first;
+ * a thread that has run out of work steals from the other queues. The
+ * queues outlive the threads, so work left in the queue of a thread that
+ * exited is stolen by the others.
+ */
+struct work_queue {
+  uv_mutex_t mutex;
+  QUEUE wq[UV__WORK_KINDS];  /* Work by kind, taken in this order. */
+  volatile unsigned int count;  /* Read without the mutex as a hint. */
+};
+
 static uv_once_t once = UV_ONCE_INIT;
 static uv_cond_t cond;
 static uv_mutex_t mutex;
-static unsigned int idle_threads;
-static unsigned int nthreads;
+static uv_mutex_t slow_io_mutex;
+static volatile unsigned int idle_threads;
+static volatile unsigned int nthreads;
+static unsigned int min_threads;
+static unsigned int max_threads;
+static unsigned int configured_min_threads;
+static unsigned int configured_max_threads;
+static unsigned int slow_io_running;
+static int slow_io_held;
 static uv_thread_t* threads;
 static uv_thread_t default_threads[4];
-static QUEUE exit_message;
-static QUEUE wq;
+static struct work_queue* queues;
+static struct work_queue default_queues[ARRAY_SIZE(default_threads)];
+static unsigned int next_queue;
+static unsigned char thread_slots[MAX_THREADPOOL_SIZE];
+static int exiting;
 static volatile int initialized;
 
 
@@ -73,39 +103,163 @@ static void uv__cancelled(struct uv__work* w) {
 }
 
 
-/* To avoid deadlock with uv_cancel() it's crucial that the worker
- * never holds the global mutex and the loop-local mutex at the same time.
+/* Slow I/O may only keep half of the threads busy, so that it does not hold
+ * back the other kinds of work.
+ */
+static int slow_io_acquire(void) {
+  int acquired;
+
+  uv_mutex_lock(&slow_io_mutex);
+  acquired = slow_io_running < (max_threads + 1) / 2;
+  if (acquired)
+    slow_io_running++;
+  else
+    slow_io_held = 1;
+  uv_mutex_unlock(&slow_io_mutex);
+
+  return acquired;
+}
+
+
+static void slow_io_release(void) {
+  int held;
+
+  uv_mutex_lock(&slow_io_mutex);
+  slow_io_running--;
+  held = slow_io_held;
+  slow_io_held = 0;
+  uv_mutex_unlock(&slow_io_mutex);
+
+  /* Slow I/O held back by the limit may go now. */
+  if (held) {
+    uv_mutex_lock(&mutex);
+    if (idle_threads > 0)
+      uv_cond_signal(&cond);
+    uv_mutex_unlock(&mutex);
+  }
+}
+
+
+/* Takes the first work of `queue` by kind, from the head for the owner of
+ * the queue and from the tail for a thief. With `hint`, an empty looking
+ * queue is skipped without taking its mutex.
+ */
+static QUEUE* take_work(struct work_queue* queue,
+                        int own,
+                        int hint,
+                        int* kind) {
+  QUEUE* q;
+
+  if (hint && queue->count == 0)
+    return NULL;
+
+  q = NULL;
+  uv_mutex_lock(&queue->mutex);
+  for (*kind = 0; *kind < UV__WORK_KINDS; (*kind)++) {
+    if (QUEUE_EMPTY(&queue->wq[*kind]))
+      continue;
+    if (*kind == UV__WORK_SLOW_IO && !slow_io_acquire())
+      continue;
+    q = own ? QUEUE_HEAD(&queue->wq[*kind]) : QUEUE_PREV(&queue->wq[*kind]);
+    QUEUE_REMOVE(q);
+    QUEUE_INIT(q);  /* Signal uv_cancel() that the work req is
+                       executing. */
+    queue->count--;
+    break;
+  }
+  uv_mutex_unlock(&queue->mutex);
+
+  return q;
+}
+
+
+static QUEUE* find_work(unsigned int slot, int hint, int* kind) {
+  unsigned int i;
+  QUEUE* q;
+
+  q = take_work(&queues[slot], 1, hint, kind);
+  for (i = 1; q == NULL && i < max_threads; i++)
+    q = take_work(&queues[(slot + i) % max_threads], 0, hint, kind);
+
+  return q;
+}
+
+
+static void worker(void* arg);
+
+
+/* Starts a thread in a free slot. Called with the global mutex held. */
+static int spawn_thread(void) {
+  unsigned int i;
+
+  for (i = 0; i < max_threads; i++) {
+    if (thread_slots[i] == SLOT_RUNNING)
+      continue;
+
+    if (thread_slots[i] == SLOT_EXITED)
+      if (uv_thread_join(threads + i))
+        abort();
+
+    thread_slots[i] = SLOT_UNUSED;
+    if (uv_thread_create(threads + i, worker, (void*) (uintptr_t) i))
+      return -1;
+
+    thread_slots[i] = SLOT_RUNNING;
+    nthreads++;
+    return 0;
+  }
+
+  return -1;
+}
+
+
+/* The global mutex only guards the pool itself and the idle threads; the
+ * work is guarded by the mutexes of the queues. A thread going idle counts
+ * itself as idle before it looks at the queues once more, under their
+ * mutexes, so that post() either sees it idle or it sees the new work.
+ *
+ * To avoid deadlock with uv_cancel() it's crucial that the worker
+ * never holds a queue mutex and the loop-local mutex at the same time.
  */
 static void worker(void* arg) {
   struct uv__work* w;
   QUEUE* q;
+  unsigned int slot;
+  int timed_out;
+  int kind;
 
-  (void) arg;
+  slot = (unsigned int) (uintptr_t) arg;
 
   for (;;) {
-    uv_mutex_lock(&mutex);
+    q = find_work(slot, 1, &kind);
 
-    while (QUEUE_EMPTY(&wq)) {
+    if (q == NULL) {
+      uv_mutex_lock(&mutex);
       idle_threads += 1;
-      uv_cond_wait(&cond, &mutex);
-      idle_threads -= 1;
-    }
-
-    q = QUEUE_HEAD(&wq);
+      timed_out = 0;
+
+      while ((q = find_work(slot, 0, &kind)) == NULL) {
+        if (exiting || (timed_out && nthreads > min_threads)) {
+          /* Idle for long enough, give the thread back. */
+          idle_threads -= 1;
+          nthreads -= 1;
+          if (!exiting)
+            thread_slots[slot] = SLOT_EXITED;
+          uv_mutex_unlock(&mutex);
+          return;
+        }
+
+        if (nthreads > min_threads)
+          timed_out = uv_cond_timedwait(&cond, &mutex,
+                                        THREADPOOL_IDLE_TIMEOUT) != 0;
+        else
+          uv_cond_wait(&cond, &mutex);
+      }
 
-    if (q == &exit_message)
-      uv_cond_signal(&cond);
-    else {
-      QUEUE_REMOVE(q);
-      QUEUE_INIT(q);  /* Signal uv_cancel() that the work req is
-                             executing. */
+      idle_threads -= 1;
+      uv_mutex_unlock(&mutex);
     }
 
-    uv_mutex_unlock(&mutex);
-
-    if (q == &exit_message)
-      break;
-
     w = QUEUE_DATA(q, struct uv__work, wq);
     w->work(w);
 
@@ -115,15 +269,38 @@ static void worker(void* arg) {
     QUEUE_INSERT_TAIL(&w->loop->wq, &w->wq);
     uv_async_send(&w->loop->wq_async);
     uv_mutex_unlock(&w->loop->wq_mutex);
+
+    if (kind == UV__WORK_SLOW_IO)
+      slow_io_release();
   }
 }
 
 
-static void post(QUEUE* q) {
+/* Work is spread over the queues of the running threads in turn. The global
+ * mutex is only taken when a thread is idle and has to be woken up, or when
+ * the pool has to grow, so a busy pool is fed without it.
+ */
+static void post(struct uv__work* w, enum uv__work_kind kind) {
+  struct work_queue* queue;
+  unsigned int idle;
+
+  w->queue = next_queue++ % nthreads;
+  queue = &queues[w->queue];
+
+  uv_mutex_lock(&queue->mutex);
+  QUEUE_INSERT_TAIL(&queue->wq[kind], &w->wq);
+  queue->count++;
+  idle = idle_threads;
+  uv_mutex_unlock(&queue->mutex);
+
+  if (idle == 0 && nthreads >= max_threads)
+    return;
+
   uv_mutex_lock(&mutex);
-  QUEUE_INSERT_TAIL(&wq, q);
   if (idle_threads > 0)
     uv_cond_signal(&cond);
+  else if (nthreads < max_threads)
+    spawn_thread();  /* All threads are busy, grow the pool. */
   uv_mutex_unlock(&mutex);
 }
 
@@ -139,20 +316,39 @@ UV_DESTRUCTOR(static void cleanup(void)) {
   if (initialized == 0)
     return;
 
-  post(&exit_message);
+  /* The threads leave once the work queued so far has run. */
+  uv_mutex_lock(&mutex);
+  exiting = 1;
+  uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&mutex);
 
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_join(threads + i))
-      abort();
+  for (i = 0; i < max_threads; i++) {
+    if (thread_slots[i] != SLOT_UNUSED)
+      if (uv_thread_join(threads + i))
+        abort();
+    thread_slots[i] = SLOT_UNUSED;
+  }
+
+  for (i = 0; i < max_threads; i++)
+    uv_mutex_destroy(&queues[i].mutex);
 
   if (threads != default_threads)
     uv__free(threads);
+  if (queues != default_queues)
+    uv__free(queues);
 
+  uv_mutex_destroy(&slow_io_mutex);
   uv_mutex_destroy(&mutex);
   uv_cond_destroy(&cond);
 
   threads = NULL;
+  queues = NULL;
   nthreads = 0;
+  idle_threads = 0;
+  next_queue = 0;
+  slow_io_running = 0;
+  slow_io_held = 0;
+  exiting = 0;
   initialized = 0;
   // tuv
   // It is very important to initialize once again.
@@ -164,25 +360,48 @@ UV_DESTRUCTOR(static void cleanup(void)) {
 #endif
 
 
-static void init_once(void) {
-  unsigned int i;
+static unsigned int threads_from_env(const char* name, unsigned int value) {
   const char* val;
 
-  nthreads = ARRAY_SIZE(default_threads);
-  val = getenv("UV_THREADPOOL_SIZE");
+  val = getenv(name);
   if (val != NULL)
-    nthreads = atoi(val);
-  if (nthreads == 0)
-    nthreads = 1;
-  if (nthreads > MAX_THREADPOOL_SIZE)
-    nthreads = MAX_THREADPOOL_SIZE;
+    value = atoi(val);
+  if (value == 0)
+    value = 1;
+  if (value > MAX_THREADPOOL_SIZE)
+    value = MAX_THREADPOOL_SIZE;
+  return value;
+}
+
+
+static void init_once(void) {
+  unsigned int i;
+  int kind;
+
+  if (configured_min_threads != 0) {
+    min_threads = configured_min_threads;
+    max_threads = configured_max_threads;
+  } else {
+    min_threads = threads_from_env("UV_THREADPOOL_SIZE",
+                                   ARRAY_SIZE(default_threads));
+    max_threads = threads_from_env("UV_THREADPOOL_MAX_SIZE", min_threads);
+  }
+  if (max_threads < min_threads)
+    max_threads = min_threads;
 
   threads = default_threads;
-  if (nthreads > ARRAY_SIZE(default_threads)) {
-    threads = uv__malloc(nthreads * sizeof(threads[0]));
-    if (threads == NULL) {
-      nthreads = ARRAY_SIZE(default_threads);
+  queues = default_queues;
+  if (max_threads > ARRAY_SIZE(default_threads)) {
+    threads = uv__malloc(max_threads * sizeof(threads[0]));
+    queues = uv__malloc(max_threads * sizeof(queues[0]));
+    if (threads == NULL || queues == NULL) {
+      uv__free(threads);
+      uv__free(queues);
+      max_threads = ARRAY_SIZE(default_threads);
+      if (min_threads > max_threads)
+        min_threads = max_threads;
       threads = default_threads;
+      queues = default_queues;
     }
   }
 
@@ -192,40 +411,75 @@ static void init_once(void) {
   if (uv_mutex_init(&mutex))
     abort();
 
-  QUEUE_INIT(&wq);
+  if (uv_mutex_init(&slow_io_mutex))
+    abort();
+
+  for (i = 0; i < max_threads; i++) {
+    if (uv_mutex_init(&queues[i].mutex))
+      abort();
+    for (kind = 0; kind < UV__WORK_KINDS; kind++)
+      QUEUE_INIT(&queues[i].wq[kind]);
+    queues[i].count = 0;
+  }
 
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_create(threads + i, worker, NULL))
+  nthreads = 0;
+  for (i = 0; i < min_threads; i++)
+    if (spawn_thread())
       abort();
 
   initialized = 1;
 }
 
 
+int uv_threadpool_configure(unsigned int size, unsigned int max_size) {
+  if (initialized)
+    return UV_EBUSY;
+  if (size == 0 || size > MAX_THREADPOOL_SIZE || max_size < size)
+    return UV_EINVAL;
+  if (max_size > MAX_THREADPOOL_SIZE)
+    max_size = MAX_THREADPOOL_SIZE;
+
+  configured_min_threads = size;
+  configured_max_threads = max_size;
+  return 0;
+}
+
+
 void uv__work_submit(uv_loop_t* loop,
                      struct uv__work* w,
+                     enum uv__work_kind kind,
                      void (*work)(struct uv__work* w),
                      void (*done)(struct uv__work* w, int status)) {
   uv_once(&once, init_once);
   w->loop = loop;
   w->work = work;
   w->done = done;
-  post(&w->wq);
+  post(w, kind);
 }
 
 
+/* Work stays in the queue post() put it in until a thread takes it, so the
+ * mutex of that queue is the one to hold.
+ */
 static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
+  struct work_queue* queue;
   int cancelled;
 
-  uv_mutex_lock(&mutex);
+  if (queues == NULL)
+    return UV_EBUSY;  /* Nothing was queued yet. */
+
+  queue = &queues[w->queue];
+  uv_mutex_lock(&queue->mutex);
   uv_mutex_lock(&w->loop->wq_mutex);
 
   cancelled = !QUEUE_EMPTY(&w->wq) && w->work != NULL;
-  if (cancelled)
+  if (cancelled) {
     QUEUE_REMOVE(&w->wq);
+    queue->count--;
+  }
 
   uv_mutex_unlock(&w->loop->wq_mutex);
-  uv_mutex_unlock(&mutex);
+  uv_mutex_unlock(&queue->mutex);
 
   if (!cancelled)
     return UV_EBUSY;
@@ -294,7 +548,8 @@ int uv_queue_work(uv_loop_t* loop,
   req->loop = loop;
   req->work_cb = work_cb;
   req->after_work_cb = after_work_cb;
-  uv__work_submit(loop, &req->work_req, uv__queue_work, uv__queue_done);
+  uv__work_submit(loop, &req->work_req, UV__WORK_CPU, uv__queue_work,
+                  uv__queue_done);
   return 0;
 }
 
@@ -126,6 +126,12 @@ int uv__pthread_sigmask(int how, const sigset_t* set, sigset_t* oset);
 # define UV__POLLRDHUP 0x2000
 #endif
 
+#ifdef POLLPRI
+# define UV__POLLPRI POLLPRI
+#else
+# define UV__POLLPRI 0x0002
+#endif
+
 #if !defined(O_CLOEXEC) && defined(__FreeBSD__)
 /*
  * It may be that we are just missing `__POSIX_VISIBLE >= 200809`.
@@ -153,7 +159,8 @@ enum {
   UV_TCP_SINGLE_ACCEPT    = 0x1000, /* Only accept() when idle. */
   UV_HANDLE_IPV6          = 0x10000, /* Handle is bound to a IPv6 socket. */
   UV_UDP_PROCESSING       = 0x20000, /* Handle is running the send callback queue. */
-  UV_HANDLE_BOUND         = 0x40000  /* Handle is bound to an address and port */
+  UV_HANDLE_BOUND         = 0x40000, /* Handle is bound to an address and port */
+  UV_HANDLE_UDP_RECVMMSG  = 0x80000  /* Handle receives with recvmmsg. */
 };
 
 /* loop flags */
@@ -259,6 +266,12 @@ int uv__platform_loop_init(uv_loop_t* loop);
 void uv__platform_loop_delete(uv_loop_t* loop);
 void uv__platform_invalidate_fd(uv_loop_t* loop, int fd);
 
+#if defined(__linux__)
+/* io_uring */
+int uv__iou_fs_submit(uv_fs_t* req);
+void uv__iou_delete(uv_loop_t* loop);
+#endif /* __linux__ */
+
 /* various */
 void uv__async_close(uv_async_t* handle);
 void uv__check_close(uv_check_t* handle);
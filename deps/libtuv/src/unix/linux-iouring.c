@@ -0,0 +1,407 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* The file system requests of a loop are submitted to an io_uring instead of
+ * the threadpool when the kernel supports it (Linux 5.6 and newer), and their
+ * completions are reaped by a watcher on the ring in uv__io_poll(). Reads,
+ * writes, opens, closes, stats and syncs go through the ring; every other
+ * request, and any of these the ring cannot take, goes to the threadpool.
+ *
+ * The ring is set up with the first request of the loop. Set the environment
+ * variable UV_USE_IO_URING=0 to always use the threadpool.
+ */
+
+#include "uv.h"
+#include "internal.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define UV__IOU_ENTRIES 64
+
+struct uv__iou {
+  uv__io_t watcher;  /* The ring is readable when completions are queued. */
+  uint32_t* sqhead;
+  uint32_t* sqtail;
+  uint32_t sqmask;
+  struct uv__io_uring_sqe* sqe;
+  uint32_t* cqhead;
+  uint32_t* cqtail;
+  uint32_t cqmask;
+  struct uv__io_uring_cqe* cqe;
+  void* ring;
+  size_t ringlen;
+  size_t sqelen;
+  unsigned int fs_types;  /* The uv_fs_type bits the ring can take. */
+  unsigned int in_flight;
+  unsigned int max_in_flight;
+};
+
+/* The loop->iou of a loop the ring is not available to. */
+static char uv__iou_none;
+
+
+static void uv__iou_on_cqes(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+
+
+static int uv__iou_supports(const struct uv__io_uring_probe* probe,
+                            unsigned int op) {
+  return op < probe->ops_len &&
+         (probe->ops[op].flags & UV__IO_URING_OP_SUPPORTED) != 0;
+}
+
+
+static unsigned int uv__iou_fs_types(int ringfd) {
+  struct uv__io_uring_probe probe;
+  unsigned int fs_types;
+
+  memset(&probe, 0, sizeof(probe));
+  if (uv__io_uring_register(ringfd,
+                            UV__IORING_REGISTER_PROBE,
+                            &probe,
+                            ARRAY_SIZE(probe.ops))) {
+    return 0;
+  }
+
+  fs_types = 0;
+  if (uv__iou_supports(&probe, UV__IORING_OP_READV))
+    fs_types |= 1u << UV_FS_READ;
+  if (uv__iou_supports(&probe, UV__IORING_OP_WRITEV))
+    fs_types |= 1u << UV_FS_WRITE;
+  if (uv__iou_supports(&probe, UV__IORING_OP_FSYNC))
+    fs_types |= 1u << UV_FS_FSYNC | 1u << UV_FS_FDATASYNC;
+  if (uv__iou_supports(&probe, UV__IORING_OP_OPENAT))
+    fs_types |= 1u << UV_FS_OPEN;
+  if (uv__iou_supports(&probe, UV__IORING_OP_CLOSE))
+    fs_types |= 1u << UV_FS_CLOSE;
+  if (uv__iou_supports(&probe, UV__IORING_OP_STATX))
+    fs_types |= 1u << UV_FS_STAT | 1u << UV_FS_FSTAT;
+
+  return fs_types;
+}
+
+
+static void* uv__iou_create(uv_loop_t* loop) {
+  struct uv__io_uring_params params;
+  struct uv__iou* iou;
+  const char* val;
+  unsigned int fs_types;
+  size_t sqlen;
+  size_t cqlen;
+  size_t ringlen;
+  size_t sqelen;
+  uint32_t* sqarray;
+  char* ring;
+  void* sqe;
+  uint32_t i;
+  int ringfd;
+
+  val = getenv("UV_USE_IO_URING");
+  if (val != NULL && atoi(val) == 0)
+    return &uv__iou_none;
+
+  memset(&params, 0, sizeof(params));
+  ringfd = uv__io_uring_setup(UV__IOU_ENTRIES, &params);
+  if (ringfd == -1)
+    return &uv__iou_none;
+
+  /* Reads and writes at the file position, and completions which are never
+   * dropped when the completion queue is full, came with 5.6.
+   */
+  if (!(params.features & UV__IORING_FEAT_SINGLE_MMAP) ||
+      !(params.features & UV__IORING_FEAT_NODROP) ||
+      !(params.features & UV__IORING_FEAT_RW_CUR_POS)) {
+    goto fail_fd;
+  }
+
+  fs_types = uv__iou_fs_types(ringfd);
+  if (fs_types == 0)
+    goto fail_fd;
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen = params.cq_off.cqes +
+          params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  ringlen = sqlen > cqlen ? sqlen : cqlen;
+  sqelen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+
+  ring = mmap(NULL, ringlen, PROT_READ | PROT_WRITE, MAP_SHARED, ringfd,
+              UV__IORING_OFF_SQ_RING);
+  if (ring == MAP_FAILED)
+    goto fail_fd;
+
+  sqe = mmap(NULL, sqelen, PROT_READ | PROT_WRITE, MAP_SHARED, ringfd,
+             UV__IORING_OFF_SQES);
+  if (sqe == MAP_FAILED)
+    goto fail_ring;
+
+  iou = uv__malloc(sizeof(*iou));
+  if (iou == NULL)
+    goto fail_sqe;
+
+  iou->sqhead = (uint32_t*) (ring + params.sq_off.head);
+  iou->sqtail = (uint32_t*) (ring + params.sq_off.tail);
+  iou->sqmask = *(uint32_t*) (ring + params.sq_off.ring_mask);
+  iou->sqe = sqe;
+  iou->cqhead = (uint32_t*) (ring + params.cq_off.head);
+  iou->cqtail = (uint32_t*) (ring + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) (ring + params.cq_off.ring_mask);
+  iou->cqe = (struct uv__io_uring_cqe*) (ring + params.cq_off.cqes);
+  iou->ring = ring;
+  iou->ringlen = ringlen;
+  iou->sqelen = sqelen;
+  iou->fs_types = fs_types;
+  iou->in_flight = 0;
+  /* No more requests are in flight than the completion queue holds. */
+  iou->max_in_flight = params.cq_entries;
+
+  /* Each submission queue entry has its own slot of the ring. */
+  sqarray = (uint32_t*) (ring + params.sq_off.array);
+  for (i = 0; i < params.sq_entries; i++)
+    sqarray[i] = i;
+
+  uv__io_init(&iou->watcher, uv__iou_on_cqes, ringfd);
+  uv__io_start(loop, &iou->watcher, POLLIN);
+
+  return iou;
+
+fail_sqe:
+  munmap(sqe, sqelen);
+fail_ring:
+  munmap(ring, ringlen);
+fail_fd:
+  uv__close(ringfd);
+  return &uv__iou_none;
+}
+
+
+void uv__iou_delete(uv_loop_t* loop) {
+  struct uv__iou* iou;
+
+  if (loop->iou == NULL || loop->iou == &uv__iou_none) {
+    loop->iou = NULL;
+    return;
+  }
+
+  iou = loop->iou;
+  assert(iou->in_flight == 0);
+  uv__io_stop(loop, &iou->watcher, POLLIN);
+  uv__close(iou->watcher.fd);
+  munmap(iou->sqe, iou->sqelen);
+  munmap(iou->ring, iou->ringlen);
+  uv__free(iou);
+  loop->iou = NULL;
+}
+
+
+/* The st_dev encoding of glibc and musl. */
+static uint64_t uv__iou_makedev(uint32_t major, uint32_t minor) {
+  return ((uint64_t) (major & 0xfffff000) << 32) |
+         ((uint64_t) (major & 0x00000fff) << 8) |
+         ((uint64_t) (minor & 0xffffff00) << 12) |
+         ((uint64_t) (minor & 0x000000ff));
+}
+
+
+/* The same as uv__to_stat() makes of a struct stat. */
+static void uv__iou_to_stat(const struct uv__statx* src, uv_stat_t* dst) {
+  dst->st_dev = uv__iou_makedev(src->stx_dev_major, src->stx_dev_minor);
+  dst->st_mode = src->stx_mode;
+  dst->st_nlink = src->stx_nlink;
+  dst->st_uid = src->stx_uid;
+  dst->st_gid = src->stx_gid;
+  dst->st_rdev = uv__iou_makedev(src->stx_rdev_major, src->stx_rdev_minor);
+  dst->st_ino = src->stx_ino;
+  dst->st_size = src->stx_size;
+  dst->st_blksize = src->stx_blksize;
+  dst->st_blocks = src->stx_blocks;
+  dst->st_atim.tv_sec = src->stx_atime.tv_sec;
+  dst->st_atim.tv_nsec = src->stx_atime.tv_nsec;
+  dst->st_mtim.tv_sec = src->stx_mtime.tv_sec;
+  dst->st_mtim.tv_nsec = src->stx_mtime.tv_nsec;
+  dst->st_ctim.tv_sec = src->stx_ctime.tv_sec;
+  dst->st_ctim.tv_nsec = src->stx_ctime.tv_nsec;
+  dst->st_birthtim.tv_sec = src->stx_ctime.tv_sec;
+  dst->st_birthtim.tv_nsec = src->stx_ctime.tv_nsec;
+  dst->st_flags = 0;
+  dst->st_gen = 0;
+}
+
+
+int uv__iou_fs_submit(uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__statx* statx;
+  struct uv__iou* iou;
+  uint32_t tail;
+
+  if (req->loop->iou == NULL)
+    req->loop->iou = uv__iou_create(req->loop);
+
+  if (req->loop->iou == &uv__iou_none)
+    return 0;
+
+  iou = req->loop->iou;
+  if (!(iou->fs_types & (1u << req->fs_type)))
+    return 0;
+
+  if (iou->in_flight == iou->max_in_flight)
+    return 0;
+
+  tail = *iou->sqtail;
+  sqe = &iou->sqe[tail & iou->sqmask];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = (uintptr_t) req;
+  statx = NULL;
+
+  switch (req->fs_type) {
+  case UV_FS_READ:
+  case UV_FS_WRITE:
+    if (req->nbufs > (unsigned int) uv__getiovmax())
+      return 0;
+    sqe->opcode = req->fs_type == UV_FS_READ ? UV__IORING_OP_READV
+                                             : UV__IORING_OP_WRITEV;
+    sqe->fd = req->file;
+    sqe->addr = (uintptr_t) req->bufs;
+    sqe->len = req->nbufs;
+    /* An offset of -1 reads or writes at the file position. */
+    sqe->off = req->off < 0 ? (uint64_t) -1 : (uint64_t) req->off;
+    break;
+  case UV_FS_FSYNC:
+  case UV_FS_FDATASYNC:
+    sqe->opcode = UV__IORING_OP_FSYNC;
+    sqe->fd = req->file;
+    if (req->fs_type == UV_FS_FDATASYNC)
+      sqe->op_flags = UV__IORING_FSYNC_DATASYNC;
+    break;
+  case UV_FS_OPEN:
+    sqe->opcode = UV__IORING_OP_OPENAT;
+    sqe->fd = UV__AT_FDCWD;
+    sqe->addr = (uintptr_t) req->path;
+    sqe->len = req->mode;
+    sqe->op_flags = req->flags | UV__O_CLOEXEC;
+    break;
+  case UV_FS_CLOSE:
+    sqe->opcode = UV__IORING_OP_CLOSE;
+    sqe->fd = req->file;
+    break;
+  case UV_FS_STAT:
+  case UV_FS_FSTAT:
+    statx = uv__malloc(sizeof(*statx));
+    if (statx == NULL)
+      return 0;
+    sqe->opcode = UV__IORING_OP_STATX;
+    if (req->fs_type == UV_FS_STAT) {
+      sqe->fd = UV__AT_FDCWD;
+      sqe->addr = (uintptr_t) req->path;
+    } else {
+      sqe->fd = req->file;
+      sqe->addr = (uintptr_t) "";
+      sqe->op_flags = UV__AT_EMPTY_PATH;
+    }
+    sqe->len = UV__STATX_BASIC_STATS;
+    sqe->off = (uintptr_t) statx;
+    break;
+  default:
+    return 0;
+  }
+
+  __atomic_store_n(iou->sqtail, tail + 1, __ATOMIC_RELEASE);
+
+  if (uv__io_uring_enter(iou->watcher.fd, 1, 0, 0) != 1) {
+    /* The kernel has not taken the entry, so the threadpool is given the
+     * request instead.
+     */
+    __atomic_store_n(iou->sqtail, tail, __ATOMIC_RELEASE);
+    uv__free(statx);
+    return 0;
+  }
+
+  req->ptr = statx;
+  iou->in_flight++;
+
+  /* uv_cancel() finds the request running, as it is not queued. */
+  req->work_req.loop = req->loop;
+  req->work_req.work = NULL;
+  req->work_req.done = NULL;
+  req->work_req.queue = 0;
+  QUEUE_INIT(&req->work_req.wq);
+
+  return 1;
+}
+
+
+static void uv__iou_fs_done(uv_fs_t* req, int32_t res) {
+  struct uv__statx* statx;
+
+  uv__req_unregister(req->loop, req);
+
+  switch (req->fs_type) {
+  case UV_FS_READ:
+  case UV_FS_WRITE:
+    if (req->bufs != req->bufsml)
+      uv__free(req->bufs);
+    req->bufs = NULL;
+    req->nbufs = 0;
+    break;
+  case UV_FS_STAT:
+  case UV_FS_FSTAT:
+    statx = req->ptr;
+    req->ptr = NULL;
+    if (res == 0) {
+      uv__iou_to_stat(statx, &req->statbuf);
+      req->ptr = &req->statbuf;
+    }
+    uv__free(statx);
+    break;
+  default:
+    break;
+  }
+
+  req->result = res;
+  req->cb(req);
+}
+
+
+static void uv__iou_on_cqes(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
+  struct uv__io_uring_cqe* cqe;
+  struct uv__iou* iou;
+  uv_fs_t* req;
+  uint32_t head;
+  int32_t res;
+
+  iou = container_of(w, struct uv__iou, watcher);
+
+  for (;;) {
+    head = *iou->cqhead;
+    if (head == __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE))
+      break;
+
+    cqe = &iou->cqe[head & iou->cqmask];
+    req = (uv_fs_t*) (uintptr_t) cqe->user_data;
+    res = cqe->res;
+
+    /* The entry is given back before the callback submits more. */
+    __atomic_store_n(iou->cqhead, head + 1, __ATOMIC_RELEASE);
+    iou->in_flight--;
+
+    uv__iou_fs_done(req, res);
+  }
+}
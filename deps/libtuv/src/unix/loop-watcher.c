@@ -78,4 +78,5 @@
     uv_##name##_stop(handle);                                                 \
   }
 
+UV_LOOP_WATCHER_DEFINE(prepare, PREPARE)
 UV_LOOP_WATCHER_DEFINE(idle, IDLE)
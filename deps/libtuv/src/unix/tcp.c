@@ -107,6 +107,19 @@ int uv__tcp_bind(uv_tcp_t* tcp,
   if (setsockopt(tcp->io_watcher.fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)))
     return -errno;
 
+  if (flags & UV_TCP_REUSEPORT) {
+#if defined(SO_REUSEPORT) && !defined(__TIZENRT__)
+    if (setsockopt(tcp->io_watcher.fd,
+                   SOL_SOCKET,
+                   SO_REUSEPORT,
+                   &on,
+                   sizeof(on)))
+      return -errno;
+#else
+    return -ENOTSUP;
+#endif
+  }
+
 #ifdef IPV6_V6ONLY
   if (addr->sa_family == AF_INET6) {
     on = (flags & UV_TCP_IPV6ONLY) != 0;
@@ -72,6 +72,7 @@ int uv_timer_init(uv_loop_t* loop, uv_timer_t* handle) {
   uv__handle_init(loop, (uv_handle_t*)handle, UV_TIMER);
   handle->timer_cb = NULL;
   handle->repeat = 0;
+  handle->slack = 0;
   return 0;
 }
 
@@ -164,9 +165,69 @@ uint64_t uv_timer_get_repeat(const uv_timer_t* handle) {
 }
 
 
+/* A timer with slack may run up to `slack` milliseconds after its timeout,
+ * so that the timers expiring close to each other run in one wakeup.
+ */
+void uv_timer_set_slack(uv_timer_t* handle, uint64_t slack) {
+  handle->slack = slack;
+}
+
+
+uint64_t uv_timer_get_slack(const uv_timer_t* handle) {
+  return handle->slack;
+}
+
+
+static uint64_t uv__timer_deadline(const uv_timer_t* handle) {
+  uint64_t deadline;
+
+  deadline = handle->timeout + handle->slack;
+  if (deadline < handle->timeout)
+    deadline = (uint64_t) -1;
+
+  return deadline;
+}
+
+
+/* The earliest deadline of the timers under `heap_node`, or `best` if it is
+ * earlier. The timers are ordered by timeout, so the ones whose timeout is
+ * not before `best` are skipped with all the timers after them.
+ */
+static uint64_t uv__timers_deadline(const struct heap_node* heap_node,
+                                    uint64_t best) {
+  const uv_timer_t* handle;
+  uint64_t deadline;
+
+#ifdef TUV_ENABLE_MEMORY_CONSTRAINTS
+  for (; heap_node != NULL; heap_node = heap_node->next) {
+    handle = container_of(heap_node, uv_timer_t, heap_node);
+    if (handle->timeout >= best)
+      break;
+    deadline = uv__timer_deadline(handle);
+    if (deadline < best)
+      best = deadline;
+  }
+#else /* original libuv code */
+  while (heap_node != NULL) {
+    handle = container_of(heap_node, uv_timer_t, heap_node);
+    if (handle->timeout >= best)
+      break;
+    deadline = uv__timer_deadline(handle);
+    if (deadline < best)
+      best = deadline;
+    best = uv__timers_deadline(heap_node->left, best);
+    heap_node = heap_node->right;
+  }
+#endif
+
+  return best;
+}
+
+
 int uv__next_timeout(const uv_loop_t* loop) {
   const struct heap_node* heap_node;
   const uv_timer_t* handle;
+  uint64_t deadline;
   uint64_t diff;
 
   heap_node = heap_min((const struct heap*) &loop->timer_heap);
@@ -177,7 +238,12 @@ int uv__next_timeout(const uv_loop_t* loop) {
   if (handle->timeout <= loop->time)
     return 0;
 
-  diff = handle->timeout - loop->time;
+  /* Without slack, this is the timeout of the first timer. */
+  deadline = handle->timeout;
+  if (handle->slack != 0)
+    deadline = uv__timers_deadline(heap_node, (uint64_t) -1);
+
+  diff = deadline - loop->time;
   if (diff > INT_MAX)
     diff = INT_MAX;
 
@@ -44,24 +44,34 @@
 // loop
 int uv__platform_loop_init(uv_loop_t* loop) {
   loop->npollfds = 0;
+  loop->pollfd_slots = NULL;
+  loop->npollfd_slots = 0;
+  loop->pollfds_stale = 0;
   return 0;
 }
 
 void uv__platform_loop_delete(uv_loop_t* loop) {
   loop->npollfds = 0;
+  uv__free(loop->pollfd_slots);
+  loop->pollfd_slots = NULL;
+  loop->npollfd_slots = 0;
 }
 
 
 //-----------------------------------------------------------------------------
 
+static void uv__drop_pollfd(uv_loop_t* loop, struct pollfd* pe);
+
 void uv__platform_invalidate_fd(uv_loop_t* loop, int fd) {
-  int i;
-  int nfd = loop->npollfds;
-  for (i = 0; i < nfd; ++i) {
-    struct pollfd* pfd = &loop->pollfds[i];
-    if (fd == pfd->fd) {
-      pfd->fd = -1;
-    }
+  int16_t slot;
+
+  if (fd < 0 || (unsigned int)fd >= loop->npollfd_slots) {
+    return;
+  }
+
+  slot = loop->pollfd_slots[fd];
+  if (slot >= 0) {
+    uv__drop_pollfd(loop, &loop->pollfds[slot]);
   }
 }
 
@@ -82,59 +92,98 @@ uint64_t uv__hrtime(uv_clocktype_t type) {
 }
 
 // From nuttx_io.c
-static void uv__add_pollfd(uv_loop_t* loop, struct pollfd* pe) {
-  int i;
-  bool exist = false;
-  int free_idx = -1;
-  for (i = 0; i < loop->npollfds; ++i) {
-    struct pollfd* cur = &loop->pollfds[i];
-    if (cur->fd == pe->fd) {
-      cur->events = pe->events;
-      exist = true;
-      break;
-    }
-    if (cur->fd == -1) {
-      free_idx = i;
-    }
+// The pollfds of the loop persist across iterations. loop->pollfd_slots maps
+// each fd to its entry, so a watcher is added or changed without a search.
+// Entries of stopped or closed watchers get an fd of -1, as this may happen
+// while the entries are dispatched, and are squeezed out before the next poll.
+static void uv__grow_pollfd_slots(uv_loop_t* loop, unsigned int len) {
+  int16_t* slots;
+  unsigned int i;
+
+  len = (len + 7) & ~7u;
+  slots = uv__realloc(loop->pollfd_slots, len * sizeof(*slots));
+  if (slots == NULL) {
+    TDLOG("uv__grow_pollfd_slots abort, because of out of memory");
+    ABORT();
   }
-  if (!exist) {
-    if (free_idx == -1) {
-      free_idx = loop->npollfds++;
-      if (free_idx >= TUV_POLL_EVENTS_SIZE)
-      {
-        TDLOG("uv__add_pollfd abort, because loop->npollfds (%d) reached maximum size", free_idx);
-        ABORT();
-      }
-    }
-    struct pollfd* cur = &loop->pollfds[free_idx];
 
-    cur->fd = pe->fd;
-    cur->events = pe->events;
-    cur->revents = 0;
-    cur->sem = 0;
-    cur->priv = 0;
+  for (i = loop->npollfd_slots; i < len; ++i) {
+    slots[i] = -1;
   }
+  loop->pollfd_slots = slots;
+  loop->npollfd_slots = len;
 }
 
 
-static void uv__rem_pollfd(uv_loop_t* loop, struct pollfd* pe) {
-  int i = 0;
-  while (i < loop->npollfds) {
-    struct pollfd* cur = &loop->pollfds[i];
-    if (cur->fd == pe->fd) {
-      *cur = loop->pollfds[--loop->npollfds];
-    } else {
-      ++i;
+static void uv__set_pollfd(uv_loop_t* loop, int fd, unsigned int events) {
+  struct pollfd* cur;
+  int16_t* slot;
+
+  if ((unsigned int)fd >= loop->npollfd_slots) {
+    uv__grow_pollfd_slots(loop, (unsigned int)fd + 1);
+  }
+
+  slot = &loop->pollfd_slots[fd];
+  if (*slot >= 0) {
+    loop->pollfds[*slot].events = events;
+    return;
+  }
+
+  if (loop->npollfds >= TUV_POLL_EVENTS_SIZE) {
+    TDLOG("uv__set_pollfd abort, because loop->npollfds (%d) reached maximum size", loop->npollfds);
+    ABORT();
+  }
+
+  *slot = (int16_t)loop->npollfds;
+  cur = &loop->pollfds[loop->npollfds++];
+  cur->fd = fd;
+  cur->events = events;
+  cur->revents = 0;
+  cur->sem = 0;
+  cur->priv = 0;
+}
+
+
+static void uv__drop_pollfd(uv_loop_t* loop, struct pollfd* pe) {
+  if (pe->fd >= 0 && (unsigned int)pe->fd < loop->npollfd_slots) {
+    loop->pollfd_slots[pe->fd] = -1;
+  }
+  pe->fd = -1;
+  pe->revents = 0;
+  loop->pollfds_stale = 1;
+}
+
+
+static void uv__compact_pollfds(uv_loop_t* loop) {
+  int i;
+  int n;
+
+  if (!loop->pollfds_stale) {
+    return;
+  }
+
+  n = 0;
+  for (i = 0; i < loop->npollfds; ++i) {
+    if (loop->pollfds[i].fd < 0) {
+      continue;
+    }
+    if (n != i) {
+      loop->pollfds[n] = loop->pollfds[i];
+      loop->pollfd_slots[loop->pollfds[n].fd] = (int16_t)n;
     }
+    ++n;
   }
+
+  loop->npollfds = n;
+  loop->pollfds_stale = 0;
 }
 
 
 void uv__io_poll(uv_loop_t* loop, int timeout) {
-  struct pollfd pfd;
   struct pollfd* pe;
   QUEUE* q;
   uv__io_t* w;
+  uint64_t poll_start;
   uint64_t base;
   uint64_t diff;
   int nevents;
@@ -147,6 +196,9 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     return;
   }
 
+  uv__compact_pollfds(loop);
+
+  // Only the watchers which have changed since the last poll are queued.
   while (!QUEUE_EMPTY(&loop->watcher_queue)) {
     q = QUEUE_HEAD(&loop->watcher_queue);
     QUEUE_REMOVE(q);
@@ -157,9 +209,7 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     assert(w->fd >= 0);
     assert(w->fd < (int)loop->nwatchers);
 
-    pfd.fd = w->fd;
-    pfd.events = w->pevents;
-    uv__add_pollfd(loop, &pfd);
+    uv__set_pollfd(loop, w->fd, w->pevents);
 
     w->events = w->pevents;
   }
@@ -169,9 +219,11 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
   count = 5;
 
   for (;;) {
+    poll_start = uv__hrtime(UV_CLOCK_FAST);
     nfd = poll(loop->pollfds, loop->npollfds, timeout);
 
     SAVE_ERRNO(uv__update_time(loop));
+    loop->idle_time += uv__hrtime(UV_CLOCK_FAST) - poll_start;
 
     if (nfd == 0) {
       assert(timeout != -1);
@@ -186,6 +238,7 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
       else if (err != EINTR) {
         // poll of which the watchers is null should be removed
         TDLOG("uv__io_poll abort for errno(%d)", err);
+        nfd = loop->npollfds;
         goto handle_poll;
       }
       if (timeout == -1) {
@@ -200,17 +253,29 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
 handle_poll:
     nevents = 0;
 
-    for (i = 0; i < loop->npollfds; ++i) {
+    // poll() returns how many entries have events, so the dispatch stops once
+    // they are all found.
+    for (i = 0; i < loop->npollfds && nfd > 0; ++i) {
       pe = &loop->pollfds[i];
-      w = loop->watchers[pe->fd];
+      if (pe->fd < 0) {
+        continue;
+      }
 
+      w = loop->watchers[pe->fd];
       if (w == NULL) {
-        uv__rem_pollfd(loop, pe);
-        --i;
+        if (pe->revents != 0) {
+          --nfd;
+        }
+        uv__drop_pollfd(loop, pe);
+        continue;
+      }
+
+      if (pe->revents == 0) {
         continue;
       }
+      --nfd;
 
-      if (pe->fd >= 0 && (pe->revents & (POLLIN | POLLOUT | POLLHUP))) {    
+      if (pe->revents & (POLLIN | POLLOUT | POLLHUP)) {
         w->cb(loop, w, pe->revents);
         ++nevents;
       }
@@ -219,6 +284,7 @@ handle_poll:
     if (nevents != 0) {
       if (--count != 0) {
         timeout = 0;
+        uv__compact_pollfds(loop);
         continue;
       }
       return;
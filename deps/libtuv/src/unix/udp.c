@@ -79,6 +79,13 @@
 #define IPV6_MULTICAST_LOOP 19
 #endif
 
+#if defined(__linux__) && !defined(__NUTTX__) && !defined(__TIZENRT__)
+# define UV__HAVE_MMSG 1
+# define UV__MMSG_MAXWIDTH 20
+#endif
+
+#define UV__UDP_DGRAM_MAXSIZE (64 * 1024)
+
 static void uv__udp_run_completed(uv_udp_t* handle);
 static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents);
 static void uv__udp_recvmsg(uv_udp_t* handle);
@@ -187,6 +194,71 @@ static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents) {
 }
 
 
+#if defined(UV__HAVE_MMSG)
+static int uv__udp_recvmmsg(uv_udp_t* handle, uv_buf_t* buf) {
+  struct sockaddr_in6 peers[UV__MMSG_MAXWIDTH];
+  struct iovec iov[UV__MMSG_MAXWIDTH];
+  struct uv__mmsghdr msgs[UV__MMSG_MAXWIDTH];
+  ssize_t nread;
+  uv_buf_t chunk_buf;
+  size_t chunks;
+  int flags;
+  size_t k;
+
+  /* prepare structures for recvmmsg */
+  chunks = buf->len / UV__UDP_DGRAM_MAXSIZE;
+  if (chunks > ARRAY_SIZE(iov))
+    chunks = ARRAY_SIZE(iov);
+  for (k = 0; k < chunks; ++k) {
+    iov[k].iov_base = buf->base + k * UV__UDP_DGRAM_MAXSIZE;
+    iov[k].iov_len = UV__UDP_DGRAM_MAXSIZE;
+    memset(&msgs[k].msg_hdr, 0, sizeof(msgs[k].msg_hdr));
+    msgs[k].msg_hdr.msg_iov = iov + k;
+    msgs[k].msg_hdr.msg_iovlen = 1;
+    msgs[k].msg_hdr.msg_name = peers + k;
+    msgs[k].msg_hdr.msg_namelen = sizeof(peers[0]);
+  }
+
+  do
+    nread = uv__recvmmsg(handle->io_watcher.fd, msgs, chunks, 0, NULL);
+  while (nread == -1 && errno == EINTR);
+
+  /* the kernel has no recvmmsg; the caller reads the message with recvmsg */
+  if (nread == -1 && errno == ENOSYS) {
+    handle->flags &= ~UV_HANDLE_UDP_RECVMMSG;
+    return -ENOSYS;
+  }
+
+  if (nread < 1) {
+    if (nread == 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+      handle->recv_cb(handle, 0, buf, NULL, 0);
+    else
+      handle->recv_cb(handle, -errno, buf, NULL, 0);
+  } else {
+    /* pass each chunk to the application */
+    for (k = 0; k < (size_t) nread && handle->recv_cb != NULL; k++) {
+      flags = UV_UDP_MMSG_CHUNK;
+      if (msgs[k].msg_hdr.msg_flags & MSG_TRUNC)
+        flags |= UV_UDP_PARTIAL;
+
+      chunk_buf = uv_buf_init(iov[k].iov_base, iov[k].iov_len);
+      handle->recv_cb(handle,
+                      msgs[k].msg_len,
+                      &chunk_buf,
+                      msgs[k].msg_hdr.msg_namelen == 0 ?
+                          NULL : msgs[k].msg_hdr.msg_name,
+                      flags);
+    }
+
+    /* one last callback so the original buffer is freed */
+    if (handle->recv_cb != NULL)
+      handle->recv_cb(handle, 0, buf, NULL, UV_UDP_MMSG_FREE);
+  }
+  return nread;
+}
+#endif
+
+
 static void uv__udp_recvmsg(uv_udp_t* handle) {
   struct sockaddr_storage peer;
 #if !defined(__NUTTX__) && !defined(__TIZENRT__)
@@ -214,13 +286,28 @@ static void uv__udp_recvmsg(uv_udp_t* handle) {
 
   do {
     buf = uv_buf_init(NULL, 0);
-    handle->alloc_cb((uv_handle_t*) handle, 64 * 1024, &buf);
+    handle->alloc_cb((uv_handle_t*) handle, UV__UDP_DGRAM_MAXSIZE, &buf);
     if (buf.base == NULL || buf.len == 0) {
       handle->recv_cb(handle, UV_ENOBUFS, &buf, NULL, 0);
       return;
     }
     assert(buf.base != NULL);
 
+#if defined(UV__HAVE_MMSG)
+    /* a buffer of several chunks is read with one recvmmsg */
+    if (uv_udp_using_recvmmsg(handle) &&
+        buf.len >= 2 * UV__UDP_DGRAM_MAXSIZE) {
+      nread = uv__udp_recvmmsg(handle, &buf);
+      if (nread != -ENOSYS) {
+        if (nread > 0)
+          count -= nread;
+        else
+          nread = -1;
+        continue;
+      }
+    }
+#endif
+
 #if !defined(__NUTTX__) && !defined(__TIZENRT__)
     h.msg_namelen = sizeof(peer);
     h.msg_iov = (void*) &buf;
@@ -669,7 +756,7 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   if (domain != AF_INET && domain != AF_INET6 && domain != AF_UNSPEC)
     return -EINVAL;
 
-  if (flags & ~0xFF)
+  if (flags & ~(0xFF | UV_UDP_RECVMMSG))
     return -EINVAL;
 
   if (domain != AF_UNSPEC) {
@@ -689,10 +776,20 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   uv__io_init(&handle->io_watcher, uv__udp_io, fd);
   QUEUE_INIT(&handle->write_queue);
   QUEUE_INIT(&handle->write_completed_queue);
+
+#if defined(UV__HAVE_MMSG)
+  if (flags & UV_UDP_RECVMMSG)
+    handle->flags |= UV_HANDLE_UDP_RECVMMSG;
+#endif
   return 0;
 }
 
 
+int uv_udp_using_recvmmsg(const uv_udp_t* handle) {
+  return (handle->flags & UV_HANDLE_UDP_RECVMMSG) != 0;
+}
+
+
 int uv_udp_init(uv_loop_t* loop, uv_udp_t* handle) {
   return uv_udp_init_ex(loop, handle, AF_UNSPEC);
 }
@@ -52,8 +52,6 @@
 # include <net/if.h> /* if_nametoindex */
 #endif
 
-#include "hashtable.h"
-
 // jmem-config
 // #define ENABLE_UV_HEAP_SIZE_TRACKING
 
@@ -71,7 +69,36 @@ static uv__allocator_t uv__allocator = {
   free,
 };
 
-#if defined(__APPLE__)
+#if defined(ENABLE_UV_HEAP_SIZE_TRACKING)
+/* Every allocation is prefixed with its requested size, so the size is known
+ * when it is freed. The union keeps the memory after the header aligned.
+ */
+typedef union {
+  size_t size;
+  void* align_ptr;
+  double align_double;
+  long double align_long_double;
+  long long align_long_long;
+} uv__heap_header_t;
+
+#define UV__HEAP_HEADER_SIZE sizeof(uv__heap_header_t)
+
+/* The counter is also updated by the threadpool workers. */
+#if defined(__GNUC__)
+# define UV__HEAP_SIZE_ADD(size) __sync_fetch_and_add(&g_heap_size, (size))
+# define UV__HEAP_SIZE_SUB(size) __sync_fetch_and_sub(&g_heap_size, (size))
+#else
+# define UV__HEAP_SIZE_ADD(size) (g_heap_size += (size))
+# define UV__HEAP_SIZE_SUB(size) (g_heap_size -= (size))
+#endif
+#endif
+
+static size_t g_heap_size;
+
+size_t* uv_get_heap_size_ptr(void) {
+  return &g_heap_size;
+}
+
 char* uv__strdup(const char* s) {
   size_t len = strlen(s) + 1;
   char* m = uv__malloc(len);
@@ -79,96 +106,94 @@ char* uv__strdup(const char* s) {
     return NULL;
   return memcpy(m, s, len);
 }
-#endif
 
-// Hash table to store heap objects: key=<void* ptr> value=<size_t size>
-static HashTable g_heap_objects_ht;
-static size_t g_heap_size;
+#if defined(ENABLE_UV_HEAP_SIZE_TRACKING)
+static void* uv__heap_track(uv__heap_header_t* header, size_t size) {
+  if (header == NULL)
+    return NULL;
 
-size_t* uv_get_heap_size_ptr(void) {
-  return &g_heap_size;
+  header->size = size;
+  UV__HEAP_SIZE_ADD(size);
+  return header + 1;
 }
+#endif
 
 void* uv__malloc(size_t size) {
-  void* result = uv__allocator.local_malloc(size);
-
 #if defined(ENABLE_UV_HEAP_SIZE_TRACKING)
   // size-profiler
-  ht_insert(&g_heap_objects_ht, (void *)&result, (void *)&size);
-  g_heap_size += size;
+  if (size > SIZE_MAX - UV__HEAP_HEADER_SIZE)
+    return NULL;
+
+  return uv__heap_track(uv__allocator.local_malloc(size + UV__HEAP_HEADER_SIZE),
+                        size);
+#else
+  return uv__allocator.local_malloc(size);
 #endif
-  return result;
 }
 
 void uv__free(void* ptr) {
   int saved_errno;
 
+#if defined(ENABLE_UV_HEAP_SIZE_TRACKING)
+  // size-profiler
+  if (ptr != NULL) {
+    uv__heap_header_t* header = (uv__heap_header_t*)ptr - 1;
+    UV__HEAP_SIZE_SUB(header->size);
+    ptr = header;
+  }
+#endif
+
   /* Libuv expects that free() does not clobber errno.  The system allocator
    * honors that assumption but custom allocators may not be so careful.
    */
   saved_errno = errno;
   uv__allocator.local_free(ptr);
   errno = saved_errno;
-
-#if defined(ENABLE_UV_HEAP_SIZE_TRACKING)
-  // size-profiler
-  if (ht_contains(&g_heap_objects_ht, &ptr)) {
-    size_t size = *(size_t *)ht_lookup(&g_heap_objects_ht, (void *)&ptr);
-    ht_erase(&g_heap_objects_ht, (void *)&ptr);
-    g_heap_size -= size;
-  } else {
-    // printf("free error: %x\n", free_error_count++);
-  }
-#endif
 }
 
 void* uv__calloc(size_t count, size_t size) {
-  void* result = uv__allocator.local_calloc(count, size);
-
 #if defined(ENABLE_UV_HEAP_SIZE_TRACKING)
   // size-profiler
-  size_t new_size = count * size;
-  ht_insert(&g_heap_objects_ht, (void *)&result, (void *)&new_size);
-  g_heap_size += new_size;
-#endif
+  if (size != 0 && count > (SIZE_MAX - UV__HEAP_HEADER_SIZE) / size)
+    return NULL;
 
-  return result;
+  return uv__heap_track(uv__allocator.local_calloc(1, count * size +
+                                                   UV__HEAP_HEADER_SIZE),
+                        count * size);
+#else
+  return uv__allocator.local_calloc(count, size);
+#endif
 }
 
 void* uv__realloc(void* ptr, size_t size) {
-  void* result = uv__allocator.local_realloc(ptr, size);
-
 #if defined(ENABLE_UV_HEAP_SIZE_TRACKING)
-  size_t new_size = size;
-  if(ptr == NULL) {
-    // Equivalent to malloc
-    ht_insert(&g_heap_objects_ht, (void *)&result, (void *)&new_size);
-    g_heap_size += new_size;
-  } else if(new_size == 0 && ptr != NULL) {
-    // Equivalent to free
-    if (ht_contains(&g_heap_objects_ht, &ptr)) {
-      size_t old_size = *(size_t *)ht_lookup(&g_heap_objects_ht, (void *)&ptr);
-      ht_erase(&g_heap_objects_ht, (void *)&ptr);
-      g_heap_size -= old_size;
-    } else {
-      //printf("realloc error 1: %d\n", realloc_error_count++);
-    }
-  } else {
-    // Equivalent to realloc
-    if (ht_contains(&g_heap_objects_ht, &ptr)) {
-      size_t old_size = *(size_t *)ht_lookup(&g_heap_objects_ht, (void *)&ptr);
-      ht_erase(&g_heap_objects_ht, (void *)&ptr);
-      g_heap_size -= old_size;
-
-      ht_insert(&g_heap_objects_ht, (void *)&result, (void *)&new_size);
-      g_heap_size += new_size;
-    } else {
-      //printf("realloc error 2: %d\n", realloc_error_count++);
-    }
+  // size-profiler
+  uv__heap_header_t* header;
+  size_t old_size;
+
+  if (ptr == NULL)
+    return uv__malloc(size);
+
+  if (size == 0) {
+    uv__free(ptr);
+    return NULL;
   }
-#endif
 
-  return result;
+  if (size > SIZE_MAX - UV__HEAP_HEADER_SIZE)
+    return NULL;
+
+  header = (uv__heap_header_t*)ptr - 1;
+  old_size = header->size;
+  header = uv__allocator.local_realloc(header, size + UV__HEAP_HEADER_SIZE);
+
+  if (header == NULL)
+    return NULL;
+
+  UV__HEAP_SIZE_SUB(old_size);
+  return uv__heap_track(header, size);
+#else
+  return uv__allocator.local_realloc(ptr, size);
+#endif
 }
 
 uv_buf_t uv_buf_init(char* base, unsigned int len) {
@@ -401,11 +426,26 @@ void uv_unref(uv_handle_t* handle) {
 }
 
 
+int uv_recv_buffer_size(uv_handle_t* handle, int* value) {
+  return uv__socket_sockopt(handle, SO_RCVBUF, value);
+}
+
+
+int uv_send_buffer_size(uv_handle_t* handle, int* value) {
+  return uv__socket_sockopt(handle, SO_SNDBUF, value);
+}
+
+
 uint64_t uv_now(const uv_loop_t* loop) {
   return loop->time;
 }
 
 
+uint64_t uv_metrics_idle_time(const uv_loop_t* loop) {
+  return loop->idle_time;
+}
+
+
 
 size_t uv__count_bufs(const uv_buf_t bufs[], unsigned int nbufs) {
   unsigned int i;
@@ -518,12 +558,6 @@ static uv_loop_t* default_loop_ptr;
 
 
 uv_loop_t* uv_default_loop(void) {
-  // size-profiler
-#if defined(ENABLE_UV_HEAP_SIZE_TRACKING)
-  ht_setup(&g_heap_objects_ht, sizeof(void *), sizeof(size_t), 10);
-  ht_reserve(&g_heap_objects_ht, 100);
-#endif
-  
   if (default_loop_ptr != NULL)
     return default_loop_ptr;
 
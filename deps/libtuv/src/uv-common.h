@@ -68,6 +68,16 @@ extern int snprintf(char*, size_t, const char*, ...);
 #define STATIC_ASSERT(expr)                                                   \
   void uv__static_assert(int static_assert_failed[1 - 2 * !(expr)])
 
+/* Static tracepoints of the "uv" provider. They are nops until a tracer
+ * enables them, and compile away without ENABLE_PROBES or off Linux.
+ */
+#if defined(ENABLE_PROBES) && defined(__linux__)
+# include <sys/sdt.h>
+# define UV__PROBE1(name, a1) DTRACE_PROBE1(uv, name, a1)
+#else
+# define UV__PROBE1(name, a1)
+#endif
+
 #ifndef _WIN32
 enum {
   UV__HANDLE_INTERNAL = 0x8000,
@@ -125,8 +135,17 @@ void uv__fs_poll_close(uv_fs_poll_t* handle);
 
 int uv__getaddrinfo_translate_error(int sys_err);    /* EAI_* error. */
 
+/* Kinds of threadpool work, in the order threads take them. */
+enum uv__work_kind {
+  UV__WORK_CPU,      /* uv_queue_work(), such as peripheral I/O */
+  UV__WORK_FAST_IO,  /* file system operations */
+  UV__WORK_SLOW_IO,  /* DNS lookups, limited to half of the threads */
+  UV__WORK_KINDS
+};
+
 void uv__work_submit(uv_loop_t* loop,
                      struct uv__work *w,
+                     enum uv__work_kind kind,
                      void (*work)(struct uv__work *w),
                      void (*done)(struct uv__work *w, int status));
 
@@ -239,9 +258,7 @@ void uv__fs_scandir_cleanup(uv_fs_t* req);
 
 /* Allocator prototypes */
 void *uv__calloc(size_t count, size_t size);
-#if defined(__APPLE__)
 char *uv__strdup(const char* s);
-#endif
 void* uv__malloc(size_t size);
 void uv__free(void* ptr);
 void* uv__realloc(void* ptr, size_t size);
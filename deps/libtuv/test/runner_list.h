@@ -38,6 +38,7 @@
 #if !defined(__TUV_RAW__)
 #define TEST_LIST_ALL(TE)                                                     \
   TE(idle_basic, 5000)                                                        \
+  TE(prepare_basic, 5000)                                                     \
   TE(active, 5000)                                                            \
   TE(timer_init, 5000)                                                        \
   TE(timer, 5000)                                                             \
@@ -48,6 +49,7 @@
   TE(timer_again, 5000)                                                       \
   TE(timer_huge_timeout, 5000)                                                \
   TE(timer_huge_repeat, 5000)                                                 \
+  TE(timer_slack, 5000)                                                       \
   \
   TE(async, 5000)                                                             \
   TE(condvar_2, 5000)                                                         \
@@ -108,8 +110,10 @@
   \
   TE(fs_file_nametoolong, 5000)                                               \
   TE(fs_fstat, 5000)                                                          \
+  TE(fs_async_write_many, 5000)                                               \
   TE(fs_utime, 5000)                                                          \
   TE(fs_futime, 5000)                                                         \
+  TE(fs_async_sendfile, 5000)                                                 \
   \
   TE(getaddrinfo_basic, 5000)                                                 \
   TE(getaddrinfo_basic_sync, 5000)                                            \
@@ -1006,6 +1006,102 @@ TEST_IMPL(fs_fstat) {
 
   return 0;
 }
+
+
+/* More writes than the io_uring of the loop takes at once, so that some go
+ * to the threadpool, and the results of the ring read back.
+ */
+#define WRITE_MANY_COUNT 300
+
+static uv_fs_t write_many_reqs[WRITE_MANY_COUNT];
+static char write_many_buf[WRITE_MANY_COUNT];
+static char write_many_read_buf[WRITE_MANY_COUNT];
+static int write_many_cb_count;
+static uv_file write_many_file;
+
+static void write_many_cb(uv_fs_t* req) {
+  TUV_ASSERT(req->fs_type == UV_FS_WRITE);
+  TUV_ASSERT(req->result == 1);
+  write_many_cb_count++;
+  uv_fs_req_cleanup(req);
+}
+
+static void write_many_fstat_cb(uv_fs_t* req) {
+  uv_stat_t* s = (uv_stat_t*)req->ptr;
+  struct stat t;
+
+  TUV_ASSERT(req->fs_type == UV_FS_FSTAT);
+  TUV_ASSERT(req->result == 0);
+  TUV_ASSERT(fstat(write_many_file, &t) == 0);
+  TUV_ASSERT(s->st_size == WRITE_MANY_COUNT);
+  TUV_ASSERT(s->st_dev == (uint64_t) t.st_dev);
+  TUV_ASSERT(s->st_ino == (uint64_t) t.st_ino);
+  TUV_ASSERT(s->st_mode == (uint64_t) t.st_mode);
+  TUV_ASSERT(s->st_nlink == (uint64_t) t.st_nlink);
+  TUV_ASSERT(s->st_blocks == (uint64_t) t.st_blocks);
+  TUV_ASSERT(s->st_mtim.tv_sec == t.st_mtim.tv_sec);
+  TUV_ASSERT(s->st_mtim.tv_nsec == t.st_mtim.tv_nsec);
+  fstat_cb_count++;
+  uv_fs_req_cleanup(req);
+}
+
+static void write_many_read_cb(uv_fs_t* req) {
+  TUV_ASSERT(req->fs_type == UV_FS_READ);
+  TUV_ASSERT(req->result == WRITE_MANY_COUNT);
+  TUV_ASSERT(memcmp(write_many_read_buf, write_many_buf,
+                    WRITE_MANY_COUNT) == 0);
+  read_cb_count++;
+  uv_fs_req_cleanup(req);
+}
+
+TEST_IMPL(fs_async_write_many) {
+  uv_fs_t req;
+  int i;
+  int r;
+
+  /* Setup. */
+  unlink(filename1);
+  loop = uv_default_loop();
+  write_many_cb_count = 0;
+  fstat_cb_count = 0;
+  read_cb_count = 0;
+
+  r = uv_fs_open(loop, &req, filename1, O_RDWR | O_CREAT,
+                 S_IWUSR | S_IRUSR, NULL);
+  TUV_ASSERT(r >= 0);
+  write_many_file = req.result;
+  uv_fs_req_cleanup(&req);
+
+  for (i = 0; i < WRITE_MANY_COUNT; i++) {
+    write_many_buf[i] = (char) ('a' + i % 26);
+    iov = uv_buf_init(write_many_buf + i, 1);
+    r = uv_fs_write(loop, &write_many_reqs[i], write_many_file, &iov, 1, i,
+                    write_many_cb);
+    TUV_ASSERT(r == 0);
+  }
+  uv_run(loop, UV_RUN_DEFAULT);
+  TUV_ASSERT(write_many_cb_count == WRITE_MANY_COUNT);
+
+  r = uv_fs_fstat(loop, &req, write_many_file, write_many_fstat_cb);
+  TUV_ASSERT(r == 0);
+  uv_run(loop, UV_RUN_DEFAULT);
+  TUV_ASSERT(fstat_cb_count == 1);
+
+  iov = uv_buf_init(write_many_read_buf, sizeof(write_many_read_buf));
+  r = uv_fs_read(loop, &req, write_many_file, &iov, 1, 0, write_many_read_cb);
+  TUV_ASSERT(r == 0);
+  uv_run(loop, UV_RUN_DEFAULT);
+  TUV_ASSERT(read_cb_count == 1);
+
+  r = uv_fs_close(loop, &req, write_many_file, NULL);
+  TUV_ASSERT(r == 0);
+  uv_fs_req_cleanup(&req);
+
+  /* Cleanup. */
+  unlink(filename1);
+
+  return 0;
+}
 #endif // __NUTTX__
 
 
@@ -1442,3 +1538,66 @@ TEST_IMPL(fs_async_dir) {
   rmdir("test_dir");
   return 0;
 }
+
+
+TEST_IMPL(fs_async_sendfile) {
+  int f, r;
+  struct stat s1, s2;
+
+  /* Setup. */
+  unlink("test_file");
+  unlink("test_file2");
+
+  f = open("test_file", O_WRONLY | O_CREAT, S_IWUSR | S_IRUSR);
+  TUV_ASSERT(f != -1);
+
+  r = write(f, "begin\n", 6);
+  TUV_ASSERT(r == 6);
+
+  r = lseek(f, 65536, SEEK_CUR);
+  TUV_ASSERT(r == 65542);
+
+  r = write(f, "end\n", 4);
+  TUV_ASSERT(r != -1);
+
+  r = close(f);
+  TUV_ASSERT(r == 0);
+
+  /* Test starts here. */
+  loop = uv_default_loop();
+  sendfile_cb_count = 0;
+
+  r = uv_fs_open(loop, &open_req1, "test_file", O_RDWR, 0, NULL);
+  TUV_ASSERT(r >= 0);
+  TUV_ASSERT(open_req1.result >= 0);
+  uv_fs_req_cleanup(&open_req1);
+
+  r = uv_fs_open(loop, &open_req2, "test_file2", O_WRONLY | O_CREAT,
+      S_IWUSR | S_IRUSR, NULL);
+  TUV_ASSERT(r >= 0);
+  TUV_ASSERT(open_req2.result >= 0);
+  uv_fs_req_cleanup(&open_req2);
+
+  r = uv_fs_sendfile(loop, &sendfile_req, open_req2.result, open_req1.result,
+      0, 131072, sendfile_cb);
+  TUV_ASSERT(r == 0);
+  uv_run(loop, UV_RUN_DEFAULT);
+
+  TUV_ASSERT(sendfile_cb_count == 1);
+
+  r = uv_fs_close(NULL, &close_req, open_req1.result, NULL);
+  TUV_ASSERT(r == 0);
+  uv_fs_req_cleanup(&close_req);
+  r = uv_fs_close(NULL, &close_req, open_req2.result, NULL);
+  TUV_ASSERT(r == 0);
+  uv_fs_req_cleanup(&close_req);
+
+  stat("test_file", &s1);
+  stat("test_file2", &s2);
+  TUV_ASSERT(65546 == s2.st_size && s1.st_size == s2.st_size);
+
+  /* Cleanup. */
+  unlink("test_file");
+  unlink("test_file2");
+  return 0;
+}
@@ -50,3 +50,50 @@ TEST_IMPL(idle_basic) {
 
   return 0;
 }
+
+
+static uv_prepare_t prepare_handle;
+static uv_timer_t prepare_timer_handle;
+static int prepare_cb_called = 0;
+static int prepare_timer_cb_called = 0;
+
+static void prepare_timer_callback(uv_timer_t* handle) {
+  prepare_timer_cb_called++;
+}
+
+static void prepare_callback(uv_prepare_t* handle) {
+  prepare_cb_called++;
+  /* The prepare callbacks run before the loop computes how long to wait, so
+   * a timer started here bounds the wait of the same iteration. */
+  uv_timer_start(&prepare_timer_handle, prepare_timer_callback, 1, 0);
+}
+
+
+TEST_IMPL(prepare_basic) {
+  uv_loop_t* loop;
+
+  prepare_cb_called = 0;
+  prepare_timer_cb_called = 0;
+
+  loop = uv_default_loop();
+  uv_timer_init(loop, &prepare_timer_handle);
+  uv_prepare_init(loop, &prepare_handle);
+  uv_prepare_start(&prepare_handle, prepare_callback);
+  uv_run(loop, UV_RUN_ONCE);
+
+  TUV_ASSERT(prepare_cb_called == 1);
+  TUV_ASSERT(prepare_timer_cb_called == 1);
+
+  /* An unreferenced prepare handle does not keep the loop alive. */
+  uv_unref((uv_handle_t*) &prepare_handle);
+  uv_run(loop, UV_RUN_DEFAULT);
+  TUV_ASSERT(prepare_cb_called == 1);
+
+  uv_close((uv_handle_t*) &prepare_handle, NULL);
+  uv_close((uv_handle_t*) &prepare_timer_handle, NULL);
+  uv_run(loop, UV_RUN_ONCE);
+
+  TUV_ASSERT(0 == uv_loop_close(loop));
+
+  return 0;
+}
@@ -368,3 +368,58 @@ TEST_IMPL(timer_null_callback) {
 
   return 0;
 }
+
+
+//-----------------------------------------------------------------------------
+
+static uv_timer_t slack_lazy;
+static uv_timer_t slack_exact;
+static uint64_t slack_lazy_time = 0ll;
+static uint64_t slack_exact_time = 0ll;
+static int slack_cb_called = 0;
+
+
+static void slack_cb(uv_timer_t* handle) {
+  if (handle == &slack_lazy) {
+    slack_lazy_time = uv_now(uv_default_loop());
+  } else {
+    slack_exact_time = uv_now(uv_default_loop());
+  }
+  slack_cb_called++;
+}
+
+
+TEST_IMPL(timer_slack) {
+  slack_cb_called = 0;
+  start_time = uv_now(uv_default_loop());
+
+  TUV_ASSERT(0 == uv_timer_init(uv_default_loop(), &slack_lazy));
+  TUV_ASSERT(0 == uv_timer_get_slack(&slack_lazy));
+  uv_timer_set_slack(&slack_lazy, 100);
+  TUV_ASSERT(100 == uv_timer_get_slack(&slack_lazy));
+  TUV_ASSERT(0 == uv_timer_init(uv_default_loop(), &slack_exact));
+
+  // The timer of 100 ms waits for the one of 150 ms, and both run in one
+  // wakeup.
+  TUV_ASSERT(0 == uv_timer_start(&slack_lazy, slack_cb, 100, 0));
+  TUV_ASSERT(0 == uv_timer_start(&slack_exact, slack_cb, 150, 0));
+  TUV_ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  TUV_ASSERT(2 == slack_cb_called);
+  TUV_ASSERT(slack_lazy_time >= start_time + 150);
+  TUV_ASSERT(slack_lazy_time == slack_exact_time);
+
+  // A timer is never run before its timeout, whatever its slack.
+  start_time = uv_now(uv_default_loop());
+  TUV_ASSERT(0 == uv_timer_start(&slack_lazy, slack_cb, 50, 0));
+  TUV_ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  TUV_ASSERT(3 == slack_cb_called);
+  TUV_ASSERT(slack_lazy_time >= start_time + 50);
+
+  uv_close((uv_handle_t*)&slack_lazy, NULL);
+  uv_close((uv_handle_t*)&slack_exact, NULL);
+  uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+  TUV_ASSERT(0 == uv_loop_close(uv_default_loop()));
+
+  return 0;
+}
@@ -0,0 +1,171 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file iotjs_addon.h
+ * @brief The interface of the native addons, shared libraries loaded by
+ * `require('./name.node')`.\n\n
+ * An addon links to nothing of IoT.js: it is given a table of the functions
+ * of the host when it is loaded, so that it keeps working with the builds of
+ * the same ABI version, whatever their engine and build options are.
+ */
+
+#ifndef IOTJS_ADDON_H
+#define IOTJS_ADDON_H
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+#define IOTJS_ADDON_EXTERN_C extern "C"
+#else /* !__cplusplus */
+#define IOTJS_ADDON_EXTERN_C
+#endif /* !__cplusplus */
+
+#define IOTJS_ADDON_EXPORT \
+  IOTJS_ADDON_EXTERN_C __attribute__((visibility("default")))
+
+
+// The version of the table below. Entries are only appended to the table in
+// the same version, which `api->size` tells.
+#define IOTJS_ADDON_ABI_VERSION 1
+
+
+// A JavaScript value. The values an addon creates or gets are its own and are
+// released by `api->release`, unless said otherwise. The arguments and the
+// `this` of a call are borrowed for the call.
+typedef uint32_t iotjs_addon_value_t;
+
+// A native call of JavaScript, the `iotjs_jhandler_t` of the host.
+typedef struct iotjs_addon_call_s iotjs_addon_call_t;
+
+// A native function, defined by IOTJS_ADDON_FUNCTION.
+typedef void (*iotjs_addon_handler_t)(iotjs_addon_call_t* call);
+
+typedef enum {
+  kAddonUndefined,
+  kAddonNull,
+  kAddonBoolean,
+  kAddonNumber,
+  kAddonString,
+  kAddonObject,
+  kAddonFunction,
+  kAddonBuffer,
+} iotjs_addon_type_t;
+
+typedef enum {
+  kAddonError,
+  kAddonRangeError,
+  kAddonTypeError,
+} iotjs_addon_error_t;
+
+
+typedef struct {
+  uint32_t version; // IOTJS_ADDON_ABI_VERSION of the host
+  uint32_t size;    // sizeof the table of the host
+
+  // The call. Arguments past the count are undefined. What a call returns is
+  // copied, and a thrown error replaces it.
+  uint16_t (*arg_count)(iotjs_addon_call_t* call);
+  iotjs_addon_value_t (*arg)(iotjs_addon_call_t* call, uint16_t index);
+  iotjs_addon_value_t (*this_value)(iotjs_addon_call_t* call);
+  void (*return_value)(iotjs_addon_call_t* call, iotjs_addon_value_t value);
+  void (*return_number)(iotjs_addon_call_t* call, double number);
+  void (*return_boolean)(iotjs_addon_call_t* call, bool boolean);
+  void (*throw_error)(iotjs_addon_call_t* call, iotjs_addon_error_t type,
+                      const char* message);
+  void (*throw_value)(iotjs_addon_call_t* call, iotjs_addon_value_t value);
+
+  // Values. A number other than a Number is 0, and a string other than a
+  // String is empty.
+  iotjs_addon_type_t (*type_of)(iotjs_addon_value_t value);
+  double (*as_number)(iotjs_addon_value_t value);
+  bool (*as_boolean)(iotjs_addon_value_t value);
+  // The UTF-8 size of a string, and its copy into `buffer`, not terminated,
+  // which copies nothing if `size` is too small for the string.
+  size_t (*string_size)(iotjs_addon_value_t value);
+  size_t (*copy_string)(iotjs_addon_value_t value, char* buffer, size_t size);
+  iotjs_addon_value_t (*create_undefined)(void);
+  iotjs_addon_value_t (*create_number)(double number);
+  iotjs_addon_value_t (*create_boolean)(bool boolean);
+  iotjs_addon_value_t (*create_string)(const char* data, size_t size);
+  iotjs_addon_value_t (*create_object)(void);
+  iotjs_addon_value_t (*create_array)(uint32_t length);
+  iotjs_addon_value_t (*create_function)(iotjs_addon_handler_t handler);
+  iotjs_addon_value_t (*acquire)(iotjs_addon_value_t value);
+  void (*release)(iotjs_addon_value_t value);
+
+  // Properties. A key is a string kept by the host until it exits, to be
+  // created once and used for every access, and never released. A getter that
+  // throws reads as undefined.
+  iotjs_addon_value_t (*create_key)(const char* name);
+  iotjs_addon_value_t (*get_property)(iotjs_addon_value_t object,
+                                      iotjs_addon_value_t key);
+  void (*set_property)(iotjs_addon_value_t object, iotjs_addon_value_t key,
+                       iotjs_addon_value_t value);
+  iotjs_addon_value_t (*get_index)(iotjs_addon_value_t object,
+                                   uint32_t index);
+  void (*set_index)(iotjs_addon_value_t object, uint32_t index,
+                    iotjs_addon_value_t value);
+
+  // Buffers. The memory of a Buffer, or NULL if `value` is not one. It stays
+  // in place while the Buffer is alive.
+  char* (*buffer_data)(iotjs_addon_value_t value, size_t* length);
+  // A Buffer of `length` bytes, whose memory is returned in `data`.
+  iotjs_addon_value_t (*create_buffer)(size_t length, char** data);
+
+  // Calls a function. The return value, or the thrown error with `threw`.
+  iotjs_addon_value_t (*call_function)(iotjs_addon_value_t function,
+                                       iotjs_addon_value_t this_value,
+                                       const iotjs_addon_value_t* args,
+                                       uint16_t count, bool* threw);
+} iotjs_addon_api_t;
+
+
+// Defines a native function, as JHANDLER_FUNCTION does for the modules of the
+// host.
+#define IOTJS_ADDON_FUNCTION(name) static void name(iotjs_addon_call_t* call)
+
+// Defines the entry point of an addon, called once with the table of the host
+// and the `module.exports` to fill. It returns false, with a message in
+// `*error`, if the addon cannot be used.
+//
+//   static const iotjs_addon_api_t* api;
+//
+//   IOTJS_ADDON_INIT(host, exports, error) {
+//     api = host;
+//     ...
+//     return true;
+//   }
+#define IOTJS_ADDON_INIT(api, exports, error)                                 \
+  IOTJS_ADDON_EXPORT const uint32_t iotjs_addon_abi_version =                 \
+      IOTJS_ADDON_ABI_VERSION;                                                \
+  IOTJS_ADDON_EXPORT bool iotjs_addon_init(const iotjs_addon_api_t* api,      \
+                                           iotjs_addon_value_t exports,       \
+                                           const char** error)
+
+// The names the host looks the entry point up by.
+#define IOTJS_ADDON_ABI_VERSION_SYMBOL "iotjs_addon_abi_version"
+#define IOTJS_ADDON_INIT_SYMBOL "iotjs_addon_init"
+
+typedef bool (*iotjs_addon_init_t)(const iotjs_addon_api_t* api,
+                                   iotjs_addon_value_t exports,
+                                   const char** error);
+
+
+#endif /* IOTJS_ADDON_H */
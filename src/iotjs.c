@@ -16,9 +16,31 @@
 #include "iotjs_def.h"
 
 #include "iotjs.h"
+#include "iotjs_addon_host.h"
+#include "iotjs_busqueue.h"
 #include "iotjs_handlewrap.h"
 #include "iotjs_js.h"
+#include "iotjs_memory.h"
 #include "iotjs_string_ext.h"
+#include "modules/iotjs_module_buffer.h"
+#include "modules/iotjs_module_console.h"
+#if ENABLE_MODULE_DNS
+#include "modules/iotjs_module_dns.h"
+#endif
+#include "modules/iotjs_module_fs.h"
+#if ENABLE_MODULE_HTTPPARSER
+#include "modules/iotjs_module_httpparser.h"
+#endif
+#if ENABLE_MODULE_HTTPS
+#include "modules/iotjs_module_https.h"
+#endif
+#include "modules/iotjs_module_process.h"
+#if ENABLE_MODULE_LOG
+#include "modules/iotjs_module_log.h"
+#endif
+#if ENABLE_MODULE_TCP
+#include "modules/iotjs_module_tcp.h"
+#endif
 
 #include "jerryscript-debugger.h"
 #ifndef __NUTTX__
@@ -29,6 +51,23 @@
 
 #include <stdio.h>
 #include <string.h>
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+
+// Number of objects examined by a slice of incremental garbage collection,
+// which is performed between iterations of the event loop.
+#define IOTJS_GC_STEP_BUDGET 256
+
+// Time in milliseconds the next tick callbacks and the promise jobs may run
+// in an iteration of the event loop. The remaining ones run in the next
+// iteration, after libtuv has polled for I/O without blocking. 0 runs one
+// round of next tick callbacks and all the jobs in every iteration.
+#ifndef IOTJS_JOB_TIME_BUDGET_MS
+#define IOTJS_JOB_TIME_BUDGET_MS 0
+#endif
 
 
 /**
@@ -55,9 +94,64 @@ static bool iotjs_jerry_initialize(iotjs_environment_t* env) {
   if (iotjs_environment_config(env)->is_jerry_jmem_logs_enabled) {
     jerry_flags |= JERRY_INIT_JMEM_LOGS_ENABLED;
   }
+  // Set segment size of the segmented heap.
+  if (iotjs_environment_config(env)->segment_size != 0 &&
+      !jerry_set_segment_size(iotjs_environment_config(env)->segment_size)) {
+    DLOG("jerry_set_segment_size() failed");
+    return false;
+  }
+
+  // Redirect jmem profilers to a structured output.
+  const char* profile_output =
+      iotjs_environment_config(env)->jmem_profile_output;
+  if (profile_output != NULL) {
+    if (!strcmp(profile_output, "-")) {
+      profile_output = NULL; // stdout
+    }
+    if (!jerry_set_jmem_profile_output(
+            profile_output, iotjs_environment_config(env)->jmem_profile_format)) {
+      DLOG("jerry_set_jmem_profile_output() failed");
+      return false;
+    }
+  }
+
+  // Select jmem profilers at runtime.
+  if (iotjs_environment_config(env)->is_jmem_profile_selected &&
+      !jerry_set_jmem_profile_categories(
+          iotjs_environment_config(env)->jmem_profile_categories)) {
+    // Not fatal: the profilers built in are selected anyway
+    DLOG("jerry_set_jmem_profile_categories(): some are not built in");
+  }
+
   // Initialize jerry.
   jerry_init(jerry_flags);
 
+  // Configure reverse map cache of the segmented heap.
+  const Config* config = iotjs_environment_config(env);
+  if (config->rmap_cache_size != 0 &&
+      !jerry_set_rmap_cache_config(config->rmap_cache_size,
+                                   config->rmap_cache_set_size,
+                                   config->rmap_cache_policy,
+                                   config->is_rmap_cache_adaptive)) {
+    DLOG("jerry_set_rmap_cache_config() failed");
+    return false;
+  }
+
+  // Keep empty segments of the segmented heap for reuse.
+  if (config->is_segment_retention_set &&
+      !jerry_set_segment_retention(config->segment_retention_low,
+                                   config->segment_retention_high,
+                                   config->segment_retention_age)) {
+    // Not fatal: empty segments are freed at once
+    DLOG("jerry_set_segment_retention(): not built in");
+  }
+
+  // Schedule GC by the adaptive trigger.
+  if (config->gc_trigger.growth_percent != 0) {
+    jerry_set_gc_trigger(&config->gc_trigger);
+  }
+  iotjs_environment_mark_startup(env, kStartupJerryInit);
+
   if (iotjs_environment_config(env)->debugger) {
     jerry_debugger_init(iotjs_environment_config(env)->debugger_port);
   }
@@ -65,13 +159,17 @@ static bool iotjs_jerry_initialize(iotjs_environment_t* env) {
   if (iotjs_environment_config(env)->debugger) {
     jerry_debugger_continue();
   }
+  iotjs_environment_mark_startup(env, kStartupDebugger);
 
   // Set magic strings.
   iotjs_register_jerry_magic_string();
+  iotjs_environment_mark_startup(env, kStartupMagicStrings);
 
-  // Register VM execution stop callback.
+  // Register VM execution stop callback. It is only called once a stop is
+  // requested by iotjs_environment_go_state_exiting(), so loops do not pay
+  // for it.
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_environment_t, env);
-  jerry_set_vm_exec_stop_callback(vm_exec_stop_callback, &(_this->state), 2);
+  jerry_set_vm_exec_stop_callback(vm_exec_stop_callback, &(_this->state), 0);
 
   // Do parse and run to generate initial javascript environment.
   jerry_value_t parsed_code = jerry_parse((jerry_char_t*)"", 0, false);
@@ -91,6 +189,7 @@ static bool iotjs_jerry_initialize(iotjs_environment_t* env) {
 
   jerry_release_value(parsed_code);
   jerry_release_value(ret_val);
+  iotjs_environment_mark_startup(env, kStartupGlobal);
   return true;
 }
 
@@ -107,7 +206,9 @@ static bool iotjs_run(iotjs_environment_t* env) {
   iotjs_jval_t jmain = iotjs_jhelper_eval("iotjs.js", strlen("iotjs.js"),
                                           iotjs_s, iotjs_l, false, &throws);
 #else
-  iotjs_jval_t jmain = iotjs_jhelper_exec_snapshot(iotjs_s, iotjs_l, &throws);
+  iotjs_jval_t jmain = iotjs_jhelper_exec_multi_snapshot(iotjs_s, iotjs_l,
+                                                         iotjs_i, false,
+                                                         &throws);
 #endif
 
   if (throws) {
@@ -120,6 +221,334 @@ static bool iotjs_run(iotjs_environment_t* env) {
 }
 
 
+// Idle-time garbage collection
+// The timer is restarted before the loop waits for I/O, so it expires only if
+// the loop has been idle for the timeout. Both handles are unreferenced not to
+// keep the loop alive.
+static uv_timer_t idle_gc_timer;
+static uv_prepare_t idle_gc_prepare;
+static bool is_idle_gc_done_in_iteration = false;
+
+
+static void iotjs_idle_gc_timer_callback(uv_timer_t* handle) {
+  IOTJS_UNUSED(handle);
+  jerry_free_unused_memory();
+  is_idle_gc_done_in_iteration = true;
+}
+
+
+static void iotjs_idle_gc_prepare_callback(uv_prepare_t* handle) {
+  if (is_idle_gc_done_in_iteration) {
+    // Do not collect again until the loop handles any other event.
+    is_idle_gc_done_in_iteration = false;
+    return;
+  }
+
+  const iotjs_environment_t* env = (const iotjs_environment_t*)handle->data;
+  uv_timer_start(&idle_gc_timer, iotjs_idle_gc_timer_callback,
+                 iotjs_environment_config(env)->idle_gc_timeout, 0);
+}
+
+
+static void iotjs_idle_gc_start(iotjs_environment_t* env) {
+  if (iotjs_environment_config(env)->idle_gc_timeout == 0) {
+    return;
+  }
+
+  uv_loop_t* loop = iotjs_environment_loop(env);
+
+  uv_timer_init(loop, &idle_gc_timer);
+  uv_unref((uv_handle_t*)&idle_gc_timer);
+
+  uv_prepare_init(loop, &idle_gc_prepare);
+  idle_gc_prepare.data = env;
+  uv_prepare_start(&idle_gc_prepare, iotjs_idle_gc_prepare_callback);
+  uv_unref((uv_handle_t*)&idle_gc_prepare);
+}
+
+
+static void iotjs_idle_gc_stop(iotjs_environment_t* env) {
+  if (iotjs_environment_config(env)->idle_gc_timeout == 0) {
+    return;
+  }
+
+  uv_close((uv_handle_t*)&idle_gc_prepare, NULL);
+  uv_close((uv_handle_t*)&idle_gc_timer, NULL);
+}
+
+
+// Live profiling over the debugger connection
+// While the loop is waiting, the engine does not poll the debugger, so this
+// timer checks the messages of the client and sends the samples of the engine
+// and the loop. It is unreferenced not to keep the loop alive.
+#define IOTJS_DEBUGGER_PROFILE_TICK_MS 100
+
+static uv_timer_t debugger_profile_timer;
+static iotjs_loop_stats_t debugger_profile_last_stats;
+
+
+static void iotjs_debugger_profile_callback(uv_timer_t* handle) {
+  if (!jerry_debugger_profile_tick()) {
+    return;
+  }
+
+  iotjs_environment_t* env = (iotjs_environment_t*)handle->data;
+  const iotjs_loop_stats_t* stats = iotjs_environment_loop_stats(env);
+  iotjs_loop_stats_t* last = &debugger_profile_last_stats;
+
+  // The times are sent in microseconds, as the changes since the last sample.
+  uint32_t values[6];
+  values[0] = (uint32_t)(stats->iterations - last->iterations);
+  values[1] = (uint32_t)((stats->idle_time - last->idle_time) / 1000);
+  values[2] = (uint32_t)((stats->callback_time - last->callback_time) / 1000);
+  values[3] = (uint32_t)((stats->job_time - last->job_time) / 1000);
+  values[4] = (uint32_t)((stats->gc_time - last->gc_time) / 1000);
+  values[5] = (uint32_t)(stats->max_lag / 1000);
+  *last = *stats;
+
+  jerry_debugger_profile_sample(JERRY_DEBUGGER_PROFILE_LOOP, values, 6);
+}
+
+
+static void iotjs_debugger_profile_start(iotjs_environment_t* env) {
+  if (!iotjs_environment_config(env)->debugger) {
+    return;
+  }
+
+  debugger_profile_last_stats = *iotjs_environment_loop_stats(env);
+
+  uv_timer_init(iotjs_environment_loop(env), &debugger_profile_timer);
+  debugger_profile_timer.data = env;
+  uv_timer_start(&debugger_profile_timer, iotjs_debugger_profile_callback,
+                 IOTJS_DEBUGGER_PROFILE_TICK_MS,
+                 IOTJS_DEBUGGER_PROFILE_TICK_MS);
+  uv_unref((uv_handle_t*)&debugger_profile_timer);
+}
+
+
+static void iotjs_debugger_profile_stop(iotjs_environment_t* env) {
+  if (!iotjs_environment_config(env)->debugger) {
+    return;
+  }
+
+  uv_close((uv_handle_t*)&debugger_profile_timer, NULL);
+}
+
+
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+// Heap snapshot on SIGUSR2
+// The engine may be running when the signal arrives, so the handler only wakes
+// up the event loop, which writes the snapshot between its iterations.
+static uv_async_t heap_snapshot_async;
+static uint32_t heap_snapshot_count = 0;
+
+
+static void iotjs_heap_snapshot_signal_handler(int signum) {
+  IOTJS_UNUSED(signum);
+  uv_async_send(&heap_snapshot_async);
+}
+
+
+static void iotjs_heap_snapshot_async_callback(uv_async_t* handle) {
+  const iotjs_environment_t* env = (const iotjs_environment_t*)handle->data;
+  char path[256];
+  snprintf(path, sizeof(path), "%s.%u",
+           iotjs_environment_config(env)->heap_snapshot_path,
+           (unsigned)heap_snapshot_count++);
+  if (!jerry_write_heap_snapshot(path)) {
+    DLOG("jerry_write_heap_snapshot(%s) failed", path);
+  }
+}
+
+
+static void iotjs_heap_snapshot_start(iotjs_environment_t* env) {
+  if (iotjs_environment_config(env)->heap_snapshot_path == NULL) {
+    return;
+  }
+
+  uv_async_init(iotjs_environment_loop(env), &heap_snapshot_async,
+                iotjs_heap_snapshot_async_callback);
+  heap_snapshot_async.data = env;
+  uv_unref((uv_handle_t*)&heap_snapshot_async);
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = iotjs_heap_snapshot_signal_handler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGUSR2, &action, NULL);
+}
+
+
+static void iotjs_heap_snapshot_stop(iotjs_environment_t* env) {
+  if (iotjs_environment_config(env)->heap_snapshot_path == NULL) {
+    return;
+  }
+
+  signal(SIGUSR2, SIG_DFL);
+  uv_close((uv_handle_t*)&heap_snapshot_async, NULL);
+}
+
+
+// Sampling CPU profiler
+// SIGPROF ticks every interval of CPU time the process spends. The handler
+// only marks the tick, and the engine samples the JS stack at its next safe
+// point.
+#define IOTJS_CPU_PROFILE_INTERVAL_US 1000
+
+static bool is_cpu_profiling = false;
+
+
+static void iotjs_cpu_profile_signal_handler(int signum) {
+  IOTJS_UNUSED(signum);
+  jerry_jmem_cpu_profile_tick();
+}
+
+
+static void iotjs_cpu_profile_start(iotjs_environment_t* env) {
+  if (!(jerry_get_jmem_profile_categories() & JERRY_JMEM_PROFILE_CPU)) {
+    return;
+  }
+
+  uint32_t interval = iotjs_environment_config(env)->cpu_profile_interval;
+  if (interval == 0) {
+    interval = IOTJS_CPU_PROFILE_INTERVAL_US;
+  }
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = iotjs_cpu_profile_signal_handler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGPROF, &action, NULL);
+
+  struct itimerval timer;
+  timer.it_interval.tv_sec = interval / 1000000;
+  timer.it_interval.tv_usec = interval % 1000000;
+  timer.it_value = timer.it_interval;
+  setitimer(ITIMER_PROF, &timer, NULL);
+  is_cpu_profiling = true;
+}
+
+
+static void iotjs_cpu_profile_stop() {
+  if (!is_cpu_profiling) {
+    return;
+  }
+
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, NULL);
+  signal(SIGPROF, SIG_DFL);
+  is_cpu_profiling = false;
+}
+#else
+static void iotjs_heap_snapshot_start(iotjs_environment_t* env) {
+  IOTJS_UNUSED(env);
+}
+
+
+static void iotjs_heap_snapshot_stop(iotjs_environment_t* env) {
+  IOTJS_UNUSED(env);
+}
+
+
+static void iotjs_cpu_profile_start(iotjs_environment_t* env) {
+  IOTJS_UNUSED(env);
+}
+
+
+static void iotjs_cpu_profile_stop() {
+}
+#endif
+
+
+// Prints the time of each startup phase, once the first iteration of the
+// event loop has run, or at exit if there is none.
+static void iotjs_print_startup_trace(iotjs_environment_t* env) {
+  static bool is_printed = false;
+  if (!iotjs_environment_config(env)->startup_trace || is_printed) {
+    return;
+  }
+  is_printed = true;
+
+  const iotjs_startup_trace_t* trace = iotjs_environment_startup_trace(env);
+  uint64_t phase_start = trace->start;
+
+  fprintf(stderr, "Startup trace (ms):\n");
+  for (int phase = 0; phase < kStartupPhaseCount; phase++) {
+    uint64_t phase_end = trace->phase_end[phase];
+    if (phase_end == 0) {
+      continue;
+    }
+    fprintf(stderr, "  %-14s %9.3f\n",
+            iotjs_environment_startup_phase_name(phase),
+            (phase_end - phase_start) / 1000000.0);
+    phase_start = phase_end;
+  }
+  fprintf(stderr, "  %-14s %9.3f\n", "total",
+          (phase_start - trace->start) / 1000000.0);
+}
+
+
+// Runs the next tick callbacks, then the promise jobs in what is left of the
+// time budget. Returns true if some are left to run.
+static bool iotjs_run_pending_jobs() {
+  uint32_t job_budget = 0;
+  bool more = iotjs_process_next_tick();
+
+#if IOTJS_JOB_TIME_BUDGET_MS > 0
+  const uint64_t budget_ns = (uint64_t)IOTJS_JOB_TIME_BUDGET_MS * 1000000;
+  uint64_t start = uv_hrtime();
+  while (more && uv_hrtime() - start < budget_ns) {
+    more = iotjs_process_next_tick();
+  }
+  uint64_t elapsed_ms = (uv_hrtime() - start) / 1000000;
+  // The jobs always get to run a little.
+  job_budget = elapsed_ms < IOTJS_JOB_TIME_BUDGET_MS
+                   ? IOTJS_JOB_TIME_BUDGET_MS - (uint32_t)elapsed_ms
+                   : 1;
+#endif
+
+  jerry_value_t ret_val = jerry_run_enqueued_jobs(job_budget);
+  if (jerry_value_has_error_flag(ret_val)) {
+    DLOG("jerry_run_enqueued_jobs() failed");
+  }
+  jerry_release_value(ret_val);
+
+  return more || jerry_has_enqueued_jobs() || iotjs_process_has_next_tick();
+}
+
+
+// Accounts an iteration of the event loop, from the times it began, left
+// uv_run, finished the jobs and finished garbage collection, and the time it
+// was blocked in polling.
+static void iotjs_record_loop_stats(iotjs_environment_t* env, uint64_t start,
+                                    uint64_t run_end, uint64_t jobs_end,
+                                    uint64_t gc_end, uint64_t idle) {
+  iotjs_loop_stats_t* stats = iotjs_environment_loop_stats(env);
+  uint64_t run_time = run_end - start;
+  uint64_t lag = gc_end - start - idle;
+
+  stats->iterations++;
+  stats->idle_time += idle;
+  stats->callback_time += run_time > idle ? run_time - idle : 0;
+  stats->job_time += jobs_end - run_end;
+  stats->gc_time += gc_end - jobs_end;
+  if (lag > stats->max_lag) {
+    stats->max_lag = lag;
+  }
+
+  int bucket = 0;
+  for (uint64_t bound = 1000000; lag >= bound; bound *= 2) {
+    if (++bucket == IOTJS_LOOP_LAG_BUCKETS - 1) {
+      break;
+    }
+  }
+  stats->lag_histogram[bucket]++;
+}
+
+
 static int iotjs_start(iotjs_environment_t* env) {
   // Initialize commonly used jerry values.
   iotjs_binding_initialize();
@@ -130,14 +559,19 @@ static int iotjs_start(iotjs_environment_t* env) {
 
   // Initialize builtin modules.
   iotjs_module_list_init();
+  iotjs_environment_mark_startup(env, kStartupModuleList);
 
   // Initialize builtin process module.
   const iotjs_jval_t* process = iotjs_init_process_module();
   iotjs_jval_set_property_jval(global, "process", process);
+  iotjs_environment_mark_startup(env, kStartupProcess);
 
   // Set running state.
   iotjs_environment_go_state_running_main(env);
 
+  // Profile from the main module on, up to the 'exit' event.
+  iotjs_cpu_profile_start(env);
+
   // Load and call iotjs.js.
   iotjs_run(env);
 
@@ -145,20 +579,51 @@ static int iotjs_start(iotjs_environment_t* env) {
   if (!iotjs_environment_is_exiting(env)) {
     // Run event loop.
     iotjs_environment_go_state_running_loop(env);
+    iotjs_idle_gc_start(env);
+    iotjs_heap_snapshot_start(env);
+    iotjs_debugger_profile_start(env);
 
+    uv_loop_t* loop = iotjs_environment_loop(env);
     bool more;
     do {
-      more = uv_run(iotjs_environment_loop(env), UV_RUN_ONCE);
-      more |= iotjs_process_next_tick();
+      uint64_t idle_start = uv_metrics_idle_time(loop);
+      uint64_t start = uv_hrtime();
+
+      // Pending next ticks, promise jobs and deferred callbacks must not wait
+      // for the next I/O event.
+      bool pending = jerry_has_enqueued_jobs() ||
+                     iotjs_process_has_next_tick() ||
+                     iotjs_has_lane_callbacks() ||
+                     iotjs_finalizer_count() > 0;
+      more = uv_run(loop, pending ? UV_RUN_NOWAIT : UV_RUN_ONCE);
+
+      // The callbacks the pass deferred, by the priority of their lanes.
+      more |= iotjs_run_lane_callbacks();
+      uint64_t run_end = uv_hrtime();
+
+      more |= iotjs_run_pending_jobs();
       if (more == false) {
-        more = uv_loop_alive(iotjs_environment_loop(env));
-      }
-      jerry_value_t ret_val = jerry_run_all_enqueued_jobs();
-      if (jerry_value_has_error_flag(ret_val)) {
-        DLOG("jerry_run_all_enqueued_jobs() failed");
+        more = uv_loop_alive(loop);
       }
+      uint64_t jobs_end = uv_hrtime();
+
+      jerry_gc_step(IOTJS_GC_STEP_BUDGET);
+      // The wraps of the objects the GC freed, all of them when memory runs
+      // short.
+      iotjs_run_finalizers(iotjs_memory_pressure() != kMemoryPressureNone);
+      iotjs_memory_check();
+
+      iotjs_record_loop_stats(env, start, run_end, jobs_end, uv_hrtime(),
+                              uv_metrics_idle_time(loop) - idle_start);
+
+      iotjs_environment_mark_startup(env, kStartupFirstLoop);
+      iotjs_print_startup_trace(env);
     } while (more && !iotjs_environment_is_exiting(env));
 
+    iotjs_debugger_profile_stop(env);
+    iotjs_heap_snapshot_stop(env);
+    iotjs_idle_gc_stop(env);
+
     exit_code = iotjs_process_exitcode();
 
     if (!iotjs_environment_is_exiting(env)) {
@@ -169,19 +634,51 @@ static int iotjs_start(iotjs_environment_t* env) {
     }
   }
 
+  iotjs_cpu_profile_stop();
+  iotjs_print_startup_trace(env);
+
   exit_code = iotjs_process_exitcode();
 
+  // Release the next tick and the deferred callbacks never run.
+  iotjs_process_next_tick_cleanup();
+  iotjs_lane_callbacks_cleanup();
+
   // Release builtin modules.
   iotjs_module_list_cleanup();
+  iotjs_fs_probe_cache_release();
+  iotjs_console_release();
+#if ENABLE_MODULE_DNS
+  iotjs_dns_release();
+#endif
+#if ENABLE_MODULE_HTTPPARSER
+  iotjs_httpparser_release();
+#endif
+#if ENABLE_MODULE_LOG
+  iotjs_log_release();
+#endif
+#if ENABLE_MODULE_TCP
+  iotjs_peer_cache_release();
+#endif
 
   return exit_code;
 }
 
 
 static void iotjs_uv_walk_to_close_callback(uv_handle_t* handle, void* arg) {
+  // Handles not wrapped by iotjs_handlewrap_t are already being closed.
+  if (uv_is_closing(handle)) {
+    return;
+  }
+
   iotjs_handlewrap_t* handle_wrap = iotjs_handlewrap_from_handle(handle);
   IOTJS_ASSERT(handle_wrap != NULL);
 
+  // Another handle of a wrapper, such as its timer, is closed by itself.
+  if (iotjs_handlewrap_get_uv_handle(handle_wrap) != handle) {
+    uv_close(handle, NULL);
+    return;
+  }
+
   iotjs_handlewrap_close(handle_wrap, NULL);
 }
 
@@ -195,6 +692,15 @@ int iotjs_entry(int argc, char** argv) {
 
   int ret_code = 0;
 
+  // Native memory is given back on this thread only.
+  iotjs_memory_init();
+
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+  // A write to a connection the peer has closed fails with EPIPE instead of
+  // killing the process, as in node.js.
+  signal(SIGPIPE, SIG_IGN);
+#endif
+
   // Parse command line arguments.
   if (!iotjs_environment_parse_command_line_arguments(env, (uint32_t)argc,
                                                       argv)) {
@@ -202,6 +708,15 @@ int iotjs_entry(int argc, char** argv) {
     ret_code = 1;
     goto terminate;
   }
+  iotjs_environment_mark_startup(env, kStartupArguments);
+
+  // Size the libtuv threadpool before any work is queued.
+  if (iotjs_environment_config(env)->threadpool_size != 0 &&
+      uv_threadpool_configure(iotjs_environment_config(env)->threadpool_size,
+                              iotjs_environment_config(env)
+                                  ->threadpool_max_size) != 0) {
+    DLOG("uv_threadpool_configure failed");
+  }
 
   // Initialize JerryScript engine.
   if (!iotjs_jerry_initialize(env)) {
@@ -216,22 +731,49 @@ int iotjs_entry(int argc, char** argv) {
   // jmem-profiler
   jerry_set_heap_size_ptr(uv_get_heap_size_ptr());
 
+  // One budget for the JS heap, the libtuv heap and the native buffers.
+  const Config* config = iotjs_environment_config(env);
+  iotjs_memory_set_budget(config->memory_budget,
+                          config->memory_moderate_percent,
+                          config->memory_critical_percent);
+
   // Start iot.js.
   ret_code = iotjs_start(env);
 
   // Close uv loop.
+  iotjs_busqueue_cleanup();
   uv_walk(iotjs_environment_loop(env), iotjs_uv_walk_to_close_callback, NULL);
   uv_run(iotjs_environment_loop(env), UV_RUN_DEFAULT);
 
   int res = uv_loop_close(iotjs_environment_loop(env));
   IOTJS_ASSERT(res == 0);
 
+#if ENABLE_MODULE_HTTPS
+  // Close the connections kept for later https requests.
+  iotjs_https_global_release();
+#endif
+
+  // The wraps may release jerry values, which they cannot while the engine
+  // is released.
+  iotjs_finalizers_cleanup();
+
+  // The addons keep their property keys until here.
+  iotjs_addon_release();
+
   // Release commonly used jerry values.
   iotjs_binding_finalize();
 
   // Release JerryScript engine.
   iotjs_jerry_release(env);
 
+  // The engine no longer refers to the snapshots it ran in place.
+  iotjs_process_snapshot_release();
+
+  // Buffers may be given back to the pool by the engine until here.
+  iotjs_read_buffer_pool_cleanup();
+  iotjs_bufferwrap_pool_cleanup();
+  iotjs_pool_cleanup();
+
 terminate:
   // Release environment.
   iotjs_environment_release();
@@ -0,0 +1,390 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "iotjs_def.h"
+#include "iotjs_addon.h"
+#include "iotjs_addon_host.h"
+#include "modules/iotjs_module_buffer.h"
+
+
+#if IOTJS_ADDON_SUPPORTED
+
+#include <dlfcn.h>
+
+
+// The values of the addons are the engine values, and their calls are the
+// jhandlers of the host: a native function of an addon is dispatched as a
+// JHANDLER_FUNCTION of a builtin module is.
+
+static iotjs_jhandler_t* iotjs_addon_jhandler(iotjs_addon_call_t* call) {
+  return (iotjs_jhandler_t*)call;
+}
+
+
+// Runs `fn` with a jval of `value`, which stays the addon's.
+#define IOTJS_ADDON_WITH_JVAL(value, jval, fn)                     \
+  do {                                                             \
+    iotjs_jval_t jval = iotjs_jval_create_raw(                     \
+        jerry_acquire_value(value));                               \
+    fn;                                                            \
+    iotjs_jval_destroy(&jval);                                     \
+  } while (0)
+
+
+static uint16_t iotjs_addon_arg_count(iotjs_addon_call_t* call) {
+  return iotjs_jhandler_get_arg_length(iotjs_addon_jhandler(call));
+}
+
+
+static iotjs_addon_value_t iotjs_addon_arg(iotjs_addon_call_t* call,
+                                          uint16_t index) {
+  iotjs_jhandler_t* jhandler = iotjs_addon_jhandler(call);
+  if (index >= iotjs_jhandler_get_arg_length(jhandler)) {
+    return iotjs_jval_as_raw(iotjs_jval_get_undefined());
+  }
+  return iotjs_jval_as_raw(iotjs_jhandler_get_arg(jhandler, index));
+}
+
+
+static iotjs_addon_value_t iotjs_addon_this_value(iotjs_addon_call_t* call) {
+  return iotjs_jval_as_raw(
+      iotjs_jhandler_get_this(iotjs_addon_jhandler(call)));
+}
+
+
+static void iotjs_addon_return_value(iotjs_addon_call_t* call,
+                                     iotjs_addon_value_t value) {
+  IOTJS_ADDON_WITH_JVAL(value, jval,
+                        iotjs_jhandler_return_jval(iotjs_addon_jhandler(call),
+                                                   &jval));
+}
+
+
+static void iotjs_addon_return_number(iotjs_addon_call_t* call,
+                                      double number) {
+  iotjs_jhandler_return_number(iotjs_addon_jhandler(call), number);
+}
+
+
+static void iotjs_addon_return_boolean(iotjs_addon_call_t* call,
+                                       bool boolean) {
+  iotjs_jhandler_return_boolean(iotjs_addon_jhandler(call), boolean);
+}
+
+
+static void iotjs_addon_throw_error(iotjs_addon_call_t* call,
+                                    iotjs_addon_error_t type,
+                                    const char* message) {
+  iotjs_error_t error_type = IOTJS_ERROR_COMMON;
+  if (type == kAddonRangeError) {
+    error_type = IOTJS_ERROR_RANGE;
+  } else if (type == kAddonTypeError) {
+    error_type = IOTJS_ERROR_TYPE;
+  }
+
+  iotjs_jval_t jerror = iotjs_jval_create_error_type(error_type, message);
+  iotjs_jhandler_throw(iotjs_addon_jhandler(call), &jerror);
+  iotjs_jval_destroy(&jerror);
+}
+
+
+static void iotjs_addon_throw_value(iotjs_addon_call_t* call,
+                                    iotjs_addon_value_t value) {
+  IOTJS_ADDON_WITH_JVAL(value, jval,
+                        iotjs_jhandler_throw(iotjs_addon_jhandler(call),
+                                             &jval));
+}
+
+
+static iotjs_bufferwrap_t* iotjs_addon_bufferwrap(iotjs_addon_value_t value) {
+  if (!jerry_value_is_object(value)) {
+    return NULL;
+  }
+
+  iotjs_bufferwrap_t* bufferwrap = NULL;
+  IOTJS_ADDON_WITH_JVAL(value, jval,
+                        bufferwrap = iotjs_bufferwrap_from_jval(&jval));
+  return bufferwrap;
+}
+
+
+static iotjs_addon_type_t iotjs_addon_type_of(iotjs_addon_value_t value) {
+  if (jerry_value_is_null(value)) {
+    return kAddonNull;
+  } else if (jerry_value_is_boolean(value)) {
+    return kAddonBoolean;
+  } else if (jerry_value_is_number(value)) {
+    return kAddonNumber;
+  } else if (jerry_value_is_string(value)) {
+    return kAddonString;
+  } else if (jerry_value_is_function(value)) {
+    return kAddonFunction;
+  } else if (jerry_value_is_object(value)) {
+    return iotjs_addon_bufferwrap(value) != NULL ? kAddonBuffer
+                                                 : kAddonObject;
+  }
+  return kAddonUndefined;
+}
+
+
+static double iotjs_addon_as_number(iotjs_addon_value_t value) {
+  return jerry_value_is_number(value) ? jerry_get_number_value(value) : 0;
+}
+
+
+static bool iotjs_addon_as_boolean(iotjs_addon_value_t value) {
+  return jerry_value_to_boolean(value);
+}
+
+
+static size_t iotjs_addon_string_size(iotjs_addon_value_t value) {
+  return jerry_value_is_string(value) ? jerry_get_utf8_string_size(value) : 0;
+}
+
+
+static size_t iotjs_addon_copy_string(iotjs_addon_value_t value, char* buffer,
+                                      size_t size) {
+  if (!jerry_value_is_string(value)) {
+    return 0;
+  }
+  return jerry_string_to_utf8_char_buffer(value, (jerry_char_t*)buffer,
+                                          (jerry_size_t)size);
+}
+
+
+static iotjs_addon_value_t iotjs_addon_create_undefined() {
+  return jerry_create_undefined();
+}
+
+
+static iotjs_addon_value_t iotjs_addon_create_number(double number) {
+  return jerry_create_number(number);
+}
+
+
+static iotjs_addon_value_t iotjs_addon_create_boolean(bool boolean) {
+  return jerry_create_boolean(boolean);
+}
+
+
+static iotjs_addon_value_t iotjs_addon_create_string(const char* data,
+                                                     size_t size) {
+  return jerry_create_string_sz_from_utf8((const jerry_char_t*)data,
+                                          (jerry_size_t)size);
+}
+
+
+static iotjs_addon_value_t iotjs_addon_create_object() {
+  return jerry_create_object();
+}
+
+
+static iotjs_addon_value_t iotjs_addon_create_array(uint32_t length) {
+  return jerry_create_array(length);
+}
+
+
+static iotjs_addon_value_t iotjs_addon_create_function(
+    iotjs_addon_handler_t handler) {
+  iotjs_jval_t jfunc =
+      iotjs_jval_create_function_with_dispatch((iotjs_native_handler_t)handler);
+  jerry_value_t value = jerry_acquire_value(iotjs_jval_as_raw(&jfunc));
+  iotjs_jval_destroy(&jfunc);
+  return value;
+}
+
+
+static iotjs_addon_value_t iotjs_addon_acquire(iotjs_addon_value_t value) {
+  return jerry_acquire_value(value);
+}
+
+
+static void iotjs_addon_release_value(iotjs_addon_value_t value) {
+  jerry_release_value(value);
+}
+
+
+// The keys of the addons, released with the engine.
+static jerry_value_t* addon_keys = NULL;
+static size_t addon_key_count = 0;
+static size_t addon_key_capacity = 0;
+
+
+static iotjs_addon_value_t iotjs_addon_create_key(const char* name) {
+  if (addon_key_count == addon_key_capacity) {
+    addon_key_capacity = addon_key_capacity > 0 ? addon_key_capacity * 2 : 16;
+    size_t size = addon_key_capacity * sizeof(jerry_value_t);
+    addon_keys = addon_keys == NULL
+                     ? (jerry_value_t*)iotjs_buffer_allocate(size)
+                     : (jerry_value_t*)iotjs_buffer_reallocate(
+                           (char*)addon_keys, size);
+  }
+
+  jerry_value_t key = jerry_create_string_from_utf8((const jerry_char_t*)name);
+  addon_keys[addon_key_count++] = key;
+  return key;
+}
+
+
+// A thrown error reads as undefined.
+static iotjs_addon_value_t iotjs_addon_result(jerry_value_t result) {
+  if (jerry_value_has_error_flag(result)) {
+    jerry_release_value(result);
+    return jerry_create_undefined();
+  }
+  return result;
+}
+
+
+static iotjs_addon_value_t iotjs_addon_get_property(
+    iotjs_addon_value_t object, iotjs_addon_value_t key) {
+  return iotjs_addon_result(jerry_get_property(object, key));
+}
+
+
+static void iotjs_addon_set_property(iotjs_addon_value_t object,
+                                     iotjs_addon_value_t key,
+                                     iotjs_addon_value_t value) {
+  jerry_release_value(jerry_set_property(object, key, value));
+}
+
+
+static iotjs_addon_value_t iotjs_addon_get_index(iotjs_addon_value_t object,
+                                                 uint32_t index) {
+  return iotjs_addon_result(jerry_get_property_by_index(object, index));
+}
+
+
+static void iotjs_addon_set_index(iotjs_addon_value_t object, uint32_t index,
+                                  iotjs_addon_value_t value) {
+  jerry_release_value(jerry_set_property_by_index(object, index, value));
+}
+
+
+static char* iotjs_addon_buffer_data(iotjs_addon_value_t value,
+                                     size_t* length) {
+  iotjs_bufferwrap_t* bufferwrap = iotjs_addon_bufferwrap(value);
+  if (bufferwrap == NULL) {
+    *length = 0;
+    return NULL;
+  }
+  *length = iotjs_bufferwrap_length(bufferwrap);
+  return iotjs_bufferwrap_buffer(bufferwrap);
+}
+
+
+static iotjs_addon_value_t iotjs_addon_create_buffer(size_t length,
+                                                     char** data) {
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(length);
+  *data = iotjs_bufferwrap_buffer(iotjs_bufferwrap_from_jbuffer(&jbuffer));
+  jerry_value_t value = jerry_acquire_value(iotjs_jval_as_raw(&jbuffer));
+  iotjs_jval_destroy(&jbuffer);
+  return value;
+}
+
+
+static iotjs_addon_value_t iotjs_addon_call_function(
+    iotjs_addon_value_t function, iotjs_addon_value_t this_value,
+    const iotjs_addon_value_t* args, uint16_t count, bool* threw) {
+  jerry_value_t result =
+      jerry_call_function(function, this_value, args, count);
+  *threw = jerry_value_has_error_flag(result);
+  jerry_value_clear_error_flag(&result);
+  return result;
+}
+
+
+static const iotjs_addon_api_t addon_api = {
+  .version = IOTJS_ADDON_ABI_VERSION,
+  .size = sizeof(iotjs_addon_api_t),
+  .arg_count = iotjs_addon_arg_count,
+  .arg = iotjs_addon_arg,
+  .this_value = iotjs_addon_this_value,
+  .return_value = iotjs_addon_return_value,
+  .return_number = iotjs_addon_return_number,
+  .return_boolean = iotjs_addon_return_boolean,
+  .throw_error = iotjs_addon_throw_error,
+  .throw_value = iotjs_addon_throw_value,
+  .type_of = iotjs_addon_type_of,
+  .as_number = iotjs_addon_as_number,
+  .as_boolean = iotjs_addon_as_boolean,
+  .string_size = iotjs_addon_string_size,
+  .copy_string = iotjs_addon_copy_string,
+  .create_undefined = iotjs_addon_create_undefined,
+  .create_number = iotjs_addon_create_number,
+  .create_boolean = iotjs_addon_create_boolean,
+  .create_string = iotjs_addon_create_string,
+  .create_object = iotjs_addon_create_object,
+  .create_array = iotjs_addon_create_array,
+  .create_function = iotjs_addon_create_function,
+  .acquire = iotjs_addon_acquire,
+  .release = iotjs_addon_release_value,
+  .create_key = iotjs_addon_create_key,
+  .get_property = iotjs_addon_get_property,
+  .set_property = iotjs_addon_set_property,
+  .get_index = iotjs_addon_get_index,
+  .set_index = iotjs_addon_set_index,
+  .buffer_data = iotjs_addon_buffer_data,
+  .create_buffer = iotjs_addon_create_buffer,
+  .call_function = iotjs_addon_call_function,
+};
+
+
+const char* iotjs_addon_load(const char* path, const iotjs_jval_t* jexports) {
+  void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  if (handle == NULL) {
+    return dlerror();
+  }
+
+  const uint32_t* abi_version =
+      (const uint32_t*)dlsym(handle, IOTJS_ADDON_ABI_VERSION_SYMBOL);
+  iotjs_addon_init_t init;
+  *(void**)(&init) = dlsym(handle, IOTJS_ADDON_INIT_SYMBOL);
+  if (abi_version == NULL || init == NULL) {
+    dlclose(handle);
+    return "Not an IoT.js addon";
+  }
+  if (*abi_version != IOTJS_ADDON_ABI_VERSION) {
+    dlclose(handle);
+    return "The addon is built for another ABI version";
+  }
+
+  // The library stays loaded whatever the init does, as it may have made
+  // functions already.
+  const char* error = NULL;
+  if (!init(&addon_api, iotjs_jval_as_raw(jexports), &error)) {
+    return error != NULL ? error : "The addon failed to initialize";
+  }
+  return NULL;
+}
+
+
+void iotjs_addon_release() {
+  for (size_t i = 0; i < addon_key_count; i++) {
+    jerry_release_value(addon_keys[i]);
+  }
+  if (addon_keys != NULL) {
+    iotjs_buffer_release((char*)addon_keys);
+  }
+  addon_keys = NULL;
+  addon_key_count = addon_key_capacity = 0;
+}
+
+#else
+
+void iotjs_addon_release() {
+}
+
+#endif /* IOTJS_ADDON_SUPPORTED */
@@ -0,0 +1,39 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IOTJS_ADDON_HOST_H
+#define IOTJS_ADDON_HOST_H
+
+
+// Native addons, the shared libraries of include/iotjs_addon.h, which are
+// loaded with dlopen() on the platforms that have it.
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+#define IOTJS_ADDON_SUPPORTED 1
+#else
+#define IOTJS_ADDON_SUPPORTED 0
+#endif
+
+#if IOTJS_ADDON_SUPPORTED
+// Loads the addon at `path` and lets it fill `jexports`. Returns NULL, or the
+// reason it cannot be loaded.
+const char* iotjs_addon_load(const char* path, const iotjs_jval_t* jexports);
+#endif
+
+// Releases the property keys of the addons, before the engine is released.
+// The libraries stay loaded until the process exits.
+void iotjs_addon_release();
+
+
+#endif /* IOTJS_ADDON_HOST_H */
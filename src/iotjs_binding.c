@@ -28,7 +28,9 @@ static iotjs_jval_t jglobal;
 
 static iotjs_jargs_t jargs_empty;
 
-static jerry_value_t iotjs_jval_as_raw(const iotjs_jval_t* jval);
+static jerry_value_t jpropkeys[IOTJS_PROPKEY__COUNT];
+
+static iotjs_jval_t* iotjs_jargs_argv(const iotjs_jargs_t* jargs);
 
 
 iotjs_jval_t iotjs_jval_create_number(double v) {
@@ -59,6 +61,46 @@ iotjs_jval_t iotjs_jval_create_string(const iotjs_string_t* v) {
 }
 
 
+static void iotjs_jval_release_external_string(void* data) {
+  iotjs_buffer_release((char*)data);
+}
+
+
+iotjs_jval_t iotjs_jval_create_string_external(char* data, size_t size) {
+  iotjs_jval_t jval;
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_jval_t, &jval);
+
+  if (size == 0) {
+    if (data != NULL) {
+      iotjs_buffer_release(data);
+    }
+    _this->value = jerry_create_string((const jerry_char_t*)"");
+    return jval;
+  }
+
+  const jerry_char_t* chars = (const jerry_char_t*)data;
+  jerry_size_t chars_size = (jerry_size_t)size;
+
+  if (!jerry_is_valid_utf8_string(chars, chars_size)) {
+    _this->value =
+        jerry_create_error(JERRY_ERROR_TYPE,
+                           (const jerry_char_t*)"Invalid UTF-8 string");
+    iotjs_buffer_release(data);
+  } else if (jerry_is_valid_cesu8_string(chars, chars_size)) {
+    // Without characters outside the BMP, the UTF-8 bytes are those the
+    // engine keeps, which are left where they are.
+    _this->value =
+        jerry_create_external_string_sz(chars, chars_size,
+                                        iotjs_jval_release_external_string);
+  } else {
+    _this->value = jerry_create_string_sz_from_utf8(chars, chars_size);
+    iotjs_buffer_release(data);
+  }
+
+  return jval;
+}
+
+
 iotjs_jval_t iotjs_jval_get_string_size(const iotjs_string_t* str) {
   iotjs_jval_t str_val = iotjs_jval_create_string(str);
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, &str_val);
@@ -82,6 +124,23 @@ iotjs_jval_t iotjs_jval_create_string_raw(const char* data) {
 }
 
 
+iotjs_jval_t iotjs_jval_create_string_sz(const char* data, size_t size) {
+  iotjs_jval_t jval;
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_jval_t, &jval);
+
+  const jerry_char_t* chars = (const jerry_char_t*)data;
+  if (jerry_is_valid_cesu8_string(chars, (jerry_size_t)size)) {
+    _this->value = jerry_create_string_sz(chars, (jerry_size_t)size);
+  } else {
+    _this->value =
+        jerry_create_error(JERRY_ERROR_TYPE,
+                           (const jerry_char_t*)"Invalid CESU-8 string");
+  }
+
+  return jval;
+}
+
+
 iotjs_jval_t iotjs_jval_create_object() {
   iotjs_jval_t jval;
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_jval_t, &jval);
@@ -162,7 +221,7 @@ iotjs_jval_t iotjs_jval_create_copied(const iotjs_jval_t* other) {
 }
 
 
-static iotjs_jval_t iotjs_jval_create_raw(jerry_value_t val) {
+iotjs_jval_t iotjs_jval_create_raw(jerry_value_t val) {
   iotjs_jval_t jval;
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_jval_t, &jval);
 
@@ -237,20 +296,89 @@ iotjs_string_t iotjs_jval_as_string(const iotjs_jval_t* jval) {
   if (size == 0)
     return iotjs_string_create();
 
-  char* buffer = iotjs_buffer_allocate(size + 1);
-  jerry_char_t* jerry_buffer = (jerry_char_t*)(buffer);
+  // A long string goes to the heap with a terminating zero, a short one is
+  // copied into the struct.
+  if (size >= IOTJS_STRING_INLINE_SIZE) {
+    char* buffer = iotjs_buffer_allocate(size + 1);
+    size_t check = jerry_string_to_char_buffer(_this->value,
+                                               (jerry_char_t*)buffer, size);
+    IOTJS_ASSERT(check == size);
+    buffer[size] = '\0';
 
-  size_t check = jerry_string_to_char_buffer(_this->value, jerry_buffer, size);
+    return iotjs_string_create_with_buffer(buffer, size);
+  }
 
-  IOTJS_ASSERT(check == size);
-  buffer[size] = '\0';
+  iotjs_string_t res = iotjs_string_create();
+  char* buffer = iotjs_string_prepare(&res, size);
 
-  iotjs_string_t res = iotjs_string_create_with_buffer(buffer, size);
+  size_t check = jerry_string_to_char_buffer(_this->value,
+                                             (jerry_char_t*)buffer, size);
+  IOTJS_ASSERT(check == size);
 
   return res;
 }
 
 
+iotjs_string_view_t iotjs_jval_as_string_view(const iotjs_jval_t* jval) {
+  IOTJS_ASSERT(iotjs_jval_is_string(jval));
+
+  iotjs_string_view_t view;
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_string_view_t, &view);
+
+  jerry_value_t value = iotjs_jval_as_raw(jval);
+  jerry_size_t size;
+  const jerry_char_t* chars = jerry_get_string_chars(value, &size);
+
+  _this->copied = false;
+
+  if (chars != NULL) {
+    _this->data = (const char*)chars;
+    _this->size = size;
+    return view;
+  }
+
+  // The engine makes up the characters of some strings, such as numbers,
+  // only when they are asked for.
+  size = jerry_get_string_size(value);
+  char* buffer = _this->inline_data;
+  _this->data = NULL;
+  if (size > sizeof(_this->inline_data)) {
+    buffer = iotjs_buffer_allocate(size);
+    _this->data = buffer;
+  }
+
+  _this->size = jerry_string_to_char_buffer(value, (jerry_char_t*)buffer, size);
+  _this->copied = true;
+  IOTJS_ASSERT(_this->size == size);
+
+  return view;
+}
+
+
+const char* iotjs_string_view_data(const iotjs_string_view_t* view) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_string_view_t, view);
+  if (_this->data == NULL) {
+    return _this->inline_data;
+  }
+  return _this->data;
+}
+
+
+size_t iotjs_string_view_size(const iotjs_string_view_t* view) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_string_view_t, view);
+  return _this->size;
+}
+
+
+void iotjs_string_view_destroy(iotjs_string_view_t* view) {
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_string_view_t, view);
+
+  if (_this->copied && _this->data != NULL) {
+    iotjs_buffer_release((char*)_this->data);
+  }
+}
+
+
 const iotjs_jval_t* iotjs_jval_as_object(const iotjs_jval_t* jval) {
   IOTJS_VALIDATABLE_STRUCT_METHOD_VALIDATE(iotjs_jval_t, jval);
   IOTJS_ASSERT(iotjs_jval_is_object(jval));
@@ -272,12 +400,43 @@ const iotjs_jval_t* iotjs_jval_as_function(const iotjs_jval_t* jval) {
 }
 
 
-static jerry_value_t iotjs_jval_as_raw(const iotjs_jval_t* jval) {
+jerry_value_t iotjs_jval_as_raw(const iotjs_jval_t* jval) {
   const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jval);
   return _this->value;
 }
 
 
+iotjs_jval_t iotjs_jval_to_string(const iotjs_jval_t* jval, bool* throws) {
+  jerry_value_t res = jerry_value_to_string(iotjs_jval_as_raw(jval));
+  *throws = jerry_value_has_error_flag(res);
+  jerry_value_clear_error_flag(&res);
+  return iotjs_jval_create_raw(res);
+}
+
+
+iotjs_jval_t iotjs_jval_to_number(const iotjs_jval_t* jval, bool* throws) {
+  jerry_value_t res = jerry_value_to_number(iotjs_jval_as_raw(jval));
+  *throws = jerry_value_has_error_flag(res);
+  jerry_value_clear_error_flag(&res);
+  return iotjs_jval_create_raw(res);
+}
+
+
+size_t iotjs_jval_string_size(const iotjs_jval_t* jval) {
+  IOTJS_ASSERT(iotjs_jval_is_string(jval));
+  return jerry_get_string_size(iotjs_jval_as_raw(jval));
+}
+
+
+size_t iotjs_jval_copy_string(const iotjs_jval_t* jval, char* buffer,
+                              size_t size) {
+  IOTJS_ASSERT(iotjs_jval_is_string(jval));
+  return jerry_string_to_char_buffer(iotjs_jval_as_raw(jval),
+                                     (jerry_char_t*)buffer,
+                                     (jerry_size_t)size);
+}
+
+
 bool iotjs_jval_set_prototype(const iotjs_jval_t* jobj, iotjs_jval_t* jproto) {
   jerry_value_t ret =
       jerry_set_prototype(iotjs_jval_as_raw(jobj), iotjs_jval_as_raw(jproto));
@@ -299,21 +458,28 @@ void iotjs_jval_set_method(const iotjs_jval_t* jobj, const char* name,
 }
 
 
-void iotjs_jval_set_property_jval(const iotjs_jval_t* jobj, const char* name,
-                                  const iotjs_jval_t* val) {
+static void iotjs_jval_set_property_raw(const iotjs_jval_t* jobj,
+                                        jerry_value_t prop_name,
+                                        const iotjs_jval_t* val) {
   const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jobj);
   IOTJS_ASSERT(iotjs_jval_is_object(jobj));
 
-  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)(name));
   jerry_value_t value = iotjs_jval_as_raw(val);
   jerry_value_t ret_val = jerry_set_property(_this->value, prop_name, value);
-  jerry_release_value(prop_name);
 
   IOTJS_ASSERT(!jerry_value_has_error_flag(ret_val));
   jerry_release_value(ret_val);
 }
 
 
+void iotjs_jval_set_property_jval(const iotjs_jval_t* jobj, const char* name,
+                                  const iotjs_jval_t* val) {
+  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)(name));
+  iotjs_jval_set_property_raw(jobj, prop_name, val);
+  jerry_release_value(prop_name);
+}
+
+
 void iotjs_jval_set_property_null(const iotjs_jval_t* jobj, const char* name) {
   IOTJS_VALIDATABLE_STRUCT_METHOD_VALIDATE(iotjs_jval_t, jobj);
   iotjs_jval_set_property_jval(jobj, name, iotjs_jval_get_null());
@@ -361,14 +527,12 @@ void iotjs_jval_set_property_string_raw(const iotjs_jval_t* jobj,
 }
 
 
-iotjs_jval_t iotjs_jval_get_property(const iotjs_jval_t* jobj,
-                                     const char* name) {
+static iotjs_jval_t iotjs_jval_get_property_raw(const iotjs_jval_t* jobj,
+                                                jerry_value_t prop_name) {
   const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jobj);
   IOTJS_ASSERT(iotjs_jval_is_object(jobj));
 
-  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)(name));
   jerry_value_t res = jerry_get_property(_this->value, prop_name);
-  jerry_release_value(prop_name);
 
   if (jerry_value_has_error_flag(res)) {
     jerry_release_value(res);
@@ -379,6 +543,151 @@ iotjs_jval_t iotjs_jval_get_property(const iotjs_jval_t* jobj,
 }
 
 
+iotjs_jval_t iotjs_jval_get_property(const iotjs_jval_t* jobj,
+                                     const char* name) {
+  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)(name));
+  iotjs_jval_t res = iotjs_jval_get_property_raw(jobj, prop_name);
+  jerry_release_value(prop_name);
+  return res;
+}
+
+
+void iotjs_jval_set_property_jval_by_key(const iotjs_jval_t* jobj,
+                                         iotjs_propkey_t key,
+                                         const iotjs_jval_t* val) {
+  IOTJS_ASSERT(key < IOTJS_PROPKEY__COUNT);
+  iotjs_jval_set_property_raw(jobj, jpropkeys[key], val);
+}
+
+
+void iotjs_jval_set_property_boolean_by_key(const iotjs_jval_t* jobj,
+                                            iotjs_propkey_t key, bool v) {
+  iotjs_jval_set_property_jval_by_key(jobj, key, iotjs_jval_get_boolean(v));
+}
+
+
+void iotjs_jval_set_property_number_by_key(const iotjs_jval_t* jobj,
+                                           iotjs_propkey_t key, double v) {
+  iotjs_jval_t jval = iotjs_jval_create_number(v);
+  iotjs_jval_set_property_jval_by_key(jobj, key, &jval);
+  iotjs_jval_destroy(&jval);
+}
+
+
+void iotjs_jval_set_property_string_by_key(const iotjs_jval_t* jobj,
+                                           iotjs_propkey_t key,
+                                           const iotjs_string_t* v) {
+  iotjs_jval_t jval = iotjs_jval_create_string(v);
+  iotjs_jval_set_property_jval_by_key(jobj, key, &jval);
+  iotjs_jval_destroy(&jval);
+}
+
+
+void iotjs_jval_set_property_string_raw_by_key(const iotjs_jval_t* jobj,
+                                               iotjs_propkey_t key,
+                                               const char* v) {
+  iotjs_jval_t jval = iotjs_jval_create_string_raw(v);
+  iotjs_jval_set_property_jval_by_key(jobj, key, &jval);
+  iotjs_jval_destroy(&jval);
+}
+
+
+iotjs_jval_t iotjs_jval_get_property_by_key(const iotjs_jval_t* jobj,
+                                            iotjs_propkey_t key) {
+  IOTJS_ASSERT(key < IOTJS_PROPKEY__COUNT);
+  return iotjs_jval_get_property_raw(jobj, jpropkeys[key]);
+}
+
+
+// Defines a writable and configurable, but not enumerable data property.
+void iotjs_jval_set_property_hidden_by_key(const iotjs_jval_t* jobj,
+                                           iotjs_propkey_t key,
+                                           const iotjs_jval_t* val) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jobj);
+  IOTJS_ASSERT(iotjs_jval_is_object(jobj));
+  IOTJS_ASSERT(key < IOTJS_PROPKEY__COUNT);
+
+  jerry_property_descriptor_t prop_desc;
+  jerry_init_property_descriptor_fields(&prop_desc);
+  prop_desc.is_value_defined = true;
+  prop_desc.value = jerry_acquire_value(iotjs_jval_as_raw(val));
+  prop_desc.is_writable_defined = true;
+  prop_desc.is_writable = true;
+  prop_desc.is_configurable_defined = true;
+  prop_desc.is_configurable = true;
+
+  jerry_value_t ret_val =
+      jerry_define_own_property(_this->value, jpropkeys[key], &prop_desc);
+  jerry_free_property_descriptor_fields(&prop_desc);
+
+  IOTJS_ASSERT(!jerry_value_has_error_flag(ret_val));
+  jerry_release_value(ret_val);
+}
+
+
+// Defines an enumerable data property that can neither be changed nor
+// deleted, for objects shared by several callers.
+void iotjs_jval_set_property_readonly_by_key(const iotjs_jval_t* jobj,
+                                             iotjs_propkey_t key,
+                                             const iotjs_jval_t* val) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jobj);
+  IOTJS_ASSERT(iotjs_jval_is_object(jobj));
+  IOTJS_ASSERT(key < IOTJS_PROPKEY__COUNT);
+
+  jerry_property_descriptor_t prop_desc;
+  jerry_init_property_descriptor_fields(&prop_desc);
+  prop_desc.is_value_defined = true;
+  prop_desc.value = jerry_acquire_value(iotjs_jval_as_raw(val));
+  prop_desc.is_writable_defined = true;
+  prop_desc.is_writable = false;
+  prop_desc.is_enumerable_defined = true;
+  prop_desc.is_enumerable = true;
+  prop_desc.is_configurable_defined = true;
+  prop_desc.is_configurable = false;
+
+  jerry_value_t ret_val =
+      jerry_define_own_property(_this->value, jpropkeys[key], &prop_desc);
+  jerry_free_property_descriptor_fields(&prop_desc);
+
+  IOTJS_ASSERT(!jerry_value_has_error_flag(ret_val));
+  jerry_release_value(ret_val);
+}
+
+
+// Defines a configurable accessor property, whose getter and setter are
+// native handlers.
+void iotjs_jval_set_accessor(const iotjs_jval_t* jobj, const char* name,
+                             iotjs_native_handler_t getter,
+                             iotjs_native_handler_t setter) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jobj);
+  IOTJS_ASSERT(iotjs_jval_is_object(jobj));
+
+  iotjs_jval_t jgetter = iotjs_jval_create_function_with_dispatch(getter);
+  iotjs_jval_t jsetter = iotjs_jval_create_function_with_dispatch(setter);
+
+  jerry_property_descriptor_t prop_desc;
+  jerry_init_property_descriptor_fields(&prop_desc);
+  prop_desc.is_get_defined = true;
+  prop_desc.getter = jerry_acquire_value(iotjs_jval_as_raw(&jgetter));
+  prop_desc.is_set_defined = true;
+  prop_desc.setter = jerry_acquire_value(iotjs_jval_as_raw(&jsetter));
+  prop_desc.is_configurable_defined = true;
+  prop_desc.is_configurable = true;
+
+  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)(name));
+  jerry_value_t ret_val =
+      jerry_define_own_property(_this->value, prop_name, &prop_desc);
+  jerry_release_value(prop_name);
+  jerry_free_property_descriptor_fields(&prop_desc);
+
+  IOTJS_ASSERT(!jerry_value_has_error_flag(ret_val));
+  jerry_release_value(ret_val);
+
+  iotjs_jval_destroy(&jgetter);
+  iotjs_jval_destroy(&jsetter);
+}
+
+
 void iotjs_jval_set_object_native_handle(const iotjs_jval_t* jobj,
                                          uintptr_t ptr,
                                          JNativeInfoType* native_info) {
@@ -400,6 +709,22 @@ uintptr_t iotjs_jval_get_object_native_handle(const iotjs_jval_t* jobj) {
 }
 
 
+uintptr_t iotjs_jval_get_object_native_handle_of(
+    const iotjs_jval_t* jval, JNativeInfoType* native_info) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jval);
+
+  uintptr_t ptr = 0;
+  JNativeInfoType* out_native_info;
+  if (jerry_value_is_object(_this->value) &&
+      jerry_get_object_native_pointer(_this->value, (void**)&ptr,
+                                      &out_native_info) &&
+      out_native_info == native_info) {
+    return ptr;
+  }
+  return 0;
+}
+
+
 uintptr_t iotjs_jval_get_object_from_jhandler(iotjs_jhandler_t* jhandler,
                                               JNativeInfoType* native_info) {
   const iotjs_jval_t* jobj = JHANDLER_GET_THIS(object);
@@ -456,6 +781,68 @@ uintptr_t iotjs_jval_get_arg_obj_from_jhandler(iotjs_jhandler_t* jhandler,
 }
 
 
+bool iotjs_jval_is_arraybuffer_supported() {
+  return jerry_is_feature_enabled(JERRY_FEATURE_TYPEDARRAY);
+}
+
+
+iotjs_jval_t iotjs_jval_create_arraybuffer_external(char* data, size_t len,
+                                                   JFreeHandlerType free_cb) {
+  IOTJS_ASSERT(iotjs_jval_is_arraybuffer_supported());
+
+  jerry_value_t jarraybuffer =
+      jerry_create_arraybuffer_external((jerry_length_t)len, (uint8_t*)data,
+                                        free_cb);
+  IOTJS_ASSERT(!jerry_value_has_error_flag(jarraybuffer));
+
+  return iotjs_jval_create_raw(jarraybuffer);
+}
+
+
+char* iotjs_jval_get_arraybuffer_pointer(const iotjs_jval_t* jarraybuffer) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jarraybuffer);
+  IOTJS_ASSERT(iotjs_jval_is_arraybuffer(jarraybuffer));
+
+  return (char*)jerry_get_arraybuffer_pointer(_this->value);
+}
+
+
+size_t iotjs_jval_get_arraybuffer_length(const iotjs_jval_t* jarraybuffer) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jarraybuffer);
+  IOTJS_ASSERT(iotjs_jval_is_arraybuffer(jarraybuffer));
+
+  return jerry_get_arraybuffer_byte_length(_this->value);
+}
+
+
+bool iotjs_jval_is_promise_supported() {
+  return jerry_is_feature_enabled(JERRY_FEATURE_PROMISE);
+}
+
+
+iotjs_jval_t iotjs_jval_create_promise() {
+  IOTJS_ASSERT(iotjs_jval_is_promise_supported());
+
+  jerry_value_t jpromise = jerry_create_promise();
+  IOTJS_ASSERT(!jerry_value_has_error_flag(jpromise));
+
+  return iotjs_jval_create_raw(jpromise);
+}
+
+
+void iotjs_jval_settle_promise(const iotjs_jval_t* jpromise,
+                               const iotjs_jval_t* jval, bool is_resolve) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jpromise);
+  IOTJS_ASSERT(jerry_value_is_promise(_this->value));
+
+  // The reactions are only queued, they run as jobs of the event loop.
+  jerry_value_t ret_val = jerry_resolve_or_reject_promise(
+      _this->value, iotjs_jval_as_raw(jval), is_resolve);
+  IOTJS_ASSERT(!jerry_value_has_error_flag(ret_val));
+  jerry_release_value(ret_val);
+}
+
+
 void iotjs_jval_set_property_by_index(const iotjs_jval_t* jarr, uint32_t idx,
                                       const iotjs_jval_t* jval) {
   const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jarr);
@@ -484,6 +871,49 @@ iotjs_jval_t iotjs_jval_get_property_by_index(const iotjs_jval_t* jarr,
 }
 
 
+void iotjs_jval_set_property_by_jval(const iotjs_jval_t* jobj,
+                                     const iotjs_jval_t* jkey,
+                                     const iotjs_jval_t* jval) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jobj);
+  IOTJS_ASSERT(iotjs_jval_is_object(jobj));
+  IOTJS_ASSERT(iotjs_jval_is_string(jkey));
+
+  jerry_value_t ret_val =
+      jerry_set_property(_this->value, iotjs_jval_as_raw(jkey),
+                         iotjs_jval_as_raw(jval));
+  IOTJS_ASSERT(!jerry_value_has_error_flag(ret_val));
+  jerry_release_value(ret_val);
+}
+
+
+iotjs_jval_t iotjs_jval_get_property_by_jval(const iotjs_jval_t* jobj,
+                                             const iotjs_jval_t* jkey) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jobj);
+  IOTJS_ASSERT(iotjs_jval_is_object(jobj));
+  IOTJS_ASSERT(iotjs_jval_is_string(jkey));
+
+  jerry_value_t res = jerry_get_property(_this->value, iotjs_jval_as_raw(jkey));
+
+  if (jerry_value_has_error_flag(res)) {
+    jerry_release_value(res);
+    return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  }
+
+  return iotjs_jval_create_raw(res);
+}
+
+
+iotjs_jval_t iotjs_jval_get_keys(const iotjs_jval_t* jobj) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jval_t, jobj);
+  IOTJS_ASSERT(iotjs_jval_is_object(jobj));
+
+  jerry_value_t res = jerry_get_object_keys(_this->value);
+  IOTJS_ASSERT(!jerry_value_has_error_flag(res));
+
+  return iotjs_jval_create_raw(res);
+}
+
+
 iotjs_jval_t iotjs_jhelper_call(const iotjs_jval_t* jfunc,
                                 const iotjs_jval_t* jthis,
                                 const iotjs_jargs_t* jargs, bool* throws) {
@@ -493,14 +923,17 @@ iotjs_jval_t iotjs_jhelper_call(const iotjs_jval_t* jfunc,
   jerry_length_t jargc_ = iotjs_jargs_length(jargs);
 
 #ifdef NDEBUG
-  jargv_ = (jerry_value_t*)jargs->unsafe.argv;
+  jargv_ = (jerry_value_t*)iotjs_jargs_argv(jargs);
 #else
-  if (jargc_ > 0) {
-    unsigned buffer_size = sizeof(iotjs_jval_t) * jargc_;
+  jerry_value_t jargv_inline[IOTJS_JARGS_INLINE_CAPACITY];
+  if (jargc_ > IOTJS_JARGS_INLINE_CAPACITY) {
+    unsigned buffer_size = sizeof(jerry_value_t) * jargc_;
     jargv_ = (jerry_value_t*)iotjs_buffer_allocate(buffer_size);
-    for (unsigned i = 0; i < jargc_; ++i) {
-      jargv_[i] = iotjs_jval_as_raw(iotjs_jargs_get(jargs, i));
-    }
+  } else if (jargc_ > 0) {
+    jargv_ = jargv_inline;
+  }
+  for (unsigned i = 0; i < jargc_; ++i) {
+    jargv_[i] = iotjs_jval_as_raw(iotjs_jargs_get(jargs, i));
   }
 #endif
 
@@ -509,7 +942,7 @@ iotjs_jval_t iotjs_jhelper_call(const iotjs_jval_t* jfunc,
   jerry_value_t res = jerry_call_function(jfunc_, jthis_, jargv_, jargc_);
 
 #ifndef NDEBUG
-  if (jargv_) {
+  if (jargc_ > IOTJS_JARGS_INLINE_CAPACITY) {
     iotjs_buffer_release((char*)jargv_);
   }
 #endif
@@ -557,10 +990,28 @@ iotjs_jval_t iotjs_jhelper_eval(const char* name, size_t name_len,
 
 #ifdef ENABLE_SNAPSHOT
 iotjs_jval_t iotjs_jhelper_exec_snapshot(const void* snapshot_p,
-                                         size_t snapshot_size, bool* throws) {
-  jerry_value_t res = jerry_exec_snapshot(snapshot_p, snapshot_size, false);
-  /* the snapshot buffer can be referenced
+                                         size_t snapshot_size,
+                                         bool copy_bytecode, bool* throws) {
+  /* unless the byte code is copied, the snapshot buffer can be referenced
    * until jerry_cleanup is not called */
+  jerry_value_t res =
+      jerry_exec_snapshot(snapshot_p, snapshot_size, copy_bytecode);
+
+  *throws = jerry_value_has_error_flag(res);
+
+  jerry_value_clear_error_flag(&res);
+
+  return iotjs_jval_create_raw(res);
+}
+
+
+iotjs_jval_t iotjs_jhelper_exec_multi_snapshot(const void* snapshot_p,
+                                               size_t snapshot_size,
+                                               uint32_t index,
+                                               bool copy_bytecode,
+                                               bool* throws) {
+  jerry_value_t res = jerry_exec_multi_snapshot(snapshot_p, snapshot_size,
+                                                index, copy_bytecode);
 
   *throws = jerry_value_has_error_flag(res);
 
@@ -571,6 +1022,15 @@ iotjs_jval_t iotjs_jhelper_exec_snapshot(const void* snapshot_p,
 #endif
 
 
+#ifdef ENABLE_CODE_CACHE
+size_t iotjs_jhelper_save_snapshot(const uint8_t* data, size_t size,
+                                   uint32_t* snapshot_p, size_t snapshot_size) {
+  return jerry_parse_and_save_snapshot(data, size, false, false, snapshot_p,
+                                       snapshot_size);
+}
+#endif
+
+
 jerry_value_t vm_exec_stop_callback(void* user_p) {
   State* state_p = (State*)user_p;
 
@@ -582,15 +1042,28 @@ jerry_value_t vm_exec_stop_callback(void* user_p) {
 }
 
 
+// Returns the storage of the arguments, which is either inline or allocated
+// by the capacity.
+static iotjs_jval_t* iotjs_jargs_argv(const iotjs_jargs_t* jargs) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jargs_t, jargs);
+  if (_this->capacity > IOTJS_JARGS_INLINE_CAPACITY) {
+    return _this->argv;
+  }
+  return (iotjs_jval_t*)_this->inline_argv;
+}
+
+
 iotjs_jargs_t iotjs_jargs_create(uint16_t capacity) {
   iotjs_jargs_t jargs;
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_jargs_t, &jargs);
 
   _this->capacity = capacity;
   _this->argc = 0;
-  if (capacity > 0) {
+  if (capacity > IOTJS_JARGS_INLINE_CAPACITY) {
     unsigned buffer_size = sizeof(iotjs_jval_t) * capacity;
     _this->argv = (iotjs_jval_t*)iotjs_buffer_allocate(buffer_size);
+  } else if (capacity > 0) {
+    _this->argv = NULL;
   } else {
     return jargs_empty;
   }
@@ -615,13 +1088,17 @@ const iotjs_jargs_t* iotjs_jargs_get_empty() {
 void iotjs_jargs_destroy(iotjs_jargs_t* jargs) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_jargs_t, jargs);
 
-  IOTJS_ASSERT(_this->argv == NULL || _this->argc > 0);
   IOTJS_ASSERT(_this->argc <= _this->capacity);
 
-  if (_this->capacity > 0) {
-    for (unsigned i = 0; i < _this->argc; ++i) {
-      iotjs_jval_destroy(&_this->argv[i]);
-    }
+  // The struct is no longer valid for iotjs_jargs_argv().
+  iotjs_jval_t* argv = _this->capacity > IOTJS_JARGS_INLINE_CAPACITY
+                           ? _this->argv
+                           : (iotjs_jval_t*)_this->inline_argv;
+  for (unsigned i = 0; i < _this->argc; ++i) {
+    iotjs_jval_destroy(&argv[i]);
+  }
+
+  if (_this->capacity > IOTJS_JARGS_INLINE_CAPACITY) {
     iotjs_buffer_release((char*)_this->argv);
   } else {
     IOTJS_ASSERT(_this->argv == NULL);
@@ -635,10 +1112,17 @@ uint16_t iotjs_jargs_length(const iotjs_jargs_t* jargs) {
 }
 
 
-void iotjs_jargs_append_jval(iotjs_jargs_t* jargs, const iotjs_jval_t* x) {
+// Appends `x`, taking over the reference of the caller.
+static void iotjs_jargs_append_owned(iotjs_jargs_t* jargs, iotjs_jval_t x) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jargs_t, jargs);
   IOTJS_ASSERT(_this->argc < _this->capacity);
-  _this->argv[_this->argc++] = iotjs_jval_create_copied(x);
+  iotjs_jargs_argv(jargs)[_this->argc++] = x;
+}
+
+
+void iotjs_jargs_append_jval(iotjs_jargs_t* jargs, const iotjs_jval_t* x) {
+  IOTJS_VALIDATABLE_STRUCT_METHOD_VALIDATE(iotjs_jargs_t, jargs);
+  iotjs_jargs_append_owned(jargs, iotjs_jval_create_copied(x));
 }
 
 
@@ -662,33 +1146,25 @@ void iotjs_jargs_append_bool(iotjs_jargs_t* jargs, bool x) {
 
 void iotjs_jargs_append_number(iotjs_jargs_t* jargs, double x) {
   IOTJS_VALIDATABLE_STRUCT_METHOD_VALIDATE(iotjs_jargs_t, jargs);
-  iotjs_jval_t jval = iotjs_jval_create_number(x);
-  iotjs_jargs_append_jval(jargs, &jval);
-  iotjs_jval_destroy(&jval);
+  iotjs_jargs_append_owned(jargs, iotjs_jval_create_number(x));
 }
 
 
 void iotjs_jargs_append_string(iotjs_jargs_t* jargs, const iotjs_string_t* x) {
   IOTJS_VALIDATABLE_STRUCT_METHOD_VALIDATE(iotjs_jargs_t, jargs);
-  iotjs_jval_t jval = iotjs_jval_create_string(x);
-  iotjs_jargs_append_jval(jargs, &jval);
-  iotjs_jval_destroy(&jval);
+  iotjs_jargs_append_owned(jargs, iotjs_jval_create_string(x));
 }
 
 
 void iotjs_jargs_append_error(iotjs_jargs_t* jargs, const char* msg) {
   IOTJS_VALIDATABLE_STRUCT_METHOD_VALIDATE(iotjs_jargs_t, jargs);
-  iotjs_jval_t error = iotjs_jval_create_error(msg);
-  iotjs_jargs_append_jval(jargs, &error);
-  iotjs_jval_destroy(&error);
+  iotjs_jargs_append_owned(jargs, iotjs_jval_create_error(msg));
 }
 
 
 void iotjs_jargs_append_string_raw(iotjs_jargs_t* jargs, const char* x) {
   IOTJS_VALIDATABLE_STRUCT_METHOD_VALIDATE(iotjs_jargs_t, jargs);
-  iotjs_jval_t jval = iotjs_jval_create_string_raw(x);
-  iotjs_jargs_append_jval(jargs, &jval);
-  iotjs_jval_destroy(&jval);
+  iotjs_jargs_append_owned(jargs, iotjs_jval_create_string_raw(x));
 }
 
 
@@ -698,8 +1174,9 @@ void iotjs_jargs_replace(iotjs_jargs_t* jargs, uint16_t index,
 
   IOTJS_ASSERT(index < _this->argc);
 
-  iotjs_jval_destroy(&_this->argv[index]);
-  _this->argv[index] = iotjs_jval_create_copied(x);
+  iotjs_jval_t* argv = iotjs_jargs_argv(jargs);
+  iotjs_jval_destroy(&argv[index]);
+  argv[index] = iotjs_jval_create_copied(x);
 }
 
 
@@ -708,7 +1185,7 @@ const iotjs_jval_t* iotjs_jargs_get(const iotjs_jargs_t* jargs,
   const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jargs_t, jargs);
 
   IOTJS_ASSERT(index < _this->argc);
-  return &_this->argv[index];
+  return &iotjs_jargs_argv(jargs)[index];
 }
 
 
@@ -906,6 +1383,12 @@ void iotjs_binding_initialize() {
 
   iotjs_jargs_initialize_empty(&jargs_empty);
 
+#define IOTJS_PROPKEY_CREATE(name)      \
+  jpropkeys[IOTJS_PROPKEY_##name] =     \
+      jerry_create_string((const jerry_char_t*)IOTJS_MAGIC_STRING_##name);
+  FOR_EACH_IOTJS_PROPKEY(IOTJS_PROPKEY_CREATE)
+#undef IOTJS_PROPKEY_CREATE
+
 #ifdef NDEBUG
   assert(sizeof(iotjs_jval_t) == sizeof(jerry_value_t));
 #endif
@@ -919,4 +1402,8 @@ void iotjs_binding_finalize() {
   iotjs_jval_destroy(&jfalse);
   iotjs_jval_destroy(&jglobal);
   iotjs_jargs_destroy(&jargs_empty);
+
+  for (int i = 0; i < IOTJS_PROPKEY__COUNT; i++) {
+    jerry_release_value(jpropkeys[i]);
+  }
 }
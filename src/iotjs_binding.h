@@ -24,6 +24,7 @@
 
 typedef jerry_external_handler_t JHandlerType;
 typedef const jerry_object_native_info_t JNativeInfoType;
+typedef jerry_object_native_free_callback_t JFreeHandlerType;
 typedef jerry_length_t JRawLengthType;
 
 
@@ -46,9 +47,42 @@ typedef enum {
   F(string)                    \
   F(object)                    \
   F(array)                     \
+  F(arraybuffer)               \
   F(function)
 
 
+// Property names used by the native callbacks called for every event. Their
+// jerry strings are created once by iotjs_binding_initialize, and accessed by
+// the iotjs_jval_*_by_key functions with IOTJS_PROPKEY_<name>, where
+// IOTJS_MAGIC_STRING_<name> is the name of the property.
+#define FOR_EACH_IOTJS_PROPKEY(F) \
+  F(ADDRESS)                      \
+  F(CONTENTLENGTH)                \
+  F(FAMILY)                       \
+  F(HEADERS)                      \
+  F(METHOD)                       \
+  F(PORT)                         \
+  F(SHOULDKEEPALIVE)              \
+  F(SIZE)                         \
+  F(STATUS)                       \
+  F(STATUS_MSG)                   \
+  F(UPGRADE)                      \
+  F(URL)                          \
+  F(VERSIONMAJOR)                 \
+  F(VERSIONMINOR)                 \
+  F(WRITEQUEUESIZE)               \
+  F(_CALLBACKS)                   \
+  F(_ONNEXTTICK)
+
+
+typedef enum {
+#define IOTJS_PROPKEY_ENUM(name) IOTJS_PROPKEY_##name,
+  FOR_EACH_IOTJS_PROPKEY(IOTJS_PROPKEY_ENUM)
+#undef IOTJS_PROPKEY_ENUM
+  IOTJS_PROPKEY__COUNT
+} iotjs_propkey_t;
+
+
 typedef struct {
   jerry_value_t value; // JavaScript value representation
 } IOTJS_VALIDATED_STRUCT(iotjs_jval_t);
@@ -71,6 +105,13 @@ typedef void (*iotjs_native_handler_t)(iotjs_jhandler_t* jhandler);
 iotjs_jval_t iotjs_jval_create_number(double v);
 iotjs_jval_t iotjs_jval_create_string(const iotjs_string_t* v);
 iotjs_jval_t iotjs_jval_create_string_raw(const char* data);
+// Creates a string of characters in the internal encoding of the engine, as
+// iotjs_jval_copy_string() gives them.
+iotjs_jval_t iotjs_jval_create_string_sz(const char* data, size_t size);
+// Creates a string of the UTF-8 `data`, which is allocated by
+// iotjs_buffer_allocate() and taken over. Long strings are left in `data`,
+// outside of the engine heap, until they are freed.
+iotjs_jval_t iotjs_jval_create_string_external(char* data, size_t size);
 iotjs_jval_t iotjs_jval_create_object();
 iotjs_jval_t iotjs_jval_create_array(uint32_t len);
 iotjs_jval_t iotjs_jval_create_byte_array(uint32_t len, const char* data);
@@ -93,6 +134,11 @@ iotjs_jval_t* iotjs_jval_get_global_object();
 /* Destructor */
 void iotjs_jval_destroy(iotjs_jval_t* jval);
 
+// The engine value of `jval`, and a jval taking over an engine value, for the
+// native addons (iotjs_addon_host.c), whose values are the engine ones.
+jerry_value_t iotjs_jval_as_raw(const iotjs_jval_t* jval);
+iotjs_jval_t iotjs_jval_create_raw(jerry_value_t val);
+
 #define THIS_JVAL const iotjs_jval_t* jval
 
 /* Type Checkers */
@@ -103,6 +149,7 @@ bool iotjs_jval_is_number(THIS_JVAL);
 bool iotjs_jval_is_string(THIS_JVAL);
 bool iotjs_jval_is_object(THIS_JVAL);
 bool iotjs_jval_is_array(THIS_JVAL);
+bool iotjs_jval_is_arraybuffer(THIS_JVAL);
 bool iotjs_jval_is_function(THIS_JVAL);
 
 /* Type Converters */
@@ -113,6 +160,31 @@ const iotjs_jval_t* iotjs_jval_as_object(THIS_JVAL);
 const iotjs_jval_t* iotjs_jval_as_array(THIS_JVAL);
 const iotjs_jval_t* iotjs_jval_as_function(THIS_JVAL);
 
+// Convert as String() and Number() do, which may call into JavaScript.
+iotjs_jval_t iotjs_jval_to_string(THIS_JVAL, bool* throws);
+iotjs_jval_t iotjs_jval_to_number(THIS_JVAL, bool* throws);
+
+// Copy the characters of a string, in the internal encoding of the engine,
+// without creating an iotjs_string_t.
+size_t iotjs_jval_string_size(THIS_JVAL);
+size_t iotjs_jval_copy_string(THIS_JVAL, char* buffer, size_t size);
+
+// The characters of a string in the internal encoding of the engine, borrowed
+// from it where it keeps them in one piece, and copied otherwise. They are not
+// zero terminated, and are valid while the string is alive.
+typedef struct {
+  // The characters, or NULL if they are copied into `inline_data`.
+  const char* data;
+  size_t size;
+  bool copied;
+  char inline_data[16];
+} IOTJS_VALIDATED_STRUCT(iotjs_string_view_t);
+
+iotjs_string_view_t iotjs_jval_as_string_view(THIS_JVAL);
+const char* iotjs_string_view_data(const iotjs_string_view_t* view);
+size_t iotjs_string_view_size(const iotjs_string_view_t* view);
+void iotjs_string_view_destroy(iotjs_string_view_t* view);
+
 /* Methods for General JavaScript Object */
 bool iotjs_jval_set_prototype(const iotjs_jval_t* jobj, iotjs_jval_t* jproto);
 void iotjs_jval_set_method(THIS_JVAL, const char* name,
@@ -130,27 +202,81 @@ void iotjs_jval_set_property_string_raw(THIS_JVAL, const char* name,
 
 iotjs_jval_t iotjs_jval_get_property(THIS_JVAL, const char* name);
 
+void iotjs_jval_set_property_jval_by_key(THIS_JVAL, iotjs_propkey_t key,
+                                         const iotjs_jval_t* value);
+void iotjs_jval_set_property_boolean_by_key(THIS_JVAL, iotjs_propkey_t key,
+                                            bool v);
+void iotjs_jval_set_property_number_by_key(THIS_JVAL, iotjs_propkey_t key,
+                                           double v);
+void iotjs_jval_set_property_string_by_key(THIS_JVAL, iotjs_propkey_t key,
+                                           const iotjs_string_t* v);
+void iotjs_jval_set_property_string_raw_by_key(THIS_JVAL, iotjs_propkey_t key,
+                                               const char* v);
+
+iotjs_jval_t iotjs_jval_get_property_by_key(THIS_JVAL, iotjs_propkey_t key);
+
+void iotjs_jval_set_property_hidden_by_key(THIS_JVAL, iotjs_propkey_t key,
+                                           const iotjs_jval_t* value);
+void iotjs_jval_set_property_readonly_by_key(THIS_JVAL, iotjs_propkey_t key,
+                                             const iotjs_jval_t* value);
+void iotjs_jval_set_accessor(THIS_JVAL, const char* name,
+                             iotjs_native_handler_t getter,
+                             iotjs_native_handler_t setter);
+
 void iotjs_jval_set_object_native_handle(THIS_JVAL, uintptr_t ptr,
                                          JNativeInfoType* native_info);
 uintptr_t iotjs_jval_get_object_native_handle(THIS_JVAL);
+// The native handle of an object created with `native_info`, or 0 if `jval`
+// is not one.
+uintptr_t iotjs_jval_get_object_native_handle_of(THIS_JVAL,
+                                                 JNativeInfoType* native_info);
 uintptr_t iotjs_jval_get_object_from_jhandler(iotjs_jhandler_t* jhandler,
                                               JNativeInfoType* native_info);
 uintptr_t iotjs_jval_get_arg_obj_from_jhandler(iotjs_jhandler_t* jhandler,
                                                uint16_t index,
                                                JNativeInfoType* native_info);
 
+/* Methods for ArrayBuffer Object */
+bool iotjs_jval_is_arraybuffer_supported();
+iotjs_jval_t iotjs_jval_create_arraybuffer_external(char* data, size_t len,
+                                                   JFreeHandlerType free_cb);
+char* iotjs_jval_get_arraybuffer_pointer(THIS_JVAL);
+size_t iotjs_jval_get_arraybuffer_length(THIS_JVAL);
+
+/* Methods for Promise Object */
+bool iotjs_jval_is_promise_supported();
+iotjs_jval_t iotjs_jval_create_promise();
+// Resolves the promise with `value`, or rejects it with `value` as the reason.
+void iotjs_jval_settle_promise(THIS_JVAL, const iotjs_jval_t* value,
+                               bool is_resolve);
+
 void iotjs_jval_set_property_by_index(THIS_JVAL, uint32_t idx,
                                       const iotjs_jval_t* value);
 iotjs_jval_t iotjs_jval_get_property_by_index(THIS_JVAL, uint32_t idx);
 
+// Properties named by a string value, e.g. a key decoded from a message.
+void iotjs_jval_set_property_by_jval(THIS_JVAL, const iotjs_jval_t* jkey,
+                                     const iotjs_jval_t* value);
+iotjs_jval_t iotjs_jval_get_property_by_jval(THIS_JVAL,
+                                             const iotjs_jval_t* jkey);
+
+// The names of the own enumerable properties, as Object.keys() gives them.
+iotjs_jval_t iotjs_jval_get_keys(THIS_JVAL);
+
 
 #undef THIS_JVAL
 
 
+// Arguments of most callbacks fit in the storage of the jargs itself, so that
+// creating them does not allocate. `argv` is only used for larger capacities,
+// and is NULL otherwise, since jargs are passed by value.
+#define IOTJS_JARGS_INLINE_CAPACITY 4
+
 typedef struct {
   uint16_t capacity;
   uint16_t argc;
   iotjs_jval_t* argv;
+  iotjs_jval_t inline_argv[IOTJS_JARGS_INLINE_CAPACITY];
 } IOTJS_VALIDATED_STRUCT(iotjs_jargs_t);
 
 
@@ -194,8 +320,23 @@ iotjs_jval_t iotjs_jhelper_eval(const char* name, size_t name_len,
                                 bool strict_mode, bool* throws);
 #ifdef ENABLE_SNAPSHOT
 // Evaluates javascript snapshot.
+// The byte code should be copied if the snapshot buffer is to be freed.
 iotjs_jval_t iotjs_jhelper_exec_snapshot(const void* snapshot_p,
-                                         size_t snapshot_size, bool* throws);
+                                         size_t snapshot_size,
+                                         bool copy_bytecode, bool* throws);
+// Evaluates the module of the given index in a snapshot of several modules.
+iotjs_jval_t iotjs_jhelper_exec_multi_snapshot(const void* snapshot_p,
+                                               size_t snapshot_size,
+                                               uint32_t index,
+                                               bool copy_bytecode,
+                                               bool* throws);
+#endif
+
+#ifdef ENABLE_CODE_CACHE
+// Saves the snapshot of a source to be evaluated. Returns the snapshot size,
+// or 0 if the source has an error or the buffer is too small.
+size_t iotjs_jhelper_save_snapshot(const uint8_t* data, size_t size,
+                                   uint32_t* snapshot_p, size_t snapshot_size);
 #endif
 
 
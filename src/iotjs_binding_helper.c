@@ -14,6 +14,7 @@
  */
 
 #include "iotjs_def.h"
+#include "iotjs_probes.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -72,31 +73,115 @@ void iotjs_process_emit_exit(int code) {
 }
 
 
-// Calls next tick callbacks registered via `process.nextTick()`.
+// Callbacks registered via `process.nextTick()`, with their arguments, in a
+// ring buffer growing as needed.
+typedef struct {
+  iotjs_jval_t jcallback;
+  iotjs_jval_t jargs; // undefined, or an array of the arguments
+} iotjs_next_tick_t;
+
+static iotjs_next_tick_t* next_ticks = NULL;
+static size_t next_tick_head = 0;
+static size_t next_tick_length = 0;
+static size_t next_tick_capacity = 0;
+
+#define NEXT_TICK_INITIAL_CAPACITY 16
+
+
+void iotjs_process_queue_next_tick(const iotjs_jval_t* jcallback,
+                                   const iotjs_jval_t* jargs) {
+  if (next_tick_length == next_tick_capacity) {
+    size_t capacity = next_tick_capacity > 0 ? next_tick_capacity * 2
+                                             : NEXT_TICK_INITIAL_CAPACITY;
+    iotjs_next_tick_t* ticks = (iotjs_next_tick_t*)iotjs_buffer_allocate(
+        capacity * sizeof(iotjs_next_tick_t));
+    for (size_t i = 0; i < next_tick_length; ++i) {
+      ticks[i] = next_ticks[(next_tick_head + i) % next_tick_capacity];
+    }
+    if (next_ticks != NULL) {
+      iotjs_buffer_release((char*)next_ticks);
+    }
+    next_ticks = ticks;
+    next_tick_head = 0;
+    next_tick_capacity = capacity;
+  }
+
+  iotjs_next_tick_t* tick =
+      &next_ticks[(next_tick_head + next_tick_length) % next_tick_capacity];
+  tick->jcallback = iotjs_jval_create_copied(jcallback);
+  tick->jargs = iotjs_jval_create_copied(jargs);
+  next_tick_length++;
+}
+
+
+bool iotjs_process_has_next_tick() {
+  return next_tick_length > 0;
+}
+
+
+// Calls next tick callbacks registered via `process.nextTick()`. The ones
+// queued so far go to JS at once, as an array of callback and arguments
+// pairs; the ones they queue run in the next call. Returns true if there are
+// more to run.
 bool iotjs_process_next_tick() {
   iotjs_environment_t* env = iotjs_environment_get();
 
-  if (iotjs_environment_is_exiting(env)) {
+  if (iotjs_environment_is_exiting(env) || next_tick_length == 0) {
     return false;
   }
 
+  size_t count = next_tick_length;
+  iotjs_jval_t jticks = iotjs_jval_create_array((uint32_t)(count * 2));
+  for (size_t i = 0; i < count; ++i) {
+    iotjs_next_tick_t* tick = &next_ticks[next_tick_head];
+    iotjs_jval_set_property_by_index(&jticks, (uint32_t)(i * 2),
+                                     &tick->jcallback);
+    iotjs_jval_set_property_by_index(&jticks, (uint32_t)(i * 2 + 1),
+                                     &tick->jargs);
+    iotjs_jval_destroy(&tick->jcallback);
+    iotjs_jval_destroy(&tick->jargs);
+    next_tick_head = (next_tick_head + 1) % next_tick_capacity;
+  }
+  next_tick_length -= count;
+
   const iotjs_jval_t* process = iotjs_module_get(MODULE_PROCESS);
 
   iotjs_jval_t jon_next_tick =
-      iotjs_jval_get_property(process, IOTJS_MAGIC_STRING__ONNEXTTICK);
+      iotjs_jval_get_property_by_key(process, IOTJS_PROPKEY__ONNEXTTICK);
   IOTJS_ASSERT(iotjs_jval_is_function(&jon_next_tick));
 
+  iotjs_jargs_t jargs = iotjs_jargs_create(1);
+  iotjs_jargs_append_jval(&jargs, &jticks);
+
   iotjs_jval_t jres =
       iotjs_jhelper_call_ok(&jon_next_tick, iotjs_jval_get_undefined(),
-                            iotjs_jargs_get_empty());
-
-  IOTJS_ASSERT(iotjs_jval_is_boolean(&jres));
+                            &jargs);
 
-  bool ret = iotjs_jval_as_boolean(&jres);
   iotjs_jval_destroy(&jres);
+  iotjs_jargs_destroy(&jargs);
+  iotjs_jval_destroy(&jticks);
   iotjs_jval_destroy(&jon_next_tick);
 
-  return ret;
+  return next_tick_length > 0;
+}
+
+
+// Drops the callbacks not run before exit.
+void iotjs_process_next_tick_cleanup() {
+  while (next_tick_length > 0) {
+    iotjs_next_tick_t* tick = &next_ticks[next_tick_head];
+    iotjs_jval_destroy(&tick->jcallback);
+    iotjs_jval_destroy(&tick->jargs);
+    next_tick_head = (next_tick_head + 1) % next_tick_capacity;
+    next_tick_length--;
+  }
+
+  if (next_ticks != NULL) {
+    iotjs_buffer_release((char*)next_ticks);
+    next_ticks = NULL;
+  }
+  next_tick_head = 0;
+  next_tick_capacity = 0;
 }
 
 
@@ -117,12 +202,15 @@ iotjs_jval_t iotjs_make_callback_with_result(const iotjs_jval_t* jfunction,
                                              const iotjs_jargs_t* jargs) {
   // Merge PR 1496 (iotjs) to resolve Issue 106 (libtuv)
   // If the environment is already exiting just return an undefined value.
+  // It is a copy, as the caller destroys it.
   if (iotjs_environment_is_exiting(iotjs_environment_get())) {
-    return *iotjs_jval_get_undefined();
+    return iotjs_jval_create_copied(iotjs_jval_get_undefined());
   }
   // Calls back the function.
+  IOTJS_PROBE1(callback__entry, iotjs_jargs_length(jargs));
   bool throws;
   iotjs_jval_t jres = iotjs_jhelper_call(jfunction, jthis, jargs, &throws);
+  IOTJS_PROBE1(callback__return, throws);
   if (throws) {
     iotjs_uncaught_exception(&jres);
   }
@@ -135,6 +223,168 @@ iotjs_jval_t iotjs_make_callback_with_result(const iotjs_jval_t* jfunction,
 }
 
 
+// Callbacks deferred by native modules to the end of the libtuv pass of an
+// iteration of the event loop, in a ring buffer for each lane, growing as
+// needed.
+typedef struct {
+  iotjs_jval_t jfunction;
+  iotjs_jval_t jthis;
+  iotjs_jargs_t jargs;
+  iotjs_lane_callback_done_t done;
+} iotjs_lane_callback_t;
+
+typedef struct {
+  iotjs_lane_callback_t* callbacks;
+  size_t head;
+  size_t length;
+  size_t capacity;
+} iotjs_callback_lane_queue_t;
+
+static iotjs_callback_lane_queue_t callback_lanes[kCallbackLaneCount];
+
+#define CALLBACK_LANE_INITIAL_CAPACITY 16
+
+// Callbacks of each lane run in an iteration of the event loop, from the
+// highest lane on. The ones left run in the next iteration, after libtuv has
+// polled for I/O without blocking, so that no lane starves the others.
+static const uint32_t callback_lane_budgets[kCallbackLaneCount] = {
+  IOTJS_CALLBACK_LANE_HIGH_BUDGET, IOTJS_CALLBACK_LANE_NORMAL_BUDGET,
+  IOTJS_CALLBACK_LANE_LOW_BUDGET,
+};
+
+
+void iotjs_make_callback_in_lane(iotjs_callback_lane_t lane,
+                                 const iotjs_jval_t* jfunction,
+                                 const iotjs_jval_t* jthis,
+                                 const iotjs_jargs_t* jargs) {
+  iotjs_make_callback_in_lane_then(lane, jfunction, jthis, jargs, NULL);
+}
+
+
+void iotjs_make_callback_in_lane_then(iotjs_callback_lane_t lane,
+                                      const iotjs_jval_t* jfunction,
+                                      const iotjs_jval_t* jthis,
+                                      const iotjs_jargs_t* jargs,
+                                      iotjs_lane_callback_done_t done) {
+  IOTJS_ASSERT(lane < kCallbackLaneCount);
+  // As iotjs_make_callback(), nothing is called back once exiting.
+  if (iotjs_environment_is_exiting(iotjs_environment_get())) {
+    return;
+  }
+  iotjs_callback_lane_queue_t* queue = &callback_lanes[lane];
+
+  if (queue->length == queue->capacity) {
+    size_t capacity = queue->capacity > 0 ? queue->capacity * 2
+                                          : CALLBACK_LANE_INITIAL_CAPACITY;
+    iotjs_lane_callback_t* callbacks =
+        (iotjs_lane_callback_t*)iotjs_buffer_allocate(
+            capacity * sizeof(iotjs_lane_callback_t));
+    for (size_t i = 0; i < queue->length; ++i) {
+      callbacks[i] = queue->callbacks[(queue->head + i) % queue->capacity];
+    }
+    if (queue->callbacks != NULL) {
+      iotjs_buffer_release((char*)queue->callbacks);
+    }
+    queue->callbacks = callbacks;
+    queue->head = 0;
+    queue->capacity = capacity;
+  }
+
+  iotjs_lane_callback_t* callback =
+      &queue->callbacks[(queue->head + queue->length) % queue->capacity];
+  callback->jfunction = iotjs_jval_create_copied(jfunction);
+  callback->jthis = iotjs_jval_create_copied(jthis);
+
+  // A callback without arguments gets the shared empty arguments, which are
+  // never destroyed.
+  uint16_t argc = iotjs_jargs_length(jargs);
+  if (argc > 0) {
+    callback->jargs = iotjs_jargs_create(argc);
+    for (uint16_t i = 0; i < argc; ++i) {
+      iotjs_jargs_append_jval(&callback->jargs, iotjs_jargs_get(jargs, i));
+    }
+  } else {
+    callback->jargs = *iotjs_jargs_get_empty();
+  }
+  callback->done = done;
+  queue->length++;
+}
+
+
+bool iotjs_has_lane_callbacks() {
+  for (int lane = 0; lane < kCallbackLaneCount; ++lane) {
+    if (callback_lanes[lane].length > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+static void iotjs_lane_callback_destroy(iotjs_lane_callback_t* callback) {
+  iotjs_jval_destroy(&callback->jfunction);
+  iotjs_jval_destroy(&callback->jthis);
+  if (iotjs_jargs_length(&callback->jargs) > 0) {
+    iotjs_jargs_destroy(&callback->jargs);
+  }
+}
+
+
+// Makes the deferred callbacks, each from the highest lane that has some and
+// has not used its budget, so that the callbacks queued to a higher lane by
+// a callback run next. Returns true if there are more to run.
+bool iotjs_run_lane_callbacks() {
+  iotjs_environment_t* env = iotjs_environment_get();
+  uint32_t budgets[kCallbackLaneCount];
+  memcpy(budgets, callback_lane_budgets, sizeof(budgets));
+
+  while (!iotjs_environment_is_exiting(env)) {
+    int lane = 0;
+    while (lane < kCallbackLaneCount &&
+           (callback_lanes[lane].length == 0 || budgets[lane] == 0)) {
+      lane++;
+    }
+    if (lane == kCallbackLaneCount) {
+      break;
+    }
+
+    iotjs_callback_lane_queue_t* queue = &callback_lanes[lane];
+    iotjs_lane_callback_t callback = queue->callbacks[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->length--;
+    budgets[lane]--;
+
+    iotjs_make_callback(&callback.jfunction, &callback.jthis, &callback.jargs);
+    if (callback.done != NULL) {
+      callback.done(&callback.jthis);
+    }
+    iotjs_lane_callback_destroy(&callback);
+  }
+
+  return iotjs_has_lane_callbacks();
+}
+
+
+// Drops the callbacks not made before exit.
+void iotjs_lane_callbacks_cleanup() {
+  for (int lane = 0; lane < kCallbackLaneCount; ++lane) {
+    iotjs_callback_lane_queue_t* queue = &callback_lanes[lane];
+    while (queue->length > 0) {
+      iotjs_lane_callback_destroy(&queue->callbacks[queue->head]);
+      queue->head = (queue->head + 1) % queue->capacity;
+      queue->length--;
+    }
+
+    if (queue->callbacks != NULL) {
+      iotjs_buffer_release((char*)queue->callbacks);
+      queue->callbacks = NULL;
+    }
+    queue->head = 0;
+    queue->capacity = 0;
+  }
+}
+
+
 int iotjs_process_exitcode() {
   const iotjs_jval_t* process = iotjs_module_get(MODULE_PROCESS);
 
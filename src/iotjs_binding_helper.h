@@ -24,7 +24,11 @@ void iotjs_uncaught_exception(const iotjs_jval_t* jexception);
 
 void iotjs_process_emit_exit(int code);
 
+void iotjs_process_queue_next_tick(const iotjs_jval_t* jcallback,
+                                   const iotjs_jval_t* jargs);
+bool iotjs_process_has_next_tick();
 bool iotjs_process_next_tick();
+void iotjs_process_next_tick_cleanup();
 
 void iotjs_make_callback(const iotjs_jval_t* jfunction,
                          const iotjs_jval_t* jthis, const iotjs_jargs_t* jargs);
@@ -34,6 +38,43 @@ iotjs_jval_t iotjs_make_callback_with_result(const iotjs_jval_t* jfunction,
                                              const iotjs_jargs_t* jargs);
 
 
+// Lanes of the callbacks that native modules defer to the end of the libtuv
+// pass of an iteration of the event loop, where they are made by priority.
+// The callbacks of a lane are made in the order they were queued.
+typedef enum {
+  kCallbackLaneHigh,   // control plane, such as the peripherals
+  kCallbackLaneNormal, // data plane, such as the sockets
+  kCallbackLaneLow,    // background work
+  kCallbackLaneCount,
+} iotjs_callback_lane_t;
+
+// Callbacks of each lane made in an iteration of the event loop.
+#ifndef IOTJS_CALLBACK_LANE_HIGH_BUDGET
+#define IOTJS_CALLBACK_LANE_HIGH_BUDGET 64
+#endif
+#ifndef IOTJS_CALLBACK_LANE_NORMAL_BUDGET
+#define IOTJS_CALLBACK_LANE_NORMAL_BUDGET 32
+#endif
+#ifndef IOTJS_CALLBACK_LANE_LOW_BUDGET
+#define IOTJS_CALLBACK_LANE_LOW_BUDGET 8
+#endif
+
+void iotjs_make_callback_in_lane(iotjs_callback_lane_t lane,
+                                 const iotjs_jval_t* jfunction,
+                                 const iotjs_jval_t* jthis,
+                                 const iotjs_jargs_t* jargs);
+// As iotjs_make_callback_in_lane(), and calls `done` with `jthis` once the
+// callback has been made.
+typedef void (*iotjs_lane_callback_done_t)(const iotjs_jval_t* jthis);
+void iotjs_make_callback_in_lane_then(iotjs_callback_lane_t lane,
+                                      const iotjs_jval_t* jfunction,
+                                      const iotjs_jval_t* jthis,
+                                      const iotjs_jargs_t* jargs,
+                                      iotjs_lane_callback_done_t done);
+bool iotjs_has_lane_callbacks();
+bool iotjs_run_lane_callbacks();
+void iotjs_lane_callbacks_cleanup();
+
 const iotjs_jval_t* iotjs_init_process_module();
 
 int iotjs_process_exitcode();
@@ -0,0 +1,321 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // pthread_setaffinity_np()
+#endif
+
+#include "iotjs_def.h"
+#include "iotjs_busqueue.h"
+
+#include <string.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+struct iotjs_busqueue_s {
+  iotjs_string_t path;
+  // The devices on the bus, and the requests not completed yet.
+  uint32_t devices;
+  uint32_t in_flight;
+  bool stopped;
+  bool closed;
+
+  uv_thread_t thread;
+  // The SCHED_FIFO priority of the thread, or 0, and its CPU, or -1.
+  int priority;
+  int cpu;
+  uv_mutex_t mutex;
+  uv_cond_t cond;
+  bool stopping;
+  // The requests for the worker, oldest first.
+  iotjs_bus_work_t* pending_head;
+  iotjs_bus_work_t* pending_tail;
+  // The requests it ran, newest first. The worker pushes them without a
+  // lock, and the loop takes them all at once.
+  iotjs_bus_work_t* done;
+  uv_async_t async;
+
+  iotjs_busqueue_t* next;
+};
+
+
+// The running queues, on the loop thread.
+static iotjs_busqueue_t* busqueues = NULL;
+
+// The queue of the other peripherals, with --peripheral-thread.
+static iotjs_busqueue_t* peripheral_queue = NULL;
+
+
+static void iotjs_busqueue_push_done(iotjs_busqueue_t* queue,
+                                     iotjs_bus_work_t* work) {
+  iotjs_bus_work_t* done = __atomic_load_n(&queue->done, __ATOMIC_RELAXED);
+  do {
+    work->next = done;
+  } while (!__atomic_compare_exchange_n(&queue->done, &done, work, true,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+
+// Raises the thread of `queue` to its real-time priority, and pins it to
+// its CPU. Without the privilege, it keeps running as any other thread.
+static void iotjs_busqueue_schedule(iotjs_busqueue_t* queue) {
+#if defined(__linux__)
+  if (queue->priority > 0) {
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = queue->priority;
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+      DLOG("Cannot raise the priority of bus %s: %s",
+           iotjs_string_data(&queue->path), strerror(err));
+    }
+  }
+
+  if (queue->cpu >= 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET((size_t)queue->cpu, &cpus);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (err != 0) {
+      DLOG("Cannot pin bus %s to CPU %d: %s", iotjs_string_data(&queue->path),
+           queue->cpu, strerror(err));
+    }
+  }
+#endif
+}
+
+
+static void iotjs_busqueue_worker(void* data) {
+  iotjs_busqueue_t* queue = (iotjs_busqueue_t*)data;
+
+  iotjs_busqueue_schedule(queue);
+
+  uv_mutex_lock(&queue->mutex);
+  for (;;) {
+    while (queue->pending_head == NULL && !queue->stopping) {
+      uv_cond_wait(&queue->cond, &queue->mutex);
+    }
+    if (queue->pending_head == NULL) {
+      break;
+    }
+
+    iotjs_bus_work_t* work = queue->pending_head;
+    queue->pending_head = queue->pending_tail = NULL;
+    uv_mutex_unlock(&queue->mutex);
+
+    while (work != NULL) {
+      // The link of a request is reused by the done list.
+      iotjs_bus_work_t* next = work->next;
+      work->req.work_cb(&work->req);
+      iotjs_busqueue_push_done(queue, work);
+      work = next;
+    }
+    uv_async_send(&queue->async);
+
+    uv_mutex_lock(&queue->mutex);
+  }
+  uv_mutex_unlock(&queue->mutex);
+}
+
+
+static void iotjs_busqueue_complete(iotjs_busqueue_t* queue) {
+  iotjs_bus_work_t* done = __atomic_exchange_n(&queue->done, NULL,
+                                               __ATOMIC_ACQUIRE);
+
+  // Oldest first, as they were queued.
+  iotjs_bus_work_t* work = NULL;
+  while (done != NULL) {
+    iotjs_bus_work_t* next = done->next;
+    done->next = work;
+    work = done;
+    done = next;
+  }
+
+  while (work != NULL) {
+    // The request may be reused by its callback.
+    iotjs_bus_work_t* next = work->next;
+    work->req.after_work_cb(&work->req, 0);
+    if (--queue->in_flight == 0 && !queue->stopped) {
+      uv_unref((uv_handle_t*)&queue->async);
+    }
+    work = next;
+  }
+}
+
+
+static void iotjs_busqueue_free(iotjs_busqueue_t* queue) {
+  uv_mutex_destroy(&queue->mutex);
+  uv_cond_destroy(&queue->cond);
+  iotjs_string_destroy(&queue->path);
+  IOTJS_RELEASE(queue);
+}
+
+
+static void iotjs_busqueue_close_cb(uv_handle_t* handle) {
+  iotjs_busqueue_t* queue = (iotjs_busqueue_t*)handle->data;
+
+  queue->closed = true;
+  if (queue->devices == 0 && queue->in_flight == 0) {
+    iotjs_busqueue_free(queue);
+  }
+}
+
+
+// Runs the requests left on the thread, and takes the queue off the list.
+static void iotjs_busqueue_stop(iotjs_busqueue_t* queue) {
+  uv_mutex_lock(&queue->mutex);
+  queue->stopping = true;
+  uv_cond_signal(&queue->cond);
+  uv_mutex_unlock(&queue->mutex);
+  uv_thread_join(&queue->thread);
+
+  queue->stopped = true;
+  iotjs_busqueue_t** link = &busqueues;
+  while (*link != queue) {
+    link = &(*link)->next;
+  }
+  *link = queue->next;
+}
+
+
+// Closes the queue once it is neither used nor busy.
+static void iotjs_busqueue_close(iotjs_busqueue_t* queue) {
+  if (queue->devices > 0 || queue->in_flight > 0) {
+    return;
+  }
+
+  if (queue->closed) {
+    iotjs_busqueue_free(queue);
+  } else if (!queue->stopped) {
+    iotjs_busqueue_stop(queue);
+    uv_close((uv_handle_t*)&queue->async, iotjs_busqueue_close_cb);
+  } else {
+    // Stopped by iotjs_busqueue_cleanup(), and freed by its close callback.
+  }
+}
+
+
+static void iotjs_busqueue_async_cb(uv_async_t* handle) {
+  iotjs_busqueue_t* queue = (iotjs_busqueue_t*)handle->data;
+
+  iotjs_busqueue_complete(queue);
+  iotjs_busqueue_close(queue);
+}
+
+
+iotjs_busqueue_t* iotjs_busqueue_acquire(const char* path) {
+  for (iotjs_busqueue_t* queue = busqueues; queue != NULL;
+       queue = queue->next) {
+    if (strcmp(iotjs_string_data(&queue->path), path) == 0) {
+      queue->devices++;
+      return queue;
+    }
+  }
+
+  iotjs_busqueue_t* queue = IOTJS_ALLOC(iotjs_busqueue_t);
+  queue->path = iotjs_string_create_with_size(path, strlen(path));
+  queue->devices = 1;
+  const Config* config = iotjs_environment_config(iotjs_environment_get());
+  queue->priority = config->peripheral_priority;
+  queue->cpu = config->peripheral_cpu;
+  uv_mutex_init(&queue->mutex);
+  uv_cond_init(&queue->cond);
+  uv_async_init(iotjs_environment_loop(iotjs_environment_get()),
+                &queue->async, iotjs_busqueue_async_cb);
+  queue->async.data = queue;
+  // Only the requests in flight keep the loop alive.
+  uv_unref((uv_handle_t*)&queue->async);
+
+  if (uv_thread_create(&queue->thread, iotjs_busqueue_worker, queue) != 0) {
+    DLOG("Cannot start the queue of bus %s", path);
+    queue->stopped = true;
+    queue->devices = 0;
+    uv_close((uv_handle_t*)&queue->async, iotjs_busqueue_close_cb);
+    return NULL;
+  }
+
+  queue->next = busqueues;
+  busqueues = queue;
+  return queue;
+}
+
+
+void iotjs_busqueue_release(iotjs_busqueue_t* queue) {
+  IOTJS_ASSERT(queue->devices > 0);
+  queue->devices--;
+  iotjs_busqueue_close(queue);
+}
+
+
+void iotjs_busqueue_work(iotjs_busqueue_t* queue, iotjs_bus_work_t* work,
+                         uv_work_cb work_cb, uv_after_work_cb after_work_cb) {
+  uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());
+
+  if (queue == NULL || queue->stopped) {
+    uv_queue_work(loop, &work->req, work_cb, after_work_cb);
+    return;
+  }
+
+  work->req.loop = loop;
+  work->req.work_cb = work_cb;
+  work->req.after_work_cb = after_work_cb;
+  work->next = NULL;
+
+  if (queue->in_flight++ == 0) {
+    uv_ref((uv_handle_t*)&queue->async);
+  }
+
+  uv_mutex_lock(&queue->mutex);
+  if (queue->pending_tail != NULL) {
+    queue->pending_tail->next = work;
+  } else {
+    queue->pending_head = work;
+  }
+  queue->pending_tail = work;
+  uv_cond_signal(&queue->cond);
+  uv_mutex_unlock(&queue->mutex);
+}
+
+
+iotjs_busqueue_t* iotjs_busqueue_peripheral() {
+  const Config* config = iotjs_environment_config(iotjs_environment_get());
+  if (config->peripheral_priority == 0) {
+    return NULL;
+  }
+
+  if (peripheral_queue == NULL) {
+    peripheral_queue = iotjs_busqueue_acquire("peripheral");
+  }
+  return peripheral_queue;
+}
+
+
+void iotjs_busqueue_cleanup() {
+  if (peripheral_queue != NULL) {
+    iotjs_busqueue_release(peripheral_queue);
+    peripheral_queue = NULL;
+  }
+
+  while (busqueues != NULL) {
+    iotjs_busqueue_t* queue = busqueues;
+    iotjs_busqueue_stop(queue);
+    iotjs_busqueue_complete(queue);
+    uv_close((uv_handle_t*)&queue->async, iotjs_busqueue_close_cb);
+  }
+}
@@ -0,0 +1,57 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IOTJS_BUSQUEUE_H
+#define IOTJS_BUSQUEUE_H
+
+
+#include <uv.h>
+
+
+// The requests of the devices on one bus, such as /dev/i2c-1, are run in
+// the order they were queued by a thread of the bus, rather than by the
+// threadpool. They neither run concurrently with each other, nor wait
+// behind file system work. The requests a worker found queued when it woke
+// up are run in one go, and completed on the loop by one async signal.
+typedef struct iotjs_busqueue_s iotjs_busqueue_t;
+
+// A request of a bus queue. The work is passed to the callbacks as with
+// uv_queue_work(), so that its request wrapper is found from its `data`.
+typedef struct iotjs_bus_work_s {
+  uv_work_t req;
+  struct iotjs_bus_work_s* next;
+} iotjs_bus_work_t;
+
+// The queue of the bus at `path`, shared by the devices on it and created
+// by the first of them. Each device releases it when it is destroyed.
+iotjs_busqueue_t* iotjs_busqueue_acquire(const char* path);
+void iotjs_busqueue_release(iotjs_busqueue_t* queue);
+
+// The queue of the peripherals which are not on a bus, such as GPIO, PWM,
+// UART and ADC, when IoT.js was started with --peripheral-thread, or NULL.
+// The threads of all queues then run at a real-time priority.
+iotjs_busqueue_t* iotjs_busqueue_peripheral();
+
+// Queues `work` on `queue`, or on the threadpool if `queue` is NULL or
+// already stopped. `after_work_cb` is called on the loop.
+void iotjs_busqueue_work(iotjs_busqueue_t* queue, iotjs_bus_work_t* work,
+                         uv_work_cb work_cb, uv_after_work_cb after_work_cb);
+
+// Stops the threads of the queues before the loop is closed, and completes
+// the requests they ran.
+void iotjs_busqueue_cleanup();
+
+
+#endif /* IOTJS_BUSQUEUE_H */
@@ -28,6 +28,48 @@
 #endif
 #endif
 
+// Number of free read buffers kept for reuse in each size class.
+#ifndef IOTJS_READ_BUFFER_POOL_HIGH_WATER
+#if defined(__NUTTX__) || defined(__TIZENRT__)
+#define IOTJS_READ_BUFFER_POOL_HIGH_WATER 2
+#else
+#define IOTJS_READ_BUFFER_POOL_HIGH_WATER 8
+#endif
+#endif
+
+// Number of free request and handle wraps of each kind kept for reuse.
+#ifndef IOTJS_REQWRAP_POOL_CAP
+#if defined(__NUTTX__) || defined(__TIZENRT__)
+#define IOTJS_REQWRAP_POOL_CAP 4
+#define IOTJS_HANDLEWRAP_POOL_CAP 2
+#else
+#define IOTJS_REQWRAP_POOL_CAP 16
+#define IOTJS_HANDLEWRAP_POOL_CAP 8
+#endif
+#endif
+
+// Memory budget of the JS heap, the libtuv heap and the native buffers, in
+// bytes. 0 keeps the memory governor off unless --memory-budget is given.
+#ifndef IOTJS_MEMORY_BUDGET
+#define IOTJS_MEMORY_BUDGET 0
+#endif
+
+// Milliseconds a timeout may run late to share a wakeup with another one,
+// unless --timer-slack or timeout.setSlack() says otherwise.
+#ifndef IOTJS_TIMER_SLACK
+#define IOTJS_TIMER_SLACK 0
+#endif
+
+// Number of header fields the http parser collects before passing them to JS.
+// Headers of a message with more fields are passed in several calls.
+#ifndef IOTJS_HTTP_PARSER_HEADER_MAX
+#if defined(__NUTTX__) || defined(__TIZENRT__)
+#define IOTJS_HTTP_PARSER_HEADER_MAX 10
+#else
+#define IOTJS_HTTP_PARSER_HEADER_MAX 32
+#endif
+#endif
+
 
 #ifndef IOTJS_ASSERT
 #ifdef NDEBUG
@@ -20,6 +20,15 @@
 #include <string.h>
 
 
+// Percent of the heap the adaptive GC trigger leaves free by default
+#define IOTJS_GC_TRIGGER_RESERVE 10
+// GCs an empty heap segment is kept for reuse by default
+#define IOTJS_SEGMENT_RETENTION_AGE 4
+// Percents of the memory budget at which the pressure becomes moderate and
+// critical by default
+#define IOTJS_MEMORY_MODERATE_PERCENT 75
+#define IOTJS_MEMORY_CRITICAL_PERCENT 90
+
 static iotjs_environment_t current_env;
 static bool initialized = false;
 
@@ -72,6 +81,15 @@ static void iotjs_environment_initialize(iotjs_environment_t* env) {
   _this->config.show_opcode = false;
   _this->config.debugger = false;
   _this->config.debugger_port = 5001;
+  _this->config.memory_budget = IOTJS_MEMORY_BUDGET;
+  _this->config.memory_moderate_percent = IOTJS_MEMORY_MODERATE_PERCENT;
+  _this->config.memory_critical_percent = IOTJS_MEMORY_CRITICAL_PERCENT;
+  _this->config.timer_slack = IOTJS_TIMER_SLACK;
+  _this->config.peripheral_priority = 0;
+  _this->config.peripheral_cpu = -1;
+  memset(&_this->loop_stats, 0, sizeof(_this->loop_stats));
+  memset(&_this->startup_trace, 0, sizeof(_this->startup_trace));
+  _this->startup_trace.start = uv_hrtime();
 }
 
 
@@ -92,6 +110,112 @@ static void iotjs_environment_destroy(iotjs_environment_t* env) {
 }
 
 
+/**
+ * Parse reverse map cache option: <size>,<set size>[,<policy>[,fixed]]
+ */
+static bool iotjs_environment_parse_rmap_cache(Config* config,
+                                               const char* value) {
+  unsigned size = 0, set_size = 0;
+  char policy[8] = "lru";
+  char sizing[8] = "adaptive";
+  if (sscanf(value, "%u,%u,%7[^,],%7s", &size, &set_size, policy, sizing) < 2) {
+    return false;
+  }
+
+  if (!strcmp(policy, "fifo")) {
+    config->rmap_cache_policy = JERRY_RMAP_CACHE_POLICY_FIFO;
+  } else if (!strcmp(policy, "lru")) {
+    config->rmap_cache_policy = JERRY_RMAP_CACHE_POLICY_LRU;
+  } else if (!strcmp(policy, "clock")) {
+    config->rmap_cache_policy = JERRY_RMAP_CACHE_POLICY_CLOCK;
+  } else {
+    return false;
+  }
+
+  if (!strcmp(sizing, "adaptive")) {
+    config->is_rmap_cache_adaptive = true;
+  } else if (!strcmp(sizing, "fixed")) {
+    config->is_rmap_cache_adaptive = false;
+  } else {
+    return false;
+  }
+
+  config->rmap_cache_size = size;
+  config->rmap_cache_set_size = set_size;
+  return size != 0;
+}
+
+
+/**
+ * Get the jmem profiler category of a name, 0 for an unknown name.
+ */
+uint32_t iotjs_environment_jmem_profile_category(const char* name) {
+  static const struct {
+    const char* name;
+    uint32_t category;
+  } categories[] = {
+    { "size", JERRY_JMEM_PROFILE_SIZE },
+    { "time", JERRY_JMEM_PROFILE_TIME },
+    { "pmu", JERRY_JMEM_PROFILE_PMU },
+    { "cptl", JERRY_JMEM_PROFILE_CPTL },
+    { "segment", JERRY_JMEM_PROFILE_SEGMENT },
+    { "jsobject", JERRY_JMEM_PROFILE_JSOBJECT },
+    { "count", JERRY_JMEM_PROFILE_COUNT },
+    { "sampling", JERRY_JMEM_PROFILE_SAMPLING },
+    { "opcode", JERRY_JMEM_PROFILE_OPCODE },
+    { "cpu", JERRY_JMEM_PROFILE_CPU },
+    { "trace", JERRY_JMEM_PROFILE_TRACE },
+    { "all", JERRY_JMEM_PROFILE_ALL },
+  };
+
+  for (size_t i = 0; i < sizeof(categories) / sizeof(categories[0]); i++) {
+    if (!strcmp(name, categories[i].name)) {
+      return categories[i].category;
+    }
+  }
+  return 0;
+}
+
+
+/**
+ * Parse jmem profiler option: <category>[,<category>...] or none
+ */
+static bool iotjs_environment_parse_jmem_profile(Config* config,
+                                                 const char* value) {
+  uint32_t categories = 0;
+  if (*value == '\0') {
+    return false;
+  }
+
+  if (strcmp(value, "none")) {
+    while (*value != '\0') {
+      char name[16];
+      size_t name_len = strcspn(value, ",");
+      if (name_len == 0 || name_len >= sizeof(name)) {
+        return false;
+      }
+      memcpy(name, value, name_len);
+      name[name_len] = '\0';
+
+      uint32_t category = iotjs_environment_jmem_profile_category(name);
+      if (category == 0) {
+        return false;
+      }
+      categories |= category;
+
+      value += name_len;
+      if (*value == ',') {
+        value++;
+      }
+    }
+  }
+
+  config->is_jmem_profile_selected = true;
+  config->jmem_profile_categories = categories;
+  return true;
+}
+
+
 /**
  * Parse command line arguments
  */
@@ -103,12 +227,28 @@ bool iotjs_environment_parse_command_line_arguments(iotjs_environment_t* env,
   // Parse IoT.js command line arguments.
   uint32_t i = 1;
   uint8_t port_arg_len = strlen("--jerry-debugger-port=");
+  uint8_t rmap_cache_arg_len = strlen("--rmap-cache=");
+  uint8_t segment_size_arg_len = strlen("--segment-size=");
+  uint8_t segment_retention_arg_len = strlen("--segment-retention=");
+  uint8_t idle_gc_arg_len = strlen("--idle-gc=");
+  uint8_t profile_output_arg_len = strlen("--jmem-profile-output=");
+  uint8_t profile_format_arg_len = strlen("--jmem-profile-format=");
+  uint8_t profile_arg_len = strlen("--jmem-profile=");
+  uint8_t heap_snapshot_arg_len = strlen("--heap-snapshot=");
+  uint8_t threadpool_arg_len = strlen("--threadpool=");
+  uint8_t cpu_profile_arg_len = strlen("--cpu-profile-interval=");
+  uint8_t gc_trigger_arg_len = strlen("--gc-trigger=");
+  uint8_t memory_budget_arg_len = strlen("--memory-budget=");
+  uint8_t timer_slack_arg_len = strlen("--timer-slack=");
+  uint8_t peripheral_arg_len = strlen("--peripheral-thread=");
   _this->config.is_jerry_jmem_logs_enabled = true;
   while (i < argc && argv[i][0] == '-') {
     if (!strcmp(argv[i], "--memstat")) {
       _this->config.memstat = true;
     } else if (!strcmp(argv[i], "--show-opcodes")) {
       _this->config.show_opcode = true;
+    } else if (!strcmp(argv[i], "--startup-trace")) {
+      _this->config.startup_trace = true;
     } else if (!strcmp(argv[i], "--start-debug-server")) {
       _this->config.debugger = true;
     } else if (!strncmp(argv[i], "--jerry-debugger-port=", port_arg_len)) {
@@ -118,6 +258,146 @@ bool iotjs_environment_parse_command_line_arguments(iotjs_environment_t* env,
       sscanf(port, "%d", &(_this->config.debugger_port));
     } else if(!strcmp(argv[i], "--no-jmem-logs")) {
       _this->config.is_jerry_jmem_logs_enabled = false;
+    } else if (!strncmp(argv[i], "--rmap-cache=", rmap_cache_arg_len)) {
+      if (!iotjs_environment_parse_rmap_cache(&_this->config,
+                                              argv[i] + rmap_cache_arg_len)) {
+        fprintf(stderr, "invalid reverse map cache option: %s\n", argv[i]);
+        return false;
+      }
+    } else if (!strncmp(argv[i], "--segment-size=", segment_size_arg_len)) {
+      unsigned segment_size = 0;
+      if (sscanf(argv[i] + segment_size_arg_len, "%u", &segment_size) != 1 ||
+          segment_size == 0) {
+        fprintf(stderr, "invalid segment size option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.segment_size = segment_size;
+    } else if (!strncmp(argv[i], "--segment-retention=",
+                        segment_retention_arg_len)) {
+      // --segment-retention=<low>,<high>[,<age>]
+      unsigned low = 0;
+      unsigned high = 0;
+      unsigned age = IOTJS_SEGMENT_RETENTION_AGE;
+      if (sscanf(argv[i] + segment_retention_arg_len, "%u,%u,%u", &low, &high,
+                 &age) < 2 ||
+          low > high) {
+        fprintf(stderr, "invalid segment retention option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.is_segment_retention_set = true;
+      _this->config.segment_retention_low = low;
+      _this->config.segment_retention_high = high;
+      _this->config.segment_retention_age = age;
+    } else if (!strncmp(argv[i], "--idle-gc=", idle_gc_arg_len)) {
+      unsigned idle_gc_timeout = 0;
+      if (sscanf(argv[i] + idle_gc_arg_len, "%u", &idle_gc_timeout) != 1) {
+        fprintf(stderr, "invalid idle GC option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.idle_gc_timeout = idle_gc_timeout;
+    } else if (!strncmp(argv[i], "--gc-trigger=", gc_trigger_arg_len)) {
+      // --gc-trigger=<growth %>[,<min interval ms>[,<pause budget ms>
+      //              [,<reserve %>]]]
+      unsigned growth = 0;
+      unsigned min_interval = 0;
+      double pause_budget = 0;
+      unsigned reserve = IOTJS_GC_TRIGGER_RESERVE;
+      int count = sscanf(argv[i] + gc_trigger_arg_len, "%u,%u,%lf,%u", &growth,
+                         &min_interval, &pause_budget, &reserve);
+      if (count < 1 || pause_budget < 0 || reserve > 100) {
+        fprintf(stderr, "invalid GC trigger option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.gc_trigger.growth_percent = growth;
+      _this->config.gc_trigger.min_interval_ms = min_interval;
+      _this->config.gc_trigger.pause_budget_us =
+          (uint32_t)(pause_budget * 1000);
+      _this->config.gc_trigger.reserve_percent = reserve;
+    } else if (!strncmp(argv[i], "--jmem-profile-output=",
+                        profile_output_arg_len)) {
+      // A file descriptor can be given as /dev/fd/<fd>
+      _this->config.jmem_profile_output = argv[i] + profile_output_arg_len;
+    } else if (!strncmp(argv[i], "--jmem-profile-format=",
+                        profile_format_arg_len)) {
+      const char* format = argv[i] + profile_format_arg_len;
+      if (!strcmp(format, "json")) {
+        _this->config.jmem_profile_format = JERRY_JMEM_PROFILE_FORMAT_JSON;
+      } else if (!strcmp(format, "csv")) {
+        _this->config.jmem_profile_format = JERRY_JMEM_PROFILE_FORMAT_CSV;
+      } else {
+        fprintf(stderr, "invalid jmem profile format: %s\n", argv[i]);
+        return false;
+      }
+    } else if (!strncmp(argv[i], "--jmem-profile=", profile_arg_len)) {
+      if (!iotjs_environment_parse_jmem_profile(&_this->config,
+                                                argv[i] + profile_arg_len)) {
+        fprintf(stderr, "invalid jmem profile option: %s\n", argv[i]);
+        return false;
+      }
+    } else if (!strncmp(argv[i], "--heap-snapshot=", heap_snapshot_arg_len)) {
+      const char* path = argv[i] + heap_snapshot_arg_len;
+      if (*path == '\0') {
+        fprintf(stderr, "invalid heap snapshot option: %s\n", argv[i]);
+        return false;
+      }
+      // Snapshots are written to <path>.<n> on SIGUSR2
+      _this->config.heap_snapshot_path = path;
+    } else if (!strncmp(argv[i], "--cpu-profile-interval=",
+                        cpu_profile_arg_len)) {
+      unsigned interval = 0;
+      if (sscanf(argv[i] + cpu_profile_arg_len, "%u", &interval) != 1 ||
+          interval == 0) {
+        fprintf(stderr, "invalid CPU profile interval option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.cpu_profile_interval = interval;
+    } else if (!strncmp(argv[i], "--threadpool=", threadpool_arg_len)) {
+      // --threadpool=<size> or --threadpool=<size>,<max size>
+      unsigned size = 0;
+      unsigned max_size = 0;
+      int count = sscanf(argv[i] + threadpool_arg_len, "%u,%u", &size,
+                         &max_size);
+      if (count < 1 || size == 0 || (count == 2 && max_size < size)) {
+        fprintf(stderr, "invalid threadpool option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.threadpool_size = size;
+      _this->config.threadpool_max_size = count == 2 ? max_size : size;
+    } else if (!strncmp(argv[i], "--memory-budget=", memory_budget_arg_len)) {
+      // --memory-budget=<KB>[,<moderate %>[,<critical %>]], 0 KB for none
+      unsigned budget = 0;
+      unsigned moderate = IOTJS_MEMORY_MODERATE_PERCENT;
+      unsigned critical = IOTJS_MEMORY_CRITICAL_PERCENT;
+      int count = sscanf(argv[i] + memory_budget_arg_len, "%u,%u,%u", &budget,
+                         &moderate, &critical);
+      if (count < 1 || moderate > critical || critical > 100) {
+        fprintf(stderr, "invalid memory budget option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.memory_budget = (size_t)budget * 1024;
+      _this->config.memory_moderate_percent = moderate;
+      _this->config.memory_critical_percent = critical;
+    } else if (!strncmp(argv[i], "--timer-slack=", timer_slack_arg_len)) {
+      unsigned slack = 0;
+      if (sscanf(argv[i] + timer_slack_arg_len, "%u", &slack) != 1) {
+        fprintf(stderr, "invalid timer slack option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.timer_slack = slack;
+    } else if (!strncmp(argv[i], "--peripheral-thread=",
+                        peripheral_arg_len)) {
+      // --peripheral-thread=<priority>[,<cpu>]
+      int priority = 0;
+      int cpu = -1;
+      int count = sscanf(argv[i] + peripheral_arg_len, "%d,%d", &priority,
+                         &cpu);
+      if (count < 1 || priority < 1 || priority > 99 ||
+          (count == 2 && cpu < 0)) {
+        fprintf(stderr, "invalid peripheral thread option: %s\n", argv[i]);
+        return false;
+      }
+      _this->config.peripheral_priority = priority;
+      _this->config.peripheral_cpu = cpu;
     } else {
       fprintf(stderr, "unknown command line option: %s\n", argv[i]);
       return false;
@@ -182,6 +462,51 @@ const Config* iotjs_environment_config(const iotjs_environment_t* env) {
 }
 
 
+iotjs_loop_stats_t* iotjs_environment_loop_stats(iotjs_environment_t* env) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_environment_t, env);
+  return &_this->loop_stats;
+}
+
+
+static const char* startup_phase_names[kStartupPhaseCount] = {
+  "arguments", "jerryInit", "debugger", "magicStrings", "global",
+  "moduleList", "process", "iotjsJs", "mainModule", "firstLoop",
+};
+
+
+// Each phase is marked once, when it ends.
+void iotjs_environment_mark_startup(iotjs_environment_t* env,
+                                    iotjs_startup_phase_t phase) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_environment_t, env);
+  IOTJS_ASSERT(phase < kStartupPhaseCount);
+  if (_this->startup_trace.phase_end[phase] == 0) {
+    _this->startup_trace.phase_end[phase] = uv_hrtime();
+  }
+}
+
+
+const iotjs_startup_trace_t* iotjs_environment_startup_trace(
+    const iotjs_environment_t* env) {
+  const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_environment_t, env);
+  return &_this->startup_trace;
+}
+
+
+const char* iotjs_environment_startup_phase_name(iotjs_startup_phase_t phase) {
+  return phase < kStartupPhaseCount ? startup_phase_names[phase] : NULL;
+}
+
+
+iotjs_startup_phase_t iotjs_environment_startup_phase_of(const char* name) {
+  int phase = 0;
+  while (phase < kStartupPhaseCount &&
+         strcmp(startup_phase_names[phase], name) != 0) {
+    phase++;
+  }
+  return (iotjs_startup_phase_t)phase;
+}
+
+
 void iotjs_environment_go_state_running_main(iotjs_environment_t* env) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_environment_t, env);
 
@@ -202,6 +527,9 @@ void iotjs_environment_go_state_exiting(iotjs_environment_t* env) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_environment_t, env);
   IOTJS_ASSERT(_this->state < kExiting);
   _this->state = kExiting;
+
+  // The script running now is stopped at its next loop iteration.
+  jerry_request_vm_exec_stop();
 }
 
 bool iotjs_environment_is_exiting(iotjs_environment_t* env) {
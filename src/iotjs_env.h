@@ -16,6 +16,7 @@
 #ifndef IOTJS_ENV_H
 #define IOTJS_ENV_H
 
+#include "jerryscript.h"
 #include "uv.h"
 
 
@@ -25,8 +26,71 @@ typedef struct {
   bool debugger;
   int debugger_port;
   bool is_jerry_jmem_logs_enabled;
+  uint32_t rmap_cache_size; // 0 for the default configuration
+  uint32_t rmap_cache_set_size;
+  jerry_rmap_cache_policy_t rmap_cache_policy;
+  bool is_rmap_cache_adaptive;
+  uint32_t segment_size; // 0 for the default segment size
+  bool is_segment_retention_set; // false to keep the build-time retention
+  uint32_t segment_retention_low; // empty segments kept however long unused
+  uint32_t segment_retention_high; // most empty segments kept
+  uint32_t segment_retention_age; // GCs an empty segment is kept
+  uint32_t idle_gc_timeout; // milliseconds, 0 to disable idle-time GC
+  jerry_gc_trigger_t gc_trigger; // growth_percent 0 for the fixed GC trigger
+  const char* jmem_profile_output; // NULL for legacy log files, "-" = stdout
+  jerry_jmem_profile_format_t jmem_profile_format;
+  bool is_jmem_profile_selected; // false to keep the build-time selection
+  uint32_t jmem_profile_categories; // jerry_jmem_profile_category_t bits
+  const char* heap_snapshot_path; // NULL to ignore SIGUSR2 for heap snapshots
+  uint32_t cpu_profile_interval; // microseconds, 0 for the default interval
+  uint32_t threadpool_size; // 0 for the libtuv default
+  uint32_t threadpool_max_size; // threadpool_size for a pool of fixed size
+  size_t memory_budget; // bytes, 0 to keep the memory governor off
+  uint32_t memory_moderate_percent; // of the budget, for moderate pressure
+  uint32_t memory_critical_percent; // of the budget, for critical pressure
+  bool startup_trace; // print the time of the startup phases
+  uint32_t timer_slack; // milliseconds timeouts may run late by default
+  int peripheral_priority; // SCHED_FIFO priority, 0 for the threadpool
+  int peripheral_cpu; // CPU the peripheral threads are pinned to, or -1
 } Config;
 
+#define IOTJS_LOOP_LAG_BUCKETS 8
+
+// Time spent in the event loop, in nanoseconds.
+typedef struct {
+  uint64_t iterations;
+  uint64_t idle_time;     // blocked in polling for I/O
+  uint64_t callback_time; // in I/O, timer and handle callbacks
+  uint64_t job_time;      // in next tick callbacks and promise jobs
+  uint64_t gc_time;       // in garbage collection between iterations
+  uint64_t max_lag;       // the longest time an iteration kept I/O waiting
+  // Iterations by the time they kept I/O waiting: below 1ms, below 2ms,
+  // below 4ms and so on, the last one counting the longer ones.
+  uint32_t lag_histogram[IOTJS_LOOP_LAG_BUCKETS];
+} iotjs_loop_stats_t;
+
+// Phases of the startup, in their order.
+typedef enum {
+  kStartupArguments,    // parsing the command line
+  kStartupJerryInit,    // jerry_init() and the heap configuration
+  kStartupDebugger,     // jerry_debugger_init()
+  kStartupMagicStrings, // registering the external magic strings
+  kStartupGlobal,       // running the empty script for the global environment
+  kStartupModuleList,   // the builtin module list
+  kStartupProcess,      // the process module
+  kStartupIotjsJs,      // iotjs.js, up to loading the main module
+  kStartupMainModule,   // the main module, as the first user require
+  kStartupFirstLoop,    // the first iteration of the event loop
+  kStartupPhaseCount,
+} iotjs_startup_phase_t;
+
+// The uv_hrtime() the startup began at, and the ones each phase ended at,
+// 0 for the phases not reached yet.
+typedef struct {
+  uint64_t start;
+  uint64_t phase_end[kStartupPhaseCount];
+} iotjs_startup_trace_t;
+
 typedef enum {
   kInitializing,
   kRunningMain,
@@ -50,6 +114,12 @@ typedef struct {
 
   // Run config
   Config config;
+
+  // Event loop metrics
+  iotjs_loop_stats_t loop_stats;
+
+  // Startup phase timing
+  iotjs_startup_trace_t startup_trace;
 } IOTJS_VALIDATED_STRUCT(iotjs_environment_t);
 
 
@@ -68,6 +138,19 @@ void iotjs_environment_set_loop(iotjs_environment_t* env, uv_loop_t* loop);
 
 const Config* iotjs_environment_config(const iotjs_environment_t* env);
 
+iotjs_loop_stats_t* iotjs_environment_loop_stats(iotjs_environment_t* env);
+
+void iotjs_environment_mark_startup(iotjs_environment_t* env,
+                                    iotjs_startup_phase_t phase);
+const iotjs_startup_trace_t* iotjs_environment_startup_trace(
+    const iotjs_environment_t* env);
+// The name of a phase, or NULL if the phase is unknown.
+const char* iotjs_environment_startup_phase_name(iotjs_startup_phase_t phase);
+// The phase of the name, or kStartupPhaseCount if the name is unknown.
+iotjs_startup_phase_t iotjs_environment_startup_phase_of(const char* name);
+
+uint32_t iotjs_environment_jmem_profile_category(const char* name);
+
 void iotjs_environment_go_state_running_main(iotjs_environment_t* env);
 void iotjs_environment_go_state_running_loop(iotjs_environment_t* env);
 void iotjs_environment_go_state_exiting(iotjs_environment_t* env);
@@ -76,6 +76,22 @@ iotjs_jval_t* iotjs_handlewrap_jobject(iotjs_handlewrap_t* handlewrap) {
 }
 
 
+void iotjs_handlewrap_initialize_callbacks(iotjs_handlewrap_t* handlewrap,
+                                           iotjs_jval_t* jcallbacks,
+                                           uint32_t count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_handlewrap_t, handlewrap);
+  iotjs_jobjectwrap_initialize_callbacks(&_this->jobjectwrap, jcallbacks,
+                                         count);
+}
+
+
+const iotjs_jval_t* iotjs_handlewrap_jcallback(iotjs_handlewrap_t* handlewrap,
+                                               uint32_t index) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_handlewrap_t, handlewrap);
+  return iotjs_jobjectwrap_jcallback(&_this->jobjectwrap, index);
+}
+
+
 static void iotjs_handlewrap_on_close(iotjs_handlewrap_t* handlewrap) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_handlewrap_t, handlewrap);
 
@@ -66,6 +66,12 @@ iotjs_handlewrap_t* iotjs_handlewrap_from_jobject(const iotjs_jval_t* jobject);
 uv_handle_t* iotjs_handlewrap_get_uv_handle(iotjs_handlewrap_t* handlewrap);
 iotjs_jval_t* iotjs_handlewrap_jobject(iotjs_handlewrap_t* handlewrap);
 
+void iotjs_handlewrap_initialize_callbacks(iotjs_handlewrap_t* handlewrap,
+                                           iotjs_jval_t* jcallbacks,
+                                           uint32_t count);
+const iotjs_jval_t* iotjs_handlewrap_jcallback(iotjs_handlewrap_t* handlewrap,
+                                               uint32_t index);
+
 void iotjs_handlewrap_validate(iotjs_handlewrap_t* handlewrap);
 
 
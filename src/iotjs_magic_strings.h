@@ -21,13 +21,26 @@
 #define IOTJS_MAGIC_STRING_2 "2"
 #define IOTJS_MAGIC_STRING_3 "3"
 #define IOTJS_MAGIC_STRING_ABORT "abort"
+#define IOTJS_MAGIC_STRING_ACCEPT "accept"
 #define IOTJS_MAGIC_STRING_ADC "Adc"
+#define IOTJS_MAGIC_STRING_ADDFORMAT "addFormat"
 #define IOTJS_MAGIC_STRING_ADDHEADER "addHeader"
 #define IOTJS_MAGIC_STRING_ADDMEMBERSHIP "addMembership"
 #define IOTJS_MAGIC_STRING_ADDRESS "address"
+#define IOTJS_MAGIC_STRING_AESCMAC "aesCmac"
+#define IOTJS_MAGIC_STRING_AESENCRYPT "aesEncrypt"
+#define IOTJS_MAGIC_STRING_ALLOCATED "allocated"
+#define IOTJS_MAGIC_STRING_ALLOCATIONRATE "allocationRate"
+#define IOTJS_MAGIC_STRING_APPEND "append"
 #define IOTJS_MAGIC_STRING_ARCH "arch"
 #define IOTJS_MAGIC_STRING_ARGV "argv"
+#define IOTJS_MAGIC_STRING_ARRAYBUFFER "arrayBuffer"
+#define IOTJS_MAGIC_STRING__ARRAYBUFFER "_arrayBuffer"
+#define IOTJS_MAGIC_STRING_BASE64BYTELENGTH "base64ByteLength"
+#define IOTJS_MAGIC_STRING_BASE64WRITE "base64Write"
+#define IOTJS_MAGIC_STRING_BATCH "batch"
 #define IOTJS_MAGIC_STRING_BAUDRATE "baudRate"
+#define IOTJS_MAGIC_STRING__BEGINNOGC "_beginNoGC"
 #define IOTJS_MAGIC_STRING_BIND "bind"
 #define IOTJS_MAGIC_STRING_BINDCONTROL "bindControl"
 #define IOTJS_MAGIC_STRING_BINDING "binding"
@@ -36,178 +49,388 @@
 #define IOTJS_MAGIC_STRING_BITORDER "bitOrder"
 #define IOTJS_MAGIC_STRING_BITORDER_U "BITORDER"
 #define IOTJS_MAGIC_STRING_BITSPERWORD "bitsPerWord"
+#define IOTJS_MAGIC_STRING_BLOCKSTART "blockStart"
 #define IOTJS_MAGIC_STRING_BOARD "board"
 #define IOTJS_MAGIC_STRING_BOTH_U "BOTH"
+#define IOTJS_MAGIC_STRING_BRIDGE "bridge"
+#define IOTJS_MAGIC_STRING_BUDGET "budget"
 #define IOTJS_MAGIC_STRING_BUFFER "Buffer"
 #define IOTJS_MAGIC_STRING__BUFFER "_buffer"
+#define IOTJS_MAGIC_STRING_BUFFERS "buffers"
 #define IOTJS_MAGIC_STRING__BUILTIN "_builtin"
 #define IOTJS_MAGIC_STRING_BUS "bus"
 #define IOTJS_MAGIC_STRING_BYTELENGTH "byteLength"
-#define IOTJS_MAGIC_STRING_REJECTUNAUTHORIZED "rejectUnauthorized"
+#define IOTJS_MAGIC_STRING_BYTEOFFSET "byteOffset"
 #define IOTJS_MAGIC_STRING_BYTEPARSED "byteParsed"
 #define IOTJS_MAGIC_STRING_CA "ca"
+#define IOTJS_MAGIC_STRING__CALLBACKS "_callbacks"
+#define IOTJS_MAGIC_STRING_CALLBACKTIME "callbackTime"
+#define IOTJS_MAGIC_STRING_CAP "cap"
+#define IOTJS_MAGIC_STRING_CAPTURE "capture"
+#define IOTJS_MAGIC_STRING_CBOR "CBOR"
 #define IOTJS_MAGIC_STRING_CERT "cert"
+#define IOTJS_MAGIC_STRING_CHANNELFD "channelFd"
 #define IOTJS_MAGIC_STRING_CHDIR "chdir"
 #define IOTJS_MAGIC_STRING_CHIP "chip"
 #define IOTJS_MAGIC_STRING_CHIPSELECT "chipSelect"
 #define IOTJS_MAGIC_STRING_CHIPSELECT_U "CHIPSELECT"
+#define IOTJS_MAGIC_STRING_CLEAR "clear"
 #define IOTJS_MAGIC_STRING_CLOSE "close"
+#define IOTJS_MAGIC_STRING_CLOSENOTIFY "closeNotify"
+#define IOTJS_MAGIC_STRING_CLOSEPEER "closePeer"
 #define IOTJS_MAGIC_STRING_CLOSESYNC "closeSync"
 #define IOTJS_MAGIC_STRING_CODE "code"
 #define IOTJS_MAGIC_STRING_COMPARE "compare"
 #define IOTJS_MAGIC_STRING_COMPILE "compile"
+#define IOTJS_MAGIC_STRING_COMPILEBUNDLED "compileBundled"
+#define IOTJS_MAGIC_STRING_COMPILECACHED "compileCached"
 #define IOTJS_MAGIC_STRING_COMPILENATIVEPTR "compileNativePtr"
+#define IOTJS_MAGIC_STRING_COMPILEROUTES "compileRoutes"
+#define IOTJS_MAGIC_STRING_COMPILESNAPSHOT "compileSnapshot"
 #define IOTJS_MAGIC_STRING_CONNECT "connect"
+#define IOTJS_MAGIC_STRING_CONTENTLENGTH "contentLength"
 #define IOTJS_MAGIC_STRING_COPY "copy"
+#define IOTJS_MAGIC_STRING_COUNT "count"
 #define IOTJS_MAGIC_STRING_CREATEREQUEST "createRequest"
 #define IOTJS_MAGIC_STRING__CREATESTAT "_createStat"
 #define IOTJS_MAGIC_STRING_CREATETCP "createTCP"
+#define IOTJS_MAGIC_STRING_CRITICAL "critical"
 #define IOTJS_MAGIC_STRING_CWD "cwd"
 #define IOTJS_MAGIC_STRING_DATABITS "dataBits"
+#define IOTJS_MAGIC_STRING_DEBOUNCE "debounce"
+#define IOTJS_MAGIC_STRING_DECODE "decode"
+#define IOTJS_MAGIC_STRING_DEFAULTSLACK "defaultSlack"
+#define IOTJS_MAGIC_STRING_DELIMITER "delimiter"
+#define IOTJS_MAGIC_STRING_DESTROY "destroy"
 #define IOTJS_MAGIC_STRING_DEVICE "device"
 #define IOTJS_MAGIC_STRING_DIRECTION "direction"
 #define IOTJS_MAGIC_STRING_DIRECTION_U "DIRECTION"
+#define IOTJS_MAGIC_STRING_DISABLE "disable"
+#define IOTJS_MAGIC_STRING_DLOPEN "dlopen"
 #define IOTJS_MAGIC_STRING_DOEXIT "doExit"
+#define IOTJS_MAGIC_STRING_DRAIN "drain"
+#define IOTJS_MAGIC_STRING_DROP "drop"
 #define IOTJS_MAGIC_STRING_DROPMEMBERSHIP "dropMembership"
 #define IOTJS_MAGIC_STRING_DUTYCYCLE "dutyCycle"
 #define IOTJS_MAGIC_STRING_EDGE "edge"
 #define IOTJS_MAGIC_STRING_EDGE_U "EDGE"
 #define IOTJS_MAGIC_STRING_EMIT "emit"
 #define IOTJS_MAGIC_STRING_EMITEXIT "emitExit"
+#define IOTJS_MAGIC_STRING_ENABLE "enable"
+#define IOTJS_MAGIC_STRING_ENABLETICKETS "enableTickets"
+#define IOTJS_MAGIC_STRING_ENCODE "encode"
+#define IOTJS_MAGIC_STRING__ENDNOGC "_endNoGC"
 #define IOTJS_MAGIC_STRING_ENV "env"
 #define IOTJS_MAGIC_STRING_ERRNAME "errname"
+#define IOTJS_MAGIC_STRING_ERRORSTRING "errorString"
 #define IOTJS_MAGIC_STRING_EXECUTE "execute"
 #define IOTJS_MAGIC_STRING_EXITCODE "exitCode"
 #define IOTJS_MAGIC_STRING_EXPORT "export"
 #define IOTJS_MAGIC_STRING_FALLING_U "FALLING"
 #define IOTJS_MAGIC_STRING_FAMILY "family"
+#define IOTJS_MAGIC_STRING_FEED "feed"
+#define IOTJS_MAGIC_STRING_FILL "fill"
+#define IOTJS_MAGIC_STRING_FINALIZERS "finalizers"
 #define IOTJS_MAGIC_STRING_FINISH "finish"
 #define IOTJS_MAGIC_STRING_FINISHREQUEST "finishRequest"
 #define IOTJS_MAGIC_STRING_FLOAT "FLOAT"
+#define IOTJS_MAGIC_STRING_FORMAT "format"
+#define IOTJS_MAGIC_STRING_FORMATS "formats"
+#define IOTJS_MAGIC_STRING_FRAMECHUNK "frameChunk"
+#define IOTJS_MAGIC_STRING_FRAMELENGTH "frameLength"
+#define IOTJS_MAGIC_STRING_FREE "free"
+#define IOTJS_MAGIC_STRING_FREESEGMENTS "freeSegments"
 #define IOTJS_MAGIC_STRING_FSTAT "fstat"
+#define IOTJS_MAGIC_STRING_FSWATCHER "FsWatcher"
+#define IOTJS_MAGIC_STRING_GCCOUNT "gcCount"
+#define IOTJS_MAGIC_STRING_GCPAUSETOTAL "gcPauseTotal"
+#define IOTJS_MAGIC_STRING_GCSTATS "gcStats"
+#define IOTJS_MAGIC_STRING_GCTIME "gcTime"
 #define IOTJS_MAGIC_STRING_GETADDRINFO "getaddrinfo"
+#define IOTJS_MAGIC_STRING_GETCIPHER "getCipher"
+#define IOTJS_MAGIC_STRING_GETPROTOCOL "getProtocol"
+#define IOTJS_MAGIC_STRING_GETSERVERS "getServers"
+#define IOTJS_MAGIC_STRING_GETSESSION "getSession"
 #define IOTJS_MAGIC_STRING_GETSOCKNAME "getsockname"
 #define IOTJS_MAGIC_STRING_GPIO "Gpio"
+#define IOTJS_MAGIC_STRING_GROWTH "growth"
+#define IOTJS_MAGIC_STRING__HANDLE "_handle"
 #define IOTJS_MAGIC_STRING_HANDLER "handler"
 #define IOTJS_MAGIC_STRING_HANDLETIMEOUT "handleTimeout"
 #define IOTJS_MAGIC_STRING_HEADERS "headers"
 #define IOTJS_MAGIC_STRING_HEXWRITE "hexWrite"
 #define IOTJS_MAGIC_STRING_HIGH "HIGH"
+#define IOTJS_MAGIC_STRING_HISTOGRAM "Histogram"
+#define IOTJS_MAGIC_STRING_HMACSHA256 "hmacSha256"
 #define IOTJS_MAGIC_STRING_HOME "HOME"
 #define IOTJS_MAGIC_STRING_HOST "host"
 #define IOTJS_MAGIC_STRING_HTTPPARSER "HTTPParser"
+#define IOTJS_MAGIC_STRING__HTTPMESSAGE "_httpMessage"
+#define IOTJS_MAGIC_STRING_IDLETIME "idleTime"
 #define IOTJS_MAGIC_STRING_IN "IN"
 #define IOTJS_MAGIC_STRING__INCOMING "_incoming"
+#define IOTJS_MAGIC_STRING_INDEXOF "indexOf"
+#define IOTJS_MAGIC_STRING_INTERBYTETIMEOUT "interByteTimeout"
+#define IOTJS_MAGIC_STRING_INTERVAL "interval"
+#define IOTJS_MAGIC_STRING_INUSE "inUse"
+#define IOTJS_MAGIC_STRING_IOTJS_CHANNEL_FD "IOTJS_CHANNEL_FD"
+#define IOTJS_MAGIC_STRING_IOTJS_CLUSTER_WORKER "IOTJS_CLUSTER_WORKER"
+#define IOTJS_MAGIC_STRING_IOTJS_CODE_CACHE "IOTJS_CODE_CACHE"
 #define IOTJS_MAGIC_STRING_IOTJS_ENV "IOTJS_ENV"
 #define IOTJS_MAGIC_STRING_IOTJS_PATH "IOTJS_PATH"
+#define IOTJS_MAGIC_STRING_IOTJS_SHARED_RING "IOTJS_SHARED_RING"
+#define IOTJS_MAGIC_STRING_IOTJS_WORKER_DATA "IOTJS_WORKER_DATA"
 #define IOTJS_MAGIC_STRING_IOTJS "iotjs"
 #define IOTJS_MAGIC_STRING_IPV4 "IPv4"
 #define IOTJS_MAGIC_STRING_IPV6 "IPv6"
 #define IOTJS_MAGIC_STRING_ISALIVEEXCEPTFOR "isAliveExceptFor"
+#define IOTJS_MAGIC_STRING_ISARRAYBUFFER "isArrayBuffer"
 #define IOTJS_MAGIC_STRING_ISDEVUP "isDevUp"
 #define IOTJS_MAGIC_STRING_ISDIRECTORY "isDirectory"
+#define IOTJS_MAGIC_STRING_ISENABLED "isEnabled"
 #define IOTJS_MAGIC_STRING_ISFILE "isFile"
+#define IOTJS_MAGIC_STRING_ISSESSIONREUSED "isSessionReused"
+#define IOTJS_MAGIC_STRING_ITERATIONS "iterations"
+#define IOTJS_MAGIC_STRING_JOBTIME "jobTime"
+#define IOTJS_MAGIC_STRING_JSHEAP "jsHeap"
+#define IOTJS_MAGIC_STRING_JSHEAPPEAK "jsHeapPeak"
+#define IOTJS_MAGIC_STRING_JSHEAPSIZE "jsHeapSize"
+#define IOTJS_MAGIC_STRING_JSON "JSON"
+#define IOTJS_MAGIC_STRING_JSPOOLFREE "jsPoolFree"
 #define IOTJS_MAGIC_STRING_KEY "key"
+#define IOTJS_MAGIC_STRING_KILL "kill"
+#define IOTJS_MAGIC_STRING_LAGHISTOGRAM "lagHistogram"
+#define IOTJS_MAGIC_STRING_LASTPAUSE "lastPause"
+#define IOTJS_MAGIC_STRING_LATENCY "latency"
 #define IOTJS_MAGIC_STRING_LENGTH "length"
 #define IOTJS_MAGIC_STRING_LISTEN "listen"
+#define IOTJS_MAGIC_STRING_LIVESIZE "liveSize"
+#define IOTJS_MAGIC_STRING_LOAD "load"
+#define IOTJS_MAGIC_STRING_LOOKUPLOCAL "lookupLocal"
 #define IOTJS_MAGIC_STRING_LOOPBACK "loopback"
+#define IOTJS_MAGIC_STRING_LOOPSTATS "loopStats"
 #define IOTJS_MAGIC_STRING_LSB "LSB"
+#define IOTJS_MAGIC_STRING__MARKSTARTUP "_markStartup"
+#define IOTJS_MAGIC_STRING_MAXLAG "maxLag"
 #define IOTJS_MAGIC_STRING_MAXSPEED "maxSpeed"
+#define IOTJS_MAGIC_STRING_MEMORYPROFILER "memoryProfiler"
+#define IOTJS_MAGIC_STRING_MEMORYSTATS "memoryStats"
+#define IOTJS_MAGIC_STRING_MEMORYUSAGE "memoryUsage"
 #define IOTJS_MAGIC_STRING_METHOD "method"
 #define IOTJS_MAGIC_STRING_METHODS "methods"
+#define IOTJS_MAGIC_STRING_MININTERVAL "minInterval"
 #define IOTJS_MAGIC_STRING_MKDIR "mkdir"
+#define IOTJS_MAGIC_STRING_MMAP "mmap"
 #define IOTJS_MAGIC_STRING_MODE "mode"
+#define IOTJS_MAGIC_STRING_MODERATE "moderate"
 #define IOTJS_MAGIC_STRING_MODE_U "MODE"
 #define IOTJS_MAGIC_STRING_MSB "MSB"
+#define IOTJS_MAGIC_STRING_MSGPACK "MSGPACK"
+#define IOTJS_MAGIC_STRING_MTIMEMS "mtimeMs"
+#define IOTJS_MAGIC_STRING_NATIVE "native"
+#define IOTJS_MAGIC_STRING_NATIVEPOOLFREE "nativePoolFree"
 #define IOTJS_MAGIC_STRING_NATIVE_SOURCES "native_sources"
+#define IOTJS_MAGIC_STRING_NEXTTICK "nextTick"
 #define IOTJS_MAGIC_STRING_NONE "NONE"
+#define IOTJS_MAGIC_STRING_NOW "now"
+#define IOTJS_MAGIC_STRING_OCCUPANCY "occupancy"
+#define IOTJS_MAGIC_STRING_OCCUPIED "occupied"
 #define IOTJS_MAGIC_STRING_ONBODY "OnBody"
+#define IOTJS_MAGIC_STRING_ONCAPTURE "onCapture"
+#define IOTJS_MAGIC_STRING_ONCHANGE "onChange"
 #define IOTJS_MAGIC_STRING_ONCLOSE "onclose"
 #define IOTJS_MAGIC_STRING_ONCLOSED "onClosed"
 #define IOTJS_MAGIC_STRING_ONCONNECTION "onconnection"
 #define IOTJS_MAGIC_STRING_ONDATA "onData"
 #define IOTJS_MAGIC_STRING_ONEND "onEnd"
 #define IOTJS_MAGIC_STRING_ONERROR "onError"
+#define IOTJS_MAGIC_STRING_ONEXIT "onexit"
+#define IOTJS_MAGIC_STRING_ONFRAME "onframe"
+#define IOTJS_MAGIC_STRING_ONHANDSHAKE "onhandshake"
 #define IOTJS_MAGIC_STRING_ONHEADERSCOMPLETE "OnHeadersComplete"
 #define IOTJS_MAGIC_STRING_ONHEADERS "OnHeaders"
 #define IOTJS_MAGIC_STRING_ONMESSAGECOMPLETE "OnMessageComplete"
 #define IOTJS_MAGIC_STRING_ONMESSAGE "onmessage"
+#define IOTJS_MAGIC_STRING_ONMESSAGES "onmessages"
 #define IOTJS_MAGIC_STRING__ONNEXTTICK "_onNextTick"
 #define IOTJS_MAGIC_STRING_ONREAD "onread"
+#define IOTJS_MAGIC_STRING_ONSIGNAL "onsignal"
 #define IOTJS_MAGIC_STRING_ONSOCKET "onSocket"
 #define IOTJS_MAGIC_STRING_ONTIMEOUT "onTimeout"
 #define IOTJS_MAGIC_STRING__ONUNCAUGHTEXCEPTION "_onUncaughtException"
 #define IOTJS_MAGIC_STRING_ONWRITABLE "onWritable"
+#define IOTJS_MAGIC_STRING_OPENBUNDLE "openBundle"
 #define IOTJS_MAGIC_STRING_OPENDRAIN "OPENDRAIN"
 #define IOTJS_MAGIC_STRING_OPEN "open"
 #define IOTJS_MAGIC_STRING_OUT "OUT"
+#define IOTJS_MAGIC_STRING_OVERWRITTEN "overwritten"
 #define IOTJS_MAGIC_STRING_OWNER "owner"
+#define IOTJS_MAGIC_STRING__PARENT "_parent"
+#define IOTJS_MAGIC_STRING_PARSEQUERY "parseQuery"
+#define IOTJS_MAGIC_STRING_PARSEURL "parseUrl"
 #define IOTJS_MAGIC_STRING_PAUSE "pause"
+#define IOTJS_MAGIC_STRING_PAUSEBUDGET "pauseBudget"
+#define IOTJS_MAGIC_STRING_PEAK "peak"
+#define IOTJS_MAGIC_STRING_PEERFDS "peerFds"
+#define IOTJS_MAGIC_STRING_PERCENTILE "percentile"
 #define IOTJS_MAGIC_STRING_PERIOD "period"
+#define IOTJS_MAGIC_STRING_PID "pid"
 #define IOTJS_MAGIC_STRING_PIN "pin"
 #define IOTJS_MAGIC_STRING_PLATFORM "platform"
+#define IOTJS_MAGIC_STRING_PLAYSEQUENCE "playSequence"
+#define IOTJS_MAGIC_STRING_POOLSTATS "poolStats"
 #define IOTJS_MAGIC_STRING_PORT "port"
+#define IOTJS_MAGIC_STRING_PRESSURE "pressure"
+#define IOTJS_MAGIC_STRING_PROBE "probe"
+#define IOTJS_MAGIC_STRING_PROBEBUNDLE "probeBundle"
 #define IOTJS_MAGIC_STRING_PROTOTYPE "prototype"
 #define IOTJS_MAGIC_STRING_PULLDOWN "PULLDOWN"
 #define IOTJS_MAGIC_STRING_PULLUP "PULLUP"
 #define IOTJS_MAGIC_STRING_PUSHPULL "PUSHPULL"
+#define IOTJS_MAGIC_STRING_RANDOMBYTES "randomBytes"
+#define IOTJS_MAGIC_STRING_RANDOMKEY "randomKey"
+#define IOTJS_MAGIC_STRING_READARRAY "readArray"
+#define IOTJS_MAGIC_STRING_READBLOCK "readBlock"
+#define IOTJS_MAGIC_STRING_READBUNDLED "readBundled"
 #define IOTJS_MAGIC_STRING_READDIR "readdir"
 #define IOTJS_MAGIC_STRING_READ "read"
+#define IOTJS_MAGIC_STRING_READEND "readEnd"
+#define IOTJS_MAGIC_STRING_READFILE "readFile"
+#define IOTJS_MAGIC_STRING_READLINES "readLines"
+#define IOTJS_MAGIC_STRING_READNUMBER "readNumber"
 #define IOTJS_MAGIC_STRING_READSOURCE "readSource"
 #define IOTJS_MAGIC_STRING_READSTART "readStart"
+#define IOTJS_MAGIC_STRING_READSTOP "readStop"
 #define IOTJS_MAGIC_STRING_READSYNC "readSync"
 #define IOTJS_MAGIC_STRING_READUINT8 "readUInt8"
+#define IOTJS_MAGIC_STRING_RECORD "record"
+#define IOTJS_MAGIC_STRING_RECORDDELTA "recordDelta"
 #define IOTJS_MAGIC_STRING_RECVSTART "recvStart"
 #define IOTJS_MAGIC_STRING_RECVSTOP "recvStop"
 #define IOTJS_MAGIC_STRING_REF "ref"
 #define IOTJS_MAGIC_STRING_REINITIALIZE "reinitialize"
+#define IOTJS_MAGIC_STRING_REJECTUNAUTHORIZED "rejectUnauthorized"
+#define IOTJS_MAGIC_STRING_RELIEFS "reliefs"
 #define IOTJS_MAGIC_STRING_RENAME "rename"
 #define IOTJS_MAGIC_STRING_REQUEST "REQUEST"
+#define IOTJS_MAGIC_STRING_RESERVE "reserve"
+#define IOTJS_MAGIC_STRING_RESET "reset"
+#define IOTJS_MAGIC_STRING_RESOLVE "resolve"
 #define IOTJS_MAGIC_STRING_RESPONSE "RESPONSE"
 #define IOTJS_MAGIC_STRING_RESUME "resume"
 #define IOTJS_MAGIC_STRING__REUSEADDR "_reuseAddr"
+#define IOTJS_MAGIC_STRING_REUSED "reused"
 #define IOTJS_MAGIC_STRING_RISING_U "RISING"
 #define IOTJS_MAGIC_STRING_RMDIR "rmdir"
+#define IOTJS_MAGIC_STRING_RSSI "rssi"
+#define IOTJS_MAGIC_STRING__RUNNEXTTICKS "_runNextTicks"
+#define IOTJS_MAGIC_STRING_SAMPLINGSTART "samplingStart"
+#define IOTJS_MAGIC_STRING_SAMPLINGSTOP "samplingStop"
+#define IOTJS_MAGIC_STRING_SECURECONTEXT "SecureContext"
+#define IOTJS_MAGIC_STRING_SEGMENTS "segments"
 #define IOTJS_MAGIC_STRING_SEND "send"
+#define IOTJS_MAGIC_STRING_SENDBATCH "sendBatch"
+#define IOTJS_MAGIC_STRING_SENDFILE "sendFile"
 #define IOTJS_MAGIC_STRING_SENDREQUEST "sendRequest"
+#define IOTJS_MAGIC_STRING_SERIALIZEHEADERS "serializeHeaders"
+#define IOTJS_MAGIC_STRING_SETACCEPTLIMIT "setAcceptLimit"
 #define IOTJS_MAGIC_STRING_SETADDRESS "setAddress"
+#define IOTJS_MAGIC_STRING_SETASYNC "setAsync"
 #define IOTJS_MAGIC_STRING_SETBROADCAST "setBroadcast"
+#define IOTJS_MAGIC_STRING_SETBUFFERSIZE "setBufferSize"
+#define IOTJS_MAGIC_STRING_SETCA "setCA"
+#define IOTJS_MAGIC_STRING_SETCERT "setCert"
 #define IOTJS_MAGIC_STRING_SETDUTYCYCLE "setDutyCycle"
 #define IOTJS_MAGIC_STRING_SETENABLE "setEnable"
+#define IOTJS_MAGIC_STRING_SETFASTOPEN "setFastOpen"
 #define IOTJS_MAGIC_STRING_SETFILTER "setFilter"
 #define IOTJS_MAGIC_STRING_SETFREQUENCY "setFrequency"
+#define IOTJS_MAGIC_STRING_SETGCTRIGGER "setGcTrigger"
 #define IOTJS_MAGIC_STRING_SETKEEPALIVE "setKeepAlive"
+#define IOTJS_MAGIC_STRING_SETMAXPAYLOAD "setMaxPayload"
+#define IOTJS_MAGIC_STRING_SETMEMORYBUDGET "setMemoryBudget"
 #define IOTJS_MAGIC_STRING_SETMULTICASTLOOPBACK "setMulticastLoopback"
 #define IOTJS_MAGIC_STRING_SETMULTICASTTTL "setMulticastTTL"
+#define IOTJS_MAGIC_STRING_SETNODELAY "setNoDelay"
 #define IOTJS_MAGIC_STRING_SETPERIOD "setPeriod"
+#define IOTJS_MAGIC_STRING_SETSERVERNAME "setServername"
+#define IOTJS_MAGIC_STRING_SETSERVERS "setServers"
+#define IOTJS_MAGIC_STRING_SETSESSION "setSession"
+#define IOTJS_MAGIC_STRING_SETSTATICROUTES "setStaticRoutes"
 #define IOTJS_MAGIC_STRING_SETTIMEOUT "setTimeout"
 #define IOTJS_MAGIC_STRING_SETTTL "setTTL"
+#define IOTJS_MAGIC_STRING_SETVERIFY "setVerify"
+#define IOTJS_MAGIC_STRING_SHA1 "sha1"
+#define IOTJS_MAGIC_STRING_SHA256 "sha256"
+#define IOTJS_MAGIC_STRING_SHAREDRING "SharedRing"
 #define IOTJS_MAGIC_STRING_SHOULDKEEPALIVE "shouldkeepalive"
 #define IOTJS_MAGIC_STRING_SHUTDOWN "shutdown"
+#define IOTJS_MAGIC_STRING_SIZE "size"
 #define IOTJS_MAGIC_STRING_SLICE "slice"
+#define IOTJS_MAGIC_STRING_SOCKET "socket"
+#define IOTJS_MAGIC_STRING_SPAWN "spawn"
 #define IOTJS_MAGIC_STRING_SPI "Spi"
+#define IOTJS_MAGIC_STRING_SPLICE "splice"
+#define IOTJS_MAGIC_STRING_SPLIT "split"
 #define IOTJS_MAGIC_STRING_START "start"
+#define IOTJS_MAGIC_STRING_STARTUPTRACE "startupTrace"
 #define IOTJS_MAGIC_STRING_STAT "stat"
 #define IOTJS_MAGIC_STRING_STATS "stats"
 #define IOTJS_MAGIC_STRING_STATUS_MSG "status_msg"
 #define IOTJS_MAGIC_STRING_STATUS "status"
+#define IOTJS_MAGIC_STRING_STATWATCHER "StatWatcher"
 #define IOTJS_MAGIC_STRING_STDERR "stderr"
 #define IOTJS_MAGIC_STRING_STDOUT "stdout"
 #define IOTJS_MAGIC_STRING_REBOOT "reboot"
 #define IOTJS_MAGIC_STRING_STOP "stop"
+#define IOTJS_MAGIC_STRING_STOPSEQUENCE "stopSequence"
+#define IOTJS_MAGIC_STRING_STREAMRESUME "streamResume"
+#define IOTJS_MAGIC_STRING_STREAMSTART "streamStart"
+#define IOTJS_MAGIC_STRING_STREAMSTOP "streamStop"
+#define IOTJS_MAGIC_STRING_STRINGIFY "stringify"
+#define IOTJS_MAGIC_STRING_SURVIVAL "survival"
+#define IOTJS_MAGIC_STRING_TIMEOUT "timeout"
+#define IOTJS_MAGIC_STRING_TIMESERIES "TimeSeries"
+#define IOTJS_MAGIC_STRING_TLS "TLS"
+#define IOTJS_MAGIC_STRING_TOBASE64STRING "toBase64String"
+#define IOTJS_MAGIC_STRING_TOBUFFER "toBuffer"
 #define IOTJS_MAGIC_STRING_TOHEXSTRING "toHexString"
 #define IOTJS_MAGIC_STRING_TOSTRING "toString"
+#define IOTJS_MAGIC_STRING_TOTAL "total"
+#define IOTJS_MAGIC_STRING_TRANSFER "transfer"
 #define IOTJS_MAGIC_STRING_TRANSFERARRAY "transferArray"
 #define IOTJS_MAGIC_STRING_TRANSFERBUFFER "transferBuffer"
+#define IOTJS_MAGIC_STRING_TRIES "tries"
+#define IOTJS_MAGIC_STRING_TRIGGERSIZE "triggerSize"
+#define IOTJS_MAGIC_STRING_UNBRIDGE "unbridge"
 #define IOTJS_MAGIC_STRING_UNEXPORT "unexport"
 #define IOTJS_MAGIC_STRING_UNLINK "unlink"
 #define IOTJS_MAGIC_STRING_UNREF "unref"
+#define IOTJS_MAGIC_STRING_UPDATE "update"
 #define IOTJS_MAGIC_STRING_UPGRADE "upgrade"
 #define IOTJS_MAGIC_STRING_URL "url"
+#define IOTJS_MAGIC_STRING_USED "used"
+#define IOTJS_MAGIC_STRING_USEPROMISE "usePromise"
+#define IOTJS_MAGIC_STRING_UTILIZATION "utilization"
+#define IOTJS_MAGIC_STRING_UUIDS "uuids"
+#define IOTJS_MAGIC_STRING_UVHEAP "uvHeap"
+#define IOTJS_MAGIC_STRING_VERIFYERROR "verifyError"
 #define IOTJS_MAGIC_STRING_VERSION "version"
+#define IOTJS_MAGIC_STRING_VERSIONMAJOR "versionMajor"
+#define IOTJS_MAGIC_STRING_VERSIONMINOR "versionMinor"
+#define IOTJS_MAGIC_STRING_WEBSOCKET "WebSocket"
+#define IOTJS_MAGIC_STRING_WINDOW "window"
+#define IOTJS_MAGIC_STRING__WRITE "_write"
+#define IOTJS_MAGIC_STRING_WRITEARRAY "writeArray"
+#define IOTJS_MAGIC_STRING_WRITECPUPROFILE "writeCpuProfile"
+#define IOTJS_MAGIC_STRING_WRITEHEAPSAMPLES "writeHeapSamples"
+#define IOTJS_MAGIC_STRING_WRITEHEAPSNAPSHOT "writeHeapSnapshot"
+#define IOTJS_MAGIC_STRING_WRITELINES "writeLines"
+#define IOTJS_MAGIC_STRING_WRITENUMBER "writeNumber"
 #define IOTJS_MAGIC_STRING_WRITESYNC "writeSync"
 #define IOTJS_MAGIC_STRING_WRITEUINT8 "writeUInt8"
+#define IOTJS_MAGIC_STRING_WRITEQUEUESIZE "writeQueueSize"
+#define IOTJS_MAGIC_STRING_WRITEV "writev"
 #define IOTJS_MAGIC_STRING_WRITE "write"
-#define IOTJS_MAGIC_STRING__WRITE "_write"
 
 #endif /* IOTJS_STRING_CONSTANTS_H */
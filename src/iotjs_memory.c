@@ -0,0 +1,176 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "iotjs_def.h"
+#include "iotjs_memory.h"
+#include "iotjs_util.h"
+#include "jerryscript.h"
+#include "uv.h"
+
+
+#define IOTJS_MEMORY_LISTENER_MAX 4
+
+static size_t memory_budget = 0;
+static size_t memory_moderate_size = 0;
+static size_t memory_critical_size = 0;
+static iotjs_memory_pressure_t memory_pressure = kMemoryPressureNone;
+static size_t memory_reliefs = 0;
+// The usage after the memory was last given back under critical pressure.
+static size_t memory_relief_usage = 0;
+
+static iotjs_memory_listener_t memory_listeners[IOTJS_MEMORY_LISTENER_MAX];
+static unsigned memory_listener_count = 0;
+
+static bool is_memory_initialized = false;
+static bool is_native_relief_running = false;
+static uv_thread_t memory_loop_thread;
+
+
+void iotjs_memory_init() {
+  memory_loop_thread = uv_thread_self();
+  is_memory_initialized = true;
+}
+
+
+bool iotjs_memory_set_budget(size_t budget, unsigned moderate_percent,
+                             unsigned critical_percent) {
+  if (moderate_percent > critical_percent || critical_percent > 100) {
+    return false;
+  }
+
+  memory_budget = budget;
+  memory_moderate_size = budget / 100 * moderate_percent;
+  memory_critical_size = budget / 100 * critical_percent;
+  memory_relief_usage = 0;
+  return true;
+}
+
+
+void iotjs_memory_add_listener(iotjs_memory_listener_t listener) {
+  for (unsigned i = 0; i < memory_listener_count; i++) {
+    if (memory_listeners[i] == listener) {
+      return;
+    }
+  }
+
+  IOTJS_ASSERT(memory_listener_count < IOTJS_MEMORY_LISTENER_MAX);
+  memory_listeners[memory_listener_count++] = listener;
+}
+
+
+static size_t iotjs_memory_usage() {
+  return jerry_get_heap_usage(NULL) + *uv_get_heap_size_ptr() +
+         iotjs_buffer_allocated_size();
+}
+
+
+static iotjs_memory_pressure_t iotjs_memory_pressure_of(size_t usage) {
+  if (usage >= memory_critical_size) {
+    return kMemoryPressureCritical;
+  }
+  if (usage >= memory_moderate_size) {
+    return kMemoryPressureModerate;
+  }
+  return kMemoryPressureNone;
+}
+
+
+static void iotjs_memory_relieve(iotjs_memory_pressure_t pressure) {
+  memory_reliefs++;
+
+  if (pressure == kMemoryPressureCritical) {
+    jerry_free_unused_memory_critical();
+    iotjs_read_buffer_pool_cleanup();
+    iotjs_pool_cleanup();
+  } else {
+    jerry_free_unused_memory();
+    iotjs_read_buffer_pool_cleanup();
+  }
+}
+
+
+iotjs_memory_pressure_t iotjs_memory_check() {
+  if (memory_budget == 0) {
+    if (memory_pressure != kMemoryPressureNone) {
+      // The governor has been turned off under pressure.
+      memory_pressure = kMemoryPressureNone;
+      for (unsigned i = 0; i < memory_listener_count; i++) {
+        memory_listeners[i](memory_pressure);
+      }
+    }
+    return memory_pressure;
+  }
+
+  size_t usage = iotjs_memory_usage();
+  iotjs_memory_pressure_t pressure = iotjs_memory_pressure_of(usage);
+
+  // Memory is given back as the pressure rises, and again while it stays
+  // critical once the usage has grown by a sixteenth of the budget.
+  if (pressure > memory_pressure ||
+      (pressure == kMemoryPressureCritical &&
+       usage > memory_relief_usage + memory_budget / 16)) {
+    iotjs_memory_relieve(pressure);
+    usage = iotjs_memory_usage();
+    pressure = iotjs_memory_pressure_of(usage);
+    memory_relief_usage = usage;
+  }
+
+  if (pressure != memory_pressure || pressure == kMemoryPressureCritical) {
+    memory_pressure = pressure;
+    for (unsigned i = 0; i < memory_listener_count; i++) {
+      memory_listeners[i](pressure);
+    }
+  }
+
+  if (pressure != kMemoryPressureCritical) {
+    memory_relief_usage = 0;
+  }
+  return pressure;
+}
+
+
+iotjs_memory_pressure_t iotjs_memory_pressure() {
+  return memory_pressure;
+}
+
+
+void iotjs_memory_get_stats(iotjs_memory_stats_t* stats) {
+  stats->js_heap = jerry_get_heap_usage(&stats->js_heap_size);
+  stats->uv_heap = *uv_get_heap_size_ptr();
+  stats->native = iotjs_buffer_allocated_size();
+  stats->budget = memory_budget;
+  stats->pressure = memory_pressure;
+  stats->reliefs = memory_reliefs;
+}
+
+
+bool iotjs_memory_relieve_native() {
+  uv_thread_t thread = uv_thread_self();
+  if (!is_memory_initialized || is_native_relief_running ||
+      !uv_thread_equal(&thread, &memory_loop_thread)) {
+    return false;
+  }
+
+  // The engine is not collected here, as the allocation may be made by it.
+  is_native_relief_running = true;
+  size_t native_size = iotjs_buffer_allocated_size();
+  iotjs_read_buffer_pool_cleanup();
+  iotjs_pool_cleanup();
+  is_native_relief_running = false;
+
+  memory_reliefs++;
+  return iotjs_buffer_allocated_size() < native_size;
+}
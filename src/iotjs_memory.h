@@ -0,0 +1,68 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IOTJS_MEMORY_H
+#define IOTJS_MEMORY_H
+
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+// The memory governor keeps the JS heap, the libtuv heap and the native
+// buffers of iotjs within one budget. As the usage nears the budget, memory
+// is given back before allocations fail: garbage is collected, the pools are
+// emptied and, when the budget is all but used, sockets stop reading.
+typedef enum {
+  kMemoryPressureNone,
+  kMemoryPressureModerate,
+  kMemoryPressureCritical,
+} iotjs_memory_pressure_t;
+
+typedef struct {
+  size_t js_heap;       // in use in the JS heap
+  size_t js_heap_size;  // the size of the JS heap
+  size_t uv_heap;       // allocated by libtuv, if it is tracked
+  size_t native;        // allocated by iotjs_buffer_allocate()
+  size_t budget;        // 0 if the governor is off
+  iotjs_memory_pressure_t pressure;
+  size_t reliefs;       // times memory was given back under pressure
+} iotjs_memory_stats_t;
+
+// Called with the new pressure as it changes, and again while it stays
+// critical, to give back the memory of a module.
+typedef void (*iotjs_memory_listener_t)(iotjs_memory_pressure_t pressure);
+
+// Called on the thread of the event loop, which alone gives memory back.
+void iotjs_memory_init();
+
+// Sets the budget in bytes, 0 to turn the governor off, and the percents of
+// it at which the pressure becomes moderate and critical.
+bool iotjs_memory_set_budget(size_t budget, unsigned moderate_percent,
+                             unsigned critical_percent);
+void iotjs_memory_add_listener(iotjs_memory_listener_t listener);
+
+// Measures the usage, and gives memory back as the pressure calls for.
+// Called in each iteration of the event loop, and by process.memoryStats().
+iotjs_memory_pressure_t iotjs_memory_check();
+iotjs_memory_pressure_t iotjs_memory_pressure();
+void iotjs_memory_get_stats(iotjs_memory_stats_t* stats);
+
+// Frees what the native side keeps for reuse, after an allocation has
+// failed. False if nothing can be freed from the calling thread.
+bool iotjs_memory_relieve_native();
+
+
+#endif /* IOTJS_MEMORY_H */
@@ -37,14 +37,19 @@ typedef iotjs_jval_t (*register_func)();
   E(F, ADC, Adc, adc)                            \
   E(F, BLEHCISOCKET, Blehcisocket, blehcisocket) \
   E(F, BUFFER, Buffer, buffer)                   \
+  E(F, CLUSTER, Cluster, cluster)                \
+  E(F, CODEC, Codec, codec)                      \
   E(F, CONSOLE, Console, console)                \
   E(F, CONSTANTS, Constants, constants)          \
+  E(F, CRYPTO, Crypto, crypto)                   \
   E(F, DNS, Dns, dns)                            \
   E(F, FS, Fs, fs)                               \
   E(F, GPIO, Gpio, gpio)                         \
   E(F, HTTPPARSER, Httpparser, httpparser)       \
   E(F, HTTPS, Https, https)                      \
   E(F, I2C, I2c, i2c)                            \
+  E(F, LOG, Log, log)                            \
+  E(F, PERFORMANCE, Performance, performance)    \
   E(F, PROCESS, Process, process)                \
   E(F, PWM, Pwm, pwm)                            \
   E(F, SPI, Spi, spi)                            \
@@ -52,8 +57,10 @@ typedef iotjs_jval_t (*register_func)();
   E(F, TESTDRIVER, Testdriver, testdriver)       \
   E(F, TCP, Tcp, tcp)                            \
   E(F, TIMER, Timer, timer)                      \
+  E(F, TLS, Tls, tls)                            \
   E(F, UART, Uart, uart)                         \
-  E(F, UDP, Udp, udp)
+  E(F, UDP, Udp, udp)                            \
+  E(F, WEBSOCKET, Websocket, websocket)
 
 #define ENUMDEF_MODULE_LIST(upper, Camel, lower) MODULE_##upper,
 
@@ -27,6 +27,8 @@ void iotjs_jobjectwrap_initialize(iotjs_jobjectwrap_t* jobjectwrap,
   // This wrapper holds pointer to the javascript object but never increases
   // reference count.
   _this->jobject = *((iotjs_jval_t*)jobject);
+  _this->jcallbacks = NULL;
+  _this->jcallback_count = 0;
 
   // Set native pointer of the object to be this wrapper.
   // If the object is freed by GC, the wrapper instance should also be freed.
@@ -59,3 +61,121 @@ iotjs_jobjectwrap_t* iotjs_jobjectwrap_from_jobject(
   IOTJS_ASSERT(iotjs_jval_is_object(iotjs_jobjectwrap_jobject(wrap)));
   return wrap;
 }
+
+
+void iotjs_jobjectwrap_initialize_callbacks(iotjs_jobjectwrap_t* jobjectwrap,
+                                            iotjs_jval_t* jcallbacks,
+                                            uint32_t count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jobjectwrap_t, jobjectwrap);
+  IOTJS_ASSERT(_this->jcallbacks == NULL);
+
+  for (uint32_t i = 0; i < count; i++) {
+    jcallbacks[i] = *iotjs_jval_get_undefined();
+  }
+
+  _this->jcallbacks = jcallbacks;
+  _this->jcallback_count = count;
+
+  iotjs_jval_t jstore = iotjs_jval_create_array(count);
+  iotjs_jval_set_property_hidden_by_key(&_this->jobject,
+                                        IOTJS_PROPKEY__CALLBACKS, &jstore);
+  iotjs_jval_destroy(&jstore);
+}
+
+
+const iotjs_jval_t* iotjs_jobjectwrap_jcallback(
+    iotjs_jobjectwrap_t* jobjectwrap, uint32_t index) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jobjectwrap_t, jobjectwrap);
+  IOTJS_ASSERT(index < _this->jcallback_count);
+  return &_this->jcallbacks[index];
+}
+
+
+void iotjs_jobjectwrap_get_callback(iotjs_jhandler_t* jhandler, uint32_t index,
+                                    JNativeInfoType* native_info) {
+  iotjs_jobjectwrap_t* jobjectwrap = (iotjs_jobjectwrap_t*)
+      iotjs_jval_get_object_from_jhandler(jhandler, native_info);
+  if (jobjectwrap == NULL) {
+    return;
+  }
+
+  iotjs_jhandler_return_jval(jhandler,
+                             iotjs_jobjectwrap_jcallback(jobjectwrap, index));
+}
+
+
+void iotjs_jobjectwrap_set_callback(iotjs_jhandler_t* jhandler, uint32_t index,
+                                    JNativeInfoType* native_info) {
+  iotjs_jobjectwrap_t* jobjectwrap = (iotjs_jobjectwrap_t*)
+      iotjs_jval_get_object_from_jhandler(jhandler, native_info);
+  if (jobjectwrap == NULL) {
+    return;
+  }
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_jobjectwrap_t, jobjectwrap);
+  IOTJS_ASSERT(index < _this->jcallback_count);
+
+  const iotjs_jval_t* jcallback = iotjs_jhandler_get_arg_length(jhandler) > 0
+                                      ? iotjs_jhandler_get_arg(jhandler, 0)
+                                      : iotjs_jval_get_undefined();
+
+  // The hidden array holds the reference, the slot only caches the value.
+  iotjs_jval_t jstore =
+      iotjs_jval_get_property_by_key(&_this->jobject, IOTJS_PROPKEY__CALLBACKS);
+  IOTJS_ASSERT(iotjs_jval_is_object(&jstore));
+  iotjs_jval_set_property_by_index(&jstore, index, jcallback);
+  iotjs_jval_destroy(&jstore);
+
+  _this->jcallbacks[index] = *((iotjs_jval_t*)jcallback);
+}
+
+
+// The queue of the wraps to destroy, a ring from `finalizer_head`.
+typedef struct {
+  void* wrap;
+  JFreeHandlerType destroy;
+} iotjs_finalizer_t;
+
+static iotjs_finalizer_t finalizers[IOTJS_FINALIZER_QUEUE_SIZE];
+static size_t finalizer_head = 0;
+static size_t finalizer_count = 0;
+static bool is_finalizer_immediate = false;
+
+
+void iotjs_defer_finalizer(void* wrap, JFreeHandlerType destroy) {
+  if (is_finalizer_immediate ||
+      finalizer_count == IOTJS_FINALIZER_QUEUE_SIZE) {
+    destroy(wrap);
+    return;
+  }
+
+  size_t tail =
+      (finalizer_head + finalizer_count) % IOTJS_FINALIZER_QUEUE_SIZE;
+  finalizers[tail].wrap = wrap;
+  finalizers[tail].destroy = destroy;
+  finalizer_count++;
+}
+
+
+size_t iotjs_finalizer_count() {
+  return finalizer_count;
+}
+
+
+bool iotjs_run_finalizers(bool is_all) {
+  // A destroy may free objects whose wraps are queued behind, which wait for
+  // the next run unless all are destroyed.
+  size_t budget = is_all ? SIZE_MAX : IOTJS_FINALIZER_BUDGET;
+  while (finalizer_count > 0 && budget-- > 0) {
+    iotjs_finalizer_t finalizer = finalizers[finalizer_head];
+    finalizer_head = (finalizer_head + 1) % IOTJS_FINALIZER_QUEUE_SIZE;
+    finalizer_count--;
+    finalizer.destroy(finalizer.wrap);
+  }
+  return finalizer_count > 0;
+}
+
+
+void iotjs_finalizers_cleanup() {
+  iotjs_run_finalizers(true);
+  is_finalizer_immediate = true;
+}
@@ -22,8 +22,12 @@
 
 // This wrapper refer javascript object but never increase reference count
 // If the object is freed by GC, then this wrapper instance will be also freed.
+// The wrapper may also cache the callbacks that native code calls on events of
+// the object (see iotjs_jobjectwrap_initialize_callbacks).
 typedef struct {
   iotjs_jval_t jobject;
+  iotjs_jval_t* jcallbacks;
+  uint32_t jcallback_count;
 } IOTJS_VALIDATED_STRUCT(iotjs_jobjectwrap_t);
 
 void iotjs_jobjectwrap_initialize(iotjs_jobjectwrap_t* jobjectwrap,
@@ -36,12 +40,94 @@ iotjs_jval_t* iotjs_jobjectwrap_jobject(iotjs_jobjectwrap_t* jobjectwrap);
 iotjs_jobjectwrap_t* iotjs_jobjectwrap_from_jobject(
     const iotjs_jval_t* jobject);
 
+// Callback slots.
+// `jcallbacks` is an array of `count` slots owned by the module wrap. Like
+// the javascript object, the slots are not referenced by the wrapper; the
+// values are kept alive by a hidden array of the object instead, so that a
+// callback referring back to the object does not keep it from the GC.
+void iotjs_jobjectwrap_initialize_callbacks(iotjs_jobjectwrap_t* jobjectwrap,
+                                            iotjs_jval_t* jcallbacks,
+                                            uint32_t count);
+const iotjs_jval_t* iotjs_jobjectwrap_jcallback(
+    iotjs_jobjectwrap_t* jobjectwrap, uint32_t index);
+
+// Accessors of the slots, called by the getter and setter of the property.
+void iotjs_jobjectwrap_get_callback(iotjs_jhandler_t* jhandler, uint32_t index,
+                                    JNativeInfoType* native_info);
+void iotjs_jobjectwrap_set_callback(iotjs_jhandler_t* jhandler, uint32_t index,
+                                    JNativeInfoType* native_info);
+
+// Defines the native getter and setter of a callback slot of this module,
+// to be installed on the prototype with iotjs_jval_set_accessor.
+#define IOTJS_DEFINE_CALLBACK_ACCESSORS(name, index)                     \
+  JHANDLER_FUNCTION(Get##name) {                                         \
+    iotjs_jobjectwrap_get_callback(jhandler, index,                      \
+                                   &this_module_native_info);            \
+  }                                                                      \
+  JHANDLER_FUNCTION(Set##name) {                                         \
+    iotjs_jobjectwrap_set_callback(jhandler, index,                      \
+                                   &this_module_native_info);            \
+  }
+
+// Finalizers.
+// The wraps of the objects freed by the GC are queued by the free callbacks
+// below, and destroyed from the event loop, at most IOTJS_FINALIZER_BUDGET of
+// them in an iteration, so that the pause of the GC does not include their
+// native cleanups. A wrap is destroyed at once when the queue is full.
+#ifndef IOTJS_FINALIZER_QUEUE_SIZE
+#if defined(__NUTTX__) || defined(__TIZENRT__)
+#define IOTJS_FINALIZER_QUEUE_SIZE 32
+#else
+#define IOTJS_FINALIZER_QUEUE_SIZE 256
+#endif
+#endif
+#ifndef IOTJS_FINALIZER_BUDGET
+#define IOTJS_FINALIZER_BUDGET 32
+#endif
+
+void iotjs_defer_finalizer(void* wrap, JFreeHandlerType destroy);
+// The count of the queued wraps.
+size_t iotjs_finalizer_count();
+// Destroys the queued wraps within the budget, or all of them with `is_all`.
+// Returns whether any are left.
+bool iotjs_run_finalizers(bool is_all);
+// Destroys the queued wraps, and from now on the freed ones at once.
+void iotjs_finalizers_cleanup();
+
 #define IOTJS_DEFINE_NATIVE_HANDLE_INFO(module)                              \
+  static void iotjs_##module##_finalize(void* wrap) {                        \
+    iotjs_defer_finalizer(wrap, (JFreeHandlerType)iotjs_##module##_destroy); \
+  }                                                                          \
   static const jerry_object_native_info_t module##_native_info = {           \
-    .free_cb = (jerry_object_native_free_callback_t)iotjs_##module##_destroy \
+    .free_cb = iotjs_##module##_finalize                                     \
   }
 
 #define IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(name)                  \
+  static void iotjs_##name##_destroy(iotjs_##name##_t* wrap);              \
+  static void iotjs_##name##_finalize(void* wrap) {                        \
+    iotjs_defer_finalizer(wrap, (JFreeHandlerType)iotjs_##name##_destroy); \
+  }                                                                        \
+  static const jerry_object_native_info_t this_module_native_info = {      \
+    .free_cb = iotjs_##name##_finalize                                     \
+  }
+
+// The wraps that other native code hands data to, as a tcp splice does, are
+// detached in the sweep of the GC: `detach` cuts them off from that code
+// without calling the engine, and only their destroy is deferred.
+#define IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE_DETACH(name)           \
+  static void iotjs_##name##_destroy(iotjs_##name##_t* wrap);              \
+  static void iotjs_##name##_detach(iotjs_##name##_t* wrap);               \
+  static void iotjs_##name##_finalize(void* wrap) {                        \
+    iotjs_##name##_detach((iotjs_##name##_t*)wrap);                        \
+    iotjs_defer_finalizer(wrap, (JFreeHandlerType)iotjs_##name##_destroy); \
+  }                                                                        \
+  static const jerry_object_native_info_t this_module_native_info = {      \
+    .free_cb = iotjs_##name##_finalize                                     \
+  }
+
+// The wraps whose handles call back until they are destroyed are destroyed
+// in the sweep of the GC, before the handles may see the freed object.
+#define IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE_IMMEDIATE(name)        \
   static void iotjs_##name##_destroy(iotjs_##name##_t* wrap);              \
   static const jerry_object_native_info_t this_module_native_info = {      \
     .free_cb = (jerry_object_native_free_callback_t)iotjs_##name##_destroy \
@@ -0,0 +1,39 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IOTJS_PROBES_H
+#define IOTJS_PROBES_H
+
+
+// Static tracepoints of the `iotjs` provider, for bpftrace, perf or
+// SystemTap to attach to a running process. A probe is a single nop until a
+// tracer enables it, and its arguments are only read then. Without
+// ENABLE_PROBES, or off Linux, the probes and their arguments compile away.
+#if defined(ENABLE_PROBES) && defined(__linux__)
+
+#include <sys/sdt.h>
+
+#define IOTJS_PROBE1(name, a1) DTRACE_PROBE1(iotjs, name, a1)
+#define IOTJS_PROBE2(name, a1, a2) DTRACE_PROBE2(iotjs, name, a1, a2)
+
+#else /* !ENABLE_PROBES || !__linux__ */
+
+#define IOTJS_PROBE1(name, a1)
+#define IOTJS_PROBE2(name, a1, a2)
+
+#endif /* ENABLE_PROBES && __linux__ */
+
+
+#endif /* IOTJS_PROBES_H */
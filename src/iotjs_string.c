@@ -27,6 +27,7 @@ iotjs_string_t iotjs_string_create() {
 
   _this->size = 0;
   _this->data = NULL;
+  _this->inline_data[0] = '\0';
 
   return str;
 }
@@ -36,25 +37,43 @@ iotjs_string_t iotjs_string_create_with_size(const char* data, size_t size) {
   iotjs_string_t str;
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_string_t, &str);
 
-  _this->size = size;
+  _this->size = 0;
+  _this->data = NULL;
+  _this->inline_data[0] = '\0';
 
   if (size > 0) {
     IOTJS_ASSERT(data != NULL);
-    _this->data = iotjs_buffer_allocate(size);
-    memcpy(_this->data, data, size);
-  } else {
-    _this->data = NULL;
+    char* dest = iotjs_string_prepare(&str, size);
+    memcpy(dest, data, size);
   }
 
   return str;
 }
 
 
+char* iotjs_string_prepare(iotjs_string_t* str, size_t size) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_string_t, str);
+
+  IOTJS_ASSERT(_this->data == NULL);
+
+  _this->size = size;
+
+  if (size < IOTJS_STRING_INLINE_SIZE) {
+    _this->inline_data[size] = '\0';
+    return _this->inline_data;
+  }
+
+  _this->data = iotjs_buffer_allocate(size);
+  return _this->data;
+}
+
+
 iotjs_string_t iotjs_string_create_with_buffer(char* buffer, size_t size) {
   iotjs_string_t str;
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_string_t, &str);
 
   _this->size = size;
+  _this->inline_data[0] = '\0';
 
   if (size > 0) {
     IOTJS_ASSERT(buffer != NULL);
@@ -72,8 +91,8 @@ void iotjs_string_destroy(iotjs_string_t* str) {
 
   if (_this->data != NULL) {
     iotjs_buffer_release(_this->data);
-    _this->size = 0;
   }
+  _this->size = 0;
 }
 
 
@@ -89,9 +108,10 @@ void iotjs_string_make_empty(iotjs_string_t* str) {
 
   if (_this->data != NULL) {
     iotjs_buffer_release(_this->data);
-    _this->size = 0;
     _this->data = NULL;
   }
+  _this->size = 0;
+  _this->inline_data[0] = '\0';
 }
 
 
@@ -104,22 +124,30 @@ void iotjs_string_append(iotjs_string_t* str, const char* data, size_t size) {
     return;
   }
 
+  size_t new_size = _this->size + size;
+
   if (_this->data != NULL) {
-    _this->data = iotjs_buffer_reallocate(_this->data, _this->size + size);
+    _this->data = iotjs_buffer_reallocate(_this->data, new_size);
+  } else if (new_size < IOTJS_STRING_INLINE_SIZE) {
+    memcpy(_this->inline_data + _this->size, data, size);
+    _this->inline_data[new_size] = '\0';
+    _this->size = new_size;
+    return;
   } else {
-    IOTJS_ASSERT(_this->size == 0);
-    _this->data = iotjs_buffer_allocate(size);
+    // The string outgrows the struct.
+    _this->data = iotjs_buffer_allocate(new_size);
+    memcpy(_this->data, _this->inline_data, _this->size);
   }
 
   memcpy(_this->data + _this->size, data, size);
-  _this->size += size;
+  _this->size = new_size;
 }
 
 
 const char* iotjs_string_data(const iotjs_string_t* str) {
   const IOTJS_VALIDATED_STRUCT_METHOD(iotjs_string_t, str);
   if (_this->data == NULL) {
-    return "";
+    return _this->inline_data;
   }
 
   return _this->data;
@@ -17,9 +17,18 @@
 #define IOTJS_STRING_H
 
 
+// Strings shorter than this are kept in the struct, zero terminated, and
+// need no allocation.
+#ifndef IOTJS_STRING_INLINE_SIZE
+#define IOTJS_STRING_INLINE_SIZE 32
+#endif
+
+
 typedef struct {
   size_t size;
+  // The bytes on the heap, or NULL if they are in `inline_data`.
   char* data;
+  char inline_data[IOTJS_STRING_INLINE_SIZE];
 } IOTJS_VALIDATED_STRUCT(iotjs_string_t);
 
 // Create new string
@@ -27,6 +36,10 @@ iotjs_string_t iotjs_string_create();
 iotjs_string_t iotjs_string_create_with_size(const char* data, size_t size);
 iotjs_string_t iotjs_string_create_with_buffer(char* buffer, size_t size);
 
+// Make room for `size` bytes in an empty string, in the struct if they fit,
+// and return where to write them.
+char* iotjs_string_prepare(iotjs_string_t* str, size_t size);
+
 // Destroy string
 void iotjs_string_destroy(iotjs_string_t* str);
 
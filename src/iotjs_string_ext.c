@@ -58,9 +58,26 @@ static const jerry_char_ptr_t magic_string_items[] = {
 };
 
 
+//
+// declare perfect hash tables of the strings
+//
+static const uint16_t magic_string_hash_displacements[] = {
+  JERRY_MAGIC_STRING_HASH_DISPLACEMENTS
+};
+
+static const uint16_t magic_string_hash_slots[] = {
+  JERRY_MAGIC_STRING_HASH_SLOTS
+};
+
+
 void iotjs_register_jerry_magic_string(void) {
   uint32_t num_magic_string_items =
       (uint32_t)(sizeof(magic_string_items) / sizeof(jerry_char_ptr_t));
   jerry_register_magic_strings(magic_string_items, num_magic_string_items,
                                magic_string_lengths);
+  jerry_register_magic_strings_hash(
+      magic_string_hash_displacements,
+      (uint32_t)(sizeof(magic_string_hash_displacements) / sizeof(uint16_t)),
+      magic_string_hash_slots,
+      (uint32_t)(sizeof(magic_string_hash_slots) / sizeof(uint16_t)));
 }
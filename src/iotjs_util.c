@@ -15,8 +15,10 @@
 
 
 #include "iotjs_def.h"
+#include "iotjs_memory.h"
 #include "iotjs_util.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -64,24 +66,371 @@ iotjs_string_t iotjs_file_read(const char* path) {
 }
 
 
+bool iotjs_file_write(const char* path, const char* data, size_t size) {
+  size_t path_len = strlen(path);
+  char* tmp_path = iotjs_buffer_allocate(path_len + sizeof(".tmp"));
+  memcpy(tmp_path, path, path_len);
+  memcpy(tmp_path + path_len, ".tmp", sizeof(".tmp"));
+
+  bool written = false;
+  FILE* file = fopen(tmp_path, "wb");
+  if (file != NULL) {
+    written = (fwrite(data, 1, size, file) == size);
+    written = (fclose(file) == 0) && written;
+  }
+
+  if (written) {
+    written = (rename(tmp_path, path) == 0);
+  }
+  if (!written) {
+    remove(tmp_path);
+  }
+
+  iotjs_buffer_release(tmp_path);
+  return written;
+}
+
+
+// Buffers are allocated with a header holding their size, so that the memory
+// governor knows the bytes held by the native side. Buffers may be allocated
+// and released by the threads of the threadpool as well.
+typedef union {
+  size_t size;
+  void* ptr;
+  double align;
+} iotjs_buffer_header_t;
+
+static size_t buffer_allocated_size = 0;
+
+#if defined(__GNUC__)
+#define IOTJS_BUFFER_SIZE_ADD(size) \
+  __sync_fetch_and_add(&buffer_allocated_size, (size))
+#define IOTJS_BUFFER_SIZE_SUB(size) \
+  __sync_fetch_and_sub(&buffer_allocated_size, (size))
+#else
+#define IOTJS_BUFFER_SIZE_ADD(size) (buffer_allocated_size += (size))
+#define IOTJS_BUFFER_SIZE_SUB(size) (buffer_allocated_size -= (size))
+#endif
+
+
 char* iotjs_buffer_allocate(size_t size) {
-  char* buffer = (char*)(calloc(size, sizeof(char)));
-  IOTJS_ASSERT(buffer != NULL);
-  return buffer;
+  IOTJS_ASSERT(size <= SIZE_MAX - sizeof(iotjs_buffer_header_t));
+  size_t total_size = sizeof(iotjs_buffer_header_t) + size;
+
+  iotjs_buffer_header_t* header =
+      (iotjs_buffer_header_t*)calloc(total_size, sizeof(char));
+  // Retry once the pools have been emptied.
+  if (header == NULL && iotjs_memory_relieve_native()) {
+    header = (iotjs_buffer_header_t*)calloc(total_size, sizeof(char));
+  }
+  IOTJS_ASSERT(header != NULL);
+
+  header->size = size;
+  IOTJS_BUFFER_SIZE_ADD(size);
+  return (char*)(header + 1);
 }
 
 
 char* iotjs_buffer_reallocate(char* buffer, size_t size) {
   IOTJS_ASSERT(buffer != NULL);
-  return (char*)(realloc(buffer, size));
+  IOTJS_ASSERT(size <= SIZE_MAX - sizeof(iotjs_buffer_header_t));
+  size_t total_size = sizeof(iotjs_buffer_header_t) + size;
+
+  iotjs_buffer_header_t* header = (iotjs_buffer_header_t*)buffer - 1;
+  size_t old_size = header->size;
+
+  iotjs_buffer_header_t* new_header =
+      (iotjs_buffer_header_t*)realloc(header, total_size);
+  if (new_header == NULL && iotjs_memory_relieve_native()) {
+    new_header = (iotjs_buffer_header_t*)realloc(header, total_size);
+  }
+  if (new_header == NULL) {
+    // The buffer is kept as it was.
+    return NULL;
+  }
+
+  new_header->size = size;
+  IOTJS_BUFFER_SIZE_SUB(old_size);
+  IOTJS_BUFFER_SIZE_ADD(size);
+  return (char*)(new_header + 1);
 }
 
 
 void iotjs_buffer_release(char* buffer) {
   IOTJS_ASSERT(buffer != NULL);
-  free(buffer);
+  iotjs_buffer_header_t* header = (iotjs_buffer_header_t*)buffer - 1;
+  IOTJS_BUFFER_SIZE_SUB(header->size);
+  free(header);
+}
+
+
+size_t iotjs_buffer_allocated_size() {
+  return buffer_allocated_size;
+}
+
+
+size_t iotjs_buffer_size(const char* buffer) {
+  IOTJS_ASSERT(buffer != NULL);
+  return ((const iotjs_buffer_header_t*)buffer - 1)->size;
+}
+
+// Read buffers are allocated with a header, which tells the size class of the
+// buffer, and links it into the free list of the class while it is pooled.
+// Buffers larger than the largest class are not pooled.
+#define IOTJS_READ_BUFFER_MIN_SIZE 256
+#define IOTJS_READ_BUFFER_CLASS_COUNT 5 /* up to 64KB, four times each */
+
+typedef union iotjs_read_buffer_header_t {
+  struct {
+    union iotjs_read_buffer_header_t* next;
+    size_t size_class;
+  } info;
+  double align;
+} iotjs_read_buffer_header_t;
+
+static iotjs_read_buffer_header_t*
+    read_buffer_pool[IOTJS_READ_BUFFER_CLASS_COUNT];
+static unsigned read_buffer_pool_count[IOTJS_READ_BUFFER_CLASS_COUNT];
+
+
+static size_t iotjs_read_buffer_class_size(size_t size_class) {
+  return (size_t)IOTJS_READ_BUFFER_MIN_SIZE << (2 * size_class);
+}
+
+
+char* iotjs_read_buffer_allocate(size_t* size) {
+  size_t size_class = 0;
+  while (size_class < IOTJS_READ_BUFFER_CLASS_COUNT &&
+         iotjs_read_buffer_class_size(size_class) < *size) {
+    size_class++;
+  }
+
+  iotjs_read_buffer_header_t* header;
+
+  if (size_class < IOTJS_READ_BUFFER_CLASS_COUNT) {
+    *size = iotjs_read_buffer_class_size(size_class);
+    header = read_buffer_pool[size_class];
+
+    if (header != NULL) {
+      read_buffer_pool[size_class] = header->info.next;
+      read_buffer_pool_count[size_class]--;
+      return (char*)(header + 1);
+    }
+  }
+
+  header = (iotjs_read_buffer_header_t*)iotjs_buffer_allocate(
+      sizeof(iotjs_read_buffer_header_t) + *size);
+  header->info.size_class = size_class;
+  return (char*)(header + 1);
+}
+
+
+void iotjs_read_buffer_release(char* buffer) {
+  IOTJS_ASSERT(buffer != NULL);
+  iotjs_read_buffer_header_t* header = (iotjs_read_buffer_header_t*)buffer - 1;
+  size_t size_class = header->info.size_class;
+
+  if (size_class < IOTJS_READ_BUFFER_CLASS_COUNT &&
+      read_buffer_pool_count[size_class] < IOTJS_READ_BUFFER_POOL_HIGH_WATER) {
+    header->info.next = read_buffer_pool[size_class];
+    read_buffer_pool[size_class] = header;
+    read_buffer_pool_count[size_class]++;
+    return;
+  }
+
+  iotjs_buffer_release((char*)header);
+}
+
+
+void iotjs_read_buffer_pool_cleanup() {
+  for (size_t i = 0; i < IOTJS_READ_BUFFER_CLASS_COUNT; i++) {
+    while (read_buffer_pool[i] != NULL) {
+      iotjs_read_buffer_header_t* header = read_buffer_pool[i];
+      read_buffer_pool[i] = header->info.next;
+      iotjs_buffer_release((char*)header);
+    }
+    read_buffer_pool_count[i] = 0;
+  }
+}
+
+
+// The first read of a handle is of this size. A read which fills its buffer
+// makes the next one of the next size class, four times larger, and the
+// buffers shrink to twice the average of the reads otherwise.
+#define IOTJS_READ_BUFFER_INITIAL_SIZE 4096
+
+
+void iotjs_read_sizer_init(iotjs_read_sizer_t* sizer) {
+  sizer->average = 0;
+  sizer->size = IOTJS_READ_BUFFER_INITIAL_SIZE < IOTJS_MAX_READ_BUFFER_SIZE
+                    ? IOTJS_READ_BUFFER_INITIAL_SIZE
+                    : IOTJS_MAX_READ_BUFFER_SIZE;
 }
 
+
+size_t iotjs_read_sizer_next(const iotjs_read_sizer_t* sizer,
+                             size_t suggested_size) {
+  return sizer->size < suggested_size ? sizer->size : suggested_size;
+}
+
+
+void iotjs_read_sizer_update(iotjs_read_sizer_t* sizer, size_t nread,
+                             size_t size) {
+  const size_t max_size = IOTJS_MAX_READ_BUFFER_SIZE;
+
+  if (nread >= size) {
+    // More is likely to be waiting, as in a bulk transfer.
+    sizer->average = nread;
+    sizer->size = size < max_size / 4 ? size * 4 : max_size;
+    return;
+  }
+
+  sizer->average = (sizer->average * 3 + nread) / 4;
+  size_t next_size = sizer->average * 2;
+  if (next_size < IOTJS_READ_BUFFER_MIN_SIZE) {
+    next_size = IOTJS_READ_BUFFER_MIN_SIZE;
+  } else if (next_size > max_size) {
+    next_size = max_size;
+  }
+  sizer->size = next_size;
+}
+
+
+static iotjs_pool_t* pool_list = NULL;
+
+
+void* iotjs_pool_allocate(iotjs_pool_t* pool) {
+  IOTJS_ASSERT(pool->size >= sizeof(void*));
+
+  if (pool->allocated == 0 && pool->reused == 0) {
+    pool->next = pool_list;
+    pool_list = pool;
+  }
+
+  if (++pool->in_use > pool->peak) {
+    pool->peak = pool->in_use;
+  }
+
+  void* block = pool->free_list;
+  if (block == NULL) {
+    pool->allocated++;
+    return iotjs_buffer_allocate(pool->size);
+  }
+
+  pool->free_list = *(void**)block;
+  pool->free_count--;
+  pool->reused++;
+  memset(block, 0, pool->size);
+  return block;
+}
+
+
+void iotjs_pool_release(iotjs_pool_t* pool, void* block) {
+  IOTJS_ASSERT(block != NULL);
+  IOTJS_ASSERT(pool->in_use > 0);
+  pool->in_use--;
+
+  if (pool->free_count < pool->cap) {
+    *(void**)block = pool->free_list;
+    pool->free_list = block;
+    pool->free_count++;
+    return;
+  }
+
+  iotjs_buffer_release((char*)block);
+}
+
+
+const iotjs_pool_t* iotjs_pool_list() {
+  return pool_list;
+}
+
+
+void iotjs_pool_cleanup() {
+  for (iotjs_pool_t* pool = pool_list; pool != NULL; pool = pool->next) {
+    while (pool->free_list != NULL) {
+      void* block = pool->free_list;
+      pool->free_list = *(void**)block;
+      iotjs_buffer_release((char*)block);
+    }
+    pool->free_count = 0;
+  }
+}
+
+
+#ifdef ENABLE_JS_COMPRESSION
+// Reads the part of a literal or match length above 14, which follows as
+// bytes that are added up until one is not 255.
+static bool iotjs_lz4_read_length(const uint8_t** src, const uint8_t* src_end,
+                                  size_t* length) {
+  uint8_t byte;
+  do {
+    if (*src >= src_end) {
+      return false;
+    }
+    byte = *(*src)++;
+    *length += byte;
+  } while (byte == 255);
+
+  return true;
+}
+
+
+bool iotjs_lz4_decompress(const uint8_t* src, size_t src_size, char* dst,
+                          size_t dst_size) {
+  const uint8_t* src_end = src + src_size;
+  char* out = dst;
+  char* out_end = dst + dst_size;
+
+  while (src < src_end) {
+    uint8_t token = *src++;
+
+    size_t length = token >> 4;
+    if (length == 15 && !iotjs_lz4_read_length(&src, src_end, &length)) {
+      return false;
+    }
+    if (length > (size_t)(src_end - src) || length > (size_t)(out_end - out)) {
+      return false;
+    }
+    memcpy(out, src, length);
+    out += length;
+    src += length;
+
+    // The last sequence has literals only.
+    if (src == src_end) {
+      break;
+    }
+
+    if (src_end - src < 2) {
+      return false;
+    }
+    size_t offset = (size_t)src[0] | ((size_t)src[1] << 8);
+    src += 2;
+    if (offset == 0 || offset > (size_t)(out - dst)) {
+      return false;
+    }
+
+    length = (size_t)(token & 15) + 4;
+    if ((token & 15) == 15 && !iotjs_lz4_read_length(&src, src_end, &length)) {
+      return false;
+    }
+    if (length > (size_t)(out_end - out)) {
+      return false;
+    }
+
+    // The match may overlap the bytes it produces, so it is copied forward
+    // byte by byte.
+    const char* match = out - offset;
+    while (length-- > 0) {
+      *out++ = *match++;
+    }
+  }
+
+  return out == out_end;
+}
+#endif
+
+
 void print_stacktrace() {
 #if defined(__linux__) && defined(DEBUG)
   // TODO: support other platforms
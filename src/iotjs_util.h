@@ -22,10 +22,76 @@
 
 // Return value should be released with iotjs_string_destroy()
 iotjs_string_t iotjs_file_read(const char* path);
+// Replaces the file at once, so that readers never see a partial file
+bool iotjs_file_write(const char* path, const char* data, size_t size);
 
 char* iotjs_buffer_allocate(size_t size);
 char* iotjs_buffer_reallocate(char* buffer, size_t size);
 void iotjs_buffer_release(char* buff);
+// Bytes of the buffers allocated and not released yet.
+size_t iotjs_buffer_allocated_size();
+// Bytes asked for when `buffer` was allocated or last reallocated.
+size_t iotjs_buffer_size(const char* buffer);
+
+// Buffers for reading from handles, recycled through a pool of a few size
+// classes. `size` is rounded up to the size of the class.
+char* iotjs_read_buffer_allocate(size_t* size);
+void iotjs_read_buffer_release(char* buffer);
+// Releases the free buffers of the pool.
+void iotjs_read_buffer_pool_cleanup();
+
+// Sizes the read buffers of a handle by a moving average of its reads, from
+// the smallest size class up to IOTJS_MAX_READ_BUFFER_SIZE.
+typedef struct {
+  size_t average;
+  size_t size;
+} iotjs_read_sizer_t;
+
+void iotjs_read_sizer_init(iotjs_read_sizer_t* sizer);
+// Size of the next read buffer, at most `suggested_size`.
+size_t iotjs_read_sizer_next(const iotjs_read_sizer_t* sizer,
+                             size_t suggested_size);
+// Counts a read of `nread` bytes into a buffer of `size` bytes.
+void iotjs_read_sizer_update(iotjs_read_sizer_t* sizer, size_t nread,
+                             size_t size);
+
+// A pool of blocks of one size, such as the request wrappers of a kind. Up to
+// `cap` released blocks are kept for reuse instead of being freed. Blocks are
+// handed out zeroed, as by IOTJS_ALLOC().
+typedef struct iotjs_pool_t {
+  const char* name;
+  size_t size;
+  unsigned cap;
+  void* free_list;
+  unsigned free_count;
+  unsigned in_use;
+  unsigned peak;     // the most blocks in use at once
+  size_t allocated;  // blocks allocated from the system
+  size_t reused;     // allocations served by the free list
+  struct iotjs_pool_t* next;  // in the list of the pools used so far
+} iotjs_pool_t;
+
+#define IOTJS_DEFINE_POOL(pool, type, name, cap)                              \
+  static iotjs_pool_t pool = { name, sizeof(type), cap, NULL, 0, 0, 0, 0, 0, \
+                               NULL }
+
+#define IOTJS_POOL_ALLOC(pool, type) (type*)iotjs_pool_allocate(&pool)
+#define IOTJS_POOL_RELEASE(pool, ptr) iotjs_pool_release(&pool, (void*)ptr)
+
+void* iotjs_pool_allocate(iotjs_pool_t* pool);
+void iotjs_pool_release(iotjs_pool_t* pool, void* block);
+// The pools used so far, linked by `next`.
+const iotjs_pool_t* iotjs_pool_list();
+// Releases the free blocks of all pools.
+void iotjs_pool_cleanup();
+
+#ifdef ENABLE_JS_COMPRESSION
+// Decompresses the LZ4 block `src`, written by tools/js2c.py, into the
+// `dst_size` bytes of `dst`. Returns false unless the block is well formed
+// and fills `dst` exactly.
+bool iotjs_lz4_decompress(const uint8_t* src, size_t src_size, char* dst,
+                          size_t dst_size);
+#endif
 
 #define IOTJS_ALLOC(type) /* Allocate (type)-sized, (type*)-typed memory */ \
   (type*)iotjs_buffer_allocate(sizeof(type))
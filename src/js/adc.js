@@ -13,8 +13,13 @@
  * limitations under the License.
  */
 
+var util = require('util');
 var adc = process.binding(process.binding.adc).Adc;
 
+
+var SAMPLING_FREQUENCY_MAX = 100000;
+var SAMPLES_MAX = 32 * 1024;
+
 function Adc() {
   if (!(this instanceof Adc)) {
     return new Adc();
@@ -25,4 +30,37 @@ Adc.prototype.open = function(configuration, callback) {
   return new adc(configuration, callback);
 };
 
+// Reads the pin `frequency` times a second on a thread of its own, and calls
+// back `callback(err, data, missed)` with a Buffer of `samples` 16 bit little
+// endian values at a time.
+adc.prototype.startSampling = function(options, callback) {
+  options = options || {};
+  var frequency = options.frequency;
+  var samples = util.isUndefined(options.samples) ? 64 : options.samples;
+
+  if (!util.isNumber(frequency) || frequency < 1 ||
+      frequency > SAMPLING_FREQUENCY_MAX) {
+    throw new RangeError('frequency must be between 1 and ' +
+                         SAMPLING_FREQUENCY_MAX);
+  }
+  if (!util.isNumber(samples) || samples < 1 || samples > SAMPLES_MAX ||
+      samples % 1 != 0) {
+    throw new RangeError('samples must be an integer between 1 and ' +
+                         SAMPLES_MAX);
+  }
+  if (!util.isFunction(callback)) {
+    throw new TypeError('Bad arguments - callback should be Function');
+  }
+
+  this.samplingStart(Math.round(1000000 / frequency), samples);
+  this.onData = callback;
+};
+
+
+adc.prototype.stopSampling = function() {
+  this.samplingStop();
+  this.onData = null;
+};
+
+
 module.exports = Adc;
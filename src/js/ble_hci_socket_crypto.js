@@ -34,7 +34,8 @@
  * SOFTWARE.
  */
 
-var crypto = require('ble_hci_socket_crypto');
+var crypto = require('crypto');
+var cryptoBuiltin = process.binding(process.binding.crypto);
 
 function r() {
   return crypto.randomBytes(16);
@@ -69,17 +70,10 @@ function s1(k, r1, r2) {
   ]));
 }
 
+// The security function e of the Bluetooth Core Specification, which is
+// AES-128 on the byte-reversed key and data.
 function e(key, data) {
-  key = swap(key);
-  data = swap(data);
-
-  var cipher = crypto.createCipheriv('aes-128-ecb', key, '');
-  cipher.setAutoPadding(false);
-
-  return swap(Buffer.concat([
-    cipher.update(data),
-    cipher.final()
-  ]));
+  return cryptoBuiltin.aesEncrypt(key, data, true);
 }
 
 function xor(b1, b2) {
@@ -93,17 +87,6 @@ function xor(b1, b2) {
   return result;
 }
 
-function swap(input) {
-  var output = new Buffer(input.length);
-
-  for (var i = 0; i < output.length; i++) {
-    //output[i] = input[input.length - i - 1];
-    output.writeUInt8(input.readUInt8(input.length - i - 1), i);
-  }
-
-  return output;
-}
-
 module.exports = {
   r: r,
   c1: c1,
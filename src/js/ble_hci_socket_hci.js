@@ -47,7 +47,6 @@ var HCI_ACLDATA_PKT = 0x02;
 var HCI_EVENT_PKT = 0x04;
 
 var ACL_START_NO_FLUSH = 0x00;
-var ACL_CONT  = 0x01;
 var ACL_START = 0x02;
 
 var EVT_DISCONN_COMPLETE = 0x05;
@@ -57,6 +56,7 @@ var EVT_CMD_STATUS = 0x0f;
 var EVT_LE_META_EVENT = 0x3e;
 
 var EVT_LE_CONN_COMPLETE = 0x01;
+var EVT_LE_ADVERTISING_REPORT = 0x02;
 var EVT_LE_CONN_UPDATE_COMPLETE = 0x03;
 
 var OGF_LINK_CTL = 0x01;
@@ -81,6 +81,8 @@ var OCF_LE_SET_ADVERTISING_PARAMETERS = 0x0006;
 var OCF_LE_SET_ADVERTISING_DATA = 0x0008;
 var OCF_LE_SET_SCAN_RESPONSE_DATA = 0x0009;
 var OCF_LE_SET_ADVERTISE_ENABLE = 0x000a;
+var OCF_LE_SET_SCAN_PARAMETERS = 0x000b;
+var OCF_LE_SET_SCAN_ENABLE = 0x000c;
 var OCF_LE_LTK_NEG_REPLY = 0x001B;
 
 var DISCONNECT_CMD = OCF_DISCONNECT | OGF_LINK_CTL << 10;
@@ -100,6 +102,8 @@ var LE_SET_ADVERTISING_PARAMETERS_CMD = OCF_LE_SET_ADVERTISING_PARAMETERS | OGF_
 var LE_SET_ADVERTISING_DATA_CMD = OCF_LE_SET_ADVERTISING_DATA | OGF_LE_CTL << 10;
 var LE_SET_SCAN_RESPONSE_DATA_CMD = OCF_LE_SET_SCAN_RESPONSE_DATA | OGF_LE_CTL << 10;
 var LE_SET_ADVERTISE_ENABLE_CMD = OCF_LE_SET_ADVERTISE_ENABLE | OGF_LE_CTL << 10;
+var LE_SET_SCAN_PARAMETERS_CMD = OCF_LE_SET_SCAN_PARAMETERS | OGF_LE_CTL << 10;
+var LE_SET_SCAN_ENABLE_CMD = OCF_LE_SET_SCAN_ENABLE | OGF_LE_CTL << 10;
 var LE_LTK_NEG_REPLY_CMD = OCF_LE_LTK_NEG_REPLY | OGF_LE_CTL << 10;
 
 var HCI_OE_USER_ENDED_CONNECTION = 0x13;
@@ -111,8 +115,7 @@ var Hci = function() {
   this._isDevUp = null;
   this._state = null;
   this._deviceId = null;
-
-  this._handleBuffers = {};
+  this._reportFilter = null;
 
   this.on('stateChange', this.onStateChange.bind(this));
 };
@@ -122,7 +125,7 @@ util.inherits(Hci, events.EventEmitter);
 Hci.STATUS_MAPPER = STATUS_MAPPER;
 
 Hci.prototype.init = function() {
-  this._socket.on('data', this.onSocketData.bind(this));
+  this._socket.on('packets', this.onSocketPackets.bind(this));
   this._socket.on('error', this.onSocketError.bind(this));
 
   var deviceId = process.env.BLENO_HCI_DEVICE_ID ? parseInt(process.env.BLENO_HCI_DEVICE_ID) : undefined;
@@ -131,12 +134,12 @@ Hci.prototype.init = function() {
   if (process.env.HCI_CHANNEL_USER) {
     this._deviceId = this._socket.bindUser(deviceId);
 
-    this._socket.start();
+    this._socket.start(true);
 
     this.reset();
   } else {
     this._deviceId = this._socket.bindRaw(deviceId);
-    this._socket.start();
+    this._socket.start(true);
 
     this.pollIsDevUp();
   }
@@ -177,7 +180,41 @@ Hci.prototype.setSocketFilter = function() {
   filter.writeUInt16LE(opcode, 12);
 
   debug('setting filter to: ' + filter.toString('hex'));
-  this._socket.setFilter(filter);
+  if (this._reportFilter) {
+    this._socket.setFilter(filter, this._reportFilter);
+  } else {
+    this._socket.setFilter(filter);
+  }
+};
+
+// Filters the advertising reports of a scan before they reach JavaScript.
+// Only reports listing one of `options.uuids` as a service, with at least
+// `options.rssi` dBm, are emitted, and the same report of a device is
+// emitted once per `options.duplicateWindow` milliseconds. `null` lets all
+// the reports through.
+Hci.prototype.setReportFilter = function(options) {
+  if (!options) {
+    this._reportFilter = null;
+  } else {
+    var uuids = (options.uuids || []).map(function(uuid) {
+      uuid = String(uuid).replace(/-/g, '').toLowerCase();
+      if (!/^([0-9a-f]{4}|[0-9a-f]{8}|[0-9a-f]{32})$/.test(uuid)) {
+        throw new TypeError('Invalid UUID: ' + uuid);
+      }
+      return new Buffer(uuidUtil.reverseByteOrder(uuid, ''), 'hex');
+    });
+
+    this._reportFilter = {
+      uuids: uuids,
+      rssi: util.isNumber(options.rssi) ? options.rssi : undefined,
+      window: util.isNumber(options.duplicateWindow) ?
+              options.duplicateWindow : 0
+    };
+  }
+
+  if (this._isDevUp) {
+    this.setSocketFilter();
+  }
 };
 
 Hci.prototype.setEventMask = function() {
@@ -371,6 +408,45 @@ Hci.prototype.setAdvertiseEnable = function(enabled) {
   this._socket.write(cmd);
 };
 
+Hci.prototype.setScanParameters = function() {
+  var cmd = new Buffer(11);
+
+  // header
+  cmd.writeUInt8(HCI_COMMAND_PKT, 0);
+  cmd.writeUInt16LE(LE_SET_SCAN_PARAMETERS_CMD, 1);
+
+  // length
+  cmd.writeUInt8(0x07, 3);
+
+  // data
+  cmd.writeUInt8(0x01, 4); // type: 0 -> passive, 1 -> active
+  cmd.writeUInt16LE(0x0010, 5); // interval, ms * 1.6
+  cmd.writeUInt16LE(0x0010, 7); // window, ms * 1.6
+  cmd.writeUInt8(0x00, 9); // own address type: 0 -> public, 1 -> random
+  cmd.writeUInt8(0x00, 10); // filter: 0 -> all event types
+
+  debug('set scan parameters - writing: ' + cmd.toString('hex'));
+  this._socket.write(cmd);
+};
+
+Hci.prototype.setScanEnabled = function(enabled, filterDuplicates) {
+  var cmd = new Buffer(6);
+
+  // header
+  cmd.writeUInt8(HCI_COMMAND_PKT, 0);
+  cmd.writeUInt16LE(LE_SET_SCAN_ENABLE_CMD, 1);
+
+  // length
+  cmd.writeUInt8(0x02, 3);
+
+  // data
+  cmd.writeUInt8(enabled ? 0x01 : 0x00, 4); // enable: 0 -> disabled, 1 -> enabled
+  cmd.writeUInt8(filterDuplicates ? 0x01 : 0x00, 5); // duplicates: 0 -> reported, 1 -> filtered
+
+  debug('set scan enabled - writing: ' + cmd.toString('hex'));
+  this._socket.write(cmd);
+};
+
 Hci.prototype.disconnect = function(handle, reason) {
   var cmd = new Buffer(7);
 
@@ -424,95 +500,55 @@ Hci.prototype.writeAclDataPkt = function(handle, cid, data) {
   this._socket.write(pkt);
 };
 
-Hci.prototype.onSocketData = function(data) {
-  debug('onSocketData: ' + data.toString('hex'));
-
-  var eventType = data.readUInt8(0);
-  var handle;
-
-  debug('\tevent type = ' + eventType);
-
-  if (HCI_EVENT_PKT === eventType) {
-    var subEventType = data.readUInt8(1);
-
-    debug('\tsub event type = ' + subEventType);
-
-    if (subEventType === EVT_DISCONN_COMPLETE) {
-      handle =  data.readUInt16LE(4);
-      var reason = data.readUInt8(6);
-
-      debug('\t\thandle = ' + handle);
-      debug('\t\treason = ' + reason);
-
-      this.emit('disconnComplete', handle, reason);
-    } else if (subEventType === EVT_ENCRYPT_CHANGE) {
-      handle =  data.readUInt16LE(4);
-      var encrypt = data.readUInt8(6);
-
-      debug('\t\thandle = ' + handle);
-      debug('\t\tencrypt = ' + encrypt);
-
-      this.emit('encryptChange', handle, encrypt);
-    } else if (subEventType === EVT_CMD_COMPLETE) {
-      var cmd = data.readUInt16LE(4);
-      var status = data.readUInt8(6);
-      var result = data.slice(7);
-
-      debug('\t\tcmd = ' + cmd);
-      debug('\t\tstatus = ' + status);
-      debug('\t\tresult = ' + result.toString('hex'));
-
-      this.processCmdCompleteEvent(cmd, status, result);
-    } else if (subEventType === EVT_LE_META_EVENT) {
-      var leMetaEventType = data.readUInt8(3);
-      var leMetaEventStatus = data.readUInt8(4);
-      var leMetaEventData = data.slice(5);
-
-      debug('\t\tLE meta event type = ' + leMetaEventType);
-      debug('\t\tLE meta event status = ' + leMetaEventStatus);
-      debug('\t\tLE meta event data = ' + leMetaEventData.toString('hex'));
-
-      this.processLeMetaEvent(leMetaEventType, leMetaEventStatus, leMetaEventData);
+// The socket decodes the packets natively and joins the ACL fragments, and
+// emits the packets read at once as an array of
+//   [HCI_EVENT_PKT, EVT_DISCONN_COMPLETE, handle, reason]
+//   [HCI_EVENT_PKT, EVT_ENCRYPT_CHANGE, handle, encrypt]
+//   [HCI_EVENT_PKT, EVT_CMD_COMPLETE, cmd, status, result]
+//   [HCI_EVENT_PKT, EVT_LE_META_EVENT, type, status, data]
+//   [HCI_EVENT_PKT, EVT_LE_META_EVENT, EVT_LE_ADVERTISING_REPORT, type,
+//    addressType, rssi, address, data]
+//   [HCI_ACLDATA_PKT, handle, cid, data]
+// where each advertising report has passed the report filter.
+Hci.prototype.onSocketPackets = function(packets) {
+  for (var i = 0; i < packets.length; i++) {
+    var packet = packets[i];
+
+    if (packet[0] === HCI_ACLDATA_PKT) {
+      debug('onSocketPackets: acl handle = ' + packet[1] +
+            ', cid = ' + packet[2] + ', data = ' + packet[3].toString('hex'));
+
+      this.emit('aclDataPkt', packet[1], packet[2], packet[3]);
+      continue;
     }
-  } else if (HCI_ACLDATA_PKT === eventType) {
-    var flags = data.readUInt16LE(1) >> 12;
-    handle = data.readUInt16LE(1) & 0x0fff;
-
-    if (ACL_START === flags) {
-      var cid = data.readUInt16LE(7);
-
-      var length = data.readUInt16LE(5);
-      var pktData = data.slice(9);
-
-      debug('\t\tcid = ' + cid);
 
-      if (length === pktData.length) {
-        debug('\t\thandle = ' + handle);
-        debug('\t\tdata = ' + pktData.toString('hex'));
-
-        this.emit('aclDataPkt', handle, cid, pktData);
-      } else {
-        this._handleBuffers[handle] = {
-          length: length,
-          cid: cid,
-          data: pktData
-        };
-      }
-    } else if (ACL_CONT === flags) {
-      if (!this._handleBuffers[handle] || !this._handleBuffers[handle].data) {
-        return;
-      }
-
-      this._handleBuffers[handle].data = Buffer.concat([
-        this._handleBuffers[handle].data,
-        data.slice(5)
-      ]);
-
-      if (this._handleBuffers[handle].data.length === this._handleBuffers[handle].length) {
-        this.emit('aclDataPkt', handle, this._handleBuffers[handle].cid, this._handleBuffers[handle].data);
-
-        delete this._handleBuffers[handle];
-      }
+    debug('onSocketPackets: event = ' + packet[1]);
+
+    switch (packet[1]) {
+      case EVT_DISCONN_COMPLETE:
+        debug('\t\thandle = ' + packet[2] + ', reason = ' + packet[3]);
+        this.emit('disconnComplete', packet[2], packet[3]);
+        break;
+      case EVT_ENCRYPT_CHANGE:
+        debug('\t\thandle = ' + packet[2] + ', encrypt = ' + packet[3]);
+        this.emit('encryptChange', packet[2], packet[3]);
+        break;
+      case EVT_CMD_COMPLETE:
+        debug('\t\tcmd = ' + packet[2] + ', status = ' + packet[3]);
+        this.processCmdCompleteEvent(packet[2], packet[3], packet[4]);
+        break;
+      case EVT_LE_META_EVENT:
+        if (packet[2] === EVT_LE_ADVERTISING_REPORT) {
+          this.emit('leAdvertisingReport', 0, packet[3],
+                    uuidUtil.reverseByteOrder(packet[6].toString('hex'), ':'),
+                    packet[4] === 0x01 ? 'random' : 'public',
+                    packet[7], packet[5]);
+          break;
+        }
+        debug('\t\tLE meta event type = ' + packet[2] +
+              ', status = ' + packet[3]);
+        this.processLeMetaEvent(packet[2], packet[3], packet[4]);
+        break;
     }
   }
 };
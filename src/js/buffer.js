@@ -37,17 +37,22 @@ var bufferBuiltin = process.binding(process.binding.buffer);
 var util = require('util');
 
 
-function checkInt(buffer, value, offset, ext, max, min) {
-  if (value > max || value < min)
-    throw new TypeError('value is out of bounds');
-  if (offset + ext > buffer.length)
-    throw new RangeError('index out of range');
-}
-
-
-function checkOffset(offset, ext, length) {
-  if (offset + ext > length)
-    throw new RangeError('index out of range');
+// The types of the numbers read and written natively, in the order of
+// iotjs_buffer_number_type_t in iotjs_module_buffer.c.
+var NUMBER_TYPES = [
+  'Int8', 'UInt8',
+  'Int16LE', 'Int16BE', 'UInt16LE', 'UInt16BE',
+  'Int32LE', 'Int32BE', 'UInt32LE', 'UInt32BE',
+  'FloatLE', 'FloatBE', 'DoubleLE', 'DoubleBE'
+];
+
+
+function numberType(name) {
+  var type = NUMBER_TYPES.indexOf(name);
+  if (type < 0) {
+    throw new TypeError('Unknown number type: ' + name);
+  }
+  return type;
 }
 
 
@@ -57,9 +62,26 @@ function checkOffset(offset, ext, length) {
 // [3] new Buffer(string)
 // [4] new Buffer(string, encoding)
 // [5] new Buffer(array)
-function Buffer(subject, encoding) {
+// [6] new Buffer(arrayBuffer[, byteOffset[, length]])
+function Buffer(subject, encoding, length) {
   if (!util.isBuffer(this)) {
-    return new Buffer(subject);
+    return new Buffer(subject, encoding, length);
+  }
+
+  if (bufferBuiltin.isArrayBuffer(subject)) {
+    // The buffer shares the memory of the ArrayBuffer.
+    var byteOffset = encoding === undefined ? 0 : encoding >>> 0;
+    if (byteOffset > subject.byteLength) {
+      throw new RangeError('byteOffset is out of bounds');
+    }
+    if (length === undefined) {
+      length = subject.byteLength - byteOffset;
+    } else if ((length >>> 0) > subject.byteLength - byteOffset) {
+      throw new RangeError('length is out of bounds');
+    }
+    this.length = length >>> 0;
+    this._builtin = new bufferBuiltin(this, this.length, subject, byteOffset);
+    return;
   }
 
   if (util.isNumber(subject)) {
@@ -69,7 +91,8 @@ function Buffer(subject, encoding) {
   } else if (util.isBuffer(subject) || util.isArray(subject)) {
     this.length = subject.length;
   } else {
-    throw new TypeError('Bad arguments: Buffer(string|number|Buffer|Array)');
+    throw new TypeError('Bad arguments: ' +
+                        'Buffer(string|number|Buffer|Array|ArrayBuffer)');
   }
 
   this._builtin = new bufferBuiltin(this, this.length);
@@ -82,6 +105,9 @@ function Buffer(subject, encoding) {
             throw new TypeError('Invalid hex string');
           }
           break;
+        case 'base64':
+          this._builtin.base64Write(subject, 0, this.length);
+          break;
         default:
           this.write(subject);
       }
@@ -91,15 +117,17 @@ function Buffer(subject, encoding) {
   } else if (util.isBuffer(subject)) {
     subject.copy(this);
   } else if (util.isArray(subject)) {
-    for (var i = 0; i < this.length; ++i) {
-      this._builtin.writeUInt8(subject[i], i);
-    }
+    this._builtin.writeArray(numberType('UInt8'), subject, 0, true);
   }
 }
 
 
-// Buffer.byteLength(string)
+// Buffer.byteLength(string[, encoding])
 Buffer.byteLength = function(str, encoding) {
+  if (encoding === 'base64') {
+    return bufferBuiltin.base64ByteLength(str);
+  }
+
   var len = bufferBuiltin.byteLength(str);
 
   if (encoding !== undefined && util.isString(encoding)) {
@@ -229,12 +257,27 @@ Buffer.prototype.slice = function(start, end) {
 // [1] buff.toString()
 // [2] buff.toString(start)
 // [3] buff.toString(start, end)
-// [4] buff.toString('hex')
+// [4] buff.toString(encoding[, start[, end]])
+// * encoding - 'utf8', 'hex' or 'base64'
 // * start - default to 0
 // * end - default to buff.length
 Buffer.prototype.toString = function(start, end) {
-  if (util.isString(start) && start === "hex" && end === undefined) {
-      return this._builtin.toHexString();
+  if (util.isString(start)) {
+    var encoding = start;
+    var buffer = this;
+    if (arguments.length > 1) {
+      // The slice shares the memory of the buffer, so nothing is copied.
+      buffer = this.slice(end, arguments[2]);
+    }
+
+    switch (encoding) {
+      case 'hex':
+        return buffer._builtin.toHexString();
+      case 'base64':
+        return buffer._builtin.toBase64String();
+      default:
+        return buffer._builtin.toString(0, buffer.length);
+    }
   }
   start = start === undefined ? 0 : ~~start;
   end = end === undefined ? this.length : ~~end;
@@ -243,95 +286,128 @@ Buffer.prototype.toString = function(start, end) {
 };
 
 
-// buff.writeUInt8(value, offset[,noAssert])
-// [1] buff.writeUInt8(value, offset)
-// [2] buff.writeUInt8(value, offset, noAssert)
-Buffer.prototype.writeUInt8 = function(value, offset, noAssert) {
-  value = +value;
+// buff.read<Type>(offset[, noAssert])
+// buff.write<Type>(value, offset[, noAssert])
+// * Type - one of NUMBER_TYPES, e.g. buff.readInt16BE(offset)
+// * noAssert - skips the checks of the value and the offset
+// The numbers are read and written natively, and the checks are made there.
+NUMBER_TYPES.forEach(function(name, type) {
+  Buffer.prototype['read' + name] = function(offset, noAssert) {
+    return this._builtin.readNumber(type, offset >>> 0, !!noAssert);
+  };
+
+  Buffer.prototype['write' + name] = function(value, offset, noAssert) {
+    return this._builtin.writeNumber(type, +value, offset >>> 0, !!noAssert);
+  };
+});
+
+
+// buff.readArray(type, offset, count[, target])
+// * type - one of NUMBER_TYPES, e.g. 'FloatLE'
+// * target - an array or a typed array to read into, from its index 0
+// Reads `count` numbers in one native call, and returns `target` or a new
+// array of them.
+Buffer.prototype.readArray = function(type, offset, count, target) {
+  type = numberType(type);
   offset = offset >>> 0;
-  if (!noAssert)
-    checkInt(this, value, offset, 1, 0xff, 0);
-  this._builtin.writeUInt8(value & 0xff, offset);
-  return offset + 1;
+  count = count >>> 0;
+  if (target === undefined) {
+    return this._builtin.readArray(type, offset, count);
+  }
+  if (!util.isObject(target)) {
+    throw new TypeError('Bad arguments: target must be an array');
+  }
+  return this._builtin.readArray(type, offset, count, target);
 };
 
 
-// buff.writeUInt16LE(value, offset[,noAssert])
-// [1] buff.writeUInt16LE(value, offset)
-// [2] buff.writeUInt16LE(value, offset, noAssert)
-Buffer.prototype.writeUInt16LE = function(value, offset, noAssert) {
-  value = +value;
-  offset = offset >>> 0;
-  if (!noAssert)
-    checkInt(this, value, offset, 2, 0xffff, 0);
-  this._builtin.writeUInt8(value & 0xff, offset);
-  this._builtin.writeUInt8((value >>> 8) & 0xff, offset + 1);
-  return offset + 2;
+// buff.writeArray(type, values, offset[, noAssert])
+// * type - one of NUMBER_TYPES, e.g. 'Int16BE'
+// * values - an array or a typed array of the numbers to write
+// Returns the offset after the last written number.
+Buffer.prototype.writeArray = function(type, values, offset, noAssert) {
+  type = numberType(type);
+  if (!util.isObject(values)) {
+    throw new TypeError('Bad arguments: values must be an array');
+  }
+  return this._builtin.writeArray(type, values, offset >>> 0, !!noAssert);
 };
 
 
-// buff.writeUInt32LE(value, offset[,noAssert])
-// [1] buff.writeUInt32LE(value, offset)
-// [2] buff.writeUInt32LE(value, offset, noAssert)
-Buffer.prototype.writeUInt32LE = function(value, offset, noAssert) {
-  value = +value;
-  offset = offset >>> 0;
-  if (!noAssert)
-    checkInt(this, value, offset, 4, 0xffffffff, 0);
-  this._builtin.writeUInt8((value >>> 24) & 0xff, offset + 3);
-  this._builtin.writeUInt8((value >>> 16) & 0xff, offset + 2);
-  this._builtin.writeUInt8((value >>> 8) & 0xff, offset + 1);
-  this._builtin.writeUInt8(value & 0xff, offset);
-  return offset + 4;
+// buff.fill(value[, offset[, end]])
+// * value - a number, string or Buffer whose bytes are repeated
+// * offset - default to 0
+// * end - default to buff.length
+Buffer.prototype.fill = function(value, offset, end) {
+  offset = offset === undefined ? 0 : offset >>> 0;
+  end = end === undefined ? this.length : end >>> 0;
+
+  if (util.isNumber(value)) {
+    this._builtin.fill(value & 255, offset, end);
+  } else if (util.isString(value) || util.isBuffer(value)) {
+    if (util.isString(value)) {
+      value = new Buffer(value);
+    }
+    this._builtin.fill(value._builtin, offset, end);
+  }
+  return this;
 };
 
 
-// buff.readUInt8(offset[,noAssert])
-// [1] buff.readUInt8(offset)
-// [2] buff.readUInt8(offset, noAssert)
-Buffer.prototype.readUInt8 = function(offset, noAssert) {
-  offset = offset >>> 0;
-  if (!noAssert)
-    checkOffset(offset, 1, this.length);
-  return this._builtin.readUInt8(offset);
-};
+// buff.indexOf(value[, byteOffset])
+// * value - a number, string or Buffer to search for
+// * byteOffset - default to 0, counted from the end if negative
+Buffer.prototype.indexOf = function(value, byteOffset) {
+  byteOffset = byteOffset === undefined ? 0 : ~~byteOffset;
+  if (byteOffset < 0) {
+    byteOffset = Math.max(this.length + byteOffset, 0);
+  }
 
+  if (util.isNumber(value)) {
+    return this._builtin.indexOf(value & 255, byteOffset);
+  }
 
-// buff.readInt8(offset[,noAssert])
-// [1] buff.readInt8(offset)
-// [2] buff.readInt8(offset, noAssert)
-Buffer.prototype.readInt8 = function(offset, noAssert) {
-  offset = offset >>> 0;
-  if (!noAssert)
-    checkOffset(offset, 1, this.length);
-  var val = this._builtin.readUInt8(offset);
-  return !(val & 0x80) ? val : (0xff - val + 1) * -1;
+  if (util.isString(value)) {
+    value = new Buffer(value);
+  } else if (!util.isBuffer(value)) {
+    throw new TypeError('Bad arguments: buff.indexOf(string|number|Buffer)');
+  }
+  return this._builtin.indexOf(value._builtin, byteOffset);
 };
 
 
-// buff.readUInt16LE(offset[,noAssert])
-// [1] buff.readUInt16LE(offset)
-// [2] buff.readUInt16LE(offset, noAssert)
-Buffer.prototype.readUInt16LE = function(offset, noAssert) {
-  offset = offset >>> 0;
-  if (!noAssert)
-    checkOffset(offset, 2, this.length);
-  return this._builtin.readUInt8(offset) |
-         (this._builtin.readUInt8(offset + 1) << 8);
+// buff.includes(value[, byteOffset])
+Buffer.prototype.includes = function(value, byteOffset) {
+  return this.indexOf(value, byteOffset) != -1;
 };
 
 
-// buff.fill(value)
-Buffer.prototype.fill = function(value) {
-  if (util.isNumber(value)) {
-    value = value & 255;
-    for (var i = 0; i < this.length; i++) {
-      this._builtin.writeUInt8(value, i);
-    }
-  }
-  return this;
+// buff._split(delimiter, start)
+// The frames of the buffer from `start` which are ended by `delimiter`, a
+// non-empty Buffer, as views of the buffer without the delimiters.
+Buffer.prototype._split = function(delimiter, start) {
+  return this._builtin.split(delimiter._builtin, start);
 };
 
 
+// buff.buffer
+// The ArrayBuffer sharing the memory of the buffer, for typed arrays to view
+// it without copying. It is undefined if the engine has no typed arrays.
+Object.defineProperty(Buffer.prototype, 'buffer', {
+  get: function() {
+    return this._builtin.arrayBuffer();
+  },
+});
+
+
+// buff.byteOffset
+// The offset of the buffer in buff.buffer.
+Object.defineProperty(Buffer.prototype, 'byteOffset', {
+  get: function() {
+    return this._builtin.byteOffset();
+  },
+});
+
+
 module.exports = Buffer;
 module.exports.Buffer = Buffer;
@@ -0,0 +1,145 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var EventEmitter = require('events').EventEmitter;
+var util = require('util');
+
+var ClusterWorker = process.binding(process.binding.cluster);
+
+
+// The master starts the workers as new iotjs processes running the same
+// script. Each worker has its own JerryScript heap and event loop; servers
+// listening in the workers share their port, and the kernel spreads the
+// incoming connections over them.
+var cluster = new EventEmitter();
+
+var workerId = process.env.IOTJS_CLUSTER_WORKER;
+
+cluster.isWorker = !!workerId;
+cluster.isMaster = !cluster.isWorker;
+cluster.workers = {};
+
+var nextWorkerId = 1;
+
+var signals = {
+  SIGHUP: 1,
+  SIGINT: 2,
+  SIGKILL: 9,
+  SIGTERM: 15
+};
+
+
+function signalName(signum) {
+  var names = Object.keys(signals);
+  for (var i = 0; i < names.length; ++i) {
+    if (signals[names[i]] == signum) {
+      return names[i];
+    }
+  }
+  return String(signum);
+}
+
+
+function Worker(id) {
+  EventEmitter.call(this);
+
+  this.id = id;
+  this.process = { pid: 0 };
+  this.state = 'none';
+  this._handle = null;
+}
+
+util.inherits(Worker, EventEmitter);
+
+
+Worker.prototype.kill = function(signal) {
+  if (!this._handle) {
+    return;
+  }
+
+  if (signal === undefined) {
+    signal = 'SIGTERM';
+  }
+
+  var signum = util.isNumber(signal) ? signal : signals[signal];
+  if (signum === undefined) {
+    throw new Error('Unknown signal: ' + signal);
+  }
+
+  this._handle.kill(signum);
+};
+
+
+Worker.prototype.isDead = function() {
+  return this.state == 'dead';
+};
+
+
+// Starts a worker process, which runs the main script of the master.
+cluster.fork = function() {
+  if (cluster.isWorker) {
+    throw new Error('cluster.fork() can only be called in the master');
+  }
+
+  var worker = new Worker(nextWorkerId++);
+  var handle = new ClusterWorker();
+
+  var err = handle.spawn(process.argv,
+                         ['IOTJS_CLUSTER_WORKER=' + worker.id]);
+  if (err) {
+    throw new Error('Failed to start a cluster worker: ' + err);
+  }
+
+  handle.onexit = function(code, signum) {
+    handle.close();
+    worker._handle = null;
+    worker.state = 'dead';
+    delete cluster.workers[worker.id];
+
+    // Like node.js, the code is null for a worker killed by a signal.
+    var signal = signum ? signalName(signum) : null;
+    if (signal) {
+      code = null;
+    }
+    worker.emit('exit', code, signal);
+    cluster.emit('exit', worker, code, signal);
+  };
+
+  worker._handle = handle;
+  worker.process.pid = handle.pid;
+  worker.state = 'online';
+  cluster.workers[worker.id] = worker;
+
+  cluster.emit('fork', worker);
+
+  return worker;
+};
+
+
+if (cluster.isWorker) {
+  cluster.worker = new Worker(Number(workerId));
+  cluster.worker.state = 'online';
+} else {
+  // Workers do not outlive the master.
+  process.on('exit', function() {
+    var ids = Object.keys(cluster.workers);
+    for (var i = 0; i < ids.length; ++i) {
+      cluster.workers[ids[i]].kill();
+    }
+  });
+}
+
+
+module.exports = cluster;
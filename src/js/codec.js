@@ -0,0 +1,229 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var util = require('util');
+var codecBuiltin = process.binding(process.binding.codec);
+
+
+function checkOffset(name, value, length) {
+  if (!util.isNumber(value) || value % 1 !== 0 || value < 0 ||
+      value > length) {
+    throw new RangeError(name + ' is out of the buffer');
+  }
+  return value;
+}
+
+
+function checkBuffer(name, buffer) {
+  if (!util.isBuffer(buffer)) {
+    throw new TypeError('Bad arguments: ' + name + ' must be a Buffer');
+  }
+}
+
+
+// The encoding and decoding of one format, which are done natively without
+// creating intermediate strings.
+function Codec(format) {
+  this._format = format;
+}
+
+
+// Encodes `value` into a new Buffer, or into `target` at `offset` without
+// allocating, and returns the count of the bytes written then.
+Codec.prototype.encode = function(value, target, offset) {
+  if (target === undefined) {
+    return codecBuiltin.encode(this._format, value);
+  }
+
+  checkBuffer('target', target);
+  offset = offset === undefined ? 0 :
+           checkOffset('offset', offset, target.length);
+  return codecBuiltin.encode(this._format, value, target, offset);
+};
+
+
+Codec.prototype.decode = function(buffer, start, end) {
+  return decode(this._format, buffer, start, end, false);
+};
+
+
+Codec.prototype.decodeAll = function(buffer, start, end) {
+  return decode(this._format, buffer, start, end, true);
+};
+
+
+function decode(format, buffer, start, end, all) {
+  checkBuffer('buffer', buffer);
+  start = start === undefined ? 0 :
+          checkOffset('start', start, buffer.length);
+  end = end === undefined ? buffer.length :
+        checkOffset('end', end, buffer.length);
+  if (start > end) {
+    throw new RangeError('start is after end');
+  }
+  return codecBuiltin.decode(format, buffer, start, end, all);
+}
+
+
+exports.cbor = new Codec(codecBuiltin.CBOR);
+exports.msgpack = new Codec(codecBuiltin.MSGPACK);
+
+
+// The points of a block unless given to the constructor.
+var defaultBlockLength = 128;
+
+
+function checkBlock(series, index) {
+  if (!util.isNumber(index) || index % 1 !== 0 || index < 0 ||
+      index >= series.blockCount) {
+    throw new RangeError('Block index out of range');
+  }
+}
+
+
+function checkBlockCount(name, value, count) {
+  if (!util.isNumber(value) || value % 1 !== 0 || value < 0 ||
+      value > count) {
+    throw new RangeError(name + ' is out of the blocks');
+  }
+  return value;
+}
+
+
+// new TimeSeries([options])
+// * options.blockLength - points of a block, from 1 to 65535
+// A series of (timestamp, value) points compressed in native memory, in
+// blocks which are decoded one at a time.
+function TimeSeries(options) {
+  if (!(this instanceof TimeSeries)) {
+    return new TimeSeries(options);
+  }
+
+  var blockLength = options && options.blockLength !== undefined ?
+                    options.blockLength : defaultBlockLength;
+  if (!util.isNumber(blockLength) || blockLength % 1 !== 0 ||
+      blockLength < 1 || blockLength > 65535) {
+    throw new RangeError('blockLength must be an integer from 1 to 65535');
+  }
+
+  this._series = new codecBuiltin.TimeSeries(blockLength);
+}
+
+
+// Returns a series of the blocks saved with toBuffer(), to which the points
+// appended go in a new block.
+TimeSeries.from = function(buffer, options) {
+  checkBuffer('buffer', buffer);
+  var series = new TimeSeries(options);
+  series._series.load(buffer);
+  return series;
+};
+
+
+// Appends a point, whose timestamp is an integer, such as milliseconds.
+TimeSeries.prototype.append = function(time, value) {
+  if (!util.isNumber(time) || !util.isNumber(value)) {
+    throw new TypeError('Bad arguments: series.append(number, number)');
+  }
+  this._series.append(time, value);
+};
+
+
+Object.defineProperty(TimeSeries.prototype, 'blockCount', {
+  get: function() {
+    return this._series.stats()[0];
+  },
+});
+
+
+Object.defineProperty(TimeSeries.prototype, 'length', {
+  get: function() {
+    return this._series.stats()[1];
+  },
+});
+
+
+Object.defineProperty(TimeSeries.prototype, 'byteLength', {
+  get: function() {
+    return this._series.stats()[2];
+  },
+});
+
+
+// The timestamp of the first point of a block.
+TimeSeries.prototype.blockStart = function(index) {
+  checkBlock(this, index);
+  return this._series.blockStart(index);
+};
+
+
+// The index of the block holding the points from `time` on, which is the
+// last block starting at or before it.
+TimeSeries.prototype.findBlock = function(time) {
+  var low = 0;
+  var high = this.blockCount - 1;
+  if (high < 0 || this._series.blockStart(0) > time) {
+    return -1;
+  }
+  while (low < high) {
+    var middle = (low + high + 1) >> 1;
+    if (this._series.blockStart(middle) <= time) {
+      low = middle;
+    } else {
+      high = middle - 1;
+    }
+  }
+  return low;
+};
+
+
+// Decodes the points of a block, into `times` and `values` if given, and
+// returns their count then.
+TimeSeries.prototype.readBlock = function(index, times, values) {
+  checkBlock(this, index);
+  if (times === undefined) {
+    times = [];
+    values = [];
+    this._series.readBlock(index, times, values);
+    return { times: times, values: values };
+  }
+  if (!util.isObject(times) || !util.isObject(values)) {
+    throw new TypeError('Bad arguments: series.readBlock(index, ' +
+                        'times, values)');
+  }
+  return this._series.readBlock(index, times, values);
+};
+
+
+// Returns the data of the blocks from `start` to `end`, e.g. for saving the
+// full blocks to a file and dropping them.
+TimeSeries.prototype.toBuffer = function(start, end) {
+  var count = this.blockCount;
+  start = start === undefined ? 0 : checkBlockCount('start', start, count);
+  end = end === undefined ? count : checkBlockCount('end', end, count);
+  if (start > end) {
+    throw new RangeError('start is after end');
+  }
+  return this._series.toBuffer(start, end);
+};
+
+
+// Drops the `count` oldest blocks.
+TimeSeries.prototype.drop = function(count) {
+  this._series.drop(checkBlockCount('count', count, this.blockCount));
+};
+
+
+exports.TimeSeries = TimeSeries;
@@ -22,17 +22,33 @@ function Console() {
 }
 
 
+// The arguments are formatted as util.format() does, and written in native
+// code, without creating the message as a string.
 Console.prototype.log =
 Console.prototype.info = function() {
-  consoleBuiltin.stdout(util.format.apply(this, arguments) + '\n');
+  consoleBuiltin.stdout.apply(consoleBuiltin, arguments);
 };
 
 
 Console.prototype.warn =
 Console.prototype.error = function() {
-  consoleBuiltin.stderr(util.format.apply(this, arguments) + '\n');
+  consoleBuiltin.stderr.apply(consoleBuiltin, arguments);
 };
 
+// Makes the output asynchronous, so that a slow terminal or pipe does not
+// block the event loop. Up to `maxQueuedBytes` of output are queued for each
+// of stdout and stderr; while the queue is full, messages are dropped and
+// counted. Returns whether the output of either is asynchronous; regular
+// files are always written synchronously.
+Console.prototype.setAsync = function(enable, maxQueuedBytes) {
+  enable = enable !== false;
+  maxQueuedBytes = util.isNumber(maxQueuedBytes) ? maxQueuedBytes : 0;
+  var stdout = consoleBuiltin.setAsync(1, enable, maxQueuedBytes);
+  var stderr = consoleBuiltin.setAsync(2, enable, maxQueuedBytes);
+  return stdout || stderr;
+};
+
+
 Console.prototype.reboot = function() {
   consoleBuiltin.reboot();
 };
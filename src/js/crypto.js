@@ -0,0 +1,174 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var util = require('util');
+var cryptoBuiltin = process.binding(process.binding.crypto);
+
+
+var AES_BLOCK_SIZE = 16;
+
+
+function toBuffer(data, encoding) {
+  if (util.isBuffer(data)) {
+    return data;
+  }
+  if (util.isString(data)) {
+    return new Buffer(data, encoding);
+  }
+  throw new TypeError('Bad arguments: data must be a Buffer or a string');
+}
+
+
+function encodeDigest(digest, encoding) {
+  return util.isString(encoding) ? digest.toString(encoding) : digest;
+}
+
+
+function checkAlgorithm(algorithm, supported) {
+  if (algorithm !== supported) {
+    throw new Error('Unsupported algorithm: ' + algorithm);
+  }
+}
+
+
+// Hash and Hmac keep the data until digest(), which hashes it in one call.
+function Hash(algorithm) {
+  checkAlgorithm(algorithm, 'sha256');
+  this._chunks = [];
+}
+
+
+Hash.prototype.update = function(data, encoding) {
+  this._chunks.push(toBuffer(data, encoding));
+  return this;
+};
+
+
+Hash.prototype.digest = function(encoding) {
+  var digest = cryptoBuiltin.sha256(this._chunks);
+  this._chunks = [];
+  return encodeDigest(digest, encoding);
+};
+
+
+function Hmac(algorithm, key) {
+  checkAlgorithm(algorithm, 'sha256');
+  this._key = toBuffer(key);
+  this._chunks = [];
+}
+
+
+Hmac.prototype.update = Hash.prototype.update;
+
+
+Hmac.prototype.digest = function(encoding) {
+  var digest = cryptoBuiltin.hmacSha256(this._key,
+                                        Buffer.concat(this._chunks));
+  this._chunks = [];
+  return encodeDigest(digest, encoding);
+};
+
+
+// AES-128 in ECB mode, which encrypts every block on its own.
+function Cipher(algorithm, key) {
+  checkAlgorithm(algorithm, 'aes-128-ecb');
+  this._key = toBuffer(key);
+  if (this._key.length != AES_BLOCK_SIZE) {
+    throw new RangeError('Invalid key length');
+  }
+  this._pending = new Buffer(0);
+  this._autoPadding = true;
+}
+
+
+Cipher.prototype.setAutoPadding = function(autoPadding) {
+  this._autoPadding = autoPadding !== false;
+  return this;
+};
+
+
+Cipher.prototype.update = function(data, encoding) {
+  var input = Buffer.concat([this._pending, toBuffer(data, encoding)]);
+  var length = input.length - input.length % AES_BLOCK_SIZE;
+  this._pending = input.slice(length);
+  return cryptoBuiltin.aesEncrypt(this._key, input.slice(0, length), false);
+};
+
+
+Cipher.prototype.final = function() {
+  var input = this._pending;
+  this._pending = new Buffer(0);
+
+  if (this._autoPadding) {
+    // PKCS#7: every padding byte is the length of the padding.
+    var padding = new Buffer(AES_BLOCK_SIZE - input.length);
+    padding.fill(padding.length);
+    input = Buffer.concat([input, padding]);
+  } else if (input.length > 0) {
+    throw new Error('Data not a multiple of the block length');
+  }
+
+  return cryptoBuiltin.aesEncrypt(this._key, input, false);
+};
+
+
+function createHash(algorithm) {
+  return new Hash(algorithm);
+}
+
+
+function createHmac(algorithm, key) {
+  return new Hmac(algorithm, key);
+}
+
+
+function createCipheriv(algorithm, key, iv) {
+  return new Cipher(algorithm, key);
+}
+
+
+function randomBytes(size, callback) {
+  if (!util.isNumber(size) || size < 0) {
+    throw new TypeError('Bad arguments: size must be a positive number');
+  }
+
+  if (!util.isFunction(callback)) {
+    return cryptoBuiltin.randomBytes(size);
+  }
+
+  var err = null;
+  var bytes;
+  try {
+    bytes = cryptoBuiltin.randomBytes(size);
+  } catch (e) {
+    err = e;
+  }
+  process.nextTick(function() {
+    callback(err, bytes);
+  });
+}
+
+
+// AES-CMAC of RFC 4493, which node.js does not have.
+function aesCmac(key, data) {
+  return cryptoBuiltin.aesCmac(toBuffer(key), toBuffer(data));
+}
+
+
+exports.createHash = createHash;
+exports.createHmac = createHmac;
+exports.createCipheriv = createCipheriv;
+exports.randomBytes = randomBytes;
+exports.aesCmac = aesCmac;
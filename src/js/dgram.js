@@ -42,6 +42,9 @@ var BIND_STATE_UNBOUND = 0;
 var BIND_STATE_BINDING = 1;
 var BIND_STATE_BOUND = 2;
 
+// Most datagrams received at once in batch mode.
+var BATCH_MAX = 20;
+
 // lazily loaded
 var dns = null;
 
@@ -58,9 +61,9 @@ function lookup4(address, callback) {
 }
 
 
-function newHandle(type) {
+function newHandle(type, batch) {
   if (type == 'udp4') {
-    var handle = new UDP();
+    var handle = batch ? new UDP(batch) : new UDP();
     handle.lookup = lookup4;
     return handle;
   }
@@ -78,7 +81,13 @@ function Socket(type, listener) {
     type = options.type;
   }
 
-  var handle = newHandle(type);
+  var batch = options && options.batch;
+  if (batch !== undefined &&
+      (!util.isNumber(batch) || batch < 1 || batch > BATCH_MAX)) {
+    throw new RangeError('batch should be between 1 and ' + BATCH_MAX);
+  }
+
+  var handle = newHandle(type, batch);
   handle.owner = this;
 
   this._handle = handle;
@@ -103,6 +112,7 @@ exports.createSocket = function(type, listener) {
 
 function startListening(socket) {
   socket._handle.onmessage = onMessage;
+  socket._handle.onmessages = onMessages;
   // Todo: handle errors
   socket._handle.recvStart();
   socket._receiving = true;
@@ -338,6 +348,67 @@ function doSend(ex, self, ip, list, address, port, callback) {
 }
 
 
+// Sends each `{ msg, port, address }` of `messages`, as few system calls as
+// possible. `address` is an IPv4 address; host names are not resolved.
+// `callback(err, bytes)` is called once for the whole batch.
+Socket.prototype.sendBatch = function(messages, callback) {
+  var self = this;
+
+  if (!util.isArray(messages)) {
+    throw new TypeError('First argument must be an array');
+  }
+
+  var list = new Array(messages.length * 3);
+  for (var i = 0; i < messages.length; i++) {
+    var message = messages[i];
+    var msg = message && message.msg;
+    var port = message && message.port >>> 0;
+
+    if (util.isString(msg)) {
+      msg = new Buffer(msg);
+    } else if (!util.isBuffer(msg)) {
+      throw new TypeError('msg must be a buffer or a string');
+    }
+    if (port === 0 || port > 65535) {
+      throw new RangeError('Port should be > 0 and < 65536');
+    }
+    if (!util.isString(message.address)) {
+      throw new TypeError('address must be a string');
+    }
+
+    list[i * 3] = msg;
+    list[i * 3 + 1] = port;
+    list[i * 3 + 2] = message.address;
+  }
+
+  if (!(util.isFunction(callback)))
+    callback = undefined;
+
+  self._healthCheck();
+
+  if (self._bindState === BIND_STATE_UNBOUND)
+    self.bind(0, null);
+
+  if (self._bindState !== BIND_STATE_BOUND) {
+    enqueue(self, self.sendBatch.bind(self, messages, callback));
+    return;
+  }
+
+  // `list` keeps the buffers alive until the messages are sent.
+  self._handle.sendBatch(list, function(err, bytes) {
+    if (err) {
+      err = util.errnoException(err, 'sendBatch');
+    } else {
+      err = null;
+    }
+
+    if (util.isFunction(callback)) {
+      callback(err, bytes);
+    }
+  });
+};
+
+
 Socket.prototype.close = function(callback) {
   if (util.isFunction(callback))
     this.on('close', callback);
@@ -471,11 +542,29 @@ function onMessage(nread, handle, buf, rinfo) {
     return self.emit('error', errnoException(nread, 'recvmsg'));
   }
 
-  rinfo.size = buf.length; // compatibility
   self.emit('message', buf, rinfo);
 }
 
 
+// The datagrams received at once in batch mode, as `[msg, address, port,
+// ...]`. Without 'messages' listeners each is emitted as a 'message'.
+function onMessages(handle, list) {
+  var self = handle.owner;
+  if (self.emit('messages', list)) {
+    return;
+  }
+
+  for (var i = 0; i < list.length && self._handle; i += 3) {
+    self.emit('message', list[i], {
+      address: list[i + 1],
+      family: 'IPv4',
+      port: list[i + 2],
+      size: list[i].length
+    });
+  }
+}
+
+
 /*
 TODO: Implement Socket.prototype.ref.
 
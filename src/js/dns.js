@@ -46,18 +46,204 @@ exports.lookup = function lookup(hostname, options, callback) {
   if (family !== 0 && family !== 4 && family !== 6)
     throw new TypeError('invalid argument: family must be 4 or 6');
 
-  if (process.platform != 'nuttx' && process.platform != 'tizenrt') {
-    dnsBuiltin.getaddrinfo(hostname, family, hints, callback);
+  var key = hostname + '/' + family + '/' + hints;
+
+  var entry = cacheGet(key);
+  if (entry) {
+    process.nextTick(function() {
+      callback(entry.err, entry.address, entry.family);
+    });
+    return;
+  }
+
+  // A lookup of the same host is on the way, its result is shared.
+  if (pending[key]) {
+    pending[key].push(callback);
+    return;
+  }
+  pending[key] = [callback];
+
+  var onResolved = function(err, address, family) {
+    var callbacks = pending[key];
+    delete pending[key];
+
+    cachePut(key, err, address, family);
+
+    for (var i = 0; i < callbacks.length; ++i) {
+      callbacks[i](err, address, family);
+    }
+  };
+
+  if (exports.backend === 'resolver' && hasResolver) {
+    resolve(hostname, family, hints, onResolved);
+  } else if (hasResolver) {
+    dnsBuiltin.getaddrinfo(hostname, family, hints, onResolved);
   } else {
     // dnsBuiltin.getaddrinfo is synchronous on these platforms.
     // needs to be wrapped into an asynchronous call.
     process.nextTick(function() {
-      dnsBuiltin.getaddrinfo(hostname, family, hints, callback);
+      dnsBuiltin.getaddrinfo(hostname, family, hints, onResolved);
     });
   }
 };
 
 
+// The lookups are made by `uv_getaddrinfo` in the threadpool, or by the
+// resolver of the module on the event loop with `backend = 'resolver'`. The
+// resolver asks the servers for the A and the AAAA records at once, and asks
+// the next server after `resolverTimeout` milliseconds, `resolverTries` times
+// for each server.
+exports.backend = 'getaddrinfo';
+exports.resolverTimeout = 5000;
+exports.resolverTries = 2;
+
+
+var hasResolver = process.platform != 'nuttx' && process.platform != 'tizenrt';
+var DEFAULT_PORT = 53;
+
+
+// Answers from /etc/hosts or from an address given as hostname first, as
+// getaddrinfo does, and asks the servers only then.
+function resolve(hostname, family, hints, callback) {
+  var local = dnsBuiltin.lookupLocal(hostname, family, hints);
+  if (local) {
+    process.nextTick(function() {
+      callback(null, local[0], local[1]);
+    });
+    return;
+  }
+
+  var options = {
+    timeout: exports.resolverTimeout,
+    tries: exports.resolverTries,
+  };
+  var error = dnsBuiltin.resolve(hostname, family, hints, options, callback);
+  if (util.isString(error)) {
+    process.nextTick(function() {
+      callback(new Error(error));
+    });
+  }
+}
+
+
+// Servers are given as 'address', 'address:port' or '[address]:port'.
+exports.setServers = function(servers) {
+  if (!util.isArray(servers)) {
+    throw new TypeError('invalid argument: servers must be an array');
+  }
+
+  var addresses = [];
+  for (var i = 0; i < servers.length; ++i) {
+    var server = servers[i];
+    if (!util.isString(server)) {
+      throw new TypeError('invalid argument: servers must be strings');
+    }
+
+    var address = server;
+    var port = DEFAULT_PORT;
+    var colon = server.lastIndexOf(':');
+    if (server[0] === '[') {
+      var end = server.indexOf(']');
+      address = server.substring(1, end);
+      if (end < 0 || (end + 1 < server.length && colon !== end + 1)) {
+        throw new TypeError('invalid argument: invalid server ' + server);
+      }
+      if (colon === end + 1) {
+        port = Number(server.substring(colon + 1));
+      }
+    } else if (colon >= 0 && server.indexOf(':') === colon) {
+      address = server.substring(0, colon);
+      port = Number(server.substring(colon + 1));
+    }
+    addresses.push(address, port);
+  }
+
+  dnsBuiltin.setServers(addresses);
+};
+
+
+exports.getServers = function() {
+  var addresses = dnsBuiltin.getServers();
+  var servers = [];
+  for (var i = 0; i < addresses.length; i += 2) {
+    var address = addresses[i];
+    var port = addresses[i + 1];
+    if (port === DEFAULT_PORT) {
+      servers.push(address);
+    } else if (address.indexOf(':') >= 0) {
+      servers.push('[' + address + ']:' + port);
+    } else {
+      servers.push(address + ':' + port);
+    }
+  }
+  return servers;
+};
+
+
+// Resolved addresses are kept for `cacheTtl` milliseconds, and failed lookups
+// for `negativeCacheTtl` milliseconds. At most `cacheSize` results are kept,
+// the least recently used one is dropped first. A ttl of 0 disables caching.
+exports.cacheTtl = 30000;
+exports.negativeCacheTtl = 1000;
+exports.cacheSize = 32;
+
+
+exports.clearCache = function() {
+  cache = {};
+  cacheKeys = [];
+};
+
+
+// results by lookup key, and the keys from the least recently used one.
+var cache = {};
+var cacheKeys = [];
+
+// callbacks of the lookups on the way, by lookup key.
+var pending = {};
+
+
+function cacheGet(key) {
+  var entry = cache[key];
+  if (!entry) {
+    return null;
+  }
+
+  var index = cacheKeys.indexOf(key);
+  cacheKeys.splice(index, 1);
+
+  if (entry.expires <= Date.now()) {
+    delete cache[key];
+    return null;
+  }
+
+  cacheKeys.push(key);
+  return entry;
+}
+
+
+function cachePut(key, err, address, family) {
+  var ttl = err ? exports.negativeCacheTtl : exports.cacheTtl;
+  if (!(ttl > 0) || !(exports.cacheSize > 0)) {
+    return;
+  }
+
+  if (cache[key]) {
+    cacheKeys.splice(cacheKeys.indexOf(key), 1);
+  }
+  while (cacheKeys.length >= exports.cacheSize) {
+    delete cache[cacheKeys.shift()];
+  }
+
+  cache[key] = {
+    err: err,
+    address: address,
+    family: family,
+    expires: Date.now() + ttl,
+  };
+  cacheKeys.push(key);
+}
+
+
 // uv_getaddrinfo flags
 exports.ADDRCONFIG = dnsBuiltin.AI_ADDRCONFIG;
 exports.V4MAPPED = dnsBuiltin.AI_V4MAPPED;
@@ -24,13 +24,17 @@ function EventEmitter() {
 module.exports.EventEmitter = EventEmitter;
 
 
+// The listeners of an event are kept in `_events[type]`: the function itself
+// while there is only one, which is the common case, or an array of them.
 EventEmitter.prototype.emit = function(type) {
   if (!this._events) {
     this._events = {};
   }
 
+  var handler = this._events[type];
+
   // About to emit 'error' event but there are no listeners for it.
-  if (type === 'error' && !this._events.error) {
+  if (type === 'error' && !handler) {
     var err = arguments[1];
     if (err instanceof Error) {
       throw err;
@@ -39,12 +43,35 @@ EventEmitter.prototype.emit = function(type) {
     }
   }
 
-  var listeners = this._events[type];
-  if (util.isArray(listeners)) {
-    listeners = listeners.slice();
-    var args = Array.prototype.slice.call(arguments, 1);
+  if (!handler) {
+    return false;
+  }
+
+  // Events are emitted with a few arguments, which are passed on without
+  // collecting them into an array first. The arguments are only read by
+  // index, so no arguments object is created for the call.
+  var argc = arguments.length - 1;
+  var arg1 = arguments[1];
+  var arg2 = arguments[2];
+  var arg3 = arguments[3];
+  var args;
+  if (argc > 3) {
+    args = new Array(argc);
+    for (var j = 0; j < argc; ++j) {
+      args[j] = arguments[j + 1];
+    }
+  }
+
+  if (util.isFunction(handler)) {
+    callListener(handler, this, argc, arg1, arg2, arg3, args);
+    return true;
+  }
+
+  if (util.isArray(handler)) {
+    // Listeners added or removed by a listener do not change this emit.
+    var listeners = handler.slice();
     for (var i = 0; i < listeners.length; ++i) {
-      listeners[i].apply(this, args);
+      callListener(listeners[i], this, argc, arg1, arg2, arg3, args);
     }
     return true;
   }
@@ -53,6 +80,26 @@ EventEmitter.prototype.emit = function(type) {
 };
 
 
+function callListener(listener, self, argc, arg1, arg2, arg3, args) {
+  switch (argc) {
+    case 0:
+      listener.call(self);
+      break;
+    case 1:
+      listener.call(self, arg1);
+      break;
+    case 2:
+      listener.call(self, arg1, arg2);
+      break;
+    case 3:
+      listener.call(self, arg1, arg2, arg3);
+      break;
+    default:
+      listener.apply(self, args);
+  }
+}
+
+
 EventEmitter.prototype.addListener = function(type, listener) {
   if (!util.isFunction(listener)) {
     throw new TypeError('listener must be a function');
@@ -61,11 +108,15 @@ EventEmitter.prototype.addListener = function(type, listener) {
   if (!this._events) {
     this._events = {};
   }
-  if (!this._events[type]) {
-    this._events[type] = [];
-  }
 
-  this._events[type].push(listener);
+  var handler = this._events[type];
+  if (!handler) {
+    this._events[type] = listener;
+  } else if (util.isFunction(handler)) {
+    this._events[type] = [handler, listener];
+  } else {
+    handler.push(listener);
+  }
 
   return this;
 };
@@ -101,13 +152,17 @@ EventEmitter.prototype.removeListener = function(type, listener) {
   }
 
   var list = this._events[type];
-  if (Array.isArray(list)) {
+  if (util.isFunction(list)) {
+    if (list == listener || list.listener == listener) {
+      delete this._events[type];
+    }
+  } else if (Array.isArray(list)) {
     for (var i = list.length - 1; i >= 0; --i) {
       if (list[i] == listener ||
           (list[i].listener && list[i].listener == listener)) {
         list.splice(i, 1);
-        if (!list.length) {
-          delete this._events[type];
+        if (list.length == 1) {
+          this._events[type] = list[0];
         }
         break;
       }
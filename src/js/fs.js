@@ -17,6 +17,7 @@
 var fs = exports;
 var constants = require('constants');
 var util = require('util');
+var EventEmitter = require('events').EventEmitter;
 var fsBuiltin = process.binding(process.binding.fs);
 
 fs.exists = function(path, callback) {
@@ -131,6 +132,21 @@ fs.readSync = function(fd, buffer, offset, length, position) {
 };
 
 
+// Returns a Buffer mapping the file instead of holding a copy of it.
+fs.mmap = function(fd, offset, length, advice) {
+  if (util.isNullOrUndefined(advice)) {
+    return fsBuiltin.mmap(checkArgNumber(fd, 'fd'),
+                          checkArgNumber(offset, 'offset'),
+                          checkArgNumber(length, 'length'));
+  }
+
+  return fsBuiltin.mmap(checkArgNumber(fd, 'fd'),
+                        checkArgNumber(offset, 'offset'),
+                        checkArgNumber(length, 'length'),
+                        checkArgString(advice, 'advice'));
+};
+
+
 fs.write = function(fd, buffer, offset, length, position, callback) {
   if (util.isFunction(position)) {
     callback = position;
@@ -171,74 +187,28 @@ fs.readFile = function(path, callback) {
   checkArgString(path);
   checkArgFunction(callback);
 
-  var fd;
-  var buffers;
-
-  fs.open(path, 'r', function(err, _fd) {
-    if (err) {
-      return callback(err);
-    }
-
-    fd = _fd;
-    buffers = [];
-
-    // start read
-    read();
-  });
-
-  var read = function() {
-    // Read segment of data.
-    var buffer = new Buffer(1023);
-    fs.read(fd, buffer, 0, 1023, -1, afterRead);
-  };
-
-  var afterRead = function(err, bytesRead, buffer) {
-    if (err) {
-      fs.close(fd, function(err) {
-        return callback(err);
-      });
-    }
-
-    if (bytesRead === 0) {
-      // End of file.
-      close();
-    } else {
-      // continue reading.
-      buffers.push(buffer.slice(0, bytesRead));
-      read();
-    }
-  };
-
-  var close = function() {
-    fs.close(fd, function(err) {
-      return callback(err, Buffer.concat(buffers));
-    });
-  }
+  // The whole file is read natively, in one threadpool job.
+  fsBuiltin.readFile(path, callback);
 };
 
 
 fs.readFileSync = function(path) {
   checkArgString(path);
 
-  var fd = fs.openSync(path, 'r', 438);
-  var buffers = [];
+  return fsBuiltin.readFile(path);
+};
 
-  while (true) {
-    try {
-      var buffer = new Buffer(1023);
-      var bytesRead = fs.readSync(fd, buffer, 0, 1023);
-      if (bytesRead) {
-        buffers.push(buffer.slice(0, bytesRead));
-      } else {
-        break;
-      }
-    } catch (e) {
-      break;
-    }
-  }
-  fs.closeSync(fd);
 
-  return Buffer.concat(buffers);
+// The streams are loaded on first use, most programs do not need them.
+fs.createReadStream = function(path, options) {
+  return new (require('fs_stream').ReadStream)(checkArgString(path, 'path'),
+                                               options);
+};
+
+
+fs.createWriteStream = function(path, options) {
+  return new (require('fs_stream').WriteStream)(checkArgString(path, 'path'),
+                                                options);
 };
 
 
@@ -379,6 +349,262 @@ fs.readdirSync = function(path) {
 };
 
 
+// The events of a change passed by the native watcher.
+var UV_RENAME = 1;
+var UV_CHANGE = 2;
+
+
+// Watches a path with inotify where there is one, and with polls of its
+// stats elsewhere. The native watcher passes the changes of `latency`
+// milliseconds together, so a burst of writes makes one call to JavaScript.
+function FSWatcher() {
+  EventEmitter.call(this);
+  this._handle = null;
+}
+
+util.inherits(FSWatcher, EventEmitter);
+
+
+FSWatcher.prototype.start = function(filename, persistent, latency,
+                                     interval) {
+  var self = this;
+  var handle;
+  var err;
+
+  if (fsBuiltin.FsWatcher) {
+    handle = new fsBuiltin.FsWatcher();
+    handle.onChange = function(status, events, filenames) {
+      for (var i = 0; i < events.length && self._handle; i++) {
+        if (events[i] & UV_RENAME) {
+          self.emit('change', 'rename', filenames[i]);
+        }
+        if ((events[i] & UV_CHANGE) && self._handle) {
+          self.emit('change', 'change', filenames[i]);
+        }
+      }
+      if (status < 0 && self._handle) {
+        self.close();
+        self.emit('error', util.errnoException(status, 'watch', filename));
+      }
+    };
+    err = handle.start(filename, latency, persistent);
+  } else {
+    var name = filename.slice(filename.lastIndexOf('/') + 1);
+    handle = new fsBuiltin.StatWatcher();
+    handle.onChange = function(status, curr, prev) {
+      var renamed = status < 0 || curr.ino !== prev.ino;
+      self.emit('change', renamed ? 'rename' : 'change', name);
+    };
+    err = handle.start(filename, interval, persistent);
+  }
+
+  if (err) {
+    handle.close();
+    throw util.errnoException(err, 'watch', filename);
+  }
+  this._handle = handle;
+};
+
+
+FSWatcher.prototype.close = function() {
+  if (!this._handle) {
+    return;
+  }
+
+  this._handle.close();
+  this._handle = null;
+
+  var self = this;
+  process.nextTick(function() {
+    self.emit('close');
+  });
+};
+
+
+fs.watch = function(filename, options, listener) {
+  if (util.isFunction(options)) {
+    listener = options;
+    options = undefined;
+  }
+  options = options || {};
+
+  var watcher = new FSWatcher();
+  watcher.start(checkArgString(filename, 'filename'),
+                options.persistent !== false,
+                util.isNumber(options.latency) ? options.latency : 20,
+                util.isNumber(options.interval) ? options.interval : 1000);
+
+  if (listener) {
+    watcher.on('change', checkArgFunction(listener, 'listener'));
+  }
+  return watcher;
+};
+
+
+// Polls the stats of a path, for the 'change' listeners of fs.watchFile.
+function StatWatcher() {
+  EventEmitter.call(this);
+  this._handle = null;
+}
+
+util.inherits(StatWatcher, EventEmitter);
+
+
+StatWatcher.prototype.start = function(filename, persistent, interval) {
+  var self = this;
+  var handle = new fsBuiltin.StatWatcher();
+  handle.onChange = function(status, curr, prev) {
+    self.emit('change', curr, prev);
+  };
+
+  var err = handle.start(filename, interval, persistent);
+  if (err) {
+    handle.close();
+    throw util.errnoException(err, 'watch', filename);
+  }
+  this._handle = handle;
+};
+
+
+StatWatcher.prototype.stop = function() {
+  if (this._handle) {
+    this._handle.close();
+    this._handle = null;
+  }
+};
+
+
+// The watchers of fs.watchFile, by path, which their listeners share.
+var statWatchers = {};
+
+
+fs.watchFile = function(filename, options, listener) {
+  if (util.isFunction(options)) {
+    listener = options;
+    options = undefined;
+  }
+  options = options || {};
+  checkArgString(filename, 'filename');
+  checkArgFunction(listener, 'listener');
+
+  var watcher = statWatchers[filename];
+  if (!watcher) {
+    watcher = new StatWatcher();
+    watcher.start(filename, options.persistent !== false,
+                  util.isNumber(options.interval) ? options.interval : 5007);
+    statWatchers[filename] = watcher;
+  }
+
+  watcher.on('change', listener);
+  return watcher;
+};
+
+
+fs.unwatchFile = function(filename, listener) {
+  var watcher = statWatchers[checkArgString(filename, 'filename')];
+  if (!watcher) {
+    return;
+  }
+
+  if (util.isFunction(listener)) {
+    watcher.removeListener('change', listener);
+  } else {
+    watcher.removeAllListeners('change');
+  }
+
+  if (!watcher._events.change) {
+    watcher.stop();
+    delete statWatchers[filename];
+  }
+};
+
+
+// fs.promises is there when the engine has Promise. Its calls pass
+// `usePromise` for the callback, and return the promise which the native
+// layer settles when the call is done, so no closure is made for a call.
+// Bad arguments throw, like they do for the callback API.
+var usePromise = fsBuiltin.usePromise;
+
+if (usePromise) {
+  var promises = fs.promises = {};
+
+  promises.stat = function(path) {
+    return fsBuiltin.stat(checkArgString(path, 'path'), usePromise);
+  };
+
+  promises.fstat = function(fd) {
+    return fsBuiltin.fstat(checkArgNumber(fd, 'fd'), usePromise);
+  };
+
+  promises.open = function(path, flags, mode) {
+    return fsBuiltin.open(checkArgString(path, 'path'),
+                          convertFlags(flags),
+                          convertMode(mode, 438),
+                          usePromise);
+  };
+
+  promises.close = function(fd) {
+    return fsBuiltin.close(checkArgNumber(fd, 'fd'), usePromise);
+  };
+
+  // Resolves to the number of bytes read.
+  promises.read = function(fd, buffer, offset, length, position) {
+    if (util.isNullOrUndefined(position)) {
+      position = -1; // Read from the current position.
+    }
+
+    return fsBuiltin.read(checkArgNumber(fd, 'fd'),
+                          checkArgBuffer(buffer, 'buffer'),
+                          checkArgNumber(offset, 'offset'),
+                          checkArgNumber(length, 'length'),
+                          checkArgNumber(position, 'position'),
+                          usePromise);
+  };
+
+  // Resolves to the number of bytes written.
+  promises.write = function(fd, buffer, offset, length, position) {
+    if (util.isNullOrUndefined(position)) {
+      position = -1; // write at current position.
+    }
+
+    return fsBuiltin.write(checkArgNumber(fd, 'fd'),
+                           checkArgBuffer(buffer, 'buffer'),
+                           checkArgNumber(offset, 'offset'),
+                           checkArgNumber(length, 'length'),
+                           checkArgNumber(position, 'position'),
+                           usePromise);
+  };
+
+  promises.readFile = function(path) {
+    return fsBuiltin.readFile(checkArgString(path, 'path'), usePromise);
+  };
+
+  promises.mkdir = function(path, mode) {
+    return fsBuiltin.mkdir(checkArgString(path, 'path'),
+                           convertMode(mode, 511),
+                           usePromise);
+  };
+
+  promises.rmdir = function(path) {
+    return fsBuiltin.rmdir(checkArgString(path, 'path'), usePromise);
+  };
+
+  promises.unlink = function(path) {
+    return fsBuiltin.unlink(checkArgString(path, 'path'), usePromise);
+  };
+
+  promises.rename = function(oldPath, newPath) {
+    return fsBuiltin.rename(checkArgString(oldPath, 'oldPath'),
+                            checkArgString(newPath, 'newPath'),
+                            usePromise);
+  };
+
+  promises.readdir = function(path) {
+    return fsBuiltin.readdir(checkArgString(path, 'path'), usePromise);
+  };
+}
+
+
 function convertFlags(flag) {
   var O_APPEND = constants.O_APPEND;
   var O_CREAT = constants.O_CREAT;
@@ -0,0 +1,414 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var fs = require('fs');
+var stream = require('stream');
+var util = require('util');
+
+
+var defaultReadHighWaterMark = 64 * 1024;
+var defaultReadAhead = 2;
+var defaultWriteHighWaterMark = 16 * 1024;
+
+
+function ReadRequest(buffer, position) {
+  this.buffer = buffer;
+  this.position = position;
+  this.done = false;
+  this.error = null;
+  this.bytesRead = 0;
+}
+
+
+// Reads a file in chunks of `highWaterMark` bytes, keeping up to `readAhead`
+// reads in flight. The reads go to the threadpool and may complete in any
+// order, so they are queued and pushed in file order.
+function ReadStream(path, options) {
+  if (!(this instanceof ReadStream)) {
+    return new ReadStream(path, options);
+  }
+
+  options = options || {};
+
+  stream.Readable.call(this, options);
+
+  this.path = path;
+  this.fd = util.isNumber(options.fd) ? options.fd : null;
+  this.flags = options.flags || 'r';
+  this.mode = util.isNumber(options.mode) ? options.mode : 438; // 0666
+  this.autoClose = options.autoClose !== false;
+  this.bytesRead = 0;
+
+  this.start = util.isNumber(options.start) ? options.start : undefined;
+  this.end = util.isNumber(options.end) ? options.end : Infinity;
+  if (this.start > this.end) {
+    throw new RangeError('start must be <= end');
+  }
+
+  this._highWaterMark = util.isNumber(options.highWaterMark) &&
+                        options.highWaterMark > 0 ?
+                        options.highWaterMark : defaultReadHighWaterMark;
+
+  // A descriptor without a start position is read where it stands, which
+  // may be a pipe, so one read at a time.
+  this._positional = this.fd === null || this.start !== undefined;
+  this._readAhead = this._positional && util.isNumber(options.readAhead) &&
+                    options.readAhead > 0 ?
+                    options.readAhead : (this._positional ? defaultReadAhead
+                                                          : 1);
+
+  this._position = this.start || 0;
+  this._reading = [];
+  // The file ended, so the reads behind the one that found the end are
+  // dropped; or all of the range up to `end` has been asked for, and the
+  // reads in flight still have data to push.
+  this._eof = false;
+  this._rangeRequested = false;
+  this._closed = false;
+  this._spare = null;
+
+  if (this.fd === null) {
+    this.open();
+  } else {
+    process.nextTick(readMore, this);
+  }
+}
+
+util.inherits(ReadStream, stream.Readable);
+
+
+ReadStream.prototype.open = function() {
+  var self = this;
+
+  fs.open(this.path, this.flags, this.mode, function(err, fd) {
+    if (err) {
+      onError(self, err);
+      return;
+    }
+
+    self.fd = fd;
+    self.emit('open', fd);
+    readMore(self);
+  });
+};
+
+
+ReadStream.prototype.read = function(n) {
+  var res = stream.Readable.prototype.read.call(this, n);
+  readMore(this);
+  return res;
+};
+
+
+ReadStream.prototype.resume = function() {
+  stream.Readable.prototype.resume.call(this);
+  readMore(this);
+  return this;
+};
+
+
+ReadStream.prototype.close = function(callback) {
+  if (util.isFunction(callback)) {
+    this.once('close', callback);
+  }
+  closeStream(this);
+};
+
+
+ReadStream.prototype.destroy = ReadStream.prototype.close;
+
+
+// Starts reads until `readAhead` of them are in flight. A paused stream only
+// reads until it holds `highWaterMark` bytes, so the memory stays bounded
+// when the consumer is slower than the file.
+function readMore(stream) {
+  if (stream.fd === null || stream._closed) {
+    return;
+  }
+
+  var state = stream._readableState;
+  while (!stream._eof && !stream._rangeRequested &&
+         stream._reading.length < stream._readAhead &&
+         (state.flowing || state.length < stream._highWaterMark)) {
+    // The first chunk ends at a multiple of highWaterMark, so the reads after
+    // it are aligned in the file.
+    var length = stream._highWaterMark -
+                 stream._position % stream._highWaterMark;
+    if (stream.end - stream._position + 1 < length) {
+      length = stream.end - stream._position + 1;
+    }
+    if (length <= 0) {
+      stream._rangeRequested = true;
+      break;
+    }
+
+    startRead(stream, length);
+  }
+
+  if ((stream._eof || stream._rangeRequested) &&
+      stream._reading.length == 0) {
+    onEnd(stream);
+  }
+}
+
+
+function startRead(stream, length) {
+  // The buffer of a read that reached the end of the file holds no data
+  // anyone refers to, so it is taken again.
+  var buffer = stream._spare;
+  if (buffer && buffer.length >= length) {
+    stream._spare = null;
+  } else {
+    buffer = new Buffer(length);
+  }
+
+  var req = new ReadRequest(buffer, stream._position);
+  stream._reading.push(req);
+  stream._position += length;
+
+  fs.read(stream.fd, buffer, 0, length,
+          stream._positional ? req.position : null,
+          function(err, bytesRead) {
+    req.done = true;
+    req.error = err;
+    req.bytesRead = bytesRead;
+    flushReads(stream);
+  });
+}
+
+
+// Pushes the data of the reads completed at the front of the queue.
+function flushReads(stream) {
+  if (stream._closed) {
+    return;
+  }
+
+  var reading = stream._reading;
+  while (reading.length > 0 && reading[0].done) {
+    var req = reading.shift();
+
+    if (req.error) {
+      onError(stream, req.error);
+      return;
+    }
+
+    if (req.bytesRead == 0) {
+      // End of file. The reads behind this one found nothing either.
+      stream._eof = true;
+      stream._spare = req.buffer;
+      continue;
+    }
+
+    if (stream._eof) {
+      continue;
+    }
+
+    if (req.bytesRead < req.buffer.length && stream._positional) {
+      // A short read ends the file. Pipes and devices just gave what they
+      // had, and are read until they have nothing more.
+      stream._eof = true;
+    }
+
+    stream.bytesRead += req.bytesRead;
+    stream.push(req.bytesRead < req.buffer.length ?
+                req.buffer.slice(0, req.bytesRead) : req.buffer);
+  }
+
+  readMore(stream);
+}
+
+
+function onEnd(stream) {
+  if (stream._readableState.ended) {
+    return;
+  }
+
+  stream.push(null);
+  if (stream.autoClose) {
+    closeStream(stream);
+  }
+}
+
+
+function onError(stream, err) {
+  if (stream.autoClose) {
+    closeStream(stream);
+  }
+  stream.emit('error', err);
+}
+
+
+function closeStream(stream) {
+  if (stream._closed) {
+    return;
+  }
+  stream._closed = true;
+
+  if (stream.fd === null) {
+    // Not opened; an open in progress is closed as soon as it is done.
+    stream.once('open', function() {
+      stream._closed = false;
+      closeStream(stream);
+    });
+    return;
+  }
+
+  fs.close(stream.fd, function(err) {
+    if (err) {
+      stream.emit('error', err);
+    } else {
+      stream.emit('close');
+    }
+  });
+  stream.fd = null;
+}
+
+
+// Writes down chunks with fs.write(), one request at a time. Small writes of
+// the same tick are joined into one write by `_writev()`.
+function WriteStream(path, options) {
+  if (!(this instanceof WriteStream)) {
+    return new WriteStream(path, options);
+  }
+
+  options = options || {};
+
+  if (!util.isNumber(options.highWaterMark)) {
+    options.highWaterMark = defaultWriteHighWaterMark;
+  }
+
+  stream.Writable.call(this, options);
+
+  this.path = path;
+  this.fd = util.isNumber(options.fd) ? options.fd : null;
+  this.flags = options.flags || 'w';
+  this.mode = util.isNumber(options.mode) ? options.mode : 438; // 0666
+  this.autoClose = options.autoClose !== false;
+  this.bytesWritten = 0;
+
+  this.start = util.isNumber(options.start) ? options.start : undefined;
+  this._position = this.start;
+  this._closed = false;
+
+  var self = this;
+
+  this.on('finish', function() {
+    if (self.autoClose) {
+      closeStream(self);
+    }
+  });
+
+  if (this.fd === null) {
+    this.open();
+  } else {
+    this._readyToWrite();
+  }
+}
+
+util.inherits(WriteStream, stream.Writable);
+
+
+WriteStream.prototype.open = function() {
+  var self = this;
+
+  fs.open(this.path, this.flags, this.mode, function(err, fd) {
+    if (err) {
+      if (self.autoClose) {
+        self._closed = true;
+      }
+      self.emit('error', err);
+      return;
+    }
+
+    self.fd = fd;
+    self.emit('open', fd);
+    if (!self._closed) {
+      self._readyToWrite();
+    }
+  });
+};
+
+
+WriteStream.prototype._write = function(chunk, callback, onwrite) {
+  var self = this;
+
+  if (chunk.length == 0) {
+    process.nextTick(function() {
+      onwrite(null);
+      if (util.isFunction(callback)) {
+        callback.call(self, null);
+      }
+    });
+    return;
+  }
+
+  writeAll(this, chunk, 0, function(err) {
+    if (err) {
+      if (self.autoClose) {
+        closeStream(self);
+      }
+      self.emit('error', err);
+    }
+    onwrite(err);
+    if (util.isFunction(callback)) {
+      callback.call(self, err);
+    }
+  });
+};
+
+
+WriteStream.prototype._writev = function(chunks, callback, onwrite) {
+  this._write(Buffer.concat(chunks), callback, onwrite);
+};
+
+
+WriteStream.prototype.close = function(callback) {
+  if (util.isFunction(callback)) {
+    this.once('close', callback);
+  }
+  closeStream(this);
+};
+
+
+WriteStream.prototype.destroy = WriteStream.prototype.close;
+
+
+function writeAll(stream, buffer, offset, callback) {
+  var length = buffer.length - offset;
+  var position = util.isNumber(stream._position) ? stream._position : null;
+
+  fs.write(stream.fd, buffer, offset, length, position,
+           function(err, written) {
+    if (err) {
+      callback(err);
+      return;
+    }
+
+    stream.bytesWritten += written;
+    if (util.isNumber(stream._position)) {
+      stream._position += written;
+    }
+
+    if (written < length) {
+      writeAll(stream, buffer, offset + written, callback);
+    } else {
+      callback(null);
+    }
+  });
+}
+
+
+exports.ReadStream = ReadStream;
+exports.WriteStream = WriteStream;
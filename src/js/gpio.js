@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+var AdaptiveCaller = require('peripheral_util').AdaptiveCaller;
 var EventEmitter = require('events').EventEmitter;
 var gpio = process.binding(process.binding.gpio);
 var util = require('util');
@@ -21,7 +22,12 @@ var util = require('util');
 var defaultConfiguration = {
   direction: gpio.DIRECTION.OUT,
   mode: gpio.MODE.NONE,
-  edge: gpio.EDGE.NONE
+  edge: gpio.EDGE.NONE,
+  debounce: 0,
+  capture: {
+    batch: 32,
+    latency: 20
+  }
 };
 
 
@@ -41,15 +47,90 @@ Gpio.prototype.MODE = gpio.MODE;
 
 Gpio.prototype.EDGE = gpio.EDGE;
 
+// The most lines of a chip one pin object can drive.
+var LINES_MAX = 64;
+
+// The most edges a pin in capture mode passes on at once.
+var CAPTURE_MAX = 512;
+
+
+function isLineArray(pin) {
+  if (!util.isArray(pin) || pin.length == 0 || pin.length > LINES_MAX) {
+    return false;
+  }
+  for (var i = 0; i < pin.length; ++i) {
+    if (!util.isNumber(pin[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+function checkCapture(configuration) {
+  var capture = configuration.capture;
+  var defaultCapture = defaultConfiguration.capture;
+
+  if (process.platform !== 'linux') {
+    throw new TypeError('Bad configuration - capture is supported on Linux');
+  }
+  if (configuration.direction !== gpio.DIRECTION.IN ||
+      configuration.edge === gpio.EDGE.NONE) {
+    throw new TypeError(
+      'Bad configuration - capture needs an input pin with an edge');
+  }
+  if (capture === true) {
+    capture = {};
+  } else if (!util.isObject(capture)) {
+    throw new TypeError(
+      'Bad configuration - capture should be Boolean or Object');
+  }
+
+  var batch = capture.batch === undefined ? defaultCapture.batch
+                                          : capture.batch;
+  if (!util.isNumber(batch) || batch < 1 || batch > CAPTURE_MAX) {
+    throw new TypeError(
+      'Bad configuration - capture.batch should be a number from 1 to ' +
+      CAPTURE_MAX);
+  }
+
+  var latency = capture.latency === undefined ? defaultCapture.latency
+                                              : capture.latency;
+  if (!util.isNumber(latency) || latency < 0) {
+    throw new TypeError(
+      'Bad configuration - capture.latency should be a non-negative number');
+  }
+
+  return { batch: batch, latency: latency };
+}
+
+
 function gpioPinOpen(configuration, callback) {
   var _binding = null;
+  // The number of lines of a pin of a GPIO chip, which are written and read
+  // together, or 0 for a sysfs pin.
+  var _lineCount = 0;
+  var _caller = new AdaptiveCaller();
 
   function GpioPin(configuration, callback) {
     var self = this;
 
     // validate pin
     if (util.isObject(configuration)) {
-      if (!util.isNumber(configuration.pin)) {
+      if (configuration.chip !== undefined) {
+        if (!util.isNumber(configuration.chip) || configuration.chip < 0) {
+          throw new TypeError(
+            'Bad configuration - chip should be a non-negative number');
+        }
+        if (!util.isNumber(configuration.pin) &&
+            !isLineArray(configuration.pin)) {
+          throw new TypeError(
+            'Bad configuration - pin is mandatory and number or ' +
+            'Array of at most ' + LINES_MAX + ' numbers');
+        }
+        _lineCount = util.isArray(configuration.pin) ?
+                     configuration.pin.length : 1;
+      } else if (!util.isNumber(configuration.pin)) {
         throw new TypeError('Bad configuration - pin is mandatory and number');
       }
     } else {
@@ -100,6 +181,31 @@ function gpioPinOpen(configuration, callback) {
     } else {
       configuration.edge = defaultConfiguration.edge;
     }
+    if (configuration.edge !== gpio.EDGE.NONE && _lineCount > 1) {
+      throw new TypeError('Bad configuration - edge needs a single pin');
+    }
+    if (configuration.edge !== gpio.EDGE.NONE &&
+        process.platform !== 'linux') {
+      throw new TypeError('Bad configuration - edge is supported on Linux');
+    }
+
+    // validate debounce
+    if (configuration.debounce !== undefined) {
+      if (!util.isNumber(configuration.debounce) ||
+          configuration.debounce < 0) {
+        throw new TypeError(
+          'Bad configuration - debounce should be a non-negative number');
+      }
+    } else {
+      configuration.debounce = defaultConfiguration.debounce;
+    }
+
+    // validate capture
+    if (configuration.capture) {
+      configuration.capture = checkCapture(configuration);
+    } else {
+      configuration.capture = undefined;
+    }
 
     EventEmitter.call(this);
 
@@ -107,8 +213,20 @@ function gpioPinOpen(configuration, callback) {
       util.isFunction(callback) && callback.call(self, err);
     });
 
-    _binding.onChange = function() {
-      self.emit('change');
+    _binding.onChange = function(value) {
+      self.emit('change', value);
+    };
+
+    _binding.onCapture = function(times, values, highWidths, lowWidths,
+                                  frequency, dropped) {
+      self.emit('capture', {
+        times: times,
+        values: values,
+        highWidths: highWidths,
+        lowWidths: lowWidths,
+        frequency: frequency,
+        dropped: dropped
+      });
     };
 
     process.on('exit', (function(self) {
@@ -122,20 +240,52 @@ function gpioPinOpen(configuration, callback) {
 
   util.inherits(GpioPin, EventEmitter);
 
-  GpioPin.prototype.write = function(value, callback) {
-    var self = this;
-
-    if (_binding === null) {
-      throw new Error('GPIO pin is not opened');
+  function checkValue(value) {
+    if (util.isArray(value) && _lineCount > 0) {
+      if (value.length != _lineCount) {
+        throw new TypeError(
+          'Bad arguments - value should have ' + _lineCount + ' elements');
+      }
+      return;
     }
 
     if (!util.isNumber(value) && !util.isBoolean(value)) {
       throw new TypeError('Bad arguments - value should be Boolean');
     }
+  }
 
-    _binding.write(!!value, function(err) {
-      util.isFunction(callback) && callback.call(self, err);
-    });
+  function writeLines(value) {
+    if (util.isArray(value)) {
+      var values = [];
+      for (var i = 0; i < value.length; ++i) {
+        values.push(!!value[i]);
+      }
+      _binding.writeLines(values);
+    } else {
+      _binding.write(!!value);
+    }
+  }
+
+  function readLines() {
+    return _lineCount > 1 ? _binding.readLines() : _binding.read();
+  }
+
+  GpioPin.prototype.write = function(value, callback) {
+    if (_binding === null) {
+      throw new Error('GPIO pin is not opened');
+    }
+
+    checkValue(value);
+
+    // The line handle of a GPIO chip does not block, so its calls always run
+    // on the loop thread.
+    var writeAsync = _lineCount > 0 ? null : function(done) {
+      _binding.write(!!value, done);
+    };
+
+    _caller.call(this, callback, function() {
+      writeLines(value);
+    }, writeAsync);
   };
 
   GpioPin.prototype.writeSync = function(value) {
@@ -143,23 +293,21 @@ function gpioPinOpen(configuration, callback) {
       throw new Error('GPIO pin is not opened');
     }
 
-    if (!util.isNumber(value) && !util.isBoolean(value)) {
-      throw new TypeError('Bad arguments - value should be Boolean');
-    }
+    checkValue(value);
 
-    _binding.write(!!value);
+    writeLines(value);
   };
 
   GpioPin.prototype.read = function(callback) {
-    var self = this;
-
     if (_binding === null) {
       throw new Error('GPIO pin is not opened');
     }
 
-    _binding.read(function(err, value) {
-      util.isFunction(callback) && callback.call(self, err, value);
-    });
+    var readAsync = _lineCount > 0 ? null : function(done) {
+      _binding.read(done);
+    };
+
+    _caller.call(this, callback, readLines, readAsync);
   };
 
   GpioPin.prototype.readSync = function() {
@@ -167,7 +315,7 @@ function gpioPinOpen(configuration, callback) {
       throw new Error('GPIO pin is not opened');
     }
 
-    return _binding.read();
+    return readLines();
   };
 
   GpioPin.prototype.close = function(callback) {
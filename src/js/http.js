@@ -14,13 +14,21 @@
  */
 
 var Server = require('http_server').Server;
+var HeaderBlock = require('http_outgoing').HeaderBlock;
 var client = require('http_client');
+var agent = require('http_agent');
 var HTTPParser = process.binding(process.binding.httpparser).HTTPParser;
 
 
 var ClientRequest = exports.ClientRequest = client.ClientRequest;
 
 
+exports.Agent = agent.Agent;
+
+
+exports.globalAgent = agent.globalAgent;
+
+
 exports.request = function(options, cb) {
   return new ClientRequest(options, cb);
 };
@@ -34,6 +42,11 @@ exports.createServer = function(requestListener){
 exports.METHODS = HTTPParser.methods;
 
 
+exports.compileHeaders = function(headers) {
+  return new HeaderBlock(headers);
+};
+
+
 exports.get = function(options, cb) {
   var req = exports.request(options, cb);
   req.end();
@@ -0,0 +1,220 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var net = require('net');
+
+
+// An agent hands out the sockets of client requests. Sockets are grouped by
+// host and port. With `keepAlive`, the socket of a finished request is kept
+// open and given to the next request to the same host, instead of connecting
+// again; an idle socket is closed after `keepAliveMsecs`.
+function Agent(options) {
+  if (!(this instanceof Agent)) {
+    return new Agent(options);
+  }
+
+  options = options || {};
+
+  this.keepAlive = options.keepAlive || false;
+  this.keepAliveMsecs = options.keepAliveMsecs || 1000;
+  this.maxSockets = options.maxSockets || Agent.defaultMaxSockets;
+  this.maxFreeSockets = options.maxFreeSockets || 256;
+
+  // sockets in use, idle sockets and requests waiting for a socket, by name.
+  this.sockets = {};
+  this.freeSockets = {};
+  this.requests = {};
+}
+
+Agent.defaultMaxSockets = Infinity;
+
+// The port of the requests that name none.
+Agent.prototype.defaultPort = 80;
+
+exports.Agent = Agent;
+
+
+Agent.prototype.getName = function(options) {
+  return options.host + ':' + options.port;
+};
+
+
+// Gives a socket to `req` by calling `req.onSocket(socket)`, now or when a
+// socket of the host is free.
+Agent.prototype.addRequest = function(req, options) {
+  var name = this.getName(options);
+  var socket = takeFreeSocket(this, name);
+
+  if (!socket) {
+    var sockets = this.sockets[name] || [];
+    if (sockets.length >= this.maxSockets) {
+      appendTo(this.requests, name, req);
+      return;
+    }
+    socket = this.createSocket(name, options);
+  }
+
+  appendTo(this.sockets, name, socket);
+  req.onSocket(socket);
+};
+
+
+// Connects the server of a request. An agent of another protocol, such as
+// the https agent, overrides it.
+Agent.prototype.createConnection = function(options) {
+  return net.connect(options.port, options.host);
+};
+
+
+Agent.prototype.createSocket = function(name, options) {
+  var self = this;
+  var socket = this.createConnection(options);
+
+  socket._agentName = name;
+  socket._agentOptions = options;
+  socket._agentIdleTimer = null;
+
+  socket.on('free', function() {
+    self.releaseSocket(socket);
+  });
+  socket.once('close', function() {
+    self.removeSocket(socket);
+  });
+
+  return socket;
+};
+
+
+// The request of `socket` has finished, and the socket can be reused.
+Agent.prototype.releaseSocket = function(socket) {
+  var name = socket._agentName;
+  var waiting = this.requests[name];
+
+  if (socket._socketState.destroyed) {
+    return;
+  }
+
+  if (waiting && waiting.length > 0) {
+    var req = waiting.shift();
+    if (waiting.length == 0) {
+      delete this.requests[name];
+    }
+    req.onSocket(socket);
+    return;
+  }
+
+  var free = this.freeSockets[name] || [];
+
+  if (!this.keepAlive || free.length >= this.maxFreeSockets) {
+    socket.destroySoon();
+    return;
+  }
+
+  removeFrom(this.sockets, name, socket);
+  appendTo(this.freeSockets, name, socket);
+
+  socket._agentIdleTimer = setTimeout(function() {
+    socket._agentIdleTimer = null;
+    socket.destroy();
+  }, this.keepAliveMsecs);
+};
+
+
+// `socket` has closed. A request waiting for a socket gets a new one.
+Agent.prototype.removeSocket = function(socket) {
+  var name = socket._agentName;
+
+  clearIdleTimer(socket);
+  removeFrom(this.sockets, name, socket);
+  removeFrom(this.freeSockets, name, socket);
+
+  var waiting = this.requests[name];
+  var sockets = this.sockets[name] || [];
+
+  if (waiting && waiting.length > 0 && sockets.length < this.maxSockets) {
+    var req = waiting.shift();
+    if (waiting.length == 0) {
+      delete this.requests[name];
+    }
+    var newSocket = this.createSocket(name, socket._agentOptions);
+    appendTo(this.sockets, name, newSocket);
+    req.onSocket(newSocket);
+  }
+};
+
+
+// Closes the idle sockets.
+Agent.prototype.destroy = function() {
+  var names = Object.keys(this.freeSockets);
+  for (var i = 0; i < names.length; ++i) {
+    var free = this.freeSockets[names[i]].slice();
+    for (var j = 0; j < free.length; ++j) {
+      clearIdleTimer(free[j]);
+      free[j].destroy();
+    }
+  }
+};
+
+
+function takeFreeSocket(agent, name) {
+  var free = agent.freeSockets[name];
+
+  if (!free) {
+    return null;
+  }
+
+  var socket = free.pop();
+  if (free.length == 0) {
+    delete agent.freeSockets[name];
+  }
+
+  clearIdleTimer(socket);
+  return socket;
+}
+
+
+function clearIdleTimer(socket) {
+  if (socket._agentIdleTimer) {
+    clearTimeout(socket._agentIdleTimer);
+    socket._agentIdleTimer = null;
+  }
+}
+
+
+function appendTo(lists, name, item) {
+  if (!lists[name]) {
+    lists[name] = [];
+  }
+  lists[name].push(item);
+}
+
+
+function removeFrom(lists, name, item) {
+  var list = lists[name];
+  if (!list) {
+    return;
+  }
+
+  var index = list.indexOf(item);
+  if (index >= 0) {
+    list.splice(index, 1);
+  }
+  if (list.length == 0) {
+    delete lists[name];
+  }
+}
+
+
+exports.globalAgent = new Agent();
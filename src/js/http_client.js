@@ -14,24 +14,35 @@
  */
 
 var util = require('util');
-var net = require('net');
 var HTTPParser = process.binding(process.binding.httpparser).HTTPParser;
 var IncomingMessage = require('http_incoming').IncomingMessage;
 var OutgoingMessage = require('http_outgoing').OutgoingMessage;
 var Buffer = require('buffer');
 var common = require('http_common');
+var Agent = require('http_agent').Agent;
+var globalAgent = require('http_agent').globalAgent;
 
 
 function ClientRequest(options, cb) {
   var self = this;
   OutgoingMessage.call(self);
 
+  // `agent: false` makes a socket for this request only.
+  var agent = options.agent;
+  if (agent === undefined) {
+    agent = globalAgent;
+  } else if (agent === false) {
+    agent = new Agent();
+  }
+  self.agent = agent;
+
   // get port, host and method.
-  var port = options.port = options.port || 80;
+  var port = options.port = options.port || agent.defaultPort;
   var host = options.host = options.hostname || options.host || '127.0.0.1';
   var method = options.method || 'GET';
 
   self.path = options.path || '/';
+  self.aborted = undefined;
 
   // If `options` contains header information, save it.
   if (options.headers) {
@@ -47,18 +58,25 @@ function ClientRequest(options, cb) {
     self.once('response', cb);
   }
 
-  // Create socket.
-  var conn = new net.Socket();
-
-  // connect server.
-  conn.connect(port, host);
+  // Basic authentication, from `user:password`.
+  if (options.auth && !self.getHeader('Authorization')) {
+    self.setHeader('Authorization',
+                   'Basic ' + new Buffer(options.auth).toString('base64'));
+  }
 
-  // setup connection information.
-  setupConnection(self, conn);
+  // As in node.js, the server is asked to close a connection that the agent
+  // does not keep.
+  if (!self.getHeader('Connection')) {
+    self.setHeader('Connection', agent.keepAlive ? 'keep-alive' : 'close');
+  }
 
   // store first header line to be sent.
   var firstHeaderLine = method + ' ' + self.path + ' HTTP/1.1\r\n';
   self._storeHeader(firstHeaderLine);
+
+  // The agent connects the server or reuses an idle connection to it. Until
+  // then, the written data is kept by the request.
+  agent.addRequest(self, options);
 }
 
 util.inherits(ClientRequest, OutgoingMessage);
@@ -66,25 +84,47 @@ util.inherits(ClientRequest, OutgoingMessage);
 exports.ClientRequest = ClientRequest;
 
 
+// This is called by the agent when a socket is assigned to the request.
+ClientRequest.prototype.onSocket = function(socket) {
+  // The socket goes back to the agent, for the next request.
+  if (this.aborted) {
+    socket.emit('free');
+    return;
+  }
+
+  setupConnection(this, socket);
+
+  if (this.output.length > 0) {
+    this._flushOutput();
+  }
+};
+
+
 function setupConnection(req, socket) {
-  var parser = common.createHTTPParser();
+  // A connection reused by the agent keeps its parser and listeners.
+  var parser = socket.parser;
+  if (!parser) {
+    parser = common.createHTTPParser();
+    parser.socket = socket;
+    parser.onIncoming = parserOnIncomingClient;
+    socket.parser = parser;
+
+    socket.on('error', socketOnError);
+    socket.on('data', socketOnData);
+    socket.on('end', socketOnEnd);
+    socket.on('close', socketOnClose);
+  }
+
   parser.reinitialize(HTTPParser.RESPONSE);
-  req.socket = socket;
-  req.connection = socket;
-  parser.socket = socket;
   parser.incoming = null;
   parser._headers = [];
+
+  req.socket = socket;
+  req.connection = socket;
   req.parser = parser;
 
-  socket.parser = parser;
   socket._httpMessage = req;
 
-  parser.onIncoming = parserOnIncomingClient;
-  socket.on('error', socketOnError);
-  socket.on('data', socketOnData);
-  socket.on('end', socketOnEnd);
-  socket.on('close', socketOnClose);
-
   // socket emitted when a socket is assigned to req
   process.nextTick(function() {
     req.emit('socket', socket);
@@ -99,6 +139,16 @@ function socketOnClose() {
 
   socket.read();
 
+  if (!req) {
+    // an idle connection of the agent.
+    if (parser) {
+      parser.finish();
+      common.freeHTTPParser(parser);
+      socket.parser = null;
+    }
+    return;
+  }
+
   req.emit('close');
 
   if (req.res && req.res.readable) {
@@ -109,15 +159,16 @@ function socketOnClose() {
     });
     res.push(null);
   }
-  else if (!req.res) {
+  else if (!req.res && !req.aborted) {
     // socket closed before response starts.
     var err = new Error('socket hang up');
     req.emit('error', err);
   }
 
   if (parser) {
-    // unref all links to parser, make parser GCed
+    // unref all links to parser, and give it back for reuse
     parser.finish();
+    common.freeHTTPParser(parser);
     parser = null;
     socket.parser = null;
     req.parser = null;
@@ -130,8 +181,9 @@ function socketOnError(er) {
   var parser = socket.parser;
 
   if (parser) {
-    // unref all links to parser, make parser GCed
+    // unref all links to parser, and give it back for reuse
     parser.finish();
+    common.freeHTTPParser(parser);
     parser = null;
     socket.parser = null;
   }
@@ -144,10 +196,17 @@ function socketOnData(d) {
   var req = this._httpMessage;
   var parser = this.parser;
 
+  if (!req) {
+    // data on an idle connection of the agent.
+    socket.destroy();
+    return;
+  }
+
   var ret = parser.execute(d);
   if (ret instanceof Error) {
-    // unref all links to parser, make parser GCed
+    // unref all links to parser, and give it back for reuse
     parser.finish();
+    common.freeHTTPParser(parser);
     parser = null;
     socket.parser = null;
     req.parser = null;
@@ -164,11 +223,14 @@ function socketOnEnd() {
   var parser = this.parser;
 
   if (parser) {
-    // unref all links to parser, make parser GCed
+    // unref all links to parser, and give it back for reuse
     parser.finish();
+    common.freeHTTPParser(parser);
     parser = null;
     socket.parser = null;
-    req.parser = null;
+    if (req) {
+      req.parser = null;
+    }
   }
 
   socket.destroy();
@@ -177,17 +239,17 @@ function socketOnEnd() {
 
 
 // This is called by parserOnHeadersComplete after response header is parsed.
-// TODO: keepalive support
 function parserOnIncomingClient(res, shouldKeepAlive) {
   var socket = this.socket;
   var req = socket._httpMessage;
 
-  if (req.res) {
+  if (!req || req.res) {
     // server sent responses twice.
     socket.destroy();
     return false;
   }
   req.res = res;
+  req.shouldKeepAlive = shouldKeepAlive;
 
   res.req = req;
 
@@ -207,9 +269,56 @@ var responseOnEnd = function() {
   var req = res.req;
   var socket = req.socket;
 
-  if (socket._socketState.writable) {
-    socket.destroySoon();
+  if (!req.shouldKeepAlive) {
+    if (socket._socketState.writable) {
+      socket.destroySoon();
+    }
+  } else if (req.finished) {
+    responseKeepAlive(req);
+  } else {
+    req.once('prefinish', function() {
+      responseKeepAlive(req);
+    });
+  }
+};
+
+
+// Detaches the request from its connection, and gives the connection back to
+// the agent, which reuses or closes it.
+function responseKeepAlive(req) {
+  var socket = req.socket;
+
+  if (req._onSocketTimeout) {
+    socket.setTimeout(0, req._onSocketTimeout);
+  }
+
+  socket._httpMessage = null;
+  req.parser = null;
+
+  // The parser is still executing the last chunk of the response, so it is
+  // reinitialized for the next request only after it returns.
+  process.nextTick(function() {
+    socket.emit('free');
+  });
+}
+
+
+// Drops the request and the data of the response, and closes the
+// connection of the request.
+ClientRequest.prototype.abort = function() {
+  if (this.aborted) {
+    return;
   }
+
+  this.aborted = Date.now();
+  if (this.socket) {
+    this.socket.destroy();
+  }
+
+  var self = this;
+  process.nextTick(function() {
+    self.emit('abort');
+  });
 };
 
 
@@ -218,14 +327,24 @@ ClientRequest.prototype.setTimeout = function(ms, cb) {
 
   if (cb) self.once('timeout', cb);
 
-  var emitTimeout = function() {
+  var emitTimeout = self._onSocketTimeout = function() {
     self.emit('timeout');
   };
 
-  // In IoT.js, socket is already assigned,
-  // thus, it is sufficient to trigger timeout on socket 'connect' event.
-  this.socket.once('connect', function() {
-    self.socket.setTimeout(ms, emitTimeout);
-  });
+  // The socket may still be connecting, or be assigned later by the agent.
+  var setSocketTimeout = function(socket) {
+    if (socket._socketState.connected) {
+      socket.setTimeout(ms, emitTimeout);
+    } else {
+      socket.once('connect', function() {
+        socket.setTimeout(ms, emitTimeout);
+      });
+    }
+  };
 
+  if (self.socket) {
+    setSocketTimeout(self.socket);
+  } else {
+    self.once('socket', setSocketTimeout);
+  }
 };
@@ -20,10 +20,21 @@ var OutgoingMessage = require('http_outgoing').OutgoingMessage;
 
 
 
+// Parsers of closed connections, kept for the next ones.
+var freeParsers = [];
+var maxFreeParsers = 4;
+
+
 var createHTTPParser = function() {
   // REQUEST is the default type.
   // For RESPONSE, use HTTPParser.reinitialize(HTTPParser.RESPONSE)
-  var parser = new HTTPParser(HTTPParser.REQUEST);
+  var parser = freeParsers.pop();
+  if (parser) {
+    parser.reinitialize(HTTPParser.REQUEST);
+    return parser;
+  }
+
+  parser = new HTTPParser(HTTPParser.REQUEST);
   // cb during  http parsing from C side(http_parser)
   parser.OnHeaders = parserOnHeaders;
   parser.OnHeadersComplete = parserOnHeadersComplete;
@@ -35,11 +46,32 @@ var createHTTPParser = function() {
 exports.createHTTPParser = createHTTPParser;
 
 
+// Gives back the parser of a closed connection. The caller must not use it
+// any more.
+var freeHTTPParser = function(parser) {
+  parser.socket = null;
+  parser.incoming = null;
+  parser.onIncoming = null;
+  parser._headers = [];
+  parser._url = '';
+  parser.setStaticRoutes();
+
+  if (freeParsers.length < maxFreeParsers) {
+    freeParsers.push(parser);
+  }
+};
+
+exports.freeHTTPParser = freeHTTPParser;
+
+
 // This is called when parsing of incoming http msg done
 function parserOnMessageComplete() {
   var stream = this.incoming;
 
   if (stream) {
+    if (stream._bodyLength >= 0) {
+      onBodyCollected(stream);
+    }
     stream.complete = true;
     // no more data from incoming, stream will emit 'end' event
     stream.push(null);
@@ -70,6 +102,11 @@ function parserOnHeadersComplete(info) {
 
   // add header fields of headers to incoming.headers
   this.incoming.addHeaders(headers);
+  this.incoming._contentLength = info.contentLength;
+  this.incoming.upgrade = info.upgrade;
+  this.incoming.httpVersionMajor = info.versionMajor;
+  this.incoming.httpVersionMinor = info.versionMinor;
+  this.incoming.httpVersion = info.versionMajor + '.' + info.versionMinor;
 
   if (util.isNumber(info.method)) {
     // for server
@@ -88,20 +125,60 @@ function parserOnHeadersComplete(info) {
 
 
 // parserOnBody is called when HTTPParser parses http msg(incoming) and
-// get body part(buf from start at length of len)
-function parserOnBody(buf, start, len) {
+// get body part, a view of the data being parsed.
+function parserOnBody(body) {
   var stream = this.incoming;
 
   if (!stream) {
     return;
   }
 
+  if (stream._bodyLength >= 0) {
+    collectBody(stream, body);
+    return;
+  }
+
   // Push body part into incoming stream, which will emit 'data' event
-  var body = buf.slice(start, start+len);
   stream.push(body);
 }
 
 
+// Collects the body of a message whose handling waits for all of it, of the
+// length announced by Content-Length. A body that came in one piece is kept
+// as it is; otherwise the pieces are copied once, into a buffer of that
+// length.
+function collectBody(stream, body) {
+  var offset = stream._bodyOffset;
+
+  if (offset == 0 && body.length == stream._bodyLength) {
+    stream.body = body;
+  } else {
+    if (offset == 0) {
+      stream.body = new Buffer(stream._bodyLength);
+    }
+    body.copy(stream.body, offset);
+  }
+  stream._bodyOffset = offset + body.length;
+}
+
+
+// The whole body is there: the message is handled, and the body goes down
+// the stream as one chunk.
+function onBodyCollected(stream) {
+  var body = stream.body || new Buffer(0);
+  stream.body = body;
+  stream._bodyLength = -1;
+
+  var onCollected = stream._onBodyCollected;
+  stream._onBodyCollected = null;
+  onCollected(stream);
+
+  if (body.length > 0) {
+    stream.push(body);
+  }
+}
+
+
 // This is called when http header is fragmented and
 // HTTPParser sends it to JS in separate pieces.
 function parserOnHeaders(headers, url) {
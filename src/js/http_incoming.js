@@ -27,6 +27,13 @@ function IncomingMessage(socket) {
 
   this.headers = {};
 
+  this.httpVersion = null;
+  this.httpVersionMajor = null;
+  this.httpVersionMinor = null;
+
+  // The length of the body by Content-Length, -1 without one.
+  this._contentLength = -1;
+
   this.complete = false;
 
   // for request (server)
@@ -37,6 +44,12 @@ function IncomingMessage(socket) {
   this.statusCode = null;
   this.statusMessage = null;
 
+  // The whole body, for a request the server handles once it has arrived.
+  // While it is collected, `_bodyLength` is its length, otherwise -1.
+  this.body = null;
+  this._bodyLength = -1;
+  this._bodyOffset = 0;
+  this._onBodyCollected = null;
 }
 
 util.inherits(IncomingMessage, stream.Readable);
@@ -16,6 +16,14 @@
 
 var util = require('util');
 var stream = require('stream');
+var httpparser = process.binding(process.binding.httpparser);
+var serializeHeaders = httpparser.serializeHeaders;
+var frameChunk = httpparser.frameChunk;
+
+
+// The end of a chunk, and the last chunk of a chunked body.
+var chunkEnd = new Buffer('\r\n');
+var lastChunk = new Buffer('0\r\n\r\n');
 
 
 function OutgoingMessage() {
@@ -30,10 +38,16 @@ function OutgoingMessage() {
 
   this.socket = null;
   this.connection = null;
-  // response header string : same 'content' as this._headers
+  // chunks written before a connection is assigned : [chunk, encoding, cb]
+  this.output = [];
+  // response header Buffer : same 'content' as this._headers
   this._header = null;
   // response header obj : (key, value) pairs
   this._headers = {};
+  // header fields serialized before, sent after the ones of _headers
+  this._headerBlock = null;
+  // whether the body is sent in the chunked transfer coding
+  this._chunked = false;
 
 }
 
@@ -62,6 +76,12 @@ OutgoingMessage.prototype.end = function(data, encoding, callback) {
     this._implicitHeader();
   }
 
+  // The last chunks go down to the socket in a single write.
+  var connection = this.connection;
+  if (connection) {
+    connection.cork();
+  }
+
   if (data) {
     this.write(data, encoding);
   }
@@ -78,10 +98,13 @@ OutgoingMessage.prototype.end = function(data, encoding, callback) {
   // the connection. On the other hand emitting 'finish' event from http does
   // not neccessarily imply end of data transmission since there might be
   // another segment of data when connection is 'Keep-Alive'.
-  this._send('', function() {
+  this._send(this._chunked ? lastChunk : '', function() {
     self.emit('finish');
   });
 
+  if (connection) {
+    connection.uncork();
+  }
 
   this.finished = true;
 
@@ -96,23 +119,74 @@ OutgoingMessage.prototype._finish = function() {
 };
 
 
-// This sends chunk directly into socket
-// TODO: buffering of chunk in the case of socket is not available
+// This sends chunk directly into socket, or keeps it in `output` until a
+// socket is assigned.
 OutgoingMessage.prototype._send = function(chunk, encoding, callback) {
   if (util.isFunction(encoding)) {
     callback = encoding;
+    encoding = undefined;
+  }
+
+  if (!this.connection) {
+    this.output.push([chunk, encoding, callback]);
+    return false;
   }
 
-  if (util.isBuffer(chunk)) {
-    chunk = chunk.toString();
+  if (util.isString(chunk) && encoding && encoding !== 'utf8') {
+    chunk = new Buffer(chunk, encoding);
   }
 
+  var connection = this.connection;
+  if (this._sentHeader && !this._chunked) {
+    return connection.write(chunk, callback);
+  }
+
+  // The header, the size line and the chunk go down to the socket in a
+  // single write, without copying them into one.
+  connection.cork();
   if (!this._sentHeader) {
-    chunk = this._header + "\r\n" + chunk;
     this._sentHeader = true;
+    connection.write(this._header);
   }
+  var ret = this._chunked ? writeChunk(connection, chunk, callback) :
+                            connection.write(chunk, callback);
+  connection.uncork();
 
-  return this.connection.write(chunk, encoding, callback);
+  return ret;
+};
+
+
+// Writes `chunk` in the chunked transfer coding. A string is framed as it
+// is encoded natively; a Buffer goes out between its size line and the end
+// of the chunk.
+function writeChunk(connection, chunk, callback) {
+  if (chunk === lastChunk || chunk.length == 0) {
+    // An empty chunk would end the body.
+    return connection.write(chunk, callback);
+  }
+
+  if (util.isString(chunk)) {
+    return connection.write(frameChunk(chunk), callback);
+  }
+
+  connection.write(frameChunk(chunk.length));
+  connection.write(chunk);
+  return connection.write(chunkEnd, callback);
+}
+
+
+// Sends the chunks kept while there was no socket.
+OutgoingMessage.prototype._flushOutput = function() {
+  var output = this.output;
+  var connection = this.connection;
+
+  this.output = [];
+
+  connection.cork();
+  for (var i = 0; i < output.length; ++i) {
+    this._send(output[i][0], output[i][1], output[i][2]);
+  }
+  connection.uncork();
 };
 
 
@@ -132,21 +206,44 @@ OutgoingMessage.prototype.write = function(chunk, encoding, callback) {
 };
 
 
-// Stringfy header fields of _headers into _header
-OutgoingMessage.prototype._storeHeader = function(statusLine) {
-  var headerStr = '';
+// Names and values of the header fields in a row, as serializeHeaders()
+// takes them.
+function headerFields(headers) {
+  var fields = [];
+  if (headers) {
+    var keys = Object.keys(headers);
+    for (var i = 0; i < keys.length; i++) {
+      fields.push(keys[i], String(headers[keys[i]]));
+    }
+  }
+  return fields;
+}
+
 
-  var keys;
-  if (this._headers) {
-    keys = Object.keys(this._headers);
-    for (var i=0; i<keys.length; i++) {
-      var key = keys[i];
-      headerStr += key + ": " + this._headers[key] + '\r\n';
+// Header fields serialized once, for the messages that all have them. It is
+// passed to writeHead() in place of the header object.
+function HeaderBlock(headers) {
+  var block = serializeHeaders('', headerFields(headers));
+
+  // The empty line ending the header is added to every message.
+  this._block = block.slice(0, block.length - 2);
+  this.headers = {};
+  for (var key in headers) {
+    if (headers.hasOwnProperty(key)) {
+      this.headers[key] = headers[key];
     }
   }
+}
+
+exports.HeaderBlock = HeaderBlock;
 
-  this._header = statusLine + headerStr;
 
+// Serializes the first line and the header fields of _headers and
+// _headerBlock into _header, natively.
+OutgoingMessage.prototype._storeHeader = function(firstLine) {
+  var block = this._headerBlock ? this._headerBlock._block : undefined;
+  this._header = serializeHeaders(firstLine, headerFields(this._headers),
+                                  block);
 };
 
 
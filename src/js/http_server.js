@@ -15,8 +15,12 @@
 
 var util = require('util');
 var net = require('net');
-var OutgoingMessage = require('http_outgoing').OutgoingMessage;
+var fs = require('fs');
+var outgoing = require('http_outgoing');
+var OutgoingMessage = outgoing.OutgoingMessage;
+var HeaderBlock = outgoing.HeaderBlock;
 var common = require('http_common');
+var httpparser = process.binding(process.binding.httpparser);
 
 // RFC 7231 (http://tools.ietf.org/html/rfc7231#page-49)
 var STATUS_CODES = exports.STATUS_CODES = {
@@ -67,6 +71,7 @@ var STATUS_CODES = exports.STATUS_CODES = {
 // response to req
 function ServerResponse(req) {
   OutgoingMessage.call(this);
+  this._req = req;
   // response to HEAD method has no body
   if (req.method === 'HEAD') this._hasBody = false;
 }
@@ -95,9 +100,7 @@ ServerResponse.prototype.writeHead = function(statusCode, reason, obj) {
     obj = reason;
   }
 
-  var statusLine = util.format('HTTP/1.1 %s %s\r\n',
-                               statusCode.toString(),
-                               this.statusMessage);
+  var statusLine = getStatusLine(statusCode, this.statusMessage);
 
   this.statusCode = statusCode;
 
@@ -107,10 +110,13 @@ ServerResponse.prototype.writeHead = function(statusCode, reason, obj) {
     this._hasBody = false;
   }
 
-  if (util.isObject(obj)) {
-    if (util.isNullOrUndefined(this._headers)) {
-      this._headers = {};
-    }
+  if (util.isNullOrUndefined(this._headers)) {
+    this._headers = {};
+  }
+
+  if (obj instanceof HeaderBlock) {
+    this._headerBlock = obj;
+  } else if (util.isObject(obj)) {
     for (var key in obj) {
       if (obj.hasOwnProperty(key)) {
         this._headers[key] = obj[key];
@@ -118,10 +124,327 @@ ServerResponse.prototype.writeHead = function(statusCode, reason, obj) {
     }
   }
 
+  // A body of unknown length goes in chunks to an HTTP/1.1 client, which
+  // finds the end of it without the connection being closed.
+  var hasLength = this._findHeader('content-length') !== undefined;
+  if (this._hasBody && !hasLength) {
+    var transferEncoding = this._findHeader('transfer-encoding');
+    if (transferEncoding !== undefined) {
+      this._chunked = String(transferEncoding).toLowerCase() === 'chunked';
+    } else if (this.shouldKeepAlive && acceptsChunked(this._req)) {
+      this._headers['Transfer-Encoding'] = 'chunked';
+      this._chunked = true;
+    }
+  }
+
+  // The connection is kept for the next request if the client wants so, and
+  // the client can find the end of this response without the connection
+  // being closed.
+  this._last = !this.shouldKeepAlive ||
+               (this._hasBody && !hasLength && !this._chunked);
+
+  var connection = this._findHeader('connection');
+  if (connection) {
+    if (String(connection).toLowerCase() === 'close') {
+      this._last = true;
+    }
+  } else if (this._last) {
+    this._headers['Connection'] = 'close';
+  }
+
   this._storeHeader(statusLine);
 };
 
 
+function acceptsChunked(req) {
+  return req.httpVersionMajor > 1 ||
+         (req.httpVersionMajor == 1 && req.httpVersionMinor >= 1);
+}
+
+
+// The status lines with the reason phrase of the status code, made once.
+var statusLines = {};
+
+function getStatusLine(statusCode, statusMessage) {
+  if (statusMessage !== STATUS_CODES[statusCode]) {
+    return 'HTTP/1.1 ' + statusCode + ' ' + statusMessage + '\r\n';
+  }
+  var line = statusLines[statusCode];
+  if (!line) {
+    line = 'HTTP/1.1 ' + statusCode + ' ' + statusMessage + '\r\n';
+    statusLines[statusCode] = line;
+  }
+  return line;
+}
+
+
+ServerResponse.prototype._findHeader = function(name) {
+  var value = findHeader(this._headers, name);
+  if (value === undefined && this._headerBlock) {
+    value = findHeader(this._headerBlock.headers, name);
+  }
+  return value;
+};
+
+
+// Returns the value of a header field, whose name is matched regardless of
+// the case.
+function findHeader(headers, name) {
+  var keys = Object.keys(headers);
+  for (var i = 0; i < keys.length; i++) {
+    if (keys[i].toLowerCase() === name) {
+      return headers[keys[i]];
+    }
+  }
+  return undefined;
+}
+
+exports.findHeader = findHeader;
+
+
+// The content types of the files sent by sendFile(), by their extensions.
+var fileContentTypes = {
+  css: 'text/css',
+  gif: 'image/gif',
+  htm: 'text/html',
+  html: 'text/html',
+  ico: 'image/x-icon',
+  jpeg: 'image/jpeg',
+  jpg: 'image/jpeg',
+  js: 'application/javascript',
+  json: 'application/json',
+  png: 'image/png',
+  svg: 'image/svg+xml',
+  txt: 'text/plain',
+  xml: 'application/xml'
+};
+
+
+// The stats of the files sent lately, so that a file asked for again and
+// again is not stated for every request.
+var fileStatTimeout = 1000;
+var fileStatCacheSize = 32;
+var fileStats = {};
+var fileStatCount = 0;
+
+function statFile(path, callback) {
+  var entry = fileStats[path];
+  if (entry && entry.expires > Date.now()) {
+    callback(null, entry.stats);
+    return;
+  }
+
+  fs.stat(path, function(err, stats) {
+    if (!err) {
+      if (!fileStats[path] && ++fileStatCount > fileStatCacheSize) {
+        fileStats = {};
+        fileStatCount = 1;
+      }
+      fileStats[path] = {stats: stats, expires: Date.now() + fileStatTimeout};
+    }
+    callback(err, stats);
+  });
+}
+
+
+var monthNames = ['Jan', 'Feb', 'Mar', 'Apr', 'May', 'Jun',
+                  'Jul', 'Aug', 'Sep', 'Oct', 'Nov', 'Dec'];
+
+// Parses an HTTP-date of RFC 7231, as `Sun, 06 Nov 1994 08:49:37 GMT`, into
+// milliseconds. Returns NaN for any other form.
+function parseHttpDate(value) {
+  var parts = String(value).split(' ');
+  if (parts.length != 6 || parts[5] !== 'GMT') {
+    return NaN;
+  }
+  var time = parts[4].split(':');
+  return Date.UTC(+parts[3], monthNames.indexOf(parts[2]), +parts[1],
+                  +time[0], +time[1], +time[2]);
+}
+
+
+// Returns the first and the last byte of a `Range: bytes=` header of a
+// single range, null for a range out of the file, or undefined if the whole
+// file is to be sent.
+function parseRange(value, size) {
+  value = String(value);
+  if (value.indexOf('bytes=') != 0 || value.indexOf(',') >= 0) {
+    return undefined;
+  }
+
+  var range = value.slice(6).split('-');
+  if (range.length != 2) {
+    return undefined;
+  }
+
+  var start;
+  var end;
+  if (range[0] === '') {
+    // The last bytes of the file.
+    var suffix = parseInt(range[1], 10);
+    if (isNaN(suffix)) {
+      return undefined;
+    }
+    start = Math.max(size - suffix, 0);
+    end = size - 1;
+  } else {
+    start = parseInt(range[0], 10);
+    end = range[1] === '' ? Infinity : parseInt(range[1], 10);
+    if (isNaN(start) || isNaN(end) || end < start) {
+      return undefined;
+    }
+    end = Math.min(end, size - 1);
+  }
+
+  if (start >= size || end < start) {
+    return null;
+  }
+  return {start: start, end: end};
+}
+
+
+// Whether the client has the file of `etag` and `lastModified` already.
+function isNotModified(req, etag, mtime) {
+  var ifNoneMatch = findHeader(req.headers, 'if-none-match');
+  if (ifNoneMatch !== undefined) {
+    var tags = String(ifNoneMatch).split(',');
+    for (var i = 0; i < tags.length; i++) {
+      var tag = tags[i].trim();
+      if (tag === '*' || tag === etag || tag === 'W/' + etag) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  var ifModifiedSince = findHeader(req.headers, 'if-modified-since');
+  if (ifModifiedSince !== undefined) {
+    // HTTP-dates count whole seconds.
+    var since = parseHttpDate(ifModifiedSince);
+    return !isNaN(since) && Math.floor(mtime / 1000) * 1000 <= since;
+  }
+
+  return false;
+}
+
+
+// res.sendFile(path[, callback])
+// Responds with the file of `path`. The response has an ETag and a
+// Last-Modified from the stat of the file, and is 304 Not Modified for a
+// client that has the file already. A request of a single range of bytes is
+// answered with that range. The body goes from the file to the socket by
+// sendfile(2).
+ServerResponse.prototype.sendFile = function(path, callback) {
+  var self = this;
+  var req = self._req;
+
+  var done = function(err) {
+    if (util.isFunction(callback)) {
+      callback.call(self, err);
+    } else if (err && !self._header) {
+      self.writeHead(404);
+      self.end();
+    }
+  };
+
+  statFile(path, function(err, stats) {
+    if (!err && !stats.isFile()) {
+      err = new Error('not a file: ' + path);
+    }
+    if (err) {
+      done(err);
+      return;
+    }
+
+    var size = stats.size;
+    var mtime = stats.mtimeMs;
+    var etag = '"' + size.toString(16) + '-' +
+               Math.floor(mtime).toString(16) + '"';
+    var headers = {
+      'ETag': etag,
+      'Last-Modified': new Date(mtime).toUTCString(),
+      'Accept-Ranges': 'bytes'
+    };
+
+    if (isNotModified(req, etag, mtime)) {
+      self.writeHead(304, headers);
+      self.end();
+      done(null);
+      return;
+    }
+
+    var status = 200;
+    var start = 0;
+    var length = size;
+
+    var rangeHeader = findHeader(req.headers, 'range');
+    var range = rangeHeader === undefined ? undefined :
+                parseRange(rangeHeader, size);
+    if (range === null) {
+      headers['Content-Range'] = 'bytes */' + size;
+      headers['Content-Length'] = 0;
+      self.writeHead(416, headers);
+      self.end();
+      done(null);
+      return;
+    } else if (range) {
+      status = 206;
+      start = range.start;
+      length = range.end - range.start + 1;
+      headers['Content-Range'] = 'bytes ' + range.start + '-' + range.end +
+                                 '/' + size;
+    }
+
+    headers['Content-Length'] = length;
+    if (self._findHeader('content-type') === undefined) {
+      var extension = path.slice(path.lastIndexOf('.') + 1).toLowerCase();
+      headers['Content-Type'] = fileContentTypes[extension] ||
+                                'application/octet-stream';
+    }
+
+    if (!self._hasBody || length == 0) {
+      self.writeHead(status, headers);
+      self.end();
+      done(null);
+      return;
+    }
+
+    fs.open(path, 'r', function(err, fd) {
+      if (err) {
+        done(err);
+        return;
+      }
+
+      self.writeHead(status, headers);
+      sendFileBody(self, fd, start, length, done);
+    });
+  });
+};
+
+
+// Sends the header, then the file down the socket, and ends the response.
+// The writes after the file wait in the socket until it is sent.
+function sendFileBody(res, fd, start, length, callback) {
+  var send = function() {
+    res._send('');
+    res.connection.sendFile(fd, start, length, function(err) {
+      fs.close(fd, function() {});
+      callback(err);
+    });
+    res.end();
+  };
+
+  if (res.connection) {
+    send();
+  } else {
+    // A pipelined response, sent once the responses before it are.
+    res.once('socket', function() {
+      process.nextTick(send);
+    });
+  }
+}
+
+
 ServerResponse.prototype.assignSocket = function(socket) {
   socket._httpMessage = this;
   this.socket = socket;
@@ -150,23 +473,46 @@ function Server(requestListener) {
   }
 
   net.Server.call(this, {allowHalfOpen: true});
+  initServer(this, requestListener);
 
+  this.on('connection', connectionListener);
+}
+
+util.inherits(Server, net.Server);
+exports.Server = Server;
+
+
+// Sets up the http side of a server. The https server, a tls.Server, shares
+// it, and gives its connections to `connectionListener` once they are secure.
+function initServer(server, requestListener) {
   if (util.isFunction(requestListener)) {
-    this.addListener('request', requestListener);
+    server.addListener('request', requestListener);
   }
 
-  this.httpAllowHalfOpen = false;
+  server.httpAllowHalfOpen = false;
 
-  this.on('connection', connectionListener);
-  this.on('clientError', function(err, conn) {
+  server.on('clientError', function(err, conn) {
     conn.destroy(err);
   });
 
-  this.timeout = 2 * 1000 * 60; // default timeout is 2 min
+  server.timeout = 2 * 1000 * 60; // default timeout is 2 min
+
+  // Reading of a connection pauses when this many pipelined requests wait
+  // for the responses before them.
+  server.maxPendingResponses = 16;
+
+  // Requests with a Content-Length up to this many bytes are handled once
+  // their body has arrived, with the body in `req.body`.
+  server.collectBodyLimit = 0;
+
+  // The responses of setStaticResponse(), by method and path, and their
+  // native table in the first element, which the parsers of the
+  // connections share.
+  server._staticResponses = {};
+  server._staticRoutes = [];
 }
 
-util.inherits(Server, net.Server);
-exports.Server = Server;
+exports.initServer = initServer;
 
 
 // TODO: Implement Server.prototype.setTimeout function
@@ -179,11 +525,75 @@ Server.prototype.setTimeout = function (ms, cb) {
 };
 
 
+// The numbers of the methods that HTTPParser knows, by their names.
+var methodNumbers = {};
+for (var method in httpparser.HTTPParser.methods) {
+  methodNumbers[httpparser.HTTPParser.methods[method]] = +method;
+}
+
+
+// server.setStaticResponse(method, path, response)
+// Answers the requests of `method` for `path`, without its query, with a
+// response made once, {statusCode, headers, body}. The parser writes it to
+// the socket natively, with no 'request' event. A null response removes the
+// route.
+Server.prototype.setStaticResponse = function(method, path, response) {
+  var number = methodNumbers[method];
+  if (number === undefined || !util.isString(path)) {
+    throw new TypeError('Bad arguments: setStaticResponse(method, path, ' +
+                        'response)');
+  }
+
+  var key = method + ' ' + path;
+  if (util.isNullOrUndefined(response)) {
+    delete this._staticResponses[key];
+  } else {
+    this._staticResponses[key] = [number, path,
+                                  makeStaticResponse(method, response)];
+  }
+
+  var routes = [];
+  for (key in this._staticResponses) {
+    routes.push.apply(routes, this._staticResponses[key]);
+  }
+  this._staticRoutes[0] = routes.length > 0 ?
+                          httpparser.compileRoutes(routes) : undefined;
+};
+
+
+function makeStaticResponse(method, response) {
+  var statusCode = response.statusCode || 200;
+  var body = response.body;
+  if (util.isNullOrUndefined(body)) {
+    body = new Buffer(0);
+  } else if (!util.isBuffer(body)) {
+    body = new Buffer(String(body));
+  }
+
+  var fields = [];
+  var headers = response.headers;
+  if (headers) {
+    var keys = Object.keys(headers);
+    for (var i = 0; i < keys.length; i++) {
+      if (keys[i].toLowerCase() !== 'content-length') {
+        fields.push(keys[i], String(headers[keys[i]]));
+      }
+    }
+  }
+  fields.push('Content-Length', String(body.length));
+
+  var header = httpparser.serializeHeaders(
+      getStatusLine(statusCode, STATUS_CODES[statusCode] || 'unknown'),
+      fields);
+  // The response to HEAD has no body.
+  return method === 'HEAD' ? header : Buffer.concat([header, body]);
+}
+
+
 function connectionListener(socket) {
   var server = this;
 
-  // cf) In Node.js, freelist returns a new parser.
-  // parser initialize
+  // parser initialize, the parser may be one of a closed connection.
   var parser = common.createHTTPParser();
   parser._headers = [];
   parser._url = '';
@@ -194,6 +604,21 @@ function connectionListener(socket) {
   parser.incoming = null;
   socket.parser = parser;
 
+  // The table is not shared with TLS, whose handle writes plain text.
+  if (server._staticRoutes && server._staticRoutes[0] && !socket.encrypted) {
+    parser.setStaticRoutes(server._staticRoutes);
+  }
+
+  // Responses of pipelined requests, waiting for the response of the socket
+  // (socket._httpMessage) to finish.
+  socket._httpPendingResponses = [];
+  // While paused, the received data is kept here instead of being parsed.
+  socket._httpPaused = false;
+  socket._httpUnparsed = [];
+  // The client ended its side while paused, or with responses still to send.
+  socket._httpEndPending = false;
+  socket._httpEnded = false;
+
   socket.on("data", socketOnData);
   socket.on("end", socketOnEnd);
   socket.on("close", socketOnClose);
@@ -205,15 +630,102 @@ function connectionListener(socket) {
   }
 }
 
+exports.connectionListener = connectionListener;
+
 
 function socketOnData(data) {
   var socket = this;
 
+  if (socket._httpPaused) {
+    socket._httpUnparsed.push(data);
+    return;
+  }
+
+  executeParser(socket, data);
+}
+
+
+function executeParser(socket, data) {
   // Begin parsing
   var ret = socket.parser.execute(data);
 
   if (ret instanceof Error) {
     socket.destroy();
+  } else if (socket._httpUpgrade) {
+    upgradeSocket(socket, data.slice(ret));
+  } else if (socket._httpPaused && ret < data.length) {
+    // Parsing stopped at a request which has to wait for its response.
+    socket._httpUnparsed.push(data.slice(ret));
+  }
+}
+
+
+// Hands the socket of an upgrade request over to the 'upgrade' listeners,
+// with the data received after the request in `head`. HTTP is done with it.
+function upgradeSocket(socket, head) {
+  var server = socket._server;
+  var req = socket._httpUpgrade;
+
+  socket._httpUpgrade = null;
+  socket.removeListener('data', socketOnData);
+  socket.removeListener('end', socketOnEnd);
+  socket.removeListener('close', socketOnClose);
+  socket.removeListener('timeout', socketOnTimeout);
+  socket.removeListener('error', socketOnError);
+  socket.setTimeout(0);
+
+  common.freeHTTPParser(socket.parser);
+  socket.parser = null;
+  socket._httpPendingResponses = [];
+  socket._httpUnparsed = [];
+
+  server.emit('upgrade', req, socket, head);
+}
+
+
+// Stops parsing and reading requests of the socket, until the pending
+// responses are sent.
+function pauseSocket(socket) {
+  if (socket._httpPaused) {
+    return;
+  }
+
+  socket._httpPaused = true;
+  socket.parser.pause();
+  if (socket._handle) {
+    socket._handle.readStop();
+  }
+}
+
+
+function resumeSocket(socket) {
+  if (!socket._httpPaused || !socket.parser) {
+    return;
+  }
+
+  var unparsed = socket._httpUnparsed;
+
+  socket._httpPaused = false;
+  socket._httpUnparsed = [];
+  socket.parser.resume();
+
+  for (var i = 0; i < unparsed.length; i++) {
+    if (socket._httpPaused) {
+      socket._httpUnparsed.push(unparsed[i]);
+    } else {
+      executeParser(socket, unparsed[i]);
+    }
+  }
+
+  if (socket._httpPaused || !socket.parser) {
+    return;
+  }
+
+  if (socket._httpEndPending) {
+    socket._httpEndPending = false;
+    socketOnEnd.call(socket);
+  } else if (socket._handle) {
+    socket._handle.readStart();
   }
 }
 
@@ -221,6 +733,13 @@ function socketOnData(data) {
 function socketOnEnd() {
   var socket = this;
   var server = socket._server;
+
+  if (socket._httpPaused) {
+    // The kept requests are parsed first.
+    socket._httpEndPending = true;
+    return;
+  }
+
   var ret = socket.parser.finish();
 
   if (ret instanceof Error) {
@@ -228,10 +747,18 @@ function socketOnEnd() {
     return;
   }
 
+  common.freeHTTPParser(socket.parser);
   socket.parser = null;
 
-  if (!server.httpAllowHalfOpen && socket._socketState.writable) {
-    socket.end();
+  if (!server.httpAllowHalfOpen) {
+    // The peer may be gone, so the responses not sent yet are dropped.
+    socket._httpPendingResponses = [];
+    if (socket._socketState.writable) {
+      socket.end();
+    }
+  } else if (socket._httpMessage) {
+    // The responses of the received requests are sent before closing.
+    socket._httpEnded = true;
   }
 }
 
@@ -240,8 +767,12 @@ function socketOnClose() {
   var socket = this;
 
   if (socket.parser) {
+    common.freeHTTPParser(socket.parser);
     socket.parser = null;
   }
+
+  socket._httpPendingResponses = [];
+  socket._httpUnparsed = [];
 }
 
 
@@ -272,16 +803,42 @@ function socketOnError(err) {
 
 
 // This is called by parserOnHeadersComplete after req header is parsed.
-// TODO: keepalive support
 function parserOnIncoming(req, shouldKeepAlive) {
   var socket = req.socket;
   var server = socket._server;
 
+  // An upgrade request is taken over by the 'upgrade' listeners once the
+  // parser returns, or answered as any other request without them.
+  if (req.upgrade && server._events && server._events.upgrade) {
+    socket._httpUpgrade = req;
+    return true;
+  }
+
   var res = new ServerResponse(req);
-  res.assignSocket(socket);
+  res.shouldKeepAlive = shouldKeepAlive;
   res.on('prefinish', resOnFinish);
 
-  server.emit('request', req, res);
+  // Responses go out in the order of the requests. The response of a
+  // pipelined request keeps what is written to it until it gets the socket.
+  if (socket._httpMessage) {
+    var pending = socket._httpPendingResponses;
+    pending.push(res);
+    if (pending.length >= server.maxPendingResponses) {
+      pauseSocket(socket);
+    }
+  } else {
+    res.assignSocket(socket);
+  }
+
+  var length = req._contentLength;
+  if (length > 0 && length <= server.collectBodyLimit) {
+    req._bodyLength = length;
+    req._onBodyCollected = function() {
+      server.emit('request', req, res);
+    };
+  } else {
+    server.emit('request', req, res);
+  }
 
   // In server, HTTPParser determines whether body should be parsed or not.
   // It is fine to return false
@@ -295,8 +852,41 @@ function resOnFinish() {
   var res = this;
   var socket = res.socket;
 
+  if (!socket) {
+    // A pending response, handled when it gets the socket.
+    return;
+  }
+
   res.detachSocket();
 
-  // cf) In Node, ConnectionListener has a list of incoming msgs.
-  socket.destroySoon();
+  var pending = socket._httpPendingResponses;
+
+  if (res._last) {
+    socket._httpPendingResponses = [];
+    socket.destroySoon();
+    return;
+  }
+
+  var next = pending.shift();
+  if (next) {
+    next.assignSocket(socket);
+    if (next.output.length > 0) {
+      next._flushOutput();
+    }
+    if (next.finished) {
+      resOnFinish.call(next);
+      return;
+    }
+  } else if (socket._httpEnded) {
+    socket.destroySoon();
+    return;
+  }
+
+  var server = socket._server;
+  if (socket._httpPaused && pending.length < server.maxPendingResponses) {
+    // Resumes out of the parser callback which may have ended this response.
+    process.nextTick(function() {
+      resumeSocket(socket);
+    });
+  }
 }
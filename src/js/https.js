@@ -13,18 +13,24 @@
  * limitations under the License.
  */
 
-var client = require('https_client');
+// https runs on tls. Where tls is not built, the requests are made by libcurl
+// instead, and https.Agent and https.createServer are not available.
+if (process.native_sources.tls) {
+  module.exports = require('https_tls');
+} else {
+  var client = require('https_client');
 
-var ClientRequest = exports.ClientRequest = client.ClientRequest;
+  var ClientRequest = exports.ClientRequest = client.ClientRequest;
 
-exports.request = function(options, cb) {
-  return new ClientRequest(options, cb);
-};
+  exports.request = function(options, cb) {
+    return new ClientRequest(options, cb);
+  };
 
-exports.METHODS = client.METHODS;
+  exports.METHODS = client.METHODS;
 
-exports.get = function(options, cb) {
-  var req = exports.request(options, cb);
-  req.end();
-  return req;
-};
+  exports.get = function(options, cb) {
+    var req = exports.request(options, cb);
+    req.end();
+    return req;
+  };
+}
@@ -90,10 +90,22 @@ function ClientRequest(options, cb) {
 util.inherits(ClientRequest, stream.Writable);
 
 // Concrete stream overriding the empty underlying _write method.
+// The chunk is copied to the upload buffer of the request, which curl drains.
+// If it does not fit, `onwrite` is called once curl has made room for the
+// rest, keeping the writer back meanwhile.
 ClientRequest.prototype._write = function(chunk, callback, onwrite) {
-  httpsNative._write(this, chunk.toString(), callback, onwrite);
+  if (httpsNative._write(this, chunk, callback, onwrite)) {
+    process.nextTick(afterWrite, this, callback, onwrite);
+  }
 };
 
+function afterWrite(req, callback, onwrite) {
+  if (util.isFunction(callback)) {
+    callback.call(req);
+  }
+  onwrite();
+}
+
 ClientRequest.prototype.headersComplete = function() {
   var self = this;
   self.emit('response', self._incoming);
@@ -120,8 +120,8 @@ function parserOnHeadersComplete(info) {
 }
 
 // parserOnBody is called when HTTPParser parses http msg(incoming) and
-// get body part(buf from start at length of len)
-function parserOnBody(buf, start, len) {
+// get body part, a view of the data being parsed.
+function parserOnBody(body) {
   var parser = this;
   var incoming = parser.incoming;
 
@@ -130,7 +130,6 @@ function parserOnBody(buf, start, len) {
   }
 
   // Push body part into incoming stream, which will emit 'data' event
-  var body = buf.slice(start, start + len);
   incoming.push(body);
 }
 
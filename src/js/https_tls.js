@@ -0,0 +1,150 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var util = require('util');
+var tls = require('tls');
+var httpServer = require('http_server');
+var client = require('http_client');
+var HttpAgent = require('http_agent').Agent;
+var HTTPParser = process.binding(process.binding.httpparser).HTTPParser;
+
+
+var ClientRequest = exports.ClientRequest = client.ClientRequest;
+
+
+// An agent of https connections. The secure contexts are made once for the
+// connections with the same certificates, and the session of the last
+// connection to a server is resumed by the next one, which saves most of the
+// handshake.
+function Agent(options) {
+  if (!(this instanceof Agent)) {
+    return new Agent(options);
+  }
+
+  HttpAgent.call(this, options);
+
+  this._contexts = {};
+  this._sessions = {};
+}
+
+util.inherits(Agent, HttpAgent);
+
+Agent.prototype.defaultPort = 443;
+
+
+Agent.prototype.getName = function(options) {
+  var name = HttpAgent.prototype.getName.call(this, options);
+  name += ':' + (options.servername || '');
+  name += ':' + (options.rejectUnauthorized === false ? 0 : 1);
+  if (options.ca || options.cert || options.key) {
+    name += ':' + String(options.ca) + ':' + String(options.cert) + ':' +
+            String(options.key);
+  }
+  return name;
+};
+
+
+Agent.prototype.createConnection = function(options) {
+  var self = this;
+  var name = self.getName(options);
+
+  var context = self._contexts[name];
+  if (!context && (options.ca || options.cert || options.key)) {
+    context = self._contexts[name] = tls.createSecureContext(options, false);
+  }
+
+  var socket = tls.connect({
+    host: options.host,
+    port: options.port,
+    servername: options.servername,
+    secureContext: context,
+    session: self._sessions[name],
+    rejectUnauthorized: options.rejectUnauthorized
+  });
+
+  socket.on('session', function(session) {
+    self._sessions[name] = session;
+  });
+
+  return socket;
+};
+
+
+exports.Agent = Agent;
+exports.globalAgent = new Agent();
+
+
+exports.request = function(options, cb) {
+  var requestOptions = {};
+  var keys = Object.keys(options);
+  for (var i = 0; i < keys.length; ++i) {
+    requestOptions[keys[i]] = options[keys[i]];
+  }
+
+  // `agent: false` makes a socket for this request only.
+  if (requestOptions.agent === undefined) {
+    requestOptions.agent = exports.globalAgent;
+  } else if (requestOptions.agent === false) {
+    requestOptions.agent = new Agent();
+  }
+
+  return new ClientRequest(requestOptions, cb);
+};
+
+
+exports.METHODS = HTTPParser.methods;
+
+
+exports.get = function(options, cb) {
+  var req = exports.request(options, cb);
+  req.end();
+  return req;
+};
+
+
+// An http server on TLS connections.
+function Server(options, requestListener) {
+  if (!(this instanceof Server)) {
+    return new Server(options, requestListener);
+  }
+
+  if (util.isFunction(options)) {
+    requestListener = options;
+    options = {};
+  }
+
+  var tlsOptions = {};
+  var keys = Object.keys(options || {});
+  for (var i = 0; i < keys.length; ++i) {
+    tlsOptions[keys[i]] = options[keys[i]];
+  }
+  tlsOptions.allowHalfOpen = true;
+
+  tls.Server.call(this, tlsOptions);
+  httpServer.initServer(this, requestListener);
+
+  this.on('secureConnection', httpServer.connectionListener);
+}
+
+util.inherits(Server, tls.Server);
+
+Server.prototype.setTimeout = httpServer.Server.prototype.setTimeout;
+
+exports.Server = Server;
+
+
+exports.createServer = function(options, requestListener) {
+  return new Server(options, requestListener);
+};
@@ -43,9 +43,15 @@
  * Some functions are translated from coffee script(i2c.coffee) in 'node-i2c'.
  */
 
+var AdaptiveCaller = require('peripheral_util').AdaptiveCaller;
 var util = require('util');
 var i2c = process.binding(process.binding.i2c);
 
+
+// The most messages of one transfer, and the most bytes of one message.
+var MESSAGES_MAX = 42;
+var MESSAGE_LENGTH_MAX = 65535;
+
 function I2C() {
   if (!(this instanceof I2C)) {
     return new I2C();
@@ -59,6 +65,7 @@ I2C.prototype.open = function(configurable, callback) {
 
 function i2cBusOpen(configurable, callback) {
   var _binding = null;
+  var _caller = new AdaptiveCaller();
 
   function I2CBus(configurable, callback) {
     var i2cContext;
@@ -122,22 +129,108 @@ function i2cBusOpen(configurable, callback) {
     }
 
     this.setAddress(this.address);
-    _binding.write(array, function(err) {
-      util.isFunction(callback) && callback(err);
+    _caller.call(this, callback, function() {
+      _binding.write(array);
+    }, function(done) {
+      _binding.write(array, done);
     });
   };
 
+  I2CBus.prototype.writeSync = function(array) {
+    if (!util.isArray(array)) {
+      throw new TypeError('Bad argument - array: Array');
+    }
+
+    this.setAddress(this.address);
+    _binding.write(array);
+  };
+
   I2CBus.prototype.read = function(length, callback) {
     if (!util.isNumber(length)) {
       throw new TypeError('Bad argument - length: Number');
     }
 
     this.setAddress(this.address);
-    _binding.read(length, function(err, data) {
-      util.isFunction(callback) && callback(err, data);
+    _caller.call(this, callback, function() {
+      return _binding.read(length);
+    }, function(done) {
+      _binding.read(length, done);
+    });
+  };
+
+  I2CBus.prototype.readSync = function(length) {
+    if (!util.isNumber(length)) {
+      throw new TypeError('Bad argument - length: Number');
+    }
+
+    this.setAddress(this.address);
+    return _binding.read(length);
+  };
+
+  // Flattens `msgs` into the address, direction and length of each message,
+  // and a Buffer of the bytes of all writes, as the binding takes them.
+  function packMessages(bus, msgs) {
+    if (!util.isArray(msgs) || msgs.length == 0 ||
+        msgs.length > MESSAGES_MAX) {
+      throw new TypeError('Bad argument - msgs: Array of at most ' +
+                          MESSAGES_MAX + ' messages');
+    }
+
+    var desc = [];
+    var writes = [];
+    for (var i = 0; i < msgs.length; ++i) {
+      var msg = msgs[i];
+      if (!util.isObject(msg)) {
+        throw new TypeError('Bad argument - msgs[' + i + ']: Object');
+      }
+
+      var address = msg.address === undefined ? bus.address : msg.address;
+      if (!util.isNumber(address)) {
+        throw new TypeError('Bad argument - msgs[' + i + '].address: Number');
+      }
+
+      if (msg.read !== undefined) {
+        if (!util.isNumber(msg.read) || msg.read <= 0 ||
+            msg.read > MESSAGE_LENGTH_MAX) {
+          throw new TypeError('Bad argument - msgs[' + i + '].read: Number');
+        }
+        desc.push(address, true, msg.read);
+      } else {
+        var data = msg.write;
+        if (util.isArray(data)) {
+          data = new Buffer(data);
+        } else if (!util.isBuffer(data)) {
+          throw new TypeError(
+            'Bad argument - msgs[' + i + '].write: Array or Buffer');
+        }
+        if (data.length > MESSAGE_LENGTH_MAX) {
+          throw new RangeError('Bad argument - msgs[' + i + '].write: ' +
+                               'at most ' + MESSAGE_LENGTH_MAX + ' bytes');
+        }
+        desc.push(address, false, data.length);
+        writes.push(data);
+      }
+    }
+
+    return [desc, Buffer.concat(writes)];
+  }
+
+  I2CBus.prototype.transfer = function(msgs, callback) {
+    var packed = packMessages(this, msgs);
+
+    _caller.call(this, callback, function() {
+      return _binding.transfer(packed[0], packed[1]);
+    }, function(done) {
+      _binding.transfer(packed[0], packed[1], done);
     });
   };
 
+  I2CBus.prototype.transferSync = function(msgs) {
+    var packed = packMessages(this, msgs);
+
+    return _binding.transfer(packed[0], packed[1]);
+  };
+
   return new I2CBus(configurable, callback);
 }
 
@@ -52,8 +52,30 @@ Native.prototype.compile = function() {
   fn(this.exports, Native.require, this);
 }
 
-global.console = Native.require('console');
-global.Buffer = Native.require('buffer');
+// Builtin globals are evaluated on first use, so that a program which does
+// not touch them does not pay for their modules at startup.
+function defineLazyGlobal(name, id) {
+  var define = function(value) {
+    Object.defineProperty(global, name, {
+      value: value,
+      writable: true,
+      configurable: true
+    });
+  };
+
+  Object.defineProperty(global, name, {
+    get: function() {
+      var value = Native.require(id);
+      define(value);
+      return value;
+    },
+    set: define,
+    configurable: true
+  });
+}
+
+defineLazyGlobal('console', 'console');
+defineLazyGlobal('Buffer', 'buffer');
 
 (function() {
   var timers = undefined;
@@ -62,7 +84,11 @@ global.Buffer = Native.require('buffer');
     if (timers == undefined) {
       timers = Native.require('timers');
     }
-    return timers[mode].apply(this, Array.prototype.slice.call(arguments, 1));
+    var args = [];
+    for (var i = 1; i < arguments.length; i++) {
+      args.push(arguments[i]);
+    }
+    return timers[mode].apply(this, args);
   }
 
   global.setTimeout = _timeoutHandler.bind(this, 'setTimeout');
@@ -84,47 +110,32 @@ for (var i = 0; i < keysLength; ++i) {
   }
 }
 
-var nextTickQueue = [];
-
-process.nextTick = nextTick;
 process._onNextTick = _onNextTick;
 
 
-function _onNextTick() {
-  // clone nextTickQueue to new array object, and calls function
-  // iterating the cloned array. This is because,
-  // during processing nextTick
-  // a callback could add another next tick callback using
-  // `process.nextTick()`, if we calls back iterating original
-  // `nextTickQueue` that could turn into infinite loop.
-
-  var callbacks = nextTickQueue.slice(0);
-  nextTickQueue = [];
-
-  var len = callbacks.length;
-  for (var i = 0; i < len; ++i) {
+// `process.nextTick()` queues the callbacks natively. Those queued until now
+// come here at once, as callback and arguments pairs.
+function _onNextTick(ticks) {
+  var len = ticks.length;
+  for (var i = 0; i < len; i += 2) {
     try {
-      callbacks[i]();
+      var args = ticks[i + 1];
+      if (args) {
+        ticks[i].apply(undefined, args);
+      } else {
+        ticks[i]();
+      }
     } catch (e) {
       process._onUncaughtException(e);
     }
   }
-
-  return nextTickQueue.length > 0;
-}
-
-
-function nextTick(callback) {
-  var args = Array.prototype.slice.call(arguments);
-  args[0] = null;
-  nextTickQueue.push(Function.prototype.bind.apply(callback, args));
 }
 
 
 process._onUncaughtException = _onUncaughtException;
 function _onUncaughtException(error) {
   var event = 'uncaughtException';
-  if (process._events[event] && process._events[event].length > 0) {
+  if (process._events[event]) {
     try {
       // Emit uncaughtException event.
       process.emit('uncaughtException', error);
@@ -166,5 +177,43 @@ process.exit = function(code) {
 }
 
 
+// Headroom of a GC-free region if none is given (bytes)
+var noGCDefaultHeadroom = 4096;
+var inNoGC = false;
+
+process.noGC = function(headroom, fn) {
+  if (typeof headroom === 'function') {
+    fn = headroom;
+    headroom = noGCDefaultHeadroom;
+  }
+  if (typeof fn !== 'function') {
+    throw new TypeError('Bad arguments: fn must be a function');
+  }
+  // A nested region runs within the headroom of the outer one
+  if (inNoGC) {
+    return fn();
+  }
+  if (!process._beginNoGC(headroom)) {
+    throw new RangeError('Cannot reserve ' + headroom +
+                         ' bytes of heap for a GC-free region');
+  }
+
+  var result;
+  var overrun;
+  inNoGC = true;
+  try {
+    result = fn();
+  } finally {
+    inNoGC = false;
+    overrun = process._endNoGC();
+  }
+  if (overrun) {
+    throw new RangeError('GC-free region overran its ' + headroom +
+                         ' bytes of headroom');
+  }
+  return result;
+};
+
+
 var module = Native.require('module');
 module.runMain();
@@ -0,0 +1,122 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var util = require('util');
+var logBuiltin = process.binding(process.binding.log);
+
+
+var defaultSize = 64 * 1024;
+var defaultFormatsSize = 4 * 1024;
+
+
+// The format strings by id, or null while the log is closed.
+var formats = null;
+
+
+function open(options) {
+  options = options || {};
+
+  var size = util.isNumber(options.size) ? options.size : defaultSize;
+  var formatsSize = util.isNumber(options.formatsSize) ?
+                    options.formatsSize : defaultFormatsSize;
+  var path = util.isString(options.path) ? options.path : '';
+
+  close();
+  logBuiltin.open(size, formatsSize, path);
+  formats = logBuiltin.formats();
+}
+
+
+function close() {
+  if (formats) {
+    logBuiltin.close();
+    formats = null;
+  }
+}
+
+
+// Returns the id of a format string, to be passed to write(). A log file
+// opened again keeps the ids of its formats.
+function format(fmt) {
+  if (!util.isString(fmt)) {
+    throw new TypeError('Bad arguments: format must be a string');
+  }
+  if (!formats) {
+    open();
+  }
+
+  var id = formats.indexOf(fmt);
+  if (id < 0) {
+    id = logBuiltin.addFormat(fmt);
+    formats[id] = fmt;
+  }
+  return id;
+}
+
+
+// Returns the records, oldest first, without formatting them.
+function records() {
+  if (!formats) {
+    return [];
+  }
+
+  return logBuiltin.read().map(function(record) {
+    return {
+      format: formats[record[0]],
+      time: record[1],
+      args: record.slice(2)
+    };
+  });
+}
+
+
+// Formats the records with util.format(), passes the lines to `write` or
+// console.log() and empties the log. Returns the number of records.
+function flush(write) {
+  if (!formats) {
+    return 0;
+  }
+
+  write = util.isFunction(write) ? write : console.log;
+
+  var list = logBuiltin.read();
+  logBuiltin.clear();
+
+  for (var i = 0; i < list.length; i++) {
+    var record = list[i];
+    var args = record.slice(1);
+    args[0] = formats[record[0]];
+    write(new Date(record[1]).toISOString() + ' ' +
+          util.format.apply(null, args));
+  }
+
+  return list.length;
+}
+
+
+function stats() {
+  return formats ? logBuiltin.stats() : null;
+}
+
+
+exports.open = open;
+exports.close = close;
+exports.format = format;
+// write(id[, ...args]) records the arguments as they are, to be formatted
+// with the format of `id` when the log is flushed.
+exports.write = logBuiltin.write;
+exports.records = records;
+exports.flush = flush;
+exports.stats = stats;
@@ -15,7 +15,7 @@
 
 
 var Native = require('native');
-var fs = Native.require('fs');
+var fsBuiltin = process.binding(process.binding.fs);
 
 function iotjs_module_t(id, parent) {
   this.id = id;
@@ -31,6 +31,23 @@ iotjs_module_t.cache = {};
 iotjs_module_t.wrapper = Native.wrapper;
 iotjs_module_t.wrap = Native.wrap;
 
+// Suffix of the snapshot files generated by tools/js2snapshot.py
+var SNAPSHOT_EXT = '.snapshot';
+
+// Suffix of the native addons, shared libraries built against
+// include/iotjs_addon.h
+var ADDON_EXT = '.node';
+
+// Directory to cache the byte code of the loaded modules in
+var codeCacheDir = process.env.IOTJS_CODE_CACHE;
+
+// Suffix of the application bundles generated by tools/js2bundle.py
+var BUNDLE_EXT = '.bundle';
+
+// The modules of an open bundle are found under its path, as if it was the
+// directory the bundle was made of.
+var bundleRoot = null;
+
 
 var cwd;
 try {
@@ -62,10 +79,65 @@ iotjs_module_t.resolveDirectories = function(id, parent) {
 };
 
 
+// Candidates tried in each directory, in this order. Modules precompiled by
+// tools/js2snapshot.py are found by their source name, and native addons
+// come last.
+function modulePaths(modulePath) {
+  return [modulePath, modulePath + SNAPSHOT_EXT,
+          modulePath + '.js', modulePath + '.js' + SNAPSHOT_EXT,
+          modulePath + ADDON_EXT];
+}
+
+
+// Paths under the bundle are normalized, as the file system cannot resolve
+// '..' through the bundle file.
+function bundlePath(path) {
+  if (!bundleRoot || path.indexOf(bundleRoot) !== 0) {
+    return path;
+  }
+  return iotjs_module_t.normalizePath(path);
+}
+
+
+// The name of a path in the open bundle, or null.
+function bundleName(path) {
+  path = bundlePath(path);
+  if (!bundleRoot || path.indexOf(bundleRoot) !== 0) {
+    return null;
+  }
+  return path.substring(bundleRoot.length);
+}
+
+
+// Index of the first of the paths from `start` which exists, or -1. Paths in
+// the bundle are looked up in its index, without touching the file system.
+function probe(paths, start) {
+  if (!bundleRoot) {
+    return fsBuiltin.probe(paths, start);
+  }
+  for (var i = start || 0; i < paths.length; i++) {
+    var name = bundleName(paths[i]);
+    if (name !== null ? process.probeBundle(name)
+                      : fsBuiltin.probe([bundlePath(paths[i])]) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+function readSource(path) {
+  var name = bundleName(path);
+  return name !== null ? process.readBundled(name)
+                       : process.readSource(bundlePath(path));
+}
+
+
 iotjs_module_t.resolveFilepath = function(id, directories) {
+  // All the candidates of all the directories are probed by one native call.
+  var candidates = [];
   for (var i = 0; i < directories.length; i++) {
-    var dir = directories[i];
-    var modulePath = dir + id;
+    var modulePath = directories[i] + id;
 
     if (modulePath[0] !== '/') {
       modulePath = process.cwd() + '/' + modulePath;
@@ -75,37 +147,29 @@ iotjs_module_t.resolveFilepath = function(id, directories) {
       modulePath = iotjs_module_t.normalizePath(modulePath);
     }
 
-    // 1. 'id'
-    var filepath = iotjs_module_t.tryPath(modulePath);
+    // 1. 'id', 2. 'id.js', 3. package path id/
+    candidates = candidates.concat(modulePaths(modulePath),
+                                   modulePath + '/package.json');
+  }
 
-    if (filepath) {
-      return filepath;
+  var probesPerDirectory = candidates.length / directories.length;
+  var index = -1;
+  while ((index = probe(candidates, index + 1)) >= 0) {
+    if (index % probesPerDirectory != probesPerDirectory - 1) {
+      return candidates[index];
     }
 
-    // 2. 'id.js'
-    filepath = iotjs_module_t.tryPath(modulePath + '.js');
-
-    if (filepath) {
-      return filepath;
-    }
+    var jsonpath = candidates[index];
+    var packagePath = jsonpath.substring(0, jsonpath.lastIndexOf('/'));
+    var pkgMainFile = JSON.parse(readSource(jsonpath)).main;
 
-    // 3. package path id/
-    var jsonpath = modulePath + "/package.json";
-    filepath = iotjs_module_t.tryPath(jsonpath);
-    if (filepath) {
-      var pkgSrc = process.readSource(jsonpath);
-      var pkgMainFile = JSON.parse(pkgSrc).main;
-      filepath = iotjs_module_t.tryPath(modulePath + "/" + pkgMainFile);
-      if (filepath) {
-        return filepath;
-      }
-      // index.js
-      filepath = iotjs_module_t.tryPath(modulePath + "/" + "index.js");
-      if (filepath) {
-        return filepath;
-      }
+    // The main file of the package, or index.js
+    var mainPaths = modulePaths(packagePath + "/" + pkgMainFile).concat(
+        modulePaths(packagePath + "/" + "index.js"));
+    var main = probe(mainPaths);
+    if (main >= 0) {
+      return mainPaths[main];
     }
-
   }
 
   return false;
@@ -159,14 +223,13 @@ iotjs_module_t.normalizePath = function(path) {
 
 
 iotjs_module_t.tryPath = function(path) {
-  try {
-    var stats = fs.statSync(path);
-    if (stats && !stats.isDirectory()) {
-      return path;
-    }
-  } catch (ex) { }
+  return probe([path]) == 0 ? path : false;
+};
 
-  return false;
+
+iotjs_module_t.tryModulePath = function(path) {
+  return iotjs_module_t.tryPath(path) ||
+         iotjs_module_t.tryPath(path + SNAPSHOT_EXT);
 };
 
 
@@ -198,15 +261,65 @@ iotjs_module_t.load = function(id, parent, isMain) {
 
 
 iotjs_module_t.prototype.compile = function() {
-  var source = process.readSource(this.filename);
-  var fn = process.compile(this.filename, source);
+  var addonIndex = this.filename.length - ADDON_EXT.length;
+  if (addonIndex > 0 && this.filename.lastIndexOf(ADDON_EXT) === addonIndex) {
+    if (!process.dlopen) {
+      throw new Error('Native addons are not supported: ' + this.filename);
+    }
+    process.dlopen(this.exports, this.filename);
+    return;
+  }
+
+  var fn;
+  var name = bundleName(this.filename);
+  var extIndex = this.filename.length - SNAPSHOT_EXT.length;
+  if (name !== null) {
+    fn = process.compileBundled(name, this.filename);
+  } else if (extIndex > 0 &&
+             this.filename.lastIndexOf(SNAPSHOT_EXT) === extIndex) {
+    fn = process.compileSnapshot(this.filename);
+  } else {
+    var source = process.readSource(this.filename);
+    if (codeCacheDir) {
+      fn = process.compileCached(this.filename, source, codeCacheDir);
+    } else {
+      fn = process.compile(this.filename, source);
+    }
+  }
   fn.call(this.exports, this.exports, this.require.bind(this), this);
 };
 
 
+// Opens an application bundle, whose modules are then required by their path
+// under the path of the bundle. Returns the path of its main module, if any.
+iotjs_module_t.openBundle = function(path) {
+  if (path[0] !== '/') {
+    path = process.cwd() + '/' + path;
+  }
+  path = iotjs_module_t.normalizePath(path);
+
+  var main = process.openBundle(path);
+  bundleRoot = path + '/';
+  // Packages of the bundle come before the ones installed on the device.
+  moduledirs.splice(1, 0, bundleRoot + 'iotjs_modules/');
+
+  return main === undefined ? undefined : bundleRoot + main;
+};
+
+
 iotjs_module_t.runMain = function() {
-  iotjs_module_t.load(process.argv[1], null, true);
-  while (process._onNextTick());
+  process._markStartup('iotjsJs');
+  var mainPath = process.argv[1];
+  var extIndex = mainPath.length - BUNDLE_EXT.length;
+  if (extIndex > 0 && mainPath.lastIndexOf(BUNDLE_EXT) === extIndex) {
+    mainPath = iotjs_module_t.openBundle(mainPath);
+    if (mainPath === undefined) {
+      throw new Error('Bundle has no main module: ' + process.argv[1]);
+    }
+  }
+  iotjs_module_t.load(mainPath, null, true);
+  process._markStartup('mainModule');
+  while (process._runNextTicks());
 };
 
 iotjs_module_t.prototype.require = function(id) {
@@ -21,9 +21,21 @@ var assert = require('assert');
 
 var TCP = process.binding(process.binding.tcp);
 
+// Bytes waiting to be written to the destination of a native pipe before
+// the source stops reading.
+var spliceHighWaterMark = 16 * 1024;
+var defaultFastOpenQueueLength = 16;
+
+// Bytes buffered by all the sockets: read and not consumed, or written and
+// not taken by the kernel. The sockets that stopped reading while over a cap
+// are restarted as the buffers drain.
+var totalBuffered = 0;
+var limitedSockets = [];
+
 
 function createTCP() {
   var tcp = new TCP();
+  tcp.writeQueueSize = 0;
   return tcp;
 }
 
@@ -59,6 +71,23 @@ function Socket(options) {
   this._timer = null;
   this._timeout = 0;
 
+  // native writes not completed yet, and the stream's callback for the chunk
+  // waiting for the native write queue to fall under the high water mark.
+  this._writesPending = 0;
+  this._afterWrite = null;
+  this._onWritesDone = null;
+
+  // Whether a file is being sent by sendfile(2), and a close waits for it.
+  this._sendingFile = false;
+  this._closePending = false;
+
+  // The most bytes the socket may buffer on each side, and what it buffers.
+  this.maxBufferedBytes = util.isNumber(options.maxBufferedBytes) ?
+                          options.maxBufferedBytes : undefined;
+  this._bufferedRead = 0;
+  this._bufferedWrite = 0;
+  this._readLimited = false;
+
   this._socketState = new SocketState(options);
 
   if (options.handle) {
@@ -68,6 +97,19 @@ function Socket(options) {
 
   this.on('finish', onSocketFinish);
   this.on('end', onSocketEnd);
+
+  // Wraps a socket that is already connected.
+  if (util.isNumber(options.fd)) {
+    this._handle = createTCP();
+    this._handle.owner = this;
+
+    var err = this._handle.open(options.fd);
+    if (err) {
+      throw new Error('open error: ' + TCP.errname(err));
+    }
+
+    onSocketConnect(this);
+  }
 }
 
 
@@ -92,6 +134,11 @@ Socket.prototype.connect = function() {
     self._handle.owner = self;
   }
 
+  var err = setSocketOptions(self._handle, options);
+  if (err) {
+    throw new Error('socket option error: ' + TCP.errname(err));
+  }
+
   if (util.isFunction(callback)) {
     self.once('connect', callback);
   }
@@ -137,39 +184,338 @@ Socket.prototype.connect = function() {
 
 
 Socket.prototype.write = function(data, callback) {
-  if (!util.isString(data) && !util.isBuffer(data)) {
+  if (util.isString(data)) {
+    data = new Buffer(data);
+  } else if (!util.isBuffer(data)) {
     throw new TypeError('invalid argument');
   }
+
+  if (overLimit(this, this._bufferedWrite, data.length)) {
+    var self = this;
+    var err = new Error('socket buffer limit exceeded');
+    process.nextTick(function() {
+      if (util.isFunction(callback)) {
+        callback.call(self, err);
+      }
+      self.emit('error', err);
+    });
+    return false;
+  }
+
+  this._bufferedWrite += data.length;
+  totalBuffered += data.length;
+
   return stream.Duplex.prototype.write.call(this, data, callback);
 };
 
 
+Socket.prototype.read = function(n) {
+  var res = stream.Duplex.prototype.read.call(this, n);
+  accountRead(this);
+  return res;
+};
+
+
+Socket.prototype.resume = function() {
+  stream.Duplex.prototype.resume.call(this);
+  accountRead(this);
+  return this;
+};
+
+
 Socket.prototype._write = function(chunk, callback, afterWrite) {
   assert(util.isBuffer(chunk));
   assert(util.isFunction(afterWrite));
 
+  if (chunk._file) {
+    writeChunks(this, [chunk], callback, afterWrite);
+  } else {
+    writeGeneric(this, false, chunk, callback, afterWrite);
+  }
+};
+
+
+// socket.bufferSize
+// Bytes written and not yet taken by the kernel. The chunk being written is
+// counted in the native write queue.
+Object.defineProperty(Socket.prototype, 'bufferSize', {
+  get: function() {
+    var state = this._writableState;
+    var queued = this._handle ? this._handle.writeQueueSize : 0;
+    return state.length - state.writingLength + queued;
+  },
+});
+
+
+// Writes down the chunks buffered by the writable stream in a single request.
+Socket.prototype._writev = function(chunks, callback, afterWrite) {
+  assert(util.isArray(chunks));
+  assert(util.isFunction(afterWrite));
+
+  for (var i = 0; i < chunks.length; ++i) {
+    if (chunks[i]._file) {
+      writeChunks(this, chunks, callback, afterWrite);
+      return;
+    }
+  }
+
+  writeGeneric(this, true, chunks, callback, afterWrite);
+};
+
+
+// The writes of the stream are finished once the kernel has taken them all.
+Socket.prototype._final = function(callback) {
+  if (this._writesPending > 0) {
+    this._onWritesDone = callback;
+  } else {
+    callback();
+  }
+};
+
+
+// socket.sendFile(fd[, offset[, length]][, callback])
+// Sends `length` bytes of the file of `fd` from `offset`, or the file up to
+// its end, in order with the data written before and after. The data goes
+// from the file to the socket by sendfile(2), and not through JavaScript; an
+// encrypted socket reads and writes it as any data.
+Socket.prototype.sendFile = function(fd, offset, length, callback) {
+  if (util.isFunction(offset)) {
+    callback = offset;
+    offset = undefined;
+  } else if (util.isFunction(length)) {
+    callback = length;
+    length = undefined;
+  }
+
+  if (!util.isNumber(fd)) {
+    throw new TypeError('Bad arguments: fd must be a number');
+  }
+
+  // The file goes down the writable stream as an empty chunk, which holds
+  // the stream until the file is sent.
+  var chunk = new Buffer(0);
+  chunk._file = {
+    fd: fd,
+    offset: util.isNumber(offset) ? offset : 0,
+    length: util.isNumber(length) ? length : -1,
+    sent: 0
+  };
+
   var self = this;
+  return this.write(chunk, function(status) {
+    if (util.isFunction(callback)) {
+      var err = status;
+      if (status && !(status instanceof Error)) {
+        err = new Error('sendFile failed - status: ' + TCP.errname(status));
+      }
+      callback.call(self, err || null, chunk._file.sent);
+    }
+  });
+};
+
+
+// Bytes of a file asked for by one request.
+var sendFileChunkSize = 64 * 1024;
+
+
+// Writes chunks of which some stand for files, one after the other. The data
+// between the files is written by single requests.
+function writeChunks(self, chunks, callback, afterWrite) {
+  var index = 0;
+
+  var done = function(status) {
+    if (util.isFunction(callback)) {
+      callback.call(self, status);
+    }
+    afterWrite(status);
+  };
+
+  var next = function(status) {
+    if (status || index == chunks.length) {
+      done(status);
+    } else if (chunks[index]._file) {
+      sendFileChunk(self, chunks[index++]._file, next);
+    } else {
+      var data = [];
+      while (index < chunks.length && !chunks[index]._file) {
+        data.push(chunks[index++]);
+      }
+      writeGeneric(self, true, data, null, next);
+    }
+  };
+
+  next(0);
+}
+
+
+// Sends a file once the writes before it are taken by the kernel, since
+// sendfile(2) writes to the socket directly around the native write queue.
+function sendFileChunk(self, file, callback) {
+  if (self.errored || !self._handle) {
+    process.nextTick(callback, 1);
+    return;
+  }
+
+  if (self._writesPending > 0) {
+    self._onWritesDone = function() {
+      sendFileChunk(self, file, callback);
+    };
+    return;
+  }
+
+  var handle = self._handle;
+  self._sendingFile = true;
+
+  var finish = function(status) {
+    self._sendingFile = false;
+    if (self._closePending) {
+      self._closePending = false;
+      close(self);
+    }
+    callback(status);
+  };
+
+  var send = function() {
+    var size = sendFileChunkSize;
+    if (file.length >= 0) {
+      size = Math.min(size, file.length - file.sent);
+      if (size == 0) {
+        finish(0);
+        return;
+      }
+    }
+
+    resetSocketTimeout(self);
+
+    var onsent = function(status, bytes) {
+      if (status) {
+        finish(status);
+      } else if (bytes == 0) {
+        // The end of the file.
+        finish(0);
+      } else {
+        file.sent += bytes;
+        send();
+      }
+    };
+
+    var err = self.encrypted ? sendFileData(self, file, size, onsent)
+                             : handle.sendFile(file.fd, file.offset + file.sent,
+                                               size, onsent);
+    if (err) {
+      finish(err);
+    }
+  };
+
+  send();
+}
+
+
+// An encrypted socket writes the data of a file as it writes any data.
+function sendFileData(self, file, size, callback) {
+  var fs = require('fs');
+  var buffer = new Buffer(size);
+
+  fs.read(file.fd, buffer, 0, size, file.offset + file.sent,
+          function(err, bytesRead) {
+    if (err) {
+      callback(-1, 0);
+    } else if (bytesRead == 0) {
+      callback(0, 0);
+    } else {
+      var data = bytesRead < size ? buffer.slice(0, bytesRead) : buffer;
+      self._bufferedWrite += bytesRead;
+      totalBuffered += bytesRead;
+      writeGeneric(self, false, data, null, function(status) {
+        if (status) {
+          callback(status, 0);
+        } else if (self._writesPending > 0) {
+          self._onWritesDone = function() {
+            callback(0, bytesRead);
+          };
+        } else {
+          callback(0, bytesRead);
+        }
+      });
+    }
+  });
+
+  return 0;
+}
+
+
+// Hands `data` to the native write queue. The stream goes on with its next
+// chunk while the bytes the kernel has not taken stay below the high water
+// mark, which most writes to a connection keeping up leave at zero. Above it
+// the chunks wait in the stream, write() returns false, and 'drain' comes
+// once the native queue is back under the mark.
+function writeGeneric(self, writev, data, callback, afterWrite) {
+  var size = data.length;
+  if (writev) {
+    size = 0;
+    for (var i = 0; i < data.length; ++i) {
+      size += data[i].length;
+    }
+  }
 
   if (self.errored) {
+    releaseWritten(self, size);
     process.nextTick(afterWrite, 1);
     if (util.isFunction(callback)) {
       process.nextTick(function(self, status) {
         callback.call(self, status);
       }, self, 1);
     }
-  } else {
-    resetSocketTimeout(self);
+    return;
+  }
 
-    self._handle.owner = self;
+  resetSocketTimeout(self);
 
-    self._handle.write(chunk, function(status) {
-      afterWrite(status);
-      if (util.isFunction(callback)) {
+  var handle = self._handle;
+  handle.owner = self;
+
+  var onwrite = function(status) {
+    self._writesPending--;
+    releaseWritten(self, size);
+    if (status < 0 && !self.errored) {
+      // The peer has gone away; the socket ends and is destroyed.
+      emitError(self, new Error('write error: ' + status));
+    }
+    var drained = handle.writeQueueSize <= self._writableState.highWaterMark;
+    if (self._afterWrite && (status || drained)) {
+      var done = self._afterWrite;
+      self._afterWrite = null;
+      done(status);
+    }
+    if (util.isFunction(callback)) {
+      callback.call(self, status);
+    }
+    if (self._writesPending == 0 && self._onWritesDone) {
+      var onWritesDone = self._onWritesDone;
+      self._onWritesDone = null;
+      onWritesDone();
+    }
+  };
+
+  var err = writev ? handle.writev(data, onwrite) : handle.write(data, onwrite);
+  if (err) {
+    releaseWritten(self, size);
+    process.nextTick(afterWrite, err);
+    if (util.isFunction(callback)) {
+      process.nextTick(function(self, status) {
         callback.call(self, status);
-      }
-    });
+      }, self, err);
+    }
+    return;
   }
-};
+
+  self._writesPending++;
+  if (handle.writeQueueSize <= self._writableState.highWaterMark) {
+    afterWrite(0);
+  } else {
+    self._afterWrite = afterWrite;
+  }
+}
 
 
 Socket.prototype.end = function(data, callback) {
@@ -228,6 +574,17 @@ Socket.prototype.destroySoon = function() {
 }
 
 
+// Small writes are sent at once rather than held back by the Nagle
+// algorithm until the data before them is acknowledged.
+Socket.prototype.setNoDelay = function(noDelay) {
+  noDelay = noDelay === undefined ? 1 : +Boolean(noDelay);
+  if (this._handle && this._handle.setNoDelay) {
+    this._handle.setNoDelay(noDelay);
+  }
+  return this;
+};
+
+
 Socket.prototype.setKeepAlive = function(enable, delay) {
   var self = this;
   enable = +Boolean(enable);
@@ -237,6 +594,23 @@ Socket.prototype.setKeepAlive = function(enable, delay) {
 };
 
 
+Socket.prototype.ref = function() {
+  if (this._handle) {
+    this._handle.ref();
+  }
+  return this;
+};
+
+
+// An unreferenced socket does not keep the process running on its own.
+Socket.prototype.unref = function() {
+  if (this._handle) {
+    this._handle.unref();
+  }
+  return this;
+};
+
+
 Socket.prototype.address = function() {
   if (!this._handle || !this._handle.getsockname) {
     return {};
@@ -273,6 +647,39 @@ Socket.prototype.setTimeout = function(msecs, callback) {
 };
 
 
+// A socket piped to another socket, with no 'data' listeners and nothing
+// buffered on either side, hands its data over natively without surfacing
+// it to JavaScript. Otherwise it is piped as any readable stream.
+Socket.prototype.pipe = function(destination, options) {
+  if (canSplice(this, destination)) {
+    var highWaterMark = Math.max(destination._writableState.highWaterMark,
+                                 spliceHighWaterMark);
+    if (this._handle.splice(destination._handle, highWaterMark) == 0) {
+      if (!options || options.end !== false) {
+        this.on('end', function() {
+          destination.end();
+        });
+      }
+      destination.emit('pipe', this);
+      return destination;
+    }
+  }
+
+  return stream.Readable.prototype.pipe.call(this, destination, options);
+};
+
+
+function canSplice(source, destination) {
+  var readableState = source._readableState;
+  return destination instanceof Socket &&
+         !source.encrypted && !destination.encrypted &&
+         !!source._handle && !!destination._handle &&
+         destination._socketState.connected &&
+         !readableState.ended && readableState.length == 0 &&
+         destination._writableState.length == 0 &&
+         !(source._events && source._events.data);
+}
+
 function connect(socket, ip, port) {
   var afterConnect = function(status) {
     var state = socket._socketState;
@@ -301,8 +708,20 @@ function connect(socket, ip, port) {
 
 
 function close(socket) {
+  // The thread sending a file writes to the socket until it is done.
+  if (socket._sendingFile) {
+    socket._closePending = true;
+    return;
+  }
+
   socket._handle.owner = socket;
   socket._handle.onclose = function() {
+    // The connection counts for `maxConnections` until its handle is closed,
+    // so a held back one is not accepted before the listeners have seen it
+    // close.
+    if (socket._server) {
+      leaveServer(socket);
+    }
     socket.emit('close');
   };
 
@@ -310,12 +729,105 @@ function close(socket) {
   socket._handle = null;
   handle.close();
 
-  if (socket._server) {
-    var server = socket._server;
-    server._socketCount--;
-    server._emitCloseIfDrained();
-    socket._server = null;
+  releaseBuffered(socket);
+}
+
+
+function leaveServer(socket) {
+  var server = socket._server;
+  server._socketCount--;
+  server._emitCloseIfDrained();
+  socket._server = null;
+
+  if (server._handle) {
+    fillHandlePool(server);
+    if (server._acceptPaused) {
+      server._acceptPaused = false;
+      process.nextTick(resumeAccept, server);
+    }
+  }
+}
+
+
+// Whether `size` more bytes on a side of `socket` that buffers `buffered`
+// would go over the cap of the socket or net.maxTotalBufferedBytes.
+function overLimit(socket, buffered, size) {
+  var limit = socket.maxBufferedBytes;
+  var totalLimit = exports.maxTotalBufferedBytes;
+  return (limit > 0 && buffered + size > limit) ||
+         (totalLimit > 0 && totalBuffered + size > totalLimit);
+}
+
+
+// Brings the accounting of the read side of `socket` up to its readable
+// buffer. Reading stops while the buffer is at a cap, and it restarts once
+// the data is consumed.
+function accountRead(socket) {
+  var length = socket._readableState.length;
+  if (length != socket._bufferedRead) {
+    var released = length < socket._bufferedRead;
+    totalBuffered += length - socket._bufferedRead;
+    socket._bufferedRead = length;
+    if (released) {
+      restartLimited();
+    }
+  }
+
+  var handle = socket._handle;
+  if (!handle) {
+    return;
+  }
+
+  var limit = socket.maxBufferedBytes;
+  var totalLimit = exports.maxTotalBufferedBytes;
+  var limited = length > 0 && ((limit > 0 && length >= limit) ||
+                               (totalLimit > 0 && totalBuffered >= totalLimit));
+  if (limited && !socket._readLimited) {
+    socket._readLimited = true;
+    limitedSockets.push(socket);
+    handle.readStop();
+  } else if (!limited && socket._readLimited) {
+    socket._readLimited = false;
+    limitedSockets.splice(limitedSockets.indexOf(socket), 1);
+    handle.readStart();
+  }
+}
+
+
+// The buffers of the sockets shrank: the sockets that stopped reading for
+// the total cap may read again.
+function restartLimited() {
+  var totalLimit = exports.maxTotalBufferedBytes;
+  if (limitedSockets.length == 0 ||
+      (totalLimit > 0 && totalBuffered >= totalLimit)) {
+    return;
+  }
+
+  var sockets = limitedSockets.slice();
+  for (var i = 0; i < sockets.length; ++i) {
+    accountRead(sockets[i]);
+  }
+}
+
+
+function releaseWritten(socket, size) {
+  size = Math.min(size, socket._bufferedWrite);
+  socket._bufferedWrite -= size;
+  totalBuffered -= size;
+  restartLimited();
+}
+
+
+// A closed socket buffers nothing anymore.
+function releaseBuffered(socket) {
+  totalBuffered -= socket._bufferedRead + socket._bufferedWrite;
+  socket._bufferedRead = 0;
+  socket._bufferedWrite = 0;
+  if (socket._readLimited) {
+    socket._readLimited = false;
+    limitedSockets.splice(limitedSockets.indexOf(socket), 1);
   }
+  restartLimited();
 }
 
 
@@ -399,9 +911,18 @@ function onread(socket, nread, isEOF, buffer) {
   } else if (nread < 0) {
     var err = new Error('read error: ' + nread);
     stream.Readable.prototype.error.call(socket, err);
+    // The connection is broken; nothing more is read or written.
+    socket.destroy();
   } else if (nread > 0) {
     if (process.platform  !== 'nuttx') {
-      stream.Readable.prototype.push.call(socket, buffer);
+      var readableState = socket._readableState;
+      if (readableState.flowing && readableState.length == 0) {
+        // Nothing buffered to go first, the data goes to the listeners.
+        socket.emit('data', buffer);
+      } else {
+        stream.Readable.prototype.push.call(socket, buffer);
+        accountRead(socket);
+      }
       return;
     }
 
@@ -480,6 +1001,20 @@ function Server(options, connectionListener) {
   this._socketCount = 0;
 
   this.allowHalfOpen = options.allowHalfOpen || false;
+  this.noDelay = !!options.noDelay;
+  this._options = options;
+
+  // Beyond this many connections, the server stops accepting, and new
+  // connections wait in the backlog of the kernel.
+  this.maxConnections = util.isNumber(options.maxConnections) ?
+                        options.maxConnections : undefined;
+
+  // tcp handles created ahead for the connections to come, so a burst of
+  // connections does not allocate them all at once.
+  this._handlePoolSize = options.preallocate >>> 0;
+  this._handlePool = [];
+
+  this._acceptPaused = false;
 }
 
 // Server inherits EventEmitter.
@@ -498,6 +1033,9 @@ Server.prototype.listen = function() {
   var port = options.port;
   var host = util.isString(options.host) ? options.host : '0.0.0.0';
   var backlog = util.isNumber(options.backlog) ? options.backlog : 511;
+  // Cluster workers share the port, and the kernel spreads the connections
+  // over them.
+  var reusePort = !!options.reusePort || !!process.env.IOTJS_CLUSTER_WORKER;
 
   if (!util.isNumber(port)) {
     throw new Error('invalid argument - need port number');
@@ -513,19 +1051,35 @@ Server.prototype.listen = function() {
     self._handle = createTCP();
   }
 
+  // Taken at listen: the buffer sizes are inherited by the accepted
+  // connections. TCP Fast Open takes the length of its queue.
+  var err = setSocketOptions(self._handle, {
+    recvBufferSize: self._options.recvBufferSize,
+    sendBufferSize: self._options.sendBufferSize,
+    fastOpen: self._options.fastOpen
+  });
+  if (err) {
+    self._handle.close();
+    return self.emit('error', err);
+  }
+
   // bind port
-  var err = self._handle.bind(host, port);
+  err = self._handle.bind(host, port, reusePort);
   if (err) {
     self._handle.close();
     return self.emit('error', err);
   }
 
   // listen
+  fillHandlePool(self);
   self._handle.onconnection = onconnection;
-  self._handle.createTCP = createTCP;
+  self._handle.createTCP = function() {
+    return self._handlePool.pop() || createTCP();
+  };
   self._handle.owner = self;
+  updateAcceptLimit(self);
 
-  var err = self._handle.listen(backlog);
+  err = self._handle.listen(backlog);
 
   if (err) {
     self._handle.close();
@@ -568,6 +1122,9 @@ Server.prototype.close = function(callback) {
     this._handle.close();
     this._handle = null;
   }
+  while (this._handlePool.length > 0) {
+    this._handlePool.pop().close();
+  }
   this._emitCloseIfDrained();
   return this;
 };
@@ -586,14 +1143,22 @@ Server.prototype._emitCloseIfDrained = function() {
 };
 
 
-// This function is called after server accepted connection request
-// from a client.
+// Makes the socket of an accepted connection. A server of sockets of another
+// kind, such as tls.Server, overrides it.
+Server.prototype._createSocket = function(handle, options) {
+  options.handle = handle;
+  return new Socket(options);
+};
+
+
+// This function is called after server accepted connection requests
+// from clients.
 //  This binding
 //   * server tcp handle
 //  Parameters
 //   * status - status code
-//   * clientHandle - client socket handle (tcp).
-function onconnection(status, clientHandle) {
+//   * clientHandles - array of client socket handles (tcp).
+function onconnection(status, clientHandles) {
   var server = this.owner;
 
   if (status) {
@@ -601,18 +1166,86 @@ function onconnection(status, clientHandle) {
     return;
   }
 
-  // Create socket object for connecting client.
-  var socket = new Socket({
-    handle: clientHandle,
-    allowHalfOpen: server.allowHalfOpen
-  });
-  socket._server = server;
+  for (var i = 0; i < clientHandles.length; ++i) {
+    // Create socket object for connecting client.
+    var socket = server._createSocket(clientHandles[i], {
+      allowHalfOpen: server.allowHalfOpen,
+      maxBufferedBytes: server._options.maxBufferedBytes
+    });
+    socket._server = server;
+
+    if (server.noDelay) {
+      socket.setNoDelay(true);
+    }
 
-  onSocketConnect(socket);
+    onSocketConnect(socket);
 
-  server._socketCount++;
+    server._socketCount++;
 
-  server.emit('connection', socket);
+    server.emit('connection', socket);
+  }
+
+  // `maxConnections` may have been changed by the listeners.
+  updateAcceptLimit(server);
+}
+
+
+// Tells the listening socket how many more connections `maxConnections`
+// leaves room for.
+function updateAcceptLimit(server) {
+  if (!server._handle) {
+    return;
+  }
+
+  var limit = -1;
+  if (server.maxConnections > 0) {
+    limit = Math.max(server.maxConnections - server._socketCount, 0);
+  }
+  server._handle.setAcceptLimit(limit);
+  server._acceptPaused = limit == 0;
+}
+
+
+// A connection closed below `maxConnections`: the connections held back
+// are accepted.
+function resumeAccept(server) {
+  var handle = server._handle;
+  if (handle) {
+    updateAcceptLimit(server);
+    onconnection.call(handle, 0, handle.accept());
+  }
+}
+
+
+function fillHandlePool(server) {
+  while (server._handlePool.length < server._handlePoolSize) {
+    server._handlePool.push(createTCP());
+  }
+}
+
+
+// Sets the `noDelay`, `recvBufferSize`, `sendBufferSize` and `fastOpen`
+// options given on a tcp handle. Returns an error code.
+function setSocketOptions(handle, options) {
+  var err = 0;
+
+  if (options.noDelay) {
+    err = handle.setNoDelay(1);
+  }
+
+  var recvBufferSize = options.recvBufferSize >>> 0;
+  var sendBufferSize = options.sendBufferSize >>> 0;
+  if (!err && (recvBufferSize || sendBufferSize)) {
+    err = handle.setBufferSize(recvBufferSize, sendBufferSize);
+  }
+
+  if (!err && options.fastOpen) {
+    var qlen = util.isNumber(options.fastOpen) ? options.fastOpen >>> 0 :
+                                                 defaultFastOpenQueueLength;
+    err = handle.setFastOpen(qlen);
+  }
+
+  return err;
 }
 
 
@@ -670,5 +1303,16 @@ exports.connect = exports.createConnection = function() {
 };
 
 
+// The bytes buffered by all the sockets.
+exports.getBufferedBytes = function() {
+  return totalBuffered;
+};
+
+
+// The most bytes all the sockets may buffer together, or undefined for no
+// limit.
+exports.maxTotalBufferedBytes = undefined;
+
+
 module.exports.Socket = Socket;
 module.exports.Server = Server;
@@ -0,0 +1,206 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var util = require('util');
+var performanceBuiltin = process.binding(process.binding.performance);
+
+
+// The defaults of createHistogram(), which track nanoseconds up to a minute
+// at two significant figures in about 15KB of counts.
+var DEFAULT_LOWEST = 1;
+var DEFAULT_HIGHEST = 60e9;
+var DEFAULT_FIGURES = 2;
+
+
+function PerformanceEntry(name, entryType, startTime, duration) {
+  this.name = name;
+  this.entryType = entryType;
+  this.startTime = startTime;
+  this.duration = duration;
+}
+
+
+// The marks and the measures, in the order they were taken.
+var entries = [];
+
+
+function filterEntries(test) {
+  var result = [];
+  for (var i = 0; i < entries.length; i++) {
+    if (test(entries[i])) {
+      result.push(entries[i]);
+    }
+  }
+  return result;
+}
+
+
+function clearEntries(entryType, name) {
+  entries = filterEntries(function(entry) {
+    return entry.entryType !== entryType ||
+           (name !== undefined && entry.name !== name);
+  });
+}
+
+
+// The start time of the latest mark of a name.
+function markTime(name) {
+  for (var i = entries.length - 1; i >= 0; i--) {
+    if (entries[i].entryType === 'mark' && entries[i].name === name) {
+      return entries[i].startTime;
+    }
+  }
+  throw new Error('The mark does not exist: ' + name);
+}
+
+
+function checkName(name) {
+  if (!util.isString(name)) {
+    throw new TypeError('Bad arguments: name must be a string');
+  }
+}
+
+
+var performance = {};
+
+
+// Milliseconds since the startup of the process, from the monotonic clock.
+performance.now = performanceBuiltin.now;
+
+
+// The Date.now() the process started at, which performance.now() counts from.
+performance.timeOrigin = Date.now() - performance.now();
+
+
+performance.mark = function(name) {
+  checkName(name);
+  var entry = new PerformanceEntry(name, 'mark', performance.now(), 0);
+  entries.push(entry);
+  return entry;
+};
+
+
+// Measures from the mark `startMark`, or from the time origin, to the mark
+// `endMark`, or to now.
+performance.measure = function(name, startMark, endMark) {
+  checkName(name);
+  var end = endMark === undefined ? performance.now() : markTime(endMark);
+  var start = startMark === undefined ? 0 : markTime(startMark);
+  var entry = new PerformanceEntry(name, 'measure', start, end - start);
+  entries.push(entry);
+  return entry;
+};
+
+
+performance.getEntries = function() {
+  return entries.slice();
+};
+
+
+performance.getEntriesByName = function(name, entryType) {
+  return filterEntries(function(entry) {
+    return entry.name === name &&
+           (entryType === undefined || entry.entryType === entryType);
+  });
+};
+
+
+performance.getEntriesByType = function(entryType) {
+  return filterEntries(function(entry) {
+    return entry.entryType === entryType;
+  });
+};
+
+
+performance.clearMarks = function(name) {
+  clearEntries('mark', name);
+};
+
+
+performance.clearMeasures = function(name) {
+  clearEntries('measure', name);
+};
+
+
+// A histogram whose counts are kept natively in a fixed size, which does
+// not grow with the count of the values recorded.
+function RecordableHistogram(lowest, highest, figures) {
+  this._histogram = new performanceBuiltin.Histogram(lowest, highest,
+                                                     figures);
+}
+
+
+// Records an integer value, such as a latency in nanoseconds. Values above
+// the highest trackable one are only counted in `exceeds`.
+RecordableHistogram.prototype.record = function(value) {
+  if (!util.isNumber(value)) {
+    throw new TypeError('Bad arguments: histogram.record(number)');
+  }
+  this._histogram.record(value);
+};
+
+
+// Records the nanoseconds since the last call, without allocating. The
+// first call only starts the clock.
+RecordableHistogram.prototype.recordDelta = function() {
+  this._histogram.recordDelta();
+};
+
+
+// The highest value the given percent of the values are at or below, with
+// the precision of the histogram.
+RecordableHistogram.prototype.percentile = function(percentile) {
+  if (!util.isNumber(percentile)) {
+    throw new TypeError('Bad arguments: histogram.percentile(number)');
+  }
+  return this._histogram.percentile(percentile);
+};
+
+
+RecordableHistogram.prototype.reset = function() {
+  this._histogram.reset();
+};
+
+
+['count', 'min', 'max', 'mean', 'stddev', 'exceeds', 'byteLength'].forEach(
+  function(name, index) {
+    Object.defineProperty(RecordableHistogram.prototype, name, {
+      get: function() {
+        return this._histogram.stats()[index];
+      },
+    });
+  });
+
+
+function createHistogram(options) {
+  options = options || {};
+  var lowest = options.lowest === undefined ? DEFAULT_LOWEST : options.lowest;
+  var highest = options.highest === undefined ? DEFAULT_HIGHEST :
+                options.highest;
+  var figures = options.figures === undefined ? DEFAULT_FIGURES :
+                options.figures;
+
+  if (!util.isNumber(lowest) || !util.isNumber(highest) ||
+      !util.isNumber(figures)) {
+    throw new TypeError('Bad arguments: lowest, highest and figures must be ' +
+                        'numbers');
+  }
+  return new RecordableHistogram(lowest, highest, figures);
+}
+
+
+exports.performance = performance;
+exports.PerformanceEntry = PerformanceEntry;
+exports.createHistogram = createHistogram;
@@ -0,0 +1,62 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var util = require('util');
+
+
+// Milliseconds an operation may block the loop thread for.
+var INLINE_LIMIT = 1;
+
+
+// Runs the asynchronous operations of a GPIO pin, PWM pin or I2C bus. Most
+// of them are a system call of a few microseconds, much less than a round
+// trip through the threadpool, so they run on the loop thread and call back
+// on the next tick. Once an operation takes longer than INLINE_LIMIT, the
+// device is a slow one, and its later operations go to the threadpool.
+function AdaptiveCaller() {
+  this._inline = true;
+}
+
+
+// Calls back `callback(err, value)` on `self` with the result of
+// `syncFn()`, or of `asyncFn(done)` when the device is slow. Without
+// `asyncFn`, `syncFn` always runs inline.
+AdaptiveCaller.prototype.call = function(self, callback, syncFn, asyncFn) {
+  if (!this._inline && asyncFn) {
+    asyncFn(function(err, value) {
+      util.isFunction(callback) && callback.call(self, err, value);
+    });
+    return;
+  }
+
+  var err = null;
+  var value;
+  var start = Date.now();
+  try {
+    value = syncFn();
+  } catch (e) {
+    err = e;
+  }
+  if (Date.now() - start > INLINE_LIMIT) {
+    this._inline = false;
+  }
+
+  process.nextTick(function() {
+    util.isFunction(callback) && callback.call(self, err, value);
+  });
+};
+
+
+exports.AdaptiveCaller = AdaptiveCaller;
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+var AdaptiveCaller = require('peripheral_util').AdaptiveCaller;
 var util = require('util');
 var pwm = process.binding(process.binding.pwm);
 
@@ -30,6 +31,7 @@ Pwm.prototype.open = function(configuration, callback) {
 
 function pwmPinOpen(configuration, callback) {
   var _binding = null;
+  var _caller = new AdaptiveCaller();
 
   function PwmPin(configuration, callback) {
     var self = this;
@@ -80,6 +82,16 @@ function pwmPinOpen(configuration, callback) {
     })(this));
   }
 
+  // Calls the setter `name` of the binding with `value`, on the loop thread
+  // unless the pin turned out to be slow.
+  function callSetter(self, name, value, callback) {
+    _caller.call(self, callback, function() {
+      _binding[name](value);
+    }, function(done) {
+      _binding[name](value, done);
+    });
+  }
+
   PwmPin.prototype._validatePeriod = function(period) {
     if (!util.isNumber(period)) {
       throw new TypeError('Period is not a number(' + typeof(period) + ')');
@@ -116,9 +128,7 @@ function pwmPinOpen(configuration, callback) {
     }
 
     if (this._validatePeriod(period)) {
-      _binding.setPeriod(period, function(err) {
-        util.isFunction(callback) && callback.call(self, err);
-      });
+      callSetter(self, 'setPeriod', period, callback);
     }
   };
 
@@ -140,9 +150,7 @@ function pwmPinOpen(configuration, callback) {
     }
 
     if (this._validateFrequency(frequency)) {
-      _binding.setPeriod(1.0 / frequency, function(err) {
-        util.isFunction(callback) && callback.call(self, err);
-      });
+      callSetter(self, 'setPeriod', 1.0 / frequency, callback);
     }
   };
 
@@ -165,9 +173,7 @@ function pwmPinOpen(configuration, callback) {
 
     // Check arguments.
     if (this._validateDutyCycle(dutyCycle)) {
-      _binding.setDutyCycle(dutyCycle, function(err) {
-        util.isFunction(callback) && callback.call(self, err);
-      });
+      callSetter(self, 'setDutyCycle', dutyCycle, callback);
     }
   };
 
@@ -194,9 +200,7 @@ function pwmPinOpen(configuration, callback) {
       throw new TypeError('enable is of type ' + typeof(enable));
     }
 
-    _binding.setEnable(!!enable, function(err) {
-      util.isFunction(callback) && callback.call(self, err);
-    });
+    callSetter(self, 'setEnable', !!enable, callback);
   };
 
   PwmPin.prototype.setEnableSync = function(enable) {
@@ -212,6 +216,93 @@ function pwmPinOpen(configuration, callback) {
     _binding.setEnable(!!enable);
   };
 
+  // Returns the settings of `options` for binding.update().
+  PwmPin.prototype._validateUpdate = function(options) {
+    if (!util.isObject(options)) {
+      throw new TypeError('Bad arguments - options should be Object');
+    }
+
+    var config = {};
+    if (!util.isUndefined(options.period)) {
+      this._validatePeriod(options.period);
+      config.period = options.period;
+    } else if (!util.isUndefined(options.frequency)) {
+      this._validateFrequency(options.frequency);
+      config.period = 1.0 / options.frequency;
+    }
+    if (!util.isUndefined(options.dutyCycle)) {
+      this._validateDutyCycle(options.dutyCycle);
+      config.dutyCycle = options.dutyCycle;
+    }
+    if (!util.isUndefined(options.enable)) {
+      if (!util.isNumber(options.enable) && !util.isBoolean(options.enable)) {
+        throw new TypeError('enable is of type ' + typeof(options.enable));
+      }
+      config.enable = !!options.enable;
+    }
+    return config;
+  };
+
+  PwmPin.prototype.update = function(options, callback) {
+    var self = this;
+
+    if (_binding === null) {
+      throw new Error('Pwm pin is not opened');
+    }
+
+    callSetter(self, 'update', this._validateUpdate(options), callback);
+  };
+
+  PwmPin.prototype.updateSync = function(options) {
+    if (_binding === null) {
+      throw new Error('Pwm pin is not opened');
+    }
+
+    _binding.update(this._validateUpdate(options));
+  };
+
+  PwmPin.prototype.playSequence = function(dutyCycles, options, callback) {
+    var self = this;
+
+    if (_binding === null) {
+      throw new Error('Pwm pin is not opened');
+    }
+
+    if (util.isFunction(options)) {
+      callback = options;
+      options = undefined;
+    }
+    options = options || {};
+
+    if (!util.isArray(dutyCycles) || dutyCycles.length == 0) {
+      throw new TypeError('Bad arguments - dutyCycles should be an Array');
+    }
+    for (var i = 0; i < dutyCycles.length; ++i) {
+      this._validateDutyCycle(dutyCycles[i]);
+    }
+
+    var interval = options.interval;
+    if (util.isUndefined(interval) && util.isNumber(options.frequency)) {
+      interval = 1000 / options.frequency;
+    }
+    if (!util.isNumber(interval) || interval < 0.001 || interval > 1000) {
+      throw new RangeError('interval must be between 0.001 and 1000 ms');
+    }
+
+    _binding.playSequence(dutyCycles, Math.round(interval * 1000),
+                          !!options.loop, function(err) {
+      util.isFunction(callback) && callback.call(self, err);
+    });
+  };
+
+  PwmPin.prototype.stopSequence = function() {
+    if (_binding === null) {
+      throw new Error('Pwm pin is not opened');
+    }
+
+    _binding.stopSequence();
+  };
+
   PwmPin.prototype.close = function(callback) {
     var self = this;
 
@@ -0,0 +1,111 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var util = require('util');
+var httpparser = process.binding(process.binding.httpparser);
+
+
+// Node.js limits the keys in the same way.
+var DEFAULT_MAX_KEYS = 1000;
+
+
+function unescape(str) {
+  try {
+    return decodeURIComponent(str);
+  } catch (e) {
+    return str;
+  }
+}
+
+
+function escape(str) {
+  return encodeURIComponent(str);
+}
+
+
+// The pairs are split and decoded natively, and only the object of them is
+// made here.
+function parse(str, sep, eq, options) {
+  var obj = Object.create(null);
+  if (!util.isString(str) || str.length === 0) {
+    return obj;
+  }
+
+  var maxKeys = DEFAULT_MAX_KEYS;
+  if (options && util.isNumber(options.maxKeys)) {
+    maxKeys = options.maxKeys > 0 ? options.maxKeys : 0;
+  }
+
+  var pairs = httpparser.parseQuery(str, sep || '&', eq || '=', maxKeys);
+  for (var i = 0; i < pairs.length; i += 2) {
+    var key = pairs[i];
+    var value = pairs[i + 1];
+    var current = obj[key];
+    if (current === undefined) {
+      obj[key] = value;
+    } else if (util.isArray(current)) {
+      current.push(value);
+    } else {
+      obj[key] = [current, value];
+    }
+  }
+  return obj;
+}
+
+
+function stringifyPrimitive(value) {
+  if (util.isString(value)) {
+    return value;
+  }
+  if (util.isBoolean(value)) {
+    return value ? 'true' : 'false';
+  }
+  if (util.isNumber(value) && isFinite(value)) {
+    return '' + value;
+  }
+  return '';
+}
+
+
+function stringify(obj, sep, eq) {
+  sep = sep || '&';
+  eq = eq || '=';
+  if (!util.isObject(obj)) {
+    return '';
+  }
+
+  var fields = [];
+  var keys = Object.keys(obj);
+  for (var i = 0; i < keys.length; i++) {
+    var key = escape(stringifyPrimitive(keys[i])) + eq;
+    var value = obj[keys[i]];
+    if (util.isArray(value)) {
+      for (var j = 0; j < value.length; j++) {
+        fields.push(key + escape(stringifyPrimitive(value[j])));
+      }
+    } else {
+      fields.push(key + escape(stringifyPrimitive(value)));
+    }
+  }
+  return fields.join(sep);
+}
+
+
+exports.parse = parse;
+exports.decode = parse;
+exports.stringify = stringify;
+exports.encode = stringify;
+exports.escape = escape;
+exports.unescape = unescape;
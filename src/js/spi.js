@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+var stream = require('stream');
 var util = require('util');
 var spi = process.binding(process.binding.spi);
 
@@ -195,6 +196,14 @@ function spiBusOpen(configuration, callback) {
     }
   };
 
+  SpiBus.prototype.createReadStream = function(options) {
+    if (_binding === null) {
+      throw new Error('SPI bus is not opened');
+    }
+
+    return new SpiStream(_binding, options);
+  };
+
   SpiBus.prototype.close = function(callback) {
     var self = this;
 
@@ -221,4 +230,72 @@ function spiBusOpen(configuration, callback) {
 }
 
 
+var defaultStreamFrames = 64;
+
+
+// Transfers one frame over and over on a thread of its own, and emits the
+// received frames as Buffers of `frames` frames each. The native side has two
+// such chunks; it stops while this stream is paused and both are waiting.
+function SpiStream(binding, options) {
+  options = options || {};
+
+  var frame = options.frame;
+  if (util.isArray(frame)) {
+    frame = new Buffer(frame);
+  } else if (!util.isBuffer(frame)) {
+    throw new TypeError('Bad arguments - frame should be Array or Buffer');
+  }
+
+  var frames = options.frames === undefined ? defaultStreamFrames
+                                            : options.frames;
+  if (!util.isNumber(frames) || frames < 1) {
+    throw new TypeError('Bad arguments - frames should be a positive Number');
+  }
+
+  stream.Readable.call(this, options);
+
+  var self = this;
+
+  this._binding = binding;
+  binding.onData = function(err, data) {
+    if (err) {
+      self.close();
+      self.emit('error', err);
+      return true;
+    }
+
+    self.push(data);
+    return !self.isPaused();
+  };
+  binding.streamStart(frame, Math.floor(frames));
+}
+
+util.inherits(SpiStream, stream.Readable);
+
+
+SpiStream.prototype.resume = function() {
+  stream.Readable.prototype.resume.call(this);
+  if (this._binding) {
+    this._binding.streamResume();
+  }
+  return this;
+};
+
+
+SpiStream.prototype.close = function() {
+  if (!this._binding) {
+    return;
+  }
+
+  this._binding.streamStop();
+  this._binding.onData = null;
+  this._binding = null;
+  this.push(null);
+  this.emit('close');
+};
+
+
+SpiStream.prototype.destroy = SpiStream.prototype.close;
+
+
 module.exports = Spi;
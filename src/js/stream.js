@@ -31,3 +31,5 @@ exports.Stream = Stream;
 exports.Readable = require('stream_readable');
 exports.Writable = require('stream_writable');
 exports.Duplex = require('stream_duplex');
+exports.Transform = require('stream_transform');
+exports.Splitter = require('stream_splitter');
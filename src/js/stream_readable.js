@@ -22,10 +22,16 @@ var assert = require('assert');
 function ReadableState(options) {
   options = options || {};
 
-  // the internal array of buffers.
+  // the internal queue of buffers, read from `head`.
   this.buffer = [];
 
-  // the sum of length of buffers.
+  // the index of the first buffer not read through.
+  this.head = 0;
+
+  // the bytes already read of the first buffer.
+  this.offset = 0;
+
+  // the sum of length of buffers, less the bytes read.
   this.length = 0;
 
   this.defaultEncoding = options.defaultEncoding || 'utf8';
@@ -114,6 +120,33 @@ Readable.prototype.resume = function() {
 };
 
 
+// Writes the data of this stream to `destination`, pausing while the
+// destination has more buffered than its high water mark.
+Readable.prototype.pipe = function(destination, options) {
+  var source = this;
+
+  source.on('data', function(chunk) {
+    if (destination.write(chunk) === false) {
+      source.pause();
+    }
+  });
+
+  destination.on('drain', function() {
+    source.resume();
+  });
+
+  if (!options || options.end !== false) {
+    source.on('end', function() {
+      destination.end();
+    });
+  }
+
+  destination.emit('pipe', source);
+
+  return destination;
+};
+
+
 Readable.prototype.error = function(error) {
   this.emit('error', error);
 };
@@ -145,28 +178,68 @@ Readable.prototype.push = function(chunk, encoding) {
 };
 
 
+// Reads `n` bytes, or all of them, out of the queue. Bytes within a chunk are
+// handed out as the chunk or a slice of it, without a copy; only the reads
+// spanning chunks are copied into a new buffer.
 function readBuffer(stream, n) {
   var state = stream._readableState;
-  var res;
 
-  if (n == 0 || util.isNullOrUndefined(n)) {
+  if (n == 0 || util.isNullOrUndefined(n) || n > state.length) {
     n = state.length;
   }
 
-  if (state.buffer.length === 0 || state.length === 0) {
-    res = null;
-  } else if (n >= state.length) {
-    res = Buffer.concat(state.buffer);
-    state.buffer = [];
-    state.length = 0;
+  if (state.length === 0) {
+    return null;
+  }
+
+  var chunk = state.buffer[state.head];
+  var res;
+
+  if (n <= chunk.length - state.offset) {
+    res = n == chunk.length ? chunk
+                            : chunk.slice(state.offset, state.offset + n);
+    state.offset += n;
+    if (state.offset == chunk.length) {
+      shiftBuffer(state);
+    }
   } else {
-    throw new Error('not implemented');
+    res = new Buffer(n);
+    var pos = 0;
+    while (pos < n) {
+      chunk = state.buffer[state.head];
+      var end = Math.min(chunk.length, state.offset + n - pos);
+      chunk.copy(res, pos, state.offset, end);
+      pos += end - state.offset;
+      if (end == chunk.length) {
+        shiftBuffer(state);
+      } else {
+        state.offset = end;
+      }
+    }
   }
 
+  state.length -= n;
   return res;
 };
 
 
+// Drops the first chunk of the queue, which has been read through.
+function shiftBuffer(state) {
+  state.buffer[state.head++] = undefined;
+  state.offset = 0;
+
+  if (state.head == state.buffer.length) {
+    state.buffer = [];
+    state.head = 0;
+  } else if (state.head >= 16 && state.head * 2 >= state.buffer.length) {
+    // The read chunks are dropped once they are half of the queue, so that
+    // each chunk is moved once on average.
+    state.buffer = state.buffer.slice(state.head);
+    state.head = 0;
+  }
+};
+
+
 function emitEnd(stream) {
   var state = stream._readableState;
 
@@ -0,0 +1,134 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var util = require('util');
+var Transform = require('stream_transform');
+
+
+// A transform stream giving out the frames of the written data which are
+// ended by `options.delimiter`, a string, a byte or a Buffer, '\n' by default.
+// The frames are views of the written chunks, without the delimiter; only the
+// bytes of a frame spanning chunks are copied. A frame growing beyond
+// `options.maxLength` bytes without a delimiter is given out as it is.
+function Splitter(options) {
+  if (!(this instanceof Splitter)) {
+    return new Splitter(options);
+  }
+
+  Transform.call(this, options);
+
+  var delimiter = options && options.delimiter;
+  if (util.isUndefined(delimiter)) {
+    delimiter = '\n';
+  }
+  if (util.isNumber(delimiter)) {
+    delimiter = new Buffer([delimiter]);
+  } else if (util.isString(delimiter)) {
+    delimiter = new Buffer(delimiter);
+  }
+  if (!util.isBuffer(delimiter) || delimiter.length == 0) {
+    throw new TypeError('Bad arguments: delimiter must be a non-empty ' +
+                        'string, a byte or a Buffer');
+  }
+
+  var maxLength = options && options.maxLength;
+  if (!util.isUndefined(maxLength) &&
+      !(util.isNumber(maxLength) && maxLength >= 1)) {
+    throw new TypeError('Bad arguments: maxLength must be a positive number');
+  }
+
+  this._delimiter = delimiter;
+  this._maxLength = maxLength;
+  // The start of a frame which was written without its delimiter.
+  this._partial = null;
+}
+
+util.inherits(Splitter, Transform);
+
+
+Splitter.prototype._transform = function(chunk, callback) {
+  var delimiter = this._delimiter;
+  var start = 0;
+
+  if (this._partial) {
+    // Only the frame spanning the chunks is copied.
+    var partial = this._partial;
+    var end = spanningDelimiterEnd(partial, chunk, delimiter);
+    if (end == -1) {
+      this._partial = null;
+      keepPartial(this, Buffer.concat([partial, chunk]));
+      callback();
+      return;
+    }
+
+    var frameEnd = end - delimiter.length;
+    this._partial = null;
+    this.push(frameEnd >= 0 ?
+              Buffer.concat([partial, chunk.slice(0, frameEnd)]) :
+              partial.slice(0, partial.length + frameEnd));
+    start = end;
+  }
+
+  var frames = chunk._split(delimiter, start);
+  for (var i = 0; i < frames.length; i++) {
+    this.push(frames[i]);
+    start += frames[i].length + delimiter.length;
+  }
+
+  if (start < chunk.length) {
+    keepPartial(this, chunk.slice(start));
+  }
+
+  callback();
+};
+
+
+// The end in `chunk` of the first delimiter after `partial`, which may start
+// in `partial`, or -1.
+function spanningDelimiterEnd(partial, chunk, delimiter) {
+  var overlap = delimiter.length - 1;
+  if (overlap > 0) {
+    var tail = partial.slice(Math.max(partial.length - overlap, 0));
+    var joint = Buffer.concat([tail, chunk.slice(0, overlap)]);
+    var index = joint.indexOf(delimiter);
+    if (index != -1) {
+      return index + delimiter.length - tail.length;
+    }
+  }
+
+  var found = chunk.indexOf(delimiter);
+  return found == -1 ? -1 : found + delimiter.length;
+}
+
+
+function keepPartial(splitter, partial) {
+  if (splitter._maxLength && partial.length >= splitter._maxLength) {
+    splitter.push(partial);
+  } else {
+    splitter._partial = partial;
+  }
+}
+
+
+// The bytes after the last delimiter are the last frame.
+Splitter.prototype._flush = function(callback) {
+  var partial = this._partial;
+  this._partial = null;
+  callback(null, partial);
+};
+
+
+module.exports = Splitter;
@@ -0,0 +1,96 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var util = require('util');
+var Duplex = require('stream_duplex');
+
+
+// A duplex stream whose readable side gives out what `_transform(chunk,
+// callback)` makes of each chunk written to it. `callback(err, data)` pushes
+// `data` if it is given, and `_flush(callback)` may push the rest once the
+// writable side has ended.
+function Transform(options) {
+  if (!(this instanceof Transform)) {
+    return new Transform(options);
+  }
+
+  Duplex.call(this, options);
+
+  if (options) {
+    if (util.isFunction(options.transform)) {
+      this._transform = options.transform;
+    }
+    if (util.isFunction(options.flush)) {
+      this._flush = options.flush;
+    }
+  }
+
+  // The chunks are transformed as they are written.
+  this._readyToWrite();
+}
+
+util.inherits(Transform, Duplex);
+
+
+// The end of the writable side is the end of the data, not a marker in it.
+Transform.prototype._markEof = false;
+
+
+Transform.prototype._transform = function(chunk, callback) {
+  throw new Error('not implemented');
+};
+
+
+Transform.prototype._write = function(chunk, callback, onwrite) {
+  var self = this;
+
+  this._transform(chunk, function(err, data) {
+    afterTransform(self, err, data);
+    if (util.isFunction(callback)) {
+      callback.call(self, err);
+    }
+    onwrite();
+  });
+};
+
+
+Transform.prototype._final = function(callback) {
+  var self = this;
+
+  function done(err, data) {
+    afterTransform(self, err, data);
+    self.push(null);
+    callback();
+  }
+
+  if (util.isFunction(this._flush)) {
+    this._flush(done);
+  } else {
+    done();
+  }
+};
+
+
+function afterTransform(stream, err, data) {
+  if (err) {
+    stream.error(err);
+  } else if (!util.isNullOrUndefined(data)) {
+    stream.push(data);
+  }
+}
+
+
+module.exports = Transform;
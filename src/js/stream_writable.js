@@ -21,6 +21,11 @@ var Duplex = stream.Duplex;
 
 var defaultHighWaterMark = 128;
 
+// Chunks smaller than this are held back until the next tick if the stream
+// implements `_writev()`, so that the small writes of a tick go down together.
+// Once this many bytes are held back, they are written at once.
+var defaultCoalesceSize = 512;
+
 
 function WriteReq(chunk, callback) {
   this.chunk = chunk;
@@ -49,6 +54,17 @@ function WritableState(options) {
   // the length of message being writing.
   this.writingLength = 0;
 
+  // chunks smaller than this are coalesced.
+  this.coalesceSize = (options && util.isNumber(options.coalesceSize)) ?
+    options.coalesceSize : defaultCoalesceSize;
+
+  // `true` if a flush of coalesced chunks is scheduled for the next tick.
+  this.flushScheduled = false;
+
+  // number of `cork()` calls not yet undone by `uncork()`. Writes are buffered
+  // while the stream is corked.
+  this.corked = 0;
+
   // turn 'true' when some messages are buffered. After buffered messages are
   // all sent, 'drain' event will be emitted.
   this.needDrain = false;
@@ -56,6 +72,9 @@ function WritableState(options) {
   // become `true` when `end()` called.
   this.ending = false;
 
+  // become `true` when the stream's `_final()` is called.
+  this.finishing = false;
+
   // become `true` when there are no date to write.
   this.ended = false;
 }
@@ -111,7 +130,7 @@ Writable.prototype.end = function(chunk, callback) {
   var state = this._writableState;
 
   // Because NuttX cannot poll 'EOF',so forcely raise EOF event.
-  if (process.platform === 'nuttx') {
+  if (process.platform === 'nuttx' && this._markEof !== false) {
     if (!state.ending) {
       if (util.isNullOrUndefined(chunk)) {
         chunk = '\\e\\n\\d';
@@ -131,6 +150,25 @@ Writable.prototype.end = function(chunk, callback) {
 };
 
 
+// Buffer the following writes until `uncork()`, so that a stream implementing
+// `_writev()` writes them down at once.
+Writable.prototype.cork = function() {
+  this._writableState.corked++;
+};
+
+
+Writable.prototype.uncork = function() {
+  var state = this._writableState;
+
+  if (state.corked > 0) {
+    state.corked--;
+    if (state.corked == 0 && state.ready && state.buffer.length > 0) {
+      writeBuffered(this);
+    }
+  }
+};
+
+
 // When stream is ready to write, concrete stream implementation should call
 // this method to inform it.
 Writable.prototype._readyToWrite = function() {
@@ -173,10 +211,25 @@ function writeOrBuffer(stream, chunk, callback) {
 
   state.length += chunk.length;
 
-  if (!state.ready || state.writing || state.buffer.length > 0) {
+  if (!state.ready || state.writing || state.corked > 0 ||
+      state.buffer.length > 0) {
     // stream not yet ready or there is pending request to write.
     // push this request into write queue.
     state.buffer.push(new WriteReq(chunk, callback));
+
+    if (state.flushScheduled && state.ready && !state.writing &&
+        state.corked == 0 && state.length >= state.coalesceSize) {
+      // enough data is held back to write it now.
+      writeBuffered(stream);
+    }
+  } else if (chunk.length < state.coalesceSize &&
+             util.isFunction(stream._writev)) {
+    // a small chunk waits for the other writes of this tick.
+    state.buffer.push(new WriteReq(chunk, callback));
+    if (!state.flushScheduled) {
+      state.flushScheduled = true;
+      process.nextTick(flushCoalesced, stream);
+    }
   } else {
     // here means there is no pending data. write out.
     doWrite(stream, chunk, callback);
@@ -196,6 +249,12 @@ function writeBuffered(stream) {
   if (!state.writing) {
     if (state.buffer.length == 0) {
       onEmptyBuffer(stream);
+    } else if (state.corked > 0) {
+      // `uncork()` writes the buffered messages.
+    } else if (state.buffer.length > 1 && util.isFunction(stream._writev)) {
+      var reqs = state.buffer;
+      state.buffer = [];
+      doWritev(stream, reqs);
     } else {
       var req = state.buffer.shift();
       doWrite(stream, req.chunk, req.callback);
@@ -220,6 +279,43 @@ function doWrite(stream, chunk, callback) {
 }
 
 
+// Write down the chunks held back in the last tick.
+function flushCoalesced(stream) {
+  var state = stream._writableState;
+
+  state.flushScheduled = false;
+
+  if (!state.writing && state.buffer.length > 0) {
+    writeBuffered(stream);
+  }
+}
+
+
+// Write down the chunks of buffered requests by a single call of the concrete
+// stream's `_writev(chunks, callback, onwrite)`.
+function doWritev(stream, reqs) {
+  var state = stream._writableState;
+
+  var chunks = new Array(reqs.length);
+  var length = 0;
+  for (var i = 0; i < reqs.length; ++i) {
+    chunks[i] = reqs[i].chunk;
+    length += chunks[i].length;
+  }
+
+  state.writing = true;
+  state.writingLength = length;
+
+  stream._writev(chunks, function(status) {
+    for (var i = 0; i < reqs.length; ++i) {
+      if (util.isFunction(reqs[i].callback)) {
+        reqs[i].callback.call(stream, status);
+      }
+    }
+  }, stream._onwrite.bind(stream));
+}
+
+
 // No more data to write. if this stream is being finishing, emit 'finish'.
 function onEmptyBuffer(stream) {
   var state = stream._writableState;
@@ -257,10 +353,22 @@ function emitDrain(stream) {
 }
 
 
-// Emit 'finish' event to notify this stream is finished.
+// Emit 'finish' event to notify this stream is finished. A concrete stream
+// whose writes complete after it has taken them defines `_final(callback)`,
+// and the stream is finished once it calls back.
 function emitFinish(stream) {
   var state = stream._writableState;
-  if (!state.ended) {
+  if (state.ended || state.finishing) {
+    return;
+  }
+
+  if (util.isFunction(stream._final)) {
+    state.finishing = true;
+    stream._final(function() {
+      state.ended = true;
+      stream.emit('finish');
+    });
+  } else {
     state.ended = true;
     stream.emit('finish');
   }
@@ -20,50 +20,172 @@ var util = require('util');
 var TIMEOUT_MAX = 2147483647; // 2^31-1
 
 
+// Timeouts of the same duration share one native timer. They are linked in a
+// list in the order they expire, which is the order they were added in, and
+// the timer is set for the first one, with its slack.
+var lists = {};
+
+// Milliseconds a timeout may run late, so that libtuv can run the timeouts
+// expiring close to each other in one wakeup.
+var defaultSlack = Timer.defaultSlack;
+
+
 function Timeout(after) {
   this.after = after;
   this.isrepeat = false;
   this.callback = null;
-  this.handler = null;
+  this.start = 0;
+  this.slack = defaultSlack;
+  this.list = null;
+  this.prev = null;
+  this.next = null;
+}
+
+
+function TimerList(after) {
+  this.after = after;
+  this.head = null;
+  this.tail = null;
+  this.handler = new Timer();
+  this.handler.timerList = this;
 }
 
 
 Timer.prototype.handleTimeout = function() {
-  var timeout = this.timeoutObj; // 'this' is Timer object
-  if (timeout && timeout.callback) {
-    timeout.callback();
-    if (!timeout.isrepeat) {
-      timeout.unref();
-    }
+  var list = this.timerList; // 'this' is Timer object
+  if (list) {
+    listOnTimeout(list);
   }
 };
 
 
-Timeout.prototype.ref = function() {
-  var repeat = 0;
-  var handler = new Timer();
+// Runs the expired timeouts of `list`, and sets the timer for the next one.
+function listOnTimeout(list) {
+  var now = Timer.now();
+  var timeout;
 
-  if (this.isrepeat) {
-    repeat = this.after;
+  while ((timeout = list.head)) {
+    var remaining = timeout.start + list.after - now;
+    if (remaining > 0) {
+      list.handler.start(remaining, 0, timeout.slack);
+      return;
+    }
 
+    var callback = timeout.callback;
+    unlink(list, timeout);
+    if (timeout.isrepeat) {
+      timeout.start = now;
+      append(list, timeout);
+    } else {
+      timeout.callback = undefined;
+    }
+
+    if (callback) {
+      var threw = true;
+      try {
+        callback();
+        threw = false;
+      } finally {
+        // The rest of the list runs in the next turn.
+        if (threw && list.handler) {
+          list.handler.start(1, 0);
+        }
+      }
+    }
+  }
+
+  closeList(list);
+}
+
+
+function append(list, timeout) {
+  timeout.list = list;
+  timeout.prev = list.tail;
+  timeout.next = null;
+  if (list.tail) {
+    list.tail.next = timeout;
+  } else {
+    list.head = timeout;
   }
+  list.tail = timeout;
+}
 
-  handler.timeoutObj = this;
-  this.handler = handler;
 
-  handler.start(this.after, repeat);
+function unlink(list, timeout) {
+  if (timeout.prev) {
+    timeout.prev.next = timeout.next;
+  } else {
+    list.head = timeout.next;
+  }
+  if (timeout.next) {
+    timeout.next.prev = timeout.prev;
+  } else {
+    list.tail = timeout.prev;
+  }
+  timeout.list = null;
+  timeout.prev = null;
+  timeout.next = null;
+}
+
+
+function closeList(list) {
+  if (list.handler) {
+    list.handler.timerList = undefined;
+    list.handler.stop();
+    list.handler = null;
+  }
+  if (lists[list.after] === list) {
+    delete lists[list.after];
+  }
+}
+
+
+Timeout.prototype.ref = function() {
+  var list = lists[this.after];
+
+  this.start = Timer.now();
+
+  if (!list) {
+    list = lists[this.after] = new TimerList(this.after);
+    list.handler.start(this.after, 0, this.slack);
+  }
+
+  append(list, this);
 };
 
 
 Timeout.prototype.unref = function() {
   this.callback = undefined;
-  if (this.handler) {
-    this.handler.timeoutObj = undefined;
-    this.handler.stop();
-    this.handler = undefined;
+
+  var list = this.list;
+  if (list) {
+    unlink(list, this);
+    if (!list.head) {
+      closeList(list);
+    }
+  }
+};
+
+// Lets the timeout run up to `slack` milliseconds late.
+Timeout.prototype.setSlack = function(slack) {
+  slack *= 1;
+  if (!(slack > 0)) {
+    slack = 0;
+  } else if (slack > TIMEOUT_MAX) {
+    slack = TIMEOUT_MAX;
+  }
+  this.slack = slack;
+
+  var list = this.list;
+  if (list && list.head === this) {
+    var remaining = this.start + list.after - Timer.now();
+    list.handler.start(Math.max(remaining, 0), 0, slack);
   }
+
+  return this;
 };
 
+
 function timeoutConfigurator(isrepeat, callback, delay) {
   if (!util.isFunction(callback)) {
     throw new TypeError('Bad arguments: callback must be a Function');
@@ -80,8 +202,10 @@ function timeoutConfigurator(isrepeat, callback, delay) {
   if (arguments.length <= 3) {
     timeout.callback = callback;
   } else {
-    var args = Array.prototype.slice.call(arguments, 3);
-    args.splice(0, 0, timeout);
+    var args = [timeout];
+    for (var i = 3; i < arguments.length; i++) {
+      args.push(arguments[i]);
+    }
     timeout.callback = callback.bind.apply(callback, args);
   }
   timeout.isrepeat = isrepeat;
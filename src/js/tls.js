@@ -0,0 +1,416 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var net = require('net');
+var stream = require('stream');
+var util = require('util');
+var fs = require('fs');
+
+var TCP = process.binding(process.binding.tcp);
+var tlsBuiltin = process.binding(process.binding.tls);
+var TLS = tlsBuiltin.TLS;
+
+
+// Authentication modes of a secure context.
+var VERIFY_OPTIONAL = 1;
+
+// Lifetime of the session tickets of a server, in seconds.
+var defaultSessionTimeout = 300;
+
+// Trusted certificates for the clients that name none, loaded once.
+var defaultCAFile = '/etc/ssl/certs/ca-certificates.crt';
+var defaultCA;
+var defaultClientContext = null;
+
+
+// A TLS object stands as the handle of a TLSSocket. It encrypts what the
+// socket writes and decrypts what the tcp object under it reads; the rest
+// goes to the tcp object.
+['connect', 'ref', 'unref', 'setNoDelay', 'setKeepAlive', 'setBufferSize',
+ 'setFastOpen', 'getsockname'].forEach(function(name) {
+  TLS.prototype[name] = function() {
+    return this._tcp[name].apply(this._tcp, arguments);
+  };
+});
+
+
+TLS.prototype.close = function() {
+  var self = this;
+  self.destroy();
+  self._tcp.onclose = function() {
+    if (util.isFunction(self.onclose)) {
+      self.onclose();
+    }
+  };
+  self._tcp.close();
+};
+
+
+// The peer learns by close_notify that the data ends here, and not by an
+// attack on the connection.
+TLS.prototype.shutdown = function(callback) {
+  this.closeNotify();
+  return this._tcp.shutdown(callback);
+};
+
+
+function createTCP() {
+  var tcp = new TCP();
+  tcp.writeQueueSize = 0;
+  return tcp;
+}
+
+
+function createHandle(tcp, context) {
+  var handle = new TLS(tcp, context._context);
+  handle._tcp = tcp;
+  handle._secureContext = context;
+  handle.writeQueueSize = 0;
+
+  // The data read goes to the TLS object, the end of it comes here.
+  tcp.owner = handle;
+  tcp.onread = onTCPRead;
+
+  return handle;
+}
+
+
+function onTCPRead(handle, nread, isEOF) {
+  handle.readEnd(nread);
+}
+
+
+function checkError(err) {
+  if (err) {
+    throw new Error(tlsBuiltin.errorString(err));
+  }
+}
+
+
+// A certificate or a key is given as PEM text, a Buffer, or the path of a
+// file holding it.
+function toBuffer(data) {
+  if (util.isBuffer(data)) {
+    return data;
+  }
+  if (util.isString(data) && data.indexOf('-----BEGIN') >= 0) {
+    return new Buffer(data);
+  }
+  return fs.readFileSync(data);
+}
+
+
+function loadDefaultCA() {
+  if (defaultCA === undefined) {
+    defaultCA = fs.existsSync(defaultCAFile) ?
+                fs.readFileSync(defaultCAFile) : null;
+  }
+  return defaultCA;
+}
+
+
+// The certificates, the key and the settings shared by connections. The
+// certificates are parsed once here, not for every connection.
+function SecureContext(options, isServer) {
+  options = options || {};
+
+  var context = new tlsBuiltin.SecureContext(!!isServer);
+  this._context = context;
+
+  var ca = options.ca;
+  if (ca) {
+    ca = util.isArray(ca) ? ca : [ca];
+    for (var i = 0; i < ca.length; ++i) {
+      checkError(context.setCA(toBuffer(ca[i])));
+    }
+  } else if (!isServer && loadDefaultCA()) {
+    checkError(context.setCA(defaultCA));
+  }
+
+  if (options.cert || options.key) {
+    checkError(context.setCert(toBuffer(options.cert), toBuffer(options.key),
+                               options.passphrase));
+  }
+
+  if (isServer) {
+    // The certificate of a client is asked for and checked in JavaScript.
+    if (options.requestCert) {
+      context.setVerify(VERIFY_OPTIONAL);
+    }
+    // A server without tickets resumes no sessions.
+    var sessionTimeout = util.isNumber(options.sessionTimeout) ?
+                         options.sessionTimeout : defaultSessionTimeout;
+    context.enableTickets(sessionTimeout);
+  }
+}
+
+
+function createSecureContext(options, isServer) {
+  return new SecureContext(options, isServer);
+}
+
+
+// A net.Socket of which the data is encrypted. The socket writes once the
+// handshake is done, and buffers the writes until then.
+function TLSSocket(options) {
+  if (!(this instanceof TLSSocket)) {
+    return new TLSSocket(options);
+  }
+
+  options = options || {};
+
+  this.encrypted = true;
+  this.authorized = false;
+  this.authorizationError = null;
+
+  this._tlsOptions = options;
+  this._secureEstablished = false;
+  this._tlsServer = null;
+
+  var context = options.secureContext ||
+                createSecureContext(options, !!options.isServer);
+  var handle = createHandle(options.handle || createTCP(), context);
+  handle.onhandshake = onhandshake;
+
+  if (options.servername) {
+    checkError(handle.setServername(options.servername));
+  }
+  // A session not taken falls back to a full handshake.
+  if (options.session) {
+    handle.setSession(options.session);
+  }
+
+  net.Socket.call(this, {
+    handle: handle,
+    allowHalfOpen: options.allowHalfOpen,
+    maxBufferedBytes: options.maxBufferedBytes
+  });
+}
+
+
+util.inherits(TLSSocket, net.Socket);
+
+
+TLSSocket.prototype._readyToWrite = function() {
+  if (this._secureEstablished || this.errored) {
+    stream.Writable.prototype._readyToWrite.call(this);
+  }
+};
+
+
+// A TLS socket hands no data over natively.
+TLSSocket.prototype.pipe = function(destination, options) {
+  return stream.Readable.prototype.pipe.call(this, destination, options);
+};
+
+
+// The state of the session as a Buffer, for a later connection to the same
+// server to resume it by the `session` option.
+TLSSocket.prototype.getSession = function() {
+  return this._handle ? this._handle.getSession() : undefined;
+};
+
+
+TLSSocket.prototype.isSessionReused = function() {
+  return this._handle ? this._handle.isSessionReused() : false;
+};
+
+
+TLSSocket.prototype.getProtocol = function() {
+  return this._handle ? this._handle.getProtocol() : null;
+};
+
+
+TLSSocket.prototype.getCipher = function() {
+  var cipher = this._handle ? this._handle.getCipher() : null;
+  if (!cipher) {
+    return null;
+  }
+  return {name: cipher, version: this._handle.getProtocol()};
+};
+
+
+function emitError(socket, err) {
+  socket.errored = true;
+  stream.Duplex.prototype.end.call(socket, '', function() {
+    socket.destroy();
+  });
+  socket._readyToWrite();
+
+  // A client failing the handshake of a server does not bring it down.
+  if (socket._tlsServer) {
+    socket._tlsServer.emit('tlsClientError', err, socket);
+  } else {
+    socket.emit('error', err);
+  }
+}
+
+
+function onhandshake(socket, status) {
+  var options = socket._tlsOptions;
+  var handle = socket._handle;
+
+  if (status) {
+    emitError(socket, new Error('TLS handshake failed: ' +
+                                tlsBuiltin.errorString(status)));
+    return;
+  }
+
+  if (!options.isServer || options.requestCert) {
+    socket.authorizationError = handle.verifyError();
+    socket.authorized = socket.authorizationError === null;
+    if (!socket.authorized && options.rejectUnauthorized !== false) {
+      emitError(socket, new Error(socket.authorizationError));
+      return;
+    }
+  }
+
+  socket._secureEstablished = true;
+  stream.Writable.prototype._readyToWrite.call(socket);
+
+  socket.emit('secure');
+  if (!options.isServer) {
+    socket.emit('secureConnect');
+    var session = handle.getSession();
+    if (session) {
+      socket.emit('session', session);
+    }
+  }
+}
+
+
+function normalizeConnectArgs(args) {
+  var options = {};
+  var i = 0;
+
+  if (util.isObject(args[0])) {
+    options = args[i++];
+  } else {
+    var port = args[i++];
+    var host = util.isString(args[i]) ? args[i++] : undefined;
+    if (util.isObject(args[i]) && !util.isFunction(args[i])) {
+      var keys = Object.keys(args[i]);
+      for (var k = 0; k < keys.length; ++k) {
+        options[keys[k]] = args[i][keys[k]];
+      }
+      i++;
+    }
+    options.port = port;
+    if (host) {
+      options.host = host;
+    }
+  }
+
+  return [options, util.isFunction(args[i]) ? args[i] : undefined];
+}
+
+
+// tls.connect(options[, callback])
+// tls.connect(port[, host][, options][, callback])
+function connect() {
+  var args = normalizeConnectArgs(arguments);
+  var options = args[0];
+  var callback = args[1];
+
+  var host = options.host || 'localhost';
+
+  var context = options.secureContext;
+  if (!context) {
+    if (options.ca || options.cert || options.key) {
+      context = createSecureContext(options, false);
+    } else {
+      defaultClientContext = defaultClientContext ||
+                             createSecureContext({}, false);
+      context = defaultClientContext;
+    }
+  }
+
+  // The name of the server is sent to it, and its certificate is checked
+  // against the name.
+  var socket = new TLSSocket({
+    secureContext: context,
+    servername: options.servername || host,
+    session: options.session,
+    rejectUnauthorized: options.rejectUnauthorized,
+    allowHalfOpen: options.allowHalfOpen,
+    maxBufferedBytes: options.maxBufferedBytes
+  });
+
+  if (util.isFunction(callback)) {
+    socket.once('secureConnect', callback);
+  }
+
+  return socket.connect(options);
+}
+
+
+function Server(options, listener) {
+  if (!(this instanceof Server)) {
+    return new Server(options, listener);
+  }
+
+  if (util.isFunction(options)) {
+    listener = options;
+    options = {};
+  }
+  options = options || {};
+
+  net.Server.call(this, options);
+
+  this._tlsOptions = options;
+  this._secureContext = options.secureContext ||
+                        createSecureContext(options, true);
+
+  if (util.isFunction(listener)) {
+    this.on('secureConnection', listener);
+  }
+}
+
+
+util.inherits(Server, net.Server);
+
+
+Server.prototype._createSocket = function(handle, options) {
+  var server = this;
+
+  var socket = new TLSSocket({
+    handle: handle,
+    isServer: true,
+    secureContext: server._secureContext,
+    requestCert: server._tlsOptions.requestCert,
+    rejectUnauthorized: server._tlsOptions.rejectUnauthorized,
+    allowHalfOpen: options.allowHalfOpen,
+    maxBufferedBytes: options.maxBufferedBytes
+  });
+  socket._tlsServer = server;
+
+  socket.once('secure', function() {
+    server.emit('secureConnection', socket);
+  });
+
+  return socket;
+};
+
+
+exports.TLSSocket = TLSSocket;
+exports.Server = Server;
+exports.SecureContext = SecureContext;
+exports.connect = connect;
+exports.createSecureContext = createSecureContext;
+
+
+exports.createServer = function(options, listener) {
+  return new Server(options, listener);
+};
@@ -19,8 +19,13 @@ var uart = process.binding(process.binding.uart);
 
 // VALIDATION ARRAYS
 var BAUDRATE = [0, 50, 75, 110, 134, 150, 200, 300, 600, 1200, 1800, 2400
-                , 4800, 9600, 19200, 38400, 57600, 115200, 230400];
+                , 4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800
+                , 921600];
 var DATABITS = [5, 6, 7, 8];
+var FRAME_LENGTH_MAX = 65535;
+// Bytes waiting to be written to one side of a bridge before the other side
+// stops being read.
+var BRIDGE_HIGH_WATER_MARK = 4096;
 
 var defaultConfiguration = {
   baudRate: 9600,
@@ -39,8 +44,48 @@ Uart.prototype.open = function(configuration, callback) {
 };
 
 
+// Frames are emitted as Buffers, ended by the `delimiter` byte, after
+// `frameLength` bytes, or after `interByteTimeout` milliseconds without a
+// byte. The delimiter is not part of the frame.
+function validateFraming(configuration) {
+  var delimiter = configuration.delimiter;
+  if (util.isString(delimiter) && delimiter.length == 1) {
+    configuration.delimiter = delimiter = delimiter.charCodeAt(0);
+  }
+  if (!util.isUndefined(delimiter) &&
+      !(util.isNumber(delimiter) && delimiter >= 0 && delimiter <= 255 &&
+        delimiter % 1 == 0)) {
+    throw new TypeError("Invalid 'delimiter': " + delimiter);
+  }
+
+  var frameLength = configuration.frameLength;
+  if (!util.isUndefined(frameLength) &&
+      !(util.isNumber(frameLength) && frameLength >= 1 &&
+        frameLength <= FRAME_LENGTH_MAX && frameLength % 1 == 0)) {
+    throw new TypeError("Invalid 'frameLength': " + frameLength);
+  }
+  if (!util.isUndefined(delimiter) && !util.isUndefined(frameLength)) {
+    throw new TypeError("'delimiter' and 'frameLength' cannot be combined");
+  }
+
+  var timeout = configuration.interByteTimeout;
+  if (!util.isUndefined(timeout) &&
+      !(util.isNumber(timeout) && timeout >= 1 && timeout % 1 == 0)) {
+    throw new TypeError("Invalid 'interByteTimeout': " + timeout);
+  }
+}
+
+
+function validateData(data) {
+  if (!util.isString(data) && !util.isBuffer(data)) {
+    throw new TypeError('Bad arguments - data should be String or Buffer');
+  }
+}
+
+
 function uartPortOpen(configuration, callback) {
   var _binding = null;
+  var _bridgeDone = null;
 
   function UartPort(configuration, callback) { //constructor
     var self = this;
@@ -72,6 +117,8 @@ function uartPortOpen(configuration, callback) {
       configuration.dataBits = defaultConfiguration.dataBits;
     }
 
+    validateFraming(configuration);
+
     EventEmitter.call(this);
 
     _binding = new uart(configuration, this, function(err) {
@@ -95,6 +142,7 @@ function uartPortOpen(configuration, callback) {
     if (_binding === null) {
       throw new Error('UART port is not opened');
     }
+    validateData(buffer);
 
     _binding.write(buffer, function(err) {
       util.isFunction(callback) && callback.call(self, err);
@@ -107,16 +155,73 @@ function uartPortOpen(configuration, callback) {
     if (_binding === null) {
       throw new Error('UART port is not opened');
     }
+    validateData(buffer);
 
     _binding.write(buffer);
   };
 
+  // Connects the port to a connected net.Socket natively: the data read from
+  // either one is written to the other without going through JavaScript.
+  // The callback is called once the socket ends, fails or closes, or the
+  // port is closed.
+  UartPort.prototype.bridge = function(socket, callback) {
+    var self = this;
+
+    if (_binding === null) {
+      throw new Error('UART port is not opened');
+    }
+    if (!util.isObject(socket) || !socket._handle || !socket._socketState ||
+        !socket._socketState.connected) {
+      throw new TypeError('Bad arguments - socket should be a connected ' +
+                          'net.Socket');
+    }
+    if (!util.isFunction(_binding.bridge)) {
+      throw new Error('UART bridge is not supported');
+    }
+    if (_bridgeDone !== null) {
+      throw new Error('UART port is already bridged');
+    }
+
+    var err = _binding.bridge(socket._handle, BRIDGE_HIGH_WATER_MARK);
+    if (err) {
+      throw new Error('UART bridge error: ' + err);
+    }
+
+    function onEnd() {
+      finish(null);
+    }
+
+    function onError(err) {
+      finish(err);
+    }
+
+    function finish(err) {
+      if (_bridgeDone !== finish) {
+        return;
+      }
+      _bridgeDone = null;
+      socket.removeListener('end', onEnd);
+      socket.removeListener('close', onEnd);
+      socket.removeListener('error', onError);
+      if (_binding !== null) {
+        _binding.unbridge();
+      }
+      util.isFunction(callback) && callback.call(self, err);
+    }
+
+    _bridgeDone = finish;
+    socket.on('end', onEnd);
+    socket.on('close', onEnd);
+    socket.on('error', onError);
+  };
+
   UartPort.prototype.close = function(callback) {
     var self = this;
 
     if (_binding === null) {
       throw new Error('UART port is not opened');
     }
+    _bridgeDone && _bridgeDone(null);
 
     _binding.close(function(err) {
       util.isFunction(callback) && callback.call(self, err);
@@ -128,6 +233,7 @@ function uartPortOpen(configuration, callback) {
     if (_binding === null) {
       throw new Error('UART port is not opened');
     }
+    _bridgeDone && _bridgeDone(null);
 
     _binding.close();
     _binding = null;
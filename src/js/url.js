@@ -0,0 +1,187 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var util = require('util');
+var querystring = require('querystring');
+var httpparser = process.binding(process.binding.httpparser);
+
+
+// The parts given by httpparser.parseUrl(), in the order of http_parser.h.
+var SCHEMA = 0;
+var HOST = 1;
+var PORT = 2;
+var PATH = 3;
+var QUERY = 4;
+var FRAGMENT = 5;
+var USERINFO = 6;
+
+
+function Url() {
+  this.protocol = null;
+  this.slashes = null;
+  this.auth = null;
+  this.host = null;
+  this.port = null;
+  this.hostname = null;
+  this.hash = null;
+  this.search = null;
+  this.query = null;
+  this.pathname = null;
+  this.path = null;
+  this.href = null;
+}
+
+
+// Splits what the HTTP parser does not take, such as a relative path, at
+// the first '#' and the first '?' before it.
+function splitRelative(url) {
+  var parts = [];
+  var hash = url.indexOf('#');
+  if (hash >= 0) {
+    parts[FRAGMENT] = url.slice(hash + 1);
+    url = url.slice(0, hash);
+  }
+  var search = url.indexOf('?');
+  if (search >= 0) {
+    parts[QUERY] = url.slice(search + 1);
+    url = url.slice(0, search);
+  }
+  if (url.length > 0) {
+    parts[PATH] = url;
+  }
+  return parts;
+}
+
+
+Url.prototype.parse = function(url, parseQueryString) {
+  if (!util.isString(url)) {
+    throw new TypeError('Parameter "url" must be a string');
+  }
+
+  url = url.trim();
+  var parts = httpparser.parseUrl(url) || splitRelative(url);
+
+  var schema = parts[SCHEMA];
+  if (schema !== undefined) {
+    this.protocol = schema.toLowerCase() + ':';
+    this.slashes = true;
+  }
+  if (parts[USERINFO] !== undefined) {
+    this.auth = querystring.unescape(parts[USERINFO]);
+  }
+
+  var hostname = parts[HOST];
+  if (hostname !== undefined) {
+    this.hostname = hostname.toLowerCase();
+    // The brackets of an IPv6 address are left out by the parser.
+    this.host = this.hostname.indexOf(':') >= 0 ?
+                '[' + this.hostname + ']' : this.hostname;
+    if (parts[PORT] !== undefined) {
+      this.port = parts[PORT];
+      this.host += ':' + this.port;
+    }
+  }
+
+  if (parts[PATH] !== undefined) {
+    this.pathname = parts[PATH];
+  } else if (hostname !== undefined) {
+    this.pathname = '/';
+  }
+
+  var query = parts[QUERY];
+  if (query !== undefined) {
+    this.search = '?' + query;
+    this.query = parseQueryString ? querystring.parse(query) : query;
+  } else if (parseQueryString) {
+    this.query = Object.create(null);
+  }
+  if (parts[FRAGMENT] !== undefined) {
+    this.hash = '#' + parts[FRAGMENT];
+  }
+
+  if (this.pathname !== null || this.search) {
+    this.path = (this.pathname || '') + (this.search || '');
+  }
+  this.href = this.format();
+  return this;
+};
+
+
+Url.prototype.format = function() {
+  var auth = this.auth ? encodeURIComponent(this.auth).replace(/%3A/i, ':') +
+                         '@' : '';
+  var protocol = this.protocol || '';
+  if (protocol && protocol.charAt(protocol.length - 1) !== ':') {
+    protocol += ':';
+  }
+
+  var host = '';
+  if (this.host) {
+    host = auth + this.host;
+  } else if (this.hostname) {
+    host = auth + (this.hostname.indexOf(':') >= 0 ?
+                   '[' + this.hostname + ']' : this.hostname);
+    if (this.port) {
+      host += ':' + this.port;
+    }
+  }
+
+  var pathname = this.pathname || '';
+  if (this.slashes || host) {
+    host = '//' + host;
+    if (pathname && pathname.charAt(0) !== '/') {
+      pathname = '/' + pathname;
+    }
+  }
+
+  var search = this.search || '';
+  if (!search && util.isObject(this.query)) {
+    search = querystring.stringify(this.query);
+    search = search ? '?' + search : '';
+  } else if (search && search.charAt(0) !== '?') {
+    search = '?' + search;
+  }
+
+  var hash = this.hash || '';
+  if (hash && hash.charAt(0) !== '#') {
+    hash = '#' + hash;
+  }
+
+  return protocol + host + pathname + search + hash;
+};
+
+
+function parse(url, parseQueryString) {
+  if (url instanceof Url) {
+    return url;
+  }
+  return new Url().parse(url, parseQueryString);
+}
+
+
+function format(obj) {
+  if (util.isString(obj)) {
+    return parse(obj).format();
+  }
+  if (!(obj instanceof Url)) {
+    return Url.prototype.format.call(obj);
+  }
+  return obj.format();
+}
+
+
+exports.Url = Url;
+exports.parse = parse;
+exports.format = format;
@@ -74,83 +74,9 @@ function inherits(ctor, superCtor) {
 };
 
 
-function format(s) {
-  if (!isString(s)) {
-    var arrs = [];
-    for (var i = 0; i < arguments.length; ++i) {
-      arrs.push(formatValue(arguments[i]));
-    }
-    return arrs.join(' ');
-  }
-
-  var i = 1;
-  var args = arguments;
-  var arg_string;
-  var str = '';
-  var start = 0;
-  var end = 0;
-
-  while (end < s.length) {
-    if (s.charAt(end) !== '%') {
-      end++;
-      continue;
-    }
-
-    str += s.slice(start, end);
-
-    switch (s.charAt(end + 1)) {
-      case 's':
-        arg_string = String(args[i]);
-        break;
-      case 'd':
-        arg_string = Number(args[i]);
-        break;
-      case 'j':
-        try {
-          arg_string = JSON.stringify(args[i]);
-        } catch (_) {
-          arg_string = '[Circular]'
-        }
-        break;
-      case '%':
-        str += '%';
-        start = end = end + 2;
-        continue;
-      default:
-        str = str + '%' + s.charAt(end + 1);
-        start = end = end + 2;
-        continue;
-    }
-
-    if (i >= args.length) {
-      str = str + '%' + s.charAt(end + 1);
-    }
-    else {
-      i++;
-      str += arg_string;
-    }
-
-    start = end = end + 2;
-  }
-
-  str += s.slice(start, end);
-
-  while (i < args.length) {
-    str += ' ' + formatValue(args[i++]);
-  }
-
-  return str;
-}
-
-function formatValue(v) {
-  if (v === undefined) {
-    return 'undefined';
-  } else if (v === null) {
-    return 'null';
-  } else {
-    return v.toString();
-  }
-}
+// Formats in native code, into one buffer, rather than with concatenations
+// of intermediate strings.
+var format = process.binding(process.binding.console).format;
 
 
 function stringToNumber(value, default_value) {
@@ -0,0 +1,664 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var EventEmitter = require('events').EventEmitter;
+var http = require('http');
+var findHeader = require('http_server').findHeader;
+var net = require('net');
+var url = require('url');
+var util = require('util');
+var websocketBuiltin = process.binding(process.binding.websocket);
+
+
+// The GUID of RFC 6455 the key of a handshake is accepted with.
+var GUID = '258EAFA5-E914-47DA-95CA-C5AB0DC85B11';
+
+var OPCODE_CONTINUATION = 0;
+var OPCODE_TEXT = 1;
+var OPCODE_BINARY = 2;
+var OPCODE_CLOSE = 8;
+var OPCODE_PING = 9;
+var OPCODE_PONG = 10;
+
+var MAX_CONTROL_PAYLOAD = 125;
+
+// The status codes of closing, of which 1005 and 1006 are never sent.
+var CLOSE_NORMAL = 1000;
+var CLOSE_GOING_AWAY = 1001;
+var CLOSE_NO_STATUS = 1005;
+var CLOSE_ABNORMAL = 1006;
+
+// How long a connection waits for the close frame of the peer.
+var closeTimeout = 30 * 1000;
+
+// The largest response to the handshake of a client.
+var maxHandshakeSize = 8 * 1024;
+
+var CONNECTING = 0;
+var OPEN = 1;
+var CLOSING = 2;
+var CLOSED = 3;
+
+
+function acceptKey(key) {
+  return websocketBuiltin.sha1(key + GUID).toString('base64');
+}
+
+
+function WebSocket() {
+  EventEmitter.call(this);
+
+  this.readyState = CONNECTING;
+  this._socket = null;
+  this._native = null;
+  // The tcp object whose data the native side reads and writes itself, or
+  // null for the sockets driven from here.
+  this._tcp = null;
+  this._sending = 0;
+  this._closeSent = false;
+  this._closeReceived = false;
+  this._closeCode = CLOSE_ABNORMAL;
+  this._closeReason = '';
+  this._closeTimer = null;
+}
+
+util.inherits(WebSocket, EventEmitter);
+
+WebSocket.CONNECTING = WebSocket.prototype.CONNECTING = CONNECTING;
+WebSocket.OPEN = WebSocket.prototype.OPEN = OPEN;
+WebSocket.CLOSING = WebSocket.prototype.CLOSING = CLOSING;
+WebSocket.CLOSED = WebSocket.prototype.CLOSED = CLOSED;
+
+exports.WebSocket = WebSocket;
+
+
+// Takes over the socket of a finished handshake, with the data received
+// after it in `head`.
+function attach(ws, socket, head, isClient, options) {
+  // A plain socket is read and written natively. The data of an encrypted
+  // one comes decrypted in 'data' events.
+  var tcp = !socket.encrypted && socket._handle ? socket._handle : null;
+  var native = new websocketBuiltin.WebSocket(isClient, tcp);
+
+  native.owner = ws;
+  native.onframe = onframe;
+  if (options && options.maxPayload > 0) {
+    native.setMaxPayload(options.maxPayload);
+  }
+
+  ws._socket = socket;
+  ws._native = native;
+  ws._tcp = tcp;
+  ws.readyState = OPEN;
+
+  socket.setTimeout(0);
+  if (socket.setNoDelay) {
+    socket.setNoDelay(true);
+  }
+  socket.on('end', socketOnEnd);
+  socket.on('close', socketOnClose);
+  socket.on('error', socketOnError);
+  socket._websocket = ws;
+
+  if (tcp && native.start() == 0) {
+    // The head comes before any data read natively: the next read waits
+    // for the ticks to run.
+    if (head && head.length > 0) {
+      process.nextTick(function() {
+        if (ws._native) {
+          native.feed(head);
+        }
+      });
+    }
+  } else {
+    ws._tcp = null;
+    socket.on('data', socketOnData);
+    if (head && head.length > 0) {
+      native.feed(head);
+    }
+  }
+}
+
+
+function socketOnData(data) {
+  var ws = this._websocket;
+  if (ws._native) {
+    ws._native.feed(data);
+  }
+}
+
+
+function socketOnEnd() {
+  var ws = this._websocket;
+  ws.readyState = CLOSING;
+  this.end();
+}
+
+
+function socketOnError(err) {
+  this._websocket.emit('error', err);
+}
+
+
+function socketOnClose() {
+  var ws = this._websocket;
+
+  if (ws._closeTimer) {
+    clearTimeout(ws._closeTimer);
+    ws._closeTimer = null;
+  }
+  if (ws._native) {
+    ws._native.destroy();
+    ws._native = null;
+  }
+  ws._tcp = null;
+  ws.readyState = CLOSED;
+
+  var code = ws._closeReceived ? ws._closeCode : CLOSE_ABNORMAL;
+  ws.emit('close', code, ws._closeReason);
+}
+
+
+// Called natively with each message and control frame received, or with a
+// negative status code when the peer broke the protocol.
+function onframe(ws, opcode, payload) {
+  if (opcode < 0) {
+    var err = new Error('WebSocket protocol error');
+    err.code = -opcode;
+    failConnection(ws, -opcode);
+    ws.emit('error', err);
+    return;
+  }
+
+  switch (opcode) {
+    case OPCODE_TEXT:
+      ws.emit('message', payload.toString(), false);
+      break;
+    case OPCODE_BINARY:
+      ws.emit('message', payload, true);
+      break;
+    case OPCODE_PING:
+      if (ws.readyState == OPEN) {
+        sendFrame(ws, OPCODE_PONG, true, payload);
+      }
+      ws.emit('ping', payload);
+      break;
+    case OPCODE_PONG:
+      ws.emit('pong', payload);
+      break;
+    case OPCODE_CLOSE:
+      onclose(ws, payload);
+      break;
+  }
+}
+
+
+function onclose(ws, payload) {
+  ws._closeReceived = true;
+  if (payload.length >= 2) {
+    ws._closeCode = payload.readUInt16BE(0);
+    ws._closeReason = payload.toString(2);
+  } else {
+    ws._closeCode = CLOSE_NO_STATUS;
+  }
+
+  if (!ws._closeSent) {
+    // The close frame is echoed with the code it came with.
+    sendClose(ws, payload.length >= 2 ? ws._closeCode : undefined, '');
+  }
+  ws.readyState = CLOSING;
+  ws._socket.end();
+}
+
+
+function failConnection(ws, code) {
+  ws._closeReceived = true;
+  ws._closeCode = code;
+  if (!ws._closeSent) {
+    sendClose(ws, code, '');
+  }
+  ws.readyState = CLOSING;
+  ws._socket.end();
+}
+
+
+// Writes a frame natively while nothing waits in the stream of the socket,
+// and through the stream otherwise, so that the frames keep their order.
+function sendFrame(ws, opcode, fin, payload, callback) {
+  var socket = ws._socket;
+  var state = socket._writableState;
+
+  if (ws._tcp && socket._handle === ws._tcp &&
+      state.length == state.writingLength) {
+    ws._sending += payload.length;
+    var err = ws._native.send(opcode, fin, payload, function(status) {
+      ws._sending -= payload.length;
+      if (callback) {
+        callback(status ? new Error('write failed: ' + status) : null);
+      }
+    });
+    if (err == 0) {
+      return;
+    }
+    ws._sending -= payload.length;
+  }
+
+  if (ws._native) {
+    socket.write(ws._native.encode(opcode, fin, payload), callback);
+  } else if (callback) {
+    process.nextTick(function() {
+      callback(new Error('WebSocket is closed'));
+    });
+  }
+}
+
+
+function sendClose(ws, code, reason) {
+  var payload;
+  if (code === undefined) {
+    payload = new Buffer(0);
+  } else {
+    reason = new Buffer(reason || '');
+    payload = new Buffer(2 + reason.length);
+    payload.writeUInt16BE(code, 0);
+    reason.copy(payload, 2);
+  }
+
+  ws._closeSent = true;
+  sendFrame(ws, OPCODE_CLOSE, true, payload);
+}
+
+
+function toPayload(data) {
+  if (util.isBuffer(data)) {
+    return data;
+  }
+  return new Buffer(util.isString(data) ? data : String(data));
+}
+
+
+function checkOpen(ws) {
+  if (ws.readyState != OPEN) {
+    throw new Error('WebSocket is not open');
+  }
+}
+
+
+// ws.send(data[, options][, callback])
+// * options.binary - send a binary message, by default for Buffers
+// * options.fragmentSize - split the message in frames of this size
+WebSocket.prototype.send = function(data, options, callback) {
+  if (util.isFunction(options)) {
+    callback = options;
+    options = undefined;
+  }
+  options = options || {};
+  checkOpen(this);
+
+  var binary = options.binary !== undefined ? !!options.binary :
+               util.isBuffer(data);
+  var payload = toPayload(data);
+  var opcode = binary ? OPCODE_BINARY : OPCODE_TEXT;
+  var size = options.fragmentSize;
+
+  // The fragments are views of the payload.
+  if (size > 0) {
+    while (payload.length > size) {
+      sendFrame(this, opcode, false, payload.slice(0, size));
+      payload = payload.slice(size);
+      opcode = OPCODE_CONTINUATION;
+    }
+  }
+  sendFrame(this, opcode, true, payload, callback);
+};
+
+
+function sendControl(ws, opcode, data, callback) {
+  checkOpen(ws);
+
+  var payload = toPayload(data === undefined ? '' : data);
+  if (payload.length > MAX_CONTROL_PAYLOAD) {
+    throw new RangeError('The payload of a control frame is at most ' +
+                         MAX_CONTROL_PAYLOAD + ' bytes');
+  }
+  sendFrame(ws, opcode, true, payload, callback);
+}
+
+
+WebSocket.prototype.ping = function(data, callback) {
+  if (util.isFunction(data)) {
+    callback = data;
+    data = undefined;
+  }
+  sendControl(this, OPCODE_PING, data, callback);
+};
+
+
+WebSocket.prototype.pong = function(data, callback) {
+  if (util.isFunction(data)) {
+    callback = data;
+    data = undefined;
+  }
+  sendControl(this, OPCODE_PONG, data, callback);
+};
+
+
+// Starts the closing handshake. The socket is closed once the peer answers,
+// or after a timeout.
+WebSocket.prototype.close = function(code, reason) {
+  if (this.readyState == CLOSED || this._closeSent) {
+    return;
+  }
+  if (this.readyState == CONNECTING) {
+    this.terminate();
+    return;
+  }
+
+  if (code !== undefined &&
+      (!util.isNumber(code) || code < CLOSE_NORMAL || code > 4999 ||
+       code == CLOSE_NO_STATUS || code == CLOSE_ABNORMAL)) {
+    throw new RangeError('Invalid close code: ' + code);
+  }
+  reason = reason === undefined ? '' : String(reason);
+  if (Buffer.byteLength(reason) > MAX_CONTROL_PAYLOAD - 2) {
+    throw new RangeError('The reason of closing is too long');
+  }
+
+  sendClose(this, code, reason);
+  this.readyState = CLOSING;
+
+  var socket = this._socket;
+  this._closeTimer = setTimeout(function() {
+    socket.destroy();
+  }, closeTimeout);
+};
+
+
+// Closes the socket at once.
+WebSocket.prototype.terminate = function() {
+  if (this._socket) {
+    this.readyState = CLOSING;
+    this._socket.destroy();
+  } else {
+    this.readyState = CLOSED;
+  }
+};
+
+
+// ws.bufferedAmount
+// The bytes sent and not yet taken by the kernel.
+Object.defineProperty(WebSocket.prototype, 'bufferedAmount', {
+  get: function() {
+    return this._socket ? this._socket.bufferSize + this._sending : 0;
+  },
+});
+
+
+var handshakeStatus = {
+  400: 'Bad Request',
+  404: 'Not Found',
+  426: 'Upgrade Required',
+};
+
+
+function abortHandshake(socket, code, headers) {
+  var response = 'HTTP/1.1 ' + code + ' ' + handshakeStatus[code] + '\r\n' +
+                 'Connection: close\r\n';
+  var names = Object.keys(headers || {});
+  for (var i = 0; i < names.length; i++) {
+    response += names[i] + ': ' + headers[names[i]] + '\r\n';
+  }
+  socket.end(response + '\r\n');
+}
+
+
+// new Server(options[, connectionListener])
+// * options.server - HTTP server whose upgrade requests are taken
+// * options.port, options.host - where to listen with a server of its own
+// * options.path - the only path accepted
+// * options.maxPayload - the largest message received
+function Server(options, connectionListener) {
+  if (!(this instanceof Server)) {
+    return new Server(options, connectionListener);
+  }
+
+  EventEmitter.call(this);
+
+  options = options || {};
+  this.path = options.path;
+  this.maxPayload = options.maxPayload;
+  this.clients = [];
+
+  if (util.isFunction(connectionListener)) {
+    this.on('connection', connectionListener);
+  }
+
+  var self = this;
+
+  if (options.server) {
+    this._server = options.server;
+    this._ownServer = false;
+  } else if (options.port !== undefined) {
+    this._server = http.createServer(function(req, res) {
+      res.writeHead(426, {'Content-Type': 'text/plain'});
+      res.end(handshakeStatus[426]);
+    });
+    this._ownServer = true;
+    this._server.on('error', function(err) {
+      self.emit('error', err);
+    });
+    this._server.listen({port: options.port, host: options.host}, function() {
+      self.emit('listening');
+    });
+  } else {
+    throw new TypeError('Bad arguments: options.server or options.port ' +
+                        'is needed');
+  }
+
+  this._onUpgrade = function(req, socket, head) {
+    if (self.path && req.url.split('?')[0] !== self.path) {
+      abortHandshake(socket, 404);
+      return;
+    }
+    self.handleUpgrade(req, socket, head, function(ws) {
+      self.emit('connection', ws, req);
+    });
+  };
+  this._server.on('upgrade', this._onUpgrade);
+}
+
+util.inherits(Server, EventEmitter);
+
+exports.Server = Server;
+
+
+// Answers the upgrade request `req` of an HTTP server, and passes the
+// WebSocket of the connection to `callback`.
+Server.prototype.handleUpgrade = function(req, socket, head, callback) {
+  var upgrade = findHeader(req.headers, 'upgrade');
+  var key = findHeader(req.headers, 'sec-websocket-key');
+  var version = findHeader(req.headers, 'sec-websocket-version');
+
+  if (req.method !== 'GET' || !upgrade ||
+      upgrade.toLowerCase() !== 'websocket' || !key) {
+    abortHandshake(socket, 400);
+    return;
+  }
+  if (version !== '13') {
+    abortHandshake(socket, 426, {'Sec-WebSocket-Version': '13'});
+    return;
+  }
+
+  socket.write('HTTP/1.1 101 Switching Protocols\r\n' +
+               'Upgrade: websocket\r\n' +
+               'Connection: Upgrade\r\n' +
+               'Sec-WebSocket-Accept: ' + acceptKey(key.trim()) + '\r\n' +
+               '\r\n');
+
+  var ws = new WebSocket();
+  attach(ws, socket, head, false, {maxPayload: this.maxPayload});
+
+  var clients = this.clients;
+  clients.push(ws);
+  ws.on('close', function() {
+    var index = clients.indexOf(ws);
+    if (index >= 0) {
+      clients.splice(index, 1);
+    }
+  });
+
+  callback(ws, req);
+};
+
+
+// Stops taking upgrade requests, and closes the connections.
+Server.prototype.close = function(callback) {
+  this._server.removeListener('upgrade', this._onUpgrade);
+
+  var clients = this.clients.slice();
+  for (var i = 0; i < clients.length; i++) {
+    clients[i].close(CLOSE_GOING_AWAY);
+  }
+
+  if (this._ownServer) {
+    this._server.close(callback);
+  } else if (callback) {
+    process.nextTick(callback);
+  }
+};
+
+
+exports.createServer = function(options, connectionListener) {
+  return new Server(options, connectionListener);
+};
+
+
+// connect(address[, options][, callback])
+// * options.headers - fields added to the handshake request
+// * options.maxPayload - the largest message received
+// * options.createConnection(options, callback) - makes the socket, as
+//   tls.connect does for 'wss:' addresses
+exports.connect = function(address, options, callback) {
+  if (util.isFunction(options)) {
+    callback = options;
+    options = undefined;
+  }
+  options = options || {};
+
+  var target = url.parse(address);
+  var secure = target.protocol === 'wss:';
+  if (!target.hostname || (!secure && target.protocol !== 'ws:')) {
+    throw new TypeError('Invalid WebSocket address: ' + address);
+  }
+  // The tls module is not part of every build, so it is not required here.
+  if (secure && !util.isFunction(options.createConnection)) {
+    throw new TypeError('options.createConnection is needed for ' +
+                        'wss: addresses');
+  }
+
+  var ws = new WebSocket();
+  if (util.isFunction(callback)) {
+    ws.once('open', callback);
+  }
+
+  var key = websocketBuiltin.randomKey().toString('base64');
+  var connectOptions = {
+    host: target.hostname,
+    port: target.port ? Number(target.port) : (secure ? 443 : 80),
+    servername: target.hostname,
+  };
+  var createConnection = options.createConnection || net.connect;
+  var socket = createConnection(connectOptions, onconnect);
+  var received = null;
+
+  function onconnect() {
+    var request = 'GET ' + (target.path || '/') + ' HTTP/1.1\r\n' +
+                  'Host: ' + target.host + '\r\n' +
+                  'Upgrade: websocket\r\n' +
+                  'Connection: Upgrade\r\n' +
+                  'Sec-WebSocket-Key: ' + key + '\r\n' +
+                  'Sec-WebSocket-Version: 13\r\n';
+    var names = Object.keys(options.headers || {});
+    for (var i = 0; i < names.length; i++) {
+      request += names[i] + ': ' + options.headers[names[i]] + '\r\n';
+    }
+    socket.write(request + '\r\n');
+  }
+
+  function cleanup() {
+    socket.removeListener('data', ondata);
+    socket.removeListener('error', onerror);
+    socket.removeListener('close', onclose);
+  }
+
+  function fail(err) {
+    cleanup();
+    ws.readyState = CLOSED;
+    socket.destroy();
+    ws.emit('error', err);
+    ws.emit('close', CLOSE_ABNORMAL, '');
+  }
+
+  function ondata(data) {
+    received = received ? Buffer.concat([received, data]) : data;
+
+    var end = received.indexOf('\r\n\r\n');
+    if (end < 0) {
+      if (received.length > maxHandshakeSize) {
+        fail(new Error('WebSocket handshake response is too large'));
+      }
+      return;
+    }
+
+    var lines = received.toString(0, end).split('\r\n');
+    var status = lines[0].split(' ')[1];
+    var headers = {};
+    for (var i = 1; i < lines.length; i++) {
+      var colon = lines[i].indexOf(':');
+      if (colon > 0) {
+        headers[lines[i].slice(0, colon).trim().toLowerCase()] =
+            lines[i].slice(colon + 1).trim();
+      }
+    }
+
+    if (status !== '101') {
+      fail(new Error('Unexpected server response: ' + status));
+      return;
+    }
+    if ((headers['upgrade'] || '').toLowerCase() !== 'websocket' ||
+        headers['sec-websocket-accept'] !== acceptKey(key)) {
+      fail(new Error('Invalid WebSocket handshake response'));
+      return;
+    }
+
+    cleanup();
+    attach(ws, socket, received.slice(end + 4), true, options);
+    ws.emit('open');
+  }
+
+  function onerror(err) {
+    fail(err);
+  }
+
+  function onclose() {
+    fail(new Error('Connection closed before the handshake'));
+  }
+
+  socket.on('data', ondata);
+  socket.on('error', onerror);
+  socket.on('close', onclose);
+
+  return ws;
+};
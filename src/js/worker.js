@@ -0,0 +1,418 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var EventEmitter = require('events').EventEmitter;
+var net = require('net');
+var util = require('util');
+
+var ClusterWorker = process.binding(process.binding.cluster);
+var SharedRing = ClusterWorker.SharedRing;
+
+
+// A worker runs a script in a new iotjs process, with its own JerryScript
+// heap and event loop. The parent and the worker talk through a socket pair;
+// every message is a header of a type byte and a 32 bit little endian length,
+// followed by the payload, which is either a Buffer or JSON text.
+var MESSAGE_JSON = 0;
+var MESSAGE_BUFFER = 1;
+var HEADER_SIZE = 5;
+
+// With the sharedMemory option, messages go through a ring in memory shared
+// by the two processes instead, and values other than Buffers are encoded
+// in CBOR.
+var MESSAGE_CBOR = 2;
+
+var SIGTERM = 15;
+
+var nextThreadId = 1;
+
+// The running workers of this process, by thread id.
+var workers = {};
+
+
+function encode(message) {
+  var type = MESSAGE_BUFFER;
+  var payload = message;
+
+  if (!Buffer.isBuffer(message)) {
+    type = MESSAGE_JSON;
+    payload = new Buffer(JSON.stringify(message === undefined ? null
+                                                              : message));
+  }
+
+  var header = new Buffer(HEADER_SIZE);
+  header.writeUInt8(type, 0);
+  header.writeUInt32LE(payload.length, 1);
+
+  return Buffer.concat([header, payload]);
+}
+
+
+// Reads the messages of `socket`, which may be split over several chunks or
+// share one, and emits them as 'message' events of `target`.
+function readMessages(socket, target) {
+  var pending = new Buffer(0);
+
+  socket.on('data', function(chunk) {
+    pending = Buffer.concat([pending, chunk]);
+
+    while (pending.length >= HEADER_SIZE) {
+      var length = pending.readUInt16LE(1) + pending.readUInt16LE(3) * 65536;
+      if (pending.length < HEADER_SIZE + length) {
+        break;
+      }
+
+      var type = pending.readUInt8(0);
+      var payload = pending.slice(HEADER_SIZE, HEADER_SIZE + length);
+      pending = pending.slice(HEADER_SIZE + length);
+
+      target.emit('message', type == MESSAGE_BUFFER
+                                 ? payload
+                                 : JSON.parse(payload.toString()));
+    }
+  });
+}
+
+
+var cbor = null;
+
+function getCbor() {
+  if (!cbor) {
+    cbor = require('codec').cbor;
+  }
+  return cbor;
+}
+
+
+// Sends and receives the messages of `target` through a shared ring. The
+// messages that do not fit wait in order until the other side makes room.
+function RingChannel(ring, target) {
+  var self = this;
+
+  this._ring = ring;
+  this._queue = [];
+  this._listening = true;
+  this._onMessage = function(type, payload) {
+    target.emit('message', type == MESSAGE_CBOR ? getCbor().decode(payload)
+                                                : payload);
+  };
+
+  ring.onsignal = function() {
+    self.flush();
+    self.drain();
+  };
+}
+
+
+RingChannel.prototype.post = function(message) {
+  var type = MESSAGE_BUFFER;
+  var payload = message;
+
+  if (!Buffer.isBuffer(message)) {
+    type = MESSAGE_CBOR;
+    payload = getCbor().encode(message === undefined ? null : message);
+  }
+
+  if (this._queue.length > 0 || !this._ring.write(type, payload)) {
+    // Copied, as a queued Buffer may be changed before it is sent.
+    this._queue.push(type, type == MESSAGE_BUFFER ? new Buffer(payload)
+                                                  : payload);
+    this._updateRef();
+  }
+};
+
+
+RingChannel.prototype.flush = function() {
+  var queue = this._queue;
+  var sent = 0;
+  while (sent < queue.length && this._ring.write(queue[sent],
+                                                 queue[sent + 1])) {
+    sent += 2;
+  }
+  if (sent > 0) {
+    queue.splice(0, sent);
+    this._updateRef();
+  }
+};
+
+
+RingChannel.prototype.drain = function() {
+  var self = this;
+  var done = false;
+  try {
+    this._ring.drain(this._onMessage);
+    done = true;
+  } finally {
+    // The rest is read later, if a listener throws.
+    if (!done) {
+      process.nextTick(function() {
+        self.drain();
+      });
+    }
+  }
+};
+
+
+// The ring keeps the process running while there are listeners, or messages
+// that are still to be sent.
+RingChannel.prototype.setListening = function(listening) {
+  this._listening = listening;
+  this._updateRef();
+};
+
+
+RingChannel.prototype._updateRef = function() {
+  if (this._listening || this._queue.length > 0) {
+    this._ring.ref();
+  } else {
+    this._ring.unref();
+  }
+};
+
+
+RingChannel.prototype.close = function() {
+  this._ring.onsignal = null;
+  this._ring.close();
+};
+
+
+function Worker(filename, options) {
+  if (!(this instanceof Worker)) {
+    return new Worker(filename, options);
+  }
+
+  if (!util.isString(filename)) {
+    throw new TypeError('Bad arguments: filename must be a string');
+  }
+
+  EventEmitter.call(this);
+
+  options = options || {};
+
+  var self = this;
+  var argv = [process.argv[0], filename].concat(options.argv || []);
+  var data = JSON.stringify({
+    threadId: nextThreadId,
+    workerData: options.workerData
+  });
+
+  var ring = options.sharedMemory ? new SharedRing(options.sharedMemory)
+                                  : null;
+  var peerFds = ring ? ring.peerFds : [];
+
+  var handle = new ClusterWorker();
+  var err = handle.spawn(argv,
+                         ['IOTJS_CLUSTER_WORKER=',
+                          'IOTJS_WORKER_DATA=' + data,
+                          'IOTJS_SHARED_RING=' + peerFds.join(',')],
+                         true, peerFds);
+  if (ring) {
+    ring.closePeer();
+  }
+  if (err) {
+    if (ring) {
+      ring.close();
+    }
+    throw new Error('Failed to start a worker: ' + err);
+  }
+
+  this.threadId = nextThreadId++;
+  this._handle = handle;
+  workers[this.threadId] = this;
+  this._channel = new net.Socket({ fd: handle.channelFd });
+  this._channel.on('error', function() {
+    self._channel.destroy();
+  });
+  readMessages(this._channel, this);
+  this._ring = ring ? new RingChannel(ring, this) : null;
+
+  // The worker may exit before its last messages are read, so 'exit' waits
+  // for the channel to be closed as well.
+  var exitCode = null;
+  var pending = 2;
+
+  function onDone() {
+    if (--pending == 0) {
+      self.emit('exit', exitCode);
+    }
+  }
+
+  this._channel.on('close', onDone);
+
+  handle.onexit = function(code, signum) {
+    handle.close();
+    self._handle = null;
+    delete workers[self.threadId];
+
+    // The messages the worker left in the ring are read before 'exit'.
+    if (self._ring) {
+      self._ring.drain();
+      self._ring.close();
+      self._ring = null;
+    }
+
+    // Like node.js, a terminated worker exits with 1.
+    exitCode = signum ? 1 : code;
+    onDone();
+  };
+}
+
+util.inherits(Worker, EventEmitter);
+
+
+Worker.prototype.postMessage = function(message) {
+  if (!this._handle) {
+    return;
+  }
+  if (this._ring) {
+    this._ring.post(message);
+  } else {
+    this._channel.write(encode(message));
+  }
+};
+
+
+Worker.prototype.terminate = function(callback) {
+  if (util.isFunction(callback)) {
+    this.once('exit', function(code) {
+      callback(null, code);
+    });
+  }
+
+  if (this._handle) {
+    this._handle.kill(SIGTERM);
+  }
+};
+
+
+// The side of the worker the parent talks to. The channel only keeps the
+// worker running while there are 'message' listeners, so a worker that does
+// not listen exits once its script is done.
+function MessagePort(fd, ringFds) {
+  EventEmitter.call(this);
+
+  var self = this;
+
+  this._ring = null;
+  if (ringFds) {
+    this._ring = new RingChannel(new SharedRing(ringFds[0], ringFds[1]), this);
+    this._ring.setListening(false);
+  }
+
+  this._channel = new net.Socket({ fd: fd });
+  this._channel.unref();
+  this._channel.on('error', function() {});
+  this._channel.on('end', function() {
+    self.close();
+  });
+  readMessages(this._channel, this);
+}
+
+util.inherits(MessagePort, EventEmitter);
+
+
+MessagePort.prototype.addListener = function(type, listener) {
+  EventEmitter.prototype.addListener.call(this, type, listener);
+  if (type == 'message' && this._channel) {
+    this._channel.ref();
+    if (this._ring) {
+      this._ring.setListening(true);
+    }
+  }
+  return this;
+};
+
+
+MessagePort.prototype.on = MessagePort.prototype.addListener;
+
+
+MessagePort.prototype.removeListener = function(type, listener) {
+  EventEmitter.prototype.removeListener.call(this, type, listener);
+  if (type == 'message' && this._channel && !this._events.message) {
+    this._channel.unref();
+    if (this._ring) {
+      this._ring.setListening(false);
+    }
+  }
+  return this;
+};
+
+
+MessagePort.prototype.removeAllListeners = function(type) {
+  EventEmitter.prototype.removeAllListeners.apply(this, arguments);
+  if (this._channel && !this._events.message) {
+    this._channel.unref();
+    if (this._ring) {
+      this._ring.setListening(false);
+    }
+  }
+  return this;
+};
+
+
+MessagePort.prototype.postMessage = function(message) {
+  if (this._ring) {
+    this._ring.post(message);
+  } else if (this._channel) {
+    this._channel.write(encode(message));
+  }
+};
+
+
+MessagePort.prototype.close = function() {
+  if (!this._channel) {
+    return;
+  }
+
+  this._channel.end();
+  this._channel = null;
+  if (this._ring) {
+    this._ring.close();
+    this._ring = null;
+  }
+  this.emit('close');
+};
+
+
+var isMainThread = process.env.IOTJS_CHANNEL_FD === '';
+var workerData = null;
+var threadId = 0;
+var parentPort = null;
+
+if (!isMainThread) {
+  var data = JSON.parse(process.env.IOTJS_WORKER_DATA);
+  workerData = data.workerData === undefined ? null : data.workerData;
+  threadId = data.threadId;
+  var ringFds = process.env.IOTJS_SHARED_RING;
+  parentPort = new MessagePort(Number(process.env.IOTJS_CHANNEL_FD),
+                               ringFds ? ringFds.split(',').map(Number)
+                                       : null);
+}
+
+
+// Workers do not outlive their parent.
+process.on('exit', function() {
+  var ids = Object.keys(workers);
+  for (var i = 0; i < ids.length; ++i) {
+    workers[ids[i]].terminate();
+  }
+});
+
+
+exports.Worker = Worker;
+exports.isMainThread = isMainThread;
+exports.parentPort = parentPort;
+exports.threadId = threadId;
+exports.workerData = workerData;
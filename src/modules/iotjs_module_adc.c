@@ -15,7 +15,9 @@
 
 #include "iotjs_def.h"
 #include "iotjs_module_adc.h"
+#include "iotjs_module_buffer.h"
 #include "iotjs_objectwrap.h"
+#include <unistd.h>
 
 
 static JNativeInfoType this_module_native_info = {.free_cb = NULL };
@@ -47,9 +49,14 @@ static void iotjs_adc_destroy(iotjs_adc_t* adc) {
 #define THIS iotjs_adc_reqwrap_t* adc_reqwrap
 
 
+IOTJS_DEFINE_POOL(adc_reqwrap_pool, iotjs_adc_reqwrap_t, "adc",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 static iotjs_adc_reqwrap_t* iotjs_adc_reqwrap_create(
     const iotjs_jval_t* jcallback, iotjs_adc_t* adc, AdcOp op) {
-  iotjs_adc_reqwrap_t* adc_reqwrap = IOTJS_ALLOC(iotjs_adc_reqwrap_t);
+  iotjs_adc_reqwrap_t* adc_reqwrap =
+      IOTJS_POOL_ALLOC(adc_reqwrap_pool, iotjs_adc_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_adc_reqwrap_t, adc_reqwrap);
 
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -62,7 +69,7 @@ static iotjs_adc_reqwrap_t* iotjs_adc_reqwrap_create(
 static void iotjs_adc_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_adc_reqwrap_t, adc_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(adc_reqwrap);
+  IOTJS_POOL_RELEASE(adc_reqwrap_pool, adc_reqwrap);
 }
 
 
@@ -72,7 +79,7 @@ static void iotjs_adc_reqwrap_dispatched(THIS) {
 }
 
 
-static uv_work_t* iotjs_adc_reqwrap_req(THIS) {
+static iotjs_bus_work_t* iotjs_adc_reqwrap_req(THIS) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_adc_reqwrap_t, adc_reqwrap);
   return &_this->req;
 }
@@ -154,7 +161,8 @@ static void iotjs_adc_after_work(uv_work_t* work_req, int status) {
   }
 
   const iotjs_jval_t* jcallback = iotjs_adc_reqwrap_jcallback(req_wrap);
-  iotjs_make_callback(jcallback, iotjs_jval_get_undefined(), &jargs);
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, jcallback,
+                              iotjs_jval_get_undefined(), &jargs);
 
   if (req_data->op == kAdcOpClose) {
     iotjs_adc_destroy(_this->adc_instance);
@@ -192,13 +200,13 @@ static void iotjs_adc_close_worker(uv_work_t* work_req) {
 }
 
 
-#define ADC_ASYNC(call, this, jcallback, op)                                   \
-  do {                                                                         \
-    uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());         \
-    iotjs_adc_reqwrap_t* req_wrap =                                            \
-        iotjs_adc_reqwrap_create(jcallback, this, op);                         \
-    uv_work_t* req = iotjs_adc_reqwrap_req(req_wrap);                          \
-    uv_queue_work(loop, req, iotjs_adc_##call##_worker, iotjs_adc_after_work); \
+#define ADC_ASYNC(call, this, jcallback, op)                              \
+  do {                                                                    \
+    iotjs_adc_reqwrap_t* req_wrap =                                       \
+        iotjs_adc_reqwrap_create(jcallback, this, op);                    \
+    iotjs_bus_work_t* req = iotjs_adc_reqwrap_req(req_wrap);              \
+    iotjs_busqueue_work(iotjs_busqueue_peripheral(), req,                 \
+                        iotjs_adc_##call##_worker, iotjs_adc_after_work); \
   } while (0)
 
 JHANDLER_FUNCTION(AdcConstructor) {
@@ -265,6 +273,282 @@ JHANDLER_FUNCTION(ReadSync) {
   }
 }
 
+// Periodic sampling reads the pin on a thread of its own at each expiration
+// of the platform timer. The thread fills the chunks of the ring in turn, and
+// the loop thread hands each filled chunk to JS as a Buffer of 16 bit little
+// endian samples and gives it back to the thread. When JS falls behind and no
+// chunk is free, the thread waits, and the periods it misses are reported
+// with the next chunk.
+#define ADC_SAMPLER_CHUNKS 4
+
+struct iotjs_adc_sampler_s {
+  iotjs_adc_t* adc;
+  iotjs_jval_t jadc;
+  uv_thread_t thread;
+  uv_async_t async;
+  uv_mutex_t mutex;
+  uv_cond_t cond;
+
+  uint32_t samples;
+  uint8_t* chunks[ADC_SAMPLER_CHUNKS];
+
+  // Guarded by `mutex`.
+  bool filled[ADC_SAMPLER_CHUNKS];
+  uint64_t missed[ADC_SAMPLER_CHUNKS];
+  bool failed;
+  bool stopping;
+
+  // Used by the loop thread only.
+  size_t next_chunk;
+};
+
+
+static void iotjs_adc_sampler_worker(void* arg) {
+  iotjs_adc_sampler_t* sampler = (iotjs_adc_sampler_t*)arg;
+  size_t index = 0;
+  uint32_t count = 0;
+  uint64_t missed = 0;
+
+  uv_mutex_lock(&sampler->mutex);
+  while (!sampler->stopping) {
+    if (sampler->filled[index]) {
+      uv_cond_wait(&sampler->cond, &sampler->mutex);
+      continue;
+    }
+    uv_mutex_unlock(&sampler->mutex);
+
+    uint64_t periods = iotjs_adc_timer_wait(sampler->adc);
+    int32_t value = periods > 0 ? iotjs_adc_read(sampler->adc) : -1;
+
+    uv_mutex_lock(&sampler->mutex);
+    if (value < 0) {
+      sampler->failed = true;
+      uv_async_send(&sampler->async);
+      break;
+    }
+
+    missed += periods - 1;
+    if (value > UINT16_MAX) {
+      value = UINT16_MAX;
+    }
+    uint8_t* chunk = sampler->chunks[index];
+    chunk[2 * count] = (uint8_t)value;
+    chunk[2 * count + 1] = (uint8_t)(value >> 8);
+
+    if (++count == sampler->samples) {
+      sampler->filled[index] = true;
+      sampler->missed[index] = missed;
+      uv_async_send(&sampler->async);
+      index = (index + 1) % ADC_SAMPLER_CHUNKS;
+      count = 0;
+      missed = 0;
+    }
+  }
+  uv_mutex_unlock(&sampler->mutex);
+}
+
+
+// Calls `onData(err, data, missed)` of the ADC object.
+static void iotjs_adc_sampler_emit(iotjs_adc_sampler_t* sampler,
+                                   iotjs_jargs_t* jargs) {
+  iotjs_jval_t jon_data =
+      iotjs_jval_get_property(&sampler->jadc, IOTJS_MAGIC_STRING_ONDATA);
+
+  if (iotjs_jval_is_function(&jon_data)) {
+    iotjs_make_callback_in_lane(kCallbackLaneHigh, &jon_data, &sampler->jadc,
+                                jargs);
+  }
+
+  iotjs_jval_destroy(&jon_data);
+}
+
+
+static void iotjs_adc_sampler_deliver(uv_async_t* async) {
+  iotjs_adc_sampler_t* sampler = (iotjs_adc_sampler_t*)async->data;
+  size_t chunk_len = 2 * sampler->samples;
+
+  // JS may stop sampling in a callback, which keeps the memory of the sampler
+  // until the async handle is closed.
+  while (true) {
+    size_t index = sampler->next_chunk;
+
+    uv_mutex_lock(&sampler->mutex);
+    bool stopping = sampler->stopping;
+    bool filled = sampler->filled[index];
+    uint64_t missed = sampler->missed[index];
+    bool failed = !filled && sampler->failed;
+    if (failed) {
+      sampler->failed = false;
+    }
+    uv_mutex_unlock(&sampler->mutex);
+
+    if (stopping || (!filled && !failed)) {
+      return;
+    }
+
+    iotjs_jargs_t jargs = iotjs_jargs_create(3);
+
+    if (failed) {
+      iotjs_jargs_append_error(&jargs, "Cannot sample ADC device");
+      iotjs_adc_sampler_emit(sampler, &jargs);
+      iotjs_jargs_destroy(&jargs);
+      return;
+    }
+
+    iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(chunk_len);
+    iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+    iotjs_bufferwrap_copy(buffer, (const char*)sampler->chunks[index],
+                          chunk_len);
+
+    uv_mutex_lock(&sampler->mutex);
+    sampler->filled[index] = false;
+    uv_cond_signal(&sampler->cond);
+    uv_mutex_unlock(&sampler->mutex);
+    sampler->next_chunk = (index + 1) % ADC_SAMPLER_CHUNKS;
+
+    iotjs_jargs_append_null(&jargs);
+    iotjs_jargs_append_jval(&jargs, &jbuffer);
+    iotjs_jargs_append_number(&jargs, (double)missed);
+    iotjs_adc_sampler_emit(sampler, &jargs);
+    iotjs_jargs_destroy(&jargs);
+    iotjs_jval_destroy(&jbuffer);
+  }
+}
+
+
+static void iotjs_adc_sampler_release(uv_handle_t* handle) {
+  iotjs_adc_sampler_t* sampler = (iotjs_adc_sampler_t*)handle->data;
+
+  uv_cond_destroy(&sampler->cond);
+  uv_mutex_destroy(&sampler->mutex);
+  for (size_t i = 0; i < ADC_SAMPLER_CHUNKS; ++i) {
+    iotjs_buffer_release((char*)sampler->chunks[i]);
+  }
+  IOTJS_RELEASE(sampler);
+}
+
+
+static void iotjs_adc_sampler_stop(iotjs_adc_t* adc) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_adc_t, adc);
+
+  iotjs_adc_sampler_t* sampler = _this->sampler;
+  if (sampler == NULL) {
+    return;
+  }
+  _this->sampler = NULL;
+
+  uv_mutex_lock(&sampler->mutex);
+  sampler->stopping = true;
+  uv_cond_signal(&sampler->cond);
+  uv_mutex_unlock(&sampler->mutex);
+
+  // The thread takes the sample it waits for.
+  uv_thread_join(&sampler->thread);
+  iotjs_adc_timer_stop(adc);
+
+  iotjs_jval_destroy(&sampler->jadc);
+  uv_close((uv_handle_t*)&sampler->async, iotjs_adc_sampler_release);
+}
+
+
+#if !defined(__linux__)
+// Without timerfd, the sampling thread sleeps until the next deadline on the
+// monotonic clock, so the period is rounded up to the system tick.
+bool iotjs_adc_timer_start(iotjs_adc_t* adc, uint32_t period_us) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_adc_t, adc);
+
+  _this->timer_period = (uint64_t)period_us * 1000;
+  _this->timer_deadline = uv_hrtime() + _this->timer_period;
+  return true;
+}
+
+
+uint64_t iotjs_adc_timer_wait(iotjs_adc_t* adc) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_adc_t, adc);
+
+  uint64_t now = uv_hrtime();
+  while (now < _this->timer_deadline) {
+    usleep((useconds_t)((_this->timer_deadline - now + 999) / 1000));
+    now = uv_hrtime();
+  }
+
+  uint64_t periods = (now - _this->timer_deadline) / _this->timer_period + 1;
+  _this->timer_deadline += periods * _this->timer_period;
+  return periods;
+}
+
+
+void iotjs_adc_timer_stop(iotjs_adc_t* adc) {
+}
+#endif
+
+
+// samplingStart(period, samples)
+// Reads the pin every `period` microseconds, and calls onData() of the ADC
+// object with Buffers of `samples` samples.
+JHANDLER_FUNCTION(SamplingStart) {
+  JHANDLER_DECLARE_THIS_PTR(adc, adc);
+  DJHANDLER_CHECK_ARGS(2, number, number);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_adc_t, adc);
+
+  double period = JHANDLER_GET_ARG(0, number);
+  double samples = JHANDLER_GET_ARG(1, number);
+
+  if (_this->sampler != NULL) {
+    JHANDLER_THROW(COMMON, "ADC sampling is already started");
+    return;
+  }
+  if (period < 1 || period > 1000000 || samples < 1 ||
+      samples > IOTJS_ADC_SAMPLES_MAX) {
+    JHANDLER_THROW(RANGE, "Bad arguments - period and samples");
+    return;
+  }
+
+  if (!iotjs_adc_timer_start(adc, (uint32_t)period)) {
+    JHANDLER_THROW(COMMON, "Cannot start ADC sampling timer");
+    return;
+  }
+
+  iotjs_adc_sampler_t* sampler = IOTJS_ALLOC(iotjs_adc_sampler_t);
+  sampler->adc = adc;
+  sampler->jadc = iotjs_jval_create_copied(JHANDLER_GET_THIS(object));
+  sampler->samples = (uint32_t)samples;
+  for (size_t i = 0; i < ADC_SAMPLER_CHUNKS; ++i) {
+    sampler->chunks[i] =
+        (uint8_t*)iotjs_buffer_allocate(2 * sampler->samples);
+  }
+
+  uv_mutex_init(&sampler->mutex);
+  uv_cond_init(&sampler->cond);
+  uv_async_init(iotjs_environment_loop(iotjs_environment_get()),
+                &sampler->async, iotjs_adc_sampler_deliver);
+  sampler->async.data = sampler;
+
+  if (uv_thread_create(&sampler->thread, iotjs_adc_sampler_worker,
+                       sampler) != 0) {
+    iotjs_adc_timer_stop(adc);
+    iotjs_jval_destroy(&sampler->jadc);
+    uv_close((uv_handle_t*)&sampler->async, iotjs_adc_sampler_release);
+    JHANDLER_THROW(COMMON, "Cannot start ADC sampling");
+    return;
+  }
+
+  _this->sampler = sampler;
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
+JHANDLER_FUNCTION(SamplingStop) {
+  JHANDLER_DECLARE_THIS_PTR(adc, adc);
+
+  iotjs_adc_sampler_stop(adc);
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
 JHANDLER_FUNCTION(Close) {
   JHANDLER_DECLARE_THIS_PTR(adc, adc);
   DJHANDLER_CHECK_ARG_IF_EXIST(0, function);
@@ -272,6 +556,8 @@ JHANDLER_FUNCTION(Close) {
   const iotjs_jval_t* jcallback =
       (iotjs_jval_t*)JHANDLER_GET_ARG_IF_EXIST(0, function);
 
+  iotjs_adc_sampler_stop(adc);
+
   if (jcallback == NULL) {
     iotjs_jval_t jdummycallback =
         iotjs_jval_create_function(&iotjs_jval_dummy_function);
@@ -287,6 +573,8 @@ JHANDLER_FUNCTION(Close) {
 JHANDLER_FUNCTION(CloseSync) {
   JHANDLER_DECLARE_THIS_PTR(adc, adc);
 
+  iotjs_adc_sampler_stop(adc);
+
   bool ret = iotjs_adc_close(adc);
   iotjs_adc_destroy(adc);
   if (!ret) {
@@ -307,6 +595,10 @@ iotjs_jval_t InitAdc() {
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_READSYNC, ReadSync);
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_CLOSE, Close);
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_CLOSESYNC, CloseSync);
+  iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_SAMPLINGSTART,
+                        SamplingStart);
+  iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_SAMPLINGSTOP,
+                        SamplingStop);
   iotjs_jval_set_property_jval(&jadcConstructor, IOTJS_MAGIC_STRING_PROTOTYPE,
                                &jprototype);
 
@@ -18,6 +18,7 @@
 #define IOTJS_MODULE_ADC_H
 
 #include "iotjs_def.h"
+#include "iotjs_busqueue.h"
 #include "iotjs_objectwrap.h"
 #include "iotjs_reqwrap.h"
 
@@ -29,6 +30,12 @@ typedef enum {
 } AdcOp;
 
 
+// Samples in one batch of periodic sampling, two bytes each.
+#define IOTJS_ADC_SAMPLES_MAX (32 * 1024)
+
+typedef struct iotjs_adc_sampler_s iotjs_adc_sampler_t;
+
+
 typedef struct {
   iotjs_jobjectwrap_t jobjectwrap;
 
@@ -38,6 +45,15 @@ typedef struct {
   uint32_t pin;
 #endif
   int32_t device_fd;
+
+  // The periodic sampling in progress, or NULL.
+  iotjs_adc_sampler_t* sampler;
+#if defined(__linux__)
+  int32_t timer_fd;
+#else
+  uint64_t timer_period;
+  uint64_t timer_deadline;
+#endif
 } IOTJS_VALIDATED_STRUCT(iotjs_adc_t);
 
 
@@ -51,7 +67,7 @@ typedef struct {
 
 typedef struct {
   iotjs_reqwrap_t reqwrap;
-  uv_work_t req;
+  iotjs_bus_work_t req;
   iotjs_adc_reqdata_t req_data;
   iotjs_adc_t* adc_instance;
 } IOTJS_VALIDATED_STRUCT(iotjs_adc_reqwrap_t);
@@ -77,5 +93,12 @@ int32_t iotjs_adc_read(iotjs_adc_t* adc);
 bool iotjs_adc_close(iotjs_adc_t* adc);
 void iotjs_adc_open_worker(uv_work_t* work_req);
 
+// The timer of periodic sampling, used on the sampling thread. It expires
+// every `period_us` microseconds, and iotjs_adc_timer_wait() returns the
+// number of periods passed since it returned last, or 0 on error.
+bool iotjs_adc_timer_start(iotjs_adc_t* adc, uint32_t period_us);
+uint64_t iotjs_adc_timer_wait(iotjs_adc_t* adc);
+void iotjs_adc_timer_stop(iotjs_adc_t* adc);
+
 
 #endif /* IOTJS_MODULE_ADC_H */
@@ -45,7 +45,7 @@
 #define THIS iotjs_blehcisocket_t* blehcisocket
 
 
-IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(blehcisocket);
+IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE_IMMEDIATE(blehcisocket);
 
 
 iotjs_blehcisocket_t* iotjs_blehcisocket_create(const iotjs_jval_t* jble) {
@@ -72,16 +72,26 @@ static void iotjs_blehcisocket_destroy(THIS) {
   iotjs_blehcisocket_close(blehcisocket);
 
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_blehcisocket_t, blehcisocket);
+  if (_this->_reportFilter != NULL) {
+    IOTJS_RELEASE(_this->_reportFilter);
+  }
   iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
   IOTJS_RELEASE(blehcisocket);
 }
 
 
+// start([decode])
+// With `decode`, the packets read at once are emitted together as 'packets',
+// decoded and with ACL data reassembled. Otherwise each is emitted as 'data'.
 JHANDLER_FUNCTION(Start) {
   JHANDLER_DECLARE_THIS_PTR(blehcisocket, blehcisocket);
   DJHANDLER_CHECK_ARGS(0);
+  DJHANDLER_CHECK_ARG_IF_EXIST(0, boolean);
+
+  const iotjs_jval_t* jdecode = JHANDLER_GET_ARG_IF_EXIST(0, boolean);
+  bool decode = jdecode != NULL && iotjs_jval_as_boolean(jdecode);
 
-  iotjs_blehcisocket_start(blehcisocket);
+  iotjs_blehcisocket_start(blehcisocket, decode);
 
   iotjs_jhandler_return_undefined(jhandler);
 }
@@ -139,9 +149,98 @@ JHANDLER_FUNCTION(IsDevUp) {
 }
 
 
+// Reads `{ uuids, rssi, window }` of a report filter. Returns NULL with
+// `error` set when the options are invalid.
+static iotjs_blehcisocket_report_filter_t* iotjs_blehcisocket_report_filter(
+    const iotjs_jval_t* joptions, const char** error) {
+  iotjs_blehcisocket_report_filter_t* filter =
+      IOTJS_ALLOC(iotjs_blehcisocket_report_filter_t);
+
+  iotjs_jval_t juuids =
+      iotjs_jval_get_property(joptions, IOTJS_MAGIC_STRING_UUIDS);
+  if (iotjs_jval_is_object(&juuids)) {
+    iotjs_jval_t jlength =
+        iotjs_jval_get_property(&juuids, IOTJS_MAGIC_STRING_LENGTH);
+    uint32_t count = iotjs_jval_as_number(&jlength);
+    iotjs_jval_destroy(&jlength);
+
+    if (count > IOTJS_BLEHCISOCKET_UUIDS_MAX) {
+      *error = "Too many UUIDs";
+    }
+
+    for (uint32_t i = 0; i < count && *error == NULL; i++) {
+      iotjs_jval_t juuid = iotjs_jval_get_property_by_index(&juuids, i);
+      iotjs_bufferwrap_t* uuid = iotjs_jval_is_object(&juuid)
+                                     ? iotjs_bufferwrap_from_jbuffer(&juuid)
+                                     : NULL;
+      size_t length = uuid ? iotjs_bufferwrap_length(uuid) : 0;
+
+      if (length != 2 && length != 4 && length != 16) {
+        *error = "Invalid UUID";
+      } else {
+        memcpy(filter->uuids[i], iotjs_bufferwrap_buffer(uuid), length);
+        filter->uuid_lengths[i] = (uint8_t)length;
+        filter->uuid_count++;
+      }
+      iotjs_jval_destroy(&juuid);
+    }
+  }
+  iotjs_jval_destroy(&juuids);
+
+  iotjs_jval_t jrssi =
+      iotjs_jval_get_property(joptions, IOTJS_MAGIC_STRING_RSSI);
+  if (iotjs_jval_is_number(&jrssi)) {
+    filter->has_rssi = true;
+    filter->rssi = (int)iotjs_jval_as_number(&jrssi);
+  }
+  iotjs_jval_destroy(&jrssi);
+
+  iotjs_jval_t jwindow =
+      iotjs_jval_get_property(joptions, IOTJS_MAGIC_STRING_WINDOW);
+  if (iotjs_jval_is_number(&jwindow)) {
+    double window = iotjs_jval_as_number(&jwindow);
+    if (window >= 0) {
+      filter->window = (uint64_t)window;
+    } else {
+      *error = "Invalid window";
+    }
+  }
+  iotjs_jval_destroy(&jwindow);
+
+  if (*error != NULL) {
+    IOTJS_RELEASE(filter);
+    return NULL;
+  }
+  return filter;
+}
+
+
+// setFilter(filter[, reportFilter])
+// `filter` is the kernel filter of HCI packet types and events. The
+// advertising reports the socket decodes are further filtered by
+// `reportFilter`.
 JHANDLER_FUNCTION(SetFilter) {
   JHANDLER_DECLARE_THIS_PTR(blehcisocket, blehcisocket);
   DJHANDLER_CHECK_ARGS(1, object);
+  DJHANDLER_CHECK_ARG_IF_EXIST(1, object);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
+
+  iotjs_blehcisocket_report_filter_t* report_filter = NULL;
+  const iotjs_jval_t* joptions = JHANDLER_GET_ARG_IF_EXIST(1, object);
+  if (joptions != NULL) {
+    const char* error = NULL;
+    report_filter = iotjs_blehcisocket_report_filter(joptions, &error);
+    if (report_filter == NULL) {
+      JHANDLER_THROW(TYPE, error);
+      return;
+    }
+  }
+
+  if (_this->_reportFilter != NULL) {
+    IOTJS_RELEASE(_this->_reportFilter);
+  }
+  _this->_reportFilter = report_filter;
 
   iotjs_bufferwrap_t* buffer =
       iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(0, object));
@@ -41,6 +41,28 @@
 #include "iotjs_objectwrap.h"
 #include "iotjs_reqwrap.h"
 
+// ACL data of a connection being reassembled from fragments.
+typedef struct iotjs_blehcisocket_acl_s iotjs_blehcisocket_acl_t;
+
+#define IOTJS_BLEHCISOCKET_UUIDS_MAX 16
+#define IOTJS_BLEHCISOCKET_SEEN_SIZE 256
+
+// The advertising reports that are decoded: ones advertising one of `uuids`,
+// if any, with a signal of at least `rssi`, and not reported already with
+// the same data within `window` milliseconds.
+typedef struct {
+  uint8_t uuids[IOTJS_BLEHCISOCKET_UUIDS_MAX][16];
+  uint8_t uuid_lengths[IOTJS_BLEHCISOCKET_UUIDS_MAX];
+  int uuid_count;
+  bool has_rssi;
+  int rssi;
+  uint64_t window;
+  struct {
+    uint32_t hash;
+    uint64_t time;
+  } seen[IOTJS_BLEHCISOCKET_SEEN_SIZE];
+} iotjs_blehcisocket_report_filter_t;
+
 typedef struct {
   iotjs_jobjectwrap_t jobjectwrap;
 
@@ -52,6 +74,9 @@ typedef struct {
   int _l2socketCount;
   uint8_t _address[6];
   uint8_t _addressType;
+  bool _decode;
+  iotjs_blehcisocket_acl_t* _acl;
+  iotjs_blehcisocket_report_filter_t* _reportFilter;
 } IOTJS_VALIDATED_STRUCT(iotjs_blehcisocket_t);
 
 
@@ -65,7 +90,7 @@ iotjs_blehcisocket_t* iotjs_blehcisocket_instance_from_jval(
 
 void iotjs_blehcisocket_initialize(THIS);
 void iotjs_blehcisocket_close(THIS);
-void iotjs_blehcisocket_start(THIS);
+void iotjs_blehcisocket_start(THIS, bool decode);
 int iotjs_blehcisocket_bindRaw(THIS, int* devId);
 int iotjs_blehcisocket_bindUser(THIS, int* devId);
 void iotjs_blehcisocket_bindControl(THIS);
@@ -16,7 +16,9 @@
 #include "iotjs_def.h"
 #include "iotjs_module_buffer.h"
 
+#include <float.h>
 #include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -24,6 +26,112 @@
 IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(bufferwrap);
 
 
+// Buffers of up to IOTJS_BUFFER_POOL_THRESHOLD bytes are carved out of slabs,
+// so they cost no allocation of their own. A slab is counted by the buffers
+// in it, and by the pool while new buffers are carved out of it; it is
+// released when the count drops to zero. The threshold is lower than the
+// half slab of node.js, since a long lived buffer keeps the whole slab.
+#ifndef IOTJS_BUFFER_POOL_SLAB_SIZE
+#define IOTJS_BUFFER_POOL_SLAB_SIZE (8 * 1024)
+#endif
+#ifndef IOTJS_BUFFER_POOL_THRESHOLD
+#define IOTJS_BUFFER_POOL_THRESHOLD 1024
+#endif
+#define IOTJS_BUFFER_POOL_ALIGN 8
+
+struct iotjs_buffer_slab_t {
+  size_t refs;
+  size_t used;
+  union {
+    char data[1];
+    double align;
+  } u;
+};
+
+
+static iotjs_buffer_slab_t* iotjs_buffer_pool_slab = NULL;
+
+// Bytes allocated for the memory of buffers, the slabs of the pool included.
+static size_t iotjs_buffer_data_size = 0;
+
+static char* iotjs_buffer_data_allocate(size_t size) {
+  iotjs_buffer_data_size += size;
+  return iotjs_buffer_allocate(size);
+}
+
+
+static void iotjs_buffer_data_release(char* data) {
+  IOTJS_ASSERT(iotjs_buffer_data_size >= iotjs_buffer_size(data));
+  iotjs_buffer_data_size -= iotjs_buffer_size(data);
+  iotjs_buffer_release(data);
+}
+
+
+size_t iotjs_bufferwrap_data_size() {
+  return iotjs_buffer_data_size;
+}
+
+
+static void iotjs_buffer_slab_unref(iotjs_buffer_slab_t* slab) {
+  IOTJS_ASSERT(slab->refs > 0);
+  slab->refs--;
+
+  if (slab->refs == 0) {
+    iotjs_buffer_data_release((char*)slab);
+  } else if (slab->refs == 1 && slab == iotjs_buffer_pool_slab) {
+    // Only the pool holds the slab, so it is carved again from the start.
+    // Its memory is cleared, since new buffers are filled with zeros.
+    memset(slab->u.data, 0, slab->used);
+    slab->used = 0;
+  }
+}
+
+
+// Returns zeroed memory of `length` bytes in the slab of the pool.
+static char* iotjs_buffer_pool_allocate(size_t length,
+                                        iotjs_buffer_slab_t** slab) {
+  size_t size = (length + IOTJS_BUFFER_POOL_ALIGN - 1) &
+                ~(size_t)(IOTJS_BUFFER_POOL_ALIGN - 1);
+
+  iotjs_buffer_slab_t* pool_slab = iotjs_buffer_pool_slab;
+  if (pool_slab == NULL ||
+      pool_slab->used + size > IOTJS_BUFFER_POOL_SLAB_SIZE) {
+    if (pool_slab != NULL) {
+      iotjs_buffer_slab_unref(pool_slab);
+    }
+    pool_slab = (iotjs_buffer_slab_t*)iotjs_buffer_data_allocate(
+        offsetof(iotjs_buffer_slab_t, u) + IOTJS_BUFFER_POOL_SLAB_SIZE);
+    pool_slab->refs = 1;
+    pool_slab->used = 0;
+    iotjs_buffer_pool_slab = pool_slab;
+  }
+
+  char* data = pool_slab->u.data + pool_slab->used;
+  pool_slab->used += size;
+  pool_slab->refs++;
+
+  *slab = pool_slab;
+  return data;
+}
+
+
+// The ArrayBuffer of a buffer in a slab spans the whole slab, and holds a
+// count of it.
+static void iotjs_buffer_slab_release_data(void* data) {
+  iotjs_buffer_slab_unref(
+      (iotjs_buffer_slab_t*)((char*)data - offsetof(iotjs_buffer_slab_t, u)));
+}
+
+
+void iotjs_bufferwrap_pool_cleanup() {
+  if (iotjs_buffer_pool_slab != NULL) {
+    iotjs_buffer_slab_t* slab = iotjs_buffer_pool_slab;
+    iotjs_buffer_pool_slab = NULL;
+    iotjs_buffer_slab_unref(slab);
+  }
+}
+
+
 iotjs_bufferwrap_t* iotjs_bufferwrap_create(const iotjs_jval_t* jbuiltin,
                                             size_t length) {
   iotjs_bufferwrap_t* bufferwrap = IOTJS_ALLOC(iotjs_bufferwrap_t);
@@ -31,14 +139,19 @@ iotjs_bufferwrap_t* iotjs_bufferwrap_create(const iotjs_jval_t* jbuiltin,
 
   iotjs_jobjectwrap_initialize(&_this->jobjectwrap, jbuiltin,
                                &this_module_native_info);
-  if (length > 0) {
+  _this->slab = NULL;
+  if (length > IOTJS_BUFFER_POOL_THRESHOLD) {
     _this->length = length;
-    _this->buffer = iotjs_buffer_allocate(length);
+    _this->buffer = iotjs_buffer_data_allocate(length);
     IOTJS_ASSERT(_this->buffer != NULL);
+  } else if (length > 0) {
+    _this->length = length;
+    _this->buffer = iotjs_buffer_pool_allocate(length, &_this->slab);
   } else {
     _this->length = 0;
     _this->buffer = NULL;
   }
+  _this->shared = false;
 
   IOTJS_ASSERT(
       bufferwrap ==
@@ -48,10 +161,41 @@ iotjs_bufferwrap_t* iotjs_bufferwrap_create(const iotjs_jval_t* jbuiltin,
 }
 
 
+// Create a buffer viewing the memory of an ArrayBuffer. The builtin object
+// refers to the ArrayBuffer, which keeps the memory alive.
+iotjs_bufferwrap_t* iotjs_bufferwrap_create_shared(
+    const iotjs_jval_t* jbuiltin, const iotjs_jval_t* jarraybuffer,
+    size_t byte_offset, size_t length) {
+  IOTJS_ASSERT(byte_offset + length <=
+               iotjs_jval_get_arraybuffer_length(jarraybuffer));
+
+  iotjs_bufferwrap_t* bufferwrap = IOTJS_ALLOC(iotjs_bufferwrap_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_bufferwrap_t, bufferwrap);
+
+  iotjs_jobjectwrap_initialize(&_this->jobjectwrap, jbuiltin,
+                               &this_module_native_info);
+  iotjs_jval_set_property_jval(jbuiltin, IOTJS_MAGIC_STRING__ARRAYBUFFER,
+                               jarraybuffer);
+
+  _this->length = length;
+  _this->buffer = NULL;
+  if (length > 0) {
+    _this->buffer =
+        iotjs_jval_get_arraybuffer_pointer(jarraybuffer) + byte_offset;
+  }
+  _this->shared = true;
+  _this->slab = NULL;
+
+  return bufferwrap;
+}
+
+
 static void iotjs_bufferwrap_destroy(iotjs_bufferwrap_t* bufferwrap) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_bufferwrap_t, bufferwrap);
-  if (_this->buffer != NULL) {
-    iotjs_buffer_release(_this->buffer);
+  if (_this->slab != NULL) {
+    iotjs_buffer_slab_unref(_this->slab);
+  } else if (_this->buffer != NULL && !_this->shared) {
+    iotjs_buffer_data_release(_this->buffer);
   }
   iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
   IOTJS_RELEASE(bufferwrap);
@@ -78,6 +222,20 @@ iotjs_bufferwrap_t* iotjs_bufferwrap_from_jbuffer(const iotjs_jval_t* jbuffer) {
 }
 
 
+iotjs_bufferwrap_t* iotjs_bufferwrap_from_jval(const iotjs_jval_t* jval) {
+  if (!iotjs_jval_is_object(jval)) {
+    return NULL;
+  }
+  iotjs_jval_t jbuiltin =
+      iotjs_jval_get_property(jval, IOTJS_MAGIC_STRING__BUILTIN);
+  iotjs_bufferwrap_t* buffer =
+      (iotjs_bufferwrap_t*)iotjs_jval_get_object_native_handle_of(
+          &jbuiltin, &this_module_native_info);
+  iotjs_jval_destroy(&jbuiltin);
+  return buffer;
+}
+
+
 iotjs_jval_t* iotjs_bufferwrap_jbuiltin(iotjs_bufferwrap_t* bufferwrap) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_bufferwrap_t, bufferwrap);
   return iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
@@ -91,6 +249,62 @@ iotjs_jval_t iotjs_bufferwrap_jbuffer(iotjs_bufferwrap_t* bufferwrap) {
 }
 
 
+static void iotjs_bufferwrap_release_shared(void* buffer) {
+  iotjs_buffer_data_release((char*)buffer);
+}
+
+
+static void iotjs_bufferwrap_release_read_buffer(void* buffer) {
+  iotjs_read_buffer_release((char*)buffer);
+}
+
+
+// Returns the ArrayBuffer sharing the memory of the buffer, or undefined if
+// the engine has no typed arrays. On the first call the memory is handed over
+// to a new ArrayBuffer, which releases it when neither the buffer nor a view
+// of the ArrayBuffer is alive.
+iotjs_jval_t iotjs_bufferwrap_jarraybuffer(iotjs_bufferwrap_t* bufferwrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_bufferwrap_t, bufferwrap);
+
+  iotjs_jval_t* jbuiltin = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
+  iotjs_jval_t jarraybuffer =
+      iotjs_jval_get_property(jbuiltin, IOTJS_MAGIC_STRING__ARRAYBUFFER);
+
+  if (!iotjs_jval_is_arraybuffer_supported() ||
+      iotjs_jval_is_arraybuffer(&jarraybuffer)) {
+    return jarraybuffer;
+  }
+
+  iotjs_jval_destroy(&jarraybuffer);
+
+  if (_this->slab != NULL) {
+    // Like the pool of node.js, the ArrayBuffer of a small buffer is the
+    // whole slab, at the offset of the buffer.
+    _this->slab->refs++;
+    jarraybuffer = iotjs_jval_create_arraybuffer_external(
+        _this->slab->u.data, IOTJS_BUFFER_POOL_SLAB_SIZE,
+        iotjs_buffer_slab_release_data);
+  } else if (_this->shared) {
+    // A slice shares the ArrayBuffer of the buffer owning the memory.
+    iotjs_jval_t jparent =
+        iotjs_jval_get_property(jbuiltin, IOTJS_MAGIC_STRING__PARENT);
+    jarraybuffer =
+        iotjs_bufferwrap_jarraybuffer(iotjs_bufferwrap_from_jbuiltin(&jparent));
+    iotjs_jval_destroy(&jparent);
+  } else {
+    jarraybuffer = iotjs_jval_create_arraybuffer_external(
+        _this->buffer, _this->length,
+        _this->buffer != NULL ? iotjs_bufferwrap_release_shared : NULL);
+    _this->shared = true;
+  }
+
+  iotjs_jval_set_property_jval(jbuiltin, IOTJS_MAGIC_STRING__ARRAYBUFFER,
+                               &jarraybuffer);
+
+  return jarraybuffer;
+}
+
+
 char* iotjs_bufferwrap_buffer(iotjs_bufferwrap_t* bufferwrap) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_bufferwrap_t, bufferwrap);
   return _this->buffer;
@@ -112,6 +326,49 @@ size_t iotjs_bufferwrap_length(iotjs_bufferwrap_t* bufferwrap) {
 }
 
 
+// Turns the empty buffer `view` into a view of `length` bytes of `parent` at
+// `offset`. The view keeps the memory alive: it counts the slab of a small
+// buffer, and otherwise refers to the ArrayBuffer or the buffer owning the
+// memory, so that views of views do not form chains.
+static void iotjs_bufferwrap_view(iotjs_bufferwrap_t* view,
+                                  iotjs_bufferwrap_t* parent, size_t offset,
+                                  size_t length) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_bufferwrap_t, view);
+  IOTJS_ASSERT(_this->buffer == NULL);
+
+  iotjs_bufferwrap_t_impl_t* parent_this = &parent->unsafe;
+  iotjs_jval_t* jbuiltin = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
+  iotjs_jval_t* jparent_builtin =
+      iotjs_jobjectwrap_jobject(&parent_this->jobjectwrap);
+
+  _this->buffer = parent_this->buffer + offset;
+  _this->length = length;
+  _this->shared = true;
+
+  if (parent_this->slab != NULL) {
+    _this->slab = parent_this->slab;
+    _this->slab->refs++;
+    return;
+  }
+
+  iotjs_jval_t jarraybuffer =
+      iotjs_jval_get_property(jparent_builtin, IOTJS_MAGIC_STRING__ARRAYBUFFER);
+  if (iotjs_jval_is_arraybuffer(&jarraybuffer)) {
+    iotjs_jval_set_property_jval(jbuiltin, IOTJS_MAGIC_STRING__ARRAYBUFFER,
+                                 &jarraybuffer);
+  } else if (parent_this->shared) {
+    iotjs_jval_t jowner =
+        iotjs_jval_get_property(jparent_builtin, IOTJS_MAGIC_STRING__PARENT);
+    iotjs_jval_set_property_jval(jbuiltin, IOTJS_MAGIC_STRING__PARENT, &jowner);
+    iotjs_jval_destroy(&jowner);
+  } else {
+    iotjs_jval_set_property_jval(jbuiltin, IOTJS_MAGIC_STRING__PARENT,
+                                 jparent_builtin);
+  }
+  iotjs_jval_destroy(&jarraybuffer);
+}
+
+
 static size_t bound_range(size_t index, size_t low, size_t upper) {
   if (index == SIZE_MAX) {
     return low;
@@ -135,6 +392,8 @@ static int8_t hex2bin(char c) {
 }
 
 
+// Decodes the hex digits of `src` into at most `len` bytes of `buf`, up to
+// the first pair with a non hex digit.
 static size_t hex_decode(char* buf, size_t len, const char* src,
                          const size_t srcLen) {
   size_t i;
@@ -142,15 +401,161 @@ static size_t hex_decode(char* buf, size_t len, const char* src,
   for (i = 0; i < len && i * 2 + 1 < srcLen; ++i) {
     int8_t a = hex2bin(src[i * 2 + 0]);
     int8_t b = hex2bin(src[i * 2 + 1]);
-    if (a == -1 || b == -1)
+    if ((a | b) < 0)
       return i;
-    buf[i] = (a << 4) | b;
+    buf[i] = (char)((a << 4) | b);
   }
 
   return i;
 }
 
 
+static size_t hex_encode(char* dst, const char* src, size_t len) {
+  static const char digits[] = "0123456789abcdef";
+
+  for (size_t i = 0; i < len; i++) {
+    uint8_t byte = (uint8_t)src[i];
+    dst[i * 2 + 0] = digits[byte >> 4];
+    dst[i * 2 + 1] = digits[byte & 0xF];
+  }
+
+  return len * 2;
+}
+
+
+// The values of the base64 digits, of both the standard and the URL safe
+// alphabet, and -1 for other characters.
+static const int8_t base64_values[256] = {
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, 62, -1, 63,
+  52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+  -1, 0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,
+  15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, 63,
+  -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+  41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+
+// The number of bytes the base64 text `src` decodes to. Like node.js, other
+// characters such as line breaks are skipped, and the text ends at '='.
+static size_t base64_decoded_size(const char* src, size_t src_len) {
+  size_t digits = 0;
+
+  for (size_t i = 0; i < src_len && src[i] != '='; i++) {
+    if (base64_values[(uint8_t)src[i]] >= 0) {
+      digits++;
+    }
+  }
+
+  return digits * 3 / 4;
+}
+
+
+// Decodes the base64 text `src` into at most `len` bytes of `buf`. Groups of
+// four digits are decoded at once until a character that is not a digit,
+// after which the digits are collected one by one.
+static size_t base64_decode(char* buf, size_t len, const char* src,
+                            size_t src_len) {
+  const uint8_t* in = (const uint8_t*)src;
+  size_t i = 0;
+  size_t n = 0;
+
+  while (i + 4 <= src_len && n + 3 <= len) {
+    int32_t a = base64_values[in[i]];
+    int32_t b = base64_values[in[i + 1]];
+    int32_t c = base64_values[in[i + 2]];
+    int32_t d = base64_values[in[i + 3]];
+    if ((a | b | c | d) < 0) {
+      break;
+    }
+
+    uint32_t bits = (uint32_t)(a << 18 | b << 12 | c << 6 | d);
+    buf[n++] = (char)(bits >> 16);
+    buf[n++] = (char)(bits >> 8);
+    buf[n++] = (char)bits;
+    i += 4;
+  }
+
+  uint32_t bits = 0;
+  unsigned count = 0;
+  for (; i < src_len && n < len && src[i] != '='; i++) {
+    int8_t value = base64_values[in[i]];
+    if (value < 0) {
+      continue;
+    }
+
+    bits = (bits << 6) | (uint8_t)value;
+    if (++count == 4) {
+      buf[n++] = (char)(bits >> 16);
+      if (n < len) {
+        buf[n++] = (char)(bits >> 8);
+      }
+      if (n < len) {
+        buf[n++] = (char)bits;
+      }
+      bits = 0;
+      count = 0;
+    }
+  }
+
+  // A last group of two or three digits holds one or two bytes.
+  if (count >= 2 && n < len) {
+    bits <<= 6 * (4 - count);
+    buf[n++] = (char)(bits >> 16);
+    if (count == 3 && n < len) {
+      buf[n++] = (char)(bits >> 8);
+    }
+  }
+
+  return n;
+}
+
+
+static size_t base64_encode(char* dst, const char* src, size_t len) {
+  static const char digits[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const uint8_t* in = (const uint8_t*)src;
+  size_t i = 0;
+  size_t n = 0;
+
+  for (; i + 3 <= len; i += 3) {
+    uint32_t bits =
+        (uint32_t)in[i] << 16 | (uint32_t)in[i + 1] << 8 | in[i + 2];
+    dst[n++] = digits[bits >> 18];
+    dst[n++] = digits[bits >> 12 & 0x3F];
+    dst[n++] = digits[bits >> 6 & 0x3F];
+    dst[n++] = digits[bits & 0x3F];
+  }
+
+  if (i < len) {
+    uint32_t bits = (uint32_t)in[i] << 16;
+    if (i + 1 < len) {
+      bits |= (uint32_t)in[i + 1] << 8;
+    }
+    dst[n++] = digits[bits >> 18];
+    dst[n++] = digits[bits >> 12 & 0x3F];
+    dst[n++] = i + 1 < len ? digits[bits >> 6 & 0x3F] : '=';
+    dst[n++] = '=';
+  }
+
+  return n;
+}
+
+
+static size_t base64_encoded_size(size_t len) {
+  return (len + 2) / 3 * 4;
+}
+
+
 static size_t iotjs_convert_double_to_sizet(double value) {
   size_t new_value;
 
@@ -171,20 +576,15 @@ int iotjs_bufferwrap_compare(const iotjs_bufferwrap_t* bufferwrap,
   const char* other_buffer = other->unsafe.buffer;
   size_t other_length = other->unsafe.length;
 
-  size_t i = 0;
-  size_t j = 0;
-  while (i < _this->length && j < other_length) {
-    if (_this->buffer[i] < other_buffer[j]) {
-      return -1;
-    } else if (_this->buffer[i] > other_buffer[j]) {
-      return 1;
-    }
-    ++i;
-    ++j;
+  size_t length = _this->length < other_length ? _this->length : other_length;
+  int result = length > 0 ? memcmp(_this->buffer, other_buffer, length) : 0;
+  if (result != 0) {
+    return result < 0 ? -1 : 1;
   }
-  if (j < other_length) {
+
+  if (_this->length < other_length) {
     return -1;
-  } else if (i < _this->length) {
+  } else if (_this->length > other_length) {
     return 1;
   }
   return 0;
@@ -194,13 +594,17 @@ size_t iotjs_bufferwrap_copy_internal(iotjs_bufferwrap_t* bufferwrap,
                                       const char* src, size_t src_from,
                                       size_t src_to, size_t dst_from) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_bufferwrap_t, bufferwrap);
-  size_t copied = 0;
-  size_t dst_length = _this->length;
-  for (size_t i = src_from, j = dst_from; i < src_to && j < dst_length;
-       ++i, ++j) {
-    *(_this->buffer + j) = *(src + i);
-    ++copied;
+  if (src_from >= src_to || dst_from >= _this->length) {
+    return 0;
   }
+
+  size_t copied = src_to - src_from;
+  if (copied > _this->length - dst_from) {
+    copied = _this->length - dst_from;
+  }
+
+  // The source may be a slice of the same memory.
+  memmove(_this->buffer + dst_from, src + src_from, copied);
   return copied;
 }
 
@@ -233,6 +637,78 @@ iotjs_jval_t iotjs_bufferwrap_create_buffer(size_t len) {
 }
 
 
+iotjs_jval_t iotjs_bufferwrap_create_view(iotjs_bufferwrap_t* bufferwrap,
+                                          size_t offset, size_t length) {
+  IOTJS_ASSERT(offset + length <= iotjs_bufferwrap_length(bufferwrap));
+
+  // The view starts as an empty buffer, which has no memory of its own.
+  iotjs_jval_t jview = iotjs_bufferwrap_create_buffer(0);
+  if (length > 0) {
+    iotjs_bufferwrap_view(iotjs_bufferwrap_from_jbuffer(&jview), bufferwrap,
+                          offset, length);
+    iotjs_jval_set_property_number(&jview, IOTJS_MAGIC_STRING_LENGTH, length);
+  }
+
+  return jview;
+}
+
+
+iotjs_jval_t iotjs_bufferwrap_create_buffer_external(char* data, size_t len,
+                                                     JFreeHandlerType free_cb) {
+  if (!iotjs_jval_is_arraybuffer_supported()) {
+    iotjs_jval_t jres = iotjs_bufferwrap_create_buffer(len);
+    iotjs_bufferwrap_t* bufferwrap = iotjs_bufferwrap_from_jbuffer(&jres);
+    iotjs_bufferwrap_copy(bufferwrap, data, len);
+    if (free_cb != NULL) {
+      free_cb(data);
+    }
+    return jres;
+  }
+
+  iotjs_jval_t* jglobal = iotjs_jval_get_global_object();
+
+  iotjs_jval_t jbuffer =
+      iotjs_jval_get_property(jglobal, IOTJS_MAGIC_STRING_BUFFER);
+  IOTJS_ASSERT(iotjs_jval_is_function(&jbuffer));
+
+  iotjs_jval_t jarraybuffer =
+      iotjs_jval_create_arraybuffer_external(data, len, free_cb);
+
+  iotjs_jargs_t jargs = iotjs_jargs_create(1);
+  iotjs_jargs_append_jval(&jargs, &jarraybuffer);
+
+  iotjs_jval_t jres =
+      iotjs_jhelper_call_ok(&jbuffer, iotjs_jval_get_undefined(), &jargs);
+  IOTJS_ASSERT(iotjs_jval_is_object(&jres));
+
+  iotjs_jargs_destroy(&jargs);
+  iotjs_jval_destroy(&jarraybuffer);
+  iotjs_jval_destroy(&jbuffer);
+
+  return jres;
+}
+
+
+iotjs_jval_t iotjs_bufferwrap_adopt_buffer(char* data, size_t size,
+                                           size_t len) {
+  IOTJS_ASSERT(len <= size);
+
+  if (len <= size / 4) {
+    iotjs_jval_t jres = iotjs_bufferwrap_create_buffer(len);
+    if (len > 0) {
+      iotjs_bufferwrap_t* bufferwrap = iotjs_bufferwrap_from_jbuffer(&jres);
+      iotjs_bufferwrap_copy(bufferwrap, data, len);
+    }
+    iotjs_read_buffer_release(data);
+    return jres;
+  }
+
+  return iotjs_bufferwrap_create_buffer_external(
+      data, len, iotjs_bufferwrap_release_read_buffer);
+}
+
+
+// new bufferBuiltin(buffer, length[, arrayBuffer, byteOffset])
 JHANDLER_FUNCTION(Buffer) {
   DJHANDLER_CHECK_THIS(object);
   DJHANDLER_CHECK_ARGS(2, object, number);
@@ -243,7 +719,22 @@ JHANDLER_FUNCTION(Buffer) {
 
   iotjs_jval_set_property_jval(jbuiltin, IOTJS_MAGIC_STRING__BUFFER, jbuffer);
 
-  iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_create(jbuiltin, length);
+  iotjs_bufferwrap_t* buffer_wrap;
+  if (iotjs_jhandler_get_arg_length(jhandler) >= 4) {
+    DJHANDLER_CHECK_ARGS(4, object, number, object, number);
+    const iotjs_jval_t* jarraybuffer = JHANDLER_GET_ARG(2, object);
+    JHANDLER_CHECK(iotjs_jval_is_arraybuffer(jarraybuffer));
+
+    size_t byte_offset = JHANDLER_GET_ARG(3, number);
+    size_t byte_length = iotjs_jval_get_arraybuffer_length(jarraybuffer);
+    JHANDLER_CHECK(byte_offset <= byte_length &&
+                   length <= byte_length - byte_offset);
+
+    buffer_wrap = iotjs_bufferwrap_create_shared(jbuiltin, jarraybuffer,
+                                                 byte_offset, length);
+  } else {
+    buffer_wrap = iotjs_bufferwrap_create(jbuiltin, length);
+  }
   IOTJS_UNUSED(buffer_wrap);
 }
 
@@ -293,7 +784,9 @@ JHANDLER_FUNCTION(Write) {
   JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
   DJHANDLER_CHECK_ARGS(3, string, number, number);
 
-  iotjs_string_t src = JHANDLER_GET_ARG(0, string);
+  // The characters are copied straight out of the engine.
+  iotjs_string_view_t src =
+      iotjs_jval_as_string_view(iotjs_jhandler_get_arg(jhandler, 0));
 
   size_t buffer_length = iotjs_bufferwrap_length(buffer_wrap);
   size_t offset = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(1, number));
@@ -301,15 +794,15 @@ JHANDLER_FUNCTION(Write) {
 
   size_t length = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(2, number));
   length = bound_range(length, 0, buffer_length - offset);
-  length = bound_range(length, 0, iotjs_string_size(&src));
+  length = bound_range(length, 0, iotjs_string_view_size(&src));
 
-  const char* src_data = iotjs_string_data(&src);
+  const char* src_data = iotjs_string_view_data(&src);
   size_t copied =
       iotjs_bufferwrap_copy_internal(buffer_wrap, src_data, 0, length, offset);
 
   iotjs_jhandler_return_number(jhandler, copied);
 
-  iotjs_string_destroy(&src);
+  iotjs_string_view_destroy(&src);
 }
 
 
@@ -337,7 +830,8 @@ JHANDLER_FUNCTION(HexWrite) {
   JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
   DJHANDLER_CHECK_ARGS(3, string, number, number);
 
-  iotjs_string_t src = JHANDLER_GET_ARG(0, string);
+  iotjs_string_view_t src =
+      iotjs_jval_as_string_view(iotjs_jhandler_get_arg(jhandler, 0));
 
   size_t buffer_length = iotjs_bufferwrap_length(buffer_wrap);
   size_t offset = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(1, number));
@@ -346,19 +840,203 @@ JHANDLER_FUNCTION(HexWrite) {
   size_t length = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(2, number));
   length = bound_range(length, 0, buffer_length - offset);
 
-  const char* src_data = iotjs_string_data(&src);
-  unsigned src_length = iotjs_string_size(&src);
-  char* src_buf = iotjs_buffer_allocate(length);
+  const char* src_data = iotjs_string_view_data(&src);
+  size_t src_length = iotjs_string_view_size(&src);
+  char* buffer = iotjs_bufferwrap_buffer(buffer_wrap);
 
-  size_t nbytes = hex_decode(src_buf, length, src_data, src_length);
+  size_t copied = 0;
+  if (buffer != NULL) {
+    copied = hex_decode(buffer + offset, length, src_data, src_length);
+  }
 
-  size_t copied =
-      iotjs_bufferwrap_copy_internal(buffer_wrap, src_buf, 0, nbytes, offset);
+  iotjs_jhandler_return_number(jhandler, copied);
+
+  iotjs_string_view_destroy(&src);
+}
+
+
+JHANDLER_FUNCTION(Base64Write) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+  DJHANDLER_CHECK_ARGS(3, string, number, number);
+
+  iotjs_string_view_t src =
+      iotjs_jval_as_string_view(iotjs_jhandler_get_arg(jhandler, 0));
+
+  size_t buffer_length = iotjs_bufferwrap_length(buffer_wrap);
+  size_t offset = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(1, number));
+  offset = bound_range(offset, 0, buffer_length);
+
+  size_t length = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(2, number));
+  length = bound_range(length, 0, buffer_length - offset);
+
+  char* buffer = iotjs_bufferwrap_buffer(buffer_wrap);
+
+  size_t copied = 0;
+  if (buffer != NULL) {
+    copied = base64_decode(buffer + offset, length,
+                           iotjs_string_view_data(&src),
+                           iotjs_string_view_size(&src));
+  }
 
   iotjs_jhandler_return_number(jhandler, copied);
 
-  iotjs_buffer_release(src_buf);
-  iotjs_string_destroy(&src);
+  iotjs_string_view_destroy(&src);
+}
+
+
+// fill(value, start, end)
+// `value` is a byte, or a buffer whose contents are repeated.
+JHANDLER_FUNCTION(Fill) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+  JHANDLER_CHECK(iotjs_jhandler_get_arg_length(jhandler) >= 3);
+  DJHANDLER_CHECK_ARG(1, number);
+  DJHANDLER_CHECK_ARG(2, number);
+
+  size_t buffer_length = iotjs_bufferwrap_length(buffer_wrap);
+  size_t start = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(1, number));
+  start = bound_range(start, 0, buffer_length);
+
+  size_t end = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(2, number));
+  end = bound_range(end, 0, buffer_length);
+
+  char* buffer = iotjs_bufferwrap_buffer(buffer_wrap);
+  if (buffer == NULL || end <= start) {
+    return;
+  }
+
+  const iotjs_jval_t* jvalue = iotjs_jhandler_get_arg(jhandler, 0);
+  if (iotjs_jval_is_number(jvalue)) {
+    uint8_t byte = (uint8_t)iotjs_jval_as_number(jvalue);
+    memset(buffer + start, byte, end - start);
+    return;
+  }
+
+  JHANDLER_CHECK(iotjs_jval_is_object(jvalue));
+  iotjs_bufferwrap_t* pattern_wrap = iotjs_bufferwrap_from_jbuiltin(jvalue);
+  size_t pattern_length = iotjs_bufferwrap_length(pattern_wrap);
+  if (pattern_length == 0) {
+    return;
+  }
+
+  // The pattern is copied once, then the filled part doubles with each copy.
+  size_t length = end - start;
+  size_t filled = pattern_length < length ? pattern_length : length;
+  memmove(buffer + start, iotjs_bufferwrap_buffer(pattern_wrap), filled);
+
+  while (filled < length) {
+    size_t chunk = filled < length - filled ? filled : length - filled;
+    memcpy(buffer + start + filled, buffer + start, chunk);
+    filled += chunk;
+  }
+}
+
+
+// Finds `needle` in `buffer` from `offset`, or returns NULL. Candidates are
+// found by the first byte with memchr(), which is usually much faster than
+// comparing at every position.
+static const char* iotjs_buffer_find(const char* buffer, size_t length,
+                                     size_t offset, const char* needle,
+                                     size_t needle_length) {
+  if (buffer == NULL || needle_length > length - offset) {
+    return NULL;
+  }
+
+  const char* last = buffer + length - needle_length;
+  const char* p = buffer + offset;
+  while (p <= last) {
+    p = (const char*)memchr(p, needle[0], (size_t)(last - p) + 1);
+    if (p == NULL) {
+      break;
+    }
+    if (memcmp(p + 1, needle + 1, needle_length - 1) == 0) {
+      return p;
+    }
+    p++;
+  }
+
+  return NULL;
+}
+
+
+// indexOf(value, byteOffset)
+// `value` is a byte or a buffer. Returns -1 if it is not found.
+JHANDLER_FUNCTION(IndexOf) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+  JHANDLER_CHECK(iotjs_jhandler_get_arg_length(jhandler) >= 2);
+  DJHANDLER_CHECK_ARG(1, number);
+
+  size_t buffer_length = iotjs_bufferwrap_length(buffer_wrap);
+  size_t offset = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(1, number));
+  offset = bound_range(offset, 0, buffer_length);
+
+  const char* buffer = iotjs_bufferwrap_buffer(buffer_wrap);
+  const iotjs_jval_t* jvalue = iotjs_jhandler_get_arg(jhandler, 0);
+
+  const char* needle;
+  size_t needle_length;
+  char byte;
+  if (iotjs_jval_is_number(jvalue)) {
+    byte = (char)(uint8_t)iotjs_jval_as_number(jvalue);
+    needle = &byte;
+    needle_length = 1;
+  } else {
+    JHANDLER_CHECK(iotjs_jval_is_object(jvalue));
+    iotjs_bufferwrap_t* needle_wrap = iotjs_bufferwrap_from_jbuiltin(jvalue);
+    needle = iotjs_bufferwrap_buffer(needle_wrap);
+    needle_length = iotjs_bufferwrap_length(needle_wrap);
+  }
+
+  if (needle_length == 0) {
+    // Like node.js, an empty value is found at the offset.
+    iotjs_jhandler_return_number(jhandler, offset);
+    return;
+  }
+
+  const char* found = iotjs_buffer_find(buffer, buffer_length, offset, needle,
+                                        needle_length);
+  if (found != NULL) {
+    iotjs_jhandler_return_number(jhandler, (size_t)(found - buffer));
+  } else {
+    iotjs_jhandler_return_number(jhandler, -1);
+  }
+}
+
+
+// split(delimiter, start)
+// Returns the frames of the buffer from `start` which are ended by
+// `delimiter`, a non-empty buffer, as views of the buffer without the
+// delimiters. The bytes after the last delimiter are left.
+JHANDLER_FUNCTION(Split) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+  DJHANDLER_CHECK_ARGS(2, object, number);
+
+  size_t buffer_length = iotjs_bufferwrap_length(buffer_wrap);
+  size_t offset = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(1, number));
+  offset = bound_range(offset, 0, buffer_length);
+
+  const char* buffer = iotjs_bufferwrap_buffer(buffer_wrap);
+  iotjs_bufferwrap_t* delimiter_wrap =
+      iotjs_bufferwrap_from_jbuiltin(JHANDLER_GET_ARG(0, object));
+  const char* delimiter = iotjs_bufferwrap_buffer(delimiter_wrap);
+  size_t delimiter_length = iotjs_bufferwrap_length(delimiter_wrap);
+  JHANDLER_CHECK(delimiter_length > 0);
+
+  iotjs_jval_t jframes = iotjs_jval_create_array(0);
+  uint32_t count = 0;
+  size_t start = offset;
+  const char* found;
+  while ((found = iotjs_buffer_find(buffer, buffer_length, offset, delimiter,
+                                    delimiter_length)) != NULL) {
+    size_t end = (size_t)(found - buffer);
+    iotjs_jval_t jframe =
+        iotjs_bufferwrap_create_view(buffer_wrap, start, end - start);
+    iotjs_jval_set_property_by_index(&jframes, count++, &jframe);
+    iotjs_jval_destroy(&jframe);
+    start = offset = end + delimiter_length;
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jframes);
+  iotjs_jval_destroy(&jframes);
 }
 
 
@@ -381,6 +1059,303 @@ JHANDLER_FUNCTION(ReadUInt8) {
 }
 
 
+// The types of the numbers `readNumber`, `writeNumber`, `readArray` and
+// `writeArray` work on, in the order of NUMBER_TYPES in buffer.js.
+typedef enum {
+  kBufferInt8 = 0,
+  kBufferUInt8,
+  kBufferInt16LE,
+  kBufferInt16BE,
+  kBufferUInt16LE,
+  kBufferUInt16BE,
+  kBufferInt32LE,
+  kBufferInt32BE,
+  kBufferUInt32LE,
+  kBufferUInt32BE,
+  kBufferFloatLE,
+  kBufferFloatBE,
+  kBufferDoubleLE,
+  kBufferDoubleBE,
+  kBufferNumberTypeCount
+} iotjs_buffer_number_type_t;
+
+
+typedef struct {
+  uint8_t size;
+  bool is_signed;
+  bool is_float;
+  bool is_big_endian;
+} iotjs_buffer_number_info_t;
+
+
+static const iotjs_buffer_number_info_t
+    iotjs_buffer_number_infos[kBufferNumberTypeCount] = {
+      { 1, true, false, false },  { 1, false, false, false },
+      { 2, true, false, false },  { 2, true, false, true },
+      { 2, false, false, false }, { 2, false, false, true },
+      { 4, true, false, false },  { 4, true, false, true },
+      { 4, false, false, false }, { 4, false, false, true },
+      { 4, true, true, false },   { 4, true, true, true },
+      { 8, true, true, false },   { 8, true, true, true },
+    };
+
+
+static const iotjs_buffer_number_info_t* iotjs_buffer_number_info(
+    double type) {
+  if (!(type >= 0 && type < kBufferNumberTypeCount)) {
+    return NULL;
+  }
+  return &iotjs_buffer_number_infos[(int)type];
+}
+
+
+// Whether `count` numbers of `size` bytes from `offset` are in the buffer.
+static bool iotjs_buffer_number_fits(iotjs_bufferwrap_t* bufferwrap,
+                                     size_t offset, size_t size,
+                                     size_t count) {
+  size_t length = iotjs_bufferwrap_length(bufferwrap);
+  return offset <= length && count <= (length - offset) / size;
+}
+
+
+// The bytes are put together by shifting, so that neither the alignment nor
+// the byte order of the host matters.
+static double iotjs_buffer_read_number(const uint8_t* data,
+                                       const iotjs_buffer_number_info_t* info) {
+  uint64_t bits = 0;
+  for (size_t i = 0; i < info->size; i++) {
+    bits = (bits << 8) |
+           data[info->is_big_endian ? i : (size_t)(info->size - 1 - i)];
+  }
+
+  if (info->is_float) {
+    if (info->size == 4) {
+      uint32_t bits32 = (uint32_t)bits;
+      float value;
+      memcpy(&value, &bits32, sizeof(value));
+      return value;
+    }
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  if (info->is_signed) {
+    uint64_t sign = (uint64_t)1 << (info->size * 8 - 1);
+    return (double)(int64_t)((bits ^ sign) - sign);
+  }
+  return (double)bits;
+}
+
+
+static void iotjs_buffer_write_number(uint8_t* data,
+                                      const iotjs_buffer_number_info_t* info,
+                                      double value) {
+  uint64_t bits = 0;
+  if (info->is_float) {
+    if (info->size == 4) {
+      float value32;
+      if (value > FLT_MAX) {
+        value32 = INFINITY;
+      } else if (value < -FLT_MAX) {
+        value32 = -INFINITY;
+      } else {
+        value32 = (float)value;
+      }
+      uint32_t bits32;
+      memcpy(&bits32, &value32, sizeof(bits32));
+      bits = bits32;
+    } else {
+      memcpy(&bits, &value, sizeof(bits));
+    }
+  } else if (value < 0 && value > -9223372036854775808.0) {
+    // Only the low bytes are written, like `value & 0xff` does.
+    bits = (uint64_t)(int64_t)value;
+  } else if (value >= 0 && value < 18446744073709551616.0) {
+    bits = (uint64_t)value;
+  }
+
+  for (size_t i = 0; i < info->size; i++) {
+    data[info->is_big_endian ? (size_t)(info->size - 1 - i) : i] =
+        (uint8_t)(bits >> (8 * i));
+  }
+}
+
+
+// Whether `value` is in the range of the integer type, as checkInt() of
+// buffer.js checked it. NaN is in range, and written as 0.
+static bool iotjs_buffer_number_in_range(const iotjs_buffer_number_info_t* info,
+                                         double value) {
+  if (info->is_float) {
+    return true;
+  }
+  double range = (double)((uint64_t)1 << (info->size * 8));
+  double min = info->is_signed ? -range / 2 : 0;
+  double max = info->is_signed ? range / 2 - 1 : range - 1;
+  return !(value > max || value < min);
+}
+
+
+static double iotjs_buffer_element_number(const iotjs_jval_t* jvalues,
+                                          uint32_t index) {
+  iotjs_jval_t jvalue = iotjs_jval_get_property_by_index(jvalues, index);
+  double value = iotjs_jval_is_number(&jvalue) ? iotjs_jval_as_number(&jvalue)
+                                               : NAN;
+  iotjs_jval_destroy(&jvalue);
+  return value;
+}
+
+
+// readNumber(type, offset, noAssert)
+JHANDLER_FUNCTION(ReadNumber) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+  DJHANDLER_CHECK_ARGS(3, number, number, boolean);
+
+  const iotjs_buffer_number_info_t* info =
+      iotjs_buffer_number_info(JHANDLER_GET_ARG(0, number));
+  JHANDLER_CHECK(info != NULL);
+  size_t offset = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(1, number));
+
+  const uint8_t* data = (const uint8_t*)iotjs_bufferwrap_buffer(buffer_wrap);
+
+  if (!iotjs_buffer_number_fits(buffer_wrap, offset, info->size, 1)) {
+    if (!JHANDLER_GET_ARG(2, boolean)) {
+      JHANDLER_THROW(RANGE, "index out of range");
+      return;
+    }
+    // The bytes after the end of the buffer are read as 0.
+    uint8_t bytes[8] = { 0 };
+    size_t length = iotjs_bufferwrap_length(buffer_wrap);
+    if (offset < length) {
+      memcpy(bytes, data + offset, length - offset);
+    }
+    iotjs_jhandler_return_number(jhandler,
+                                 iotjs_buffer_read_number(bytes, info));
+    return;
+  }
+
+  iotjs_jhandler_return_number(jhandler,
+                               iotjs_buffer_read_number(data + offset, info));
+}
+
+
+// writeNumber(type, value, offset, noAssert)
+// Returns the offset after the written number.
+JHANDLER_FUNCTION(WriteNumber) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+  DJHANDLER_CHECK_ARGS(4, number, number, number, boolean);
+
+  const iotjs_buffer_number_info_t* info =
+      iotjs_buffer_number_info(JHANDLER_GET_ARG(0, number));
+  JHANDLER_CHECK(info != NULL);
+  double value = JHANDLER_GET_ARG(1, number);
+  double joffset = JHANDLER_GET_ARG(2, number);
+  size_t offset = iotjs_convert_double_to_sizet(joffset);
+  bool no_assert = JHANDLER_GET_ARG(3, boolean);
+
+  if (!no_assert && !iotjs_buffer_number_in_range(info, value)) {
+    JHANDLER_THROW(TYPE, "value is out of bounds");
+    return;
+  }
+
+  if (iotjs_buffer_number_fits(buffer_wrap, offset, info->size, 1)) {
+    uint8_t* data = (uint8_t*)iotjs_bufferwrap_buffer(buffer_wrap);
+    iotjs_buffer_write_number(data + offset, info, value);
+  } else if (!no_assert) {
+    JHANDLER_THROW(RANGE, "index out of range");
+    return;
+  }
+
+  iotjs_jhandler_return_number(jhandler, joffset + info->size);
+}
+
+
+// readArray(type, offset, count[, target])
+// Reads `count` numbers from `offset` into `target`, an array or a typed
+// array, from its index 0, or into a new array. Returns the array.
+JHANDLER_FUNCTION(ReadArray) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+  DJHANDLER_CHECK_ARGS(3, number, number, number);
+  DJHANDLER_CHECK_ARG_IF_EXIST(3, object);
+
+  const iotjs_buffer_number_info_t* info =
+      iotjs_buffer_number_info(JHANDLER_GET_ARG(0, number));
+  JHANDLER_CHECK(info != NULL);
+  size_t offset = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(1, number));
+  size_t count = iotjs_convert_double_to_sizet(JHANDLER_GET_ARG(2, number));
+
+  if (!iotjs_buffer_number_fits(buffer_wrap, offset, info->size, count)) {
+    JHANDLER_THROW(RANGE, "index out of range");
+    return;
+  }
+
+  const iotjs_jval_t* jtarget = JHANDLER_GET_ARG_IF_EXIST(3, object);
+  iotjs_jval_t jarray = jtarget != NULL
+                            ? iotjs_jval_create_copied(jtarget)
+                            : iotjs_jval_create_array((uint32_t)count);
+
+  const uint8_t* data = (const uint8_t*)iotjs_bufferwrap_buffer(buffer_wrap);
+  for (size_t i = 0; i < count; i++) {
+    iotjs_jval_t jnumber = iotjs_jval_create_number(
+        iotjs_buffer_read_number(data + offset + i * info->size, info));
+    iotjs_jval_set_property_by_index(&jarray, (uint32_t)i, &jnumber);
+    iotjs_jval_destroy(&jnumber);
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jarray);
+  iotjs_jval_destroy(&jarray);
+}
+
+
+// writeArray(type, values, offset, noAssert)
+// Writes the numbers of `values`, an array or a typed array, from `offset`.
+// Returns the offset after the last written number.
+JHANDLER_FUNCTION(WriteArray) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+  DJHANDLER_CHECK_ARGS(4, number, object, number, boolean);
+
+  const iotjs_buffer_number_info_t* info =
+      iotjs_buffer_number_info(JHANDLER_GET_ARG(0, number));
+  JHANDLER_CHECK(info != NULL);
+  const iotjs_jval_t* jvalues = JHANDLER_GET_ARG(1, object);
+  double joffset = JHANDLER_GET_ARG(2, number);
+  size_t offset = iotjs_convert_double_to_sizet(joffset);
+  bool no_assert = JHANDLER_GET_ARG(3, boolean);
+
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jvalues, IOTJS_MAGIC_STRING_LENGTH);
+  size_t count = iotjs_jval_is_number(&jlength)
+                     ? iotjs_convert_double_to_sizet(
+                           iotjs_jval_as_number(&jlength))
+                     : 0;
+  iotjs_jval_destroy(&jlength);
+  if (count == SIZE_MAX) {
+    count = 0;
+  }
+
+  if (!iotjs_buffer_number_fits(buffer_wrap, offset, info->size, count)) {
+    if (!no_assert) {
+      JHANDLER_THROW(RANGE, "index out of range");
+      return;
+    }
+    // Only the numbers which fit are written.
+    size_t length = iotjs_bufferwrap_length(buffer_wrap);
+    count = offset < length ? (length - offset) / info->size : 0;
+  }
+
+  uint8_t* data = (uint8_t*)iotjs_bufferwrap_buffer(buffer_wrap);
+  for (size_t i = 0; i < count; i++) {
+    double value = iotjs_buffer_element_number(jvalues, (uint32_t)i);
+    if (!no_assert && !iotjs_buffer_number_in_range(info, value)) {
+      JHANDLER_THROW(TYPE, "value is out of bounds");
+      return;
+    }
+    iotjs_buffer_write_number(data + offset + i * info->size, info, value);
+  }
+
+  iotjs_jhandler_return_number(jhandler, joffset + count * info->size);
+}
+
 JHANDLER_FUNCTION(Slice) {
   JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
   DJHANDLER_CHECK_ARGS(2, number, number);
@@ -419,12 +1394,8 @@ JHANDLER_FUNCTION(Slice) {
 
   size_t length = (size_t)(end_idx - start_idx);
 
-  iotjs_jval_t jnew_buffer = iotjs_bufferwrap_create_buffer(length);
-  iotjs_bufferwrap_t* new_buffer_wrap =
-      iotjs_bufferwrap_from_jbuffer(&jnew_buffer);
-  iotjs_bufferwrap_copy_internal(new_buffer_wrap,
-                                 iotjs_bufferwrap_buffer(buffer_wrap),
-                                 start_idx, end_idx, 0);
+  iotjs_jval_t jnew_buffer =
+      iotjs_bufferwrap_create_view(buffer_wrap, start_idx, length);
 
   iotjs_jhandler_return_jval(jhandler, &jnew_buffer);
   iotjs_jval_destroy(&jnew_buffer);
@@ -449,11 +1420,21 @@ JHANDLER_FUNCTION(ToString) {
 
   const char* data = iotjs_bufferwrap_buffer(buffer_wrap) + start;
   length = strnlen(data, length);
-  iotjs_string_t str = iotjs_string_create_with_size(data, length);
 
-  iotjs_jhandler_return_string(jhandler, &str);
+  if (length < IOTJS_STRING_INLINE_SIZE) {
+    iotjs_string_t str = iotjs_string_create_with_size(data, length);
+    iotjs_jhandler_return_string(jhandler, &str);
+    iotjs_string_destroy(&str);
+    return;
+  }
+
+  // A long text is copied once, and is kept off the engine heap.
+  char* buffer = iotjs_buffer_allocate(length);
+  memcpy(buffer, data, length);
 
-  iotjs_string_destroy(&str);
+  iotjs_jval_t str = iotjs_jval_create_string_external(buffer, length);
+  iotjs_jhandler_return_jval(jhandler, &str);
+  iotjs_jval_destroy(&str);
 }
 
 
@@ -461,21 +1442,81 @@ JHANDLER_FUNCTION(ToHexString) {
   JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
 
   size_t length = iotjs_bufferwrap_length(buffer_wrap);
+  if (length == 0) {
+    // An empty buffer may have no memory.
+    iotjs_jhandler_return_string_raw(jhandler, "");
+    return;
+  }
+
   const char* data = iotjs_bufferwrap_buffer(buffer_wrap);
   JHANDLER_CHECK(data != NULL);
 
   char* buffer = iotjs_buffer_allocate(length * 2);
-  iotjs_string_t str = iotjs_string_create_with_buffer(buffer, length * 2);
+  size_t size = hex_encode(buffer, data, length);
+
+  iotjs_jval_t str = iotjs_jval_create_string_external(buffer, size);
+  iotjs_jhandler_return_jval(jhandler, &str);
+  iotjs_jval_destroy(&str);
+}
+
+
+JHANDLER_FUNCTION(ToBase64String) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+
+  size_t length = iotjs_bufferwrap_length(buffer_wrap);
+  if (length == 0) {
+    // An empty buffer may have no memory.
+    iotjs_jhandler_return_string_raw(jhandler, "");
+    return;
+  }
+
+  const char* data = iotjs_bufferwrap_buffer(buffer_wrap);
+  JHANDLER_CHECK(data != NULL);
+
+  char* buffer = iotjs_buffer_allocate(base64_encoded_size(length));
+  size_t size = base64_encode(buffer, data, length);
+
+  iotjs_jval_t str = iotjs_jval_create_string_external(buffer, size);
+  iotjs_jhandler_return_jval(jhandler, &str);
+  iotjs_jval_destroy(&str);
+}
+
+
+JHANDLER_FUNCTION(ArrayBuffer) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+
+  iotjs_jval_t jarraybuffer = iotjs_bufferwrap_jarraybuffer(buffer_wrap);
+  iotjs_jhandler_return_jval(jhandler, &jarraybuffer);
+  iotjs_jval_destroy(&jarraybuffer);
+}
 
-  for (size_t i = 0; i < length; i++) {
-    memcpy(buffer, &"0123456789abcdef"[data[i] >> 4 & 0xF], 1);
-    buffer++;
-    memcpy(buffer, &"0123456789abcdef"[data[i] >> 0 & 0xF], 1);
-    buffer++;
+
+JHANDLER_FUNCTION(ByteOffset) {
+  JHANDLER_DECLARE_THIS_PTR(bufferwrap, buffer_wrap);
+
+  iotjs_jval_t* jbuiltin = iotjs_bufferwrap_jbuiltin(buffer_wrap);
+  iotjs_jval_t jarraybuffer =
+      iotjs_jval_get_property(jbuiltin, IOTJS_MAGIC_STRING__ARRAYBUFFER);
+  size_t byte_offset = 0;
+
+  char* buffer = iotjs_bufferwrap_buffer(buffer_wrap);
+  if (buffer != NULL && iotjs_jval_is_arraybuffer(&jarraybuffer)) {
+    byte_offset =
+        (size_t)(buffer - iotjs_jval_get_arraybuffer_pointer(&jarraybuffer));
   }
 
-  iotjs_jhandler_return_string(jhandler, &str);
-  iotjs_string_destroy(&str);
+  iotjs_jhandler_return_number(jhandler, byte_offset);
+  iotjs_jval_destroy(&jarraybuffer);
+}
+
+
+JHANDLER_FUNCTION(IsArrayBuffer) {
+  DJHANDLER_CHECK_THIS(object);
+
+  bool is_arraybuffer =
+      iotjs_jhandler_get_arg_length(jhandler) > 0 &&
+      iotjs_jval_is_arraybuffer(iotjs_jhandler_get_arg(jhandler, 0));
+  iotjs_jhandler_return_boolean(jhandler, is_arraybuffer);
 }
 
 
@@ -483,12 +1524,24 @@ JHANDLER_FUNCTION(ByteLength) {
   DJHANDLER_CHECK_THIS(object);
   DJHANDLER_CHECK_ARGS(1, string);
 
-  iotjs_string_t str = JHANDLER_GET_ARG(0, string);
-  iotjs_jval_t size = iotjs_jval_get_string_size(&str);
+  // The size is asked of the engine, the string is not copied.
+  size_t size = iotjs_jval_string_size(iotjs_jhandler_get_arg(jhandler, 0));
+
+  iotjs_jhandler_return_number(jhandler, size);
+}
+
+
+JHANDLER_FUNCTION(Base64ByteLength) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_view_t str =
+      iotjs_jval_as_string_view(iotjs_jhandler_get_arg(jhandler, 0));
+  size_t size = base64_decoded_size(iotjs_string_view_data(&str),
+                                    iotjs_string_view_size(&str));
 
-  iotjs_jhandler_return_jval(jhandler, &size);
-  iotjs_string_destroy(&str);
-  iotjs_jval_destroy(&size);
+  iotjs_jhandler_return_number(jhandler, size);
+  iotjs_string_view_destroy(&str);
 }
 
 
@@ -498,25 +1551,51 @@ iotjs_jval_t InitBuffer() {
   iotjs_jval_t prototype = iotjs_jval_create_object();
   iotjs_jval_t byte_length =
       iotjs_jval_create_function_with_dispatch(ByteLength);
+  iotjs_jval_t is_arraybuffer =
+      iotjs_jval_create_function_with_dispatch(IsArrayBuffer);
+  iotjs_jval_t base64_byte_length =
+      iotjs_jval_create_function_with_dispatch(Base64ByteLength);
 
   iotjs_jval_set_property_jval(&buffer, IOTJS_MAGIC_STRING_PROTOTYPE,
                                &prototype);
   iotjs_jval_set_property_jval(&buffer, IOTJS_MAGIC_STRING_BYTELENGTH,
                                &byte_length);
+  iotjs_jval_set_property_jval(&buffer, IOTJS_MAGIC_STRING_ISARRAYBUFFER,
+                               &is_arraybuffer);
+  iotjs_jval_set_property_jval(&buffer, IOTJS_MAGIC_STRING_BASE64BYTELENGTH,
+                               &base64_byte_length);
 
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_COMPARE, Compare);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_COPY, Copy);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITE, Write);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_HEXWRITE, HexWrite);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_BASE64WRITE,
+                        Base64Write);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_FILL, Fill);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_INDEXOF, IndexOf);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITEUINT8, WriteUInt8);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READUINT8, ReadUInt8);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READNUMBER,
+                        ReadNumber);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITENUMBER,
+                        WriteNumber);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READARRAY, ReadArray);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITEARRAY, WriteArray);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SLICE, Slice);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SPLIT, Split);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_TOSTRING, ToString);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_TOHEXSTRING,
                         ToHexString);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_TOBASE64STRING,
+                        ToBase64String);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_ARRAYBUFFER,
+                        ArrayBuffer);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_BYTEOFFSET, ByteOffset);
 
   iotjs_jval_destroy(&prototype);
   iotjs_jval_destroy(&byte_length);
+  iotjs_jval_destroy(&is_arraybuffer);
+  iotjs_jval_destroy(&base64_byte_length);
 
   return buffer;
 }
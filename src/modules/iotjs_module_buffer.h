@@ -20,22 +20,36 @@
 #include "iotjs_objectwrap.h"
 
 
+typedef struct iotjs_buffer_slab_t iotjs_buffer_slab_t;
+
+
 typedef struct {
   iotjs_jobjectwrap_t jobjectwrap;
   char* buffer;
   size_t length;
+  // The memory is owned by the ArrayBuffer, or the buffer of a slice,
+  // referred by the builtin object.
+  bool shared;
+  // The memory is a part of this slab, shared with other small buffers.
+  iotjs_buffer_slab_t* slab;
 } IOTJS_VALIDATED_STRUCT(iotjs_bufferwrap_t);
 
 
 iotjs_bufferwrap_t* iotjs_bufferwrap_create(const iotjs_jval_t* jbuiltin,
                                             size_t length);
+iotjs_bufferwrap_t* iotjs_bufferwrap_create_shared(
+    const iotjs_jval_t* jbuiltin, const iotjs_jval_t* jarraybuffer,
+    size_t byte_offset, size_t length);
 
 iotjs_bufferwrap_t* iotjs_bufferwrap_from_jbuiltin(
     const iotjs_jval_t* jbuiltin);
 iotjs_bufferwrap_t* iotjs_bufferwrap_from_jbuffer(const iotjs_jval_t* jbuffer);
+// The bufferwrap of `jval` if it is a Buffer, and NULL otherwise.
+iotjs_bufferwrap_t* iotjs_bufferwrap_from_jval(const iotjs_jval_t* jval);
 
 iotjs_jval_t* iotjs_bufferwrap_jbuiltin(iotjs_bufferwrap_t* bufferwrap);
 iotjs_jval_t iotjs_bufferwrap_jbuffer(iotjs_bufferwrap_t* bufferwrap);
+iotjs_jval_t iotjs_bufferwrap_jarraybuffer(iotjs_bufferwrap_t* bufferwrap);
 
 char* iotjs_bufferwrap_buffer(iotjs_bufferwrap_t* bufferwrap);
 size_t iotjs_bufferwrap_length(iotjs_bufferwrap_t* bufferwrap);
@@ -49,5 +63,30 @@ size_t iotjs_bufferwrap_copy(iotjs_bufferwrap_t* bufferwrap, const char* src,
 // Create buffer object.
 iotjs_jval_t iotjs_bufferwrap_create_buffer(size_t len);
 
+// Bytes allocated for the memory of buffers, the slabs of the pool included.
+size_t iotjs_bufferwrap_data_size();
+
+// Create buffer object sharing `length` bytes of the memory of `bufferwrap`
+// at `offset`, as Buffer.prototype.slice does.
+iotjs_jval_t iotjs_bufferwrap_create_view(iotjs_bufferwrap_t* bufferwrap,
+                                          size_t offset, size_t length);
+
+// Create buffer object over memory allocated by native code, e.g. a DMA
+// buffer, without copying it. `free_cb` is called with `data` when neither
+// the buffer nor a view of its ArrayBuffer is alive. If the engine has no
+// typed arrays, the data is copied and released at once.
+iotjs_jval_t iotjs_bufferwrap_create_buffer_external(char* data, size_t len,
+                                                     JFreeHandlerType free_cb);
+
+// Create buffer object taking over `data` of `size` bytes allocated by
+// iotjs_read_buffer_allocate, of which the first `len` bytes are used. Data
+// using a small part of the memory is copied, so that the memory goes back to
+// the pool at once.
+iotjs_jval_t iotjs_bufferwrap_adopt_buffer(char* data, size_t size, size_t len);
+
+// Releases the slab small buffers are carved out of. Called after
+// jerry_cleanup(), when no buffer is alive.
+void iotjs_bufferwrap_pool_cleanup();
+
 
 #endif /* IOTJS_MODULE_BUFFER_H */
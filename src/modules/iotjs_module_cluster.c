@@ -0,0 +1,848 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "iotjs_def.h"
+#include "iotjs_module_buffer.h"
+#include "iotjs_module_cluster.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+extern char** environ;
+
+
+// Descriptors a worker may inherit besides its channel.
+#define IOTJS_CLUSTER_MAX_INHERIT 4
+
+
+IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(clusterworker);
+
+
+static void iotjs_clusterworker_on_poll(uv_poll_t* handle, int status,
+                                        int events);
+
+
+iotjs_clusterworker_t* iotjs_clusterworker_create(const iotjs_jval_t* jworker,
+                                                  int pid, int fd) {
+  iotjs_clusterworker_t* worker = IOTJS_ALLOC(iotjs_clusterworker_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_clusterworker_t, worker);
+
+  iotjs_handlewrap_initialize(&_this->handlewrap, jworker,
+                              (uv_handle_t*)(&_this->handle),
+                              &this_module_native_info);
+
+  _this->pid = pid;
+  _this->fd = fd;
+
+  const iotjs_environment_t* env = iotjs_environment_get();
+  uv_poll_init(iotjs_environment_loop(env), &_this->handle, fd);
+  uv_poll_start(&_this->handle, UV_READABLE, iotjs_clusterworker_on_poll);
+
+  return worker;
+}
+
+
+static void iotjs_clusterworker_destroy(iotjs_clusterworker_t* worker) {
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_clusterworker_t, worker);
+  iotjs_handlewrap_destroy(&_this->handlewrap);
+
+  if (_this->fd >= 0) {
+    close(_this->fd);
+  }
+
+  IOTJS_RELEASE(worker);
+}
+
+
+iotjs_clusterworker_t* iotjs_clusterworker_from_handle(uv_poll_t* handle) {
+  iotjs_handlewrap_t* handlewrap =
+      iotjs_handlewrap_from_handle((uv_handle_t*)handle);
+  return (iotjs_clusterworker_t*)handlewrap;
+}
+
+
+iotjs_jval_t* iotjs_clusterworker_jobject(iotjs_clusterworker_t* worker) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_clusterworker_t, worker);
+  return iotjs_handlewrap_jobject(&_this->handlewrap);
+}
+
+
+// The read end of the pipe became readable: the worker has exited, unless it
+// wrote into the pipe, which it is not meant to.
+static void iotjs_clusterworker_on_exit(iotjs_clusterworker_t* worker) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_clusterworker_t, worker);
+
+  char buffer[16];
+  ssize_t n = read(_this->fd, buffer, sizeof(buffer));
+  if (n > 0 || (n < 0 && (errno == EAGAIN || errno == EINTR))) {
+    return;
+  }
+
+  int status = 0;
+  while (waitpid(_this->pid, &status, 0) < 0 && errno == EINTR) {
+  }
+
+  uv_poll_stop(&_this->handle);
+  close(_this->fd);
+  _this->fd = -1;
+
+  int code = WIFEXITED(status) ? WEXITSTATUS(status) : 0;
+  int signum = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+
+  // onexit(code, signal)
+  const iotjs_jval_t* jworker = iotjs_handlewrap_jobject(&_this->handlewrap);
+  iotjs_jval_t jcallback =
+      iotjs_jval_get_property(jworker, IOTJS_MAGIC_STRING_ONEXIT);
+  if (iotjs_jval_is_function(&jcallback)) {
+    iotjs_jargs_t jargs = iotjs_jargs_create(2);
+    iotjs_jargs_append_number(&jargs, code);
+    iotjs_jargs_append_number(&jargs, signum);
+    iotjs_make_callback(&jcallback, jworker, &jargs);
+    iotjs_jargs_destroy(&jargs);
+  }
+  iotjs_jval_destroy(&jcallback);
+}
+
+
+static void iotjs_clusterworker_on_poll(uv_poll_t* handle, int status,
+                                        int events) {
+  iotjs_clusterworker_on_exit(iotjs_clusterworker_from_handle(handle));
+}
+
+
+// Copies a JS array of strings into a NULL terminated array.
+static char** iotjs_cluster_strings_create(const iotjs_jval_t* jarray,
+                                           uint32_t* count) {
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jarray, IOTJS_MAGIC_STRING_LENGTH);
+  *count = iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+
+  char** strings = (char**)iotjs_buffer_allocate((*count + 1) * sizeof(char*));
+  for (uint32_t i = 0; i < *count; i++) {
+    iotjs_jval_t jstring = iotjs_jval_get_property_by_index(jarray, i);
+    iotjs_string_t string = iotjs_jval_as_string(&jstring);
+    size_t size = iotjs_string_size(&string);
+    strings[i] = iotjs_buffer_allocate(size + 1);
+    memcpy(strings[i], iotjs_string_data(&string), size);
+    iotjs_string_destroy(&string);
+    iotjs_jval_destroy(&jstring);
+  }
+
+  return strings;
+}
+
+
+static void iotjs_cluster_strings_destroy(char** strings, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    iotjs_buffer_release(strings[i]);
+  }
+  iotjs_buffer_release((char*)strings);
+}
+
+
+// Whether `variable` sets one of the names set by `env`.
+static bool iotjs_cluster_env_overridden(const char* variable, char** env) {
+  for (; *env != NULL; env++) {
+    const char* separator = strchr(*env, '=');
+    size_t length = separator ? (size_t)(separator - *env + 1) : strlen(*env);
+    if (!strncmp(variable, *env, length)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// Starts the iotjs executable again with `argv`, and the variables of `env`
+// added to the environment. With `channel`, the worker also gets one end of
+// a socket pair, whose descriptor is in IOTJS_CHANNEL_FD; the other end is
+// stored in `channel_fd`. The descriptors of `inherit`, which are closed on
+// exec in this process, are kept open in the worker. Returns the pid of the
+// worker, or a negative errno.
+static int iotjs_cluster_spawn(char** argv, char** env, bool channel,
+                               const int* inherit, uint32_t inherit_count,
+                               int* fd, int* channel_fd) {
+#if defined(__NUTTX__) || defined(__TIZENRT__)
+  // No processes to start on these.
+  return -ENOSYS;
+#else
+  int fds[2];
+  int sockets[2] = { -1, -1 };
+
+  if (channel && socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) < 0) {
+    return -errno;
+  }
+
+  if (pipe(fds) < 0) {
+    int err = -errno;
+    if (channel) {
+      close(sockets[0]);
+      close(sockets[1]);
+    }
+    return err;
+  }
+
+  // Only the write end of the pipe and the worker's end of the socket pair
+  // are inherited by the worker.
+  fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+  fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+  if (channel) {
+    fcntl(sockets[0], F_SETFD, FD_CLOEXEC);
+  }
+
+  // Everything the child needs is prepared before forking, since only
+  // async-signal-safe calls may be made between fork() and exec().
+  char channel_variable[sizeof(IOTJS_CHANNEL_FD_ENV) + 12];
+  snprintf(channel_variable, sizeof(channel_variable), "%s=%d",
+           IOTJS_CHANNEL_FD_ENV, sockets[1]);
+
+  size_t count = 0;
+  while (environ[count] != NULL) {
+    count++;
+  }
+  for (char** variable = env; *variable != NULL; variable++) {
+    count++;
+  }
+
+  char** envp = (char**)iotjs_buffer_allocate((count + 2) * sizeof(char*));
+  size_t envc = 0;
+  for (char** variable = environ; *variable != NULL; variable++) {
+    if (!iotjs_cluster_env_overridden(*variable, env) &&
+        strncmp(*variable, IOTJS_CHANNEL_FD_ENV "=",
+                strlen(IOTJS_CHANNEL_FD_ENV "="))) {
+      envp[envc++] = *variable;
+    }
+  }
+  for (char** variable = env; *variable != NULL; variable++) {
+    envp[envc++] = *variable;
+  }
+  if (channel) {
+    envp[envc++] = channel_variable;
+  }
+  envp[envc] = NULL;
+
+  int pid = fork();
+  if (pid == 0) {
+    for (uint32_t i = 0; i < inherit_count; i++) {
+      fcntl(inherit[i], F_SETFD, 0);
+    }
+    execve("/proc/self/exe", argv, envp);
+    execve(argv[0], argv, envp);
+    _exit(127);
+  }
+
+  int err = -errno;
+  close(fds[1]);
+  if (channel) {
+    close(sockets[1]);
+  }
+  iotjs_buffer_release((char*)envp);
+
+  if (pid < 0) {
+    close(fds[0]);
+    if (channel) {
+      close(sockets[0]);
+    }
+    return err;
+  }
+
+  *fd = fds[0];
+  *channel_fd = sockets[0];
+  return pid;
+#endif
+}
+
+
+// worker.spawn(argv, env[, channel[, inheritFds]])
+JHANDLER_FUNCTION(Spawn) {
+  JHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(2, object, object);
+
+  const iotjs_jval_t* jworker = JHANDLER_GET_THIS(object);
+  const iotjs_jval_t* jchannel = JHANDLER_GET_ARG_IF_EXIST(2, boolean);
+  bool channel = jchannel != NULL && iotjs_jval_as_boolean(jchannel);
+  const iotjs_jval_t* jinherit = JHANDLER_GET_ARG_IF_EXIST(3, object);
+
+  int inherit[IOTJS_CLUSTER_MAX_INHERIT];
+  uint32_t inherit_count = 0;
+  if (jinherit != NULL) {
+    iotjs_jval_t jlength =
+        iotjs_jval_get_property(jinherit, IOTJS_MAGIC_STRING_LENGTH);
+    uint32_t length = iotjs_jval_as_number(&jlength);
+    iotjs_jval_destroy(&jlength);
+
+    for (; inherit_count < length && inherit_count < IOTJS_CLUSTER_MAX_INHERIT;
+         inherit_count++) {
+      iotjs_jval_t jfd = iotjs_jval_get_property_by_index(jinherit,
+                                                          inherit_count);
+      inherit[inherit_count] = iotjs_jval_as_number(&jfd);
+      iotjs_jval_destroy(&jfd);
+    }
+  }
+
+  uint32_t argc;
+  uint32_t envc;
+  char** argv = iotjs_cluster_strings_create(JHANDLER_GET_ARG(0, object),
+                                             &argc);
+  char** env = iotjs_cluster_strings_create(JHANDLER_GET_ARG(1, object),
+                                            &envc);
+
+  int fd = -1;
+  int channel_fd = -1;
+  int pid = argc > 0
+                ? iotjs_cluster_spawn(argv, env, channel, inherit,
+                                      inherit_count, &fd, &channel_fd)
+                : -EINVAL;
+
+  iotjs_cluster_strings_destroy(argv, argc);
+  iotjs_cluster_strings_destroy(env, envc);
+
+  if (pid < 0) {
+    iotjs_jhandler_return_number(jhandler, pid);
+    return;
+  }
+
+  iotjs_clusterworker_create(jworker, pid, fd);
+  iotjs_jval_set_property_number(jworker, IOTJS_MAGIC_STRING_PID, pid);
+  if (channel) {
+    iotjs_jval_set_property_number(jworker, IOTJS_MAGIC_STRING_CHANNELFD,
+                                   channel_fd);
+  }
+
+  iotjs_jhandler_return_number(jhandler, 0);
+}
+
+
+// worker.kill(signal)
+JHANDLER_FUNCTION(Kill) {
+  JHANDLER_DECLARE_THIS_PTR(clusterworker, worker);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_clusterworker_t, worker);
+  int signum = JHANDLER_GET_ARG(0, number);
+
+  int err = 0;
+  if (_this->fd < 0) {
+    err = -ESRCH;
+  } else if (kill(_this->pid, signum) < 0) {
+    err = -errno;
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+JHANDLER_FUNCTION(Close) {
+  JHANDLER_DECLARE_THIS_PTR(handlewrap, wrap);
+  DJHANDLER_CHECK_ARGS(0);
+
+  iotjs_handlewrap_close(wrap, NULL);
+}
+
+
+// Shared rings between a worker and its parent. A message is a record of its
+// length and type, 32 bits each, followed by the payload, with the record
+// padded to 8 bytes. A record does not wrap around: where it does not fit
+// before the end of the data, the rest of the data is skipped with a padding
+// record.
+#define IOTJS_RING_MIN_CAPACITY 4096
+#define IOTJS_RING_MAX_CAPACITY (1 << 30)
+#define IOTJS_RING_RECORD_HEADER_SIZE 8
+#define IOTJS_RING_PADDING 0xffffffff
+
+
+static void iotjs_sharedring_destroy(iotjs_sharedring_t* ring);
+IOTJS_DEFINE_NATIVE_HANDLE_INFO(sharedring);
+
+
+static void iotjs_sharedring_on_poll(uv_poll_t* handle, int status,
+                                     int events);
+
+
+static size_t iotjs_ring_size(uint32_t capacity) {
+  return sizeof(iotjs_ring_t) + capacity;
+}
+
+
+static uint32_t iotjs_ring_record_size(size_t length) {
+  return (uint32_t)((IOTJS_RING_RECORD_HEADER_SIZE + length + 7) & ~(size_t)7);
+}
+
+
+// Appends a message, if there is room for it.
+static bool iotjs_ring_push(iotjs_ring_t* ring, uint32_t type,
+                            const char* data, size_t length) {
+  uint32_t capacity = ring->capacity;
+  uint32_t record_size = iotjs_ring_record_size(length);
+  uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+  uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST);
+
+  uint32_t offset = head & (capacity - 1);
+  uint32_t skip = capacity - offset < record_size ? capacity - offset : 0;
+  if (capacity - (head - tail) < skip + record_size) {
+    return false;
+  }
+
+  if (skip > 0) {
+    uint32_t padding[2] = { 0, IOTJS_RING_PADDING };
+    memcpy(ring->data + offset, padding, sizeof(padding));
+    head += skip;
+    offset = 0;
+  }
+
+  uint32_t header[2] = { (uint32_t)length, type };
+  memcpy(ring->data + offset, header, sizeof(header));
+  memcpy(ring->data + offset + IOTJS_RING_RECORD_HEADER_SIZE, data, length);
+
+  // The message is visible to the consumer once the head is past it.
+  __atomic_store_n(&ring->head, head + record_size, __ATOMIC_SEQ_CST);
+  return true;
+}
+
+
+// Wakes the other side up. A full socket already holds a pending signal.
+static void iotjs_sharedring_signal(iotjs_sharedring_t* ring) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  char signal = 0;
+  while (write(_this->fd, &signal, 1) < 0 && errno == EINTR) {
+  }
+}
+
+
+// Frees the received messages up to `tail` for the producer, and signals
+// the producer if it waits for room.
+static void iotjs_sharedring_consume(iotjs_sharedring_t* ring, uint32_t tail) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  __atomic_store_n(&_this->rx->tail, tail, __ATOMIC_SEQ_CST);
+  if (__atomic_exchange_n(&_this->rx->producer_blocked, 0, __ATOMIC_SEQ_CST)) {
+    iotjs_sharedring_signal(ring);
+  }
+}
+
+
+static int iotjs_sharedring_memory_fd(size_t size) {
+  int fd = -1;
+#ifdef SYS_memfd_create
+  // MFD_CLOEXEC
+  fd = syscall(SYS_memfd_create, "iotjs-ring", 1);
+#endif
+  if (fd < 0) {
+    char path[] = "/tmp/iotjs-ring-XXXXXX";
+    fd = mkstemp(path);
+    if (fd >= 0) {
+      unlink(path);
+      fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+  }
+
+  if (fd >= 0 && ftruncate(fd, (off_t)size) < 0) {
+    close(fd);
+    fd = -1;
+  }
+  return fd;
+}
+
+
+static iotjs_sharedring_t* iotjs_sharedring_create(const iotjs_jval_t* jring,
+                                                   void* memory, size_t size,
+                                                   int fd) {
+  iotjs_sharedring_t* ring = IOTJS_ALLOC(iotjs_sharedring_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_sharedring_t, ring);
+
+  iotjs_handlewrap_initialize(&_this->handlewrap, jring,
+                              (uv_handle_t*)(&_this->handle),
+                              &sharedring_native_info);
+
+  _this->memory = memory;
+  _this->size = size;
+  _this->fd = fd;
+  _this->peer_fds[0] = -1;
+  _this->peer_fds[1] = -1;
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  const iotjs_environment_t* env = iotjs_environment_get();
+  uv_poll_init(iotjs_environment_loop(env), &_this->handle, fd);
+  uv_poll_start(&_this->handle, UV_READABLE, iotjs_sharedring_on_poll);
+
+  return ring;
+}
+
+
+static void iotjs_sharedring_destroy(iotjs_sharedring_t* ring) {
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_sharedring_t, ring);
+  iotjs_handlewrap_destroy(&_this->handlewrap);
+
+  munmap(_this->memory, _this->size);
+  close(_this->fd);
+  for (int i = 0; i < 2; i++) {
+    if (_this->peer_fds[i] >= 0) {
+      close(_this->peer_fds[i]);
+    }
+  }
+
+  IOTJS_RELEASE(ring);
+}
+
+
+// Drains the signals of the other side, and calls ring.onsignal(), which
+// reads the messages received and writes the queued ones.
+static void iotjs_sharedring_on_poll(uv_poll_t* handle, int status,
+                                     int events) {
+  iotjs_sharedring_t* ring =
+      (iotjs_sharedring_t*)iotjs_handlewrap_from_handle((uv_handle_t*)handle);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  char buffer[64];
+  ssize_t n;
+  while ((n = read(_this->fd, buffer, sizeof(buffer))) > 0 ||
+         (n < 0 && errno == EINTR)) {
+  }
+  // The other side is gone; the messages it left are still read.
+  if (n == 0) {
+    uv_poll_stop(&_this->handle);
+  }
+
+  const iotjs_jval_t* jring = iotjs_handlewrap_jobject(&_this->handlewrap);
+  iotjs_jval_t jonsignal =
+      iotjs_jval_get_property(jring, IOTJS_MAGIC_STRING_ONSIGNAL);
+  if (iotjs_jval_is_function(&jonsignal)) {
+    iotjs_make_callback(&jonsignal, jring, iotjs_jargs_get_empty());
+  }
+  iotjs_jval_destroy(&jonsignal);
+}
+
+
+#define SHAREDRING_DECLARE_THIS(name)                              \
+  iotjs_sharedring_t* name = (iotjs_sharedring_t*)                 \
+      iotjs_jval_get_object_from_jhandler(jhandler,                \
+                                          &sharedring_native_info); \
+  if (!name) {                                                     \
+    return;                                                        \
+  }
+
+
+// new SharedRing(capacity) creates the rings in a parent, and
+// new SharedRing(memoryFd, signalFd) maps the rings of a worker, from the
+// descriptors of ring.peerFds in its parent.
+JHANDLER_FUNCTION(SharedRing) {
+  DJHANDLER_CHECK_THIS(object);
+  const iotjs_jval_t* jring = JHANDLER_GET_THIS(object);
+
+  bool is_worker = iotjs_jhandler_get_arg_length(jhandler) >= 2;
+  int memory_fd = -1;
+  int fds[2] = { -1, -1 };
+  uint32_t capacity = IOTJS_RING_MIN_CAPACITY;
+  size_t size = 0;
+
+  if (!is_worker) {
+    DJHANDLER_CHECK_ARGS(1, number);
+    double requested = JHANDLER_GET_ARG(0, number);
+    while (capacity < requested && capacity < IOTJS_RING_MAX_CAPACITY) {
+      capacity *= 2;
+    }
+    size = 2 * iotjs_ring_size(capacity);
+
+    memory_fd = iotjs_sharedring_memory_fd(size);
+    if (memory_fd < 0 || socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+      if (memory_fd >= 0) {
+        close(memory_fd);
+      }
+      JHANDLER_THROW(COMMON, "Failed to create a shared ring");
+      return;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+  } else {
+    DJHANDLER_CHECK_ARGS(2, number, number);
+    memory_fd = JHANDLER_GET_ARG(0, number);
+    fds[0] = JHANDLER_GET_ARG(1, number);
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+    struct stat st;
+    if (fstat(memory_fd, &st) == 0) {
+      size = (size_t)st.st_size;
+    }
+  }
+
+  void* memory = MAP_FAILED;
+  if (size > 0) {
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, memory_fd, 0);
+  }
+
+  bool valid = memory != MAP_FAILED;
+  if (valid && is_worker) {
+    capacity = ((iotjs_ring_t*)memory)->capacity;
+    valid = capacity >= IOTJS_RING_MIN_CAPACITY &&
+            capacity <= IOTJS_RING_MAX_CAPACITY &&
+            (capacity & (capacity - 1)) == 0 &&
+            size == 2 * iotjs_ring_size(capacity);
+  }
+
+  if (!valid) {
+    if (memory != MAP_FAILED) {
+      munmap(memory, size);
+    }
+    close(memory_fd);
+    close(fds[0]);
+    if (fds[1] >= 0) {
+      close(fds[1]);
+    }
+    JHANDLER_THROW(COMMON, "Failed to map a shared ring");
+    return;
+  }
+
+  iotjs_sharedring_t* ring = iotjs_sharedring_create(jring, memory, size,
+                                                     fds[0]);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  iotjs_ring_t* first = (iotjs_ring_t*)memory;
+  iotjs_ring_t* second = (iotjs_ring_t*)((uint8_t*)memory +
+                                         iotjs_ring_size(capacity));
+
+  if (is_worker) {
+    close(memory_fd);
+    _this->tx = second;
+    _this->rx = first;
+    return;
+  }
+
+  // The memory is zeroed. Both consumers start out waiting.
+  first->capacity = second->capacity = capacity;
+  first->consumer_waiting = second->consumer_waiting = 1;
+  _this->tx = first;
+  _this->rx = second;
+
+  _this->peer_fds[0] = memory_fd;
+  _this->peer_fds[1] = fds[1];
+
+  iotjs_jval_t jpeer_fds = iotjs_jval_create_array(2);
+  for (uint32_t i = 0; i < 2; i++) {
+    iotjs_jval_t jfd = iotjs_jval_create_number(_this->peer_fds[i]);
+    iotjs_jval_set_property_by_index(&jpeer_fds, i, &jfd);
+    iotjs_jval_destroy(&jfd);
+  }
+  iotjs_jval_set_property_jval(jring, IOTJS_MAGIC_STRING_PEERFDS, &jpeer_fds);
+  iotjs_jval_destroy(&jpeer_fds);
+}
+
+
+// ring.write(type, buffer) appends a message for the other side, and returns
+// false if there is no room for it. The message is then to be written again
+// on the next signal.
+JHANDLER_FUNCTION(SharedRingWrite) {
+  SHAREDRING_DECLARE_THIS(ring);
+  DJHANDLER_CHECK_ARGS(2, number, object);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  uint32_t type = JHANDLER_GET_ARG(0, number);
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(1, object));
+  const char* data = iotjs_bufferwrap_buffer(buffer_wrap);
+  size_t length = iotjs_bufferwrap_length(buffer_wrap);
+
+  // Any message fits into the empty ring, whatever its head is.
+  iotjs_ring_t* tx = _this->tx;
+  if (type == IOTJS_RING_PADDING ||
+      length > tx->capacity / 2 - IOTJS_RING_RECORD_HEADER_SIZE) {
+    JHANDLER_THROW(RANGE, "Message is too large for the shared ring");
+    return;
+  }
+
+  bool written = iotjs_ring_push(tx, type, data, length);
+  if (!written) {
+    // Checked again after the flag is set, as the consumer may have made room
+    // in between without seeing it.
+    __atomic_store_n(&tx->producer_blocked, 1, __ATOMIC_SEQ_CST);
+    written = iotjs_ring_push(tx, type, data, length);
+    if (written) {
+      __atomic_store_n(&tx->producer_blocked, 0, __ATOMIC_SEQ_CST);
+    }
+  }
+
+  if (written &&
+      __atomic_exchange_n(&tx->consumer_waiting, 0, __ATOMIC_SEQ_CST)) {
+    iotjs_sharedring_signal(ring);
+  }
+
+  iotjs_jhandler_return_boolean(jhandler, written);
+}
+
+
+// ring.drain(callback) calls callback(type, buffer) for each message
+// received, until there are none.
+JHANDLER_FUNCTION(SharedRingDrain) {
+  SHAREDRING_DECLARE_THIS(ring);
+  DJHANDLER_CHECK_ARGS(1, function);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG(0, function);
+  iotjs_ring_t* rx = _this->rx;
+  uint32_t capacity = rx->capacity;
+
+  for (;;) {
+    uint32_t tail = __atomic_load_n(&rx->tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&rx->head, __ATOMIC_SEQ_CST);
+
+    if (head == tail) {
+      // Checked again after the flag is set, as the producer may have added
+      // a message in between without seeing it.
+      __atomic_store_n(&rx->consumer_waiting, 1, __ATOMIC_SEQ_CST);
+      if (__atomic_load_n(&rx->head, __ATOMIC_SEQ_CST) == tail) {
+        break;
+      }
+      __atomic_store_n(&rx->consumer_waiting, 0, __ATOMIC_SEQ_CST);
+      continue;
+    }
+
+    uint32_t offset = tail & (capacity - 1);
+    uint32_t header[2];
+    memcpy(header, rx->data + offset, sizeof(header));
+
+    if (header[1] == IOTJS_RING_PADDING) {
+      iotjs_sharedring_consume(ring, tail + (capacity - offset));
+      continue;
+    }
+
+    if (header[0] > capacity - offset - IOTJS_RING_RECORD_HEADER_SIZE) {
+      JHANDLER_THROW(COMMON, "Corrupted shared ring");
+      return;
+    }
+
+    iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(header[0]);
+    iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+    iotjs_bufferwrap_copy(buffer_wrap,
+                          (const char*)rx->data + offset +
+                              IOTJS_RING_RECORD_HEADER_SIZE,
+                          header[0]);
+    iotjs_sharedring_consume(ring, tail + iotjs_ring_record_size(header[0]));
+
+    iotjs_jargs_t jargs = iotjs_jargs_create(2);
+    iotjs_jargs_append_number(&jargs, header[1]);
+    iotjs_jargs_append_jval(&jargs, &jbuffer);
+
+    bool throws;
+    iotjs_jval_t jres =
+        iotjs_jhelper_call(jcallback, iotjs_jval_get_undefined(), &jargs,
+                           &throws);
+    iotjs_jargs_destroy(&jargs);
+    iotjs_jval_destroy(&jbuffer);
+
+    if (throws) {
+      iotjs_jhandler_throw(jhandler, &jres);
+      iotjs_jval_destroy(&jres);
+      return;
+    }
+    iotjs_jval_destroy(&jres);
+  }
+}
+
+
+// Closes the descriptors of the worker, once it has inherited them.
+JHANDLER_FUNCTION(SharedRingClosePeer) {
+  SHAREDRING_DECLARE_THIS(ring);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  for (int i = 0; i < 2; i++) {
+    if (_this->peer_fds[i] >= 0) {
+      close(_this->peer_fds[i]);
+      _this->peer_fds[i] = -1;
+    }
+  }
+}
+
+
+JHANDLER_FUNCTION(SharedRingRef) {
+  SHAREDRING_DECLARE_THIS(ring);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  uv_ref((uv_handle_t*)&_this->handle);
+}
+
+
+JHANDLER_FUNCTION(SharedRingUnref) {
+  SHAREDRING_DECLARE_THIS(ring);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  uv_unref((uv_handle_t*)&_this->handle);
+}
+
+
+JHANDLER_FUNCTION(SharedRingClose) {
+  SHAREDRING_DECLARE_THIS(ring);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sharedring_t, ring);
+
+  iotjs_handlewrap_close(&_this->handlewrap, NULL);
+}
+
+
+JHANDLER_FUNCTION(ClusterWorker) {
+  JHANDLER_CHECK_THIS(object);
+}
+
+
+iotjs_jval_t InitCluster() {
+  iotjs_jval_t jworker =
+      iotjs_jval_create_function_with_dispatch(ClusterWorker);
+
+  iotjs_jval_t prototype = iotjs_jval_create_object();
+  iotjs_jval_set_property_jval(&jworker, IOTJS_MAGIC_STRING_PROTOTYPE,
+                               &prototype);
+
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SPAWN, Spawn);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_KILL, Kill);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_CLOSE, Close);
+
+  iotjs_jval_destroy(&prototype);
+
+  iotjs_jval_t jring = iotjs_jval_create_function_with_dispatch(SharedRing);
+  iotjs_jval_t ring_prototype = iotjs_jval_create_object();
+  iotjs_jval_set_property_jval(&jring, IOTJS_MAGIC_STRING_PROTOTYPE,
+                               &ring_prototype);
+
+  iotjs_jval_set_method(&ring_prototype, IOTJS_MAGIC_STRING_WRITE,
+                        SharedRingWrite);
+  iotjs_jval_set_method(&ring_prototype, IOTJS_MAGIC_STRING_DRAIN,
+                        SharedRingDrain);
+  iotjs_jval_set_method(&ring_prototype, IOTJS_MAGIC_STRING_CLOSEPEER,
+                        SharedRingClosePeer);
+  iotjs_jval_set_method(&ring_prototype, IOTJS_MAGIC_STRING_REF,
+                        SharedRingRef);
+  iotjs_jval_set_method(&ring_prototype, IOTJS_MAGIC_STRING_UNREF,
+                        SharedRingUnref);
+  iotjs_jval_set_method(&ring_prototype, IOTJS_MAGIC_STRING_CLOSE,
+                        SharedRingClose);
+
+  iotjs_jval_set_property_jval(&jworker, IOTJS_MAGIC_STRING_SHAREDRING,
+                               &jring);
+  iotjs_jval_destroy(&ring_prototype);
+  iotjs_jval_destroy(&jring);
+
+  return jworker;
+}
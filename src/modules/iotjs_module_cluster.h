@@ -0,0 +1,84 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IOTJS_MODULE_CLUSTER_H
+#define IOTJS_MODULE_CLUSTER_H
+
+
+#include "iotjs_binding.h"
+#include "iotjs_handlewrap.h"
+
+
+// Environment variable holding the descriptor of the socket a worker process
+// talks to its parent through.
+#define IOTJS_CHANNEL_FD_ENV "IOTJS_CHANNEL_FD"
+
+
+// A worker process started by this one, for the cluster and worker modules.
+// The worker inherits the write end of a pipe and holds it open until it
+// exits; the parent polls the read end, which reports end of file once the
+// worker is gone.
+typedef struct {
+  iotjs_handlewrap_t handlewrap;
+  uv_poll_t handle;
+  int pid;
+  int fd;
+} IOTJS_VALIDATED_STRUCT(iotjs_clusterworker_t);
+
+
+iotjs_clusterworker_t* iotjs_clusterworker_create(const iotjs_jval_t* jworker,
+                                                  int pid, int fd);
+
+iotjs_clusterworker_t* iotjs_clusterworker_from_handle(uv_poll_t* handle);
+
+iotjs_jval_t* iotjs_clusterworker_jobject(iotjs_clusterworker_t* worker);
+
+
+// One direction of a shared ring: a single producer, single consumer queue
+// of messages in memory shared by two processes. The positions only grow,
+// and are taken modulo the capacity, a power of two. Each one is written by
+// one side, on a cache line of its own.
+typedef struct {
+  uint32_t head; // written by the producer
+  uint8_t head_padding[60];
+  uint32_t tail; // written by the consumer
+  uint8_t tail_padding[60];
+  uint32_t capacity;
+  // The consumer found the ring empty, and waits for a signal.
+  uint32_t consumer_waiting;
+  // The producer found the ring full, and waits for a signal.
+  uint32_t producer_blocked;
+  uint8_t flags_padding[52];
+  uint8_t data[];
+} iotjs_ring_t;
+
+
+// Two rings, one for each direction, shared between a worker process and its
+// parent, which signal each other through a socket pair when a ring has
+// messages for a waiting consumer, or room for a blocked producer.
+typedef struct {
+  iotjs_handlewrap_t handlewrap;
+  uv_poll_t handle;
+  void* memory;
+  size_t size;
+  iotjs_ring_t* tx;
+  iotjs_ring_t* rx;
+  int fd;
+  // The shared memory and the socket of the worker, until it is started.
+  int peer_fds[2];
+} IOTJS_VALIDATED_STRUCT(iotjs_sharedring_t);
+
+
+#endif /* IOTJS_MODULE_CLUSTER_H */
@@ -0,0 +1,1447 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "iotjs_def.h"
+#include "iotjs_module_buffer.h"
+#include "iotjs_objectwrap.h"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+
+// Values nest no deeper than this, which also stops the encoding of cyclic
+// objects and keeps the native stack small.
+#define IOTJS_CODEC_MAX_DEPTH 32
+
+// Values are encoded on the stack up to this size.
+#define IOTJS_CODEC_STACK_SIZE 256
+
+// The largest integer a double holds exactly, 2^53 - 1.
+#define IOTJS_CODEC_MAX_SAFE_INTEGER 9007199254740991.0
+
+
+typedef enum {
+  kCodecCbor = 0,
+  kCodecMsgpack = 1,
+} iotjs_codec_format_t;
+
+
+typedef struct {
+  iotjs_codec_format_t format;
+  char* data;
+  size_t size;
+  size_t length;
+  // The data is the memory of the Buffer to encode into, which never grows.
+  bool is_fixed;
+  // The data has grown out of the stack.
+  bool is_allocated;
+  const char* error;
+} iotjs_codec_encoder_t;
+
+
+typedef struct {
+  iotjs_codec_format_t format;
+  const uint8_t* data;
+  size_t pos;
+  size_t end;
+  const char* error;
+} iotjs_codec_decoder_t;
+
+
+// Returns where the next `size` bytes are written, or NULL if the value
+// has failed to encode.
+static uint8_t* iotjs_codec_reserve(iotjs_codec_encoder_t* encoder,
+                                    size_t size) {
+  if (encoder->error != NULL) {
+    return NULL;
+  }
+
+  if (size > encoder->size - encoder->length) {
+    if (encoder->is_fixed) {
+      encoder->error = "The encoded value does not fit in the buffer";
+      return NULL;
+    }
+
+    size_t new_size = encoder->size * 2;
+    while (new_size - encoder->length < size) {
+      new_size *= 2;
+    }
+    if (encoder->is_allocated) {
+      encoder->data = iotjs_buffer_reallocate(encoder->data, new_size);
+    } else {
+      char* data = iotjs_buffer_allocate(new_size);
+      memcpy(data, encoder->data, encoder->length);
+      encoder->data = data;
+      encoder->is_allocated = true;
+    }
+    encoder->size = new_size;
+  }
+
+  uint8_t* p = (uint8_t*)encoder->data + encoder->length;
+  encoder->length += size;
+  return p;
+}
+
+
+static void iotjs_codec_put_uint(uint8_t* p, uint64_t value, size_t size) {
+  for (size_t i = size; i > 0; i--) {
+    p[i - 1] = (uint8_t)value;
+    value >>= 8;
+  }
+}
+
+
+// Writes the byte `type` and `value` in `size` bytes after it.
+static void iotjs_codec_write_head(iotjs_codec_encoder_t* encoder,
+                                   uint8_t type, uint64_t value,
+                                   size_t size) {
+  uint8_t* p = iotjs_codec_reserve(encoder, 1 + size);
+  if (p != NULL) {
+    p[0] = type;
+    iotjs_codec_put_uint(p + 1, value, size);
+  }
+}
+
+
+static void iotjs_codec_write_bytes(iotjs_codec_encoder_t* encoder,
+                                    const void* data, size_t size) {
+  uint8_t* p = iotjs_codec_reserve(encoder, size);
+  if (p != NULL && size > 0) {
+    memcpy(p, data, size);
+  }
+}
+
+
+// The major type and the argument of a CBOR data item, in as few bytes as
+// the argument takes.
+static void iotjs_codec_cbor_head(iotjs_codec_encoder_t* encoder,
+                                  uint8_t major, uint64_t value) {
+  uint8_t type = (uint8_t)(major << 5);
+  if (value < 24) {
+    iotjs_codec_write_head(encoder, type | (uint8_t)value, 0, 0);
+  } else if (value <= UINT8_MAX) {
+    iotjs_codec_write_head(encoder, type | 24, value, 1);
+  } else if (value <= UINT16_MAX) {
+    iotjs_codec_write_head(encoder, type | 25, value, 2);
+  } else if (value <= UINT32_MAX) {
+    iotjs_codec_write_head(encoder, type | 26, value, 4);
+  } else {
+    iotjs_codec_write_head(encoder, type | 27, value, 8);
+  }
+}
+
+
+// The head of a MessagePack string, binary, array or map of `length`, with
+// the fix type of up to `fix_max` elements if it has one, and the 8 bit
+// length if it has one.
+static void iotjs_codec_msgpack_head(iotjs_codec_encoder_t* encoder,
+                                     uint8_t fix_type, uint64_t fix_max,
+                                     uint8_t type8, uint8_t type16,
+                                     uint8_t type32, uint64_t length) {
+  if (fix_type != 0 && length <= fix_max) {
+    iotjs_codec_write_head(encoder, fix_type | (uint8_t)length, 0, 0);
+  } else if (type8 != 0 && length <= UINT8_MAX) {
+    iotjs_codec_write_head(encoder, type8, length, 1);
+  } else if (length <= UINT16_MAX) {
+    iotjs_codec_write_head(encoder, type16, length, 2);
+  } else if (length <= UINT32_MAX) {
+    iotjs_codec_write_head(encoder, type32, length, 4);
+  } else {
+    encoder->error = "The value is too long for MessagePack";
+  }
+}
+
+
+static void iotjs_codec_encode_integer(iotjs_codec_encoder_t* encoder,
+                                       double number) {
+  bool is_negative = number < 0;
+  // A negative n is written as -1 - n in CBOR, which is the complement.
+  uint64_t value =
+      is_negative ? (uint64_t)(-(number + 1)) : (uint64_t)number;
+
+  if (encoder->format == kCodecCbor) {
+    iotjs_codec_cbor_head(encoder, is_negative ? 1 : 0, value);
+  } else if (!is_negative) {
+    if (value < 0x80) {
+      iotjs_codec_write_head(encoder, (uint8_t)value, 0, 0);
+    } else if (value <= UINT8_MAX) {
+      iotjs_codec_write_head(encoder, 0xcc, value, 1);
+    } else if (value <= UINT16_MAX) {
+      iotjs_codec_write_head(encoder, 0xcd, value, 2);
+    } else if (value <= UINT32_MAX) {
+      iotjs_codec_write_head(encoder, 0xce, value, 4);
+    } else {
+      iotjs_codec_write_head(encoder, 0xcf, value, 8);
+    }
+  } else {
+    int64_t signed_value = (int64_t)number;
+    uint64_t bits = (uint64_t)signed_value;
+    if (signed_value >= -32) {
+      iotjs_codec_write_head(encoder, (uint8_t)bits, 0, 0);
+    } else if (signed_value >= INT8_MIN) {
+      iotjs_codec_write_head(encoder, 0xd0, bits, 1);
+    } else if (signed_value >= INT16_MIN) {
+      iotjs_codec_write_head(encoder, 0xd1, bits, 2);
+    } else if (signed_value >= INT32_MIN) {
+      iotjs_codec_write_head(encoder, 0xd2, bits, 4);
+    } else {
+      iotjs_codec_write_head(encoder, 0xd3, bits, 8);
+    }
+  }
+}
+
+
+// Integers are written in the fewest bytes, and other numbers as single
+// precision floats if that keeps them exact.
+static void iotjs_codec_encode_number(iotjs_codec_encoder_t* encoder,
+                                      double number) {
+  if (number >= -IOTJS_CODEC_MAX_SAFE_INTEGER &&
+      number <= IOTJS_CODEC_MAX_SAFE_INTEGER &&
+      (double)(int64_t)number == number &&
+      !(number == 0 && signbit(number))) {
+    iotjs_codec_encode_integer(encoder, number);
+    return;
+  }
+
+  bool is_cbor = encoder->format == kCodecCbor;
+  if (isnan(number)) {
+    // The half precision NaN of CBOR.
+    if (is_cbor) {
+      iotjs_codec_write_head(encoder, 0xf9, 0x7e00, 2);
+    } else {
+      iotjs_codec_write_head(encoder, 0xca, 0x7fc00000, 4);
+    }
+    return;
+  }
+
+  if (isinf(number) || (number >= -FLT_MAX && number <= FLT_MAX &&
+                        (double)(float)number == number)) {
+    float single = (float)number;
+    uint32_t bits;
+    memcpy(&bits, &single, sizeof(bits));
+    iotjs_codec_write_head(encoder, is_cbor ? 0xfa : 0xca, bits, 4);
+  } else {
+    uint64_t bits;
+    memcpy(&bits, &number, sizeof(bits));
+    iotjs_codec_write_head(encoder, is_cbor ? 0xfb : 0xcb, bits, 8);
+  }
+}
+
+
+// The engine keeps the characters outside the BMP as the CESU-8 of their
+// surrogate pairs, 6 bytes, which are written as the 4 bytes of UTF-8.
+static bool iotjs_codec_is_surrogate_pair(const uint8_t* p,
+                                          const uint8_t* end) {
+  return end - p >= 6 && p[0] == 0xed && (p[1] & 0xf0) == 0xa0 &&
+         p[3] == 0xed && (p[4] & 0xf0) == 0xb0;
+}
+
+
+static size_t iotjs_codec_utf8_size(const uint8_t* data, size_t size) {
+  const uint8_t* end = data + size;
+  const uint8_t* p = memchr(data, 0xed, size);
+  while (p != NULL) {
+    if (iotjs_codec_is_surrogate_pair(p, end)) {
+      size -= 2;
+      p += 6;
+    } else {
+      p++;
+    }
+    p = p < end ? memchr(p, 0xed, (size_t)(end - p)) : NULL;
+  }
+  return size;
+}
+
+
+static void iotjs_codec_copy_utf8(uint8_t* dest, const uint8_t* data,
+                                  size_t size) {
+  const uint8_t* end = data + size;
+  while (data < end) {
+    if (iotjs_codec_is_surrogate_pair(data, end)) {
+      uint32_t high = ((uint32_t)(data[1] & 0x0f) << 6) | (data[2] & 0x3f);
+      uint32_t low = ((uint32_t)(data[4] & 0x0f) << 6) | (data[5] & 0x3f);
+      uint32_t code_point = 0x10000 + (high << 10) + low;
+      *dest++ = (uint8_t)(0xf0 | (code_point >> 18));
+      *dest++ = (uint8_t)(0x80 | ((code_point >> 12) & 0x3f));
+      *dest++ = (uint8_t)(0x80 | ((code_point >> 6) & 0x3f));
+      *dest++ = (uint8_t)(0x80 | (code_point & 0x3f));
+      data += 6;
+    } else {
+      *dest++ = *data++;
+    }
+  }
+}
+
+
+static void iotjs_codec_encode_string(iotjs_codec_encoder_t* encoder,
+                                      const iotjs_jval_t* jstring) {
+  iotjs_string_view_t view = iotjs_jval_as_string_view(jstring);
+  const uint8_t* data = (const uint8_t*)iotjs_string_view_data(&view);
+  size_t size = iotjs_string_view_size(&view);
+  size_t utf8_size = iotjs_codec_utf8_size(data, size);
+
+  if (encoder->format == kCodecCbor) {
+    iotjs_codec_cbor_head(encoder, 3, utf8_size);
+  } else {
+    iotjs_codec_msgpack_head(encoder, 0xa0, 31, 0xd9, 0xda, 0xdb, utf8_size);
+  }
+
+  if (utf8_size == size) {
+    iotjs_codec_write_bytes(encoder, data, size);
+  } else {
+    uint8_t* p = iotjs_codec_reserve(encoder, utf8_size);
+    if (p != NULL) {
+      iotjs_codec_copy_utf8(p, data, size);
+    }
+  }
+
+  iotjs_string_view_destroy(&view);
+}
+
+
+static uint32_t iotjs_codec_length_of(const iotjs_jval_t* jarray) {
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jarray, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t length = (uint32_t)iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+  return length;
+}
+
+
+static void iotjs_codec_encode_value(iotjs_codec_encoder_t* encoder,
+                                     const iotjs_jval_t* jval, int depth);
+
+
+static void iotjs_codec_encode_object(iotjs_codec_encoder_t* encoder,
+                                      const iotjs_jval_t* jobj, int depth) {
+  bool is_cbor = encoder->format == kCodecCbor;
+
+  iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jval(jobj);
+  if (buffer != NULL) {
+    size_t length = iotjs_bufferwrap_length(buffer);
+    if (is_cbor) {
+      iotjs_codec_cbor_head(encoder, 2, length);
+    } else {
+      iotjs_codec_msgpack_head(encoder, 0, 0, 0xc4, 0xc5, 0xc6, length);
+    }
+    iotjs_codec_write_bytes(encoder, iotjs_bufferwrap_buffer(buffer), length);
+    return;
+  }
+
+  if (iotjs_jval_is_array(jobj)) {
+    uint32_t length = iotjs_codec_length_of(jobj);
+    if (is_cbor) {
+      iotjs_codec_cbor_head(encoder, 4, length);
+    } else {
+      iotjs_codec_msgpack_head(encoder, 0x90, 15, 0, 0xdc, 0xdd, length);
+    }
+    for (uint32_t i = 0; i < length && encoder->error == NULL; i++) {
+      iotjs_jval_t jitem = iotjs_jval_get_property_by_index(jobj, i);
+      iotjs_codec_encode_value(encoder, &jitem, depth + 1);
+      iotjs_jval_destroy(&jitem);
+    }
+    return;
+  }
+
+  iotjs_jval_t jkeys = iotjs_jval_get_keys(jobj);
+  uint32_t length = iotjs_codec_length_of(&jkeys);
+  if (is_cbor) {
+    iotjs_codec_cbor_head(encoder, 5, length);
+  } else {
+    iotjs_codec_msgpack_head(encoder, 0x80, 15, 0, 0xde, 0xdf, length);
+  }
+  for (uint32_t i = 0; i < length && encoder->error == NULL; i++) {
+    iotjs_jval_t jkey = iotjs_jval_get_property_by_index(&jkeys, i);
+    iotjs_jval_t jitem = iotjs_jval_get_property_by_jval(jobj, &jkey);
+    iotjs_codec_encode_string(encoder, &jkey);
+    iotjs_codec_encode_value(encoder, &jitem, depth + 1);
+    iotjs_jval_destroy(&jitem);
+    iotjs_jval_destroy(&jkey);
+  }
+  iotjs_jval_destroy(&jkeys);
+}
+
+
+// Functions are written as undefined, and undefined as nil in MessagePack,
+// which has no undefined.
+static void iotjs_codec_encode_value(iotjs_codec_encoder_t* encoder,
+                                     const iotjs_jval_t* jval, int depth) {
+  if (depth > IOTJS_CODEC_MAX_DEPTH) {
+    if (encoder->error == NULL) {
+      encoder->error = "The value is nested too deeply";
+    }
+    return;
+  }
+
+  bool is_cbor = encoder->format == kCodecCbor;
+  if (iotjs_jval_is_number(jval)) {
+    iotjs_codec_encode_number(encoder, iotjs_jval_as_number(jval));
+  } else if (iotjs_jval_is_string(jval)) {
+    iotjs_codec_encode_string(encoder, jval);
+  } else if (iotjs_jval_is_boolean(jval)) {
+    bool value = iotjs_jval_as_boolean(jval);
+    if (is_cbor) {
+      iotjs_codec_write_head(encoder, value ? 0xf5 : 0xf4, 0, 0);
+    } else {
+      iotjs_codec_write_head(encoder, value ? 0xc3 : 0xc2, 0, 0);
+    }
+  } else if (iotjs_jval_is_null(jval)) {
+    iotjs_codec_write_head(encoder, is_cbor ? 0xf6 : 0xc0, 0, 0);
+  } else if (iotjs_jval_is_object(jval) && !iotjs_jval_is_function(jval)) {
+    iotjs_codec_encode_object(encoder, jval, depth);
+  } else {
+    iotjs_codec_write_head(encoder, is_cbor ? 0xf7 : 0xc0, 0, 0);
+  }
+}
+
+
+// encode(format, value[, buffer, offset])
+// Encodes `value` into a new Buffer, or into `buffer` at `offset`, and
+// returns the count of the bytes written into it.
+JHANDLER_FUNCTION(Encode) {
+  JHANDLER_CHECK(iotjs_jhandler_get_arg_length(jhandler) >= 2);
+  DJHANDLER_CHECK_ARG(0, number);
+
+  iotjs_codec_format_t format =
+      (iotjs_codec_format_t)JHANDLER_GET_ARG(0, number);
+  const iotjs_jval_t* jval = iotjs_jhandler_get_arg(jhandler, 1);
+  const iotjs_jval_t* jtarget = JHANDLER_GET_ARG_IF_EXIST(2, object);
+
+  char stack_data[IOTJS_CODEC_STACK_SIZE];
+  iotjs_codec_encoder_t encoder;
+  encoder.format = format;
+  encoder.data = stack_data;
+  encoder.size = sizeof(stack_data);
+  encoder.length = 0;
+  encoder.is_fixed = false;
+  encoder.is_allocated = false;
+  encoder.error = NULL;
+
+  if (jtarget != NULL) {
+    DJHANDLER_CHECK_ARG(3, number);
+    iotjs_bufferwrap_t* target = iotjs_bufferwrap_from_jbuffer(jtarget);
+    size_t offset = (size_t)JHANDLER_GET_ARG(3, number);
+    size_t length = iotjs_bufferwrap_length(target);
+    JHANDLER_CHECK(offset <= length);
+    encoder.data = iotjs_bufferwrap_buffer(target) + offset;
+    encoder.size = length - offset;
+    encoder.is_fixed = true;
+  }
+
+  iotjs_codec_encode_value(&encoder, jval, 0);
+
+  if (encoder.error != NULL) {
+    JHANDLER_THROW(RANGE, encoder.error);
+  } else if (jtarget != NULL) {
+    iotjs_jhandler_return_number(jhandler, encoder.length);
+  } else {
+    iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(encoder.length);
+    iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+    iotjs_bufferwrap_copy(buffer, encoder.data, encoder.length);
+    iotjs_jhandler_return_jval(jhandler, &jbuffer);
+    iotjs_jval_destroy(&jbuffer);
+  }
+
+  if (encoder.is_allocated) {
+    iotjs_buffer_release(encoder.data);
+  }
+}
+
+
+static bool iotjs_codec_need(iotjs_codec_decoder_t* decoder, uint64_t size) {
+  if (decoder->error != NULL) {
+    return false;
+  }
+  if (size > decoder->end - decoder->pos) {
+    decoder->error = "Unexpected end of the data";
+    return false;
+  }
+  return true;
+}
+
+
+static uint64_t iotjs_codec_read_uint(iotjs_codec_decoder_t* decoder,
+                                      size_t size) {
+  if (!iotjs_codec_need(decoder, size)) {
+    return 0;
+  }
+  uint64_t value = 0;
+  const uint8_t* p = decoder->data + decoder->pos;
+  for (size_t i = 0; i < size; i++) {
+    value = (value << 8) | p[i];
+  }
+  decoder->pos += size;
+  return value;
+}
+
+
+static iotjs_jval_t iotjs_codec_decode_failed(iotjs_codec_decoder_t* decoder,
+                                              const char* error) {
+  if (decoder->error == NULL) {
+    decoder->error = error;
+  }
+  return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+}
+
+
+static iotjs_jval_t iotjs_codec_read_float(iotjs_codec_decoder_t* decoder) {
+  float single;
+  uint32_t bits = (uint32_t)iotjs_codec_read_uint(decoder, 4);
+  memcpy(&single, &bits, sizeof(single));
+  return iotjs_jval_create_number(single);
+}
+
+
+static iotjs_jval_t iotjs_codec_read_double(iotjs_codec_decoder_t* decoder) {
+  double number;
+  uint64_t bits = iotjs_codec_read_uint(decoder, 8);
+  memcpy(&number, &bits, sizeof(number));
+  return iotjs_jval_create_number(number);
+}
+
+
+static iotjs_jval_t iotjs_codec_read_half(iotjs_codec_decoder_t* decoder) {
+  uint32_t half = (uint32_t)iotjs_codec_read_uint(decoder, 2);
+  int exponent = (half >> 10) & 0x1f;
+  double mantissa = half & 0x3ff;
+  double number;
+  if (exponent == 0) {
+    number = mantissa / (1 << 24);
+  } else if (exponent == 31) {
+    number = mantissa == 0 ? INFINITY : NAN;
+  } else if (exponent >= 25) {
+    number = (mantissa + 1024) * (1 << (exponent - 25));
+  } else {
+    number = (mantissa + 1024) / (1 << (25 - exponent));
+  }
+  return iotjs_jval_create_number(half & 0x8000 ? -number : number);
+}
+
+
+static iotjs_jval_t iotjs_codec_read_string(iotjs_codec_decoder_t* decoder,
+                                            uint64_t size) {
+  if (!iotjs_codec_need(decoder, size)) {
+    return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  }
+  const uint8_t* data = decoder->data + decoder->pos;
+  decoder->pos += size;
+
+  if (!jerry_is_valid_utf8_string(data, (jerry_size_t)size)) {
+    return iotjs_codec_decode_failed(decoder, "Invalid UTF-8 string");
+  }
+
+  // Without the 4 bytes of characters outside the BMP, the UTF-8 is the
+  // CESU-8 the engine keeps.
+  for (uint64_t i = 0; i < size; i++) {
+    if (data[i] >= 0xf0) {
+      iotjs_string_t str =
+          iotjs_string_create_with_size((const char*)data, (size_t)size);
+      iotjs_jval_t jstring = iotjs_jval_create_string(&str);
+      iotjs_string_destroy(&str);
+      return jstring;
+    }
+  }
+  return iotjs_jval_create_string_sz((const char*)data, (size_t)size);
+}
+
+
+static iotjs_jval_t iotjs_codec_read_bytes(iotjs_codec_decoder_t* decoder,
+                                           uint64_t size) {
+  if (!iotjs_codec_need(decoder, size)) {
+    return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  }
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer((size_t)size);
+  iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+  iotjs_bufferwrap_copy(buffer, (const char*)decoder->data + decoder->pos,
+                        (size_t)size);
+  decoder->pos += size;
+  return jbuffer;
+}
+
+
+static iotjs_jval_t iotjs_codec_decode_value(iotjs_codec_decoder_t* decoder,
+                                             int depth);
+
+
+// Keys which are not strings name the property of their string, as they do
+// in JavaScript.
+static void iotjs_codec_set_entry(iotjs_codec_decoder_t* decoder,
+                                  const iotjs_jval_t* jobj,
+                                  const iotjs_jval_t* jkey,
+                                  const iotjs_jval_t* jitem) {
+  if (iotjs_jval_is_string(jkey)) {
+    iotjs_jval_set_property_by_jval(jobj, jkey, jitem);
+  } else if (iotjs_jval_is_object(jkey)) {
+    decoder->error = "Unsupported map key";
+  } else {
+    bool throws;
+    iotjs_jval_t jname = iotjs_jval_to_string(jkey, &throws);
+    IOTJS_ASSERT(!throws);
+    iotjs_jval_set_property_by_jval(jobj, &jname, jitem);
+    iotjs_jval_destroy(&jname);
+  }
+}
+
+
+// An array or a map of `length` items, or of the items before the break
+// code of CBOR if it is UINT64_MAX.
+static iotjs_jval_t iotjs_codec_read_items(iotjs_codec_decoder_t* decoder,
+                                           uint64_t length, bool is_map,
+                                           int depth) {
+  bool is_indefinite = length == UINT64_MAX;
+  // Each item takes a byte at least.
+  uint64_t min_size = length > UINT32_MAX ? UINT64_MAX
+                                          : (is_map ? length * 2 : length);
+  if (!is_indefinite && !iotjs_codec_need(decoder, min_size)) {
+    return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  }
+
+  iotjs_jval_t jresult = is_map ? iotjs_jval_create_object()
+                                : iotjs_jval_create_array(0);
+  for (uint32_t i = 0; decoder->error == NULL; i++) {
+    if (is_indefinite) {
+      if (!iotjs_codec_need(decoder, 1)) {
+        break;
+      }
+      if (decoder->data[decoder->pos] == 0xff) {
+        decoder->pos++;
+        break;
+      }
+    } else if (i == length) {
+      break;
+    }
+
+    if (is_map) {
+      iotjs_jval_t jkey = iotjs_codec_decode_value(decoder, depth + 1);
+      iotjs_jval_t jitem = iotjs_codec_decode_value(decoder, depth + 1);
+      if (decoder->error == NULL) {
+        iotjs_codec_set_entry(decoder, &jresult, &jkey, &jitem);
+      }
+      iotjs_jval_destroy(&jitem);
+      iotjs_jval_destroy(&jkey);
+    } else {
+      iotjs_jval_t jitem = iotjs_codec_decode_value(decoder, depth + 1);
+      iotjs_jval_set_property_by_index(&jresult, i, &jitem);
+      iotjs_jval_destroy(&jitem);
+    }
+  }
+  return jresult;
+}
+
+
+static iotjs_jval_t iotjs_codec_decode_cbor(iotjs_codec_decoder_t* decoder,
+                                            int depth) {
+  uint8_t type = (uint8_t)iotjs_codec_read_uint(decoder, 1);
+  uint8_t major = type >> 5;
+  uint8_t info = type & 0x1f;
+
+  if (major == 7) {
+    switch (info) {
+      case 20:
+        return iotjs_jval_create_copied(iotjs_jval_get_boolean(false));
+      case 21:
+        return iotjs_jval_create_copied(iotjs_jval_get_boolean(true));
+      case 22:
+        return iotjs_jval_create_copied(iotjs_jval_get_null());
+      case 23:
+        return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+      case 25:
+        return iotjs_codec_read_half(decoder);
+      case 26:
+        return iotjs_codec_read_float(decoder);
+      case 27:
+        return iotjs_codec_read_double(decoder);
+      default:
+        return iotjs_codec_decode_failed(decoder, "Unsupported simple value");
+    }
+  }
+
+  uint64_t argument = info;
+  if (info >= 24 && info <= 27) {
+    argument = iotjs_codec_read_uint(decoder, (size_t)1 << (info - 24));
+  } else if (info == 31 && (major == 4 || major == 5)) {
+    argument = UINT64_MAX;
+  } else if (info >= 24) {
+    return iotjs_codec_decode_failed(decoder, "Unsupported data item");
+  }
+  if (decoder->error != NULL) {
+    return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  }
+
+  switch (major) {
+    case 0:
+      return iotjs_jval_create_number((double)argument);
+    case 1:
+      return iotjs_jval_create_number(-1 - (double)argument);
+    case 2:
+      return iotjs_codec_read_bytes(decoder, argument);
+    case 3:
+      return iotjs_codec_read_string(decoder, argument);
+    case 4:
+      return iotjs_codec_read_items(decoder, argument, false, depth);
+    case 5:
+      return iotjs_codec_read_items(decoder, argument, true, depth);
+    default:
+      // The tags are left out, and the items they tag decoded.
+      return iotjs_codec_decode_value(decoder, depth + 1);
+  }
+}
+
+
+static iotjs_jval_t iotjs_codec_decode_msgpack(iotjs_codec_decoder_t* decoder,
+                                               int depth) {
+  uint8_t type = (uint8_t)iotjs_codec_read_uint(decoder, 1);
+  if (decoder->error != NULL) {
+    return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  }
+
+  if (type < 0x80) {
+    return iotjs_jval_create_number(type);
+  } else if (type >= 0xe0) {
+    return iotjs_jval_create_number((int8_t)type);
+  } else if (type < 0x90) {
+    return iotjs_codec_read_items(decoder, type & 0x0f, true, depth);
+  } else if (type < 0xa0) {
+    return iotjs_codec_read_items(decoder, type & 0x0f, false, depth);
+  } else if (type < 0xc0) {
+    return iotjs_codec_read_string(decoder, type & 0x1f);
+  }
+
+  switch (type) {
+    case 0xc0:
+      return iotjs_jval_create_copied(iotjs_jval_get_null());
+    case 0xc2:
+      return iotjs_jval_create_copied(iotjs_jval_get_boolean(false));
+    case 0xc3:
+      return iotjs_jval_create_copied(iotjs_jval_get_boolean(true));
+    case 0xc4:
+    case 0xc5:
+    case 0xc6:
+      return iotjs_codec_read_bytes(
+          decoder, iotjs_codec_read_uint(decoder, (size_t)1 << (type - 0xc4)));
+    case 0xca:
+      return iotjs_codec_read_float(decoder);
+    case 0xcb:
+      return iotjs_codec_read_double(decoder);
+    case 0xcc:
+    case 0xcd:
+    case 0xce:
+    case 0xcf:
+      return iotjs_jval_create_number((double)iotjs_codec_read_uint(
+          decoder, (size_t)1 << (type - 0xcc)));
+    case 0xd0:
+    case 0xd1:
+    case 0xd2:
+    case 0xd3: {
+      size_t size = (size_t)1 << (type - 0xd0);
+      uint64_t bits = iotjs_codec_read_uint(decoder, size);
+      // Sign extends the value of `size` bytes.
+      int shift = (int)(64 - size * 8);
+      int64_t value = (int64_t)(bits << shift) >> shift;
+      return iotjs_jval_create_number((double)value);
+    }
+    case 0xd9:
+    case 0xda:
+    case 0xdb:
+      return iotjs_codec_read_string(
+          decoder, iotjs_codec_read_uint(decoder, (size_t)1 << (type - 0xd9)));
+    case 0xdc:
+    case 0xdd:
+      return iotjs_codec_read_items(
+          decoder, iotjs_codec_read_uint(decoder, type == 0xdc ? 2 : 4), false,
+          depth);
+    case 0xde:
+    case 0xdf:
+      return iotjs_codec_read_items(
+          decoder, iotjs_codec_read_uint(decoder, type == 0xde ? 2 : 4), true,
+          depth);
+    default:
+      return iotjs_codec_decode_failed(decoder, "Unsupported type");
+  }
+}
+
+
+static iotjs_jval_t iotjs_codec_decode_value(iotjs_codec_decoder_t* decoder,
+                                             int depth) {
+  if (decoder->error != NULL) {
+    return iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  }
+  if (depth > IOTJS_CODEC_MAX_DEPTH) {
+    return iotjs_codec_decode_failed(decoder, "The value is nested too deeply");
+  }
+
+  if (decoder->format == kCodecCbor) {
+    return iotjs_codec_decode_cbor(decoder, depth);
+  }
+  return iotjs_codec_decode_msgpack(decoder, depth);
+}
+
+
+// decode(format, buffer, start, end, all)
+// Decodes the value in `buffer` from `start` to `end`, or all values in a
+// row there into an array if `all` is true.
+JHANDLER_FUNCTION(Decode) {
+  DJHANDLER_CHECK_ARGS(5, number, object, number, number, boolean);
+
+  iotjs_bufferwrap_t* buffer =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(1, object));
+  size_t start = (size_t)JHANDLER_GET_ARG(2, number);
+  size_t end = (size_t)JHANDLER_GET_ARG(3, number);
+  bool all = JHANDLER_GET_ARG(4, boolean);
+  JHANDLER_CHECK(start <= end && end <= iotjs_bufferwrap_length(buffer));
+
+  iotjs_codec_decoder_t decoder;
+  decoder.format = (iotjs_codec_format_t)JHANDLER_GET_ARG(0, number);
+  decoder.data = (const uint8_t*)iotjs_bufferwrap_buffer(buffer);
+  decoder.pos = start;
+  decoder.end = end;
+  decoder.error = NULL;
+
+  iotjs_jval_t jresult;
+  if (all) {
+    jresult = iotjs_jval_create_array(0);
+    for (uint32_t i = 0; decoder.pos < decoder.end && decoder.error == NULL;
+         i++) {
+      iotjs_jval_t jitem = iotjs_codec_decode_value(&decoder, 0);
+      iotjs_jval_set_property_by_index(&jresult, i, &jitem);
+      iotjs_jval_destroy(&jitem);
+    }
+  } else {
+    jresult = iotjs_codec_decode_value(&decoder, 0);
+    if (decoder.error == NULL && decoder.pos != decoder.end) {
+      decoder.error = "Unexpected data after the value";
+    }
+  }
+
+  if (decoder.error != NULL) {
+    JHANDLER_THROW(RANGE, decoder.error);
+  } else {
+    iotjs_jhandler_return_jval(jhandler, &jresult);
+  }
+  iotjs_jval_destroy(&jresult);
+}
+
+
+// Time series are kept in blocks of compressed points, after Gorilla: the
+// timestamps as the differences of their deltas, and the values as the XOR
+// with the one before, of which only the bits in between the leading and
+// the trailing zeros are written. A block starts with this header, of which
+// the fields are little endian:
+//
+//   uint32 size of the block in bytes, header included
+//   uint16 count of the points
+//   uint16 0
+//   int64  timestamp of the first point
+//   double value of the first point
+//
+// The header of the last block is kept current as points are appended, so
+// the data holds all the points at any time.
+#define IOTJS_TIMESERIES_HEADER_SIZE 24
+#define IOTJS_TIMESERIES_MAX_BLOCK_LENGTH 0xffff
+
+// The most bytes a point takes: 68 bits of timestamp and 77 of value.
+#define IOTJS_TIMESERIES_MAX_POINT_SIZE 19
+
+// The value of `leading` while no XOR has set the window of the bits.
+#define IOTJS_TIMESERIES_NO_WINDOW 0xff
+
+
+typedef struct {
+  iotjs_jobjectwrap_t jobjectwrap;
+
+  uint32_t block_length;
+  char* data;
+  size_t size;
+  size_t length;
+  // Where each block starts in the data.
+  size_t* blocks;
+  uint32_t block_count;
+  uint32_t block_capacity;
+  double point_count;
+
+  // The state of the last block while it takes points.
+  bool is_open;
+  size_t bits;
+  int64_t prev_time;
+  int64_t prev_delta;
+  uint64_t prev_value;
+  uint8_t leading;
+  uint8_t trailing;
+} IOTJS_VALIDATED_STRUCT(iotjs_timeserieswrap_t);
+
+
+IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(timeserieswrap);
+
+
+static iotjs_timeserieswrap_t* iotjs_timeserieswrap_create(
+    const iotjs_jval_t* jseries, uint32_t block_length) {
+  iotjs_timeserieswrap_t* wrap = IOTJS_ALLOC(iotjs_timeserieswrap_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_timeserieswrap_t, wrap);
+
+  iotjs_jobjectwrap_initialize(&_this->jobjectwrap, jseries,
+                               &this_module_native_info);
+  _this->block_length = block_length;
+
+  return wrap;
+}
+
+
+static void iotjs_timeserieswrap_destroy(iotjs_timeserieswrap_t* wrap) {
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_timeserieswrap_t, wrap);
+  if (_this->data != NULL) {
+    iotjs_buffer_release(_this->data);
+  }
+  if (_this->blocks != NULL) {
+    iotjs_buffer_release((char*)_this->blocks);
+  }
+  iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
+  IOTJS_RELEASE(wrap);
+}
+
+
+static void iotjs_timeseries_put_le(uint8_t* p, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    p[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+
+static uint64_t iotjs_timeseries_get_le(const uint8_t* p, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = size; i > 0; i--) {
+    value = (value << 8) | p[i - 1];
+  }
+  return value;
+}
+
+
+static uint64_t iotjs_timeseries_double_bits(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+
+static double iotjs_timeseries_bits_double(uint64_t bits) {
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+
+// Makes room for `size` more bytes of data, which are zeroed for the bits
+// to be ORed into.
+static void iotjs_timeseries_reserve(iotjs_timeserieswrap_t* wrap,
+                                     size_t size) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  if (_this->size - _this->length < size) {
+    size_t new_size = _this->size > 0 ? _this->size * 2 : 256;
+    while (new_size - _this->length < size) {
+      new_size *= 2;
+    }
+    _this->data = _this->data == NULL
+                      ? iotjs_buffer_allocate(new_size)
+                      : iotjs_buffer_reallocate(_this->data, new_size);
+    _this->size = new_size;
+  }
+  memset(_this->data + _this->length, 0, size);
+}
+
+
+static void iotjs_timeseries_add_block(iotjs_timeserieswrap_t* wrap,
+                                       size_t offset) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  if (_this->block_count == _this->block_capacity) {
+    uint32_t capacity =
+        _this->block_capacity > 0 ? _this->block_capacity * 2 : 16;
+    size_t size = capacity * sizeof(size_t);
+    _this->blocks =
+        (size_t*)(_this->blocks == NULL
+                      ? iotjs_buffer_allocate(size)
+                      : iotjs_buffer_reallocate((char*)_this->blocks, size));
+    _this->block_capacity = capacity;
+  }
+  _this->blocks[_this->block_count++] = offset;
+}
+
+
+// Writes the `count` low bits of `value` after the bits of the last block,
+// the most significant first.
+static void iotjs_timeseries_write_bits(iotjs_timeserieswrap_t* wrap,
+                                        uint64_t value, unsigned count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  uint8_t* stream = (uint8_t*)_this->data +
+                    _this->blocks[_this->block_count - 1] +
+                    IOTJS_TIMESERIES_HEADER_SIZE;
+  while (count > 0) {
+    unsigned room = 8 - (unsigned)(_this->bits & 7);
+    unsigned take = count < room ? count : room;
+    uint8_t bits = (uint8_t)((value >> (count - take)) & ((1u << take) - 1));
+    stream[_this->bits >> 3] |= (uint8_t)(bits << (room - take));
+    _this->bits += take;
+    count -= take;
+  }
+}
+
+
+static void iotjs_timeseries_write_dod(iotjs_timeserieswrap_t* wrap,
+                                       int64_t dod) {
+  // Zigzag, so that small differences of both signs take few bits.
+  uint64_t u = ((uint64_t)dod << 1) ^ (uint64_t)(dod >> 63);
+  if (u == 0) {
+    iotjs_timeseries_write_bits(wrap, 0, 1);
+  } else if (u < (1u << 7)) {
+    iotjs_timeseries_write_bits(wrap, 2, 2);
+    iotjs_timeseries_write_bits(wrap, u, 7);
+  } else if (u < (1u << 9)) {
+    iotjs_timeseries_write_bits(wrap, 6, 3);
+    iotjs_timeseries_write_bits(wrap, u, 9);
+  } else if (u < (1u << 12)) {
+    iotjs_timeseries_write_bits(wrap, 14, 4);
+    iotjs_timeseries_write_bits(wrap, u, 12);
+  } else {
+    iotjs_timeseries_write_bits(wrap, 15, 4);
+    iotjs_timeseries_write_bits(wrap, u, 64);
+  }
+}
+
+
+static void iotjs_timeseries_write_value(iotjs_timeserieswrap_t* wrap,
+                                         uint64_t value) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  uint64_t xor = value ^ _this->prev_value;
+  _this->prev_value = value;
+  if (xor == 0) {
+    iotjs_timeseries_write_bits(wrap, 0, 1);
+    return;
+  }
+
+  unsigned leading = (unsigned)__builtin_clzll(xor);
+  unsigned trailing = (unsigned)__builtin_ctzll(xor);
+  if (leading > 31) {
+    leading = 31;
+  }
+
+  if (_this->leading != IOTJS_TIMESERIES_NO_WINDOW &&
+      leading >= _this->leading && trailing >= _this->trailing) {
+    // The bits fit in the window of the value before.
+    iotjs_timeseries_write_bits(wrap, 2, 2);
+    iotjs_timeseries_write_bits(wrap, xor >> _this->trailing,
+                                64u - _this->leading - _this->trailing);
+    return;
+  }
+
+  unsigned significant = 64 - leading - trailing;
+  iotjs_timeseries_write_bits(wrap, 3, 2);
+  iotjs_timeseries_write_bits(wrap, leading, 5);
+  iotjs_timeseries_write_bits(wrap, significant - 1, 6);
+  iotjs_timeseries_write_bits(wrap, xor >> trailing, significant);
+  _this->leading = (uint8_t)leading;
+  _this->trailing = (uint8_t)trailing;
+}
+
+
+static void iotjs_timeseries_append(iotjs_timeserieswrap_t* wrap,
+                                    int64_t time, double value) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  uint64_t bits = iotjs_timeseries_double_bits(value);
+
+  if (!_this->is_open) {
+    iotjs_timeseries_reserve(wrap, IOTJS_TIMESERIES_HEADER_SIZE);
+    uint8_t* header = (uint8_t*)_this->data + _this->length;
+    iotjs_timeseries_put_le(header + 8, (uint64_t)time, 8);
+    iotjs_timeseries_put_le(header + 16, bits, 8);
+    iotjs_timeseries_add_block(wrap, _this->length);
+    _this->length += IOTJS_TIMESERIES_HEADER_SIZE;
+
+    _this->is_open = true;
+    _this->bits = 0;
+    _this->prev_time = time;
+    _this->prev_delta = 0;
+    _this->prev_value = bits;
+    _this->leading = IOTJS_TIMESERIES_NO_WINDOW;
+    _this->trailing = 0;
+  } else {
+    iotjs_timeseries_reserve(wrap, IOTJS_TIMESERIES_MAX_POINT_SIZE);
+    int64_t delta = time - _this->prev_time;
+    iotjs_timeseries_write_dod(wrap, delta - _this->prev_delta);
+    iotjs_timeseries_write_value(wrap, bits);
+    _this->prev_time = time;
+    _this->prev_delta = delta;
+  }
+
+  size_t start = _this->blocks[_this->block_count - 1];
+  uint8_t* header = (uint8_t*)_this->data + start;
+  uint32_t count = (uint32_t)iotjs_timeseries_get_le(header + 4, 2) + 1;
+  _this->length =
+      start + IOTJS_TIMESERIES_HEADER_SIZE + ((_this->bits + 7) >> 3);
+  iotjs_timeseries_put_le(header, _this->length - start, 4);
+  iotjs_timeseries_put_le(header + 4, count, 2);
+  _this->point_count++;
+
+  if (count == _this->block_length) {
+    _this->is_open = false;
+  }
+}
+
+
+typedef struct {
+  const uint8_t* stream;
+  size_t bits;
+  size_t end;
+  bool failed;
+} iotjs_timeseries_reader_t;
+
+
+static uint64_t iotjs_timeseries_read_bits(iotjs_timeseries_reader_t* reader,
+                                           unsigned count) {
+  if (reader->failed || count > reader->end - reader->bits) {
+    reader->failed = true;
+    return 0;
+  }
+
+  uint64_t value = 0;
+  while (count > 0) {
+    unsigned room = 8 - (unsigned)(reader->bits & 7);
+    unsigned take = count < room ? count : room;
+    uint8_t byte = reader->stream[reader->bits >> 3];
+    value = (value << take) | ((byte >> (room - take)) & ((1u << take) - 1));
+    reader->bits += take;
+    count -= take;
+  }
+  return value;
+}
+
+
+static int64_t iotjs_timeseries_read_dod(iotjs_timeseries_reader_t* reader) {
+  unsigned size;
+  if (iotjs_timeseries_read_bits(reader, 1) == 0) {
+    return 0;
+  } else if (iotjs_timeseries_read_bits(reader, 1) == 0) {
+    size = 7;
+  } else if (iotjs_timeseries_read_bits(reader, 1) == 0) {
+    size = 9;
+  } else if (iotjs_timeseries_read_bits(reader, 1) == 0) {
+    size = 12;
+  } else {
+    size = 64;
+  }
+  uint64_t u = iotjs_timeseries_read_bits(reader, size);
+  return (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+}
+
+
+// Points `header` at the block `index`, or returns false if the block is out
+// of the series.
+static bool iotjs_timeseries_block(iotjs_timeserieswrap_t* wrap,
+                                   uint32_t index, const uint8_t** header) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+  if (index >= _this->block_count) {
+    return false;
+  }
+  *header = (const uint8_t*)_this->data + _this->blocks[index];
+  return true;
+}
+
+
+// Checks the headers of the blocks of `data`, and returns their count, or
+// -1 if they do not make a series.
+static int64_t iotjs_timeseries_count_blocks(const uint8_t* data,
+                                             size_t length) {
+  int64_t count = 0;
+  size_t offset = 0;
+  while (offset < length) {
+    if (length - offset < IOTJS_TIMESERIES_HEADER_SIZE) {
+      return -1;
+    }
+    size_t size = (size_t)iotjs_timeseries_get_le(data + offset, 4);
+    size_t points = (size_t)iotjs_timeseries_get_le(data + offset + 4, 2);
+    if (size < IOTJS_TIMESERIES_HEADER_SIZE || size > length - offset ||
+        points == 0) {
+      return -1;
+    }
+    offset += size;
+    count++;
+  }
+  return count;
+}
+
+
+JHANDLER_FUNCTION(TimeSeries) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  double block_length = JHANDLER_GET_ARG(0, number);
+  JHANDLER_CHECK(block_length >= 1 &&
+                 block_length <= IOTJS_TIMESERIES_MAX_BLOCK_LENGTH);
+
+  iotjs_timeserieswrap_create(JHANDLER_GET_THIS(object),
+                              (uint32_t)block_length);
+}
+
+
+// [0] timestamp, an integer
+// [1] value
+JHANDLER_FUNCTION(Append) {
+  JHANDLER_DECLARE_THIS_PTR(timeserieswrap, wrap);
+  DJHANDLER_CHECK_ARGS(2, number, number);
+
+  double time = JHANDLER_GET_ARG(0, number);
+  if (time != floor(time) || fabs(time) > IOTJS_CODEC_MAX_SAFE_INTEGER) {
+    JHANDLER_THROW(RANGE, "The timestamp must be a safe integer");
+    return;
+  }
+
+  iotjs_timeseries_append(wrap, (int64_t)time, JHANDLER_GET_ARG(1, number));
+}
+
+
+// Returns [the count of the blocks, of the points, of the bytes].
+JHANDLER_FUNCTION(Stats) {
+  JHANDLER_DECLARE_THIS_PTR(timeserieswrap, wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  iotjs_jval_t jstats = iotjs_jval_create_array(3);
+  iotjs_jval_t jblocks = iotjs_jval_create_number(_this->block_count);
+  iotjs_jval_t jpoints = iotjs_jval_create_number(_this->point_count);
+  iotjs_jval_t jbytes = iotjs_jval_create_number((double)_this->length);
+  iotjs_jval_set_property_by_index(&jstats, 0, &jblocks);
+  iotjs_jval_set_property_by_index(&jstats, 1, &jpoints);
+  iotjs_jval_set_property_by_index(&jstats, 2, &jbytes);
+  iotjs_jval_destroy(&jblocks);
+  iotjs_jval_destroy(&jpoints);
+  iotjs_jval_destroy(&jbytes);
+
+  iotjs_jhandler_return_jval(jhandler, &jstats);
+  iotjs_jval_destroy(&jstats);
+}
+
+
+// Returns the timestamp of the first point of a block, for finding the
+// block of a time without decoding any.
+// [0] block index
+JHANDLER_FUNCTION(BlockStart) {
+  JHANDLER_DECLARE_THIS_PTR(timeserieswrap, wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  const uint8_t* header;
+  if (!iotjs_timeseries_block(wrap, (uint32_t)JHANDLER_GET_ARG(0, number),
+                              &header)) {
+    JHANDLER_THROW(RANGE, "Block index out of range");
+    return;
+  }
+
+  int64_t time = (int64_t)iotjs_timeseries_get_le(header + 8, 8);
+  iotjs_jhandler_return_number(jhandler, (double)time);
+}
+
+
+// Decodes the points of a block into two arrays, and returns their count.
+// [0] block index
+// [1] array of the timestamps
+// [2] array of the values
+JHANDLER_FUNCTION(ReadBlock) {
+  JHANDLER_DECLARE_THIS_PTR(timeserieswrap, wrap);
+  DJHANDLER_CHECK_ARGS(3, number, object, object);
+
+  const uint8_t* header;
+  if (!iotjs_timeseries_block(wrap, (uint32_t)JHANDLER_GET_ARG(0, number),
+                              &header)) {
+    JHANDLER_THROW(RANGE, "Block index out of range");
+    return;
+  }
+  const iotjs_jval_t* jtimes = JHANDLER_GET_ARG(1, object);
+  const iotjs_jval_t* jvalues = JHANDLER_GET_ARG(2, object);
+
+  size_t size = (size_t)iotjs_timeseries_get_le(header, 4);
+  uint32_t count = (uint32_t)iotjs_timeseries_get_le(header + 4, 2);
+  int64_t time = (int64_t)iotjs_timeseries_get_le(header + 8, 8);
+  uint64_t value = iotjs_timeseries_get_le(header + 16, 8);
+
+  iotjs_timeseries_reader_t reader;
+  reader.stream = header + IOTJS_TIMESERIES_HEADER_SIZE;
+  reader.bits = 0;
+  reader.end = (size - IOTJS_TIMESERIES_HEADER_SIZE) * 8;
+  reader.failed = false;
+
+  int64_t delta = 0;
+  unsigned leading = 0;
+  unsigned trailing = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if (i > 0) {
+      delta += iotjs_timeseries_read_dod(&reader);
+      time += delta;
+
+      if (iotjs_timeseries_read_bits(&reader, 1) != 0) {
+        if (iotjs_timeseries_read_bits(&reader, 1) != 0) {
+          leading = (unsigned)iotjs_timeseries_read_bits(&reader, 5);
+          unsigned significant =
+              (unsigned)iotjs_timeseries_read_bits(&reader, 6) + 1;
+          if (leading + significant > 64) {
+            reader.failed = true;
+            break;
+          }
+          trailing = 64 - leading - significant;
+        }
+        unsigned significant = 64 - leading - trailing;
+        value ^= iotjs_timeseries_read_bits(&reader, significant) << trailing;
+      }
+      if (reader.failed) {
+        break;
+      }
+    }
+
+    iotjs_jval_t jtime = iotjs_jval_create_number((double)time);
+    iotjs_jval_t jvalue =
+        iotjs_jval_create_number(iotjs_timeseries_bits_double(value));
+    iotjs_jval_set_property_by_index(jtimes, i, &jtime);
+    iotjs_jval_set_property_by_index(jvalues, i, &jvalue);
+    iotjs_jval_destroy(&jtime);
+    iotjs_jval_destroy(&jvalue);
+  }
+
+  if (reader.failed) {
+    JHANDLER_THROW(RANGE, "Malformed time series block");
+    return;
+  }
+  iotjs_jhandler_return_number(jhandler, count);
+}
+
+
+// Returns the data of the blocks from `start` to `end` in a new Buffer.
+// [0] start block
+// [1] end block
+JHANDLER_FUNCTION(ToBuffer) {
+  JHANDLER_DECLARE_THIS_PTR(timeserieswrap, wrap);
+  DJHANDLER_CHECK_ARGS(2, number, number);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  uint32_t start = (uint32_t)JHANDLER_GET_ARG(0, number);
+  uint32_t end = (uint32_t)JHANDLER_GET_ARG(1, number);
+  JHANDLER_CHECK(start <= end && end <= _this->block_count);
+
+  size_t from = start < _this->block_count ? _this->blocks[start]
+                                           : _this->length;
+  size_t to = end < _this->block_count ? _this->blocks[end] : _this->length;
+
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(to - from);
+  if (to > from) {
+    iotjs_bufferwrap_copy(iotjs_bufferwrap_from_jbuffer(&jbuffer),
+                          _this->data + from, to - from);
+  }
+  iotjs_jhandler_return_jval(jhandler, &jbuffer);
+  iotjs_jval_destroy(&jbuffer);
+}
+
+
+// Takes the blocks of data saved by toBuffer() after those of the series.
+// The points appended then start a new block.
+// [0] buffer
+JHANDLER_FUNCTION(Load) {
+  JHANDLER_DECLARE_THIS_PTR(timeserieswrap, wrap);
+  DJHANDLER_CHECK_ARGS(1, object);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(0, object));
+  const uint8_t* data = (const uint8_t*)iotjs_bufferwrap_buffer(buffer_wrap);
+  size_t length = iotjs_bufferwrap_length(buffer_wrap);
+
+  if (iotjs_timeseries_count_blocks(data, length) < 0) {
+    JHANDLER_THROW(RANGE, "Malformed time series data");
+    return;
+  }
+  if (length == 0) {
+    return;
+  }
+
+  iotjs_timeseries_reserve(wrap, length);
+  memcpy(_this->data + _this->length, data, length);
+
+  size_t offset = 0;
+  while (offset < length) {
+    iotjs_timeseries_add_block(wrap, _this->length + offset);
+    _this->point_count += (double)iotjs_timeseries_get_le(data + offset + 4, 2);
+    offset += (size_t)iotjs_timeseries_get_le(data + offset, 4);
+  }
+  _this->length += length;
+  _this->is_open = false;
+}
+
+
+// Drops the oldest blocks.
+// [0] count of the blocks
+JHANDLER_FUNCTION(Drop) {
+  JHANDLER_DECLARE_THIS_PTR(timeserieswrap, wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timeserieswrap_t, wrap);
+
+  uint32_t count = (uint32_t)JHANDLER_GET_ARG(0, number);
+  JHANDLER_CHECK(count <= _this->block_count);
+  if (count == 0) {
+    return;
+  }
+
+  size_t from =
+      count < _this->block_count ? _this->blocks[count] : _this->length;
+  for (uint32_t i = 0; i < count; i++) {
+    const uint8_t* header = (const uint8_t*)_this->data + _this->blocks[i];
+    _this->point_count -= (double)iotjs_timeseries_get_le(header + 4, 2);
+  }
+
+  memmove(_this->data, _this->data + from, _this->length - from);
+  _this->length -= from;
+  _this->block_count -= count;
+  for (uint32_t i = 0; i < _this->block_count; i++) {
+    _this->blocks[i] = _this->blocks[i + count] - from;
+  }
+  if (_this->block_count == 0) {
+    _this->is_open = false;
+  }
+}
+
+
+iotjs_jval_t InitCodec() {
+  iotjs_jval_t codec = iotjs_jval_create_object();
+
+  iotjs_jval_set_method(&codec, IOTJS_MAGIC_STRING_ENCODE, Encode);
+  iotjs_jval_set_method(&codec, IOTJS_MAGIC_STRING_DECODE, Decode);
+  iotjs_jval_set_property_number(&codec, IOTJS_MAGIC_STRING_CBOR, kCodecCbor);
+  iotjs_jval_set_property_number(&codec, IOTJS_MAGIC_STRING_MSGPACK,
+                                 kCodecMsgpack);
+
+  iotjs_jval_t jseries = iotjs_jval_create_function_with_dispatch(TimeSeries);
+  iotjs_jval_t prototype = iotjs_jval_create_object();
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_APPEND, Append);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_STATS, Stats);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_BLOCKSTART, BlockStart);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READBLOCK, ReadBlock);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_TOBUFFER, ToBuffer);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_LOAD, Load);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_DROP, Drop);
+  iotjs_jval_set_property_jval(&jseries, IOTJS_MAGIC_STRING_PROTOTYPE,
+                               &prototype);
+  iotjs_jval_set_property_jval(&codec, IOTJS_MAGIC_STRING_TIMESERIES, &jseries);
+  iotjs_jval_destroy(&prototype);
+  iotjs_jval_destroy(&jseries);
+
+  return codec;
+}
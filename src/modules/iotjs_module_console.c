@@ -14,42 +14,498 @@
  */
 
 #include "iotjs_def.h"
+#include "iotjs_module_console.h"
 #include "jerry-board-config.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #ifdef PROF_MODE_ARTIK053
 #include <sys/boardctl.h>
 #endif
 
+// Bytes an asynchronous stream queues before it drops messages.
+#define IOTJS_CONSOLE_DEFAULT_MAX_QUEUED (64 * 1024)
+
+
+// Written in place of the NUL characters of a message.
+static const char iotjs_console_nul[] = "\\u0000";
+
+
+// The output of console to stdout or stderr. A synchronous stream writes
+// messages with stdio, which blocks while the terminal or pipe is full. An
+// asynchronous one sets the descriptor non-blocking, writes as much as it
+// takes, and queues the rest until a poll handle finds it writable again.
+typedef struct {
+  FILE* file;
+  int fd;
+  bool async;
+  bool initialized;
+  bool polling;
+  int flags;
+  uv_poll_t poll;
+  char* queue;
+  size_t head;
+  size_t length;
+  size_t size;
+  size_t max_queued;
+  unsigned dropped;
+} iotjs_console_stream_t;
+
+
+static iotjs_console_stream_t iotjs_console_streams[2];
+
+
+static void iotjs_console_on_poll(uv_poll_t* handle, int status, int events);
+
+
+static iotjs_console_stream_t* iotjs_console_stream(int fd) {
+  iotjs_console_stream_t* stream = &iotjs_console_streams[fd == 2 ? 1 : 0];
+  if (stream->file == NULL) {
+    stream->file = fd == 2 ? stderr : stdout;
+    stream->fd = fd == 2 ? 2 : 1;
+  }
+  return stream;
+}
+
+
+static void iotjs_console_enqueue(iotjs_console_stream_t* stream,
+                                  const char* data, size_t length) {
+  if (stream->head + stream->length + length > stream->size) {
+    if (stream->head > 0) {
+      memmove(stream->queue, stream->queue + stream->head, stream->length);
+      stream->head = 0;
+    }
+    if (stream->length + length > stream->size) {
+      size_t size = stream->size > 0 ? stream->size : 256;
+      while (size < stream->length + length) {
+        size *= 2;
+      }
+      stream->queue = stream->queue == NULL
+                          ? iotjs_buffer_allocate(size)
+                          : iotjs_buffer_reallocate(stream->queue, size);
+      stream->size = size;
+    }
+  }
+  memcpy(stream->queue + stream->head + stream->length, data, length);
+  stream->length += length;
+}
+
+
+// Writes the queue until it is empty or the descriptor is full, and polls
+// for the rest. Once everything is written, the stream tells how many
+// messages it dropped.
+static void iotjs_console_flush(iotjs_console_stream_t* stream) {
+  while (stream->length > 0) {
+    ssize_t n = write(stream->fd, stream->queue + stream->head, stream->length);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        if (!stream->polling) {
+          uv_poll_start(&stream->poll, UV_WRITABLE, iotjs_console_on_poll);
+          stream->polling = true;
+        }
+        return;
+      }
+      // Nobody reads the output any more.
+      n = (ssize_t)stream->length;
+    }
+
+    stream->head += (size_t)n;
+    stream->length -= (size_t)n;
+    if (stream->length == 0) {
+      stream->head = 0;
+      if (stream->dropped > 0) {
+        char note[48];
+        int len =
+            snprintf(note, sizeof(note), "[%u console messages dropped]\n",
+                     stream->dropped);
+        stream->dropped = 0;
+        iotjs_console_enqueue(stream, note, (size_t)len);
+      }
+    }
+  }
+
+  if (stream->polling) {
+    uv_poll_stop(&stream->poll);
+    stream->polling = false;
+  }
+}
+
+
+static void iotjs_console_on_poll(uv_poll_t* handle, int status, int events) {
+  iotjs_console_flush((iotjs_console_stream_t*)handle->data);
+}
+
+
+// Makes the descriptor blocking again and writes what is still queued.
+static void iotjs_console_stop_async(iotjs_console_stream_t* stream) {
+  if (stream->polling) {
+    uv_poll_stop(&stream->poll);
+    stream->polling = false;
+  }
+  fcntl(stream->fd, F_SETFL, stream->flags);
+  stream->async = false;
+  iotjs_console_flush(stream);
+}
+
+
+static bool iotjs_console_start_async(iotjs_console_stream_t* stream) {
+  // Regular files are never full, and cannot be polled.
+  struct stat st;
+  if (fstat(stream->fd, &st) != 0 ||
+      !(S_ISCHR(st.st_mode) || S_ISFIFO(st.st_mode) ||
+        S_ISSOCK(st.st_mode))) {
+    return false;
+  }
+
+  int flags = fcntl(stream->fd, F_GETFL);
+  if (flags < 0) {
+    return false;
+  }
+
+  if (!stream->initialized) {
+    const iotjs_environment_t* env = iotjs_environment_get();
+    if (uv_poll_init(iotjs_environment_loop(env), &stream->poll, stream->fd) !=
+        0) {
+      return false;
+    }
+    stream->poll.data = stream;
+    stream->initialized = true;
+  }
+
+  // What stdio holds goes out before the messages of the queue.
+  fflush(stream->file);
+  fcntl(stream->fd, F_SETFL, flags | O_NONBLOCK);
+  stream->flags = flags;
+  stream->async = true;
+  return true;
+}
+
+
+static void iotjs_console_write(iotjs_console_stream_t* stream,
+                                const char* data, size_t length) {
+  if (stream->async) {
+    iotjs_console_enqueue(stream, data, length);
+  } else {
+    fwrite(data, 1, length, stream->file);
+  }
+}
+
+
+// Output of util.format(). The first bytes are kept on the stack, so a
+// short message needs no allocation.
+typedef struct {
+  char* data;
+  size_t length;
+  size_t size;
+  char inline_data[256];
+} iotjs_console_buffer_t;
+
+
+static void iotjs_console_buffer_init(iotjs_console_buffer_t* buf) {
+  buf->data = buf->inline_data;
+  buf->length = 0;
+  buf->size = sizeof(buf->inline_data);
+}
+
+
+static void iotjs_console_buffer_destroy(iotjs_console_buffer_t* buf) {
+  if (buf->data != buf->inline_data) {
+    iotjs_buffer_release(buf->data);
+  }
+}
+
+
+static char* iotjs_console_buffer_reserve(iotjs_console_buffer_t* buf,
+                                          size_t length) {
+  if (buf->length + length > buf->size) {
+    size_t size = buf->size * 2;
+    while (size < buf->length + length) {
+      size *= 2;
+    }
+    char* data = iotjs_buffer_allocate(size);
+    memcpy(data, buf->data, buf->length);
+    iotjs_console_buffer_destroy(buf);
+    buf->data = data;
+    buf->size = size;
+  }
+  return buf->data + buf->length;
+}
+
+
+static void iotjs_console_buffer_append(iotjs_console_buffer_t* buf,
+                                        const char* data, size_t length) {
+  memcpy(iotjs_console_buffer_reserve(buf, length), data, length);
+  buf->length += length;
+}
+
+
+static void iotjs_console_buffer_append_string(iotjs_console_buffer_t* buf,
+                                               const iotjs_jval_t* jstr) {
+  size_t size = iotjs_jval_string_size(jstr);
+  char* data = iotjs_console_buffer_reserve(buf, size);
+  buf->length += iotjs_jval_copy_string(jstr, data, size);
+}
+
+
+static iotjs_jval_t iotjs_console_stringify(const iotjs_jval_t* jval,
+                                            bool* throws) {
+  iotjs_jval_t jjson =
+      iotjs_jval_get_property(iotjs_jval_get_global_object(),
+                              IOTJS_MAGIC_STRING_JSON);
+  iotjs_jval_t jstringify =
+      iotjs_jval_get_property(&jjson, IOTJS_MAGIC_STRING_STRINGIFY);
+
+  iotjs_jargs_t jargs = iotjs_jargs_create(1);
+  iotjs_jargs_append_jval(&jargs, jval);
+  iotjs_jval_t jres = iotjs_jhelper_call(&jstringify, &jjson, &jargs, throws);
+  iotjs_jargs_destroy(&jargs);
+
+  iotjs_jval_destroy(&jstringify);
+  iotjs_jval_destroy(&jjson);
+  return jres;
+}
+
+
+// Appends a value as `%s`, `%d` or `%j` do. Returns false, with the error in
+// `jerr`, if a conversion throws.
+static bool iotjs_console_format_value(iotjs_console_buffer_t* buf,
+                                       const iotjs_jval_t* jval,
+                                       char conversion, iotjs_jval_t* jerr) {
+  if (conversion == 's' && iotjs_jval_is_string(jval)) {
+    iotjs_console_buffer_append_string(buf, jval);
+    return true;
+  }
+
+  bool throws = false;
+  iotjs_jval_t jconverted;
+  if (conversion == 'd') {
+    jconverted = iotjs_jval_to_number(jval, &throws);
+  } else if (conversion == 'j') {
+    jconverted = iotjs_console_stringify(jval, &throws);
+    if (throws) {
+      iotjs_jval_destroy(&jconverted);
+      iotjs_console_buffer_append(buf, "[Circular]", 10);
+      return true;
+    }
+  } else {
+    jconverted = iotjs_jval_create_copied(jval);
+  }
+
+  if (!throws) {
+    iotjs_jval_t jstr = iotjs_jval_to_string(&jconverted, &throws);
+    iotjs_jval_destroy(&jconverted);
+    jconverted = jstr;
+  }
+
+  if (throws) {
+    *jerr = jconverted;
+    return false;
+  }
+
+  iotjs_console_buffer_append_string(buf, &jconverted);
+  iotjs_jval_destroy(&jconverted);
+  return true;
+}
+
+
+// Formats the arguments of the handler as util.format() does.
+static bool iotjs_console_format(iotjs_jhandler_t* jhandler,
+                                 iotjs_console_buffer_t* buf,
+                                 iotjs_jval_t* jerr) {
+  uint16_t argc = iotjs_jhandler_get_arg_length(jhandler);
+  uint16_t i = 0;
+
+  if (argc > 0 && iotjs_jval_is_string(iotjs_jhandler_get_arg(jhandler, 0))) {
+    i = 1;
+    iotjs_console_buffer_append_string(buf,
+                                       iotjs_jhandler_get_arg(jhandler, 0));
+    if (memchr(buf->data, '%', buf->length) != NULL) {
+      // The format is moved out of the way of the output.
+      iotjs_string_t format =
+          iotjs_string_create_with_size(buf->data, buf->length);
+      buf->length = 0;
+
+      const char* p = iotjs_string_data(&format);
+      const char* end = p + iotjs_string_size(&format);
+      bool ok = true;
+      while (ok && p < end) {
+        const char* pct = memchr(p, '%', (size_t)(end - p));
+        if (pct == NULL) {
+          iotjs_console_buffer_append(buf, p, (size_t)(end - p));
+          break;
+        }
+        iotjs_console_buffer_append(buf, p, (size_t)(pct - p));
+
+        char conversion = pct + 1 < end ? pct[1] : '\0';
+        if (conversion == 's' || conversion == 'd' || conversion == 'j') {
+          if (i < argc) {
+            ok = iotjs_console_format_value(
+                buf, iotjs_jhandler_get_arg(jhandler, i++), conversion, jerr);
+          } else {
+            iotjs_console_buffer_append(buf, pct, 2);
+          }
+          p = pct + 2;
+        } else {
+          // `%%` is a percent sign, and any other `%` is written as is.
+          iotjs_console_buffer_append(buf, "%", 1);
+          p = conversion == '%' ? pct + 2 : pct + 1;
+        }
+      }
+
+      iotjs_string_destroy(&format);
+      if (!ok) {
+        return false;
+      }
+    }
+  }
+
+  for (; i < argc; i++) {
+    if (i > 0) {
+      iotjs_console_buffer_append(buf, " ", 1);
+    }
+    if (!iotjs_console_format_value(buf, iotjs_jhandler_get_arg(jhandler, i),
+                                    's', jerr)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
 // This function should be able to print utf8 encoded string
 // as utf8 is internal string representation in Jerryscript
-static void Print(iotjs_jhandler_t* jhandler, FILE* out_fd) {
-  JHANDLER_CHECK_ARGS(1, string);
-
-  iotjs_string_t msg = JHANDLER_GET_ARG(0, string);
-  const char* str = iotjs_string_data(&msg);
-  unsigned str_len = iotjs_string_size(&msg);
-  unsigned idx = 0;
+static void Print(iotjs_console_stream_t* stream, const char* str,
+                  size_t str_len) {
+  if (stream->async && stream->length > 0) {
+    // The output is behind; a message that does not fit in the queue is
+    // dropped rather than letting the queue grow without bound.
+    size_t length = str_len;
+    const char* nul = memchr(str, 0, str_len);
+    while (nul != NULL) {
+      length += sizeof(iotjs_console_nul) - 2;
+      nul = memchr(nul + 1, 0, str_len - (size_t)(nul + 1 - str));
+    }
+    if (stream->length + length > stream->max_queued) {
+      stream->dropped++;
+      return;
+    }
+  }
 
-  for (idx = 0; idx < str_len; idx++) {
-    if (str[idx] != 0) {
-      fprintf(out_fd, "%c", str[idx]);
-    } else {
-      fprintf(out_fd, "\\u0000");
+  // The runs between NUL characters are written at once.
+  const char* end = str + str_len;
+  while (str < end) {
+    const char* nul = memchr(str, 0, (size_t)(end - str));
+    if (nul == NULL) {
+      iotjs_console_write(stream, str, (size_t)(end - str));
+      break;
     }
+    iotjs_console_write(stream, str, (size_t)(nul - str));
+    iotjs_console_write(stream, iotjs_console_nul,
+                        sizeof(iotjs_console_nul) - 1);
+    str = nul + 1;
+  }
+
+  if (stream->async && !stream->polling) {
+    iotjs_console_flush(stream);
   }
-  iotjs_string_destroy(&msg);
+}
+
+
+// Prints the arguments formatted as util.format() does, and a new line.
+static void PrintLine(iotjs_jhandler_t* jhandler, int fd) {
+  iotjs_console_buffer_t buf;
+  iotjs_console_buffer_init(&buf);
+
+  iotjs_jval_t jerr;
+  if (iotjs_console_format(jhandler, &buf, &jerr)) {
+    iotjs_console_buffer_append(&buf, "\n", 1);
+    Print(iotjs_console_stream(fd), buf.data, buf.length);
+  } else {
+    iotjs_jhandler_throw(jhandler, &jerr);
+    iotjs_jval_destroy(&jerr);
+  }
+
+  iotjs_console_buffer_destroy(&buf);
 }
 
 
 JHANDLER_FUNCTION(Stdout) {
-  Print(jhandler, stdout);
+  PrintLine(jhandler, 1);
 }
 
 
 JHANDLER_FUNCTION(Stderr) {
-  Print(jhandler, stderr);
+  PrintLine(jhandler, 2);
+}
+
+
+JHANDLER_FUNCTION(Format) {
+  iotjs_console_buffer_t buf;
+  iotjs_console_buffer_init(&buf);
+
+  iotjs_jval_t jerr;
+  if (iotjs_console_format(jhandler, &buf, &jerr)) {
+    iotjs_jval_t jstr = iotjs_jval_create_string_sz(buf.data, buf.length);
+    iotjs_jhandler_return_jval(jhandler, &jstr);
+    iotjs_jval_destroy(&jstr);
+  } else {
+    iotjs_jhandler_throw(jhandler, &jerr);
+    iotjs_jval_destroy(&jerr);
+  }
+
+  iotjs_console_buffer_destroy(&buf);
+}
+
+
+// Makes the output to a descriptor asynchronous or synchronous, and returns
+// whether it is asynchronous.
+JHANDLER_FUNCTION(SetAsync) {
+  DJHANDLER_CHECK_ARGS(3, number, boolean, number);
+
+  iotjs_console_stream_t* stream =
+      iotjs_console_stream((int)JHANDLER_GET_ARG(0, number));
+  bool enable = JHANDLER_GET_ARG(1, boolean);
+  double max_queued = JHANDLER_GET_ARG(2, number);
+
+  stream->max_queued = max_queued > 0 ? (size_t)max_queued
+                                      : IOTJS_CONSOLE_DEFAULT_MAX_QUEUED;
+
+  if (enable && !stream->async) {
+    iotjs_console_start_async(stream);
+  } else if (!enable && stream->async) {
+    iotjs_console_stop_async(stream);
+  }
+
+  iotjs_jhandler_return_boolean(jhandler, stream->async);
+}
+
+
+void iotjs_console_release() {
+  for (size_t i = 0; i < 2; i++) {
+    iotjs_console_stream_t* stream = &iotjs_console_streams[i];
+    if (stream->async) {
+      iotjs_console_stop_async(stream);
+    }
+    if (stream->initialized) {
+      // Closed before the handles of the loop are, which are all wrapped.
+      uv_close((uv_handle_t*)&stream->poll, NULL);
+      stream->initialized = false;
+    }
+    if (stream->queue != NULL) {
+      iotjs_buffer_release(stream->queue);
+      stream->queue = NULL;
+      stream->head = stream->length = stream->size = 0;
+    }
+  }
 }
 
 #ifdef PROF_MODE_ARTIK053
@@ -65,8 +521,10 @@ JHANDLER_FUNCTION(Reboot) {
 iotjs_jval_t InitConsole() {
   iotjs_jval_t console = iotjs_jval_create_object();
 
+  iotjs_jval_set_method(&console, IOTJS_MAGIC_STRING_FORMAT, Format);
   iotjs_jval_set_method(&console, IOTJS_MAGIC_STRING_STDOUT, Stdout);
   iotjs_jval_set_method(&console, IOTJS_MAGIC_STRING_STDERR, Stderr);
+  iotjs_jval_set_method(&console, IOTJS_MAGIC_STRING_SETASYNC, SetAsync);
 #ifdef PROF_MODE_ARTIK053
   iotjs_jval_set_method(&console, IOTJS_MAGIC_STRING_REBOOT, Reboot);
 #endif
@@ -0,0 +1,551 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "iotjs_def.h"
+#include "iotjs_exception.h"
+#include "iotjs_module_buffer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+// The AES instructions are used when the compiler targets them, e.g. with
+// -maes, or -march=armv8-a+crypto on the Raspberry Pi 3.
+#if defined(__AES__)
+#include <wmmintrin.h>
+#define IOTJS_CRYPTO_AESNI 1
+#elif defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+#include <arm_neon.h>
+#define IOTJS_CRYPTO_ARMV8 1
+#endif
+
+
+#define AES_BLOCK_SIZE 16
+#define AES_ROUNDS 10
+#define SHA256_BLOCK_SIZE 64
+#define SHA256_DIGEST_SIZE 32
+
+
+typedef struct {
+  uint8_t round_keys[(AES_ROUNDS + 1) * AES_BLOCK_SIZE];
+} iotjs_aes_key_t;
+
+
+typedef struct {
+  uint32_t state[8];
+  uint64_t length;
+  uint8_t block[SHA256_BLOCK_SIZE];
+  size_t used;
+} iotjs_sha256_t;
+
+
+static const uint8_t iotjs_aes_sbox[256] = {
+  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b,
+  0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0,
+  0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26,
+  0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2,
+  0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0,
+  0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed,
+  0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f,
+  0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5,
+  0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec,
+  0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14,
+  0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c,
+  0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d,
+  0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f,
+  0x4b, 0xbd, 0x8b, 0x8a, 0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e,
+  0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11,
+  0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f,
+  0xb0, 0x54, 0xbb, 0x16,
+};
+
+
+static void iotjs_aes_expand_key(iotjs_aes_key_t* key, const uint8_t* raw) {
+  uint8_t* w = key->round_keys;
+  uint8_t rcon = 1;
+
+  memcpy(w, raw, AES_BLOCK_SIZE);
+  for (size_t i = AES_BLOCK_SIZE; i < sizeof(key->round_keys); i += 4) {
+    uint8_t t[4] = { w[i - 4], w[i - 3], w[i - 2], w[i - 1] };
+    if (i % AES_BLOCK_SIZE == 0) {
+      uint8_t first = t[0];
+      t[0] = (uint8_t)(iotjs_aes_sbox[t[1]] ^ rcon);
+      t[1] = iotjs_aes_sbox[t[2]];
+      t[2] = iotjs_aes_sbox[t[3]];
+      t[3] = iotjs_aes_sbox[first];
+      rcon = (uint8_t)((rcon << 1) ^ ((rcon & 0x80) ? 0x1b : 0));
+    }
+    for (size_t j = 0; j < 4; j++) {
+      w[i + j] = (uint8_t)(w[i + j - AES_BLOCK_SIZE] ^ t[j]);
+    }
+  }
+}
+
+
+#if !defined(IOTJS_CRYPTO_AESNI) && !defined(IOTJS_CRYPTO_ARMV8)
+static uint8_t iotjs_aes_xtime(uint8_t x) {
+  return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0));
+}
+
+
+static void iotjs_aes_add_round_key(uint8_t* s, const uint8_t* k) {
+  for (size_t i = 0; i < AES_BLOCK_SIZE; i++) {
+    s[i] ^= k[i];
+  }
+}
+
+
+// SubBytes and ShiftRows. The state is in columns of four bytes.
+static void iotjs_aes_sub_shift(uint8_t* s) {
+  uint8_t t[AES_BLOCK_SIZE];
+  for (size_t i = 0; i < AES_BLOCK_SIZE; i++) {
+    // Row r of column c comes from column c + r.
+    size_t row = i % 4;
+    size_t column = (i / 4 + row) % 4;
+    t[i] = iotjs_aes_sbox[s[column * 4 + row]];
+  }
+  memcpy(s, t, AES_BLOCK_SIZE);
+}
+
+
+static void iotjs_aes_mix_columns(uint8_t* s) {
+  for (size_t c = 0; c < 4; c++) {
+    uint8_t* col = s + c * 4;
+    uint8_t all = (uint8_t)(col[0] ^ col[1] ^ col[2] ^ col[3]);
+    uint8_t first = col[0];
+    col[0] ^= (uint8_t)(all ^ iotjs_aes_xtime((uint8_t)(col[0] ^ col[1])));
+    col[1] ^= (uint8_t)(all ^ iotjs_aes_xtime((uint8_t)(col[1] ^ col[2])));
+    col[2] ^= (uint8_t)(all ^ iotjs_aes_xtime((uint8_t)(col[2] ^ col[3])));
+    col[3] ^= (uint8_t)(all ^ iotjs_aes_xtime((uint8_t)(col[3] ^ first)));
+  }
+}
+#endif
+
+
+static void iotjs_aes_encrypt_block(const iotjs_aes_key_t* key,
+                                    const uint8_t* in, uint8_t* out) {
+  const uint8_t* k = key->round_keys;
+#if defined(IOTJS_CRYPTO_AESNI)
+  __m128i s = _mm_loadu_si128((const __m128i*)in);
+  s = _mm_xor_si128(s, _mm_loadu_si128((const __m128i*)k));
+  for (size_t r = 1; r < AES_ROUNDS; r++) {
+    s = _mm_aesenc_si128(
+        s, _mm_loadu_si128((const __m128i*)(k + r * AES_BLOCK_SIZE)));
+  }
+  s = _mm_aesenclast_si128(
+      s, _mm_loadu_si128((const __m128i*)(k + AES_ROUNDS * AES_BLOCK_SIZE)));
+  _mm_storeu_si128((__m128i*)out, s);
+#elif defined(IOTJS_CRYPTO_ARMV8)
+  uint8x16_t s = vld1q_u8(in);
+  for (size_t r = 0; r < AES_ROUNDS - 1; r++) {
+    s = vaesmcq_u8(vaeseq_u8(s, vld1q_u8(k + r * AES_BLOCK_SIZE)));
+  }
+  s = vaeseq_u8(s, vld1q_u8(k + (AES_ROUNDS - 1) * AES_BLOCK_SIZE));
+  s = veorq_u8(s, vld1q_u8(k + AES_ROUNDS * AES_BLOCK_SIZE));
+  vst1q_u8(out, s);
+#else
+  uint8_t s[AES_BLOCK_SIZE];
+  memcpy(s, in, AES_BLOCK_SIZE);
+  iotjs_aes_add_round_key(s, k);
+  for (size_t r = 1; r < AES_ROUNDS; r++) {
+    iotjs_aes_sub_shift(s);
+    iotjs_aes_mix_columns(s);
+    iotjs_aes_add_round_key(s, k + r * AES_BLOCK_SIZE);
+  }
+  iotjs_aes_sub_shift(s);
+  iotjs_aes_add_round_key(s, k + AES_ROUNDS * AES_BLOCK_SIZE);
+  memcpy(out, s, AES_BLOCK_SIZE);
+#endif
+}
+
+
+// The subkeys of CMAC double in GF(2^128).
+static void iotjs_cmac_double(uint8_t* block) {
+  uint8_t carry = block[0] & 0x80;
+  for (size_t i = 0; i < AES_BLOCK_SIZE - 1; i++) {
+    block[i] = (uint8_t)((block[i] << 1) | (block[i + 1] >> 7));
+  }
+  block[AES_BLOCK_SIZE - 1] =
+      (uint8_t)((block[AES_BLOCK_SIZE - 1] << 1) ^ (carry ? 0x87 : 0));
+}
+
+
+// AES-CMAC of RFC 4493.
+static void iotjs_aes_cmac(const iotjs_aes_key_t* key, const uint8_t* data,
+                           size_t length, uint8_t* mac) {
+  uint8_t subkey[AES_BLOCK_SIZE] = { 0 };
+  iotjs_aes_encrypt_block(key, subkey, subkey);
+  iotjs_cmac_double(subkey);
+
+  uint8_t x[AES_BLOCK_SIZE] = { 0 };
+  while (length > AES_BLOCK_SIZE) {
+    for (size_t i = 0; i < AES_BLOCK_SIZE; i++) {
+      x[i] ^= data[i];
+    }
+    iotjs_aes_encrypt_block(key, x, x);
+    data += AES_BLOCK_SIZE;
+    length -= AES_BLOCK_SIZE;
+  }
+
+  // A partial last block is padded, and takes the second subkey.
+  uint8_t last[AES_BLOCK_SIZE] = { 0 };
+  memcpy(last, data, length);
+  if (length < AES_BLOCK_SIZE) {
+    last[length] = 0x80;
+    iotjs_cmac_double(subkey);
+  }
+  for (size_t i = 0; i < AES_BLOCK_SIZE; i++) {
+    x[i] ^= (uint8_t)(last[i] ^ subkey[i]);
+  }
+  iotjs_aes_encrypt_block(key, x, mac);
+}
+
+
+static const uint32_t iotjs_sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+  0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+  0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+  0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+  0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+  0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+
+static void iotjs_sha256_transform(iotjs_sha256_t* ctx, const uint8_t* data) {
+  uint32_t w[64];
+  for (size_t i = 0; i < 16; i++) {
+    w[i] = (uint32_t)data[i * 4] << 24 | (uint32_t)data[i * 4 + 1] << 16 |
+           (uint32_t)data[i * 4 + 2] << 8 | (uint32_t)data[i * 4 + 3];
+  }
+  for (size_t i = 16; i < 64; i++) {
+    uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = ctx->state[0], b = ctx->state[1], c = ctx->state[2];
+  uint32_t d = ctx->state[3], e = ctx->state[4], f = ctx->state[5];
+  uint32_t g = ctx->state[6], h = ctx->state[7];
+  for (size_t i = 0; i < 64; i++) {
+    uint32_t s1 = ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25);
+    uint32_t t1 = h + s1 + ((e & f) ^ (~e & g)) + iotjs_sha256_k[i] + w[i];
+    uint32_t s0 = ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22);
+    uint32_t t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  ctx->state[0] += a;
+  ctx->state[1] += b;
+  ctx->state[2] += c;
+  ctx->state[3] += d;
+  ctx->state[4] += e;
+  ctx->state[5] += f;
+  ctx->state[6] += g;
+  ctx->state[7] += h;
+}
+
+
+static void iotjs_sha256_init(iotjs_sha256_t* ctx) {
+  static const uint32_t initial[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                       0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                       0x1f83d9ab, 0x5be0cd19 };
+  memcpy(ctx->state, initial, sizeof(initial));
+  ctx->length = 0;
+  ctx->used = 0;
+}
+
+
+static void iotjs_sha256_update(iotjs_sha256_t* ctx, const uint8_t* data,
+                                size_t length) {
+  ctx->length += length;
+  while (length > 0) {
+    if (ctx->used == 0 && length >= SHA256_BLOCK_SIZE) {
+      iotjs_sha256_transform(ctx, data);
+      data += SHA256_BLOCK_SIZE;
+      length -= SHA256_BLOCK_SIZE;
+      continue;
+    }
+    size_t n = SHA256_BLOCK_SIZE - ctx->used;
+    if (n > length) {
+      n = length;
+    }
+    memcpy(ctx->block + ctx->used, data, n);
+    ctx->used += n;
+    data += n;
+    length -= n;
+    if (ctx->used == SHA256_BLOCK_SIZE) {
+      iotjs_sha256_transform(ctx, ctx->block);
+      ctx->used = 0;
+    }
+  }
+}
+
+
+static void iotjs_sha256_final(iotjs_sha256_t* ctx, uint8_t* digest) {
+  uint64_t bits = ctx->length * 8;
+  uint8_t pad[SHA256_BLOCK_SIZE + 8] = { 0x80 };
+  size_t pad_length = (ctx->used < 56 ? 56 : 120) - ctx->used;
+  for (size_t i = 0; i < 8; i++) {
+    pad[pad_length + i] = (uint8_t)(bits >> (56 - i * 8));
+  }
+  iotjs_sha256_update(ctx, pad, pad_length + 8);
+
+  for (size_t i = 0; i < 8; i++) {
+    digest[i * 4] = (uint8_t)(ctx->state[i] >> 24);
+    digest[i * 4 + 1] = (uint8_t)(ctx->state[i] >> 16);
+    digest[i * 4 + 2] = (uint8_t)(ctx->state[i] >> 8);
+    digest[i * 4 + 3] = (uint8_t)ctx->state[i];
+  }
+}
+
+
+// HMAC of RFC 2104 with SHA-256.
+static void iotjs_hmac_sha256(const uint8_t* key, size_t key_length,
+                              const uint8_t* data, size_t length,
+                              uint8_t* mac) {
+  uint8_t block[SHA256_BLOCK_SIZE] = { 0 };
+  iotjs_sha256_t ctx;
+
+  if (key_length > SHA256_BLOCK_SIZE) {
+    iotjs_sha256_init(&ctx);
+    iotjs_sha256_update(&ctx, key, key_length);
+    iotjs_sha256_final(&ctx, block);
+  } else {
+    memcpy(block, key, key_length);
+  }
+
+  for (size_t i = 0; i < SHA256_BLOCK_SIZE; i++) {
+    block[i] ^= 0x36;
+  }
+  iotjs_sha256_init(&ctx);
+  iotjs_sha256_update(&ctx, block, SHA256_BLOCK_SIZE);
+  iotjs_sha256_update(&ctx, data, length);
+  iotjs_sha256_final(&ctx, mac);
+
+  for (size_t i = 0; i < SHA256_BLOCK_SIZE; i++) {
+    block[i] ^= 0x36 ^ 0x5c;
+  }
+  iotjs_sha256_init(&ctx);
+  iotjs_sha256_update(&ctx, block, SHA256_BLOCK_SIZE);
+  iotjs_sha256_update(&ctx, mac, SHA256_DIGEST_SIZE);
+  iotjs_sha256_final(&ctx, mac);
+}
+
+
+static iotjs_bufferwrap_t* iotjs_crypto_arg_buffer(iotjs_jhandler_t* jhandler,
+                                                   uint16_t index) {
+  const iotjs_jval_t* jbuffer = JHANDLER_GET_ARG(index, object);
+  return iotjs_bufferwrap_from_jbuffer(jbuffer);
+}
+
+
+static void iotjs_crypto_return_bytes(iotjs_jhandler_t* jhandler,
+                                      const uint8_t* data, size_t length) {
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(length);
+  iotjs_bufferwrap_copy(iotjs_bufferwrap_from_jbuffer(&jbuffer),
+                        (const char*)data, length);
+  iotjs_jhandler_return_jval(jhandler, &jbuffer);
+  iotjs_jval_destroy(&jbuffer);
+}
+
+
+static void iotjs_crypto_reverse(uint8_t* data, size_t length) {
+  for (size_t i = 0; i < length / 2; i++) {
+    uint8_t t = data[i];
+    data[i] = data[length - 1 - i];
+    data[length - 1 - i] = t;
+  }
+}
+
+
+// Encrypts the blocks of `data` with AES-128 in ECB mode. With `reversed`,
+// the key and every block are taken and given least significant byte first,
+// as the security function e of Bluetooth does.
+JHANDLER_FUNCTION(AesEncrypt) {
+  DJHANDLER_CHECK_ARGS(3, object, object, boolean);
+
+  iotjs_bufferwrap_t* key_wrap = iotjs_crypto_arg_buffer(jhandler, 0);
+  iotjs_bufferwrap_t* data_wrap = iotjs_crypto_arg_buffer(jhandler, 1);
+  bool reversed = JHANDLER_GET_ARG(2, boolean);
+
+  size_t length = iotjs_bufferwrap_length(data_wrap);
+  if (iotjs_bufferwrap_length(key_wrap) != AES_BLOCK_SIZE ||
+      length % AES_BLOCK_SIZE != 0) {
+    JHANDLER_THROW(RANGE, "Invalid key or data length");
+    return;
+  }
+
+  uint8_t raw_key[AES_BLOCK_SIZE];
+  memcpy(raw_key, iotjs_bufferwrap_buffer(key_wrap), AES_BLOCK_SIZE);
+  if (reversed) {
+    iotjs_crypto_reverse(raw_key, AES_BLOCK_SIZE);
+  }
+  iotjs_aes_key_t key;
+  iotjs_aes_expand_key(&key, raw_key);
+
+  iotjs_jval_t jresult = iotjs_bufferwrap_create_buffer(length);
+  iotjs_bufferwrap_t* result_wrap = iotjs_bufferwrap_from_jbuffer(&jresult);
+  const uint8_t* in = (const uint8_t*)iotjs_bufferwrap_buffer(data_wrap);
+  uint8_t* out = (uint8_t*)iotjs_bufferwrap_buffer(result_wrap);
+
+  for (size_t i = 0; i < length; i += AES_BLOCK_SIZE) {
+    uint8_t block[AES_BLOCK_SIZE];
+    memcpy(block, in + i, AES_BLOCK_SIZE);
+    if (reversed) {
+      iotjs_crypto_reverse(block, AES_BLOCK_SIZE);
+    }
+    iotjs_aes_encrypt_block(&key, block, block);
+    if (reversed) {
+      iotjs_crypto_reverse(block, AES_BLOCK_SIZE);
+    }
+    memcpy(out + i, block, AES_BLOCK_SIZE);
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jresult);
+  iotjs_jval_destroy(&jresult);
+}
+
+
+JHANDLER_FUNCTION(AesCmac) {
+  DJHANDLER_CHECK_ARGS(2, object, object);
+
+  iotjs_bufferwrap_t* key_wrap = iotjs_crypto_arg_buffer(jhandler, 0);
+  iotjs_bufferwrap_t* data_wrap = iotjs_crypto_arg_buffer(jhandler, 1);
+
+  if (iotjs_bufferwrap_length(key_wrap) != AES_BLOCK_SIZE) {
+    JHANDLER_THROW(RANGE, "Invalid key length");
+    return;
+  }
+
+  iotjs_aes_key_t key;
+  iotjs_aes_expand_key(&key, (const uint8_t*)iotjs_bufferwrap_buffer(key_wrap));
+
+  uint8_t mac[AES_BLOCK_SIZE];
+  iotjs_aes_cmac(&key, (const uint8_t*)iotjs_bufferwrap_buffer(data_wrap),
+                 iotjs_bufferwrap_length(data_wrap), mac);
+  iotjs_crypto_return_bytes(jhandler, mac, sizeof(mac));
+}
+
+
+// Returns the SHA-256 digest of the buffers of an array.
+JHANDLER_FUNCTION(Sha256) {
+  DJHANDLER_CHECK_ARGS(1, array);
+
+  const iotjs_jval_t* jchunks = JHANDLER_GET_ARG(0, array);
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jchunks, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t count = (uint32_t)iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+
+  iotjs_sha256_t ctx;
+  iotjs_sha256_init(&ctx);
+  for (uint32_t i = 0; i < count; i++) {
+    iotjs_jval_t jchunk = iotjs_jval_get_property_by_index(jchunks, i);
+    iotjs_bufferwrap_t* chunk = iotjs_bufferwrap_from_jbuffer(&jchunk);
+    iotjs_sha256_update(&ctx, (const uint8_t*)iotjs_bufferwrap_buffer(chunk),
+                        iotjs_bufferwrap_length(chunk));
+    iotjs_jval_destroy(&jchunk);
+  }
+
+  uint8_t digest[SHA256_DIGEST_SIZE];
+  iotjs_sha256_final(&ctx, digest);
+  iotjs_crypto_return_bytes(jhandler, digest, sizeof(digest));
+}
+
+
+JHANDLER_FUNCTION(HmacSha256) {
+  DJHANDLER_CHECK_ARGS(2, object, object);
+
+  iotjs_bufferwrap_t* key_wrap = iotjs_crypto_arg_buffer(jhandler, 0);
+  iotjs_bufferwrap_t* data_wrap = iotjs_crypto_arg_buffer(jhandler, 1);
+
+  uint8_t mac[SHA256_DIGEST_SIZE];
+  iotjs_hmac_sha256((const uint8_t*)iotjs_bufferwrap_buffer(key_wrap),
+                    iotjs_bufferwrap_length(key_wrap),
+                    (const uint8_t*)iotjs_bufferwrap_buffer(data_wrap),
+                    iotjs_bufferwrap_length(data_wrap), mac);
+  iotjs_crypto_return_bytes(jhandler, mac, sizeof(mac));
+}
+
+
+JHANDLER_FUNCTION(RandomBytes) {
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  size_t size = (size_t)JHANDLER_GET_ARG(0, number);
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(size);
+  char* data = iotjs_bufferwrap_buffer(iotjs_bufferwrap_from_jbuffer(&jbuffer));
+
+  int err = 0;
+  int fd = open("/dev/urandom", O_RDONLY);
+  if (fd < 0) {
+    err = -errno;
+  }
+  for (size_t done = 0; err == 0 && done < size;) {
+    ssize_t n = read(fd, data + done, size - done);
+    if (n > 0) {
+      done += (size_t)n;
+    } else if (n < 0 && errno != EINTR) {
+      err = -errno;
+    } else if (n == 0) {
+      err = UV__EIO;
+    }
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+
+  if (err != 0) {
+    iotjs_jval_t jerror = iotjs_create_uv_exception(err, "randomBytes");
+    iotjs_jhandler_throw(jhandler, &jerror);
+    iotjs_jval_destroy(&jerror);
+  } else {
+    iotjs_jhandler_return_jval(jhandler, &jbuffer);
+  }
+  iotjs_jval_destroy(&jbuffer);
+}
+
+
+iotjs_jval_t InitCrypto() {
+  iotjs_jval_t crypto = iotjs_jval_create_object();
+
+  iotjs_jval_set_method(&crypto, IOTJS_MAGIC_STRING_AESCMAC, AesCmac);
+  iotjs_jval_set_method(&crypto, IOTJS_MAGIC_STRING_AESENCRYPT, AesEncrypt);
+  iotjs_jval_set_method(&crypto, IOTJS_MAGIC_STRING_HMACSHA256, HmacSha256);
+  iotjs_jval_set_method(&crypto, IOTJS_MAGIC_STRING_RANDOMBYTES, RandomBytes);
+  iotjs_jval_set_method(&crypto, IOTJS_MAGIC_STRING_SHA256, Sha256);
+
+  return crypto;
+}
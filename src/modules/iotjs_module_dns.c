@@ -20,13 +20,25 @@
 #include "iotjs_reqwrap.h"
 #include "uv.h"
 
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+#include <arpa/inet.h>
+#endif
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
 
 #define THIS iotjs_getaddrinfo_reqwrap_t* getaddrinfo_reqwrap
 
+IOTJS_DEFINE_POOL(getaddrinfo_reqwrap_pool, iotjs_getaddrinfo_reqwrap_t,
+                  "dns.lookup", IOTJS_REQWRAP_POOL_CAP);
+
+
 iotjs_getaddrinfo_reqwrap_t* iotjs_getaddrinfo_reqwrap_create(
     const iotjs_jval_t* jcallback) {
   iotjs_getaddrinfo_reqwrap_t* getaddrinfo_reqwrap =
-      IOTJS_ALLOC(iotjs_getaddrinfo_reqwrap_t);
+      IOTJS_POOL_ALLOC(getaddrinfo_reqwrap_pool, iotjs_getaddrinfo_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_getaddrinfo_reqwrap_t,
                                      getaddrinfo_reqwrap);
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -38,7 +50,7 @@ static void iotjs_getaddrinfo_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_getaddrinfo_reqwrap_t,
                                     getaddrinfo_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(getaddrinfo_reqwrap);
+  IOTJS_POOL_RELEASE(getaddrinfo_reqwrap_pool, getaddrinfo_reqwrap);
 }
 
 
@@ -246,6 +258,839 @@ JHANDLER_FUNCTION(GetAddrInfo) {
 }
 
 
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+
+// Stub resolver
+// Names are resolved by DNS queries on UDP handles of the loop, without a
+// threadpool worker, so that lookups stalled by the network never hold the
+// workers of the fs and the peripheral jobs. The A and the AAAA questions of a
+// lookup are asked in parallel. A question goes first to the server that
+// answered last, and on to the next server on a timeout or a failure, until
+// every server has been tried `tries` times.
+#define IOTJS_DNS_MAX_SERVERS 4
+#define IOTJS_DNS_PORT 53
+#define IOTJS_DNS_HEADER_SIZE 12
+// Encoded names, with the length bytes of the labels and the root label.
+#define IOTJS_DNS_NAME_SIZE 255
+#define IOTJS_DNS_MAX_LABEL 63
+// Messages over UDP without EDNS.
+#define IOTJS_DNS_PACKET_SIZE 512
+
+#define IOTJS_DNS_TYPE_A 1
+#define IOTJS_DNS_TYPE_AAAA 28
+#define IOTJS_DNS_CLASS_IN 1
+
+#define IOTJS_DNS_FLAG_RESPONSE 0x8000
+#define IOTJS_DNS_FLAG_TRUNCATED 0x0200
+#define IOTJS_DNS_FLAG_RECURSION 0x0100
+#define IOTJS_DNS_RCODE_MASK 0x000f
+#define IOTJS_DNS_RCODE_NXDOMAIN 3
+
+// Outcomes of a message besides an answer (0) and the UV__EAI_* errors.
+#define IOTJS_DNS_RETRY 1   // the next server is asked
+#define IOTJS_DNS_IGNORE 2  // not the answer to the question
+
+
+typedef struct {
+  uint16_t id;
+  uint16_t type;
+  bool is_pending;
+  // 0 once the address is found, or the UV__EAI_* error of the last try.
+  int status;
+  unsigned server;
+  unsigned tries;
+  uint64_t deadline;
+  uint8_t address[16];
+} iotjs_dns_question_t;
+
+
+typedef struct iotjs_dns_query_s {
+  struct iotjs_dns_query_s* next;
+  iotjs_jval_t jcallback;
+  int family;
+  int flags;
+  unsigned timeout;
+  unsigned tries;
+  // The A and the AAAA questions.
+  iotjs_dns_question_t questions[2];
+  size_t name_size;
+  uint8_t name[IOTJS_DNS_NAME_SIZE];
+} iotjs_dns_query_t;
+
+
+IOTJS_DEFINE_POOL(dns_query_pool, iotjs_dns_query_t, "dns.resolve",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
+// The socket of a family is opened for its first server. The handles are
+// unreferenced, and the timer keeps the loop alive while a question waits.
+static struct {
+  bool is_initialized;
+  bool has_servers;
+  uv_timer_t timer;
+  uv_udp_t udp4;
+  uv_udp_t udp6;
+  bool is_udp4_open;
+  bool is_udp6_open;
+  bool is_udp4_failed;
+  bool is_udp6_failed;
+  struct sockaddr_storage servers[IOTJS_DNS_MAX_SERVERS];
+  unsigned server_count;
+  unsigned last_server;
+  iotjs_dns_query_t* queries;
+  uint32_t random;
+} dns_resolver;
+
+static char dns_resolver_buffer[IOTJS_DNS_PACKET_SIZE];
+
+
+static uint16_t iotjs_dns_read16(const uint8_t* p) {
+  return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+
+static void iotjs_dns_write16(uint8_t* p, uint16_t value) {
+  p[0] = (uint8_t)(value >> 8);
+  p[1] = (uint8_t)value;
+}
+
+
+// The ids of the queries are not predictable, which makes forged answers
+// harder to match.
+static uint16_t iotjs_dns_random_id() {
+  uint32_t x = dns_resolver.random;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  dns_resolver.random = x;
+  return (uint16_t)(x >> 8);
+}
+
+
+static uv_loop_t* iotjs_dns_loop() {
+  return iotjs_environment_loop(iotjs_environment_get());
+}
+
+
+static bool iotjs_dns_sockaddr_equal(const struct sockaddr* a,
+                                     const struct sockaddr_storage* b) {
+  if (a->sa_family != b->ss_family) {
+    return false;
+  }
+  if (a->sa_family == AF_INET) {
+    const struct sockaddr_in* a4 = (const struct sockaddr_in*)a;
+    const struct sockaddr_in* b4 = (const struct sockaddr_in*)b;
+    return a4->sin_port == b4->sin_port &&
+           memcmp(&a4->sin_addr, &b4->sin_addr, sizeof(a4->sin_addr)) == 0;
+  }
+  const struct sockaddr_in6* a6 = (const struct sockaddr_in6*)a;
+  const struct sockaddr_in6* b6 = (const struct sockaddr_in6*)b;
+  return a6->sin6_port == b6->sin6_port &&
+         memcmp(&a6->sin6_addr, &b6->sin6_addr, sizeof(a6->sin6_addr)) == 0;
+}
+
+
+// The text forms of IPv6 addresses are read and written by the C library,
+// as libtuv knows only the IPv4 ones.
+static bool iotjs_dns_parse_server(const char* address, int port,
+                                   struct sockaddr_storage* server) {
+  if (port <= 0 || port > 65535) {
+    return false;
+  }
+
+  memset(server, 0, sizeof(*server));
+  struct sockaddr_in* server4 = (struct sockaddr_in*)server;
+  struct sockaddr_in6* server6 = (struct sockaddr_in6*)server;
+  if (inet_pton(AF_INET, address, &server4->sin_addr) == 1) {
+    server4->sin_family = AF_INET;
+    server4->sin_port = htons((uint16_t)port);
+    return true;
+  }
+  if (inet_pton(AF_INET6, address, &server6->sin6_addr) == 1) {
+    server6->sin6_family = AF_INET6;
+    server6->sin6_port = htons((uint16_t)port);
+    return true;
+  }
+  return false;
+}
+
+
+// The servers of the `nameserver` lines of /etc/resolv.conf, or the local
+// one, as the C library uses.
+static void iotjs_dns_read_resolv_conf() {
+  dns_resolver.server_count = 0;
+
+  FILE* file = fopen("/etc/resolv.conf", "r");
+  if (file != NULL) {
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL &&
+           dns_resolver.server_count < IOTJS_DNS_MAX_SERVERS) {
+      char address[INET6_ADDRSTRLEN + 1];
+      if (sscanf(line, " nameserver %46s", address) == 1 &&
+          iotjs_dns_parse_server(
+              address, IOTJS_DNS_PORT,
+              &dns_resolver.servers[dns_resolver.server_count])) {
+        dns_resolver.server_count++;
+      }
+    }
+    fclose(file);
+  }
+
+  if (dns_resolver.server_count == 0) {
+    iotjs_dns_parse_server("127.0.0.1", IOTJS_DNS_PORT,
+                           &dns_resolver.servers[0]);
+    dns_resolver.server_count = 1;
+  }
+  dns_resolver.has_servers = true;
+}
+
+
+static void iotjs_dns_resolver_init() {
+  if (dns_resolver.is_initialized) {
+    return;
+  }
+
+  uv_timer_init(iotjs_dns_loop(), &dns_resolver.timer);
+  dns_resolver.random = (uint32_t)uv_hrtime() | 1;
+  dns_resolver.is_initialized = true;
+}
+
+
+static void OnResolverAlloc(uv_handle_t* handle, size_t suggested_size,
+                            uv_buf_t* buf) {
+  IOTJS_UNUSED(handle);
+  IOTJS_UNUSED(suggested_size);
+  // The messages are parsed before the next one is received.
+  *buf = uv_buf_init(dns_resolver_buffer, sizeof(dns_resolver_buffer));
+}
+
+
+static void OnResolverRecv(uv_udp_t* handle, ssize_t nread,
+                           const uv_buf_t* buf, const struct sockaddr* addr,
+                           unsigned flags);
+static void OnResolverTimeout(uv_timer_t* handle);
+
+
+// The socket the servers of a family are asked on, or NULL if it cannot be
+// opened.
+static uv_udp_t* iotjs_dns_resolver_socket(int family) {
+  bool is_ipv4 = family == AF_INET;
+  uv_udp_t* udp = is_ipv4 ? &dns_resolver.udp4 : &dns_resolver.udp6;
+  bool* is_open =
+      is_ipv4 ? &dns_resolver.is_udp4_open : &dns_resolver.is_udp6_open;
+  bool* is_failed =
+      is_ipv4 ? &dns_resolver.is_udp4_failed : &dns_resolver.is_udp6_failed;
+
+  if (*is_open) {
+    return udp;
+  }
+  if (*is_failed) {
+    return NULL;
+  }
+
+  struct sockaddr_storage any;
+  memset(&any, 0, sizeof(any));
+  any.ss_family = (sa_family_t)family;
+
+  uv_udp_init(iotjs_dns_loop(), udp);
+  if (uv_udp_bind(udp, (const struct sockaddr*)&any, 0) != 0 ||
+      uv_udp_recv_start(udp, OnResolverAlloc, OnResolverRecv) != 0) {
+    uv_close((uv_handle_t*)udp, NULL);
+    *is_failed = true;
+    return NULL;
+  }
+  uv_unref((uv_handle_t*)udp);
+
+  *is_open = true;
+  return udp;
+}
+
+
+// Converts `hostname` into the labels of a question. Returns false for a name
+// that cannot be asked.
+static bool iotjs_dns_encode_name(const char* hostname, uint8_t* name,
+                                  size_t* name_size) {
+  size_t length = strlen(hostname);
+  if (length > 0 && hostname[length - 1] == '.') {
+    length--;
+  }
+  if (length == 0 || length + 2 > IOTJS_DNS_NAME_SIZE) {
+    return false;
+  }
+
+  size_t size = 0;
+  size_t start = 0;
+  for (size_t i = 0; i <= length; i++) {
+    if (i < length && hostname[i] != '.') {
+      continue;
+    }
+    size_t label = i - start;
+    if (label == 0 || label > IOTJS_DNS_MAX_LABEL) {
+      return false;
+    }
+    name[size++] = (uint8_t)label;
+    memcpy(name + size, hostname + start, label);
+    size += label;
+    start = i + 1;
+  }
+  name[size++] = 0;
+
+  *name_size = size;
+  return true;
+}
+
+
+static void iotjs_dns_question_send(iotjs_dns_query_t* query,
+                                    iotjs_dns_question_t* question) {
+  uv_loop_t* loop = iotjs_dns_loop();
+  question->id = iotjs_dns_random_id();
+  question->deadline = uv_now(loop) + query->timeout;
+
+  uint8_t packet[IOTJS_DNS_HEADER_SIZE + IOTJS_DNS_NAME_SIZE + 4];
+  memset(packet, 0, IOTJS_DNS_HEADER_SIZE);
+  iotjs_dns_write16(packet, question->id);
+  iotjs_dns_write16(packet + 2, IOTJS_DNS_FLAG_RECURSION);
+  iotjs_dns_write16(packet + 4, 1);
+
+  uint8_t* p = packet + IOTJS_DNS_HEADER_SIZE;
+  memcpy(p, query->name, query->name_size);
+  p += query->name_size;
+  iotjs_dns_write16(p, question->type);
+  iotjs_dns_write16(p + 2, IOTJS_DNS_CLASS_IN);
+  p += 4;
+
+  question->server %= dns_resolver.server_count;
+  const struct sockaddr* server =
+      (const struct sockaddr*)&dns_resolver.servers[question->server];
+  uv_udp_t* udp = iotjs_dns_resolver_socket(server->sa_family);
+  uv_buf_t buf = uv_buf_init((char*)packet, (unsigned int)(p - packet));
+
+  // A datagram the socket does not take counts as a try without an answer,
+  // and the next server is asked at once.
+  if (udp == NULL || uv_udp_try_send(udp, &buf, 1, server) < 0) {
+    question->deadline = uv_now(loop);
+  }
+}
+
+
+static void iotjs_dns_question_retry(iotjs_dns_query_t* query,
+                                     iotjs_dns_question_t* question) {
+  if (++question->tries >= query->tries * dns_resolver.server_count) {
+    question->is_pending = false;
+    return;
+  }
+  question->server = (question->server + 1) % dns_resolver.server_count;
+  iotjs_dns_question_send(query, question);
+}
+
+
+// Skips a name of a message, which may end with a pointer to another name.
+// Returns the offset after it, or 0 if the message is malformed.
+static size_t iotjs_dns_skip_name(const uint8_t* msg, size_t size,
+                                  size_t offset) {
+  while (offset < size) {
+    uint8_t length = msg[offset];
+    if (length == 0) {
+      return offset + 1;
+    }
+    if ((length & 0xc0) == 0xc0) {
+      return offset + 2 <= size ? offset + 2 : 0;
+    }
+    if (length & 0xc0) {
+      return 0;
+    }
+    offset += 1 + (size_t)length;
+  }
+  return 0;
+}
+
+
+// Reads the address of the answer to a question from a message.
+static int iotjs_dns_parse_answer(const iotjs_dns_query_t* query,
+                                  iotjs_dns_question_t* question,
+                                  const uint8_t* msg, size_t size,
+                                  bool is_partial) {
+  uint16_t flags = iotjs_dns_read16(msg + 2);
+  size_t offset = IOTJS_DNS_HEADER_SIZE;
+
+  // The question is sent back as it was asked, the letters aside.
+  if (!(flags & IOTJS_DNS_FLAG_RESPONSE) || iotjs_dns_read16(msg + 4) != 1 ||
+      offset + query->name_size + 4 > size) {
+    return IOTJS_DNS_IGNORE;
+  }
+  for (size_t i = 0; i < query->name_size; i++) {
+    if (tolower(msg[offset + i]) != tolower(query->name[i])) {
+      return IOTJS_DNS_IGNORE;
+    }
+  }
+  offset += query->name_size;
+  if (iotjs_dns_read16(msg + offset) != question->type ||
+      iotjs_dns_read16(msg + offset + 2) != IOTJS_DNS_CLASS_IN) {
+    return IOTJS_DNS_IGNORE;
+  }
+  offset += 4;
+
+  int rcode = flags & IOTJS_DNS_RCODE_MASK;
+  if (rcode == IOTJS_DNS_RCODE_NXDOMAIN) {
+    return UV__EAI_NONAME;
+  }
+  if (rcode != 0) {
+    return IOTJS_DNS_RETRY;
+  }
+
+  // The CNAME records that lead to the address come before it.
+  size_t address_size = question->type == IOTJS_DNS_TYPE_A ? 4 : 16;
+  uint16_t count = iotjs_dns_read16(msg + 6);
+  for (uint16_t i = 0; i < count; i++) {
+    offset = iotjs_dns_skip_name(msg, size, offset);
+    if (offset == 0 || offset + 10 > size) {
+      break;
+    }
+    uint16_t type = iotjs_dns_read16(msg + offset);
+    uint16_t rclass = iotjs_dns_read16(msg + offset + 2);
+    size_t rdlength = iotjs_dns_read16(msg + offset + 8);
+    offset += 10;
+    if (offset + rdlength > size) {
+      break;
+    }
+    if (type == question->type && rclass == IOTJS_DNS_CLASS_IN &&
+        rdlength == address_size) {
+      memcpy(question->address, msg + offset, address_size);
+      return 0;
+    }
+    offset += rdlength;
+  }
+
+  if (is_partial || (flags & IOTJS_DNS_FLAG_TRUNCATED)) {
+    return IOTJS_DNS_RETRY;
+  }
+  return UV__EAI_NODATA;
+}
+
+
+// Whether a query has its result: the address of the family asked first, or
+// the answers to all its questions.
+static bool iotjs_dns_query_is_done(const iotjs_dns_query_t* query) {
+  const iotjs_dns_question_t* first = &query->questions[query->family == 6];
+  const iotjs_dns_question_t* second = &query->questions[query->family != 6];
+  return !first->is_pending && (first->status == 0 || !second->is_pending);
+}
+
+
+static void iotjs_dns_query_complete(iotjs_dns_query_t* query) {
+  const iotjs_dns_question_t* first = &query->questions[query->family == 6];
+  const iotjs_dns_question_t* second = &query->questions[query->family != 6];
+
+  iotjs_jargs_t args = iotjs_jargs_create(3);
+
+  if (first->status == 0 || second->status == 0) {
+    uint8_t address[16];
+    int family;
+    if (first->status == 0) {
+      family = first->type == IOTJS_DNS_TYPE_A ? AF_INET : AF_INET6;
+      memcpy(address, first->address, sizeof(address));
+    } else if (query->family == 6) {
+      // An IPv4 address mapped to IPv6, asked for by V4MAPPED.
+      family = AF_INET6;
+      memset(address, 0, 10);
+      address[10] = address[11] = 0xff;
+      memcpy(address + 12, second->address, 4);
+    } else {
+      family = AF_INET6;
+      memcpy(address, second->address, sizeof(address));
+    }
+
+    char ip[INET6_ADDRSTRLEN];
+    inet_ntop(family, address, ip, sizeof(ip));
+    iotjs_jargs_append_null(&args);
+    iotjs_jargs_append_string_raw(&args, ip);
+    iotjs_jargs_append_number(&args, family == AF_INET ? 4 : 6);
+  } else {
+    iotjs_jargs_append_error(&args, getaddrinfo_error_str(first->status));
+  }
+
+  iotjs_make_callback(&query->jcallback, iotjs_jval_get_undefined(), &args);
+  iotjs_jargs_destroy(&args);
+
+  iotjs_jval_destroy(&query->jcallback);
+  IOTJS_POOL_RELEASE(dns_query_pool, query);
+}
+
+
+// Calls back the queries that are done, and sets the timer to the next
+// deadline.
+static void iotjs_dns_resolver_flush() {
+  iotjs_dns_query_t** link = &dns_resolver.queries;
+  while (*link != NULL) {
+    iotjs_dns_query_t* query = *link;
+    if (iotjs_dns_query_is_done(query)) {
+      // The callback may add queries in front of the list.
+      *link = query->next;
+      iotjs_dns_query_complete(query);
+    } else {
+      link = &query->next;
+    }
+  }
+
+  bool has_deadline = false;
+  uint64_t deadline = 0;
+  for (iotjs_dns_query_t* query = dns_resolver.queries; query != NULL;
+       query = query->next) {
+    for (int i = 0; i < 2; i++) {
+      const iotjs_dns_question_t* question = &query->questions[i];
+      if (question->is_pending &&
+          (!has_deadline || question->deadline < deadline)) {
+        deadline = question->deadline;
+        has_deadline = true;
+      }
+    }
+  }
+
+  if (!has_deadline) {
+    uv_timer_stop(&dns_resolver.timer);
+    return;
+  }
+
+  uint64_t now = uv_now(iotjs_dns_loop());
+  uv_timer_start(&dns_resolver.timer, OnResolverTimeout,
+                 deadline > now ? deadline - now : 0, 0);
+}
+
+
+static void OnResolverTimeout(uv_timer_t* handle) {
+  uint64_t now = uv_now(handle->loop);
+  for (iotjs_dns_query_t* query = dns_resolver.queries; query != NULL;
+       query = query->next) {
+    for (int i = 0; i < 2; i++) {
+      iotjs_dns_question_t* question = &query->questions[i];
+      if (question->is_pending && question->deadline <= now) {
+        iotjs_dns_question_retry(query, question);
+      }
+    }
+  }
+  iotjs_dns_resolver_flush();
+}
+
+
+static void OnResolverRecv(uv_udp_t* handle, ssize_t nread,
+                           const uv_buf_t* buf, const struct sockaddr* addr,
+                           unsigned flags) {
+  IOTJS_UNUSED(handle);
+  if (nread < IOTJS_DNS_HEADER_SIZE || addr == NULL) {
+    return;
+  }
+
+  const uint8_t* msg = (const uint8_t*)buf->base;
+  uint16_t id = iotjs_dns_read16(msg);
+
+  for (iotjs_dns_query_t* query = dns_resolver.queries; query != NULL;
+       query = query->next) {
+    for (int i = 0; i < 2; i++) {
+      iotjs_dns_question_t* question = &query->questions[i];
+      if (!question->is_pending || question->id != id ||
+          !iotjs_dns_sockaddr_equal(
+              addr, &dns_resolver.servers[question->server])) {
+        continue;
+      }
+
+      int status = iotjs_dns_parse_answer(query, question, msg, (size_t)nread,
+                                          (flags & UV_UDP_PARTIAL) != 0);
+      if (status == IOTJS_DNS_IGNORE) {
+        return;
+      }
+      if (status == IOTJS_DNS_RETRY) {
+        question->status = UV__EAI_FAIL;
+        iotjs_dns_question_retry(query, question);
+      } else {
+        question->status = status;
+        question->is_pending = false;
+        dns_resolver.last_server = question->server;
+      }
+      iotjs_dns_resolver_flush();
+      return;
+    }
+  }
+}
+
+
+// Reads an address of `family`, 0 for any, from `text`. With V4MAPPED, an
+// IPv4 address is taken for IPv6, mapped.
+static bool iotjs_dns_parse_address(const char* text, int family, int flags,
+                                    char* ip, int* ip_family) {
+  uint8_t address[16];
+  int af;
+  if (inet_pton(AF_INET, text, address) == 1) {
+    af = AF_INET;
+    if (family == 6 && (flags & AI_V4MAPPED)) {
+      memmove(address + 12, address, 4);
+      memset(address, 0, 10);
+      address[10] = address[11] = 0xff;
+      af = AF_INET6;
+    } else if (family == 6) {
+      return false;
+    }
+  } else if (inet_pton(AF_INET6, text, address) == 1) {
+    af = AF_INET6;
+    if (family == 4) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+
+  *ip_family = af == AF_INET ? 4 : 6;
+  return inet_ntop(af, address, ip, INET6_ADDRSTRLEN) != NULL;
+}
+
+
+// Finds `hostname` in /etc/hosts, whose lines are an address and its names.
+static bool iotjs_dns_find_host(const char* hostname, int family, int flags,
+                                char* ip, int* ip_family) {
+  FILE* file = fopen("/etc/hosts", "r");
+  if (file == NULL) {
+    return false;
+  }
+
+  bool is_found = false;
+  char line[512];
+  while (!is_found && fgets(line, sizeof(line), file) != NULL) {
+    char* comment = strchr(line, '#');
+    if (comment != NULL) {
+      *comment = '\0';
+    }
+
+    char* saveptr;
+    const char* address = strtok_r(line, " \t\r\n", &saveptr);
+    if (address == NULL) {
+      continue;
+    }
+    const char* name;
+    while ((name = strtok_r(NULL, " \t\r\n", &saveptr)) != NULL) {
+      if (strcasecmp(name, hostname) == 0) {
+        is_found =
+            iotjs_dns_parse_address(address, family, flags, ip, ip_family);
+        break;
+      }
+    }
+  }
+
+  fclose(file);
+  return is_found;
+}
+
+
+// lookupLocal(hostname, family, hints)
+// Returns the address and the family of a numeric `hostname`, or of its line
+// in /etc/hosts, or undefined if it has to be resolved.
+JHANDLER_FUNCTION(LookupLocal) {
+  DJHANDLER_CHECK_ARGS(3, string, number, number);
+
+  iotjs_string_t hostname = JHANDLER_GET_ARG(0, string);
+  int family = JHANDLER_GET_ARG(1, number);
+  int flags = JHANDLER_GET_ARG(2, number);
+
+  char ip[INET6_ADDRSTRLEN];
+  int ip_family;
+  const char* name = iotjs_string_data(&hostname);
+  if (iotjs_dns_parse_address(name, family, flags, ip, &ip_family) ||
+      iotjs_dns_find_host(name, family, flags, ip, &ip_family)) {
+    iotjs_jval_t jresult = iotjs_jval_create_array(2);
+    iotjs_jval_t jip = iotjs_jval_create_string_raw(ip);
+    iotjs_jval_t jfamily = iotjs_jval_create_number(ip_family);
+    iotjs_jval_set_property_by_index(&jresult, 0, &jip);
+    iotjs_jval_set_property_by_index(&jresult, 1, &jfamily);
+    iotjs_jhandler_return_jval(jhandler, &jresult);
+    iotjs_jval_destroy(&jfamily);
+    iotjs_jval_destroy(&jip);
+    iotjs_jval_destroy(&jresult);
+  }
+
+  iotjs_string_destroy(&hostname);
+}
+
+
+// resolve(hostname, family, hints, {timeout, tries}, callback)
+// Asks the servers for the address of `hostname`, and calls back as
+// getaddrinfo does. Returns the error message if it cannot be asked.
+JHANDLER_FUNCTION(Resolve) {
+  DJHANDLER_CHECK_ARGS(5, string, number, number, object, function);
+
+  const iotjs_jval_t* joptions = JHANDLER_GET_ARG(3, object);
+  double timeout;
+  double tries;
+  DJHANDLER_GET_REQUIRED_CONF_VALUE(joptions, timeout,
+                                    IOTJS_MAGIC_STRING_TIMEOUT, number);
+  DJHANDLER_GET_REQUIRED_CONF_VALUE(joptions, tries, IOTJS_MAGIC_STRING_TRIES,
+                                    number);
+
+  iotjs_string_t hostname = JHANDLER_GET_ARG(0, string);
+  int family = JHANDLER_GET_ARG(1, number);
+  int flags = JHANDLER_GET_ARG(2, number);
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG(4, function);
+
+  iotjs_dns_resolver_init();
+  if (!dns_resolver.has_servers) {
+    iotjs_dns_read_resolv_conf();
+  }
+
+  uint8_t name[IOTJS_DNS_NAME_SIZE];
+  size_t name_size;
+  if (!iotjs_dns_encode_name(iotjs_string_data(&hostname), name,
+                             &name_size)) {
+    iotjs_string_destroy(&hostname);
+    iotjs_jhandler_return_string_raw(jhandler,
+                                     getaddrinfo_error_str(UV__EAI_NONAME));
+    return;
+  }
+  iotjs_string_destroy(&hostname);
+
+  iotjs_dns_query_t* query =
+      IOTJS_POOL_ALLOC(dns_query_pool, iotjs_dns_query_t);
+  query->jcallback = iotjs_jval_create_copied(jcallback);
+  query->family = family;
+  query->flags = flags;
+  query->timeout = timeout >= 1 ? (unsigned)timeout : 1;
+  query->tries = tries >= 1 ? (unsigned)tries : 1;
+  memcpy(query->name, name, name_size);
+  query->name_size = name_size;
+
+  // The IPv4 address is asked for IPv6 too with V4MAPPED, in case there is
+  // no IPv6 one.
+  bool asks[2] = { family != 6 || (flags & AI_V4MAPPED), family != 4 };
+  for (int i = 0; i < 2; i++) {
+    iotjs_dns_question_t* question = &query->questions[i];
+    question->type = i == 0 ? IOTJS_DNS_TYPE_A : IOTJS_DNS_TYPE_AAAA;
+    question->server = dns_resolver.last_server;
+    question->is_pending = asks[i];
+    question->status = asks[i] ? UV__EAI_AGAIN : UV__EAI_NODATA;
+    if (asks[i]) {
+      iotjs_dns_question_send(query, question);
+    }
+  }
+
+  query->next = dns_resolver.queries;
+  dns_resolver.queries = query;
+  iotjs_dns_resolver_flush();
+}
+
+
+// setServers(servers)
+// Asks the servers, given as addresses and ports in a row, in place of the
+// ones of /etc/resolv.conf.
+JHANDLER_FUNCTION(SetServers) {
+  DJHANDLER_CHECK_ARGS(1, array);
+  const iotjs_jval_t* jservers = JHANDLER_GET_ARG(0, array);
+
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jservers, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t length = iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+
+  if (length == 0 || length % 2 != 0 ||
+      length / 2 > IOTJS_DNS_MAX_SERVERS) {
+    JHANDLER_THROW(RANGE, "There must be 1 to 4 servers");
+    return;
+  }
+
+  struct sockaddr_storage servers[IOTJS_DNS_MAX_SERVERS];
+  for (uint32_t i = 0; i < length; i += 2) {
+    iotjs_jval_t jaddress = iotjs_jval_get_property_by_index(jservers, i);
+    iotjs_jval_t jport = iotjs_jval_get_property_by_index(jservers, i + 1);
+    bool is_valid = false;
+    if (iotjs_jval_is_string(&jaddress) && iotjs_jval_is_number(&jport)) {
+      iotjs_string_t address = iotjs_jval_as_string(&jaddress);
+      is_valid = iotjs_dns_parse_server(iotjs_string_data(&address),
+                                        (int)iotjs_jval_as_number(&jport),
+                                        &servers[i / 2]);
+      iotjs_string_destroy(&address);
+    }
+    iotjs_jval_destroy(&jaddress);
+    iotjs_jval_destroy(&jport);
+    if (!is_valid) {
+      JHANDLER_THROW(TYPE, "Invalid server address");
+      return;
+    }
+  }
+
+  // The questions on the way go on to the new servers.
+  memcpy(dns_resolver.servers, servers, sizeof(servers));
+  dns_resolver.server_count = length / 2;
+  dns_resolver.last_server = 0;
+  dns_resolver.has_servers = true;
+}
+
+
+// getServers()
+// Returns the addresses and the ports of the servers in a row.
+JHANDLER_FUNCTION(GetServers) {
+  if (!dns_resolver.has_servers) {
+    iotjs_dns_read_resolv_conf();
+  }
+
+  iotjs_jval_t jservers =
+      iotjs_jval_create_array(dns_resolver.server_count * 2);
+  for (unsigned i = 0; i < dns_resolver.server_count; i++) {
+    const struct sockaddr_storage* server = &dns_resolver.servers[i];
+    char ip[INET6_ADDRSTRLEN];
+    int port;
+    if (server->ss_family == AF_INET) {
+      const struct sockaddr_in* server4 = (const struct sockaddr_in*)server;
+      inet_ntop(AF_INET, &server4->sin_addr, ip, sizeof(ip));
+      port = ntohs(server4->sin_port);
+    } else {
+      const struct sockaddr_in6* server6 = (const struct sockaddr_in6*)server;
+      inet_ntop(AF_INET6, &server6->sin6_addr, ip, sizeof(ip));
+      port = ntohs(server6->sin6_port);
+    }
+
+    iotjs_jval_t jip = iotjs_jval_create_string_raw(ip);
+    iotjs_jval_t jport = iotjs_jval_create_number(port);
+    iotjs_jval_set_property_by_index(&jservers, i * 2, &jip);
+    iotjs_jval_set_property_by_index(&jservers, i * 2 + 1, &jport);
+    iotjs_jval_destroy(&jip);
+    iotjs_jval_destroy(&jport);
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jservers);
+  iotjs_jval_destroy(&jservers);
+}
+
+
+void iotjs_dns_release() {
+  // The lookups on the way are never called back.
+  while (dns_resolver.queries != NULL) {
+    iotjs_dns_query_t* query = dns_resolver.queries;
+    dns_resolver.queries = query->next;
+    iotjs_jval_destroy(&query->jcallback);
+    IOTJS_POOL_RELEASE(dns_query_pool, query);
+  }
+
+  if (!dns_resolver.is_initialized) {
+    return;
+  }
+  if (dns_resolver.is_udp4_open) {
+    uv_close((uv_handle_t*)&dns_resolver.udp4, NULL);
+  }
+  if (dns_resolver.is_udp6_open) {
+    uv_close((uv_handle_t*)&dns_resolver.udp6, NULL);
+  }
+  uv_close((uv_handle_t*)&dns_resolver.timer, NULL);
+
+  // The handles are closed by the loop after this.
+  dns_resolver.is_initialized = false;
+  dns_resolver.is_udp4_open = dns_resolver.is_udp6_open = false;
+  dns_resolver.is_udp4_failed = dns_resolver.is_udp6_failed = false;
+  dns_resolver.has_servers = false;
+}
+
+#else
+
+void iotjs_dns_release() {
+}
+
+#endif
+
+
 #define SET_CONSTANT(object, constant)                           \
   do {                                                           \
     iotjs_jval_set_property_number(object, #constant, constant); \
@@ -256,6 +1101,12 @@ iotjs_jval_t InitDns() {
   iotjs_jval_t dns = iotjs_jval_create_object();
 
   iotjs_jval_set_method(&dns, IOTJS_MAGIC_STRING_GETADDRINFO, GetAddrInfo);
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+  iotjs_jval_set_method(&dns, IOTJS_MAGIC_STRING_LOOKUPLOCAL, LookupLocal);
+  iotjs_jval_set_method(&dns, IOTJS_MAGIC_STRING_RESOLVE, Resolve);
+  iotjs_jval_set_method(&dns, IOTJS_MAGIC_STRING_SETSERVERS, SetServers);
+  iotjs_jval_set_method(&dns, IOTJS_MAGIC_STRING_GETSERVERS, GetServers);
+#endif
   SET_CONSTANT(&dns, AI_ADDRCONFIG);
   SET_CONSTANT(&dns, AI_V4MAPPED);
 
@@ -40,4 +40,8 @@ const iotjs_jval_t* iotjs_getaddrinfo_reqwrap_jcallback(THIS);
 #undef THIS
 
 
+// Closes the handles of the resolver, and drops the lookups on the way.
+void iotjs_dns_release();
+
+
 #endif /* IOTJS_MODULE_DNS_H */
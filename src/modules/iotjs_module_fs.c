@@ -16,29 +16,100 @@
 #include "iotjs_def.h"
 
 #include "iotjs_module_buffer.h"
+#include "iotjs_module_fs.h"
 
 #include "iotjs_exception.h"
+#include "iotjs_handlewrap.h"
+#include "iotjs_probes.h"
 #include "iotjs_reqwrap.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+#include <sys/mman.h>
+#endif
+#include <sys/stat.h>
+#include <unistd.h>
+
 
 typedef struct {
   iotjs_reqwrap_t reqwrap;
   uv_fs_t req;
+  iotjs_jval_t jpromise;
+  // The Buffer of a read or a write, which must live until the call is done.
+  iotjs_jval_t jbuffer;
 } iotjs_fs_reqwrap_t;
 
 
-iotjs_fs_reqwrap_t* iotjs_fs_reqwrap_create(const iotjs_jval_t* jcallback) {
-  iotjs_fs_reqwrap_t* fs_reqwrap = IOTJS_ALLOC(iotjs_fs_reqwrap_t);
+IOTJS_DEFINE_POOL(fs_reqwrap_pool, iotjs_fs_reqwrap_t, "fs",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
+// fs.promises passes `usePromise` of the binding for the callback of an
+// asynchronous call. The call then returns a promise, which is settled in
+// the after callback without calling into JavaScript.
+static const jerry_object_native_info_t iotjs_fs_use_promise_info = { NULL };
+
+
+static iotjs_jval_t iotjs_fs_create_jpromise(const iotjs_jval_t* jcallback) {
+  if (iotjs_jval_get_object_native_handle_of(jcallback,
+                                             &iotjs_fs_use_promise_info)) {
+    return iotjs_jval_create_promise();
+  }
+  return iotjs_jval_create_copied(iotjs_jval_get_null());
+}
+
+
+// Settles the promise of a call, or calls its callback with (error) on
+// failure and (null, result) on success.
+static void iotjs_fs_complete(const iotjs_jval_t* jcallback,
+                              const iotjs_jval_t* jpromise,
+                              const iotjs_jval_t* jresult, bool failed) {
+  if (iotjs_jval_is_object(jpromise)) {
+    // The calls which give null to a callback resolve to undefined.
+    if (!failed && iotjs_jval_is_null(jresult)) {
+      jresult = iotjs_jval_get_undefined();
+    }
+    iotjs_jval_settle_promise(jpromise, jresult, !failed);
+    return;
+  }
+
+  IOTJS_ASSERT(iotjs_jval_is_function(jcallback));
+  iotjs_jargs_t jarg = iotjs_jargs_create(2);
+  if (failed) {
+    iotjs_jargs_append_jval(&jarg, jresult);
+  } else {
+    iotjs_jargs_append_null(&jarg);
+    if (!iotjs_jval_is_undefined(jresult)) {
+      iotjs_jargs_append_jval(&jarg, jresult);
+    }
+  }
+
+  iotjs_make_callback(jcallback, iotjs_jval_get_undefined(), &jarg);
+
+  iotjs_jargs_destroy(&jarg);
+}
+
+
+iotjs_fs_reqwrap_t* iotjs_fs_reqwrap_create(const iotjs_jval_t* jcallback,
+                                            const iotjs_jval_t* jbuffer) {
+  iotjs_fs_reqwrap_t* fs_reqwrap =
+      IOTJS_POOL_ALLOC(fs_reqwrap_pool, iotjs_fs_reqwrap_t);
   iotjs_reqwrap_initialize(&fs_reqwrap->reqwrap, jcallback,
                            (uv_req_t*)&fs_reqwrap->req);
+  fs_reqwrap->jpromise = iotjs_fs_create_jpromise(jcallback);
+  fs_reqwrap->jbuffer = iotjs_jval_create_copied(
+      jbuffer != NULL ? jbuffer : iotjs_jval_get_undefined());
   return fs_reqwrap;
 }
 
 
 static void iotjs_fs_reqwrap_destroy(iotjs_fs_reqwrap_t* fs_reqwrap) {
   uv_fs_req_cleanup(&fs_reqwrap->req);
+  iotjs_jval_destroy(&fs_reqwrap->jpromise);
+  iotjs_jval_destroy(&fs_reqwrap->jbuffer);
   iotjs_reqwrap_destroy(&fs_reqwrap->reqwrap);
-  IOTJS_RELEASE(fs_reqwrap);
+  IOTJS_POOL_RELEASE(fs_reqwrap_pool, fs_reqwrap);
 }
 
 iotjs_jval_t MakeStatObject(uv_stat_t* statbuf);
@@ -48,60 +119,68 @@ static void AfterAsync(uv_fs_t* req) {
   iotjs_fs_reqwrap_t* req_wrap = (iotjs_fs_reqwrap_t*)(req->data);
   IOTJS_ASSERT(req_wrap != NULL);
   IOTJS_ASSERT(&req_wrap->req == req);
+  IOTJS_PROBE2(fs__done, req->fs_type, req->result);
 
   const iotjs_jval_t* cb = iotjs_reqwrap_jcallback(&req_wrap->reqwrap);
-  IOTJS_ASSERT(iotjs_jval_is_function(cb));
 
-  iotjs_jargs_t jarg = iotjs_jargs_create(2);
+  switch (req->fs_type) {
+    case UV_FS_OPEN:
+    case UV_FS_MKDIR:
+    case UV_FS_RMDIR:
+    case UV_FS_UNLINK:
+    case UV_FS_RENAME: {
+      // Module resolution may have looked at the paths while the call ran.
+      iotjs_fs_probe_cache_release();
+      break;
+    }
+    default:
+      break;
+  }
+
+  iotjs_jval_t jresult;
   if (req->result < 0) {
-    iotjs_jval_t jerror = iotjs_create_uv_exception(req->result, "open");
-    iotjs_jargs_append_jval(&jarg, &jerror);
-    iotjs_jval_destroy(&jerror);
+    jresult = iotjs_create_uv_exception(req->result, "open");
   } else {
-    iotjs_jargs_append_null(&jarg);
     switch (req->fs_type) {
       case UV_FS_CLOSE: {
+        jresult = iotjs_jval_create_copied(iotjs_jval_get_undefined());
         break;
       }
       case UV_FS_OPEN:
       case UV_FS_READ:
       case UV_FS_WRITE: {
-        iotjs_jargs_append_number(&jarg, (double)req->result);
+        jresult = iotjs_jval_create_number((double)req->result);
         break;
       }
       case UV_FS_SCANDIR: {
         int r;
         uv_dirent_t ent;
         uint32_t idx = 0;
-        iotjs_jval_t ret = iotjs_jval_create_array(0);
+        jresult = iotjs_jval_create_array(0);
         while ((r = uv_fs_scandir_next(req, &ent)) != UV_EOF) {
           iotjs_jval_t name = iotjs_jval_create_string_raw(ent.name);
-          iotjs_jval_set_property_by_index(&ret, idx, &name);
+          iotjs_jval_set_property_by_index(&jresult, idx, &name);
           iotjs_jval_destroy(&name);
           idx++;
         }
-        iotjs_jargs_append_jval(&jarg, &ret);
-        iotjs_jval_destroy(&ret);
         break;
       }
       case UV_FS_FSTAT:
       case UV_FS_STAT: {
         uv_stat_t s = (req->statbuf);
-        iotjs_jval_t ret = MakeStatObject(&s);
-        iotjs_jargs_append_jval(&jarg, &ret);
-        iotjs_jval_destroy(&ret);
+        jresult = MakeStatObject(&s);
         break;
       }
       default: {
-        iotjs_jargs_append_null(&jarg);
+        jresult = iotjs_jval_create_copied(iotjs_jval_get_null());
         break;
       }
     }
   }
 
-  iotjs_make_callback(cb, iotjs_jval_get_undefined(), &jarg);
+  iotjs_fs_complete(cb, &req_wrap->jpromise, &jresult, req->result < 0);
 
-  iotjs_jargs_destroy(&jarg);
+  iotjs_jval_destroy(&jresult);
   iotjs_fs_reqwrap_destroy(req_wrap);
 }
 
@@ -169,16 +248,97 @@ static inline bool IsWithinBounds(size_t off, size_t len, size_t max) {
   return true;
 }
 
-#define FS_ASYNC(env, syscall, pcallback, ...)                                \
-  iotjs_fs_reqwrap_t* req_wrap = iotjs_fs_reqwrap_create(pcallback);          \
+// Module resolution probes many paths which do not exist for every require().
+// The outcomes are remembered until the next call which may create or remove
+// a file. Only absolute paths are kept, since relative ones depend on the
+// working directory.
+#define IOTJS_FS_PROBE_CACHE_SIZE 256 // a power of two
+
+
+typedef struct {
+  char* path;
+  uint32_t hash;
+  bool is_file;
+} iotjs_fs_probe_entry_t;
+
+
+static iotjs_fs_probe_entry_t iotjs_fs_probe_cache[IOTJS_FS_PROBE_CACHE_SIZE];
+static size_t iotjs_fs_probe_count = 0;
+
+
+void iotjs_fs_probe_cache_release() {
+  for (size_t i = 0; i < IOTJS_FS_PROBE_CACHE_SIZE; i++) {
+    if (iotjs_fs_probe_cache[i].path != NULL) {
+      iotjs_buffer_release(iotjs_fs_probe_cache[i].path);
+      iotjs_fs_probe_cache[i].path = NULL;
+    }
+  }
+  iotjs_fs_probe_count = 0;
+}
+
+
+static uint32_t iotjs_fs_probe_hash(const char* path) {
+  uint32_t hash = 2166136261U;
+  for (; *path != '\0'; path++) {
+    hash = (hash ^ (uint8_t)*path) * 16777619U;
+  }
+  return hash;
+}
+
+
+// Whether `path` is there and is not a directory, like the stat() checks of
+// module.js.
+static bool iotjs_fs_probe(const char* path) {
+  if (path[0] != '/') {
+    struct stat statbuf;
+    return stat(path, &statbuf) == 0 && !S_ISDIR(statbuf.st_mode);
+  }
+
+  uint32_t hash = iotjs_fs_probe_hash(path);
+  size_t index = hash & (IOTJS_FS_PROBE_CACHE_SIZE - 1);
+
+  while (iotjs_fs_probe_cache[index].path != NULL) {
+    iotjs_fs_probe_entry_t* entry = &iotjs_fs_probe_cache[index];
+    if (entry->hash == hash && !strcmp(entry->path, path)) {
+      return entry->is_file;
+    }
+    index = (index + 1) & (IOTJS_FS_PROBE_CACHE_SIZE - 1);
+  }
+
+  struct stat statbuf;
+  bool is_file = stat(path, &statbuf) == 0 && !S_ISDIR(statbuf.st_mode);
+
+  // Starting over keeps the probe sequences short.
+  if (iotjs_fs_probe_count >= IOTJS_FS_PROBE_CACHE_SIZE * 3 / 4) {
+    iotjs_fs_probe_cache_release();
+    index = hash & (IOTJS_FS_PROBE_CACHE_SIZE - 1);
+  }
+
+  size_t length = strlen(path);
+  iotjs_fs_probe_entry_t* entry = &iotjs_fs_probe_cache[index];
+  entry->path = iotjs_buffer_allocate(length + 1);
+  memcpy(entry->path, path, length);
+  entry->hash = hash;
+  entry->is_file = is_file;
+  iotjs_fs_probe_count++;
+
+  return is_file;
+}
+
+
+// Returns the promise of the call if it has one, or null.
+#define FS_ASYNC(env, syscall, pcallback, pbuffer, ...)                       \
+  iotjs_fs_reqwrap_t* req_wrap = iotjs_fs_reqwrap_create(pcallback, pbuffer); \
   uv_fs_t* fs_req = &req_wrap->req;                                           \
+  iotjs_jval_t jreturn = iotjs_jval_create_copied(&req_wrap->jpromise);       \
   int err = uv_fs_##syscall(iotjs_environment_loop(env), fs_req, __VA_ARGS__, \
                             AfterAsync);                                      \
   if (err < 0) {                                                              \
     fs_req->result = err;                                                     \
     AfterAsync(fs_req);                                                       \
   }                                                                           \
-  iotjs_jhandler_return_null(jhandler);
+  iotjs_jhandler_return_jval(jhandler, &jreturn);                             \
+  iotjs_jval_destroy(&jreturn);
 
 
 #define FS_SYNC(env, syscall, ...)                                             \
@@ -200,7 +360,7 @@ JHANDLER_FUNCTION(Close) {
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
   if (jcallback) {
-    FS_ASYNC(env, close, jcallback, fd);
+    FS_ASYNC(env, close, jcallback, NULL, fd);
   } else {
     FS_SYNC(env, close, fd);
   }
@@ -219,8 +379,12 @@ JHANDLER_FUNCTION(Open) {
   int mode = JHANDLER_GET_ARG(2, number);
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(3, function);
 
+  if (flags & O_CREAT) {
+    iotjs_fs_probe_cache_release();
+  }
+
   if (jcallback) {
-    FS_ASYNC(env, open, jcallback, iotjs_string_data(&path), flags, mode);
+    FS_ASYNC(env, open, jcallback, NULL, iotjs_string_data(&path), flags, mode);
   } else {
     FS_SYNC(env, open, iotjs_string_data(&path), flags, mode);
   }
@@ -261,7 +425,7 @@ JHANDLER_FUNCTION(Read) {
   uv_buf_t uvbuf = uv_buf_init(data + offset, length);
 
   if (jcallback) {
-    FS_ASYNC(env, read, jcallback, fd, &uvbuf, 1, position);
+    FS_ASYNC(env, read, jcallback, jbuffer, fd, &uvbuf, 1, position);
   } else {
     FS_SYNC(env, read, fd, &uvbuf, 1, position);
   }
@@ -300,7 +464,7 @@ JHANDLER_FUNCTION(Write) {
   uv_buf_t uvbuf = uv_buf_init(data + offset, length);
 
   if (jcallback) {
-    FS_ASYNC(env, write, jcallback, fd, &uvbuf, 1, position);
+    FS_ASYNC(env, write, jcallback, jbuffer, fd, &uvbuf, 1, position);
   } else {
     FS_SYNC(env, write, fd, &uvbuf, 1, position);
   }
@@ -336,6 +500,11 @@ iotjs_jval_t MakeStatObject(uv_stat_t* statbuf) {
 
 #undef X
 
+  // Milliseconds, as node.js has it.
+  double mtime_ms = (double)statbuf->st_mtim.tv_sec * 1000 +
+                    (double)statbuf->st_mtim.tv_nsec / 1000000;
+  iotjs_jval_set_property_number(&jstat, IOTJS_MAGIC_STRING_MTIMEMS, mtime_ms);
+
   return jstat;
 }
 
@@ -351,7 +520,7 @@ JHANDLER_FUNCTION(Stat) {
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
   if (jcallback) {
-    FS_ASYNC(env, stat, jcallback, iotjs_string_data(&path));
+    FS_ASYNC(env, stat, jcallback, NULL, iotjs_string_data(&path));
   } else {
     FS_SYNC(env, stat, iotjs_string_data(&path));
   }
@@ -371,7 +540,7 @@ JHANDLER_FUNCTION(Fstat) {
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
   if (jcallback) {
-    FS_ASYNC(env, fstat, jcallback, fd);
+    FS_ASYNC(env, fstat, jcallback, NULL, fd);
   } else {
     FS_SYNC(env, fstat, fd);
   }
@@ -389,8 +558,10 @@ JHANDLER_FUNCTION(MkDir) {
   int mode = JHANDLER_GET_ARG(1, number);
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(2, function);
 
+  iotjs_fs_probe_cache_release();
+
   if (jcallback) {
-    FS_ASYNC(env, mkdir, jcallback, iotjs_string_data(&path), mode);
+    FS_ASYNC(env, mkdir, jcallback, NULL, iotjs_string_data(&path), mode);
   } else {
     FS_SYNC(env, mkdir, iotjs_string_data(&path), mode);
   }
@@ -409,8 +580,10 @@ JHANDLER_FUNCTION(RmDir) {
   iotjs_string_t path = JHANDLER_GET_ARG(0, string);
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
+  iotjs_fs_probe_cache_release();
+
   if (jcallback) {
-    FS_ASYNC(env, rmdir, jcallback, iotjs_string_data(&path));
+    FS_ASYNC(env, rmdir, jcallback, NULL, iotjs_string_data(&path));
   } else {
     FS_SYNC(env, rmdir, iotjs_string_data(&path));
   }
@@ -429,8 +602,10 @@ JHANDLER_FUNCTION(Unlink) {
   iotjs_string_t path = JHANDLER_GET_ARG(0, string);
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
+  iotjs_fs_probe_cache_release();
+
   if (jcallback) {
-    FS_ASYNC(env, unlink, jcallback, iotjs_string_data(&path));
+    FS_ASYNC(env, unlink, jcallback, NULL, iotjs_string_data(&path));
   } else {
     FS_SYNC(env, unlink, iotjs_string_data(&path));
   }
@@ -450,8 +625,10 @@ JHANDLER_FUNCTION(Rename) {
   iotjs_string_t newPath = JHANDLER_GET_ARG(1, string);
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(2, function);
 
+  iotjs_fs_probe_cache_release();
+
   if (jcallback) {
-    FS_ASYNC(env, rename, jcallback, iotjs_string_data(&oldPath),
+    FS_ASYNC(env, rename, jcallback, NULL, iotjs_string_data(&oldPath),
              iotjs_string_data(&newPath));
   } else {
     FS_SYNC(env, rename, iotjs_string_data(&oldPath),
@@ -473,13 +650,360 @@ JHANDLER_FUNCTION(ReadDir) {
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
   if (jcallback) {
-    FS_ASYNC(env, scandir, jcallback, iotjs_string_data(&path), 0);
+    FS_ASYNC(env, scandir, jcallback, NULL, iotjs_string_data(&path), 0);
   } else {
     FS_SYNC(env, scandir, iotjs_string_data(&path), 0);
   }
   iotjs_string_destroy(&path);
 }
 
+// Files of unknown size, such as the ones in /proc, are read in chunks of this
+// size, doubling as the data grows.
+#define IOTJS_FS_READ_FILE_CHUNK 4096
+
+
+typedef struct {
+  char* data;
+  size_t length;
+  int result;
+  const char* syscall_name;
+} iotjs_fs_read_file_t;
+
+
+typedef struct {
+  iotjs_reqwrap_t reqwrap;
+  uv_work_t req;
+  iotjs_string_t path;
+  iotjs_fs_read_file_t file;
+  iotjs_jval_t jpromise;
+} iotjs_fs_read_file_reqwrap_t;
+
+
+// Reads the whole file at `path` into memory allocated with
+// iotjs_buffer_allocate. It makes plain system calls and touches no engine or
+// loop state, so it may also run on a threadpool thread.
+static void iotjs_fs_read_file(const char* path, iotjs_fs_read_file_t* file) {
+  file->data = NULL;
+  file->length = 0;
+  file->result = 0;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    file->result = -errno;
+    file->syscall_name = "open";
+    return;
+  }
+
+  // One byte more than the size, so the read reaching the end of the file
+  // does not need more memory.
+  struct stat statbuf;
+  size_t capacity = IOTJS_FS_READ_FILE_CHUNK;
+  if (fstat(fd, &statbuf) == 0 && S_ISREG(statbuf.st_mode) &&
+      statbuf.st_size > 0) {
+    capacity = (size_t)statbuf.st_size + 1;
+  }
+
+  char* data = iotjs_buffer_allocate(capacity);
+  size_t length = 0;
+
+  while (true) {
+    if (length == capacity) {
+      capacity *= 2;
+      data = iotjs_buffer_reallocate(data, capacity);
+      IOTJS_ASSERT(data != NULL);
+    }
+
+    ssize_t nread = read(fd, data + length, capacity - length);
+    if (nread < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      file->result = -errno;
+      file->syscall_name = "read";
+      iotjs_buffer_release(data);
+      close(fd);
+      return;
+    }
+    if (nread == 0) {
+      break;
+    }
+    length += (size_t)nread;
+  }
+
+  close(fd);
+
+  file->data = data;
+  file->length = length;
+}
+
+
+static void iotjs_fs_release_file_data(void* data) {
+  iotjs_buffer_release((char*)data);
+}
+
+
+// Creates the error or the Buffer for the outcome of iotjs_fs_read_file,
+// taking over the data.
+static iotjs_jval_t iotjs_fs_read_file_result(iotjs_fs_read_file_t* file,
+                                              bool* failed) {
+  *failed = file->result < 0;
+  if (*failed) {
+    return iotjs_create_uv_exception(file->result, file->syscall_name);
+  }
+
+  if (file->length == 0) {
+    iotjs_buffer_release(file->data);
+    return iotjs_bufferwrap_create_buffer(0);
+  }
+
+  return iotjs_bufferwrap_create_buffer_external(file->data, file->length,
+                                                 iotjs_fs_release_file_data);
+}
+
+
+IOTJS_DEFINE_POOL(read_file_reqwrap_pool, iotjs_fs_read_file_reqwrap_t,
+                  "fs.readFile", IOTJS_REQWRAP_POOL_CAP);
+
+
+static void ReadFileWorker(uv_work_t* work_req) {
+  iotjs_fs_read_file_reqwrap_t* req_wrap =
+      (iotjs_fs_read_file_reqwrap_t*)(work_req->data);
+
+  iotjs_fs_read_file(iotjs_string_data(&req_wrap->path), &req_wrap->file);
+}
+
+
+static void AfterReadFile(uv_work_t* work_req, int status) {
+  iotjs_fs_read_file_reqwrap_t* req_wrap =
+      (iotjs_fs_read_file_reqwrap_t*)(work_req->data);
+  IOTJS_ASSERT(&req_wrap->req == work_req);
+
+  const iotjs_jval_t* cb = iotjs_reqwrap_jcallback(&req_wrap->reqwrap);
+
+  if (status < 0) {
+    req_wrap->file.result = status;
+    req_wrap->file.syscall_name = "read";
+  }
+
+  bool failed;
+  iotjs_jval_t jresult = iotjs_fs_read_file_result(&req_wrap->file, &failed);
+
+  iotjs_fs_complete(cb, &req_wrap->jpromise, &jresult, failed);
+
+  iotjs_jval_destroy(&jresult);
+  iotjs_jval_destroy(&req_wrap->jpromise);
+  iotjs_string_destroy(&req_wrap->path);
+  iotjs_reqwrap_destroy(&req_wrap->reqwrap);
+  IOTJS_POOL_RELEASE(read_file_reqwrap_pool, req_wrap);
+}
+
+
+// Reads a whole file with one threadpool job instead of a round trip per
+// chunk. The data is read into one allocation of the size of the file, which
+// the returned Buffer takes over.
+JHANDLER_FUNCTION(ReadFile) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(1, string);
+  DJHANDLER_CHECK_ARG_IF_EXIST(1, function);
+
+  const iotjs_environment_t* env = iotjs_environment_get();
+
+  iotjs_string_t path = JHANDLER_GET_ARG(0, string);
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
+
+  if (jcallback) {
+    iotjs_fs_read_file_reqwrap_t* req_wrap =
+        IOTJS_POOL_ALLOC(read_file_reqwrap_pool, iotjs_fs_read_file_reqwrap_t);
+    iotjs_reqwrap_initialize(&req_wrap->reqwrap, jcallback,
+                             (uv_req_t*)&req_wrap->req);
+    req_wrap->path = path;
+    req_wrap->jpromise = iotjs_fs_create_jpromise(jcallback);
+    iotjs_jval_t jreturn = iotjs_jval_create_copied(&req_wrap->jpromise);
+
+    int err = uv_queue_work(iotjs_environment_loop(env), &req_wrap->req,
+                            ReadFileWorker, AfterReadFile);
+    if (err < 0) {
+      AfterReadFile(&req_wrap->req, err);
+    }
+    iotjs_jhandler_return_jval(jhandler, &jreturn);
+    iotjs_jval_destroy(&jreturn);
+  } else {
+    iotjs_fs_read_file_t file;
+    iotjs_fs_read_file(iotjs_string_data(&path), &file);
+
+    bool failed;
+    iotjs_jval_t jresult = iotjs_fs_read_file_result(&file, &failed);
+    if (failed) {
+      iotjs_jhandler_throw(jhandler, &jresult);
+    } else {
+      iotjs_jhandler_return_jval(jhandler, &jresult);
+    }
+    iotjs_jval_destroy(&jresult);
+
+    iotjs_string_destroy(&path);
+  }
+}
+
+
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+// A file mapping backing a Buffer. The Buffer only knows the address of its
+// data, so the mappings are kept in a list to find what to unmap.
+typedef struct iotjs_fs_mapping_s {
+  char* data;
+  void* base;
+  size_t size;
+  struct iotjs_fs_mapping_s* next;
+} iotjs_fs_mapping_t;
+
+
+static iotjs_fs_mapping_t* iotjs_fs_mappings = NULL;
+
+
+static void iotjs_fs_unmap(void* data) {
+  iotjs_fs_mapping_t** link = &iotjs_fs_mappings;
+  while (*link != NULL) {
+    iotjs_fs_mapping_t* mapping = *link;
+    if (mapping->data == data) {
+      *link = mapping->next;
+      munmap(mapping->base, mapping->size);
+      IOTJS_RELEASE(mapping);
+      return;
+    }
+    link = &mapping->next;
+  }
+  IOTJS_ASSERT(false);
+}
+
+
+static int iotjs_fs_advice(const iotjs_string_t* advice) {
+  const char* name = iotjs_string_data(advice);
+  if (!strcmp(name, "random")) {
+    return MADV_RANDOM;
+  } else if (!strcmp(name, "sequential")) {
+    return MADV_SEQUENTIAL;
+  } else if (!strcmp(name, "willneed")) {
+    return MADV_WILLNEED;
+  } else if (!strcmp(name, "normal")) {
+    return MADV_NORMAL;
+  }
+  return -1;
+}
+#endif
+
+
+// Maps `length` bytes of the file at `offset` into memory and returns a
+// Buffer over the mapping, which is unmapped when the Buffer is collected.
+// Pages are read from the file when they are first touched and can be dropped
+// again under memory pressure. The mapping is private: writing to the Buffer
+// does not change the file.
+// [0] fd
+// [1] offset
+// [2] length
+// [3] advice (optional) - 'normal', 'random', 'sequential' or 'willneed'
+JHANDLER_FUNCTION(Mmap) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(3, number, number, number);
+
+#if defined(__NUTTX__) || defined(__TIZENRT__)
+  JHANDLER_THROW(COMMON, "mmap is not supported on this platform");
+#else
+  int fd = JHANDLER_GET_ARG(0, number);
+  double offset = JHANDLER_GET_ARG(1, number);
+  double length = JHANDLER_GET_ARG(2, number);
+
+  if (offset < 0 || offset != (off_t)offset) {
+    JHANDLER_THROW(RANGE, "offset out of bound");
+    return;
+  }
+  if (length <= 0 || length != (size_t)length) {
+    JHANDLER_THROW(RANGE, "length out of bound");
+    return;
+  }
+
+  int advice = MADV_NORMAL;
+  if (iotjs_jhandler_get_arg_length(jhandler) > 3) {
+    DJHANDLER_CHECK_ARGS(4, number, number, number, string);
+    iotjs_string_t jadvice = JHANDLER_GET_ARG(3, string);
+    advice = iotjs_fs_advice(&jadvice);
+    iotjs_string_destroy(&jadvice);
+    if (advice < 0) {
+      JHANDLER_THROW(TYPE, "Bad arguments - unknown advice");
+      return;
+    }
+  }
+
+  // mmap() takes offsets at page boundaries, so the mapping may start a bit
+  // before the data.
+  off_t page_size = (off_t)sysconf(_SC_PAGESIZE);
+  off_t base_offset = (off_t)offset - (off_t)offset % page_size;
+  size_t skip = (size_t)((off_t)offset - base_offset);
+  size_t size = skip + (size_t)length;
+
+  void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                    base_offset);
+  if (base == MAP_FAILED) {
+    iotjs_jval_t jerror = iotjs_create_uv_exception(-errno, "mmap");
+    iotjs_jhandler_throw(jhandler, &jerror);
+    iotjs_jval_destroy(&jerror);
+    return;
+  }
+
+  if (advice != MADV_NORMAL) {
+    // Only a hint, failing to give it does not fail the mapping.
+    madvise(base, size, advice);
+  }
+
+  iotjs_fs_mapping_t* mapping = IOTJS_ALLOC(iotjs_fs_mapping_t);
+  mapping->data = (char*)base + skip;
+  mapping->base = base;
+  mapping->size = size;
+  mapping->next = iotjs_fs_mappings;
+  iotjs_fs_mappings = mapping;
+
+  iotjs_jval_t jbuffer =
+      iotjs_bufferwrap_create_buffer_external(mapping->data, (size_t)length,
+                                              iotjs_fs_unmap);
+  iotjs_jhandler_return_jval(jhandler, &jbuffer);
+  iotjs_jval_destroy(&jbuffer);
+#endif
+}
+
+
+// Returns the index of the first of `paths` from `start` on which is there and
+// is not a directory, or -1. Module resolution tries all its candidates for a
+// require() with one call.
+// [0] paths
+// [1] start (optional)
+JHANDLER_FUNCTION(Probe) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(1, object);
+
+  const iotjs_jval_t* jpaths = JHANDLER_GET_ARG(0, object);
+  const iotjs_jval_t* jstart = JHANDLER_GET_ARG_IF_EXIST(1, number);
+
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jpaths, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t length = iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+
+  uint32_t i = jstart != NULL ? iotjs_jval_as_number(jstart) : 0;
+  for (; i < length; i++) {
+    iotjs_jval_t jpath = iotjs_jval_get_property_by_index(jpaths, i);
+    iotjs_string_t path = iotjs_jval_as_string(&jpath);
+    bool found = iotjs_fs_probe(iotjs_string_data(&path));
+    iotjs_string_destroy(&path);
+    iotjs_jval_destroy(&jpath);
+
+    if (found) {
+      iotjs_jhandler_return_number(jhandler, i);
+      return;
+    }
+  }
+
+  iotjs_jhandler_return_number(jhandler, -1);
+}
+
+
 static void StatsIsTypeOf(iotjs_jhandler_t* jhandler, int type) {
   DJHANDLER_CHECK_THIS(object);
   const iotjs_jval_t* stats = JHANDLER_GET_THIS(object);
@@ -492,6 +1016,12 @@ static void StatsIsTypeOf(iotjs_jhandler_t* jhandler, int type) {
   iotjs_jhandler_return_boolean(jhandler, (mode_number & S_IFMT) == type);
 }
 
+// Only marks the calls of fs.promises, it is never called.
+JHANDLER_FUNCTION(UsePromise) {
+  iotjs_jhandler_return_undefined(jhandler);
+}
+
+
 JHANDLER_FUNCTION(StatsIsDirectory) {
   StatsIsTypeOf(jhandler, S_IFDIR);
 }
@@ -500,21 +1030,357 @@ JHANDLER_FUNCTION(StatsIsFile) {
   StatsIsTypeOf(jhandler, S_IFREG);
 }
 
+
+// The changes of a watched path within `latency` milliseconds of the first
+// one are passed to JavaScript together, with the events of each file name
+// merged, so that a burst of writes makes one call.
+#define IOTJS_FS_WATCH_MAX_PENDING 16
+
+
+#if defined(__linux__)
+typedef struct {
+  iotjs_handlewrap_t handlewrap;
+  uv_fs_event_t handle;
+  uv_timer_t timer;
+  uint64_t latency;
+  // The file names with changes, or NULL for the changes of the names which
+  // did not fit.
+  char* pending_names[IOTJS_FS_WATCH_MAX_PENDING];
+  int pending_events[IOTJS_FS_WATCH_MAX_PENDING];
+  size_t pending_count;
+  int status;
+} IOTJS_VALIDATED_STRUCT(iotjs_fswatcher_t);
+
+
+static void iotjs_fswatcher_destroy(iotjs_fswatcher_t* watcher);
+IOTJS_DEFINE_NATIVE_HANDLE_INFO(fswatcher);
+
+
+static void iotjs_fswatcher_clear(iotjs_fswatcher_t* watcher) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_fswatcher_t, watcher);
+  for (size_t i = 0; i < _this->pending_count; i++) {
+    if (_this->pending_names[i] != NULL) {
+      iotjs_buffer_release(_this->pending_names[i]);
+    }
+  }
+  _this->pending_count = 0;
+}
+
+
+static void iotjs_fswatcher_destroy(iotjs_fswatcher_t* watcher) {
+  iotjs_fswatcher_clear(watcher);
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_fswatcher_t, watcher);
+  iotjs_handlewrap_destroy(&_this->handlewrap);
+  IOTJS_RELEASE(watcher);
+}
+
+
+// Calls watcher.onChange(status, events, filenames) with the changes since
+// the last call.
+static void iotjs_fswatcher_flush(uv_timer_t* timer) {
+  iotjs_fswatcher_t* watcher = (iotjs_fswatcher_t*)timer->data;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_fswatcher_t, watcher);
+
+  iotjs_jval_t jevents = iotjs_jval_create_array(0);
+  iotjs_jval_t jnames = iotjs_jval_create_array(0);
+  for (size_t i = 0; i < _this->pending_count; i++) {
+    iotjs_jval_t jevent = iotjs_jval_create_number(_this->pending_events[i]);
+    iotjs_jval_t jname =
+        _this->pending_names[i] != NULL
+            ? iotjs_jval_create_string_raw(_this->pending_names[i])
+            : iotjs_jval_create_copied(iotjs_jval_get_null());
+    iotjs_jval_set_property_by_index(&jevents, (uint32_t)i, &jevent);
+    iotjs_jval_set_property_by_index(&jnames, (uint32_t)i, &jname);
+    iotjs_jval_destroy(&jevent);
+    iotjs_jval_destroy(&jname);
+  }
+  iotjs_fswatcher_clear(watcher);
+
+  const iotjs_jval_t* jwatcher = iotjs_handlewrap_jobject(&_this->handlewrap);
+  iotjs_jval_t jonchange =
+      iotjs_jval_get_property(jwatcher, IOTJS_MAGIC_STRING_ONCHANGE);
+  if (iotjs_jval_is_function(&jonchange)) {
+    iotjs_jargs_t jargs = iotjs_jargs_create(3);
+    iotjs_jargs_append_number(&jargs, _this->status);
+    iotjs_jargs_append_jval(&jargs, &jevents);
+    iotjs_jargs_append_jval(&jargs, &jnames);
+    _this->status = 0;
+    iotjs_make_callback(&jonchange, jwatcher, &jargs);
+    iotjs_jargs_destroy(&jargs);
+  }
+  iotjs_jval_destroy(&jonchange);
+  iotjs_jval_destroy(&jevents);
+  iotjs_jval_destroy(&jnames);
+}
+
+
+static void iotjs_fswatcher_on_event(uv_fs_event_t* handle,
+                                     const char* filename, int events,
+                                     int status) {
+  iotjs_fswatcher_t* watcher =
+      (iotjs_fswatcher_t*)iotjs_handlewrap_from_handle((uv_handle_t*)handle);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_fswatcher_t, watcher);
+
+  if (status < 0) {
+    _this->status = status;
+  } else {
+    size_t i = 0;
+    for (; i < _this->pending_count; i++) {
+      const char* name = _this->pending_names[i];
+      if (name == NULL || (filename != NULL && strcmp(name, filename) == 0)) {
+        break;
+      }
+    }
+
+    if (i == _this->pending_count) {
+      char* name = NULL;
+      if (filename != NULL && i < IOTJS_FS_WATCH_MAX_PENDING - 1) {
+        size_t size = strlen(filename) + 1;
+        name = iotjs_buffer_allocate(size);
+        memcpy(name, filename, size);
+      }
+      _this->pending_names[i] = name;
+      _this->pending_events[i] = 0;
+      _this->pending_count++;
+    }
+    _this->pending_events[i] |= events;
+  }
+
+  if (!uv_is_active((uv_handle_t*)&_this->timer)) {
+    uv_timer_start(&_this->timer, iotjs_fswatcher_flush, _this->latency, 0);
+  }
+}
+
+
+static void iotjs_fswatcher_on_timer_close(uv_handle_t* timer) {
+  iotjs_fswatcher_t* watcher = (iotjs_fswatcher_t*)timer->data;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_fswatcher_t, watcher);
+  iotjs_handlewrap_close(&_this->handlewrap, NULL);
+}
+
+
+JHANDLER_FUNCTION(FsWatcher) {
+  DJHANDLER_CHECK_THIS(object);
+
+  iotjs_fswatcher_t* watcher = IOTJS_ALLOC(iotjs_fswatcher_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_fswatcher_t, watcher);
+
+  iotjs_handlewrap_initialize(&_this->handlewrap, JHANDLER_GET_THIS(object),
+                              (uv_handle_t*)&_this->handle,
+                              &fswatcher_native_info);
+
+  uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());
+  uv_fs_event_init(loop, &_this->handle);
+  uv_timer_init(loop, &_this->timer);
+  _this->timer.data = watcher;
+}
+
+
+#define FSWATCHER_DECLARE_THIS(name)                              \
+  iotjs_fswatcher_t* name = (iotjs_fswatcher_t*)                  \
+      iotjs_jval_get_object_from_jhandler(jhandler,               \
+                                          &fswatcher_native_info); \
+  if (!name) {                                                    \
+    return;                                                       \
+  }
+
+
+// Returns 0, or the error of watching the path.
+// [0] path
+// [1] latency of the changes, in milliseconds
+// [2] whether the watcher keeps the process alive
+JHANDLER_FUNCTION(FsWatcherStart) {
+  FSWATCHER_DECLARE_THIS(watcher);
+  DJHANDLER_CHECK_ARGS(3, string, number, boolean);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_fswatcher_t, watcher);
+
+  iotjs_string_t path = JHANDLER_GET_ARG(0, string);
+  double latency = JHANDLER_GET_ARG(1, number);
+  _this->latency = latency > 0 ? (uint64_t)latency : 0;
+
+  int err = uv_fs_event_start(&_this->handle, iotjs_fswatcher_on_event,
+                              iotjs_string_data(&path), 0);
+  iotjs_string_destroy(&path);
+
+  if (err == 0 && !JHANDLER_GET_ARG(2, boolean)) {
+    uv_unref((uv_handle_t*)&_this->handle);
+    uv_unref((uv_handle_t*)&_this->timer);
+  }
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Stops watching, dropping the changes not passed on yet.
+JHANDLER_FUNCTION(FsWatcherClose) {
+  FSWATCHER_DECLARE_THIS(watcher);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_fswatcher_t, watcher);
+
+  // The handle is closed after the timer, which refers to the watcher.
+  uv_handle_t* timer = (uv_handle_t*)&_this->timer;
+  if (!uv_is_closing(timer)) {
+    uv_fs_event_stop(&_this->handle);
+    uv_close(timer, iotjs_fswatcher_on_timer_close);
+  }
+}
+#endif
+
+
+typedef struct {
+  iotjs_handlewrap_t handlewrap;
+  uv_fs_poll_t handle;
+} IOTJS_VALIDATED_STRUCT(iotjs_statwatcher_t);
+
+
+static void iotjs_statwatcher_destroy(iotjs_statwatcher_t* watcher);
+IOTJS_DEFINE_NATIVE_HANDLE_INFO(statwatcher);
+
+
+static void iotjs_statwatcher_destroy(iotjs_statwatcher_t* watcher) {
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_statwatcher_t, watcher);
+  iotjs_handlewrap_destroy(&_this->handlewrap);
+  IOTJS_RELEASE(watcher);
+}
+
+
+// Calls watcher.onChange(status, current, previous) when the stats of the
+// path change. No stats are made while they stay the same.
+static void iotjs_statwatcher_on_change(uv_fs_poll_t* handle, int status,
+                                        const uv_stat_t* prev,
+                                        const uv_stat_t* curr) {
+  iotjs_statwatcher_t* watcher =
+      (iotjs_statwatcher_t*)iotjs_handlewrap_from_handle((uv_handle_t*)handle);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_statwatcher_t, watcher);
+
+  const iotjs_jval_t* jwatcher = iotjs_handlewrap_jobject(&_this->handlewrap);
+  iotjs_jval_t jonchange =
+      iotjs_jval_get_property(jwatcher, IOTJS_MAGIC_STRING_ONCHANGE);
+  if (iotjs_jval_is_function(&jonchange)) {
+    iotjs_jval_t jcurr = MakeStatObject((uv_stat_t*)curr);
+    iotjs_jval_t jprev = MakeStatObject((uv_stat_t*)prev);
+    iotjs_jargs_t jargs = iotjs_jargs_create(3);
+    iotjs_jargs_append_number(&jargs, status);
+    iotjs_jargs_append_jval(&jargs, &jcurr);
+    iotjs_jargs_append_jval(&jargs, &jprev);
+    iotjs_make_callback(&jonchange, jwatcher, &jargs);
+    iotjs_jargs_destroy(&jargs);
+    iotjs_jval_destroy(&jcurr);
+    iotjs_jval_destroy(&jprev);
+  }
+  iotjs_jval_destroy(&jonchange);
+}
+
+
+JHANDLER_FUNCTION(StatWatcher) {
+  DJHANDLER_CHECK_THIS(object);
+
+  iotjs_statwatcher_t* watcher = IOTJS_ALLOC(iotjs_statwatcher_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_statwatcher_t, watcher);
+
+  iotjs_handlewrap_initialize(&_this->handlewrap, JHANDLER_GET_THIS(object),
+                              (uv_handle_t*)&_this->handle,
+                              &statwatcher_native_info);
+
+  uv_fs_poll_init(iotjs_environment_loop(iotjs_environment_get()),
+                  &_this->handle);
+}
+
+
+#define STATWATCHER_DECLARE_THIS(name)                              \
+  iotjs_statwatcher_t* name = (iotjs_statwatcher_t*)                \
+      iotjs_jval_get_object_from_jhandler(jhandler,                 \
+                                          &statwatcher_native_info); \
+  if (!name) {                                                      \
+    return;                                                         \
+  }
+
+
+// Returns 0, or the error of starting to poll.
+// [0] path
+// [1] interval of the polls, in milliseconds
+// [2] whether the watcher keeps the process alive
+JHANDLER_FUNCTION(StatWatcherStart) {
+  STATWATCHER_DECLARE_THIS(watcher);
+  DJHANDLER_CHECK_ARGS(3, string, number, boolean);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_statwatcher_t, watcher);
+
+  iotjs_string_t path = JHANDLER_GET_ARG(0, string);
+  double interval = JHANDLER_GET_ARG(1, number);
+
+  int err = uv_fs_poll_start(&_this->handle, iotjs_statwatcher_on_change,
+                             iotjs_string_data(&path),
+                             interval > 0 ? (unsigned int)interval : 1);
+  iotjs_string_destroy(&path);
+
+  if (err == 0 && !JHANDLER_GET_ARG(2, boolean)) {
+    uv_unref((uv_handle_t*)&_this->handle);
+  }
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+JHANDLER_FUNCTION(StatWatcherClose) {
+  STATWATCHER_DECLARE_THIS(watcher);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_statwatcher_t, watcher);
+  iotjs_handlewrap_close(&_this->handlewrap, NULL);
+}
+
+
 iotjs_jval_t InitFs() {
   iotjs_jval_t fs = iotjs_jval_create_object();
 
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_CLOSE, Close);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_OPEN, Open);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_READ, Read);
+  iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_READFILE, ReadFile);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_WRITE, Write);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_STAT, Stat);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_FSTAT, Fstat);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_MKDIR, MkDir);
+  iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_MMAP, Mmap);
+  iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_PROBE, Probe);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_RMDIR, RmDir);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_UNLINK, Unlink);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_RENAME, Rename);
   iotjs_jval_set_method(&fs, IOTJS_MAGIC_STRING_READDIR, ReadDir);
 
+  if (iotjs_jval_is_promise_supported()) {
+    iotjs_jval_t juse_promise =
+        iotjs_jval_create_function_with_dispatch(UsePromise);
+    iotjs_jval_set_object_native_handle(&juse_promise, 1,
+                                        &iotjs_fs_use_promise_info);
+    iotjs_jval_set_property_jval(&fs, IOTJS_MAGIC_STRING_USEPROMISE,
+                                 &juse_promise);
+    iotjs_jval_destroy(&juse_promise);
+  }
+
+#if defined(__linux__)
+  iotjs_jval_t jfswatcher = iotjs_jval_create_function_with_dispatch(FsWatcher);
+  iotjs_jval_t fswatcher_prototype = iotjs_jval_create_object();
+  iotjs_jval_set_method(&fswatcher_prototype, IOTJS_MAGIC_STRING_START,
+                        FsWatcherStart);
+  iotjs_jval_set_method(&fswatcher_prototype, IOTJS_MAGIC_STRING_CLOSE,
+                        FsWatcherClose);
+  iotjs_jval_set_property_jval(&jfswatcher, IOTJS_MAGIC_STRING_PROTOTYPE,
+                               &fswatcher_prototype);
+  iotjs_jval_set_property_jval(&fs, IOTJS_MAGIC_STRING_FSWATCHER, &jfswatcher);
+  iotjs_jval_destroy(&fswatcher_prototype);
+  iotjs_jval_destroy(&jfswatcher);
+#endif
+
+  iotjs_jval_t jstatwatcher =
+      iotjs_jval_create_function_with_dispatch(StatWatcher);
+  iotjs_jval_t statwatcher_prototype = iotjs_jval_create_object();
+  iotjs_jval_set_method(&statwatcher_prototype, IOTJS_MAGIC_STRING_START,
+                        StatWatcherStart);
+  iotjs_jval_set_method(&statwatcher_prototype, IOTJS_MAGIC_STRING_CLOSE,
+                        StatWatcherClose);
+  iotjs_jval_set_property_jval(&jstatwatcher, IOTJS_MAGIC_STRING_PROTOTYPE,
+                               &statwatcher_prototype);
+  iotjs_jval_set_property_jval(&fs, IOTJS_MAGIC_STRING_STATWATCHER,
+                               &jstatwatcher);
+  iotjs_jval_destroy(&statwatcher_prototype);
+  iotjs_jval_destroy(&jstatwatcher);
+
   iotjs_jval_t stats_prototype = iotjs_jval_create_object();
 
   iotjs_jval_set_method(&stats_prototype, IOTJS_MAGIC_STRING_ISDIRECTORY,
@@ -22,7 +22,7 @@
 
 
 static iotjs_gpio_t* iotjs_gpio_instance_from_jval(const iotjs_jval_t* jgpio);
-IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(gpio);
+IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE_IMMEDIATE(gpio);
 
 
 static iotjs_gpio_t* iotjs_gpio_create(const iotjs_jval_t* jgpio) {
@@ -39,6 +39,9 @@ static iotjs_gpio_t* iotjs_gpio_create(const iotjs_jval_t* jgpio) {
 static void iotjs_gpio_destroy(iotjs_gpio_t* gpio) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_gpio_t, gpio);
   iotjs_gpio_platform_destroy(_this);
+  if (_this->lines != NULL) {
+    iotjs_buffer_release((char*)_this->lines);
+  }
   iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
   IOTJS_RELEASE(gpio);
 }
@@ -47,9 +50,14 @@ static void iotjs_gpio_destroy(iotjs_gpio_t* gpio) {
 #define THIS iotjs_gpio_reqwrap_t* gpio_reqwrap
 
 
+IOTJS_DEFINE_POOL(gpio_reqwrap_pool, iotjs_gpio_reqwrap_t, "gpio",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 static iotjs_gpio_reqwrap_t* iotjs_gpio_reqwrap_create(
     const iotjs_jval_t* jcallback, iotjs_gpio_t* gpio, GpioOp op) {
-  iotjs_gpio_reqwrap_t* gpio_reqwrap = IOTJS_ALLOC(iotjs_gpio_reqwrap_t);
+  iotjs_gpio_reqwrap_t* gpio_reqwrap =
+      IOTJS_POOL_ALLOC(gpio_reqwrap_pool, iotjs_gpio_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_gpio_reqwrap_t, gpio_reqwrap);
 
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -63,7 +71,7 @@ static iotjs_gpio_reqwrap_t* iotjs_gpio_reqwrap_create(
 static void iotjs_gpio_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_gpio_reqwrap_t, gpio_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(gpio_reqwrap);
+  IOTJS_POOL_RELEASE(gpio_reqwrap_pool, gpio_reqwrap);
 }
 
 
@@ -73,7 +81,7 @@ static void iotjs_gpio_reqwrap_dispatched(THIS) {
 }
 
 
-static uv_work_t* iotjs_gpio_reqwrap_req(THIS) {
+static iotjs_bus_work_t* iotjs_gpio_reqwrap_req(THIS) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_reqwrap_t, gpio_reqwrap);
   return &_this->req;
 }
@@ -162,6 +170,7 @@ static void iotjs_gpio_after_worker(uv_work_t* work_req, int status) {
         if (!result) {
           iotjs_jargs_append_error(&jargs, "GPIO Open Error");
         } else {
+          iotjs_gpio_edge_start(iotjs_gpio_instance_from_reqwrap(req_wrap));
           iotjs_jargs_append_null(&jargs);
         }
         break;
@@ -194,7 +203,8 @@ static void iotjs_gpio_after_worker(uv_work_t* work_req, int status) {
   }
 
   const iotjs_jval_t* jcallback = iotjs_gpio_reqwrap_jcallback(req_wrap);
-  iotjs_make_callback(jcallback, iotjs_jval_get_undefined(), &jargs);
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, jcallback,
+                              iotjs_jval_get_undefined(), &jargs);
 
   iotjs_jargs_destroy(&jargs);
 
@@ -206,9 +216,36 @@ static void gpio_set_configurable(iotjs_gpio_t* gpio,
                                   const iotjs_jval_t* jconfigurable) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
 
+  iotjs_jval_t jchip =
+      iotjs_jval_get_property(jconfigurable, IOTJS_MAGIC_STRING_CHIP);
+  _this->chip =
+      iotjs_jval_is_number(&jchip) ? (int32_t)iotjs_jval_as_number(&jchip) : -1;
+  iotjs_jval_destroy(&jchip);
+
   iotjs_jval_t jpin =
       iotjs_jval_get_property(jconfigurable, IOTJS_MAGIC_STRING_PIN);
-  _this->pin = iotjs_jval_as_number(&jpin);
+  _this->line_count = 1;
+  if (iotjs_jval_is_array(&jpin)) {
+    // A group of lines, which the script checked to be 1 to
+    // IOTJS_GPIO_LINES_MAX numbers.
+    iotjs_jval_t jlength =
+        iotjs_jval_get_property(&jpin, IOTJS_MAGIC_STRING_LENGTH);
+    _this->line_count = (uint32_t)iotjs_jval_as_number(&jlength);
+    iotjs_jval_destroy(&jlength);
+    IOTJS_ASSERT(_this->line_count > 0 &&
+                 _this->line_count <= IOTJS_GPIO_LINES_MAX);
+
+    _this->lines = (uint32_t*)iotjs_buffer_allocate(sizeof(uint32_t) *
+                                                    _this->line_count);
+    for (uint32_t i = 0; i < _this->line_count; ++i) {
+      iotjs_jval_t jline = iotjs_jval_get_property_by_index(&jpin, i);
+      _this->lines[i] = (uint32_t)iotjs_jval_as_number(&jline);
+      iotjs_jval_destroy(&jline);
+    }
+    _this->pin = _this->lines[0];
+  } else {
+    _this->pin = iotjs_jval_as_number(&jpin);
+  }
   iotjs_jval_destroy(&jpin);
 
   iotjs_jval_t jdirection =
@@ -223,32 +260,52 @@ static void gpio_set_configurable(iotjs_gpio_t* gpio,
 
   iotjs_jval_t jedge =
       iotjs_jval_get_property(jconfigurable, IOTJS_MAGIC_STRING_EDGE);
-  _this->edge = (GpioMode)iotjs_jval_as_number(&jedge);
+  _this->edge = (GpioEdge)iotjs_jval_as_number(&jedge);
   iotjs_jval_destroy(&jedge);
+
+  iotjs_jval_t jdebounce =
+      iotjs_jval_get_property(jconfigurable, IOTJS_MAGIC_STRING_DEBOUNCE);
+  _this->debounce = iotjs_jval_is_number(&jdebounce)
+                        ? (uint32_t)iotjs_jval_as_number(&jdebounce)
+                        : 0;
+  iotjs_jval_destroy(&jdebounce);
+
+  // The script checked the batch to be 1 to the size of the edge buffer.
+  iotjs_jval_t jcapture =
+      iotjs_jval_get_property(jconfigurable, IOTJS_MAGIC_STRING_CAPTURE);
+  if (iotjs_jval_is_object(&jcapture)) {
+    iotjs_jval_t jbatch =
+        iotjs_jval_get_property(&jcapture, IOTJS_MAGIC_STRING_BATCH);
+    iotjs_jval_t jlatency =
+        iotjs_jval_get_property(&jcapture, IOTJS_MAGIC_STRING_LATENCY);
+    _this->capture_batch = (uint32_t)iotjs_jval_as_number(&jbatch);
+    _this->capture_latency = (uint32_t)iotjs_jval_as_number(&jlatency);
+    iotjs_jval_destroy(&jbatch);
+    iotjs_jval_destroy(&jlatency);
+  }
+  iotjs_jval_destroy(&jcapture);
 }
 
 
-#define GPIO_ASYNC(call, this, jcallback, op)                          \
-  do {                                                                 \
-    uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get()); \
-    iotjs_gpio_reqwrap_t* req_wrap =                                   \
-        iotjs_gpio_reqwrap_create(jcallback, this, op);                \
-    uv_work_t* req = iotjs_gpio_reqwrap_req(req_wrap);                 \
-    uv_queue_work(loop, req, iotjs_gpio_##call##_worker,               \
-                  iotjs_gpio_after_worker);                            \
+#define GPIO_ASYNC(call, this, jcallback, op)                                 \
+  do {                                                                        \
+    iotjs_gpio_reqwrap_t* req_wrap =                                          \
+        iotjs_gpio_reqwrap_create(jcallback, this, op);                       \
+    iotjs_bus_work_t* req = iotjs_gpio_reqwrap_req(req_wrap);                 \
+    iotjs_busqueue_work(iotjs_busqueue_peripheral(), req,                     \
+                        iotjs_gpio_##call##_worker, iotjs_gpio_after_worker); \
   } while (0)
 
 
-#define GPIO_ASYNC_WITH_VALUE(call, this, jcallback, op, val)           \
-  do {                                                                  \
-    uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());  \
-    iotjs_gpio_reqwrap_t* req_wrap =                                    \
-        iotjs_gpio_reqwrap_create(jcallback, this, op);                 \
-    uv_work_t* req = iotjs_gpio_reqwrap_req(req_wrap);                  \
-    iotjs_gpio_reqdata_t* req_data = iotjs_gpio_reqwrap_data(req_wrap); \
-    req_data->value = val;                                              \
-    uv_queue_work(loop, req, iotjs_gpio_##call##_worker,                \
-                  iotjs_gpio_after_worker);                             \
+#define GPIO_ASYNC_WITH_VALUE(call, this, jcallback, op, val)                 \
+  do {                                                                        \
+    iotjs_gpio_reqwrap_t* req_wrap =                                          \
+        iotjs_gpio_reqwrap_create(jcallback, this, op);                       \
+    iotjs_bus_work_t* req = iotjs_gpio_reqwrap_req(req_wrap);                 \
+    iotjs_gpio_reqdata_t* req_data = iotjs_gpio_reqwrap_data(req_wrap);       \
+    req_data->value = val;                                                    \
+    iotjs_busqueue_work(iotjs_busqueue_peripheral(), req,                     \
+                        iotjs_gpio_##call##_worker, iotjs_gpio_after_worker); \
   } while (0)
 
 
@@ -309,12 +366,69 @@ JHANDLER_FUNCTION(Read) {
 }
 
 
+static uint32_t iotjs_gpio_line_count(iotjs_gpio_t* gpio) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+  return _this->line_count;
+}
+
+
+// writeLines(values)
+// Writes the values of all lines of the pin with one call.
+JHANDLER_FUNCTION(WriteLines) {
+  JHANDLER_DECLARE_THIS_PTR(gpio, gpio);
+  DJHANDLER_CHECK_ARGS(1, array);
+
+  const iotjs_jval_t* jvalues = JHANDLER_GET_ARG(0, array);
+  uint32_t line_count = iotjs_gpio_line_count(gpio);
+
+  uint8_t values[IOTJS_GPIO_LINES_MAX];
+  for (uint32_t i = 0; i < line_count; ++i) {
+    iotjs_jval_t jvalue = iotjs_jval_get_property_by_index(jvalues, i);
+    values[i] = iotjs_jval_as_boolean(&jvalue);
+    iotjs_jval_destroy(&jvalue);
+  }
+
+  if (!iotjs_gpio_write_lines(gpio, values)) {
+    JHANDLER_THROW(COMMON, "GPIO WriteSync Error");
+    return;
+  }
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
+// readLines()
+// Reads the values of all lines of the pin with one call.
+JHANDLER_FUNCTION(ReadLines) {
+  JHANDLER_DECLARE_THIS_PTR(gpio, gpio);
+
+  uint32_t line_count = iotjs_gpio_line_count(gpio);
+
+  uint8_t values[IOTJS_GPIO_LINES_MAX];
+  if (!iotjs_gpio_read_lines(gpio, values)) {
+    JHANDLER_THROW(COMMON, "GPIO ReadSync Error");
+    return;
+  }
+
+  iotjs_jval_t jvalues = iotjs_jval_create_array(line_count);
+  for (uint32_t i = 0; i < line_count; ++i) {
+    iotjs_jval_set_property_by_index(&jvalues, i,
+                                     iotjs_jval_get_boolean(values[i]));
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jvalues);
+  iotjs_jval_destroy(&jvalues);
+}
+
+
 JHANDLER_FUNCTION(Close) {
   JHANDLER_DECLARE_THIS_PTR(gpio, gpio)
   DJHANDLER_CHECK_ARG_IF_EXIST(0, function);
 
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(0, function);
 
+  iotjs_gpio_edge_stop(gpio);
+
   if (jcallback) {
     GPIO_ASYNC(close, gpio, jcallback, kGpioOpClose);
   } else {
@@ -337,6 +451,9 @@ iotjs_jval_t InitGpio() {
   iotjs_jval_t jprototype = iotjs_jval_create_object();
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_WRITE, Write);
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_READ, Read);
+  iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_WRITELINES,
+                        WriteLines);
+  iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_READLINES, ReadLines);
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_CLOSE, Close);
   iotjs_jval_set_property_jval(&jgpioConstructor, IOTJS_MAGIC_STRING_PROTOTYPE,
                                &jprototype);
@@ -19,6 +19,7 @@
 
 
 #include "iotjs_def.h"
+#include "iotjs_busqueue.h"
 #include "iotjs_objectwrap.h"
 #include "iotjs_reqwrap.h"
 
@@ -63,20 +64,36 @@ typedef struct {
 
 typedef struct _iotjs_gpio_module_platform_t* iotjs_gpio_module_platform_t;
 
+// The most lines of a chip a pin object can drive together.
+#define IOTJS_GPIO_LINES_MAX 64
+
+// The most edges kept for a pin in capture mode before they are passed on.
+#define IOTJS_GPIO_CAPTURE_MAX 512
+
 // This Gpio class provides interfaces for GPIO operation.
 typedef struct {
   iotjs_jobjectwrap_t jobjectwrap;
   uint32_t pin;
+  // The GPIO chip on Linux, or -1 for the sysfs interface. With a chip, the
+  // pin may be a group of `line_count` lines, `pin` being the first one.
+  int32_t chip;
+  uint32_t line_count;
+  uint32_t* lines;
   GpioDirection direction;
   GpioMode mode;
   GpioEdge edge;
+  uint32_t debounce;
+  // In capture mode, the edges are timestamped natively and passed on to
+  // `onCapture` by `capture_batch`, or after `capture_latency` milliseconds.
+  uint32_t capture_batch;
+  uint32_t capture_latency;
   iotjs_gpio_module_platform_t platform;
 } IOTJS_VALIDATED_STRUCT(iotjs_gpio_t);
 
 
 typedef struct {
   iotjs_reqwrap_t reqwrap;
-  uv_work_t req;
+  iotjs_bus_work_t req;
   iotjs_gpio_reqdata_t req_data;
   iotjs_gpio_t* gpio_instance;
 } IOTJS_VALIDATED_STRUCT(iotjs_gpio_reqwrap_t);
@@ -101,8 +118,17 @@ iotjs_gpio_t* iotjs_gpio_instance_from_reqwrap(THIS);
 void iotjs_gpio_open_worker(uv_work_t* work_req);
 bool iotjs_gpio_write(iotjs_gpio_t* gpio, bool value);
 int iotjs_gpio_read(iotjs_gpio_t* gpio);
+// Write and read the values of all lines of the pin at once.
+bool iotjs_gpio_write_lines(iotjs_gpio_t* gpio, const uint8_t* values);
+bool iotjs_gpio_read_lines(iotjs_gpio_t* gpio, uint8_t* values);
 bool iotjs_gpio_close(iotjs_gpio_t* gpio);
 void iotjs_gpio_platform_create(iotjs_gpio_t_impl_t* gpio);
 void iotjs_gpio_platform_destroy(iotjs_gpio_t_impl_t* gpio);
 
+// Start and stop reporting the edges of the pin with its `onChange` method,
+// or its `onCapture` method in capture mode. They run on the event loop
+// thread, once the pin is opened and before it is closed.
+void iotjs_gpio_edge_start(iotjs_gpio_t* gpio);
+void iotjs_gpio_edge_stop(iotjs_gpio_t* gpio);
+
 #endif /* IOTJS_MODULE_GPIO_H */
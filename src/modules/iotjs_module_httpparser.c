@@ -16,6 +16,12 @@
 
 #include "iotjs_def.h"
 #include "iotjs_module_buffer.h"
+#include "iotjs_module_httpparser.h"
+#if ENABLE_MODULE_TCP
+#include "iotjs_module_tcp.h"
+#endif
+#include <ctype.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,14 +29,20 @@
 #include "http_parser.h"
 
 
-// If # of header fields == HEADER_MAX, flush header to JS side.
-// This is weired : # of maximum headers in C equals to HEADER_MAX-1.
-// This is because , OnHeaders cb, we increase n_fields first,
-// and check whether field == HEADER_MAX.
-// ex) HEADER_MAX 2 means that we can keep at most 1 header field/value
-// during http parsing.
-// Increase this to minimize inter JS-C call
-#define HEADER_MAX 10
+// Header fields and values are collected in C, and passed to JS with the
+// OnHeadersComplete callback. When the fields of a message do not fit in
+// HEADER_MAX slots, the collected ones are flushed to JS by OnHeaders first.
+#define HEADER_MAX IOTJS_HTTP_PARSER_HEADER_MAX
+
+
+// Callback slots of the parser object.
+typedef enum {
+  IOTJS_HTTPPARSER_ONHEADERS,
+  IOTJS_HTTPPARSER_ONHEADERSCOMPLETE,
+  IOTJS_HTTPPARSER_ONBODY,
+  IOTJS_HTTPPARSER_ONMESSAGECOMPLETE,
+  IOTJS_HTTPPARSER_CALLBACK_COUNT,
+} iotjs_httpparser_callback_t;
 
 
 typedef struct {
@@ -51,12 +63,135 @@ typedef struct {
   size_t cur_buf_len;
 
   bool flushed;
+
+  // The responses answered natively, in the first element of an array that
+  // the connections of a server share (see SetStaticRoutes).
+  iotjs_jval_t jroutes;
+  bool has_routes;
+  // The current request is answered from the routes, without JS.
+  bool is_answered;
+
+  iotjs_jval_t jcallbacks[IOTJS_HTTPPARSER_CALLBACK_COUNT];
 } IOTJS_VALIDATED_STRUCT(iotjs_httpparserwrap_t);
 
 
 typedef enum http_parser_type http_parser_type;
 
 
+// The names of the header fields most messages have. Their jerry strings are
+// created as they are first parsed, and reused for the messages after. A name
+// is looked up by a perfect hash of its length and of its first and last
+// letters, and matches when it is spelled as here or all in lower case.
+static const char* const common_names[] = {
+  "Accept", "Accept-Charset", "Accept-Encoding", "Accept-Language",
+  "Access-Control-Request-Method", "Authorization", "Cache-Control",
+  "Connection", "Content-Encoding", "Content-Length", "Content-Type",
+  "Cookie", "Date", "ETag", "Expect", "Host", "If-Modified-Since",
+  "If-None-Match", "Keep-Alive", "Last-Modified", "Location", "Origin",
+  "Pragma", "Range", "Referer", "Sec-WebSocket-Accept", "Sec-WebSocket-Key",
+  "Sec-WebSocket-Version", "Server", "Set-Cookie", "Transfer-Encoding",
+  "Upgrade", "User-Agent", "Vary", "Via", "X-Forwarded-For",
+  "X-Requested-With",
+};
+
+#define COMMON_NAME_COUNT (sizeof(common_names) / sizeof(common_names[0]))
+#define COMMON_NAME_HASH_SIZE 64
+
+// Values of the letters in the hash, chosen for the names above to fall in
+// distinct slots.
+static const uint8_t common_name_asso[26] = {
+  4,  0, 15, 38, 51, 0,  2,  40, 14, 0,  12, 35, 0,
+  63, 40, 50, 0, 40, 0, 46, 33, 61, 0,  59, 57, 0,
+};
+
+typedef struct {
+  iotjs_jval_t jname;
+  iotjs_jval_t jlower;
+  bool has_jname;
+  bool has_jlower;
+} iotjs_httpparser_common_name_t;
+
+// Slots of the hash, holding the index of a name plus one, or zero.
+static uint8_t common_name_slots[COMMON_NAME_HASH_SIZE];
+static iotjs_httpparser_common_name_t common_name_strings[COMMON_NAME_COUNT];
+
+
+static int iotjs_httpparser_hash_name(const char* name, size_t size) {
+  int first = tolower((unsigned char)name[0]) - 'a';
+  int last = tolower((unsigned char)name[size - 1]) - 'a';
+  if (first < 0 || first >= 26 || last < 0 || last >= 26) {
+    return -1;
+  }
+  return (int)((size + common_name_asso[first] + common_name_asso[last]) &
+               (COMMON_NAME_HASH_SIZE - 1));
+}
+
+
+static void iotjs_httpparser_init_common_names() {
+  memset(common_name_slots, 0, sizeof(common_name_slots));
+  for (size_t i = 0; i < COMMON_NAME_COUNT; i++) {
+    int hash = iotjs_httpparser_hash_name(common_names[i],
+                                          strlen(common_names[i]));
+    IOTJS_ASSERT(hash >= 0 && common_name_slots[hash] == 0);
+    common_name_slots[hash] = (uint8_t)(i + 1);
+  }
+}
+
+
+// Gives the string of a header name, the one made before when the name is a
+// common one.
+static iotjs_jval_t iotjs_httpparser_create_name(const iotjs_string_t* field) {
+  const char* data = iotjs_string_data(field);
+  size_t size = iotjs_string_size(field);
+
+  int hash = size > 0 ? iotjs_httpparser_hash_name(data, size) : -1;
+  size_t index = hash >= 0 ? common_name_slots[hash] : 0;
+  if (index == 0) {
+    return iotjs_jval_create_string(field);
+  }
+
+  const char* name = common_names[index - 1];
+  iotjs_httpparser_common_name_t* strings = &common_name_strings[index - 1];
+  if (strlen(name) != size) {
+    return iotjs_jval_create_string(field);
+  }
+
+  if (memcmp(name, data, size) == 0) {
+    if (!strings->has_jname) {
+      strings->jname = iotjs_jval_create_string(field);
+      strings->has_jname = true;
+    }
+    return iotjs_jval_create_copied(&strings->jname);
+  }
+
+  for (size_t i = 0; i < size; i++) {
+    if (data[i] != tolower((unsigned char)name[i])) {
+      return iotjs_jval_create_string(field);
+    }
+  }
+  if (!strings->has_jlower) {
+    strings->jlower = iotjs_jval_create_string(field);
+    strings->has_jlower = true;
+  }
+  return iotjs_jval_create_copied(&strings->jlower);
+}
+
+
+void iotjs_httpparser_release() {
+  for (size_t i = 0; i < COMMON_NAME_COUNT; i++) {
+    iotjs_httpparser_common_name_t* strings = &common_name_strings[i];
+    if (strings->has_jname) {
+      iotjs_jval_destroy(&strings->jname);
+      strings->has_jname = false;
+    }
+    if (strings->has_jlower) {
+      iotjs_jval_destroy(&strings->jlower);
+      strings->has_jlower = false;
+    }
+  }
+}
+
+
 static void iotjs_httpparserwrap_initialize(
     iotjs_httpparserwrap_t* httpparserwrap, http_parser_type type) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
@@ -69,18 +204,34 @@ static void iotjs_httpparserwrap_initialize(
   _this->cur_jbuf = NULL;
   _this->cur_buf = NULL;
   _this->cur_buf_len = 0;
+  if (_this->has_routes) {
+    iotjs_jval_destroy(&_this->jroutes);
+    _this->has_routes = false;
+  }
+  _this->is_answered = false;
 }
 
 
 IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(httpparserwrap);
 
 
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnHeaders, IOTJS_HTTPPARSER_ONHEADERS)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnHeadersComplete,
+                                IOTJS_HTTPPARSER_ONHEADERSCOMPLETE)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnBody, IOTJS_HTTPPARSER_ONBODY)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnMessageComplete,
+                                IOTJS_HTTPPARSER_ONMESSAGECOMPLETE)
+
+
 static void iotjs_httpparserwrap_create(const iotjs_jval_t* jparser,
                                         http_parser_type type) {
   iotjs_httpparserwrap_t* httpparserwrap = IOTJS_ALLOC(iotjs_httpparserwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_httpparserwrap_t, httpparserwrap);
   iotjs_jobjectwrap_initialize(&_this->jobjectwrap, jparser,
                                &this_module_native_info);
+  iotjs_jobjectwrap_initialize_callbacks(&_this->jobjectwrap,
+                                         _this->jcallbacks,
+                                         IOTJS_HTTPPARSER_CALLBACK_COUNT);
 
   _this->url = iotjs_string_create();
   _this->status_msg = iotjs_string_create();
@@ -89,6 +240,7 @@ static void iotjs_httpparserwrap_create(const iotjs_jval_t* jparser,
     _this->values[i] = iotjs_string_create();
   }
 
+  _this->has_routes = false;
   iotjs_httpparserwrap_initialize(httpparserwrap, type);
   _this->parser.data = httpparserwrap;
 
@@ -107,6 +259,9 @@ static void iotjs_httpparserwrap_destroy(
     iotjs_string_destroy(&_this->fields[i]);
     iotjs_string_destroy(&_this->values[i]);
   }
+  if (_this->has_routes) {
+    iotjs_jval_destroy(&_this->jroutes);
+  }
   iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
 
   IOTJS_RELEASE(httpparserwrap);
@@ -118,7 +273,7 @@ static iotjs_jval_t iotjs_httpparserwrap_make_header(
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
   iotjs_jval_t jheader = iotjs_jval_create_array(_this->n_values * 2);
   for (size_t i = 0; i < _this->n_values; i++) {
-    iotjs_jval_t f = iotjs_jval_create_string(&_this->fields[i]);
+    iotjs_jval_t f = iotjs_httpparser_create_name(&_this->fields[i]);
     iotjs_jval_t v = iotjs_jval_create_string(&_this->values[i]);
     iotjs_jval_set_property_by_index(&jheader, i * 2, &f);
     iotjs_jval_set_property_by_index(&jheader, i * 2 + 1, &v);
@@ -132,8 +287,8 @@ static iotjs_jval_t iotjs_httpparserwrap_make_header(
 static void iotjs_httpparserwrap_flush(iotjs_httpparserwrap_t* httpparserwrap) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
   const iotjs_jval_t* jobj = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
-  iotjs_jval_t func =
-      iotjs_jval_get_property(jobj, IOTJS_MAGIC_STRING_ONHEADERS);
+  iotjs_jval_t func = iotjs_jval_create_copied(iotjs_jobjectwrap_jcallback(
+      &_this->jobjectwrap, IOTJS_HTTPPARSER_ONHEADERS));
   IOTJS_ASSERT(iotjs_jval_is_function(&func));
 
   iotjs_jargs_t argv = iotjs_jargs_create(2);
@@ -201,14 +356,14 @@ static int iotjs_httpparserwrap_on_header_field(http_parser* parser,
       (iotjs_httpparserwrap_t*)(parser->data);
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
   if (_this->n_fields == _this->n_values) {
-    _this->n_fields++;
     // values and fields are flushed to JS
-    // before corresponding OnHeaderValue is called.
+    // before a field which does not fit.
     if (_this->n_fields == HEADER_MAX) {
       iotjs_httpparserwrap_flush(httpparserwrap); // to JS world
-      _this->n_fields = 1;
+      _this->n_fields = 0;
       _this->n_values = 0;
     }
+    _this->n_fields++;
     iotjs_string_make_empty(&_this->fields[_this->n_fields - 1]);
   }
   IOTJS_ASSERT(_this->n_fields == _this->n_values + 1);
@@ -236,13 +391,185 @@ static int iotjs_httpparserwrap_on_header_value(http_parser* parser,
 }
 
 
+// A route of the table of CompileRoutes, followed by its path and its
+// response, padded to the alignment of the next route.
+typedef struct {
+  uint32_t method;
+  uint32_t path_size;
+  uint32_t response_size;
+} iotjs_httpparser_route_t;
+
+#define IOTJS_HTTPPARSER_ROUTE_SIZE(path_size, response_size)             \
+  ((sizeof(iotjs_httpparser_route_t) + (path_size) + (response_size) + 3) & \
+   ~(size_t)3)
+
+
+#if ENABLE_MODULE_TCP
+
+// The rest of a response the socket did not take at once. The table is kept
+// alive until it is written.
+typedef struct {
+  uv_write_t req;
+  iotjs_jval_t jtable;
+} iotjs_httpparser_route_write_t;
+
+
+IOTJS_DEFINE_POOL(route_write_pool, iotjs_httpparser_route_write_t,
+                  "httpparser.route", IOTJS_REQWRAP_POOL_CAP);
+
+
+static void AfterRouteWrite(uv_write_t* req, int status) {
+  // A failed write is reported to JS by the reading of the socket.
+  iotjs_httpparser_route_write_t* write = (iotjs_httpparser_route_write_t*)req;
+  iotjs_jval_destroy(&write->jtable);
+  IOTJS_POOL_RELEASE(route_write_pool, write);
+}
+
+
+// Writes a response of the table to the socket. Returns false when nothing
+// could be written, for JS to answer the request instead.
+static bool iotjs_httpparser_write_route(uv_stream_t* stream,
+                                         const iotjs_jval_t* jtable,
+                                         const char* response, size_t size) {
+  uv_buf_t buf = uv_buf_init((char*)response, (unsigned int)size);
+  int written = uv_try_write(stream, &buf, 1);
+  if (written == (int)size) {
+    return true;
+  }
+  if (written < 0 && written != UV__EAGAIN) {
+    return false;
+  }
+  if (written < 0) {
+    written = 0;
+  }
+
+  iotjs_httpparser_route_write_t* write =
+      IOTJS_POOL_ALLOC(route_write_pool, iotjs_httpparser_route_write_t);
+  write->jtable = iotjs_jval_create_copied(jtable);
+
+  buf = uv_buf_init((char*)response + written,
+                    (unsigned int)(size - (size_t)written));
+  if (uv_write(&write->req, stream, &buf, 1, AfterRouteWrite) != 0) {
+    iotjs_jval_destroy(&write->jtable);
+    IOTJS_POOL_RELEASE(route_write_pool, write);
+    // A partly written response can not be answered again.
+    return written > 0;
+  }
+  return true;
+}
+
+
+// Writes the response of a route to the socket of the parser, unless the
+// socket is closing or still sends a response of JS, which goes first.
+static bool iotjs_httpparserwrap_send_route(
+    iotjs_httpparserwrap_t* httpparserwrap, const iotjs_jval_t* jtable,
+    const char* response, size_t size) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
+  const iotjs_jval_t* jobj = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
+
+  iotjs_jval_t jsocket =
+      iotjs_jval_get_property(jobj, IOTJS_MAGIC_STRING_SOCKET);
+  if (!iotjs_jval_is_object(&jsocket)) {
+    iotjs_jval_destroy(&jsocket);
+    return false;
+  }
+
+  iotjs_jval_t jmessage =
+      iotjs_jval_get_property(&jsocket, IOTJS_MAGIC_STRING__HTTPMESSAGE);
+  iotjs_jval_t jhandle =
+      iotjs_jval_get_property(&jsocket, IOTJS_MAGIC_STRING__HANDLE);
+
+  bool is_sent = false;
+  if ((iotjs_jval_is_null(&jmessage) || iotjs_jval_is_undefined(&jmessage)) &&
+      iotjs_jval_is_object(&jhandle)) {
+    iotjs_tcpwrap_t* tcp_wrap = iotjs_tcpwrap_from_jobject(&jhandle);
+    uv_stream_t* stream = (uv_stream_t*)iotjs_tcpwrap_tcp_handle(tcp_wrap);
+    if (!uv_is_closing((uv_handle_t*)stream)) {
+      is_sent = iotjs_httpparser_write_route(stream, jtable, response, size);
+    }
+  }
+
+  iotjs_jval_destroy(&jhandle);
+  iotjs_jval_destroy(&jmessage);
+  iotjs_jval_destroy(&jsocket);
+  return is_sent;
+}
+
+
+// Answers the request from the routes, when its method and its path, without
+// the query, are the ones of a route. Only requests without a body, which
+// keep an HTTP/1.1 connection open, are answered, for JS to deal with the
+// others.
+static bool iotjs_httpparserwrap_answer_route(
+    iotjs_httpparserwrap_t* httpparserwrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
+  http_parser* parser = &_this->parser;
+
+  if (parser->type != HTTP_REQUEST || _this->flushed || parser->upgrade ||
+      parser->http_major != 1 || parser->http_minor != 1 ||
+      !http_should_keep_alive(parser) || (parser->flags & F_CHUNKED) ||
+      (parser->content_length != 0 && parser->content_length != ULLONG_MAX)) {
+    return false;
+  }
+
+  const char* url = iotjs_string_data(&_this->url);
+  size_t url_size = iotjs_string_size(&_this->url);
+  const char* query = url_size > 0 ? memchr(url, '?', url_size) : NULL;
+  size_t path_size = query != NULL ? (size_t)(query - url) : url_size;
+
+  iotjs_jval_t jtable = iotjs_jval_get_property_by_index(&_this->jroutes, 0);
+  if (!iotjs_jval_is_object(&jtable)) {
+    iotjs_jval_destroy(&jtable);
+    return false;
+  }
+
+  iotjs_bufferwrap_t* table_wrap = iotjs_bufferwrap_from_jbuffer(&jtable);
+  const char* table = iotjs_bufferwrap_buffer(table_wrap);
+  size_t table_size = iotjs_bufferwrap_length(table_wrap);
+
+  bool is_answered = false;
+  size_t offset = 0;
+  while (offset + sizeof(iotjs_httpparser_route_t) <= table_size) {
+    iotjs_httpparser_route_t route;
+    memcpy(&route, table + offset, sizeof(route));
+    const char* path = table + offset + sizeof(route);
+
+    if (route.method == parser->method && route.path_size == path_size &&
+        memcmp(path, url, path_size) == 0) {
+      is_answered =
+          iotjs_httpparserwrap_send_route(httpparserwrap, &jtable,
+                                          path + path_size,
+                                          route.response_size);
+      break;
+    }
+    offset += IOTJS_HTTPPARSER_ROUTE_SIZE(route.path_size,
+                                          route.response_size);
+  }
+
+  iotjs_jval_destroy(&jtable);
+  return is_answered;
+}
+
+#endif /* ENABLE_MODULE_TCP */
+
+
 static int iotjs_httpparserwrap_on_headers_complete(http_parser* parser) {
   iotjs_httpparserwrap_t* httpparserwrap =
       (iotjs_httpparserwrap_t*)(parser->data);
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
+
+#if ENABLE_MODULE_TCP
+  if (_this->has_routes && iotjs_httpparserwrap_answer_route(httpparserwrap)) {
+    // The request has no body, which is skipped, and no message for JS.
+    _this->n_fields = _this->n_values = 0;
+    _this->is_answered = true;
+    return 1;
+  }
+#endif
+
   const iotjs_jval_t* jobj = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
-  iotjs_jval_t func =
-      iotjs_jval_get_property(jobj, IOTJS_MAGIC_STRING_ONHEADERSCOMPLETE);
+  iotjs_jval_t func = iotjs_jval_create_copied(iotjs_jobjectwrap_jcallback(
+      &_this->jobjectwrap, IOTJS_HTTPPARSER_ONHEADERSCOMPLETE));
   IOTJS_ASSERT(iotjs_jval_is_function(&func));
 
   // URL
@@ -258,38 +585,54 @@ static int iotjs_httpparserwrap_on_headers_complete(http_parser* parser) {
     // Here, there was no flushed header.
     // We need to make a new header object with all header fields
     iotjs_jval_t jheader = iotjs_httpparserwrap_make_header(httpparserwrap);
-    iotjs_jval_set_property_jval(&info, IOTJS_MAGIC_STRING_HEADERS, &jheader);
+    iotjs_jval_set_property_jval_by_key(&info, IOTJS_PROPKEY_HEADERS, &jheader);
     iotjs_jval_destroy(&jheader);
     if (_this->parser.type == HTTP_REQUEST) {
       IOTJS_ASSERT(!iotjs_string_is_empty(&_this->url));
-      iotjs_jval_set_property_string(&info, IOTJS_MAGIC_STRING_URL,
-                                     &_this->url);
+      iotjs_jval_set_property_string_by_key(&info, IOTJS_PROPKEY_URL,
+                                            &_this->url);
     }
   }
   _this->n_fields = _this->n_values = 0;
 
   // Method
   if (_this->parser.type == HTTP_REQUEST) {
-    iotjs_jval_set_property_number(&info, IOTJS_MAGIC_STRING_METHOD,
-                                   _this->parser.method);
+    iotjs_jval_set_property_number_by_key(&info, IOTJS_PROPKEY_METHOD,
+                                          _this->parser.method);
   }
   // Status
   else if (_this->parser.type == HTTP_RESPONSE) {
-    iotjs_jval_set_property_number(&info, IOTJS_MAGIC_STRING_STATUS,
-                                   _this->parser.status_code);
-    iotjs_jval_set_property_string(&info, IOTJS_MAGIC_STRING_STATUS_MSG,
-                                   &_this->status_msg);
+    iotjs_jval_set_property_number_by_key(&info, IOTJS_PROPKEY_STATUS,
+                                          _this->parser.status_code);
+    iotjs_jval_set_property_string_by_key(&info, IOTJS_PROPKEY_STATUS_MSG,
+                                          &_this->status_msg);
+  }
+
+
+  // The length of the body by Content-Length, which http-parser has parsed,
+  // or -1 when the body is chunked or lasts until the connection closes.
+  double content_length = -1;
+  if (!(_this->parser.flags & F_CHUNKED) &&
+      _this->parser.content_length != ULLONG_MAX) {
+    content_length = (double)_this->parser.content_length;
   }
+  iotjs_jval_set_property_number_by_key(&info, IOTJS_PROPKEY_CONTENTLENGTH,
+                                        content_length);
+
 
+  iotjs_jval_set_property_number_by_key(&info, IOTJS_PROPKEY_VERSIONMAJOR,
+                                        _this->parser.http_major);
+  iotjs_jval_set_property_number_by_key(&info, IOTJS_PROPKEY_VERSIONMINOR,
+                                        _this->parser.http_minor);
 
-  // For future support, current http_server module does not support
-  // upgrade and keepalive.
-  // upgrade
-  iotjs_jval_set_property_boolean(&info, IOTJS_MAGIC_STRING_UPGRADE,
-                                  _this->parser.upgrade);
+  // upgrade, for which the server hands the socket to its 'upgrade'
+  // listeners.
+  iotjs_jval_set_property_boolean_by_key(&info, IOTJS_PROPKEY_UPGRADE,
+                                         _this->parser.upgrade);
   // shouldkeepalive
-  iotjs_jval_set_property_boolean(&info, IOTJS_MAGIC_STRING_SHOULDKEEPALIVE,
-                                  http_should_keep_alive(&_this->parser));
+  iotjs_jval_set_property_boolean_by_key(
+      &info, IOTJS_PROPKEY_SHOULDKEEPALIVE,
+      http_should_keep_alive(&_this->parser));
 
 
   iotjs_jargs_append_jval(&argv, &info);
@@ -320,18 +663,24 @@ static int iotjs_httpparserwrap_on_body(http_parser* parser, const char* at,
       (iotjs_httpparserwrap_t*)(parser->data);
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
   const iotjs_jval_t* jobj = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
-  iotjs_jval_t func = iotjs_jval_get_property(jobj, IOTJS_MAGIC_STRING_ONBODY);
+  iotjs_jval_t func = iotjs_jval_create_copied(iotjs_jobjectwrap_jcallback(
+      &_this->jobjectwrap, IOTJS_HTTPPARSER_ONBODY));
   IOTJS_ASSERT(iotjs_jval_is_function(&func));
 
-  iotjs_jargs_t argv = iotjs_jargs_create(3);
-  iotjs_jargs_append_jval(&argv, _this->cur_jbuf);
-  iotjs_jargs_append_number(&argv, at - _this->cur_buf);
-  iotjs_jargs_append_number(&argv, length);
+  // The body is a view of the data being parsed, nothing is copied.
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(_this->cur_jbuf);
+  iotjs_jval_t jbody =
+      iotjs_bufferwrap_create_view(buffer_wrap, (size_t)(at - _this->cur_buf),
+                                   length);
 
+  iotjs_jargs_t argv = iotjs_jargs_create(1);
+  iotjs_jargs_append_jval(&argv, &jbody);
 
   iotjs_make_callback(&func, jobj, &argv);
 
   iotjs_jargs_destroy(&argv);
+  iotjs_jval_destroy(&jbody);
   iotjs_jval_destroy(&func);
 
   return 0;
@@ -342,9 +691,14 @@ static int iotjs_httpparserwrap_on_message_complete(http_parser* parser) {
   iotjs_httpparserwrap_t* httpparserwrap =
       (iotjs_httpparserwrap_t*)(parser->data);
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, httpparserwrap);
+  if (_this->is_answered) {
+    _this->is_answered = false;
+    return 0;
+  }
+
   const iotjs_jval_t* jobj = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
-  iotjs_jval_t func =
-      iotjs_jval_get_property(jobj, IOTJS_MAGIC_STRING_ONMESSAGECOMPLETE);
+  iotjs_jval_t func = iotjs_jval_create_copied(iotjs_jobjectwrap_jcallback(
+      &_this->jobjectwrap, IOTJS_HTTPPARSER_ONMESSAGECOMPLETE));
   IOTJS_ASSERT(iotjs_jval_is_function(&func));
 
   iotjs_make_callback(&func, jobj, iotjs_jargs_get_empty());
@@ -431,8 +785,11 @@ JHANDLER_FUNCTION(Execute) {
   iotjs_httpparserwrap_set_buf(parser, NULL, NULL, 0);
 
 
-  if (!nativeparser->upgrade && nparsed != buf_len) {
-    // nparsed should equal to buf_len except UPGRADE protocol
+  if (!nativeparser->upgrade && nparsed != buf_len &&
+      HTTP_PARSER_ERRNO(nativeparser) != HPE_PAUSED) {
+    // nparsed should equal to buf_len except UPGRADE protocol, or when the
+    // parser is paused by a callback. The caller executes the rest of the
+    // buffer after resuming it.
     iotjs_httpparser_return_parserrror(jhandler, nativeparser);
   } else {
     iotjs_jhandler_return_number(jhandler, nparsed);
@@ -458,6 +815,444 @@ JHANDLER_FUNCTION(Resume) {
 }
 
 
+// setStaticRoutes([routes])
+// Answers the requests of the table of CompileRoutes in `routes[0]` without
+// calling JS, until the parser is reinitialized. The table may be replaced.
+// Without `routes`, the table is dropped; a parser kept for later must not
+// hold it, as nothing would release it before the engine is cleaned up.
+JHANDLER_FUNCTION(SetStaticRoutes) {
+  JHANDLER_DECLARE_THIS_PTR(httpparserwrap, parser);
+  const iotjs_jval_t* jroutes = JHANDLER_GET_ARG_IF_EXIST(0, array);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_httpparserwrap_t, parser);
+
+  if (_this->has_routes) {
+    iotjs_jval_destroy(&_this->jroutes);
+    _this->has_routes = false;
+  }
+  if (jroutes != NULL) {
+    _this->jroutes = iotjs_jval_create_copied(jroutes);
+    _this->has_routes = true;
+  }
+}
+
+
+// Gets the string at `index` of the header fields, which must be a string.
+static bool iotjs_httpparser_get_field(const iotjs_jval_t* jfields,
+                                       uint32_t index, iotjs_jval_t* jfield) {
+  *jfield = iotjs_jval_get_property_by_index(jfields, index);
+  if (!iotjs_jval_is_string(jfield)) {
+    iotjs_jval_destroy(jfield);
+    return false;
+  }
+  return true;
+}
+
+
+// serializeHeaders(firstLine, fields[, block])
+// Writes the first line of a message, the header fields, given as names and
+// values in a row, the header block of http.compileHeaders(), and the empty
+// line after the header into a new Buffer.
+JHANDLER_FUNCTION(SerializeHeaders) {
+  DJHANDLER_CHECK_ARGS(2, string, array);
+
+  const iotjs_jval_t* jfirst = iotjs_jhandler_get_arg(jhandler, 0);
+  const iotjs_jval_t* jfields = JHANDLER_GET_ARG(1, array);
+
+  const iotjs_jval_t* jblock = JHANDLER_GET_ARG_IF_EXIST(2, object);
+  iotjs_bufferwrap_t* block =
+      jblock != NULL ? iotjs_bufferwrap_from_jbuffer(jblock) : NULL;
+
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jfields, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t length = iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+  JHANDLER_CHECK(length % 2 == 0);
+
+  size_t first_size = iotjs_jval_string_size(jfirst);
+  size_t block_size = block != NULL ? iotjs_bufferwrap_length(block) : 0;
+
+  // Every field takes its name, its value, ": " and "\r\n".
+  size_t size = first_size + block_size + 2;
+  for (uint32_t i = 0; i < length; i++) {
+    iotjs_jval_t jfield;
+    if (!iotjs_httpparser_get_field(jfields, i, &jfield)) {
+      JHANDLER_THROW(TYPE, "Header names and values must be strings");
+      return;
+    }
+    size += iotjs_jval_string_size(&jfield) + 2;
+    iotjs_jval_destroy(&jfield);
+  }
+
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(size);
+  iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+  char* buffer = iotjs_bufferwrap_buffer(buffer_wrap);
+
+  char* p = buffer;
+  p += iotjs_jval_copy_string(jfirst, p, first_size);
+  for (uint32_t i = 0; i < length; i++) {
+    iotjs_jval_t jfield;
+    iotjs_httpparser_get_field(jfields, i, &jfield);
+    size_t field_size = iotjs_jval_string_size(&jfield);
+    IOTJS_ASSERT(p + field_size + 2 <= buffer + size);
+    p += iotjs_jval_copy_string(&jfield, p, field_size);
+    iotjs_jval_destroy(&jfield);
+
+    if (i % 2 == 0) {
+      *p++ = ':';
+      *p++ = ' ';
+    } else {
+      *p++ = '\r';
+      *p++ = '\n';
+    }
+  }
+  if (block_size > 0) {
+    memcpy(p, iotjs_bufferwrap_buffer(block), block_size);
+    p += block_size;
+  }
+  *p++ = '\r';
+  *p++ = '\n';
+  IOTJS_ASSERT(p == buffer + size);
+
+  iotjs_jhandler_return_jval(jhandler, &jbuffer);
+  iotjs_jval_destroy(&jbuffer);
+}
+
+
+// Writes the size line of a chunk of `size` bytes, the size in hex and
+// "\r\n", into `line`. Returns the length of the line.
+static size_t iotjs_httpparser_chunk_size_line(char* line, size_t size) {
+  static const char hex[] = "0123456789abcdef";
+  char digits[sizeof(size_t) * 2];
+  size_t count = 0;
+  do {
+    digits[count++] = hex[size & 0xf];
+    size >>= 4;
+  } while (size > 0);
+
+  size_t length = 0;
+  while (count > 0) {
+    line[length++] = digits[--count];
+  }
+  line[length++] = '\r';
+  line[length++] = '\n';
+  return length;
+}
+
+
+// frameChunk(data)
+// Frames `data` as a chunk of the chunked transfer coding. A string is
+// written into a new Buffer between the size line and "\r\n". For the length
+// of a Buffer only the size line is returned, and the Buffer is sent after it
+// as it is.
+JHANDLER_FUNCTION(FrameChunk) {
+  JHANDLER_CHECK(iotjs_jhandler_get_arg_length(jhandler) >= 1);
+  const iotjs_jval_t* jdata = iotjs_jhandler_get_arg(jhandler, 0);
+
+  char line[sizeof(size_t) * 2 + 2];
+  size_t data_size;
+  bool is_string = iotjs_jval_is_string(jdata);
+  if (is_string) {
+    data_size = iotjs_jval_string_size(jdata);
+  } else {
+    JHANDLER_CHECK(iotjs_jval_is_number(jdata));
+    data_size = (size_t)iotjs_jval_as_number(jdata);
+  }
+
+  size_t line_size = iotjs_httpparser_chunk_size_line(line, data_size);
+  size_t size = is_string ? line_size + data_size + 2 : line_size;
+
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(size);
+  iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+  char* buffer = iotjs_bufferwrap_buffer(buffer_wrap);
+
+  memcpy(buffer, line, line_size);
+  if (is_string) {
+    char* p = buffer + line_size;
+    p += iotjs_jval_copy_string(jdata, p, data_size);
+    *p++ = '\r';
+    *p++ = '\n';
+    IOTJS_ASSERT(p == buffer + size);
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jbuffer);
+  iotjs_jval_destroy(&jbuffer);
+}
+
+
+// compileRoutes(routes)
+// Lays the routes, given as methods, paths and response Buffers in a row, out
+// in a Buffer for setStaticRoutes.
+JHANDLER_FUNCTION(CompileRoutes) {
+  DJHANDLER_CHECK_ARGS(1, array);
+  const iotjs_jval_t* jroutes = JHANDLER_GET_ARG(0, array);
+
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jroutes, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t length = iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+  JHANDLER_CHECK(length % 3 == 0);
+
+  size_t size = 0;
+  for (uint32_t i = 0; i < length; i += 3) {
+    iotjs_jval_t jpath = iotjs_jval_get_property_by_index(jroutes, i + 1);
+    iotjs_jval_t jresponse = iotjs_jval_get_property_by_index(jroutes, i + 2);
+    bool is_valid = iotjs_jval_is_string(&jpath) &&
+                    iotjs_jval_is_object(&jresponse);
+    if (is_valid) {
+      size += IOTJS_HTTPPARSER_ROUTE_SIZE(
+          iotjs_jval_string_size(&jpath),
+          iotjs_bufferwrap_length(iotjs_bufferwrap_from_jbuffer(&jresponse)));
+    }
+    iotjs_jval_destroy(&jpath);
+    iotjs_jval_destroy(&jresponse);
+    if (!is_valid) {
+      JHANDLER_THROW(TYPE, "Routes must be methods, paths and Buffers");
+      return;
+    }
+  }
+
+  iotjs_jval_t jtable = iotjs_bufferwrap_create_buffer(size);
+  char* table = iotjs_bufferwrap_buffer(iotjs_bufferwrap_from_jbuffer(&jtable));
+
+  size_t offset = 0;
+  for (uint32_t i = 0; i < length; i += 3) {
+    iotjs_jval_t jmethod = iotjs_jval_get_property_by_index(jroutes, i);
+    iotjs_jval_t jpath = iotjs_jval_get_property_by_index(jroutes, i + 1);
+    iotjs_jval_t jresponse = iotjs_jval_get_property_by_index(jroutes, i + 2);
+    iotjs_bufferwrap_t* response_wrap =
+        iotjs_bufferwrap_from_jbuffer(&jresponse);
+
+    iotjs_httpparser_route_t route;
+    route.method = (uint32_t)iotjs_jval_as_number(&jmethod);
+    route.path_size = (uint32_t)iotjs_jval_string_size(&jpath);
+    route.response_size = (uint32_t)iotjs_bufferwrap_length(response_wrap);
+
+    char* p = table + offset;
+    memcpy(p, &route, sizeof(route));
+    p += sizeof(route);
+    p += iotjs_jval_copy_string(&jpath, p, route.path_size);
+    memcpy(p, iotjs_bufferwrap_buffer(response_wrap), route.response_size);
+    offset += IOTJS_HTTPPARSER_ROUTE_SIZE(route.path_size,
+                                          route.response_size);
+    IOTJS_ASSERT(offset <= size);
+
+    iotjs_jval_destroy(&jmethod);
+    iotjs_jval_destroy(&jpath);
+    iotjs_jval_destroy(&jresponse);
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jtable);
+  iotjs_jval_destroy(&jtable);
+}
+
+
+// URLs up to this size are parsed on the stack.
+#define IOTJS_HTTPPARSER_URL_STACK_SIZE 256
+
+
+// parseUrl(url[, isConnect])
+// Splits `url` with the URL parser of the HTTP parser. Returns the schema,
+// host, port, path, query, fragment and userinfo of the URL in an array, in
+// which the parts the URL does not have are left undefined, or null if the
+// URL can not be parsed.
+JHANDLER_FUNCTION(ParseUrl) {
+  DJHANDLER_CHECK_ARGS(1, string);
+
+  const iotjs_jval_t* jurl = iotjs_jhandler_get_arg(jhandler, 0);
+  const iotjs_jval_t* jconnect = JHANDLER_GET_ARG_IF_EXIST(1, boolean);
+  bool is_connect = jconnect != NULL && iotjs_jval_as_boolean(jconnect);
+
+  // The parts are given by 16 bit offsets.
+  size_t size = iotjs_jval_string_size(jurl);
+  if (size == 0 || size > UINT16_MAX) {
+    iotjs_jhandler_return_null(jhandler);
+    return;
+  }
+
+  char stack_url[IOTJS_HTTPPARSER_URL_STACK_SIZE];
+  char* url = size <= sizeof(stack_url) ? stack_url
+                                        : iotjs_buffer_allocate(size);
+  iotjs_jval_copy_string(jurl, url, size);
+
+  struct http_parser_url parsed;
+  if (http_parser_parse_url(url, size, is_connect, &parsed) != 0) {
+    iotjs_jhandler_return_null(jhandler);
+  } else {
+    iotjs_jval_t jparts = iotjs_jval_create_array(UF_MAX);
+    for (uint32_t i = 0; i < UF_MAX; i++) {
+      if (parsed.field_set & (1 << i)) {
+        // The parts end at ASCII characters, so that they are whole
+        // characters of the engine.
+        iotjs_jval_t jpart =
+            iotjs_jval_create_string_sz(url + parsed.field_data[i].off,
+                                        parsed.field_data[i].len);
+        iotjs_jval_set_property_by_index(&jparts, i, &jpart);
+        iotjs_jval_destroy(&jpart);
+      }
+    }
+    iotjs_jhandler_return_jval(jhandler, &jparts);
+    iotjs_jval_destroy(&jparts);
+  }
+
+  if (url != stack_url) {
+    iotjs_buffer_release(url);
+  }
+}
+
+
+static int iotjs_httpparser_hex_value(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+
+// Creates the string of `data` with '+' as a space and the percent-encoded
+// bytes decoded into `decoded`, which is at least `size` bytes. If the
+// decoded bytes are not UTF-8, `data` is given as it is.
+static iotjs_jval_t iotjs_httpparser_create_decoded(const char* data,
+                                                    size_t size,
+                                                    char* decoded) {
+  size_t length = 0;
+  bool is_changed = false;
+  for (size_t i = 0; i < size; i++) {
+    char c = data[i];
+    if (c == '+') {
+      c = ' ';
+      is_changed = true;
+    } else if (c == '%' && i + 2 < size) {
+      int high = iotjs_httpparser_hex_value(data[i + 1]);
+      int low = high < 0 ? -1 : iotjs_httpparser_hex_value(data[i + 2]);
+      if (low >= 0) {
+        c = (char)(high << 4 | low);
+        i += 2;
+        is_changed = true;
+      }
+    }
+    decoded[length++] = c;
+  }
+
+  if (!is_changed) {
+    return iotjs_jval_create_string_sz(data, size);
+  }
+  if (!jerry_is_valid_utf8_string((const jerry_char_t*)decoded,
+                                  (jerry_size_t)length)) {
+    return iotjs_jval_create_string_sz(data, size);
+  }
+
+  iotjs_string_t str = iotjs_string_create_with_size(decoded, length);
+  iotjs_jval_t jstr = iotjs_jval_create_string(&str);
+  iotjs_string_destroy(&str);
+  return jstr;
+}
+
+
+static const char* iotjs_httpparser_find(const char* data, const char* end,
+                                         const char* needle,
+                                         size_t needle_size) {
+  while (data + needle_size <= end) {
+    const char* found = memchr(data, needle[0],
+                               (size_t)(end - data) - needle_size + 1);
+    if (found == NULL) {
+      return NULL;
+    }
+    if (memcmp(found, needle, needle_size) == 0) {
+      return found;
+    }
+    data = found + 1;
+  }
+  return NULL;
+}
+
+
+// parseQuery(query, sep, eq[, maxKeys])
+// Splits `query` into the pairs between `sep`, and each pair into the key
+// before the first `eq` and the value after it, which are decoded in place
+// of querystring.unescape(). Returns the keys and values in a row. Empty
+// pairs are skipped, and no more than `maxKeys` pairs are given unless it is
+// 0.
+JHANDLER_FUNCTION(ParseQuery) {
+  DJHANDLER_CHECK_ARGS(3, string, string, string);
+
+  const iotjs_jval_t* jquery = iotjs_jhandler_get_arg(jhandler, 0);
+  iotjs_string_t sep = JHANDLER_GET_ARG(1, string);
+  iotjs_string_t eq = JHANDLER_GET_ARG(2, string);
+  const iotjs_jval_t* jmax_keys = JHANDLER_GET_ARG_IF_EXIST(3, number);
+  uint32_t max_keys =
+      jmax_keys != NULL ? (uint32_t)iotjs_jval_as_number(jmax_keys) : 0;
+
+  size_t sep_size = iotjs_string_size(&sep);
+  size_t eq_size = iotjs_string_size(&eq);
+  size_t size = iotjs_jval_string_size(jquery);
+
+  iotjs_jval_t jpairs = iotjs_jval_create_array(0);
+  if (size == 0 || sep_size == 0 || eq_size == 0) {
+    iotjs_string_destroy(&sep);
+    iotjs_string_destroy(&eq);
+    iotjs_jhandler_return_jval(jhandler, &jpairs);
+    iotjs_jval_destroy(&jpairs);
+    return;
+  }
+
+  // The query is copied and decoded into the two halves of one allocation.
+  char* query = iotjs_buffer_allocate(size * 2);
+  char* decoded = query + size;
+  iotjs_jval_copy_string(jquery, query, size);
+
+  const char* end = query + size;
+  const char* pair = query;
+  uint32_t count = 0;
+  while (max_keys == 0 || count < max_keys) {
+    const char* pair_end =
+        iotjs_httpparser_find(pair, end, iotjs_string_data(&sep), sep_size);
+    if (pair_end == NULL) {
+      pair_end = end;
+    }
+
+    if (pair_end > pair) {
+      const char* key_end = iotjs_httpparser_find(pair, pair_end,
+                                                  iotjs_string_data(&eq),
+                                                  eq_size);
+      const char* value = key_end != NULL ? key_end + eq_size : pair_end;
+      if (key_end == NULL) {
+        key_end = pair_end;
+      }
+
+      iotjs_jval_t jkey =
+          iotjs_httpparser_create_decoded(pair, (size_t)(key_end - pair),
+                                          decoded);
+      iotjs_jval_t jvalue =
+          iotjs_httpparser_create_decoded(value, (size_t)(pair_end - value),
+                                          decoded);
+      iotjs_jval_set_property_by_index(&jpairs, count * 2, &jkey);
+      iotjs_jval_set_property_by_index(&jpairs, count * 2 + 1, &jvalue);
+      iotjs_jval_destroy(&jkey);
+      iotjs_jval_destroy(&jvalue);
+      count++;
+    }
+
+    if (pair_end == end) {
+      break;
+    }
+    pair = pair_end + sep_size;
+  }
+
+  iotjs_buffer_release(query);
+  iotjs_string_destroy(&sep);
+  iotjs_string_destroy(&eq);
+
+  iotjs_jhandler_return_jval(jhandler, &jpairs);
+  iotjs_jval_destroy(&jpairs);
+}
+
+
 JHANDLER_FUNCTION(HTTPParserCons) {
   DJHANDLER_CHECK_THIS(object);
   DJHANDLER_CHECK_ARGS(1, number);
@@ -475,10 +1270,21 @@ JHANDLER_FUNCTION(HTTPParserCons) {
 iotjs_jval_t InitHttpparser() {
   iotjs_jval_t httpparser = iotjs_jval_create_object();
 
+  iotjs_httpparser_init_common_names();
+
   iotjs_jval_t jParserCons =
       iotjs_jval_create_function_with_dispatch(HTTPParserCons);
   iotjs_jval_set_property_jval(&httpparser, IOTJS_MAGIC_STRING_HTTPPARSER,
                                &jParserCons);
+  iotjs_jval_set_method(&httpparser, IOTJS_MAGIC_STRING_SERIALIZEHEADERS,
+                        SerializeHeaders);
+  iotjs_jval_set_method(&httpparser, IOTJS_MAGIC_STRING_FRAMECHUNK,
+                        FrameChunk);
+  iotjs_jval_set_method(&httpparser, IOTJS_MAGIC_STRING_PARSEURL, ParseUrl);
+  iotjs_jval_set_method(&httpparser, IOTJS_MAGIC_STRING_PARSEQUERY,
+                        ParseQuery);
+  iotjs_jval_set_method(&httpparser, IOTJS_MAGIC_STRING_COMPILEROUTES,
+                        CompileRoutes);
 
   iotjs_jval_set_property_number(&jParserCons, IOTJS_MAGIC_STRING_REQUEST,
                                  HTTP_REQUEST);
@@ -496,12 +1302,23 @@ iotjs_jval_t InitHttpparser() {
 
   iotjs_jval_t prototype = iotjs_jval_create_object();
 
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONHEADERS,
+                          GetOnHeaders, SetOnHeaders);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONHEADERSCOMPLETE,
+                          GetOnHeadersComplete, SetOnHeadersComplete);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONBODY, GetOnBody,
+                          SetOnBody);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONMESSAGECOMPLETE,
+                          GetOnMessageComplete, SetOnMessageComplete);
+
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_EXECUTE, Execute);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_REINITIALIZE,
                         Reinitialize);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_FINISH, Finish);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_PAUSE, Pause);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_RESUME, Resume);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETSTATICROUTES,
+                        SetStaticRoutes);
 
   iotjs_jval_set_property_jval(&jParserCons, IOTJS_MAGIC_STRING_PROTOTYPE,
                                &prototype);
@@ -14,6 +14,7 @@
  */
 
 #include "iotjs_module_https.h"
+#include "iotjs_module_buffer.h"
 #include "iotjs_objectwrap.h"
 #include <inttypes.h>
 #include <limits.h>
@@ -26,6 +27,129 @@
 void iotjs_https_destroy(iotjs_https_t* https_data);
 IOTJS_DEFINE_NATIVE_HANDLE_INFO(https);
 
+static iotjs_https_global_t https_global;
+
+//-------------Shared Handles------------
+// Set up the shared handles for the first request
+static bool iotjs_https_global_initialize() {
+  if (https_global.curl_multi_handle != NULL)
+    return true;
+
+  if (curl_global_init(CURL_GLOBAL_SSL))
+    return false;
+
+  CURLM* multi_handle = curl_multi_init();
+  curl_multi_setopt(multi_handle, CURLMOPT_SOCKETFUNCTION,
+                    iotjs_https_curl_socket_callback);
+  curl_multi_setopt(multi_handle, CURLMOPT_TIMERFUNCTION,
+                    iotjs_https_curl_start_timeout_callback);
+
+  CURLSH* share_handle = curl_share_init();
+  curl_share_setopt(share_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  curl_share_setopt(share_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+  https_global.curl_multi_handle = multi_handle;
+  https_global.curl_share_handle = share_handle;
+  https_global.timeout = NULL;
+  https_global.poll_list = NULL;
+  https_global.request_count = 0;
+  https_global.free_easy_handle_count = 0;
+  return true;
+}
+
+void iotjs_https_global_release() {
+  if (https_global.curl_multi_handle == NULL)
+    return;
+
+  IOTJS_ASSERT(https_global.request_count == 0);
+  IOTJS_ASSERT(https_global.poll_list == NULL);
+
+  for (size_t i = 0; i < https_global.free_easy_handle_count; i++)
+    curl_easy_cleanup(https_global.free_easy_handles[i]);
+  https_global.free_easy_handle_count = 0;
+
+  // The event loop is closed, curl must not poll the kept connections while
+  // closing them.
+  curl_multi_setopt(https_global.curl_multi_handle, CURLMOPT_SOCKETFUNCTION,
+                    NULL);
+  curl_multi_setopt(https_global.curl_multi_handle, CURLMOPT_TIMERFUNCTION,
+                    NULL);
+  curl_multi_cleanup(https_global.curl_multi_handle);
+  https_global.curl_multi_handle = NULL;
+  curl_share_cleanup(https_global.curl_share_handle);
+  https_global.curl_share_handle = NULL;
+
+  curl_global_cleanup();
+}
+
+// Start the timer of the multi handle with the first request
+static void iotjs_https_global_ref(uv_loop_t* loop) {
+  if (https_global.request_count++ == 0) {
+    IOTJS_ASSERT(https_global.timeout == NULL);
+    https_global.timeout = IOTJS_ALLOC(uv_timer_t);
+    uv_timer_init(loop, https_global.timeout);
+  }
+}
+
+static void iotjs_https_global_timeout_close_callback(uv_handle_t* handle) {
+  IOTJS_RELEASE(handle);
+}
+
+// Close the libtuv handles after the last request, so that they do not keep
+// the event loop alive. Connections stay in the cache of the multi handle.
+static void iotjs_https_global_unref() {
+  IOTJS_ASSERT(https_global.request_count > 0);
+  if (--https_global.request_count > 0)
+    return;
+
+  uv_close((uv_handle_t*)https_global.timeout,
+           iotjs_https_global_timeout_close_callback);
+  https_global.timeout = NULL;
+
+  // Curl has no transfers left to poll sockets for, forget the remaining ones.
+  iotjs_https_poll_t* current = https_global.poll_list;
+  while (current != NULL) {
+    IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_poll_t, current);
+    curl_multi_assign(https_global.curl_multi_handle, _this->sockfd, NULL);
+    current = iotjs_https_poll_get_next(current);
+  }
+  iotjs_https_poll_close_all(https_global.poll_list);
+}
+
+// Let curl act on its timeout after `timeout_ms`
+static void iotjs_https_global_start_timeout(uint64_t timeout_ms) {
+  if (https_global.timeout == NULL)
+    return;
+  uv_timer_stop(https_global.timeout);
+  uv_timer_start(https_global.timeout, iotjs_https_uv_timeout_callback,
+                 timeout_ms, 0);
+}
+
+// Take an easy handle of a finished request, or make a new one
+static CURL* iotjs_https_easy_handle_create() {
+  CURL* easy_handle;
+  if (https_global.free_easy_handle_count > 0) {
+    https_global.free_easy_handle_count--;
+    easy_handle =
+        https_global.free_easy_handles[https_global.free_easy_handle_count];
+  } else {
+    easy_handle = curl_easy_init();
+  }
+  curl_easy_setopt(easy_handle, CURLOPT_SHARE, https_global.curl_share_handle);
+  return easy_handle;
+}
+
+static void iotjs_https_easy_handle_release(CURL* easy_handle) {
+  if (https_global.free_easy_handle_count < IOTJS_HTTPS_EASY_HANDLE_POOL_SIZE) {
+    curl_easy_reset(easy_handle);
+    https_global.free_easy_handles[https_global.free_easy_handle_count] =
+        easy_handle;
+    https_global.free_easy_handle_count++;
+  } else {
+    curl_easy_cleanup(easy_handle);
+  }
+}
+
 //-------------Constructor------------
 iotjs_https_t* iotjs_https_create(const char* URL, const char* method,
                                   const char* ca, const char* cert,
@@ -72,13 +196,11 @@ iotjs_https_t* iotjs_https_create(const char* URL, const char* method,
   iotjs_jval_set_object_native_handle(&(_this->jthis_native),
                                       (uintptr_t)https_data,
                                       &https_native_info);
-  _this->curl_multi_handle = curl_multi_init();
-  _this->curl_easy_handle = curl_easy_init();
-  _this->timeout.data = (void*)https_data;
-  uv_timer_init(_this->loop, &(_this->timeout));
+  _this->curl_easy_handle = iotjs_https_easy_handle_create();
   _this->request_done = false;
-  _this->closing_handles = 3;
-  _this->poll_data = NULL;
+  _this->socket_emitted = false;
+  _this->closing_handles = 2;
+  iotjs_https_global_ref(_this->loop);
 
   // Timeout stuff
   _this->timeout_ms = -1;
@@ -88,11 +210,15 @@ iotjs_https_t* iotjs_https_create(const char* URL, const char* method,
   uv_timer_init(_this->loop, &(_this->socket_timeout));
 
   // ReadData stuff
-  _this->cur_read_index = 0;
+  _this->upload_buffer = NULL;
+  _this->upload_head = 0;
+  _this->upload_length = 0;
   _this->is_stream_writable = false;
+  _this->upload_paused = false;
   _this->stream_ended = false;
-  _this->data_to_read = false;
-  _this->to_destroy_read_onwrite = false;
+  _this->chunk_pending = false;
+  _this->pending_offset = 0;
+  _this->write_pending = false;
   _this->async_read_onwrite.data = (void*)https_data;
   uv_timer_init(_this->loop, &(_this->async_read_onwrite));
   // No Need to read data for following types of requests
@@ -113,22 +239,19 @@ void iotjs_https_destroy(iotjs_https_t* https_data) {
 }
 
 //----------------Utility Functions------------------
-void iotjs_https_check_done(iotjs_https_t* https_data) {
-  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
-  char* done_url;
+// Finish the requests which curl is done with
+void iotjs_https_check_done() {
   CURLMsg* message;
   int pending;
-  bool error = false;
-
-  while ((message = curl_multi_info_read(_this->curl_multi_handle, &pending))) {
-    switch (message->msg) {
-      case CURLMSG_DONE:
-        curl_easy_getinfo(message->easy_handle, CURLINFO_EFFECTIVE_URL,
-                          &done_url);
-        break;
-      default:
-        error = true;
-    }
+
+  while ((message = curl_multi_info_read(https_global.curl_multi_handle,
+                                         &pending))) {
+    iotjs_https_t* https_data = NULL;
+    curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE,
+                      (char**)&https_data);
+    IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
+
+    bool error = (message->msg != CURLMSG_DONE);
     if (error) {
       iotjs_jargs_t jarg = iotjs_jargs_create(1);
       char error[] = "Unknown Error has occured.";
@@ -143,22 +266,24 @@ void iotjs_https_check_done(iotjs_https_t* https_data) {
     if (_this->stream_ended) {
       iotjs_https_cleanup(https_data);
     } else {
-      if (_this->to_destroy_read_onwrite) {
+      // The rest of the body will not be sent.
+      if (_this->chunk_pending) {
+        _this->chunk_pending = false;
+        iotjs_jval_destroy(&(_this->pending_chunk));
         iotjs_https_call_read_onwrite_async(https_data);
       }
       _this->request_done = true;
     }
-    break;
   }
 }
 
 // Cleanup before destructor
 void iotjs_https_cleanup(iotjs_https_t* https_data) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
+  if (_this->curl_easy_handle == NULL)
+    return;
   _this->loop = NULL;
 
-  uv_close((uv_handle_t*)&_this->timeout,
-           (uv_close_cb)iotjs_https_uv_close_callback);
   uv_close((uv_handle_t*)&_this->socket_timeout,
            (uv_close_cb)iotjs_https_uv_close_callback);
   uv_close((uv_handle_t*)&_this->async_read_onwrite,
@@ -169,51 +294,48 @@ void iotjs_https_cleanup(iotjs_https_t* https_data) {
   iotjs_https_jcallback(https_data, IOTJS_MAGIC_STRING_ONCLOSED,
                         iotjs_jargs_get_empty(), false);
 
-  curl_multi_remove_handle(_this->curl_multi_handle, _this->curl_easy_handle);
-  curl_easy_cleanup(_this->curl_easy_handle);
+  // The connection stays in the cache of the multi handle for reuse.
+  curl_multi_remove_handle(https_global.curl_multi_handle,
+                           _this->curl_easy_handle);
+  iotjs_https_easy_handle_release(_this->curl_easy_handle);
   _this->curl_easy_handle = NULL;
-  curl_multi_cleanup(_this->curl_multi_handle);
-  _this->curl_multi_handle = NULL;
   curl_slist_free_all(_this->header_list);
+  _this->header_list = NULL;
 
-  if (_this->poll_data != NULL)
-    iotjs_https_poll_close_all(_this->poll_data);
-
-  if (_this->to_destroy_read_onwrite) {
-    const iotjs_jargs_t* jarg = iotjs_jargs_get_empty();
-    const iotjs_jval_t* jthis = &(_this->jthis_native);
-    IOTJS_ASSERT(iotjs_jval_is_function(&(_this->read_onwrite)));
-
-    if (!iotjs_jval_is_undefined(&(_this->read_callback)))
-      iotjs_make_callback(&(_this->read_callback), jthis, jarg);
+  if (_this->chunk_pending) {
+    _this->chunk_pending = false;
+    iotjs_jval_destroy(&(_this->pending_chunk));
+  }
+  iotjs_https_call_read_onwrite(&(_this->async_read_onwrite));
 
-    iotjs_make_callback(&(_this->read_onwrite), jthis, jarg);
-    _this->to_destroy_read_onwrite = false;
-    iotjs_string_destroy(&(_this->read_chunk));
-    iotjs_jval_destroy(&(_this->read_onwrite));
-    iotjs_jval_destroy(&(_this->read_callback));
+  if (_this->upload_buffer != NULL) {
+    iotjs_buffer_release(_this->upload_buffer);
+    _this->upload_buffer = NULL;
   }
+  _this->upload_length = 0;
+
+  iotjs_https_global_unref();
   return;
 }
 
-CURLM* iotjs_https_get_multi_handle(iotjs_https_t* https_data) {
+// Emit 'socket' once, also when curl reuses a connection and does not open a
+// socket for the request
+void iotjs_https_emit_socket(iotjs_https_t* https_data) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
-  return _this->curl_multi_handle;
+  if (_this->socket_emitted)
+    return;
+  _this->socket_emitted = true;
+  iotjs_https_jcallback(https_data, IOTJS_MAGIC_STRING_ONSOCKET,
+                        iotjs_jargs_get_empty(), false);
 }
 
 // Set various parameters of curl handles
 void iotjs_https_initialize_curl_opts(iotjs_https_t* https_data) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
 
-  // Setup Some parameters for multi handle
-  curl_multi_setopt(_this->curl_multi_handle, CURLMOPT_SOCKETFUNCTION,
-                    iotjs_https_curl_socket_callback);
-  curl_multi_setopt(_this->curl_multi_handle, CURLMOPT_SOCKETDATA,
-                    (void*)https_data);
-  curl_multi_setopt(_this->curl_multi_handle, CURLMOPT_TIMERFUNCTION,
-                    iotjs_https_curl_start_timeout_callback);
-  curl_multi_setopt(_this->curl_multi_handle, CURLMOPT_TIMERDATA,
-                    (void*)https_data);
+  // The request of an easy handle in messages of the multi handle
+  curl_easy_setopt(_this->curl_easy_handle, CURLOPT_PRIVATE,
+                   (void*)https_data);
 
   curl_easy_setopt(_this->curl_easy_handle, CURLOPT_PROXY, "");
   curl_easy_setopt(_this->curl_easy_handle, CURLOPT_HEADERDATA,
@@ -323,25 +445,33 @@ bool iotjs_https_jcallback(iotjs_https_t* https_data, const char* property,
   return retval;
 }
 
-// Call onWrite and callback after ClientRequest._write
+// Call onWrite and callback of a ClientRequest._write which waited for room
+// in the ring buffer
 void iotjs_https_call_read_onwrite(uv_timer_t* timer) {
   iotjs_https_t* https_data = (iotjs_https_t*)(timer->data);
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
 
   uv_timer_stop(&(_this->async_read_onwrite));
-  if (iotjs_jval_is_null(&_this->jthis_native))
+  if (!_this->write_pending || iotjs_jval_is_null(&_this->jthis_native))
     return;
   const iotjs_jargs_t* jarg = iotjs_jargs_get_empty();
   const iotjs_jval_t* jthis = &(_this->jthis_native);
   IOTJS_ASSERT(iotjs_jval_is_function(&(_this->read_onwrite)));
 
-  if (!iotjs_jval_is_undefined(&(_this->read_callback)))
-    iotjs_make_callback(&(_this->read_callback), jthis, jarg);
+  // The callbacks may write the next chunk.
+  iotjs_jval_t callback = _this->read_callback;
+  iotjs_jval_t onwrite = _this->read_onwrite;
+  _this->write_pending = false;
+
+  if (!iotjs_jval_is_undefined(&callback))
+    iotjs_make_callback(&callback, jthis, jarg);
 
-  iotjs_make_callback(&(_this->read_onwrite), jthis, jarg);
+  iotjs_make_callback(&onwrite, jthis, jarg);
+  iotjs_jval_destroy(&callback);
+  iotjs_jval_destroy(&onwrite);
 }
 
-// Call the above method Asynchronously
+// Call the above method Asynchronously, not from within a curl callback
 void iotjs_https_call_read_onwrite_async(iotjs_https_t* https_data) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
   uv_timer_start(&(_this->async_read_onwrite), iotjs_https_call_read_onwrite, 0,
@@ -363,34 +493,122 @@ void iotjs_https_add_header(iotjs_https_t* https_data,
   }
 }
 
-// Recieved data to write from ClientRequest._write
-void iotjs_https_data_to_write(iotjs_https_t* https_data,
-                               iotjs_string_t read_chunk,
+// Copy data at the end of the ring buffer, as much as fits
+static size_t iotjs_https_upload_push(iotjs_https_t* https_data,
+                                      const char* data, size_t len) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
+  const size_t capacity = IOTJS_HTTPS_UPLOAD_BUFFER_SIZE;
+  size_t copied = 0;
+
+  while (copied < len && _this->upload_length < capacity) {
+    size_t tail = (_this->upload_head + _this->upload_length) % capacity;
+    size_t room = (tail >= _this->upload_head) ? capacity - tail
+                                               : _this->upload_head - tail;
+    size_t num_to_copy = (len - copied < room) ? len - copied : room;
+    memcpy(_this->upload_buffer + tail, data + copied, num_to_copy);
+    _this->upload_length += num_to_copy;
+    copied += num_to_copy;
+  }
+
+  return copied;
+}
+
+// Take data from the front of the ring buffer
+static size_t iotjs_https_upload_pop(iotjs_https_t* https_data, char* dest,
+                                     size_t len) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
+  const size_t capacity = IOTJS_HTTPS_UPLOAD_BUFFER_SIZE;
+  size_t copied = 0;
+
+  while (copied < len && _this->upload_length > 0) {
+    size_t num_to_copy = capacity - _this->upload_head;
+    if (num_to_copy > _this->upload_length)
+      num_to_copy = _this->upload_length;
+    if (num_to_copy > len - copied)
+      num_to_copy = len - copied;
+    memcpy(dest + copied, _this->upload_buffer + _this->upload_head,
+           num_to_copy);
+    _this->upload_head = (_this->upload_head + num_to_copy) % capacity;
+    _this->upload_length -= num_to_copy;
+    copied += num_to_copy;
+  }
+
+  if (_this->upload_length == 0)
+    _this->upload_head = 0;
+
+  return copied;
+}
+
+// Move the rest of the pending chunk to the ring buffer. Once it is all
+// there, the writer may go on.
+static void iotjs_https_upload_fill(iotjs_https_t* https_data) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
+  if (!_this->chunk_pending)
+    return;
+
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(&(_this->pending_chunk));
+  const char* data = iotjs_bufferwrap_buffer(buffer_wrap);
+  size_t len = iotjs_bufferwrap_length(buffer_wrap);
+
+  _this->pending_offset +=
+      iotjs_https_upload_push(https_data, data + _this->pending_offset,
+                              len - _this->pending_offset);
+
+  if (_this->pending_offset == len) {
+    _this->chunk_pending = false;
+    iotjs_jval_destroy(&(_this->pending_chunk));
+    iotjs_https_call_read_onwrite_async(https_data);
+  }
+}
+
+// Let curl call the read callback again
+static void iotjs_https_upload_resume(iotjs_https_t* https_data) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
+  if (!_this->upload_paused)
+    return;
+  _this->upload_paused = false;
+  curl_easy_pause(_this->curl_easy_handle, CURLPAUSE_CONT);
+  iotjs_https_global_start_timeout(1);
+}
+
+// Recieved data to write from ClientRequest._write. Returns true if the whole
+// chunk is taken, otherwise onwrite is called once it is.
+bool iotjs_https_data_to_write(iotjs_https_t* https_data,
+                               const iotjs_jval_t* jchunk,
                                const iotjs_jval_t* callback,
                                const iotjs_jval_t* onwrite) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
+  IOTJS_ASSERT(!_this->write_pending);
 
-  if (_this->to_destroy_read_onwrite) {
-    _this->to_destroy_read_onwrite = false;
-    iotjs_string_destroy(&(_this->read_chunk));
-    iotjs_jval_destroy(&(_this->read_onwrite));
-    iotjs_jval_destroy(&(_this->read_callback));
+  // The request is over, the data is dropped.
+  if (_this->request_done || _this->curl_easy_handle == NULL)
+    return true;
+
+  if (_this->upload_buffer == NULL) {
+    _this->upload_buffer =
+        iotjs_buffer_allocate(IOTJS_HTTPS_UPLOAD_BUFFER_SIZE);
   }
 
-  _this->read_chunk = read_chunk;
-  _this->data_to_read = true;
+  iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(jchunk);
+  const char* data = iotjs_bufferwrap_buffer(buffer_wrap);
+  size_t len = iotjs_bufferwrap_length(buffer_wrap);
+
+  size_t copied = iotjs_https_upload_push(https_data, data, len);
+  if (copied > 0)
+    iotjs_https_upload_resume(https_data);
 
+  if (copied == len)
+    return true;
+
+  _this->chunk_pending = true;
+  _this->pending_chunk = iotjs_jval_create_copied(jchunk);
+  _this->pending_offset = copied;
+
+  _this->write_pending = true;
   _this->read_callback = iotjs_jval_create_copied(callback);
   _this->read_onwrite = iotjs_jval_create_copied(onwrite);
-  _this->to_destroy_read_onwrite = true;
-
-  if (_this->request_done) {
-    iotjs_https_call_read_onwrite_async(https_data);
-  } else if (_this->is_stream_writable) {
-    curl_easy_pause(_this->curl_easy_handle, CURLPAUSE_CONT);
-    uv_timer_stop(&(_this->timeout));
-    uv_timer_start(&(_this->timeout), iotjs_https_uv_timeout_callback, 1, 0);
-  }
+  return false;
 }
 
 // Finish writing all data from ClientRequest Stream
@@ -399,10 +617,8 @@ void iotjs_https_finish_request(iotjs_https_t* https_data) {
   _this->stream_ended = true;
   if (_this->request_done) {
     iotjs_https_cleanup(https_data);
-  } else if (_this->is_stream_writable) {
-    curl_easy_pause(_this->curl_easy_handle, CURLPAUSE_CONT);
-    uv_timer_stop(&(_this->timeout));
-    uv_timer_start(&(_this->timeout), iotjs_https_uv_timeout_callback, 1, 0);
+  } else {
+    iotjs_https_upload_resume(https_data);
   }
 }
 
@@ -420,7 +636,8 @@ void iotjs_https_send_request(iotjs_https_t* https_data) {
     curl_easy_setopt(_this->curl_easy_handle, CURLOPT_INFILESIZE,
                      _this->content_length);
 
-  curl_multi_add_handle(_this->curl_multi_handle, _this->curl_easy_handle);
+  curl_multi_add_handle(https_global.curl_multi_handle,
+                        _this->curl_easy_handle);
 }
 
 // Set timeout for request.
@@ -441,6 +658,8 @@ size_t iotjs_https_curl_read_callback(void* contents, size_t size, size_t nmemb,
   iotjs_https_t* https_data = (iotjs_https_t*)userp;
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
 
+  iotjs_https_emit_socket(https_data);
+
   // If stream wasnt made writable yet, make it so.
   if (!_this->is_stream_writable) {
     _this->is_stream_writable = true;
@@ -448,33 +667,24 @@ size_t iotjs_https_curl_read_callback(void* contents, size_t size, size_t nmemb,
                           iotjs_jargs_get_empty(), false);
   }
 
-  if (_this->data_to_read) {
-    size_t real_size = size * nmemb;
-    size_t chunk_size = iotjs_string_size(&(_this->read_chunk));
-    size_t left_to_copy_size = chunk_size - _this->cur_read_index;
-
-    if (real_size < 1)
-      return 0;
-
-    // send some data
-    if (_this->cur_read_index < chunk_size) {
-      size_t num_to_copy =
-          (left_to_copy_size < real_size) ? left_to_copy_size : real_size;
-      const char* buf = iotjs_string_data(&(_this->read_chunk));
-      buf = &buf[_this->cur_read_index];
-      strncpy((char*)contents, buf, num_to_copy);
-      _this->cur_read_index = _this->cur_read_index + num_to_copy;
-      return num_to_copy;
+  size_t real_size = size * nmemb;
+  if (real_size < 1)
+    return 0;
+
+  // send the staged data, refilling from a pending chunk
+  if (_this->upload_length > 0) {
+    size_t copied = 0;
+    while (copied < real_size && _this->upload_length > 0) {
+      copied += iotjs_https_upload_pop(https_data, (char*)contents + copied,
+                                       real_size - copied);
+      iotjs_https_upload_fill(https_data);
     }
-
-    // Finished sending one chunk of data
-    _this->cur_read_index = 0;
-    _this->data_to_read = false;
-    iotjs_https_call_read_onwrite_async(https_data);
+    return copied;
   }
 
   // If the data is sent, and stream hasn't ended, wait for more data
   if (!_this->stream_ended) {
+    _this->upload_paused = true;
     return CURL_READFUNC_PAUSE;
   }
 
@@ -485,20 +695,15 @@ size_t iotjs_https_curl_read_callback(void* contents, size_t size, size_t nmemb,
 // Pass Curl events on its fd sockets
 int iotjs_https_curl_socket_callback(CURL* easy, curl_socket_t sockfd,
                                      int action, void* userp, void* socketp) {
-  iotjs_https_t* https_data = (iotjs_https_t*)userp;
-  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
   if (action == CURL_POLL_IN || action == CURL_POLL_OUT ||
       action == CURL_POLL_INOUT) {
     iotjs_https_poll_t* poll_data = NULL;
 
     if (!socketp) {
-      poll_data = iotjs_https_poll_create(_this->loop, sockfd, https_data);
-      curl_multi_assign(_this->curl_multi_handle, sockfd, (void*)poll_data);
-      _this->closing_handles = _this->closing_handles + 1;
-      if (_this->poll_data == NULL)
-        _this->poll_data = poll_data;
-      else
-        iotjs_https_poll_append(_this->poll_data, poll_data);
+      uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());
+      poll_data = iotjs_https_poll_create(loop, sockfd);
+      curl_multi_assign(https_global.curl_multi_handle, sockfd,
+                        (void*)poll_data);
     } else
       poll_data = (iotjs_https_poll_t*)socketp;
 
@@ -515,7 +720,7 @@ int iotjs_https_curl_socket_callback(CURL* easy, curl_socket_t sockfd,
     if (socketp) {
       iotjs_https_poll_t* poll_data = (iotjs_https_poll_t*)socketp;
       iotjs_https_poll_close(poll_data);
-      curl_multi_assign(_this->curl_multi_handle, sockfd, NULL);
+      curl_multi_assign(https_global.curl_multi_handle, sockfd, NULL);
     }
   }
   return 0;
@@ -525,25 +730,21 @@ int iotjs_https_curl_socket_callback(CURL* easy, curl_socket_t sockfd,
 int iotjs_https_curl_sockopt_callback(void* userp, curl_socket_t curlfd,
                                       curlsocktype purpose) {
   iotjs_https_t* https_data = (iotjs_https_t*)userp;
-  iotjs_https_jcallback(https_data, IOTJS_MAGIC_STRING_ONSOCKET,
-                        iotjs_jargs_get_empty(), false);
+  iotjs_https_emit_socket(https_data);
   return CURL_SOCKOPT_OK;
 }
 
 // Curl wants us to signal after timeout
 int iotjs_https_curl_start_timeout_callback(CURLM* multi, long timeout_ms,
                                             void* userp) {
-  iotjs_https_t* https_data = (iotjs_https_t*)userp;
-  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
+  if (https_global.timeout == NULL)
+    return 0;
   if (timeout_ms < 0)
-    uv_timer_stop(&(_this->timeout));
+    uv_timer_stop(https_global.timeout);
   else {
     if (timeout_ms == 0)
       timeout_ms = 1;
-    if ((_this->timeout_ms != -1) && (timeout_ms > _this->timeout_ms))
-      timeout_ms = _this->timeout_ms;
-    uv_timer_start(&(_this->timeout), iotjs_https_uv_timeout_callback,
-                   (uint64_t)timeout_ms, 0);
+    iotjs_https_global_start_timeout((uint64_t)timeout_ms);
   }
   return 0;
 }
@@ -556,6 +757,7 @@ size_t iotjs_https_curl_write_callback(void* contents, size_t size,
   size_t real_size = size * nmemb;
   if (iotjs_jval_is_null(&_this->jthis_native))
     return real_size - 1;
+  iotjs_https_emit_socket(https_data);
   iotjs_jargs_t jarg = iotjs_jargs_create(1);
   iotjs_jval_t jresult_arr = iotjs_jval_create_byte_array(real_size, contents);
   iotjs_jargs_append_jval(&jarg, &jresult_arr);
@@ -581,8 +783,6 @@ void iotjs_https_uv_close_callback(uv_handle_t* handle) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
   _this->closing_handles = _this->closing_handles - 1;
   if (_this->closing_handles <= 0) {
-    if (_this->poll_data != NULL)
-      iotjs_https_poll_destroy(_this->poll_data);
     iotjs_jval_destroy(&_this->jthis_native);
   }
 }
@@ -591,7 +791,6 @@ void iotjs_https_uv_close_callback(uv_handle_t* handle) {
 void iotjs_https_uv_poll_callback(uv_poll_t* poll, int status, int events) {
   iotjs_https_poll_t* poll_data = (iotjs_https_poll_t*)poll->data;
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_poll_t, poll_data);
-  iotjs_https_t* https_data = (iotjs_https_t*)_this->https_data;
 
   int flags = 0;
   if (status < 0)
@@ -600,21 +799,18 @@ void iotjs_https_uv_poll_callback(uv_poll_t* poll, int status, int events) {
     flags |= CURL_CSELECT_IN;
   if (!status && events & UV_WRITABLE)
     flags |= CURL_CSELECT_OUT;
-  int running_handles;
-  curl_multi_socket_action(iotjs_https_get_multi_handle(https_data),
-                           _this->sockfd, flags, &running_handles);
-  iotjs_https_check_done(https_data);
+  curl_multi_socket_action(https_global.curl_multi_handle, _this->sockfd,
+                           flags, &https_global.running_handles);
+  iotjs_https_check_done();
 }
 
 // This function is for signalling to curl a given time has passed.
 // This timeout is usually given by curl itself.
 void iotjs_https_uv_timeout_callback(uv_timer_t* timer) {
-  iotjs_https_t* https_data = (iotjs_https_t*)(timer->data);
-  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_t, https_data);
   uv_timer_stop(timer);
-  curl_multi_socket_action(_this->curl_multi_handle, CURL_SOCKET_TIMEOUT, 0,
-                           &_this->running_handles);
-  iotjs_https_check_done(https_data);
+  curl_multi_socket_action(https_global.curl_multi_handle, CURL_SOCKET_TIMEOUT,
+                           0, &https_global.running_handles);
+  iotjs_https_check_done();
 }
 
 // Callback called to check if request has timed out
@@ -651,34 +847,45 @@ void iotjs_https_uv_socket_timeout_callback(uv_timer_t* timer) {
 
 //--------------https_poll Functions------------------
 iotjs_https_poll_t* iotjs_https_poll_create(uv_loop_t* loop,
-                                            curl_socket_t sockfd,
-                                            iotjs_https_t* https_data) {
+                                            curl_socket_t sockfd) {
   iotjs_https_poll_t* poll_data = IOTJS_ALLOC(iotjs_https_poll_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_https_poll_t, poll_data);
   _this->sockfd = sockfd;
   _this->poll_handle.data = poll_data;
-  _this->https_data = https_data;
   _this->closing = false;
-  _this->next = NULL;
   uv_poll_init_socket(loop, &_this->poll_handle, sockfd);
+
+  _this->next = (struct iotjs_https_poll_t*)https_global.poll_list;
+  https_global.poll_list = poll_data;
   return poll_data;
 }
 
-void iotjs_https_poll_append(iotjs_https_poll_t* head,
-                             iotjs_https_poll_t* poll_data) {
-  iotjs_https_poll_t* current = head;
-  iotjs_https_poll_t* next = iotjs_https_poll_get_next(current);
-  while (next != NULL) {
-    current = next;
-    next = iotjs_https_poll_get_next(current);
+static void iotjs_https_poll_set_next(iotjs_https_poll_t* poll_data,
+                                      iotjs_https_poll_t* next) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_poll_t, poll_data);
+  _this->next = (struct iotjs_https_poll_t*)next;
+}
+
+// Unlink the closed poll from the list of the shared handles and free it
+static void iotjs_https_poll_close_callback(uv_handle_t* handle) {
+  iotjs_https_poll_t* poll_data = (iotjs_https_poll_t*)handle->data;
+  iotjs_https_poll_t* next = iotjs_https_poll_get_next(poll_data);
+
+  if (https_global.poll_list == poll_data) {
+    https_global.poll_list = next;
+  } else {
+    iotjs_https_poll_t* current = https_global.poll_list;
+    while (iotjs_https_poll_get_next(current) != poll_data)
+      current = iotjs_https_poll_get_next(current);
+    iotjs_https_poll_set_next(current, next);
   }
-  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_poll_t, current);
-  _this->next = poll_data;
+
+  iotjs_https_poll_destroy(poll_data);
 }
 
 iotjs_https_poll_t* iotjs_https_poll_get_next(iotjs_https_poll_t* poll_data) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_https_poll_t, poll_data);
-  return _this->next;
+  return (iotjs_https_poll_t*)_this->next;
 }
 
 uv_poll_t* iotjs_https_poll_get_poll_handle(iotjs_https_poll_t* poll_data) {
@@ -691,8 +898,8 @@ void iotjs_https_poll_close(iotjs_https_poll_t* poll_data) {
   if (_this->closing == false) {
     _this->closing = true;
     uv_poll_stop(&_this->poll_handle);
-    _this->poll_handle.data = _this->https_data;
-    uv_close((uv_handle_t*)&_this->poll_handle, iotjs_https_uv_close_callback);
+    uv_close((uv_handle_t*)&_this->poll_handle,
+             iotjs_https_poll_close_callback);
   }
   return;
 }
@@ -707,9 +914,7 @@ void iotjs_https_poll_close_all(iotjs_https_poll_t* head) {
 
 void iotjs_https_poll_destroy(iotjs_https_poll_t* poll_data) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_https_poll_t, poll_data);
-  if (_this->next != NULL) {
-    iotjs_https_poll_destroy(_this->next);
-  }
+  _this->next = NULL;
   IOTJS_RELEASE(poll_data);
 }
 
@@ -746,7 +951,7 @@ JHANDLER_FUNCTION(createRequest) {
       iotjs_jval_get_property(jthis, IOTJS_MAGIC_STRING_REJECTUNAUTHORIZED);
   const bool reject_unauthorized = iotjs_jval_as_boolean(&jreject_unauthorized);
 
-  if (curl_global_init(CURL_GLOBAL_SSL)) {
+  if (!iotjs_https_global_initialize()) {
     return;
   }
   iotjs_https_t* https_data =
@@ -807,22 +1012,21 @@ JHANDLER_FUNCTION(setTimeout) {
 
 JHANDLER_FUNCTION(_write) {
   DJHANDLER_CHECK_THIS(object);
-  DJHANDLER_CHECK_ARGS(2, object, string);
+  DJHANDLER_CHECK_ARGS(2, object, object);
   // Argument 3 can be null, so not checked directly, checked later
   DJHANDLER_CHECK_ARG(3, function);
 
   const iotjs_jval_t* jthis = JHANDLER_GET_ARG(0, object);
-  iotjs_string_t read_chunk = JHANDLER_GET_ARG(1, string);
+  const iotjs_jval_t* jchunk = JHANDLER_GET_ARG(1, object);
 
   const iotjs_jval_t* callback = iotjs_jhandler_get_arg(jhandler, 2);
   const iotjs_jval_t* onwrite = JHANDLER_GET_ARG(3, function);
 
   iotjs_https_t* https_data =
       (iotjs_https_t*)iotjs_jval_get_object_native_handle(jthis);
-  iotjs_https_data_to_write(https_data, read_chunk, callback, onwrite);
+  bool done = iotjs_https_data_to_write(https_data, jchunk, callback, onwrite);
 
-  // readchunk was copied to https_data, hence not destroyed.
-  iotjs_jhandler_return_null(jhandler);
+  iotjs_jhandler_return_boolean(jhandler, done);
 }
 
 JHANDLER_FUNCTION(finishRequest) {
@@ -40,6 +40,10 @@ typedef enum {
 #define STRING_OPTIONS "OPTIONS"
 #define STRING_TRACE "TRACE"
 
+// Bytes of the request body staged for curl. A write beyond this waits until
+// curl has sent some of the body.
+#define IOTJS_HTTPS_UPLOAD_BUFFER_SIZE 16384
+
 // A Per-Request Struct, native bound to https.ClientRequest
 typedef struct {
   // Original Request Details
@@ -54,17 +58,15 @@ typedef struct {
   // Content-Length for Post and Put
   long content_length;
 
-  // Handles
+  // Handles, the easy handle is added to the multi handle shared by all the
+  // requests (iotjs_https_global_t).
   uv_loop_t* loop;
   iotjs_jval_t jthis_native;
-  CURLM* curl_multi_handle;
-  uv_timer_t timeout;
   CURL* curl_easy_handle;
   // Curl Context
-  int running_handles;
   int closing_handles;
   bool request_done;
-  struct iotjs_https_poll_t* poll_data;
+  bool socket_emitted;
 
   // For SetTimeOut
   uv_timer_t socket_timeout;
@@ -73,12 +75,20 @@ typedef struct {
   uint64_t last_bytes_time;
 
   // For Writable Stream ClientRequest
-  size_t cur_read_index;
+  // The body is copied to a ring buffer, which the read callback of curl
+  // drains.
+  char* upload_buffer;
+  size_t upload_head;
+  size_t upload_length;
   bool is_stream_writable;
-  bool data_to_read;
+  bool upload_paused;
   bool stream_ended;
-  bool to_destroy_read_onwrite;
-  iotjs_string_t read_chunk;
+  // The rest of a chunk not fitting in the ring buffer
+  bool chunk_pending;
+  iotjs_jval_t pending_chunk;
+  size_t pending_offset;
+  // Callbacks of the write waiting for room in the ring buffer
+  bool write_pending;
   iotjs_jval_t read_callback;
   iotjs_jval_t read_onwrite;
   uv_timer_t async_read_onwrite;
@@ -93,9 +103,9 @@ iotjs_https_t* iotjs_https_create(const char* URL, const char* method,
 
 #define THIS iotjs_https_t* https_data
 // Some utility functions
-void iotjs_https_check_done(THIS);
+void iotjs_https_check_done();
 void iotjs_https_cleanup(THIS);
-CURLM* iotjs_https_get_multi_handle(THIS);
+void iotjs_https_emit_socket(THIS);
 void iotjs_https_initialize_curl_opts(THIS);
 iotjs_jval_t* iotjs_https_jthis_from_https(THIS);
 bool iotjs_https_jcallback(THIS, const char* property,
@@ -105,7 +115,7 @@ void iotjs_https_call_read_onwrite_async(THIS);
 
 // Functions almost directly called by JS via JHANDLER
 void iotjs_https_add_header(THIS, const char* char_header);
-void iotjs_https_data_to_write(THIS, iotjs_string_t read_chunk,
+bool iotjs_https_data_to_write(THIS, const iotjs_jval_t* jchunk,
                                const iotjs_jval_t* callback,
                                const iotjs_jval_t* onwrite);
 void iotjs_https_finish_request(THIS);
@@ -132,23 +142,42 @@ void iotjs_https_uv_poll_callback(uv_poll_t* poll, int status, int events);
 void iotjs_https_uv_socket_timeout_callback(uv_timer_t* timer);
 void iotjs_https_uv_timeout_callback(uv_timer_t* timer);
 
+// A socket of the shared multi handle, polled while curl waits on it
 typedef struct {
   uv_poll_t poll_handle;
   struct iotjs_https_poll_t* next;
-  struct iotjs_https_t* https_data;
   curl_socket_t sockfd;
   bool closing;
 } IOTJS_VALIDATED_STRUCT(iotjs_https_poll_t);
 
 iotjs_https_poll_t* iotjs_https_poll_create(uv_loop_t* loop,
-                                            curl_socket_t sockfd,
-                                            iotjs_https_t* https_data);
-void iotjs_https_poll_append(iotjs_https_poll_t* head,
-                             iotjs_https_poll_t* poll_data);
+                                            curl_socket_t sockfd);
 iotjs_https_poll_t* iotjs_https_poll_get_next(iotjs_https_poll_t* poll_data);
 uv_poll_t* iotjs_https_poll_get_poll_handle(iotjs_https_poll_t* poll_data);
 void iotjs_https_poll_close(iotjs_https_poll_t* poll_data);
 void iotjs_https_poll_destroy(iotjs_https_poll_t* poll_data);
 void iotjs_https_poll_close_all(iotjs_https_poll_t* head);
 
+
+// Number of easy handles of finished requests kept for reuse
+#define IOTJS_HTTPS_EASY_HANDLE_POOL_SIZE 4
+
+// Curl and libtuv handles shared by all the requests. The multi handle keeps
+// the connections of finished requests for later requests to the same host,
+// and the share handle keeps resolved names and TLS sessions.
+typedef struct {
+  CURLM* curl_multi_handle;
+  CURLSH* curl_share_handle;
+  // Allocated while there are requests, closed when the last one is done.
+  uv_timer_t* timeout;
+  iotjs_https_poll_t* poll_list;
+  int running_handles;
+  size_t request_count;
+  CURL* free_easy_handles[IOTJS_HTTPS_EASY_HANDLE_POOL_SIZE];
+  size_t free_easy_handle_count;
+} iotjs_https_global_t;
+
+// Releases the shared handles and the connections kept by them.
+void iotjs_https_global_release();
+
 #endif /* IOTJS_MODULE_HTTPS_H */
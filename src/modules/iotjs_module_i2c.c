@@ -16,6 +16,7 @@
 
 #include "iotjs_def.h"
 #include "iotjs_module_i2c.h"
+#include "iotjs_module_buffer.h"
 #include "iotjs_objectwrap.h"
 
 
@@ -26,6 +27,9 @@ static JNativeInfoType this_module_native_info = {.free_cb = NULL };
 static void i2c_destroy_data(iotjs_i2c_t* i2c) {
   IOTJS_DECLARE_THIS(iotjs_i2c_t, i2c);
   i2c_destroy_platform_data(_this->platform_data);
+  if (_this->bus_queue != NULL) {
+    iotjs_busqueue_release(_this->bus_queue);
+  }
 }
 
 static iotjs_i2c_t* iotjs_i2c_create(iotjs_jhandler_t* jhandler,
@@ -38,9 +42,14 @@ static iotjs_i2c_t* iotjs_i2c_create(iotjs_jhandler_t* jhandler,
   return i2c;
 }
 
+IOTJS_DEFINE_POOL(i2c_reqwrap_pool, iotjs_i2c_reqwrap_t, "i2c",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 static iotjs_i2c_reqwrap_t* iotjs_i2c_reqwrap_create(
     const iotjs_jval_t* jcallback, iotjs_i2c_t* i2c, I2cOp op) {
-  iotjs_i2c_reqwrap_t* i2c_reqwrap = IOTJS_ALLOC(iotjs_i2c_reqwrap_t);
+  iotjs_i2c_reqwrap_t* i2c_reqwrap =
+      IOTJS_POOL_ALLOC(i2c_reqwrap_pool, iotjs_i2c_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_i2c_reqwrap_t, i2c_reqwrap);
 
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -53,7 +62,7 @@ static iotjs_i2c_reqwrap_t* iotjs_i2c_reqwrap_create(
 static void iotjs_i2c_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_i2c_reqwrap_t, i2c_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(i2c_reqwrap);
+  IOTJS_POOL_RELEASE(i2c_reqwrap_pool, i2c_reqwrap);
 }
 
 void iotjs_i2c_reqwrap_dispatched(THIS) {
@@ -61,7 +70,7 @@ void iotjs_i2c_reqwrap_dispatched(THIS) {
   iotjs_i2c_reqwrap_destroy(i2c_reqwrap);
 }
 
-uv_work_t* iotjs_i2c_reqwrap_req(THIS) {
+iotjs_bus_work_t* iotjs_i2c_reqwrap_req(THIS) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_i2c_reqwrap_t, i2c_reqwrap);
   return &_this->req;
 }
@@ -98,6 +107,83 @@ iotjs_i2c_t* iotjs_i2c_instance_from_jval(const iotjs_jval_t* ji2c) {
   return (iotjs_i2c_t*)jobjectwrap;
 }
 
+// Sets up the messages of a transfer from `jmsgs`, the address, direction
+// and length of each message in a row, and `jdata`, the bytes of all writes.
+static bool GetI2cTransfer(const iotjs_jval_t* jmsgs, const iotjs_jval_t* jdata,
+                           iotjs_i2c_reqdata_t* req_data) {
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jmsgs, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t length = iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+
+  uint32_t msg_count = length / 3;
+  if (msg_count == 0 || msg_count > IOTJS_I2C_TRANSFER_MSGS_MAX ||
+      msg_count * 3 != length) {
+    return false;
+  }
+
+  iotjs_i2c_msg_t msgs[IOTJS_I2C_TRANSFER_MSGS_MAX];
+  size_t read_len = 0;
+  size_t write_len = 0;
+  for (uint32_t i = 0; i < msg_count; ++i) {
+    iotjs_jval_t jaddress = iotjs_jval_get_property_by_index(jmsgs, i * 3);
+    iotjs_jval_t jread = iotjs_jval_get_property_by_index(jmsgs, i * 3 + 1);
+    iotjs_jval_t jlen = iotjs_jval_get_property_by_index(jmsgs, i * 3 + 2);
+    msgs[i].address = iotjs_jval_as_number(&jaddress);
+    msgs[i].read = iotjs_jval_as_boolean(&jread);
+    msgs[i].length = iotjs_jval_as_number(&jlen);
+    iotjs_jval_destroy(&jaddress);
+    iotjs_jval_destroy(&jread);
+    iotjs_jval_destroy(&jlen);
+
+    if (msgs[i].read) {
+      read_len += msgs[i].length;
+    } else {
+      write_len += msgs[i].length;
+    }
+  }
+
+  iotjs_bufferwrap_t* data = iotjs_bufferwrap_from_jbuffer(jdata);
+  if (iotjs_bufferwrap_length(data) != write_len) {
+    return false;
+  }
+
+  // Reads first, so that their bytes are contiguous.
+  char* transfer_data = iotjs_buffer_allocate(read_len + write_len + 1);
+  memcpy(transfer_data + read_len, iotjs_bufferwrap_buffer(data), write_len);
+
+  size_t read_offset = 0;
+  size_t write_offset = read_len;
+  for (uint32_t i = 0; i < msg_count; ++i) {
+    size_t* offset = msgs[i].read ? &read_offset : &write_offset;
+    msgs[i].data = (uint8_t*)transfer_data + *offset;
+    *offset += msgs[i].length;
+  }
+
+  req_data->msgs = (iotjs_i2c_msg_t*)iotjs_buffer_allocate(
+      msg_count * sizeof(iotjs_i2c_msg_t));
+  memcpy(req_data->msgs, msgs, msg_count * sizeof(iotjs_i2c_msg_t));
+  req_data->msg_count = msg_count;
+  req_data->transfer_data = transfer_data;
+  req_data->read_len = read_len;
+
+  return true;
+}
+
+static iotjs_jval_t CreateI2cTransferResult(iotjs_i2c_reqdata_t* req_data) {
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(req_data->read_len);
+  iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+  iotjs_bufferwrap_copy(buffer, req_data->transfer_data, req_data->read_len);
+  return jbuffer;
+}
+
+static void ReleaseI2cTransfer(iotjs_i2c_reqdata_t* req_data) {
+  iotjs_buffer_release((char*)req_data->msgs);
+  iotjs_buffer_release(req_data->transfer_data);
+  req_data->msgs = NULL;
+  req_data->transfer_data = NULL;
+}
+
 void AfterI2CWork(uv_work_t* work_req, int status) {
   iotjs_i2c_reqwrap_t* req_wrap = iotjs_i2c_reqwrap_from_request(work_req);
   iotjs_i2c_reqdata_t* req_data = iotjs_i2c_reqwrap_data(req_wrap);
@@ -157,6 +243,21 @@ void AfterI2CWork(uv_work_t* work_req, int status) {
         }
         break;
       }
+      case kI2cOpTransfer: {
+        if (req_data->error == kI2cErrTransfer) {
+          iotjs_jval_t error =
+              iotjs_jval_create_error("Cannot transfer with device");
+          iotjs_jargs_append_jval(&jargs, &error);
+          iotjs_jval_destroy(&error);
+        } else {
+          iotjs_jargs_append_null(&jargs);
+          iotjs_jval_t jbuffer = CreateI2cTransferResult(req_data);
+          iotjs_jargs_append_jval(&jargs, &jbuffer);
+          iotjs_jval_destroy(&jbuffer);
+        }
+        ReleaseI2cTransfer(req_data);
+        break;
+      }
       default: {
         IOTJS_ASSERT(!"Unreachable");
         break;
@@ -165,7 +266,8 @@ void AfterI2CWork(uv_work_t* work_req, int status) {
   }
 
   const iotjs_jval_t* jcallback = iotjs_i2c_reqwrap_jcallback(req_wrap);
-  iotjs_make_callback(jcallback, iotjs_jval_get_undefined(), &jargs);
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, jcallback,
+                              iotjs_jval_get_undefined(), &jargs);
 
   iotjs_jargs_destroy(&jargs);
   iotjs_i2c_reqwrap_dispatched(req_wrap);
@@ -191,11 +293,34 @@ static void GetI2cArray(const iotjs_jval_t* jarray,
   iotjs_jval_destroy(&jlength);
 }
 
-#define I2C_ASYNC(op)                                                  \
-  do {                                                                 \
-    uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get()); \
-    uv_work_t* req = iotjs_i2c_reqwrap_req(req_wrap);                  \
-    uv_queue_work(loop, req, op##Worker, AfterI2CWork);                \
+static void WriteWorker(uv_work_t* work_req) {
+  iotjs_i2c_reqwrap_t* req_wrap = iotjs_i2c_reqwrap_from_request(work_req);
+  I2cWrite(iotjs_i2c_instance_from_reqwrap(req_wrap),
+           iotjs_i2c_reqwrap_data(req_wrap));
+}
+
+static void ReadWorker(uv_work_t* work_req) {
+  iotjs_i2c_reqwrap_t* req_wrap = iotjs_i2c_reqwrap_from_request(work_req);
+  I2cRead(iotjs_i2c_instance_from_reqwrap(req_wrap),
+          iotjs_i2c_reqwrap_data(req_wrap));
+}
+
+static void TransferWorker(uv_work_t* work_req) {
+  iotjs_i2c_reqwrap_t* req_wrap = iotjs_i2c_reqwrap_from_request(work_req);
+  I2cTransfer(iotjs_i2c_instance_from_reqwrap(req_wrap),
+              iotjs_i2c_reqwrap_data(req_wrap));
+}
+
+static iotjs_busqueue_t* iotjs_i2c_bus_queue(iotjs_i2c_t* i2c) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_i2c_t, i2c);
+  return _this->bus_queue;
+}
+
+#define I2C_ASYNC(op)                                              \
+  do {                                                             \
+    iotjs_bus_work_t* req = iotjs_i2c_reqwrap_req(req_wrap);       \
+    iotjs_busqueue_work(iotjs_i2c_bus_queue(i2c), req, op##Worker, \
+                        AfterI2CWork);                             \
   } while (0)
 
 JHANDLER_FUNCTION(I2cCons) {
@@ -235,37 +360,127 @@ JHANDLER_FUNCTION(Close) {
 
 JHANDLER_FUNCTION(Write) {
   JHANDLER_DECLARE_THIS_PTR(i2c, i2c);
-  DJHANDLER_CHECK_ARGS(2, array, function);
+  DJHANDLER_CHECK_ARGS(1, array);
+  DJHANDLER_CHECK_ARG_IF_EXIST(1, function);
 
-  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG(1, function);
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
-  iotjs_i2c_reqwrap_t* req_wrap =
-      iotjs_i2c_reqwrap_create(jcallback, i2c, kI2cOpWrite);
-  iotjs_i2c_reqdata_t* req_data = iotjs_i2c_reqwrap_data(req_wrap);
+  if (jcallback) {
+    iotjs_i2c_reqwrap_t* req_wrap =
+        iotjs_i2c_reqwrap_create(jcallback, i2c, kI2cOpWrite);
+    iotjs_i2c_reqdata_t* req_data = iotjs_i2c_reqwrap_data(req_wrap);
 
-  GetI2cArray(JHANDLER_GET_ARG(0, array), req_data);
+    GetI2cArray(JHANDLER_GET_ARG(0, array), req_data);
 
-  I2C_ASYNC(Write);
+    I2C_ASYNC(Write);
+  } else {
+    iotjs_i2c_reqdata_t req_data;
+    memset(&req_data, 0, sizeof(req_data));
+    req_data.op = kI2cOpWrite;
+
+    GetI2cArray(JHANDLER_GET_ARG(0, array), &req_data);
+
+    I2cWrite(i2c, &req_data);
+    if (req_data.error != kI2cErrOk) {
+      JHANDLER_THROW(COMMON, "I2C WriteSync Error");
+      return;
+    }
+  }
 
   iotjs_jhandler_return_null(jhandler);
 }
 
 JHANDLER_FUNCTION(Read) {
   JHANDLER_DECLARE_THIS_PTR(i2c, i2c);
-  DJHANDLER_CHECK_ARGS(2, number, function);
+  DJHANDLER_CHECK_ARGS(1, number);
+  DJHANDLER_CHECK_ARG_IF_EXIST(1, function);
 
-  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG(1, function);
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
-  iotjs_i2c_reqwrap_t* req_wrap =
-      iotjs_i2c_reqwrap_create(jcallback, i2c, kI2cOpRead);
+  if (jcallback) {
+    iotjs_i2c_reqwrap_t* req_wrap =
+        iotjs_i2c_reqwrap_create(jcallback, i2c, kI2cOpRead);
 
-  iotjs_i2c_reqdata_t* req_data = iotjs_i2c_reqwrap_data(req_wrap);
-  req_data->buf_len = JHANDLER_GET_ARG(0, number);
-  req_data->delay = 0;
+    iotjs_i2c_reqdata_t* req_data = iotjs_i2c_reqwrap_data(req_wrap);
+    req_data->buf_len = JHANDLER_GET_ARG(0, number);
+    req_data->delay = 0;
 
-  I2C_ASYNC(Read);
+    I2C_ASYNC(Read);
 
-  iotjs_jhandler_return_null(jhandler);
+    iotjs_jhandler_return_null(jhandler);
+  } else {
+    iotjs_i2c_reqdata_t req_data;
+    memset(&req_data, 0, sizeof(req_data));
+    req_data.op = kI2cOpRead;
+    req_data.buf_len = JHANDLER_GET_ARG(0, number);
+
+    I2cRead(i2c, &req_data);
+    if (req_data.error != kI2cErrOk) {
+      if (req_data.buf_data != NULL) {
+        iotjs_buffer_release(req_data.buf_data);
+      }
+      JHANDLER_THROW(COMMON, "I2C ReadSync Error");
+      return;
+    }
+
+    iotjs_jval_t result =
+        iotjs_jval_create_byte_array(req_data.buf_len, req_data.buf_data);
+    iotjs_buffer_release(req_data.buf_data);
+
+    iotjs_jhandler_return_jval(jhandler, &result);
+    iotjs_jval_destroy(&result);
+  }
+}
+
+// transfer(msgs, data[, callback])
+// Runs the messages described by `msgs` in one transaction. The bytes read
+// are returned, or passed to the callback, as one Buffer.
+JHANDLER_FUNCTION(Transfer) {
+  JHANDLER_DECLARE_THIS_PTR(i2c, i2c);
+  DJHANDLER_CHECK_ARGS(2, array, object);
+  DJHANDLER_CHECK_ARG_IF_EXIST(2, function);
+
+  const iotjs_jval_t* jmsgs = JHANDLER_GET_ARG(0, array);
+  const iotjs_jval_t* jdata = JHANDLER_GET_ARG(1, object);
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(2, function);
+
+  if (jcallback) {
+    iotjs_i2c_reqwrap_t* req_wrap =
+        iotjs_i2c_reqwrap_create(jcallback, i2c, kI2cOpTransfer);
+    iotjs_i2c_reqdata_t* req_data = iotjs_i2c_reqwrap_data(req_wrap);
+
+    if (!GetI2cTransfer(jmsgs, jdata, req_data)) {
+      iotjs_i2c_reqwrap_dispatched(req_wrap);
+      JHANDLER_THROW(TYPE, "Bad arguments - messages");
+      return;
+    }
+
+    I2C_ASYNC(Transfer);
+
+    iotjs_jhandler_return_null(jhandler);
+  } else {
+    iotjs_i2c_reqdata_t req_data;
+    memset(&req_data, 0, sizeof(req_data));
+    req_data.op = kI2cOpTransfer;
+
+    if (!GetI2cTransfer(jmsgs, jdata, &req_data)) {
+      JHANDLER_THROW(TYPE, "Bad arguments - messages");
+      return;
+    }
+
+    I2cTransfer(i2c, &req_data);
+    if (req_data.error != kI2cErrOk) {
+      ReleaseI2cTransfer(&req_data);
+      JHANDLER_THROW(COMMON, "I2C TransferSync Error");
+      return;
+    }
+
+    iotjs_jval_t jbuffer = CreateI2cTransferResult(&req_data);
+    ReleaseI2cTransfer(&req_data);
+
+    iotjs_jhandler_return_jval(jhandler, &jbuffer);
+    iotjs_jval_destroy(&jbuffer);
+  }
 }
 
 iotjs_jval_t InitI2c() {
@@ -277,6 +492,7 @@ iotjs_jval_t InitI2c() {
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_CLOSE, Close);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITE, Write);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READ, Read);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_TRANSFER, Transfer);
 
   iotjs_jval_set_property_jval(&jI2cCons, IOTJS_MAGIC_STRING_PROTOTYPE,
                                &prototype);
@@ -18,6 +18,7 @@
 #define IOTJS_MODULE_I2C_H
 
 #include "iotjs_def.h"
+#include "iotjs_busqueue.h"
 #include "iotjs_objectwrap.h"
 #include "iotjs_reqwrap.h"
 
@@ -27,6 +28,7 @@ typedef enum {
   kI2cOpClose,
   kI2cOpWrite,
   kI2cOpRead,
+  kI2cOpTransfer,
 } I2cOp;
 
 typedef enum {
@@ -34,8 +36,21 @@ typedef enum {
   kI2cErrOpen = -1,
   kI2cErrRead = -2,
   kI2cErrWrite = -3,
+  kI2cErrTransfer = -4,
 } I2cError;
 
+// The most messages of one transfer, as Linux allows for I2C_RDWR.
+#define IOTJS_I2C_TRANSFER_MSGS_MAX 42
+
+// A message of a transfer: `length` bytes written to or read from the device
+// at `address`, starting with a repeated start condition but the first.
+typedef struct {
+  uint16_t address;
+  bool read;
+  uint16_t length;
+  uint8_t* data;
+} iotjs_i2c_msg_t;
+
 typedef struct {
   char* buf_data;
   uint8_t buf_len;
@@ -43,6 +58,13 @@ typedef struct {
   uint8_t cmd;
   int32_t delay;
 
+  // The messages of a transfer. Their data is one allocation, which starts with
+  // the `read_len` bytes of all reads, returned as one Buffer.
+  iotjs_i2c_msg_t* msgs;
+  uint8_t msg_count;
+  char* transfer_data;
+  size_t read_len;
+
   I2cOp op;
   I2cError error;
 } iotjs_i2c_reqdata_t;
@@ -54,11 +76,14 @@ typedef struct iotjs_i2c_platform_data_s iotjs_i2c_platform_data_t;
 typedef struct {
   iotjs_jobjectwrap_t jobjectwrap;
   iotjs_i2c_platform_data_t* platform_data;
+  // The queue of the bus of the device, set by the platform where the bus
+  // has a name. Otherwise the requests go to the threadpool.
+  iotjs_busqueue_t* bus_queue;
 } IOTJS_VALIDATED_STRUCT(iotjs_i2c_t);
 
 typedef struct {
   iotjs_reqwrap_t reqwrap;
-  uv_work_t req;
+  iotjs_bus_work_t req;
   iotjs_i2c_reqdata_t req_data;
   iotjs_i2c_t* i2c_data;
 } IOTJS_VALIDATED_STRUCT(iotjs_i2c_reqwrap_t);
@@ -68,7 +93,7 @@ iotjs_i2c_t* iotjs_i2c_instance_from_jval(const iotjs_jval_t* ji2c);
 iotjs_i2c_reqwrap_t* iotjs_i2c_reqwrap_from_request(uv_work_t* req);
 #define THIS iotjs_i2c_reqwrap_t* i2c_reqwrap
 void iotjs_i2c_reqwrap_dispatched(THIS);
-uv_work_t* iotjs_i2c_reqwrap_req(THIS);
+iotjs_bus_work_t* iotjs_i2c_reqwrap_req(THIS);
 const iotjs_jval_t* iotjs_i2c_reqwrap_jcallback(THIS);
 iotjs_i2c_reqdata_t* iotjs_i2c_reqwrap_data(THIS);
 iotjs_i2c_t* iotjs_i2c_instance_from_reqwrap(THIS);
@@ -77,8 +102,13 @@ iotjs_i2c_t* iotjs_i2c_instance_from_reqwrap(THIS);
 void I2cSetAddress(iotjs_i2c_t* i2c, uint8_t address);
 void OpenWorker(uv_work_t* work_req);
 void I2cClose(iotjs_i2c_t* i2c);
-void WriteWorker(uv_work_t* work_req);
-void ReadWorker(uv_work_t* work_req);
+// Write and read `req_data->buf_len` bytes, on the loop thread or in the
+// threadpool. I2cWrite releases `buf_data`, and I2cRead allocates it.
+void I2cWrite(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data);
+void I2cRead(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data);
+// Runs the messages of `req_data` as one combined transaction where the
+// platform can, or one after another.
+void I2cTransfer(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data);
 
 // Platform-related functions; they are implemented
 // by platform code (i.e.: linux, nuttx, tizen).
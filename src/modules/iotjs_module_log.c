@@ -0,0 +1,561 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "iotjs_def.h"
+#include "iotjs_exception.h"
+#include "iotjs_module_log.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/time.h>
+
+#if !defined(__NUTTX__) && !defined(__TIZENRT__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define IOTJS_LOG_MMAP 1
+#endif
+
+
+// The log is a ring of binary records, which hold the id of a format, the
+// time and the raw values of the arguments. Nothing is formatted when a
+// record is written: the records are formatted when the log is flushed, or
+// by tools/log_decode.py from a log file mapped with mmap(). The header,
+// the format strings and the ring are laid out in one block of memory, so
+// that a log file holds everything needed to decode it, and what was
+// written before a crash can be read when the file is opened again.
+
+
+#define IOTJS_LOG_MAGIC "IOTJSLOG"
+#define IOTJS_LOG_VERSION 1
+
+// Bytes of a record, header included. Longer strings are truncated.
+#define IOTJS_LOG_MAX_RECORD 1024
+// length(2) format(2) argc(1) time(8)
+#define IOTJS_LOG_RECORD_HEADER 13
+#define IOTJS_LOG_MIN_SIZE IOTJS_LOG_MAX_RECORD
+
+
+typedef enum {
+  IOTJS_LOG_UNDEFINED = 0,
+  IOTJS_LOG_NULL = 1,
+  IOTJS_LOG_FALSE = 2,
+  IOTJS_LOG_TRUE = 3,
+  IOTJS_LOG_NUMBER = 4,
+  IOTJS_LOG_STRING = 5,
+} iotjs_log_type_t;
+
+
+// All fields are 32 bits wide, in the byte order of the device. The ring
+// holds the records in [head, tail), or in [head, end) and then [0, tail)
+// when it is wrapped.
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t formats_size;
+  uint32_t formats_used;
+  uint32_t format_count;
+  uint32_t ring_size;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t end;
+  uint32_t wrapped;
+  uint32_t count;
+  uint32_t overwritten;
+} iotjs_log_header_t;
+
+
+static iotjs_log_header_t* iotjs_log = NULL;
+static size_t iotjs_log_mapped = 0;
+
+// The record times are the wall clock at open() advanced by the monotonic
+// clock, which is cheaper to read.
+static uint64_t iotjs_log_base_us;
+static uint64_t iotjs_log_base_hrtime;
+
+
+static char* iotjs_log_formats() {
+  return (char*)(iotjs_log + 1);
+}
+
+
+static uint8_t* iotjs_log_ring() {
+  return (uint8_t*)iotjs_log_formats() + iotjs_log->formats_size;
+}
+
+
+static uint16_t iotjs_log_record_length(uint32_t offset) {
+  uint16_t length;
+  memcpy(&length, iotjs_log_ring() + offset, sizeof(length));
+  return length;
+}
+
+
+static void iotjs_log_init_header(iotjs_log_header_t* header,
+                                  uint32_t formats_size, uint32_t ring_size) {
+  memset(header, 0, sizeof(*header));
+  memcpy(header->magic, IOTJS_LOG_MAGIC, sizeof(header->magic));
+  header->version = IOTJS_LOG_VERSION;
+  header->formats_size = formats_size;
+  header->ring_size = ring_size;
+}
+
+
+// Checks that the header of a mapped file is of a log of the same sizes,
+// whose records can be kept.
+static bool iotjs_log_header_is_valid(const iotjs_log_header_t* header,
+                                      uint32_t formats_size,
+                                      uint32_t ring_size) {
+  return memcmp(header->magic, IOTJS_LOG_MAGIC, sizeof(header->magic)) == 0 &&
+         header->version == IOTJS_LOG_VERSION &&
+         header->formats_size == formats_size &&
+         header->ring_size == ring_size &&
+         header->formats_used <= formats_size && header->head < ring_size &&
+         header->tail <= ring_size && header->end <= ring_size;
+}
+
+
+static uint64_t iotjs_log_now_us() {
+  return iotjs_log_base_us + (uv_hrtime() - iotjs_log_base_hrtime) / 1000;
+}
+
+
+// Returns the offset of `length` free bytes at the tail of the ring, which
+// the oldest records are overwritten to make.
+static uint32_t iotjs_log_reserve(uint32_t length) {
+  iotjs_log_header_t* log = iotjs_log;
+  for (;;) {
+    if (log->count == 0) {
+      log->head = log->tail = log->end = log->wrapped = 0;
+    }
+
+    if (!log->wrapped) {
+      if (log->tail + length <= log->ring_size) {
+        return log->tail;
+      }
+      log->end = log->tail;
+      log->tail = 0;
+      log->wrapped = 1;
+    }
+
+    if (log->tail + length <= log->head) {
+      return log->tail;
+    }
+
+    uint16_t record_length = iotjs_log_record_length(log->head);
+    if (record_length < IOTJS_LOG_RECORD_HEADER) {
+      // A damaged file; its records are dropped.
+      log->count = 0;
+      continue;
+    }
+    log->head += record_length;
+    log->count--;
+    log->overwritten++;
+    if (log->head >= log->end) {
+      // The records before the wrap are all gone.
+      log->head = 0;
+      log->end = 0;
+      log->wrapped = 0;
+    }
+  }
+}
+
+
+static void iotjs_log_release_memory() {
+  if (iotjs_log == NULL) {
+    return;
+  }
+#ifdef IOTJS_LOG_MMAP
+  if (iotjs_log_mapped > 0) {
+    msync(iotjs_log, iotjs_log_mapped, MS_ASYNC);
+    munmap(iotjs_log, iotjs_log_mapped);
+    iotjs_log_mapped = 0;
+    iotjs_log = NULL;
+    return;
+  }
+#endif
+  iotjs_buffer_release((char*)iotjs_log);
+  iotjs_log = NULL;
+}
+
+
+void iotjs_log_release() {
+  iotjs_log_release_memory();
+}
+
+
+// Appends an argument to a record being built, and returns its new length.
+static size_t iotjs_log_append_arg(uint8_t* record, size_t length,
+                                   const iotjs_jval_t* jval) {
+  size_t room = IOTJS_LOG_MAX_RECORD - length;
+  if (room < 1 + sizeof(double)) {
+    return length;
+  }
+
+  if (iotjs_jval_is_undefined(jval)) {
+    record[length] = IOTJS_LOG_UNDEFINED;
+    return length + 1;
+  } else if (iotjs_jval_is_null(jval)) {
+    record[length] = IOTJS_LOG_NULL;
+    return length + 1;
+  } else if (iotjs_jval_is_boolean(jval)) {
+    record[length] =
+        iotjs_jval_as_boolean(jval) ? IOTJS_LOG_TRUE : IOTJS_LOG_FALSE;
+    return length + 1;
+  } else if (iotjs_jval_is_number(jval)) {
+    double value = iotjs_jval_as_number(jval);
+    record[length] = IOTJS_LOG_NUMBER;
+    memcpy(record + length + 1, &value, sizeof(value));
+    return length + 1 + sizeof(value);
+  }
+
+  // Other values are recorded as String() gives them.
+  bool throws = false;
+  iotjs_jval_t jstr = iotjs_jval_is_string(jval)
+                          ? iotjs_jval_create_copied(jval)
+                          : iotjs_jval_to_string(jval, &throws);
+  if (throws) {
+    iotjs_jval_destroy(&jstr);
+    record[length] = IOTJS_LOG_UNDEFINED;
+    return length + 1;
+  }
+
+  uint8_t* data = record + length + 1 + sizeof(uint16_t);
+  size_t max = room - 1 - sizeof(uint16_t);
+  size_t size = iotjs_jval_string_size(&jstr);
+  if (size <= max) {
+    iotjs_jval_copy_string(&jstr, (char*)data, size);
+  } else {
+    iotjs_string_t str = iotjs_jval_as_string(&jstr);
+    // Truncated where a character starts.
+    size = max;
+    while (size > 0 &&
+           ((uint8_t)iotjs_string_data(&str)[size] & 0xc0) == 0x80) {
+      size--;
+    }
+    memcpy(data, iotjs_string_data(&str), size);
+    iotjs_string_destroy(&str);
+  }
+  iotjs_jval_destroy(&jstr);
+
+  uint16_t size16 = (uint16_t)size;
+  record[length] = IOTJS_LOG_STRING;
+  memcpy(record + length + 1, &size16, sizeof(size16));
+  return length + 1 + sizeof(size16) + size;
+}
+
+
+// Opens a log of `size` bytes of records and `formatsSize` bytes of format
+// strings, in memory or in the file at `path`. The records of a file of the
+// same sizes are kept.
+JHANDLER_FUNCTION(Open) {
+  DJHANDLER_CHECK_ARGS(3, number, number, string);
+
+  double ring_size = JHANDLER_GET_ARG(0, number);
+  double formats_size = JHANDLER_GET_ARG(1, number);
+  iotjs_string_t path = JHANDLER_GET_ARG(2, string);
+
+  if (ring_size < IOTJS_LOG_MIN_SIZE || ring_size > UINT32_MAX / 2 ||
+      formats_size < 0 || formats_size > UINT32_MAX / 2) {
+    iotjs_string_destroy(&path);
+    JHANDLER_THROW(RANGE, "Invalid log size");
+    return;
+  }
+
+  iotjs_log_release_memory();
+
+  uint32_t ring = (uint32_t)ring_size;
+  uint32_t formats = (uint32_t)formats_size;
+  size_t total = sizeof(iotjs_log_header_t) + formats + ring;
+
+  if (iotjs_string_is_empty(&path)) {
+    iotjs_log = (iotjs_log_header_t*)iotjs_buffer_allocate(total);
+    iotjs_log_init_header(iotjs_log, formats, ring);
+  } else {
+#ifdef IOTJS_LOG_MMAP
+    int err = 0;
+    int fd = open(iotjs_string_data(&path), O_RDWR | O_CREAT, 0666);
+    if (fd < 0 || ftruncate(fd, (off_t)total) != 0) {
+      err = -errno;
+    } else {
+      void* data =
+          mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (data == MAP_FAILED) {
+        err = -errno;
+      } else {
+        iotjs_log = (iotjs_log_header_t*)data;
+        iotjs_log_mapped = total;
+        if (!iotjs_log_header_is_valid(iotjs_log, formats, ring)) {
+          iotjs_log_init_header(iotjs_log, formats, ring);
+        }
+      }
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+
+    if (err != 0) {
+      iotjs_string_destroy(&path);
+      iotjs_jval_t jerror = iotjs_create_uv_exception(err, "open");
+      iotjs_jhandler_throw(jhandler, &jerror);
+      iotjs_jval_destroy(&jerror);
+      return;
+    }
+#else
+    iotjs_string_destroy(&path);
+    JHANDLER_THROW(COMMON, "Log files are not supported on this platform");
+    return;
+#endif
+  }
+
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  iotjs_log_base_us = (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_usec;
+  iotjs_log_base_hrtime = uv_hrtime();
+
+  iotjs_string_destroy(&path);
+}
+
+
+JHANDLER_FUNCTION(Close) {
+  iotjs_log_release_memory();
+}
+
+
+// Adds a format string, and returns its id.
+JHANDLER_FUNCTION(AddFormat) {
+  DJHANDLER_CHECK_ARGS(1, string);
+  JHANDLER_CHECK(iotjs_log != NULL);
+
+  iotjs_string_t format = JHANDLER_GET_ARG(0, string);
+  size_t size = iotjs_string_size(&format) + 1;
+
+  if (iotjs_log->formats_used + size > iotjs_log->formats_size ||
+      iotjs_log->format_count >= UINT16_MAX) {
+    iotjs_string_destroy(&format);
+    JHANDLER_THROW(RANGE, "No room for more log formats");
+    return;
+  }
+
+  memcpy(iotjs_log_formats() + iotjs_log->formats_used,
+         iotjs_string_data(&format), size);
+  iotjs_log->formats_used += size;
+  iotjs_string_destroy(&format);
+
+  iotjs_jhandler_return_number(jhandler, iotjs_log->format_count++);
+}
+
+
+// Returns the format strings by id, those of an opened file included.
+JHANDLER_FUNCTION(Formats) {
+  JHANDLER_CHECK(iotjs_log != NULL);
+
+  iotjs_jval_t jformats = iotjs_jval_create_array(iotjs_log->format_count);
+  const char* format = iotjs_log_formats();
+  const char* end = format + iotjs_log->formats_used;
+  for (uint32_t i = 0; i < iotjs_log->format_count && format < end; i++) {
+    size_t size = strnlen(format, (size_t)(end - format));
+    iotjs_jval_t jformat = iotjs_jval_create_string_sz(format, size);
+    iotjs_jval_set_property_by_index(&jformats, i, &jformat);
+    iotjs_jval_destroy(&jformat);
+    format += size + 1;
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jformats);
+  iotjs_jval_destroy(&jformats);
+}
+
+
+// Records the format id and the arguments after it. Does nothing while the
+// log is closed.
+JHANDLER_FUNCTION(Write) {
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  if (iotjs_log == NULL) {
+    return;
+  }
+
+  uint8_t record[IOTJS_LOG_MAX_RECORD];
+  uint16_t format = (uint16_t)JHANDLER_GET_ARG(0, number);
+  uint64_t time = iotjs_log_now_us();
+  memcpy(record + 2, &format, sizeof(format));
+  memcpy(record + 5, &time, sizeof(time));
+
+  size_t length = IOTJS_LOG_RECORD_HEADER;
+  uint16_t argc = iotjs_jhandler_get_arg_length(jhandler);
+  uint8_t count = 0;
+  for (uint16_t i = 1; i < argc && count < UINT8_MAX; i++) {
+    const iotjs_jval_t* jarg = iotjs_jhandler_get_arg(jhandler, i);
+    size_t next = iotjs_log_append_arg(record, length, jarg);
+    if (next == length) {
+      break;
+    }
+    length = next;
+    count++;
+  }
+
+  uint16_t length16 = (uint16_t)length;
+  memcpy(record, &length16, sizeof(length16));
+  record[4] = count;
+
+  // The header counts the record only once it is whole.
+  uint32_t offset = iotjs_log_reserve((uint32_t)length);
+  memcpy(iotjs_log_ring() + offset, record, length);
+  iotjs_log->tail = offset + (uint32_t)length;
+  iotjs_log->count++;
+}
+
+
+static iotjs_jval_t iotjs_log_read_record(uint32_t offset) {
+  const uint8_t* record = iotjs_log_ring() + offset;
+  uint16_t length;
+  uint16_t format;
+  uint64_t time;
+  memcpy(&length, record, sizeof(length));
+  memcpy(&format, record + 2, sizeof(format));
+  memcpy(&time, record + 5, sizeof(time));
+  uint8_t argc = record[4];
+
+  iotjs_jval_t jrecord = iotjs_jval_create_array(2 + (uint32_t)argc);
+  iotjs_jval_t jformat = iotjs_jval_create_number(format);
+  iotjs_jval_t jtime = iotjs_jval_create_number((double)time / 1000);
+  iotjs_jval_set_property_by_index(&jrecord, 0, &jformat);
+  iotjs_jval_set_property_by_index(&jrecord, 1, &jtime);
+  iotjs_jval_destroy(&jformat);
+  iotjs_jval_destroy(&jtime);
+
+  size_t pos = IOTJS_LOG_RECORD_HEADER;
+  for (uint32_t i = 0; i < argc && pos < length; i++) {
+    iotjs_jval_t jarg;
+    switch (record[pos++]) {
+      case IOTJS_LOG_NULL:
+        jarg = iotjs_jval_create_copied(iotjs_jval_get_null());
+        break;
+      case IOTJS_LOG_FALSE:
+      case IOTJS_LOG_TRUE:
+        jarg = iotjs_jval_create_copied(
+            iotjs_jval_get_boolean(record[pos - 1] == IOTJS_LOG_TRUE));
+        break;
+      case IOTJS_LOG_NUMBER: {
+        double value;
+        memcpy(&value, record + pos, sizeof(value));
+        pos += sizeof(value);
+        jarg = iotjs_jval_create_number(value);
+        break;
+      }
+      case IOTJS_LOG_STRING: {
+        uint16_t size;
+        memcpy(&size, record + pos, sizeof(size));
+        pos += sizeof(size);
+        if (pos + size > length) {
+          size = 0;
+        }
+        jarg = iotjs_jval_create_string_sz((const char*)record + pos, size);
+        pos += size;
+        break;
+      }
+      default:
+        jarg = iotjs_jval_create_copied(iotjs_jval_get_undefined());
+        break;
+    }
+    iotjs_jval_set_property_by_index(&jrecord, 2 + i, &jarg);
+    iotjs_jval_destroy(&jarg);
+  }
+
+  return jrecord;
+}
+
+
+// Returns the records, oldest first, as arrays of the format id, the time
+// in milliseconds and the arguments.
+JHANDLER_FUNCTION(Read) {
+  JHANDLER_CHECK(iotjs_log != NULL);
+
+  iotjs_log_header_t* log = iotjs_log;
+  iotjs_jval_t jrecords = iotjs_jval_create_array(log->count);
+
+  uint32_t offset = log->head;
+  uint32_t end = log->wrapped ? log->end : log->tail;
+  bool wrapped = log->wrapped;
+  for (uint32_t i = 0; i < log->count; i++) {
+    if (offset >= end && wrapped) {
+      offset = 0;
+      end = log->tail;
+      wrapped = false;
+    }
+    if (offset + IOTJS_LOG_RECORD_HEADER > end) {
+      break;
+    }
+    uint16_t length = iotjs_log_record_length(offset);
+    if (length < IOTJS_LOG_RECORD_HEADER || offset + length > end) {
+      // A damaged file.
+      break;
+    }
+
+    iotjs_jval_t jrecord = iotjs_log_read_record(offset);
+    iotjs_jval_set_property_by_index(&jrecords, i, &jrecord);
+    iotjs_jval_destroy(&jrecord);
+    offset += length;
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jrecords);
+  iotjs_jval_destroy(&jrecords);
+}
+
+
+JHANDLER_FUNCTION(Clear) {
+  if (iotjs_log != NULL) {
+    iotjs_log->count = 0;
+    iotjs_log->head = iotjs_log->tail = iotjs_log->end = 0;
+    iotjs_log->wrapped = 0;
+  }
+}
+
+
+JHANDLER_FUNCTION(Stats) {
+  JHANDLER_CHECK(iotjs_log != NULL);
+
+  iotjs_log_header_t* log = iotjs_log;
+  uint32_t used = log->wrapped ? log->end - log->head + log->tail
+                               : log->tail - log->head;
+
+  iotjs_jval_t jstats = iotjs_jval_create_object();
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_COUNT,
+                                 log->count);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_SIZE,
+                                 log->ring_size);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_USED, used);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_OVERWRITTEN,
+                                 log->overwritten);
+
+  iotjs_jhandler_return_jval(jhandler, &jstats);
+  iotjs_jval_destroy(&jstats);
+}
+
+
+iotjs_jval_t InitLog() {
+  iotjs_jval_t log = iotjs_jval_create_object();
+
+  iotjs_jval_set_method(&log, IOTJS_MAGIC_STRING_ADDFORMAT, AddFormat);
+  iotjs_jval_set_method(&log, IOTJS_MAGIC_STRING_CLEAR, Clear);
+  iotjs_jval_set_method(&log, IOTJS_MAGIC_STRING_CLOSE, Close);
+  iotjs_jval_set_method(&log, IOTJS_MAGIC_STRING_FORMATS, Formats);
+  iotjs_jval_set_method(&log, IOTJS_MAGIC_STRING_OPEN, Open);
+  iotjs_jval_set_method(&log, IOTJS_MAGIC_STRING_READ, Read);
+  iotjs_jval_set_method(&log, IOTJS_MAGIC_STRING_STATS, Stats);
+  iotjs_jval_set_method(&log, IOTJS_MAGIC_STRING_WRITE, Write);
+
+  return log;
+}
@@ -0,0 +1,431 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "iotjs_def.h"
+#include "iotjs_objectwrap.h"
+
+#include <math.h>
+#include <string.h>
+
+
+// The largest value a histogram tracks, so that the shifts of the bucket
+// math stay within 63 bits.
+#define IOTJS_HISTOGRAM_MAX_VALUE 4611686018427387903.0
+
+#define IOTJS_HISTOGRAM_MAX_FIGURES 5
+
+
+// A histogram of the HdrHistogram layout: the values are counted in buckets
+// of a relative precision of `figures` significant decimal digits, whose
+// counts are allocated once, as the histogram is created. Values above the
+// highest trackable one are only counted as exceeding.
+typedef struct {
+  iotjs_jobjectwrap_t jobjectwrap;
+
+  int64_t lowest;
+  int64_t highest;
+  uint32_t figures;
+
+  uint32_t unit_magnitude;
+  uint32_t sub_bucket_half_count_magnitude;
+  int64_t sub_bucket_count;
+  int64_t sub_bucket_half_count;
+  int64_t sub_bucket_mask;
+  uint32_t bucket_count;
+  uint32_t counts_len;
+  uint32_t* counts;
+
+  uint64_t total_count;
+  uint64_t exceeds;
+  int64_t min;
+  int64_t max;
+
+  // The uv_hrtime() of the last recordDelta(), 0 before the first one.
+  uint64_t prev_hrtime;
+} IOTJS_VALIDATED_STRUCT(iotjs_histogramwrap_t);
+
+
+IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(histogramwrap);
+
+
+// The index of the highest set bit of a non-zero value.
+static uint32_t iotjs_histogram_log2(uint64_t value) {
+  uint32_t bit = 0;
+  while (value >>= 1) {
+    bit++;
+  }
+  return bit;
+}
+
+
+static iotjs_histogramwrap_t* iotjs_histogramwrap_create(
+    const iotjs_jval_t* jhistogram, int64_t lowest, int64_t highest,
+    uint32_t figures) {
+  iotjs_histogramwrap_t* wrap = IOTJS_ALLOC(iotjs_histogramwrap_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_histogramwrap_t, wrap);
+
+  iotjs_jobjectwrap_initialize(&_this->jobjectwrap, jhistogram,
+                               &this_module_native_info);
+
+  _this->lowest = lowest;
+  _this->highest = highest;
+  _this->figures = figures;
+
+  // Values below 2 * 10^figures are counted one by one in the first bucket,
+  // and each later bucket is twice as wide and as coarse as the one before.
+  int64_t single_unit_limit = 2;
+  for (uint32_t i = 0; i < figures; i++) {
+    single_unit_limit *= 10;
+  }
+  uint32_t sub_bucket_count_magnitude =
+      iotjs_histogram_log2((uint64_t)single_unit_limit - 1) + 1;
+
+  _this->sub_bucket_half_count_magnitude = sub_bucket_count_magnitude - 1;
+  _this->unit_magnitude = iotjs_histogram_log2((uint64_t)lowest);
+  _this->sub_bucket_count = (int64_t)1 << sub_bucket_count_magnitude;
+  _this->sub_bucket_half_count = _this->sub_bucket_count / 2;
+  _this->sub_bucket_mask = (_this->sub_bucket_count - 1)
+                           << _this->unit_magnitude;
+
+  int64_t smallest_untrackable = _this->sub_bucket_count
+                                 << _this->unit_magnitude;
+  uint32_t bucket_count = 1;
+  while (smallest_untrackable <= highest) {
+    if (smallest_untrackable > INT64_MAX / 2) {
+      bucket_count++;
+      break;
+    }
+    smallest_untrackable <<= 1;
+    bucket_count++;
+  }
+  _this->bucket_count = bucket_count;
+  _this->counts_len =
+      (bucket_count + 1) * (uint32_t)_this->sub_bucket_half_count;
+  _this->counts = (uint32_t*)iotjs_buffer_allocate(_this->counts_len *
+                                                   sizeof(uint32_t));
+
+  return wrap;
+}
+
+
+static void iotjs_histogramwrap_destroy(iotjs_histogramwrap_t* wrap) {
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_histogramwrap_t, wrap);
+  iotjs_buffer_release((char*)_this->counts);
+  iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
+  IOTJS_RELEASE(wrap);
+}
+
+
+static uint32_t iotjs_histogram_bucket_index(iotjs_histogramwrap_t* wrap,
+                                             int64_t value) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+  uint32_t pow2ceiling =
+      iotjs_histogram_log2((uint64_t)(value | _this->sub_bucket_mask)) + 1;
+  return pow2ceiling - _this->unit_magnitude -
+         (_this->sub_bucket_half_count_magnitude + 1);
+}
+
+
+static uint32_t iotjs_histogram_counts_index(iotjs_histogramwrap_t* wrap,
+                                             int64_t value) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+  uint32_t bucket_index = iotjs_histogram_bucket_index(wrap, value);
+  int64_t sub_bucket_index = value >> (bucket_index + _this->unit_magnitude);
+  int64_t bucket_base_index = (int64_t)(bucket_index + 1)
+                              << _this->sub_bucket_half_count_magnitude;
+  return (uint32_t)(bucket_base_index + sub_bucket_index -
+                    _this->sub_bucket_half_count);
+}
+
+
+// The lowest value counted at an index of the counts.
+static int64_t iotjs_histogram_value_at_index(iotjs_histogramwrap_t* wrap,
+                                              uint32_t index) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+  uint32_t bucket_index = index >> _this->sub_bucket_half_count_magnitude;
+  int64_t sub_bucket_index = (index & (_this->sub_bucket_half_count - 1)) +
+                             _this->sub_bucket_half_count;
+  if (bucket_index == 0) {
+    sub_bucket_index -= _this->sub_bucket_half_count;
+  } else {
+    bucket_index--;
+  }
+  return sub_bucket_index << (bucket_index + _this->unit_magnitude);
+}
+
+
+// The count of the values that share the index of a value.
+static int64_t iotjs_histogram_range_size(iotjs_histogramwrap_t* wrap,
+                                          int64_t value) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+  uint32_t bucket_index = iotjs_histogram_bucket_index(wrap, value);
+  int64_t sub_bucket_index = value >> (bucket_index + _this->unit_magnitude);
+  if (sub_bucket_index >= _this->sub_bucket_count) {
+    bucket_index++;
+  }
+  return (int64_t)1 << (_this->unit_magnitude + bucket_index);
+}
+
+
+static void iotjs_histogram_record(iotjs_histogramwrap_t* wrap,
+                                   int64_t value) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+
+  if (value > _this->highest) {
+    _this->exceeds++;
+    return;
+  }
+
+  uint32_t* count = &_this->counts[iotjs_histogram_counts_index(wrap, value)];
+  if (*count == UINT32_MAX) {
+    _this->exceeds++;
+    return;
+  }
+  (*count)++;
+
+  if (_this->total_count == 0 || value < _this->min) {
+    _this->min = value;
+  }
+  if (_this->total_count == 0 || value > _this->max) {
+    _this->max = value;
+  }
+  _this->total_count++;
+}
+
+
+// The mean, with each value taken as the middle of its range.
+static double iotjs_histogram_mean(iotjs_histogramwrap_t* wrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+
+  double total = 0;
+  for (uint32_t i = 0; i < _this->counts_len; i++) {
+    if (_this->counts[i] != 0) {
+      int64_t value = iotjs_histogram_value_at_index(wrap, i);
+      value += iotjs_histogram_range_size(wrap, value) >> 1;
+      total += (double)_this->counts[i] * (double)value;
+    }
+  }
+  return total / (double)_this->total_count;
+}
+
+
+static double iotjs_histogram_stddev(iotjs_histogramwrap_t* wrap,
+                                     double mean) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+
+  double total = 0;
+  for (uint32_t i = 0; i < _this->counts_len; i++) {
+    if (_this->counts[i] != 0) {
+      int64_t value = iotjs_histogram_value_at_index(wrap, i);
+      value += iotjs_histogram_range_size(wrap, value) >> 1;
+      double deviation = (double)value - mean;
+      total += deviation * deviation * (double)_this->counts[i];
+    }
+  }
+  return sqrt(total / (double)_this->total_count);
+}
+
+
+// The highest value of the range the given percent of the values are at or
+// below, or the lowest one for the 0th percentile.
+static int64_t iotjs_histogram_percentile(iotjs_histogramwrap_t* wrap,
+                                          double percent) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+
+  uint64_t count_at_percentile =
+      (uint64_t)(percent / 100 * (double)_this->total_count + 0.5);
+  if (count_at_percentile == 0) {
+    count_at_percentile = 1;
+  }
+
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < _this->counts_len; i++) {
+    total += _this->counts[i];
+    if (total >= count_at_percentile) {
+      int64_t value = iotjs_histogram_value_at_index(wrap, i);
+      if (percent == 0) {
+        return value;
+      }
+      return value + iotjs_histogram_range_size(wrap, value) - 1;
+    }
+  }
+  return 0;
+}
+
+
+static void iotjs_histogram_reset(iotjs_histogramwrap_t* wrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+  memset(_this->counts, 0, _this->counts_len * sizeof(uint32_t));
+  _this->total_count = 0;
+  _this->exceeds = 0;
+  _this->min = 0;
+  _this->max = 0;
+  _this->prev_hrtime = 0;
+}
+
+
+// Milliseconds since the startup of the process.
+JHANDLER_FUNCTION(Now) {
+  const iotjs_startup_trace_t* trace =
+      iotjs_environment_startup_trace(iotjs_environment_get());
+  iotjs_jhandler_return_number(jhandler,
+                               (double)(uv_hrtime() - trace->start) / 1e6);
+}
+
+
+// [0] lowest discernible value, at least 1
+// [1] highest trackable value, at least twice the lowest
+// [2] significant figures, 1 to 5
+JHANDLER_FUNCTION(Histogram) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(3, number, number, number);
+
+  double lowest = JHANDLER_GET_ARG(0, number);
+  double highest = JHANDLER_GET_ARG(1, number);
+  double figures = JHANDLER_GET_ARG(2, number);
+
+  if (!(lowest >= 1 && lowest == floor(lowest) &&
+        lowest <= IOTJS_HISTOGRAM_MAX_VALUE / 2)) {
+    JHANDLER_THROW(RANGE, "The lowest value must be a positive integer");
+    return;
+  }
+  if (!(highest >= 2 * lowest && highest <= IOTJS_HISTOGRAM_MAX_VALUE)) {
+    JHANDLER_THROW(RANGE,
+                   "The highest value must be at least twice the lowest");
+    return;
+  }
+  if (!(figures >= 1 && figures <= IOTJS_HISTOGRAM_MAX_FIGURES &&
+        figures == floor(figures))) {
+    JHANDLER_THROW(RANGE, "The significant figures must be 1 to 5");
+    return;
+  }
+
+  iotjs_histogramwrap_create(JHANDLER_GET_THIS(object), (int64_t)lowest,
+                             (int64_t)highest, (uint32_t)figures);
+}
+
+
+// [0] value, a non-negative number, of which the fraction is dropped
+JHANDLER_FUNCTION(Record) {
+  JHANDLER_DECLARE_THIS_PTR(histogramwrap, wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  double value = JHANDLER_GET_ARG(0, number);
+  if (!(value >= 0)) {
+    JHANDLER_THROW(RANGE, "The value must not be negative");
+    return;
+  }
+
+  if (value > IOTJS_HISTOGRAM_MAX_VALUE) {
+    value = IOTJS_HISTOGRAM_MAX_VALUE;
+  }
+  iotjs_histogram_record(wrap, (int64_t)value);
+}
+
+
+// Records the nanoseconds since the last call, which only starts the clock
+// the first time. Nothing is allocated, on either side.
+JHANDLER_FUNCTION(RecordDelta) {
+  JHANDLER_DECLARE_THIS_PTR(histogramwrap, wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+
+  uint64_t now = uv_hrtime();
+  if (_this->prev_hrtime != 0) {
+    iotjs_histogram_record(wrap, (int64_t)(now - _this->prev_hrtime));
+  }
+  _this->prev_hrtime = now;
+}
+
+
+// Returns [count, min, max, mean, stddev, exceeds, bytes of the counts].
+JHANDLER_FUNCTION(Stats) {
+  JHANDLER_DECLARE_THIS_PTR(histogramwrap, wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+
+  double stats[7];
+  stats[0] = (double)_this->total_count;
+  stats[1] = (double)_this->min;
+  stats[2] = (double)_this->max;
+  stats[3] = NAN;
+  stats[4] = NAN;
+  if (_this->total_count > 0) {
+    stats[3] = iotjs_histogram_mean(wrap);
+    stats[4] = iotjs_histogram_stddev(wrap, stats[3]);
+  }
+  stats[5] = (double)_this->exceeds;
+  stats[6] = (double)(_this->counts_len * sizeof(uint32_t));
+
+  iotjs_jval_t jstats = iotjs_jval_create_array(7);
+  for (uint32_t i = 0; i < 7; i++) {
+    iotjs_jval_t jstat = iotjs_jval_create_number(stats[i]);
+    iotjs_jval_set_property_by_index(&jstats, i, &jstat);
+    iotjs_jval_destroy(&jstat);
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jstats);
+  iotjs_jval_destroy(&jstats);
+}
+
+
+// [0] percent, 0 to 100
+JHANDLER_FUNCTION(Percentile) {
+  JHANDLER_DECLARE_THIS_PTR(histogramwrap, wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_histogramwrap_t, wrap);
+
+  double percent = JHANDLER_GET_ARG(0, number);
+  if (!(percent >= 0 && percent <= 100)) {
+    JHANDLER_THROW(RANGE, "The percentile must be 0 to 100");
+    return;
+  }
+
+  if (_this->total_count == 0) {
+    iotjs_jhandler_return_number(jhandler, 0);
+    return;
+  }
+  iotjs_jhandler_return_number(jhandler,
+                               (double)iotjs_histogram_percentile(wrap,
+                                                                  percent));
+}
+
+
+JHANDLER_FUNCTION(Reset) {
+  JHANDLER_DECLARE_THIS_PTR(histogramwrap, wrap);
+  iotjs_histogram_reset(wrap);
+}
+
+
+iotjs_jval_t InitPerformance() {
+  iotjs_jval_t performance = iotjs_jval_create_object();
+
+  iotjs_jval_set_method(&performance, IOTJS_MAGIC_STRING_NOW, Now);
+
+  iotjs_jval_t jhistogram = iotjs_jval_create_function_with_dispatch(Histogram);
+  iotjs_jval_t prototype = iotjs_jval_create_object();
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_RECORD, Record);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_RECORDDELTA,
+                        RecordDelta);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_STATS, Stats);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_PERCENTILE, Percentile);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_RESET, Reset);
+  iotjs_jval_set_property_jval(&jhistogram, IOTJS_MAGIC_STRING_PROTOTYPE,
+                               &prototype);
+  iotjs_jval_set_property_jval(&performance, IOTJS_MAGIC_STRING_HISTOGRAM,
+                               &jhistogram);
+  iotjs_jval_destroy(&prototype);
+  iotjs_jval_destroy(&jhistogram);
+
+  return performance;
+}
@@ -14,11 +14,26 @@
  */
 
 #include "iotjs_def.h"
+#include "iotjs_addon_host.h"
 #include "iotjs_js.h"
+#include "iotjs_memory.h"
+#include "iotjs_module_buffer.h"
+#include "iotjs_module_process.h"
 #include "jerryscript-debugger.h"
 
 #include <stdlib.h>
 
+#if !defined(__TIZENRT__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define IOTJS_FILE_MMAP 1
+#if defined(ENABLE_SNAPSHOT)
+#define IOTJS_SNAPSHOT_MMAP 1
+#endif
+#endif
+
 
 JHANDLER_FUNCTION(Binding) {
   DJHANDLER_CHECK_ARGS(1, number);
@@ -32,20 +47,30 @@ JHANDLER_FUNCTION(Binding) {
 }
 
 
-static iotjs_jval_t WrapEval(const char* name, size_t name_len,
-                             const char* source, size_t length, bool* throws) {
+// Return value should be released with iotjs_buffer_release()
+static char* WrapSource(const char* source, size_t length,
+                        size_t* buffer_length) {
   static const char* wrapper[2] = { "(function(exports, require, module) {",
                                     "\n});\n" };
 
   size_t len0 = strlen(wrapper[0]);
   size_t len1 = strlen(wrapper[1]);
 
-  size_t buffer_length = len0 + len1 + length;
-  char* buffer = iotjs_buffer_allocate(buffer_length);
+  *buffer_length = len0 + len1 + length;
+  char* buffer = iotjs_buffer_allocate(*buffer_length);
   memcpy(buffer, wrapper[0], len0);
   memcpy(buffer + len0, source, length);
   memcpy(buffer + len0 + length, wrapper[1], len1);
 
+  return buffer;
+}
+
+
+static iotjs_jval_t WrapEval(const char* name, size_t name_len,
+                             const char* source, size_t length, bool* throws) {
+  size_t buffer_length;
+  char* buffer = WrapSource(source, length, &buffer_length);
+
   iotjs_jval_t res = iotjs_jhelper_eval(name, name_len, (uint8_t*)buffer,
                                         buffer_length, false, throws);
 
@@ -101,14 +126,43 @@ JHANDLER_FUNCTION(CompileNativePtr) {
   }
 
   if (natives[i].name != NULL) {
+    const char* code = (const char*)natives[i].code;
+    // Byte code in ROM is run in place; decompressed byte code is copied
+    // into the heap since the buffer is released right after.
+    bool copy_bytecode = false;
+
+#ifdef ENABLE_JS_COMPRESSION
+    char* decompressed = NULL;
+    if (natives[i].compressed_length > 0) {
+      decompressed = iotjs_buffer_allocate(natives[i].length);
+      if (!iotjs_lz4_decompress(natives[i].code, natives[i].compressed_length,
+                                decompressed, natives[i].length)) {
+        iotjs_buffer_release(decompressed);
+        iotjs_string_destroy(&id);
+        JHANDLER_THROW(COMMON, "Corrupted native module");
+        return;
+      }
+      code = decompressed;
+      copy_bytecode = true;
+    }
+#endif
+
     bool throws;
 #ifdef ENABLE_SNAPSHOT
-    iotjs_jval_t jres = iotjs_jhelper_exec_snapshot(natives[i].code,
-                                                    natives[i].length, &throws);
-#else
     iotjs_jval_t jres =
-        WrapEval(name, iotjs_string_size(&id), (const char*)natives[i].code,
-                 natives[i].length, &throws);
+        iotjs_jhelper_exec_multi_snapshot(code, natives[i].length,
+                                          natives[i].index, copy_bytecode,
+                                          &throws);
+#else
+    IOTJS_UNUSED(copy_bytecode);
+    iotjs_jval_t jres = WrapEval(name, iotjs_string_size(&id), code,
+                                 natives[i].length, &throws);
+#endif
+
+#ifdef ENABLE_JS_COMPRESSION
+    if (decompressed != NULL) {
+      iotjs_buffer_release(decompressed);
+    }
 #endif
 
     if (!throws) {
@@ -127,6 +181,565 @@ JHANDLER_FUNCTION(CompileNativePtr) {
 }
 
 
+#ifdef IOTJS_FILE_MMAP
+// A snapshot or bundle file mapped into memory. Like the builtin snapshots in
+// ROM, a mapped snapshot is run in place: only the literal tables of its
+// functions are copied into the JerryScript heap, and the instructions are
+// read from the mapping until jerry_cleanup(). On NuttX a file of an XIP file
+// system is mapped straight from flash.
+typedef struct iotjs_snapshot_mapping_s {
+  void* data;
+  size_t size;
+  struct iotjs_snapshot_mapping_s* next;
+} iotjs_snapshot_mapping_t;
+
+
+static iotjs_snapshot_mapping_t* iotjs_snapshot_mappings = NULL;
+
+
+static const void* MapFile(const char* path, size_t* size) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  void* data = MAP_FAILED;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    return NULL;
+  }
+
+  iotjs_snapshot_mapping_t* mapping = IOTJS_ALLOC(iotjs_snapshot_mapping_t);
+  mapping->data = data;
+  mapping->size = (size_t)st.st_size;
+  mapping->next = iotjs_snapshot_mappings;
+  iotjs_snapshot_mappings = mapping;
+
+  *size = mapping->size;
+  return data;
+}
+#endif
+
+
+// An application bundle made by tools/js2bundle.py: the modules of an
+// application in one file, mapped once and looked up by name without probing
+// the file system. All numbers are 32 bits, little endian:
+//   header:  "IOTB", version, entry count, bucket count (a power of two),
+//            index of the main entry, reserved
+//   buckets: entry index + 1 of each slot of the hash table, 0 if empty
+//   entries: FNV-1a hash of the name, kind, name offset, name length,
+//            data offset, data size
+// followed by the names, and the data of the entries at 8 byte boundaries.
+// Entries are found by the hash of their name with linear probing.
+#define BUNDLE_MAGIC "IOTB"
+#define BUNDLE_VERSION 1
+#define BUNDLE_HEADER_SIZE 24
+#define BUNDLE_ENTRY_SIZE 24
+#define BUNDLE_NO_MAIN 0xffffffff
+
+// A JS module is saved in the wrapper of process.compile, so that it is parsed
+// from the bundle without being copied.
+typedef enum {
+  kBundleFile = 0,
+  kBundleModule = 1,
+  kBundleSnapshot = 2,
+} iotjs_bundle_kind_t;
+
+typedef struct {
+  const uint8_t* data;
+  size_t size;
+  uint32_t entry_count;
+  uint32_t bucket_count;
+  uint32_t main_index;
+  // The file read into memory where it cannot be mapped. It is released
+  // together with the mappings, as snapshots are run from it in place.
+  char* buffer;
+} iotjs_bundle_t;
+
+
+static iotjs_bundle_t iotjs_bundle = { NULL, 0, 0, 0, 0, NULL };
+
+
+static uint32_t BundleReadUInt32(const uint8_t* data) {
+  return (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+         ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+
+static uint32_t BundleHash(const char* name, size_t length) {
+  uint32_t hash = 2166136261U;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ (uint8_t)name[i]) * 16777619U;
+  }
+  return hash;
+}
+
+
+static const uint8_t* BundleEntry(uint32_t index) {
+  return iotjs_bundle.data + BUNDLE_HEADER_SIZE +
+         4 * (size_t)iotjs_bundle.bucket_count +
+         BUNDLE_ENTRY_SIZE * (size_t)index;
+}
+
+
+static bool BundleRangeCheck(uint32_t offset, uint32_t length) {
+  return offset <= iotjs_bundle.size && length <= iotjs_bundle.size - offset;
+}
+
+
+// Checks the layout once, so that the lookups need no bounds checks.
+static bool BundleValidate() {
+  const uint8_t* data = iotjs_bundle.data;
+  if (iotjs_bundle.size < BUNDLE_HEADER_SIZE || memcmp(data, BUNDLE_MAGIC, 4) ||
+      BundleReadUInt32(data + 4) != BUNDLE_VERSION) {
+    return false;
+  }
+
+  uint32_t entry_count = BundleReadUInt32(data + 8);
+  uint32_t bucket_count = BundleReadUInt32(data + 12);
+  uint32_t main_index = BundleReadUInt32(data + 16);
+  if (bucket_count == 0 || (bucket_count & (bucket_count - 1)) != 0 ||
+      bucket_count <= entry_count ||
+      (main_index != BUNDLE_NO_MAIN && main_index >= entry_count)) {
+    return false;
+  }
+
+  uint64_t table_size = BUNDLE_HEADER_SIZE + 4 * (uint64_t)bucket_count +
+                        BUNDLE_ENTRY_SIZE * (uint64_t)entry_count;
+  if (table_size > iotjs_bundle.size) {
+    return false;
+  }
+
+  iotjs_bundle.entry_count = entry_count;
+  iotjs_bundle.bucket_count = bucket_count;
+  iotjs_bundle.main_index = main_index;
+
+  for (uint32_t i = 0; i < bucket_count; i++) {
+    if (BundleReadUInt32(data + BUNDLE_HEADER_SIZE + 4 * i) > entry_count) {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i < entry_count; i++) {
+    const uint8_t* entry = BundleEntry(i);
+    uint32_t kind = BundleReadUInt32(entry + 4);
+    if (kind > kBundleSnapshot ||
+        !BundleRangeCheck(BundleReadUInt32(entry + 8),
+                          BundleReadUInt32(entry + 12)) ||
+        !BundleRangeCheck(BundleReadUInt32(entry + 16),
+                          BundleReadUInt32(entry + 20))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+static const uint8_t* BundleFind(const char* name, size_t length) {
+  if (iotjs_bundle.data == NULL) {
+    return NULL;
+  }
+
+  uint32_t hash = BundleHash(name, length);
+  uint32_t mask = iotjs_bundle.bucket_count - 1;
+  const uint8_t* buckets = iotjs_bundle.data + BUNDLE_HEADER_SIZE;
+
+  // The table has an empty slot at least, which ends the probing.
+  for (uint32_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    uint32_t index = BundleReadUInt32(buckets + 4 * slot);
+    if (index == 0) {
+      return NULL;
+    }
+
+    const uint8_t* entry = BundleEntry(index - 1);
+    if (BundleReadUInt32(entry) == hash &&
+        BundleReadUInt32(entry + 12) == length &&
+        !memcmp(iotjs_bundle.data + BundleReadUInt32(entry + 8), name,
+                length)) {
+      return entry;
+    }
+  }
+}
+
+
+static void BundleRelease() {
+  // A mapped bundle is unmapped with the snapshot mappings.
+  if (iotjs_bundle.buffer != NULL) {
+    iotjs_buffer_release(iotjs_bundle.buffer);
+  }
+  memset(&iotjs_bundle, 0, sizeof(iotjs_bundle));
+}
+
+
+// Opens the bundle of the application, and returns the name of its main
+// module. An application has one bundle, which stays open until exit.
+JHANDLER_FUNCTION(OpenBundle) {
+  DJHANDLER_CHECK_ARGS(1, string);
+
+  if (iotjs_bundle.data != NULL) {
+    JHANDLER_THROW(COMMON, "Bundle is already open");
+    return;
+  }
+
+  iotjs_string_t path = JHANDLER_GET_ARG(0, string);
+
+#ifdef IOTJS_FILE_MMAP
+  iotjs_bundle.data =
+      (const uint8_t*)MapFile(iotjs_string_data(&path), &iotjs_bundle.size);
+#endif
+
+  if (iotjs_bundle.data == NULL) {
+    iotjs_string_t content = iotjs_file_read(iotjs_string_data(&path));
+    if (!iotjs_string_is_empty(&content)) {
+      iotjs_bundle.size = iotjs_string_size(&content);
+      iotjs_bundle.buffer = iotjs_buffer_allocate(iotjs_bundle.size);
+      memcpy(iotjs_bundle.buffer, iotjs_string_data(&content),
+             iotjs_bundle.size);
+      iotjs_bundle.data = (const uint8_t*)iotjs_bundle.buffer;
+    }
+    iotjs_string_destroy(&content);
+  }
+
+  iotjs_string_destroy(&path);
+
+  if (iotjs_bundle.data == NULL) {
+    JHANDLER_THROW(COMMON, "Cannot read bundle");
+    return;
+  }
+
+  if (!BundleValidate()) {
+    // A mapping is kept until exit and may be run from, so it is left as is.
+    if (iotjs_bundle.buffer != NULL) {
+      BundleRelease();
+    } else {
+      iotjs_bundle.data = NULL;
+    }
+    JHANDLER_THROW(COMMON, "Invalid bundle");
+    return;
+  }
+
+  if (iotjs_bundle.main_index == BUNDLE_NO_MAIN) {
+    iotjs_jhandler_return_jval(jhandler, iotjs_jval_get_undefined());
+    return;
+  }
+
+  const uint8_t* entry = BundleEntry(iotjs_bundle.main_index);
+  iotjs_string_t main = iotjs_string_create_with_size(
+      (const char*)iotjs_bundle.data + BundleReadUInt32(entry + 8),
+      BundleReadUInt32(entry + 12));
+  iotjs_jhandler_return_string(jhandler, &main);
+  iotjs_string_destroy(&main);
+}
+
+
+// Looks up the entry of the name given, and throws if there is none.
+static const uint8_t* GetBundleEntry(iotjs_jhandler_t* jhandler,
+                                     const iotjs_string_t* name) {
+  const uint8_t* entry =
+      BundleFind(iotjs_string_data(name), iotjs_string_size(name));
+  if (entry == NULL) {
+    iotjs_jval_t jerror = iotjs_jval_create_error("Not found in bundle");
+    iotjs_jhandler_throw(jhandler, &jerror);
+    iotjs_jval_destroy(&jerror);
+  }
+  return entry;
+}
+
+
+JHANDLER_FUNCTION(ProbeBundle) {
+  DJHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_t name = JHANDLER_GET_ARG(0, string);
+  bool found =
+      BundleFind(iotjs_string_data(&name), iotjs_string_size(&name)) != NULL;
+  iotjs_string_destroy(&name);
+
+  iotjs_jhandler_return_boolean(jhandler, found);
+}
+
+
+JHANDLER_FUNCTION(ReadBundled) {
+  DJHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_t name = JHANDLER_GET_ARG(0, string);
+  const uint8_t* entry = GetBundleEntry(jhandler, &name);
+  iotjs_string_destroy(&name);
+
+  if (entry == NULL) {
+    return;
+  }
+
+  if (BundleReadUInt32(entry + 4) != kBundleFile) {
+    JHANDLER_THROW(COMMON, "Bundled module can only be compiled");
+    return;
+  }
+
+  iotjs_string_t content = iotjs_string_create_with_size(
+      (const char*)iotjs_bundle.data + BundleReadUInt32(entry + 16),
+      BundleReadUInt32(entry + 20));
+  iotjs_jhandler_return_string(jhandler, &content);
+  iotjs_string_destroy(&content);
+}
+
+
+// Compiles a bundled module like process.compile, or runs its snapshot in
+// place. The file name is the one of the module in stack traces.
+JHANDLER_FUNCTION(CompileBundled) {
+  DJHANDLER_CHECK_ARGS(2, string, string);
+
+  iotjs_string_t name = JHANDLER_GET_ARG(0, string);
+  iotjs_string_t file = JHANDLER_GET_ARG(1, string);
+  const uint8_t* entry = GetBundleEntry(jhandler, &name);
+
+  if (entry != NULL) {
+    const char* data =
+        (const char*)iotjs_bundle.data + BundleReadUInt32(entry + 16);
+    size_t size = BundleReadUInt32(entry + 20);
+
+    uint32_t kind = BundleReadUInt32(entry + 4);
+    if (kind != kBundleSnapshot &&
+        iotjs_environment_config(iotjs_environment_get())->debugger) {
+      jerry_debugger_stop();
+    }
+
+    bool throws = false;
+    iotjs_jval_t jres;
+    if (kind == kBundleModule) {
+      jres = iotjs_jhelper_eval(iotjs_string_data(&file),
+                                iotjs_string_size(&file), (const uint8_t*)data,
+                                size, false, &throws);
+    } else if (kind == kBundleSnapshot) {
+#ifdef ENABLE_SNAPSHOT
+      jres = iotjs_jhelper_exec_snapshot(data, size, false, &throws);
+#else
+      jres = iotjs_jval_create_error("Snapshot is not enabled");
+      throws = true;
+#endif
+    } else {
+      jres = WrapEval(iotjs_string_data(&file), iotjs_string_size(&file), data,
+                      size, &throws);
+    }
+
+    if (!throws) {
+      iotjs_jhandler_return_jval(jhandler, &jres);
+    } else {
+      iotjs_jhandler_throw(jhandler, &jres);
+    }
+    iotjs_jval_destroy(&jres);
+  }
+
+  iotjs_string_destroy(&name);
+  iotjs_string_destroy(&file);
+}
+
+
+void iotjs_process_snapshot_release() {
+#ifdef IOTJS_FILE_MMAP
+  while (iotjs_snapshot_mappings != NULL) {
+    iotjs_snapshot_mapping_t* mapping = iotjs_snapshot_mappings;
+    iotjs_snapshot_mappings = mapping->next;
+    munmap(mapping->data, mapping->size);
+    IOTJS_RELEASE(mapping);
+  }
+#endif
+  BundleRelease();
+}
+
+
+#ifdef ENABLE_SNAPSHOT
+// Runs the snapshot file at `path` in place if it can be mapped, otherwise
+// reads it and copies the byte code, so that the buffer can be freed right
+// away. `*loaded` is false when the file cannot be read.
+static iotjs_jval_t ExecSnapshotFile(const char* path, bool* loaded,
+                                     bool* throws) {
+  *loaded = true;
+
+#ifdef IOTJS_SNAPSHOT_MMAP
+  size_t size;
+  const void* data = MapFile(path, &size);
+  if (data != NULL) {
+    return iotjs_jhelper_exec_snapshot(data, size, false, throws);
+  }
+#endif
+
+  iotjs_string_t snapshot = iotjs_file_read(path);
+  if (iotjs_string_is_empty(&snapshot)) {
+    *loaded = false;
+  }
+
+  iotjs_jval_t jres =
+      iotjs_jhelper_exec_snapshot(iotjs_string_data(&snapshot),
+                                  iotjs_string_size(&snapshot), true, throws);
+
+  iotjs_string_destroy(&snapshot);
+  return jres;
+}
+#endif
+
+
+// Loads a module precompiled by tools/js2snapshot.py.
+JHANDLER_FUNCTION(CompileSnapshot) {
+  DJHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_t file = JHANDLER_GET_ARG(0, string);
+
+#ifdef ENABLE_SNAPSHOT
+  bool loaded;
+  bool throws;
+  iotjs_jval_t jres =
+      ExecSnapshotFile(iotjs_string_data(&file), &loaded, &throws);
+
+  if (!throws) {
+    iotjs_jhandler_return_jval(jhandler, &jres);
+  } else {
+    iotjs_jhandler_throw(jhandler, &jres);
+  }
+
+  iotjs_jval_destroy(&jres);
+#else
+  JHANDLER_THROW(COMMON, "Snapshot is not enabled");
+#endif
+
+  iotjs_string_destroy(&file);
+}
+
+
+#ifdef ENABLE_CODE_CACHE
+// Snapshots are saved into a buffer doubled up to this size
+#define CODE_CACHE_MAX_SNAPSHOT_SIZE (1024 * 1024)
+
+// The cache file of a source is named by the FNV-1a hash of the source and
+// the IoT.js version. Snapshots of another engine version are rejected by
+// jerry_exec_snapshot, and saved again.
+static iotjs_string_t GetCodeCachePath(const char* cache_dir,
+                                       const char* source, size_t length) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ (uint8_t)source[i]) * 1099511628211ULL;
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "/%016llx-%s.snapshot",
+           (unsigned long long)hash, IOTJS_VERSION);
+
+  iotjs_string_t path = iotjs_string_create();
+  iotjs_string_append(&path, cache_dir, strlen(cache_dir));
+  iotjs_string_append(&path, name, strlen(name));
+  return path;
+}
+
+
+static bool LoadCodeCache(const char* path, iotjs_jval_t* jres) {
+  bool loaded;
+  bool throws;
+  *jres = ExecSnapshotFile(path, &loaded, &throws);
+
+  if (!loaded || throws) {
+    iotjs_jval_destroy(jres);
+    return false;
+  }
+
+  return true;
+}
+
+
+static bool SaveCodeCache(const char* path, const char* source, size_t length,
+                          iotjs_jval_t* jres) {
+  size_t buffer_length;
+  char* buffer = WrapSource(source, length, &buffer_length);
+
+  // The snapshot is also run, so the source is not parsed twice.
+  bool saved = false;
+  size_t snapshot_size = 0;
+  size_t buffer_size = 2 * buffer_length + 4096;
+  while (buffer_size <= CODE_CACHE_MAX_SNAPSHOT_SIZE) {
+    uint32_t* snapshot = (uint32_t*)iotjs_buffer_allocate(buffer_size);
+    snapshot_size = iotjs_jhelper_save_snapshot((uint8_t*)buffer, buffer_length,
+                                                snapshot, buffer_size);
+    if (snapshot_size > 0) {
+      iotjs_file_write(path, (const char*)snapshot, snapshot_size);
+
+      bool throws;
+      *jres = iotjs_jhelper_exec_snapshot(snapshot, snapshot_size, true,
+                                          &throws);
+      saved = !throws;
+      if (!saved) {
+        iotjs_jval_destroy(jres);
+      }
+    }
+    iotjs_buffer_release((char*)snapshot);
+
+    if (snapshot_size > 0) {
+      break;
+    }
+    buffer_size *= 2;
+  }
+
+  iotjs_buffer_release(buffer);
+  return saved;
+}
+#endif
+
+
+// Compiles a module like process.compile, with its byte code cached in
+// the directory given.
+JHANDLER_FUNCTION(CompileCached) {
+  DJHANDLER_CHECK_ARGS(3, string, string, string);
+
+  iotjs_string_t file = JHANDLER_GET_ARG(0, string);
+  iotjs_string_t source = JHANDLER_GET_ARG(1, string);
+  iotjs_string_t cache_dir = JHANDLER_GET_ARG(2, string);
+
+  const char* filename = iotjs_string_data(&file);
+  const iotjs_environment_t* env = iotjs_environment_get();
+
+  iotjs_jval_t jres;
+  bool cached = false;
+
+#ifdef ENABLE_CODE_CACHE
+  // The byte code of the debugger is not saved in snapshots.
+  if (!iotjs_environment_config(env)->debugger) {
+    iotjs_string_t path =
+        GetCodeCachePath(iotjs_string_data(&cache_dir),
+                         iotjs_string_data(&source), iotjs_string_size(&source));
+
+    cached = LoadCodeCache(iotjs_string_data(&path), &jres) ||
+             SaveCodeCache(iotjs_string_data(&path), iotjs_string_data(&source),
+                           iotjs_string_size(&source), &jres);
+
+    iotjs_string_destroy(&path);
+  }
+#endif
+
+  bool throws = false;
+  if (!cached) {
+    // Sources with errors are not cached, and raise them here.
+    if (iotjs_environment_config(env)->debugger) {
+      jerry_debugger_stop();
+    }
+    jres = WrapEval(filename, strlen(filename), iotjs_string_data(&source),
+                    iotjs_string_size(&source), &throws);
+  }
+
+  if (!throws) {
+    iotjs_jhandler_return_jval(jhandler, &jres);
+  } else {
+    iotjs_jhandler_throw(jhandler, &jres);
+  }
+
+  iotjs_string_destroy(&file);
+  iotjs_string_destroy(&source);
+  iotjs_string_destroy(&cache_dir);
+  iotjs_jval_destroy(&jres);
+}
+
+
 JHANDLER_FUNCTION(ReadSource) {
   DJHANDLER_CHECK_ARGS(1, string);
 
@@ -140,6 +753,25 @@ JHANDLER_FUNCTION(ReadSource) {
 }
 
 
+#if IOTJS_ADDON_SUPPORTED
+// Loads the native addon `filename` into `exports`, for `require`.
+JHANDLER_FUNCTION(DLOpen) {
+  DJHANDLER_CHECK_ARGS(2, object, string);
+
+  const iotjs_jval_t* jexports = JHANDLER_GET_ARG(0, object);
+  iotjs_string_t filename = JHANDLER_GET_ARG(1, string);
+
+  const char* error = iotjs_addon_load(iotjs_string_data(&filename), jexports);
+
+  iotjs_string_destroy(&filename);
+
+  if (error != NULL) {
+    JHANDLER_THROW(COMMON, error);
+  }
+}
+#endif
+
+
 JHANDLER_FUNCTION(Cwd) {
   DJHANDLER_CHECK_ARGS(0);
 
@@ -182,6 +814,87 @@ JHANDLER_FUNCTION(DoExit) {
 }
 
 
+// Get the jmem profiler category of the first argument.
+static uint32_t GetMemoryProfilerCategory(iotjs_jhandler_t* jhandler) {
+  iotjs_string_t name = JHANDLER_GET_ARG(0, string);
+  uint32_t category =
+      iotjs_environment_jmem_profile_category(iotjs_string_data(&name));
+  iotjs_string_destroy(&name);
+  return category;
+}
+
+
+JHANDLER_FUNCTION(MemoryProfilerEnable) {
+  JHANDLER_CHECK_ARGS(1, string);
+
+  uint32_t category = GetMemoryProfilerCategory(jhandler);
+  if (category == 0) {
+    JHANDLER_THROW(COMMON, "unknown memory profiler category");
+    return;
+  }
+  bool is_built_in = jerry_set_jmem_profile_categories(
+      jerry_get_jmem_profile_categories() | category);
+  iotjs_jhandler_return_boolean(jhandler, is_built_in);
+}
+
+
+JHANDLER_FUNCTION(MemoryProfilerDisable) {
+  JHANDLER_CHECK_ARGS(1, string);
+
+  uint32_t category = GetMemoryProfilerCategory(jhandler);
+  if (category == 0) {
+    JHANDLER_THROW(COMMON, "unknown memory profiler category");
+    return;
+  }
+  jerry_set_jmem_profile_categories(jerry_get_jmem_profile_categories() &
+                                    ~category);
+}
+
+
+JHANDLER_FUNCTION(MemoryProfilerIsEnabled) {
+  JHANDLER_CHECK_ARGS(1, string);
+
+  uint32_t category = GetMemoryProfilerCategory(jhandler);
+  if (category == 0) {
+    JHANDLER_THROW(COMMON, "unknown memory profiler category");
+    return;
+  }
+  uint32_t categories = jerry_get_jmem_profile_categories();
+  iotjs_jhandler_return_boolean(jhandler, (categories & category) == category);
+}
+
+
+JHANDLER_FUNCTION(MemoryProfilerWriteHeapSamples) {
+  JHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_t path = JHANDLER_GET_ARG(0, string);
+  bool is_written =
+      jerry_write_jmem_sampling_profile(iotjs_string_data(&path));
+  iotjs_string_destroy(&path);
+  iotjs_jhandler_return_boolean(jhandler, is_written);
+}
+
+
+JHANDLER_FUNCTION(MemoryProfilerWriteCpuProfile) {
+  JHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_t path = JHANDLER_GET_ARG(0, string);
+  bool is_written = jerry_write_jmem_cpu_profile(iotjs_string_data(&path));
+  iotjs_string_destroy(&path);
+  iotjs_jhandler_return_boolean(jhandler, is_written);
+}
+
+
+JHANDLER_FUNCTION(MemoryProfilerWriteHeapSnapshot) {
+  JHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_t path = JHANDLER_GET_ARG(0, string);
+  bool is_written = jerry_write_heap_snapshot(iotjs_string_data(&path));
+  iotjs_string_destroy(&path);
+  iotjs_jhandler_return_boolean(jhandler, is_written);
+}
+
+
 void SetNativeSources(iotjs_jval_t* native_sources) {
   for (int i = 0; natives[i].name; i++) {
     iotjs_jval_set_property_jval(native_sources, natives[i].name,
@@ -191,7 +904,8 @@ void SetNativeSources(iotjs_jval_t* native_sources) {
 
 
 static void SetProcessEnv(iotjs_jval_t* process) {
-  const char *homedir, *iotjspath, *iotjsenv;
+  const char *homedir, *iotjspath, *iotjsenv, *codecache, *clusterworker,
+      *channelfd, *workerdata, *sharedring;
 
   homedir = getenv("HOME");
   if (homedir == NULL) {
@@ -207,6 +921,35 @@ static void SetProcessEnv(iotjs_jval_t* process) {
 #endif
   }
 
+  codecache = getenv("IOTJS_CODE_CACHE");
+  if (codecache == NULL) {
+    codecache = "";
+  }
+
+  // The id of a cluster worker process, empty for the master.
+  clusterworker = getenv("IOTJS_CLUSTER_WORKER");
+  if (clusterworker == NULL) {
+    clusterworker = "";
+  }
+
+  // The socket and the start up data of a worker module worker, empty for
+  // other processes.
+  channelfd = getenv("IOTJS_CHANNEL_FD");
+  if (channelfd == NULL) {
+    channelfd = "";
+  }
+
+  workerdata = getenv("IOTJS_WORKER_DATA");
+  if (workerdata == NULL) {
+    workerdata = "";
+  }
+
+  // The descriptors of the rings of a worker with shared memory.
+  sharedring = getenv("IOTJS_SHARED_RING");
+  if (sharedring == NULL) {
+    sharedring = "";
+  }
+
 #if defined(EXPERIMENTAL)
   iotjsenv = "experimental";
 #else
@@ -219,6 +962,19 @@ static void SetProcessEnv(iotjs_jval_t* process) {
                                      iotjspath);
   iotjs_jval_set_property_string_raw(&env, IOTJS_MAGIC_STRING_IOTJS_ENV,
                                      iotjsenv);
+  iotjs_jval_set_property_string_raw(&env, IOTJS_MAGIC_STRING_IOTJS_CODE_CACHE,
+                                     codecache);
+  iotjs_jval_set_property_string_raw(&env,
+                                     IOTJS_MAGIC_STRING_IOTJS_CLUSTER_WORKER,
+                                     clusterworker);
+  iotjs_jval_set_property_string_raw(&env, IOTJS_MAGIC_STRING_IOTJS_CHANNEL_FD,
+                                     channelfd);
+  iotjs_jval_set_property_string_raw(&env,
+                                     IOTJS_MAGIC_STRING_IOTJS_WORKER_DATA,
+                                     workerdata);
+  iotjs_jval_set_property_string_raw(&env,
+                                     IOTJS_MAGIC_STRING_IOTJS_SHARED_RING,
+                                     sharedring);
 
   iotjs_jval_set_property_jval(process, IOTJS_MAGIC_STRING_ENV, &env);
 
@@ -237,6 +993,395 @@ static void SetProcessIotjs(iotjs_jval_t* process) {
 }
 
 
+static void SetProcessMemoryProfiler(iotjs_jval_t* process) {
+  // jmem profilers selected at runtime
+  iotjs_jval_t profiler = iotjs_jval_create_object();
+  iotjs_jval_set_method(&profiler, IOTJS_MAGIC_STRING_ENABLE,
+                        MemoryProfilerEnable);
+  iotjs_jval_set_method(&profiler, IOTJS_MAGIC_STRING_DISABLE,
+                        MemoryProfilerDisable);
+  iotjs_jval_set_method(&profiler, IOTJS_MAGIC_STRING_ISENABLED,
+                        MemoryProfilerIsEnabled);
+  iotjs_jval_set_method(&profiler, IOTJS_MAGIC_STRING_WRITECPUPROFILE,
+                        MemoryProfilerWriteCpuProfile);
+  iotjs_jval_set_method(&profiler, IOTJS_MAGIC_STRING_WRITEHEAPSAMPLES,
+                        MemoryProfilerWriteHeapSamples);
+  iotjs_jval_set_method(&profiler, IOTJS_MAGIC_STRING_WRITEHEAPSNAPSHOT,
+                        MemoryProfilerWriteHeapSnapshot);
+  iotjs_jval_set_property_jval(process, IOTJS_MAGIC_STRING_MEMORYPROFILER,
+                               &profiler);
+  iotjs_jval_destroy(&profiler);
+}
+
+
+// process.nextTick(callback[, arg...])
+JHANDLER_FUNCTION(NextTick) {
+  uint16_t argc = iotjs_jhandler_get_arg_length(jhandler);
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(0, function);
+  if (jcallback == NULL) {
+    JHANDLER_THROW(TYPE, "Bad arguments: callback must be a Function");
+    return;
+  }
+
+  if (argc == 1) {
+    iotjs_process_queue_next_tick(jcallback, iotjs_jval_get_undefined());
+  } else {
+    iotjs_jval_t jargs = iotjs_jval_create_array(argc - 1);
+    for (uint16_t i = 1; i < argc; ++i) {
+      iotjs_jval_set_property_by_index(&jargs, i - 1,
+                                       iotjs_jhandler_get_arg(jhandler, i));
+    }
+    iotjs_process_queue_next_tick(jcallback, &jargs);
+    iotjs_jval_destroy(&jargs);
+  }
+
+  iotjs_jhandler_return_undefined(jhandler);
+}
+
+
+JHANDLER_FUNCTION(RunNextTicks) {
+  iotjs_jhandler_return_boolean(jhandler, iotjs_process_next_tick());
+}
+
+
+// process.loopStats(): the time spent in the event loop so far, in
+// milliseconds, and the iterations counted by the time they kept I/O waiting.
+JHANDLER_FUNCTION(LoopStats) {
+  const iotjs_loop_stats_t* stats =
+      iotjs_environment_loop_stats(iotjs_environment_get());
+  const double ns_per_ms = 1000000;
+
+  iotjs_jval_t jstats = iotjs_jval_create_object();
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_ITERATIONS,
+                                 (double)stats->iterations);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_IDLETIME,
+                                 stats->idle_time / ns_per_ms);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_CALLBACKTIME,
+                                 stats->callback_time / ns_per_ms);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_JOBTIME,
+                                 stats->job_time / ns_per_ms);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_GCTIME,
+                                 stats->gc_time / ns_per_ms);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_MAXLAG,
+                                 stats->max_lag / ns_per_ms);
+
+  iotjs_jval_t jhistogram = iotjs_jval_create_array(IOTJS_LOOP_LAG_BUCKETS);
+  for (uint32_t i = 0; i < IOTJS_LOOP_LAG_BUCKETS; ++i) {
+    iotjs_jval_t jcount = iotjs_jval_create_number(stats->lag_histogram[i]);
+    iotjs_jval_set_property_by_index(&jhistogram, i, &jcount);
+    iotjs_jval_destroy(&jcount);
+  }
+  iotjs_jval_set_property_jval(&jstats, IOTJS_MAGIC_STRING_LAGHISTOGRAM,
+                               &jhistogram);
+  iotjs_jval_destroy(&jhistogram);
+
+  iotjs_jhandler_return_jval(jhandler, &jstats);
+  iotjs_jval_destroy(&jstats);
+}
+
+
+// process._markStartup(phase): the end of a startup phase run in iotjs.js.
+JHANDLER_FUNCTION(MarkStartup) {
+  DJHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_t name = JHANDLER_GET_ARG(0, string);
+  iotjs_startup_phase_t phase =
+      iotjs_environment_startup_phase_of(iotjs_string_data(&name));
+  iotjs_string_destroy(&name);
+
+  if (phase < kStartupPhaseCount) {
+    iotjs_environment_mark_startup(iotjs_environment_get(), phase);
+  }
+}
+
+
+// process.startupTrace(): the milliseconds each startup phase took, and their
+// total. The phases not reached yet are left out.
+JHANDLER_FUNCTION(StartupTrace) {
+  const iotjs_startup_trace_t* trace =
+      iotjs_environment_startup_trace(iotjs_environment_get());
+  const double ns_per_ms = 1000000;
+  uint64_t phase_start = trace->start;
+
+  iotjs_jval_t jtrace = iotjs_jval_create_object();
+  for (int phase = 0; phase < kStartupPhaseCount; phase++) {
+    uint64_t phase_end = trace->phase_end[phase];
+    if (phase_end == 0) {
+      continue;
+    }
+    iotjs_jval_set_property_number(&jtrace,
+                                   iotjs_environment_startup_phase_name(phase),
+                                   (phase_end - phase_start) / ns_per_ms);
+    phase_start = phase_end;
+  }
+  iotjs_jval_set_property_number(&jtrace, IOTJS_MAGIC_STRING_TOTAL,
+                                 (phase_start - trace->start) / ns_per_ms);
+
+  iotjs_jhandler_return_jval(jhandler, &jtrace);
+  iotjs_jval_destroy(&jtrace);
+}
+
+
+JHANDLER_FUNCTION(GcStats) {
+  jerry_gc_stats_t stats;
+  jerry_get_gc_stats(&stats);
+
+  iotjs_jval_t jstats = iotjs_jval_create_object();
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_COUNT,
+                                 stats.count);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_LASTPAUSE,
+                                 stats.last_pause_us / 1000.0);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_INTERVAL,
+                                 stats.interval_ms);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_ALLOCATIONRATE,
+                                 stats.allocation_rate);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_SURVIVAL,
+                                 stats.survival_percent);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_GROWTH,
+                                 stats.growth_percent);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_FREESEGMENTS,
+                                 stats.free_segments);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_LIVESIZE,
+                                 (double)stats.live_size);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_TRIGGERSIZE,
+                                 (double)stats.trigger_size);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_FINALIZERS,
+                                 iotjs_finalizer_count());
+
+  iotjs_jhandler_return_jval(jhandler, &jstats);
+  iotjs_jval_destroy(&jstats);
+}
+
+
+// Reads a non-negative number option, keeping the value if it is not given
+static double GetGcTriggerOption(const iotjs_jval_t* joptions,
+                                 const char* name, double value) {
+  iotjs_jval_t jvalue = iotjs_jval_get_property(joptions, name);
+  if (iotjs_jval_is_number(&jvalue) && iotjs_jval_as_number(&jvalue) >= 0) {
+    value = iotjs_jval_as_number(&jvalue);
+  }
+  iotjs_jval_destroy(&jvalue);
+  return value;
+}
+
+
+// process.setGcTrigger({growth, minInterval, pauseBudget, reserve})
+JHANDLER_FUNCTION(SetGcTrigger) {
+  JHANDLER_CHECK_ARGS(1, object);
+  const iotjs_jval_t* joptions = JHANDLER_GET_ARG(0, object);
+
+  jerry_gc_trigger_t trigger;
+  jerry_get_gc_trigger(&trigger);
+
+  trigger.growth_percent = (uint32_t)GetGcTriggerOption(
+      joptions, IOTJS_MAGIC_STRING_GROWTH, trigger.growth_percent);
+  trigger.min_interval_ms = (uint32_t)GetGcTriggerOption(
+      joptions, IOTJS_MAGIC_STRING_MININTERVAL, trigger.min_interval_ms);
+  trigger.pause_budget_us =
+      (uint32_t)(GetGcTriggerOption(joptions, IOTJS_MAGIC_STRING_PAUSEBUDGET,
+                                    trigger.pause_budget_us / 1000.0) *
+                 1000);
+  double reserve = GetGcTriggerOption(joptions, IOTJS_MAGIC_STRING_RESERVE,
+                                      trigger.reserve_percent);
+  if (reserve > 100) {
+    JHANDLER_THROW(RANGE, "reserve must be a percent of the heap");
+    return;
+  }
+  trigger.reserve_percent = (uint32_t)reserve;
+
+  jerry_set_gc_trigger(&trigger);
+}
+
+
+// process._beginNoGC(headroom): false if the headroom cannot be reserved
+JHANDLER_FUNCTION(BeginNoGC) {
+  JHANDLER_CHECK_ARGS(1, number);
+  double headroom = JHANDLER_GET_ARG(0, number);
+
+  bool ret = headroom >= 0 && jerry_begin_no_gc_region((size_t)headroom);
+  iotjs_jhandler_return_boolean(jhandler, ret);
+}
+
+
+// process._endNoGC(): true if the region has allocated past its headroom
+JHANDLER_FUNCTION(EndNoGC) {
+  iotjs_jhandler_return_boolean(jhandler, jerry_end_no_gc_region());
+}
+
+
+JHANDLER_FUNCTION(PoolStats) {
+  iotjs_jval_t jstats = iotjs_jval_create_object();
+
+  for (const iotjs_pool_t* pool = iotjs_pool_list(); pool != NULL;
+       pool = pool->next) {
+    iotjs_jval_t jpool = iotjs_jval_create_object();
+    iotjs_jval_set_property_number(&jpool, IOTJS_MAGIC_STRING_SIZE,
+                                   (double)pool->size);
+    iotjs_jval_set_property_number(&jpool, IOTJS_MAGIC_STRING_CAP, pool->cap);
+    iotjs_jval_set_property_number(&jpool, IOTJS_MAGIC_STRING_FREE,
+                                   pool->free_count);
+    iotjs_jval_set_property_number(&jpool, IOTJS_MAGIC_STRING_INUSE,
+                                   pool->in_use);
+    iotjs_jval_set_property_number(&jpool, IOTJS_MAGIC_STRING_PEAK,
+                                   pool->peak);
+    iotjs_jval_set_property_number(&jpool, IOTJS_MAGIC_STRING_ALLOCATED,
+                                   (double)pool->allocated);
+    iotjs_jval_set_property_number(&jpool, IOTJS_MAGIC_STRING_REUSED,
+                                   (double)pool->reused);
+    iotjs_jval_set_property_jval(&jstats, pool->name, &jpool);
+    iotjs_jval_destroy(&jpool);
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jstats);
+  iotjs_jval_destroy(&jstats);
+}
+
+
+JHANDLER_FUNCTION(MemoryStats) {
+  // The pressure of the usage now, not of the end of the last iteration.
+  iotjs_memory_check();
+
+  iotjs_memory_stats_t stats;
+  iotjs_memory_get_stats(&stats);
+
+  iotjs_jval_t jstats = iotjs_jval_create_object();
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_JSHEAP,
+                                 (double)stats.js_heap);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_JSHEAPSIZE,
+                                 (double)stats.js_heap_size);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_UVHEAP,
+                                 (double)stats.uv_heap);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_NATIVE,
+                                 (double)stats.native);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_BUDGET,
+                                 (double)stats.budget);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_PRESSURE,
+                                 stats.pressure);
+  iotjs_jval_set_property_number(&jstats, IOTJS_MAGIC_STRING_RELIEFS,
+                                 (double)stats.reliefs);
+
+  iotjs_jhandler_return_jval(jhandler, &jstats);
+  iotjs_jval_destroy(&jstats);
+}
+
+
+// The sizes of the segments are taken by the caller before it creates any
+// JS value, which would change them.
+static iotjs_jval_t CreateSegmentUsage(const jerry_heap_usage_t* usage,
+                                       const size_t* occupied_sizes,
+                                       uint32_t count) {
+  iotjs_jval_t jsegments = iotjs_jval_create_object();
+  iotjs_jval_set_property_number(&jsegments, IOTJS_MAGIC_STRING_COUNT,
+                                 usage->segment_count);
+  iotjs_jval_set_property_number(&jsegments, IOTJS_MAGIC_STRING_SIZE,
+                                 (double)usage->segment_size);
+  iotjs_jval_set_property_number(&jsegments, IOTJS_MAGIC_STRING_OCCUPIED,
+                                 (double)usage->segment_occupied_size);
+
+  double capacity = (double)usage->segment_count * usage->segment_size;
+  iotjs_jval_set_property_number(
+      &jsegments, IOTJS_MAGIC_STRING_UTILIZATION,
+      capacity > 0 ? usage->segment_occupied_size * 100.0 / capacity : 0);
+
+  iotjs_jval_t joccupancy = iotjs_jval_create_array(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    iotjs_jval_t joccupied = iotjs_jval_create_number(occupied_sizes[i]);
+    iotjs_jval_set_property_by_index(&joccupancy, i, &joccupied);
+    iotjs_jval_destroy(&joccupied);
+  }
+  iotjs_jval_set_property_jval(&jsegments, IOTJS_MAGIC_STRING_OCCUPANCY,
+                               &joccupancy);
+  iotjs_jval_destroy(&joccupancy);
+
+  return jsegments;
+}
+
+
+JHANDLER_FUNCTION(MemoryUsage) {
+  jerry_heap_usage_t usage;
+  jerry_get_heap_usage_stats(&usage);
+  jerry_gc_stats_t gc_stats;
+  jerry_get_gc_stats(&gc_stats);
+
+  // The segments are walked once, and their total is taken from the walk.
+  uint32_t segment_count = usage.segment_count;
+  size_t* occupied_sizes = NULL;
+  if (segment_count > 0) {
+    occupied_sizes =
+        (size_t*)iotjs_buffer_allocate(segment_count * sizeof(size_t));
+    uint32_t walked =
+        jerry_get_segment_occupancy(occupied_sizes, segment_count);
+    if (walked < segment_count) {
+      segment_count = walked;
+    }
+    usage.segment_count = segment_count;
+    usage.segment_occupied_size = 0;
+    for (uint32_t i = 0; i < segment_count; ++i) {
+      usage.segment_occupied_size += occupied_sizes[i];
+    }
+  }
+
+  size_t native_pool_free = 0;
+  for (const iotjs_pool_t* pool = iotjs_pool_list(); pool != NULL;
+       pool = pool->next) {
+    native_pool_free += pool->size * pool->free_count;
+  }
+
+  iotjs_jval_t jusage = iotjs_jval_create_object();
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_JSHEAP,
+                                 (double)usage.allocated_size);
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_JSHEAPPEAK,
+                                 (double)usage.peak_allocated_size);
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_JSHEAPSIZE,
+                                 (double)usage.size);
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_JSPOOLFREE,
+                                 (double)usage.pool_free_size);
+
+  iotjs_jval_t jsegments =
+      CreateSegmentUsage(&usage, occupied_sizes, segment_count);
+  iotjs_jval_set_property_jval(&jusage, IOTJS_MAGIC_STRING_SEGMENTS,
+                               &jsegments);
+  iotjs_jval_destroy(&jsegments);
+  if (occupied_sizes != NULL) {
+    iotjs_buffer_release((char*)occupied_sizes);
+  }
+
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_UVHEAP,
+                                 (double)*uv_get_heap_size_ptr());
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_NATIVE,
+                                 (double)iotjs_buffer_allocated_size());
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_BUFFERS,
+                                 (double)iotjs_bufferwrap_data_size());
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_NATIVEPOOLFREE,
+                                 (double)native_pool_free);
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_GCCOUNT,
+                                 gc_stats.count);
+  iotjs_jval_set_property_number(&jusage, IOTJS_MAGIC_STRING_GCPAUSETOTAL,
+                                 gc_stats.total_pause_us / 1000.0);
+
+  iotjs_jhandler_return_jval(jhandler, &jusage);
+  iotjs_jval_destroy(&jusage);
+}
+
+
+// process.setMemoryBudget({budget, moderate, critical})
+JHANDLER_FUNCTION(SetMemoryBudget) {
+  JHANDLER_CHECK_ARGS(1, object);
+  const iotjs_jval_t* joptions = JHANDLER_GET_ARG(0, object);
+  const Config* config = iotjs_environment_config(iotjs_environment_get());
+
+  double budget = GetGcTriggerOption(joptions, IOTJS_MAGIC_STRING_BUDGET, 0);
+  double moderate = GetGcTriggerOption(joptions, IOTJS_MAGIC_STRING_MODERATE,
+                                       config->memory_moderate_percent);
+  double critical = GetGcTriggerOption(joptions, IOTJS_MAGIC_STRING_CRITICAL,
+                                       config->memory_critical_percent);
+  if (!iotjs_memory_set_budget((size_t)budget, (unsigned)moderate,
+                               (unsigned)critical)) {
+    JHANDLER_THROW(RANGE, "moderate and critical must be rising percents");
+  }
+}
+
+
 static void SetProcessArgv(iotjs_jval_t* process) {
   const iotjs_environment_t* env = iotjs_environment_get();
   uint32_t argc = iotjs_environment_argc(env);
@@ -262,10 +1407,40 @@ iotjs_jval_t InitProcess() {
   iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_COMPILE, Compile);
   iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_COMPILENATIVEPTR,
                         CompileNativePtr);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_COMPILESNAPSHOT,
+                        CompileSnapshot);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_COMPILEBUNDLED,
+                        CompileBundled);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_COMPILECACHED,
+                        CompileCached);
   iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_READSOURCE, ReadSource);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_OPENBUNDLE, OpenBundle);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_PROBEBUNDLE, ProbeBundle);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_READBUNDLED, ReadBundled);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_SETGCTRIGGER,
+                        SetGcTrigger);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_SETMEMORYBUDGET,
+                        SetMemoryBudget);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING__BEGINNOGC, BeginNoGC);
   iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_CWD, Cwd);
   iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_CHDIR, Chdir);
   iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_DOEXIT, DoExit);
+#if IOTJS_ADDON_SUPPORTED
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_DLOPEN, DLOpen);
+#endif
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING__ENDNOGC, EndNoGC);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_GCSTATS, GcStats);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_LOOPSTATS, LoopStats);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING__MARKSTARTUP,
+                        MarkStartup);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_MEMORYSTATS, MemoryStats);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_MEMORYUSAGE, MemoryUsage);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_NEXTTICK, NextTick);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_POOLSTATS, PoolStats);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING_STARTUPTRACE,
+                        StartupTrace);
+  iotjs_jval_set_method(&process, IOTJS_MAGIC_STRING__RUNNEXTTICKS,
+                        RunNextTicks);
   SetProcessEnv(&process);
 
   // process.native_sources
@@ -292,6 +1467,8 @@ iotjs_jval_t InitProcess() {
 
   SetProcessArgv(&process);
 
+  SetProcessMemoryProfiler(&process);
+
   // Binding module id.
   iotjs_jval_t jbinding =
       iotjs_jval_get_property(&process, IOTJS_MAGIC_STRING_BINDING);
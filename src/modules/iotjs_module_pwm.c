@@ -50,9 +50,14 @@ static void iotjs_pwm_destroy(iotjs_pwm_t* pwm) {
 #define THIS iotjs_pwm_reqwrap_t* pwm_reqwrap
 
 
+IOTJS_DEFINE_POOL(pwm_reqwrap_pool, iotjs_pwm_reqwrap_t, "pwm",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 static iotjs_pwm_reqwrap_t* iotjs_pwm_reqwrap_create(
     const iotjs_jval_t* jcallback, iotjs_pwm_t* pwm, PwmOp op) {
-  iotjs_pwm_reqwrap_t* pwm_reqwrap = IOTJS_ALLOC(iotjs_pwm_reqwrap_t);
+  iotjs_pwm_reqwrap_t* pwm_reqwrap =
+      IOTJS_POOL_ALLOC(pwm_reqwrap_pool, iotjs_pwm_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_pwm_reqwrap_t, pwm_reqwrap);
 
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -68,7 +73,7 @@ static iotjs_pwm_reqwrap_t* iotjs_pwm_reqwrap_create(
 static void iotjs_pwm_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_pwm_reqwrap_t, pwm_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(pwm_reqwrap);
+  IOTJS_POOL_RELEASE(pwm_reqwrap_pool, pwm_reqwrap);
 }
 
 
@@ -78,7 +83,7 @@ static void iotjs_pwm_reqwrap_dispatched(THIS) {
 }
 
 
-static uv_work_t* iotjs_pwm_reqwrap_req(THIS) {
+static iotjs_bus_work_t* iotjs_pwm_reqwrap_req(THIS) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_reqwrap_t, pwm_reqwrap);
   return &_this->req;
 }
@@ -200,6 +205,13 @@ static void iotjs_pwm_after_worker(uv_work_t* work_req, int status) {
           iotjs_jargs_append_null(&jargs);
         }
         break;
+      case kPwmOpUpdate:
+        if (!result) {
+          iotjs_jargs_append_error(&jargs, "Failed to update PWM");
+        } else {
+          iotjs_jargs_append_null(&jargs);
+        }
+        break;
       case kPwmOpClose:
         if (!result) {
           iotjs_jargs_append_error(&jargs, "Cannot close PWM device");
@@ -215,7 +227,8 @@ static void iotjs_pwm_after_worker(uv_work_t* work_req, int status) {
   }
 
   const iotjs_jval_t* jcallback = iotjs_pwm_reqwrap_jcallback(req_wrap);
-  iotjs_make_callback(jcallback, iotjs_jval_get_undefined(), &jargs);
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, jcallback,
+                              iotjs_jval_get_undefined(), &jargs);
 
   iotjs_jargs_destroy(&jargs);
 
@@ -223,29 +236,194 @@ static void iotjs_pwm_after_worker(uv_work_t* work_req, int status) {
 }
 
 
-#define PWM_ASYNC(call, this, jcallback, op)                           \
-  do {                                                                 \
-    uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get()); \
-    iotjs_pwm_reqwrap_t* req_wrap =                                    \
-        iotjs_pwm_reqwrap_create(jcallback, this, op);                 \
-    uv_work_t* req = iotjs_pwm_reqwrap_req(req_wrap);                  \
-    uv_queue_work(loop, req, iotjs_pwm_##call##_worker,                \
-                  iotjs_pwm_after_worker);                             \
+#define PWM_ASYNC(call, this, jcallback, op)                                \
+  do {                                                                      \
+    iotjs_pwm_reqwrap_t* req_wrap =                                         \
+        iotjs_pwm_reqwrap_create(jcallback, this, op);                      \
+    iotjs_bus_work_t* req = iotjs_pwm_reqwrap_req(req_wrap);                \
+    iotjs_busqueue_work(iotjs_busqueue_peripheral(), req,                   \
+                        iotjs_pwm_##call##_worker, iotjs_pwm_after_worker); \
   } while (0)
 
 
-#define PWM_ASYNC_COMMON_WORKER(call, this, jcallback, op)                     \
-  do {                                                                         \
-    uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());         \
-    iotjs_pwm_reqwrap_t* req_wrap =                                            \
-        iotjs_pwm_reqwrap_create(jcallback, this, op);                         \
-    uv_work_t* req = iotjs_pwm_reqwrap_req(req_wrap);                          \
-    iotjs_pwm_reqdata_t* req_data = iotjs_pwm_reqwrap_data(req_wrap);          \
-    req_data->caller = call;                                                   \
-    uv_queue_work(loop, req, iotjs_pwm_common_worker, iotjs_pwm_after_worker); \
+#define PWM_ASYNC_COMMON_WORKER(call, this, jcallback, op)                \
+  do {                                                                    \
+    iotjs_pwm_reqwrap_t* req_wrap =                                       \
+        iotjs_pwm_reqwrap_create(jcallback, this, op);                    \
+    iotjs_bus_work_t* req = iotjs_pwm_reqwrap_req(req_wrap);              \
+    iotjs_pwm_reqdata_t* req_data = iotjs_pwm_reqwrap_data(req_wrap);     \
+    req_data->caller = call;                                              \
+    iotjs_busqueue_work(iotjs_busqueue_peripheral(), req,                 \
+                        iotjs_pwm_common_worker, iotjs_pwm_after_worker); \
   } while (0)
 
 
+// Applies the settings of `config` in one job. A disabled output is turned off
+// before and an enabled one on after the rest, and the duty cycle is set
+// first when the period gets shorter, so it never exceeds the period.
+static bool iotjs_pwm_update(iotjs_pwm_t* pwm) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+
+  uint8_t config = _this->config;
+  bool duty_first = _this->period < _this->last_period;
+
+  if ((config & kPwmConfigEnable) && !_this->enable &&
+      !iotjs_pwm_set_enable(pwm)) {
+    return false;
+  }
+  if ((config & kPwmConfigDutyCycle) && duty_first &&
+      !iotjs_pwm_set_dutycycle(pwm)) {
+    return false;
+  }
+  if ((config & kPwmConfigPeriod) && !iotjs_pwm_set_period(pwm)) {
+    return false;
+  }
+  if ((config & kPwmConfigDutyCycle) && !duty_first &&
+      !iotjs_pwm_set_dutycycle(pwm)) {
+    return false;
+  }
+  if ((config & kPwmConfigEnable) && _this->enable &&
+      !iotjs_pwm_set_enable(pwm)) {
+    return false;
+  }
+
+  return true;
+}
+
+
+// A sequence sets the duty cycles of a table one after another at a fixed
+// rate, on a thread of its own, so the steps do not depend on the timers of
+// the loop thread. The thread waits on a condition until each deadline, so a
+// stop does not wait for the step.
+struct iotjs_pwm_sequence_s {
+  iotjs_pwm_t* pwm;
+  iotjs_jval_t jcallback;
+  uv_thread_t thread;
+  uv_async_t async;
+  uv_mutex_t mutex;
+  uv_cond_t cond;
+
+  double* duty_cycles;
+  size_t count;
+  uint64_t interval;
+  bool loop;
+
+  // Guarded by `mutex`.
+  bool stopping;
+  bool failed;
+};
+
+
+static void iotjs_pwm_sequence_worker(void* arg) {
+  iotjs_pwm_sequence_t* sequence = (iotjs_pwm_sequence_t*)arg;
+  iotjs_pwm_t* pwm = sequence->pwm;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+
+  uint64_t deadline = uv_hrtime();
+  size_t index = 0;
+
+  uv_mutex_lock(&sequence->mutex);
+  while (!sequence->stopping) {
+    uv_mutex_unlock(&sequence->mutex);
+    _this->duty_cycle = sequence->duty_cycles[index];
+    bool result = iotjs_pwm_set_dutycycle(pwm);
+    uv_mutex_lock(&sequence->mutex);
+
+    if (!result) {
+      sequence->failed = true;
+      break;
+    }
+    if (++index == sequence->count) {
+      if (!sequence->loop) {
+        break;
+      }
+      index = 0;
+    }
+
+    // A step that came too late does not make the next ones hurry.
+    uint64_t now = uv_hrtime();
+    deadline += sequence->interval;
+    if (deadline < now) {
+      deadline = now;
+    }
+    while (!sequence->stopping && now < deadline) {
+      uv_cond_timedwait(&sequence->cond, &sequence->mutex, deadline - now);
+      now = uv_hrtime();
+    }
+  }
+  uv_mutex_unlock(&sequence->mutex);
+
+  uv_async_send(&sequence->async);
+}
+
+
+static void iotjs_pwm_sequence_release(uv_handle_t* handle) {
+  iotjs_pwm_sequence_t* sequence = (iotjs_pwm_sequence_t*)handle->data;
+
+  uv_cond_destroy(&sequence->cond);
+  uv_mutex_destroy(&sequence->mutex);
+  iotjs_buffer_release((char*)sequence->duty_cycles);
+  IOTJS_RELEASE(sequence);
+}
+
+
+static void iotjs_pwm_sequence_finish(iotjs_pwm_sequence_t* sequence) {
+  iotjs_pwm_t* pwm = sequence->pwm;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+
+  _this->sequence = NULL;
+  uv_thread_join(&sequence->thread);
+  iotjs_jval_destroy(&sequence->jcallback);
+  uv_close((uv_handle_t*)&sequence->async, iotjs_pwm_sequence_release);
+}
+
+
+// Calls back once the thread ended the sequence by itself.
+static void iotjs_pwm_sequence_done(uv_async_t* async) {
+  iotjs_pwm_sequence_t* sequence = (iotjs_pwm_sequence_t*)async->data;
+
+  uv_mutex_lock(&sequence->mutex);
+  bool stopping = sequence->stopping;
+  bool failed = sequence->failed;
+  uv_mutex_unlock(&sequence->mutex);
+
+  if (stopping) {
+    return;
+  }
+
+  iotjs_jval_t jcallback = iotjs_jval_create_copied(&sequence->jcallback);
+  iotjs_pwm_sequence_finish(sequence);
+
+  iotjs_jargs_t jargs = iotjs_jargs_create(1);
+  if (failed) {
+    iotjs_jargs_append_error(&jargs, "Failed to set duty-cycle");
+  } else {
+    iotjs_jargs_append_null(&jargs);
+  }
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, &jcallback,
+                              iotjs_jval_get_undefined(), &jargs);
+  iotjs_jargs_destroy(&jargs);
+  iotjs_jval_destroy(&jcallback);
+}
+
+
+static void iotjs_pwm_sequence_stop(iotjs_pwm_t* pwm) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+
+  iotjs_pwm_sequence_t* sequence = _this->sequence;
+  if (sequence == NULL) {
+    return;
+  }
+
+  uv_mutex_lock(&sequence->mutex);
+  sequence->stopping = true;
+  uv_cond_signal(&sequence->cond);
+  uv_mutex_unlock(&sequence->mutex);
+
+  iotjs_pwm_sequence_finish(sequence);
+}
+
+
 JHANDLER_FUNCTION(PWMConstructor) {
   DJHANDLER_CHECK_THIS(object);
   DJHANDLER_CHECK_ARGS(2, object, function);
@@ -274,6 +452,7 @@ JHANDLER_FUNCTION(SetPeriod) {
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+  iotjs_pwm_sequence_stop(pwm);
   _this->period = JHANDLER_GET_ARG(0, number);
 
   if (jcallback) {
@@ -298,6 +477,7 @@ JHANDLER_FUNCTION(SetDutyCycle) {
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+  iotjs_pwm_sequence_stop(pwm);
   _this->duty_cycle = JHANDLER_GET_ARG(0, number);
 
   if (jcallback) {
@@ -322,6 +502,7 @@ JHANDLER_FUNCTION(SetEnable) {
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+  iotjs_pwm_sequence_stop(pwm);
   _this->enable = JHANDLER_GET_ARG(0, boolean);
 
   if (jcallback) {
@@ -337,12 +518,144 @@ JHANDLER_FUNCTION(SetEnable) {
 }
 
 
+// update(config[, callback])
+// Applies the period, duty cycle and enable given in `config` in one job. A
+// new period keeps the ratio of the duty cycle.
+JHANDLER_FUNCTION(Update) {
+  JHANDLER_DECLARE_THIS_PTR(pwm, pwm);
+
+  DJHANDLER_CHECK_ARGS(1, object);
+  DJHANDLER_CHECK_ARG_IF_EXIST(1, function);
+
+  const iotjs_jval_t* jconfig = JHANDLER_GET_ARG(0, object);
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+  iotjs_pwm_sequence_stop(pwm);
+
+  iotjs_jval_t jperiod =
+      iotjs_jval_get_property(jconfig, IOTJS_MAGIC_STRING_PERIOD);
+  iotjs_jval_t jduty_cycle =
+      iotjs_jval_get_property(jconfig, IOTJS_MAGIC_STRING_DUTYCYCLE);
+  iotjs_jval_t jenable =
+      iotjs_jval_get_property(jconfig, IOTJS_MAGIC_STRING_ENABLE);
+
+  _this->config = 0;
+  _this->last_period = _this->period;
+  if (iotjs_jval_is_number(&jperiod)) {
+    _this->period = iotjs_jval_as_number(&jperiod);
+    _this->config |= kPwmConfigPeriod | kPwmConfigDutyCycle;
+  }
+  if (iotjs_jval_is_number(&jduty_cycle)) {
+    _this->duty_cycle = iotjs_jval_as_number(&jduty_cycle);
+    _this->config |= kPwmConfigDutyCycle;
+  }
+  if (iotjs_jval_is_boolean(&jenable)) {
+    _this->enable = iotjs_jval_as_boolean(&jenable);
+    _this->config |= kPwmConfigEnable;
+  }
+
+  iotjs_jval_destroy(&jperiod);
+  iotjs_jval_destroy(&jduty_cycle);
+  iotjs_jval_destroy(&jenable);
+
+  if (jcallback) {
+    PWM_ASYNC_COMMON_WORKER(iotjs_pwm_update, pwm, jcallback, kPwmOpUpdate);
+  } else {
+    if (!iotjs_pwm_update(pwm)) {
+      JHANDLER_THROW(COMMON, "PWM Update Error");
+    }
+  }
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
+// playSequence(dutyCycles, interval, loop, callback)
+// Sets the duty cycles one after another every `interval` microseconds,
+// over and over when `loop` is true. `callback` is called once the sequence
+// ended by itself.
+JHANDLER_FUNCTION(PlaySequence) {
+  JHANDLER_DECLARE_THIS_PTR(pwm, pwm);
+
+  DJHANDLER_CHECK_ARGS(4, array, number, boolean, function);
+
+  const iotjs_jval_t* jduty_cycles = JHANDLER_GET_ARG(0, array);
+  double interval = JHANDLER_GET_ARG(1, number);
+  bool loop = JHANDLER_GET_ARG(2, boolean);
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG(3, function);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_pwm_t, pwm);
+
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jduty_cycles, IOTJS_MAGIC_STRING_LENGTH);
+  size_t count = (size_t)iotjs_jval_as_number(&jlength);
+  iotjs_jval_destroy(&jlength);
+
+  if (count < 1 || count > IOTJS_PWM_SEQUENCE_MAX || interval < 1 ||
+      interval > 1000000) {
+    JHANDLER_THROW(RANGE, "Bad arguments - dutyCycles and interval");
+    return;
+  }
+  if (_this->period < 0) {
+    JHANDLER_THROW(COMMON, "PWM period is not set");
+    return;
+  }
+
+  iotjs_pwm_sequence_stop(pwm);
+
+  iotjs_pwm_sequence_t* sequence = IOTJS_ALLOC(iotjs_pwm_sequence_t);
+  sequence->pwm = pwm;
+  sequence->count = count;
+  sequence->interval = (uint64_t)interval * 1000;
+  sequence->loop = loop;
+  sequence->duty_cycles =
+      (double*)iotjs_buffer_allocate(count * sizeof(double));
+  for (size_t i = 0; i < count; ++i) {
+    iotjs_jval_t jduty_cycle =
+        iotjs_jval_get_property_by_index(jduty_cycles, (uint32_t)i);
+    sequence->duty_cycles[i] = iotjs_jval_as_number(&jduty_cycle);
+    iotjs_jval_destroy(&jduty_cycle);
+  }
+  sequence->jcallback = iotjs_jval_create_copied(jcallback);
+
+  uv_mutex_init(&sequence->mutex);
+  uv_cond_init(&sequence->cond);
+  uv_async_init(iotjs_environment_loop(iotjs_environment_get()),
+                &sequence->async, iotjs_pwm_sequence_done);
+  sequence->async.data = sequence;
+
+  if (uv_thread_create(&sequence->thread, iotjs_pwm_sequence_worker,
+                       sequence) != 0) {
+    iotjs_jval_destroy(&sequence->jcallback);
+    uv_close((uv_handle_t*)&sequence->async, iotjs_pwm_sequence_release);
+    JHANDLER_THROW(COMMON, "Cannot start PWM sequence");
+    return;
+  }
+
+  _this->sequence = sequence;
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
+JHANDLER_FUNCTION(StopSequence) {
+  JHANDLER_DECLARE_THIS_PTR(pwm, pwm);
+
+  iotjs_pwm_sequence_stop(pwm);
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
 JHANDLER_FUNCTION(Close) {
   JHANDLER_DECLARE_THIS_PTR(pwm, pwm);
   DJHANDLER_CHECK_ARG_IF_EXIST(0, function);
 
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(0, function);
 
+  iotjs_pwm_sequence_stop(pwm);
+
   if (jcallback) {
     PWM_ASYNC_COMMON_WORKER(iotjs_pwm_close, pwm, jcallback, kPwmOpClose);
   } else {
@@ -365,6 +678,11 @@ iotjs_jval_t InitPwm() {
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_SETDUTYCYCLE,
                         SetDutyCycle);
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_SETENABLE, SetEnable);
+  iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_UPDATE, Update);
+  iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_PLAYSEQUENCE,
+                        PlaySequence);
+  iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_STOPSEQUENCE,
+                        StopSequence);
   iotjs_jval_set_method(&jprototype, IOTJS_MAGIC_STRING_CLOSE, Close);
 
   iotjs_jval_set_property_jval(&jpwm_constructor, IOTJS_MAGIC_STRING_PROTOTYPE,
@@ -18,6 +18,7 @@
 #define IOTJS_MODULE_PWM_H
 
 #include "iotjs_def.h"
+#include "iotjs_busqueue.h"
 #include "iotjs_objectwrap.h"
 #include "iotjs_reqwrap.h"
 
@@ -33,10 +34,25 @@ typedef enum {
   kPwmOpSetPeriod,
   kPwmOpSetFrequency,
   kPwmOpSetEnable,
+  kPwmOpUpdate,
   kPwmOpClose,
 } PwmOp;
 
 
+// The settings an update applies.
+typedef enum {
+  kPwmConfigPeriod = 1 << 0,
+  kPwmConfigDutyCycle = 1 << 1,
+  kPwmConfigEnable = 1 << 2,
+} PwmConfig;
+
+
+// Steps of a duty cycle sequence.
+#define IOTJS_PWM_SEQUENCE_MAX 4096
+
+typedef struct iotjs_pwm_sequence_s iotjs_pwm_sequence_t;
+
+
 typedef struct {
   iotjs_jobjectwrap_t jobjectwrap;
 
@@ -52,6 +68,13 @@ typedef struct {
   double duty_cycle;
   double period;
   bool enable;
+
+  // The settings of an update, and the period before it.
+  uint8_t config;
+  double last_period;
+
+  // The sequence playing, or NULL.
+  iotjs_pwm_sequence_t* sequence;
 } IOTJS_VALIDATED_STRUCT(iotjs_pwm_t);
 
 
@@ -67,7 +90,7 @@ typedef struct {
 
 typedef struct {
   iotjs_reqwrap_t reqwrap;
-  uv_work_t req;
+  iotjs_bus_work_t req;
   iotjs_pwm_reqdata_t req_data;
   iotjs_pwm_t* pwm_instance;
 } IOTJS_VALIDATED_STRUCT(iotjs_pwm_reqwrap_t);
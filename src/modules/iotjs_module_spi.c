@@ -42,6 +42,9 @@ static void iotjs_spi_destroy(iotjs_spi_t* spi) {
 
 #if defined(__linux__)
   iotjs_string_destroy(&_this->device);
+  if (_this->bus_queue != NULL) {
+    iotjs_busqueue_release(_this->bus_queue);
+  }
 #endif
 
   IOTJS_RELEASE(spi);
@@ -51,9 +54,14 @@ static void iotjs_spi_destroy(iotjs_spi_t* spi) {
 #define THIS iotjs_spi_reqwrap_t* spi_reqwrap
 
 
+IOTJS_DEFINE_POOL(spi_reqwrap_pool, iotjs_spi_reqwrap_t, "spi",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 static iotjs_spi_reqwrap_t* iotjs_spi_reqwrap_create(
     const iotjs_jval_t* jcallback, iotjs_spi_t* spi, SpiOp op) {
-  iotjs_spi_reqwrap_t* spi_reqwrap = IOTJS_ALLOC(iotjs_spi_reqwrap_t);
+  iotjs_spi_reqwrap_t* spi_reqwrap =
+      IOTJS_POOL_ALLOC(spi_reqwrap_pool, iotjs_spi_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_spi_reqwrap_t, spi_reqwrap);
 
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -68,7 +76,7 @@ static iotjs_spi_reqwrap_t* iotjs_spi_reqwrap_create(
 static void iotjs_spi_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_spi_reqwrap_t, spi_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(spi_reqwrap);
+  IOTJS_POOL_RELEASE(spi_reqwrap_pool, spi_reqwrap);
 }
 
 
@@ -78,7 +86,7 @@ static void iotjs_spi_reqwrap_dispatched(THIS) {
 }
 
 
-static uv_work_t* iotjs_spi_reqwrap_req(THIS) {
+static iotjs_bus_work_t* iotjs_spi_reqwrap_req(THIS) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_reqwrap_t, spi_reqwrap);
   return &_this->req;
 }
@@ -182,6 +190,7 @@ static void iotjs_spi_set_configuration(iotjs_spi_t* spi,
       iotjs_jval_get_property(joptions, IOTJS_MAGIC_STRING_DEVICE);
   _this->device = iotjs_jval_as_string(&jdevice);
   iotjs_jval_destroy(&jdevice);
+  _this->bus_queue = iotjs_busqueue_acquire(iotjs_string_data(&_this->device));
 #elif defined(__NUTTX__) || defined(__TIZENRT__)
   iotjs_jval_t jbus = iotjs_jval_get_property(joptions, IOTJS_MAGIC_STRING_BUS);
   _this->bus = iotjs_jval_as_number(&jbus);
@@ -301,7 +310,8 @@ static void iotjs_spi_after_work(uv_work_t* work_req, int status) {
   }
 
   const iotjs_jval_t* jcallback = iotjs_spi_reqwrap_jcallback(req_wrap);
-  iotjs_make_callback(jcallback, iotjs_jval_get_undefined(), &jargs);
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, jcallback,
+                              iotjs_jval_get_undefined(), &jargs);
 
   iotjs_jargs_destroy(&jargs);
 
@@ -315,13 +325,25 @@ iotjs_spi_t* iotjs_spi_get_instance(const iotjs_jval_t* jspi) {
 }
 
 
-#define SPI_ASYNC(call, this, jcallback, op)                                   \
-  do {                                                                         \
-    uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());         \
-    iotjs_spi_reqwrap_t* req_wrap =                                            \
-        iotjs_spi_reqwrap_create(jcallback, this, op);                         \
-    uv_work_t* req = iotjs_spi_reqwrap_req(req_wrap);                          \
-    uv_queue_work(loop, req, iotjs_spi_##call##_worker, iotjs_spi_after_work); \
+// The bus queue of `spi` on Linux, where the device is named. The requests
+// of other platforms go to the threadpool.
+static iotjs_busqueue_t* iotjs_spi_bus_queue(iotjs_spi_t* spi) {
+#if defined(__linux__)
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
+  return _this->bus_queue;
+#else
+  return NULL;
+#endif
+}
+
+
+#define SPI_ASYNC(call, this, jcallback, op)                              \
+  do {                                                                    \
+    iotjs_spi_reqwrap_t* req_wrap =                                       \
+        iotjs_spi_reqwrap_create(jcallback, this, op);                    \
+    iotjs_bus_work_t* req = iotjs_spi_reqwrap_req(req_wrap);              \
+    iotjs_busqueue_work(iotjs_spi_bus_queue(this), req,                   \
+                        iotjs_spi_##call##_worker, iotjs_spi_after_work); \
   } while (0)
 
 
@@ -402,6 +424,254 @@ JHANDLER_FUNCTION(TransferBuffer) {
 }
 
 
+// A stream repeats the transfer of one frame back to back on a thread of its
+// own. The thread fills the chunks of `frames` received frames in turn, and
+// the loop thread hands each filled chunk to JS as a Buffer and gives it back
+// to the thread. When JS holds the stream, filled chunks wait, and so does the
+// thread once none is free.
+#define SPI_STREAM_CHUNKS 2
+
+struct iotjs_spi_stream_s {
+  iotjs_spi_t* spi;
+  iotjs_jval_t jspi;
+  uv_thread_t thread;
+  uv_async_t async;
+  uv_mutex_t mutex;
+  uv_cond_t cond;
+
+  char* tx_frame;
+  size_t frame_len;
+  uint32_t frames;
+  char* chunks[SPI_STREAM_CHUNKS];
+
+  // Guarded by `mutex`.
+  bool filled[SPI_STREAM_CHUNKS];
+  bool failed;
+  bool stopping;
+
+  // Used by the loop thread only.
+  size_t next_chunk;
+  bool held;
+};
+
+
+static void iotjs_spi_stream_worker(void* arg) {
+  iotjs_spi_stream_t* stream = (iotjs_spi_stream_t*)arg;
+  size_t index = 0;
+
+  uv_mutex_lock(&stream->mutex);
+  while (!stream->stopping) {
+    if (stream->filled[index]) {
+      uv_cond_wait(&stream->cond, &stream->mutex);
+      continue;
+    }
+    uv_mutex_unlock(&stream->mutex);
+
+    bool result =
+        iotjs_spi_transfer_frames(stream->spi, stream->tx_frame,
+                                  stream->frame_len, stream->chunks[index],
+                                  stream->frames);
+
+    uv_mutex_lock(&stream->mutex);
+    if (!result) {
+      stream->failed = true;
+      uv_async_send(&stream->async);
+      break;
+    }
+    stream->filled[index] = true;
+    uv_async_send(&stream->async);
+    index = (index + 1) % SPI_STREAM_CHUNKS;
+  }
+  uv_mutex_unlock(&stream->mutex);
+}
+
+
+// Calls `onData(err, data)` of the SPI object. JS returns false to hold the
+// stream.
+static bool iotjs_spi_stream_emit(iotjs_spi_stream_t* stream,
+                                  iotjs_jargs_t* jargs) {
+  iotjs_jval_t jon_data =
+      iotjs_jval_get_property(&stream->jspi, IOTJS_MAGIC_STRING_ONDATA);
+  bool hold = false;
+
+  if (iotjs_jval_is_function(&jon_data)) {
+    iotjs_jval_t jres =
+        iotjs_make_callback_with_result(&jon_data, &stream->jspi, jargs);
+    hold = iotjs_jval_is_boolean(&jres) && !iotjs_jval_as_boolean(&jres);
+    iotjs_jval_destroy(&jres);
+  }
+
+  iotjs_jval_destroy(&jon_data);
+  return hold;
+}
+
+
+static void iotjs_spi_stream_deliver(uv_async_t* async) {
+  iotjs_spi_stream_t* stream = (iotjs_spi_stream_t*)async->data;
+  size_t chunk_len = stream->frame_len * stream->frames;
+
+  // JS may stop the stream in a callback, which keeps the memory of the
+  // stream until the async handle is closed.
+  while (!stream->held) {
+    size_t index = stream->next_chunk;
+
+    uv_mutex_lock(&stream->mutex);
+    bool stopping = stream->stopping;
+    bool filled = stream->filled[index];
+    bool failed = !filled && stream->failed;
+    if (failed) {
+      stream->failed = false;
+    }
+    uv_mutex_unlock(&stream->mutex);
+
+    if (stopping || (!filled && !failed)) {
+      return;
+    }
+
+    iotjs_jargs_t jargs = iotjs_jargs_create(2);
+
+    if (failed) {
+      iotjs_jargs_append_error(&jargs, "Cannot transfer from SPI device");
+      iotjs_spi_stream_emit(stream, &jargs);
+      iotjs_jargs_destroy(&jargs);
+      return;
+    }
+
+    iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(chunk_len);
+    iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+    iotjs_bufferwrap_copy(buffer, stream->chunks[index], chunk_len);
+
+    uv_mutex_lock(&stream->mutex);
+    stream->filled[index] = false;
+    uv_cond_signal(&stream->cond);
+    uv_mutex_unlock(&stream->mutex);
+    stream->next_chunk = (index + 1) % SPI_STREAM_CHUNKS;
+
+    iotjs_jargs_append_null(&jargs);
+    iotjs_jargs_append_jval(&jargs, &jbuffer);
+    stream->held = iotjs_spi_stream_emit(stream, &jargs);
+    iotjs_jargs_destroy(&jargs);
+    iotjs_jval_destroy(&jbuffer);
+  }
+}
+
+
+static void iotjs_spi_stream_release(uv_handle_t* handle) {
+  iotjs_spi_stream_t* stream = (iotjs_spi_stream_t*)handle->data;
+
+  uv_cond_destroy(&stream->cond);
+  uv_mutex_destroy(&stream->mutex);
+  for (size_t i = 0; i < SPI_STREAM_CHUNKS; ++i) {
+    iotjs_buffer_release(stream->chunks[i]);
+  }
+  iotjs_buffer_release(stream->tx_frame);
+  IOTJS_RELEASE(stream);
+}
+
+
+static void iotjs_spi_stream_stop(iotjs_spi_t* spi) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
+
+  iotjs_spi_stream_t* stream = _this->stream;
+  if (stream == NULL) {
+    return;
+  }
+  _this->stream = NULL;
+
+  uv_mutex_lock(&stream->mutex);
+  stream->stopping = true;
+  uv_cond_signal(&stream->cond);
+  uv_mutex_unlock(&stream->mutex);
+
+  // The thread finishes the chunk it is filling.
+  uv_thread_join(&stream->thread);
+
+  iotjs_jval_destroy(&stream->jspi);
+  uv_close((uv_handle_t*)&stream->async, iotjs_spi_stream_release);
+}
+
+
+// streamStart(frame, frames)
+// Starts transferring `frame`, a Buffer, over and over, and calls onData() of
+// the SPI object with Buffers of `frames` received frames.
+JHANDLER_FUNCTION(StreamStart) {
+  JHANDLER_DECLARE_THIS_PTR(spi, spi);
+  DJHANDLER_CHECK_ARGS(2, object, number);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
+
+  iotjs_bufferwrap_t* frame =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(0, object));
+  size_t frame_len = iotjs_bufferwrap_length(frame);
+  double frames = JHANDLER_GET_ARG(1, number);
+
+  if (_this->stream != NULL) {
+    JHANDLER_THROW(COMMON, "SPI stream is already started");
+    return;
+  }
+  if (frame_len == 0 || frames < 1 ||
+      frame_len * frames > IOTJS_SPI_STREAM_CHUNK_MAX) {
+    JHANDLER_THROW(RANGE, "Bad arguments - frame and frames");
+    return;
+  }
+
+  iotjs_spi_stream_t* stream = IOTJS_ALLOC(iotjs_spi_stream_t);
+  stream->spi = spi;
+  stream->jspi = iotjs_jval_create_copied(JHANDLER_GET_THIS(object));
+  stream->frame_len = frame_len;
+  stream->frames = (uint32_t)frames;
+  stream->tx_frame = iotjs_buffer_allocate(frame_len);
+  memcpy(stream->tx_frame, iotjs_bufferwrap_buffer(frame), frame_len);
+  for (size_t i = 0; i < SPI_STREAM_CHUNKS; ++i) {
+    stream->chunks[i] = iotjs_buffer_allocate(frame_len * stream->frames);
+  }
+
+  uv_mutex_init(&stream->mutex);
+  uv_cond_init(&stream->cond);
+  uv_async_init(iotjs_environment_loop(iotjs_environment_get()),
+                &stream->async, iotjs_spi_stream_deliver);
+  stream->async.data = stream;
+
+  if (uv_thread_create(&stream->thread, iotjs_spi_stream_worker, stream) !=
+      0) {
+    iotjs_jval_destroy(&stream->jspi);
+    uv_close((uv_handle_t*)&stream->async, iotjs_spi_stream_release);
+    JHANDLER_THROW(COMMON, "Cannot start SPI stream");
+    return;
+  }
+
+  _this->stream = stream;
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
+// streamResume()
+// Delivers the chunks held since onData() returned false.
+JHANDLER_FUNCTION(StreamResume) {
+  JHANDLER_DECLARE_THIS_PTR(spi, spi);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
+
+  iotjs_spi_stream_t* stream = _this->stream;
+  if (stream != NULL && stream->held) {
+    stream->held = false;
+    uv_async_send(&stream->async);
+  }
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
+JHANDLER_FUNCTION(StreamStop) {
+  JHANDLER_DECLARE_THIS_PTR(spi, spi);
+
+  iotjs_spi_stream_stop(spi);
+
+  iotjs_jhandler_return_null(jhandler);
+}
+
+
 JHANDLER_FUNCTION(Close) {
   JHANDLER_DECLARE_THIS_PTR(spi, spi);
 
@@ -409,6 +679,8 @@ JHANDLER_FUNCTION(Close) {
 
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(0, function);
 
+  iotjs_spi_stream_stop(spi);
+
   if (jcallback) {
     SPI_ASYNC(close, spi, jcallback, kSpiOpClose);
   } else {
@@ -432,6 +704,11 @@ iotjs_jval_t InitSpi() {
                         TransferArray);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_TRANSFERBUFFER,
                         TransferBuffer);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_STREAMSTART,
+                        StreamStart);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_STREAMRESUME,
+                        StreamResume);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_STREAMSTOP, StreamStop);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_CLOSE, Close);
   iotjs_jval_set_property_jval(&jspiConstructor, IOTJS_MAGIC_STRING_PROTOTYPE,
                                &prototype);
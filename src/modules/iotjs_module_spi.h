@@ -18,6 +18,7 @@
 #define IOTJS_MODULE_SPI_H
 
 #include "iotjs_def.h"
+#include "iotjs_busqueue.h"
 #include "iotjs_module_buffer.h"
 #include "iotjs_objectwrap.h"
 #include "iotjs_reqwrap.h"
@@ -54,11 +55,20 @@ typedef enum {
 typedef enum { kSpiOrderMsb, kSpiOrderLsb } SpiOrder;
 
 
+// The most bytes one chunk of a stream holds.
+#define IOTJS_SPI_STREAM_CHUNK_MAX (64 * 1024)
+
+// The state of a stream of transfers, private to the SPI module.
+typedef struct iotjs_spi_stream_s iotjs_spi_stream_t;
+
+
 typedef struct {
   iotjs_jobjectwrap_t jobjectwrap;
 #if defined(__linux__)
   iotjs_string_t device;
   int32_t device_fd;
+  // The queue of the requests to the device.
+  iotjs_busqueue_t* bus_queue;
 #elif defined(__NUTTX__)
   int bus;
   uint32_t cs_chip;
@@ -80,6 +90,9 @@ typedef struct {
   char* rx_buf_data;
   uint8_t buf_len;
 
+  // The running stream, or NULL.
+  iotjs_spi_stream_t* stream;
+
 } IOTJS_VALIDATED_STRUCT(iotjs_spi_t);
 
 
@@ -91,7 +104,7 @@ typedef struct {
 
 typedef struct {
   iotjs_reqwrap_t reqwrap;
-  uv_work_t req;
+  iotjs_bus_work_t req;
   iotjs_spi_reqdata_t req_data;
   iotjs_spi_t* spi_instance;
 } IOTJS_VALIDATED_STRUCT(iotjs_spi_reqwrap_t);
@@ -114,6 +127,11 @@ iotjs_spi_t* iotjs_spi_instance_from_reqwrap(THIS);
 
 
 bool iotjs_spi_transfer(iotjs_spi_t* spi);
+// Sends `tx` of `len` bytes `count` times, and receives the frames into
+// `rx` one after another. Called on the thread of a stream, so it touches
+// none of the transfer buffers of `spi`.
+bool iotjs_spi_transfer_frames(iotjs_spi_t* spi, const char* tx, size_t len,
+                               char* rx, uint32_t count);
 bool iotjs_spi_close(iotjs_spi_t* spi);
 
 void iotjs_spi_open_worker(uv_work_t* work_req);
@@ -18,32 +18,98 @@
 #include "iotjs_module_tcp.h"
 
 #include "iotjs_handlewrap.h"
+#include "iotjs_memory.h"
 #include "iotjs_module_buffer.h"
+#include "iotjs_probes.h"
 #include "iotjs_reqwrap.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 
 IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(tcpwrap);
 
 
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnRead, IOTJS_TCP_ONREAD)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(Owner, IOTJS_TCP_OWNER)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnConnection, IOTJS_TCP_ONCONNECTION)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnClose, IOTJS_TCP_ONCLOSE)
+
+
+// Moves the data read from a socket to another one without the onread
+// callback. The source holds a reference until it is destroyed, every write
+// in flight another one, and the consumer of a sink one until it detaches.
+// The destination object is kept alive, so its handle can be checked until
+// then.
+struct iotjs_tcp_splice_t {
+  uv_stream_t* src;
+  uv_stream_t* dst;
+  iotjs_jval_t jdst;
+  // Takes the data instead of `dst`, when it is not a socket.
+  const iotjs_tcp_sink_t* sink;
+  void* sink_data;
+  size_t high_water_mark;
+  uint32_t refs;
+  bool paused;
+  bool failed;
+};
+
+
+typedef struct {
+  uv_write_t req;
+  char* base;
+  iotjs_tcp_splice_t* splice;
+} iotjs_tcp_splice_write_t;
+
+
+IOTJS_DEFINE_POOL(splice_write_pool, iotjs_tcp_splice_write_t, "tcp.splice",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
+static void iotjs_tcp_splice_unref(iotjs_tcp_splice_t* splice) {
+  if (--splice->refs == 0) {
+    iotjs_jval_destroy(&splice->jdst);
+    IOTJS_RELEASE(splice);
+  }
+}
+
+
+IOTJS_DEFINE_POOL(tcpwrap_pool, iotjs_tcpwrap_t, "tcp",
+                  IOTJS_HANDLEWRAP_POOL_CAP);
+
+
 iotjs_tcpwrap_t* iotjs_tcpwrap_create(const iotjs_jval_t* jtcp) {
-  iotjs_tcpwrap_t* tcpwrap = IOTJS_ALLOC(iotjs_tcpwrap_t);
+  iotjs_tcpwrap_t* tcpwrap = IOTJS_POOL_ALLOC(tcpwrap_pool, iotjs_tcpwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_tcpwrap_t, tcpwrap);
 
   iotjs_handlewrap_initialize(&_this->handlewrap, jtcp,
                               (uv_handle_t*)(&_this->handle),
                               &this_module_native_info);
+  iotjs_handlewrap_initialize_callbacks(&_this->handlewrap, _this->jcallbacks,
+                                        IOTJS_TCP_CALLBACK_COUNT);
 
   const iotjs_environment_t* env = iotjs_environment_get();
   uv_tcp_init(iotjs_environment_loop(env), &_this->handle);
 
+  _this->accept_limit = -1;
+  iotjs_read_sizer_init(&_this->read_sizer);
+
   return tcpwrap;
 }
 
 
 static void iotjs_tcpwrap_destroy(iotjs_tcpwrap_t* tcpwrap) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_tcpwrap_t, tcpwrap);
+  if (_this->splice != NULL) {
+    _this->splice->src = NULL;
+    iotjs_tcp_splice_unref(_this->splice);
+  }
   iotjs_handlewrap_destroy(&_this->handlewrap);
-  IOTJS_RELEASE(tcpwrap);
+  IOTJS_POOL_RELEASE(tcpwrap_pool, tcpwrap);
 }
 
 
@@ -75,16 +141,27 @@ iotjs_jval_t* iotjs_tcpwrap_jobject(iotjs_tcpwrap_t* tcpwrap) {
 }
 
 
+const iotjs_jval_t* iotjs_tcpwrap_jcallback(iotjs_tcpwrap_t* tcpwrap,
+                                            iotjs_tcp_callback_t index) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcpwrap);
+  return iotjs_handlewrap_jcallback(&_this->handlewrap, index);
+}
+
+
 #define THIS iotjs_connect_reqwrap_t* connect_reqwrap
 
 
 static void iotjs_connect_reqwrap_destroy(THIS);
 
 
+IOTJS_DEFINE_POOL(connect_reqwrap_pool, iotjs_connect_reqwrap_t, "tcp.connect",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 iotjs_connect_reqwrap_t* iotjs_connect_reqwrap_create(
     const iotjs_jval_t* jcallback) {
   iotjs_connect_reqwrap_t* connect_reqwrap =
-      IOTJS_ALLOC(iotjs_connect_reqwrap_t);
+      IOTJS_POOL_ALLOC(connect_reqwrap_pool, iotjs_connect_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_connect_reqwrap_t, connect_reqwrap);
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
   return connect_reqwrap;
@@ -94,7 +171,7 @@ iotjs_connect_reqwrap_t* iotjs_connect_reqwrap_create(
 static void iotjs_connect_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_connect_reqwrap_t, connect_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(connect_reqwrap);
+  IOTJS_POOL_RELEASE(connect_reqwrap_pool, connect_reqwrap);
 }
 
 
@@ -125,9 +202,14 @@ const iotjs_jval_t* iotjs_connect_reqwrap_jcallback(THIS) {
 static void iotjs_write_reqwrap_destroy(THIS);
 
 
+IOTJS_DEFINE_POOL(write_reqwrap_pool, iotjs_write_reqwrap_t, "tcp.write",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 iotjs_write_reqwrap_t* iotjs_write_reqwrap_create(
     const iotjs_jval_t* jcallback) {
-  iotjs_write_reqwrap_t* write_reqwrap = IOTJS_ALLOC(iotjs_write_reqwrap_t);
+  iotjs_write_reqwrap_t* write_reqwrap =
+      IOTJS_POOL_ALLOC(write_reqwrap_pool, iotjs_write_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_write_reqwrap_t, write_reqwrap);
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
   return write_reqwrap;
@@ -137,7 +219,7 @@ iotjs_write_reqwrap_t* iotjs_write_reqwrap_create(
 static void iotjs_write_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_write_reqwrap_t, write_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(write_reqwrap);
+  IOTJS_POOL_RELEASE(write_reqwrap_pool, write_reqwrap);
 }
 
 
@@ -168,10 +250,14 @@ const iotjs_jval_t* iotjs_write_reqwrap_jcallback(THIS) {
 static void iotjs_shutdown_reqwrap_destroy(THIS);
 
 
+IOTJS_DEFINE_POOL(shutdown_reqwrap_pool, iotjs_shutdown_reqwrap_t,
+                  "tcp.shutdown", IOTJS_REQWRAP_POOL_CAP);
+
+
 iotjs_shutdown_reqwrap_t* iotjs_shutdown_reqwrap_create(
     const iotjs_jval_t* jcallback) {
   iotjs_shutdown_reqwrap_t* shutdown_reqwrap =
-      IOTJS_ALLOC(iotjs_shutdown_reqwrap_t);
+      IOTJS_POOL_ALLOC(shutdown_reqwrap_pool, iotjs_shutdown_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_shutdown_reqwrap_t,
                                      shutdown_reqwrap);
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -182,7 +268,7 @@ iotjs_shutdown_reqwrap_t* iotjs_shutdown_reqwrap_create(
 static void iotjs_shutdown_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_shutdown_reqwrap_t, shutdown_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(shutdown_reqwrap);
+  IOTJS_POOL_RELEASE(shutdown_reqwrap_pool, shutdown_reqwrap);
 }
 
 
@@ -207,6 +293,56 @@ const iotjs_jval_t* iotjs_shutdown_reqwrap_jcallback(THIS) {
 #undef THIS
 
 
+#define THIS iotjs_sendfile_reqwrap_t* sendfile_reqwrap
+
+
+static void iotjs_sendfile_reqwrap_destroy(THIS);
+
+
+IOTJS_DEFINE_POOL(sendfile_reqwrap_pool, iotjs_sendfile_reqwrap_t,
+                  "tcp.sendfile", IOTJS_REQWRAP_POOL_CAP);
+
+
+iotjs_sendfile_reqwrap_t* iotjs_sendfile_reqwrap_create(
+    const iotjs_jval_t* jcallback) {
+  iotjs_sendfile_reqwrap_t* sendfile_reqwrap =
+      IOTJS_POOL_ALLOC(sendfile_reqwrap_pool, iotjs_sendfile_reqwrap_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_sendfile_reqwrap_t,
+                                     sendfile_reqwrap);
+  iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
+  return sendfile_reqwrap;
+}
+
+
+static void iotjs_sendfile_reqwrap_destroy(THIS) {
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_sendfile_reqwrap_t, sendfile_reqwrap);
+  uv_fs_req_cleanup(&_this->req);
+  iotjs_reqwrap_destroy(&_this->reqwrap);
+  IOTJS_POOL_RELEASE(sendfile_reqwrap_pool, sendfile_reqwrap);
+}
+
+
+void iotjs_sendfile_reqwrap_dispatched(THIS) {
+  IOTJS_VALIDATABLE_STRUCT_METHOD_VALIDATE(iotjs_sendfile_reqwrap_t,
+                                           sendfile_reqwrap);
+  iotjs_sendfile_reqwrap_destroy(sendfile_reqwrap);
+}
+
+
+uv_fs_t* iotjs_sendfile_reqwrap_req(THIS) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sendfile_reqwrap_t, sendfile_reqwrap);
+  return &_this->req;
+}
+
+
+const iotjs_jval_t* iotjs_sendfile_reqwrap_jcallback(THIS) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_sendfile_reqwrap_t, sendfile_reqwrap);
+  return iotjs_reqwrap_jcallback(&_this->reqwrap);
+}
+
+#undef THIS
+
+
 JHANDLER_FUNCTION(TCP) {
   DJHANDLER_CHECK_THIS(object);
   DJHANDLER_CHECK_ARGS(0);
@@ -217,7 +353,17 @@ JHANDLER_FUNCTION(TCP) {
 }
 
 
+// Wraps an already connected socket.
+// [0] file descriptor
 JHANDLER_FUNCTION(Open) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  int fd = JHANDLER_GET_ARG(0, number);
+  int err = uv_tcp_open(iotjs_tcpwrap_tcp_handle(tcp_wrap), fd);
+
+  iotjs_jhandler_return_number(jhandler, err);
 }
 
 
@@ -225,15 +371,18 @@ JHANDLER_FUNCTION(Open) {
 void AfterClose(uv_handle_t* handle) {
   iotjs_handlewrap_t* wrap = iotjs_handlewrap_from_handle(handle);
 
-  // tcp object.
-  const iotjs_jval_t* jtcp = iotjs_handlewrap_jobject(wrap);
+  // The splice keeps its destination object alive. Two sockets piped to
+  // each other would keep both objects for good if it waited for them to
+  // be freed.
+  iotjs_tcp_splice_stop(iotjs_tcpwrap_from_handle((uv_tcp_t*)handle));
 
   // callback function.
-  iotjs_jval_t jcallback =
-      iotjs_jval_get_property(jtcp, IOTJS_MAGIC_STRING_ONCLOSE);
+  iotjs_jval_t jcallback = iotjs_jval_create_copied(
+      iotjs_handlewrap_jcallback(wrap, IOTJS_TCP_ONCLOSE));
   if (iotjs_jval_is_function(&jcallback)) {
-    iotjs_make_callback(&jcallback, iotjs_jval_get_undefined(),
-                        iotjs_jargs_get_empty());
+    iotjs_make_callback_in_lane(kCallbackLaneNormal, &jcallback,
+                                iotjs_jval_get_undefined(),
+                                iotjs_jargs_get_empty());
   }
   iotjs_jval_destroy(&jcallback);
 }
@@ -253,6 +402,7 @@ JHANDLER_FUNCTION(Close) {
 // start listening.
 // [0] address
 // [1] port
+// [2] reusePort (optional) - share the port with other listening sockets
 JHANDLER_FUNCTION(Bind) {
   JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
 
@@ -260,13 +410,19 @@ JHANDLER_FUNCTION(Bind) {
 
   iotjs_string_t address = JHANDLER_GET_ARG(0, string);
   int port = JHANDLER_GET_ARG(1, number);
+  const iotjs_jval_t* jreuse_port = JHANDLER_GET_ARG_IF_EXIST(2, boolean);
+
+  unsigned int flags = 0;
+  if (jreuse_port != NULL && iotjs_jval_as_boolean(jreuse_port)) {
+    flags |= UV_TCP_REUSEPORT;
+  }
 
   sockaddr_in addr;
   int err = uv_ip4_addr(iotjs_string_data(&address), port, &addr);
 
   if (err == 0) {
     err = uv_tcp_bind(iotjs_tcpwrap_tcp_handle(tcp_wrap),
-                      (const sockaddr*)(&addr), 0);
+                      (const sockaddr*)(&addr), flags);
   }
 
   iotjs_jhandler_return_number(jhandler, err);
@@ -275,6 +431,63 @@ JHANDLER_FUNCTION(Bind) {
 }
 
 
+// Sets the buffer sizes asked for on a socket that has a descriptor.
+static int iotjs_tcp_apply_buffer_sizes(iotjs_tcpwrap_t* tcp_wrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  uv_handle_t* handle = (uv_handle_t*)&_this->handle;
+
+  int err = 0;
+  if (_this->recv_buffer_size > 0) {
+    int size = _this->recv_buffer_size;
+    err = uv_recv_buffer_size(handle, &size);
+  }
+  if (err == 0 && _this->send_buffer_size > 0) {
+    int size = _this->send_buffer_size;
+    err = uv_send_buffer_size(handle, &size);
+  }
+  return err;
+}
+
+
+// The buffer sizes of a connection, and fast open on the client side, have
+// to be set before connect(), while libuv creates the socket right before
+// it. A socket is created beforehand for them.
+static int iotjs_tcp_prepare_connect(iotjs_tcpwrap_t* tcp_wrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  uv_handle_t* handle = (uv_handle_t*)&_this->handle;
+
+  if (_this->recv_buffer_size == 0 && _this->send_buffer_size == 0 &&
+      _this->fast_open == 0) {
+    return 0;
+  }
+
+  uv_os_fd_t fd;
+  if (uv_fileno(handle, &fd) != 0) {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+      return -errno;
+    }
+    int err = uv_tcp_open(&_this->handle, fd);
+    if (err) {
+      close(fd);
+      return err;
+    }
+  }
+
+  int err = iotjs_tcp_apply_buffer_sizes(tcp_wrap);
+#if defined(TCP_FASTOPEN_CONNECT)
+  if (err == 0 && _this->fast_open > 0) {
+    int enable = 1;
+    if (setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enable,
+                   sizeof(enable)) != 0) {
+      err = -errno;
+    }
+  }
+#endif
+  return err;
+}
+
+
 // Connection request result handler.
 static void AfterConnect(uv_connect_t* req, int status) {
   iotjs_connect_reqwrap_t* req_wrap = (iotjs_connect_reqwrap_t*)(req->data);
@@ -316,6 +529,10 @@ JHANDLER_FUNCTION(Connect) {
   sockaddr_in addr;
   int err = uv_ip4_addr(iotjs_string_data(&address), port, &addr);
 
+  if (err == 0) {
+    err = iotjs_tcp_prepare_connect(tcp_wrap);
+  }
+
   if (err == 0) {
     // Create connection request wrapper.
     iotjs_connect_reqwrap_t* req_wrap = iotjs_connect_reqwrap_create(jcallback);
@@ -340,6 +557,105 @@ JHANDLER_FUNCTION(Connect) {
 // Parameters:
 //   * uv_stream_t* handle - server handle
 //   * int status - status code
+// Most connections accepted for one wakeup of a listening socket.
+#define IOTJS_TCP_ACCEPT_BATCH 16
+
+
+// Creates the tcp object of an accepted connection with `createTCP` of the
+// server, and opens `fd` in it, or the connection libuv has accepted when
+// `fd` is -1. Returns whether the object was stored in `jclients`.
+static bool iotjs_tcp_accept_one(const iotjs_jval_t* jcreate_tcp,
+                                 uv_stream_t* server, int fd,
+                                 iotjs_jval_t* jclients, uint32_t index) {
+  iotjs_jval_t jclient_tcp =
+      iotjs_jhelper_call_ok(jcreate_tcp, iotjs_jval_get_undefined(),
+                            iotjs_jargs_get_empty());
+  IOTJS_ASSERT(iotjs_jval_is_object(&jclient_tcp));
+
+  iotjs_tcpwrap_t* tcp_wrap_client =
+      (iotjs_tcpwrap_t*)(iotjs_jval_get_object_native_handle(&jclient_tcp));
+  uv_tcp_t* client_handle = iotjs_tcpwrap_tcp_handle(tcp_wrap_client);
+
+  int err;
+  if (fd < 0) {
+    err = uv_accept(server, (uv_stream_t*)client_handle);
+  } else {
+    err = uv_tcp_open(client_handle, fd);
+    if (err) {
+      close(fd);
+    }
+  }
+
+  if (err == 0) {
+    iotjs_jval_set_property_by_index(jclients, index, &jclient_tcp);
+  } else {
+    // Nothing refers to the object but its handle.
+    iotjs_handlewrap_close(
+        iotjs_handlewrap_from_handle((uv_handle_t*)client_handle), NULL);
+  }
+
+  iotjs_jval_destroy(&jclient_tcp);
+  return err == 0;
+}
+
+
+// Accepts the connections waiting on a listening socket into an array of tcp
+// objects, up to its accept limit and IOTJS_TCP_ACCEPT_BATCH. The first is
+// the one libuv has accepted, if any; the others are accepted from the
+// socket directly, so a burst of connections is delivered by one callback.
+static iotjs_jval_t iotjs_tcp_accept_batch(iotjs_tcpwrap_t* tcp_wrap,
+                                           uint32_t* count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  uv_stream_t* server = (uv_stream_t*)&_this->handle;
+
+  iotjs_jval_t jcreate_tcp =
+      iotjs_jval_get_property(iotjs_tcpwrap_jobject(tcp_wrap),
+                              IOTJS_MAGIC_STRING_CREATETCP);
+  IOTJS_ASSERT(iotjs_jval_is_function(&jcreate_tcp));
+
+  int limit = IOTJS_TCP_ACCEPT_BATCH;
+  if (_this->accept_limit >= 0 && _this->accept_limit < limit) {
+    limit = _this->accept_limit;
+  }
+
+  uv_os_fd_t fd;
+  bool has_fd = uv_fileno((uv_handle_t*)server, &fd) == 0;
+
+  iotjs_jval_t jclients = iotjs_jval_create_array(0);
+  *count = 0;
+
+  for (int i = 0; i < limit; i++) {
+    int client_fd = -1;
+    if (server->accepted_fd == -1) {
+      // Errors other than an empty backlog are reported by libuv, which
+      // accepts again once this callback returns.
+      client_fd = has_fd ? accept(fd, NULL, NULL) : -1;
+      if (client_fd < 0) {
+        break;
+      }
+#if defined(FD_CLOEXEC)
+      fcntl(client_fd, F_SETFD, FD_CLOEXEC);
+#endif
+    }
+
+    if (iotjs_tcp_accept_one(&jcreate_tcp, server, client_fd, &jclients,
+                             *count)) {
+      (*count)++;
+    }
+  }
+
+  if (_this->accept_limit > 0) {
+    _this->accept_limit -= (int)*count;
+  }
+
+  iotjs_jval_destroy(&jcreate_tcp);
+  return jclients;
+}
+
+
+// A listening socket has connections to accept. At the accept limit, the
+// connection libuv has accepted is left to it, and libuv stops watching the
+// socket until `accept()` takes the connection.
 static void OnConnection(uv_stream_t* handle, int status) {
   // Server tcp wrapper.
   iotjs_tcpwrap_t* tcp_wrap = iotjs_tcpwrap_from_handle((uv_tcp_t*)handle);
@@ -347,71 +663,113 @@ static void OnConnection(uv_stream_t* handle, int status) {
   // Tcp object
   const iotjs_jval_t* jtcp = iotjs_tcpwrap_jobject(tcp_wrap);
 
-  // `onconnection` callback.
-  iotjs_jval_t jonconnection =
-      iotjs_jval_get_property(jtcp, IOTJS_MAGIC_STRING_ONCONNECTION);
-  IOTJS_ASSERT(iotjs_jval_is_function(&jonconnection));
-
   // The callback takes two parameter
   // [0] status
-  // [1] client tcp object
+  // [1] array of client tcp objects
   iotjs_jargs_t args = iotjs_jargs_create(2);
   iotjs_jargs_append_number(&args, status);
 
   if (status == 0) {
-    // Create client socket handle wrapper.
-    iotjs_jval_t jcreate_tcp =
-        iotjs_jval_get_property(jtcp, IOTJS_MAGIC_STRING_CREATETCP);
-    IOTJS_ASSERT(iotjs_jval_is_function(&jcreate_tcp));
-
-    iotjs_jval_t jclient_tcp =
-        iotjs_jhelper_call_ok(&jcreate_tcp, iotjs_jval_get_undefined(),
-                              iotjs_jargs_get_empty());
-    IOTJS_ASSERT(iotjs_jval_is_object(&jclient_tcp));
-
-    iotjs_tcpwrap_t* tcp_wrap_client =
-        (iotjs_tcpwrap_t*)(iotjs_jval_get_object_native_handle(&jclient_tcp));
-
-    uv_stream_t* client_handle =
-        (uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap_client));
+    uint32_t count;
+    iotjs_jval_t jclients = iotjs_tcp_accept_batch(tcp_wrap, &count);
+    iotjs_jargs_append_jval(&args, &jclients);
+    iotjs_jval_destroy(&jclients);
 
-    int err = uv_accept(handle, client_handle);
-    if (err) {
+    if (count == 0) {
       iotjs_jargs_destroy(&args);
       return;
     }
-
-    iotjs_jargs_append_jval(&args, &jclient_tcp);
-    iotjs_jval_destroy(&jcreate_tcp);
-    iotjs_jval_destroy(&jclient_tcp);
   }
 
-  iotjs_make_callback(&jonconnection, jtcp, &args);
+  // `onconnection` callback.
+  iotjs_jval_t jonconnection = iotjs_jval_create_copied(
+      iotjs_tcpwrap_jcallback(tcp_wrap, IOTJS_TCP_ONCONNECTION));
+  IOTJS_ASSERT(iotjs_jval_is_function(&jonconnection));
+
+  iotjs_make_callback_in_lane(kCallbackLaneNormal, &jonconnection, jtcp, &args);
 
   iotjs_jval_destroy(&jonconnection);
   iotjs_jargs_destroy(&args);
 }
 
 
+// Sets the number of connections a listening socket may still accept.
+// [0] limit, -1 for no limit
+JHANDLER_FUNCTION(SetAcceptLimit) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  _this->accept_limit = JHANDLER_GET_ARG(0, number);
+
+  iotjs_jhandler_return_undefined(jhandler);
+}
+
+
+// Accepts the connections waiting on a listening socket, up to its accept
+// limit, and returns their tcp objects. Called when the limit is raised,
+// as libuv does not watch the socket again until its connection is taken.
+JHANDLER_FUNCTION(Accept) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  DJHANDLER_CHECK_ARGS(0);
+
+  uint32_t count;
+  iotjs_jval_t jclients = iotjs_tcp_accept_batch(tcp_wrap, &count);
+  iotjs_jhandler_return_jval(jhandler, &jclients);
+  iotjs_jval_destroy(&jclients);
+}
+
+
 JHANDLER_FUNCTION(Listen) {
   JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
   DJHANDLER_CHECK_ARGS(1, number);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
 
   int backlog = JHANDLER_GET_ARG(0, number);
 
-  int err = uv_listen((uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap)),
-                      backlog, OnConnection);
+  // Accepted connections inherit the buffer sizes of the listening socket.
+  int err = iotjs_tcp_apply_buffer_sizes(tcp_wrap);
+
+  // The number of connections whose SYN data waits to be accepted.
+#if defined(TCP_FASTOPEN)
+  uv_os_fd_t fd;
+  if (err == 0 && _this->fast_open > 0 &&
+      uv_fileno((uv_handle_t*)&_this->handle, &fd) == 0) {
+    int qlen = _this->fast_open;
+    if (setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &qlen, sizeof(qlen)) != 0) {
+      err = -errno;
+    }
+  }
+#endif
+
+  if (err == 0) {
+    err = uv_listen((uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap)),
+                    backlog, OnConnection);
+  }
 
   iotjs_jhandler_return_number(jhandler, err);
 }
 
 
+// Publishes the bytes the kernel has not taken yet as the `writeQueueSize`
+// property of the socket, which the stream holds back the next chunk on.
+static void iotjs_tcp_update_write_queue_size(iotjs_tcpwrap_t* tcp_wrap,
+                                              uv_stream_t* stream) {
+  iotjs_jval_set_property_number_by_key(iotjs_tcpwrap_jobject(tcp_wrap),
+                                        IOTJS_PROPKEY_WRITEQUEUESIZE,
+                                        stream->write_queue_size);
+}
+
+
 void AfterWrite(uv_write_t* req, int status) {
   iotjs_write_reqwrap_t* req_wrap = (iotjs_write_reqwrap_t*)(req->data);
   iotjs_tcpwrap_t* tcp_wrap = (iotjs_tcpwrap_t*)(req->handle->data);
   IOTJS_ASSERT(req_wrap != NULL);
   IOTJS_ASSERT(tcp_wrap != NULL);
 
+  IOTJS_PROBE2(tcp__write__done, req->handle->io_watcher.fd, status);
+  iotjs_tcp_update_write_queue_size(tcp_wrap, req->handle);
+
   // Take callback function object.
   const iotjs_jval_t* jcallback = iotjs_write_reqwrap_jcallback(req_wrap);
 
@@ -446,42 +804,190 @@ JHANDLER_FUNCTION(Write) {
   const iotjs_jval_t* arg1 = JHANDLER_GET_ARG(1, object);
   iotjs_write_reqwrap_t* req_wrap = iotjs_write_reqwrap_create(arg1);
 
-  int err = uv_write(iotjs_write_reqwrap_req(req_wrap),
-                     (uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap)), &buf,
-                     1, AfterWrite);
+  uv_stream_t* stream = (uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap));
+  int err = uv_write(iotjs_write_reqwrap_req(req_wrap), stream, &buf, 1,
+                     AfterWrite);
+
+  if (err) {
+    iotjs_write_reqwrap_dispatched(req_wrap);
+  } else {
+    iotjs_tcp_update_write_queue_size(tcp_wrap, stream);
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+static void AfterSendFile(uv_fs_t* req) {
+  iotjs_sendfile_reqwrap_t* req_wrap = (iotjs_sendfile_reqwrap_t*)(req->data);
+  IOTJS_ASSERT(req_wrap != NULL);
+
+  // function onSendFile(status, bytes)
+  const iotjs_jval_t* jcallback = iotjs_sendfile_reqwrap_jcallback(req_wrap);
+
+  iotjs_jargs_t args = iotjs_jargs_create(2);
+  if (req->result < 0) {
+    iotjs_jargs_append_number(&args, req->result);
+    iotjs_jargs_append_number(&args, 0);
+  } else {
+    iotjs_jargs_append_number(&args, 0);
+    iotjs_jargs_append_number(&args, req->result);
+  }
+
+  iotjs_make_callback(jcallback, iotjs_jval_get_undefined(), &args);
+
+  iotjs_jargs_destroy(&args);
+
+  iotjs_sendfile_reqwrap_dispatched(req_wrap);
+}
+
+
+// Sends up to `length` bytes of a file from `offset` by sendfile(2) in the
+// thread pool, so the data goes to the socket without passing through a
+// buffer of JavaScript. The callback gets the bytes sent, which may be fewer.
+// What is queued to the socket before has to be written out by then.
+// [0] fd of the file
+// [1] offset
+// [2] length
+// [3] callback
+JHANDLER_FUNCTION(SendFile) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  DJHANDLER_CHECK_ARGS(4, number, number, number, function);
+
+  int in_fd = JHANDLER_GET_ARG(0, number);
+  int64_t offset = JHANDLER_GET_ARG(1, number);
+  size_t length = JHANDLER_GET_ARG(2, number);
+
+  uv_handle_t* handle = (uv_handle_t*)iotjs_tcpwrap_tcp_handle(tcp_wrap);
+  uv_os_fd_t out_fd;
+  int err = uv_fileno(handle, &out_fd);
+  if (err) {
+    iotjs_jhandler_return_number(jhandler, err);
+    return;
+  }
+
+  const iotjs_jval_t* jcallback = JHANDLER_GET_ARG(3, object);
+  iotjs_sendfile_reqwrap_t* req_wrap =
+      iotjs_sendfile_reqwrap_create(jcallback);
+
+  err = uv_fs_sendfile(iotjs_environment_loop(iotjs_environment_get()),
+                       iotjs_sendfile_reqwrap_req(req_wrap), out_fd, in_fd,
+                       offset, length, AfterSendFile);
+
+  if (err) {
+    iotjs_sendfile_reqwrap_dispatched(req_wrap);
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Number of buffers of a vectored write described on the stack.
+#define IOTJS_TCP_WRITEV_INLINE_BUFS 8
+
+
+// Writes the buffers of an array by a single request.
+// [0] array of buffers
+// [1] callback
+JHANDLER_FUNCTION(Writev) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  DJHANDLER_CHECK_ARGS(2, object, function);
+
+  const iotjs_jval_t* jchunks = JHANDLER_GET_ARG(0, object);
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jchunks, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t count = iotjs_jval_is_number(&jlength)
+                       ? (uint32_t)iotjs_jval_as_number(&jlength)
+                       : 0;
+  iotjs_jval_destroy(&jlength);
+  JHANDLER_CHECK(count > 0);
+
+  // libuv copies the descriptors into the request, the memory of the buffers
+  // is kept alive by the callback referring to the array.
+  uv_buf_t bufs_inline[IOTJS_TCP_WRITEV_INLINE_BUFS];
+  uv_buf_t* bufs = bufs_inline;
+  if (count > IOTJS_TCP_WRITEV_INLINE_BUFS) {
+    bufs = (uv_buf_t*)iotjs_buffer_allocate(sizeof(uv_buf_t) * count);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    iotjs_jval_t jbuffer = iotjs_jval_get_property_by_index(jchunks, i);
+    IOTJS_ASSERT(iotjs_jval_is_object(&jbuffer));
+    iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+    bufs[i].base = iotjs_bufferwrap_buffer(buffer_wrap);
+    bufs[i].len = iotjs_bufferwrap_length(buffer_wrap);
+    iotjs_jval_destroy(&jbuffer);
+  }
+
+  const iotjs_jval_t* arg1 = JHANDLER_GET_ARG(1, object);
+  iotjs_write_reqwrap_t* req_wrap = iotjs_write_reqwrap_create(arg1);
+
+  uv_stream_t* stream = (uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap));
+  int err = uv_write(iotjs_write_reqwrap_req(req_wrap), stream, bufs, count,
+                     AfterWrite);
 
   if (err) {
     iotjs_write_reqwrap_dispatched(req_wrap);
+  } else {
+    iotjs_tcp_update_write_queue_size(tcp_wrap, stream);
+  }
+
+  if (bufs != bufs_inline) {
+    iotjs_buffer_release((char*)bufs);
   }
 
   iotjs_jhandler_return_number(jhandler, err);
 }
 
 
+// The buffers are sized by the reads of the socket, so that a socket which
+// receives small messages does not take the largest buffers of the pool.
 void OnAlloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
-  if (suggested_size > IOTJS_MAX_READ_BUFFER_SIZE) {
-    suggested_size = IOTJS_MAX_READ_BUFFER_SIZE;
+  iotjs_tcpwrap_t* tcp_wrap = iotjs_tcpwrap_from_handle((uv_tcp_t*)handle);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+
+  size_t size = iotjs_read_sizer_next(&_this->read_sizer, suggested_size);
+  buf->base = iotjs_read_buffer_allocate(&size);
+  buf->len = size;
+}
+
+
+// Counts a read of the socket for the size of the next buffer.
+static void iotjs_tcpwrap_count_read(iotjs_tcpwrap_t* tcp_wrap, ssize_t nread,
+                                     const uv_buf_t* buf) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  if (nread > 0) {
+    iotjs_read_sizer_update(&_this->read_sizer, (size_t)nread, buf->len);
   }
+}
 
-  buf->base = iotjs_buffer_allocate(suggested_size);
-  buf->len = suggested_size;
+
+// The data of a socket has been passed to onread, which may have stopped
+// reading, or left it to go on.
+static void iotjs_tcp_after_onread(const iotjs_jval_t* jtcp) {
+  iotjs_tcpwrap_t* tcp_wrap = iotjs_tcpwrap_from_jobject(jtcp);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+
+  if (_this->is_lane_paused && !uv_is_closing((uv_handle_t*)&_this->handle)) {
+    iotjs_tcp_read_start(tcp_wrap);
+  }
 }
 
 
 void OnRead(uv_stream_t* handle, ssize_t nread, const uv_buf_t* buf) {
   iotjs_tcpwrap_t* tcp_wrap = iotjs_tcpwrap_from_handle((uv_tcp_t*)handle);
-
-  // tcp handle
-  const iotjs_jval_t* jtcp = iotjs_tcpwrap_jobject(tcp_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  IOTJS_PROBE2(tcp__read, handle->io_watcher.fd, nread);
+  iotjs_tcpwrap_count_read(tcp_wrap, nread, buf);
 
   // socket object
-  iotjs_jval_t jsocket =
-      iotjs_jval_get_property(jtcp, IOTJS_MAGIC_STRING_OWNER);
+  iotjs_jval_t jsocket = iotjs_jval_create_copied(
+      iotjs_tcpwrap_jcallback(tcp_wrap, IOTJS_TCP_OWNER));
   IOTJS_ASSERT(iotjs_jval_is_object(&jsocket));
 
   // onread callback
-  iotjs_jval_t jonread =
-      iotjs_jval_get_property(jtcp, IOTJS_MAGIC_STRING_ONREAD);
+  iotjs_jval_t jonread = iotjs_jval_create_copied(
+      iotjs_tcpwrap_jcallback(tcp_wrap, IOTJS_TCP_ONREAD));
   IOTJS_ASSERT(iotjs_jval_is_function(&jonread));
 
   iotjs_jargs_t jargs = iotjs_jargs_create(4);
@@ -491,26 +997,31 @@ void OnRead(uv_stream_t* handle, ssize_t nread, const uv_buf_t* buf) {
 
   if (nread <= 0) {
     if (buf->base != NULL) {
-      iotjs_buffer_release(buf->base);
+      iotjs_read_buffer_release(buf->base);
     }
     if (nread < 0) {
       if (nread == UV__EOF) {
         iotjs_jargs_replace(&jargs, 2, iotjs_jval_get_boolean(true));
       }
 
-      iotjs_make_callback(&jonread, iotjs_jval_get_undefined(), &jargs);
+      iotjs_make_callback_in_lane(kCallbackLaneNormal, &jonread,
+                                  iotjs_jval_get_undefined(), &jargs);
     }
   } else {
-    iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer((size_t)nread);
-    iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
-
-    iotjs_bufferwrap_copy(buffer_wrap, buf->base, (size_t)nread);
+    // The read buffer becomes the memory of the Buffer object.
+    iotjs_jval_t jbuffer =
+        iotjs_bufferwrap_adopt_buffer(buf->base, buf->len, (size_t)nread);
 
     iotjs_jargs_append_jval(&jargs, &jbuffer);
-    iotjs_make_callback(&jonread, iotjs_jval_get_undefined(), &jargs);
+    iotjs_make_callback_in_lane_then(kCallbackLaneNormal, &jonread,
+                                     iotjs_tcpwrap_jobject(tcp_wrap), &jargs,
+                                     iotjs_tcp_after_onread);
+
+    // libtuv would read on in this pass, before onread can stop it.
+    uv_read_stop(handle);
+    _this->is_lane_paused = true;
 
     iotjs_jval_destroy(&jbuffer);
-    iotjs_buffer_release(buf->base);
   }
 
   iotjs_jargs_destroy(&jargs);
@@ -519,11 +1030,260 @@ void OnRead(uv_stream_t* handle, ssize_t nread, const uv_buf_t* buf) {
 }
 
 
+static void OnSpliceRead(uv_stream_t* handle, ssize_t nread,
+                         const uv_buf_t* buf);
+
+
+// Passes a failed write on to onread of the source as a read error, once.
+static void iotjs_tcp_splice_fail(iotjs_tcp_splice_t* splice, int err,
+                                  const uv_buf_t* buf) {
+  uv_read_stop(splice->src);
+  if (splice->failed) {
+    if (buf->base != NULL) {
+      iotjs_read_buffer_release(buf->base);
+    }
+    return;
+  }
+
+  splice->failed = true;
+  OnRead(splice->src, err, buf);
+}
+
+
+static void AfterSpliceWrite(uv_write_t* req, int status) {
+  iotjs_tcp_splice_write_t* write = (iotjs_tcp_splice_write_t*)req;
+  iotjs_tcp_splice_t* splice = write->splice;
+
+  iotjs_read_buffer_release(write->base);
+  IOTJS_POOL_RELEASE(splice_write_pool, write);
+
+  if (splice->src != NULL && !uv_is_closing((uv_handle_t*)splice->src)) {
+    if (status < 0) {
+      uv_buf_t none = uv_buf_init(NULL, 0);
+      iotjs_tcp_splice_fail(splice, status, &none);
+    } else if (splice->paused && !splice->failed &&
+               splice->dst->write_queue_size <= splice->high_water_mark) {
+      // The destination caught up.
+      splice->paused = false;
+      uv_read_start(splice->src, OnAlloc, OnSpliceRead);
+    }
+  }
+
+  iotjs_tcp_splice_unref(splice);
+}
+
+
+static void OnSpliceRead(uv_stream_t* handle, ssize_t nread,
+                         const uv_buf_t* buf) {
+  iotjs_tcpwrap_t* tcp_wrap = iotjs_tcpwrap_from_handle((uv_tcp_t*)handle);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  iotjs_tcp_splice_t* splice = _this->splice;
+
+  // The end of the data and read errors go to onread as usual.
+  if (nread <= 0) {
+    OnRead(handle, nread, buf);
+    return;
+  }
+  iotjs_tcpwrap_count_read(tcp_wrap, nread, buf);
+
+  if (splice->sink != NULL) {
+    int err = splice->sink->write(splice->sink_data, buf->base, (size_t)nread);
+    if (err) {
+      iotjs_tcp_splice_fail(splice, err, buf);
+    } else if (splice->sink->queued(splice->sink_data) >
+               splice->high_water_mark) {
+      uv_read_stop(handle);
+      splice->paused = true;
+    }
+    return;
+  }
+
+  if (uv_is_closing((uv_handle_t*)splice->dst)) {
+    iotjs_tcp_splice_fail(splice, UV__EPIPE, buf);
+    return;
+  }
+
+  iotjs_tcp_splice_write_t* write =
+      IOTJS_POOL_ALLOC(splice_write_pool, iotjs_tcp_splice_write_t);
+  write->base = buf->base;
+  write->splice = splice;
+
+  uv_buf_t data = uv_buf_init(buf->base, (unsigned int)nread);
+  int err = uv_write(&write->req, splice->dst, &data, 1, AfterSpliceWrite);
+  if (err) {
+    IOTJS_POOL_RELEASE(splice_write_pool, write);
+    iotjs_tcp_splice_fail(splice, err, buf);
+    return;
+  }
+  splice->refs++;
+
+  // Stop reading while the destination cannot keep up.
+  if (splice->dst->write_queue_size > splice->high_water_mark) {
+    uv_read_stop(handle);
+    splice->paused = true;
+  }
+}
+
+
+int iotjs_tcp_read_start(iotjs_tcpwrap_t* tcp_wrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  if (iotjs_memory_pressure() == kMemoryPressureCritical) {
+    _this->is_memory_paused = true;
+    return 0;
+  }
+
+  _this->is_memory_paused = false;
+  _this->is_lane_paused = false;
+  return uv_read_start((uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap)),
+                       OnAlloc, _this->splice != NULL ? OnSpliceRead : OnRead);
+}
+
+
 JHANDLER_FUNCTION(ReadStart) {
   JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
 
-  int err = uv_read_start((uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap)),
-                          OnAlloc, OnRead);
+  int err = iotjs_tcp_read_start(tcp_wrap);
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+static int iotjs_tcp_splice_start(iotjs_tcpwrap_t* tcp_wrap,
+                                  iotjs_tcp_splice_t* splice) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+
+  splice->src = (uv_stream_t*)&_this->handle;
+  splice->refs = 1;
+  _this->splice = splice;
+
+  // A socket that is reading switches to the destination right away.
+  if (uv_is_active((uv_handle_t*)splice->src)) {
+    return uv_read_start(splice->src, OnAlloc, OnSpliceRead);
+  }
+  return 0;
+}
+
+
+int iotjs_tcp_splice_to_sink(iotjs_tcpwrap_t* tcp_wrap,
+                             const iotjs_tcp_sink_t* sink, void* sink_data,
+                             size_t high_water_mark,
+                             iotjs_tcp_splice_t** splice_out) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  if (_this->splice != NULL) {
+    return UV__EINVAL;
+  }
+
+  iotjs_tcp_splice_t* splice = IOTJS_ALLOC(iotjs_tcp_splice_t);
+  splice->jdst = iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  splice->sink = sink;
+  splice->sink_data = sink_data;
+  splice->high_water_mark = high_water_mark;
+
+  int err = iotjs_tcp_splice_start(tcp_wrap, splice);
+  splice->refs++;
+  *splice_out = splice;
+  return err;
+}
+
+
+void iotjs_tcp_splice_drained(iotjs_tcpwrap_t* tcp_wrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  iotjs_tcp_splice_t* splice = _this->splice;
+
+  if (splice != NULL && splice->sink != NULL && splice->paused &&
+      !splice->failed && !uv_is_closing((uv_handle_t*)splice->src) &&
+      splice->sink->queued(splice->sink_data) <= splice->high_water_mark) {
+    splice->paused = false;
+    uv_read_start(splice->src, OnAlloc, OnSpliceRead);
+  }
+}
+
+
+void iotjs_tcp_splice_stop(iotjs_tcpwrap_t* tcp_wrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  iotjs_tcp_splice_t* splice = _this->splice;
+  if (splice == NULL) {
+    return;
+  }
+
+  // The handle is not taken from the handle wrapper, which may be closed.
+  uv_stream_t* stream = (uv_stream_t*)&_this->handle;
+  if (!uv_is_closing((uv_handle_t*)stream) && !splice->failed &&
+      (splice->paused || uv_is_active((uv_handle_t*)stream))) {
+    uv_read_start(stream, OnAlloc, OnRead);
+  }
+
+  _this->splice = NULL;
+  splice->src = NULL;
+  iotjs_tcp_splice_unref(splice);
+}
+
+
+static int iotjs_tcp_detached_sink_write(void* data, char* base,
+                                         size_t length) {
+  IOTJS_UNUSED(data);
+  IOTJS_UNUSED(length);
+  iotjs_read_buffer_release(base);
+  return 0;
+}
+
+
+static size_t iotjs_tcp_detached_sink_queued(void* data) {
+  IOTJS_UNUSED(data);
+  return 0;
+}
+
+
+static const iotjs_tcp_sink_t iotjs_tcp_detached_sink = {
+  iotjs_tcp_detached_sink_write, iotjs_tcp_detached_sink_queued,
+};
+
+
+// The consumer may be freed right after, while the socket still reads.
+void iotjs_tcp_splice_detach(iotjs_tcp_splice_t* splice) {
+  splice->sink = &iotjs_tcp_detached_sink;
+  splice->sink_data = NULL;
+  iotjs_tcp_splice_unref(splice);
+}
+
+
+// Writes the data read from now on to another socket, pausing while more
+// than `highWaterMark` bytes wait to be written to it.
+// [0] destination tcp object
+// [1] highWaterMark
+JHANDLER_FUNCTION(Splice) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  DJHANDLER_CHECK_ARGS(2, object, number);
+
+  const iotjs_jval_t* jdst = JHANDLER_GET_ARG(0, object);
+  iotjs_tcpwrap_t* dst_wrap = iotjs_tcpwrap_from_jobject(jdst);
+  double high_water_mark = JHANDLER_GET_ARG(1, number);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  if (_this->splice != NULL || dst_wrap == tcp_wrap) {
+    iotjs_jhandler_return_number(jhandler, UV__EINVAL);
+    return;
+  }
+
+  iotjs_tcp_splice_t* splice = IOTJS_ALLOC(iotjs_tcp_splice_t);
+  splice->dst = (uv_stream_t*)iotjs_tcpwrap_tcp_handle(dst_wrap);
+  splice->jdst = iotjs_jval_create_copied(jdst);
+  splice->high_water_mark =
+      high_water_mark > 0 ? (size_t)high_water_mark : 0;
+
+  int err = iotjs_tcp_splice_start(tcp_wrap, splice);
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+JHANDLER_FUNCTION(ReadStop) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  _this->is_memory_paused = false;
+  _this->is_lane_paused = false;
+
+  int err = uv_read_stop((uv_stream_t*)(iotjs_tcpwrap_tcp_handle(tcp_wrap)));
 
   iotjs_jhandler_return_number(jhandler, err);
 }
@@ -586,6 +1346,75 @@ JHANDLER_FUNCTION(SetKeepAlive) {
   iotjs_jhandler_return_number(jhandler, err);
 }
 
+// Enable/Disable the Nagle algorithm, which holds small writes back until
+// the data sent before is acknowledged.
+// [0] enable
+JHANDLER_FUNCTION(SetNoDelay) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  int enable = JHANDLER_GET_ARG(0, number);
+
+  int err = uv_tcp_nodelay(iotjs_tcpwrap_tcp_handle(tcp_wrap), enable);
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Sets the sizes of the kernel buffers of the socket. Zero leaves a size as
+// it is. A socket not created yet takes them when it connects or listens;
+// accepted connections take them from the listening socket.
+// [0] receive buffer size
+// [1] send buffer size
+JHANDLER_FUNCTION(SetBufferSize) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  DJHANDLER_CHECK_ARGS(2, number, number);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  _this->recv_buffer_size = JHANDLER_GET_ARG(0, number);
+  _this->send_buffer_size = JHANDLER_GET_ARG(1, number);
+
+  int err = 0;
+  uv_os_fd_t fd;
+  if (uv_fileno((uv_handle_t*)&_this->handle, &fd) == 0) {
+    err = iotjs_tcp_apply_buffer_sizes(tcp_wrap);
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Enables TCP Fast Open, from the next connect or listen. A client sends the
+// data of its first write with the SYN; a server accepts that data for up
+// to `qlen` connections waiting at once. Where the system has no fast open,
+// connections are opened as usual.
+// [0] qlen
+JHANDLER_FUNCTION(SetFastOpen) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+  _this->fast_open = JHANDLER_GET_ARG(0, number);
+
+  iotjs_jhandler_return_number(jhandler, 0);
+}
+
+
+// Whether the socket keeps the event loop alive.
+JHANDLER_FUNCTION(Ref) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+
+  uv_ref((uv_handle_t*)iotjs_tcpwrap_tcp_handle(tcp_wrap));
+}
+
+
+JHANDLER_FUNCTION(Unref) {
+  JHANDLER_DECLARE_THIS_PTR(tcpwrap, tcp_wrap);
+
+  uv_unref((uv_handle_t*)iotjs_tcpwrap_tcp_handle(tcp_wrap));
+}
+
+
 JHANDLER_FUNCTION(ErrName) {
   DJHANDLER_CHECK_THIS(object);
   DJHANDLER_CHECK_ARGS(1, number);
@@ -606,10 +1435,10 @@ void AddressToJS(const iotjs_jval_t* obj, const sockaddr* addr) {
       a6 = (const sockaddr_in6*)(addr);
       uv_inet_ntop(AF_INET6, &a6->sin6_addr, ip, sizeof ip);
       port = ntohs(a6->sin6_port);
-      iotjs_jval_set_property_string_raw(obj, IOTJS_MAGIC_STRING_ADDRESS, ip);
-      iotjs_jval_set_property_string_raw(obj, IOTJS_MAGIC_STRING_FAMILY,
-                                         IOTJS_MAGIC_STRING_IPV6);
-      iotjs_jval_set_property_number(obj, IOTJS_MAGIC_STRING_PORT, port);
+      iotjs_jval_set_property_string_raw_by_key(obj, IOTJS_PROPKEY_ADDRESS, ip);
+      iotjs_jval_set_property_string_raw_by_key(obj, IOTJS_PROPKEY_FAMILY,
+                                                IOTJS_MAGIC_STRING_IPV6);
+      iotjs_jval_set_property_number_by_key(obj, IOTJS_PROPKEY_PORT, port);
       break;
     }
 
@@ -617,20 +1446,173 @@ void AddressToJS(const iotjs_jval_t* obj, const sockaddr* addr) {
       a4 = (const sockaddr_in*)(addr);
       uv_inet_ntop(AF_INET, &a4->sin_addr, ip, sizeof ip);
       port = ntohs(a4->sin_port);
-      iotjs_jval_set_property_string_raw(obj, IOTJS_MAGIC_STRING_ADDRESS, ip);
-      iotjs_jval_set_property_string_raw(obj, IOTJS_MAGIC_STRING_FAMILY,
-                                         IOTJS_MAGIC_STRING_IPV4);
-      iotjs_jval_set_property_number(obj, IOTJS_MAGIC_STRING_PORT, port);
+      iotjs_jval_set_property_string_raw_by_key(obj, IOTJS_PROPKEY_ADDRESS, ip);
+      iotjs_jval_set_property_string_raw_by_key(obj, IOTJS_PROPKEY_FAMILY,
+                                                IOTJS_MAGIC_STRING_IPV4);
+      iotjs_jval_set_property_number_by_key(obj, IOTJS_PROPKEY_PORT, port);
       break;
     }
 
     default: {
-      iotjs_jval_set_property_string_raw(obj, IOTJS_MAGIC_STRING_ADDRESS, "");
+      iotjs_jval_set_property_string_raw_by_key(obj, IOTJS_PROPKEY_ADDRESS, "");
       break;
     }
   }
 }
 
+
+// The peers messages were last received from, most recent first. A peer
+// keeps its address string, and the rinfo object of the last message size
+// it sent, so a peer sending messages of the same size gets the same object.
+#define IOTJS_PEER_CACHE_SIZE 16
+
+typedef struct {
+  sockaddr_storage addr;
+  iotjs_jval_t jaddress;
+  iotjs_jval_t jrinfo;
+  size_t rinfo_size;
+  bool has_rinfo;
+} iotjs_peer_t;
+
+static iotjs_peer_t* peer_cache[IOTJS_PEER_CACHE_SIZE];
+static int peer_count = 0;
+
+
+static bool iotjs_peer_equals(const sockaddr_storage* a, const sockaddr* b) {
+  if (a->ss_family != b->sa_family) {
+    return false;
+  }
+
+  if (b->sa_family == AF_INET) {
+    const sockaddr_in* a4 = (const sockaddr_in*)a;
+    const sockaddr_in* b4 = (const sockaddr_in*)b;
+    return a4->sin_port == b4->sin_port &&
+           a4->sin_addr.s_addr == b4->sin_addr.s_addr;
+  }
+
+  const sockaddr_in6* a6 = (const sockaddr_in6*)a;
+  const sockaddr_in6* b6 = (const sockaddr_in6*)b;
+  return a6->sin6_port == b6->sin6_port &&
+         a6->sin6_scope_id == b6->sin6_scope_id &&
+         memcmp(&a6->sin6_addr, &b6->sin6_addr, sizeof(a6->sin6_addr)) == 0;
+}
+
+
+static void iotjs_peer_release(iotjs_peer_t* peer) {
+  iotjs_jval_destroy(&peer->jaddress);
+  if (peer->has_rinfo) {
+    iotjs_jval_destroy(&peer->jrinfo);
+  }
+  IOTJS_RELEASE(peer);
+}
+
+
+// Returns the cache entry of an IPv4 or IPv6 peer, moved to the front, or
+// NULL for other families.
+static iotjs_peer_t* iotjs_peer_lookup(const sockaddr* addr) {
+  if (addr == NULL ||
+      (addr->sa_family != AF_INET && addr->sa_family != AF_INET6)) {
+    return NULL;
+  }
+
+  int i = 0;
+  while (i < peer_count && !iotjs_peer_equals(&peer_cache[i]->addr, addr)) {
+    i++;
+  }
+
+  iotjs_peer_t* peer;
+  if (i < peer_count) {
+    peer = peer_cache[i];
+  } else {
+    if (peer_count == IOTJS_PEER_CACHE_SIZE) {
+      iotjs_peer_release(peer_cache[--peer_count]);
+    }
+    i = peer_count++;
+
+    char ip[INET6_ADDRSTRLEN];
+    peer = IOTJS_ALLOC(iotjs_peer_t);
+    if (addr->sa_family == AF_INET) {
+      memcpy(&peer->addr, addr, sizeof(sockaddr_in));
+      uv_ip4_name((const sockaddr_in*)addr, ip, sizeof(ip));
+    } else {
+      memcpy(&peer->addr, addr, sizeof(sockaddr_in6));
+      uv_ip6_name((const sockaddr_in6*)addr, ip, sizeof(ip));
+    }
+    peer->jaddress = iotjs_jval_create_string_raw(ip);
+  }
+
+  memmove(peer_cache + 1, peer_cache, sizeof(peer_cache[0]) * (size_t)i);
+  peer_cache[0] = peer;
+  return peer;
+}
+
+
+iotjs_jval_t iotjs_peer_address(const sockaddr* addr) {
+  iotjs_peer_t* peer = iotjs_peer_lookup(addr);
+  if (peer == NULL) {
+    return iotjs_jval_create_string_raw("");
+  }
+  return iotjs_jval_create_copied(&peer->jaddress);
+}
+
+
+iotjs_jval_t iotjs_peer_rinfo(const sockaddr* addr, size_t size) {
+  iotjs_peer_t* peer = iotjs_peer_lookup(addr);
+  if (peer == NULL) {
+    iotjs_jval_t jrinfo = iotjs_jval_create_object();
+    if (addr != NULL) {
+      AddressToJS(&jrinfo, addr);
+    }
+    iotjs_jval_set_property_number_by_key(&jrinfo, IOTJS_PROPKEY_SIZE,
+                                          (double)size);
+    return jrinfo;
+  }
+
+  if (peer->has_rinfo && peer->rinfo_size == size) {
+    return iotjs_jval_create_copied(&peer->jrinfo);
+  }
+
+  if (peer->has_rinfo) {
+    iotjs_jval_destroy(&peer->jrinfo);
+  }
+
+  // The object is shared by the messages of the peer, so it is read-only.
+  bool ipv4 = peer->addr.ss_family == AF_INET;
+  int port = ipv4 ? ntohs(((const sockaddr_in*)&peer->addr)->sin_port)
+                  : ntohs(((const sockaddr_in6*)&peer->addr)->sin6_port);
+  iotjs_jval_t jfamily = iotjs_jval_create_string_raw(
+      ipv4 ? IOTJS_MAGIC_STRING_IPV4 : IOTJS_MAGIC_STRING_IPV6);
+  iotjs_jval_t jport = iotjs_jval_create_number(port);
+  iotjs_jval_t jsize = iotjs_jval_create_number((double)size);
+
+  peer->jrinfo = iotjs_jval_create_object();
+  iotjs_jval_set_property_readonly_by_key(&peer->jrinfo, IOTJS_PROPKEY_ADDRESS,
+                                          &peer->jaddress);
+  iotjs_jval_set_property_readonly_by_key(&peer->jrinfo, IOTJS_PROPKEY_FAMILY,
+                                          &jfamily);
+  iotjs_jval_set_property_readonly_by_key(&peer->jrinfo, IOTJS_PROPKEY_PORT,
+                                          &jport);
+  iotjs_jval_set_property_readonly_by_key(&peer->jrinfo, IOTJS_PROPKEY_SIZE,
+                                          &jsize);
+  peer->rinfo_size = size;
+  peer->has_rinfo = true;
+
+  iotjs_jval_destroy(&jsize);
+  iotjs_jval_destroy(&jport);
+  iotjs_jval_destroy(&jfamily);
+
+  return iotjs_jval_create_copied(&peer->jrinfo);
+}
+
+
+void iotjs_peer_cache_release() {
+  while (peer_count > 0) {
+    iotjs_peer_release(peer_cache[--peer_count]);
+  }
+}
+
+
+
 GetSockNameFunction(tcpwrap, tcp_handle, uv_tcp_getsockname);
 
 
@@ -638,7 +1620,39 @@ JHANDLER_FUNCTION(GetSockeName) {
   DoGetSockName(jhandler);
 }
 
+static void iotjs_tcp_memory_pressure_walk(uv_handle_t* handle, void* arg) {
+  if (handle->type != UV_TCP || uv_is_closing(handle)) {
+    return;
+  }
+
+  uv_stream_t* stream = (uv_stream_t*)handle;
+  iotjs_tcpwrap_t* tcp_wrap = iotjs_tcpwrap_from_handle((uv_tcp_t*)handle);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tcpwrap_t, tcp_wrap);
+
+  if (*(bool*)arg) {
+    // A listening socket is active as well, but reads nothing.
+    if (stream->read_cb != NULL) {
+      uv_read_stop(stream);
+      _this->is_memory_paused = true;
+    }
+  } else if (_this->is_memory_paused) {
+    iotjs_tcp_read_start(tcp_wrap);
+  }
+}
+
+
+// Sockets stop reading under critical memory pressure, so that no more read
+// buffers are allocated until memory has been given back.
+static void iotjs_tcp_on_memory_pressure(iotjs_memory_pressure_t pressure) {
+  bool is_pausing = (pressure == kMemoryPressureCritical);
+  uv_walk(iotjs_environment_loop(iotjs_environment_get()),
+          iotjs_tcp_memory_pressure_walk, &is_pausing);
+}
+
+
 iotjs_jval_t InitTcp() {
+  iotjs_memory_add_listener(iotjs_tcp_on_memory_pressure);
+
   iotjs_jval_t tcp = iotjs_jval_create_function_with_dispatch(TCP);
 
   iotjs_jval_t prototype = iotjs_jval_create_object();
@@ -647,18 +1661,41 @@ iotjs_jval_t InitTcp() {
   iotjs_jval_set_property_jval(&tcp, IOTJS_MAGIC_STRING_PROTOTYPE, &prototype);
   iotjs_jval_set_property_jval(&tcp, IOTJS_MAGIC_STRING_ERRNAME, &errname);
 
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONREAD, GetOnRead,
+                          SetOnRead);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_OWNER, GetOwner,
+                          SetOwner);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONCONNECTION,
+                          GetOnConnection, SetOnConnection);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONCLOSE, GetOnClose,
+                          SetOnClose);
+
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_OPEN, Open);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_CLOSE, Close);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_CONNECT, Connect);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_BIND, Bind);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_LISTEN, Listen);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_ACCEPT, Accept);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETACCEPTLIMIT,
+                        SetAcceptLimit);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITE, Write);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITEV, Writev);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SENDFILE, SendFile);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READSTART, ReadStart);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READSTOP, ReadStop);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SPLICE, Splice);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SHUTDOWN, Shutdown);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETKEEPALIVE,
                         SetKeepAlive);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETNODELAY, SetNoDelay);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETBUFFERSIZE,
+                        SetBufferSize);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETFASTOPEN,
+                        SetFastOpen);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_GETSOCKNAME,
                         GetSockeName);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_REF, Ref);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_UNREF, Unref);
 
   iotjs_jval_destroy(&prototype);
   iotjs_jval_destroy(&errname);
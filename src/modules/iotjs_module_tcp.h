@@ -29,9 +29,41 @@ typedef struct sockaddr_in6 sockaddr_in6;
 typedef struct sockaddr_storage sockaddr_storage;
 
 
+// Callback slots of the tcp object.
+typedef enum {
+  IOTJS_TCP_ONREAD,
+  IOTJS_TCP_OWNER,
+  IOTJS_TCP_ONCONNECTION,
+  IOTJS_TCP_ONCLOSE,
+  IOTJS_TCP_CALLBACK_COUNT,
+} iotjs_tcp_callback_t;
+
+
+typedef struct iotjs_tcp_splice_t iotjs_tcp_splice_t;
+
+
 typedef struct {
   iotjs_handlewrap_t handlewrap;
   uv_tcp_t handle;
+  iotjs_jval_t jcallbacks[IOTJS_TCP_CALLBACK_COUNT];
+  // The socket the data read is written to, instead of passing it on to the
+  // onread callback.
+  iotjs_tcp_splice_t* splice;
+  // Options applied once the socket is created, by connect or listen. Zero
+  // leaves the system default.
+  int recv_buffer_size;
+  int send_buffer_size;
+  int fast_open;
+  // The number of connections a listening socket may still accept, or -1
+  // for no limit. The others wait in the backlog of the kernel.
+  int accept_limit;
+  // Reading is paused under critical memory pressure, to be started again
+  // once the pressure goes down.
+  bool is_memory_paused;
+  // Reading stops while a read waits in its callback lane, so that the
+  // onread callback can stop it, as for a cap, before more is read.
+  bool is_lane_paused;
+  iotjs_read_sizer_t read_sizer;
 } IOTJS_VALIDATED_STRUCT(iotjs_tcpwrap_t);
 
 
@@ -42,6 +74,8 @@ iotjs_tcpwrap_t* iotjs_tcpwrap_from_jobject(const iotjs_jval_t* jtcp);
 
 uv_tcp_t* iotjs_tcpwrap_tcp_handle(iotjs_tcpwrap_t* tcpwrap);
 iotjs_jval_t* iotjs_tcpwrap_jobject(iotjs_tcpwrap_t* tcpwrap);
+const iotjs_jval_t* iotjs_tcpwrap_jcallback(iotjs_tcpwrap_t* tcpwrap,
+                                            iotjs_tcp_callback_t index);
 
 
 typedef struct {
@@ -86,8 +120,56 @@ const iotjs_jval_t* iotjs_shutdown_reqwrap_jcallback(THIS);
 #undef THIS
 
 
+typedef struct {
+  iotjs_reqwrap_t reqwrap;
+  uv_fs_t req;
+} IOTJS_VALIDATED_STRUCT(iotjs_sendfile_reqwrap_t);
+
+#define THIS iotjs_sendfile_reqwrap_t* sendfile_reqwrap
+iotjs_sendfile_reqwrap_t* iotjs_sendfile_reqwrap_create(
+    const iotjs_jval_t* jcallback);
+void iotjs_sendfile_reqwrap_dispatched(THIS);
+uv_fs_t* iotjs_sendfile_reqwrap_req(THIS);
+const iotjs_jval_t* iotjs_sendfile_reqwrap_jcallback(THIS);
+#undef THIS
+
+
+// A native consumer of the data read by a socket, in place of the onread
+// callback. `write` takes a buffer of iotjs_read_buffer_allocate holding
+// `length` bytes, and returns 0 or a libuv error code, in which case the
+// buffer is not taken and the error goes to onread. Reading pauses while
+// `queued` returns more than the high water mark, until the consumer calls
+// iotjs_tcp_splice_drained. The end of the data and read errors still go to
+// onread.
+typedef struct {
+  int (*write)(void* data, char* base, size_t length);
+  size_t (*queued)(void* data);
+} iotjs_tcp_sink_t;
+
+// Starts reading, to the sink or the onread callback, as readStart does.
+int iotjs_tcp_read_start(iotjs_tcpwrap_t* tcpwrap);
+
+// `splice` is set once the splice is on the socket, even if reading failed to
+// start. It holds a reference for the consumer, which gives it back with
+// iotjs_tcp_splice_detach when it goes away. The data read after that is
+// dropped.
+int iotjs_tcp_splice_to_sink(iotjs_tcpwrap_t* tcpwrap,
+                             const iotjs_tcp_sink_t* sink, void* data,
+                             size_t high_water_mark,
+                             iotjs_tcp_splice_t** splice);
+void iotjs_tcp_splice_drained(iotjs_tcpwrap_t* tcpwrap);
+void iotjs_tcp_splice_stop(iotjs_tcpwrap_t* tcpwrap);
+void iotjs_tcp_splice_detach(iotjs_tcp_splice_t* splice);
+
+
 void AddressToJS(const iotjs_jval_t* obj, const sockaddr* addr);
 
+// The address string and rinfo object of a recent peer, taken from a small
+// cache instead of being created for every message.
+iotjs_jval_t iotjs_peer_address(const sockaddr* addr);
+iotjs_jval_t iotjs_peer_rinfo(const sockaddr* addr, size_t size);
+void iotjs_peer_cache_release();
+
 
 #define GetSockNameFunction(wraptype, handletype, function)                    \
   static void DoGetSockName(iotjs_jhandler_t* jhandler) {                      \
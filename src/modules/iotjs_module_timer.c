@@ -61,12 +61,13 @@ static void TimeoutHandler(uv_timer_t* handle) {
 
 
 int iotjs_timerwrap_start(iotjs_timerwrap_t* timerwrap, uint64_t timeout,
-                          uint64_t repeat) {
+                          uint64_t repeat, uint64_t slack) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_timerwrap_t, timerwrap);
 
   // Start uv timer.
   uv_timer_t* uv_timer =
       (uv_timer_t*)iotjs_handlewrap_get_uv_handle(&_this->handlewrap);
+  uv_timer_set_slack(uv_timer, slack);
   return uv_timer_start(uv_timer, TimeoutHandler, timeout, repeat);
 }
 
@@ -131,9 +132,14 @@ JHANDLER_FUNCTION(Start) {
   // parameters.
   uint64_t timeout = JHANDLER_GET_ARG(0, number);
   uint64_t repeat = JHANDLER_GET_ARG(1, number);
+  uint64_t slack = 0;
+  const iotjs_jval_t* jslack = JHANDLER_GET_ARG_IF_EXIST(2, number);
+  if (jslack != NULL && iotjs_jval_as_number(jslack) > 0) {
+    slack = iotjs_jval_as_number(jslack);
+  }
 
   // Start timer.
-  int res = iotjs_timerwrap_start(timer_wrap, timeout, repeat);
+  int res = iotjs_timerwrap_start(timer_wrap, timeout, repeat, slack);
 
   iotjs_jhandler_return_number(jhandler, res);
 }
@@ -148,6 +154,15 @@ JHANDLER_FUNCTION(Stop) {
 }
 
 
+// The loop time, which timeouts are measured from.
+JHANDLER_FUNCTION(Now) {
+  const iotjs_environment_t* env = iotjs_environment_get();
+  uint64_t now = uv_now(iotjs_environment_loop(env));
+
+  iotjs_jhandler_return_number(jhandler, (double)now);
+}
+
+
 JHANDLER_FUNCTION(Timer) {
   JHANDLER_CHECK_THIS(object);
 
@@ -162,6 +177,13 @@ JHANDLER_FUNCTION(Timer) {
 iotjs_jval_t InitTimer() {
   iotjs_jval_t timer = iotjs_jval_create_function_with_dispatch(Timer);
 
+  iotjs_jval_set_method(&timer, IOTJS_MAGIC_STRING_NOW, Now);
+
+  // The slack of the timeouts which are not given one, from --timer-slack.
+  const iotjs_environment_t* env = iotjs_environment_get();
+  iotjs_jval_set_property_number(&timer, IOTJS_MAGIC_STRING_DEFAULTSLACK,
+                                 iotjs_environment_config(env)->timer_slack);
+
   iotjs_jval_t prototype = iotjs_jval_create_object();
   iotjs_jval_set_property_jval(&timer, IOTJS_MAGIC_STRING_PROTOTYPE,
                                &prototype);
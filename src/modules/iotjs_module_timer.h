@@ -35,8 +35,9 @@ uv_timer_t* iotjs_timerwrap_handle(iotjs_timerwrap_t* timerwrap);
 iotjs_jval_t* iotjs_timerwrap_jobject(iotjs_timerwrap_t* timerwrap);
 
 // Start timer.
+// Start timer, to run up to `slack` milliseconds late.
 int iotjs_timerwrap_start(iotjs_timerwrap_t* timerwrap, uint64_t timeout,
-                          uint64_t repeat);
+                          uint64_t repeat, uint64_t slack);
 // Stop & close timer.
 int iotjs_timerwrap_stop(iotjs_timerwrap_t* timerwrap);
 
@@ -0,0 +1,1184 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "iotjs_def.h"
+#include "iotjs_module_buffer.h"
+#include "iotjs_module_tcp.h"
+#include "iotjs_objectwrap.h"
+
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/error.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/x509_crt.h"
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include "mbedtls/ssl_ticket.h"
+#endif
+// The state of the handshake tells whether a session was resumed. It is
+// public in mbedTLS 2.x, the version the supported platforms ship.
+#include "mbedtls/ssl_internal.h"
+
+
+// The TLS object sits between a tcp object and a net.Socket. The ciphertext
+// read by the socket goes to a sink of the tcp object (see
+// iotjs_tcp_splice_to_sink) instead of JavaScript, and waits in the read
+// buffers until mbedTLS takes it. mbedTLS decrypts the records in place in
+// its input buffer, and the plaintext is read into a read buffer that becomes
+// the memory of the Buffer passed to onread, as the tcp object does. The
+// records of a write are collected in one buffer and written by one request.
+
+
+// High water mark of the ciphertext queued while the plaintext is not read.
+#define IOTJS_TLS_HIGH_WATER_MARK (32 * 1024)
+
+// The largest plaintext of a record.
+#define IOTJS_TLS_RECORD_SIZE (16 * 1024)
+
+
+
+// The random generator of all the contexts, seeded on first use.
+static mbedtls_entropy_context tls_entropy;
+static mbedtls_ctr_drbg_context tls_drbg;
+static bool tls_drbg_seeded = false;
+
+
+static int iotjs_tls_seed_drbg() {
+  if (tls_drbg_seeded) {
+    return 0;
+  }
+
+  static const char personalization[] = "iotjs";
+  mbedtls_entropy_init(&tls_entropy);
+  mbedtls_ctr_drbg_init(&tls_drbg);
+  int ret = mbedtls_ctr_drbg_seed(&tls_drbg, mbedtls_entropy_func,
+                                  &tls_entropy,
+                                  (const unsigned char*)personalization,
+                                  sizeof(personalization) - 1);
+  if (ret != 0) {
+    mbedtls_ctr_drbg_free(&tls_drbg);
+    mbedtls_entropy_free(&tls_entropy);
+    return ret;
+  }
+
+  tls_drbg_seeded = true;
+  return 0;
+}
+
+
+// The configuration of a SecureContext. The TLS objects set up with it keep
+// a reference, so it outlives the SecureContext object when needed.
+typedef struct {
+  mbedtls_ssl_config conf;
+  mbedtls_x509_crt ca;
+  mbedtls_x509_crt cert;
+  mbedtls_pk_context key;
+#if defined(MBEDTLS_SSL_TICKET_C)
+  mbedtls_ssl_ticket_context ticket;
+  bool has_ticket;
+#endif
+  uint32_t refs;
+} iotjs_tls_config_t;
+
+
+static void iotjs_tls_config_unref(iotjs_tls_config_t* config) {
+  if (--config->refs > 0) {
+    return;
+  }
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+  if (config->has_ticket) {
+    mbedtls_ssl_ticket_free(&config->ticket);
+  }
+#endif
+  mbedtls_pk_free(&config->key);
+  mbedtls_x509_crt_free(&config->cert);
+  mbedtls_x509_crt_free(&config->ca);
+  mbedtls_ssl_config_free(&config->conf);
+  IOTJS_RELEASE(config);
+}
+
+
+typedef struct {
+  iotjs_jobjectwrap_t jobjectwrap;
+  iotjs_tls_config_t* config;
+} IOTJS_VALIDATED_STRUCT(iotjs_securecontext_t);
+
+
+static void iotjs_securecontext_destroy(iotjs_securecontext_t* context);
+IOTJS_DEFINE_NATIVE_HANDLE_INFO(securecontext);
+
+
+static void iotjs_securecontext_destroy(iotjs_securecontext_t* context) {
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_securecontext_t, context);
+  iotjs_tls_config_unref(_this->config);
+  iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
+  IOTJS_RELEASE(context);
+}
+
+
+static iotjs_tls_config_t* iotjs_securecontext_config(
+    iotjs_securecontext_t* context) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_securecontext_t, context);
+  return _this->config;
+}
+
+
+// Callback slots of the tls object.
+typedef enum {
+  IOTJS_TLS_ONREAD,
+  IOTJS_TLS_OWNER,
+  IOTJS_TLS_ONHANDSHAKE,
+  IOTJS_TLS_CALLBACK_COUNT,
+} iotjs_tls_callback_t;
+
+
+// A read buffer of ciphertext, of which mbedTLS took `offset` bytes.
+typedef struct iotjs_tls_chunk_s {
+  struct iotjs_tls_chunk_s* next;
+  char* base;
+  size_t length;
+  size_t offset;
+} iotjs_tls_chunk_t;
+
+
+typedef struct {
+  iotjs_jobjectwrap_t jobjectwrap;
+  iotjs_jval_t jcallbacks[IOTJS_TLS_CALLBACK_COUNT];
+
+  iotjs_tcpwrap_t* tcp_wrap;
+  // Hands the ciphertext read by the socket to the wrap.
+  iotjs_tcp_splice_t* splice;
+  iotjs_tls_config_t* config;
+  mbedtls_ssl_context ssl;
+
+  // Ciphertext read and not taken by mbedTLS yet.
+  iotjs_tls_chunk_t* head;
+  iotjs_tls_chunk_t* tail;
+  size_t queued;
+
+  // Ciphertext written by mbedTLS, sent at the end of the operation.
+  char* out;
+  size_t out_length;
+  size_t out_size;
+
+  // The error or UV__EOF the socket ended with, delivered once the data
+  // before it is read.
+  int end_status;
+
+  bool started;
+  bool secure;
+  bool failed;
+  bool resumed;
+  bool reading;
+  bool ended;
+  bool busy;
+  bool destroyed;
+  bool released;
+} IOTJS_VALIDATED_STRUCT(iotjs_tlswrap_t);
+
+
+IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE_DETACH(tlswrap);
+
+
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnRead, IOTJS_TLS_ONREAD)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(Owner, IOTJS_TLS_OWNER)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnHandshake, IOTJS_TLS_ONHANDSHAKE)
+
+
+static int iotjs_tls_bio_send(void* ctx, const unsigned char* buf,
+                              size_t len);
+static int iotjs_tls_bio_recv(void* ctx, unsigned char* buf, size_t len);
+
+
+static iotjs_tlswrap_t* iotjs_tlswrap_create(const iotjs_jval_t* jtls,
+                                             iotjs_tcpwrap_t* tcp_wrap,
+                                             iotjs_tls_config_t* config) {
+  iotjs_tlswrap_t* tlswrap = IOTJS_ALLOC(iotjs_tlswrap_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_tlswrap_t, tlswrap);
+
+  iotjs_jobjectwrap_initialize(&_this->jobjectwrap, jtls,
+                               &this_module_native_info);
+  iotjs_jobjectwrap_initialize_callbacks(&_this->jobjectwrap, _this->jcallbacks,
+                                         IOTJS_TLS_CALLBACK_COUNT);
+
+  _this->tcp_wrap = tcp_wrap;
+  _this->config = config;
+  config->refs++;
+
+  mbedtls_ssl_init(&_this->ssl);
+  mbedtls_ssl_set_bio(&_this->ssl, tlswrap, iotjs_tls_bio_send,
+                      iotjs_tls_bio_recv, NULL);
+
+  return tlswrap;
+}
+
+
+static void iotjs_tlswrap_release(iotjs_tlswrap_t* tlswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+  if (_this->released) {
+    return;
+  }
+  _this->released = true;
+
+  while (_this->head != NULL) {
+    iotjs_tls_chunk_t* chunk = _this->head;
+    _this->head = chunk->next;
+    iotjs_read_buffer_release(chunk->base);
+    IOTJS_RELEASE(chunk);
+  }
+  _this->tail = NULL;
+  _this->queued = 0;
+
+  if (_this->out != NULL) {
+    iotjs_buffer_release(_this->out);
+    _this->out = NULL;
+  }
+
+  mbedtls_ssl_free(&_this->ssl);
+}
+
+
+// The socket can outlive the object. The ciphertext it still reads is
+// dropped.
+static void iotjs_tlswrap_detach(iotjs_tlswrap_t* tlswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+  _this->destroyed = true;
+  _this->reading = false;
+  if (_this->splice != NULL) {
+    iotjs_tcp_splice_detach(_this->splice);
+    _this->splice = NULL;
+  }
+}
+
+
+static void iotjs_tlswrap_destroy(iotjs_tlswrap_t* tlswrap) {
+  // Released while the struct is still valid, if Destroy has not done it.
+  iotjs_tlswrap_release(tlswrap);
+
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_tlswrap_t, tlswrap);
+  iotjs_tls_config_unref(_this->config);
+  iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
+  IOTJS_RELEASE(tlswrap);
+}
+
+
+static iotjs_jval_t* iotjs_tlswrap_jobject(iotjs_tlswrap_t* tlswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+  return iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
+}
+
+
+static int iotjs_tls_bio_send(void* ctx, const unsigned char* buf,
+                              size_t len) {
+  iotjs_tlswrap_t* tlswrap = (iotjs_tlswrap_t*)ctx;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+
+  if (_this->out_length + len > _this->out_size) {
+    size_t size = _this->out_size > 0 ? _this->out_size * 2 : 1024;
+    while (size < _this->out_length + len) {
+      size *= 2;
+    }
+    _this->out = _this->out == NULL
+                     ? iotjs_buffer_allocate(size)
+                     : iotjs_buffer_reallocate(_this->out, size);
+    _this->out_size = size;
+  }
+
+  memcpy(_this->out + _this->out_length, buf, len);
+  _this->out_length += len;
+  return (int)len;
+}
+
+
+static int iotjs_tls_bio_recv(void* ctx, unsigned char* buf, size_t len) {
+  iotjs_tlswrap_t* tlswrap = (iotjs_tlswrap_t*)ctx;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+
+  size_t copied = 0;
+  while (copied < len && _this->head != NULL) {
+    iotjs_tls_chunk_t* chunk = _this->head;
+    size_t n = chunk->length - chunk->offset;
+    if (n > len - copied) {
+      n = len - copied;
+    }
+    memcpy(buf + copied, chunk->base + chunk->offset, n);
+    copied += n;
+    chunk->offset += n;
+
+    if (chunk->offset == chunk->length) {
+      _this->head = chunk->next;
+      if (_this->head == NULL) {
+        _this->tail = NULL;
+      }
+      iotjs_read_buffer_release(chunk->base);
+      IOTJS_RELEASE(chunk);
+    }
+  }
+  _this->queued -= copied;
+
+  if (copied > 0) {
+    return (int)copied;
+  }
+  // Zero tells mbedTLS the connection ended.
+  return _this->end_status != 0 ? 0 : MBEDTLS_ERR_SSL_WANT_READ;
+}
+
+
+typedef struct {
+  uv_write_t req;
+  char* base;
+  iotjs_jval_t jtls;
+  iotjs_jval_t jcallback;
+} iotjs_tls_write_t;
+
+
+static void AfterTlsWrite(uv_write_t* req, int status) {
+  iotjs_tls_write_t* write = (iotjs_tls_write_t*)req;
+
+  iotjs_jval_set_property_number_by_key(&write->jtls,
+                                        IOTJS_PROPKEY_WRITEQUEUESIZE,
+                                        req->handle->write_queue_size);
+
+  if (iotjs_jval_is_function(&write->jcallback)) {
+    iotjs_jargs_t args = iotjs_jargs_create(1);
+    iotjs_jargs_append_number(&args, status);
+    iotjs_make_callback(&write->jcallback, iotjs_jval_get_undefined(), &args);
+    iotjs_jargs_destroy(&args);
+  }
+
+  if (write->base != NULL) {
+    iotjs_buffer_release(write->base);
+  }
+  iotjs_jval_destroy(&write->jcallback);
+  iotjs_jval_destroy(&write->jtls);
+  IOTJS_RELEASE(write);
+}
+
+
+// Writes the ciphertext collected by the bio, calling `jcallback` when it is
+// written if it is a function.
+static int iotjs_tls_flush(iotjs_tlswrap_t* tlswrap,
+                           const iotjs_jval_t* jcallback) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+
+  if (_this->out_length == 0 && jcallback == NULL) {
+    return 0;
+  }
+
+  iotjs_tls_write_t* write = IOTJS_ALLOC(iotjs_tls_write_t);
+  write->base = _this->out;
+  write->jtls = iotjs_jval_create_copied(iotjs_tlswrap_jobject(tlswrap));
+  write->jcallback = iotjs_jval_create_copied(
+      jcallback != NULL ? jcallback : iotjs_jval_get_undefined());
+
+  uv_buf_t buf = uv_buf_init(_this->out, (unsigned int)_this->out_length);
+  _this->out = NULL;
+  _this->out_length = 0;
+  _this->out_size = 0;
+
+  uv_stream_t* stream =
+      (uv_stream_t*)iotjs_tcpwrap_tcp_handle(_this->tcp_wrap);
+  int err = uv_write(&write->req, stream, &buf, 1, AfterTlsWrite);
+  if (err) {
+    if (write->base != NULL) {
+      iotjs_buffer_release(write->base);
+    }
+    iotjs_jval_destroy(&write->jcallback);
+    iotjs_jval_destroy(&write->jtls);
+    IOTJS_RELEASE(write);
+    return err;
+  }
+
+  iotjs_jval_set_property_number_by_key(iotjs_tlswrap_jobject(tlswrap),
+                                        IOTJS_PROPKEY_WRITEQUEUESIZE,
+                                        stream->write_queue_size);
+  return 0;
+}
+
+
+static void iotjs_tls_emit_read(iotjs_tlswrap_t* tlswrap, ssize_t nread,
+                                const iotjs_jval_t* jbuffer) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+
+  iotjs_jval_t jonread = iotjs_jval_create_copied(
+      iotjs_jobjectwrap_jcallback(&_this->jobjectwrap, IOTJS_TLS_ONREAD));
+  if (!iotjs_jval_is_function(&jonread)) {
+    iotjs_jval_destroy(&jonread);
+    return;
+  }
+
+  iotjs_jargs_t jargs = iotjs_jargs_create(4);
+  iotjs_jargs_append_jval(&jargs, iotjs_jobjectwrap_jcallback(
+                                      &_this->jobjectwrap, IOTJS_TLS_OWNER));
+  iotjs_jargs_append_number(&jargs, nread);
+  iotjs_jargs_append_bool(&jargs, nread == UV__EOF);
+  if (jbuffer != NULL) {
+    iotjs_jargs_append_jval(&jargs, jbuffer);
+  }
+
+  iotjs_make_callback(&jonread, iotjs_jval_get_undefined(), &jargs);
+
+  iotjs_jargs_destroy(&jargs);
+  iotjs_jval_destroy(&jonread);
+}
+
+
+// Runs the handshake as far as the data received allows. The handshake is
+// run step by step, to learn whether the session was resumed before mbedTLS
+// frees the state of the handshake.
+static void iotjs_tls_handshake(iotjs_tlswrap_t* tlswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+
+  int ret = 0;
+  while (_this->ssl.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+    if (_this->ssl.state == MBEDTLS_SSL_HANDSHAKE_WRAPUP &&
+        _this->ssl.handshake != NULL) {
+      _this->resumed = _this->ssl.handshake->resume != 0;
+    }
+    ret = mbedtls_ssl_handshake_step(&_this->ssl);
+    if (ret != 0) {
+      break;
+    }
+  }
+
+  // The messages of this flight go out before the callback writes any data.
+  iotjs_tls_flush(tlswrap, NULL);
+
+  if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+    return;
+  }
+
+  if (ret == 0) {
+    _this->secure = true;
+  } else {
+    _this->failed = true;
+  }
+
+  // function onhandshake(socket, error)
+  iotjs_jval_t jonhandshake = iotjs_jval_create_copied(
+      iotjs_jobjectwrap_jcallback(&_this->jobjectwrap, IOTJS_TLS_ONHANDSHAKE));
+  if (iotjs_jval_is_function(&jonhandshake)) {
+    iotjs_jargs_t jargs = iotjs_jargs_create(2);
+    iotjs_jargs_append_jval(&jargs, iotjs_jobjectwrap_jcallback(
+                                        &_this->jobjectwrap, IOTJS_TLS_OWNER));
+    iotjs_jargs_append_number(&jargs, ret);
+    iotjs_make_callback(&jonhandshake, iotjs_jval_get_undefined(), &jargs);
+    iotjs_jargs_destroy(&jargs);
+  }
+  iotjs_jval_destroy(&jonhandshake);
+}
+
+
+// Passes the plaintext of the records received on to onread, while reading.
+static void iotjs_tls_read(iotjs_tlswrap_t* tlswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+
+  while (_this->reading && !_this->ended && !_this->destroyed) {
+    size_t size = mbedtls_ssl_get_bytes_avail(&_this->ssl);
+    if (size == 0 || size > IOTJS_TLS_RECORD_SIZE) {
+      size = IOTJS_TLS_RECORD_SIZE;
+    }
+    if (size > IOTJS_MAX_READ_BUFFER_SIZE) {
+      size = IOTJS_MAX_READ_BUFFER_SIZE;
+    }
+    char* base = iotjs_read_buffer_allocate(&size);
+
+    int ret = mbedtls_ssl_read(&_this->ssl, (unsigned char*)base, size);
+    if (ret > 0) {
+      // The read buffer becomes the memory of the Buffer object.
+      iotjs_jval_t jbuffer =
+          iotjs_bufferwrap_adopt_buffer(base, size, (size_t)ret);
+      iotjs_tls_emit_read(tlswrap, ret, &jbuffer);
+      iotjs_jval_destroy(&jbuffer);
+      continue;
+    }
+
+    iotjs_read_buffer_release(base);
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+      break;
+    }
+
+    _this->ended = true;
+    if (ret == 0 || ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
+      iotjs_tls_emit_read(tlswrap, UV__EOF, NULL);
+    } else if (ret == MBEDTLS_ERR_SSL_CONN_EOF) {
+      iotjs_tls_emit_read(tlswrap, _this->end_status, NULL);
+    } else {
+      iotjs_tls_emit_read(tlswrap, UV__EPROTO, NULL);
+    }
+  }
+}
+
+
+// Takes the handshake and the reading as far as the data received allows.
+static void iotjs_tls_cycle(iotjs_tlswrap_t* tlswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+  if (_this->busy || _this->destroyed || !_this->started || _this->failed) {
+    return;
+  }
+
+  // The callbacks may drop the last reference to the object.
+  iotjs_jval_t jtls = iotjs_jval_create_copied(iotjs_tlswrap_jobject(tlswrap));
+  _this->busy = true;
+
+  if (!_this->secure) {
+    iotjs_tls_handshake(tlswrap);
+  }
+  if (_this->secure && !_this->destroyed) {
+    iotjs_tls_read(tlswrap);
+    // Alerts and renegotiation records produced while reading.
+    if (!_this->destroyed) {
+      iotjs_tls_flush(tlswrap, NULL);
+    }
+  }
+
+  _this->busy = false;
+  if (_this->destroyed) {
+    iotjs_tlswrap_release(tlswrap);
+  } else if (_this->queued <= IOTJS_TLS_HIGH_WATER_MARK) {
+    iotjs_tcp_splice_drained(_this->tcp_wrap);
+  }
+
+  iotjs_jval_destroy(&jtls);
+}
+
+
+static int iotjs_tls_sink_write(void* data, char* base, size_t length) {
+  iotjs_tlswrap_t* tlswrap = (iotjs_tlswrap_t*)data;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+
+  if (_this->destroyed) {
+    iotjs_read_buffer_release(base);
+    return 0;
+  }
+
+  iotjs_tls_chunk_t* chunk = IOTJS_ALLOC(iotjs_tls_chunk_t);
+  chunk->base = base;
+  chunk->length = length;
+  if (_this->tail != NULL) {
+    _this->tail->next = chunk;
+  } else {
+    _this->head = chunk;
+  }
+  _this->tail = chunk;
+  _this->queued += length;
+
+  iotjs_tls_cycle(tlswrap);
+  return 0;
+}
+
+
+static size_t iotjs_tls_sink_queued(void* data) {
+  iotjs_tlswrap_t* tlswrap = (iotjs_tlswrap_t*)data;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+  return _this->destroyed ? 0 : _this->queued;
+}
+
+
+static const iotjs_tcp_sink_t iotjs_tls_sink = {
+  iotjs_tls_sink_write, iotjs_tls_sink_queued,
+};
+
+
+// [0] tcp object
+// [1] SecureContext
+JHANDLER_FUNCTION(TLS) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(2, object, object);
+
+  const iotjs_jval_t* jtls = JHANDLER_GET_THIS(object);
+  iotjs_tcpwrap_t* tcp_wrap =
+      iotjs_tcpwrap_from_jobject(JHANDLER_GET_ARG(0, object));
+  iotjs_securecontext_t* context =
+      (iotjs_securecontext_t*)iotjs_jval_get_arg_obj_from_jhandler(
+          jhandler, 1, &securecontext_native_info);
+  if (tcp_wrap == NULL || context == NULL) {
+    JHANDLER_THROW(TYPE, "Bad arguments: tcp and SecureContext expected");
+    return;
+  }
+
+  iotjs_tls_config_t* config = iotjs_securecontext_config(context);
+  iotjs_tlswrap_t* tls_wrap = iotjs_tlswrap_create(jtls, tcp_wrap, config);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+  int ret = mbedtls_ssl_setup(&_this->ssl, &config->conf);
+  if (ret != 0) {
+    _this->failed = true;
+    JHANDLER_THROW(COMMON, "TLS setup failed");
+  }
+}
+
+
+// Starts the handshake, or the delivery of plaintext once it is done.
+JHANDLER_FUNCTION(ReadStart) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+
+  if (_this->destroyed || _this->failed) {
+    iotjs_jhandler_return_number(jhandler, UV__EINVAL);
+    return;
+  }
+
+  _this->reading = true;
+
+  int err = 0;
+  if (!_this->started) {
+    err = iotjs_tcp_splice_to_sink(_this->tcp_wrap, &iotjs_tls_sink, tls_wrap,
+                                   IOTJS_TLS_HIGH_WATER_MARK, &_this->splice);
+    if (err == 0) {
+      err = iotjs_tcp_read_start(_this->tcp_wrap);
+    }
+    _this->started = err == 0;
+  }
+
+  iotjs_tls_cycle(tls_wrap);
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// The ciphertext is still read and queued, up to the high water mark.
+JHANDLER_FUNCTION(ReadStop) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+
+  _this->reading = false;
+
+  iotjs_jhandler_return_number(jhandler, 0);
+}
+
+
+// The socket ended, with UV__EOF or an error, after the data queued.
+// [0] status
+JHANDLER_FUNCTION(ReadEnd) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+
+  int status = (int)JHANDLER_GET_ARG(0, number);
+  if (_this->end_status == 0 && status < 0) {
+    _this->end_status = status;
+    if (!_this->secure && !_this->started) {
+      _this->ended = true;
+    }
+    iotjs_tls_cycle(tls_wrap);
+  }
+}
+
+
+static int iotjs_tls_encrypt(iotjs_tlswrap_t* tlswrap, const char* data,
+                             size_t length) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+
+  while (length > 0) {
+    int ret = mbedtls_ssl_write(&_this->ssl, (const unsigned char*)data,
+                                length);
+    if (ret < 0) {
+      return ret;
+    }
+    data += ret;
+    length -= (size_t)ret;
+  }
+  return 0;
+}
+
+
+static bool iotjs_tls_writable(iotjs_tlswrap_t* tlswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tlswrap);
+  return _this->secure && !_this->destroyed;
+}
+
+
+// [0] buffer
+// [1] callback
+JHANDLER_FUNCTION(Write) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  DJHANDLER_CHECK_ARGS(2, object, function);
+
+  if (!iotjs_tls_writable(tls_wrap)) {
+    iotjs_jhandler_return_number(jhandler, UV__ENOTCONN);
+    return;
+  }
+
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(0, object));
+  int err = iotjs_tls_encrypt(tls_wrap, iotjs_bufferwrap_buffer(buffer_wrap),
+                              iotjs_bufferwrap_length(buffer_wrap));
+  if (err == 0) {
+    err = iotjs_tls_flush(tls_wrap, JHANDLER_GET_ARG(1, function));
+  } else {
+    err = UV__EPROTO;
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Encrypts the buffers of an array, and writes the records by one request.
+// [0] array of buffers
+// [1] callback
+JHANDLER_FUNCTION(Writev) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  DJHANDLER_CHECK_ARGS(2, object, function);
+
+  if (!iotjs_tls_writable(tls_wrap)) {
+    iotjs_jhandler_return_number(jhandler, UV__ENOTCONN);
+    return;
+  }
+
+  const iotjs_jval_t* jchunks = JHANDLER_GET_ARG(0, object);
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jchunks, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t count = iotjs_jval_is_number(&jlength)
+                       ? (uint32_t)iotjs_jval_as_number(&jlength)
+                       : 0;
+  iotjs_jval_destroy(&jlength);
+
+  int err = 0;
+  for (uint32_t i = 0; i < count && err == 0; i++) {
+    iotjs_jval_t jbuffer = iotjs_jval_get_property_by_index(jchunks, i);
+    IOTJS_ASSERT(iotjs_jval_is_object(&jbuffer));
+    iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+    err = iotjs_tls_encrypt(tls_wrap, iotjs_bufferwrap_buffer(buffer_wrap),
+                            iotjs_bufferwrap_length(buffer_wrap));
+    iotjs_jval_destroy(&jbuffer);
+  }
+
+  if (err == 0) {
+    err = iotjs_tls_flush(tls_wrap, JHANDLER_GET_ARG(1, function));
+  } else {
+    err = UV__EPROTO;
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Sends the close_notify alert, ahead of the shutdown of the socket.
+JHANDLER_FUNCTION(CloseNotify) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+
+  int err = 0;
+  if (iotjs_tls_writable(tls_wrap)) {
+    IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+    mbedtls_ssl_close_notify(&_this->ssl);
+    err = iotjs_tls_flush(tls_wrap, NULL);
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Drops the state of the connection, before the socket is closed.
+JHANDLER_FUNCTION(Destroy) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+
+  _this->destroyed = true;
+  _this->reading = false;
+  if (!_this->busy) {
+    iotjs_tlswrap_release(tls_wrap);
+  }
+}
+
+
+// [0] host name to send, and to verify the certificate of the server with
+JHANDLER_FUNCTION(SetServername) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  DJHANDLER_CHECK_ARGS(1, string);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+
+  iotjs_string_t servername = JHANDLER_GET_ARG(0, string);
+  int ret = mbedtls_ssl_set_hostname(&_this->ssl,
+                                     iotjs_string_data(&servername));
+  iotjs_string_destroy(&servername);
+
+  iotjs_jhandler_return_number(jhandler, ret);
+}
+
+
+// Returns the session of the connection as a Buffer, to resume it later by
+// setSession, or undefined.
+JHANDLER_FUNCTION(GetSession) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+
+  if (!iotjs_tls_writable(tls_wrap)) {
+    return;
+  }
+
+  mbedtls_ssl_session session;
+  mbedtls_ssl_session_init(&session);
+
+  size_t size = 0;
+  if (mbedtls_ssl_get_session(&_this->ssl, &session) == 0 &&
+      mbedtls_ssl_session_save(&session, NULL, 0, &size) ==
+          MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL) {
+    iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(size);
+    iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+    if (mbedtls_ssl_session_save(
+            &session, (unsigned char*)iotjs_bufferwrap_buffer(buffer_wrap),
+            size, &size) == 0) {
+      iotjs_jhandler_return_jval(jhandler, &jbuffer);
+    }
+    iotjs_jval_destroy(&jbuffer);
+  }
+
+  mbedtls_ssl_session_free(&session);
+}
+
+
+// Offers a session of an earlier connection to the server, before the
+// handshake.
+// [0] buffer of getSession
+JHANDLER_FUNCTION(SetSession) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  DJHANDLER_CHECK_ARGS(1, object);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(0, object));
+
+  mbedtls_ssl_session session;
+  mbedtls_ssl_session_init(&session);
+
+  int ret = mbedtls_ssl_session_load(
+      &session, (const unsigned char*)iotjs_bufferwrap_buffer(buffer_wrap),
+      iotjs_bufferwrap_length(buffer_wrap));
+  if (ret == 0) {
+    ret = mbedtls_ssl_set_session(&_this->ssl, &session);
+  }
+
+  mbedtls_ssl_session_free(&session);
+
+  iotjs_jhandler_return_number(jhandler, ret);
+}
+
+
+JHANDLER_FUNCTION(IsSessionReused) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+
+  iotjs_jhandler_return_boolean(jhandler, _this->secure && _this->resumed);
+}
+
+
+// Returns why the certificate of the peer did not verify, or null.
+JHANDLER_FUNCTION(VerifyError) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+
+  if (!iotjs_tls_writable(tls_wrap)) {
+    iotjs_jhandler_return_null(jhandler);
+    return;
+  }
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+  uint32_t flags = mbedtls_ssl_get_verify_result(&_this->ssl);
+  if (flags == 0) {
+    iotjs_jhandler_return_null(jhandler);
+    return;
+  }
+
+  char info[128];
+  int len = mbedtls_x509_crt_verify_info(info, sizeof(info), "", flags);
+  // The first of the reasons, one per line.
+  char* newline = len > 0 ? strchr(info, '\n') : NULL;
+  if (newline != NULL) {
+    *newline = '\0';
+  }
+  iotjs_jhandler_return_string_raw(jhandler, len > 0 ? info : "unknown");
+}
+
+
+JHANDLER_FUNCTION(GetProtocol) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+
+  if (!iotjs_tls_writable(tls_wrap)) {
+    iotjs_jhandler_return_null(jhandler);
+    return;
+  }
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+  iotjs_jhandler_return_string_raw(jhandler,
+                                   mbedtls_ssl_get_version(&_this->ssl));
+}
+
+
+JHANDLER_FUNCTION(GetCipher) {
+  JHANDLER_DECLARE_THIS_PTR(tlswrap, tls_wrap);
+
+  if (!iotjs_tls_writable(tls_wrap)) {
+    iotjs_jhandler_return_null(jhandler);
+    return;
+  }
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_tlswrap_t, tls_wrap);
+  iotjs_jhandler_return_string_raw(jhandler,
+                                   mbedtls_ssl_get_ciphersuite(&_this->ssl));
+}
+
+
+#define SECURECONTEXT_DECLARE_THIS(name)                                   \
+  iotjs_securecontext_t* name##_context =                                  \
+      (iotjs_securecontext_t*)iotjs_jval_get_object_from_jhandler(         \
+          jhandler, &securecontext_native_info);                           \
+  if (!name##_context) {                                                   \
+    return;                                                                \
+  }                                                                        \
+  iotjs_tls_config_t* name = iotjs_securecontext_config(name##_context);
+
+
+// [0] isServer
+JHANDLER_FUNCTION(SecureContext) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(1, boolean);
+
+  bool is_server = JHANDLER_GET_ARG(0, boolean);
+
+  int ret = iotjs_tls_seed_drbg();
+  if (ret != 0) {
+    JHANDLER_THROW(COMMON, "TLS random generator cannot be seeded");
+    return;
+  }
+
+  iotjs_tls_config_t* config = IOTJS_ALLOC(iotjs_tls_config_t);
+  config->refs = 1;
+  mbedtls_ssl_config_init(&config->conf);
+  mbedtls_x509_crt_init(&config->ca);
+  mbedtls_x509_crt_init(&config->cert);
+  mbedtls_pk_init(&config->key);
+
+  ret = mbedtls_ssl_config_defaults(
+      &config->conf, is_server ? MBEDTLS_SSL_IS_SERVER : MBEDTLS_SSL_IS_CLIENT,
+      MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+  mbedtls_ssl_conf_rng(&config->conf, mbedtls_ctr_drbg_random, &tls_drbg);
+  // Clients verify the certificate and leave the decision to JavaScript.
+  mbedtls_ssl_conf_authmode(&config->conf, is_server
+                                               ? MBEDTLS_SSL_VERIFY_NONE
+                                               : MBEDTLS_SSL_VERIFY_OPTIONAL);
+
+  iotjs_securecontext_t* context = IOTJS_ALLOC(iotjs_securecontext_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_securecontext_t, context);
+  iotjs_jobjectwrap_initialize(&_this->jobjectwrap, JHANDLER_GET_THIS(object),
+                               &securecontext_native_info);
+  _this->config = config;
+
+  if (ret != 0) {
+    JHANDLER_THROW(COMMON, "TLS configuration failed");
+  }
+}
+
+
+// mbedTLS parses PEM only with the terminating zero counted in the length.
+static int iotjs_tls_parse(const iotjs_jval_t* jbuffer, bool is_key,
+                           iotjs_tls_config_t* config, const char* password) {
+  iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(jbuffer);
+  size_t length = iotjs_bufferwrap_length(buffer_wrap);
+  unsigned char* data = (unsigned char*)iotjs_buffer_allocate(length + 1);
+  memcpy(data, iotjs_bufferwrap_buffer(buffer_wrap), length);
+  data[length] = '\0';
+
+  int ret;
+  if (is_key) {
+    ret = mbedtls_pk_parse_key(&config->key, data, length + 1,
+                               (const unsigned char*)password,
+                               password != NULL ? strlen(password) : 0);
+  } else {
+    ret = mbedtls_x509_crt_parse(&config->cert, data, length + 1);
+  }
+
+  iotjs_buffer_release((char*)data);
+  return ret;
+}
+
+
+// Adds trusted certificates.
+// [0] buffer of PEM or DER certificates
+JHANDLER_FUNCTION(SetCA) {
+  SECURECONTEXT_DECLARE_THIS(config);
+  DJHANDLER_CHECK_ARGS(1, object);
+
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(0, object));
+  size_t length = iotjs_bufferwrap_length(buffer_wrap);
+  unsigned char* data = (unsigned char*)iotjs_buffer_allocate(length + 1);
+  memcpy(data, iotjs_bufferwrap_buffer(buffer_wrap), length);
+  data[length] = '\0';
+
+  int ret = mbedtls_x509_crt_parse(&config->ca, data, length + 1);
+  iotjs_buffer_release((char*)data);
+
+  if (ret >= 0) {
+    mbedtls_ssl_conf_ca_chain(&config->conf, &config->ca, NULL);
+  }
+
+  iotjs_jhandler_return_number(jhandler, ret < 0 ? ret : 0);
+}
+
+
+// Sets the certificate chain and the private key presented to the peer.
+// [0] buffer of certificates
+// [1] buffer of the key
+// [2] passphrase of the key (optional)
+JHANDLER_FUNCTION(SetCert) {
+  SECURECONTEXT_DECLARE_THIS(config);
+  DJHANDLER_CHECK_ARGS(2, object, object);
+
+  iotjs_string_t passphrase = iotjs_string_create();
+  if (iotjs_jhandler_get_arg_length(jhandler) > 2 &&
+      iotjs_jval_is_string(iotjs_jhandler_get_arg(jhandler, 2))) {
+    iotjs_string_destroy(&passphrase);
+    passphrase = JHANDLER_GET_ARG(2, string);
+  }
+
+  int ret = iotjs_tls_parse(JHANDLER_GET_ARG(0, object), false, config, NULL);
+  if (ret == 0) {
+    ret = iotjs_tls_parse(JHANDLER_GET_ARG(1, object), true, config,
+                          iotjs_string_is_empty(&passphrase)
+                              ? NULL
+                              : iotjs_string_data(&passphrase));
+  }
+  if (ret == 0) {
+    ret = mbedtls_ssl_conf_own_cert(&config->conf, &config->cert,
+                                    &config->key);
+  }
+
+  iotjs_string_destroy(&passphrase);
+
+  iotjs_jhandler_return_number(jhandler, ret);
+}
+
+
+// [0] MBEDTLS_SSL_VERIFY_NONE, _OPTIONAL or _REQUIRED, as 0, 1 or 2
+JHANDLER_FUNCTION(SetVerify) {
+  SECURECONTEXT_DECLARE_THIS(config);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  int mode = (int)JHANDLER_GET_ARG(0, number);
+  JHANDLER_CHECK(mode >= 0 && mode <= 2);
+  mbedtls_ssl_conf_authmode(&config->conf, mode);
+}
+
+
+// Lets a server hand out session tickets, for the clients to resume their
+// sessions with, without a cache of the sessions on the server.
+// [0] lifetime of a ticket in seconds
+JHANDLER_FUNCTION(EnableTickets) {
+  SECURECONTEXT_DECLARE_THIS(config);
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  int ret = MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
+#if defined(MBEDTLS_SSL_TICKET_C)
+  ret = 0;
+  if (!config->has_ticket) {
+    mbedtls_ssl_ticket_init(&config->ticket);
+    ret = mbedtls_ssl_ticket_setup(&config->ticket, mbedtls_ctr_drbg_random,
+                                   &tls_drbg, MBEDTLS_CIPHER_AES_256_GCM,
+                                   (uint32_t)JHANDLER_GET_ARG(0, number));
+    if (ret == 0) {
+      config->has_ticket = true;
+      mbedtls_ssl_conf_session_tickets_cb(&config->conf,
+                                          mbedtls_ssl_ticket_write,
+                                          mbedtls_ssl_ticket_parse,
+                                          &config->ticket);
+    } else {
+      mbedtls_ssl_ticket_free(&config->ticket);
+    }
+  }
+#endif
+
+  iotjs_jhandler_return_number(jhandler, ret);
+}
+
+
+// Returns the description of an mbedTLS error code.
+// [0] error code
+JHANDLER_FUNCTION(ErrorString) {
+  DJHANDLER_CHECK_ARGS(1, number);
+
+  int code = (int)JHANDLER_GET_ARG(0, number);
+  char message[128];
+#if defined(MBEDTLS_ERROR_C)
+  mbedtls_strerror(code, message, sizeof(message));
+#else
+  snprintf(message, sizeof(message), "mbedTLS error -0x%04X",
+           (unsigned)(code < 0 ? -code : code));
+#endif
+
+  iotjs_jhandler_return_string_raw(jhandler, message);
+}
+
+
+iotjs_jval_t InitTls() {
+  iotjs_jval_t tls = iotjs_jval_create_object();
+
+  iotjs_jval_t jtls = iotjs_jval_create_function_with_dispatch(TLS);
+  iotjs_jval_t prototype = iotjs_jval_create_object();
+
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONREAD, GetOnRead,
+                          SetOnRead);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_OWNER, GetOwner,
+                          SetOwner);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONHANDSHAKE,
+                          GetOnHandshake, SetOnHandshake);
+
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READSTART, ReadStart);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READSTOP, ReadStop);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_READEND, ReadEnd);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITE, Write);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITEV, Writev);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_CLOSENOTIFY,
+                        CloseNotify);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_DESTROY, Destroy);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETSERVERNAME,
+                        SetServername);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_GETSESSION, GetSession);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETSESSION, SetSession);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_ISSESSIONREUSED,
+                        IsSessionReused);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_VERIFYERROR,
+                        VerifyError);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_GETPROTOCOL,
+                        GetProtocol);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_GETCIPHER, GetCipher);
+
+  iotjs_jval_set_property_jval(&jtls, IOTJS_MAGIC_STRING_PROTOTYPE,
+                               &prototype);
+  iotjs_jval_set_property_jval(&tls, IOTJS_MAGIC_STRING_TLS, &jtls);
+  iotjs_jval_destroy(&prototype);
+  iotjs_jval_destroy(&jtls);
+
+  iotjs_jval_t jcontext =
+      iotjs_jval_create_function_with_dispatch(SecureContext);
+  prototype = iotjs_jval_create_object();
+
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETCA, SetCA);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETCERT, SetCert);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETVERIFY, SetVerify);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_ENABLETICKETS,
+                        EnableTickets);
+
+  iotjs_jval_set_property_jval(&jcontext, IOTJS_MAGIC_STRING_PROTOTYPE,
+                               &prototype);
+  iotjs_jval_set_property_jval(&tls, IOTJS_MAGIC_STRING_SECURECONTEXT,
+                               &jcontext);
+  iotjs_jval_destroy(&prototype);
+  iotjs_jval_destroy(&jcontext);
+
+  iotjs_jval_set_method(&tls, IOTJS_MAGIC_STRING_ERRORSTRING, ErrorString);
+
+  return tls;
+}
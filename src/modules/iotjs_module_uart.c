@@ -13,11 +13,31 @@
  * limitations under the License.
  */
 
+#include <errno.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "iotjs_def.h"
+#include "iotjs_module_buffer.h"
 #include "iotjs_module_uart.h"
 #include "iotjs_objectwrap.h"
+#if ENABLE_MODULE_TCP
+#include "iotjs_module_tcp.h"
+#endif
+
+
+struct iotjs_uart_write_s {
+  iotjs_uart_write_t* next;
+  char* data;
+  size_t length;
+  size_t offset;
+  iotjs_jval_t jcallback;
+  // Data of the bridged socket, in a buffer of the read buffer pool.
+  bool bridged;
+};
+
+
+static void iotjs_uart_bridge_stop(iotjs_uart_t* uart);
 
 
 static iotjs_uart_t* iotjs_uart_instance_from_jval(const iotjs_jval_t* juart);
@@ -32,6 +52,7 @@ static iotjs_uart_t* iotjs_uart_create(const iotjs_jval_t* juart) {
                               &this_module_native_info);
 
   _this->device_fd = -1;
+  _this->delimiter = -1;
   return uart;
 }
 
@@ -39,6 +60,9 @@ static void iotjs_uart_destroy(iotjs_uart_t* uart) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_uart_t, uart);
   iotjs_handlewrap_destroy(&_this->handlewrap);
   iotjs_string_destroy(&_this->device_path);
+  if (_this->frame_buf != NULL) {
+    iotjs_buffer_release(_this->frame_buf);
+  }
   IOTJS_RELEASE(uart);
 }
 
@@ -46,9 +70,14 @@ static void iotjs_uart_destroy(iotjs_uart_t* uart) {
 #define THIS iotjs_uart_reqwrap_t* uart_reqwrap
 
 
+IOTJS_DEFINE_POOL(uart_reqwrap_pool, iotjs_uart_reqwrap_t, "uart",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 static iotjs_uart_reqwrap_t* iotjs_uart_reqwrap_create(
     const iotjs_jval_t* jcallback, iotjs_uart_t* uart, UartOp op) {
-  iotjs_uart_reqwrap_t* uart_reqwrap = IOTJS_ALLOC(iotjs_uart_reqwrap_t);
+  iotjs_uart_reqwrap_t* uart_reqwrap =
+      IOTJS_POOL_ALLOC(uart_reqwrap_pool, iotjs_uart_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_uart_reqwrap_t, uart_reqwrap);
 
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -63,7 +92,7 @@ static iotjs_uart_reqwrap_t* iotjs_uart_reqwrap_create(
 static void iotjs_uart_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_uart_reqwrap_t, uart_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(uart_reqwrap);
+  IOTJS_POOL_RELEASE(uart_reqwrap_pool, uart_reqwrap);
 }
 
 
@@ -73,7 +102,7 @@ static void iotjs_uart_reqwrap_dispatched(THIS) {
 }
 
 
-static uv_work_t* iotjs_uart_reqwrap_req(THIS) {
+static iotjs_bus_work_t* iotjs_uart_reqwrap_req(THIS) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_reqwrap_t, uart_reqwrap);
   return &_this->req;
 }
@@ -130,10 +159,10 @@ static bool iotjs_uart_close(iotjs_uart_t* uart) {
 }
 
 
-static void iotjs_uart_write_worker(uv_work_t* work_req) {
+static void iotjs_uart_close_worker(uv_work_t* work_req) {
   UART_WORKER_INIT;
 
-  if (!iotjs_uart_write(uart)) {
+  if (!iotjs_uart_close(uart)) {
     req_data->result = false;
     return;
   }
@@ -142,15 +171,113 @@ static void iotjs_uart_write_worker(uv_work_t* work_req) {
 }
 
 
-static void iotjs_uart_close_worker(uv_work_t* work_req) {
-  UART_WORKER_INIT;
+static bool iotjs_uart_bridge_paused(iotjs_uart_bridge_t* bridge);
 
-  if (!iotjs_uart_close(uart)) {
-    req_data->result = false;
+
+static void iotjs_uart_update_poll(iotjs_uart_t* uart) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  int events = 0;
+  if (_this->bridge == NULL || !iotjs_uart_bridge_paused(_this->bridge)) {
+    events |= UV_READABLE;
+  }
+  if (_this->write_head != NULL) {
+    events |= UV_WRITABLE;
+  }
+  if (events != _this->poll_events) {
+    uv_poll_start(&_this->poll_handle, events, iotjs_uart_poll_cb);
+    _this->poll_events = events;
+  }
+}
+
+
+static void iotjs_uart_bridge_written(iotjs_uart_t* uart, size_t length);
+
+
+// Takes the first queued write off and calls back with `error`, or with null
+// when it is NULL. Writes done from JS are called back on the next tick.
+static void iotjs_uart_write_done(iotjs_uart_t* uart, const char* error,
+                                  bool next_tick) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  iotjs_uart_write_t* req = _this->write_head;
+  _this->write_head = req->next;
+  if (_this->write_head == NULL) {
+    _this->write_tail = NULL;
+  }
+
+  if (req->bridged) {
+    iotjs_uart_bridge_written(uart, req->length);
+    iotjs_read_buffer_release(req->data);
+    IOTJS_RELEASE(req);
     return;
   }
 
-  req_data->result = true;
+  iotjs_jval_t jerror = error ? iotjs_jval_create_error(error)
+                              : iotjs_jval_create_copied(iotjs_jval_get_null());
+  if (next_tick) {
+    iotjs_jval_t jargs = iotjs_jval_create_array(1);
+    iotjs_jval_set_property_by_index(&jargs, 0, &jerror);
+    iotjs_process_queue_next_tick(&req->jcallback, &jargs);
+    iotjs_jval_destroy(&jargs);
+  } else {
+    iotjs_jargs_t jargs = iotjs_jargs_create(1);
+    iotjs_jargs_append_jval(&jargs, &jerror);
+    iotjs_make_callback_in_lane(kCallbackLaneHigh, &req->jcallback,
+                                iotjs_jval_get_undefined(), &jargs);
+    iotjs_jargs_destroy(&jargs);
+  }
+  iotjs_jval_destroy(&jerror);
+
+  iotjs_jval_destroy(&req->jcallback);
+  iotjs_buffer_release(req->data);
+  IOTJS_RELEASE(req);
+}
+
+
+// Writes the queued data as far as the device takes it without blocking. The
+// rest waits for the poll handle to report the device writable.
+static void iotjs_uart_flush_writes(iotjs_uart_t* uart, bool next_tick) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  if (_this->device_fd < 0) {
+    return;
+  }
+
+  while (_this->write_head != NULL && !_this->closing) {
+    iotjs_uart_write_t* req = _this->write_head;
+    ssize_t written = write(_this->device_fd, req->data + req->offset,
+                            req->length - req->offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      iotjs_uart_write_done(uart, "Cannot write to device", next_tick);
+      continue;
+    }
+
+    req->offset += (size_t)written;
+    if (req->offset == req->length) {
+      iotjs_uart_write_done(uart, NULL, next_tick);
+    }
+  }
+
+  if (!_this->closing) {
+    iotjs_uart_update_poll(uart);
+  }
+}
+
+
+static void iotjs_uart_opened(iotjs_uart_t* uart) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  if (_this->frame_length > 0 && _this->inter_byte_timeout == 0) {
+    iotjs_uart_set_read_min(uart, _this->frame_length);
+  }
+  iotjs_uart_flush_writes(uart, true);
 }
 
 
@@ -170,19 +297,7 @@ static void iotjs_uart_after_worker(uv_work_t* work_req, int status) {
         if (!req_data->result) {
           iotjs_jargs_append_error(&jargs, "Failed to open UART device");
         } else {
-          iotjs_jargs_append_null(&jargs);
-        }
-        break;
-      }
-      case kUartOpWrite: {
-        iotjs_uart_t* uart = iotjs_uart_instance_from_reqwrap(req_wrap);
-        IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
-
-        iotjs_string_destroy(&_this->buf_data);
-
-        if (!req_data->result) {
-          iotjs_jargs_append_error(&jargs, "Cannot write to device");
-        } else {
+          iotjs_uart_opened(iotjs_uart_instance_from_reqwrap(req_wrap));
           iotjs_jargs_append_null(&jargs);
         }
         break;
@@ -203,7 +318,8 @@ static void iotjs_uart_after_worker(uv_work_t* work_req, int status) {
   }
 
   const iotjs_jval_t* jcallback = iotjs_uart_reqwrap_jcallback(req_wrap);
-  iotjs_make_callback(jcallback, iotjs_jval_get_undefined(), &jargs);
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, jcallback,
+                              iotjs_jval_get_undefined(), &jargs);
 
   iotjs_jargs_destroy(&jargs);
   iotjs_uart_reqwrap_dispatched(req_wrap);
@@ -219,7 +335,7 @@ static void iotjs_uart_onread(iotjs_jval_t* jthis, char* buf) {
   iotjs_jval_t data = iotjs_jval_create_string_raw(buf);
   iotjs_jargs_append_jval(&jargs, &str);
   iotjs_jargs_append_jval(&jargs, &data);
-  iotjs_jhelper_call_ok(&jemit, jthis, &jargs);
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, &jemit, jthis, &jargs);
 
   iotjs_jval_destroy(&str);
   iotjs_jval_destroy(&data);
@@ -228,10 +344,126 @@ static void iotjs_uart_onread(iotjs_jval_t* jthis, char* buf) {
 }
 
 
-void iotjs_uart_read_cb(uv_poll_t* req, int status, int events) {
+static void iotjs_uart_emit_frame(iotjs_uart_t* uart, const char* data,
+                                  size_t length) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  iotjs_jval_t jemit =
+      iotjs_jval_get_property(&_this->jemitter_this, IOTJS_MAGIC_STRING_EMIT);
+  IOTJS_ASSERT(iotjs_jval_is_function(&jemit));
+
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(length);
+  iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+  iotjs_bufferwrap_copy(buffer, data, length);
+
+  iotjs_jargs_t jargs = iotjs_jargs_create(2);
+  iotjs_jval_t str = iotjs_jval_create_string_raw("data");
+  iotjs_jargs_append_jval(&jargs, &str);
+  iotjs_jargs_append_jval(&jargs, &jbuffer);
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, &jemit, &_this->jemitter_this,
+                              &jargs);
+
+  iotjs_jval_destroy(&str);
+  iotjs_jval_destroy(&jbuffer);
+  iotjs_jargs_destroy(&jargs);
+  iotjs_jval_destroy(&jemit);
+}
+
+
+static void iotjs_uart_frame_timeout(uv_timer_t* timer) {
+  iotjs_uart_t* uart = (iotjs_uart_t*)timer->data;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  size_t length = _this->frame_len;
+  _this->frame_len = 0;
+  if (length > 0 && !_this->closing) {
+    iotjs_uart_emit_frame(uart, _this->frame_buf, length);
+  }
+}
+
+
+// Reads into the frame buffer behind the bytes of the frame in progress, and
+// emits the frames completed. A frame that fills the buffer without its
+// delimiter is emitted as it is.
+static void iotjs_uart_read_frames(iotjs_uart_t* uart) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  ssize_t count = read(_this->device_fd, _this->frame_buf + _this->frame_len,
+                       _this->frame_cap - _this->frame_len);
+  if (count <= 0) {
+    return;
+  }
+
+  size_t scan = _this->frame_len;
+  _this->frame_len += (size_t)count;
+
+  size_t start = 0;
+  if (_this->delimiter >= 0) {
+    for (size_t i = scan; i < _this->frame_len && !_this->closing; ++i) {
+      if ((uint8_t)_this->frame_buf[i] == _this->delimiter) {
+        iotjs_uart_emit_frame(uart, _this->frame_buf + start, i - start);
+        start = i + 1;
+      }
+    }
+  } else if (_this->frame_length > 0) {
+    while (_this->frame_len - start >= _this->frame_length &&
+           !_this->closing) {
+      iotjs_uart_emit_frame(uart, _this->frame_buf + start,
+                            _this->frame_length);
+      start += _this->frame_length;
+    }
+  }
+  if (start == 0 && _this->frame_len == _this->frame_cap && !_this->closing) {
+    iotjs_uart_emit_frame(uart, _this->frame_buf, _this->frame_len);
+    start = _this->frame_len;
+  }
+
+  if (_this->closing) {
+    _this->frame_len = 0;
+    return;
+  }
+
+  _this->frame_len -= start;
+  memmove(_this->frame_buf, _this->frame_buf + start, _this->frame_len);
+
+  if (_this->inter_byte_timeout > 0) {
+    if (_this->frame_len > 0) {
+      uv_timer_start(&_this->frame_timer, iotjs_uart_frame_timeout,
+                     _this->inter_byte_timeout, 0);
+    } else {
+      uv_timer_stop(&_this->frame_timer);
+    }
+  } else if (_this->frame_length > 0) {
+    iotjs_uart_set_read_min(uart, _this->frame_length - _this->frame_len);
+  }
+}
+
+
+static void iotjs_uart_bridge_read(iotjs_uart_t* uart);
+
+
+void iotjs_uart_poll_cb(uv_poll_t* req, int status, int events) {
   iotjs_uart_t* uart = (iotjs_uart_t*)req->data;
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
 
+  if (events & UV_WRITABLE) {
+    iotjs_uart_flush_writes(uart, false);
+  }
+
+  if (!(events & UV_READABLE) || _this->closing) {
+    return;
+  }
+
+  if (_this->bridge != NULL) {
+    iotjs_uart_bridge_read(uart);
+    return;
+  }
+
+  if (_this->frame_buf != NULL) {
+    iotjs_uart_read_frames(uart);
+    return;
+  }
+
   char buf[UART_WRITE_BUFFER_SIZE];
   int i = read(_this->device_fd, buf, UART_WRITE_BUFFER_SIZE - 1);
   if (i > 0) {
@@ -242,14 +474,261 @@ void iotjs_uart_read_cb(uv_poll_t* req, int status, int events) {
 }
 
 
-#define UART_ASYNC(call, this, jcallback, op)                          \
-  do {                                                                 \
-    uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get()); \
-    iotjs_uart_reqwrap_t* req_wrap =                                   \
-        iotjs_uart_reqwrap_create(jcallback, this, op);                \
-    uv_work_t* req = iotjs_uart_reqwrap_req(req_wrap);                 \
-    uv_queue_work(loop, req, iotjs_uart_##call##_worker,               \
-                  iotjs_uart_after_worker);                            \
+#if ENABLE_MODULE_TCP
+
+// A port connected to a TCP socket natively: the data read from either one
+// is written to the other, and the side read from pauses while the other
+// one has more than `high_water_mark` bytes to write. The socket object is
+// kept alive, so its handle can be checked until the bridge is released.
+struct iotjs_uart_bridge_s {
+  iotjs_uart_t* uart;
+  iotjs_tcpwrap_t* tcp_wrap;
+  uv_stream_t* tcp;
+  iotjs_jval_t jtcp;
+  // Hands the data read by the socket to the bridge.
+  iotjs_tcp_splice_t* splice;
+  size_t high_water_mark;
+  // Bytes of the socket queued to be written to the port.
+  size_t queued;
+  // The port, and each write to the socket in flight.
+  uint32_t refs;
+  // The port is not read while the socket is behind.
+  bool paused;
+};
+
+
+typedef struct {
+  uv_write_t req;
+  char* base;
+  iotjs_uart_bridge_t* bridge;
+} iotjs_uart_bridge_write_t;
+
+
+static void iotjs_uart_bridge_unref(iotjs_uart_bridge_t* bridge) {
+  if (--bridge->refs == 0) {
+    iotjs_jval_destroy(&bridge->jtcp);
+    IOTJS_RELEASE(bridge);
+  }
+}
+
+
+static bool iotjs_uart_bridge_paused(iotjs_uart_bridge_t* bridge) {
+  return bridge->paused;
+}
+
+
+// Queues data read from the socket to be written to the port.
+static int iotjs_uart_bridge_sink_write(void* data, char* base,
+                                        size_t length) {
+  iotjs_uart_bridge_t* bridge = (iotjs_uart_bridge_t*)data;
+  iotjs_uart_t* uart = bridge->uart;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  if (_this->closing || _this->device_fd < 0) {
+    return UV__EPIPE;
+  }
+
+  iotjs_uart_write_t* req = IOTJS_ALLOC(iotjs_uart_write_t);
+  req->data = base;
+  req->length = length;
+  req->bridged = true;
+  bridge->queued += length;
+
+  if (_this->write_tail != NULL) {
+    _this->write_tail->next = req;
+  } else {
+    _this->write_head = req;
+  }
+  _this->write_tail = req;
+
+  if (req == _this->write_head) {
+    iotjs_uart_flush_writes(uart, false);
+  }
+  return 0;
+}
+
+
+static size_t iotjs_uart_bridge_sink_queued(void* data) {
+  return ((iotjs_uart_bridge_t*)data)->queued;
+}
+
+
+static const iotjs_tcp_sink_t iotjs_uart_bridge_sink = {
+  iotjs_uart_bridge_sink_write, iotjs_uart_bridge_sink_queued,
+};
+
+
+static void iotjs_uart_bridge_written(iotjs_uart_t* uart, size_t length) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  // Data queued before the bridge stopped is dropped with the port.
+  iotjs_uart_bridge_t* bridge = _this->bridge;
+  if (bridge != NULL) {
+    bridge->queued -= length;
+    iotjs_tcp_splice_drained(bridge->tcp_wrap);
+  }
+}
+
+
+static void iotjs_uart_bridge_after_write(uv_write_t* req, int status) {
+  iotjs_uart_bridge_write_t* write = (iotjs_uart_bridge_write_t*)req;
+  iotjs_uart_bridge_t* bridge = write->bridge;
+  IOTJS_UNUSED(status);
+
+  iotjs_read_buffer_release(write->base);
+  IOTJS_RELEASE(write);
+
+  // Failed writes are reported by the socket itself.
+  iotjs_uart_t* uart = bridge->uart;
+  if (uart != NULL && bridge->paused &&
+      bridge->tcp->write_queue_size <= bridge->high_water_mark) {
+    bridge->paused = false;
+    IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+    if (!_this->closing) {
+      iotjs_uart_update_poll(uart);
+    }
+  }
+
+  iotjs_uart_bridge_unref(bridge);
+}
+
+
+// Writes the data read from the port to the socket.
+static void iotjs_uart_bridge_read(iotjs_uart_t* uart) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+  iotjs_uart_bridge_t* bridge = _this->bridge;
+
+  size_t size = UART_FRAME_BUFFER_SIZE;
+  char* base = iotjs_read_buffer_allocate(&size);
+  ssize_t count = read(_this->device_fd, base, size);
+  if (count <= 0 || uv_is_closing((uv_handle_t*)bridge->tcp)) {
+    iotjs_read_buffer_release(base);
+    return;
+  }
+
+  iotjs_uart_bridge_write_t* write = IOTJS_ALLOC(iotjs_uart_bridge_write_t);
+  write->base = base;
+  write->bridge = bridge;
+
+  uv_buf_t data = uv_buf_init(base, (unsigned int)count);
+  if (uv_write(&write->req, bridge->tcp, &data, 1,
+               iotjs_uart_bridge_after_write) != 0) {
+    iotjs_read_buffer_release(base);
+    IOTJS_RELEASE(write);
+    return;
+  }
+  bridge->refs++;
+
+  if (bridge->tcp->write_queue_size > bridge->high_water_mark) {
+    bridge->paused = true;
+    iotjs_uart_update_poll(uart);
+  }
+}
+
+
+static void iotjs_uart_bridge_stop(iotjs_uart_t* uart) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+  iotjs_uart_bridge_t* bridge = _this->bridge;
+  if (bridge == NULL) {
+    return;
+  }
+
+  iotjs_tcp_splice_stop(bridge->tcp_wrap);
+  iotjs_tcp_splice_detach(bridge->splice);
+  _this->bridge = NULL;
+  bridge->uart = NULL;
+  iotjs_uart_bridge_unref(bridge);
+
+  if (!_this->closing) {
+    iotjs_uart_update_poll(uart);
+  }
+}
+
+
+// bridge(tcp, highWaterMark)
+// Connects the port to a connected TCP socket. Returns 0 or an error code.
+JHANDLER_FUNCTION(Bridge) {
+  JHANDLER_DECLARE_THIS_PTR(uart, uart);
+  DJHANDLER_CHECK_ARGS(2, object, number);
+
+  const iotjs_jval_t* jtcp = JHANDLER_GET_ARG(0, object);
+  double high_water_mark = JHANDLER_GET_ARG(1, number);
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+  if (_this->bridge != NULL || _this->closing || _this->device_fd < 0) {
+    iotjs_jhandler_return_number(jhandler, UV__EINVAL);
+    return;
+  }
+
+  iotjs_tcpwrap_t* tcp_wrap = iotjs_tcpwrap_from_jobject(jtcp);
+
+  iotjs_uart_bridge_t* bridge = IOTJS_ALLOC(iotjs_uart_bridge_t);
+  bridge->uart = uart;
+  bridge->tcp_wrap = tcp_wrap;
+  bridge->tcp = (uv_stream_t*)iotjs_tcpwrap_tcp_handle(tcp_wrap);
+  bridge->jtcp = iotjs_jval_create_copied(jtcp);
+  bridge->high_water_mark =
+      high_water_mark > 0 ? (size_t)high_water_mark : 0;
+  bridge->refs = 1;
+
+  int err = iotjs_tcp_splice_to_sink(tcp_wrap, &iotjs_uart_bridge_sink,
+                                     bridge, bridge->high_water_mark,
+                                     &bridge->splice);
+  if (err) {
+    if (bridge->splice != NULL) {
+      iotjs_tcp_splice_stop(tcp_wrap);
+      iotjs_tcp_splice_detach(bridge->splice);
+    }
+    iotjs_uart_bridge_unref(bridge);
+  } else {
+    _this->bridge = bridge;
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Disconnects the port from its socket. Both are read as before.
+JHANDLER_FUNCTION(Unbridge) {
+  JHANDLER_DECLARE_THIS_PTR(uart, uart);
+  DJHANDLER_CHECK_ARGS(0);
+
+  iotjs_uart_bridge_stop(uart);
+}
+
+#else
+
+static bool iotjs_uart_bridge_paused(iotjs_uart_bridge_t* bridge) {
+  IOTJS_UNUSED(bridge);
+  return false;
+}
+
+
+static void iotjs_uart_bridge_written(iotjs_uart_t* uart, size_t length) {
+  IOTJS_UNUSED(uart);
+  IOTJS_UNUSED(length);
+}
+
+
+static void iotjs_uart_bridge_read(iotjs_uart_t* uart) {
+  IOTJS_UNUSED(uart);
+}
+
+
+static void iotjs_uart_bridge_stop(iotjs_uart_t* uart) {
+  IOTJS_UNUSED(uart);
+}
+
+#endif /* ENABLE_MODULE_TCP */
+
+
+#define UART_ASYNC(call, this, jcallback, op)                                 \
+  do {                                                                        \
+    iotjs_uart_reqwrap_t* req_wrap =                                          \
+        iotjs_uart_reqwrap_create(jcallback, this, op);                       \
+    iotjs_bus_work_t* req = iotjs_uart_reqwrap_req(req_wrap);                 \
+    iotjs_busqueue_work(iotjs_busqueue_peripheral(), req,                     \
+                        iotjs_uart_##call##_worker, iotjs_uart_after_worker); \
   } while (0)
 
 
@@ -288,25 +767,113 @@ JHANDLER_FUNCTION(UartConstructor) {
   iotjs_jval_destroy(&jbaud_rate);
   iotjs_jval_destroy(&jdata_bits);
 
+  iotjs_jval_t jdelimiter =
+      iotjs_jval_get_property(jconfiguration, IOTJS_MAGIC_STRING_DELIMITER);
+  iotjs_jval_t jframe_length =
+      iotjs_jval_get_property(jconfiguration, IOTJS_MAGIC_STRING_FRAMELENGTH);
+  iotjs_jval_t jinter_byte_timeout =
+      iotjs_jval_get_property(jconfiguration,
+                              IOTJS_MAGIC_STRING_INTERBYTETIMEOUT);
+
+  if (iotjs_jval_is_number(&jdelimiter)) {
+    _this->delimiter = (int)iotjs_jval_as_number(&jdelimiter);
+  }
+  if (iotjs_jval_is_number(&jframe_length)) {
+    _this->frame_length = (size_t)iotjs_jval_as_number(&jframe_length);
+  }
+  if (iotjs_jval_is_number(&jinter_byte_timeout)) {
+    _this->inter_byte_timeout =
+        (uint32_t)iotjs_jval_as_number(&jinter_byte_timeout);
+  }
+
+  iotjs_jval_destroy(&jdelimiter);
+  iotjs_jval_destroy(&jframe_length);
+  iotjs_jval_destroy(&jinter_byte_timeout);
+
+  if (_this->delimiter >= 0 || _this->frame_length > 0 ||
+      _this->inter_byte_timeout > 0) {
+    // Fixed length frames are read a whole number at a time.
+    _this->frame_cap = UART_FRAME_BUFFER_SIZE;
+    if (_this->frame_length >= UART_FRAME_BUFFER_SIZE) {
+      _this->frame_cap = _this->frame_length;
+    } else if (_this->frame_length > 0) {
+      _this->frame_cap -= UART_FRAME_BUFFER_SIZE % _this->frame_length;
+    }
+    _this->frame_buf = iotjs_buffer_allocate(_this->frame_cap);
+  }
+  if (_this->inter_byte_timeout > 0) {
+    uv_timer_init(iotjs_environment_loop(iotjs_environment_get()),
+                  &_this->frame_timer);
+    _this->frame_timer.data = uart;
+  }
+
   UART_ASYNC(open, uart, jcallback, kUartOpOpen);
 }
 
 
+// write(data[, callback])
+// `data` is a string or a Buffer. With a callback, the data is queued and
+// written whenever the device takes it, without blocking.
 JHANDLER_FUNCTION(Write) {
   JHANDLER_DECLARE_THIS_PTR(uart, uart);
-  DJHANDLER_CHECK_ARGS(1, string);
   DJHANDLER_CHECK_ARG_IF_EXIST(1, function);
 
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(1, function);
 
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
 
-  _this->buf_data = JHANDLER_GET_ARG(0, string);
-  _this->buf_len = iotjs_string_size(&_this->buf_data);
+  if (iotjs_jhandler_get_arg_length(jhandler) < 1) {
+    JHANDLER_THROW(TYPE, "Bad arguments - data required");
+    return;
+  }
+  const iotjs_jval_t* jdata = iotjs_jhandler_get_arg(jhandler, 0);
+  if (!iotjs_jval_is_string(jdata) && !iotjs_jval_is_object(jdata)) {
+    JHANDLER_THROW(TYPE, "Bad arguments - data should be String or Buffer");
+    return;
+  }
 
   if (jcallback) {
-    UART_ASYNC(write, uart, jcallback, kUartOpWrite);
+    if (_this->closing) {
+      JHANDLER_THROW(COMMON, "UART port is not opened");
+      return;
+    }
+
+    iotjs_uart_write_t* req = IOTJS_ALLOC(iotjs_uart_write_t);
+    if (iotjs_jval_is_string(jdata)) {
+      iotjs_string_t str = iotjs_jval_as_string(jdata);
+      req->length = iotjs_string_size(&str);
+      req->data = iotjs_buffer_allocate(req->length);
+      memcpy(req->data, iotjs_string_data(&str), req->length);
+      iotjs_string_destroy(&str);
+    } else {
+      iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jbuffer(jdata);
+      req->length = iotjs_bufferwrap_length(buffer);
+      req->data = iotjs_buffer_allocate(req->length);
+      memcpy(req->data, iotjs_bufferwrap_buffer(buffer), req->length);
+    }
+    req->jcallback = iotjs_jval_create_copied(jcallback);
+
+    if (_this->write_tail != NULL) {
+      _this->write_tail->next = req;
+    } else {
+      _this->write_head = req;
+    }
+    _this->write_tail = req;
+
+    if (req == _this->write_head) {
+      iotjs_uart_flush_writes(uart, true);
+    }
   } else {
+    if (iotjs_jval_is_string(jdata)) {
+      _this->buf_data = iotjs_jval_as_string(jdata);
+    } else {
+      iotjs_bufferwrap_t* buffer = iotjs_bufferwrap_from_jbuffer(jdata);
+      _this->buf_data =
+          iotjs_string_create_with_size(iotjs_bufferwrap_buffer(buffer),
+                                        iotjs_bufferwrap_length(buffer));
+    }
+    _this->buf_len = iotjs_string_size(&_this->buf_data);
+
     bool result = iotjs_uart_write(uart);
     iotjs_string_destroy(&_this->buf_data);
 
@@ -327,6 +894,18 @@ JHANDLER_FUNCTION(Close) {
   const iotjs_jval_t* jcallback = JHANDLER_GET_ARG_IF_EXIST(0, function);
 
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  // The queued writes are called back before the port closes.
+  iotjs_uart_bridge_stop(uart);
+  _this->closing = true;
+  while (_this->write_head != NULL) {
+    iotjs_uart_write_done(uart, "UART port is closed", true);
+  }
+  if (_this->inter_byte_timeout > 0 &&
+      !uv_is_closing((uv_handle_t*)&_this->frame_timer)) {
+    uv_close((uv_handle_t*)&_this->frame_timer, NULL);
+  }
+
   iotjs_jval_destroy(&_this->jemitter_this);
 
   if (jcallback) {
@@ -347,6 +926,10 @@ iotjs_jval_t InitUart() {
 
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_WRITE, Write);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_CLOSE, Close);
+#if ENABLE_MODULE_TCP
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_BRIDGE, Bridge);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_UNBRIDGE, Unbridge);
+#endif
 
   iotjs_jval_set_property_jval(&juart_constructor, IOTJS_MAGIC_STRING_PROTOTYPE,
                                &prototype);
@@ -18,20 +18,26 @@
 #define IOTJS_MODULE_UART_H
 
 #include "iotjs_def.h"
+#include "iotjs_busqueue.h"
 #include "iotjs_handlewrap.h"
 #include "iotjs_reqwrap.h"
 
 
 #define UART_WRITE_BUFFER_SIZE 512
+// Bytes read at a time when received data is framed.
+#define UART_FRAME_BUFFER_SIZE 4096
 
 
 typedef enum {
   kUartOpOpen,
   kUartOpClose,
-  kUartOpWrite,
 } UartOp;
 
 
+typedef struct iotjs_uart_write_s iotjs_uart_write_t;
+typedef struct iotjs_uart_bridge_s iotjs_uart_bridge_t;
+
+
 typedef struct {
   iotjs_handlewrap_t handlewrap;
   iotjs_jval_t jemitter_this;
@@ -42,6 +48,27 @@ typedef struct {
   iotjs_string_t buf_data;
   unsigned buf_len;
   uv_poll_t poll_handle;
+  int poll_events;
+  bool closing;
+
+  // Framing of received data: a frame ends with the `delimiter` byte, after
+  // `frame_length` bytes, or when no byte came for `inter_byte_timeout`
+  // milliseconds. Without framing, every read is emitted as it is.
+  int delimiter;
+  size_t frame_length;
+  uint32_t inter_byte_timeout;
+  char* frame_buf;
+  size_t frame_cap;
+  size_t frame_len;
+  uv_timer_t frame_timer;
+  size_t read_min;
+
+  // Asynchronous writes waiting for the device to take their data.
+  iotjs_uart_write_t* write_head;
+  iotjs_uart_write_t* write_tail;
+
+  // The socket the port is connected to natively, in both directions.
+  iotjs_uart_bridge_t* bridge;
 } IOTJS_VALIDATED_STRUCT(iotjs_uart_t);
 
 
@@ -53,7 +80,7 @@ typedef struct {
 
 typedef struct {
   iotjs_reqwrap_t reqwrap;
-  uv_work_t req;
+  iotjs_bus_work_t req;
   iotjs_uart_reqdata_t req_data;
   iotjs_uart_t* uart_instance;
 } IOTJS_VALIDATED_STRUCT(iotjs_uart_reqwrap_t);
@@ -74,9 +101,13 @@ iotjs_uart_t* iotjs_uart_instance_from_reqwrap(THIS);
   iotjs_uart_t* uart = iotjs_uart_instance_from_reqwrap(req_wrap);
 
 
-void iotjs_uart_read_cb(uv_poll_t* req, int status, int events);
+void iotjs_uart_poll_cb(uv_poll_t* req, int status, int events);
 
 void iotjs_uart_open_worker(uv_work_t* work_req);
 bool iotjs_uart_write(iotjs_uart_t* uart);
 
+// Asks the driver to report the device readable only once `min` bytes
+// arrived, where it can.
+void iotjs_uart_set_read_min(iotjs_uart_t* uart, size_t min);
+
 #endif /* IOTJS_MODULE_UART_H */
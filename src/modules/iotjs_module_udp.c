@@ -13,29 +13,56 @@
  * limitations under the License.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // sendmmsg()
+#endif
+
 #include "iotjs_def.h"
 
 #include "iotjs_module_udp.h"
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
 #include "iotjs_handlewrap.h"
 #include "iotjs_module_buffer.h"
 #include "iotjs_module_tcp.h"
+#include "iotjs_probes.h"
 #include "iotjs_reqwrap.h"
 
 
 IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(udpwrap);
 
 
-iotjs_udpwrap_t* iotjs_udpwrap_create(const iotjs_jval_t* judp) {
-  iotjs_udpwrap_t* udpwrap = IOTJS_ALLOC(iotjs_udpwrap_t);
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnMessage, IOTJS_UDP_ONMESSAGE)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnMessages, IOTJS_UDP_ONMESSAGES)
+
+
+IOTJS_DEFINE_POOL(udpwrap_pool, iotjs_udpwrap_t, "udp",
+                  IOTJS_HANDLEWRAP_POOL_CAP);
+
+
+iotjs_udpwrap_t* iotjs_udpwrap_create(const iotjs_jval_t* judp,
+                                      size_t batch_size) {
+  iotjs_udpwrap_t* udpwrap = IOTJS_POOL_ALLOC(udpwrap_pool, iotjs_udpwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_udpwrap_t, udpwrap);
 
   iotjs_handlewrap_initialize(&_this->handlewrap, judp,
                               (uv_handle_t*)(&_this->handle),
                               &this_module_native_info);
+  iotjs_handlewrap_initialize_callbacks(&_this->handlewrap, _this->jcallbacks,
+                                        IOTJS_UDP_CALLBACK_COUNT);
 
   const iotjs_environment_t* env = iotjs_environment_get();
-  uv_udp_init(iotjs_environment_loop(env), &_this->handle);
+  if (batch_size > 0) {
+    // Several datagrams are read with one recvmmsg() where there is one.
+    _this->batch_size = batch_size;
+    uv_udp_init_ex(iotjs_environment_loop(env), &_this->handle,
+                   AF_UNSPEC | UV_UDP_RECVMMSG);
+  } else {
+    uv_udp_init(iotjs_environment_loop(env), &_this->handle);
+  }
 
   return udpwrap;
 }
@@ -43,8 +70,14 @@ iotjs_udpwrap_t* iotjs_udpwrap_create(const iotjs_jval_t* judp) {
 
 static void iotjs_udpwrap_destroy(iotjs_udpwrap_t* udpwrap) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_udpwrap_t, udpwrap);
+  if (_this->batch_count > 0) {
+    iotjs_jval_destroy(&_this->jbatch);
+  }
+  if (_this->batch_buffer != NULL) {
+    iotjs_buffer_release(_this->batch_buffer);
+  }
   iotjs_handlewrap_destroy(&_this->handlewrap);
-  IOTJS_RELEASE(udpwrap);
+  IOTJS_POOL_RELEASE(udpwrap_pool, udpwrap);
 }
 
 
@@ -76,11 +109,23 @@ iotjs_jval_t* iotjs_udpwrap_jobject(iotjs_udpwrap_t* udpwrap) {
 }
 
 
+const iotjs_jval_t* iotjs_udpwrap_jcallback(iotjs_udpwrap_t* udpwrap,
+                                            iotjs_udp_callback_t index) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_udpwrap_t, udpwrap);
+  return iotjs_handlewrap_jcallback(&_this->handlewrap, index);
+}
+
+
 #define THIS iotjs_send_reqwrap_t* send_reqwrap
 
+IOTJS_DEFINE_POOL(send_reqwrap_pool, iotjs_send_reqwrap_t, "udp.send",
+                  IOTJS_REQWRAP_POOL_CAP);
+
+
 iotjs_send_reqwrap_t* iotjs_send_reqwrap_create(const iotjs_jval_t* jcallback,
                                                 const size_t msg_size) {
-  iotjs_send_reqwrap_t* send_reqwrap = IOTJS_ALLOC(iotjs_send_reqwrap_t);
+  iotjs_send_reqwrap_t* send_reqwrap =
+      IOTJS_POOL_ALLOC(send_reqwrap_pool, iotjs_send_reqwrap_t);
   IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_send_reqwrap_t, send_reqwrap);
 
   iotjs_reqwrap_initialize(&_this->reqwrap, jcallback, (uv_req_t*)&_this->req);
@@ -93,7 +138,7 @@ iotjs_send_reqwrap_t* iotjs_send_reqwrap_create(const iotjs_jval_t* jcallback,
 static void iotjs_send_reqwrap_destroy(THIS) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_send_reqwrap_t, send_reqwrap);
   iotjs_reqwrap_destroy(&_this->reqwrap);
-  IOTJS_RELEASE(send_reqwrap);
+  IOTJS_POOL_RELEASE(send_reqwrap_pool, send_reqwrap);
 }
 
 
@@ -123,12 +168,20 @@ size_t iotjs_send_reqwrap_msg_size(THIS) {
 #undef THIS
 
 
+// UDP([batchSize])
 JHANDLER_FUNCTION(UDP) {
   DJHANDLER_CHECK_THIS(object);
   DJHANDLER_CHECK_ARGS(0);
+  DJHANDLER_CHECK_ARG_IF_EXIST(0, number);
+
+  const iotjs_jval_t* jbatch = JHANDLER_GET_ARG_IF_EXIST(0, number);
+  size_t batch_size = jbatch ? (size_t)iotjs_jval_as_number(jbatch) : 0;
+  if (batch_size > IOTJS_UDP_BATCH_MAX) {
+    batch_size = IOTJS_UDP_BATCH_MAX;
+  }
 
   const iotjs_jval_t* judp = JHANDLER_GET_THIS(object);
-  iotjs_udpwrap_t* udp_wrap = iotjs_udpwrap_create(judp);
+  iotjs_udpwrap_t* udp_wrap = iotjs_udpwrap_create(judp, batch_size);
   IOTJS_UNUSED(udp_wrap);
 }
 
@@ -167,32 +220,155 @@ JHANDLER_FUNCTION(Bind) {
 
 
 static void OnAlloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
+  iotjs_udpwrap_t* udp_wrap = iotjs_udpwrap_from_handle((uv_udp_t*)handle);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_udpwrap_t, udp_wrap);
+
+  if (_this->batch_size > 0) {
+    // One buffer is kept for the socket. Its pages are only touched as far
+    // as the datagrams fill the chunks.
+    size_t size = _this->batch_size * IOTJS_UDP_BATCH_CHUNK;
+    if (_this->batch_buffer == NULL) {
+      _this->batch_buffer = iotjs_buffer_allocate(size);
+    }
+    buf->base = _this->batch_buffer;
+    buf->len = size;
+    return;
+  }
+
   if (suggested_size > IOTJS_MAX_READ_BUFFER_SIZE) {
     suggested_size = IOTJS_MAX_READ_BUFFER_SIZE;
   }
 
-  buf->base = iotjs_buffer_allocate(suggested_size);
+  buf->base = iotjs_read_buffer_allocate(&suggested_size);
   buf->len = suggested_size;
 }
 
 
+// Passes the datagrams gathered in batch mode to `onmessages`.
+static void iotjs_udpwrap_flush_batch(iotjs_udpwrap_t* udp_wrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_udpwrap_t, udp_wrap);
+
+  if (_this->batch_count == 0) {
+    return;
+  }
+
+  iotjs_jval_t jbatch = _this->jbatch;
+  _this->batch_count = 0;
+
+  const iotjs_jval_t* jonmessages =
+      iotjs_udpwrap_jcallback(udp_wrap, IOTJS_UDP_ONMESSAGES);
+  if (iotjs_jval_is_function(jonmessages)) {
+    iotjs_jval_t jcallback = iotjs_jval_create_copied(jonmessages);
+    iotjs_jargs_t jargs = iotjs_jargs_create(2);
+    iotjs_jargs_append_jval(&jargs, iotjs_udpwrap_jobject(udp_wrap));
+    iotjs_jargs_append_jval(&jargs, &jbatch);
+
+    iotjs_make_callback(&jcallback, iotjs_jval_get_undefined(), &jargs);
+
+    iotjs_jargs_destroy(&jargs);
+    iotjs_jval_destroy(&jcallback);
+  }
+
+  iotjs_jval_destroy(&jbatch);
+}
+
+
+static void iotjs_udpwrap_batch_push(iotjs_udpwrap_t* udp_wrap,
+                                     const iotjs_jval_t* jvalue) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_udpwrap_t, udp_wrap);
+  iotjs_jval_set_property_by_index(&_this->jbatch, _this->batch_count++,
+                                   jvalue);
+}
+
+
+// Adds a copy of a datagram and its sender to the batch.
+static void iotjs_udpwrap_batch_add(iotjs_udpwrap_t* udp_wrap,
+                                    const uv_buf_t* buf, size_t nread,
+                                    const struct sockaddr* addr) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_udpwrap_t, udp_wrap);
+
+  if (_this->batch_count == 0) {
+    _this->jbatch = iotjs_jval_create_array(0);
+  }
+
+  int port = 0;
+  if (addr != NULL && addr->sa_family == AF_INET) {
+    port = ntohs(((const sockaddr_in*)addr)->sin_port);
+  } else if (addr != NULL && addr->sa_family == AF_INET6) {
+    port = ntohs(((const sockaddr_in6*)addr)->sin6_port);
+  }
+
+  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer(nread);
+  iotjs_bufferwrap_copy(iotjs_bufferwrap_from_jbuffer(&jbuffer), buf->base,
+                        nread);
+  iotjs_jval_t jaddress = iotjs_peer_address(addr);
+  iotjs_jval_t jport = iotjs_jval_create_number(port);
+
+  iotjs_udpwrap_batch_push(udp_wrap, &jbuffer);
+  iotjs_udpwrap_batch_push(udp_wrap, &jaddress);
+  iotjs_udpwrap_batch_push(udp_wrap, &jport);
+
+  iotjs_jval_destroy(&jport);
+  iotjs_jval_destroy(&jaddress);
+  iotjs_jval_destroy(&jbuffer);
+}
+
+
+// Receives in batch mode. recvmmsg() hands out each datagram as a chunk of
+// the batch buffer and ends with UV_UDP_MMSG_FREE, which flushes the batch.
+// Without it every datagram is passed on by itself.
+static void OnRecvBatch(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
+                        const struct sockaddr* addr, unsigned int flags) {
+  iotjs_udpwrap_t* udp_wrap = iotjs_udpwrap_from_handle(handle);
+
+  if (nread > 0 || (nread == 0 && addr != NULL)) {
+    iotjs_udpwrap_batch_add(udp_wrap, buf, (size_t)nread, addr);
+    if (!(flags & UV_UDP_MMSG_CHUNK)) {
+      iotjs_udpwrap_flush_batch(udp_wrap);
+    }
+    return;
+  }
+
+  iotjs_udpwrap_flush_batch(udp_wrap);
+
+  if (nread < 0) {
+    const iotjs_jval_t* jonmessage =
+        iotjs_udpwrap_jcallback(udp_wrap, IOTJS_UDP_ONMESSAGE);
+    if (!iotjs_jval_is_function(jonmessage)) {
+      return;
+    }
+
+    iotjs_jval_t jcallback = iotjs_jval_create_copied(jonmessage);
+    iotjs_jargs_t jargs = iotjs_jargs_create(2);
+    iotjs_jargs_append_number(&jargs, nread);
+    iotjs_jargs_append_jval(&jargs, iotjs_udpwrap_jobject(udp_wrap));
+
+    iotjs_make_callback(&jcallback, iotjs_jval_get_undefined(), &jargs);
+
+    iotjs_jargs_destroy(&jargs);
+    iotjs_jval_destroy(&jcallback);
+  }
+}
+
+
 static void OnRecv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
                    const struct sockaddr* addr, unsigned int flags) {
   if (nread == 0 && addr == NULL) {
     if (buf->base != NULL)
-      iotjs_buffer_release(buf->base);
+      iotjs_read_buffer_release(buf->base);
     return;
   }
 
   iotjs_udpwrap_t* udp_wrap = iotjs_udpwrap_from_handle(handle);
+  IOTJS_PROBE2(udp__recv, handle->io_watcher.fd, nread);
 
   // udp handle
   const iotjs_jval_t* judp = iotjs_udpwrap_jobject(udp_wrap);
   IOTJS_ASSERT(iotjs_jval_is_object(judp));
 
   // onmessage callback
-  iotjs_jval_t jonmessage =
-      iotjs_jval_get_property(judp, IOTJS_MAGIC_STRING_ONMESSAGE);
+  iotjs_jval_t jonmessage = iotjs_jval_create_copied(
+      iotjs_udpwrap_jcallback(udp_wrap, IOTJS_UDP_ONMESSAGE));
   IOTJS_ASSERT(iotjs_jval_is_function(&jonmessage));
 
   iotjs_jargs_t jargs = iotjs_jargs_create(4);
@@ -201,22 +377,20 @@ static void OnRecv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
 
   if (nread < 0) {
     if (buf->base != NULL)
-      iotjs_buffer_release(buf->base);
+      iotjs_read_buffer_release(buf->base);
     iotjs_make_callback(&jonmessage, iotjs_jval_get_undefined(), &jargs);
     iotjs_jval_destroy(&jonmessage);
     iotjs_jargs_destroy(&jargs);
     return;
   }
 
-  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer((size_t)nread);
-  iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
-
-  iotjs_bufferwrap_copy(buffer_wrap, buf->base, (size_t)nread);
+  // The receive buffer becomes the memory of the Buffer object.
+  iotjs_jval_t jbuffer =
+      iotjs_bufferwrap_adopt_buffer(buf->base, buf->len, (size_t)nread);
 
   iotjs_jargs_append_jval(&jargs, &jbuffer);
 
-  iotjs_jval_t rinfo = iotjs_jval_create_object();
-  AddressToJS(&rinfo, addr);
+  iotjs_jval_t rinfo = iotjs_peer_rinfo(addr, (size_t)nread);
   iotjs_jargs_append_jval(&jargs, &rinfo);
 
   iotjs_make_callback(&jonmessage, iotjs_jval_get_undefined(), &jargs);
@@ -224,7 +398,6 @@ static void OnRecv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
   iotjs_jval_destroy(&rinfo);
   iotjs_jval_destroy(&jbuffer);
   iotjs_jval_destroy(&jonmessage);
-  iotjs_buffer_release(buf->base);
   iotjs_jargs_destroy(&jargs);
 }
 
@@ -233,8 +406,9 @@ JHANDLER_FUNCTION(RecvStart) {
   JHANDLER_DECLARE_THIS_PTR(udpwrap, udp_wrap);
   DJHANDLER_CHECK_ARGS(0);
 
-  int err =
-      uv_udp_recv_start(iotjs_udpwrap_udp_handle(udp_wrap), OnAlloc, OnRecv);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_udpwrap_t, udp_wrap);
+  int err = uv_udp_recv_start(iotjs_udpwrap_udp_handle(udp_wrap), OnAlloc,
+                              _this->batch_size > 0 ? OnRecvBatch : OnRecv);
 
   // UV_EALREADY means that the socket is already bound but that's okay
   if (err == UV_EALREADY)
@@ -322,6 +496,159 @@ JHANDLER_FUNCTION(Send) {
 }
 
 
+static void iotjs_udpwrap_send_batch_done(const iotjs_jval_t* jcallback,
+                                          int status, size_t bytes) {
+  if (!iotjs_jval_is_function(jcallback)) {
+    return;
+  }
+
+  iotjs_jval_t jargs = iotjs_jval_create_array(2);
+  iotjs_jval_t jstatus = iotjs_jval_create_number(status);
+  iotjs_jval_t jbytes = iotjs_jval_create_number(bytes);
+  iotjs_jval_set_property_by_index(&jargs, 0, &jstatus);
+  iotjs_jval_set_property_by_index(&jargs, 1, &jbytes);
+  iotjs_process_queue_next_tick(jcallback, &jargs);
+  iotjs_jval_destroy(&jbytes);
+  iotjs_jval_destroy(&jstatus);
+  iotjs_jval_destroy(&jargs);
+}
+
+
+// Sends several messages at once, with sendmmsg() where there is one.
+// [0] [buffer, port, ip, ...]
+// [1] callback function, called with the status and the bytes sent
+// The messages the socket cannot take right away are queued as usual, and
+// the callback then comes with the last of them.
+JHANDLER_FUNCTION(SendBatch) {
+  JHANDLER_DECLARE_THIS_PTR(udpwrap, udp_wrap);
+  DJHANDLER_CHECK_ARGS(1, array);
+
+  const iotjs_jval_t* jlist = JHANDLER_GET_ARG(0, array);
+  const iotjs_jval_t* jcallback = iotjs_jhandler_get_arg(jhandler, 1);
+  uv_udp_t* handle = iotjs_udpwrap_udp_handle(udp_wrap);
+
+  iotjs_jval_t jlength =
+      iotjs_jval_get_property(jlist, IOTJS_MAGIC_STRING_LENGTH);
+  uint32_t count = (uint32_t)iotjs_jval_as_number(&jlength) / 3;
+  iotjs_jval_destroy(&jlength);
+
+  uv_buf_t* bufs = NULL;
+  sockaddr_in* addrs = NULL;
+  size_t bytes = 0;
+  int err = 0;
+
+  if (count > 0) {
+    bufs = (uv_buf_t*)iotjs_buffer_allocate(count * sizeof(uv_buf_t));
+    addrs = (sockaddr_in*)iotjs_buffer_allocate(count * sizeof(sockaddr_in));
+  }
+
+  for (uint32_t i = 0; i < count && err == 0; i++) {
+    iotjs_jval_t jbuffer = iotjs_jval_get_property_by_index(jlist, i * 3);
+    iotjs_jval_t jport = iotjs_jval_get_property_by_index(jlist, i * 3 + 1);
+    iotjs_jval_t jip = iotjs_jval_get_property_by_index(jlist, i * 3 + 2);
+
+    if (!iotjs_jval_is_object(&jbuffer) || !iotjs_jval_is_number(&jport) ||
+        !iotjs_jval_is_string(&jip)) {
+      err = UV_EINVAL;
+    } else {
+      iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
+      bufs[i].base = iotjs_bufferwrap_buffer(buffer_wrap);
+      bufs[i].len = iotjs_bufferwrap_length(buffer_wrap);
+
+      iotjs_string_t ip = iotjs_jval_as_string(&jip);
+      err = uv_ip4_addr(iotjs_string_data(&ip),
+                        (int)iotjs_jval_as_number(&jport), &addrs[i]);
+      iotjs_string_destroy(&ip);
+    }
+
+    iotjs_jval_destroy(&jip);
+    iotjs_jval_destroy(&jport);
+    iotjs_jval_destroy(&jbuffer);
+  }
+
+  uint32_t sent = 0;
+
+#if defined(__linux__)
+  // The socket is written directly only when nothing is queued before.
+  uv_os_fd_t fd = -1;
+  if (err == 0 && handle->send_queue_count == 0 &&
+      uv_fileno((const uv_handle_t*)handle, &fd) == 0) {
+    struct mmsghdr msgs[IOTJS_UDP_BATCH_MAX];
+    struct iovec iov[IOTJS_UDP_BATCH_MAX];
+
+    while (sent < count) {
+      uint32_t width = count - sent;
+      if (width > IOTJS_UDP_BATCH_MAX) {
+        width = IOTJS_UDP_BATCH_MAX;
+      }
+
+      memset(msgs, 0, sizeof(msgs[0]) * width);
+      for (uint32_t k = 0; k < width; k++) {
+        iov[k].iov_base = bufs[sent + k].base;
+        iov[k].iov_len = bufs[sent + k].len;
+        msgs[k].msg_hdr.msg_iov = &iov[k];
+        msgs[k].msg_hdr.msg_iovlen = 1;
+        msgs[k].msg_hdr.msg_name = &addrs[sent + k];
+        msgs[k].msg_hdr.msg_namelen = sizeof(addrs[0]);
+      }
+
+      int n;
+      do {
+        n = sendmmsg(fd, msgs, width, 0);
+      } while (n == -1 && errno == EINTR);
+
+      if (n < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOSYS) {
+          err = -errno;
+        }
+        break;
+      }
+
+      for (uint32_t k = 0; k < (uint32_t)n; k++) {
+        bytes += bufs[sent + k].len;
+      }
+      sent += (uint32_t)n;
+    }
+  }
+#endif
+
+  // The rest is queued, with the callback on the last message.
+  bool queued = false;
+  if (err == 0 && sent < count) {
+    size_t total = bytes;
+    for (uint32_t i = sent; i < count; i++) {
+      total += bufs[i].len;
+    }
+
+    for (uint32_t i = sent; i < count && err == 0; i++) {
+      bool last = i == count - 1;
+      iotjs_send_reqwrap_t* req_wrap = iotjs_send_reqwrap_create(
+          last ? jcallback : iotjs_jval_get_undefined(), total);
+
+      err = uv_udp_send(iotjs_send_reqwrap_req(req_wrap), handle, &bufs[i], 1,
+                        (const sockaddr*)&addrs[i], OnSend);
+      if (err) {
+        iotjs_send_reqwrap_dispatched(req_wrap);
+      } else {
+        bytes += bufs[i].len;
+        queued = last;
+      }
+    }
+  }
+
+  if (!queued) {
+    iotjs_udpwrap_send_batch_done(jcallback, err, bytes);
+  }
+
+  if (bufs != NULL) {
+    iotjs_buffer_release((char*)bufs);
+    iotjs_buffer_release((char*)addrs);
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
 // Close socket
 JHANDLER_FUNCTION(Close) {
   JHANDLER_DECLARE_THIS_PTR(handlewrap, wrap);
@@ -461,10 +788,16 @@ iotjs_jval_t InitUdp() {
   iotjs_jval_t prototype = iotjs_jval_create_object();
   iotjs_jval_set_property_jval(&udp, IOTJS_MAGIC_STRING_PROTOTYPE, &prototype);
 
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONMESSAGE,
+                          GetOnMessage, SetOnMessage);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONMESSAGES,
+                          GetOnMessages, SetOnMessages);
+
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_BIND, Bind);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_RECVSTART, RecvStart);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_RECVSTOP, RecvStop);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SEND, Send);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SENDBATCH, SendBatch);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_CLOSE, Close);
   iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_GETSOCKNAME,
                         GetSockeName);
@@ -23,19 +23,43 @@
 #include "iotjs_reqwrap.h"
 
 
+// Callback slots of the udp object.
+typedef enum {
+  IOTJS_UDP_ONMESSAGE,
+  IOTJS_UDP_ONMESSAGES,
+  IOTJS_UDP_CALLBACK_COUNT,
+} iotjs_udp_callback_t;
+
+
+// Most datagrams received at once in batch mode, each read into a chunk of
+// 64 KiB of the batch buffer.
+#define IOTJS_UDP_BATCH_MAX 20
+#define IOTJS_UDP_BATCH_CHUNK (64 * 1024)
+
+
 typedef struct {
   iotjs_handlewrap_t handlewrap;
   uv_udp_t handle;
+  iotjs_jval_t jcallbacks[IOTJS_UDP_CALLBACK_COUNT];
+  // Batch mode: the datagrams of a wake up are passed to `onmessages` at
+  // once, as `[buffer, address, port, ...]` in `jbatch`.
+  size_t batch_size;
+  char* batch_buffer;
+  iotjs_jval_t jbatch;
+  uint32_t batch_count;
 } IOTJS_VALIDATED_STRUCT(iotjs_udpwrap_t);
 
 
-iotjs_udpwrap_t* iotjs_udpwrap_create(const iotjs_jval_t* judp);
+iotjs_udpwrap_t* iotjs_udpwrap_create(const iotjs_jval_t* judp,
+                                      size_t batch_size);
 
 iotjs_udpwrap_t* iotjs_udpwrap_from_handle(uv_udp_t* handle);
 iotjs_udpwrap_t* iotjs_udpwrap_from_jobject(const iotjs_jval_t* judp);
 
 uv_udp_t* iotjs_udpwrap_udp_handle(iotjs_udpwrap_t* udpwrap);
 iotjs_jval_t* iotjs_udpwrap_jobject(iotjs_udpwrap_t* udpwrap);
+const iotjs_jval_t* iotjs_udpwrap_jcallback(iotjs_udpwrap_t* udpwrap,
+                                            iotjs_udp_callback_t index);
 
 
 typedef struct {
@@ -0,0 +1,970 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "iotjs_def.h"
+#include "iotjs_module_buffer.h"
+#include "iotjs_module_tcp.h"
+#include "iotjs_objectwrap.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+// The payloads are masked 16 bytes at a time when the compiler targets SSE2
+// or NEON, and 8 bytes at a time otherwise.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define IOTJS_WEBSOCKET_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define IOTJS_WEBSOCKET_NEON 1
+#endif
+
+
+// The WebSocket object frames the messages of a connection of RFC 6455. The
+// data read by a plain socket goes to a sink of its tcp object (see
+// iotjs_tcp_splice_to_sink) instead of JavaScript, and the frames are parsed
+// and unmasked in place, in the Buffer the read buffer becomes. A frame that
+// came in one read is passed to onframe as a view of that Buffer; only the
+// frames split across reads and the fragments of a message are copied, into
+// the Buffer of the frame or of the message. A frame written goes to the
+// socket with its header in the write request, and the payload of a server
+// is written from its Buffer as it is. The data of an encrypted socket is fed
+// from JavaScript, which writes the frames encoded into Buffers.
+
+
+#define IOTJS_WEBSOCKET_MAX_HEADER 14
+#define IOTJS_WEBSOCKET_MAX_CONTROL 125
+
+#define IOTJS_WEBSOCKET_CONTINUATION 0x0
+#define IOTJS_WEBSOCKET_BINARY 0x2
+#define IOTJS_WEBSOCKET_CLOSE 0x8
+#define IOTJS_WEBSOCKET_PONG 0xa
+
+// The status codes a failed connection is closed with.
+#define IOTJS_WEBSOCKET_PROTOCOL_ERROR 1002
+#define IOTJS_WEBSOCKET_TOO_BIG 1009
+
+// The largest payload of a message received, unless set by setMaxPayload.
+#define IOTJS_WEBSOCKET_MAX_PAYLOAD (1024 * 1024)
+
+#define SHA1_BLOCK_SIZE 64
+#define SHA1_DIGEST_SIZE 20
+
+
+// Callback slots of the websocket object.
+typedef enum {
+  IOTJS_WEBSOCKET_OWNER,
+  IOTJS_WEBSOCKET_ONFRAME,
+  IOTJS_WEBSOCKET_CALLBACK_COUNT,
+} iotjs_websocket_callback_t;
+
+
+typedef struct {
+  iotjs_jobjectwrap_t jobjectwrap;
+  iotjs_jval_t jcallbacks[IOTJS_WEBSOCKET_CALLBACK_COUNT];
+
+  // The tcp object the frames are read from and written to, or NULL when
+  // JavaScript feeds and writes them.
+  iotjs_tcpwrap_t* tcp_wrap;
+  // Hands the data read by the socket to the wrap.
+  iotjs_tcp_splice_t* splice;
+  // A client masks the frames it sends, and a server the frames it gets.
+  bool is_client;
+  size_t max_payload;
+
+  // The header of the frame being received, until all of it is there.
+  uint8_t header[IOTJS_WEBSOCKET_MAX_HEADER];
+  size_t header_length;
+
+  // The frame of which the payload is being received.
+  bool in_payload;
+  bool is_fragment;
+  bool fin;
+  bool masked;
+  uint8_t opcode;
+  uint8_t mask[4];
+  size_t payload_length;
+  size_t payload_received;
+  // Where a payload split across reads is collected: the memory of the
+  // Buffer of the frame, or the message the fragment is a part of.
+  iotjs_jval_t jpayload;
+  char* payload;
+
+  // The fragments of the message being received, which has this opcode, or
+  // 0 if there is none.
+  uint8_t message_opcode;
+  char* message;
+  size_t message_length;
+  size_t message_size;
+
+  bool started;
+  bool failed;
+  bool busy;
+  bool destroyed;
+  bool released;
+} IOTJS_VALIDATED_STRUCT(iotjs_websocketwrap_t);
+
+
+IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE_DETACH(websocketwrap);
+
+
+IOTJS_DEFINE_CALLBACK_ACCESSORS(Owner, IOTJS_WEBSOCKET_OWNER)
+IOTJS_DEFINE_CALLBACK_ACCESSORS(OnFrame, IOTJS_WEBSOCKET_ONFRAME)
+
+
+static iotjs_websocketwrap_t* iotjs_websocketwrap_create(
+    const iotjs_jval_t* jws, iotjs_tcpwrap_t* tcp_wrap, bool is_client) {
+  iotjs_websocketwrap_t* wswrap = IOTJS_ALLOC(iotjs_websocketwrap_t);
+  IOTJS_VALIDATED_STRUCT_CONSTRUCTOR(iotjs_websocketwrap_t, wswrap);
+
+  iotjs_jobjectwrap_initialize(&_this->jobjectwrap, jws,
+                               &this_module_native_info);
+  iotjs_jobjectwrap_initialize_callbacks(&_this->jobjectwrap, _this->jcallbacks,
+                                         IOTJS_WEBSOCKET_CALLBACK_COUNT);
+
+  _this->tcp_wrap = tcp_wrap;
+  _this->is_client = is_client;
+  _this->max_payload = IOTJS_WEBSOCKET_MAX_PAYLOAD;
+  _this->jpayload = iotjs_jval_create_copied(iotjs_jval_get_undefined());
+
+  return wswrap;
+}
+
+
+static void iotjs_websocketwrap_release(iotjs_websocketwrap_t* wswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+  if (_this->released) {
+    return;
+  }
+  _this->released = true;
+
+  if (_this->message != NULL) {
+    iotjs_buffer_release(_this->message);
+    _this->message = NULL;
+  }
+  iotjs_jval_destroy(&_this->jpayload);
+  _this->jpayload = iotjs_jval_create_copied(iotjs_jval_get_undefined());
+  _this->payload = NULL;
+}
+
+
+// Frames the tcp object still reads once this object is gone are dropped.
+static void iotjs_websocketwrap_detach(iotjs_websocketwrap_t* wswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+  _this->destroyed = true;
+  _this->tcp_wrap = NULL;
+  if (_this->splice != NULL) {
+    iotjs_tcp_splice_detach(_this->splice);
+    _this->splice = NULL;
+  }
+}
+
+
+static void iotjs_websocketwrap_destroy(iotjs_websocketwrap_t* wswrap) {
+  // Released while the struct is still valid, if Destroy has not done it.
+  iotjs_websocketwrap_release(wswrap);
+
+  IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_websocketwrap_t, wswrap);
+  iotjs_jval_destroy(&_this->jpayload);
+  iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
+  IOTJS_RELEASE(wswrap);
+}
+
+
+static iotjs_jval_t* iotjs_websocketwrap_jobject(
+    iotjs_websocketwrap_t* wswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+  return iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
+}
+
+
+// XORs `length` bytes of `data` with the masking key, of which the byte
+// `phase` applies to the first one.
+static void iotjs_websocket_mask(uint8_t* data, size_t length,
+                                 const uint8_t* key, size_t phase) {
+  uint8_t rotated[16];
+  for (size_t i = 0; i < sizeof(rotated); i++) {
+    rotated[i] = key[(phase + i) & 3];
+  }
+
+  size_t i = 0;
+#if defined(IOTJS_WEBSOCKET_SSE2)
+  if (length >= 16) {
+    __m128i vkey = _mm_loadu_si128((const __m128i*)rotated);
+    for (; i + 16 <= length; i += 16) {
+      __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+      _mm_storeu_si128((__m128i*)(data + i), _mm_xor_si128(v, vkey));
+    }
+  }
+#elif defined(IOTJS_WEBSOCKET_NEON)
+  if (length >= 16) {
+    uint8x16_t vkey = vld1q_u8(rotated);
+    for (; i + 16 <= length; i += 16) {
+      vst1q_u8(data + i, veorq_u8(vld1q_u8(data + i), vkey));
+    }
+  }
+#endif
+
+  // The offsets stay multiples of 4, and the key is not rotated further.
+  uint64_t word;
+  memcpy(&word, rotated, sizeof(word));
+  for (; i + 8 <= length; i += 8) {
+    uint64_t v;
+    memcpy(&v, data + i, sizeof(v));
+    v ^= word;
+    memcpy(data + i, &v, sizeof(v));
+  }
+  for (; i < length; i++) {
+    data[i] ^= rotated[i & 3];
+  }
+}
+
+
+static uint32_t websocket_random_state = 0;
+
+
+// The masking keys of a client, which need not be secret, only unpredictable
+// to the scripts of the peer.
+static uint32_t iotjs_websocket_random() {
+  uint32_t x = websocket_random_state;
+  if (x == 0) {
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0 || read(fd, &x, sizeof(x)) != sizeof(x)) {
+      x = (uint32_t)uv_hrtime();
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+    x |= 1;
+  }
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  websocket_random_state = x;
+  return x;
+}
+
+
+// Writes the header of a frame of `length` bytes, masked with `mask` if it
+// is not NULL, and returns its size.
+static size_t iotjs_websocket_build_header(uint8_t* header, int opcode,
+                                           bool fin, size_t length,
+                                           const uint8_t* mask) {
+  uint8_t mask_bit = mask != NULL ? 0x80 : 0;
+  size_t size = 2;
+
+  header[0] = (uint8_t)((fin ? 0x80 : 0) | (opcode & 0x0f));
+  if (length <= IOTJS_WEBSOCKET_MAX_CONTROL) {
+    header[1] = (uint8_t)(mask_bit | length);
+  } else if (length <= 0xffff) {
+    header[1] = mask_bit | 126;
+    header[2] = (uint8_t)(length >> 8);
+    header[3] = (uint8_t)length;
+    size = 4;
+  } else {
+    header[1] = mask_bit | 127;
+    for (size_t i = 0; i < 8; i++) {
+      header[2 + i] = (uint8_t)((uint64_t)length >> (56 - i * 8));
+    }
+    size = 10;
+  }
+
+  if (mask != NULL) {
+    memcpy(header + size, mask, 4);
+    size += 4;
+  }
+  return size;
+}
+
+
+// The size of a header, of which the first two bytes are there.
+static size_t iotjs_websocket_header_size(const uint8_t* header) {
+  size_t size = (header[1] & 0x80) ? 6 : 2;
+  uint8_t length = header[1] & 0x7f;
+  if (length == 126) {
+    size += 2;
+  } else if (length == 127) {
+    size += 8;
+  }
+  return size;
+}
+
+
+// function onframe(owner, opcode, payload), or onframe(owner, -status) when
+// the connection fails with a status code.
+static void iotjs_websocket_emit(iotjs_websocketwrap_t* wswrap, int opcode,
+                                 const iotjs_jval_t* jpayload) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+
+  iotjs_jval_t jonframe = iotjs_jval_create_copied(
+      iotjs_jobjectwrap_jcallback(&_this->jobjectwrap,
+                                  IOTJS_WEBSOCKET_ONFRAME));
+  if (!iotjs_jval_is_function(&jonframe)) {
+    iotjs_jval_destroy(&jonframe);
+    return;
+  }
+
+  iotjs_jargs_t jargs = iotjs_jargs_create(3);
+  iotjs_jargs_append_jval(&jargs,
+                          iotjs_jobjectwrap_jcallback(&_this->jobjectwrap,
+                                                      IOTJS_WEBSOCKET_OWNER));
+  iotjs_jargs_append_number(&jargs, opcode);
+  if (jpayload != NULL) {
+    iotjs_jargs_append_jval(&jargs, jpayload);
+  }
+
+  iotjs_make_callback(&jonframe, iotjs_jval_get_undefined(), &jargs);
+
+  iotjs_jargs_destroy(&jargs);
+  iotjs_jval_destroy(&jonframe);
+}
+
+
+static void iotjs_websocket_fail(iotjs_websocketwrap_t* wswrap, int status) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+  _this->failed = true;
+  iotjs_websocket_emit(wswrap, -status, NULL);
+}
+
+
+static void iotjs_websocket_release_message(void* message) {
+  iotjs_buffer_release((char*)message);
+}
+
+
+// Takes the header received, and makes room for the payload of a fragment
+// in the message. Fails the connection on a frame out of the protocol.
+static bool iotjs_websocket_begin_frame(iotjs_websocketwrap_t* wswrap) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+  const uint8_t* header = _this->header;
+
+  uint8_t opcode = header[0] & 0x0f;
+  bool fin = (header[0] & 0x80) != 0;
+  bool masked = (header[1] & 0x80) != 0;
+  bool is_control = (opcode & 0x8) != 0;
+
+  uint64_t length = header[1] & 0x7f;
+  size_t offset = 2;
+  if (length == 126) {
+    length = ((uint64_t)header[2] << 8) | header[3];
+    offset = 4;
+  } else if (length == 127) {
+    length = 0;
+    for (size_t i = 0; i < 8; i++) {
+      length = (length << 8) | header[2 + i];
+    }
+    offset = 10;
+  }
+
+  // No extension is negotiated, so the reserved bits are clear.
+  if ((header[0] & 0x70) != 0 || masked == _this->is_client ||
+      (opcode > IOTJS_WEBSOCKET_BINARY && opcode < IOTJS_WEBSOCKET_CLOSE) ||
+      opcode > IOTJS_WEBSOCKET_PONG ||
+      (is_control && (!fin || length > IOTJS_WEBSOCKET_MAX_CONTROL)) ||
+      (!is_control && (opcode == IOTJS_WEBSOCKET_CONTINUATION) !=
+                          (_this->message_opcode != 0))) {
+    iotjs_websocket_fail(wswrap, IOTJS_WEBSOCKET_PROTOCOL_ERROR);
+    return false;
+  }
+
+  uint64_t total = length;
+  if (!is_control) {
+    total += _this->message_length;
+  }
+  if (total > _this->max_payload) {
+    iotjs_websocket_fail(wswrap, IOTJS_WEBSOCKET_TOO_BIG);
+    return false;
+  }
+
+  _this->opcode = opcode;
+  _this->fin = fin;
+  _this->masked = masked;
+  if (masked) {
+    memcpy(_this->mask, header + offset, 4);
+  }
+  _this->payload_length = (size_t)length;
+  _this->payload_received = 0;
+  _this->payload = NULL;
+  _this->header_length = 0;
+  _this->in_payload = true;
+
+  _this->is_fragment = !is_control &&
+                       (!fin || opcode == IOTJS_WEBSOCKET_CONTINUATION);
+  if (_this->is_fragment) {
+    if (opcode != IOTJS_WEBSOCKET_CONTINUATION) {
+      _this->message_opcode = opcode;
+    }
+    size_t needed = (size_t)total;
+    if (needed > _this->message_size) {
+      size_t size = _this->message_size > 0 ? _this->message_size * 2 : 1024;
+      while (size < needed) {
+        size *= 2;
+      }
+      if (size > _this->max_payload) {
+        size = needed;
+      }
+      _this->message = _this->message == NULL
+                           ? iotjs_buffer_allocate(size)
+                           : iotjs_buffer_reallocate(_this->message, size);
+      _this->message_size = size;
+    }
+    _this->payload = _this->message + _this->message_length;
+  }
+
+  return true;
+}
+
+
+// Passes the frame received on, or the message once its last fragment is
+// there.
+static void iotjs_websocket_end_frame(iotjs_websocketwrap_t* wswrap,
+                                      const iotjs_jval_t* jpayload) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+  _this->in_payload = false;
+  _this->payload = NULL;
+
+  if (!_this->is_fragment) {
+    iotjs_websocket_emit(wswrap, _this->opcode, jpayload);
+    return;
+  }
+
+  _this->message_length += _this->payload_length;
+  if (!_this->fin) {
+    return;
+  }
+
+  int opcode = _this->message_opcode;
+  iotjs_jval_t jmessage;
+  if (_this->message_length > 0) {
+    jmessage = iotjs_bufferwrap_create_buffer_external(
+        _this->message, _this->message_length,
+        iotjs_websocket_release_message);
+  } else {
+    if (_this->message != NULL) {
+      iotjs_buffer_release(_this->message);
+    }
+    jmessage = iotjs_bufferwrap_create_buffer(0);
+  }
+  _this->message_opcode = 0;
+  _this->message = NULL;
+  _this->message_length = 0;
+  _this->message_size = 0;
+
+  iotjs_websocket_emit(wswrap, opcode, &jmessage);
+  iotjs_jval_destroy(&jmessage);
+}
+
+
+// Parses the frames of the data of `chunk`, unmasking their payloads in
+// place.
+static void iotjs_websocket_parse(iotjs_websocketwrap_t* wswrap,
+                                  iotjs_bufferwrap_t* chunk) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+
+  char* base = iotjs_bufferwrap_buffer(chunk);
+  char* data = base;
+  size_t length = iotjs_bufferwrap_length(chunk);
+
+  while (!_this->failed && !_this->destroyed) {
+    if (!_this->in_payload) {
+      if (length == 0) {
+        break;
+      }
+
+      size_t size = _this->header_length < 2
+                        ? 2
+                        : iotjs_websocket_header_size(_this->header);
+      size_t n = size - _this->header_length;
+      if (n > length) {
+        n = length;
+      }
+      memcpy(_this->header + _this->header_length, data, n);
+      _this->header_length += n;
+      data += n;
+      length -= n;
+
+      if (_this->header_length < 2 ||
+          _this->header_length < iotjs_websocket_header_size(_this->header)) {
+        continue;
+      }
+      if (!iotjs_websocket_begin_frame(wswrap)) {
+        break;
+      }
+
+      if (!_this->is_fragment && _this->payload_length <= length) {
+        // The whole payload is in this chunk, and the frame is a view of it.
+        if (_this->masked) {
+          iotjs_websocket_mask((uint8_t*)data, _this->payload_length,
+                               _this->mask, 0);
+        }
+        iotjs_jval_t jview = iotjs_bufferwrap_create_view(
+            chunk, (size_t)(data - base), _this->payload_length);
+        data += _this->payload_length;
+        length -= _this->payload_length;
+        iotjs_websocket_end_frame(wswrap, &jview);
+        iotjs_jval_destroy(&jview);
+        continue;
+      }
+
+      if (!_this->is_fragment) {
+        iotjs_jval_destroy(&_this->jpayload);
+        _this->jpayload =
+            iotjs_bufferwrap_create_buffer(_this->payload_length);
+        _this->payload = iotjs_bufferwrap_buffer(
+            iotjs_bufferwrap_from_jbuffer(&_this->jpayload));
+      }
+    }
+
+    size_t n = _this->payload_length - _this->payload_received;
+    if (n > length) {
+      n = length;
+    }
+    if (n > 0) {
+      char* target = _this->payload + _this->payload_received;
+      memcpy(target, data, n);
+      if (_this->masked) {
+        iotjs_websocket_mask((uint8_t*)target, n, _this->mask,
+                             _this->payload_received);
+      }
+      _this->payload_received += n;
+      data += n;
+      length -= n;
+    }
+
+    if (_this->payload_received < _this->payload_length) {
+      break;
+    }
+
+    if (_this->is_fragment) {
+      iotjs_websocket_end_frame(wswrap, NULL);
+    } else {
+      iotjs_jval_t jpayload = _this->jpayload;
+      _this->jpayload = iotjs_jval_create_copied(iotjs_jval_get_undefined());
+      iotjs_websocket_end_frame(wswrap, &jpayload);
+      iotjs_jval_destroy(&jpayload);
+    }
+  }
+}
+
+
+static void iotjs_websocket_receive(iotjs_websocketwrap_t* wswrap,
+                                    iotjs_bufferwrap_t* chunk) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+  if (_this->busy || _this->destroyed || _this->failed) {
+    return;
+  }
+
+  // The callbacks may drop the last reference to the object.
+  iotjs_jval_t jws =
+      iotjs_jval_create_copied(iotjs_websocketwrap_jobject(wswrap));
+  _this->busy = true;
+
+  iotjs_websocket_parse(wswrap, chunk);
+
+  _this->busy = false;
+  if (_this->destroyed) {
+    iotjs_websocketwrap_release(wswrap);
+  }
+
+  iotjs_jval_destroy(&jws);
+}
+
+
+static int iotjs_websocket_sink_write(void* data, char* base, size_t length) {
+  iotjs_websocketwrap_t* wswrap = (iotjs_websocketwrap_t*)data;
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, wswrap);
+
+  if (_this->destroyed || _this->failed) {
+    iotjs_read_buffer_release(base);
+    return 0;
+  }
+
+  // The read buffers of the socket are of at most this size. The memory of
+  // a small read is copied and given back at once, as for onread.
+  size_t size = length > IOTJS_MAX_READ_BUFFER_SIZE
+                    ? length
+                    : IOTJS_MAX_READ_BUFFER_SIZE;
+  iotjs_jval_t jchunk = iotjs_bufferwrap_adopt_buffer(base, size, length);
+  iotjs_websocket_receive(wswrap, iotjs_bufferwrap_from_jbuffer(&jchunk));
+  iotjs_jval_destroy(&jchunk);
+  return 0;
+}
+
+
+// The frames are passed on as they are parsed, and nothing waits.
+static size_t iotjs_websocket_sink_queued(void* data) {
+  IOTJS_UNUSED(data);
+  return 0;
+}
+
+
+static const iotjs_tcp_sink_t iotjs_websocket_sink = {
+  iotjs_websocket_sink_write, iotjs_websocket_sink_queued,
+};
+
+
+// [0] whether this is the client side
+// [1] tcp object, or null for the data fed from JavaScript
+JHANDLER_FUNCTION(WebSocket) {
+  DJHANDLER_CHECK_THIS(object);
+  DJHANDLER_CHECK_ARGS(1, boolean);
+
+  const iotjs_jval_t* jws = JHANDLER_GET_THIS(object);
+  bool is_client = JHANDLER_GET_ARG(0, boolean);
+  const iotjs_jval_t* jtcp = JHANDLER_GET_ARG_IF_EXIST(1, object);
+  iotjs_tcpwrap_t* tcp_wrap =
+      jtcp != NULL ? iotjs_tcpwrap_from_jobject(jtcp) : NULL;
+
+  iotjs_websocketwrap_create(jws, tcp_wrap, is_client);
+}
+
+
+// Hands the data read by the tcp object to this object from now on.
+JHANDLER_FUNCTION(Start) {
+  JHANDLER_DECLARE_THIS_PTR(websocketwrap, ws_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, ws_wrap);
+
+  if (_this->tcp_wrap == NULL || _this->started || _this->destroyed) {
+    iotjs_jhandler_return_number(jhandler, UV__EINVAL);
+    return;
+  }
+
+  int err = iotjs_tcp_splice_to_sink(_this->tcp_wrap, &iotjs_websocket_sink,
+                                     ws_wrap, 0, &_this->splice);
+  if (err == 0) {
+    err = iotjs_tcp_read_start(_this->tcp_wrap);
+  }
+  _this->started = err == 0;
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Parses data received by JavaScript, which is unmasked in place.
+// [0] buffer
+JHANDLER_FUNCTION(Feed) {
+  JHANDLER_DECLARE_THIS_PTR(websocketwrap, ws_wrap);
+  DJHANDLER_CHECK_ARGS(1, object);
+
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(0, object));
+  iotjs_websocket_receive(ws_wrap, buffer_wrap);
+}
+
+
+typedef struct {
+  uv_write_t req;
+  uint8_t header[IOTJS_WEBSOCKET_MAX_HEADER];
+  // The masked copy of the payload of a client.
+  char* masked;
+  iotjs_jval_t jws;
+  iotjs_jval_t jbuffer;
+  iotjs_jval_t jcallback;
+} iotjs_websocket_write_t;
+
+
+static void iotjs_websocket_write_release(iotjs_websocket_write_t* write) {
+  if (write->masked != NULL) {
+    iotjs_buffer_release(write->masked);
+  }
+  iotjs_jval_destroy(&write->jcallback);
+  iotjs_jval_destroy(&write->jbuffer);
+  iotjs_jval_destroy(&write->jws);
+  IOTJS_RELEASE(write);
+}
+
+
+static void AfterWebSocketWrite(uv_write_t* req, int status) {
+  iotjs_websocket_write_t* write = (iotjs_websocket_write_t*)req;
+
+  if (iotjs_jval_is_function(&write->jcallback)) {
+    iotjs_jargs_t args = iotjs_jargs_create(1);
+    iotjs_jargs_append_number(&args, status);
+    iotjs_make_callback(&write->jcallback, iotjs_jval_get_undefined(), &args);
+    iotjs_jargs_destroy(&args);
+  }
+
+  iotjs_websocket_write_release(write);
+}
+
+
+// Writes a frame to the tcp object.
+// [0] opcode
+// [1] whether this is the last frame of the message
+// [2] payload buffer
+// [3] callback
+JHANDLER_FUNCTION(Send) {
+  JHANDLER_DECLARE_THIS_PTR(websocketwrap, ws_wrap);
+  DJHANDLER_CHECK_ARGS(4, number, boolean, object, function);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, ws_wrap);
+
+  if (_this->tcp_wrap == NULL || _this->destroyed) {
+    iotjs_jhandler_return_number(jhandler, UV__ENOTCONN);
+    return;
+  }
+
+  int opcode = (int)JHANDLER_GET_ARG(0, number);
+  bool fin = JHANDLER_GET_ARG(1, boolean);
+  const iotjs_jval_t* jbuffer = JHANDLER_GET_ARG(2, object);
+  iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(jbuffer);
+  char* payload = iotjs_bufferwrap_buffer(buffer_wrap);
+  size_t length = iotjs_bufferwrap_length(buffer_wrap);
+
+  iotjs_websocket_write_t* write = IOTJS_ALLOC(iotjs_websocket_write_t);
+  write->jws = iotjs_jval_create_copied(iotjs_websocketwrap_jobject(ws_wrap));
+  write->jbuffer = iotjs_jval_create_copied(jbuffer);
+  write->jcallback = iotjs_jval_create_copied(JHANDLER_GET_ARG(3, function));
+
+  uint32_t key = iotjs_websocket_random();
+  uint8_t mask[4];
+  memcpy(mask, &key, sizeof(mask));
+
+  size_t header_length =
+      iotjs_websocket_build_header(write->header, opcode, fin, length,
+                                   _this->is_client ? mask : NULL);
+
+  uv_buf_t bufs[2];
+  bufs[0] = uv_buf_init((char*)write->header, (unsigned int)header_length);
+  if (_this->is_client && length > 0) {
+    write->masked = iotjs_buffer_allocate(length);
+    memcpy(write->masked, payload, length);
+    iotjs_websocket_mask((uint8_t*)write->masked, length, mask, 0);
+    payload = write->masked;
+  }
+  bufs[1] = uv_buf_init(payload, (unsigned int)length);
+
+  uv_stream_t* stream =
+      (uv_stream_t*)iotjs_tcpwrap_tcp_handle(_this->tcp_wrap);
+  int err = uv_write(&write->req, stream, bufs, length > 0 ? 2 : 1,
+                     AfterWebSocketWrite);
+  if (err) {
+    iotjs_websocket_write_release(write);
+  }
+
+  iotjs_jhandler_return_number(jhandler, err);
+}
+
+
+// Returns a frame in a Buffer, for JavaScript to write.
+// [0] opcode
+// [1] whether this is the last frame of the message
+// [2] payload buffer
+JHANDLER_FUNCTION(Encode) {
+  JHANDLER_DECLARE_THIS_PTR(websocketwrap, ws_wrap);
+  DJHANDLER_CHECK_ARGS(3, number, boolean, object);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, ws_wrap);
+
+  int opcode = (int)JHANDLER_GET_ARG(0, number);
+  bool fin = JHANDLER_GET_ARG(1, boolean);
+  iotjs_bufferwrap_t* buffer_wrap =
+      iotjs_bufferwrap_from_jbuffer(JHANDLER_GET_ARG(2, object));
+  size_t length = iotjs_bufferwrap_length(buffer_wrap);
+
+  uint32_t key = iotjs_websocket_random();
+  uint8_t mask[4];
+  memcpy(mask, &key, sizeof(mask));
+
+  uint8_t header[IOTJS_WEBSOCKET_MAX_HEADER];
+  size_t header_length =
+      iotjs_websocket_build_header(header, opcode, fin, length,
+                                   _this->is_client ? mask : NULL);
+
+  iotjs_jval_t jframe = iotjs_bufferwrap_create_buffer(header_length + length);
+  char* frame =
+      iotjs_bufferwrap_buffer(iotjs_bufferwrap_from_jbuffer(&jframe));
+  memcpy(frame, header, header_length);
+  if (length > 0) {
+    memcpy(frame + header_length, iotjs_bufferwrap_buffer(buffer_wrap),
+           length);
+  }
+  if (_this->is_client) {
+    iotjs_websocket_mask((uint8_t*)frame + header_length, length, mask, 0);
+  }
+
+  iotjs_jhandler_return_jval(jhandler, &jframe);
+  iotjs_jval_destroy(&jframe);
+}
+
+
+// [0] the largest payload of a message received
+JHANDLER_FUNCTION(SetMaxPayload) {
+  JHANDLER_DECLARE_THIS_PTR(websocketwrap, ws_wrap);
+  DJHANDLER_CHECK_ARGS(1, number);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, ws_wrap);
+
+  double max_payload = JHANDLER_GET_ARG(0, number);
+  _this->max_payload = max_payload > 0 ? (size_t)max_payload : 0;
+}
+
+
+// Drops the state of the connection, and gives the data read by the tcp
+// object back to JavaScript.
+JHANDLER_FUNCTION(Destroy) {
+  JHANDLER_DECLARE_THIS_PTR(websocketwrap, ws_wrap);
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_websocketwrap_t, ws_wrap);
+
+  if (_this->started && _this->tcp_wrap != NULL) {
+    iotjs_tcp_splice_stop(_this->tcp_wrap);
+  }
+  _this->destroyed = true;
+  _this->tcp_wrap = NULL;
+  if (!_this->busy) {
+    iotjs_websocketwrap_release(ws_wrap);
+  }
+}
+
+
+#define ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+
+static void iotjs_sha1_transform(uint32_t* state, const uint8_t* block) {
+  uint32_t w[80];
+  for (size_t i = 0; i < 16; i++) {
+    w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) |
+           ((uint32_t)block[i * 4 + 2] << 8) | (uint32_t)block[i * 4 + 3];
+  }
+  for (size_t i = 16; i < 80; i++) {
+    w[i] = ROTL(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+           e = state[4];
+  for (size_t i = 0; i < 80; i++) {
+    uint32_t f, k;
+    if (i < 20) {
+      f = (b & c) | (~b & d);
+      k = 0x5a827999;
+    } else if (i < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ed9eba1;
+    } else if (i < 60) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8f1bbcdc;
+    } else {
+      f = b ^ c ^ d;
+      k = 0xca62c1d6;
+    }
+    uint32_t t = ROTL(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = ROTL(b, 30);
+    b = a;
+    a = t;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
+
+
+// SHA-1, which only the opening handshake uses.
+static void iotjs_sha1(const uint8_t* data, size_t length, uint8_t* digest) {
+  uint32_t state[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476,
+                        0xc3d2e1f0 };
+
+  size_t full = length - length % SHA1_BLOCK_SIZE;
+  for (size_t offset = 0; offset < full; offset += SHA1_BLOCK_SIZE) {
+    iotjs_sha1_transform(state, data + offset);
+  }
+
+  uint8_t tail[SHA1_BLOCK_SIZE * 2] = { 0 };
+  size_t rest = length - full;
+  memcpy(tail, data + full, rest);
+  tail[rest] = 0x80;
+  size_t tail_length = rest < 56 ? SHA1_BLOCK_SIZE : SHA1_BLOCK_SIZE * 2;
+  uint64_t bits = (uint64_t)length * 8;
+  for (size_t i = 0; i < 8; i++) {
+    tail[tail_length - 1 - i] = (uint8_t)(bits >> (i * 8));
+  }
+  for (size_t offset = 0; offset < tail_length; offset += SHA1_BLOCK_SIZE) {
+    iotjs_sha1_transform(state, tail + offset);
+  }
+
+  for (size_t i = 0; i < 5; i++) {
+    digest[i * 4] = (uint8_t)(state[i] >> 24);
+    digest[i * 4 + 1] = (uint8_t)(state[i] >> 16);
+    digest[i * 4 + 2] = (uint8_t)(state[i] >> 8);
+    digest[i * 4 + 3] = (uint8_t)state[i];
+  }
+}
+
+
+// Returns the SHA-1 digest of a string in a Buffer.
+// [0] string
+JHANDLER_FUNCTION(Sha1) {
+  DJHANDLER_CHECK_ARGS(1, string);
+
+  iotjs_string_view_t view =
+      iotjs_jval_as_string_view(iotjs_jhandler_get_arg(jhandler, 0));
+  uint8_t digest[SHA1_DIGEST_SIZE];
+  iotjs_sha1((const uint8_t*)iotjs_string_view_data(&view),
+             iotjs_string_view_size(&view), digest);
+  iotjs_string_view_destroy(&view);
+
+  iotjs_jval_t jdigest = iotjs_bufferwrap_create_buffer(SHA1_DIGEST_SIZE);
+  iotjs_bufferwrap_copy(iotjs_bufferwrap_from_jbuffer(&jdigest),
+                        (const char*)digest, SHA1_DIGEST_SIZE);
+  iotjs_jhandler_return_jval(jhandler, &jdigest);
+  iotjs_jval_destroy(&jdigest);
+}
+
+
+// Returns the 16 random bytes of the key of a client handshake.
+JHANDLER_FUNCTION(RandomKey) {
+  iotjs_jval_t jkey = iotjs_bufferwrap_create_buffer(16);
+  char* key = iotjs_bufferwrap_buffer(iotjs_bufferwrap_from_jbuffer(&jkey));
+  for (size_t i = 0; i < 16; i += 4) {
+    uint32_t x = iotjs_websocket_random();
+    memcpy(key + i, &x, sizeof(x));
+  }
+  iotjs_jhandler_return_jval(jhandler, &jkey);
+  iotjs_jval_destroy(&jkey);
+}
+
+
+iotjs_jval_t InitWebsocket() {
+  iotjs_jval_t websocket = iotjs_jval_create_object();
+
+  iotjs_jval_t jws = iotjs_jval_create_function_with_dispatch(WebSocket);
+  iotjs_jval_t prototype = iotjs_jval_create_object();
+
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_OWNER, GetOwner,
+                          SetOwner);
+  iotjs_jval_set_accessor(&prototype, IOTJS_MAGIC_STRING_ONFRAME, GetOnFrame,
+                          SetOnFrame);
+
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_START, Start);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_FEED, Feed);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SEND, Send);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_ENCODE, Encode);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_SETMAXPAYLOAD,
+                        SetMaxPayload);
+  iotjs_jval_set_method(&prototype, IOTJS_MAGIC_STRING_DESTROY, Destroy);
+
+  iotjs_jval_set_property_jval(&jws, IOTJS_MAGIC_STRING_PROTOTYPE, &prototype);
+  iotjs_jval_set_property_jval(&websocket, IOTJS_MAGIC_STRING_WEBSOCKET, &jws);
+  iotjs_jval_destroy(&prototype);
+  iotjs_jval_destroy(&jws);
+
+  iotjs_jval_set_method(&websocket, IOTJS_MAGIC_STRING_SHA1, Sha1);
+  iotjs_jval_set_method(&websocket, IOTJS_MAGIC_STRING_RANDOMKEY, RandomKey);
+
+  return websocket;
+}
@@ -16,9 +16,11 @@
 #ifndef IOTJS_MODULE_ADC_LINUX_GENERAL_INL_H
 #define IOTJS_MODULE_ADC_LINUX_GENERAL_INL_H
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 
 #include "iotjs_systemio-linux.h"
@@ -65,4 +67,50 @@ void iotjs_adc_open_worker(uv_work_t* work_req) {
 }
 
 
+bool iotjs_adc_timer_start(iotjs_adc_t* adc, uint32_t period_us) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_adc_t, adc);
+
+  int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct itimerspec spec;
+  spec.it_interval.tv_sec = period_us / 1000000;
+  spec.it_interval.tv_nsec = (period_us % 1000000) * 1000;
+  spec.it_value = spec.it_interval;
+  if (timerfd_settime(fd, 0, &spec, NULL) < 0) {
+    close(fd);
+    return false;
+  }
+
+  _this->timer_fd = fd;
+  return true;
+}
+
+
+// A read of the timer blocks until it expires, and gives the number of
+// expirations since the last read, so periods missed are counted by the
+// kernel.
+uint64_t iotjs_adc_timer_wait(iotjs_adc_t* adc) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_adc_t, adc);
+
+  uint64_t expirations;
+  ssize_t result;
+  do {
+    result = read(_this->timer_fd, &expirations, sizeof(expirations));
+  } while (result < 0 && errno == EINTR);
+
+  return result == sizeof(expirations) ? expirations : 0;
+}
+
+
+void iotjs_adc_timer_stop(iotjs_adc_t* adc) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_adc_t, adc);
+
+  close(_this->timer_fd);
+  _this->timer_fd = -1;
+}
+
+
 #endif /* IOTJS_MODULE_ADC_LINUX_GENERAL_INL_H */
@@ -67,6 +67,22 @@
 
 #define ATT_CID 4
 
+#define HCI_ACLDATA_PKT 0x02
+#define HCI_EVENT_PKT 0x04
+
+#define EVT_DISCONN_COMPLETE 0x05
+#define EVT_ENCRYPT_CHANGE 0x08
+#define EVT_CMD_COMPLETE 0x0e
+#define EVT_LE_META_EVENT 0x3e
+
+#define EVT_LE_ADVERTISING_REPORT 0x02
+
+#define ACL_CONT 0x01
+#define ACL_START 0x02
+
+// Packets read at most per wake up of the poll handle.
+#define HCI_READ_BATCH 32
+
 enum {
   HCI_UP,
   HCI_INIT,
@@ -142,6 +158,15 @@ struct sockaddr_l2 {
   uint8_t l2_bdaddr_type;
 };
 
+struct iotjs_blehcisocket_acl_s {
+  uint16_t handle;
+  uint16_t cid;
+  size_t length;
+  size_t received;
+  char* data;
+  iotjs_blehcisocket_acl_t* next;
+};
+
 
 #define THIS iotjs_blehcisocket_t* blehcisocket
 
@@ -150,6 +175,8 @@ void iotjs_blehcisocket_initialize(THIS) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
 
   _this->_l2socketCount = 0;
+  _this->_decode = false;
+  _this->_acl = NULL;
 
   _this->_socket = socket(AF_BLUETOOTH, SOCK_RAW | SOCK_CLOEXEC, BTPROTO_HCI);
 
@@ -166,12 +193,21 @@ void iotjs_blehcisocket_close(THIS) {
   uv_close((uv_handle_t*)&(_this->_pollHandle), NULL);
 
   close(_this->_socket);
+
+  while (_this->_acl != NULL) {
+    iotjs_blehcisocket_acl_t* acl = _this->_acl;
+    _this->_acl = acl->next;
+    iotjs_buffer_release(acl->data);
+    IOTJS_RELEASE(acl);
+  }
 }
 
 
-void iotjs_blehcisocket_start(THIS) {
+void iotjs_blehcisocket_start(THIS, bool decode) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
 
+  _this->_decode = decode;
+
   uv_poll_start(&_this->_pollHandle, UV_READABLE, iotjs_blehcisocket_poll_cb);
 }
 
@@ -281,9 +317,455 @@ void iotjs_blehcisocket_setFilter(THIS, char* data, size_t length) {
 }
 
 
+static void iotjs_blehcisocket_emit(THIS, const char* event,
+                                    const iotjs_jval_t* jvalue) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
+
+  iotjs_jval_t* jhcisocket = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
+  iotjs_jval_t jemit = iotjs_jval_get_property(jhcisocket, "emit");
+  IOTJS_ASSERT(iotjs_jval_is_function(&jemit));
+
+  iotjs_jargs_t jargs = iotjs_jargs_create(2);
+  iotjs_jval_t str = iotjs_jval_create_string_raw(event);
+  iotjs_jargs_append_jval(&jargs, &str);
+  iotjs_jargs_append_jval(&jargs, jvalue);
+  iotjs_jhelper_call_ok(&jemit, jhcisocket, &jargs);
+
+  iotjs_jval_destroy(&str);
+  iotjs_jargs_destroy(&jargs);
+  iotjs_jval_destroy(&jemit);
+}
+
+
+static iotjs_jval_t iotjs_blehcisocket_create_buffer(const char* data,
+                                                    size_t length) {
+  iotjs_jval_t jbuf = iotjs_bufferwrap_create_buffer(length);
+  iotjs_bufferwrap_t* buf_wrap = iotjs_bufferwrap_from_jbuffer(&jbuf);
+  iotjs_bufferwrap_copy(buf_wrap, data, length);
+  return jbuf;
+}
+
+
+static uint16_t iotjs_blehcisocket_read16(const char* data) {
+  return (uint16_t)((uint8_t)data[0] | ((uint8_t)data[1] << 8));
+}
+
+
+// Creates `[type, values..., data]` for a decoded packet, with `data` left
+// out when it is NULL.
+static iotjs_jval_t iotjs_blehcisocket_create_packet(const double* values,
+                                                    uint32_t value_count,
+                                                    const char* data,
+                                                    size_t length) {
+  iotjs_jval_t jpacket =
+      iotjs_jval_create_array(value_count + (data ? 1 : 0));
+
+  for (uint32_t i = 0; i < value_count; i++) {
+    iotjs_jval_t jvalue = iotjs_jval_create_number(values[i]);
+    iotjs_jval_set_property_by_index(&jpacket, i, &jvalue);
+    iotjs_jval_destroy(&jvalue);
+  }
+
+  if (data != NULL) {
+    iotjs_jval_t jbuf = iotjs_blehcisocket_create_buffer(data, length);
+    iotjs_jval_set_property_by_index(&jpacket, value_count, &jbuf);
+    iotjs_jval_destroy(&jbuf);
+  }
+
+  return jpacket;
+}
+
+
+// Appends a decoded packet to `jpackets`.
+static void iotjs_blehcisocket_push_packet(iotjs_jval_t* jpackets,
+                                           uint32_t* count,
+                                           const double* values,
+                                           uint32_t value_count,
+                                           const char* data, size_t length) {
+  iotjs_jval_t jpacket =
+      iotjs_blehcisocket_create_packet(values, value_count, data, length);
+  iotjs_jval_set_property_by_index(jpackets, (*count)++, &jpacket);
+  iotjs_jval_destroy(&jpacket);
+}
+
+
+static iotjs_blehcisocket_acl_t** iotjs_blehcisocket_find_acl(THIS,
+                                                             uint16_t handle) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
+
+  iotjs_blehcisocket_acl_t** pacl = &_this->_acl;
+  while (*pacl != NULL && (*pacl)->handle != handle) {
+    pacl = &(*pacl)->next;
+  }
+  return pacl;
+}
+
+
+static void iotjs_blehcisocket_drop_acl(THIS, uint16_t handle) {
+  iotjs_blehcisocket_acl_t** pacl =
+      iotjs_blehcisocket_find_acl(blehcisocket, handle);
+  iotjs_blehcisocket_acl_t* acl = *pacl;
+
+  if (acl != NULL) {
+    *pacl = acl->next;
+    iotjs_buffer_release(acl->data);
+    IOTJS_RELEASE(acl);
+  }
+}
+
+
+// Whether the advertising data lists one of the UUIDs of the filter, as a
+// service or in service data. Without UUIDs every report matches.
+static bool iotjs_blehcisocket_has_uuid(
+    const iotjs_blehcisocket_report_filter_t* filter, const uint8_t* data,
+    size_t length) {
+  if (filter->uuid_count == 0) {
+    return true;
+  }
+
+  size_t i = 0;
+  while (i + 1 < length) {
+    size_t field_length = data[i];
+    if (field_length == 0 || i + 1 + field_length > length) {
+      break;
+    }
+
+    const uint8_t* field = data + i + 2;
+    size_t size = field_length - 1;
+    size_t uuid_size = 0;
+    bool service_data = false;
+
+    switch (data[i + 1]) {
+      case 0x02: // Incomplete list of 16-bit UUIDs.
+      case 0x03: // Complete list of 16-bit UUIDs.
+        uuid_size = 2;
+        break;
+      case 0x04: // Incomplete list of 32-bit UUIDs.
+      case 0x05: // Complete list of 32-bit UUIDs.
+        uuid_size = 4;
+        break;
+      case 0x06: // Incomplete list of 128-bit UUIDs.
+      case 0x07: // Complete list of 128-bit UUIDs.
+        uuid_size = 16;
+        break;
+      case 0x16: // Service data of a 16-bit UUID.
+        uuid_size = 2;
+        service_data = true;
+        break;
+      case 0x20: // Service data of a 32-bit UUID.
+        uuid_size = 4;
+        service_data = true;
+        break;
+      case 0x21: // Service data of a 128-bit UUID.
+        uuid_size = 16;
+        service_data = true;
+        break;
+      default:
+        break;
+    }
+
+    if (service_data && size > uuid_size) {
+      size = uuid_size;
+    }
+
+    for (size_t offset = 0; uuid_size > 0 && offset + uuid_size <= size;
+         offset += uuid_size) {
+      for (int k = 0; k < filter->uuid_count; k++) {
+        if (filter->uuid_lengths[k] == uuid_size &&
+            memcmp(filter->uuids[k], field + offset, uuid_size) == 0) {
+          return true;
+        }
+      }
+    }
+
+    i += 1 + field_length;
+  }
+
+  return false;
+}
+
+
+// Whether the same report was seen within the window of the filter, and
+// otherwise remembers it. The reports are kept by a hash of the address and
+// data in a small open addressed set, where an expired or the oldest entry
+// of the probed ones is replaced.
+static bool iotjs_blehcisocket_seen(iotjs_blehcisocket_report_filter_t* filter,
+                                    const uint8_t* report, size_t length) {
+  if (filter->window == 0) {
+    return false;
+  }
+
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ report[i]) * 16777619u;
+  }
+  if (hash == 0) {
+    hash = 1;
+  }
+
+  uint64_t now = uv_now(iotjs_environment_loop(iotjs_environment_get()));
+  size_t first = hash & (IOTJS_BLEHCISOCKET_SEEN_SIZE - 1);
+  size_t victim = first;
+  bool victim_expired = false;
+
+  for (size_t probe = 0; probe < 8; probe++) {
+    size_t slot = (first + probe) & (IOTJS_BLEHCISOCKET_SEEN_SIZE - 1);
+    bool expired = filter->seen[slot].hash == 0 ||
+                   now - filter->seen[slot].time >= filter->window;
+
+    if (!expired && filter->seen[slot].hash == hash) {
+      return true;
+    }
+
+    if (victim_expired) {
+      continue;
+    }
+    if (expired) {
+      victim = slot;
+      victim_expired = true;
+    } else if (filter->seen[slot].time < filter->seen[victim].time) {
+      victim = slot;
+    }
+  }
+
+  filter->seen[victim].hash = hash;
+  filter->seen[victim].time = now;
+  return false;
+}
+
+
+// Decodes each report of an LE advertising report event that passes the
+// report filter as
+//   [HCI_EVENT_PKT, EVT_LE_META_EVENT, EVT_LE_ADVERTISING_REPORT, type,
+//    addressType, rssi, address, data]
+static void iotjs_blehcisocket_decode_reports(THIS, const uint8_t* data,
+                                              size_t length,
+                                              iotjs_jval_t* jpackets,
+                                              uint32_t* count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
+
+  iotjs_blehcisocket_report_filter_t* filter = _this->_reportFilter;
+  size_t reports = length > 0 ? data[0] : 0;
+  size_t offset = 1;
+
+  for (size_t i = 0; i < reports; i++) {
+    // Event type, address type, address and length, data and RSSI.
+    if (offset + 9 > length || offset + 10 + data[offset + 8] > length) {
+      return;
+    }
+
+    const uint8_t* report = data + offset;
+    size_t data_length = report[8];
+    int8_t rssi = (int8_t)report[9 + data_length];
+    offset += 10 + data_length;
+
+    if (filter != NULL &&
+        ((filter->has_rssi && (rssi == 127 || rssi < filter->rssi)) ||
+         !iotjs_blehcisocket_has_uuid(filter, report + 9, data_length) ||
+         iotjs_blehcisocket_seen(filter, report, 9 + data_length))) {
+      continue;
+    }
+
+    double values[6] = { HCI_EVENT_PKT, EVT_LE_META_EVENT,
+                         EVT_LE_ADVERTISING_REPORT, report[0],
+                         report[1], rssi };
+    iotjs_jval_t jpacket =
+        iotjs_blehcisocket_create_packet(values, 6, (const char*)report + 2,
+                                         6);
+    iotjs_jval_t jdata =
+        iotjs_blehcisocket_create_buffer((const char*)report + 9,
+                                         data_length);
+    iotjs_jval_set_property_by_index(&jpacket, 7, &jdata);
+    iotjs_jval_set_property_by_index(jpackets, (*count)++, &jpacket);
+    iotjs_jval_destroy(&jdata);
+    iotjs_jval_destroy(&jpacket);
+  }
+}
+
+
+// Decodes the HCI events the stack handles:
+//   [HCI_EVENT_PKT, EVT_DISCONN_COMPLETE, handle, reason]
+//   [HCI_EVENT_PKT, EVT_ENCRYPT_CHANGE, handle, encrypt]
+//   [HCI_EVENT_PKT, EVT_CMD_COMPLETE, cmd, status, result]
+//   [HCI_EVENT_PKT, EVT_LE_META_EVENT, type, status, data]
+static void iotjs_blehcisocket_decode_event(THIS, const char* data,
+                                            size_t length,
+                                            iotjs_jval_t* jpackets,
+                                            uint32_t* count) {
+  if (length < 3 || length < 3 + (size_t)(uint8_t)data[2]) {
+    return;
+  }
+
+  uint8_t event = (uint8_t)data[1];
+  double values[4] = { HCI_EVENT_PKT, event, 0, 0 };
+
+  switch (event) {
+    case EVT_DISCONN_COMPLETE:
+    case EVT_ENCRYPT_CHANGE: {
+      if (length < 7) {
+        return;
+      }
+      uint16_t handle = iotjs_blehcisocket_read16(data + 4);
+      values[2] = handle;
+      values[3] = (uint8_t)data[6];
+      if (event == EVT_DISCONN_COMPLETE) {
+        iotjs_blehcisocket_drop_acl(blehcisocket, handle);
+      }
+      iotjs_blehcisocket_push_packet(jpackets, count, values, 4, NULL, 0);
+      break;
+    }
+    case EVT_CMD_COMPLETE: {
+      if (length < 7) {
+        return;
+      }
+      values[2] = iotjs_blehcisocket_read16(data + 4);
+      values[3] = (uint8_t)data[6];
+      iotjs_blehcisocket_push_packet(jpackets, count, values, 4, data + 7,
+                                     length - 7);
+      break;
+    }
+    case EVT_LE_META_EVENT: {
+      if (length < 5) {
+        return;
+      }
+      if ((uint8_t)data[3] == EVT_LE_ADVERTISING_REPORT) {
+        iotjs_blehcisocket_decode_reports(blehcisocket,
+                                          (const uint8_t*)data + 4,
+                                          length - 4, jpackets, count);
+        break;
+      }
+      values[2] = (uint8_t)data[3];
+      values[3] = (uint8_t)data[4];
+      iotjs_blehcisocket_push_packet(jpackets, count, values, 4, data + 5,
+                                     length - 5);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+
+// Joins the fragments of an L2CAP frame. A complete frame is decoded as
+//   [HCI_ACLDATA_PKT, handle, cid, data]
+static void iotjs_blehcisocket_decode_acl(THIS, const char* data,
+                                          size_t length,
+                                          iotjs_jval_t* jpackets,
+                                          uint32_t* count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
+
+  if (length < 5) {
+    return;
+  }
+
+  uint16_t header = iotjs_blehcisocket_read16(data + 1);
+  uint16_t handle = header & 0x0fff;
+  uint16_t flags = header >> 12;
+  double values[3] = { HCI_ACLDATA_PKT, handle, 0 };
+
+  if (flags == ACL_START) {
+    if (length < 9) {
+      return;
+    }
+
+    size_t frame_length = iotjs_blehcisocket_read16(data + 5);
+    uint16_t cid = iotjs_blehcisocket_read16(data + 7);
+    size_t received = length - 9;
+
+    iotjs_blehcisocket_drop_acl(blehcisocket, handle);
+
+    if (received == frame_length) {
+      values[2] = cid;
+      iotjs_blehcisocket_push_packet(jpackets, count, values, 3, data + 9,
+                                     received);
+      return;
+    }
+    if (received > frame_length) {
+      return;
+    }
+
+    iotjs_blehcisocket_acl_t* acl = IOTJS_ALLOC(iotjs_blehcisocket_acl_t);
+    acl->handle = handle;
+    acl->cid = cid;
+    acl->length = frame_length;
+    acl->received = received;
+    acl->data = iotjs_buffer_allocate(frame_length);
+    memcpy(acl->data, data + 9, received);
+    acl->next = _this->_acl;
+    _this->_acl = acl;
+  } else if (flags == ACL_CONT) {
+    iotjs_blehcisocket_acl_t* acl =
+        *iotjs_blehcisocket_find_acl(blehcisocket, handle);
+    size_t received = length - 5;
+
+    if (acl == NULL) {
+      return;
+    }
+    if (acl->received + received > acl->length) {
+      iotjs_blehcisocket_drop_acl(blehcisocket, handle);
+      return;
+    }
+
+    memcpy(acl->data + acl->received, data + 5, received);
+    acl->received += received;
+
+    if (acl->received == acl->length) {
+      values[2] = acl->cid;
+      iotjs_blehcisocket_push_packet(jpackets, count, values, 3, acl->data,
+                                     acl->length);
+      iotjs_blehcisocket_drop_acl(blehcisocket, handle);
+    }
+  }
+}
+
+
+// Reads the packets that are waiting, up to HCI_READ_BATCH, and emits the
+// decoded ones at once as 'packets'.
+static void iotjs_blehcisocket_poll_decoded(THIS) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
+
+  iotjs_jval_t jpackets = iotjs_jval_create_array(0);
+  uint32_t count = 0;
+  char data[1024];
+
+  for (int i = 0; i < HCI_READ_BATCH; i++) {
+    int length = recv(_this->_socket, data, sizeof(data), MSG_DONTWAIT);
+    if (length <= 0) {
+      break;
+    }
+
+    if (_this->_mode == HCI_CHANNEL_RAW) {
+      if (iotjs_blehcisocket_kernelDisconnectWorkArounds(blehcisocket, length,
+                                                         data) < 0) {
+        continue;
+      }
+    }
+
+    if ((uint8_t)data[0] == HCI_EVENT_PKT) {
+      iotjs_blehcisocket_decode_event(blehcisocket, data, (size_t)length,
+                                      &jpackets, &count);
+    } else if ((uint8_t)data[0] == HCI_ACLDATA_PKT) {
+      iotjs_blehcisocket_decode_acl(blehcisocket, data, (size_t)length,
+                                    &jpackets, &count);
+    }
+  }
+
+  if (count > 0) {
+    iotjs_blehcisocket_emit(blehcisocket, "packets", &jpackets);
+  }
+
+  iotjs_jval_destroy(&jpackets);
+}
+
+
 void iotjs_blehcisocket_poll(THIS) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_blehcisocket_t, blehcisocket);
 
+  if (_this->_decode) {
+    iotjs_blehcisocket_poll_decoded(blehcisocket);
+    return;
+  }
+
   int length = 0;
   char data[1024];
 
@@ -297,24 +779,10 @@ void iotjs_blehcisocket_poll(THIS) {
       }
     }
 
-    iotjs_jval_t* jhcisocket = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
-    iotjs_jval_t jemit = iotjs_jval_get_property(jhcisocket, "emit");
-    IOTJS_ASSERT(iotjs_jval_is_function(&jemit));
-
-    iotjs_jargs_t jargs = iotjs_jargs_create(2);
-    iotjs_jval_t str = iotjs_jval_create_string_raw("data");
-    IOTJS_ASSERT(length >= 0);
-    iotjs_jval_t jbuf = iotjs_bufferwrap_create_buffer((size_t)length);
-    iotjs_bufferwrap_t* buf_wrap = iotjs_bufferwrap_from_jbuffer(&jbuf);
-    iotjs_bufferwrap_copy(buf_wrap, data, (size_t)length);
-    iotjs_jargs_append_jval(&jargs, &str);
-    iotjs_jargs_append_jval(&jargs, &jbuf);
-    iotjs_jhelper_call_ok(&jemit, jhcisocket, &jargs);
-
-    iotjs_jval_destroy(&str);
+    iotjs_jval_t jbuf =
+        iotjs_blehcisocket_create_buffer(data, (size_t)length);
+    iotjs_blehcisocket_emit(blehcisocket, "data", &jbuf);
     iotjs_jval_destroy(&jbuf);
-    iotjs_jargs_destroy(&jargs);
-    iotjs_jval_destroy(&jemit);
   }
 }
 
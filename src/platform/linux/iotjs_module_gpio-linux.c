@@ -14,12 +14,17 @@
  */
 
 
-#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
+#if defined(HAVE_LINUX_GPIO_H)
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#endif
+
 #include "iotjs_systemio-linux.h"
 #include "modules/iotjs_module_gpio.h"
 
@@ -42,110 +47,430 @@
 #define GPIO_PIN_BUFFER_SIZE DEVICE_IO_PIN_BUFFER_SIZE
 #define GPIO_VALUE_BUFFER_SIZE 10
 
+#define GPIO_CHIP_FORMAT "/dev/gpiochip%d"
+#define GPIO_CONSUMER_LABEL "iotjs"
+
+// The edges of a pin in capture mode, with their times in microseconds,
+// until they are passed on.
+typedef struct {
+  double times[IOTJS_GPIO_CAPTURE_MAX];
+  uint8_t values[IOTJS_GPIO_CAPTURE_MAX];
+  uint32_t count;
+  // Edges which came while the buffer was full.
+  uint32_t dropped;
+  uint32_t batch;
+  uint32_t latency;
+  // The value whose edges start the periods: rising, unless only the
+  // falling edges are captured.
+  uint8_t period_value;
+  // The last edges passed on, for the pulses and periods across batches.
+  bool has_last;
+  uint8_t last_value;
+  double last_time;
+  bool has_period_start;
+  double period_start;
+} iotjs_gpio_capture_t;
+
+// The edge detection of an input pin. It is allocated apart from the pin,
+// because its handles are closed asynchronously and may outlive it.
+typedef struct {
+  uv_poll_t poll_handle;
+  // Holds back the edges for the debounce time, or the captured edges for
+  // the latency of capture mode.
+  uv_timer_t debounce_timer;
+  iotjs_gpio_t* gpio;
+  int value_fd;
+  bool chardev;
+  uint32_t debounce;
+  // Whether an edge came while the events were held back by the timer.
+  bool pending;
+  iotjs_gpio_capture_t* capture;
+  int closing_handles;
+} iotjs_gpio_edge_t;
+
+// A pin is driven with the sysfs interface, which opens its value file for
+// every access, or with a line handle of the GPIO character device, which
+// stays open and reads or writes all lines of the pin with one ioctl().
 struct _iotjs_gpio_module_platform_t {
+  // The value file of an input pin with an edge, or the line handle.
   int value_fd;
-  uv_thread_t thread;
-  uv_mutex_t mutex;
+  bool chardev;
+  iotjs_gpio_edge_t* edge;
 };
 
 // Implementation used here are based on:
 //  https://www.kernel.org/doc/Documentation/gpio/sysfs.txt
+//  https://www.kernel.org/doc/Documentation/ABI/testing/gpio-cdev
 
 
 static const char* gpio_edge_string[] = { "none", "rising", "falling", "both" };
 
 
-static int gpio_get_value_fd(iotjs_gpio_t* gpio) {
-  int fd;
-  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+// Reads the value of the pin from the start of its value file, which also
+// clears the edge that poll() reported.
+static int gpio_read_value_fd(int fd) {
+  char buffer[1];
+
+  if (lseek(fd, 0, SEEK_SET) < 0) {
+    DLOG("GPIO Error in lseek");
+    return -1;
+  }
 
-  uv_mutex_lock(&_this->platform->mutex);
-  fd = _this->platform->value_fd;
-  uv_mutex_unlock(&_this->platform->mutex);
+  if (read(fd, &buffer, 1) < 1) {
+    DLOG("GPIO Error in read");
+    return -1;
+  }
 
-  return fd;
+  return buffer[0] == '1';
 }
 
 
-static void gpio_set_value_fd(iotjs_gpio_t* gpio, int fd) {
-  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+#if defined(HAVE_LINUX_GPIO_H)
+static bool gpio_chardev_get_values(int fd, uint8_t* values, uint32_t count) {
+  struct gpiohandle_data data;
+  memset(&data, 0, sizeof(data));
 
-  uv_mutex_lock(&_this->platform->mutex);
-  _this->platform->value_fd = fd;
-  uv_mutex_unlock(&_this->platform->mutex);
+  if (ioctl(fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) < 0) {
+    DLOG("GPIO Error in GPIOHANDLE_GET_LINE_VALUES_IOCTL");
+    return false;
+  }
+
+  memcpy(values, data.values, count);
+  return true;
 }
 
 
-static void gpio_emit_change_event(iotjs_gpio_t* gpio) {
-  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+static bool gpio_chardev_set_values(int fd, const uint8_t* values,
+                                    uint32_t count) {
+  struct gpiohandle_data data;
+  memset(&data, 0, sizeof(data));
+  memcpy(data.values, values, count);
+
+  if (ioctl(fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0) {
+    DLOG("GPIO Error in GPIOHANDLE_SET_LINE_VALUES_IOCTL");
+    return false;
+  }
+
+  return true;
+}
+#endif
+
+
+// Clears the edges that were reported and reads the value of the pin. The
+// events of a line event file are all read, so a burst of them is one
+// 'change' event.
+static int gpio_edge_read_value(iotjs_gpio_edge_t* edge) {
+#if defined(HAVE_LINUX_GPIO_H)
+  if (edge->chardev) {
+    struct gpioevent_data events[16];
+    while (read(edge->value_fd, events, sizeof(events)) ==
+           (ssize_t)sizeof(events)) {
+    }
+
+    uint8_t value;
+    return gpio_chardev_get_values(edge->value_fd, &value, 1) ? value : -1;
+  }
+#endif
+
+  return gpio_read_value_fd(edge->value_fd);
+}
+
+
+static void gpio_emit_change_event(iotjs_gpio_edge_t* edge) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, edge->gpio);
+
+  int value = gpio_edge_read_value(edge);
 
   iotjs_jval_t* jgpio = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
-  iotjs_jval_t jonChange = iotjs_jval_get_property(jgpio, "onChange");
+  iotjs_jval_t jonChange =
+      iotjs_jval_get_property(jgpio, IOTJS_MAGIC_STRING_ONCHANGE);
   IOTJS_ASSERT(iotjs_jval_is_function(&jonChange));
 
-  iotjs_jhelper_call_ok(&jonChange, jgpio, iotjs_jargs_get_empty());
+  iotjs_jargs_t jargs = iotjs_jargs_create(1);
+  if (value >= 0) {
+    iotjs_jargs_append_bool(&jargs, value);
+  }
+
+  iotjs_make_callback_in_lane(kCallbackLaneHigh, &jonChange, jgpio, &jargs);
 
+  iotjs_jargs_destroy(&jargs);
   iotjs_jval_destroy(&jonChange);
 }
 
 
-static bool gpio_clear_dummy_value(int fd) {
-  char buffer[1];
+// With a debounce time, the first edge is reported at once and the edges
+// that follow within the time are held back. If there were any, one more
+// event reports the value they settled to when the time is over.
+static void gpio_debounce_timer_cb(uv_timer_t* handle) {
+  iotjs_gpio_edge_t* edge = (iotjs_gpio_edge_t*)handle->data;
 
-  if (lseek(fd, 0, SEEK_SET) < 0) {
-    DLOG("GPIO Error in lseek");
-    return false;
+  if (edge->pending) {
+    edge->pending = false;
+    uv_timer_start(&edge->debounce_timer, gpio_debounce_timer_cb,
+                   edge->debounce, 0);
+    gpio_emit_change_event(edge);
   }
+}
 
-  if (read(fd, &buffer, 1) < 0) {
-    DLOG("GPIO Error in read");
-    return false;
+
+static void gpio_edge_poll_cb(uv_poll_t* handle, int status, int events) {
+  iotjs_gpio_edge_t* edge = (iotjs_gpio_edge_t*)handle->data;
+
+  if (status < 0) {
+    DLOG("GPIO Error on poll: %s", uv_strerror(status));
+    return;
   }
 
-  return true;
+  if (edge->debounce == 0) {
+    gpio_emit_change_event(edge);
+    return;
+  }
+
+  if (uv_is_active((uv_handle_t*)&edge->debounce_timer)) {
+    // Clear the edge, so it is not reported again on the next iteration.
+    gpio_edge_read_value(edge);
+    edge->pending = true;
+    return;
+  }
+
+  uv_timer_start(&edge->debounce_timer, gpio_debounce_timer_cb, edge->debounce,
+                 0);
+  gpio_emit_change_event(edge);
 }
 
 
-static int gpio_edge_poll(struct pollfd* pollfd) {
-  int ret;
+// Passes the captured edges on to onCapture(times, values, highWidths,
+// lowWidths, frequency, dropped). The widths are those of the pulses which
+// ended with the edges, and the frequency is of the periods which did.
+static void gpio_capture_flush(iotjs_gpio_edge_t* edge) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, edge->gpio);
+
+  iotjs_gpio_capture_t* capture = edge->capture;
+  if (capture->count == 0 && capture->dropped == 0) {
+    return;
+  }
+
+  iotjs_jval_t jtimes = iotjs_jval_create_array(capture->count);
+  iotjs_jval_t jvalues = iotjs_jval_create_array(capture->count);
+  iotjs_jval_t jhigh_widths = iotjs_jval_create_array(0);
+  iotjs_jval_t jlow_widths = iotjs_jval_create_array(0);
+  uint32_t high_count = 0;
+  uint32_t low_count = 0;
+  uint32_t period_count = 0;
+  double period_sum = 0;
+
+  for (uint32_t i = 0; i < capture->count; ++i) {
+    double time = capture->times[i];
+    uint8_t value = capture->values[i];
+
+    iotjs_jval_t jtime = iotjs_jval_create_number(time);
+    iotjs_jval_set_property_by_index(&jtimes, i, &jtime);
+    iotjs_jval_destroy(&jtime);
+    iotjs_jval_set_property_by_index(&jvalues, i,
+                                     iotjs_jval_get_boolean(value));
+
+    if (capture->has_last && value != capture->last_value) {
+      iotjs_jval_t jwidth = iotjs_jval_create_number(time - capture->last_time);
+      if (capture->last_value) {
+        iotjs_jval_set_property_by_index(&jhigh_widths, high_count++, &jwidth);
+      } else {
+        iotjs_jval_set_property_by_index(&jlow_widths, low_count++, &jwidth);
+      }
+      iotjs_jval_destroy(&jwidth);
+    }
+
+    if (value == capture->period_value) {
+      if (capture->has_period_start) {
+        period_sum += time - capture->period_start;
+        period_count++;
+      }
+      capture->has_period_start = true;
+      capture->period_start = time;
+    }
 
-  // Wait edge
-  if ((ret = poll(pollfd, 1, -1)) > 0) {
-    if (!gpio_clear_dummy_value(pollfd->fd))
-      return -1;
+    capture->has_last = true;
+    capture->last_value = value;
+    capture->last_time = time;
   }
 
-  return ret;
+  double frequency =
+      period_count > 0 && period_sum > 0 ? 1e6 * period_count / period_sum : 0;
+  uint32_t dropped = capture->dropped;
+  capture->count = 0;
+  capture->dropped = 0;
+
+  iotjs_jval_t* jgpio = iotjs_jobjectwrap_jobject(&_this->jobjectwrap);
+  iotjs_jval_t jonCapture =
+      iotjs_jval_get_property(jgpio, IOTJS_MAGIC_STRING_ONCAPTURE);
+  if (iotjs_jval_is_function(&jonCapture)) {
+    iotjs_jargs_t jargs = iotjs_jargs_create(6);
+    iotjs_jargs_append_jval(&jargs, &jtimes);
+    iotjs_jargs_append_jval(&jargs, &jvalues);
+    iotjs_jargs_append_jval(&jargs, &jhigh_widths);
+    iotjs_jargs_append_jval(&jargs, &jlow_widths);
+    iotjs_jargs_append_number(&jargs, frequency);
+    iotjs_jargs_append_number(&jargs, dropped);
+    iotjs_make_callback_in_lane(kCallbackLaneHigh, &jonCapture, jgpio, &jargs);
+    iotjs_jargs_destroy(&jargs);
+  }
+  iotjs_jval_destroy(&jonCapture);
+  iotjs_jval_destroy(&jtimes);
+  iotjs_jval_destroy(&jvalues);
+  iotjs_jval_destroy(&jhigh_widths);
+  iotjs_jval_destroy(&jlow_widths);
 }
 
 
-static void gpio_edge_detection_cb(void* data) {
-  int fd;
-  iotjs_gpio_t* gpio = (iotjs_gpio_t*)data;
-  struct pollfd pollfd;
+static void gpio_capture_add(iotjs_gpio_capture_t* capture, double time,
+                             uint8_t value) {
+  if (capture->count == IOTJS_GPIO_CAPTURE_MAX) {
+    capture->dropped++;
+    return;
+  }
+  capture->times[capture->count] = time;
+  capture->values[capture->count] = value;
+  capture->count++;
+}
+
 
-  if ((fd = gpio_get_value_fd(gpio)) < 0) {
-    DLOG("GPIO Error: cannot start edge detection");
+// Records the edges reported by the poll. The line events of the character
+// device carry the times the kernel saw the edges at. With sysfs, the time
+// is taken at the wakeup and the value read after it.
+static void gpio_capture_read(iotjs_gpio_edge_t* edge) {
+  iotjs_gpio_capture_t* capture = edge->capture;
+
+#if defined(HAVE_LINUX_GPIO_H)
+  if (edge->chardev) {
+    struct gpioevent_data events[16];
+    ssize_t size;
+    while ((size = read(edge->value_fd, events, sizeof(events))) > 0) {
+      size_t count = (size_t)size / sizeof(events[0]);
+      for (size_t i = 0; i < count; ++i) {
+        gpio_capture_add(capture, (double)events[i].timestamp / 1000,
+                         events[i].id == GPIOEVENT_EVENT_RISING_EDGE);
+      }
+      if (size < (ssize_t)sizeof(events)) {
+        break;
+      }
+    }
     return;
   }
+#endif
+
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  int value = gpio_read_value_fd(edge->value_fd);
+  if (value >= 0) {
+    gpio_capture_add(capture,
+                     (double)now.tv_sec * 1e6 + (double)now.tv_nsec / 1000,
+                     (uint8_t)value);
+  }
+}
+
+
+static void gpio_capture_timer_cb(uv_timer_t* handle) {
+  gpio_capture_flush((iotjs_gpio_edge_t*)handle->data);
+}
+
 
-  memset(&pollfd, 0, sizeof(pollfd));
-  pollfd.fd = fd;
-  pollfd.events = POLLPRI | POLLERR;
+static void gpio_capture_poll_cb(uv_poll_t* handle, int status, int events) {
+  iotjs_gpio_edge_t* edge = (iotjs_gpio_edge_t*)handle->data;
 
-  if (!gpio_clear_dummy_value(fd))
+  if (status < 0) {
+    DLOG("GPIO Error on poll: %s", uv_strerror(status));
     return;
+  }
 
-  while (true) {
-    if ((fd = gpio_get_value_fd(gpio)) < 0)
-      return;
+  gpio_capture_read(edge);
 
-    if (gpio_edge_poll(&pollfd) > 0) {
-      gpio_emit_change_event(gpio);
-    } else {
-      DLOG("GPIO Error on poll: %s", strerror(errno));
+  if (edge->capture->count >= edge->capture->batch) {
+    uv_timer_stop(&edge->debounce_timer);
+    gpio_capture_flush(edge);
+  } else if (!uv_is_active((uv_handle_t*)&edge->debounce_timer)) {
+    uv_timer_start(&edge->debounce_timer, gpio_capture_timer_cb,
+                   edge->capture->latency, 0);
+  }
+}
+
+
+static void gpio_edge_close_cb(uv_handle_t* handle) {
+  iotjs_gpio_edge_t* edge = (iotjs_gpio_edge_t*)handle->data;
+
+  if (--edge->closing_handles == 0) {
+    if (edge->capture != NULL) {
+      IOTJS_RELEASE(edge->capture);
+    }
+    IOTJS_RELEASE(edge);
+  }
+}
+
+
+void iotjs_gpio_edge_start(iotjs_gpio_t* gpio) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+
+  int fd = _this->platform->value_fd;
+  if (fd < 0 || _this->platform->edge != NULL ||
+      _this->direction != kGpioDirectionIn || _this->edge == kGpioEdgeNone) {
+    return;
+  }
+
+  uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());
+  iotjs_gpio_edge_t* edge = IOTJS_ALLOC(iotjs_gpio_edge_t);
+  edge->gpio = gpio;
+  edge->value_fd = fd;
+  edge->chardev = _this->platform->chardev;
+  edge->debounce = _this->debounce;
+
+  if (_this->capture_batch > 0) {
+    edge->capture = IOTJS_ALLOC(iotjs_gpio_capture_t);
+    edge->capture->batch = _this->capture_batch;
+    edge->capture->latency = _this->capture_latency;
+    edge->capture->period_value = _this->edge != kGpioEdgeFalling;
+  }
+
+  if (uv_poll_init(loop, &edge->poll_handle, fd) < 0) {
+    DLOG("GPIO Error: cannot start edge detection");
+    if (edge->capture != NULL) {
+      IOTJS_RELEASE(edge->capture);
     }
+    IOTJS_RELEASE(edge);
+    return;
   }
+  uv_timer_init(loop, &edge->debounce_timer);
+  edge->poll_handle.data = edge;
+  edge->debounce_timer.data = edge;
+
+  // Like the thread that used to wait for the edges, the pin does not keep
+  // the process running.
+  uv_unref((uv_handle_t*)&edge->poll_handle);
+  uv_unref((uv_handle_t*)&edge->debounce_timer);
+
+  // sysfs reports an edge with POLLPRI, while the file is always readable.
+  // A line event file is readable when it has events.
+  uv_poll_start(&edge->poll_handle,
+                edge->chardev ? UV_READABLE : UV_PRIORITIZED,
+                edge->capture != NULL ? gpio_capture_poll_cb
+                                      : gpio_edge_poll_cb);
+  _this->platform->edge = edge;
+}
+
+
+static void gpio_edge_close(iotjs_gpio_module_platform_t platform) {
+  iotjs_gpio_edge_t* edge = platform->edge;
+  if (edge == NULL) {
+    return;
+  }
+
+  platform->edge = NULL;
+  edge->closing_handles = 2;
+  uv_close((uv_handle_t*)&edge->poll_handle, gpio_edge_close_cb);
+  uv_close((uv_handle_t*)&edge->debounce_timer, gpio_edge_close_cb);
+}
+
+
+void iotjs_gpio_edge_stop(iotjs_gpio_t* gpio) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+  gpio_edge_close(_this->platform);
 }
 
 
@@ -186,30 +511,96 @@ static bool gpio_set_edge(iotjs_gpio_t* gpio) {
       return false;
     }
 
+    // The value read first is not an edge. The edges are watched on the
+    // event loop by iotjs_gpio_edge_start() once the pin is opened.
+    gpio_read_value_fd(_this->platform->value_fd);
+  }
 
-    // Create edge detection thread
-    // When the GPIO pin is closed, thread is terminated.
-    int ret = uv_thread_create(&_this->platform->thread, gpio_edge_detection_cb,
-                               (void*)gpio);
-    if (ret < 0) {
-      DLOG("GPIO Error in uv_thread_create");
-    }
+  return true;
+}
+
+
+// Requests the lines of the pin from its GPIO chip. An input pin with an edge
+// is requested as a line event file, which also reads the value.
+static bool gpio_chardev_open(iotjs_gpio_t* gpio) {
+#if defined(HAVE_LINUX_GPIO_H)
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+
+  char chip_path[GPIO_PATH_BUFFER_SIZE];
+  snprintf(chip_path, GPIO_PATH_BUFFER_SIZE, GPIO_CHIP_FORMAT, _this->chip);
+
+  int chip_fd = open(chip_path, O_RDONLY | O_CLOEXEC);
+  if (chip_fd < 0) {
+    DLOG("GPIO Error: cannot open %s", chip_path);
     return false;
   }
 
-  return true;
+  int fd = -1;
+  if (_this->direction == kGpioDirectionIn && _this->edge != kGpioEdgeNone) {
+    struct gpioevent_request request;
+    memset(&request, 0, sizeof(request));
+    request.lineoffset = _this->pin;
+    request.handleflags = GPIOHANDLE_REQUEST_INPUT;
+    if (_this->edge == kGpioEdgeRising) {
+      request.eventflags = GPIOEVENT_REQUEST_RISING_EDGE;
+    } else if (_this->edge == kGpioEdgeFalling) {
+      request.eventflags = GPIOEVENT_REQUEST_FALLING_EDGE;
+    } else {
+      request.eventflags = GPIOEVENT_REQUEST_BOTH_EDGES;
+    }
+    strncpy(request.consumer_label, GPIO_CONSUMER_LABEL,
+            sizeof(request.consumer_label) - 1);
+
+    if (ioctl(chip_fd, GPIO_GET_LINEEVENT_IOCTL, &request) < 0) {
+      DLOG("GPIO Error in GPIO_GET_LINEEVENT_IOCTL");
+    } else {
+      fd = request.fd;
+    }
+  } else {
+    struct gpiohandle_request request;
+    memset(&request, 0, sizeof(request));
+    for (uint32_t i = 0; i < _this->line_count; ++i) {
+      request.lineoffsets[i] = _this->lines ? _this->lines[i] : _this->pin;
+    }
+    request.lines = _this->line_count;
+    request.flags = _this->direction == kGpioDirectionIn
+                        ? GPIOHANDLE_REQUEST_INPUT
+                        : GPIOHANDLE_REQUEST_OUTPUT;
+    strncpy(request.consumer_label, GPIO_CONSUMER_LABEL,
+            sizeof(request.consumer_label) - 1);
+
+    if (ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &request) < 0) {
+      DLOG("GPIO Error in GPIO_GET_LINEHANDLE_IOCTL");
+    } else {
+      fd = request.fd;
+    }
+  }
+
+  close(chip_fd);
+
+  _this->platform->value_fd = fd;
+  _this->platform->chardev = true;
+  return fd >= 0;
+#else
+  DLOG("GPIO Error: built without the GPIO character device");
+  return false;
+#endif
 }
 
 
 void iotjs_gpio_platform_create(iotjs_gpio_t_impl_t* _this) {
   size_t private_mem = sizeof(struct _iotjs_gpio_module_platform_t);
-  _this->platform = (iotjs_gpio_module_platform_t)malloc(private_mem);
+  _this->platform =
+      (iotjs_gpio_module_platform_t)iotjs_buffer_allocate(private_mem);
   _this->platform->value_fd = -1;
-  uv_mutex_init(&_this->platform->mutex);
+  _this->platform->chardev = false;
+  _this->platform->edge = NULL;
 }
 
 
 void iotjs_gpio_platform_destroy(iotjs_gpio_t_impl_t* _this) {
+  // A pin that was not closed stops detecting edges, which refer to it.
+  gpio_edge_close(_this->platform);
   iotjs_buffer_release((char*)_this->platform);
 }
 
@@ -217,6 +608,12 @@ void iotjs_gpio_platform_destroy(iotjs_gpio_t_impl_t* _this) {
 bool iotjs_gpio_write(iotjs_gpio_t* gpio, bool value) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
 
+  if (_this->platform->chardev) {
+    uint8_t values[IOTJS_GPIO_LINES_MAX];
+    memset(values, value, _this->line_count);
+    return iotjs_gpio_write_lines(gpio, values);
+  }
+
   char value_path[GPIO_PATH_BUFFER_SIZE];
   snprintf(value_path, GPIO_PATH_BUFFER_SIZE, GPIO_PIN_FORMAT_VALUE,
            _this->pin);
@@ -232,6 +629,11 @@ bool iotjs_gpio_write(iotjs_gpio_t* gpio, bool value) {
 int iotjs_gpio_read(iotjs_gpio_t* gpio) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
 
+  if (_this->platform->chardev) {
+    uint8_t values[IOTJS_GPIO_LINES_MAX];
+    return iotjs_gpio_read_lines(gpio, values) ? values[0] : -1;
+  }
+
   char buffer[GPIO_VALUE_BUFFER_SIZE];
   char value_path[GPIO_PATH_BUFFER_SIZE];
   snprintf(value_path, GPIO_PATH_BUFFER_SIZE, GPIO_PIN_FORMAT_VALUE,
@@ -246,14 +648,57 @@ int iotjs_gpio_read(iotjs_gpio_t* gpio) {
 }
 
 
+bool iotjs_gpio_write_lines(iotjs_gpio_t* gpio, const uint8_t* values) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+
+#if defined(HAVE_LINUX_GPIO_H)
+  if (_this->platform->chardev && _this->platform->value_fd >= 0) {
+    return gpio_chardev_set_values(_this->platform->value_fd, values,
+                                   _this->line_count);
+  }
+#endif
+
+  // The sysfs interface has one pin per object.
+  return !_this->platform->chardev && iotjs_gpio_write(gpio, values[0]);
+}
+
+
+bool iotjs_gpio_read_lines(iotjs_gpio_t* gpio, uint8_t* values) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
+
+#if defined(HAVE_LINUX_GPIO_H)
+  if (_this->platform->chardev && _this->platform->value_fd >= 0) {
+    return gpio_chardev_get_values(_this->platform->value_fd, values,
+                                   _this->line_count);
+  }
+#endif
+
+  if (_this->platform->chardev) {
+    return false;
+  }
+
+  int value = iotjs_gpio_read(gpio);
+  values[0] = (uint8_t)value;
+  return value >= 0;
+}
+
+
 bool iotjs_gpio_close(iotjs_gpio_t* gpio) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
 
   char buff[GPIO_PIN_BUFFER_SIZE];
   snprintf(buff, GPIO_PIN_BUFFER_SIZE, "%d", _this->pin);
 
-  gpio_set_value_fd(gpio, -1);
-  close(_this->platform->value_fd);
+  // The edge detection is stopped already, on the event loop thread.
+  if (_this->platform->value_fd >= 0) {
+    close(_this->platform->value_fd);
+    _this->platform->value_fd = -1;
+  }
+
+  // Closing the line handle released the lines.
+  if (_this->platform->chardev) {
+    return true;
+  }
 
   return iotjs_systemio_open_write_close(GPIO_PIN_FORMAT_UNEXPORT, buff);
 }
@@ -266,6 +711,11 @@ void iotjs_gpio_open_worker(uv_work_t* work_req) {
   DDDLOG("%s - pin: %d, dir: %d, mode: %d", __func__, _this->pin,
          _this->direction, _this->mode);
 
+  if (_this->chip >= 0) {
+    req_data->result = gpio_chardev_open(gpio);
+    return;
+  }
+
   // Open GPIO pin.
   char exported_path[GPIO_PATH_BUFFER_SIZE];
   snprintf(exported_path, GPIO_PATH_BUFFER_SIZE, GPIO_PIN_FORMAT, _this->pin);
@@ -45,6 +45,7 @@
 
 
 #include <fcntl.h>
+#include <linux/i2c.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -59,6 +60,14 @@
 
 
 #define I2C_SLAVE_FORCE 0x0706
+#define I2C_RDWR 0x0707
+
+
+// The argument of I2C_RDWR, as in <linux/i2c-dev.h>.
+typedef struct {
+  struct i2c_msg* msgs;
+  uint32_t nmsgs;
+} iotjs_i2c_rdwr_ioctl_data_t;
 
 
 #define I2C_WORKER_INIT_TEMPLATE                                            \
@@ -86,6 +95,9 @@ void i2c_create_platform_data(iotjs_jhandler_t* jhandler, iotjs_i2c_t* i2c,
                       iotjs_string_size(&device));
   pdata->device_fd = -1;
   *ppdata = pdata;
+
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_i2c_t, i2c);
+  _this->bus_queue = iotjs_busqueue_acquire(iotjs_string_data(&pdata->device));
 }
 
 void i2c_destroy_platform_data(iotjs_i2c_platform_data_t* pdata) {
@@ -123,9 +135,7 @@ void I2cClose(iotjs_i2c_t* i2c) {
   }
 }
 
-void WriteWorker(uv_work_t* work_req) {
-  I2C_WORKER_INIT_TEMPLATE;
-  iotjs_i2c_t* i2c = iotjs_i2c_instance_from_reqwrap(req_wrap);
+void I2cWrite(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
   IOTJS_I2C_METHOD_HEADER(i2c);
 
   uint8_t len = req_data->buf_len;
@@ -140,9 +150,7 @@ void WriteWorker(uv_work_t* work_req) {
   }
 }
 
-void ReadWorker(uv_work_t* work_req) {
-  I2C_WORKER_INIT_TEMPLATE;
-  iotjs_i2c_t* i2c = iotjs_i2c_instance_from_reqwrap(req_wrap);
+void I2cRead(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
   IOTJS_I2C_METHOD_HEADER(i2c);
 
   uint8_t len = req_data->buf_len;
@@ -152,3 +160,26 @@ void ReadWorker(uv_work_t* work_req) {
     req_data->error = kI2cErrRead;
   }
 }
+
+void I2cTransfer(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
+  IOTJS_I2C_METHOD_HEADER(i2c);
+
+  struct i2c_msg msgs[IOTJS_I2C_TRANSFER_MSGS_MAX];
+  for (uint8_t i = 0; i < req_data->msg_count; ++i) {
+    iotjs_i2c_msg_t* msg = &req_data->msgs[i];
+    msgs[i].addr = msg->address;
+    msgs[i].flags = msg->read ? I2C_M_RD : 0;
+    msgs[i].len = msg->length;
+    msgs[i].buf = msg->data;
+  }
+
+  iotjs_i2c_rdwr_ioctl_data_t rdwr = {.msgs = msgs,
+                                      .nmsgs = req_data->msg_count };
+
+  if (ioctl(platform_data->device_fd, I2C_RDWR, &rdwr) !=
+      req_data->msg_count) {
+    req_data->error = kI2cErrTransfer;
+  } else {
+    req_data->error = kI2cErrOk;
+  }
+}
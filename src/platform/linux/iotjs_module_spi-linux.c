@@ -115,6 +115,46 @@ bool iotjs_spi_transfer(iotjs_spi_t* spi) {
 }
 
 
+// The most transfers of one SPI_IOC_MESSAGE.
+#define SPI_FRAMES_PER_MESSAGE 32
+
+bool iotjs_spi_transfer_frames(iotjs_spi_t* spi, const char* tx, size_t len,
+                               char* rx, uint32_t count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
+
+  struct spi_ioc_transfer data[SPI_FRAMES_PER_MESSAGE];
+  memset(data, 0, sizeof(data));
+
+  for (uint32_t done = 0; done < count;) {
+    uint32_t frames = count - done;
+    if (frames > SPI_FRAMES_PER_MESSAGE) {
+      frames = SPI_FRAMES_PER_MESSAGE;
+    }
+
+    for (uint32_t i = 0; i < frames; ++i) {
+      data[i].tx_buf = (unsigned long)tx;
+      data[i].rx_buf = (unsigned long)(rx + (done + i) * len);
+      data[i].len = len;
+      data[i].speed_hz = _this->max_speed;
+      data[i].bits_per_word = _this->bits_per_word;
+      // Deselects the device between frames. On the last transfer of a
+      // message the flag would keep it selected instead.
+      data[i].cs_change = i + 1 < frames;
+    }
+
+    int err = ioctl(_this->device_fd, SPI_IOC_MESSAGE(frames), data);
+    if (err < 1) {
+      DLOG("%s - transfer failed: %d", __func__, err);
+      return false;
+    }
+
+    done += frames;
+  }
+
+  return true;
+}
+
+
 bool iotjs_spi_close(iotjs_spi_t* spi) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
 
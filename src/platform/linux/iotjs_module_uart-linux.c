@@ -64,6 +64,14 @@ static int baud_to_constant(int baudRate) {
       return B115200;
     case 230400:
       return B230400;
+#ifdef B460800
+    case 460800:
+      return B460800;
+#endif
+#ifdef B921600
+    case 921600:
+      return B921600;
+#endif
   }
   return -1;
 }
@@ -103,16 +111,20 @@ void iotjs_uart_open_worker(uv_work_t* work_req) {
   options.c_iflag = IGNPAR;
   options.c_oflag = 0;
   options.c_lflag = 0;
+  options.c_cc[VMIN] = 1;
+  options.c_cc[VTIME] = 0;
   tcflush(fd, TCIFLUSH);
   tcsetattr(fd, TCSANOW, &options);
 
   _this->device_fd = fd;
+  _this->read_min = 1;
   uv_poll_t* poll_handle = &_this->poll_handle;
 
   uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());
   uv_poll_init(loop, poll_handle, fd);
   poll_handle->data = uart;
-  uv_poll_start(poll_handle, UV_READABLE, iotjs_uart_read_cb);
+  uv_poll_start(poll_handle, UV_READABLE, iotjs_uart_poll_cb);
+  _this->poll_events = UV_READABLE;
 
   req_data->result = true;
 }
@@ -151,4 +163,28 @@ bool iotjs_uart_write(iotjs_uart_t* uart) {
 }
 
 
+// In non-canonical mode without VTIME, the tty reports the device readable
+// once VMIN bytes are received, so a fixed length frame takes one wakeup.
+void iotjs_uart_set_read_min(iotjs_uart_t* uart, size_t min) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_uart_t, uart);
+
+  if (min > UINT8_MAX) {
+    min = UINT8_MAX;
+  }
+  if (min == _this->read_min) {
+    return;
+  }
+
+  struct termios options;
+  if (tcgetattr(_this->device_fd, &options) < 0) {
+    return;
+  }
+  options.c_cc[VMIN] = (cc_t)min;
+  options.c_cc[VTIME] = 0;
+  if (tcsetattr(_this->device_fd, TCSANOW, &options) == 0) {
+    _this->read_min = min;
+  }
+}
+
+
 #endif /* IOTJS_MODULE_UART_LINUX_GENERAL_INL_H */
@@ -33,7 +33,7 @@ void iotjs_blehcisocket_close(THIS) {
 }
 
 
-void iotjs_blehcisocket_start(THIS) {
+void iotjs_blehcisocket_start(THIS, bool decode) {
   IOTJS_ASSERT(!"Not implemented");
 }
 
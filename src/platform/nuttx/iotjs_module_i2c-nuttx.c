@@ -83,9 +83,7 @@ void I2cClose(iotjs_i2c_t* i2c) {
   iotjs_i2c_unconfig_nuttx(platform_data->i2c_master);
 }
 
-void WriteWorker(uv_work_t* work_req) {
-  I2C_WORKER_INIT_TEMPLATE;
-  iotjs_i2c_t* i2c = iotjs_i2c_instance_from_reqwrap(req_wrap);
+void I2cWrite(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
   IOTJS_I2C_METHOD_HEADER(i2c);
 
   uint8_t len = req_data->buf_len;
@@ -97,7 +95,7 @@ void WriteWorker(uv_work_t* work_req) {
   int ret =
       i2c_write(platform_data->i2c_master, &platform_data->config, data, len);
   if (ret < 0) {
-    DLOG("I2C WriteWorker : cannot write - %d", ret);
+    DLOG("I2C Write : cannot write - %d", ret);
     req_data->error = kI2cErrWrite;
   } else {
     req_data->error = kI2cErrOk;
@@ -108,9 +106,7 @@ void WriteWorker(uv_work_t* work_req) {
   }
 }
 
-void ReadWorker(uv_work_t* work_req) {
-  I2C_WORKER_INIT_TEMPLATE;
-  iotjs_i2c_t* i2c = iotjs_i2c_instance_from_reqwrap(req_wrap);
+void I2cRead(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
   IOTJS_I2C_METHOD_HEADER(i2c);
 
   uint8_t len = req_data->buf_len;
@@ -122,9 +118,33 @@ void ReadWorker(uv_work_t* work_req) {
   int ret = i2c_read(platform_data->i2c_master, &platform_data->config,
                      (uint8_t*)req_data->buf_data, len);
   if (ret != 0) {
-    DLOG("I2C ReadWorker : cannot read - %d", ret);
+    DLOG("I2C Read : cannot read - %d", ret);
     req_data->error = kI2cErrRead;
     return;
   }
   req_data->error = kI2cErrOk;
 }
+
+void I2cTransfer(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
+  IOTJS_I2C_METHOD_HEADER(i2c);
+
+  IOTJS_ASSERT(platform_data->i2c_master);
+
+  struct i2c_msg_s msgs[IOTJS_I2C_TRANSFER_MSGS_MAX];
+  for (uint8_t i = 0; i < req_data->msg_count; ++i) {
+    iotjs_i2c_msg_t* msg = &req_data->msgs[i];
+    msgs[i].frequency = platform_data->config.frequency;
+    msgs[i].addr = msg->address;
+    msgs[i].flags = msg->read ? I2C_M_READ : 0;
+    msgs[i].buffer = msg->data;
+    msgs[i].length = msg->length;
+  }
+
+  int ret = I2C_TRANSFER(platform_data->i2c_master, msgs, req_data->msg_count);
+  if (ret < 0) {
+    DLOG("I2C Transfer : cannot transfer - %d", ret);
+    req_data->error = kI2cErrTransfer;
+  } else {
+    req_data->error = kI2cErrOk;
+  }
+}
@@ -48,6 +48,31 @@ bool iotjs_spi_transfer(iotjs_spi_t* spi) {
 }
 
 
+bool iotjs_spi_transfer_frames(iotjs_spi_t* spi, const char* tx, size_t len,
+                               char* rx, uint32_t count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
+
+  struct spi_dev_s* spi_dev = _this->spi_dev;
+
+  SPI_LOCK(spi_dev, true);
+
+  SPI_SETFREQUENCY(spi_dev, _this->max_speed);
+
+  SPI_SETMODE(spi_dev, _this->mode);
+  SPI_SETBITS(spi_dev, _this->bits_per_word);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    iotjs_gpio_write_nuttx(_this->cs_chip, false);
+    SPI_EXCHANGE(spi_dev, tx, rx + i * len, len);
+    iotjs_gpio_write_nuttx(_this->cs_chip, true);
+  }
+
+  SPI_LOCK(spi_dev, false);
+
+  return true;
+}
+
+
 bool iotjs_spi_close(iotjs_spi_t* spi) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
 
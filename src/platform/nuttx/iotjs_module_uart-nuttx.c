@@ -37,7 +37,8 @@ void iotjs_uart_open_worker(uv_work_t* work_req) {
   uv_loop_t* loop = iotjs_environment_loop(iotjs_environment_get());
   uv_poll_init(loop, poll_handle, fd);
   poll_handle->data = uart;
-  uv_poll_start(poll_handle, UV_READABLE, iotjs_uart_read_cb);
+  uv_poll_start(poll_handle, UV_READABLE, iotjs_uart_poll_cb);
+  _this->poll_events = UV_READABLE;
 
   req_data->result = true;
 }
@@ -75,4 +76,8 @@ bool iotjs_uart_write(iotjs_uart_t* uart) {
 }
 
 
+void iotjs_uart_set_read_min(iotjs_uart_t* uart, size_t min) {
+}
+
+
 #endif // __NUTTX__
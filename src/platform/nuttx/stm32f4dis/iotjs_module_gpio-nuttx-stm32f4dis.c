@@ -42,6 +42,27 @@ void iotjs_gpio_platform_destroy(iotjs_gpio_t_impl_t* _this) {
 }
 
 
+// Edges are not detected; the open worker refuses a pin with an edge.
+void iotjs_gpio_edge_start(iotjs_gpio_t* gpio) {
+}
+
+
+void iotjs_gpio_edge_stop(iotjs_gpio_t* gpio) {
+}
+
+
+// A pin has a single line.
+bool iotjs_gpio_write_lines(iotjs_gpio_t* gpio, const uint8_t* values) {
+  return iotjs_gpio_write(gpio, values[0]);
+}
+
+bool iotjs_gpio_read_lines(iotjs_gpio_t* gpio, uint8_t* values) {
+  int value = iotjs_gpio_read(gpio);
+  values[0] = (uint8_t)value;
+  return value >= 0;
+}
+
+
 bool iotjs_gpio_write(iotjs_gpio_t* gpio, bool value) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
 
@@ -74,6 +95,13 @@ void iotjs_gpio_open_worker(uv_work_t* work_req) {
   DDDLOG("%s - pin: %d, dir: %d, mode: %d", __func__, _this->pin,
          _this->direction, _this->mode);
 
+  if (_this->edge != kGpioEdgeNone) {
+    DDLOG("%s - pin: %d, edge detection is not supported", __func__,
+          _this->pin);
+    req_data->result = false;
+    return;
+  }
+
   uint32_t cfgset = 0;
 
   // Set pin direction and mode
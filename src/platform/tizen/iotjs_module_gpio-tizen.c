@@ -24,13 +24,32 @@ struct _iotjs_gpio_module_platform_t {
 
 void iotjs_gpio_platform_create(iotjs_gpio_t_impl_t* _this) {
   size_t private_mem = sizeof(struct _iotjs_gpio_module_platform_t);
-  _this->platform = (iotjs_gpio_module_platform_t)malloc(private_mem);
+  _this->platform =
+      (iotjs_gpio_module_platform_t)iotjs_buffer_allocate(private_mem);
 }
 
 void iotjs_gpio_platform_destroy(iotjs_gpio_t_impl_t* _this) {
   iotjs_buffer_release((char*)_this->platform);
 }
 
+// FIXME: Implement edge detection.
+void iotjs_gpio_edge_start(iotjs_gpio_t* gpio) {
+}
+
+void iotjs_gpio_edge_stop(iotjs_gpio_t* gpio) {
+}
+
+// A pin has a single line.
+bool iotjs_gpio_write_lines(iotjs_gpio_t* gpio, const uint8_t* values) {
+  return iotjs_gpio_write(gpio, values[0]);
+}
+
+bool iotjs_gpio_read_lines(iotjs_gpio_t* gpio, uint8_t* values) {
+  int value = iotjs_gpio_read(gpio);
+  values[0] = (uint8_t)value;
+  return value >= 0;
+}
+
 bool iotjs_gpio_write(iotjs_gpio_t* gpio, bool value) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
   int retVal = peripheral_gpio_write(_this->platform->peripheral_gpio, value);
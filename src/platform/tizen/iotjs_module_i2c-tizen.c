@@ -86,9 +86,7 @@ void I2cClose(iotjs_i2c_t* i2c) {
   }
 }
 
-void WriteWorker(uv_work_t* work_req) {
-  I2C_WORKER_INIT_TEMPLATE;
-  iotjs_i2c_t* i2c = iotjs_i2c_instance_from_reqwrap(req_wrap);
+void I2cWrite(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
   IOTJS_I2C_METHOD_HEADER(i2c);
 
   req_data->error = kI2cErrOk;
@@ -103,9 +101,7 @@ void WriteWorker(uv_work_t* work_req) {
   }
 }
 
-void ReadWorker(uv_work_t* work_req) {
-  I2C_WORKER_INIT_TEMPLATE;
-  iotjs_i2c_t* i2c = iotjs_i2c_instance_from_reqwrap(req_wrap);
+void I2cRead(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
   IOTJS_I2C_METHOD_HEADER(i2c);
 
   uint8_t len = req_data->buf_len;
@@ -118,3 +114,27 @@ void ReadWorker(uv_work_t* work_req) {
     req_data->error = kI2cErrWrite;
   }
 }
+
+// A device handle has a fixed address, so the messages of a transfer are
+// written and read one after another, each with a start condition.
+void I2cTransfer(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
+  IOTJS_I2C_METHOD_HEADER(i2c);
+
+  req_data->error = kI2cErrOk;
+  for (uint8_t i = 0; i < req_data->msg_count; ++i) {
+    iotjs_i2c_msg_t* msg = &req_data->msgs[i];
+    if (msg->address != platform_data->address) {
+      req_data->error = kI2cErrTransfer;
+      return;
+    }
+
+    int ret = msg->read ? peripheral_i2c_read(platform_data->handle,
+                                              msg->data, msg->length)
+                        : peripheral_i2c_write(platform_data->handle,
+                                               msg->data, msg->length);
+    if (ret < 0) {
+      req_data->error = kI2cErrTransfer;
+      return;
+    }
+  }
+}
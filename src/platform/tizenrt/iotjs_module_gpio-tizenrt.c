@@ -26,7 +26,8 @@ struct _iotjs_gpio_module_platform_t {
 
 void iotjs_gpio_platform_create(iotjs_gpio_t_impl_t* _this) {
   size_t private_mem = sizeof(struct _iotjs_gpio_module_platform_t);
-  _this->platform = (iotjs_gpio_module_platform_t)malloc(private_mem);
+  _this->platform =
+      (iotjs_gpio_module_platform_t)iotjs_buffer_allocate(private_mem);
 }
 
 
@@ -35,6 +36,27 @@ void iotjs_gpio_platform_destroy(iotjs_gpio_t_impl_t* _this) {
 }
 
 
+// Edges are not detected; the open worker refuses a pin with an edge.
+void iotjs_gpio_edge_start(iotjs_gpio_t* gpio) {
+}
+
+
+void iotjs_gpio_edge_stop(iotjs_gpio_t* gpio) {
+}
+
+
+// A pin has a single line.
+bool iotjs_gpio_write_lines(iotjs_gpio_t* gpio, const uint8_t* values) {
+  return iotjs_gpio_write(gpio, values[0]);
+}
+
+bool iotjs_gpio_read_lines(iotjs_gpio_t* gpio, uint8_t* values) {
+  int value = iotjs_gpio_read(gpio);
+  values[0] = (uint8_t)value;
+  return value >= 0;
+}
+
+
 void iotjs_gpio_open_worker(uv_work_t* work_req) {
   GPIO_WORKER_INIT;
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_gpio_t, gpio);
@@ -42,6 +64,13 @@ void iotjs_gpio_open_worker(uv_work_t* work_req) {
   DDDLOG("%s - pin: %d, direction: %d, mode: %d", __func__, _this->pin,
          _this->direction, _this->mode);
 
+  if (_this->edge != kGpioEdgeNone) {
+    DDLOG("%s - pin: %d, edge detection is not supported", __func__,
+          _this->pin);
+    req_data->result = false;
+    return;
+  }
+
   iotbus_gpio_context_h gpio_context = iotbus_gpio_open((int)_this->pin);
   if (gpio_context == NULL) {
     req_data->result = false;
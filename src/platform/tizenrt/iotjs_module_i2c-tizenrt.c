@@ -108,9 +108,7 @@ void I2cClose(iotjs_i2c_t* i2c) {
 }
 
 
-void WriteWorker(uv_work_t* work_req) {
-  I2C_WORKER_INIT_TEMPLATE;
-  iotjs_i2c_t* i2c = iotjs_i2c_instance_from_reqwrap(req_wrap);
+void I2cWrite(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_i2c_t, i2c)
   iotjs_i2c_platform_data_t* pdata = _this->platform_data;
 
@@ -132,9 +130,7 @@ void WriteWorker(uv_work_t* work_req) {
 }
 
 
-void ReadWorker(uv_work_t* work_req) {
-  I2C_WORKER_INIT_TEMPLATE;
-  iotjs_i2c_t* i2c = iotjs_i2c_instance_from_reqwrap(req_wrap);
+void I2cRead(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_i2c_t, i2c)
   iotjs_i2c_platform_data_t* pdata = _this->platform_data;
 
@@ -154,3 +150,34 @@ void ReadWorker(uv_work_t* work_req) {
 
   req_data->error = kI2cErrOk;
 }
+
+
+// The messages of a transfer are written and read one after another. The
+// address of the bus is set for each of them, and is left at the last one.
+void I2cTransfer(iotjs_i2c_t* i2c, iotjs_i2c_reqdata_t* req_data) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_i2c_t, i2c)
+  iotjs_i2c_platform_data_t* pdata = _this->platform_data;
+
+  IOTJS_ASSERT(pdata);
+  IOTJS_ASSERT(pdata->i2c_context);
+
+  req_data->error = kI2cErrOk;
+  for (uint8_t i = 0; i < req_data->msg_count; ++i) {
+    iotjs_i2c_msg_t* msg = &req_data->msgs[i];
+    if (iotbus_i2c_set_address(pdata->i2c_context, msg->address) < 0) {
+      DLOG("%s: cannot set address", __func__);
+      req_data->error = kI2cErrTransfer;
+      return;
+    }
+
+    int ret = msg->read
+                  ? iotbus_i2c_read(pdata->i2c_context, msg->data, msg->length)
+                  : iotbus_i2c_write(pdata->i2c_context, msg->data,
+                                     msg->length);
+    if (ret < 0) {
+      DLOG("%s: cannot transfer data", __func__);
+      req_data->error = kI2cErrTransfer;
+      return;
+    }
+  }
+}
@@ -86,6 +86,23 @@ bool iotjs_spi_transfer(iotjs_spi_t* spi) {
 }
 
 
+bool iotjs_spi_transfer_frames(iotjs_spi_t* spi, const char* tx, size_t len,
+                               char* rx, uint32_t count) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    int err = iotbus_spi_transfer_buf(_this->hSpi, (unsigned char*)tx,
+                                      (unsigned char*)rx + i * len, len);
+    if (err != 0) {
+      DDLOG("%s - transfer failed: %d", __func__, err);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
 bool iotjs_spi_close(iotjs_spi_t* spi) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_spi_t, spi);
 
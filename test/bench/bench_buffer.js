@@ -0,0 +1,57 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+
+var text = 'The quick brown fox jumps over the lazy dog. ';
+var source = new Buffer(text + text + text + text);
+
+common.bench('buffer.alloc.small', common.count(20000), function() {
+  new Buffer(64);
+});
+
+common.bench('buffer.alloc.large', common.count(5000), function() {
+  new Buffer(4096);
+});
+
+common.bench('buffer.from.string', common.count(20000), function() {
+  new Buffer(text);
+});
+
+common.bench('buffer.toString', common.count(20000), function() {
+  source.toString();
+});
+
+common.bench('buffer.toString.hex', common.count(5000), function() {
+  source.toString('hex');
+});
+
+common.bench('buffer.slice', common.count(20000), function(i) {
+  source.slice(i % 16, 64);
+});
+
+var target = new Buffer(source.length);
+common.bench('buffer.copy', common.count(20000), function() {
+  source.copy(target, 0);
+});
+
+var parts = [source, source, source, source];
+common.bench('buffer.concat', common.count(5000), function() {
+  Buffer.concat(parts);
+});
+
+common.bench('buffer.readUInt32LE', common.count(50000), function(i) {
+  source.readUInt32LE((i % 32) * 4);
+});
@@ -0,0 +1,77 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+var dgram = require('dgram');
+
+var port = 38103;
+var count = common.count(5000);
+var message = new Buffer(256);
+message.fill(0x62);
+
+// The client sends as fast as the send callbacks allow. The throughput counts
+// the datagrams the server has received, which may be fewer than were sent.
+var server = dgram.createSocket('udp4');
+var client = dgram.createSocket('udp4');
+var received = 0;
+var sent = 0;
+var acked = 0;
+var start;
+var latencies = [];
+var idleTimer = null;
+var finished = false;
+
+function finish() {
+  if (finished) {
+    return;
+  }
+  finished = true;
+  clearTimeout(idleTimer);
+  common.report('dgram.flood', received, Date.now() - start, latencies);
+  client.close();
+  server.close();
+}
+
+server.on('message', function() {
+  if (++received === count) {
+    finish();
+  }
+});
+
+function send() {
+  var sendStart = Date.now();
+  sent++;
+  client.send(message, 0, message.length, port, 'localhost', function(err) {
+    if (err) {
+      throw err;
+    }
+    latencies.push(Date.now() - sendStart);
+    acked++;
+    if (sent < count) {
+      send();
+    } else if (acked === count && !finished) {
+      // The datagrams still to come are given a moment, then taken as lost.
+      idleTimer = setTimeout(finish, 500);
+    }
+  });
+}
+
+server.bind(port, function() {
+  start = Date.now();
+  // A few sends are kept in flight.
+  for (var i = 0; i < Math.min(4, count); i++) {
+    send();
+  }
+});
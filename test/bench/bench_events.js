@@ -0,0 +1,51 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+var EventEmitter = require('events').EventEmitter;
+
+var received = 0;
+function listener() {
+  received++;
+}
+
+var single = new EventEmitter();
+single.on('data', listener);
+
+common.bench('events.emit.noargs', common.count(50000), function() {
+  single.emit('data');
+});
+
+common.bench('events.emit.args', common.count(50000), function(i) {
+  single.emit('data', i, 'payload', true);
+});
+
+var multiple = new EventEmitter();
+for (var i = 0; i < 4; i++) {
+  multiple.on('data', listener);
+}
+
+common.bench('events.emit.listeners', common.count(20000), function(i) {
+  multiple.emit('data', i);
+});
+
+common.bench('events.on.remove', common.count(20000), function() {
+  single.on('other', listener);
+  single.removeListener('other', listener);
+});
+
+common.bench('events.emit.missing', common.count(50000), function() {
+  single.emit('missing');
+});
@@ -0,0 +1,32 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+var fs = require('fs');
+
+var filePath = process.cwd() + '/resources/tobeornottobe.txt';
+
+common.bench('fs.readFileSync', common.count(1000), function() {
+  fs.readFileSync(filePath);
+});
+
+common.benchAsync('fs.readFile', common.count(1000), 4, function(i, done) {
+  fs.readFile(filePath, function(err, data) {
+    if (err) {
+      throw err;
+    }
+    done();
+  });
+});
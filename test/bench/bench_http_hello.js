@@ -0,0 +1,40 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+var http = require('http');
+
+var port = 38102;
+var body = 'Hello, world!';
+
+var server = http.createServer(function(req, res) {
+  res.writeHead(200, {
+    'Content-Type': 'text/plain',
+    'Content-Length': body.length
+  });
+  res.end(body);
+});
+
+server.listen(port, function() {
+  common.benchAsync('http.hello', common.count(500), 4, function(i, done) {
+    var req = http.request({port: port, path: '/'}, function(res) {
+      res.on('data', function() {});
+      res.on('end', done);
+    });
+    req.end();
+  }, function() {
+    server.close();
+  });
+});
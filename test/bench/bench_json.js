@@ -0,0 +1,45 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+
+var object = {
+  id: 1234,
+  name: 'sensor',
+  active: true,
+  location: {latitude: 37.29, longitude: 126.97},
+  tags: ['temperature', 'humidity', 'pressure'],
+  readings: []
+};
+for (var i = 0; i < 32; i++) {
+  object.readings.push({time: 1500000000 + i, value: i * 0.25});
+}
+var text = JSON.stringify(object);
+
+common.bench('json.stringify', common.count(2000), function() {
+  JSON.stringify(object);
+});
+
+common.bench('json.parse', common.count(2000), function() {
+  JSON.parse(text);
+});
+
+common.bench('json.stringify.small', common.count(20000), function(i) {
+  JSON.stringify({id: i, value: 'v' + i});
+});
+
+common.bench('json.parse.small', common.count(20000), function() {
+  JSON.parse('{"id":1,"value":"v1","ok":true}');
+});
@@ -0,0 +1,53 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+var net = require('net');
+
+var port = 38101;
+var message = new Buffer(64);
+message.fill(0x61);
+
+var server = net.createServer(function(socket) {
+  socket.on('data', function(data) {
+    socket.write(data);
+  });
+});
+
+server.listen(port, function() {
+  var client = net.connect(port, 'localhost', function() {
+    var pending = 0;
+    var onEcho = null;
+
+    // An echo may come back in several chunks.
+    client.on('data', function(data) {
+      pending -= data.length;
+      if (pending <= 0 && onEcho) {
+        var callback = onEcho;
+        onEcho = null;
+        callback();
+      }
+    });
+
+    common.benchAsync('net.echo', common.count(2000), 1, function(i, done) {
+      pending = message.length;
+      onEcho = done;
+      client.write(message);
+    }, function() {
+      client.end();
+      server.close();
+    });
+  });
+});
@@ -0,0 +1,51 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+
+var word = 'chunk';
+
+common.bench('string.concat', common.count(200), function() {
+  var s = '';
+  for (var i = 0; i < 100; i++) {
+    s += word + i;
+  }
+});
+
+common.bench('string.join', common.count(200), function() {
+  var parts = [];
+  for (var i = 0; i < 100; i++) {
+    parts.push(word + i);
+  }
+  parts.join('');
+});
+
+var line = 'GET /index.html HTTP/1.1\r\nHost: localhost\r\n\r\n';
+
+common.bench('string.indexOf', common.count(50000), function() {
+  line.indexOf('Host');
+});
+
+common.bench('string.split', common.count(20000), function() {
+  line.split('\r\n');
+});
+
+common.bench('string.replace', common.count(20000), function() {
+  line.replace('localhost', 'example.com');
+});
+
+common.bench('string.number', common.count(50000), function(i) {
+  String(i * 1.5);
+});
@@ -0,0 +1,39 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var common = require(process.cwd() + '/bench/common');
+
+// The latency is the delay of a zero timeout behind its due time.
+common.benchAsync('timers.timeout', common.count(500), 1, function(i, done) {
+  setTimeout(done, 0);
+}, function() {
+  var count = common.count(5000);
+  var fired = 0;
+  var start = Date.now();
+  var latencies = [];
+
+  function fire(due) {
+    latencies.push(Date.now() - due);
+    if (++fired === count) {
+      common.report('timers.many', count, Date.now() - start, latencies);
+    }
+  }
+
+  // Many timers pending at once, with a few distinct timeouts.
+  for (var i = 0; i < count; i++) {
+    var timeout = i % 10;
+    setTimeout(fire, timeout, start + timeout);
+  }
+});
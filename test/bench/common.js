@@ -0,0 +1,126 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Harness of the benchmarks run by tools/benchrunner.py. Each benchmark
+// prints one line of JSON after the `BENCH ` prefix:
+//   {"name", "ops", "time", "opsPerSec",
+//    "latency": {"p50", "p90", "p99", "max"}, "peakHeap"}
+// with the times in milliseconds. The counts of the operations are scaled by
+// the IOTJS_BENCH_SCALE environment variable.
+
+var performance = require('perf_hooks').performance;
+
+var SYNC_BATCHES = 20;
+
+var scale = Number(process.env.IOTJS_BENCH_SCALE) || 1;
+
+
+exports.count = function(count) {
+  return Math.max(1, Math.round(count * scale));
+};
+
+
+function percentile(sorted, percent) {
+  if (sorted.length === 0) {
+    return 0;
+  }
+  var index = Math.ceil(sorted.length * percent / 100) - 1;
+  return sorted[Math.max(0, index)];
+}
+
+
+function peakHeap() {
+  var usage = process.memoryUsage();
+  return usage.jsHeapPeak !== undefined ? usage.jsHeapPeak : usage.heapUsed;
+}
+
+
+function report(name, ops, time, latencies) {
+  latencies.sort(function(a, b) { return a - b; });
+
+  var result = {
+    name: name,
+    ops: ops,
+    time: time,
+    opsPerSec: time > 0 ? Math.round(ops * 1000 / time) : 0,
+    latency: {
+      p50: percentile(latencies, 50),
+      p90: percentile(latencies, 90),
+      p99: percentile(latencies, 99),
+      max: percentile(latencies, 100)
+    },
+    peakHeap: peakHeap()
+  };
+  console.log('BENCH ' + JSON.stringify(result));
+  return result;
+}
+
+
+// Calls fn(i) `count` times in batches. The latency of an operation is taken
+// as the mean of its batch, as timing each call would cost more than most
+// calls do.
+exports.bench = function(name, count, fn) {
+  var batch = Math.max(1, Math.ceil(count / SYNC_BATCHES));
+  var latencies = [];
+  var start = performance.now();
+
+  for (var done = 0; done < count;) {
+    var end = Math.min(count, done + batch);
+    var batchStart = performance.now();
+    for (var i = done; i < end; i++) {
+      fn(i);
+    }
+    latencies.push((performance.now() - batchStart) / (end - done));
+    done = end;
+  }
+
+  return report(name, count, performance.now() - start, latencies);
+};
+
+
+// Runs `count` operations, `concurrency` of them at once. fn(i, done) starts
+// the operation `i`, which calls done() as it completes. callback(result) is
+// called after the last one.
+exports.benchAsync = function(name, count, concurrency, fn, callback) {
+  var latencies = [];
+  var started = 0;
+  var completed = 0;
+  var start = performance.now();
+
+  function next() {
+    var i = started++;
+    var opStart = performance.now();
+    fn(i, function() {
+      latencies.push(performance.now() - opStart);
+      completed++;
+      if (started < count) {
+        next();
+      } else if (completed === count) {
+        var result = report(name, count, performance.now() - start, latencies);
+        if (callback) {
+          callback(result);
+        }
+      }
+    });
+  }
+
+  for (var i = 0; i < Math.min(concurrency, count); i++) {
+    next();
+  }
+};
+
+
+// Reports a benchmark measured by itself, such as a flood of datagrams.
+exports.report = report;
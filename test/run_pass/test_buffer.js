@@ -115,6 +115,34 @@ assert.equal(buff9.slice(-2).toString(), 'cd');
 assert.equal(buff9.slice(-3, -2).toString(), 'b');
 assert.equal(buff9.slice(0, -2).toString(), 'abcabcab');
 
+// A slice shares the memory of the buffer, and keeps it alive.
+var sliceBase = new Buffer('0123456789');
+var slice1 = sliceBase.slice(2, 8);
+var slice2 = slice1.slice(1, 3);
+slice1.write('ab', 1);
+assert.equal(sliceBase.toString(), '012ab56789');
+assert.equal(slice2.toString(), 'ab');
+sliceBase.writeUInt8(0x43, 4);
+assert.equal(slice2.toString(), 'aC');
+assert.equal(sliceBase.slice(5, 5).length, 0);
+sliceBase = undefined;
+slice1 = undefined;
+process.nextTick(function() {
+  assert.equal(slice2.toString(), 'aC');
+});
+
+var bigBase = new Buffer(4096);
+bigBase.fill(0x61);
+var bigSlice = bigBase.slice(4000);
+bigSlice.writeUInt8(0x62, 95);
+assert.equal(bigBase.readUInt8(4095), 0x62);
+assert.equal(bigSlice.length, 96);
+bigBase = undefined;
+process.nextTick(function() {
+  assert.equal(bigSlice.readUInt8(0), 0x61);
+  assert.equal(bigSlice.readUInt8(95), 0x62);
+});
+
 
 assert.equal(Buffer.isBuffer(buff9), true);
 assert.equal(Buffer.isBuffer(1), false);
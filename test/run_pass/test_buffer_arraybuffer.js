@@ -0,0 +1,74 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var assert = require('assert');
+
+
+if (typeof ArrayBuffer === 'undefined') {
+  // The engine is built without typed arrays.
+  assert.equal(new Buffer(4).buffer, undefined);
+  assert.equal(new Buffer(4).byteOffset, 0);
+} else {
+  // Typed arrays view the memory of a buffer without copying.
+  var buff1 = new Buffer('abcd');
+  var bytes = new Uint8Array(buff1.buffer, buff1.byteOffset, buff1.length);
+  assert.equal(buff1.buffer, buff1.buffer);
+  assert.equal(bytes[0], 0x61);
+  bytes[1] = 0x42;
+  assert.equal(buff1.toString(), 'aBcd');
+  buff1.writeUInt8(0x43, 2);
+  assert.equal(bytes[2], 0x43);
+
+  // A buffer over an ArrayBuffer shares its memory.
+  var arrayBuffer = new ArrayBuffer(8);
+  var words = new Uint16Array(arrayBuffer);
+  var buff2 = new Buffer(arrayBuffer, 2, 4);
+  assert.equal(buff2.length, 4);
+  assert.equal(buff2.buffer, arrayBuffer);
+  assert.equal(buff2.byteOffset, 2);
+  buff2.writeUInt16LE(0x1234, 0);
+  assert.equal(words[1], 0x1234);
+  words[2] = 0x4142;
+  assert.equal(buff2.toString('hex'), '34124241');
+
+  var buff3 = Buffer(arrayBuffer);
+  assert.equal(buff3.length, 8);
+  assert.equal(buff3.readUInt8(2), 0x34);
+  assert.equal(new Buffer(arrayBuffer, 8).length, 0);
+
+  assert.throws(function() { new Buffer(arrayBuffer, 9); }, RangeError);
+  assert.throws(function() { new Buffer(arrayBuffer, 4, 5); }, RangeError);
+
+  // A slice shares the ArrayBuffer of its buffer, before or after it is
+  // taken.
+  var buff5 = new Buffer(2048);
+  var buff6 = buff5.slice(100, 200);
+  assert.equal(buff6.buffer, buff5.buffer);
+  assert.equal(buff6.byteOffset, buff5.byteOffset + 100);
+  var buff7 = buff6.slice(10);
+  assert.equal(buff7.buffer, buff5.buffer);
+  assert.equal(buff7.byteOffset, buff5.byteOffset + 110);
+  new Uint8Array(buff7.buffer, buff7.byteOffset, 1)[0] = 0x7a;
+  assert.equal(buff5.readUInt8(110), 0x7a);
+
+  // The memory outlives the buffer as long as a view refers to it.
+  var buff4 = new Buffer('xyz');
+  var view = new Uint8Array(buff4.buffer, buff4.byteOffset, buff4.length);
+  buff4 = undefined;
+  process.nextTick(function() {
+    assert.equal(String.fromCharCode(view[0], view[1], view[2]), 'xyz');
+  });
+}
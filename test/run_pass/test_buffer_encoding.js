@@ -0,0 +1,135 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var assert = require('assert');
+
+
+// base64
+assert.equal(new Buffer('').toString('base64'), '');
+assert.equal(new Buffer('f').toString('base64'), 'Zg==');
+assert.equal(new Buffer('fo').toString('base64'), 'Zm8=');
+assert.equal(new Buffer('foo').toString('base64'), 'Zm9v');
+assert.equal(new Buffer('foobar').toString('base64'), 'Zm9vYmFy');
+
+assert.equal(Buffer.byteLength('Zm9vYmFy', 'base64'), 6);
+assert.equal(Buffer.byteLength('Zm9vYg==', 'base64'), 4);
+assert.equal(Buffer.byteLength('Zm9vYg', 'base64'), 4);
+assert.equal(new Buffer('Zm9vYmFy', 'base64').toString(), 'foobar');
+assert.equal(new Buffer('Zm9vYg==', 'base64').toString(), 'foob');
+assert.equal(new Buffer('Zm9vYg', 'base64').toString(), 'foob');
+assert.equal(new Buffer('Zm9v\nYmFy\r\n', 'base64').toString(), 'foobar');
+assert.equal(new Buffer('Zm 9v Ym Fy', 'base64').toString(), 'foobar');
+
+// The URL safe alphabet.
+assert.equal(new Buffer('-_8', 'base64').toString('hex'), 'fbff');
+assert.equal(new Buffer('+/8', 'base64').toString('hex'), 'fbff');
+
+var bytes = new Buffer(256);
+for (var i = 0; i < 256; ++i) {
+  bytes.writeUInt8(i, i);
+}
+for (var length = 0; length < 20; ++length) {
+  var part = bytes.slice(100, 100 + length);
+  var text = part.toString('base64');
+  assert.equal(text.length, Math.ceil(length / 3) * 4);
+  assert(new Buffer(text, 'base64').equals(part));
+}
+assert(new Buffer(bytes.toString('base64'), 'base64').equals(bytes));
+
+
+// hex
+assert.equal(bytes.toString('hex').length, 512);
+assert(new Buffer(bytes.toString('hex'), 'hex').equals(bytes));
+assert.equal(new Buffer('DEFG').toString('hex', 1, 3), '4546');
+assert.equal(new Buffer('DEFG').toString('base64', 1), 'RUZH');
+assert.equal(new Buffer('DEFG').toString('utf8', 1, 3), 'EF');
+
+
+// compare and copy
+assert.equal(new Buffer('abc').compare(new Buffer('abd')), -1);
+assert.equal(new Buffer('abd').compare(new Buffer('abc')), 1);
+assert.equal(new Buffer('ab').compare(new Buffer('abc')), -1);
+assert.equal(new Buffer('abc').compare(new Buffer('ab')), 1);
+assert.equal(new Buffer('abc').compare(new Buffer('abc')), 0);
+assert.equal(new Buffer([0x80]).compare(new Buffer([0x7f])), 1);
+
+// The source and the target may overlap.
+var overlap = new Buffer('abcdef');
+overlap.copy(overlap.slice(1), 0, 0, 4);
+assert.equal(overlap.toString(), 'aabcdf');
+
+
+// fill
+var filled = new Buffer(10);
+filled.fill(0x61);
+assert.equal(filled.toString(), 'aaaaaaaaaa');
+filled.fill(0x62, 2, 4);
+assert.equal(filled.toString(), 'aabbaaaaaa');
+filled.fill('xyz', 3);
+assert.equal(filled.toString(), 'aabxyzxyzx');
+filled.fill(new Buffer('01'));
+assert.equal(filled.toString(), '0101010101');
+filled.fill('');
+assert.equal(filled.toString(), '0101010101');
+assert.equal(filled.fill(0x63, 8, 100).toString(), '01010101cc');
+
+
+// indexOf and includes
+var haystack = new Buffer('this is a buffer');
+assert.equal(haystack.indexOf('is'), 2);
+assert.equal(haystack.indexOf('is', 3), 5);
+assert.equal(haystack.indexOf('is', -11), 5);
+assert.equal(haystack.indexOf(0x61), 8);
+assert.equal(haystack.indexOf(0x61 + 256), 8);
+assert.equal(haystack.indexOf(new Buffer('buffer')), 10);
+assert.equal(haystack.indexOf('buffers'), -1);
+assert.equal(haystack.indexOf('r', 15), 15);
+assert.equal(haystack.indexOf('r', 16), -1);
+assert.equal(haystack.indexOf(''), 0);
+assert.equal(haystack.indexOf('', 4), 4);
+assert.equal(haystack.slice(5).indexOf('is'), 0);
+assert.equal(new Buffer(0).indexOf('a'), -1);
+assert(haystack.includes('a buf'));
+assert(!haystack.includes('a buf', 9));
+assert.throws(function() { haystack.indexOf({}); }, TypeError);
+
+
+// Strings the engine makes up on demand, joins lazily or holds in full
+var numberString = String(1234567);
+assert.equal(Buffer.byteLength(numberString), 7);
+assert.equal(new Buffer(numberString).toString(), '1234567');
+assert.equal(new Buffer(numberString, 'hex').toString('hex'), '123456');
+
+var joined = 'abcdefghij';
+for (var j = 0; j < 4; ++j) {
+  joined += joined;
+}
+assert.equal(Buffer.byteLength(joined + 'é'), 162);
+assert.equal(new Buffer(joined + 'é').toString(), joined + 'é');
+assert.equal(new Buffer(new Buffer(joined).toString('base64'), 'base64')
+               .toString(), joined);
+
+// Long texts are kept off the engine heap
+var longBuffer = new Buffer(joined + joined + joined);
+var longText = longBuffer.toString();
+assert.equal(longText, joined + joined + joined);
+assert.equal(longText.length, 480);
+assert.equal(longText.slice(10, 20), 'abcdefghij');
+assert.equal(longBuffer.toString('hex').length, 960);
+assert.equal(new Buffer(longBuffer.toString('hex'), 'hex').toString(),
+             longText);
+assert.equal(new Buffer(longBuffer.toString('base64'), 'base64').toString(),
+             longText);
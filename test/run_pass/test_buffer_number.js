@@ -0,0 +1,126 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+var assert = require('assert');
+
+
+// Each typed writer writes the bytes of its type, and its reader reads them.
+var cases = [
+  ['Int8', -2, 'fe'],
+  ['UInt8', 0xc8, 'c8'],
+  ['Int16LE', -2, 'feff'],
+  ['Int16BE', -2, 'fffe'],
+  ['UInt16LE', 0x1234, '3412'],
+  ['UInt16BE', 0x1234, '1234'],
+  ['Int32LE', -123456789, 'eb32a4f8'],
+  ['Int32BE', -123456789, 'f8a432eb'],
+  ['UInt32LE', 0x89abcdef, 'efcdab89'],
+  ['UInt32BE', 0x89abcdef, '89abcdef'],
+  ['FloatLE', 1.5, '0000c03f'],
+  ['FloatBE', -2.25, 'c0100000'],
+  ['DoubleLE', 1.1, '9a9999999999f13f'],
+  ['DoubleBE', -0.5, 'bfe0000000000000']
+];
+
+cases.forEach(function(c) {
+  var size = c[2].length / 2;
+  var buff = new Buffer(size + 2);
+  buff.fill(0);
+  assert.equal(buff['write' + c[0]](c[1], 1), size + 1);
+  assert.equal(buff.toString('hex'), '00' + c[2] + '00');
+  assert.equal(buff['read' + c[0]](1), c[1]);
+  assert.equal(new Buffer('00' + c[2], 'hex')['read' + c[0]](1), c[1]);
+});
+
+var buff = new Buffer(8);
+assert.equal(buff.writeInt32BE(-1, 0), 4);
+assert.equal(buff.readUInt32BE(0), 0xffffffff);
+assert.equal(buff.readInt16LE(2), -1);
+buff.writeFloatLE(0.1, 0);
+assert.notEqual(buff.readFloatLE(0), 0.1);
+assert(Math.abs(buff.readFloatLE(0) - 0.1) < 1e-7);
+buff.writeDoubleBE(NaN, 0);
+assert(isNaN(buff.readDoubleBE(0)));
+buff.writeFloatBE(Infinity, 0);
+assert.equal(buff.readFloatBE(0), Infinity);
+
+// The values and the offsets are checked, unless noAssert is given.
+assert.throws(function() { buff.writeInt8(128, 0); }, TypeError);
+assert.throws(function() { buff.writeInt16BE(-32769, 0); }, TypeError);
+assert.throws(function() { buff.writeUInt32LE(-1, 0); }, TypeError);
+assert.throws(function() { buff.writeInt32LE(0, 5); }, RangeError);
+assert.throws(function() { buff.writeDoubleLE(0, 1); }, RangeError);
+assert.throws(function() { buff.readInt32BE(5); }, RangeError);
+assert.throws(function() { buff.readDoubleBE(-1); }, RangeError);
+
+buff.fill(0);
+assert.equal(buff.writeUInt8(0x1ff, 0, true), 1);
+assert.equal(buff.readUInt8(0), 0xff);
+assert.equal(buff.writeInt16LE(-1, 7, true), 9);
+assert.equal(buff.readUInt8(7), 0);
+assert.equal(buff.readUInt16LE(7, true), 0);
+assert.equal(buff.readUInt32BE(100, true), 0);
+
+
+// readArray() reads a frame of numbers in one call.
+var frame = new Buffer('0001ff00fffe8000', 'hex');
+assert.equal(JSON.stringify(frame.readArray('Int16BE', 0, 4)),
+             JSON.stringify([1, -256, -2, -32768]));
+assert.equal(JSON.stringify(frame.readArray('UInt8', 6, 2)),
+             JSON.stringify([0x80, 0]));
+assert.equal(frame.readArray('UInt16LE', 8, 0).length, 0);
+
+var target = [9, 9, 9];
+assert.equal(frame.readArray('UInt16BE', 2, 2, target), target);
+assert.equal(JSON.stringify(target), JSON.stringify([0xff00, 0xfffe, 9]));
+
+if (typeof Float32Array === 'function') {
+  var floats = new Float32Array(2);
+  var samples = new Buffer(8);
+  samples.writeFloatLE(1.5, 0);
+  samples.writeFloatLE(-3, 4);
+  assert.equal(samples.readArray('FloatLE', 0, 2, floats), floats);
+  assert.equal(floats[0], 1.5);
+  assert.equal(floats[1], -3);
+}
+
+assert.throws(function() { frame.readArray('Int32BE', 4, 2); }, RangeError);
+assert.throws(function() { frame.readArray('Int64', 0, 1); }, TypeError);
+assert.throws(function() { frame.readArray('UInt8', 0, 1, 0); }, TypeError);
+
+
+// writeArray() writes the numbers of an array.
+var out = new Buffer(6);
+out.fill(0);
+assert.equal(out.writeArray('Int16BE', [1, -2, 0x7fff], 0), 6);
+assert.equal(out.toString('hex'), '0001fffe7fff');
+assert.equal(out.writeArray('UInt8', [0xaa], 5), 6);
+assert.equal(out.toString('hex'), '0001fffe7faa');
+
+assert.throws(function() { out.writeArray('Int8', [1, 200], 0); }, TypeError);
+assert.throws(function() { out.writeArray('UInt16LE', [1, 2], 4); },
+              RangeError);
+assert.throws(function() { out.writeArray('UInt8', 1, 0); }, TypeError);
+
+// With noAssert, only the numbers which fit are written.
+out.fill(0);
+assert.equal(out.writeArray('UInt16LE', [0x0102, 0x0304], 4, true), 6);
+assert.equal(out.toString('hex'), '000000000201');
+
+
+// An array given to Buffer() is written with the low byte of each number.
+assert.equal(new Buffer([1, 0x102, -1]).toString('hex'), '0102ff');
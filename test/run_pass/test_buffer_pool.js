@@ -0,0 +1,75 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+var assert = require('assert');
+
+
+// Small buffers are carved out of shared slabs, yet each one has its own
+// zero-filled memory. A few hundred of them fill several slabs, and fit in
+// the default JS heap.
+var buffers = [];
+for (var i = 0; i < 300; i++) {
+  var size = i % 129;
+  var buff = new Buffer(size);
+  for (var j = 0; j < size; j++) {
+    assert.equal(buff.readUInt8(j), 0);
+  }
+  buff.fill(i & 255);
+  buffers.push(buff);
+}
+
+for (var i = 0; i < buffers.length; i++) {
+  var buff = buffers[i];
+  assert.equal(buff.length, i % 129);
+  for (var j = 0; j < buff.length; j++) {
+    assert.equal(buff.readUInt8(j), i & 255);
+  }
+}
+
+// Memory given back to a slab is zero-filled again when it is reused.
+buffers = undefined;
+for (var i = 0; i < 1000; i++) {
+  var buff = new Buffer(100);
+  assert.equal(buff.toString('hex'), new Array(201).join('0'));
+  buff.fill(0xff);
+}
+
+// Slices of pooled buffers share their memory, copies do not.
+var small = new Buffer('pooled');
+var slice = small.slice(1, 4);
+var copy = new Buffer(slice);
+slice.write('OOL');
+assert.equal(small.toString(), 'pOOLed');
+assert.equal(copy.toString(), 'ool');
+
+// Buffers above the pool threshold work the same.
+var large = new Buffer(4096);
+large.fill(0x61);
+assert.equal(large.toString().length, 4096);
+assert.equal(large.readUInt8(4095), 0x61);
+
+// The ArrayBuffer of a pooled buffer is its slab, like in node.js.
+if (typeof ArrayBuffer !== 'undefined') {
+  var neighbour = new Buffer('before');
+  var viewed = new Buffer('viewed');
+  assert.equal(viewed.buffer, viewed.buffer);
+  assert(viewed.byteOffset + viewed.length <= viewed.buffer.byteLength);
+  var bytes = new Uint8Array(viewed.buffer, viewed.byteOffset, viewed.length);
+  bytes[0] = 0x56;
+  assert.equal(viewed.toString(), 'Viewed');
+  assert.equal(neighbour.toString(), 'before');
+}
@@ -0,0 +1,66 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+var cluster = require('cluster');
+var http = require('http');
+
+if (cluster.isMaster) {
+  var forked = [];
+  var exits = {};
+
+  cluster.on('fork', function(worker) {
+    forked.push(worker.id);
+  });
+
+  cluster.on('exit', function(worker, code, signal) {
+    assert.equal(worker.isDead(), true);
+    assert.equal(cluster.workers[worker.id], undefined);
+    exits[worker.id] = [code, signal];
+  });
+
+  // Two workers listen on the same port at the same time.
+  cluster.fork();
+  cluster.fork();
+
+  // The third one never finishes by itself.
+  var worker = cluster.fork();
+  assert.notEqual(worker.process.pid, 0);
+  worker.kill('SIGTERM');
+
+  process.on('exit', function() {
+    assert.equal(JSON.stringify(forked), JSON.stringify([1, 2, 3]));
+    assert.equal(JSON.stringify(exits[1]), JSON.stringify([0, null]));
+    assert.equal(JSON.stringify(exits[2]), JSON.stringify([0, null]));
+    assert.equal(JSON.stringify(exits[3]), JSON.stringify([null, 'SIGTERM']));
+  });
+} else {
+  assert.equal(cluster.isWorker, true);
+
+  if (cluster.worker.id == 3) {
+    setTimeout(function() {}, 10000);
+  } else {
+    var server = http.createServer(function(req, res) {
+      res.end('worker ' + cluster.worker.id);
+    });
+    server.on('error', function(err) {
+      process.exit(1);
+    });
+    server.listen(3089, function() {
+      setTimeout(function() {
+        server.close();
+      }, 300);
+    });
+  }
+}
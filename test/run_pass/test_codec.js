@@ -0,0 +1,128 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var codec = require('codec');
+
+function hex(buffer) {
+  return buffer.toString('hex');
+}
+
+function roundTrip(format, value) {
+  return format.decode(format.encode(value));
+}
+
+// Vectors of RFC 7049 and of the MessagePack specification.
+assert.equal(hex(codec.cbor.encode(0)), '00');
+assert.equal(hex(codec.cbor.encode(24)), '1818');
+assert.equal(hex(codec.cbor.encode(1000000)), '1a000f4240');
+assert.equal(hex(codec.cbor.encode(-1000)), '3903e7');
+assert.equal(hex(codec.cbor.encode(1.5)), 'fa3fc00000');
+assert.equal(hex(codec.cbor.encode(1.1)), 'fb3ff199999999999a');
+assert.equal(hex(codec.cbor.encode('IETF')), '6449455446');
+assert.equal(hex(codec.cbor.encode('\u00fc')), '62c3bc');
+assert.equal(hex(codec.cbor.encode('\ud800\udd51')), '64f0908591');
+assert.equal(hex(codec.cbor.encode([1, [2, 3]])), '8201820203');
+assert.equal(hex(codec.cbor.encode({ a: 1, b: [2, 3] })),
+             'a26161016162820203');
+assert.equal(hex(codec.cbor.encode([false, true, null, undefined])),
+             '84f4f5f6f7');
+
+assert.equal(hex(codec.msgpack.encode(127)), '7f');
+assert.equal(hex(codec.msgpack.encode(256)), 'cd0100');
+assert.equal(hex(codec.msgpack.encode(-33)), 'd0df');
+assert.equal(hex(codec.msgpack.encode('a')), 'a161');
+assert.equal(hex(codec.msgpack.encode({ a: 1, b: [2, 3] })),
+             '82a16101a162920203');
+assert.equal(hex(codec.msgpack.encode([null, true])), '92c0c3');
+
+assert.equal(codec.cbor.decode(new Buffer('f93c00', 'hex')), 1);
+assert.equal(codec.cbor.decode(new Buffer('9f0102ff', 'hex')).length, 2);
+assert.equal(codec.cbor.decode(new Buffer('c11834', 'hex')), 52);
+
+var telemetry = {
+  id: 'sensor-12',
+  seq: 4294967296,
+  temperature: -12.25,
+  humidity: 0.1,
+  ok: true,
+  samples: [1, -1, 300, -70000],
+  raw: new Buffer([1, 2, 3]),
+  note: 'caf\u00e9 \ud83d\ude00',
+  nested: { empty: {}, list: [] },
+};
+
+[codec.cbor, codec.msgpack].forEach(function(format) {
+  var decoded = roundTrip(format, telemetry);
+  assert.equal(decoded.id, telemetry.id);
+  assert.equal(decoded.seq, telemetry.seq);
+  assert.equal(decoded.temperature, telemetry.temperature);
+  assert.equal(decoded.humidity, telemetry.humidity);
+  assert.equal(decoded.ok, true);
+  assert.equal(JSON.stringify(decoded.samples),
+               JSON.stringify(telemetry.samples));
+  assert(Buffer.isBuffer(decoded.raw));
+  assert.equal(decoded.raw.compare(telemetry.raw), 0);
+  assert.equal(decoded.note, telemetry.note);
+  assert.equal(Object.keys(decoded.nested.empty).length, 0);
+  assert.equal(decoded.nested.list.length, 0);
+
+  // JSON has no bytes, so it is compared without them.
+  var json = JSON.stringify(telemetry, function(key, value) {
+    return Buffer.isBuffer(value) ? undefined : value;
+  });
+  assert(format.encode(telemetry).length < new Buffer(json).length);
+
+  // Into a preallocated buffer.
+  var target = new Buffer(64);
+  var length = format.encode([1, 'two'], target, 10);
+  assert.equal(length, 6);
+  assert.equal(JSON.stringify(format.decode(target, 10, 10 + length)),
+               '[1,"two"]');
+
+  assert.throws(function() {
+    format.encode(telemetry, new Buffer(4));
+  }, RangeError);
+  assert.throws(function() {
+    format.encode(1, target, 65);
+  }, RangeError);
+
+  // Values in a row.
+  var row = Buffer.concat([format.encode(1), format.encode('a'),
+                           format.encode([])]);
+  var all = format.decodeAll(row);
+  assert.equal(all.length, 3);
+  assert.equal(all[1], 'a');
+  assert.throws(function() {
+    format.decode(row);
+  }, RangeError);
+
+  assert.throws(function() {
+    format.decode(new Buffer([0x92, 0x01]));
+  }, RangeError);
+  assert.throws(function() {
+    format.decode('not a buffer');
+  }, TypeError);
+
+  var cyclic = {};
+  cyclic.self = cyclic;
+  assert.throws(function() {
+    format.encode(cyclic);
+  }, RangeError);
+
+  assert(isNaN(roundTrip(format, NaN)));
+  assert.equal(roundTrip(format, Infinity), Infinity);
+  assert.equal(1 / roundTrip(format, -0), -Infinity);
+});
@@ -0,0 +1,101 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var codec = require('codec');
+
+var series = new codec.TimeSeries({ blockLength: 100 });
+var times = [];
+var values = [];
+
+// Readings of a sensor every second, with some jitter, and a gap.
+var time = 1500000000000;
+for (var i = 0; i < 1000; i++) {
+  time += i == 500 ? 3600000 : 1000 + (i % 3) - 1;
+  var value = i % 10 == 0 ? NaN : 20 + Math.round(Math.sin(i / 50) * 40) / 4;
+  times.push(time);
+  values.push(value);
+  series.append(time, value);
+}
+
+function checkPoints(first, pointTimes, pointValues) {
+  for (var i = 0; i < pointTimes.length; i++) {
+    assert.equal(pointTimes[i], times[first + i]);
+    if (isNaN(values[first + i])) {
+      assert(isNaN(pointValues[i]));
+    } else {
+      assert.equal(pointValues[i], values[first + i]);
+    }
+  }
+}
+
+assert.equal(series.length, 1000);
+assert.equal(series.blockCount, 10);
+// Less than half of the 16 bytes of each point. Every NaN costs two XORs
+// of nearly all the bits.
+assert(series.byteLength < 1000 * 16 / 2);
+
+for (var b = 0; b < series.blockCount; b++) {
+  var block = series.readBlock(b);
+  assert.equal(block.times.length, 100);
+  assert.equal(series.blockStart(b), times[b * 100]);
+  checkPoints(b * 100, block.times, block.values);
+}
+
+assert.equal(series.findBlock(times[0] - 1), -1);
+assert.equal(series.findBlock(times[0]), 0);
+assert.equal(series.findBlock(times[550]), 5);
+assert.equal(series.findBlock(times[999] + 1e9), 9);
+
+// Decoding into given arrays.
+var blockTimes = [];
+var blockValues = [];
+assert.equal(series.readBlock(3, blockTimes, blockValues), 100);
+checkPoints(300, blockTimes, blockValues);
+
+// The last block takes points until it is full.
+series.append(time + 1000, -0);
+times.push(time + 1000);
+values.push(-0);
+assert.equal(series.blockCount, 11);
+assert.equal(1 / series.readBlock(10).values[0], -Infinity);
+
+// Saved and loaded, the blocks are the same, and new points start a block.
+var saved = series.toBuffer(0, 10);
+var loaded = codec.TimeSeries.from(saved);
+assert.equal(loaded.length, 1000);
+assert.equal(loaded.byteLength, saved.length);
+checkPoints(700, loaded.readBlock(7).times, loaded.readBlock(7).values);
+loaded.append(time + 2000, 1);
+assert.equal(loaded.blockCount, 11);
+
+// Dropped blocks leave the later ones as they were.
+series.drop(4);
+assert.equal(series.blockCount, 7);
+assert.equal(series.length, 601);
+checkPoints(400, series.readBlock(0).times, series.readBlock(0).values);
+series.append(time + 2000, 5);
+assert.equal(JSON.stringify(series.readBlock(6).times),
+             JSON.stringify([time + 1000, time + 2000]));
+
+assert.throws(function() { series.append(1.5, 0); }, RangeError);
+assert.throws(function() { series.readBlock(7); }, RangeError);
+assert.throws(function() { series.drop(8); }, RangeError);
+assert.throws(function() {
+  codec.TimeSeries.from(saved.slice(0, saved.length - 1));
+}, RangeError);
+assert.throws(function() {
+  codec.TimeSeries({ blockLength: 0 });
+}, RangeError);
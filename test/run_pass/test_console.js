@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+var assert = require('assert');
 var console = require('console');
 
 console.log("Hello IoT.js!!");
@@ -33,3 +34,13 @@ console.error(3+5*2);
 console.error([1, 2, 3]);
 console.error(1, 2, 3);
 console.error('a', 1, 'b', 2, 'c', 3);
+
+// Regular files stay synchronous, so either result is fine.
+var async = console.setAsync(true, 1024);
+assert.equal(typeof async, 'boolean');
+for (var i = 0; i < 100; i++) {
+  console.log('asynchronous line ' + i + ' \u0000 with a NUL');
+}
+console.error("Hello asynchronous IoT.js!!");
+assert.equal(console.setAsync(false), false);
+console.log("Hello again IoT.js!!");
@@ -0,0 +1,103 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var crypto = require('crypto');
+
+function sha256(data) {
+  return crypto.createHash('sha256').update(data).digest('hex');
+}
+
+// SHA-256, over one and several chunks.
+assert.equal(sha256(''),
+  'e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855');
+assert.equal(sha256('abc'),
+  'ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad');
+
+var hash = crypto.createHash('sha256');
+for (var i = 0; i < 10; i++) {
+  hash.update(new Buffer(100).fill('a'));
+}
+assert.equal(hash.digest('hex'),
+  '41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3');
+assert.equal(crypto.createHash('sha256').update('abc').digest('base64'),
+  'ungWv48Bz+pBQUDeXa4iI7ADYaOWF3qctBD/YfIAFa0=');
+assert.equal(crypto.createHash('sha256').digest().length, 32);
+
+assert.throws(function() { crypto.createHash('md5'); }, Error);
+
+// HMAC-SHA256, with a short key and a key longer than a block.
+assert.equal(crypto.createHmac('sha256', 'key')
+  .update('The quick brown fox jumps over the lazy dog').digest('hex'),
+  'f7bc83f430538424b13298e6aa6fb143ef4d59a14946175997479dbc2d1a3cd8');
+assert.equal(crypto.createHmac('sha256', new Buffer(100).fill('k'))
+  .update('da').update('ta').digest('hex'),
+  '09380ee4b802da2363bc96e8e0d133ba275458ea8ddbc564f986fc12b31f8cb1');
+
+// AES-128 of FIPS-197, appendix C.1.
+var key = new Buffer('000102030405060708090a0b0c0d0e0f', 'hex');
+var plain = new Buffer('00112233445566778899aabbccddeeff', 'hex');
+var cipher = crypto.createCipheriv('aes-128-ecb', key, '');
+cipher.setAutoPadding(false);
+var encrypted = Buffer.concat([cipher.update(plain.slice(0, 5)),
+                               cipher.update(plain.slice(5)),
+                               cipher.final()]);
+assert.equal(encrypted.toString('hex'), '69c4e0d86a7b0430d8cdb78070b4c55a');
+
+cipher = crypto.createCipheriv('aes-128-ecb', key, '');
+cipher.setAutoPadding(false);
+cipher.update(plain.slice(0, 5));
+assert.throws(function() { cipher.final(); }, Error);
+
+// A whole block of input gets a whole block of padding.
+cipher = crypto.createCipheriv('aes-128-ecb', key, '');
+var padded = Buffer.concat([cipher.update(plain), cipher.final()]);
+assert.equal(padded.length, 32);
+assert.equal(padded.slice(0, 16).toString('hex'),
+             '69c4e0d86a7b0430d8cdb78070b4c55a');
+cipher = crypto.createCipheriv('aes-128-ecb', key, '');
+cipher.setAutoPadding(false);
+assert(cipher.update(new Buffer(16).fill(16)).equals(padded.slice(16)));
+
+assert.throws(function() {
+  crypto.createCipheriv('aes-128-ecb', new Buffer(15), '');
+}, RangeError);
+
+// AES-CMAC of RFC 4493, section 4.
+var cmacKey = new Buffer('2b7e151628aed2a6abf7158809cf4f3c', 'hex');
+assert.equal(crypto.aesCmac(cmacKey, new Buffer(0)).toString('hex'),
+             'bb1d6929e95937287fa37d129b756746');
+assert.equal(crypto.aesCmac(cmacKey,
+  new Buffer('6bc1bee22e409f96e93d7e117393172a', 'hex')).toString('hex'),
+  '070a16b46b4d4144f79bdd9dd04a287c');
+assert.equal(crypto.aesCmac(cmacKey, new Buffer(
+  '6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e5130c81c46' +
+  'a35ce411', 'hex')).toString('hex'), 'dfa66747de9ae63030ca32611497c827');
+
+// Random bytes, returned and passed to a callback.
+assert.equal(crypto.randomBytes(16).length, 16);
+assert.equal(crypto.randomBytes(0).length, 0);
+
+var called = false;
+crypto.randomBytes(8, function(err, bytes) {
+  assert.equal(err, null);
+  assert.equal(bytes.length, 8);
+  called = true;
+});
+assert.equal(called, false);
+
+process.on('exit', function() {
+  assert(called);
+});
@@ -0,0 +1,68 @@
+/* Copyright 2016-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var dgram = require('dgram');
+
+var port = 41240;
+var count = 10;
+var received = [];
+var sentBytes = 0;
+
+assert.throws(function() {
+  dgram.createSocket({ type: 'udp4', batch: 0 });
+}, RangeError);
+
+var server = dgram.createSocket({ type: 'udp4', batch: 8 });
+
+server.on('error', function(err) {
+  assert.fail();
+  server.close();
+});
+
+server.on('messages', function(list) {
+  assert.equal(list.length % 3, 0);
+  for (var i = 0; i < list.length; i += 3) {
+    assert.equal(list[i + 1], '127.0.0.1');
+    assert.equal(typeof list[i + 2], 'number');
+    received.push(list[i].toString());
+  }
+  if (received.length == count) {
+    server.close();
+  }
+});
+
+server.bind(port, function() {
+  var client = dgram.createSocket('udp4');
+  var messages = [];
+  for (var i = 0; i < count; i++) {
+    messages.push({ msg: 'message ' + i, port: port, address: '127.0.0.1' });
+  }
+
+  client.sendBatch(messages, function(err, bytes) {
+    assert.equal(err, null);
+    sentBytes = bytes;
+    client.close();
+  });
+});
+
+process.on('exit', function(code) {
+  assert.equal(code, 0);
+  assert.equal(received.length, count);
+  for (var i = 0; i < count; i++) {
+    assert.equal(received[i], 'message ' + i);
+  }
+  assert.equal(sentBytes, 'message 0'.length * count);
+});
@@ -0,0 +1,62 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var dns = require('dns');
+var assert = require('assert');
+
+// Count the lookups which reach the resolver.
+var dnsBuiltin = process.binding(process.binding.dns);
+var getaddrinfo = dnsBuiltin.getaddrinfo;
+var resolved = {};
+dnsBuiltin.getaddrinfo = function(hostname, family, hints, callback) {
+  resolved[hostname] = (resolved[hostname] || 0) + 1;
+  return getaddrinfo.call(this, hostname, family, hints, callback);
+};
+
+var answers = 0;
+
+function check(err, ip, family) {
+  assert.equal(err, null);
+  assert.equal(ip, '127.0.0.1');
+  assert.strictEqual(family, 4);
+  answers++;
+}
+
+// Concurrent lookups of a host share one resolution.
+dns.lookup('localhost', 4, check);
+dns.lookup('localhost', 4, check);
+
+dns.lookup('invalid', 4, function(err) {
+  assert.notEqual(err, null);
+
+  // A later lookup is answered from the cache, failures included.
+  dns.lookup('localhost', 4, check);
+  dns.lookup('invalid', 4, function(err) {
+    assert.notEqual(err, null);
+
+    // Without the cache, the host is resolved again.
+    dns.clearCache();
+    dns.lookup('localhost', 4, function(err, ip, family) {
+      check(err, ip, family);
+      assert.equal(resolved['localhost'], 2);
+    });
+  });
+});
+
+process.on('exit', function() {
+  assert.equal(answers, 4);
+  assert.equal(resolved['localhost'], 2);
+  assert.equal(resolved['invalid'], 1);
+});
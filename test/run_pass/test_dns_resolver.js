@@ -0,0 +1,121 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var dgram = require('dgram');
+var dns = require('dns');
+
+// A name server which knows the A record of one host, and never answers
+// for another one.
+var port = 3097;
+var server = dgram.createSocket('udp4');
+var questions = [];
+
+server.on('message', function(data, rinfo) {
+  var end = 12;
+  var labels = [];
+  while (data.readUInt8(end) !== 0) {
+    var size = data.readUInt8(end);
+    labels.push(data.toString(end + 1, end + 1 + size));
+    end += size + 1;
+  }
+  var name = labels.join('.');
+  var type = data.readUInt16BE(end + 1);
+  end += 5;
+  questions.push(name + '/' + type);
+
+  if (name === 'silent.test') {
+    return;
+  }
+
+  var isKnown = name === 'resolver.test';
+  var hasAnswer = isKnown && type === 1;
+  var reply = new Buffer(end + (hasAnswer ? 16 : 0));
+  data.copy(reply, 0, 0, end);
+  reply.writeUInt16BE(isKnown ? 0x8180 : 0x8183, 2);
+  reply.writeUInt16BE(hasAnswer ? 1 : 0, 6);
+  if (hasAnswer) {
+    reply.writeArray('UInt16BE', [0xc00c, 1, 1, 0, 60, 4], end);
+    reply.writeArray('UInt8', [10, 0, 0, 7], end + 12);
+  }
+  server.send(reply, rinfo.port, '127.0.0.1');
+});
+
+dns.backend = 'resolver';
+dns.cacheTtl = 0;
+dns.negativeCacheTtl = 0;
+dns.resolverTimeout = 200;
+dns.resolverTries = 1;
+
+dns.setServers(['127.0.0.1:' + port, '[::1]:' + port, '10.0.0.1']);
+assert.equal(dns.getServers().join(),
+             '127.0.0.1:' + port + ',[::1]:' + port + ',10.0.0.1');
+dns.setServers(['127.0.0.1:' + port]);
+
+assert.throws(function() {
+  dns.setServers([]);
+}, RangeError);
+assert.throws(function() {
+  dns.setServers(['not an address']);
+}, TypeError);
+
+var answers = {};
+
+server.bind(port, function() {
+  // The A and the AAAA records are asked at once.
+  dns.lookup('resolver.test', function(err, ip, family) {
+    assert.equal(err, null);
+    assert.equal(ip, '10.0.0.7');
+    assert.equal(family, 4);
+    answers.both = true;
+  });
+
+  dns.lookup('resolver.test', 4, function(err, ip, family) {
+    assert.equal(err, null);
+    assert.equal(ip, '10.0.0.7');
+    answers.a = true;
+  });
+
+  dns.lookup('resolver.test', 6, function(err, ip, family) {
+    assert(err instanceof Error);
+    answers.aaaa = true;
+  });
+
+  dns.lookup('missing.test', 4, function(err, ip, family) {
+    assert(err instanceof Error);
+    answers.missing = true;
+  });
+
+  // An address is answered without asking the server.
+  dns.lookup('127.0.0.1', function(err, ip, family) {
+    assert.equal(err, null);
+    assert.equal(ip, '127.0.0.1');
+    assert.equal(family, 4);
+    answers.address = true;
+  });
+
+  dns.lookup('silent.test', 4, function(err, ip, family) {
+    assert(err instanceof Error);
+    answers.silent = true;
+    server.close();
+  });
+});
+
+process.on('exit', function() {
+  assert.equal(Object.keys(answers).sort().join(),
+               'a,aaaa,address,both,missing,silent');
+  assert.equal(questions.indexOf('127.0.0.1/1'), -1);
+  assert.notEqual(questions.indexOf('resolver.test/28'), -1);
+});
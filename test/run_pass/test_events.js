@@ -247,3 +247,50 @@ emitter.addListener('event2', listener1);
 emitter.removeAllListeners('event2');
 res = emitter.emit('event2');
 assert.equal(res, false);
+
+/*
+ * Test the arguments passed on to one and to several listeners, and
+ * listeners removed while an event is emitted.
+ */
+var argsEmitter = new EventEmitter();
+var received = [];
+var argsListener = function() {
+  received.push(Array.prototype.slice.call(arguments));
+};
+
+argsEmitter.on('args', argsListener);
+argsEmitter.emit('args');
+argsEmitter.emit('args', 1);
+argsEmitter.emit('args', 1, 2);
+argsEmitter.emit('args', 1, 2, 3);
+argsEmitter.emit('args', 1, 2, 3, 4);
+assert.equal(JSON.stringify(received),
+             JSON.stringify([[], [1], [1, 2], [1, 2, 3], [1, 2, 3, 4]]));
+
+received = [];
+argsEmitter.on('args', argsListener);
+argsEmitter.emit('args', 'a', 'b');
+assert.equal(JSON.stringify(received),
+             JSON.stringify([['a', 'b'], ['a', 'b']]));
+
+received = [];
+argsEmitter.removeListener('args', argsListener);
+argsEmitter.emit('args', 'c');
+assert.equal(JSON.stringify(received),
+             JSON.stringify([['c']]));
+
+var removedCnt = 0;
+var removingListener = function() {
+  argsEmitter.removeListener('remove', removedListener);
+};
+var removedListener = function() {
+  removedCnt++;
+};
+argsEmitter.on('remove', removingListener);
+argsEmitter.on('remove', removedListener);
+assert.equal(argsEmitter.emit('remove'), true);
+assert.equal(removedCnt, 1);
+assert.equal(argsEmitter.emit('remove'), true);
+assert.equal(removedCnt, 1);
+argsEmitter.removeListener('remove', removingListener);
+assert.equal(argsEmitter.emit('remove'), false);
@@ -0,0 +1,52 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+var fs = require('fs');
+
+var filePath = process.cwd() + "/resources/tobeornottobe.txt";
+var expected = fs.readFileSync(filePath);
+
+var fd = fs.openSync(filePath, 'r');
+
+var whole = fs.mmap(fd, 0, expected.length);
+assert.equal(whole.length, expected.length);
+assert.equal(whole.toString(), expected.toString());
+
+// An offset within the first page.
+var part = fs.mmap(fd, 7, 20, 'sequential');
+assert.equal(part.toString(), expected.slice(7, 27).toString());
+
+// Writing to the mapping does not change the file.
+whole[0] = 0x20;
+assert.equal(fs.readFileSync(filePath)[0], expected[0]);
+
+assert.throws(function() {
+  fs.mmap(fd, 0, 0);
+}, RangeError);
+assert.throws(function() {
+  fs.mmap(fd, -1, 10);
+}, RangeError);
+assert.throws(function() {
+  fs.mmap(fd, 0, 10, 'often');
+}, TypeError);
+
+fs.closeSync(fd);
+
+// The mapping outlives the descriptor.
+assert.equal(part.toString(), expected.slice(7, 27).toString());
+
+assert.throws(function() {
+  fs.mmap(fd, 0, 10);
+});
@@ -0,0 +1,79 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var fs = require('fs');
+var assert = require('assert');
+
+var dirPath = process.cwd() + '/resources';
+var filePath = dirPath + '/greeting.txt';
+var newPath = dirPath + '/greeting_promises.txt';
+
+var promises = fs.promises;
+var done = {};
+
+promises.stat(filePath).then(function(stat) {
+  assert(stat.isFile());
+  done.stat = true;
+});
+
+promises.stat(dirPath + '/not_exists.txt').then(function() {
+  assert.fail('stat of a missing file resolved');
+}, function(err) {
+  assert(err instanceof Error);
+  done.statError = true;
+});
+
+promises.readdir(dirPath).then(function(files) {
+  assert(files.indexOf('greeting.txt') >= 0);
+  done.readdir = true;
+});
+
+promises.readFile(filePath).then(function(data) {
+  assert.equal(data.toString(), fs.readFileSync(filePath).toString());
+  done.readFile = true;
+});
+
+// open, write, close, read back and unlink, each call settled natively.
+var text = new Buffer('promised');
+var fd;
+promises.open(newPath, 'w').then(function(_fd) {
+  fd = _fd;
+  return promises.write(fd, text, 0, text.length);
+}).then(function(written) {
+  assert.equal(written, text.length);
+  return promises.close(fd);
+}).then(function(result) {
+  assert.equal(result, undefined);
+  return promises.open(newPath, 'r');
+}).then(function(_fd) {
+  fd = _fd;
+  return promises.read(fd, new Buffer(32), 0, 32, 0);
+}).then(function(bytesRead) {
+  assert.equal(bytesRead, text.length);
+  return promises.close(fd);
+}).then(function() {
+  return promises.unlink(newPath);
+}).then(function() {
+  assert.equal(fs.existsSync(newPath), false);
+  done.chain = true;
+});
+
+// Bad arguments throw, like they do for the callback API.
+assert.throws(function() { promises.stat(1); }, TypeError);
+
+process.on('exit', function() {
+  assert.equal(Object.keys(done).sort().join(),
+               'chain,readFile,readdir,stat,statError');
+});
@@ -59,3 +59,12 @@ fs.readFile(filePath, function(err, data) {
   "Be all my ſinnes remembred."
   assert.equal(data, result);
 });
+
+
+var missingPath = process.cwd() + "/resources/not_existing.txt";
+
+fs.readFile(missingPath, function(err, data) {
+  assert.notEqual(err, null);
+  assert.equal(err instanceof Error, true);
+  assert.equal(data, undefined);
+});
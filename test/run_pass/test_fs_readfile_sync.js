@@ -58,3 +58,8 @@ var result =
   "The faire Ophelia? Nimph, in thy Orizons\n" +
   "Be all my ſinnes remembred."
 assert.equal(data, result);
+
+
+assert.throws(function() {
+  fs.readFileSync(process.cwd() + "/resources/not_existing.txt");
+});
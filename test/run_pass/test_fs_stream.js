@@ -0,0 +1,74 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+var fs = require('fs');
+
+var srcPath = process.cwd() + '/resources/tobeornottobe.txt';
+var dstPath = process.cwd() + '/resources/test_fs_stream.txt';
+
+if (process.platform === 'tizenrt') {
+  dstPath = '/mnt/test_fs_stream.txt';
+}
+
+var expected = fs.readFileSync(srcPath);
+
+// Small chunks, so that several reads are in flight and complete in any
+// order; the first one ends at a chunk boundary.
+var chunks = [];
+var part = fs.createReadStream(srcPath, {
+  start: 10,
+  end: 999,
+  highWaterMark: 64,
+  readAhead: 4
+});
+var partClosed = false;
+
+part.on('data', function(chunk) {
+  chunks.push(chunk);
+});
+part.on('close', function() {
+  partClosed = true;
+});
+
+// The whole file, copied through a write stream.
+var source = fs.createReadStream(srcPath, { highWaterMark: 100 });
+var copy = fs.createWriteStream(dstPath, { highWaterMark: 50 });
+var copied = false;
+
+copy.on('close', function() {
+  copied = true;
+  assert.equal(copy.bytesWritten, expected.length);
+  assert.equal(fs.readFileSync(dstPath).toString(), expected.toString());
+  fs.unlinkSync(dstPath);
+});
+
+source.pipe(copy);
+
+var missingError = null;
+fs.createReadStream(process.cwd() + '/resources/not_existing.txt')
+  .on('error', function(err) {
+    missingError = err;
+  });
+
+process.on('exit', function() {
+  assert.equal(chunks[0].length, 54);
+  assert.equal(Buffer.concat(chunks).toString(),
+               expected.slice(10, 1000).toString());
+  assert.equal(part.bytesRead, 990);
+  assert.equal(partClosed, true);
+  assert.equal(source.bytesRead, expected.length);
+  assert.equal(copied, true);
+  assert.notEqual(missingError, null);
+});
@@ -0,0 +1,82 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var fs = require('fs');
+
+var dirPath = process.cwd() + '/resources/watch_dir';
+var filePath = dirPath + '/watched.txt';
+var statPath = process.cwd() + '/resources/watched_stat.txt';
+
+if (fs.existsSync(filePath)) {
+  fs.unlinkSync(filePath);
+}
+if (!fs.existsSync(dirPath)) {
+  fs.mkdirSync(dirPath);
+}
+
+// The writes of a burst make one 'change' of the file.
+var changes = 0;
+var closed = false;
+
+var watcher = fs.watch(dirPath, { latency: 100 }, function(event, filename) {
+  assert.equal(filename, 'watched.txt');
+  if (event === 'change') {
+    changes++;
+  }
+});
+
+watcher.on('close', function() {
+  closed = true;
+  fs.unlinkSync(filePath);
+  fs.rmdirSync(dirPath);
+});
+
+for (var i = 0; i < 5; i++) {
+  fs.writeFileSync(filePath, 'burst ' + i);
+}
+
+setTimeout(function() {
+  watcher.close();
+}, 500);
+
+// fs.watchFile passes the current and the previous stats.
+var statChanges = 0;
+
+fs.writeFileSync(statPath, 'a');
+
+function onStatChange(curr, prev) {
+  statChanges++;
+  assert.equal(curr.size, 3);
+  assert.equal(prev.size, 1);
+  fs.unwatchFile(statPath, onStatChange);
+}
+
+fs.watchFile(statPath, { interval: 50 }, onStatChange);
+
+setTimeout(function() {
+  fs.writeFileSync(statPath, 'abc');
+}, 200);
+
+assert.throws(function() {
+  fs.watchFile(statPath);
+}, TypeError);
+
+process.on('exit', function() {
+  assert.equal(changes, 1);
+  assert.equal(closed, true);
+  assert.equal(statChanges, 1);
+  fs.unlinkSync(statPath);
+});
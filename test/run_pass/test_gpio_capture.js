@@ -0,0 +1,40 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var Gpio = require('gpio');
+var assert = require('assert');
+var Gpio = require('gpio');
+var gpio = new Gpio();
+
+// The configurations which capture mode rejects, before a pin is opened.
+var badConfigurations = [
+  { pin: 13, direction: gpio.DIRECTION.OUT, edge: gpio.EDGE.BOTH,
+    capture: true },
+  { pin: 13, direction: gpio.DIRECTION.IN, capture: true },
+  { pin: 13, direction: gpio.DIRECTION.IN, edge: gpio.EDGE.BOTH,
+    capture: 'yes' },
+  { pin: 13, direction: gpio.DIRECTION.IN, edge: gpio.EDGE.BOTH,
+    capture: { batch: 0 } },
+  { pin: 13, direction: gpio.DIRECTION.IN, edge: gpio.EDGE.BOTH,
+    capture: { batch: 513 } },
+  { pin: 13, direction: gpio.DIRECTION.IN, edge: gpio.EDGE.BOTH,
+    capture: { latency: -1 } },
+];
+
+badConfigurations.forEach(function(configuration) {
+  assert.throws(function() {
+    gpio.open(configuration);
+  }, TypeError);
+});
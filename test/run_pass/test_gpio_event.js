@@ -27,7 +27,8 @@ var testGpioInfo = [
   },
   {
     pin: 26,
-    edge: gpio.EDGE.BOTH
+    edge: gpio.EDGE.BOTH,
+    debounce: 50
   }
 ];
 
@@ -35,10 +36,11 @@ testGpioInfo.forEach(function(info) {
   var switchGpio = gpio.open({
     pin: info.pin,
     edge: info.edge,
+    debounce: info.debounce,
     direction: gpio.DIRECTION.IN
   }, function() {
-    switchGpio.on('change', function() {
-      console.log('pin:', info.pin, ', current value:', this.readSync());
+    switchGpio.on('change', function(value) {
+      console.log('pin:', info.pin, ', current value:', value);
     });
   });
 });
@@ -0,0 +1,82 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var https = require('https');
+
+var port = 3052;
+var cert = process.cwd() + '/resources/tls/server.crt';
+var key = process.cwd() + '/resources/tls/server.key';
+
+var message = 'Hello HTTPS';
+var requests = 0;
+var responses = [];
+
+var server = https.createServer({cert: cert, key: key}, function(req, res) {
+  var body = '';
+  requests++;
+
+  assert.equal(req.socket.encrypted, true);
+
+  req.on('data', function(chunk) {
+    body += chunk.toString();
+  });
+
+  req.on('end', function() {
+    res.writeHead(200, {'Content-Length': body.length});
+    res.end(body);
+  });
+});
+
+
+server.listen(port, function() {
+  request(function() {
+    request(function() {
+      server.close();
+    });
+  });
+});
+
+
+function request(callback) {
+  var req = https.request({
+    method: 'POST',
+    host: 'localhost',
+    port: port,
+    ca: cert,
+    headers: {'Content-Length': message.length}
+  }, function(res) {
+    var body = '';
+
+    assert.equal(res.statusCode, 200);
+
+    res.on('data', function(chunk) {
+      body += chunk.toString();
+    });
+
+    res.on('end', function() {
+      responses.push(body);
+      callback();
+    });
+  });
+
+  req.end(message);
+}
+
+
+process.on('exit', function() {
+  assert.equal(requests, 2);
+  assert.equal(responses.join(), message + ',' + message);
+});
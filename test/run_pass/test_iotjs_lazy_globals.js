@@ -0,0 +1,35 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+
+// console and Buffer are evaluated on first use, and then stay the same.
+assert.equal(Buffer, Buffer);
+assert.equal(typeof Buffer.concat, 'function');
+assert.equal(new Buffer('abc').toString(), 'abc');
+assert.equal(console, console);
+assert.equal(typeof console.log, 'function');
+
+// Like other globals, they can be replaced.
+var originalConsole = console;
+var logged = [];
+console = {
+  log: function(message) {
+    logged.push(message);
+  }
+};
+console.log('replaced');
+assert.equal(logged[0], 'replaced');
+console = originalConsole;
+assert.equal(console, originalConsole);
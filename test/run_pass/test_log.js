@@ -0,0 +1,85 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var fs = require('fs');
+var log = require('log');
+
+// The records keep the raw values, in order.
+log.open({ size: 4096 });
+var sample = log.format('sample %d of %s: %j');
+var flag = log.format('flag %s %s %s');
+log.write(sample, 1, 'sensor', { a: 1 });
+log.write(flag, true, null, undefined);
+assert.equal(log.format('sample %d of %s: %j'), sample);
+
+var records = log.records();
+assert.equal(records.length, 2);
+assert.equal(records[0].format, 'sample %d of %s: %j');
+assert.equal(records[0].args[0], 1);
+assert.equal(records[0].args[1], 'sensor');
+assert.equal(records[0].args[2], '[object Object]');
+assert.equal(records[1].args.length, 3);
+assert.strictEqual(records[1].args[0], true);
+assert.strictEqual(records[1].args[1], null);
+assert.strictEqual(records[1].args[2], undefined);
+assert(Math.abs(records[0].time - Date.now()) < 60000);
+
+var lines = [];
+assert.equal(log.flush(function(line) { lines.push(line); }), 2);
+assert.equal(lines.length, 2);
+assert(/ sample 1 of sensor: "\[object Object\]"$/.test(lines[0]));
+assert(/ flag true null undefined$/.test(lines[1]));
+assert.equal(log.records().length, 0);
+
+// A full ring overwrites its oldest records.
+for (var i = 0; i < 1000; i++) {
+  log.write(sample, i, 'a string argument of some length', i * 2);
+}
+records = log.records();
+var stats = log.stats();
+assert.equal(stats.count, records.length);
+assert.equal(stats.overwritten + stats.count, 1000);
+assert(stats.used <= stats.size);
+assert.equal(records[records.length - 1].args[0], 999);
+for (var j = 1; j < records.length; j++) {
+  assert.equal(records[j].args[0], records[j - 1].args[0] + 1);
+}
+
+// Long strings are truncated to fit in a record.
+var long = new Array(2000).join('x');
+log.write(flag, long, 'b', 'c');
+records = log.records();
+var last = records[records.length - 1];
+assert(last.args[0].length < long.length);
+log.close();
+assert.equal(log.stats(), null);
+
+// A log file keeps its formats and records when it is opened again.
+if (process.platform === 'linux') {
+  var file = process.cwd() + '/resources/test_log.bin';
+  log.open({ size: 2048, path: file });
+  var id = log.format('persisted %s');
+  log.write(id, 'value');
+  log.close();
+
+  log.open({ size: 2048, path: file });
+  assert.equal(log.format('persisted %s'), id);
+  records = log.records();
+  assert.equal(records.length, 1);
+  assert.equal(records[0].args[0], 'value');
+  log.close();
+  fs.unlinkSync(file);
+}
@@ -0,0 +1,50 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var fs = require('fs');
+
+assert.equal(typeof process.dlopen, 'function');
+
+// A file that is not a shared library.
+var file = process.cwd() + '/resources/test_addon.node';
+fs.writeFileSync(file, 'not a shared library');
+
+assert.throws(function() {
+  require(file);
+}, Error);
+
+// It is found by its name without the suffix, too.
+assert.throws(function() {
+  require(process.cwd() + '/resources/test_addon');
+}, Error);
+
+fs.unlinkSync(file);
+
+// A library that is not an addon.
+if (process.platform === 'linux') {
+  var error;
+  try {
+    process.dlopen({}, 'libm.so.6');
+  } catch (e) {
+    error = e;
+  }
+  assert(error instanceof Error);
+  assert.equal(error.message, 'Not an IoT.js addon');
+}
+
+assert.throws(function() {
+  process.dlopen({}, process.cwd() + '/resources/no_such_addon.node');
+}, Error);
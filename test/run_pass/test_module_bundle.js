@@ -0,0 +1,40 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var module = require('module');
+
+var root = process.cwd() + '/resources/app.bundle';
+
+assert.equal(module.openBundle('resources/app.bundle'), root + '/index.js');
+
+assert.throws(function() {
+  module.openBundle(root);
+}, Error);
+
+// Modules and packages are found in the bundle, and paths leading out of it
+// on the file system.
+var app = require(root + '/index.js');
+assert.equal(app.add(2, 3), 5);
+assert.equal(app.pkg.name, 'pkg');
+assert.equal(app.outside.add(1, 4), 5);
+
+// A bundled module is loaded once, whatever path it is required by.
+assert.equal(require(root + '/lib/add').add, app.add);
+assert.equal(require(root + '/lib/../lib/add.js').add, app.add);
+
+assert.throws(function() {
+  require(root + '/lib/missing');
+}, Error);
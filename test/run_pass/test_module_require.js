@@ -40,3 +40,19 @@ assert.throws(function() {
 assert.throws(function() {
   var test4 = require('tmp');
 }, Error);
+
+// A module written after a failed lookup is found, the outcomes of earlier
+// lookups are forgotten when a file is created.
+var fs = require('fs');
+var later = dir + "require_later.js";
+
+assert.throws(function() {
+  require(dir + "require_later");
+}, Error);
+
+fs.writeFileSync(later, "exports.value = 42;");
+try {
+  assert.equal(require(dir + "require_later").value, 42);
+} finally {
+  fs.unlinkSync(later);
+}
@@ -0,0 +1,75 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var net = require('net');
+var assert = require('assert');
+
+
+var port = 22715;
+var chunk = new Buffer(64 * 1024);
+chunk.fill('x');
+var maxChunks = 1024;
+
+
+// Does not read until the client has filled the kernel buffers.
+var received = 0;
+var server = net.createServer(function(socket) {
+  socket.pause();
+  setTimeout(function() {
+    socket.resume();
+  }, 100);
+  socket.on('data', function(data) {
+    received += data.length;
+  });
+  socket.on('end', function() {
+    socket.end();
+  });
+});
+server.listen(port);
+
+
+var written = 0;
+var blocked = false;
+var drained = false;
+var ended = false;
+
+var socket = net.connect(port, '127.0.0.1', function() {
+  while (written < maxChunks * chunk.length) {
+    written += chunk.length;
+    if (!socket.write(chunk)) {
+      blocked = true;
+      break;
+    }
+  }
+  assert.equal(blocked, true);
+  assert(socket.bufferSize > 0);
+});
+socket.on('drain', function() {
+  drained = true;
+  socket.end();
+});
+socket.on('end', function() {
+  ended = true;
+  server.close();
+});
+
+
+process.on('exit', function(code) {
+  assert.equal(code, 0);
+  assert.equal(drained, true);
+  assert.equal(ended, true);
+  assert.equal(received, written);
+});
@@ -0,0 +1,76 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var net = require('net');
+var assert = require('assert');
+
+
+var port = 22717;
+var limit = 16 * 1024;
+var payload = new Buffer(512 * 1024);
+payload.fill('x');
+
+
+// Leaves the data unread for a while: the socket stops reading at its cap,
+// and the rest waits in the kernel.
+var received = 0;
+var maxBuffered = 0;
+var server = net.createServer({ maxBufferedBytes: limit }, function(socket) {
+  assert.equal(socket.maxBufferedBytes, limit);
+  socket.pause();
+  socket.on('readable', function() {
+    maxBuffered = Math.max(maxBuffered, socket._readableState.length);
+  });
+  setTimeout(function() {
+    assert(net.getBufferedBytes() > 0);
+    socket.on('data', function(data) {
+      received += data.length;
+    });
+  }, 100);
+  socket.on('end', function() {
+    socket.end();
+  });
+});
+server.listen(port);
+
+
+var rejected = false;
+
+var socket = net.connect(port, '127.0.0.1', function() {
+  socket.write(payload);
+  socket.end();
+});
+socket.on('end', function() {
+  server.close();
+
+  // A write over the cap of a socket is rejected.
+  var small = new net.Socket({ maxBufferedBytes: 8 });
+  small.on('error', function(err) {
+    rejected = true;
+  });
+  assert.equal(small.write('more than eight bytes'), false);
+});
+
+
+process.on('exit', function(code) {
+  assert.equal(code, 0);
+  assert.equal(received, payload.length);
+  assert(maxBuffered > 0);
+  // One read may go over the cap before reading stops.
+  assert(maxBuffered < limit + 64 * 1024);
+  assert.equal(rejected, true);
+  assert.equal(net.getBufferedBytes(), 0);
+});
@@ -0,0 +1,83 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+var http = require('http');
+var net = require('net');
+
+var connections = 0;
+var responses = 0;
+
+// A server answering every request of a connection, without closing it.
+var server = net.createServer(function(socket) {
+  var received = '';
+
+  connections++;
+
+  socket.on('data', function(data) {
+    received += data.toString();
+
+    var end;
+    while ((end = received.indexOf('\r\n\r\n')) >= 0) {
+      assert.notEqual(received.indexOf('Connection: keep-alive'), -1);
+      received = received.substring(end + 4);
+      socket.write('HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok');
+    }
+  });
+});
+
+server.listen(3086, '127.0.0.1');
+
+var agent = new http.Agent({ keepAlive: true, maxSockets: 1 });
+
+assert.equal(http.globalAgent instanceof http.Agent, true);
+
+function get(path, callback) {
+  var request = http.request({
+    host: '127.0.0.1',
+    port: 3086,
+    path: path,
+    agent: agent
+  }, function(res) {
+    var body = '';
+    res.on('data', function(chunk) {
+      body += chunk.toString();
+    });
+    res.on('end', function() {
+      assert.equal(body, 'ok');
+      responses++;
+      callback();
+    });
+  });
+  request.end();
+}
+
+// Requests beyond `maxSockets` wait for the connection of the first one.
+var pending = 3;
+for (var i = 0; i < 3; ++i) {
+  get('/' + i, function() {
+    if (--pending == 0) {
+      // An idle connection is reused by a later request.
+      get('/last', function() {
+        agent.destroy();
+        server.close();
+      });
+    }
+  });
+}
+
+process.on('exit', function() {
+  assert.equal(responses, 4);
+  assert.equal(connections, 1);
+});
@@ -0,0 +1,65 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var http = require('http');
+var net = require('net');
+
+var server = http.createServer(function(req, res) {
+  // No Content-Length: an HTTP/1.1 client gets the body in chunks.
+  res.write('hello ');
+  res.write(new Buffer('binary-safe'));
+  res.write('');
+  res.end('!');
+});
+
+server.listen(3095, 5);
+
+var expected =
+    'HTTP/1.1 200 OK\r\n' +
+    'Transfer-Encoding: chunked\r\n' +
+    '\r\n' +
+    '6\r\nhello \r\n' +
+    'b\r\nbinary-safe\r\n' +
+    '1\r\n!\r\n' +
+    '0\r\n\r\n' +
+    // An HTTP/1.0 client does not know chunks, the connection ends the body.
+    'HTTP/1.1 200 OK\r\n' +
+    'Connection: close\r\n' +
+    '\r\n' +
+    'hello binary-safe!';
+
+var response = '';
+var client = net.connect(3095, '127.0.0.1', function() {
+  client.write('GET / HTTP/1.1\r\n\r\nGET / HTTP/1.0\r\n\r\n');
+});
+client.on('data', function(data) {
+  response += data.toString();
+});
+client.on('close', function() {
+  assert.equal(response, expected);
+
+  // The http client takes the chunks apart again.
+  http.get({port: 3095}, function(res) {
+    var body = '';
+    res.on('data', function(chunk) {
+      body += chunk.toString();
+    });
+    res.on('end', function() {
+      assert.equal(body, 'hello binary-safe!');
+      server.close();
+    });
+  });
+});
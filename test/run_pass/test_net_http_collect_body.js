@@ -0,0 +1,100 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var http = require('http');
+
+var limit = 1024;
+var large = new Buffer(2 * limit);
+large.fill('x');
+
+// Bodies sent in pieces, and whether the server collects them.
+var cases = [
+  { pieces: ['hello'], collected: true },
+  { pieces: ['hel', 'lo ', 'world'], collected: true },
+  { pieces: [large.toString()], collected: false },
+];
+var requests = 0;
+var responses = 0;
+
+var server = http.createServer(function(req, res) {
+  var index = Number(req.url.substr(1));
+  var expected = cases[index].pieces.join('');
+
+  requests++;
+  if (cases[index].collected) {
+    assert(Buffer.isBuffer(req.body));
+    assert.equal(req.body.toString(), expected);
+  } else {
+    assert.equal(req.body, null);
+  }
+
+  var body = '';
+  req.on('data', function(chunk) {
+    body += chunk.toString();
+  });
+  req.on('end', function() {
+    assert.equal(body, expected);
+    res.writeHead(200, { 'Connection': 'close' });
+    res.end(String(body.length));
+  });
+});
+server.collectBodyLimit = limit;
+
+server.listen(3091, 5);
+
+function request(index) {
+  if (index == cases.length) {
+    server.close();
+    return;
+  }
+
+  var pieces = cases[index].pieces;
+  var req = http.request({
+    method: 'POST',
+    port: 3091,
+    path: '/' + index,
+    headers: { 'Content-Length': pieces.join('').length }
+  }, function(res) {
+    var body = '';
+    res.on('data', function(chunk) {
+      body += chunk.toString();
+    });
+    res.on('end', function() {
+      assert.equal(body, String(pieces.join('').length));
+      responses++;
+      request(index + 1);
+    });
+  });
+
+  // The pieces go in separate ticks, so they may reach the server apart.
+  var i = 0;
+  var writePiece = function() {
+    if (i == pieces.length - 1) {
+      req.end(pieces[i]);
+    } else {
+      req.write(pieces[i++]);
+      setTimeout(writePiece, 10);
+    }
+  };
+  writePiece();
+}
+
+request(0);
+
+process.on('exit', function() {
+  assert.equal(requests, cases.length);
+  assert.equal(responses, cases.length);
+});
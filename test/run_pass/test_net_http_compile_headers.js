@@ -0,0 +1,58 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var http = require('http');
+var net = require('net');
+
+var block = http.compileHeaders({
+  'Content-Type': 'application/json',
+  'X-Api': 1
+});
+var body = JSON.stringify({ status: 'ok' });
+
+var server = http.createServer(function(req, res) {
+  res.setHeader('Content-Length', body.length);
+  if (req.url == '/last') {
+    res.setHeader('Connection', 'close');
+  }
+  res.writeHead(200, block);
+  res.end(body);
+});
+
+server.listen(3093, 5);
+
+var expected = function(last) {
+  return 'HTTP/1.1 200 OK\r\n' +
+         'Content-Length: ' + body.length + '\r\n' +
+         (last ? 'Connection: close\r\n' : '') +
+         'Content-Type: application/json\r\n' +
+         'X-Api: 1\r\n' +
+         '\r\n' + body;
+};
+
+var response = '';
+var client = net.connect(3093, '127.0.0.1', function() {
+  // The block does not end the keep-alive connection, the second response
+  // uses it again.
+  client.write('GET / HTTP/1.1\r\n\r\nGET /last HTTP/1.1\r\n\r\n');
+});
+client.on('data', function(data) {
+  response += data.toString();
+});
+client.on('close', function() {
+  assert.equal(response, expected(false) + expected(true));
+  server.close();
+});
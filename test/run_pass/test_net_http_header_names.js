@@ -0,0 +1,70 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var http = require('http');
+var net = require('net');
+
+// The names of the common headers are interned, the others are not; all
+// keep the spelling they are sent with.
+var lines = [
+  'Host: localhost',
+  'content-type: text/plain',
+  'CONTENT-LENGTH: 5',
+  'X-Custom-Header: custom',
+  'Vary: Accept',
+  'via: proxy',
+];
+var requests = 0;
+
+var server = http.createServer(function(req, res) {
+  requests++;
+
+  var names = Object.keys(req.headers);
+  assert.equal(names.join(','),
+               'Host,content-type,CONTENT-LENGTH,X-Custom-Header,Vary,via');
+  for (var i = 0; i < lines.length; i++) {
+    var line = lines[i].split(': ');
+    assert.equal(req.headers[line[0]], line[1]);
+  }
+  assert.equal(req._contentLength, 5);
+
+  req.on('data', function(chunk) {
+    assert.equal(chunk.toString(), 'hello');
+  });
+  req.on('end', function() {
+    res.writeHead(200, { 'Connection': 'close' });
+    res.end();
+  });
+});
+
+server.listen(3092, 5);
+
+var client = net.connect(3092, '127.0.0.1', function() {
+  client.write('POST / HTTP/1.1\r\n' + lines.join('\r\n') + '\r\n\r\nhello');
+});
+
+var response = '';
+client.on('data', function(data) {
+  response += data.toString();
+});
+client.on('close', function() {
+  assert.equal(response.indexOf('HTTP/1.1 200'), 0);
+  server.close();
+});
+
+process.on('exit', function() {
+  assert.equal(requests, 1);
+});
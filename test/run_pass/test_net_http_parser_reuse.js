@@ -0,0 +1,74 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+var http = require('http');
+
+// Header counts around the number of fields the parser passes to JS at once.
+var headerCounts = [1, 9, 10, 11, 31, 32, 33, 70];
+var requests = 0;
+var responses = 0;
+
+var server = http.createServer(function(req, res) {
+  var count = Number(req.headers['x-count']);
+
+  requests++;
+  assert.equal(req.url, '/count/' + count);
+  for (var i = 0; i < count; i++) {
+    assert.equal(req.headers['x-h' + i], 'v' + i);
+  }
+
+  res.writeHead(200, { 'Connection': 'close' });
+  res.end(req.url);
+});
+
+server.listen(3087, 5);
+
+function request(index) {
+  if (index == headerCounts.length) {
+    server.close();
+    return;
+  }
+
+  var count = headerCounts[index];
+  var headers = { 'x-count': count };
+  for (var i = 0; i < count; i++) {
+    headers['x-h' + i] = 'v' + i;
+  }
+
+  // Requests go one after the other, so the server parses them with the
+  // parsers of closed connections.
+  http.get({
+    port: 3087,
+    path: '/count/' + count,
+    headers: headers
+  }, function(res) {
+    var body = '';
+    res.on('data', function(chunk) {
+      body += chunk.toString();
+    });
+    res.on('end', function() {
+      assert.equal(body, '/count/' + count);
+      responses++;
+      request(index + 1);
+    });
+  });
+}
+
+request(0);
+
+process.on('exit', function() {
+  assert.equal(requests, headerCounts.length);
+  assert.equal(responses, headerCounts.length);
+});
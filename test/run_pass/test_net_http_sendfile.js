@@ -0,0 +1,125 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var fs = require('fs');
+var http = require('http');
+
+var filePath = process.cwd() + '/resources/tobeornottobe.txt';
+// Lengths and ranges are in bytes, and the file is not all ASCII.
+var content = fs.readFileSync(filePath);
+
+var server = http.createServer(function(req, res) {
+  var path = req.url == '/missing' ? filePath + '.missing' : filePath;
+  res.sendFile(path);
+});
+
+server.listen(3094, 5);
+
+
+function get(headers, path, callback) {
+  http.get({port: 3094, path: path, headers: headers}, function(res) {
+    var chunks = [];
+    res.on('data', function(chunk) {
+      chunks.push(chunk);
+    });
+    res.on('end', function() {
+      callback(res, Buffer.concat(chunks).toString());
+    });
+  });
+}
+
+
+var etag;
+var lastModified;
+
+var tests = [
+  function(next) {
+    get({}, '/', function(res, body) {
+      assert.equal(res.statusCode, 200);
+      assert.equal(res.headers['Content-Type'], 'text/plain');
+      assert.equal(res.headers['Accept-Ranges'], 'bytes');
+      assert.equal(body, content.toString());
+      etag = res.headers['ETag'];
+      lastModified = res.headers['Last-Modified'];
+      assert(etag);
+      assert(lastModified);
+      next();
+    });
+  },
+  function(next) {
+    get({'Range': 'bytes=3-12'}, '/', function(res, body) {
+      assert.equal(res.statusCode, 206);
+      assert.equal(res.headers['Content-Range'],
+                   'bytes 3-12/' + content.length);
+      assert.equal(body, content.slice(3, 13).toString());
+      next();
+    });
+  },
+  function(next) {
+    get({'Range': 'bytes=-5'}, '/', function(res, body) {
+      assert.equal(res.statusCode, 206);
+      assert.equal(body, content.slice(content.length - 5).toString());
+      next();
+    });
+  },
+  function(next) {
+    get({'Range': 'bytes=' + content.length + '-'}, '/', function(res, body) {
+      assert.equal(res.statusCode, 416);
+      assert.equal(res.headers['Content-Range'], 'bytes */' + content.length);
+      next();
+    });
+  },
+  function(next) {
+    get({'If-None-Match': etag}, '/', function(res, body) {
+      assert.equal(res.statusCode, 304);
+      assert.equal(body, '');
+      next();
+    });
+  },
+  function(next) {
+    get({'If-Modified-Since': lastModified}, '/', function(res, body) {
+      assert.equal(res.statusCode, 304);
+      next();
+    });
+  },
+  function(next) {
+    get({}, '/missing', function(res, body) {
+      assert.equal(res.statusCode, 404);
+      next();
+    });
+  }
+];
+
+
+var done = 0;
+
+function runTest(index) {
+  if (index == tests.length) {
+    server.close();
+    return;
+  }
+  tests[index](function() {
+    done++;
+    runTest(index + 1);
+  });
+}
+
+runTest(0);
+
+
+process.on('exit', function() {
+  assert.equal(done, tests.length);
+});
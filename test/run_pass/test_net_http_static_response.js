@@ -0,0 +1,77 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var http = require('http');
+var net = require('net');
+
+var requests = [];
+
+var server = http.createServer(function(req, res) {
+  requests.push(req.method + ' ' + req.url);
+  res.writeHead(200, { 'Content-Length': 7 });
+  res.end('dynamic');
+});
+
+server.setStaticResponse('GET', '/static', {
+  headers: { 'Content-Type': 'text/plain' },
+  body: 'static'
+});
+server.setStaticResponse('HEAD', '/static', {
+  headers: { 'Content-Type': 'text/plain' },
+  body: 'static'
+});
+server.setStaticResponse('GET', '/removed', { body: 'removed' });
+server.setStaticResponse('GET', '/removed', null);
+
+assert.throws(function() {
+  server.setStaticResponse('FETCH', '/static', { body: '' });
+}, TypeError);
+
+server.listen(3096, 5);
+
+// Static and dynamic requests in a row on one connection, the last one
+// closing it.
+var request = 'GET /static HTTP/1.1\r\n\r\n' +
+              'GET /static?query=1 HTTP/1.1\r\n\r\n' +
+              'HEAD /static HTTP/1.1\r\n\r\n' +
+              'GET /removed HTTP/1.1\r\n\r\n' +
+              'POST /static HTTP/1.1\r\nContent-Length: 0\r\n\r\n' +
+              'GET /static HTTP/1.1\r\nConnection: close\r\n\r\n';
+
+var received = '';
+var socket = net.connect(3096, 'localhost', function() {
+  socket.end(request);
+});
+socket.on('data', function(data) {
+  received += data.toString();
+});
+socket.on('close', function() {
+  server.close();
+});
+
+process.on('exit', function() {
+  var responses = received.split('HTTP/1.1 200 OK\r\n');
+  assert.equal(responses.length, 7);
+  assert(responses[1].indexOf('Content-Type: text/plain\r\n') >= 0);
+  assert(responses[1].indexOf('Content-Length: 6\r\n') >= 0);
+  assert.equal(responses[1].slice(-10), '\r\n\r\nstatic');
+  assert.equal(responses[2].slice(-10), '\r\n\r\nstatic');
+  assert.equal(responses[3].slice(-4), '\r\n\r\n');
+  assert.equal(responses[4].slice(-11), '\r\n\r\ndynamic');
+  assert.equal(responses[5].slice(-11), '\r\n\r\ndynamic');
+  assert.equal(responses[6].slice(-11), '\r\n\r\ndynamic');
+  assert.equal(requests.join(), 'GET /removed,POST /static,GET /static');
+});
@@ -0,0 +1,73 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+var http = require('http');
+var net = require('net');
+
+var paths = ['/a', '/b', '/c', '/d'];
+var requests = [];
+
+var server = http.createServer(function(req, res) {
+  requests.push(req.url);
+
+  // Later requests are answered first, but their responses have to wait for
+  // the ones before them.
+  var delay = (paths.length - paths.indexOf(req.url)) * 20;
+  setTimeout(function() {
+    res.writeHead(200, { 'Content-Length': req.url.length });
+    res.end(req.url);
+  }, delay);
+});
+
+// Reading pauses while two responses are pending.
+server.maxPendingResponses = 2;
+// The responses are still sent once the client has ended its side.
+server.httpAllowHalfOpen = true;
+
+server.listen(3088, 5);
+
+var received = '';
+var client = net.connect(3088, '127.0.0.1', function() {
+  var message = '';
+  for (var i = 0; i < paths.length; i++) {
+    message += 'GET ' + paths[i] + ' HTTP/1.1\r\nHost: localhost\r\n\r\n';
+  }
+  // All the requests go in one write, and the client then ends its side.
+  client.end(message);
+});
+
+client.on('data', function(data) {
+  received += data.toString();
+});
+
+client.on('end', function() {
+  server.close();
+});
+
+process.on('exit', function() {
+  assert.equal(requests.join(), paths.join());
+
+  var bodies = [];
+  var index = 0;
+  var end;
+  while ((end = received.indexOf('\r\n\r\n', index)) >= 0) {
+    var head = received.substring(index, end);
+    assert.equal(head.indexOf('HTTP/1.1 200 OK'), 0);
+    assert.equal(head.indexOf('Connection: close'), -1);
+    bodies.push(received.substr(end + 4, 2));
+    index = end + 6;
+  }
+  assert.equal(bodies.join(), paths.join());
+});
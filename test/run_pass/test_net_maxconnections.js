@@ -0,0 +1,66 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var net = require('net');
+var assert = require('assert');
+
+
+var port = 22716;
+var clients = 6;
+var maxConnections = 2;
+
+
+// Serves each connection for a while, so the others have to wait.
+var active = 0;
+var maxActive = 0;
+var served = 0;
+var server = net.createServer({
+  maxConnections: maxConnections,
+  preallocate: 2
+}, function(socket) {
+  active++;
+  maxActive = Math.max(maxActive, active);
+  socket.on('close', function() {
+    active--;
+    if (++served == clients) {
+      server.close();
+    }
+  });
+  setTimeout(function() {
+    socket.end('ok');
+  }, 50);
+});
+server.listen(port);
+
+
+var replies = 0;
+
+for (var i = 0; i < clients; ++i) {
+  var socket = net.connect(port, '127.0.0.1');
+  socket.on('data', function(data) {
+    assert.equal(data.toString(), 'ok');
+    replies++;
+  });
+}
+
+
+process.on('exit', function(code) {
+  assert.equal(code, 0);
+  assert.equal(server.maxConnections, maxConnections);
+  assert.equal(served, clients);
+  assert.equal(replies, clients);
+  assert(maxActive <= maxConnections);
+});
@@ -0,0 +1,75 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var net = require('net');
+var assert = require('assert');
+
+
+var port = 22714;
+var rounds = 20;
+
+
+// Answers every small request at once.
+var server = net.createServer({
+  noDelay: true,
+  recvBufferSize: 16 * 1024,
+  sendBufferSize: 16 * 1024,
+  fastOpen: true
+}, function(socket) {
+  socket.on('data', function(data) {
+    socket.write(data);
+  });
+  socket.on('end', function() {
+    socket.end();
+  });
+});
+server.listen(port);
+
+
+var replies = 0;
+var ended = false;
+
+var socket = net.connect({
+  port: port,
+  host: '127.0.0.1',
+  noDelay: true,
+  recvBufferSize: 16 * 1024,
+  sendBufferSize: 16 * 1024,
+  fastOpen: true
+}, function() {
+  assert.equal(socket.setNoDelay(false), socket);
+  assert.equal(socket.setNoDelay(), socket);
+  socket.write('ping');
+});
+socket.on('data', function(data) {
+  assert.equal(data.toString(), 'ping');
+  if (++replies < rounds) {
+    socket.write('ping');
+  } else {
+    socket.end();
+  }
+});
+socket.on('end', function() {
+  ended = true;
+  server.close();
+});
+
+
+process.on('exit', function(code) {
+  assert.equal(code, 0);
+  assert.equal(replies, rounds);
+  assert.equal(ended, true);
+});
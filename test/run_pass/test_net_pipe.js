@@ -0,0 +1,77 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var net = require('net');
+var assert = require('assert');
+
+
+var echoPort = 22712;
+var proxyPort = 22713;
+var greeting = 'hi';
+var payload = new Buffer(64 * 1024);
+payload.fill('x');
+
+
+// Greets every connection, and then echoes the data back.
+var echoServer = net.createServer(function(socket) {
+  socket.write(greeting);
+  socket.on('data', function(data) {
+    socket.write(data);
+  });
+  socket.on('end', function() {
+    socket.end();
+  });
+});
+echoServer.listen(echoPort);
+
+
+// Connects both ends natively, once the upstream connection is made.
+var proxyServer = net.createServer(function(client) {
+  var upstream = net.connect(echoPort, '127.0.0.1', function() {
+    assert.equal(client.pipe(upstream), upstream);
+    assert.equal(upstream.pipe(client), client);
+  });
+});
+proxyServer.listen(proxyPort);
+
+
+var received = 0;
+var sent = false;
+var ended = false;
+
+var socket = net.connect(proxyPort, '127.0.0.1');
+socket.on('data', function(data) {
+  received += data.length;
+  if (!sent) {
+    sent = true;
+    socket.write(payload);
+  }
+  if (received == greeting.length + payload.length) {
+    socket.end();
+  }
+});
+socket.on('end', function() {
+  ended = true;
+  echoServer.close();
+  proxyServer.close();
+});
+
+
+process.on('exit', function(code) {
+  assert.equal(code, 0);
+  assert.equal(received, greeting.length + payload.length);
+  assert.equal(ended, true);
+});
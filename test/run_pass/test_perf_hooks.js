@@ -0,0 +1,108 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var perf_hooks = require('perf_hooks');
+
+var performance = perf_hooks.performance;
+
+// now() is monotonic, and counts from the startup of the process.
+var first = performance.now();
+var second = performance.now();
+assert(first > 0);
+assert(second >= first);
+assert(Math.abs(performance.timeOrigin + first - Date.now()) < 1000);
+
+// Marks and measures between them.
+var start = performance.mark('start');
+assert.equal(start.name, 'start');
+assert.equal(start.entryType, 'mark');
+assert.equal(start.duration, 0);
+for (var i = 0; i < 10000; i++) {}
+performance.mark('end');
+
+var measure = performance.measure('loop', 'start', 'end');
+assert.equal(measure.entryType, 'measure');
+assert.equal(measure.startTime, start.startTime);
+assert(measure.duration >= 0);
+assert.equal(performance.measure('sinceStart').startTime, 0);
+
+assert.equal(performance.getEntries().length, 4);
+assert.equal(performance.getEntriesByType('mark').length, 2);
+assert.equal(performance.getEntriesByName('loop')[0], measure);
+assert.equal(performance.getEntriesByName('loop', 'mark').length, 0);
+assert.throws(function() {
+  performance.measure('missing', 'nothing');
+}, Error);
+
+performance.clearMarks('start');
+assert.equal(performance.getEntriesByType('mark').length, 1);
+performance.clearMarks();
+performance.clearMeasures();
+assert.equal(performance.getEntries().length, 0);
+
+// A histogram of exact values below 2 * 10^figures.
+var histogram = perf_hooks.createHistogram({ highest: 1000, figures: 2 });
+assert.equal(histogram.count, 0);
+assert(isNaN(histogram.mean));
+assert.equal(histogram.percentile(50), 0);
+
+for (var i = 1; i <= 100; i++) {
+  histogram.record(i);
+}
+assert.equal(histogram.count, 100);
+assert.equal(histogram.min, 1);
+assert.equal(histogram.max, 100);
+assert.equal(histogram.mean, 50.5);
+assert(Math.abs(histogram.stddev - 28.866) < 0.001);
+assert.equal(histogram.percentile(50), 50);
+assert.equal(histogram.percentile(99), 99);
+assert.equal(histogram.percentile(100), 100);
+
+// Larger values fall into coarser buckets, within the precision.
+histogram.record(999);
+assert(Math.abs(histogram.percentile(100) - 999) <= 999 / 100);
+histogram.record(5000);
+assert.equal(histogram.exceeds, 1);
+assert.equal(histogram.count, 101);
+
+assert.throws(function() {
+  histogram.record(-1);
+}, RangeError);
+assert.throws(function() {
+  histogram.percentile(101);
+}, RangeError);
+assert.throws(function() {
+  perf_hooks.createHistogram({ lowest: 10, highest: 15 });
+}, RangeError);
+assert.throws(function() {
+  perf_hooks.createHistogram({ figures: 6 });
+}, RangeError);
+
+histogram.reset();
+assert.equal(histogram.count, 0);
+assert.equal(histogram.exceeds, 0);
+
+// recordDelta() records the nanoseconds between its calls.
+var deltas = perf_hooks.createHistogram();
+assert(deltas.byteLength > 0);
+deltas.recordDelta();
+assert.equal(deltas.count, 0);
+for (var i = 0; i < 10; i++) {
+  deltas.recordDelta();
+}
+assert.equal(deltas.count, 10);
+assert(deltas.min >= 0);
+assert(deltas.max >= deltas.min);
@@ -0,0 +1,47 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var fs = require('fs');
+
+var cacheDir = process.cwd() + '/resources/code_cache';
+var filename = cacheDir + '/module.js';
+var source = 'module.exports = function(a) { return a + exports.b; };\n' +
+             'exports.b = 2;';
+
+if (!fs.existsSync(cacheDir)) {
+  fs.mkdirSync(cacheDir);
+}
+
+function load() {
+  var module = { exports: {} };
+  var fn = process.compileCached(filename, source, cacheDir);
+  fn.call(module.exports, module.exports, require, module);
+  return module.exports;
+}
+
+// The first load saves the cache, and the second one runs it when the code
+// cache is enabled.
+assert.equal(load()(1), 3);
+assert.equal(load()(40), 42);
+
+assert.throws(function() {
+  process.compileCached(filename, 'var = 1;', cacheDir);
+}, SyntaxError);
+
+fs.readdirSync(cacheDir).forEach(function(name) {
+  fs.unlinkSync(cacheDir + '/' + name);
+});
+fs.rmdirSync(cacheDir);
@@ -0,0 +1,66 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+
+var before = process.gcStats();
+
+assert.equal(typeof before.count, 'number');
+assert(before.lastPause >= 0);
+assert(before.survival >= 0 && before.survival <= 100);
+assert(before.liveSize >= 0);
+assert(before.freeSegments >= 0);
+
+assert.throws(function() {
+  process.setGcTrigger({growth: 100, reserve: 101});
+}, RangeError);
+
+process.setGcTrigger({growth: 100, minInterval: 10, reserve: 10});
+
+var garbage = [];
+for (var i = 0; i < 2000; i++) {
+  garbage.push({index: i, name: 'object ' + i});
+  if (garbage.length > 100) {
+    garbage = [];
+  }
+}
+
+var after = process.gcStats();
+assert(after.count >= before.count);
+assert(after.growth >= 100);
+assert(after.triggerSize > 0);
+assert(after.triggerSize >= after.liveSize);
+
+process.setGcTrigger({growth: 0});
+assert.equal(process.gcStats().triggerSize, 0);
+
+// The wraps of the collected buffers are destroyed between the iterations
+// of the event loop.
+assert.equal(typeof after.finalizers, 'number');
+var buffers = [];
+for (var i = 0; i < 2000; i++) {
+  buffers.push(new Buffer(16));
+  if (buffers.length > 100) {
+    buffers = [];
+  }
+}
+
+var iterations = 0;
+(function waitFinalizers() {
+  if (process.gcStats().finalizers > 0) {
+    assert(++iterations < 100);
+    setTimeout(waitFinalizers, 0);
+  }
+})();
@@ -0,0 +1,42 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+
+var before = process.loopStats();
+
+setTimeout(function() {
+  // Keep the loop busy for a while.
+  var start = Date.now();
+  while (Date.now() - start < 5) {
+  }
+
+  setTimeout(function() {
+    var stats = process.loopStats();
+
+    assert(stats.iterations > before.iterations);
+    assert(stats.idleTime >= before.idleTime);
+    assert(stats.callbackTime >= 5);
+    assert(stats.jobTime >= 0);
+    assert(stats.gcTime >= 0);
+    assert(stats.maxLag >= 5);
+
+    var counted = 0;
+    for (var i = 0; i < stats.lagHistogram.length; ++i) {
+      counted += stats.lagHistogram[i];
+    }
+    assert.equal(stats.lagHistogram.length, 8);
+    assert.equal(counted, stats.iterations);
+  }, 10);
+}, 10);
@@ -0,0 +1,55 @@
+/* Copyright 2016-2020 Gyeonghwan Hong, Eunsoo Park, Sungkyunkwan University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var fs = require('fs');
+
+var profiler = process.memoryProfiler;
+var categories = ['size', 'time', 'pmu', 'cptl', 'segment', 'jsobject',
+                  'count', 'sampling', 'opcode'];
+
+categories.forEach(function(category) {
+  var isBuiltIn = profiler.enable(category);
+  assert.equal(profiler.isEnabled(category), isBuiltIn);
+
+  profiler.disable(category);
+  assert.equal(profiler.isEnabled(category), false);
+});
+
+var samplesPath = process.cwd() + '/resources/sampling.folded';
+if (profiler.writeHeapSamples(samplesPath)) {
+  assert.equal(fs.existsSync(samplesPath), true);
+  fs.unlinkSync(samplesPath);
+}
+
+var snapshotPath = process.cwd() + '/resources/heap.snapshot';
+var retained = { child: { values: [1, 2, 3] } };
+if (profiler.writeHeapSnapshot(snapshotPath)) {
+  var snapshot = fs.readFileSync(snapshotPath).toString();
+  assert.equal(snapshot.indexOf('heap-snapshot '), 0);
+  assert.notEqual(snapshot.indexOf('\nE '), -1);
+  fs.unlinkSync(snapshotPath);
+}
+assert.equal(retained.child.values.length, 3);
+
+profiler.disable('all');
+assert.equal(profiler.isEnabled('all'), false);
+
+assert.throws(function() {
+  profiler.enable('unknown');
+});
+assert.throws(function() {
+  profiler.isEnabled(1);
+});
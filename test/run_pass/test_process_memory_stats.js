@@ -0,0 +1,54 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+
+var stats = process.memoryStats();
+assert(stats.jsHeap > 0);
+assert(stats.jsHeapSize >= stats.jsHeap);
+assert(stats.uvHeap >= 0);
+assert(stats.native > 0);
+assert.equal(stats.budget, 0);
+assert.equal(stats.pressure, 0);
+
+assert.throws(function() {
+  process.setMemoryBudget({budget: 65536, moderate: 90, critical: 80});
+}, RangeError);
+assert.throws(function() {
+  process.setMemoryBudget({budget: 65536, critical: 101});
+}, RangeError);
+
+// A budget below the usage puts the memory under critical pressure, measured
+// at the end of each iteration of the event loop and by memoryStats().
+process.setMemoryBudget({budget: 1024});
+assert.equal(process.memoryStats().budget, 1024);
+
+function nextIteration(callback) {
+  setTimeout(function() {
+    setTimeout(callback, 0);
+  }, 0);
+}
+
+nextIteration(function() {
+  var critical = process.memoryStats();
+  assert.equal(critical.pressure, 2);
+  assert(critical.reliefs > stats.reliefs);
+
+  // Turning the governor off ends the pressure.
+  process.setMemoryBudget({budget: 0});
+  nextIteration(function() {
+    assert.equal(process.memoryStats().pressure, 0);
+  });
+});
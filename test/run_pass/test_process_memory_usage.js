@@ -0,0 +1,55 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+
+var usage = process.memoryUsage();
+assert(usage.jsHeap > 0);
+assert(usage.jsHeapPeak >= usage.jsHeap);
+assert(usage.jsHeapSize >= usage.jsHeapPeak);
+assert(usage.jsPoolFree >= 0 && usage.jsPoolFree <= usage.jsHeap);
+assert(usage.uvHeap >= 0);
+assert(usage.native > 0);
+assert(usage.nativePoolFree >= 0);
+
+var segments = usage.segments;
+assert.equal(segments.occupancy.length, segments.count);
+assert(segments.utilization >= 0 && segments.utilization <= 100);
+var occupied = 0;
+segments.occupancy.forEach(function(size) {
+  assert(size <= segments.size);
+  occupied += size;
+});
+assert.equal(occupied, segments.occupied);
+
+// Buffers are counted in the native memory, and the peak keeps their garbage.
+var buffers = [];
+for (var i = 0; i < 16; i++) {
+  buffers.push(new Buffer(2048));
+}
+var grown = process.memoryUsage();
+assert(grown.buffers >= usage.buffers + 16 * 2048);
+assert(grown.native >= grown.buffers);
+
+buffers = null;
+var gcCount = grown.gcCount;
+var garbage;
+for (var j = 0; j < 2048; j++) {
+  garbage = {index: j, name: 'garbage' + j};
+}
+var collected = process.memoryUsage();
+assert(collected.jsHeapPeak >= grown.jsHeapPeak);
+assert(collected.gcCount >= gcCount);
+assert(collected.gcPauseTotal >= 0);
@@ -35,7 +35,26 @@ process.nextTick(function() {
 });
 
 
+// Callbacks get their arguments, and run in the order they were queued, also
+// when more are queued than the initial room of the queue.
+var order = [];
+for (var i = 0; i < 40; ++i) {
+  process.nextTick(function(index, name) {
+    assert.equal(name, 'tick');
+    order.push(index);
+  }, i, 'tick');
+}
+
+assert.throws(function() {
+  process.nextTick('callback');
+}, TypeError);
+
+
 process.on('exit', function(code) {
   assert.equal(code, 0);
   assert.equal(tickTrace, "12345");
+  assert.equal(order.length, 40);
+  for (var i = 0; i < order.length; ++i) {
+    assert.equal(order[i], i);
+  }
 });
@@ -0,0 +1,58 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+
+// The return value of the function is passed on.
+assert.equal(process.noGC(function() {
+  return 1 + 2;
+}), 3);
+
+// A nested region runs within the outer one.
+assert.equal(process.noGC(4096, function() {
+  return process.noGC(function() {
+    return 'nested';
+  });
+}), 'nested');
+
+// An exception of the function ends the region.
+assert.throws(function() {
+  process.noGC(function() {
+    throw new Error('thrown');
+  });
+}, Error);
+
+// A headroom larger than the heap cannot be reserved.
+var called = false;
+assert.throws(function() {
+  process.noGC(1024 * 1024 * 1024, function() {
+    called = true;
+  });
+}, RangeError);
+assert.equal(called, false);
+
+// Allocating past the headroom overruns the region.
+assert.throws(function() {
+  process.noGC(16, function() {
+    var objects = [];
+    for (var i = 0; i < 100; i++) {
+      objects.push({index: i});
+    }
+  });
+}, RangeError);
+
+assert.throws(function() {
+  process.noGC(4096);
+}, TypeError);
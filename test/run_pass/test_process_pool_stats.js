@@ -0,0 +1,46 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+var fs = require('fs');
+
+var path = process.cwd() + '/resources/tobeornottobe.txt';
+var count = 0;
+
+function stat() {
+  fs.stat(path, function(err, stats) {
+    assert.equal(err, null);
+    // The next request is made once this one is released.
+    if (++count < 4) {
+      setTimeout(stat, 0);
+      return;
+    }
+
+    var pool = process.poolStats()['fs'];
+    assert(pool.size > 0);
+    assert(pool.cap > 0);
+    // The request of this callback is released once it returns.
+    assert.equal(pool.inUse, 1);
+    assert.equal(pool.peak, 1);
+    assert.equal(pool.allocated, 1);
+    assert.equal(pool.reused, 3);
+    assert.equal(pool.free, 0);
+  });
+}
+
+stat();
+
+process.on('exit', function() {
+  assert.equal(count, 4);
+});
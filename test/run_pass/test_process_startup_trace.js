@@ -0,0 +1,61 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+
+var phases = ['arguments', 'jerryInit', 'debugger', 'magicStrings', 'global',
+              'moduleList', 'process', 'iotjsJs'];
+
+function checkTrace(trace, reached) {
+  var sum = 0;
+  reached.forEach(function(phase) {
+    assert.equal(typeof trace[phase], 'number', phase);
+    assert(trace[phase] >= 0, phase);
+    sum += trace[phase];
+  });
+  assert(Math.abs(trace.total - sum) < 0.001);
+}
+
+// The main module is still loading, and the loop has not run.
+var trace = process.startupTrace();
+checkTrace(trace, phases);
+assert.equal(trace.mainModule, undefined);
+assert.equal(trace.firstLoop, undefined);
+
+// Unknown phases are ignored, and a phase ends only once.
+process._markStartup('unknown');
+process._markStartup('iotjsJs');
+assert.equal(process.startupTrace().iotjsJs, trace.iotjsJs);
+assert.equal(process.startupTrace().unknown, undefined);
+
+// The first iteration ends after the callbacks of its pass, so the timers
+// that run in that pass see no firstLoop yet.
+var checked = false;
+function checkLater(tries) {
+  setTimeout(function() {
+    var trace = process.startupTrace();
+    if (trace.firstLoop === undefined && tries > 0) {
+      checkLater(tries - 1);
+      return;
+    }
+    checkTrace(trace, phases.concat('mainModule', 'firstLoop'));
+    checked = true;
+  }, 10);
+}
+checkLater(10);
+
+process.on('exit', function() {
+  assert(checked);
+});
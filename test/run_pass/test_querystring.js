@@ -0,0 +1,59 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var querystring = require('querystring');
+
+var obj = querystring.parse('a=1&b=x%20y+z&a=2&&c&d=&e=%E2%82%AC');
+assert.equal(obj.a.length, 2);
+assert.equal(obj.a[0], '1');
+assert.equal(obj.a[1], '2');
+assert.equal(obj.b, 'x y z');
+assert.equal(obj.c, '');
+assert.equal(obj.d, '');
+assert.equal(obj.e, '\u20ac');
+
+// Malformed escapes are left as they are.
+obj = querystring.parse('bad=%zz&half=%4&invalid=%ff');
+assert.equal(obj.bad, '%zz');
+assert.equal(obj.half, '%4');
+assert.equal(obj.invalid, '%ff');
+
+// An '=' in the value is kept.
+obj = querystring.parse('expr=a=b');
+assert.equal(obj.expr, 'a=b');
+
+obj = querystring.parse('a:1;;b:2::3', ';;', ':');
+assert.equal(obj.a, '1');
+assert.equal(obj.b, '2::3');
+
+obj = querystring.parse('a=1&b=2&c=3', null, null, { maxKeys: 2 });
+assert.equal(obj.b, '2');
+assert.equal(obj.c, undefined);
+
+obj = querystring.parse('__proto__=1');
+assert.equal(obj.__proto__, '1');
+
+assert.equal(Object.keys(querystring.parse('')).length, 0);
+assert.equal(Object.keys(querystring.parse(undefined)).length, 0);
+
+assert.equal(querystring.stringify({ a: [1, 2], b: 'x y', c: true, d: null }),
+             'a=1&a=2&b=x%20y&c=true&d=');
+assert.equal(querystring.stringify({ a: 1, b: 2 }, ';', ':'), 'a:1;b:2');
+assert.equal(querystring.stringify('a'), '');
+
+assert.equal(querystring.escape('a b&c'), 'a%20b%26c');
+assert.equal(querystring.unescape('a%20b'), 'a b');
+assert.equal(querystring.unescape('%zz'), '%zz');
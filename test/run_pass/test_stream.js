@@ -122,11 +122,30 @@ assert.equal(readable2.read(0), null);
 readable2.push('qwerty');
 assert.equal(readable2.read(6), 'qwerty');
 
-// Throw not implemented Error when we trying to read less length data.
+// Partial reads, within a chunk and spanning chunks.
 readable2.push('new-data');
-assert.throws(function() {
-  readable2.read(1);
-}, Error);
+assert.equal(readable2.read(1), 'n');
+assert.equal(readable2.read(3), 'ew-');
+readable2.push('-more');
+readable2.push('-and');
+assert.equal(readable2.read(6), 'data-m');
+assert.equal(readable2._readableState.length, 7);
+assert.equal(readable2.read(100), 'ore-and');
+assert.equal(readable2.read(1), null);
+
+// Fixed-size frames out of chunks of other sizes.
+var frames = [];
+for (var i = 0; i < 10; i++) {
+  readable2.push(new Buffer('0123456789abc'.slice(0, i + 1)));
+}
+var frame;
+while (readable2._readableState.length >= 4 && (frame = readable2.read(4))) {
+  frames.push(frame.toString());
+}
+assert.equal(frames.join(),
+             '0010,1201,2301,2340,1234,5012,3456,0123,4567,0123,4567,8012,' +
+             '3456');
+assert.equal(readable2.read().toString(), '789');
 
 var readable3 = new Readable();
 var readable3End = false;
@@ -0,0 +1,88 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var stream = require('stream');
+var Transform = stream.Transform;
+var Splitter = stream.Splitter;
+
+// A transform with its functions given as options.
+var upper = new Transform({
+  transform: function(chunk, callback) {
+    callback(null, chunk.toString().toUpperCase());
+  },
+  flush: function(callback) {
+    callback(null, '!');
+  },
+});
+var upperData = '';
+var upperEnded = false;
+upper.on('data', function(data) {
+  upperData += data.toString();
+});
+upper.on('end', function() {
+  upperEnded = true;
+});
+upper.write('ab');
+upper.write('cd');
+upper.end();
+
+// Lines written in pieces, with the last one not ended.
+var lines = [];
+var splitter = new Splitter();
+splitter.on('data', function(frame) {
+  assert(Buffer.isBuffer(frame));
+  lines.push(frame.toString());
+});
+splitter.write('one\ntw');
+splitter.write('o\n\nthr');
+splitter.write('ee\nfour');
+splitter.end();
+
+// A delimiter of two bytes spanning the chunks.
+var records = [];
+var crlf = Splitter({ delimiter: '\r\n' });
+crlf.on('data', function(frame) {
+  records.push(frame.toString());
+});
+crlf.write('a\r');
+crlf.write('\nb\r\nc\r');
+crlf.write('x\r\n');
+crlf.end();
+
+// A frame growing beyond maxLength without its delimiter.
+var frames = [];
+var bounded = new Splitter({ delimiter: 0, maxLength: 4 });
+bounded.on('data', function(frame) {
+  frames.push(frame.toString());
+});
+bounded.write(new Buffer([0x61, 0x62, 0, 0x63]));
+bounded.write('defg');
+bounded.end();
+
+assert.throws(function() {
+  new Splitter({ delimiter: '' });
+}, TypeError);
+assert.throws(function() {
+  new Splitter({ maxLength: 0 });
+}, TypeError);
+
+process.on('exit', function() {
+  assert.equal(upperData, 'ABCD!');
+  assert(upperEnded);
+  assert.equal(lines.join(), 'one,two,,three,four');
+  assert.equal(records.join(), 'a,b,c\rx');
+  assert.equal(frames.join(), 'ab,cdefg');
+});
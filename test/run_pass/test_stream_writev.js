@@ -0,0 +1,87 @@
+/* Copyright 2015-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+var assert = require('assert');
+var Writable = require('stream').Writable;
+
+var writable = Writable();
+var writes = [];
+var pending = null;
+var called = 0;
+
+writable._write = function(chunk, callback, onwrite) {
+  writes.push(chunk.toString());
+  pending = function() {
+    onwrite();
+    if (callback) {
+      callback(0);
+    }
+  };
+};
+
+writable._writev = function(chunks, callback, onwrite) {
+  writes.push(chunks.map(function(chunk) {
+    return chunk.toString();
+  }).join('|'));
+  pending = function() {
+    onwrite();
+    callback(0);
+  };
+};
+
+writable._readyToWrite();
+
+// Corked writes go down together.
+writable.cork();
+writable.write('header');
+writable.write('body', function(status) {
+  assert.equal(status, 0);
+  called++;
+});
+assert.equal(writes.length, 0);
+writable.uncork();
+assert.equal(writes.join(), 'header|body');
+pending();
+assert.equal(called, 1);
+
+// Writes queued during a write are coalesced.
+var large = new Buffer(600);
+writable.write(large);
+assert.equal(writes.length, 2);
+writable.write('a');
+writable.write('b', function() {
+  called++;
+});
+pending();
+assert.equal(writes.length, 3);
+assert.equal(writes[2], 'a|b');
+pending();
+assert.equal(called, 2);
+
+// Small writes of a tick are held back until the next tick.
+writable.write('x');
+writable.write('y');
+writable.write('z', function() {
+  called++;
+});
+assert.equal(writes.length, 3);
+
+process.nextTick(function() {
+  assert.equal(writes.length, 4);
+  assert.equal(writes[3], 'x|y|z');
+  pending();
+  assert.equal(called, 3);
+});
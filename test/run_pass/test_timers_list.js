@@ -0,0 +1,54 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+
+// Timeouts of the same duration run in the order they were set.
+var order = [];
+var timeouts = [];
+
+// Runs first, and clears one of the later timeouts.
+setTimeout(function() {
+  clearTimeout(timeouts[9]);
+}, 20);
+
+for (var i = 0; i < 10; ++i) {
+  timeouts.push(setTimeout(order.push.bind(order, i), 20));
+}
+
+// Cleared ones never run.
+clearTimeout(timeouts[3]);
+clearTimeout(timeouts[7]);
+
+// An interval sharing the duration keeps its own period.
+var ticks = 0;
+var interval = setInterval(function() {
+  if (++ticks == 3) {
+    clearInterval(interval);
+  }
+}, 20);
+
+// A timeout set from a callback waits for its whole duration.
+setTimeout(function() {
+  var start = Date.now();
+  setTimeout(function() {
+    assert(Date.now() - start >= 15);
+    order.push('late');
+  }, 20);
+}, 20);
+
+process.on('exit', function() {
+  assert.equal(order.join(), '0,1,2,4,5,6,8,late');
+  assert.equal(ticks, 3);
+});
@@ -0,0 +1,47 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+
+var start = Date.now();
+var lazyTime = 0;
+var exactTime = 0;
+
+// The timeout of 50 ms waits for the one of 100 ms, and both run in one
+// wakeup.
+var lazy = setTimeout(function() {
+  lazyTime = Date.now();
+  assert.equal(exactTime, 0);
+}, 50);
+assert.equal(lazy.setSlack(100), lazy);
+assert.equal(lazy.slack, 100);
+
+setTimeout(function() {
+  exactTime = Date.now();
+}, 100);
+
+// A timeout never runs before its delay, whatever its slack.
+setTimeout(function() {
+  assert(Date.now() - start >= 25);
+}, 30).setSlack(1000);
+
+// Bad slacks are none.
+assert.equal(setTimeout(function() {}, 1).setSlack('bad').slack, 0);
+assert.equal(setTimeout(function() {}, 1).setSlack(-5).slack, 0);
+
+process.on('exit', function() {
+  assert(lazyTime - start >= 95);
+  assert(exactTime - lazyTime < 5);
+});
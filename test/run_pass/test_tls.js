@@ -0,0 +1,92 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var fs = require('fs');
+var tls = require('tls');
+
+var port = 3051;
+var cert = fs.readFileSync(process.cwd() + '/resources/tls/server.crt');
+var key = process.cwd() + '/resources/tls/server.key';
+
+var connections = 0;
+var echoed = [];
+var reused = [];
+var rejected = false;
+
+var server = tls.createServer({cert: cert, key: key}, function(socket) {
+  connections++;
+  socket.pipe(socket);
+});
+
+server.listen(port, function() {
+  connect(null, function(session) {
+    // The second connection resumes the session of the first one.
+    connect(session, function() {
+      connectUntrusted();
+    });
+  });
+});
+
+
+function connect(session, callback) {
+  var message = 'Hello TLS ' + reused.length;
+  var received = '';
+
+  var socket = tls.connect({
+    port: port,
+    host: 'localhost',
+    ca: cert,
+    session: session
+  }, function() {
+    assert.equal(socket.authorized, true);
+    assert.equal(socket.authorizationError, null);
+    assert.equal(typeof socket.getProtocol(), 'string');
+    assert.equal(typeof socket.getCipher().name, 'string');
+    reused.push(socket.isSessionReused());
+    socket.end(message);
+  });
+
+  socket.on('data', function(data) {
+    received += data.toString();
+  });
+
+  socket.on('end', function() {
+    echoed.push(received);
+    callback(socket.getSession());
+  });
+}
+
+
+// Without the certificate of the server as trusted, the client ends the
+// handshake.
+function connectUntrusted() {
+  var socket = tls.connect({port: port, host: 'localhost'}, function() {
+    assert(false, 'the server is not trusted');
+  });
+
+  socket.on('error', function() {
+    rejected = true;
+    server.close();
+  });
+}
+
+
+process.on('exit', function() {
+  assert.equal(echoed.join(), 'Hello TLS 0,Hello TLS 1');
+  assert.equal(reused.join(), 'false,true');
+  assert.equal(connections >= 2, true);
+  assert.equal(rejected, true);
+});
@@ -0,0 +1,94 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var fs = require('fs');
+var tls = require('tls');
+
+var port = 3053;
+var cert = fs.readFileSync(process.cwd() + '/resources/tls/server.crt');
+var key = process.cwd() + '/resources/tls/server.key';
+
+var chunk = new Buffer(16 * 1024);
+chunk.fill('x');
+
+var collections = 0;
+var serverClosed = false;
+
+// The server writes until a write fails or the connection goes away.
+var server = tls.createServer({cert: cert, key: key}, function(socket) {
+  var closed = false;
+  socket.on('error', function() {});
+  socket.on('close', function() {
+    closed = true;
+    serverClosed = true;
+    server.close();
+  });
+
+  (function pump(err) {
+    if (!closed && !err) {
+      socket.write(chunk, pump);
+    }
+  })();
+});
+
+
+// Runs the GC until it has collected twice.
+function collect() {
+  var start = process.gcStats().gcCount;
+  for (var i = 0; process.gcStats().gcCount < start + 2; i++) {
+    assert(i < 100000);
+    var garbage = [];
+    for (var j = 0; j < 100; j++) {
+      garbage.push({ index: j });
+    }
+  }
+  collections++;
+}
+
+
+server.listen(port, function() {
+  var socket = tls.connect({port: port, host: 'localhost', ca: cert});
+  socket.once('data', function() {
+    // The socket keeps reading into the TLS object, which nothing refers to
+    // from now on.
+    var tcp = socket._handle._tcp;
+    tcp.owner = null;
+    tcp.onread = function() {};
+    socket.removeAllListeners();
+    socket = null;
+
+    setTimeout(function() {
+      collect();
+      (function waitFinalizers() {
+        if (process.gcStats().finalizers > 0) {
+          setTimeout(waitFinalizers, 0);
+          return;
+        }
+        // More data arrives after the TLS object is destroyed.
+        setTimeout(function() {
+          collect();
+          tcp.close();
+        }, 100);
+      })();
+    }, 0);
+  });
+});
+
+
+process.on('exit', function() {
+  assert.equal(collections, 2);
+  assert(serverClosed);
+});
@@ -143,6 +143,14 @@ assert.equal(util.format('%d%d', 5001), '5001%d');
 assert.equal(util.format('%s%d%s%d', 'IoT.js ', 5001), 'IoT.js 5001%s%d');
 assert.equal(util.format('%d%% %s', 100, 'IoT.js'), '100% IoT.js');
 assert.equal(util.format(new Error('format')), 'Error: format');
+assert.equal(util.format('%x %s 100%', 'IoT.js'), '%x IoT.js 100%');
+assert.equal(util.format('%s', undefined, null), 'undefined null');
+assert.equal(util.format(1, 'a', [2, 3]), '1 a 2,3');
+assert.equal(util.format('\u00e9%s\ud83d\ude00', '\u00fc'),
+             '\u00e9\u00fc\ud83d\ude00');
+assert.throws(function() {
+  util.format('%s', { toString: function() { throw new Error('boom'); } });
+}, Error);
 
 var err1 = util.errnoException(3008, 'syscall', 'original message');
 assert.equal(err1 instanceof Error, true);
@@ -0,0 +1,143 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var http = require('http');
+var net = require('net');
+var websocket = require('websocket');
+
+var port = 3297;
+var received = [];
+var pongs = 0;
+var closes = [];
+var errors = [];
+var rejected = null;
+var failed = null;
+
+var server = http.createServer(function(req, res) {
+  res.end('plain');
+});
+
+var wss = new websocket.Server({server: server, path: '/echo'});
+
+wss.on('connection', function(ws, req) {
+  assert.equal(req.url, '/echo');
+  ws.on('message', function(data, isBinary) {
+    if (data === 'protocol') {
+      ws.close(4000, 'bye');
+      return;
+    }
+    ws.send(data, {binary: isBinary});
+  });
+  ws.on('error', function(err) {
+    errors.push(err.code);
+  });
+  ws.on('close', function(code, reason) {
+    closes.push('server ' + code + ' ' + reason);
+  });
+});
+
+server.listen(port, function() {
+  var ws = websocket.connect('ws://localhost:' + port + '/echo', function() {
+    assert.equal(ws.readyState, websocket.WebSocket.OPEN);
+    ws.send('hello');
+    ws.send(new Buffer([1, 2, 3, 250]));
+    // Echoed as one message of the fragments.
+    ws.send(new Array(200).join('x'), {fragmentSize: 50});
+    ws.send(new Buffer(70000).fill(7));
+    ws.ping('are you there');
+  });
+
+  ws.on('pong', function(data) {
+    assert.equal(data.toString(), 'are you there');
+    pongs++;
+  });
+
+  ws.on('message', function(data, isBinary) {
+    received.push(isBinary ? data : data.toString());
+    if (received.length == 4) {
+      ws.send('protocol');
+    }
+  });
+
+  ws.on('close', function(code, reason) {
+    closes.push('client ' + code + ' ' + reason);
+    rejectWrongPath();
+  });
+});
+
+
+// A request for another path is refused.
+function rejectWrongPath() {
+  var other = websocket.connect('ws://localhost:' + port + '/other');
+  other.on('error', function(err) {
+    rejected = err.message;
+  });
+  other.on('close', function() {
+    breakProtocol();
+  });
+}
+
+
+// An unmasked frame from a client fails the connection with 1002.
+function breakProtocol() {
+  var socket = net.connect(port, 'localhost', function() {
+    socket.write('GET /echo HTTP/1.1\r\n' +
+                 'Host: localhost\r\n' +
+                 'Upgrade: websocket\r\n' +
+                 'Connection: Upgrade\r\n' +
+                 'Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n' +
+                 'Sec-WebSocket-Version: 13\r\n\r\n');
+  });
+
+  var response = new Buffer(0);
+  socket.on('data', function(data) {
+    if (response.length == 0) {
+      socket.write(new Buffer([0x81, 0x02, 0x68, 0x69]));
+    }
+    response = Buffer.concat([response, data]);
+  });
+  socket.on('end', function() {
+    failed = response;
+    socket.end();
+    wss.close();
+    server.close();
+  });
+}
+
+
+process.on('exit', function() {
+  assert.equal(received.length, 4);
+  assert.equal(received[0], 'hello');
+  assert.equal(received[1].toString('hex'), '010203fa');
+  assert.equal(received[2], new Array(200).join('x'));
+  assert.equal(received[3].length, 70000);
+  assert.equal(received[3].readUInt8(69999), 7);
+  assert.equal(pongs, 1);
+
+  assert.equal(closes.length, 3);
+  assert(closes.indexOf('client 4000 bye') >= 0);
+  assert(closes.indexOf('server 4000 ') >= 0);
+  assert(closes.indexOf('server 1002 ') >= 0);
+  assert.equal(JSON.stringify(errors), JSON.stringify([1002]));
+  assert.equal(rejected, 'Unexpected server response: 404');
+
+  // The accept key of the example of RFC 6455, and a close frame of 1002.
+  var text = failed.slice(0, failed.length - 4).toString();
+  assert(text.indexOf('Sec-WebSocket-Accept: ' +
+                      's3pPLMBiTxaQ9kYGzzhZRbK+xOo=') > 0);
+  var frame = failed.slice(failed.length - 4);
+  assert.equal(frame.toString('hex'), '880203ea');
+});
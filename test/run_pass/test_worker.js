@@ -0,0 +1,88 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+var assert = require('assert');
+var worker = require('worker');
+
+if (worker.isMainThread) {
+  assert.equal(worker.parentPort, null);
+  assert.equal(worker.threadId, 0);
+
+  var replies = [];
+  var exits = [];
+
+  // The first worker echoes what it gets until it is terminated.
+  var echo = new worker.Worker(process.argv[1], {
+    workerData: { role: 'echo' }
+  });
+  assert.equal(echo.threadId, 1);
+
+  echo.on('message', function(message) {
+    replies.push(message);
+    if (replies.length == 3) {
+      echo.terminate(function(err, code) {
+        exits.push(['echo', code]);
+      });
+    }
+  });
+
+  echo.postMessage({ a: [1, 2] });
+  echo.postMessage('text');
+  // Large enough to arrive in several chunks.
+  var big = new Buffer(100000);
+  big.fill(7);
+  echo.postMessage(big);
+
+  // The second one sends one result and is done.
+  var sum = new worker.Worker(process.argv[1], {
+    workerData: { role: 'sum', values: [1, 2, 3, 4] }
+  });
+  assert.equal(sum.threadId, 2);
+
+  var result;
+  sum.on('message', function(message) {
+    result = message;
+  });
+  sum.on('exit', function(code) {
+    exits.push(['sum', code]);
+  });
+
+  process.on('exit', function() {
+    assert.equal(JSON.stringify(replies[0]), JSON.stringify({ a: [1, 2] }));
+    assert.equal(replies[1], 'text');
+    assert.equal(Buffer.isBuffer(replies[2]), true);
+    assert.equal(replies[2].length, 100000);
+    assert.equal(replies[2].readUInt8(99999), 7);
+    assert.equal(result, 10);
+    assert.equal(JSON.stringify(exits.sort()),
+                 JSON.stringify([['echo', 1], ['sum', 0]]));
+  });
+} else {
+  assert.notEqual(worker.parentPort, null);
+
+  var data = worker.workerData;
+  if (data.role == 'echo') {
+    assert.equal(worker.threadId, 1);
+    worker.parentPort.on('message', function(message) {
+      worker.parentPort.postMessage(message);
+    });
+  } else {
+    assert.equal(worker.threadId, 2);
+    var total = 0;
+    for (var i = 0; i < data.values.length; i++) {
+      total += data.values[i];
+    }
+    worker.parentPort.postMessage(total);
+  }
+}
@@ -0,0 +1,70 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var assert = require('assert');
+var worker = require('worker');
+
+var COUNT = 200;
+
+if (worker.isMainThread) {
+  // The rings are small, so that messages wait for room in both directions.
+  var echo = new worker.Worker(process.argv[1], { sharedMemory: 4096 });
+
+  assert.throws(function() {
+    echo.postMessage(new Buffer(4096));
+  }, RangeError);
+
+  var replies = [];
+  echo.on('message', function(message) {
+    replies.push(message);
+    if (replies.length == COUNT) {
+      echo.terminate();
+    }
+  });
+
+  var exitCode;
+  echo.on('exit', function(code) {
+    exitCode = code;
+  });
+
+  for (var i = 0; i < COUNT; i++) {
+    if (i % 2) {
+      var chunk = new Buffer(1000);
+      chunk.fill(i & 0xff);
+      echo.postMessage(chunk);
+    } else {
+      echo.postMessage({ seq: i, values: [i, 'v' + i] });
+    }
+  }
+
+  process.on('exit', function() {
+    assert.equal(replies.length, COUNT);
+    for (var i = 0; i < COUNT; i++) {
+      if (i % 2) {
+        assert.equal(Buffer.isBuffer(replies[i]), true);
+        assert.equal(replies[i].length, 1000);
+        assert.equal(replies[i].readUInt8(999), i & 0xff);
+      } else {
+        assert.equal(replies[i].seq, i);
+        assert.equal(replies[i].values[1], 'v' + i);
+      }
+    }
+    assert.equal(exitCode, 1);
+  });
+} else {
+  worker.parentPort.on('message', function(message) {
+    worker.parentPort.postMessage(message);
+  });
+}
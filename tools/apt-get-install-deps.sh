@@ -17,3 +17,16 @@
 sudo apt-get update -q
 sudo apt-get install -q -y \
     cmake gcc valgrind clang-format-3.8
+
+# The tls and https modules run on mbedTLS 2.x, which Ubuntu trusty does not
+# package.
+MBEDTLS_TAG=mbedtls-2.16.12
+MBEDTLS_ROOT=$(mktemp -d)
+git clone -q --depth 1 -b $MBEDTLS_TAG \
+    https://github.com/Mbed-TLS/mbedtls.git $MBEDTLS_ROOT
+cmake -B$MBEDTLS_ROOT/build -H$MBEDTLS_ROOT \
+    -DUSE_SHARED_MBEDTLS_LIBRARY=ON -DENABLE_PROGRAMS=OFF -DENABLE_TESTING=OFF
+make -C $MBEDTLS_ROOT/build -j2
+sudo make -C $MBEDTLS_ROOT/build install
+sudo ldconfig
+rm -rf $MBEDTLS_ROOT
@@ -0,0 +1,224 @@
+#!/usr/bin/env python
+
+# Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import signal
+import subprocess
+import sys
+
+from common_py import path
+from common_py.system.filesystem import FileSystem as fs
+
+
+BENCH_DIR = fs.join(path.TEST_ROOT, 'bench')
+BENCH_PREFIX = 'BENCH '
+
+
+class TimeoutException(Exception):
+    pass
+
+
+def alarm_handler(signum, frame):
+    raise TimeoutException
+
+
+def get_args():
+    parser = argparse.ArgumentParser(
+        description='Run the benchmarks of test/bench, and compare the '
+                    'results of two binaries with --base and --new.')
+
+    parser.add_argument('iotjs', action='store', nargs='?',
+                        help='path to the iotjs binary file')
+    parser.add_argument('--base', action='store',
+                        help='path to the base iotjs binary to compare')
+    parser.add_argument('--new', action='store',
+                        help='path to the new iotjs binary to compare')
+    parser.add_argument('--filter', action='store', default='',
+                        help='run only the benchmark files containing this')
+    parser.add_argument('--repeat', action='store', default=3, type=int,
+                        help='runs of each benchmark, of which the median '
+                             'is reported')
+    parser.add_argument('--scale', action='store', default=1, type=float,
+                        help='scale of the operation counts')
+    parser.add_argument('--timeout', action='store', default=120, type=int,
+                        help='timeout for a benchmark file in seconds')
+    parser.add_argument('--output', action='store', metavar='file',
+                        help='write the JSON report to this file, and a '
+                             'table to the standard output')
+
+    args = parser.parse_args()
+
+    if bool(args.base) != bool(args.new):
+        parser.error('--base and --new are given together')
+    if not args.iotjs and not args.base:
+        parser.error('an iotjs binary, or --base and --new, are required')
+    if args.iotjs and args.base:
+        parser.error('give either an iotjs binary, or --base and --new')
+
+    return args
+
+
+def bench_files(name_filter):
+    return sorted(name for name in os.listdir(BENCH_DIR)
+                  if name.startswith('bench_') and name.endswith('.js') and
+                  name_filter in name)
+
+
+def run_file(iotjs, bench_file, options):
+    """Runs one benchmark file, and returns its results by name."""
+    env = dict(os.environ)
+    env['IOTJS_BENCH_SCALE'] = str(options.scale)
+
+    signal.alarm(options.timeout)
+    try:
+        process = subprocess.Popen(args=[iotjs, fs.join('bench', bench_file)],
+                                   cwd=path.TEST_ROOT, env=env,
+                                   stdout=subprocess.PIPE,
+                                   stderr=subprocess.STDOUT)
+        output = process.communicate()[0]
+        signal.alarm(0)
+    except TimeoutException:
+        process.kill()
+        print('  TIMEOUT: %s' % bench_file, file=sys.stderr)
+        return {}
+
+    results = {}
+    for line in output.decode('utf-8', 'replace').splitlines():
+        if line.startswith(BENCH_PREFIX):
+            result = json.loads(line[len(BENCH_PREFIX):])
+            results[result['name']] = result
+
+    if process.returncode != 0:
+        print('  FAIL: %s (exit code %d)' % (bench_file, process.returncode),
+              file=sys.stderr)
+
+    return results
+
+
+def median_result(runs):
+    """The run with the median throughput, so that its latencies match."""
+    runs = sorted(runs, key=lambda result: result['opsPerSec'])
+    return runs[len(runs) // 2]
+
+
+def run_benchmarks(iotjs, options):
+    results = {}
+    for bench_file in bench_files(options.filter):
+        runs = {}
+        for _ in range(max(1, options.repeat)):
+            for name, result in run_file(iotjs, bench_file, options).items():
+                runs.setdefault(name, []).append(result)
+
+        for name, name_runs in runs.items():
+            results[name] = median_result(name_runs)
+
+    return results
+
+
+def change_percent(base, new):
+    if not base:
+        return None
+    return round((new - base) * 100.0 / base, 2)
+
+
+def compare(base_results, new_results):
+    comparison = {}
+    for name in sorted(set(base_results) | set(new_results)):
+        base = base_results.get(name)
+        new = new_results.get(name)
+        entry = {'base': base, 'new': new}
+        if base and new:
+            entry['change'] = {
+                'opsPerSec': change_percent(base['opsPerSec'],
+                                            new['opsPerSec']),
+                'p99': change_percent(base['latency']['p99'],
+                                      new['latency']['p99']),
+                'peakHeap': change_percent(base['peakHeap'],
+                                           new['peakHeap'])
+            }
+        comparison[name] = entry
+    return comparison
+
+
+def format_number(value):
+    if value is None:
+        return '-'
+    return '%g' % value
+
+
+def print_table(results):
+    print('| {0:<28} | {1:>12} | {2:>8} | {3:>8} | {4:>10} |'
+          .format('Benchmark', 'ops/s', 'p50 ms', 'p99 ms', 'peak heap'))
+    print('| {0} | {1} | {2} | {3} | {4} |'
+          .format('-' * 28, '-' * 12, '-' * 8, '-' * 8, '-' * 10))
+    for name in sorted(results):
+        result = results[name]
+        print('| {0:<28} | {1:>12} | {2:>8} | {3:>8} | {4:>10} |'
+              .format(name, result['opsPerSec'],
+                      format_number(result['latency']['p50']),
+                      format_number(result['latency']['p99']),
+                      result['peakHeap']))
+
+
+def print_comparison(comparison):
+    print('| {0:<28} | {1:>12} | {2:>12} | {3:>8} | {4:>8} | {5:>9} |'
+          .format('Benchmark', 'base ops/s', 'new ops/s', 'ops/s %',
+                  'p99 %', 'heap %'))
+    print('| {0} | {1} | {2} | {3} | {4} | {5} |'
+          .format('-' * 28, '-' * 12, '-' * 12, '-' * 8, '-' * 8, '-' * 9))
+    for name in sorted(comparison):
+        entry = comparison[name]
+        change = entry.get('change', {})
+        print('| {0:<28} | {1:>12} | {2:>12} | {3:>8} | {4:>8} | {5:>9} |'
+              .format(name,
+                      entry['base']['opsPerSec'] if entry['base'] else '-',
+                      entry['new']['opsPerSec'] if entry['new'] else '-',
+                      format_number(change.get('opsPerSec')),
+                      format_number(change.get('p99')),
+                      format_number(change.get('peakHeap'))))
+
+
+def main():
+    options = get_args()
+
+    # Define own alarm handler to handle timeout.
+    signal.signal(signal.SIGALRM, alarm_handler)
+
+    if options.base:
+        report = compare(run_benchmarks(options.base, options),
+                         run_benchmarks(options.new, options))
+    else:
+        report = run_benchmarks(options.iotjs, options)
+
+    if not options.output:
+        print(json.dumps(report, indent=2, sort_keys=True))
+        return
+
+    with open(options.output, 'w') as output_file:
+        json.dump(report, output_file, indent=2, sort_keys=True)
+
+    if options.base:
+        print_comparison(report)
+    else:
+        print_table(report)
+
+
+if __name__ == '__main__':
+    main()
@@ -62,8 +62,14 @@ def init_options():
     config_option = config['build_option']
     list_with_commas = ['iotjs-include-module','iotjs-exclude-module']
 
+    # The modules of an application given on the command line replace the
+    # ones the config includes.
+    has_app = any(arg.startswith('--iotjs-app') for arg in sys.argv)
+
     for opt_key in config_option:
         opt_val = config_option[opt_key]
+        if has_app and opt_key == 'iotjs-include-module':
+            continue
         if (opt_key in list_with_commas) and isinstance(opt_val, list):
             opt_val and argv.append('--%s=%s' % (opt_key, ','.join(opt_val)))
         elif isinstance(opt_val, basestring) and opt_val != '':
@@ -158,6 +164,11 @@ def init_options():
     parser.add_argument('--iotjs-minimal-profile',
         action='store_true', default=False,
         help='Build IoT.js with minimal profile')
+    parser.add_argument('--iotjs-app',
+        action='store', default='',
+        help='Specify the main file, or the directory, of the application '
+             'whose modules and JerryScript builtins are built in, instead '
+             'of the basic modules')
 
     parser.add_argument('--jerry-cmake-param',
         action='append', default=[],
@@ -179,6 +190,11 @@ def init_options():
         help='Specify the size of the JerryScript max heap size '
              '(default: %(default)s)')
 
+    parser.add_argument('--jerry-cpointer-32bit',
+        action='store_true', default=False,
+        help='Enable 32 bit compressed pointers of JerryScript, '
+             'for heaps larger than 512KB')
+
     parser.add_argument('--jerry-memstat',
         action='store_true', default=False,
         help='Enable JerryScript heap statistics')
@@ -208,6 +224,18 @@ def init_options():
     parser.add_argument('--no-snapshot',
         action='store_true', default=False,
         help='Disable snapshot generation for IoT.js')
+    parser.add_argument('--code-cache',
+        action='store_true', default=False,
+        help='Enable caching the byte code of required modules on disk '
+             '(directory given by the IOTJS_CODE_CACHE environment variable)')
+    parser.add_argument('--js-compress',
+        action='store_true', default=False,
+        help='Store the builtin JS modules compressed with LZ4, and '
+             'decompress each one when it is first required')
+    parser.add_argument('--probes',
+        action='store_true', default=False,
+        help='Build in the static tracepoints of IoT.js, JerryScript and '
+             'libtuv (requires sys/sdt.h, Linux only)')
     parser.add_argument('-e', '--experimental',
         action='store_true', default=False,
         help='Enable to build experimental features')
@@ -271,6 +299,9 @@ def adjust_options(options):
     options.jerry_profile = fs.join(path.JERRY_PROFILE_ROOT,
                                     options.jerry_profile + '.profile')
 
+    if options.iotjs_app:
+        options.iotjs_app = fs.abspath(options.iotjs_app)
+
 
 def print_build_option(options):
     print('=================================================')
@@ -350,6 +381,30 @@ def get_on_off(boolean_value):
     return 'OFF'
 
 
+def build_app_profile(options):
+    print_progress('Analyze the application')
+
+    # Leave the JerryScript builtins the application and its modules do not
+    # use out of the profile.
+    app_profile = fs.join(options.build_root, 'app.profile')
+    fs.maybe_make_directory(options.build_root)
+    analyzer_args = [
+        fs.join(path.TOOLS_ROOT, 'module_analyzer.py'),
+        '--mode=jerry-profile',
+        '--target-os=%s' % options.target_os,
+        '--iotjs-app=%s' % options.iotjs_app,
+        '--iotjs-include-module=%s' % ','.join(options.iotjs_include_module),
+        '--iotjs-exclude-module=%s' % ','.join(options.iotjs_exclude_module),
+        '--jerry-profile=%s' % options.jerry_profile,
+        '--output=%s' % app_profile,
+    ]
+    if options.iotjs_minimal_profile:
+        analyzer_args.append('--iotjs-minimal-profile')
+
+    ex.check_run_cmd('python', analyzer_args)
+    options.jerry_profile = app_profile
+
+
 def build_iotjs(options):
     print_progress('Build IoT.js')
 
@@ -364,6 +419,9 @@ def build_iotjs(options):
         '-DPLATFORM_DESCRIPTOR=%s' % options.target_tuple,
         '-DENABLE_LTO=%s' % get_on_off(options.jerry_lto), # --jerry-lto
         '-DENABLE_SNAPSHOT=%s' % get_on_off(not options.no_snapshot),
+        '-DENABLE_CODE_CACHE=%s' % get_on_off(options.code_cache),
+        # --js-compress
+        '-DENABLE_JS_COMPRESSION=%s' % get_on_off(options.js_compress),
         '-DENABLE_MINIMAL=%s' % get_on_off(options.iotjs_minimal_profile),
         '-DBUILD_LIB_ONLY=%s' % get_on_off(options.buildlib), # --build-lib
         # --jerry-memstat
@@ -374,6 +432,8 @@ def build_iotjs(options):
         "-DIOTJS_EXCLUDE_MODULE='%s'" % ','.join(options.iotjs_exclude_module),
         # --jerry-profile
         "-DFEATURE_PROFILE='%s'" % options.jerry_profile,
+        # --iotjs-app
+        "-DIOTJS_APP='%s'" % options.iotjs_app,
     ]
 
     if options.target_os in ['nuttx', 'tizenrt']:
@@ -386,6 +446,10 @@ def build_iotjs(options):
     if options.jerry_heaplimit:
         cmake_opt.append('-DMEM_HEAP_SIZE_KB=%d' % options.jerry_heaplimit)
 
+    # --jerry-cpointer-32bit
+    if options.jerry_cpointer_32bit:
+        cmake_opt.append('-DFEATURE_CPOINTER_32_BIT=ON')
+
     # --jerry-heap-section
     if options.jerry_heap_section:
         cmake_opt.append("-DJERRY_HEAP_SECTION_ATTR='%s'" %
@@ -419,6 +483,10 @@ def build_iotjs(options):
     if options.experimental:
         options.compile_flag.append('-DEXPERIMENTAL')
 
+    # --probes
+    if options.probes:
+        options.compile_flag.append('-DENABLE_PROBES')
+
     # Add common cmake options.
     cmake_opt.extend(build_cmake_args(options))
 
@@ -476,6 +544,9 @@ if __name__ == '__main__':
         print_progress('Initialize submodule')
         init_submodule()
 
+    if options.iotjs_app:
+        build_app_profile(options)
+
     build_iotjs(options)
 
     # Run tests.
@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+
+# Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import print_function
+
+import argparse
+import json
+import subprocess
+import sys
+
+
+def get_args():
+    parser = argparse.ArgumentParser(
+        description='Replay allocation traces with the jerry-replay of each '
+                    'heap allocator, and compare their time, peak memory and '
+                    'fragmentation.')
+
+    parser.add_argument('--replay', action='append', required=True,
+                        metavar='file',
+                        help='path to a jerry-replay binary, once for each '
+                             'allocator to compare')
+    parser.add_argument('--repeat', action='store', default=5, type=int,
+                        help='replays of each trace, of which the fastest '
+                             'is reported')
+    parser.add_argument('--output', action='store', metavar='file',
+                        help='write the JSON report to this file, and a '
+                             'table to the standard output')
+    parser.add_argument('traces', action='store', nargs='+',
+                        help='allocation traces recorded with the trace '
+                             'category of the memory profiler')
+
+    return parser.parse_args()
+
+
+def replay(binary, trace, repeat):
+    """Replays one trace, and returns the results of jerry-replay."""
+    process = subprocess.Popen(args=[binary, '--json', '--repeat',
+                                     str(repeat), trace],
+                               stdout=subprocess.PIPE)
+    output = process.communicate()[0].decode('utf-8', 'replace')
+
+    # The engine may print its configuration before the results.
+    for line in reversed(output.splitlines()):
+        if line.startswith('{'):
+            result = json.loads(line)
+            result['binary'] = binary
+            return result
+
+    print('  FAIL: %s %s (exit code %d)' % (binary, trace, process.returncode),
+          file=sys.stderr)
+    return None
+
+
+def print_table(report):
+    print('| {0:<24} | {1:<14} | {2:>9} | {3:>10} | {4:>10} | {5:>7} | '
+          '{6:>7} | {7:>6} |'
+          .format('Trace', 'Allocator', 'ns/event', 'peak live',
+                  'footprint', 'frag %', 'mean %', 'failed'))
+    print('| {0} | {1} | {2} | {3} | {4} | {5} | {6} | {7} |'
+          .format('-' * 24, '-' * 14, '-' * 9, '-' * 10, '-' * 10, '-' * 7,
+                  '-' * 7, '-' * 6))
+    for trace in sorted(report):
+        for result in report[trace]:
+            print('| {0:<24} | {1:<14} | {2:>9} | {3:>10} | {4:>10} | '
+                  '{5:>7.2f} | {6:>7.2f} | {7:>6} |'
+                  .format(trace[-24:], result['allocator'],
+                          result['nsPerEvent'], result['peakLive'],
+                          result['peakFootprint'],
+                          result['fragAtPeak'] * 100,
+                          result['fragMean'] * 100, result['failed']))
+
+
+def main():
+    options = get_args()
+
+    report = {}
+    for trace in options.traces:
+        results = [replay(binary, trace, options.repeat)
+                   for binary in options.replay]
+        report[trace] = [result for result in results if result]
+
+    if not options.output:
+        print(json.dumps(report, indent=2, sort_keys=True))
+        return
+
+    with open(options.output, 'w') as output_file:
+        json.dump(report, output_file, indent=2, sort_keys=True)
+
+    print_table(report)
+
+
+if __name__ == '__main__':
+    main()
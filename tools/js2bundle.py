@@ -0,0 +1,160 @@
+#!/usr/bin/env python
+
+# Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+#  This file packs the files of an application tree into one bundle file,
+# which IoT.js maps at startup and looks its modules up in by name, instead
+# of probing and reading each of them. 'iotjs app.bundle' runs the bundle,
+# and its files are required by their path under 'app.bundle/'.
+# The layout is described in src/modules/iotjs_module_process.c.
+
+import os
+import struct
+
+from common_py.system.filesystem import FileSystem as fs
+from js2snapshot import MODULE_WRAPPER, save_snapshot
+
+
+BUNDLE_MAGIC = b'IOTB'
+BUNDLE_VERSION = 1
+BUNDLE_HEADER_SIZE = 24
+BUNDLE_ENTRY_SIZE = 24
+BUNDLE_NO_MAIN = 0xffffffff
+BUNDLE_ALIGNMENT = 8
+
+KIND_FILE = 0
+KIND_MODULE = 1
+KIND_SNAPSHOT = 2
+
+
+def fnv1a(data):
+    value = 2166136261
+    for byte in bytearray(data):
+        value = ((value ^ byte) * 16777619) & 0xffffffff
+    return value
+
+
+def read_entry(snapshot_generator, src_path, out_path, verbose):
+    """The kind and the data of a file in the bundle."""
+    with open(src_path, 'rb') as src_file:
+        data = src_file.read()
+
+    if fs.splitext(src_path)[1] != '.js':
+        return KIND_FILE, data
+
+    if not snapshot_generator:
+        return KIND_MODULE, (MODULE_WRAPPER[0].encode('utf-8') + data +
+                             MODULE_WRAPPER[1].encode('utf-8'))
+
+    snapshot_path = out_path + '.tmp.snapshot'
+    save_snapshot(snapshot_generator, src_path, snapshot_path, verbose)
+    with open(snapshot_path, 'rb') as snapshot_file:
+        data = snapshot_file.read()
+    fs.remove(snapshot_path)
+    return KIND_SNAPSHOT, data
+
+
+def align(size):
+    return (size + BUNDLE_ALIGNMENT - 1) & ~(BUNDLE_ALIGNMENT - 1)
+
+
+def pack(entries, main):
+    """The bundle of (name, kind, data) entries, with the main one given."""
+    bucket_count = 1
+    while bucket_count < 2 * len(entries) + 1:
+        bucket_count *= 2
+
+    names = [name.encode('utf-8') for name, _, _ in entries]
+    main_index = BUNDLE_NO_MAIN
+    if main is not None:
+        main_index = [name for name, _, _ in entries].index(main)
+
+    buckets = [0] * bucket_count
+    for index, name in enumerate(names):
+        slot = fnv1a(name) & (bucket_count - 1)
+        while buckets[slot]:
+            slot = (slot + 1) & (bucket_count - 1)
+        buckets[slot] = index + 1
+
+    name_offset = (BUNDLE_HEADER_SIZE + 4 * bucket_count +
+                   BUNDLE_ENTRY_SIZE * len(entries))
+    data_offset = align(name_offset + sum(len(name) for name in names))
+
+    table = b''
+    name_table = b''
+    data_table = b''
+    for name, (_, kind, data) in zip(names, entries):
+        table += struct.pack('<6I', fnv1a(name), kind,
+                             name_offset + len(name_table), len(name),
+                             data_offset + len(data_table), len(data))
+        name_table += name
+        data_table += data + b'\0' * (align(len(data)) - len(data))
+
+    header = struct.pack('<4s5I', BUNDLE_MAGIC, BUNDLE_VERSION, len(entries),
+                         bucket_count, main_index, 0)
+    padding = b'\0' * (data_offset - name_offset - len(name_table))
+
+    return (header + struct.pack('<%dI' % bucket_count, *buckets) + table +
+            name_table + padding + data_table)
+
+
+def js2bundle(snapshot_generator, src_dir, out_file, main, verbose):
+    src_dir = fs.abspath(src_dir)
+    out_file = fs.abspath(out_file)
+
+    entries = []
+    for src_path in sorted(fs.files_under(src_dir)):
+        if src_path == out_file or src_path.startswith(out_file + '.'):
+            continue
+        name = fs.relpath(src_path, src_dir).replace(os.sep, '/')
+        kind, data = read_entry(snapshot_generator, src_path, out_file,
+                                verbose)
+        if verbose:
+            print('%s (%d bytes)' % (name, len(data)))
+        entries.append((name, kind, data))
+
+    if main is not None and main not in [name for name, _, _ in entries]:
+        print('Main module is not in %s: %s' % (src_dir, main))
+        exit(1)
+
+    # Written aside and renamed, so that a running device never sees a
+    # partial bundle.
+    tmp_file = out_file + '.tmp'
+    with open(tmp_file, 'wb') as bundle_file:
+        bundle_file.write(pack(entries, main))
+    os.rename(tmp_file, out_file)
+
+
+if __name__ == "__main__":
+    import argparse
+    parser = argparse.ArgumentParser()
+
+    parser.add_argument('--snapshot-generator',
+        help='Executable to use for generating snapshots from the JS files, '
+             'as in tools/js2snapshot.py. Without it, the sources are '
+             'bundled.')
+    parser.add_argument('--main', default='index.js',
+        help='Path of the main module in the application directory '
+             '(default: %(default)s).')
+    parser.add_argument('-v', '--verbose', action='store_true', default=False,
+        help='Enable verbose output.')
+    parser.add_argument('src_dir', help='Application directory to bundle.')
+    parser.add_argument('out_file', help='Bundle file to write, which should '
+                        'be named with the .bundle suffix.')
+
+    options = parser.parse_args()
+
+    js2bundle(options.snapshot_generator, options.src_dir, options.out_file,
+              options.main, options.verbose)
@@ -54,8 +54,21 @@ def force_str(string):
         return string
 
 
+def c_string_literal(string):
+    """ The contents of a C string literal for the given string, whose bytes
+        other than the printable ASCII ones, '"' and '\\' are octal escapes.
+    """
+    chars = []
+    for byte in bytearray(string.encode('utf-8')):
+        if 0x20 <= byte < 0x7f and chr(byte) not in '"\\':
+            chars.append(chr(byte))
+        else:
+            chars.append('\\%03o' % byte)
+    return ''.join(chars)
+
+
 def parse_literals(code):
-    JERRY_SNAPSHOT_VERSION = 7
+    JERRY_SNAPSHOT_VERSION = 9
 
     literals = set()
 
@@ -65,8 +78,10 @@ def parse_literals(code):
                % JERRY_SNAPSHOT_VERSION)
         exit(1)
 
+    # A snapshot of several modules has its module table after the literals.
     code_ptr = header[1] + 8
-    while code_ptr < len(code):
+    code_end = header[1] + header[2]
+    while code_ptr < code_end:
         length = struct.unpack('H', code[code_ptr : code_ptr + 2])[0]
         code_ptr = code_ptr + 2
         if length == 0:
@@ -117,27 +132,71 @@ EMPTY_LINE = '\n'
 
 MAGIC_STRINGS_HEADER = '#define JERRY_MAGIC_STRING_ITEMS \\\n'
 
+MAGIC_STRINGS_HASH = '''
+#define JERRY_MAGIC_STRING_HASH_DISPLACEMENTS \\
+{DISPLACEMENTS}
+
+#define JERRY_MAGIC_STRING_HASH_SLOTS \\
+{SLOTS}
+'''
+
+# Must be kept in sync with the magic string hash of JerryScript,
+# see deps/jerry/tools/gen-magic-strings.py
+MAGIC_HASH_INIT = 2166136261
+MAGIC_HASH_MASK = 0xffffffff
+MAGIC_HASH_BUCKET_SIZE = 4
+MAGIC_HASH_MAX_DISPLACEMENT = 0xffff
+
 
 MODULE_VARIABLES_H = '''
 extern const char {NAME}_n[];
-extern const uint8_t {NAME}_s[];
+extern const uint8_t {DATA}_s[];
 extern const size_t {NAME}_l;
+extern const uint32_t {NAME}_i;
 '''
 
 MODULE_VARIABLES_C = '''
 #define SIZE_{NAME_UPPER} {SIZE}
+#define COMPRESSED_SIZE_{NAME_UPPER} {COMPRESSED_SIZE}
+#define INDEX_{NAME_UPPER} {INDEX}
 const size_t {NAME}_l = SIZE_{NAME_UPPER};
+const uint32_t {NAME}_i = INDEX_{NAME_UPPER};
 const char {NAME}_n[] = "{NAME}";
-const uint8_t {NAME}_s[] = {{
+'''
+
+MODULE_DATA_C = '''const uint8_t {NAME}_s[] = {{
 {CODE}
 }};
 '''
 
+# The modules in one snapshot share its literal table. It is an array of
+# words, as the snapshot is run in place.
+SHARED_SNAPSHOT_H = '''
+extern const uint32_t {NAME}_s[];
+'''
+
+SHARED_SNAPSHOT_C = '''
+const uint32_t {NAME}_s[] = {{
+{CODE}
+}};
+'''
+
+SHARED_MODULE_H = '''
+extern const char {NAME}_n[];
+#define {NAME}_s {DATA}_s
+extern const size_t {NAME}_l;
+extern const uint32_t {NAME}_i;
+'''
+
+SHARED_SNAPSHOT_NAME = 'iotjs_snapshot'
+
 NATIVE_STRUCT_H = '''
 typedef struct {
   const char* name;
   const void* code;
   const size_t length;
+  const size_t compressed_length;
+  const uint32_t index; // of the module in a snapshot of several modules
 } iotjs_js_module;
 
 extern const iotjs_js_module natives[];
@@ -168,13 +227,229 @@ def format_code(code, indent):
     return "\n".join(lines)
 
 
-def get_snapshot_contents(module_name, snapshot_generator):
-    """ Convert the given module with the snapshot generator
-        and return the resulting bytes.
+def format_words(code, indent):
+    code = bytearray(code) + bytearray(-len(code) % 4)
+    words = struct.unpack('<%dI' % (len(code) // 4), bytes(code))
+    lines = []
+    # 6 hex words per line
+    for line in regroup(["0x{:08x}".format(word) for word in words], 6):
+        lines.append(('  ' * indent) + ", ".join(line) + ",")
+
+    return "\n".join(lines)
+
+
+LZ4_MIN_MATCH = 4
+LZ4_MAX_OFFSET = 65535
+LZ4_MAX_CHAIN = 32
+# The last match starts at least 12 bytes before the end of the block, and the
+# last 5 bytes are literals.
+LZ4_MATCH_LIMIT = 12
+LZ4_LAST_LITERALS = 5
+
+
+def lz4_length(length):
+    """ Encode the part of a literal or match length above 14. """
+    out = bytearray()
+    length -= 15
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+    return out
+
+
+def lz4_sequence(out, literals, match_length, offset):
+    literal_length = len(literals)
+    token = min(literal_length, 15) << 4
+    if match_length:
+        token |= min(match_length - LZ4_MIN_MATCH, 15)
+    out.append(token)
+
+    if literal_length >= 15:
+        out += lz4_length(literal_length)
+    out += literals
+
+    if match_length:
+        out += struct.pack('<H', offset)
+        if match_length - LZ4_MIN_MATCH >= 15:
+            out += lz4_length(match_length - LZ4_MIN_MATCH)
+
+
+def lz4_compress(data):
+    """ Compress `data` into an LZ4 block, which src/iotjs_util.c
+        decompresses. The matches are searched among the last positions
+        of the same 4 bytes, which is slow but only runs at build time.
+    """
+    data = bytearray(data)
+    size = len(data)
+    out = bytearray()
+    chains = {}
+    anchor = 0
+    pos = 0
+
+    while pos + LZ4_MATCH_LIMIT <= size:
+        key = bytes(data[pos:pos + LZ4_MIN_MATCH])
+        chain = chains.setdefault(key, [])
+
+        best_length = 0
+        best_offset = 0
+        match_limit = size - LZ4_LAST_LITERALS
+        for candidate in reversed(chain):
+            offset = pos - candidate
+            if offset > LZ4_MAX_OFFSET:
+                break
+            length = LZ4_MIN_MATCH
+            while (pos + length < match_limit and
+                   data[candidate + length] == data[pos + length]):
+                length += 1
+            if length > best_length:
+                best_length = length
+                best_offset = offset
+
+        chain.append(pos)
+        if len(chain) > LZ4_MAX_CHAIN:
+            del chain[0]
+
+        if best_length < LZ4_MIN_MATCH:
+            pos += 1
+            continue
+
+        lz4_sequence(out, data[anchor:pos], best_length, best_offset)
+
+        # Index the matched bytes too, so later matches may refer to them.
+        for skipped in range(pos + 1, min(pos + best_length,
+                                          size - LZ4_MIN_MATCH)):
+            key = bytes(data[skipped:skipped + LZ4_MIN_MATCH])
+            chain = chains.setdefault(key, [])
+            chain.append(skipped)
+            if len(chain) > LZ4_MAX_CHAIN:
+                del chain[0]
+
+        pos += best_length
+        anchor = pos
+
+    lz4_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def lz4_decompress(data, size):
+    """ The reference of the decompressor in C, to check the output of
+        lz4_compress.
+    """
+    data = bytearray(data)
+    out = bytearray()
+    pos = 0
+
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+
+        length = token >> 4
+        if length == 15:
+            while True:
+                length += data[pos]
+                pos += 1
+                if data[pos - 1] != 255:
+                    break
+        out += data[pos:pos + length]
+        pos += length
+        if pos >= len(data):
+            break
+
+        offset = data[pos] | (data[pos + 1] << 8)
+        pos += 2
+        length = (token & 15) + LZ4_MIN_MATCH
+        if token & 15 == 15:
+            while True:
+                length += data[pos]
+                pos += 1
+                if data[pos - 1] != 255:
+                    break
+        for i in range(length):
+            out.append(out[-offset])
+
+    if len(out) != size:
+        return None
+    return bytes(out)
+
+
+def magic_string_hash(string):
+    # 32 bit FNV-1a hash of the utf-8 representation of the string.
+    hash_value = MAGIC_HASH_INIT
+    for byte in bytearray(string.encode('utf-8')):
+        hash_value = ((hash_value ^ byte) * 16777619) & MAGIC_HASH_MASK
+    return hash_value
+
+
+def magic_string_hash_slot(hash_value, displacement, slot_count):
+    # The displaced hash is mixed by the finalizer of MurmurHash3.
+    hash_value = (hash_value + displacement) & MAGIC_HASH_MASK
+    hash_value ^= hash_value >> 16
+    hash_value = (hash_value * 0x85ebca6b) & MAGIC_HASH_MASK
+    hash_value ^= hash_value >> 13
+    hash_value = (hash_value * 0xc2b2ae35) & MAGIC_HASH_MASK
+    hash_value ^= hash_value >> 16
+    return hash_value % slot_count
+
+
+def magic_string_perfect_hash(strings):
+    # Builds the hash-and-displace tables registered by
+    # jerry_register_magic_strings_hash, empty slots contain len(strings).
+    hashes = [magic_string_hash(string) for string in strings]
+    bucket_count = max(1, (len(strings) + MAGIC_HASH_BUCKET_SIZE - 1)
+                       // MAGIC_HASH_BUCKET_SIZE)
+    slot_count = max(1, len(strings) + len(strings) // 4)
+
+    while True:
+        buckets = [[] for _ in range(bucket_count)]
+        for idx, hash_value in enumerate(hashes):
+            buckets[hash_value % bucket_count].append(idx)
+
+        displacements = [0] * bucket_count
+        slots = [len(strings)] * slot_count
+        used_slots = set()
+
+        # Place the largest buckets first, while most of the slots are free.
+        order = sorted(range(bucket_count),
+                       key=lambda idx: (-len(buckets[idx]), idx))
+        for bucket_idx in order:
+            bucket = buckets[bucket_idx]
+            if not bucket:
+                continue
+
+            for displacement in range(MAGIC_HASH_MAX_DISPLACEMENT + 1):
+                bucket_slots = [magic_string_hash_slot(hashes[idx],
+                                                       displacement,
+                                                       slot_count)
+                                for idx in bucket]
+                if len(set(bucket_slots)) == len(bucket_slots) and \
+                   used_slots.isdisjoint(bucket_slots):
+                    break
+            else:
+                break
+
+            displacements[bucket_idx] = displacement
+            for idx, slot in zip(bucket, bucket_slots):
+                slots[slot] = idx
+            used_slots.update(bucket_slots)
+        else:
+            return displacements, slots
+
+        slot_count += max(1, slot_count // 8)
+
+
+def format_magic_string_hash_table(values):
+    lines = ['  ' + ', '.join(str(value) for value in line) + ','
+             for line in regroup(values, 16)]
+    return ' \\\n'.join(lines)
+
+
+def write_wrapped_module(module_name):
+    """ Write the given module wrapped into a function, and return the path
+        of the written file.
     """
     js_path = fs.join(path.SRC_ROOT, 'js', module_name + '.js')
     wrapped_path = js_path + ".wrapped"
-    snapshot_path = js_path + ".snapshot"
 
     with open(wrapped_path, 'w') as fwrapped, open(js_path, "r") as fmodule:
         if module_name != "iotjs":
@@ -185,24 +460,54 @@ def get_snapshot_contents(module_name, snapshot_generator):
         if module_name != "iotjs":
             fwrapped.write("});\n")
 
+    return wrapped_path
+
+
+def save_snapshot(module_names, snapshot_generator, snapshot_path):
+    """ Convert the given modules with the snapshot generator into one
+        snapshot, and return the resulting bytes.
+    """
+    wrapped_paths = [write_wrapped_module(name) for name in module_names]
+
     ret = subprocess.call([snapshot_generator,
+                           "--optimize-snapshot",
                            "--save-snapshot-for-eval",
-                           snapshot_path,
-                           wrapped_path])
+                           snapshot_path] + wrapped_paths)
+    for wrapped_path in wrapped_paths:
+        fs.remove(wrapped_path)
+
     if ret != 0:
-        msg = "Failed to dump %s: - %d" % (js_path, ret)
+        msg = "Failed to dump %s: - %d" % (", ".join(module_names), ret)
         print("%s%s%s" % ("\033[1;31m", msg, "\033[0m"))
         exit(1)
 
     with open(snapshot_path, 'rb') as snapshot:
         code = snapshot.read()
 
-    fs.remove(wrapped_path)
     fs.remove(snapshot_path)
 
     return code
 
 
+def get_snapshot_contents(module_name, snapshot_generator):
+    """ Convert the given module with the snapshot generator
+        and return the resulting bytes.
+    """
+    snapshot_path = fs.join(path.SRC_ROOT, 'js', module_name + '.js.snapshot')
+    return save_snapshot([module_name], snapshot_generator, snapshot_path)
+
+
+def get_shared_snapshot_contents(module_names, snapshot_generator):
+    """ Convert the given modules with the snapshot generator into one
+        snapshot, in which module i has the index i, and their code shares
+        one literal table. A literal used by several modules is stored once,
+        and is only created when a module which uses it is loaded.
+    """
+    snapshot_path = fs.join(path.SRC_ROOT, 'js', SHARED_SNAPSHOT_NAME +
+                            '.snapshot')
+    return save_snapshot(module_names, snapshot_generator, snapshot_path)
+
+
 def get_js_contents(name, is_debug_mode=False):
     """ Read the contents of the given js module. """
     js_path = fs.join(path.SRC_ROOT, 'js', name + '.js')
@@ -216,7 +521,55 @@ def get_js_contents(name, is_debug_mode=False):
     return code
 
 
-def js2c(buildtype, no_snapshot, js_modules, js_dumper, verbose=False):
+def print_size_report(sizes):
+    """ Print the ROM used by each module, before and after compression. """
+    print('%-32s %10s %10s %7s' % ('Module', 'Size', 'Stored', 'Ratio'))
+
+    total_size = 0
+    total_stored = 0
+    for name, size, stored in sizes:
+        print('%-32s %10d %10d %6.1f%%' % (name, size, stored,
+                                           100.0 * stored / max(size, 1)))
+        total_size += size
+        total_stored += stored
+
+    print('%-32s %10d %10d %6.1f%%' % ('Total', total_size, total_stored,
+                                       100.0 * total_stored /
+                                       max(total_size, 1)))
+
+
+def write_shared_snapshot(fout_h, fout_c, module_names, js_dumper,
+                          modules_struct, sizes, magic_string_set, verbose):
+    """ Write the modules as one snapshot, see get_shared_snapshot_contents.
+    """
+    if verbose:
+        print('Processing modules: %s' % ', '.join(module_names))
+
+    code = get_shared_snapshot_contents(module_names, js_dumper)
+    magic_string_set |= parse_literals(code)
+    sizes.append((SHARED_SNAPSHOT_NAME, len(code), len(code)))
+
+    fout_h.write(SHARED_SNAPSHOT_H.format(NAME=SHARED_SNAPSHOT_NAME))
+    fout_c.write(SHARED_SNAPSHOT_C.format(NAME=SHARED_SNAPSHOT_NAME,
+                                          CODE=format_words(code, 1)))
+
+    for index, name in enumerate(module_names):
+        fout_h.write(SHARED_MODULE_H.format(NAME=name,
+                                            DATA=SHARED_SNAPSHOT_NAME))
+        fout_c.write(MODULE_VARIABLES_C.format(
+            NAME=name,
+            NAME_UPPER=name.upper(),
+            SIZE=len(code),
+            COMPRESSED_SIZE=0,
+            INDEX=index))
+
+        modules_struct.append(
+            '  {{ {0}_n, {1}_s, SIZE_{2}, COMPRESSED_SIZE_{2}, '
+            'INDEX_{2} }},'.format(name, SHARED_SNAPSHOT_NAME, name.upper()))
+
+
+def js2c(buildtype, no_snapshot, js_modules, js_dumper, verbose=False,
+         compress=False):
     is_debug_mode = buildtype == "debug"
     magic_string_set = set()
 
@@ -227,6 +580,11 @@ def js2c(buildtype, no_snapshot, js_modules, js_dumper, verbose=False):
             if result:
                 magic_string_set.add(result.group(1))
 
+    # The modules with the same contents share one array.
+    data_names = {}
+    modules_struct = []
+    sizes = []
+
     # generate the code for the modules
     with open(fs.join(path.SRC_ROOT, 'iotjs_js.h'), 'w') as fout_h, \
          open(fs.join(path.SRC_ROOT, 'iotjs_js.c'), 'w') as fout_c:
@@ -236,7 +594,16 @@ def js2c(buildtype, no_snapshot, js_modules, js_dumper, verbose=False):
         fout_c.write(LICENSE)
         fout_c.write(HEADER2)
 
-        for name in sorted(js_modules):
+        # Compressed modules are decompressed one by one, so they are not
+        # put into one snapshot.
+        separate_modules = sorted(js_modules)
+        if not no_snapshot and not compress:
+            write_shared_snapshot(fout_h, fout_c, separate_modules,
+                                  js_dumper, modules_struct, sizes,
+                                  magic_string_set, verbose)
+            separate_modules = []
+
+        for name in separate_modules:
             if verbose:
                 print('Processing module: %s' % name)
 
@@ -246,26 +613,56 @@ def js2c(buildtype, no_snapshot, js_modules, js_dumper, verbose=False):
                 code = get_snapshot_contents(name, js_dumper)
                 magic_string_set |= parse_literals(code)
 
-            code_string = format_code(code, 1)
-
-            fout_h.write(MODULE_VARIABLES_H.format(NAME=name))
-            fout_c.write(MODULE_VARIABLES_C.format(NAME=name,
-                                                   NAME_UPPER=name.upper(),
-                                                   SIZE=len(code),
-                                                   CODE=code_string))
+            if not isinstance(code, bytes):
+                code = code.encode('utf-8')
+
+            # A module is stored compressed only when that saves something.
+            stored = code
+            compressed_size = 0
+            if compress:
+                compressed = lz4_compress(code)
+                if lz4_decompress(compressed, len(code)) != code:
+                    print('Failed to compress %s' % name)
+                    exit(1)
+                if len(compressed) < len(code):
+                    stored = compressed
+                    compressed_size = len(compressed)
+
+            data_name = data_names.get(stored)
+            if data_name is None:
+                data_name = name
+                data_names[stored] = name
+                sizes.append((name, len(code), len(stored)))
+            else:
+                sizes.append((name, len(code), 0))
+
+            fout_h.write(MODULE_VARIABLES_H.format(NAME=name, DATA=data_name))
+            fout_c.write(MODULE_VARIABLES_C.format(
+                NAME=name,
+                NAME_UPPER=name.upper(),
+                SIZE=len(code),
+                COMPRESSED_SIZE=compressed_size,
+                INDEX=0))
+            if data_name == name:
+                fout_c.write(MODULE_DATA_C.format(
+                    NAME=name,
+                    CODE=format_code(stored, 1)))
+
+            modules_struct.append(
+                '  {{ {0}_n, {1}_s, SIZE_{2}, COMPRESSED_SIZE_{2}, '
+                'INDEX_{2} }},'.format(name, data_name, name.upper()))
 
         fout_h.write(NATIVE_STRUCT_H)
         fout_h.write(FOOTER1)
 
-        modules_struct = [
-            '  {{ {0}_n, {0}_s, SIZE_{1} }},'.format(name, name.upper())
-            for name in sorted(js_modules)
-        ]
-        modules_struct.append('  { NULL, NULL, 0 }')
+        modules_struct.append('  { NULL, NULL, 0, 0, 0 }')
 
         fout_c.write(NATIVE_STRUCT_C.format(MODULES="\n".join(modules_struct)))
         fout_c.write(EMPTY_LINE)
 
+    if compress or verbose:
+        print_size_report(sizes)
+
     # Write out the external magic strings
     magic_str_path = fs.join(path.SRC_ROOT, 'iotjs_string_ext.inl.h')
     with open(magic_str_path, 'w') as fout_magic_str:
@@ -274,13 +671,18 @@ def js2c(buildtype, no_snapshot, js_modules, js_dumper, verbose=False):
 
         sorted_strings = sorted(magic_string_set, key=lambda x: (len(x), x))
         for idx, magic_string in enumerate(sorted_strings):
-            magic_text = repr(magic_string)[1:-1]
+            magic_text = c_string_literal(magic_string)
 
             fout_magic_str.write('  MAGICSTR_EX_DEF(MAGIC_STR_%d, "%s") \\\n'
                                  % (idx, magic_text))
         # an empty line is required to avoid compile warning
         fout_magic_str.write(EMPTY_LINE)
 
+        displacements, slots = magic_string_perfect_hash(sorted_strings)
+        fout_magic_str.write(MAGIC_STRINGS_HASH.format(
+            DISPLACEMENTS=format_magic_string_hash_table(displacements),
+            SLOTS=format_magic_string_hash_table(slots)))
+
 
 if __name__ == "__main__":
     import argparse
@@ -294,6 +696,9 @@ if __name__ == "__main__":
     parser.add_argument('--snapshot-generator', default=None,
         help='Executable to use for generating snapshots from the JS files. '
              'If not specified the JS files will be directly processed.')
+    parser.add_argument('--compress', action='store_true', default=False,
+        help='Store the modules compressed with LZ4. They are decompressed '
+             'when they are first required.')
     parser.add_argument('-v', '--verbose', default=False,
         help='Enable verbose output.')
 
@@ -308,4 +713,4 @@ if __name__ == "__main__":
 
     modules = options.modules.replace(',', ' ').split()
     js2c(options.buildtype, no_snapshot, modules, options.snapshot_generator,
-         options.verbose)
+         options.verbose, options.compress)
@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+
+# Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+#  This file precompiles the JS files of an application tree into JerryScript
+# snapshots, so that IoT.js can load the application without parsing it.
+# The tree is copied to the output directory with each 'foo.js' replaced by
+# 'foo.js.snapshot', which the module loader finds by the source name.
+
+import subprocess
+
+from common_py.system.filesystem import FileSystem as fs
+
+
+SNAPSHOT_EXT = '.snapshot'
+
+# Same as the wrapper of process.compile, so that line numbers match.
+MODULE_WRAPPER = ('(function(exports, require, module) {', '\n});\n')
+
+
+def save_snapshot(snapshot_generator, js_path, snapshot_path, verbose):
+    wrapped_path = snapshot_path + '.wrapped'
+
+    with open(wrapped_path, 'w') as fwrapped, open(js_path, 'r') as fmodule:
+        fwrapped.write(MODULE_WRAPPER[0])
+        fwrapped.write(fmodule.read())
+        fwrapped.write(MODULE_WRAPPER[1])
+
+    if verbose:
+        print('%s -> %s' % (js_path, snapshot_path))
+
+    ret = subprocess.call([snapshot_generator,
+                           '--save-snapshot-for-eval',
+                           snapshot_path,
+                           wrapped_path])
+    fs.remove(wrapped_path)
+
+    if ret != 0:
+        msg = 'Failed to dump %s: - %d' % (js_path, ret)
+        print('%s%s%s' % ('\033[1;31m', msg, '\033[0m'))
+        exit(1)
+
+
+def js2snapshot(snapshot_generator, src_dir, out_dir, verbose):
+    src_dir = fs.abspath(src_dir)
+    out_dir = fs.abspath(out_dir)
+
+    # The output directory may be under the application directory.
+    def not_in_out_dir(dirpath, basename):
+        return not fs.join(dirpath, '').startswith(fs.join(out_dir, ''))
+
+    for src_path in fs.files_under(src_dir, file_filter=not_in_out_dir):
+        rel_path = fs.relpath(src_path, src_dir)
+        out_path = fs.join(out_dir, rel_path)
+        fs.maybe_make_directory(fs.dirname(out_path))
+
+        # The sources are left out, not to be loaded instead of the snapshots.
+        if fs.splitext(src_path)[1] == '.js':
+            save_snapshot(snapshot_generator, src_path,
+                          out_path + SNAPSHOT_EXT, verbose)
+        else:
+            fs.copyfile(src_path, out_path)
+
+
+if __name__ == "__main__":
+    import argparse
+    parser = argparse.ArgumentParser()
+
+    parser.add_argument('--snapshot-generator', required=True,
+        help='Executable to use for generating snapshots from the JS files. '
+             'It should be the host jerry of the IoT.js build '
+             '(build/<target>/<buildtype>/deps/jerry-host/bin/jerry), as '
+             'snapshots depend on the engine configuration.')
+    parser.add_argument('-v', '--verbose', action='store_true', default=False,
+        help='Enable verbose output.')
+    parser.add_argument('src_dir', help='Application directory to precompile.')
+    parser.add_argument('out_dir', help='Directory to write the snapshots to.')
+
+    options = parser.parse_args()
+
+    js2snapshot(options.snapshot_generator, options.src_dir, options.out_dir,
+                options.verbose)
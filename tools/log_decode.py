@@ -0,0 +1,158 @@
+#!/usr/bin/env python
+
+# Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+#  This file prints the records of a log file written by the 'log' module
+# (src/modules/iotjs_module_log.c), formatted as util.format() does. The file
+# is in the byte order of the device that wrote it, which is found from the
+# version field of the header.
+
+from __future__ import print_function
+
+import datetime
+import json
+import struct
+
+
+MAGIC = b'IOTJSLOG'
+VERSION = 1
+
+# magic, version, formats_size, formats_used, format_count, ring_size, head,
+# tail, end, wrapped, count, overwritten
+HEADER = '8s11I'
+RECORD = 'HHBQ'
+
+UNDEFINED, NULL, FALSE, TRUE, NUMBER, STRING = range(6)
+
+
+def read_header(data):
+    for order in '<>':
+        fields = struct.unpack_from(order + HEADER, data)
+        if fields[0] == MAGIC and fields[1] == VERSION:
+            return order, fields
+    raise ValueError('not a log file of version %d' % VERSION)
+
+
+def read_args(order, data, pos, end, argc):
+    args = []
+    while len(args) < argc and pos < end:
+        tag = struct.unpack_from('B', data, pos)[0]
+        pos += 1
+        if tag == NULL:
+            args.append(None)
+        elif tag in (FALSE, TRUE):
+            args.append(tag == TRUE)
+        elif tag == NUMBER:
+            args.append(struct.unpack_from(order + 'd', data, pos)[0])
+            pos += 8
+        elif tag == STRING:
+            size = struct.unpack_from(order + 'H', data, pos)[0]
+            pos += 2
+            args.append(data[pos:pos + size].decode('utf-8', 'replace'))
+            pos += size
+        else:
+            args.append(NotImplemented)
+    return args
+
+
+def to_string(value):
+    if value is NotImplemented:
+        return 'undefined'
+    if value is None:
+        return 'null'
+    if value is True or value is False:
+        return 'true' if value else 'false'
+    if isinstance(value, float):
+        return '%d' % value if value.is_integer() else repr(value)
+    return value
+
+
+def format_record(fmt, args):
+    out = []
+    i = 0
+    pos = 0
+    while pos < len(fmt):
+        pct = fmt.find('%', pos)
+        if pct < 0:
+            out.append(fmt[pos:])
+            break
+        out.append(fmt[pos:pct])
+        conversion = fmt[pct + 1:pct + 2]
+        if conversion in ('s', 'd', 'j'):
+            if i < len(args):
+                value = args[i]
+                i += 1
+                if conversion == 'j':
+                    out.append('undefined' if value is NotImplemented
+                               else json.dumps(value))
+                else:
+                    out.append(to_string(value))
+            else:
+                out.append(fmt[pct:pct + 2])
+            pos = pct + 2
+        else:
+            out.append('%')
+            pos = pct + 2 if conversion == '%' else pct + 1
+    for value in args[i:]:
+        out.append(' ' + to_string(value))
+    return ''.join(out)
+
+
+def decode(data):
+    order, fields = read_header(data)
+    (_, _, formats_size, formats_used, format_count, ring_size, head, tail,
+     end, wrapped, count, overwritten) = fields
+
+    formats_start = struct.calcsize(order + HEADER)
+    formats = data[formats_start:formats_start + formats_used].split(b'\0')
+    formats = [f.decode('utf-8', 'replace') for f in formats[:format_count]]
+
+    ring = formats_start + formats_size
+    regions = [(head, end), (0, tail)] if wrapped else [(head, tail)]
+    lines = []
+    for start, stop in regions:
+        pos = start
+        while pos + struct.calcsize(order + RECORD) <= stop:
+            length, fmt, argc, time = struct.unpack_from(order + RECORD, data,
+                                                         ring + pos)
+            if length < struct.calcsize(order + RECORD) or pos + length > stop:
+                break
+            args = read_args(order, data,
+                             ring + pos + struct.calcsize(order + RECORD),
+                             ring + pos + length, argc)
+            stamp = datetime.datetime.utcfromtimestamp(time / 1e6)
+            fmt = formats[fmt] if fmt < len(formats) else 'undefined'
+            lines.append('%sZ %s' % (stamp.isoformat()[:23],
+                                     format_record(fmt, args)))
+            pos += length
+
+    return lines, overwritten
+
+
+if __name__ == "__main__":
+    import argparse
+    parser = argparse.ArgumentParser()
+
+    parser.add_argument('log_file', help='Log file to decode.')
+
+    options = parser.parse_args()
+
+    with open(options.log_file, 'rb') as f:
+        lines, overwritten = decode(f.read())
+
+    if overwritten:
+        print('(%d older records were overwritten)' % overwritten)
+    for line in lines:
+        print(line)
@@ -16,7 +16,9 @@
 
 from __future__ import print_function
 
+import json
 import re
+import sys
 
 from common_py.system.filesystem import FileSystem as fs
 from common_py.system.executor import Executor as ex
@@ -25,6 +27,242 @@ from common_py import path
 
 platform = Platform()
 
+
+# The builtins a JerryScript profile may leave out, and the names in the
+# sources which use them. Builtins without names of their own, such as the
+# methods of strings and arrays, are always kept.
+JERRY_BUILTIN_USES = [
+    ('CONFIG_DISABLE_ANNEXB_BUILTIN',
+     ['escape', 'unescape', 'substr', 'getYear', 'setYear', 'toGMTString',
+      'compile']),
+    ('CONFIG_DISABLE_DATE_BUILTIN', ['Date']),
+    ('CONFIG_DISABLE_ES2015_BUILTIN', ['setPrototypeOf']),
+    ('CONFIG_DISABLE_ES2015_PROMISE_BUILTIN', ['Promise']),
+    ('CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN',
+     ['ArrayBuffer', 'Int8Array', 'Uint8Array', 'Uint8ClampedArray',
+      'Int16Array', 'Uint16Array', 'Int32Array', 'Uint32Array',
+      'Float32Array', 'Float64Array']),
+    ('CONFIG_DISABLE_JSON_BUILTIN', ['JSON']),
+    ('CONFIG_DISABLE_MATH_BUILTIN', ['Math']),
+    ('CONFIG_DISABLE_REGEXP_BUILTIN', ['RegExp']),
+    ('CONFIG_DISABLE_UNICODE_CASE_CONVERSION',
+     ['toLowerCase', 'toUpperCase', 'toLocaleLowerCase',
+      'toLocaleUpperCase']),
+]
+
+# Names through which an application may run code the analysis cannot see.
+DYNAMIC_CODE_NAMES = {'eval', 'Function'}
+
+# Keywords after which a slash starts a regular expression literal.
+REGEXP_KEYWORDS = {'return', 'typeof', 'instanceof', 'in', 'new', 'delete',
+                   'void', 'throw', 'case', 'do', 'else'}
+
+
+def scan_js(content):
+    """ Split a JavaScript source into (kind, value) tokens, where kind is
+        'name', 'string', 'number', 'regexp' or 'punct'. Comments are left
+        out, and a slash which may start a regular expression is taken as
+        one when the line has its end.
+    """
+    tokens = []
+    i = 0
+    length = len(content)
+    while i < length:
+        c = content[i]
+        if c.isspace():
+            i += 1
+        elif content.startswith('//', i):
+            end = content.find('\n', i)
+            i = length if end < 0 else end
+        elif content.startswith('/*', i):
+            end = content.find('*/', i + 2)
+            i = length if end < 0 else end + 2
+        elif c in '\'"`':
+            j = i + 1
+            value = []
+            while j < length and content[j] != c:
+                if content[j] == '\\':
+                    j += 1
+                value.append(content[j:j + 1])
+                j += 1
+            tokens.append(('string', ''.join(value)))
+            i = j + 1
+        elif c.isalpha() or c in '_$':
+            match = re.compile(r'[\w$]+').match(content, i)
+            tokens.append(('name', match.group()))
+            i = match.end()
+        elif c.isdigit() or (c == '.' and content[i + 1:i + 2].isdigit()):
+            match = re.compile(r'[\w.]+').match(content, i)
+            tokens.append(('number', match.group()))
+            i = match.end()
+        elif c == '/' and _starts_regexp(tokens):
+            match = re.compile(r'/(?:\\.|\[(?:\\.|[^\]\n])*\]|[^/\\\n\[])+'
+                               r'/[\w$]*').match(content, i)
+            if match:
+                tokens.append(('regexp', match.group()))
+                i = match.end()
+            else:
+                tokens.append(('punct', c))
+                i += 1
+        else:
+            tokens.append(('punct', c))
+            i += 1
+    return tokens
+
+
+def _starts_regexp(tokens):
+    if not tokens:
+        return True
+    kind, value = tokens[-1]
+    if kind == 'name':
+        return value in REGEXP_KEYWORDS
+    return kind == 'punct' and value not in ')]'
+
+
+def find_requires(tokens):
+    """ The module names required with string literals, and whether any
+        module is required by a name computed at run time.
+    """
+    required = set()
+    dynamic = False
+    for index, (kind, value) in enumerate(tokens):
+        if kind != 'name' or value != 'require':
+            continue
+        if index > 0 and tokens[index - 1] == ('punct', '.'):
+            continue
+        following = tokens[index + 1:index + 4]
+        if not following or following[0] != ('punct', '('):
+            continue
+        if (len(following) == 3 and following[1][0] == 'string' and
+                following[2] == ('punct', ')')):
+            required.add(following[1][1])
+        else:
+            dynamic = True
+    return required, dynamic
+
+
+def _resolve_app_module(name, directories):
+    """ The files of a module of an application, as iotjs looks them up:
+        the file, the file with '.js', or the main file of the package,
+        or its index.js.
+    """
+    for directory in directories:
+        module_path = fs.join(directory, name)
+        for candidate in [module_path, module_path + '.js']:
+            if fs.isfile(candidate):
+                return candidate
+        package_path = fs.join(module_path, 'package.json')
+        if fs.isfile(package_path):
+            with open(package_path) as package:
+                main = json.load(package).get('main', 'index.js')
+            for candidate in [fs.join(module_path, main),
+                              fs.join(module_path, main) + '.js',
+                              fs.join(module_path, 'index.js')]:
+                if fs.isfile(candidate):
+                    return candidate
+    return None
+
+
+def analyze_app(app_path):
+    """ Follow the require graph of an application from its main file, or
+        from all the files of its directory, and return the builtin modules
+        it requires, its sources, and whether some module is required by a
+        name the analysis cannot see.
+    """
+    app_path = fs.abspath(app_path)
+    if fs.isdir(app_path):
+        app_root = app_path
+        queue = [src for src in fs.files_under(app_path)
+                 if fs.splitext(src)[1] == '.js']
+    elif fs.isfile(app_path):
+        app_root = fs.dirname(app_path)
+        queue = [app_path]
+    else:
+        ex.fail('Cannot read the application "%s"' % app_path)
+
+    builtin = set()
+    sources = set()
+    dynamic = False
+    while queue:
+        src = queue.pop()
+        if src in sources:
+            continue
+        sources.add(src)
+        with open(src) as module:
+            required, is_dynamic = find_requires(scan_js(module.read()))
+        if is_dynamic:
+            print('%s: a module is required by a computed name' % src,
+                  file=sys.stderr)
+            dynamic = True
+
+        directories = [fs.dirname(src), app_root,
+                       fs.join(app_root, 'iotjs_modules')]
+        for name in required:
+            is_path = name.startswith('./') or name.startswith('../') or \
+                      name.startswith('/')
+            if not is_path and fs.exists(fs.join(path.PROJECT_ROOT, 'src',
+                                                 'js', name + '.js')):
+                builtin.add(name)
+                continue
+
+            module_path = _resolve_app_module(
+                name, directories[:1] if is_path else directories)
+            if module_path:
+                queue.append(fs.abspath(module_path))
+            else:
+                print('%s: cannot find the module "%s"' % (src, name),
+                      file=sys.stderr)
+
+    return {'builtin': builtin, 'sources': sorted(sources),
+            'dynamic': dynamic}
+
+
+def analyze_jerry_builtins(sources, check_dynamic_code):
+    """ The CONFIG_DISABLE_* settings of the JerryScript builtins none of the
+        sources uses. Nothing is left out if one of the `check_dynamic_code`
+        sources may run code that is not in the sources.
+    """
+    names = set()
+    has_regexp = False
+    for src in sources:
+        with open(src) as module:
+            tokens = scan_js(module.read())
+        # Properties may be named by strings, as global['JSON'].
+        src_names = set(value for kind, value in tokens
+                        if kind in ('name', 'string'))
+        names |= src_names
+        has_regexp |= any(kind == 'regexp' for kind, _ in tokens)
+
+        if src in check_dynamic_code and src_names & DYNAMIC_CODE_NAMES:
+            print('%s: code may be evaluated at run time, all the builtins '
+                  'are kept' % src, file=sys.stderr)
+            return []
+
+    disabled = []
+    for setting, uses in JERRY_BUILTIN_USES:
+        if names & set(uses):
+            continue
+        if setting == 'CONFIG_DISABLE_REGEXP_BUILTIN' and has_regexp:
+            continue
+        disabled.append(setting)
+    return disabled
+
+
+def write_jerry_profile(base_profile, disabled, output):
+    """ Write the settings of the base profile and the disabled builtins into
+        a new profile.
+    """
+    with open(base_profile) as profile:
+        lines = [line.strip() for line in profile.read().splitlines()]
+    settings = [line for line in lines if line and not line.startswith('#')]
+
+    with open(output, 'w') as profile:
+        profile.write('# Generated by tools/module_analyzer.py from %s\n' %
+                      fs.basename(base_profile))
+        for setting in settings + sorted(set(disabled) - set(settings)):
+            profile.write(setting + '\n')
+
+
 def resolve_modules(options):
     """ Resolve include/exclude module lists based on command line arguments
         and build config.
@@ -41,7 +279,15 @@ def resolve_modules(options):
     include_modules = set() | core_modules
     include_modules |= options.iotjs_include_module
 
-    if not options.iotjs_minimal_profile:
+    app = None
+    if options.iotjs_app:
+        # The builtin modules the application requires replace the 'basic'
+        # ones, unless it requires some by names computed at run time.
+        app = analyze_app(options.iotjs_app)
+        include_modules |= app['builtin']
+        options.app_sources = app['sources']
+
+    if not options.iotjs_minimal_profile and (not app or app['dynamic']):
         # Add 'basic' module to the target include modules
         include_modules |= basic_modules
 
@@ -60,7 +306,51 @@ def resolve_modules(options):
     return include_modules, exclude_modules
 
 
-def analyze_module_dependency(include_modules, exclude_modules):
+def _read_module_requires(item):
+    """ Return the builtin modules and the native modules the js module
+        `item` requires.
+    """
+    js_module_path = fs.join(path.PROJECT_ROOT, 'src', 'js', item + '.js')
+    if not fs.exists(js_module_path):
+        ex.fail('Cannot read file "%s"' % js_module_path)
+    with open(js_module_path) as module:
+        content = module.read()
+
+    # Pretend to ignore comments in JavaScript
+    re_js_comments = "\/\/.*|\/\*.*\*\/";
+    content = re.sub(re_js_comments, "", content)
+
+    # Get all required modules
+    re_js_module = 'require\([\'\"](.*?)[\'\"]\)'
+    required_modules = set(re.findall(re_js_module, content))
+
+    # Get all native modules
+    re_native_module = 'process.binding\(process.binding.(.*?)\)'
+    native_modules = set(re.findall(re_native_module, content))
+
+    return required_modules, native_modules
+
+
+def _choose_alternative(item, alternatives, exclude_modules):
+    """ Choose the first of the alternative modules `item` requires which
+        neither is excluded nor requires an excluded module.
+    """
+    for alternative in alternatives:
+        queue = {alternative}
+        seen = set()
+        while queue and not (seen & exclude_modules):
+            current = queue.pop()
+            seen.add(current)
+            queue |= _read_module_requires(current)[0] - seen - {'native'}
+        if not (seen & exclude_modules):
+            return alternative
+
+    ex.fail('Cannot build "%s" on any of "%s"' %
+            (item, ', '.join(alternatives)))
+
+
+def analyze_module_dependency(include_modules, exclude_modules,
+                              alternatives={}):
     analyze_queue = set(include_modules) # copy the set
     analyze_queue.add('iotjs')
 
@@ -69,20 +359,14 @@ def analyze_module_dependency(include_modules, exclude_modules):
     while analyze_queue:
         item = analyze_queue.pop()
         js_modules.add(item)
-        js_module_path = fs.join(path.PROJECT_ROOT,
-                                 'src', 'js', item + '.js')
-        if not fs.exists(js_module_path):
-            ex.fail('Cannot read file "%s"' % js_module_path)
-        with open(js_module_path) as module:
-            content = module.read()
-
-        # Pretend to ignore comments in JavaScript
-        re_js_comments = "\/\/.*|\/\*.*\*\/";
-        content = re.sub(re_js_comments, "", content)
-
-        # Get all required modules
-        re_js_module = 'require\([\'\"](.*?)[\'\"]\)'
-        required_modules = set(re.findall(re_js_module, content))
+        required_modules, item_native_modules = _read_module_requires(item)
+
+        # Of the modules a module may run on, only one is built
+        if item in alternatives:
+            required_modules -= set(alternatives[item])
+            required_modules.add(_choose_alternative(item, alternatives[item],
+                                                     exclude_modules))
+
         # Check if there is any required modules in the exclude set
         problem_modules = required_modules & exclude_modules
         if problem_modules:
@@ -92,9 +376,7 @@ def analyze_module_dependency(include_modules, exclude_modules):
         # Add all modules to analytze queue which are not yet analyzed
         analyze_queue |= required_modules - js_modules
 
-        # Get all native modules
-        re_native_module = 'process.binding\(process.binding.(.*?)\)'
-        native_modules |= set(re.findall(re_native_module, content))
+        native_modules |= item_native_modules
 
     js_modules.remove('native')
 
@@ -132,6 +414,21 @@ def _load_options(argv):
          'args': dict(action='store_true', default=False,
             help='Build IoT.js with minimal profile')
         },
+        {'name': 'iotjs-app',
+         'args': dict(action='store', default='',
+            help='Select the modules which the application of this main '
+                 'file, or of this directory, requires, instead of the '
+                 'basic modules')
+        },
+        {'name': 'jerry-profile',
+         'args': dict(action='store', default='',
+            help='Base JerryScript profile the jerry-profile mode leaves '
+                 'the builtins unused by the application out of')
+        },
+        {'name': 'output',
+         'args': dict(action='store', default='',
+            help='Profile file written in the jerry-profile mode')
+        },
         {'name': 'iotjs-include-module',
          'args': dict(action='store', default=set(),
             type=_normalize_module_set,
@@ -150,7 +447,7 @@ def _load_options(argv):
             help='Specify the target os: %(choices)s (default: %(default)s)')
         },
         {'name': 'mode',
-         'args': dict(choices=['verbose', 'cmake-dump'],
+         'args': dict(choices=['verbose', 'cmake-dump', 'jerry-profile'],
             default='verbose',
             help='Execution mode of the script. Choices: %(choices)s '
                  '(default: %(default)s)'
@@ -203,11 +500,24 @@ def _main():
     options = _load_options(sys.argv)
 
     includes, excludes = resolve_modules(options)
-    modules = analyze_module_dependency(includes, excludes)
+    modules = analyze_module_dependency(
+        includes, excludes, options.config['module'].get('alternatives', {}))
 
     if options.mode == 'cmake-dump':
         print('IOTJS_JS_MODULES=' + ';'.join(modules['js']))
         print('IOTJS_NATIVE_MODULES=' + ';'.join(modules['native']))
+    elif options.mode == 'jerry-profile':
+        if not options.iotjs_app or not options.jerry_profile or \
+                not options.output:
+            ex.fail('The jerry-profile mode needs --iotjs-app, '
+                    '--jerry-profile and --output')
+        app_sources = options.app_sources
+        module_sources = [fs.join(path.PROJECT_ROOT, 'src', 'js', name + '.js')
+                          for name in modules['js']]
+        disabled = analyze_jerry_builtins(app_sources + module_sources,
+                                          set(app_sources))
+        write_jerry_profile(options.jerry_profile, disabled, options.output)
+        print('Builtins left out: %s' % (', '.join(disabled) or 'none'))
     else:
         print('Selected js modules: %s' % ', '.join(modules['js']))
         print('Selected native modules: %s' % ', '.join(modules['native']))
@@ -175,15 +175,24 @@ if __name__ == '__main__':
         os_dependency_module[os_name] = \
         ['--iotjs-include-module=' + ','.join(extend_module[os_name])]
 
+    # tls and https link mbedTLS, which apt-get-install-deps.sh installs for
+    # the host only.
+    no_tls_module = ['--iotjs-exclude-module=https,tls']
+
     build_args = []
 
     if option.buildoptions:
         build_args.extend(option.buildoptions.split(','))
 
+    # Neither do the host builds for another architecture, such as i686.
+    host_module = os_dependency_module['linux']
+    if any(arg.startswith('--target-arch=') for arg in build_args):
+        host_module = host_module + no_tls_module
+
     for test in option.test:
         if test == "host-linux":
             for buildtype in option.buildtype:
-                build(buildtype, os_dependency_module['linux'] + build_args)
+                build(buildtype, host_module + build_args)
 
         if test == "host-darwin":
             for buildtype in option.buildtype:
@@ -192,7 +201,8 @@ if __name__ == '__main__':
         elif test == "rpi2":
             for buildtype in option.buildtype:
                 build(buildtype, ['--target-arch=arm', '--target-board=rpi2']
-                                + os_dependency_module['linux'] + build_args)
+                                + os_dependency_module['linux'] + no_tls_module
+                                + build_args)
 
         elif test == "artik10":
             for buildtype in option.buildtype:
@@ -202,7 +212,8 @@ if __name__ == '__main__':
                                 '--target-os=tizen',
                                 '--target-board=artik10',
                                 '--compile-flag=--sysroot=' + tizen_root
-                                ] + os_dependency_module['linux'] + build_args)
+                                ] + os_dependency_module['linux']
+                                + no_tls_module + build_args)
 
         elif test == "artik053":
             for buildtype in option.buildtype:
@@ -115,8 +115,20 @@ Runner.prototype.checkSupportedModule = function() {
   return false;
 }
 
+// The other modules a test requires are named by `required-modules`.
+Runner.prototype.checkRequiredModules = function() {
+  var required = this.test['required-modules'] || [];
+  for (var i = 0; i < required.length; i++) {
+    if (builtin_modules.indexOf(required[i]) < 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 Runner.prototype.run = function() {
-  if (!this.checkSupportedModule()) {
+  if (!this.checkSupportedModule() || !this.checkRequiredModules()) {
     this.test.reason = 'unsupported module by iotjs build';
     this.finish('skip');
     return;
@@ -219,6 +219,13 @@ class TestRunner(object):
             test["reason"] = "unsupported module by iotjs build"
             return True
 
+        # Skip the test if the other modules it requires, which the
+        # `required-modules` attribute names, are not compiled in.
+        for module in test.get("required-modules", []):
+            if module not in self.builtins:
+                test["reason"] = "unsupported module by iotjs build"
+                return True
+
         return False
 
 